@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_app_trace_func_counters.h"
+
+// Counters of the functions compiled with `-finstrument-functions`, kept in an open addressing hash table.
+// A slot is claimed atomically by storing the function address, the count itself is incremented without a lock,
+// so a few increments may be lost when the same function runs on both cores at once, which is fine for profiling.
+
+#define FUNC_COUNTERS_TABLE_SIZE    CONFIG_APPTRACE_FUNC_COUNTERS_TABLE_SIZE
+#define FUNC_COUNTERS_MAX_PROBES    16
+
+_Static_assert((FUNC_COUNTERS_TABLE_SIZE & (FUNC_COUNTERS_TABLE_SIZE - 1)) == 0, "counter table size must be a power of 2");
+
+typedef struct {
+    volatile uint32_t func;     // function address, 0 means a free slot
+    volatile uint32_t count;    // number of calls
+} func_counter_slot_t;
+
+static func_counter_slot_t s_func_counters[FUNC_COUNTERS_TABLE_SIZE];
+static volatile uint32_t s_func_counters_dropped;
+static volatile bool s_func_counters_enabled;
+
+void __cyg_profile_func_enter(void *this_fn, void *call_site) __attribute__((no_instrument_function));
+void __cyg_profile_func_exit(void *this_fn, void *call_site) __attribute__((no_instrument_function));
+
+void IRAM_ATTR __cyg_profile_func_enter(void *this_fn, void *call_site)
+{
+    if (!s_func_counters_enabled) {
+        return;
+    }
+    uint32_t func = (uint32_t)this_fn;
+    // Fibonacci hashing, the function addresses are at least 2 bytes aligned
+    uint32_t index = ((func >> 1) * 2654435761U) >> 16;
+    for (int i = 0; i < FUNC_COUNTERS_MAX_PROBES; i++) {
+        func_counter_slot_t *slot = &s_func_counters[(index + i) & (FUNC_COUNTERS_TABLE_SIZE - 1)];
+        uint32_t slot_func = slot->func;
+        if (slot_func == 0) {
+            // try to claim the free slot, another core may have claimed it meanwhile, maybe for the same function
+            esp_cpu_compare_and_set(&slot->func, 0, func);
+            slot_func = slot->func;
+        }
+        if (slot_func == func) {
+            slot->count++;
+            return;
+        }
+    }
+    s_func_counters_dropped++;
+}
+
+void IRAM_ATTR __cyg_profile_func_exit(void *this_fn, void *call_site)
+{
+}
+
+void esp_apptrace_func_counters_start(void)
+{
+    s_func_counters_enabled = true;
+}
+
+void esp_apptrace_func_counters_stop(void)
+{
+    s_func_counters_enabled = false;
+}
+
+void esp_apptrace_func_counters_reset(void)
+{
+    memset((void *)s_func_counters, 0, sizeof(s_func_counters));
+    s_func_counters_dropped = 0;
+}
+
+uint32_t esp_apptrace_func_counters_get_dropped(void)
+{
+    return s_func_counters_dropped;
+}
+
+esp_err_t esp_apptrace_func_counters_foreach(esp_apptrace_func_counter_cb_t cb, void *arg)
+{
+    if (!cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < FUNC_COUNTERS_TABLE_SIZE; i++) {
+        esp_apptrace_func_counter_t counter = {
+            .func = (void *)s_func_counters[i].func,
+            .count = s_func_counters[i].count,
+        };
+        if (counter.func && counter.count) {
+            if (!cb(&counter, arg)) {
+                break;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+static bool func_counter_print(const esp_apptrace_func_counter_t *counter, void *arg)
+{
+    fprintf((FILE *)arg, "%p %"PRIu32"\n", counter->func, counter->count);
+    return true;
+}
+
+esp_err_t esp_apptrace_func_counters_dump(FILE *stream)
+{
+    if (!stream) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = esp_apptrace_func_counters_foreach(func_counter_print, stream);
+    uint32_t dropped = esp_apptrace_func_counters_get_dropped();
+    if (dropped) {
+        fprintf(stream, "# %"PRIu32" calls dropped, counter table full\n", dropped);
+    }
+    return ret;
+}
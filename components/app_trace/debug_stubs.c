@@ -94,7 +94,7 @@ esp_err_t esp_dbg_stub_entry_get(esp_dbg_stub_id_t id, uint32_t *entry)
     return ESP_OK;
 }
 
-ESP_SYSTEM_INIT_FN(init_dbg_stubs, SECONDARY, BIT(0), 140)
+ESP_SYSTEM_INIT_FN(init_dbg_stubs, DEFERRABLE, BIT(0), 140)
 {
     esp_dbg_stubs_init();
     return ESP_OK;
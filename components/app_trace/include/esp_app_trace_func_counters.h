@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Function call counter entry
+ */
+typedef struct {
+    void *func;         /*!< Address of the instrumented function */
+    uint32_t count;     /*!< Number of calls since the counters were reset */
+} esp_apptrace_func_counter_t;
+
+/**
+ * @brief Callback invoked for every function which has been called at least once
+ *
+ * @param[in] counter Function call counter
+ * @param[in] arg User argument passed to `esp_apptrace_func_counters_foreach`
+ * @return true to continue the iteration, false to stop it
+ */
+typedef bool (*esp_apptrace_func_counter_cb_t)(const esp_apptrace_func_counter_t *counter, void *arg);
+
+/**
+ * @brief Start counting the calls of the functions compiled with `-finstrument-functions`
+ *
+ * @note The counters are stopped after startup, the instrumented functions only pay for a flag check until this function is called.
+ */
+void esp_apptrace_func_counters_start(void);
+
+/**
+ * @brief Stop counting the function calls, the counters keep their values
+ */
+void esp_apptrace_func_counters_stop(void);
+
+/**
+ * @brief Clear all the counters
+ *
+ * @note The counters should be stopped while clearing them, otherwise the calls made meanwhile may be lost.
+ */
+void esp_apptrace_func_counters_reset(void);
+
+/**
+ * @brief Get the number of function calls which were not counted because the counter table was full
+ *
+ * @return Number of dropped calls, a non-zero value means CONFIG_APPTRACE_FUNC_COUNTERS_TABLE_SIZE should be increased
+ */
+uint32_t esp_apptrace_func_counters_get_dropped(void);
+
+/**
+ * @brief Iterate over the functions which have been called at least once
+ *
+ * @param[in] cb Callback invoked for every function, e.g. to send the counters over HTTP
+ * @param[in] arg User argument passed to the callback
+ * @return
+ *      - ESP_OK: Iterate the counters successfully
+ *      - ESP_ERR_INVALID_ARG: Iterate the counters failed because of invalid argument
+ */
+esp_err_t esp_apptrace_func_counters_foreach(esp_apptrace_func_counter_cb_t cb, void *arg);
+
+/**
+ * @brief Print the counters, one `<address> <count>` line per function
+ *
+ * The addresses can be resolved with `addr2line -f -e build/<project>.elf`.
+ *
+ * @param[in] stream Stream to print to, e.g. stdout
+ * @return
+ *      - ESP_OK: Print the counters successfully
+ *      - ESP_ERR_INVALID_ARG: Print the counters failed because of invalid argument
+ */
+esp_err_t esp_apptrace_func_counters_dump(FILE *stream);
+
+#ifdef __cplusplus
+}
+#endif
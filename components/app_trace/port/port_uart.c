@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2017-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2017-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -19,6 +19,9 @@
 
 #define APP_TRACE_MAX_TX_BUFF_UART          CONFIG_APPTRACE_UART_TX_BUFF_SIZE
 #define APP_TRACE_MAX_TX_MSG_UART           CONFIG_APPTRACE_UART_TX_MSG_SIZE
+// wake up the TX task as soon as the ring buffer is half full, instead of waiting for its next poll
+#define APP_TRACE_UART_TX_WAKE_THRESHOLD    (APP_TRACE_MAX_TX_BUFF_UART / 2)
+#define APP_TRACE_UART_TX_POLL_TICKS        10
 
 /** UART HW transport data */
 typedef struct {
@@ -27,6 +30,7 @@ typedef struct {
     esp_apptrace_lock_t                 lock;   // sync lock
 #endif
     uart_port_t port_num;
+    TaskHandle_t tx_task;
 // TX data ring buffer
     uint8_t *tx_data_buff;
     int32_t tx_data_buff_in;
@@ -114,59 +118,102 @@ static inline void esp_apptrace_uart_hw_init(void)
 /***************************** Apptrace HW iface *****************************************/
 /*****************************************************************************************/
 
-static esp_err_t esp_apptrace_send_uart_data(esp_apptrace_uart_data_t *hw_data, const char *data, uint32_t size, esp_apptrace_tmo_t *tmo)
+static inline bool esp_apptrace_uart_can_wait(void)
 {
-    esp_err_t res = esp_apptrace_uart_lock(hw_data, tmo);
-    if (res != ESP_OK) {
-        return res;
-    }
-    // We store current out position to handle it without lock
-    volatile int32_t out_position = hw_data->tx_data_buff_out;
+    return xTaskGetSchedulerState() == taskSCHEDULER_RUNNING && xPortCanYield();
+}
 
-    int len_free = APP_TRACE_MAX_TX_BUFF_UART - (hw_data->tx_data_buff_in - out_position);
-    if (out_position > hw_data->tx_data_buff_in) {
-        len_free = out_position - hw_data->tx_data_buff_in;
+static inline int32_t esp_apptrace_uart_tx_used(esp_apptrace_uart_data_t *hw_data)
+{
+    int32_t used = hw_data->tx_data_buff_in - hw_data->tx_data_buff_out;
+    return used < 0 ? used + APP_TRACE_MAX_TX_BUFF_UART : used;
+}
+
+static void esp_apptrace_uart_wake_tx_task(esp_apptrace_uart_data_t *hw_data)
+{
+    if (hw_data->tx_task == NULL) {
+        return;
     }
-    int check_len = APP_TRACE_MAX_TX_BUFF_UART - hw_data->tx_data_buff_in;
-    if (size <= len_free)
-    {
-        if ( check_len >= size) {
-            memcpy(&hw_data->tx_data_buff[hw_data->tx_data_buff_in], data, size);
-            hw_data->tx_data_buff_in += size;
-        } else {
-            memcpy(&hw_data->tx_data_buff[hw_data->tx_data_buff_in], data, APP_TRACE_MAX_TX_BUFF_UART - hw_data->tx_data_buff_in);
-            memcpy(&hw_data->tx_data_buff[0], &data[APP_TRACE_MAX_TX_BUFF_UART - hw_data->tx_data_buff_in], size - (APP_TRACE_MAX_TX_BUFF_UART - hw_data->tx_data_buff_in));
-            hw_data->tx_data_buff_in = size - (APP_TRACE_MAX_TX_BUFF_UART - hw_data->tx_data_buff_in);
-        }
-        if (hw_data->tx_data_buff_in >= APP_TRACE_MAX_TX_BUFF_UART) {
-            hw_data->tx_data_buff_in = 0;
+    if (xPortInIsrContext()) {
+        BaseType_t need_yield = pdFALSE;
+        vTaskNotifyGiveFromISR(hw_data->tx_task, &need_yield);
+        if (need_yield == pdTRUE) {
+            portYIELD_FROM_ISR();
         }
-    } else {
-        hw_data->circular_buff_overflow = true;
+    } else if (esp_apptrace_uart_can_wait()) {
+        xTaskNotifyGive(hw_data->tx_task);
     }
+    // otherwise we are in a critical section, the TX task will pick up the data on its next poll
+}
 
-    if (esp_apptrace_uart_unlock(hw_data) != ESP_OK) {
-        assert(false && "Failed to unlock apptrace data!");
-    }
+static esp_err_t esp_apptrace_send_uart_data(esp_apptrace_uart_data_t *hw_data, const char *data, uint32_t size, esp_apptrace_tmo_t *tmo)
+{
+    while (1) {
+        esp_err_t res = esp_apptrace_uart_lock(hw_data, tmo);
+        if (res != ESP_OK) {
+            return res;
+        }
+        // keep one byte free, so that a full buffer can be told apart from an empty one
+        int32_t len_free = APP_TRACE_MAX_TX_BUFF_UART - esp_apptrace_uart_tx_used(hw_data) - 1;
+        int32_t check_len = APP_TRACE_MAX_TX_BUFF_UART - hw_data->tx_data_buff_in;
+        bool done = (int32_t)size <= len_free;
+        if (done) {
+            if (check_len >= (int32_t)size) {
+                memcpy(&hw_data->tx_data_buff[hw_data->tx_data_buff_in], data, size);
+                hw_data->tx_data_buff_in += size;
+            } else {
+                memcpy(&hw_data->tx_data_buff[hw_data->tx_data_buff_in], data, check_len);
+                memcpy(&hw_data->tx_data_buff[0], &data[check_len], size - check_len);
+                hw_data->tx_data_buff_in = size - check_len;
+            }
+            if (hw_data->tx_data_buff_in >= APP_TRACE_MAX_TX_BUFF_UART) {
+                hw_data->tx_data_buff_in = 0;
+            }
+        }
+        int32_t used = esp_apptrace_uart_tx_used(hw_data);
 
-    return ESP_OK;
+        if (esp_apptrace_uart_unlock(hw_data) != ESP_OK) {
+            assert(false && "Failed to unlock apptrace data!");
+        }
+
+        if (done) {
+            if (used >= APP_TRACE_UART_TX_WAKE_THRESHOLD) {
+                esp_apptrace_uart_wake_tx_task(hw_data);
+            }
+            return ESP_OK;
+        }
+#if CONFIG_APPTRACE_UART_LOSSLESS
+        // wait for the TX task to make room, unless we are not allowed to block
+        if (esp_apptrace_uart_can_wait() && esp_apptrace_tmo_check(tmo) == ESP_OK) {
+            esp_apptrace_uart_wake_tx_task(hw_data);
+            vTaskDelay(1);
+            continue;
+        }
+#endif
+        hw_data->circular_buff_overflow = true;
+#if CONFIG_APPTRACE_UART_LOSSLESS
+        return ESP_ERR_TIMEOUT;
+#else
+        return ESP_OK;
+#endif
+    }
 }
 
 static void send_buff_data(esp_apptrace_uart_data_t *hw_data, esp_apptrace_tmo_t *tmo)
 {
-    if (hw_data->tx_data_buff_in == hw_data->tx_data_buff_out) {
-        return;
-    }
-    // We store current in position to handle it without lock
-    volatile int32_t in_position = hw_data->tx_data_buff_in;
-    if (in_position > hw_data->tx_data_buff_out) {
-        int bytes_sent = uart_write_bytes(hw_data->port_num, &hw_data->tx_data_buff[hw_data->tx_data_buff_out], in_position - hw_data->tx_data_buff_out);
-        hw_data->tx_data_buff_out += bytes_sent;
-    } else {
-        int bytes_sent = uart_write_bytes(hw_data->port_num, &hw_data->tx_data_buff[hw_data->tx_data_buff_out], APP_TRACE_MAX_TX_BUFF_UART - hw_data->tx_data_buff_out);
-        hw_data->tx_data_buff_out += bytes_sent;
-        if (hw_data->tx_data_buff_out >= APP_TRACE_MAX_TX_BUFF_UART) {
-            hw_data->tx_data_buff_out = 0;
+    // drain the ring buffer, the new data may wrap around the end of the buffer
+    while (hw_data->tx_data_buff_in != hw_data->tx_data_buff_out) {
+        // We store current in position to handle it without lock
+        volatile int32_t in_position = hw_data->tx_data_buff_in;
+        if (in_position > hw_data->tx_data_buff_out) {
+            int bytes_sent = uart_write_bytes(hw_data->port_num, &hw_data->tx_data_buff[hw_data->tx_data_buff_out], in_position - hw_data->tx_data_buff_out);
+            hw_data->tx_data_buff_out += bytes_sent;
+        } else {
+            int bytes_sent = uart_write_bytes(hw_data->port_num, &hw_data->tx_data_buff[hw_data->tx_data_buff_out], APP_TRACE_MAX_TX_BUFF_UART - hw_data->tx_data_buff_out);
+            hw_data->tx_data_buff_out += bytes_sent;
+            if (hw_data->tx_data_buff_out >= APP_TRACE_MAX_TX_BUFF_UART) {
+                hw_data->tx_data_buff_out = 0;
+            }
         }
     }
 }
@@ -182,7 +229,8 @@ static void esp_apptrace_send_uart_tx_task(void *arg)
     vTaskDelay(10);
     while (1) {
         send_buff_data(hw_data, &tmo);
-        vTaskDelay(10);
+        // sleep until the ring buffer fills up or the poll period expires
+        ulTaskNotifyTake(pdTRUE, APP_TRACE_UART_TX_POLL_TICKS);
         if (hw_data->circular_buff_overflow == true)
         {
             hw_data->circular_buff_overflow = false;
@@ -245,7 +293,7 @@ static esp_err_t esp_apptrace_uart_init(esp_apptrace_uart_data_t *hw_data)
 
         int uart_prio = CONFIG_APPTRACE_UART_TASK_PRIO;
         if (uart_prio >= (configMAX_PRIORITIES-1)) uart_prio = configMAX_PRIORITIES - 1;
-        err = xTaskCreate(esp_apptrace_send_uart_tx_task, "app_trace_uart_tx_task", 2500, hw_data, uart_prio, NULL);
+        err = xTaskCreate(esp_apptrace_send_uart_tx_task, "app_trace_uart_tx_task", 2500, hw_data, uart_prio, &hw_data->tx_task);
         assert((err == pdPASS) && "Not possible to configure UART. Not possible to create task!");
 
 #if CONFIG_APPTRACE_LOCK_ENABLE
@@ -344,12 +392,28 @@ static bool esp_apptrace_uart_host_is_connected(esp_apptrace_uart_data_t *hw_dat
 
 static esp_err_t esp_apptrace_uart_flush_nolock(esp_apptrace_uart_data_t *hw_data, uint32_t min_sz, esp_apptrace_tmo_t *tmo)
 {
+    if (esp_apptrace_uart_tx_used(hw_data) < min_sz) {
+        return ESP_OK;
+    }
+    if (!esp_apptrace_uart_can_wait()) {
+        // the TX task can not run, leave the data for its next poll
+        return ESP_OK;
+    }
+    // hand the data over to the TX task and wait until it has been passed to the UART driver
+    while (esp_apptrace_uart_tx_used(hw_data) != 0) {
+        esp_err_t res = esp_apptrace_tmo_check(tmo);
+        if (res != ESP_OK) {
+            return res;
+        }
+        esp_apptrace_uart_wake_tx_task(hw_data);
+        vTaskDelay(1);
+    }
     return ESP_OK;
 }
 
 static esp_err_t esp_apptrace_uart_flush(esp_apptrace_uart_data_t *hw_data, esp_apptrace_tmo_t *tmo)
 {
-    return ESP_OK;
+    return esp_apptrace_uart_flush_nolock(hw_data, 0, tmo);
 }
 
 #endif // APPTRACE_DEST_UART
@@ -35,6 +35,15 @@
 
 #define SUB_TYPE_ID(i) (i & 0x0F)
 #define ALIGN_UP(num, align) (((num) + ((align) - 1)) & ~((align) - 1))
+#define ALIGN_DOWN(num, align) ((num) & ~((align) - 1))
+
+/* Sequential writes erase the partition ahead of the data up to the next 64 KB flash block,
+ * so that the flash driver can use block erase instead of one sector erase per 4 KB written */
+#define OTA_ERASE_AHEAD_SIZE    0x10000
+
+#define OTA_WRITE_BUF_SIZE      CONFIG_APP_UPDATE_WRITE_BUF_SIZE
+
+_Static_assert(OTA_WRITE_BUF_SIZE % 256 == 0, "esp_ota_write() buffer size must be a multiple of the flash page size");
 
 /* Partial_data is word aligned so no reallocation is necessary for encrypted flash write */
 typedef struct ota_ops_entry_ {
@@ -45,9 +54,12 @@ typedef struct ota_ops_entry_ {
         bool finalize_with_copy;             /*!< Flag to copy the image from staging partition to the final partition at the end of OTA update */
     } partition;
     bool need_erase;
-    uint32_t wrote_size;
-    uint8_t partial_bytes;
+    uint32_t erased_size;                    /*!< Size of the staging partition erased by sequential writes so far */
+    uint32_t wrote_size;                     /*!< Size of the data written to flash, not counting the buffered data */
     bool ota_resumption;
+    uint8_t *write_buf;                      /*!< Buffer aggregating the data of esp_ota_write() into flash aligned blocks, NULL if not allocated */
+    uint32_t write_buf_len;                  /*!< Data waiting in write_buf, or in partial_data if write_buf is NULL */
+    esp_image_stream_verify_handle_t verify; /*!< Verification of the app image as it is written, NULL if the image is read back */
     WORD_ALIGNED_ATTR uint8_t partial_data[16];
     LIST_ENTRY(ota_ops_entry_) entries;
 } ota_ops_entry_t;
@@ -57,6 +69,9 @@ static LIST_HEAD(ota_ops_entries_head, ota_ops_entry_) s_ota_ops_entries_head =
 
 static uint32_t s_ota_ops_last_handle = 0;
 
+/* App partition verified by the last esp_ota_end() from the written data, esp_ota_set_boot_partition() does not read it back */
+static const esp_partition_t *s_ota_verified_partition;
+
 const static char *TAG = "esp_ota_ops";
 
 static ota_ops_entry_t *get_ota_ops_entry(esp_ota_handle_t handle);
@@ -134,9 +149,24 @@ static ota_ops_entry_t* esp_ota_init_entry(const esp_partition_t *partition)
     new_entry->partition.finalize_with_copy = false;
     new_entry->handle = ++s_ota_ops_last_handle;
 
+#if OTA_WRITE_BUF_SIZE > 0
+    new_entry->write_buf = malloc(OTA_WRITE_BUF_SIZE);
+    if (new_entry->write_buf == NULL) {
+        ESP_LOGW(TAG, "no memory for write buffer, data is written as it comes");
+    }
+#endif
+
     return new_entry;
 }
 
+static void esp_ota_free_entry(ota_ops_entry_t *it)
+{
+    LIST_REMOVE(it, entries);
+    esp_image_stream_verify_abort(it->verify);
+    free(it->write_buf);
+    free(it);
+}
+
 
 esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp_ota_handle_t *out_handle)
 {
@@ -176,6 +206,9 @@ esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp
     if (new_entry == NULL) {
         return ESP_ERR_NO_MEM;
     }
+    if (s_ota_verified_partition == partition) {
+        s_ota_verified_partition = NULL;
+    }
     new_entry->need_erase = (image_size == OTA_WITH_SEQUENTIAL_WRITES);
     *out_handle = new_entry->handle;
 
@@ -242,6 +275,9 @@ esp_err_t esp_ota_resume(const esp_partition_t *partition, const size_t erase_si
     if (new_entry == NULL) {
         return ESP_ERR_NO_MEM;
     }
+    if (s_ota_verified_partition == partition) {
+        s_ota_verified_partition = NULL;
+    }
 
     if (partition->type == ESP_PARTITION_TYPE_BOOTLOADER) {
         esp_image_bootloader_offset_set(partition->address);
@@ -253,6 +289,8 @@ esp_err_t esp_ota_resume(const esp_partition_t *partition, const size_t erase_si
     new_entry->ota_resumption = true;
     new_entry->wrote_size = image_offset;
     new_entry->need_erase = (erase_size == OTA_WITH_SEQUENTIAL_WRITES);
+    // The sector holding an unaligned resumption offset has been erased before the interruption
+    new_entry->erased_size = ALIGN_UP(image_offset, partition->erase_size);
     *out_handle = new_entry->handle;
     return ESP_OK;
 }
@@ -270,7 +308,7 @@ esp_err_t esp_ota_set_final_partition(esp_ota_handle_t handle, const esp_partiti
     // If OTA resumption is enabled, it->wrote_size may already contain the size of previously written data.
     // Ensure that wrote_size is zero only when OTA resumption is disabled, as any non-zero value in this case
     // indicates an invalid state.
-    if (!it->ota_resumption && it->wrote_size != 0) {
+    if (!it->ota_resumption && (it->wrote_size != 0 || it->write_buf_len != 0)) {
         return ESP_ERR_INVALID_STATE;
     }
 
@@ -292,6 +330,134 @@ esp_err_t esp_ota_set_final_partition(esp_ota_handle_t handle, const esp_partiti
     return ESP_OK;
 }
 
+/* Erase the staging partition ahead of a sequential write ending at the given offset */
+static esp_err_t ota_erase_ahead(ota_ops_entry_t *it, uint32_t end)
+{
+    const esp_partition_t *partition = it->partition.staging;
+    if (!it->need_erase || end <= it->erased_size) {
+        return ESP_OK;
+    }
+
+    // Align the end of the erased range to a flash block, so that the whole blocks are erased at once
+    uint32_t erase_end = ALIGN_UP(partition->address + end, OTA_ERASE_AHEAD_SIZE) - partition->address;
+    erase_end = MIN(erase_end, partition->size);
+    if (erase_end <= it->erased_size) {
+        // Out of the partition bounds, esp_partition_write() reports it
+        return ESP_OK;
+    }
+    esp_err_t ret = esp_partition_erase_range(partition, it->erased_size, erase_end - it->erased_size);
+    if (ret == ESP_OK) {
+        it->erased_size = erase_end;
+    }
+    return ret;
+}
+
+/* Start verifying the app image from the written data, it is read back by esp_ota_end() if this is not possible */
+static void ota_start_stream_verify(ota_ops_entry_t *it)
+{
+#if !CONFIG_APP_UPDATE_VERIFY_READBACK
+    if (it->ota_resumption || it->partition.final->type != ESP_PARTITION_TYPE_APP) {
+        return;
+    }
+    const esp_partition_pos_t part_pos = {
+        .offset = it->partition.staging->address,
+        .size = it->partition.staging->size,
+    };
+    esp_err_t err = esp_image_stream_verify_begin(&part_pos, &it->verify);
+    if (err != ESP_OK) {
+        ESP_LOGD(TAG, "image will be read back for verification (0x%x)", err);
+        it->verify = NULL;
+    }
+#endif
+}
+
+/* Write data to flash right after the data written so far */
+static esp_err_t ota_flash_write(ota_ops_entry_t *it, const void *data, size_t size)
+{
+    esp_err_t ret = ota_erase_ahead(it, it->wrote_size + size);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = esp_partition_write(it->partition.staging, it->wrote_size, data, size);
+    if (ret == ESP_OK) {
+        it->wrote_size += size;
+    }
+    return ret;
+}
+
+/* Write the buffered data to flash. With flash encryption, the data is written in 16 byte blocks,
+ * the last block is either padded or left in the buffer */
+static esp_err_t ota_flush_buffer(ota_ops_entry_t *it, bool pad)
+{
+    uint8_t *buf = it->write_buf ? it->write_buf : it->partial_data;
+    size_t len = it->write_buf_len;
+    if (esp_flash_encryption_enabled()) {
+        if (pad) {
+            memset(buf + len, 0xFF, ALIGN_UP(len, 16) - len);
+            len = ALIGN_UP(len, 16);
+        } else {
+            len = ALIGN_DOWN(len, 16);
+        }
+    }
+    if (len == 0) {
+        return ESP_OK;
+    }
+
+    esp_err_t ret = ota_flash_write(it, buf, len);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    if (len < it->write_buf_len) {
+        memmove(buf, buf + len, it->write_buf_len - len);
+        it->write_buf_len -= len;
+    } else {
+        it->write_buf_len = 0;
+    }
+    return ESP_OK;
+}
+
+/* Write data after the data written so far, gathering it into flash aligned blocks */
+static esp_err_t ota_buffered_write(ota_ops_entry_t *it, const uint8_t *data_bytes, size_t size)
+{
+    esp_err_t ret;
+
+    /* Without the write buffer, only the encrypted flash writes need to be cached in 16 byte blocks */
+    size_t block_size = it->write_buf ? OTA_WRITE_BUF_SIZE : (esp_flash_encryption_enabled() ? 16 : 0);
+    if (block_size == 0) {
+        return ota_flash_write(it, data_bytes, size);
+    }
+
+    uint8_t *buf = it->write_buf ? it->write_buf : it->partial_data;
+    while (size > 0) {
+        // bytes missing to the end of the current flash aligned block
+        size_t block_left = block_size - ((it->wrote_size + it->write_buf_len) % block_size);
+        if (it->write_buf_len == 0 && size >= block_left) {
+            // nothing is buffered, write the whole blocks straight from the caller's data
+            size_t len = block_left + ALIGN_DOWN(size - block_left, block_size);
+            ret = ota_flash_write(it, data_bytes, len);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+            data_bytes += len;
+            size -= len;
+            continue;
+        }
+
+        size_t copy_len = MIN(block_left, size);
+        memcpy(buf + it->write_buf_len, data_bytes, copy_len);
+        it->write_buf_len += copy_len;
+        data_bytes += copy_len;
+        size -= copy_len;
+        if (copy_len == block_left) {
+            ret = ota_flush_buffer(it, false);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
 esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
 {
     const uint8_t *data_bytes = (const uint8_t *)data;
@@ -309,82 +475,49 @@ esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
     }
 
     // find ota handle in linked list
-    for (it = LIST_FIRST(&s_ota_ops_entries_head); it != NULL; it = LIST_NEXT(it, entries)) {
-        if (it->handle == handle) {
-            if (it->need_erase) {
-                // must erase the partition before writing to it
-                uint32_t first_sector = it->wrote_size / it->partition.staging->erase_size; // first affected sector
-                uint32_t last_sector = (it->wrote_size + size - 1) / it->partition.staging->erase_size; // last affected sector
-
-                ret = ESP_OK;
-                if ((it->wrote_size % it->partition.staging->erase_size) == 0) {
-                    ret = esp_partition_erase_range(it->partition.staging, it->wrote_size, ((last_sector - first_sector) + 1) * it->partition.staging->erase_size);
-                } else if (first_sector != last_sector) {
-                    ret = esp_partition_erase_range(it->partition.staging, (first_sector + 1) * it->partition.staging->erase_size, (last_sector - first_sector) * it->partition.staging->erase_size);
-                }
-                if (ret != ESP_OK) {
-                    return ret;
-                }
-            }
-
-            if (it->wrote_size == 0 && it->partial_bytes == 0 && size > 0) {
-                if (it->partition.final->type == ESP_PARTITION_TYPE_APP || it->partition.final->type == ESP_PARTITION_TYPE_BOOTLOADER) {
-                    if (data_bytes[0] != ESP_IMAGE_HEADER_MAGIC) {
-                        ESP_LOGE(TAG, "OTA image has invalid magic byte (expected 0xE9, saw 0x%02x)", data_bytes[0]);
-                        return ESP_ERR_OTA_VALIDATE_FAILED;
-                    }
-
-                } else if (it->partition.final->type == ESP_PARTITION_TYPE_PARTITION_TABLE) {
-                    if (*(uint16_t*)data_bytes != (uint16_t)ESP_PARTITION_MAGIC) {
-                        ESP_LOGE(TAG, "Partition table image has invalid magic word (expected 0x50AA, saw 0x%04x)", *(uint16_t*)data_bytes);
-                        return ESP_ERR_OTA_VALIDATE_FAILED;
-                    }
-                }
-            }
-
-            if (esp_flash_encryption_enabled()) {
-                /* Can only write 16 byte blocks to flash, so need to cache anything else */
-                size_t copy_len;
-
-                /* check if we have partially written data from earlier */
-                if (it->partial_bytes != 0) {
-                    copy_len = MIN(16 - it->partial_bytes, size);
-                    memcpy(it->partial_data + it->partial_bytes, data_bytes, copy_len);
-                    it->partial_bytes += copy_len;
-                    if (it->partial_bytes != 16) {
-                        return ESP_OK; /* nothing to write yet, just filling buffer */
-                    }
-                    /* write 16 byte to partition */
-                    ret = esp_partition_write(it->partition.staging, it->wrote_size, it->partial_data, 16);
-                    if (ret != ESP_OK) {
-                        return ret;
-                    }
-                    it->partial_bytes = 0;
-                    memset(it->partial_data, 0xFF, 16);
-                    it->wrote_size += 16;
-                    data_bytes += copy_len;
-                    size -= copy_len;
-                }
+    it = get_ota_ops_entry(handle);
+    if (it == NULL) {
+        ESP_LOGE(TAG,"not found the handle");
+        return ESP_ERR_INVALID_ARG;
+    }
 
-                /* check if we need to save trailing data that we're about to write */
-                it->partial_bytes = size % 16;
-                if (it->partial_bytes != 0) {
-                    size -= it->partial_bytes;
-                    memcpy(it->partial_data, data_bytes + size, it->partial_bytes);
-                }
+    if (it->wrote_size == 0 && it->write_buf_len == 0) {
+        if (it->partition.final->type == ESP_PARTITION_TYPE_APP || it->partition.final->type == ESP_PARTITION_TYPE_BOOTLOADER) {
+            if (data_bytes[0] != ESP_IMAGE_HEADER_MAGIC) {
+                ESP_LOGE(TAG, "OTA image has invalid magic byte (expected 0xE9, saw 0x%02x)", data_bytes[0]);
+                return ESP_ERR_OTA_VALIDATE_FAILED;
             }
+            ota_start_stream_verify(it);
 
-            ret = esp_partition_write(it->partition.staging, it->wrote_size, data_bytes, size);
-            if(ret == ESP_OK){
-                it->wrote_size += size;
+        } else if (it->partition.final->type == ESP_PARTITION_TYPE_PARTITION_TABLE) {
+            if (*(uint16_t*)data_bytes != (uint16_t)ESP_PARTITION_MAGIC) {
+                ESP_LOGE(TAG, "Partition table image has invalid magic word (expected 0x50AA, saw 0x%04x)", *(uint16_t*)data_bytes);
+                return ESP_ERR_OTA_VALIDATE_FAILED;
             }
-            return ret;
         }
     }
 
-    //if go to here ,means don't find the handle
-    ESP_LOGE(TAG,"not found the handle");
-    return ESP_ERR_INVALID_ARG;
+    if (it->verify != NULL && esp_image_stream_verify_data(it->verify, data_bytes, size) != ESP_OK) {
+        // Keep writing, the caller sees the verification error from esp_ota_end() as with a read back image
+        ESP_LOGD(TAG, "OTA image is invalid, esp_ota_end() will fail");
+    }
+
+    ret = ota_buffered_write(it, data_bytes, size);
+    if (ret != ESP_OK && it->verify != NULL) {
+        // the data may be written again, read the image back to verify it
+        esp_image_stream_verify_abort(it->verify);
+        it->verify = NULL;
+    }
+    return ret;
+}
+
+esp_err_t esp_ota_flush(esp_ota_handle_t handle)
+{
+    ota_ops_entry_t *it = get_ota_ops_entry(handle);
+    if (it == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ota_flush_buffer(it, false);
 }
 
 esp_err_t esp_ota_write_with_offset(esp_ota_handle_t handle, const void *data, size_t size, uint32_t offset)
@@ -411,6 +544,14 @@ esp_err_t esp_ota_write_with_offset(esp_ota_handle_t handle, const void *data, s
                 ESP_LOGE(TAG, "Size should be 16byte aligned for flash encryption case");
                 return ESP_ERR_INVALID_ARG;
             }
+            // data given to esp_ota_write earlier must not be written after this one
+            ret = ota_flush_buffer(it, false);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+            // the image is not written in order any more, read it back to verify it
+            esp_image_stream_verify_abort(it->verify);
+            it->verify = NULL;
             ret = esp_partition_write(it->partition.staging, offset, data_bytes, size);
             if (ret == ESP_OK) {
                 it->wrote_size += size;
@@ -442,8 +583,7 @@ esp_err_t esp_ota_abort(esp_ota_handle_t handle)
     if (it == NULL) {
         return ESP_ERR_NOT_FOUND;
     }
-    LIST_REMOVE(it, entries);
-    free(it);
+    esp_ota_free_entry(it);
     return ESP_OK;
 }
 
@@ -487,29 +627,33 @@ esp_err_t esp_ota_end(esp_ota_handle_t handle)
     /* 'it' holds the ota_ops_entry_t for 'handle' */
 
     // esp_ota_end() is only valid if some data was written to this handle
-    if (it->wrote_size == 0) {
+    if (it->wrote_size == 0 && it->write_buf_len == 0) {
         ret = ESP_ERR_INVALID_ARG;
         goto cleanup;
     }
 
-    if (it->partial_bytes > 0) {
-        /* Write out last 16 bytes, if necessary */
-        ret = esp_partition_write(it->partition.staging, it->wrote_size, it->partial_data, 16);
-        if (ret != ESP_OK) {
-            ret = ESP_ERR_INVALID_STATE;
-            goto cleanup;
-        }
-        it->wrote_size += 16;
-        it->partial_bytes = 0;
+    /* Write out the buffered data, padded to 16 bytes for encrypted flash */
+    ret = ota_flush_buffer(it, true);
+    if (ret != ESP_OK) {
+        ret = ESP_ERR_INVALID_STATE;
+        goto cleanup;
     }
 
-    ret = ota_verify_partition(it);
+    if (it->verify != NULL) {
+        ret = esp_image_stream_verify_end(it->verify, NULL);
+        it->verify = NULL;
+        ret = (ret == ESP_OK) ? ESP_OK : ESP_ERR_OTA_VALIDATE_FAILED;
+    } else {
+        ret = ota_verify_partition(it);
+    }
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "New image failed verification");
     } else {
         if (it->partition.finalize_with_copy) {
             ESP_LOGI(TAG, "Copy from <%s> staging partition to <%s>...", it->partition.staging->label, it->partition.final->label);
             ret = esp_partition_copy(it->partition.final, 0, it->partition.staging, 0, it->partition.final->size);
+        } else if (it->partition.final->type == ESP_PARTITION_TYPE_APP) {
+            s_ota_verified_partition = it->partition.staging;
         }
     }
 
@@ -518,8 +662,7 @@ esp_err_t esp_ota_end(esp_ota_handle_t handle)
         // In esp_ota_begin, bootloader offset was updated, here we return it to default.
         esp_image_bootloader_offset_set(ESP_PRIMARY_BOOTLOADER_OFFSET);
     }
-    LIST_REMOVE(it, entries);
-    free(it);
+    esp_ota_free_entry(it);
     return ret;
 }
 
@@ -602,7 +745,9 @@ esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (image_validate(partition, ESP_IMAGE_VERIFY) != ESP_OK) {
+    if (partition == s_ota_verified_partition) {
+        ESP_LOGD(TAG, "partition <%s> verified by esp_ota_end()", partition->label);
+    } else if (image_validate(partition, ESP_IMAGE_VERIFY) != ESP_OK) {
         return ESP_ERR_OTA_VALIDATE_FAILED;
     }
 
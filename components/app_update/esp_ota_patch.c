@@ -0,0 +1,370 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "sys/param.h"
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_rom_md5.h"
+#include "esp_ota_ops.h"
+#include "esp_ota_patch.h"
+#include "miniz.h"
+
+#define OUT_BUF_SIZE        4096
+
+/* Largest number of argument bytes of a command */
+#define MAX_ARGS_SIZE       8
+
+static const char *TAG = "esp_ota_patch";
+
+struct esp_ota_patch_ctx {
+    esp_ota_handle_t ota_handle;
+    const esp_partition_t *base;
+    esp_err_t err;                      /* error which made the patch fail, returned for any further call */
+    esp_ota_patch_header_t header;
+    size_t header_len;                  /* number of header bytes received so far */
+    struct {                            /* decompressor, if ESP_OTA_PATCH_FLAG_COMPRESSED is set */
+        tinfl_decompressor *decomp;
+        uint8_t *window;
+        size_t window_size;
+        size_t window_pos;
+        bool done;
+    } inflate;
+    uint8_t cmd;                        /* command being received */
+    uint8_t args[MAX_ARGS_SIZE];
+    size_t args_len;                    /* number of argument bytes of cmd received so far, SIZE_MAX while waiting for a command */
+    uint32_t base_offset;               /* for ESP_OTA_PATCH_CMD_ADD, position in the base of the next byte */
+    uint32_t data_remaining;            /* bytes still to be received for ESP_OTA_PATCH_CMD_ADD or ESP_OTA_PATCH_CMD_INSERT */
+    uint32_t image_len;                 /* bytes of the image covered by the commands received so far */
+    size_t out_len;
+    uint8_t out[OUT_BUF_SIZE];          /* image bytes to be written with esp_ota_write */
+};
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static esp_err_t flush_out(struct esp_ota_patch_ctx *ctx)
+{
+    esp_err_t err = esp_ota_write(ctx->ota_handle, ctx->out, ctx->out_len);
+    ctx->out_len = 0;
+    return err;
+}
+
+static esp_err_t check_base(struct esp_ota_patch_ctx *ctx)
+{
+    const esp_ota_patch_header_t *header = &ctx->header;
+    if (header->base_size > ctx->base->size) {
+        ESP_LOGE(TAG, "Patch needs 0x%" PRIx32 " bytes of base, partition has 0x%" PRIx32, header->base_size, ctx->base->size);
+        return ESP_ERR_OTA_PATCH_BASE_MISMATCH;
+    }
+
+    // the output buffer is still unused, read the base through it
+    md5_context_t md5;
+    esp_rom_md5_init(&md5);
+    for (uint32_t offset = 0; offset < header->base_size; offset += OUT_BUF_SIZE) {
+        size_t len = MIN(OUT_BUF_SIZE, header->base_size - offset);
+        esp_err_t err = esp_partition_read(ctx->base, offset, ctx->out, len);
+        if (err != ESP_OK) {
+            return err;
+        }
+        esp_rom_md5_update(&md5, ctx->out, len);
+    }
+    uint8_t digest[ESP_ROM_MD5_DIGEST_LEN];
+    esp_rom_md5_final(digest, &md5);
+    if (memcmp(digest, header->base_md5, sizeof(digest)) != 0) {
+        ESP_LOGE(TAG, "Patch was created against a different base");
+        return ESP_ERR_OTA_PATCH_BASE_MISMATCH;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t parse_header(struct esp_ota_patch_ctx *ctx)
+{
+    const esp_ota_patch_header_t *header = &ctx->header;
+    if (header->magic != ESP_OTA_PATCH_MAGIC) {
+        ESP_LOGE(TAG, "Invalid patch magic 0x%08" PRIx32, header->magic);
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    if (header->version != ESP_OTA_PATCH_VERSION || (header->flags & ~ESP_OTA_PATCH_FLAG_COMPRESSED) != 0) {
+        ESP_LOGE(TAG, "Unsupported patch version %d, flags 0x%02x", header->version, header->flags);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    esp_err_t err = check_base(ctx);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (header->flags & ESP_OTA_PATCH_FLAG_COMPRESSED) {
+        if (header->window_bits < 9 || header->window_bits > 15) {
+            ESP_LOGE(TAG, "Invalid window size 2^%d", header->window_bits);
+            return ESP_ERR_OTA_VALIDATE_FAILED;
+        }
+        // the decompressor checks that the window given in the zlib header fits into this one
+        ctx->inflate.window_size = 1 << header->window_bits;
+        ctx->inflate.window = malloc(ctx->inflate.window_size);
+        ctx->inflate.decomp = malloc(sizeof(tinfl_decompressor));
+        if (ctx->inflate.window == NULL || ctx->inflate.decomp == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        tinfl_init(ctx->inflate.decomp);
+    }
+    ESP_LOGD(TAG, "Patch to 0x%" PRIx32 " bytes, using 0x%" PRIx32 " bytes of base, flags 0x%02x",
+             header->image_size, header->base_size, header->flags);
+    return ESP_OK;
+}
+
+/* Copy len bytes of the base at base_offset to the output */
+static esp_err_t copy_base(struct esp_ota_patch_ctx *ctx, uint32_t base_offset, uint32_t len)
+{
+    while (len > 0) {
+        size_t chunk = MIN(len, OUT_BUF_SIZE - ctx->out_len);
+        esp_err_t err = esp_partition_read(ctx->base, base_offset, ctx->out + ctx->out_len, chunk);
+        if (err != ESP_OK) {
+            return err;
+        }
+        ctx->out_len += chunk;
+        base_offset += chunk;
+        len -= chunk;
+        if (ctx->out_len == OUT_BUF_SIZE) {
+            err = flush_out(ctx);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+/* Handle a command whose arguments have been received completely */
+static esp_err_t start_command(struct esp_ota_patch_ctx *ctx)
+{
+    uint32_t base_offset = 0;
+    uint32_t len;
+    if (ctx->cmd == ESP_OTA_PATCH_CMD_INSERT) {
+        len = get_le32(ctx->args);
+    } else {
+        base_offset = get_le32(ctx->args);
+        len = get_le32(ctx->args + 4);
+        if (base_offset > ctx->header.base_size || len > ctx->header.base_size - base_offset) {
+            ESP_LOGE(TAG, "Command refers to 0x%" PRIx32 " bytes at 0x%" PRIx32 ", outside of the base", len, base_offset);
+            return ESP_ERR_OTA_VALIDATE_FAILED;
+        }
+    }
+    if (len > ctx->header.image_size - ctx->image_len) {
+        ESP_LOGE(TAG, "Patch produces more than 0x%" PRIx32 " bytes", ctx->header.image_size);
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    ctx->image_len += len;
+
+    if (ctx->cmd == ESP_OTA_PATCH_CMD_COPY) {
+        return copy_base(ctx, base_offset, len);
+    }
+    ctx->base_offset = base_offset;
+    ctx->data_remaining = len;
+    return ESP_OK;
+}
+
+/* Handle the data following an ESP_OTA_PATCH_CMD_ADD or ESP_OTA_PATCH_CMD_INSERT command */
+static esp_err_t command_data(struct esp_ota_patch_ctx *ctx, const uint8_t *data, size_t size)
+{
+    uint8_t *out = ctx->out + ctx->out_len;
+    if (ctx->cmd == ESP_OTA_PATCH_CMD_ADD) {
+        esp_err_t err = esp_partition_read(ctx->base, ctx->base_offset, out, size);
+        if (err != ESP_OK) {
+            return err;
+        }
+        for (size_t i = 0; i < size; i++) {
+            out[i] += data[i];
+        }
+        ctx->base_offset += size;
+    } else {
+        memcpy(out, data, size);
+    }
+    ctx->out_len += size;
+    ctx->data_remaining -= size;
+    if (ctx->out_len == OUT_BUF_SIZE) {
+        return flush_out(ctx);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t process_commands(struct esp_ota_patch_ctx *ctx, const uint8_t *data, size_t size)
+{
+    while (size > 0) {
+        esp_err_t err;
+        if (ctx->data_remaining > 0) {
+            size_t chunk = MIN(size, MIN(ctx->data_remaining, OUT_BUF_SIZE - ctx->out_len));
+            err = command_data(ctx, data, chunk);
+            data += chunk;
+            size -= chunk;
+        } else if (ctx->args_len == SIZE_MAX) {
+            ctx->cmd = *data++;
+            size--;
+            if (ctx->cmd > ESP_OTA_PATCH_CMD_INSERT) {
+                ESP_LOGE(TAG, "Invalid command %d", ctx->cmd);
+                return ESP_ERR_OTA_VALIDATE_FAILED;
+            }
+            ctx->args_len = 0;
+            continue;
+        } else {
+            const size_t args_size = (ctx->cmd == ESP_OTA_PATCH_CMD_INSERT) ? 4 : 8;
+            size_t chunk = MIN(size, args_size - ctx->args_len);
+            memcpy(ctx->args + ctx->args_len, data, chunk);
+            ctx->args_len += chunk;
+            data += chunk;
+            size -= chunk;
+            if (ctx->args_len < args_size) {
+                continue;
+            }
+            ctx->args_len = SIZE_MAX;
+            err = start_command(ctx);
+        }
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t inflate_commands(struct esp_ota_patch_ctx *ctx, const uint8_t *data, size_t size)
+{
+    while (size > 0 && !ctx->inflate.done) {
+        size_t in_bytes = size;
+        size_t out_bytes = ctx->inflate.window_size - ctx->inflate.window_pos;
+        uint8_t *out = ctx->inflate.window + ctx->inflate.window_pos;
+        tinfl_status status = tinfl_decompress(ctx->inflate.decomp, data, &in_bytes, ctx->inflate.window, out, &out_bytes,
+                                               TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_HAS_MORE_INPUT);
+        data += in_bytes;
+        size -= in_bytes;
+        if (status < TINFL_STATUS_DONE) {
+            ESP_LOGE(TAG, "Decompressing the patch failed (%d)", status);
+            return ESP_ERR_OTA_VALIDATE_FAILED;
+        }
+        esp_err_t err = process_commands(ctx, out, out_bytes);
+        if (err != ESP_OK) {
+            return err;
+        }
+        ctx->inflate.window_pos = (ctx->inflate.window_pos + out_bytes) & (ctx->inflate.window_size - 1);
+        ctx->inflate.done = (status == TINFL_STATUS_DONE);
+    }
+    if (size > 0) {
+        ESP_LOGE(TAG, "Unexpected data after the end of the compressed patch");
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t patch_write(struct esp_ota_patch_ctx *ctx, const uint8_t *data, size_t size)
+{
+    if (ctx->header_len < sizeof(esp_ota_patch_header_t)) {
+        size_t chunk = MIN(size, sizeof(esp_ota_patch_header_t) - ctx->header_len);
+        memcpy((uint8_t *)&ctx->header + ctx->header_len, data, chunk);
+        ctx->header_len += chunk;
+        data += chunk;
+        size -= chunk;
+        if (ctx->header_len < sizeof(esp_ota_patch_header_t)) {
+            return ESP_OK;
+        }
+        esp_err_t err = parse_header(ctx);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    if (ctx->inflate.decomp != NULL) {
+        return inflate_commands(ctx, data, size);
+    }
+    return process_commands(ctx, data, size);
+}
+
+esp_err_t esp_ota_patch_begin(esp_ota_handle_t ota_handle, const esp_partition_t *base, esp_ota_patch_handle_t *out_handle)
+{
+    if (out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_handle = NULL;
+
+    if (base == NULL) {
+        base = esp_ota_get_running_partition();
+        if (base == NULL) {
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+
+    struct esp_ota_patch_ctx *ctx = calloc(1, sizeof(struct esp_ota_patch_ctx));
+    if (ctx == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ctx->ota_handle = ota_handle;
+    ctx->base = base;
+    ctx->args_len = SIZE_MAX;
+    *out_handle = ctx;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_patch_write(esp_ota_patch_handle_t handle, const void *data, size_t size)
+{
+    if (handle == NULL || data == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->err == ESP_OK) {
+        handle->err = patch_write(handle, data, size);
+    }
+    return handle->err;
+}
+
+esp_err_t esp_ota_patch_end(esp_ota_patch_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = handle->err;
+    if (err == ESP_OK) {
+        bool complete = handle->header_len == sizeof(esp_ota_patch_header_t)
+                        && handle->image_len == handle->header.image_size
+                        && handle->data_remaining == 0 && handle->args_len == SIZE_MAX
+                        && (handle->inflate.decomp == NULL || handle->inflate.done);
+        if (complete) {
+            err = flush_out(handle);
+        } else {
+            ESP_LOGE(TAG, "Patch is incomplete");
+            err = ESP_ERR_OTA_VALIDATE_FAILED;
+        }
+    }
+    esp_ota_patch_abort(handle);
+    return err;
+}
+
+void esp_ota_patch_abort(esp_ota_patch_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    free(handle->inflate.decomp);
+    free(handle->inflate.window);
+    free(handle);
+}
+
+bool esp_ota_patch_is_patch(const void *data, size_t size)
+{
+    uint32_t magic;
+    if (data == NULL || size < sizeof(esp_ota_patch_header_t)) {
+        return false;
+    }
+    memcpy(&magic, data, sizeof(magic));
+    return magic == ESP_OTA_PATCH_MAGIC;
+}
@@ -0,0 +1,154 @@
+#!/usr/bin/env python
+#
+# gen_ota_patch creates OTA patches, which esp_ota_patch_write() turns back into the image
+# while it is written to the update partition. A patch can describe the image relative to a base
+# image, usually the app running on the device, and it can be compressed.
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+import argparse
+import hashlib
+import struct
+import sys
+import zlib
+
+__version__ = '1.0'
+
+# Keep in sync with esp_ota_patch.h
+PATCH_MAGIC = 0x50544F45
+PATCH_VERSION = 1
+PATCH_FLAG_COMPRESSED = 1 << 0
+PATCH_HEADER = struct.Struct('<IBBBBI16sI')
+
+CMD_COPY = 0
+CMD_ADD = 1
+CMD_INSERT = 2
+
+# Length of the exact match needed to start a command using the base
+BLOCK_SIZE = 16
+# Distance of the base positions which are indexed. As the image is searched at every position,
+# all common runs of at least BLOCK_SIZE + INDEX_STEP - 1 bytes are found.
+INDEX_STEP = 8
+# An approximate match ends once it has this many more mismatching than matching bytes
+MAX_MISMATCH_SCORE = 64
+
+
+def build_index(base):  # type: (bytes) -> dict
+    index = {}
+    for pos in range(0, len(base) - BLOCK_SIZE + 1, INDEX_STEP):
+        index.setdefault(base[pos:pos + BLOCK_SIZE], pos)
+    return index
+
+
+def extend_match(base, base_pos, image, image_pos):  # type: (bytes, int, bytes, int) -> int
+    """
+    Returns the length of the approximate match starting at the given positions: the length at which the number of
+    matching minus the number of mismatching bytes is largest. Bytes which differ can still be encoded
+    compactly by CMD_ADD, and the differences compress well, e.g. where addresses in code have changed.
+    """
+    end = min(len(base) - base_pos, len(image) - image_pos)
+    score = best_score = best_len = 0
+    for i in range(end):
+        score += 1 if base[base_pos + i] == image[image_pos + i] else -1
+        if score > best_score:
+            best_score = score
+            best_len = i + 1
+        elif score < best_score - MAX_MISMATCH_SCORE:
+            break
+    return best_len
+
+
+def diff(base, image):  # type: (bytes, bytes) -> list
+    """ Returns the commands producing image from base, as a list of (command, base offset, length) tuples """
+    index = build_index(base)
+    commands = []
+    literal_start = 0
+    pos = 0
+    shift = None  # base position minus image position of the previous match
+    while pos + BLOCK_SIZE <= len(image):
+        block = image[pos:pos + BLOCK_SIZE]
+        base_pos = None
+        # code and data are often shifted by the same amount as they were in the previous match
+        if shift is not None and 0 <= pos + shift <= len(base) - BLOCK_SIZE and base[pos + shift:pos + shift + BLOCK_SIZE] == block:
+            base_pos = pos + shift
+        else:
+            base_pos = index.get(block)
+        if base_pos is None:
+            pos += 1
+            continue
+
+        while pos > literal_start and base_pos > 0 and image[pos - 1] == base[base_pos - 1]:
+            pos -= 1
+            base_pos -= 1
+        length = extend_match(base, base_pos, image, pos)
+        if pos > literal_start:
+            commands.append((CMD_INSERT, literal_start, pos - literal_start))
+        commands.append((CMD_ADD, base_pos, length))
+        pos += length
+        literal_start = pos
+        shift = base_pos - (pos - length)
+    if literal_start < len(image):
+        commands.append((CMD_INSERT, literal_start, len(image) - literal_start))
+    return commands
+
+
+def encode_commands(base, image, commands):  # type: (bytes, bytes, list) -> bytes
+    out = bytearray()
+    image_pos = 0
+    for cmd, offset, length in commands:
+        if cmd == CMD_INSERT:
+            out += struct.pack('<BI', CMD_INSERT, length)
+            out += image[offset:offset + length]
+        else:
+            delta = bytes((image[image_pos + i] - base[offset + i]) & 0xFF for i in range(length))
+            if delta.count(0) == length:
+                out += struct.pack('<BII', CMD_COPY, offset, length)
+            else:
+                out += struct.pack('<BII', CMD_ADD, offset, length)
+                out += delta
+        image_pos += length
+    return bytes(out)
+
+
+def create_patch(image, base=None, compress=True, window_bits=15):  # type: (bytes, bytes, bool, int) -> bytes
+    if base:
+        commands = diff(base, image)
+    else:
+        base = b''
+        commands = [(CMD_INSERT, 0, len(image))]
+    body = encode_commands(base, image, commands)
+
+    flags = 0
+    if compress:
+        compressor = zlib.compressobj(9, zlib.DEFLATED, window_bits)
+        body = compressor.compress(body) + compressor.flush()
+        flags |= PATCH_FLAG_COMPRESSED
+    header = PATCH_HEADER.pack(PATCH_MAGIC, PATCH_VERSION, flags, window_bits if compress else 0, 0,
+                               len(base), hashlib.md5(base).digest(), len(image))
+    return header + body
+
+
+def main():  # type: () -> None
+    parser = argparse.ArgumentParser(description='ESP-IDF OTA patch generator v{}'.format(__version__))
+    parser.add_argument('image', help='Image the patch produces', type=argparse.FileType('rb'))
+    parser.add_argument('output', help='Patch file to write', type=argparse.FileType('wb'))
+    parser.add_argument('--base', help='Image the device is running, which the patch refers to. '
+                        'Without it, the patch only compresses the image.', type=argparse.FileType('rb'))
+    parser.add_argument('--no-compress', help='Do not compress the patch', action='store_true')
+    parser.add_argument('--window-bits', help='Base two logarithm of the compression window size. The device '
+                        'needs a buffer of this size to apply the patch. (default: %(default)s)',
+                        type=int, choices=range(9, 16), default=15, metavar='{9..15}')
+    args = parser.parse_args()
+
+    image = args.image.read()
+    base = args.base.read() if args.base else None
+    patch = create_patch(image, base, not args.no_compress, args.window_bits)
+    args.output.write(patch)
+    print('Image of {} bytes encoded into a patch of {} bytes'.format(len(image), len(patch)))
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except KeyboardInterrupt:
+        sys.exit(2)
@@ -32,6 +32,7 @@ extern "C"
 #define ESP_ERR_OTA_SMALL_SEC_VER                (ESP_ERR_OTA_BASE + 0x04)  /*!< Error if the firmware has a secure version less than the running firmware. */
 #define ESP_ERR_OTA_ROLLBACK_FAILED              (ESP_ERR_OTA_BASE + 0x05)  /*!< Error if flash does not have valid firmware in passive partition and hence rollback is not possible */
 #define ESP_ERR_OTA_ROLLBACK_INVALID_STATE       (ESP_ERR_OTA_BASE + 0x06)  /*!< Error if current active firmware is still marked in pending validation state (ESP_OTA_IMG_PENDING_VERIFY), essentially first boot of firmware image post upgrade and hence firmware upgrade is not possible */
+#define ESP_ERR_OTA_PATCH_BASE_MISMATCH          (ESP_ERR_OTA_BASE + 0x07)  /*!< Error if an OTA patch was created against a different base image */
 
 
 /**
@@ -162,12 +163,16 @@ esp_err_t esp_ota_set_final_partition(esp_ota_handle_t handle, const esp_partiti
  * data is received during the OTA operation. Data is written
  * sequentially to the partition.
  *
+ * The data is gathered in a buffer of CONFIG_APP_UPDATE_WRITE_BUF_SIZE bytes and written to flash
+ * in blocks aligned to the buffer size, regardless of the size of the chunks passed to this function.
+ * With OTA_WITH_SEQUENTIAL_WRITES, the partition is erased ahead of the data up to the next 64 KB flash block.
+ *
  * @param handle  Handle obtained from esp_ota_begin
  * @param data    Data buffer to write
  * @param size    Size of data buffer in bytes.
  *
  * @return
- *    - ESP_OK: Data was written to flash successfully, or size = 0
+ *    - ESP_OK: Data was written to flash or buffered successfully, or size = 0
  *    - ESP_ERR_INVALID_ARG: handle is invalid.
  *    - ESP_ERR_OTA_VALIDATE_FAILED: First byte of image contains invalid image magic byte.
  *    - ESP_ERR_FLASH_OP_TIMEOUT or ESP_ERR_FLASH_OP_FAIL: Flash write failed.
@@ -176,6 +181,26 @@ esp_err_t esp_ota_set_final_partition(esp_ota_handle_t handle, const esp_partiti
  */
 esp_err_t esp_ota_write(esp_ota_handle_t handle, const void* data, size_t size);
 
+/**
+ * @brief   Write the data buffered by esp_ota_write() to flash
+ *
+ * esp_ota_end() writes the buffered data itself, this function is only needed when the data given to esp_ota_write()
+ * must be in flash before the update ends, e.g. to read the image back from the partition or to store the progress
+ * for esp_ota_resume().
+ *
+ * @note If flash encryption is enabled, the last (size % 16) bytes stay buffered, as flash can only be written
+ *       in 16 byte blocks. These bytes are not in flash until more data is written or esp_ota_end() is called.
+ *
+ * @param handle  Handle obtained from esp_ota_begin
+ *
+ * @return
+ *    - ESP_OK: Buffered data was written to flash successfully, or nothing was buffered.
+ *    - ESP_ERR_NOT_FOUND: OTA handle was not found.
+ *    - ESP_ERR_FLASH_OP_TIMEOUT or ESP_ERR_FLASH_OP_FAIL: Flash write failed.
+ *    - or one of error codes from lower-level flash driver.
+ */
+esp_err_t esp_ota_flush(esp_ota_handle_t handle);
+
 /**
  * @brief   Write OTA update data to partition at an offset
  *
@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_assert.h"
+#include "esp_partition.h"
+#include "esp_ota_ops.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define ESP_OTA_PATCH_MAGIC             0x50544f45  /*!< "EOTP", first word of a patch */
+#define ESP_OTA_PATCH_VERSION           1           /*!< Version of the patch format described here */
+
+#define ESP_OTA_PATCH_FLAG_COMPRESSED   (1 << 0)    /*!< The commands following the header are a zlib stream */
+
+/**
+ * @brief Header at the start of a patch
+ *
+ * A patch describes an image as a sequence of commands which take data from a base partition,
+ * usually the running app, or from the patch itself. Patches are created by
+ * ``components/app_update/gen_ota_patch.py``. All fields are little endian.
+ *
+ * The header is followed by the commands, which are compressed with zlib if
+ * ESP_OTA_PATCH_FLAG_COMPRESSED is set. Each command starts with a byte of type
+ * esp_ota_patch_cmd_t, followed by its arguments as 32-bit words.
+ */
+typedef struct {
+    uint32_t magic;             /*!< ESP_OTA_PATCH_MAGIC */
+    uint8_t version;            /*!< ESP_OTA_PATCH_VERSION */
+    uint8_t flags;              /*!< ESP_OTA_PATCH_FLAG_x */
+    uint8_t window_bits;        /*!< Base two logarithm of the zlib window size (9..15) if the patch is compressed */
+    uint8_t reserved;           /*!< Reserved, must be 0 */
+    uint32_t base_size;         /*!< Number of bytes at the start of the base partition the patch refers to, 0 if it doesn't use a base */
+    uint8_t base_md5[16];       /*!< MD5 digest of these bytes, to check that the patch is applied to the right base */
+    uint32_t image_size;        /*!< Size of the image the patch produces */
+} __attribute__((packed)) esp_ota_patch_header_t;
+
+ESP_STATIC_ASSERT(sizeof(esp_ota_patch_header_t) == 32, "esp_ota_patch_header_t should be 32 bytes");
+
+/**
+ * @brief Commands of a patch
+ */
+typedef enum {
+    ESP_OTA_PATCH_CMD_COPY = 0,     /*!< Arguments: base offset, length. Copy length bytes from the base */
+    ESP_OTA_PATCH_CMD_ADD = 1,      /*!< Arguments: base offset, length, followed by length bytes. Add each byte to the base byte at the same position (modulo 256) */
+    ESP_OTA_PATCH_CMD_INSERT = 2,   /*!< Arguments: length, followed by length bytes. Take the bytes from the patch */
+} esp_ota_patch_cmd_t;
+
+/**
+ * @brief Opaque handle of a patch being applied
+ */
+typedef struct esp_ota_patch_ctx *esp_ota_patch_handle_t;
+
+/**
+ * @brief Start applying a patch to an OTA update
+ *
+ * The image produced by the patch is written with esp_ota_write() to the update started with
+ * esp_ota_begin(). Once all of the patch has been passed to esp_ota_patch_write(),
+ * esp_ota_patch_end() must be called before esp_ota_end().
+ *
+ * Applying a compressed patch needs a zlib window of 2^window_bits bytes and about 11 KB for the
+ * decompressor, in addition to about 4 KB for buffering the output.
+ *
+ * @param ota_handle  Handle of the OTA update, returned by esp_ota_begin()
+ * @param base        Partition the patch was created against, NULL for the running app partition
+ * @param out_handle  On success, handle of the patch to pass to the other esp_ota_patch functions
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: out_handle is NULL
+ *    - ESP_ERR_NOT_FOUND: base is NULL and the running partition could not be found
+ *    - ESP_ERR_NO_MEM: Cannot allocate memory for the patch
+ */
+esp_err_t esp_ota_patch_begin(esp_ota_handle_t ota_handle, const esp_partition_t *base, esp_ota_patch_handle_t *out_handle);
+
+/**
+ * @brief Pass the next part of a patch
+ *
+ * The parts can have any size. As soon as the header has been received, the base is checked
+ * against its digest, which reads the part of the base the patch refers to.
+ *
+ * After this function has failed, it fails again for any further data.
+ *
+ * @param handle  Handle returned by esp_ota_patch_begin()
+ * @param data    Next part of the patch
+ * @param size    Size of data in bytes
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: handle or data is NULL
+ *    - ESP_ERR_NOT_SUPPORTED: The patch has an unsupported version or flags
+ *    - ESP_ERR_OTA_PATCH_BASE_MISMATCH: The patch was created against a different base
+ *    - ESP_ERR_OTA_VALIDATE_FAILED: The patch is invalid or corrupted
+ *    - ESP_ERR_NO_MEM: Cannot allocate memory for decompressing the patch
+ *    - Errors returned by esp_ota_write() and esp_partition_read()
+ */
+esp_err_t esp_ota_patch_write(esp_ota_patch_handle_t handle, const void *data, size_t size);
+
+/**
+ * @brief Finish applying a patch and free the handle
+ *
+ * Checks that the complete patch has been received, and writes the rest of the image. The OTA
+ * update still has to be finished with esp_ota_end().
+ *
+ * @param handle  Handle returned by esp_ota_patch_begin(). It is freed even if this function fails.
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: handle is NULL
+ *    - ESP_ERR_OTA_VALIDATE_FAILED: The patch is incomplete
+ *    - The error returned by esp_ota_patch_write() if it has failed
+ *    - Errors returned by esp_ota_write()
+ */
+esp_err_t esp_ota_patch_end(esp_ota_patch_handle_t handle);
+
+/**
+ * @brief Stop applying a patch and free the handle
+ *
+ * The OTA update itself is not aborted, call esp_ota_abort() for this.
+ *
+ * @param handle  Handle returned by esp_ota_patch_begin(), may be NULL
+ */
+void esp_ota_patch_abort(esp_ota_patch_handle_t handle);
+
+/**
+ * @brief Check if data starts with a patch header
+ *
+ * This can be used to tell a patch from a plain image, which starts with ESP_IMAGE_HEADER_MAGIC.
+ *
+ * @param data  Start of the data
+ * @param size  Size of data in bytes
+ *
+ * @return true if data is long enough to hold a patch header and starts with ESP_OTA_PATCH_MAGIC
+ */
+bool esp_ota_patch_is_patch(const void *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
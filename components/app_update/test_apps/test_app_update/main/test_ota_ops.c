@@ -1,11 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/param.h>
 #include "esp_log.h"
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -14,6 +15,7 @@
 #include <unity.h>
 #include <test_utils.h>
 #include <esp_ota_ops.h>
+#include "esp_image_format.h"
 
 /* These OTA tests currently don't assume an OTA partition exists
    on the device, so they're a bit limited
@@ -122,3 +124,40 @@ TEST_CASE("esp_ota_get_running_partition points to correct address", "[spi_flash
     ESP_LOGI("running bin", "0x%p", (void*)part->address);
     TEST_ASSERT_EQUAL_HEX32(factory->address, part->address);
 }
+
+TEST_CASE("esp_ota_write aggregates unaligned writes", "[ota]")
+{
+    const esp_partition_t *ota_0 = esp_partition_find_first(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, NULL);
+    TEST_ASSERT_NOT_NULL(ota_0);
+
+    const size_t image_size = 70 * 1024;
+    uint8_t *image = malloc(image_size);
+    uint8_t *read_back = malloc(image_size);
+    TEST_ASSERT_NOT_NULL(image);
+    TEST_ASSERT_NOT_NULL(read_back);
+    for (size_t i = 0; i < image_size; i++) {
+        image[i] = i * 7 + (i >> 8);
+    }
+    image[0] = ESP_IMAGE_HEADER_MAGIC;
+
+    esp_ota_handle_t handle;
+    TEST_ESP_OK(esp_ota_begin(ota_0, OTA_WITH_SEQUENTIAL_WRITES, &handle));
+
+    /* chunks of odd sizes, both smaller and larger than the write buffer */
+    const size_t chunk_sizes[] = { 1, 15, 17, 255, 1000, 4096, 9001, 3 };
+    size_t written = 0;
+    for (int i = 0; written < image_size; i = (i + 1) % (sizeof(chunk_sizes) / sizeof(chunk_sizes[0]))) {
+        size_t len = MIN(chunk_sizes[i], image_size - written);
+        TEST_ESP_OK(esp_ota_write(handle, image + written, len));
+        written += len;
+    }
+
+    /* the image is in flash once flushed, without ending the update */
+    TEST_ESP_OK(esp_ota_flush(handle));
+    TEST_ESP_OK(esp_partition_read(ota_0, 0, read_back, image_size));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(image, read_back, image_size);
+
+    TEST_ESP_OK(esp_ota_abort(handle));
+    free(image);
+    free(read_back);
+}
@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+
+#include <unity.h>
+#include <test_utils.h>
+#include "esp_ota_ops.h"
+#include "esp_ota_patch.h"
+#include "esp_image_format.h"
+#include "esp_rom_md5.h"
+#include "miniz.h"
+
+#define ADD_LEN         1024
+#define INSERT_LEN      512
+
+static uint8_t *put_le32(uint8_t *p, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        *p++ = value >> (8 * i);
+    }
+    return p;
+}
+
+/* Build the commands producing the running app from itself, using each kind of command */
+static size_t build_commands(const esp_partition_t *base, uint32_t image_len, uint8_t *cmds)
+{
+    const uint32_t add_start = image_len / 2;
+    const uint32_t insert_start = add_start + ADD_LEN;
+    const uint32_t copy_start = insert_start + INSERT_LEN;
+    uint8_t *p = cmds;
+
+    *p++ = ESP_OTA_PATCH_CMD_COPY;
+    p = put_le32(p, 0);
+    p = put_le32(p, add_start);
+
+    // add to a different part of the base
+    uint8_t *other = malloc(ADD_LEN);
+    TEST_ASSERT_NOT_NULL(other);
+    *p++ = ESP_OTA_PATCH_CMD_ADD;
+    p = put_le32(p, add_start - ADD_LEN);
+    p = put_le32(p, ADD_LEN);
+    TEST_ESP_OK(esp_partition_read(base, add_start, p, ADD_LEN));
+    TEST_ESP_OK(esp_partition_read(base, add_start - ADD_LEN, other, ADD_LEN));
+    for (int i = 0; i < ADD_LEN; i++) {
+        p[i] -= other[i];
+    }
+    p += ADD_LEN;
+    free(other);
+
+    *p++ = ESP_OTA_PATCH_CMD_INSERT;
+    p = put_le32(p, INSERT_LEN);
+    TEST_ESP_OK(esp_partition_read(base, insert_start, p, INSERT_LEN));
+    p += INSERT_LEN;
+
+    *p++ = ESP_OTA_PATCH_CMD_COPY;
+    p = put_le32(p, copy_start);
+    p = put_le32(p, image_len - copy_start);
+    return p - cmds;
+}
+
+static void fill_header(const esp_partition_t *base, uint32_t image_len, esp_ota_patch_header_t *header)
+{
+    uint8_t *buf = malloc(SPI_FLASH_SEC_SIZE);
+    TEST_ASSERT_NOT_NULL(buf);
+    md5_context_t md5;
+    esp_rom_md5_init(&md5);
+    for (uint32_t offset = 0; offset < image_len; offset += SPI_FLASH_SEC_SIZE) {
+        uint32_t len = MIN(SPI_FLASH_SEC_SIZE, image_len - offset);
+        TEST_ESP_OK(esp_partition_read(base, offset, buf, len));
+        esp_rom_md5_update(&md5, buf, len);
+    }
+    free(buf);
+
+    memset(header, 0, sizeof(*header));
+    header->magic = ESP_OTA_PATCH_MAGIC;
+    header->version = ESP_OTA_PATCH_VERSION;
+    header->base_size = image_len;
+    esp_rom_md5_final(header->base_md5, &md5);
+    header->image_size = image_len;
+}
+
+/* Apply the patch in small parts, returning the first error */
+static esp_err_t apply_patch(const esp_partition_t *update, const esp_ota_patch_header_t *header, const uint8_t *body, size_t body_len)
+{
+    esp_ota_handle_t ota_handle;
+    esp_ota_patch_handle_t patch_handle;
+    TEST_ESP_OK(esp_ota_begin(update, OTA_SIZE_UNKNOWN, &ota_handle));
+    TEST_ESP_OK(esp_ota_patch_begin(ota_handle, NULL, &patch_handle));
+
+    esp_err_t err = esp_ota_patch_write(patch_handle, header, sizeof(*header));
+    for (size_t pos = 0; pos < body_len && err == ESP_OK; pos += 100) {
+        err = esp_ota_patch_write(patch_handle, body + pos, MIN(100, body_len - pos));
+    }
+    if (err != ESP_OK) {
+        esp_ota_patch_abort(patch_handle);
+        esp_ota_abort(ota_handle);
+        return err;
+    }
+    err = esp_ota_patch_end(patch_handle);
+    if (err != ESP_OK) {
+        esp_ota_abort(ota_handle);
+        return err;
+    }
+    return esp_ota_end(ota_handle);
+}
+
+TEST_CASE("esp_ota_patch applies patches against the running app", "[ota]")
+{
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    const esp_partition_t *update = esp_ota_get_next_update_partition(NULL);
+    TEST_ASSERT_NOT_NULL(running);
+    TEST_ASSERT_NOT_NULL(update);
+
+    const esp_partition_pos_t running_pos = {
+        .offset = running->address,
+        .size = running->size,
+    };
+    esp_image_metadata_t data;
+    TEST_ESP_OK(esp_image_get_metadata(&running_pos, &data));
+
+    esp_ota_patch_header_t header;
+    fill_header(running, data.image_len, &header);
+    uint8_t *cmds = malloc(64 + ADD_LEN + INSERT_LEN);
+    TEST_ASSERT_NOT_NULL(cmds);
+    size_t cmds_len = build_commands(running, data.image_len, cmds);
+
+    // the patch reproduces the running app, so the image written must be valid
+    TEST_ESP_OK(apply_patch(update, &header, cmds, cmds_len));
+
+    // the same commands, compressed
+    tdefl_compressor *comp = calloc(1, sizeof(tdefl_compressor));
+    uint8_t *compressed = malloc(cmds_len + 128);
+    TEST_ASSERT_NOT_NULL(comp);
+    TEST_ASSERT_NOT_NULL(compressed);
+    TEST_ASSERT_EQUAL(TDEFL_STATUS_OKAY, tdefl_init(comp, NULL, NULL, TDEFL_WRITE_ZLIB_HEADER | 1500));
+    size_t in_bytes = cmds_len;
+    size_t compressed_len = cmds_len + 128;
+    TEST_ASSERT_EQUAL(TDEFL_STATUS_DONE, tdefl_compress(comp, cmds, &in_bytes, compressed, &compressed_len, TDEFL_FINISH));
+    free(comp);
+    header.flags = ESP_OTA_PATCH_FLAG_COMPRESSED;
+    header.window_bits = 15;
+    TEST_ESP_OK(apply_patch(update, &header, compressed, compressed_len));
+
+    // a truncated patch is detected
+    TEST_ASSERT_EQUAL_HEX(ESP_ERR_OTA_VALIDATE_FAILED, apply_patch(update, &header, compressed, compressed_len - 1));
+    free(compressed);
+
+    // a patch against a different base is rejected
+    header.flags = 0;
+    header.base_md5[0] ^= 1;
+    TEST_ASSERT_EQUAL_HEX(ESP_ERR_OTA_PATCH_BASE_MISMATCH, apply_patch(update, &header, cmds, cmds_len));
+    free(cmds);
+}
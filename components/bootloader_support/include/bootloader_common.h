@@ -265,6 +265,28 @@ bool bootloader_common_get_rtc_retain_mem_factory_reset_state(void);
  */
 void bootloader_common_set_rtc_retain_mem_factory_reset_state(void);
 
+#if CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
+/**
+ * @brief Check that an app image was validated on a previous boot
+ *
+ * @param[in] partition        App partition.
+ * @param[in] digest           SHA-256 digest appended to the app image.
+ * @param[in] flash_encryption Current flash encryption state.
+ *
+ * @return true if rtc_retain_mem is valid and records this image as validated.
+ */
+bool bootloader_common_check_rtc_retain_mem_verified_image(const esp_partition_pos_t *partition, const uint8_t *digest, bool flash_encryption);
+
+/**
+ * @brief Record in rtc_retain_mem that an app image has been validated
+ *
+ * @param[in] partition        App partition.
+ * @param[in] digest           SHA-256 digest appended to the app image.
+ * @param[in] flash_encryption Current flash encryption state.
+ */
+void bootloader_common_update_rtc_retain_mem_verified_image(const esp_partition_pos_t *partition, const uint8_t *digest, bool flash_encryption);
+#endif // CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
+
 /**
  * @brief Returns rtc_retain_mem
  *
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -57,6 +57,14 @@ typedef struct {
         uint8_t val;
     } flags;
     uint8_t reserve;                /*!< Reserve */
+#ifdef CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
+    struct {
+        uint32_t offset;            /*!< Offset of the app partition validated on a previous boot */
+        uint8_t flash_encryption;   /*!< Flash encryption state when the app was validated */
+        uint8_t reserve[3];         /*!< Reserve */
+        uint8_t digest[32];         /*!< SHA-256 digest appended to the validated app image */
+    } verified_image;               /*!< Record of the last validated app image */
+#endif
 #ifdef CONFIG_BOOTLOADER_CUSTOM_RESERVE_RTC
     uint8_t custom[CONFIG_BOOTLOADER_CUSTOM_RESERVE_RTC_SIZE]; /*!< Reserve for custom propose */
 #endif
@@ -127,6 +135,68 @@ esp_err_t esp_image_verify(esp_image_load_mode_t mode, const esp_partition_pos_t
  */
 esp_err_t esp_image_get_metadata(const esp_partition_pos_t *part, esp_image_metadata_t *metadata);
 
+#ifndef BOOTLOADER_BUILD
+/**
+ * @brief Handle of an app image verified while it is being written
+ */
+typedef struct esp_image_stream_verify *esp_image_stream_verify_handle_t;
+
+/**
+ * @brief Start verifying an app image from the data written to the partition, instead of reading it back from flash.
+ *
+ * The image is passed in order to esp_image_stream_verify_data(), starting from its first byte, and checked by
+ * esp_image_stream_verify_end() in the same way as esp_image_verify() in ESP_IMAGE_VERIFY mode would check it.
+ * The result only holds if the data has been written to flash as it was passed in.
+ *
+ * @param part Partition the image is written to.
+ * @param[out] out_handle Handle to pass to the other esp_image_stream_verify functions.
+ *
+ * @return
+ * - ESP_OK if the verification has started
+ * - ESP_ERR_INVALID_ARG if the arguments are invalid
+ * - ESP_ERR_NOT_SUPPORTED if the image needs esp_image_verify(), i.e. it is a bootloader or its signature must be verified
+ * - ESP_ERR_NO_MEM if there is not enough memory
+ */
+esp_err_t esp_image_stream_verify_begin(const esp_partition_pos_t *part, esp_image_stream_verify_handle_t *out_handle);
+
+/**
+ * @brief Pass the next part of the image being verified
+ *
+ * Data after the end of the image (e.g. padding) is ignored.
+ *
+ * @param handle Handle from esp_image_stream_verify_begin()
+ * @param data Image data
+ * @param len Length of the data
+ *
+ * @return
+ * - ESP_OK if the image is valid so far
+ * - ESP_ERR_INVALID_ARG if the arguments are invalid
+ * - ESP_ERR_IMAGE_INVALID if the image is invalid, this error is then returned for all the later data
+ * - ESP_ERR_NO_MEM if there is not enough memory to calculate the image hash
+ */
+esp_err_t esp_image_stream_verify_data(esp_image_stream_verify_handle_t handle, const void *data, size_t len);
+
+/**
+ * @brief Finish the verification of the image and free the handle
+ *
+ * @param handle Handle from esp_image_stream_verify_begin()
+ * @param[out] data Image metadata filled in if the image is valid, may be NULL
+ *
+ * @return
+ * - ESP_OK if the image is valid
+ * - ESP_ERR_INVALID_ARG if the handle is NULL
+ * - ESP_ERR_IMAGE_INVALID if the image is invalid or incomplete
+ */
+esp_err_t esp_image_stream_verify_end(esp_image_stream_verify_handle_t handle, esp_image_metadata_t *data);
+
+/**
+ * @brief Stop the verification of the image and free the handle
+ *
+ * @param handle Handle from esp_image_stream_verify_begin(), may be NULL
+ */
+void esp_image_stream_verify_abort(esp_image_stream_verify_handle_t handle);
+#endif // !BOOTLOADER_BUILD
+
 /**
  * @brief Verify and load an app image (available only in space of bootloader).
  *
@@ -235,6 +235,29 @@ void bootloader_common_update_rtc_retain_mem(esp_partition_pos_t* partition, boo
     update_rtc_retain_mem_crc();
 }
 
+#if CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
+bool bootloader_common_check_rtc_retain_mem_verified_image(const esp_partition_pos_t *partition, const uint8_t *digest, bool flash_encryption)
+{
+    rtc_retain_mem_t* rtc_retain_mem = bootloader_common_get_rtc_retain_mem();
+    return is_retain_mem_valid()
+           && rtc_retain_mem->verified_image.offset == partition->offset
+           && rtc_retain_mem->verified_image.flash_encryption == flash_encryption
+           && memcmp(rtc_retain_mem->verified_image.digest, digest, sizeof(rtc_retain_mem->verified_image.digest)) == 0;
+}
+
+void bootloader_common_update_rtc_retain_mem_verified_image(const esp_partition_pos_t *partition, const uint8_t *digest, bool flash_encryption)
+{
+    rtc_retain_mem_t* rtc_retain_mem = bootloader_common_get_rtc_retain_mem();
+    if (!is_retain_mem_valid()) {
+        bootloader_common_reset_rtc_retain_mem();
+    }
+    rtc_retain_mem->verified_image.offset = partition->offset;
+    rtc_retain_mem->verified_image.flash_encryption = flash_encryption;
+    memcpy(rtc_retain_mem->verified_image.digest, digest, sizeof(rtc_retain_mem->verified_image.digest));
+    update_rtc_retain_mem_crc();
+}
+#endif // CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
+
 rtc_retain_mem_t* bootloader_common_get_rtc_retain_mem(void)
 {
 #ifdef BOOTLOADER_BUILD
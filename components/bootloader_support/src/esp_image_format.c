@@ -1,9 +1,10 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <string.h>
+#include <stdlib.h>
 #include <sys/param.h>
 #include <esp_cpu.h>
 #include <bootloader_utility.h>
@@ -14,6 +15,7 @@
 #include <bootloader_flash_priv.h>
 #include <bootloader_random.h>
 #include <bootloader_sha.h>
+#include <esp_flash_encrypt.h>
 #include "bootloader_util.h"
 #include "bootloader_common.h"
 #include "esp_rom_sys.h"
@@ -80,6 +82,8 @@ static esp_err_t verify_image_header(uint32_t src_addr, const esp_image_header_t
 /* Verify a segment header */
 static esp_err_t verify_segment_header(int index, const esp_image_segment_header_t *segment, uint32_t segment_data_offs, esp_image_metadata_t *metadata, bool silent);
 
+static esp_err_t verify_segment_mapping(int index, uint32_t load_addr, uint32_t segment_data_offs, int mmu_page_size, bool silent);
+
 /* Log-and-fail macro for use in esp_image_load */
 #define FAIL_LOAD(...) do {                         \
         if (!silent) {                              \
@@ -273,6 +277,34 @@ err:
     return err;
 }
 
+#if defined(BOOTLOADER_BUILD) && CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
+/* Load the image without validation if it was validated on a previous boot */
+static esp_err_t load_verified_image(const esp_partition_pos_t *part, esp_image_metadata_t *data)
+{
+    if (esp_rom_get_reset_reason(0) == RESET_REASON_CHIP_POWER_ON) {
+        // RTC FAST memory content is not retained
+        return ESP_ERR_NOT_FOUND;
+    }
+    // Only the headers and the appended digest are read, the digest tells whether the image has been replaced
+    esp_err_t err = esp_image_get_metadata(part, data);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (!data->image.hash_appended
+            || !bootloader_common_check_rtc_retain_mem_verified_image(part, data->image_digest, esp_flash_encryption_enabled())) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    uint8_t digest[HASH_LEN];
+    memcpy(digest, data->image_digest, HASH_LEN);
+    ESP_LOGI(TAG, "image at 0x%"PRIx32" was validated on a previous boot, skipping validation", part->offset);
+    CHECK_ERR(image_load(ESP_IMAGE_LOAD_NO_VALIDATE, part, data));
+    memcpy(data->image_digest, digest, HASH_LEN);
+    return ESP_OK;
+err:
+    return err;
+}
+#endif // BOOTLOADER_BUILD && CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
+
 esp_err_t bootloader_load_image(const esp_partition_pos_t *part, esp_image_metadata_t *data)
 {
 #if !defined(BOOTLOADER_BUILD)
@@ -293,6 +325,20 @@ esp_err_t bootloader_load_image(const esp_partition_pos_t *part, esp_image_metad
         mode = ESP_IMAGE_LOAD_NO_VALIDATE;
     }
 #endif // CONFIG_BOOTLOADER_SKIP_...
+
+#if CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
+    if (mode == ESP_IMAGE_LOAD) {
+        if (part != NULL && data != NULL && load_verified_image(part, data) == ESP_OK) {
+            return ESP_OK;
+        }
+        esp_err_t err = image_load(mode, part, data);
+        // the digest is not checked when a debugger is attached, do not record the image then
+        if (err == ESP_OK && data->image.hash_appended && !esp_cpu_dbgr_is_attached()) {
+            bootloader_common_update_rtc_retain_mem_verified_image(part, data->image_digest, esp_flash_encryption_enabled());
+        }
+        return err;
+    }
+#endif // CONFIG_BOOTLOADER_VERIFIED_IMAGE_CACHE
 #endif // CONFIG_SECURE_BOOT
 
  return image_load(mode, part, data);
@@ -788,7 +834,6 @@ static esp_err_t verify_segment_header(int index, const esp_image_segment_header
     }
 
     uint32_t load_addr = segment->load_addr;
-    bool map_segment = should_map(load_addr);
 
 #if SOC_MMU_PAGE_SIZE_CONFIGURABLE
     /* ESP APP descriptor is present in the DROM segment #0 */
@@ -813,7 +858,12 @@ static esp_err_t verify_segment_header(int index, const esp_image_segment_header
     metadata->mmu_page_size = SPI_FLASH_MMU_PAGE_SIZE;
 #endif // !SOC_MMU_PAGE_SIZE_CONFIGURABLE
 
-    const int mmu_page_size = metadata->mmu_page_size;
+    return verify_segment_mapping(index, load_addr, segment_data_offs, metadata->mmu_page_size, silent);
+}
+
+static esp_err_t verify_segment_mapping(int index, uint32_t load_addr, uint32_t segment_data_offs, int mmu_page_size, bool silent)
+{
+    bool map_segment = should_map(load_addr);
     ESP_LOGV(TAG, "MMU page size 0x%x", mmu_page_size);
 
     /* Check that flash cache mapped segment aligns correctly from flash to its mapped address,
@@ -1091,6 +1141,266 @@ static esp_err_t verify_simple_hash(bootloader_sha256_handle_t sha_handle, esp_i
     return ESP_OK;
 }
 
+#ifndef BOOTLOADER_BUILD
+/* Verification of an app image while it is being written, e.g. by an OTA update.
+ * Performs the same checks as image_load() in ESP_IMAGE_VERIFY mode, on the data passed in
+ * instead of the data read back from flash.
+ */
+
+typedef enum {
+    STREAM_IMAGE_HEADER,        /* receiving esp_image_header_t */
+    STREAM_SEGMENT_HEADER,      /* receiving esp_image_segment_header_t of segment 'segment' */
+    STREAM_SEGMENT_DATA,        /* receiving data of segment 'segment' */
+    STREAM_CHECKSUM,            /* receiving the padding ending with the checksum byte */
+    STREAM_DIGEST,              /* receiving the appended SHA-256 digest */
+    STREAM_DONE,                /* whole image received, the rest is ignored */
+} stream_state_t;
+
+struct esp_image_stream_verify {
+    esp_image_metadata_t data;
+    uint32_t part_size;
+    bootloader_sha256_handle_t sha_handle;
+    stream_state_t state;
+    int segment;
+    uint32_t item_len;          /* length of the header, segment data, padding or digest being received */
+    uint32_t item_pos;          /* bytes of the item received so far */
+    uint8_t checksum;           /* XOR of the segment data bytes, equal to the folded word checksum */
+    esp_err_t err;              /* first error, later data is ignored */
+    WORD_ALIGNED_ATTR uint8_t item[MAX(sizeof(esp_image_header_t), HASH_LEN)];
+    esp_app_desc_t app_desc;    /* start of segment #0 */
+};
+
+esp_err_t esp_image_stream_verify_begin(const esp_partition_pos_t *part, esp_image_stream_verify_handle_t *out_handle)
+{
+    if (part == NULL || out_handle == NULL || part->size > SIXTEEN_MB) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (SECURE_BOOT_CHECK_SIGNATURE || is_bootloader(part->offset)) {
+        // The signature block and the bootloader rules are only handled by esp_image_verify()
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    esp_image_stream_verify_handle_t handle = calloc(1, sizeof(struct esp_image_stream_verify));
+    if (handle == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    handle->data.start_addr = part->offset;
+    handle->part_size = part->size;
+    handle->state = STREAM_IMAGE_HEADER;
+    handle->item_len = sizeof(esp_image_header_t);
+    handle->checksum = ESP_ROM_CHECKSUM_INITIAL;
+    *out_handle = handle;
+    return ESP_OK;
+}
+
+static void stream_start_checksum(esp_image_stream_verify_handle_t handle)
+{
+    // Padding to the next full 16 byte block, the last byte is the checksum
+    uint32_t unpadded_length = handle->data.image_len;
+    handle->state = STREAM_CHECKSUM;
+    handle->item_len = ALIGN_UP(unpadded_length + 1, 16) - unpadded_length;
+}
+
+/* Process the item which has just been received and set up the next one */
+static esp_err_t stream_next_item(esp_image_stream_verify_handle_t handle)
+{
+    esp_image_metadata_t *data = &handle->data;
+    const bool silent = false;
+    esp_err_t err = ESP_OK;
+
+    switch (handle->state) {
+    case STREAM_IMAGE_HEADER:
+        memcpy(&data->image, handle->item, sizeof(esp_image_header_t));
+        CHECK_ERR(verify_image_header(data->start_addr, &data->image, false));
+        if (data->image.hash_appended) {
+            handle->sha_handle = bootloader_sha256_start();
+            if (handle->sha_handle == NULL) {
+                return ESP_ERR_NO_MEM;
+            }
+            bootloader_sha256_data(handle->sha_handle, &data->image, sizeof(esp_image_header_t));
+        }
+        data->image_len = sizeof(esp_image_header_t);
+        handle->segment = 0;
+        if (data->image.segment_count > 0) {
+            handle->state = STREAM_SEGMENT_HEADER;
+            handle->item_len = sizeof(esp_image_segment_header_t);
+        } else {
+            stream_start_checksum(handle);
+        }
+        break;
+    case STREAM_SEGMENT_HEADER: {
+        esp_image_segment_header_t *header = &data->segments[handle->segment];
+        memcpy(header, handle->item, sizeof(esp_image_segment_header_t));
+        if (handle->sha_handle != NULL) {
+            bootloader_sha256_data(handle->sha_handle, header, sizeof(esp_image_segment_header_t));
+        }
+        if ((header->data_len & 3) != 0 || header->data_len >= SIXTEEN_MB) {
+            FAIL_LOAD("invalid segment length 0x%"PRIx32, header->data_len);
+        }
+        data->image_len += sizeof(esp_image_segment_header_t);
+        data->segment_data[handle->segment] = data->start_addr + data->image_len;
+        handle->state = STREAM_SEGMENT_DATA;
+        handle->item_len = header->data_len;
+        break;
+    }
+    case STREAM_SEGMENT_DATA:
+        data->image_len += handle->item_len;
+        if (data->image_len > handle->part_size) {
+            FAIL_LOAD("Image length %"PRIu32" doesn't fit in partition length %"PRIu32, data->image_len, handle->part_size);
+        }
+        if (++handle->segment < data->image.segment_count) {
+            handle->state = STREAM_SEGMENT_HEADER;
+            handle->item_len = sizeof(esp_image_segment_header_t);
+        } else {
+            stream_start_checksum(handle);
+        }
+        break;
+    case STREAM_CHECKSUM:
+        if (handle->item[handle->item_len - 1] != handle->checksum && !esp_cpu_dbgr_is_attached()) {
+            FAIL_LOAD("Checksum failed. Calculated 0x%x read 0x%x", handle->checksum, handle->item[handle->item_len - 1]);
+        }
+        if (handle->sha_handle != NULL) {
+            bootloader_sha256_data(handle->sha_handle, handle->item, handle->item_len);
+        }
+        data->image_len += handle->item_len;
+        if (data->image.hash_appended) {
+            handle->state = STREAM_DIGEST;
+            handle->item_len = HASH_LEN;
+        } else {
+            handle->state = STREAM_DONE;
+        }
+        break;
+    case STREAM_DIGEST:
+        memcpy(data->image_digest, handle->item, HASH_LEN);
+        data->image_len += HASH_LEN;
+        handle->state = STREAM_DONE;
+        break;
+    default:
+        break;
+    }
+    handle->item_pos = 0;
+    return ESP_OK;
+err:
+    if (err == ESP_OK) {
+        err = ESP_ERR_IMAGE_INVALID;
+    }
+    return err;
+}
+
+static void stream_segment_data(esp_image_stream_verify_handle_t handle, const uint8_t *src, size_t len)
+{
+    if (handle->segment == 0 && handle->item_pos < sizeof(esp_app_desc_t)) {
+        size_t desc_len = MIN(len, sizeof(esp_app_desc_t) - handle->item_pos);
+        memcpy((uint8_t *)&handle->app_desc + handle->item_pos, src, desc_len);
+    }
+    for (size_t i = 0; i < len; i++) {
+        handle->checksum ^= src[i];
+    }
+    if (handle->sha_handle != NULL) {
+        bootloader_sha256_data(handle->sha_handle, src, len);
+    }
+}
+
+esp_err_t esp_image_stream_verify_data(esp_image_stream_verify_handle_t handle, const void *data, size_t len)
+{
+    if (handle == NULL || (data == NULL && len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const uint8_t *src = (const uint8_t *)data;
+    while (handle->err == ESP_OK && handle->state != STREAM_DONE) {
+        // items may be empty, e.g. segments without data
+        if (handle->item_pos == handle->item_len) {
+            handle->err = stream_next_item(handle);
+            continue;
+        }
+        if (len == 0) {
+            break;
+        }
+        size_t chunk = MIN(len, handle->item_len - handle->item_pos);
+        if (handle->state == STREAM_SEGMENT_DATA) {
+            stream_segment_data(handle, src, chunk);
+        } else {
+            memcpy(handle->item + handle->item_pos, src, chunk);
+        }
+        handle->item_pos += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+    return handle->err;
+}
+
+esp_err_t esp_image_stream_verify_end(esp_image_stream_verify_handle_t handle, esp_image_metadata_t *data)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_image_metadata_t *metadata = &handle->data;
+    const bool silent = false;
+    esp_err_t err = handle->err;
+    if (err != ESP_OK) {
+        goto err;
+    }
+    if (handle->state != STREAM_DONE) {
+        FAIL_LOAD("image is truncated, %"PRIu32" bytes received", metadata->image_len + handle->item_pos);
+    }
+
+    // The esp_app_desc_t structure is at the start of segment #0
+    metadata->mmu_page_size = SPI_FLASH_MMU_PAGE_SIZE;
+    if (metadata->image.segment_count > 0) {
+        const esp_app_desc_t __attribute__((unused)) *app_desc = &handle->app_desc;
+#if !CONFIG_IDF_TARGET_ESP32
+        CHECK_ERR(bootloader_common_check_efuse_blk_validity(app_desc->min_efuse_blk_rev_full, app_desc->max_efuse_blk_rev_full));
+#endif
+#if CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
+        metadata->secure_version = app_desc->secure_version;
+#endif
+#if SOC_MMU_PAGE_SIZE_CONFIGURABLE
+        if (app_desc->magic_word != ESP_APP_DESC_MAGIC_WORD) {
+            FAIL_LOAD("Failed to fetch app description header!");
+        }
+        metadata->mmu_page_size = (app_desc->mmu_page_size > 0) ? (1UL << app_desc->mmu_page_size) : SPI_FLASH_MMU_PAGE_SIZE;
+#endif
+    }
+    for (int i = 0; i < metadata->image.segment_count; i++) {
+        CHECK_ERR(verify_segment_mapping(i, metadata->segments[i].load_addr, metadata->segment_data[i], metadata->mmu_page_size, false));
+    }
+
+    if (handle->sha_handle != NULL && !esp_cpu_dbgr_is_attached()) {
+        err = verify_simple_hash(handle->sha_handle, metadata);
+        handle->sha_handle = NULL; // calling verify_simple_hash finishes sha_handle
+        if (err != ESP_OK) {
+            goto err;
+        }
+    }
+    if (data != NULL) {
+        memcpy(data, metadata, sizeof(esp_image_metadata_t));
+    }
+    esp_image_stream_verify_abort(handle);
+    return ESP_OK;
+
+err:
+    if (err == ESP_OK) {
+        err = ESP_ERR_IMAGE_INVALID;
+    }
+    esp_image_stream_verify_abort(handle);
+    return err;
+}
+
+void esp_image_stream_verify_abort(esp_image_stream_verify_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    if (handle->sha_handle != NULL) {
+        // Need to finish the hash process to free the handle
+        bootloader_sha256_finish(handle->sha_handle, NULL);
+    }
+    free(handle);
+}
+#endif // !BOOTLOADER_BUILD
+
 int esp_image_get_flash_size(esp_image_flash_size_t app_flash_size)
 {
     switch (app_flash_size) {
@@ -30,6 +30,20 @@
 #define SPI_OUT_TS_SYNC_TIMEOUT (1000 * 1000)
 #endif // CONFIG_BT_BLE_LOG_SPI_OUT_TS_SYNC_ENABLED
 
+#if CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_memory_utils.h"
+#include "esp_private/log_args.h"
+
+// Binary printf payload: esp_ts (4), marker, level, format addr (4), tag addr (4), arguments...
+// The arguments are encoded as in CONFIG_LOG_BINARY, see components/log/src/os/log_binary.c
+#define SPI_OUT_BIN_MARKER 0x02
+#define SPI_OUT_BIN_LEVEL_NONE 0xFF
+#define SPI_OUT_BIN_HEAD_LEN 14
+#define SPI_OUT_BIN_MAX_LEN 160
+#endif // CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+
 // Private typedefs
 typedef struct {
     // CRITICAL: 0 for available, 1 for need queue (ISR), 2 for in queue
@@ -91,6 +105,10 @@ static void spi_out_log_cb_write(spi_out_log_cb_t *log_cb, const uint8_t *addr,
 static inline void spi_out_log_cb_write_packet_loss(spi_out_log_cb_t *log_cb, uint8_t flag);
 static void spi_out_log_cb_dump(spi_out_log_cb_t *log_cb);
 
+#if CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+static int spi_out_ul_log_write_bin(uint8_t source, uint8_t level, const char *tag, const char *format, va_list args);
+#endif // CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+
 static int spi_out_ul_log_init(void);
 static void spi_out_ul_log_deinit(void);
 static void esp_timer_cb_ul_log_flushout(void);
@@ -611,6 +629,174 @@ IRAM_ATTR static void esp_timer_cb_ts_sync(void)
 }
 #endif // CONFIG_BT_BLE_LOG_SPI_OUT_TS_SYNC_ENABLED
 
+#if CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+typedef struct {
+    uint8_t buf[SPI_OUT_BIN_MAX_LEN];
+    uint16_t len;
+    bool overflow;
+} spi_out_bin_t;
+
+static void spi_out_bin_put(spi_out_bin_t *bin, const void *data, size_t len)
+{
+    if (bin->overflow || (len > sizeof(bin->buf) - bin->len)) {
+        bin->overflow = true;
+        return;
+    }
+    memcpy(bin->buf + bin->len, data, len);
+    bin->len += len;
+}
+
+static void spi_out_bin_put_varint(spi_out_bin_t *bin, uint64_t value)
+{
+    uint8_t byte;
+    while (value >= 0x80) {
+        byte = (value & 0x7F) | 0x80;
+        spi_out_bin_put(bin, &byte, 1);
+        value >>= 7;
+    }
+    byte = (uint8_t)value;
+    spi_out_bin_put(bin, &byte, 1);
+}
+
+static void spi_out_bin_put_svarint(spi_out_bin_t *bin, int64_t value)
+{
+    spi_out_bin_put_varint(bin, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+// Returns whether all conversions of the format string can be encoded
+static bool spi_out_bin_format_supported(const char *format)
+{
+    for (const char *p = strchr(format, '%'); p != NULL; p = strchr(p, '%')) {
+        esp_log_conv_t conv;
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+        if (!esp_log_args_parse(p + 1, &conv)) {
+            return false;
+        }
+        p = conv.end;
+    }
+    return true;
+}
+
+static void spi_out_bin_put_arg(spi_out_bin_t *bin, const esp_log_conv_t *conv, va_list *args)
+{
+    union {
+        int i;
+        long l;
+        long long ll;
+        intmax_t im;
+        ptrdiff_t pd;
+        size_t sz;
+        uintptr_t ptr;
+        double d;
+        const char *str;
+    } value;
+    esp_log_args_fetch(conv->type, args, &value);
+
+    int64_t v;
+    switch (conv->type) {
+    case ESP_LOG_ARG_STR: {
+        const char *str = (value.str != NULL) ? value.str : "(null)";
+        if (esp_ptr_in_drom(str)) {
+            uint32_t addr = (uint32_t)(uintptr_t)str;
+            spi_out_bin_put_varint(bin, 0);
+            spi_out_bin_put(bin, &addr, sizeof(addr));
+        } else {
+            size_t len = (conv->precision >= 0) ? strnlen(str, conv->precision) : strlen(str);
+            spi_out_bin_put_varint(bin, len + 1);
+            spi_out_bin_put(bin, str, len);
+        }
+        return;
+    }
+    case ESP_LOG_ARG_DOUBLE:
+        spi_out_bin_put(bin, &value.d, sizeof(value.d));
+        return;
+    case ESP_LOG_ARG_INT:
+        v = conv->is_signed ? (int64_t)value.i : (int64_t)(unsigned)value.i;
+        break;
+    case ESP_LOG_ARG_LONG:
+        v = conv->is_signed ? (int64_t)value.l : (int64_t)(unsigned long)value.l;
+        break;
+    case ESP_LOG_ARG_SIZE:
+    case ESP_LOG_ARG_PTRDIFF:
+        v = conv->is_signed ? (int64_t)value.pd : (int64_t)value.sz;
+        break;
+    case ESP_LOG_ARG_PTR:
+        v = (int64_t)value.ptr;
+        break;
+    case ESP_LOG_ARG_INTMAX:
+        v = (int64_t)value.im;
+        break;
+    default:
+        v = (int64_t)value.ll;
+        break;
+    }
+    if (conv->is_signed) {
+        spi_out_bin_put_svarint(bin, v);
+    } else {
+        spi_out_bin_put_varint(bin, (uint64_t)v);
+    }
+}
+
+// Returns -2 if the message can't be encoded, the caller then writes it as text
+static int spi_out_ul_log_write_bin(uint8_t source, uint8_t level, const char *tag, const char *format, va_list args)
+{
+    // The decoder takes these strings from the ELF file of the application
+    if (!esp_ptr_in_drom(format) || (tag && !esp_ptr_in_drom(tag)) || !spi_out_bin_format_supported(format)) {
+        return -2;
+    }
+
+    spi_out_bin_t bin = {
+        .len = SPI_OUT_BIN_HEAD_LEN,
+        .overflow = false,
+    };
+    uint32_t esp_ts = esp_timer_get_time();
+    uint32_t format_addr = (uint32_t)(uintptr_t)format;
+    uint32_t tag_addr = (uint32_t)(uintptr_t)tag;
+    memcpy(bin.buf, &esp_ts, 4);
+    bin.buf[4] = SPI_OUT_BIN_MARKER;
+    bin.buf[5] = level;
+    memcpy(bin.buf + 6, &format_addr, 4);
+    memcpy(bin.buf + 10, &tag_addr, 4);
+
+    va_list ap;
+    va_copy(ap, args);
+    for (const char *p = strchr(format, '%'); (p != NULL) && !bin.overflow; p = strchr(p, '%')) {
+        esp_log_conv_t conv;
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+        esp_log_args_parse(p + 1, &conv);
+        p = conv.end;
+
+        if (conv.width_star) {
+            spi_out_bin_put_svarint(&bin, va_arg(ap, int));
+        }
+        if (conv.precision_star) {
+            conv.precision = va_arg(ap, int);
+            spi_out_bin_put_svarint(&bin, conv.precision);
+        }
+        spi_out_bin_put_arg(&bin, &conv, &ap);
+    }
+    va_end(ap);
+    if (bin.overflow) {
+        return -2;
+    }
+
+    xSemaphoreTake(ul_log_mutex, portMAX_DELAY);
+    int ret = spi_out_log_cb_check_trans(ul_log_cb, bin.len);
+    if (ret == 0) {
+        spi_out_log_cb_write(ul_log_cb, bin.buf, bin.len, NULL, 0, source);
+    }
+    spi_out_log_cb_append_trans(ul_log_cb, false);
+    xSemaphoreGive(ul_log_mutex);
+    return ret;
+}
+#endif // CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+
 // Public functions
 int ble_log_spi_out_init(void)
 {
@@ -808,6 +994,14 @@ IRAM_ATTR int ble_log_spi_out_printf(uint8_t source, const char *format, ...)
     va_list args;
     va_start(args, format);
 
+#if CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+    int bin_ret = spi_out_ul_log_write_bin(source, SPI_OUT_BIN_LEVEL_NONE, NULL, format, args);
+    if (bin_ret != -2) {
+        va_end(args);
+        return bin_ret;
+    }
+#endif // CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+
     // Get len as ref to allocate heap memory
     va_list args_copy;
     va_copy(args_copy, args);
@@ -851,13 +1045,22 @@ IRAM_ATTR int ble_log_spi_out_printf_enh(uint8_t source, uint8_t level, const ch
         return -1;
     }
 
+    va_list args;
+    va_start(args, format);
+
+#if CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+    int bin_ret = spi_out_ul_log_write_bin(source, level, tag, format, args);
+    if (bin_ret != -2) {
+        va_end(args);
+        return bin_ret;
+    }
+#endif // CONFIG_BT_BLE_LOG_SPI_OUT_BINARY
+
     // Create log prefix in the format: "[level][tag] "
     char prefix[32];
     int prefix_len = snprintf(prefix, sizeof(prefix), "[%d][%s] ", level, tag ? tag : "NULL");
 
     // Compute the length of the formatted log message
-    va_list args;
-    va_start(args, format);
     va_list args_copy;
     va_copy(args_copy, args);
     int log_len = vsnprintf(NULL, 0, format, args_copy);
@@ -16,19 +16,22 @@
  *
  ******************************************************************************/
 
+#include "freertos/FreeRTOS.h"
 #include "osi/allocator.h"
 #include "osi/fixed_queue.h"
 #include "osi/list.h"
 #include "osi/osi.h"
-#include "osi/mutex.h"
 #include "osi/semaphore.h"
 
+// The list is only modified by a few pointer updates under |lock|, the nodes are
+// allocated and released out of the critical section, so a spinlock costs less
+// than a mutex on the per packet data path.
 typedef struct fixed_queue_t {
 
     list_t *list;
     osi_sem_t enqueue_sem;
     osi_sem_t dequeue_sem;
-    osi_mutex_t lock;
+    portMUX_TYPE lock;
     size_t capacity;
 
     fixed_queue_cb dequeue_ready;
@@ -42,7 +45,7 @@ fixed_queue_t *fixed_queue_new(size_t capacity)
         goto error;
     }
 
-    osi_mutex_new(&ret->lock);
+    portMUX_INITIALIZE(&ret->lock);
     ret->capacity = capacity;
 
     ret->list = list_new(NULL);
@@ -87,7 +90,6 @@ void fixed_queue_free(fixed_queue_t *queue, fixed_queue_free_cb free_cb)
     list_free(queue->list);
     osi_sem_free(&queue->enqueue_sem);
     osi_sem_free(&queue->dequeue_sem);
-    osi_mutex_free(&queue->lock);
     osi_free(queue);
 }
 
@@ -99,9 +101,9 @@ bool fixed_queue_is_empty(fixed_queue_t *queue)
         return true;
     }
 
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
+    portENTER_CRITICAL(&queue->lock);
     is_empty = list_is_empty(queue->list);
-    osi_mutex_unlock(&queue->lock);
+    portEXIT_CRITICAL(&queue->lock);
 
     return is_empty;
 }
@@ -114,9 +116,9 @@ size_t fixed_queue_length(fixed_queue_t *queue)
         return 0;
     }
 
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
+    portENTER_CRITICAL(&queue->lock);
     length = list_length(queue->list);
-    osi_mutex_unlock(&queue->lock);
+    portEXIT_CRITICAL(&queue->lock);
 
     return length;
 }
@@ -129,7 +131,7 @@ size_t fixed_queue_capacity(fixed_queue_t *queue)
 
 bool fixed_queue_enqueue(fixed_queue_t *queue, void *data, uint32_t timeout)
 {
-    bool status=false; //Flag whether enqueued success
+    list_node_t *node;
 
     assert(queue != NULL);
     assert(data != NULL);
@@ -138,19 +140,25 @@ bool fixed_queue_enqueue(fixed_queue_t *queue, void *data, uint32_t timeout)
         return false;
     }
 
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    status = list_append(queue->list, data); //Check whether enqueued success
-    osi_mutex_unlock(&queue->lock);
+    node = list_node_alloc(data);
+    if (node == NULL) {
+        osi_sem_give(&queue->enqueue_sem);
+        return false;
+    }
 
-    if(status == true )
-        osi_sem_give(&queue->dequeue_sem);
+    portENTER_CRITICAL(&queue->lock);
+    list_append_node(queue->list, node);
+    portEXIT_CRITICAL(&queue->lock);
 
-    return status;
+    osi_sem_give(&queue->dequeue_sem);
+
+    return true;
 }
 
 void *fixed_queue_dequeue(fixed_queue_t *queue, uint32_t timeout)
 {
-    void *ret = NULL;
+    list_node_t *node;
+    void *ret;
 
     assert(queue != NULL);
 
@@ -158,10 +166,13 @@ void *fixed_queue_dequeue(fixed_queue_t *queue, uint32_t timeout)
         return NULL;
     }
 
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    ret = list_front(queue->list);
-    list_remove(queue->list, ret);
-    osi_mutex_unlock(&queue->lock);
+    portENTER_CRITICAL(&queue->lock);
+    node = list_unlink_front(queue->list);
+    portEXIT_CRITICAL(&queue->lock);
+
+    assert(node != NULL);
+    ret = list_node(node);
+    list_node_release(node);
 
     osi_sem_give(&queue->enqueue_sem);
 
@@ -176,9 +187,9 @@ void *fixed_queue_try_peek_first(fixed_queue_t *queue)
         return NULL;
     }
 
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
+    portENTER_CRITICAL(&queue->lock);
     ret = list_is_empty(queue->list) ? NULL : list_front(queue->list);
-    osi_mutex_unlock(&queue->lock);
+    portEXIT_CRITICAL(&queue->lock);
 
     return ret;
 }
@@ -191,35 +202,38 @@ void *fixed_queue_try_peek_last(fixed_queue_t *queue)
         return NULL;
     }
 
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
+    portENTER_CRITICAL(&queue->lock);
     ret = list_is_empty(queue->list) ? NULL : list_back(queue->list);
-    osi_mutex_unlock(&queue->lock);
+    portEXIT_CRITICAL(&queue->lock);
 
     return ret;
 }
 
 void *fixed_queue_try_remove_from_queue(fixed_queue_t *queue, void *data)
 {
-    bool removed = false;
+    list_node_t *node;
 
     if (queue == NULL) {
         return NULL;
     }
 
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    if (list_contains(queue->list, data) &&
-            osi_sem_take(&queue->dequeue_sem, 0) == 0) {
-        removed = list_remove(queue->list, data);
-        assert(removed);
+    // Reserve an element first, the semaphore cannot be taken in the critical section
+    if (osi_sem_take(&queue->dequeue_sem, 0) != 0) {
+        return NULL;
     }
-    osi_mutex_unlock(&queue->lock);
 
-    if (removed) {
-        osi_sem_give(&queue->enqueue_sem);
-        return data;
+    portENTER_CRITICAL(&queue->lock);
+    node = list_unlink(queue->list, data);
+    portEXIT_CRITICAL(&queue->lock);
+
+    if (node == NULL) {
+        osi_sem_give(&queue->dequeue_sem);
+        return NULL;
     }
 
-    return NULL;
+    list_node_release(node);
+    osi_sem_give(&queue->enqueue_sem);
+    return data;
 }
 
 list_t *fixed_queue_get_list(fixed_queue_t *queue)
@@ -118,4 +118,26 @@ list_node_t *list_next(const list_node_t *node);
 // |node| must not equal the value returned by |list_end|.
 void *list_node(const list_node_t *node);
 
+// The functions below split the insertion and removal of an element from the
+// allocation and the release of its node, so that a list can be modified in a
+// critical section, without calling the allocator.
+
+// Allocates a node holding |data|, to insert with |list_append_node|. Returns NULL
+// if out of memory. |data| may not be NULL.
+list_node_t *list_node_alloc(void *data);
+
+// Releases a node returned by |list_node_alloc| or unlinked from a list. The free
+// function of the list is not called.
+void list_node_release(list_node_t *node);
+
+// Appends |node| to the end of |list|. Neither |list| nor |node| may be NULL.
+void list_append_node(list_t *list, list_node_t *node);
+
+// Unlinks the first node of |list| and returns it, or NULL if |list| is empty.
+list_node_t *list_unlink_front(list_t *list);
+
+// Unlinks the first node holding |data| from |list| and returns it, or NULL if
+// |data| is not in |list|.
+list_node_t *list_unlink(list_t *list, const void *data);
+
 #endif /* _LIST_H_ */
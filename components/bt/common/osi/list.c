@@ -152,14 +152,38 @@ bool list_prepend(list_t *list, void *data)
 bool list_append(list_t *list, void *data)
 {
     assert(list != NULL);
+    assert(data != NULL);
+    list_node_t *node = list_node_alloc(data);
+    if (!node) {
+        return false;
+    }
+    list_append_node(list, node);
+    return true;
+}
+
+list_node_t *list_node_alloc(void *data)
+{
     assert(data != NULL);
     list_node_t *node = (list_node_t *)osi_calloc(sizeof(list_node_t));
     if (!node) {
         OSI_TRACE_ERROR("%s osi_calloc failed.\n", __FUNCTION__ );
-        return false;
+        return NULL;
     }
     node->next = NULL;
     node->data = data;
+    return node;
+}
+
+void list_node_release(list_node_t *node)
+{
+    osi_free(node);
+}
+
+void list_append_node(list_t *list, list_node_t *node)
+{
+    assert(list != NULL);
+    assert(node != NULL);
+    node->next = NULL;
     if (list->tail == NULL) {
         list->head = node;
         list->tail = node;
@@ -168,7 +192,42 @@ bool list_append(list_t *list, void *data)
         list->tail = node;
     }
     ++list->length;
-    return true;
+}
+
+list_node_t *list_unlink_front(list_t *list)
+{
+    assert(list != NULL);
+    list_node_t *node = list->head;
+    if (node == NULL) {
+        return NULL;
+    }
+    list->head = node->next;
+    if (list->tail == node) {
+        list->tail = NULL;
+    }
+    --list->length;
+    return node;
+}
+
+list_node_t *list_unlink(list_t *list, const void *data)
+{
+    assert(list != NULL);
+    assert(data != NULL);
+    for (list_node_t *prev = NULL, *node = list->head; node; prev = node, node = node->next) {
+        if (node->data == data) {
+            if (prev) {
+                prev->next = node->next;
+            } else {
+                list->head = node->next;
+            }
+            if (list->tail == node) {
+                list->tail = prev;
+            }
+            --list->length;
+            return node;
+        }
+    }
+    return NULL;
 }
 
 bool list_remove(list_t *list, void *data)
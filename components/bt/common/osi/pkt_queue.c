@@ -4,15 +4,16 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "freertos/FreeRTOS.h"
 #include "osi/pkt_queue.h"
 #include "osi/allocator.h"
-#include "osi/mutex.h"
 
 
 STAILQ_HEAD(pkt_queue_header, pkt_linked_item);
 
+/* the items are linked in place, so a spinlock held for a few pointer updates is enough */
 struct pkt_queue {
-    osi_mutex_t lock;
+    portMUX_TYPE lock;
     size_t length;
     struct pkt_queue_header header;
 } pkt_queue_t;
@@ -23,10 +24,7 @@ struct pkt_queue *pkt_queue_create(void)
     if (queue == NULL) {
         return NULL;
     }
-    if (osi_mutex_new(&queue->lock) != 0) {
-        osi_free(queue);
-        return NULL;
-    }
+    portMUX_INITIALIZE(&queue->lock);
     struct pkt_queue_header *p = &queue->header;
     STAILQ_INIT(p);
 
@@ -40,19 +38,23 @@ static void pkt_queue_cleanup(struct pkt_queue *queue, pkt_queue_free_cb free_cb
     }
 
     struct pkt_queue_header *header = &queue->header;
-    pkt_linked_item_t *item = STAILQ_FIRST(header);
+    pkt_linked_item_t *item;
     pkt_linked_item_t *tmp;
 
     pkt_queue_free_cb free_func = (free_cb != NULL) ? free_cb : (pkt_queue_free_cb)osi_free_func;
 
+    /* detach the items, they are freed out of the critical section */
+    portENTER_CRITICAL(&queue->lock);
+    item = STAILQ_FIRST(header);
+    STAILQ_INIT(header);
+    queue->length = 0;
+    portEXIT_CRITICAL(&queue->lock);
+
     while (item != NULL) {
         tmp = STAILQ_NEXT(item, next);
         free_func(item);
         item = tmp;
-        queue->length--;
     }
-    STAILQ_INIT(header);
-    queue->length = 0;
 }
 
 void pkt_queue_flush(struct pkt_queue *queue, pkt_queue_free_cb free_cb)
@@ -60,9 +62,7 @@ void pkt_queue_flush(struct pkt_queue *queue, pkt_queue_free_cb free_cb)
     if (queue == NULL) {
         return;
     }
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
     pkt_queue_cleanup(queue, free_cb);
-    osi_mutex_unlock(&queue->lock);
 }
 
 void pkt_queue_destroy(struct pkt_queue *queue, pkt_queue_free_cb free_cb)
@@ -70,11 +70,7 @@ void pkt_queue_destroy(struct pkt_queue *queue, pkt_queue_free_cb free_cb)
     if (queue == NULL) {
         return;
     }
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
     pkt_queue_cleanup(queue, free_cb);
-    osi_mutex_unlock(&queue->lock);
-
-    osi_mutex_free(&queue->lock);
     osi_free(queue);
 }
 
@@ -86,7 +82,7 @@ pkt_linked_item_t *pkt_queue_dequeue(struct pkt_queue *queue)
 
     struct pkt_linked_item *item;
     struct pkt_queue_header *header;
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
+    portENTER_CRITICAL(&queue->lock);
     header = &queue->header;
     item = STAILQ_FIRST(header);
     if (item != NULL) {
@@ -95,7 +91,7 @@ pkt_linked_item_t *pkt_queue_dequeue(struct pkt_queue *queue)
             queue->length--;
         }
     }
-    osi_mutex_unlock(&queue->lock);
+    portEXIT_CRITICAL(&queue->lock);
 
     return item;
 }
@@ -107,11 +103,11 @@ bool pkt_queue_enqueue(struct pkt_queue *queue, pkt_linked_item_t *item)
     }
 
     struct pkt_queue_header *header;
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
+    portENTER_CRITICAL(&queue->lock);
     header = &queue->header;
     STAILQ_INSERT_TAIL(header, item, next);
     queue->length++;
-    osi_mutex_unlock(&queue->lock);
+    portEXIT_CRITICAL(&queue->lock);
 
     return true;
 }
@@ -137,9 +133,9 @@ pkt_linked_item_t *pkt_queue_try_peek_first(struct pkt_queue *queue)
 
     struct pkt_queue_header *header = &queue->header;
     pkt_linked_item_t *item;
-    osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
+    portENTER_CRITICAL(&queue->lock);
     item = STAILQ_FIRST(header);
-    osi_mutex_unlock(&queue->lock);
+    portEXIT_CRITICAL(&queue->lock);
 
     return item;
 }
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A notification to send with esp_nimble_gatts_notify_batch()
+ */
+typedef struct {
+    uint16_t conn_handle;   /*!< Connection to send the notification to */
+    uint16_t attr_handle;   /*!< Handle of the characteristic value */
+    const void *data;       /*!< Value to notify, copied into an mbuf */
+    uint16_t len;           /*!< Length of the value */
+} esp_nimble_notify_t;
+
+/**
+ * @brief Sizes of the msys mbuf pools
+ */
+typedef struct {
+    uint16_t block_count[2];    /*!< Number of blocks of msys_1 and msys_2 */
+    uint16_t block_size[2];     /*!< Size of the blocks of msys_1 and msys_2, not smaller than the configured ones
+                                     (BT_NIMBLE_MSYS_1_BLOCK_SIZE and BT_NIMBLE_MSYS_2_BLOCK_SIZE) */
+    bool ext_ram;               /*!< Allocate the pools from PSRAM */
+} esp_nimble_msys_config_t;
+
+/**
+ * @brief Send several notifications, possibly to several connections
+ *
+ * Notifications to the same connection that follow one another in the array are sent together with
+ * ATT Handle Value Multiple Notifications, if the peer supports it, instead of one ATT PDU per notification.
+ * Spread the notifications to several centrals by interleaving runs of notifications to each of them.
+ *
+ * The notifications are sent in order. When the mbuf pools are exhausted, the function stops and returns
+ * BLE_HS_ENOMEM: retry from notifies[*num_sent] on the next BLE_GAP_EVENT_NOTIFY_TX event.
+ *
+ * @param[in]  notifies Notifications to send
+ * @param[in]  num      Number of notifications
+ * @param[out] num_sent Number of notifications passed to the stack, can be NULL
+ *
+ * @return 0 on success, a NimBLE host error code (BLE_HS_E*) otherwise
+ */
+int esp_nimble_gatts_notify_batch(const esp_nimble_notify_t *notifies, size_t num, size_t *num_sent);
+
+/**
+ * @brief Request the fastest link settings for a connection
+ *
+ * Requests the maximum Data Length Extension payload (251 bytes) and, if the controller supports it, the LE 2M PHY.
+ * Call this function on BLE_GAP_EVENT_CONNECT. The results are reported by the BLE_GAP_EVENT_DATA_LEN_CHG and
+ * BLE_GAP_EVENT_PHY_UPDATE_COMPLETE events, the peer may refuse them.
+ *
+ * @param conn_handle Connection handle
+ *
+ * @return 0 on success, a NimBLE host error code (BLE_HS_E*) otherwise
+ */
+int esp_nimble_gap_conn_optimize(uint16_t conn_handle);
+
+#if CONFIG_BT_LE_CONTROLLER_NPL_OS_PORTING_SUPPORT
+/**
+ * @brief Set the sizes of the msys mbuf pools
+ *
+ * By default, the pools are sized by the BT_NIMBLE_MSYS_* options. Must be called before nimble_port_init().
+ *
+ * @param config Pool sizes
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the pools are already allocated
+ *      - ESP_ERR_NOT_SUPPORTED if ext_ram is set but there is no PSRAM, or the pools are allocated by the
+ *        controller (BT_LE_MSYS_INIT_IN_CONTROLLER)
+ */
+esp_err_t esp_nimble_msys_set_config(const esp_nimble_msys_config_t *config);
+#endif // CONFIG_BT_LE_CONTROLLER_NPL_OS_PORTING_SUPPORT
+
+#ifdef __cplusplus
+}
+#endif
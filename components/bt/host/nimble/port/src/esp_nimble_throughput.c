@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "host/ble_hs.h"
+#include "host/ble_gap.h"
+#include "host/ble_gatt.h"
+#include "esp_nimble_throughput.h"
+
+#define NOTIFY_MULTI_MAX            8       /* notifications sent in a single call to the host */
+#define CONN_DATA_LEN_TX_OCTETS     251     /* maximum LL payload with Data Length Extension */
+#define CONN_DATA_LEN_TX_TIME       2120    /* time to send 251 bytes on the LE 1M PHY, in us */
+
+/**
+ * Send the notifications to the connection of the first one, which follow one another, up to NOTIFY_MULTI_MAX
+ */
+static int notify_run(const esp_nimble_notify_t *notifies, size_t num, size_t *sent)
+{
+    struct ble_gatt_notif tuples[NOTIFY_MULTI_MAX];
+    uint16_t conn_handle = notifies[0].conn_handle;
+    size_t count = 0;
+    int rc;
+
+    while (count < NOTIFY_MULTI_MAX && count < num && notifies[count].conn_handle == conn_handle) {
+        tuples[count].handle = notifies[count].attr_handle;
+        tuples[count].value = ble_hs_mbuf_from_flat(notifies[count].data, notifies[count].len);
+        if (tuples[count].value == NULL) {
+            break;
+        }
+        count++;
+    }
+    if (count == 0) {
+        return BLE_HS_ENOMEM;
+    }
+
+    /* the host frees the mbufs passed to it, whether the notifications are sent or not */
+#if MYNEWT_VAL(BLE_GATT_NOTIFY_MULTIPLE)
+    if (count > 1) {
+        rc = ble_gatts_notify_multiple_custom(conn_handle, count, tuples);
+        *sent = rc == 0 ? count : 0;
+        return rc;
+    }
+#endif
+    rc = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (rc == 0) {
+            rc = ble_gatts_notify_custom(conn_handle, tuples[i].handle, tuples[i].value);
+            *sent = rc == 0 ? i + 1 : i;
+        } else {
+            os_mbuf_free_chain(tuples[i].value);
+        }
+    }
+    return rc;
+}
+
+int esp_nimble_gatts_notify_batch(const esp_nimble_notify_t *notifies, size_t num, size_t *num_sent)
+{
+    size_t sent = 0;
+    int rc = 0;
+
+    if (notifies == NULL && num > 0) {
+        rc = BLE_HS_EINVAL;
+    }
+    while (rc == 0 && sent < num) {
+        size_t count = 0;
+        rc = notify_run(&notifies[sent], num - sent, &count);
+        sent += count;
+    }
+    if (num_sent) {
+        *num_sent = sent;
+    }
+    return rc;
+}
+
+int esp_nimble_gap_conn_optimize(uint16_t conn_handle)
+{
+    int rc = ble_gap_set_data_len(conn_handle, CONN_DATA_LEN_TX_OCTETS, CONN_DATA_LEN_TX_TIME);
+    if (rc != 0) {
+        return rc;
+    }
+#if MYNEWT_VAL(BLE_LL_CFG_FEAT_LE_2M_PHY)
+    rc = ble_gap_set_prefered_le_phy(conn_handle, BLE_GAP_LE_PHY_2M_MASK, BLE_GAP_LE_PHY_2M_MASK,
+                                     BLE_GAP_LE_PHY_CODED_ANY);
+#endif
+    return rc;
+}
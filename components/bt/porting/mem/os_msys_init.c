@@ -15,6 +15,7 @@
 
 #if CONFIG_BT_NIMBLE_ENABLED
 #include "syscfg/syscfg.h"
+#include "esp_nimble_throughput.h"
 #endif
 
 #define SYSINIT_PANIC_ASSERT(rc)        assert(rc);
@@ -81,23 +82,54 @@ static struct os_mempool os_msys_init_2_mempool;
 #endif // !CONFIG_BT_LE_MSYS_INIT_IN_CONTROLLER
 #endif
 
+/* sizes of the pools, the configured ones unless changed by esp_nimble_msys_set_config() */
+static uint16_t s_msys_block_count[2] = { OS_MSYS_1_BLOCK_COUNT, OS_MSYS_2_BLOCK_COUNT };
+static uint16_t s_msys_block_size[2] = { OS_MSYS_1_BLOCK_SIZE, OS_MSYS_2_BLOCK_SIZE };
+
 #if CONFIG_BT_LE_MSYS_INIT_IN_CONTROLLER
 extern int  r_esp_ble_msys_init(uint16_t msys_size1, uint16_t msys_size2, uint16_t msys_cnt1, uint16_t msys_cnt2, uint8_t from_heap);
 extern void r_esp_ble_msys_deinit(void);
 
+static bool s_msys_initialized;
+
 int os_msys_init(void)
 {
-    return r_esp_ble_msys_init(SYSINIT_MSYS_1_MEMBLOCK_SIZE,
-                             SYSINIT_MSYS_2_MEMBLOCK_SIZE,
-                             OS_MSYS_1_BLOCK_COUNT,
-                             OS_MSYS_2_BLOCK_COUNT,
-                             OS_MSYS_BLOCK_FROM_HEAP);
+    int rc = r_esp_ble_msys_init(OS_ALIGN(s_msys_block_size[0], 4),
+                                 OS_ALIGN(s_msys_block_size[1], 4),
+                                 s_msys_block_count[0],
+                                 s_msys_block_count[1],
+                                 OS_MSYS_BLOCK_FROM_HEAP);
+    s_msys_initialized = (rc == 0);
+    return rc;
 }
 
 void os_msys_deinit(void)
 {
     r_esp_ble_msys_deinit();
+    s_msys_initialized = false;
+}
+
+#if CONFIG_BT_NIMBLE_ENABLED
+esp_err_t esp_nimble_msys_set_config(const esp_nimble_msys_config_t *config)
+{
+    if (config == NULL || config->block_count[0] == 0 || config->block_count[1] == 0 ||
+        config->block_size[0] < OS_MSYS_1_BLOCK_SIZE || config->block_size[1] < OS_MSYS_2_BLOCK_SIZE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* the controller allocates the pools itself */
+    if (config->ext_ram) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (s_msys_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (int i = 0; i < 2; i++) {
+        s_msys_block_count[i] = config->block_count[i];
+        s_msys_block_size[i] = config->block_size[i];
+    }
+    return ESP_OK;
 }
+#endif // CONFIG_BT_NIMBLE_ENABLED
 
 #else // CONFIG_BT_LE_MSYS_INIT_IN_CONTROLLER
 
@@ -164,18 +196,32 @@ os_msys_init_once(void *data, struct os_mempool *mempool,
     SYSINIT_PANIC_ASSERT(rc == 0);
 }
 
+static bool s_msys_ext_ram;
+
+static os_membuf_t *
+os_msys_pool_alloc(int idx)
+{
+    size_t size = sizeof(os_membuf_t) *
+                  OS_MEMPOOL_SIZE(s_msys_block_count[idx], OS_ALIGN(s_msys_block_size[idx], 4));
+
+    if (s_msys_ext_ram) {
+        return (os_membuf_t *)heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    return (os_membuf_t *)bt_osi_mem_calloc(1, size);
+}
+
 int
 os_msys_buf_alloc(void)
 {
 #if OS_MSYS_1_BLOCK_COUNT > 0
-    os_msys_init_1_data = (os_membuf_t *)bt_osi_mem_calloc(1, (sizeof(os_membuf_t) * SYSINIT_MSYS_1_MEMPOOL_SIZE));
+    os_msys_init_1_data = os_msys_pool_alloc(0);
     if (!os_msys_init_1_data) {
         return ESP_ERR_NO_MEM;
     }
 #endif
 
 #if OS_MSYS_2_BLOCK_COUNT > 0
-    os_msys_init_2_data = (os_membuf_t *)bt_osi_mem_calloc(1, (sizeof(os_membuf_t) * SYSINIT_MSYS_2_MEMPOOL_SIZE));
+    os_msys_init_2_data = os_msys_pool_alloc(1);
     if (!os_msys_init_2_data) {
 #if OS_MSYS_1_BLOCK_COUNT > 0
        bt_osi_mem_free(os_msys_init_1_data);
@@ -203,6 +249,37 @@ os_msys_buf_free(void)
 
 }
 
+#if CONFIG_BT_NIMBLE_ENABLED
+esp_err_t esp_nimble_msys_set_config(const esp_nimble_msys_config_t *config)
+{
+    if (config == NULL || config->block_count[0] == 0 || config->block_count[1] == 0 ||
+        config->block_size[0] < OS_MSYS_1_BLOCK_SIZE || config->block_size[1] < OS_MSYS_2_BLOCK_SIZE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+#if !CONFIG_SPIRAM
+    if (config->ext_ram) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+#endif
+#if OS_MSYS_1_BLOCK_COUNT > 0
+    if (os_msys_init_1_data) {
+        return ESP_ERR_INVALID_STATE;
+    }
+#endif
+#if OS_MSYS_2_BLOCK_COUNT > 0
+    if (os_msys_init_2_data) {
+        return ESP_ERR_INVALID_STATE;
+    }
+#endif
+    for (int i = 0; i < 2; i++) {
+        s_msys_block_count[i] = config->block_count[i];
+        s_msys_block_size[i] = config->block_size[i];
+    }
+    s_msys_ext_ram = config->ext_ram;
+    return ESP_OK;
+}
+#endif // CONFIG_BT_NIMBLE_ENABLED
+
 void os_msys_init(void)
 {
 #if OS_MSYS_SANITY_ENABLED
@@ -215,8 +292,8 @@ void os_msys_init(void)
     os_msys_init_once(os_msys_init_1_data,
                       &os_msys_init_1_mempool,
                       &os_msys_init_1_mbuf_pool,
-                      OS_MSYS_1_BLOCK_COUNT,
-                      SYSINIT_MSYS_1_MEMBLOCK_SIZE,
+                      s_msys_block_count[0],
+                      OS_ALIGN(s_msys_block_size[0], 4),
                       "msys_1");
 #endif
 
@@ -224,8 +301,8 @@ void os_msys_init(void)
     os_msys_init_once(os_msys_init_2_data,
                       &os_msys_init_2_mempool,
                       &os_msys_init_2_mbuf_pool,
-                      OS_MSYS_2_BLOCK_COUNT,
-                      SYSINIT_MSYS_2_MEMBLOCK_SIZE,
+                      s_msys_block_count[1],
+                      OS_ALIGN(s_msys_block_size[1], 4),
                       "msys_2");
 #endif
 
@@ -1,22 +1,67 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <string.h>
 #include <stdio.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
 #include "os/os_mbuf.h"
 #include "esp_hci_transport.h"
 #include "esp_hci_internal.h"
 #include "esp_hci_driver.h"
 #include "esp_bt.h"
+#include "esp_bit_defs.h"
+
+/* The host copies the packet before its receive callback returns, so the buffers for the packets to the host
+ * are only in use during the callback. Keep a few of them instead of allocating one for each packet. */
+#define HCI_DRIVER_VHCI_C2H_BUF_NUM     (2)
+#define HCI_DRIVER_VHCI_C2H_BUF_SIZE    (1 + MAX(2 + 255, 4 + CONFIG_BT_LE_ACL_BUF_SIZE))
 
 typedef struct {
     hci_driver_forward_fn *forward_cb;
     const esp_vhci_host_callback_t *host_recv_cb;
+    uint8_t *c2h_bufs;
+    uint32_t c2h_buf_free_mask;
 } hci_driver_vhci_env_t;
 
 static hci_driver_vhci_env_t s_hci_driver_vhci_env;
+static portMUX_TYPE s_hci_driver_vhci_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t *
+hci_driver_vhci_c2h_buf_get(uint32_t len)
+{
+    int idx = -1;
+
+    if (len <= HCI_DRIVER_VHCI_C2H_BUF_SIZE) {
+        portENTER_CRITICAL_SAFE(&s_hci_driver_vhci_lock);
+        idx = __builtin_ffs(s_hci_driver_vhci_env.c2h_buf_free_mask) - 1;
+        if (idx >= 0) {
+            s_hci_driver_vhci_env.c2h_buf_free_mask &= ~BIT(idx);
+        }
+        portEXIT_CRITICAL_SAFE(&s_hci_driver_vhci_lock);
+    }
+    if (idx >= 0) {
+        return &s_hci_driver_vhci_env.c2h_bufs[idx * HCI_DRIVER_VHCI_C2H_BUF_SIZE];
+    }
+    /* All buffers are in use or the packet is larger, fall back to the heap. */
+    return malloc(len);
+}
+
+static void
+hci_driver_vhci_c2h_buf_put(uint8_t *buf)
+{
+    uint8_t *bufs = s_hci_driver_vhci_env.c2h_bufs;
+
+    if (bufs && buf >= bufs && buf < bufs + HCI_DRIVER_VHCI_C2H_BUF_NUM * HCI_DRIVER_VHCI_C2H_BUF_SIZE) {
+        portENTER_CRITICAL_SAFE(&s_hci_driver_vhci_lock);
+        s_hci_driver_vhci_env.c2h_buf_free_mask |= BIT((buf - bufs) / HCI_DRIVER_VHCI_C2H_BUF_SIZE);
+        portEXIT_CRITICAL_SAFE(&s_hci_driver_vhci_lock);
+    } else {
+        free(buf);
+    }
+}
 
 static int
 hci_driver_vhci_controller_tx(hci_driver_data_type_t data_type, uint8_t *data, uint32_t length)
@@ -28,8 +73,17 @@ hci_driver_vhci_controller_tx(hci_driver_data_type_t data_type, uint8_t *data, u
 
     if (data_type == HCI_DRIVER_TYPE_ACL) {
         om = (struct os_mbuf *)data;
+        if (SLIST_NEXT(om, om_next) == NULL && OS_MBUF_LEADINGSPACE(om) >= 1) {
+            /* The packet is contiguous, prepend the packet type in place and pass the mbuf data to the host. */
+            om = os_mbuf_prepend(om, 1);
+            assert(om);
+            om->om_data[0] = HCI_DRIVER_TYPE_ACL;
+            rc = s_hci_driver_vhci_env.forward_cb(data_type, om->om_data, length + 1, HCI_DRIVER_DIR_C2H);
+            os_mbuf_free_chain(om);
+            return rc;
+        }
         buf_len = length + 1;
-        buf = malloc(buf_len);
+        buf = hci_driver_vhci_c2h_buf_get(buf_len);
         /* TODO: If there is no memory, should handle it in the controller. */
         assert(buf);
         buf[0] = HCI_DRIVER_TYPE_ACL;
@@ -37,7 +91,7 @@ hci_driver_vhci_controller_tx(hci_driver_data_type_t data_type, uint8_t *data, u
         os_mbuf_free_chain(om);
     } else if (data_type == HCI_DRIVER_TYPE_EVT) {
         buf_len = length + 1;
-        buf = malloc(buf_len);
+        buf = hci_driver_vhci_c2h_buf_get(buf_len);
         /* TODO: If there is no memory, should handle it in the controller. */
         assert(buf != NULL);
         buf[0] = HCI_DRIVER_TYPE_EVT;
@@ -46,7 +100,7 @@ hci_driver_vhci_controller_tx(hci_driver_data_type_t data_type, uint8_t *data, u
     }
 
     rc = s_hci_driver_vhci_env.forward_cb(data_type, buf, buf_len, HCI_DRIVER_DIR_C2H);
-    free(buf);
+    hci_driver_vhci_c2h_buf_put(buf);
 
     return rc;
 }
@@ -90,6 +144,11 @@ static int
 hci_driver_vhci_init(hci_driver_forward_fn *cb)
 {
     memset(&s_hci_driver_vhci_env, 0, sizeof(hci_driver_vhci_env_t));
+    s_hci_driver_vhci_env.c2h_bufs = malloc(HCI_DRIVER_VHCI_C2H_BUF_NUM * HCI_DRIVER_VHCI_C2H_BUF_SIZE);
+    if (!s_hci_driver_vhci_env.c2h_bufs) {
+        return -1;
+    }
+    s_hci_driver_vhci_env.c2h_buf_free_mask = BIT(HCI_DRIVER_VHCI_C2H_BUF_NUM) - 1;
     s_hci_driver_vhci_env.forward_cb = cb;
     return 0;
 }
@@ -97,6 +156,7 @@ hci_driver_vhci_init(hci_driver_forward_fn *cb)
 static void
 hci_driver_vhci_deinit(void)
 {
+    free(s_hci_driver_vhci_env.c2h_bufs);
     memset(&s_hci_driver_vhci_env, 0, sizeof(hci_driver_vhci_env_t));
 }
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -9,8 +9,14 @@
 */
 
 #include <stdbool.h>
+#include <inttypes.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "unity.h"
+#include "esp_bt.h"
+#include "esp_timer.h"
 #include "sdkconfig.h"
 
 // btdm_controller_compile_version_check defined only for ESP32
@@ -22,3 +28,59 @@ TEST_CASE("bt_controller_git_commit_check", "[bt_common]")
     TEST_ASSERT(btdm_controller_compile_version_check() == true);
 }
 #endif
+
+#if CONFIG_BT_CONTROLLER_ENABLED && !CONFIG_IDF_TARGET_ESP32
+#define TEST_VHCI_CMD_NUM   1000
+
+extern void set_leak_threshold(int threshold);
+
+static SemaphoreHandle_t s_vhci_evt_sem;
+
+static void test_vhci_send_available(void)
+{
+}
+
+static int test_vhci_host_recv(uint8_t *data, uint16_t len)
+{
+    // Command Complete event of HCI_Read_Local_Version_Information
+    if (len >= 6 && data[0] == 0x04 && data[1] == 0x0e && data[4] == 0x01 && data[5] == 0x10) {
+        xSemaphoreGive(s_vhci_evt_sem);
+    }
+    return 0;
+}
+
+TEST_CASE("bt_vhci_cmd_evt_throughput", "[bt_common]")
+{
+    static const esp_vhci_host_callback_t vhci_host_cb = {
+        .notify_host_send_available = test_vhci_send_available,
+        .notify_host_recv = test_vhci_host_recv,
+    };
+    // HCI_Read_Local_Version_Information
+    uint8_t cmd[] = {0x01, 0x01, 0x10, 0x00};
+
+    // The PHY keeps the memory allocated by the first initialization of the controller
+    set_leak_threshold(-2048);
+    s_vhci_evt_sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(s_vhci_evt_sem);
+    esp_bt_controller_config_t bt_cfg = BT_CONTROLLER_INIT_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_bt_controller_init(&bt_cfg));
+    TEST_ESP_OK(esp_bt_controller_enable(ESP_BT_MODE_BLE));
+    TEST_ESP_OK(esp_vhci_host_register_callback(&vhci_host_cb));
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < TEST_VHCI_CMD_NUM; i++) {
+        while (!esp_vhci_host_check_send_available()) {
+            vTaskDelay(1);
+        }
+        esp_vhci_host_send_packet(cmd, sizeof(cmd));
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(s_vhci_evt_sem, pdMS_TO_TICKS(1000)));
+    }
+    int64_t diff = esp_timer_get_time() - start;
+    printf("%d HCI commands took %"PRId64" us, %"PRId64" commands/s\n",
+           TEST_VHCI_CMD_NUM, diff, TEST_VHCI_CMD_NUM * 1000000LL / diff);
+
+    TEST_ESP_OK(esp_bt_controller_disable());
+    TEST_ESP_OK(esp_bt_controller_deinit());
+    vSemaphoreDelete(s_vhci_evt_sem);
+}
+#endif // CONFIG_BT_CONTROLLER_ENABLED && !CONFIG_IDF_TARGET_ESP32
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -18,6 +18,8 @@
 
 #define ANSI_COLOR_DEFAULT      39      /** Default foreground color */
 
+#define CMD_HASH_BUCKETS        32      /** Number of buckets of the command lookup table, power of 2 */
+
 typedef struct cmd_item_ {
     /**
      * Command name (statically allocated by application)
@@ -34,9 +36,12 @@ typedef struct cmd_item_ {
     char *hint;
     esp_console_cmd_func_t func;                        //!< pointer to the command handler (without user context)
     esp_console_cmd_func_with_context_t func_w_context; //!< pointer to the command handler (with user context)
+    esp_console_cmd_binary_func_t func_binary;          //!< optional pointer to the binary request handler
     void *argtable;                                     //!< optional pointer to arg table
     void *context;                                      //!< optional pointer to user context
+    uint32_t hash;                                      //!< hash of the command name
     SLIST_ENTRY(cmd_item_) next;                        //!< next command in the list
+    SLIST_ENTRY(cmd_item_) hash_next;                   //!< next command in the same bucket of the lookup table
 } cmd_item_t;
 
 typedef void (*const fn_print_arg_t)(cmd_item_t*);
@@ -44,6 +49,9 @@ typedef void (*const fn_print_arg_t)(cmd_item_t*);
 /** linked list of command structures */
 static SLIST_HEAD(cmd_list_, cmd_item_) s_cmd_list;
 
+/** hash table of the same command structures, for looking commands up by name */
+static SLIST_HEAD(cmd_bucket_, cmd_item_) s_cmd_hash[CMD_HASH_BUCKETS];
+
 /** run-time configuration options */
 static esp_console_config_t s_config = {
     .heap_alloc_caps = MALLOC_CAP_DEFAULT
@@ -52,8 +60,22 @@ static esp_console_config_t s_config = {
 /** temporary buffer used for command line parsing */
 static char *s_tmp_line_buf;
 
+/** temporary array of arguments used for command line parsing */
+static char **s_tmp_argv;
+
 static const cmd_item_t *find_command_by_name(const char *name);
 
+/* FNV-1a hash of the command name */
+static uint32_t cmd_name_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= (uint8_t) * name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 static esp_console_help_verbose_level_e s_verbose_level = ESP_CONSOLE_HELP_VERBOSE_LEVEL_1;
 
 esp_err_t esp_console_init(const esp_console_config_t *config)
@@ -75,6 +97,15 @@ esp_err_t esp_console_init(const esp_console_config_t *config)
     if (s_tmp_line_buf == NULL) {
         return ESP_ERR_NO_MEM;
     }
+    /* Allocated once, so that running a command line doesn't allocate memory */
+    if (s_config.max_cmdline_args > 0) {
+        s_tmp_argv = heap_caps_calloc(s_config.max_cmdline_args, sizeof(char *), s_config.heap_alloc_caps);
+        if (s_tmp_argv == NULL) {
+            free(s_tmp_line_buf);
+            s_tmp_line_buf = NULL;
+            return ESP_ERR_NO_MEM;
+        }
+    }
     return ESP_OK;
 }
 
@@ -85,12 +116,17 @@ esp_err_t esp_console_deinit(void)
     }
     free(s_tmp_line_buf);
     s_tmp_line_buf = NULL;
+    free(s_tmp_argv);
+    s_tmp_argv = NULL;
     cmd_item_t *it, *tmp;
     SLIST_FOREACH_SAFE(it, &s_cmd_list, next, tmp) {
         SLIST_REMOVE(&s_cmd_list, it, cmd_item_, next);
         free(it->hint);
         free(it);
     }
+    for (size_t i = 0; i < CMD_HASH_BUCKETS; i++) {
+        SLIST_INIT(&s_cmd_hash[i]);
+    }
     return ESP_OK;
 }
 
@@ -107,6 +143,7 @@ esp_err_t esp_console_cmd_deregister(const char *cmd_name)
         return ESP_ERR_INVALID_ARG;
     }
     esp_console_rm_item_free_hint(item);
+    SLIST_REMOVE(&s_cmd_hash[item->hash & (CMD_HASH_BUCKETS - 1)], item, cmd_item_, hash_next);
     heap_caps_free(item);
     return ESP_OK;
 }
@@ -120,7 +157,7 @@ esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd)
     if (strchr(cmd->command, ' ') != NULL) {
         return ESP_ERR_INVALID_ARG;
     }
-    if ((cmd->func == NULL && cmd->func_w_context == NULL)
+    if ((cmd->func == NULL && cmd->func_w_context == NULL && cmd->func_binary == NULL)
             || (cmd->func != NULL && cmd->func_w_context != NULL)) {
         return ESP_ERR_INVALID_ARG;
     }
@@ -131,6 +168,8 @@ esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd)
         if (item == NULL) {
             return ESP_ERR_NO_MEM;
         }
+        item->hash = cmd_name_hash(cmd->command);
+        SLIST_INSERT_HEAD(&s_cmd_hash[item->hash & (CMD_HASH_BUCKETS - 1)], item, hash_next);
     } else {
         // remove from list and free the old hint, because we will alloc new hint for the command
         esp_console_rm_item_free_hint(item);
@@ -152,13 +191,10 @@ esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd)
     }
     item->argtable = cmd->argtable;
 
-    if (cmd->func) {
-        item->func = cmd->func;
-    } else {
-        // cmd->func_w_context is valid here according to check above
-        item->func_w_context = cmd->func_w_context;
-        item->context = cmd->context;
-    }
+    item->func = cmd->func;
+    item->func_w_context = cmd->func_w_context;
+    item->func_binary = cmd->func_binary;
+    item->context = cmd->context;
 
     cmd_item_t *last;
     cmd_item_t *it;
@@ -218,51 +254,85 @@ const char *esp_console_get_hint(const char *buf, int *color, int *bold)
 
 static const cmd_item_t *find_command_by_name(const char *name)
 {
-    const cmd_item_t *cmd = NULL;
+    uint32_t hash = cmd_name_hash(name);
     cmd_item_t *it;
-    size_t len = strlen(name);
-    SLIST_FOREACH(it, &s_cmd_list, next) {
-        if (strlen(it->command) == len &&
-                strcmp(name, it->command) == 0) {
-            cmd = it;
-            break;
+    SLIST_FOREACH(it, &s_cmd_hash[hash & (CMD_HASH_BUCKETS - 1)], hash_next) {
+        if (it->hash == hash && strcmp(name, it->command) == 0) {
+            return it;
         }
     }
-    return cmd;
+    return NULL;
+}
+
+esp_err_t esp_console_run_argv(int argc, char **argv, int *cmd_ret)
+{
+    if (argc <= 0 || argv == NULL || argv[0] == NULL || cmd_ret == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const cmd_item_t *cmd = find_command_by_name(argv[0]);
+    if (cmd == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (cmd->func) {
+        *cmd_ret = (*cmd->func)(argc, argv);
+    } else if (cmd->func_w_context) {
+        *cmd_ret = (*cmd->func_w_context)(cmd->context, argc, argv);
+    } else {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    return ESP_OK;
 }
 
 esp_err_t esp_console_run(const char *cmdline, int *cmd_ret)
 {
-    if (s_tmp_line_buf == NULL) {
+    if (s_tmp_line_buf == NULL || s_tmp_argv == NULL) {
         return ESP_ERR_INVALID_STATE;
     }
-    char **argv = (char **) heap_caps_calloc(s_config.max_cmdline_args, sizeof(char *), s_config.heap_alloc_caps);
-    if (argv == NULL) {
-        return ESP_ERR_NO_MEM;
-    }
     strlcpy(s_tmp_line_buf, cmdline, s_config.max_cmdline_length);
 
-    size_t argc = esp_console_split_argv(s_tmp_line_buf, argv,
+    size_t argc = esp_console_split_argv(s_tmp_line_buf, s_tmp_argv,
                                          s_config.max_cmdline_args);
     if (argc == 0) {
-        free(argv);
         return ESP_ERR_INVALID_ARG;
     }
-    const cmd_item_t *cmd = find_command_by_name(argv[0]);
+    return esp_console_run_argv(argc, s_tmp_argv, cmd_ret);
+}
+
+esp_err_t esp_console_run_binary(const char *command, const void *data, size_t len, int *cmd_ret)
+{
+    if (command == NULL || (data == NULL && len != 0) || cmd_ret == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const cmd_item_t *cmd = find_command_by_name(command);
     if (cmd == NULL) {
-        free(argv);
         return ESP_ERR_NOT_FOUND;
     }
-    if (cmd->func) {
-        *cmd_ret = (*cmd->func)(argc, argv);
-    }
-    if (cmd->func_w_context) {
-        *cmd_ret = (*cmd->func_w_context)(cmd->context, argc, argv);
+    if (cmd->func_binary == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
     }
-    free(argv);
+    *cmd_ret = (*cmd->func_binary)(cmd->context, data, len);
     return ESP_OK;
 }
 
+esp_err_t esp_console_run_batch(const char *const *cmdlines, size_t count, int *cmd_rets, size_t *num_run)
+{
+    if ((cmdlines == NULL || cmd_rets == NULL) && count != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = ESP_OK;
+    size_t i;
+    for (i = 0; i < count; i++) {
+        ret = esp_console_run(cmdlines[i], &cmd_rets[i]);
+        if (ret != ESP_OK) {
+            break;
+        }
+    }
+    if (num_run) {
+        *num_run = i;
+    }
+    return ret;
+}
+
 static struct {
     struct arg_str *help_cmd;
     struct arg_int *verbose_level;
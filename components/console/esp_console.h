@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -175,6 +175,15 @@ typedef int (*esp_console_cmd_func_t)(int argc, char **argv);
  */
 typedef int (*esp_console_cmd_func_with_context_t)(void *context, int argc, char **argv);
 
+/**
+ * @brief Console command function handling a binary request
+ * @param context the user context of the command
+ * @param data request data, as passed to esp_console_run_binary
+ * @param len length of the request data, in bytes
+ * @return console command return code, 0 indicates "success"
+ */
+typedef int (*esp_console_cmd_binary_func_t)(void *context, const void *data, size_t len);
+
 /**
  * @brief Console command description
  */
@@ -215,9 +224,15 @@ typedef struct {
     esp_console_cmd_func_with_context_t func_w_context;
     /**
      * Context pointer to user-defined per-command context data.
-     * This is used if context aware function \c func_w_context is set.
+     * This is used if context aware function \c func_w_context or \c func_binary is set.
      */
     void *context;
+    /**
+     * Optional pointer to a function handling binary requests for the command,
+     * see esp_console_run_binary. A command may set only this function, in which
+     * case it can't be run from a command line.
+     */
+    esp_console_cmd_binary_func_t func_binary;
 } esp_console_cmd_t;
 
 /**
@@ -232,7 +247,7 @@ typedef struct {
  *      - ESP_ERR_NO_MEM if out of memory
  *      - ESP_ERR_INVALID_ARG if command description includes invalid arguments
  *      - ESP_ERR_INVALID_ARG if both func and func_w_context members of cmd are non-NULL
- *      - ESP_ERR_INVALID_ARG if both func and func_w_context members of cmd are NULL
+ *      - ESP_ERR_INVALID_ARG if func, func_w_context and func_binary members of cmd are all NULL
  */
 esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd);
 
@@ -255,10 +270,68 @@ esp_err_t esp_console_cmd_deregister(const char *cmd_name);
  *      - ESP_ERR_INVALID_ARG, if the command line is empty, or only contained
  *        whitespace
  *      - ESP_ERR_NOT_FOUND, if command with given name wasn't registered
+ *      - ESP_ERR_NOT_SUPPORTED, if the command only handles binary requests
  *      - ESP_ERR_INVALID_STATE, if esp_console_init wasn't called
  */
 esp_err_t esp_console_run(const char *cmdline, int *cmd_ret);
 
+/**
+ * @brief Run a command with already split arguments
+ *
+ * Unlike esp_console_run, the command line isn't copied and split, so this may
+ * be used by applications which receive the arguments in a structured form,
+ * e.g. from a test fixture. It doesn't allocate memory and doesn't require
+ * esp_console_init to be called.
+ *
+ * @param argc number of arguments, including the command name
+ * @param argv array of argc arguments, argv[0] being the command name.
+ *             The array and the strings may be modified by the command.
+ * @param[out] cmd_ret return code from the command (set if command was run)
+ * @return
+ *      - ESP_OK, if command was run
+ *      - ESP_ERR_INVALID_ARG, if there are no arguments
+ *      - ESP_ERR_NOT_FOUND, if command with given name wasn't registered
+ *      - ESP_ERR_NOT_SUPPORTED, if the command only handles binary requests
+ */
+esp_err_t esp_console_run_argv(int argc, char **argv, int *cmd_ret);
+
+/**
+ * @brief Run a command with a binary request
+ *
+ * Calls the \c func_binary function of the command with the request data as is,
+ * without splitting it into arguments or parsing them with argtable. The framing
+ * of the requests on the transport (e.g. UART) is up to the application.
+ *
+ * @param command name of the command
+ * @param data request data passed to the command, may be NULL if len is 0
+ * @param len length of the request data, in bytes
+ * @param[out] cmd_ret return code from the command (set if command was run)
+ * @return
+ *      - ESP_OK, if command was run
+ *      - ESP_ERR_INVALID_ARG, if an argument is invalid
+ *      - ESP_ERR_NOT_FOUND, if command with given name wasn't registered
+ *      - ESP_ERR_NOT_SUPPORTED, if the command has no \c func_binary function
+ */
+esp_err_t esp_console_run_binary(const char *command, const void *data, size_t len, int *cmd_ret);
+
+/**
+ * @brief Run several command lines
+ *
+ * The command lines are run in order with esp_console_run, until all of them
+ * were run or one of them couldn't be run. A non-zero return code of a command
+ * doesn't stop the batch.
+ *
+ * @param cmdlines array of command lines
+ * @param count number of command lines
+ * @param[out] cmd_rets array of count return codes of the commands, set for the commands which were run
+ * @param[out] num_run number of command lines run, may be NULL
+ * @return
+ *      - ESP_OK, if all the command lines were run
+ *      - ESP_ERR_INVALID_ARG, if an argument is invalid
+ *      - Others: the error returned by esp_console_run for the command line at index num_run
+ */
+esp_err_t esp_console_run_batch(const char *const *cmdlines, size_t count, int *cmd_rets, size_t *num_run);
+
 /**
  * @brief Split command line into arguments in place
  * @verbatim
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -348,3 +348,83 @@ TEST_CASE("esp console re-register commands", "[console][ignore]")
     TEST_ESP_OK(esp_console_start_repl(s_repl));
     vTaskDelay(pdMS_TO_TICKS(5000));
 }
+
+static int do_binary_cmd(void *context, const void *data, size_t len)
+{
+    memcpy(context, data, len);
+    return (int)len;
+}
+
+static int do_count_args_cmd(int argc, char **argv)
+{
+    return argc;
+}
+
+TEST_CASE("esp console run binary and split arguments", "[console]")
+{
+    esp_console_config_t console_config = ESP_CONSOLE_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_console_init(&console_config));
+
+    uint8_t received[4] = {0};
+    const esp_console_cmd_t bin_cmd = {
+        .command = "bin",
+        .func_binary = do_binary_cmd,
+        .context = received,
+    };
+    const esp_console_cmd_t args_cmd = {
+        .command = "args",
+        .func = do_count_args_cmd,
+    };
+    TEST_ESP_OK(esp_console_cmd_register(&bin_cmd));
+    TEST_ESP_OK(esp_console_cmd_register(&args_cmd));
+
+    int ret;
+    const uint8_t request[] = {0x00, 0x20, 0xff, 0x0a};
+    TEST_ESP_OK(esp_console_run_binary("bin", request, sizeof(request), &ret));
+    TEST_ASSERT_EQUAL(sizeof(request), ret);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(request, received, sizeof(request));
+    TEST_ESP_ERR(ESP_ERR_NOT_SUPPORTED, esp_console_run("bin", &ret));
+    TEST_ESP_ERR(ESP_ERR_NOT_SUPPORTED, esp_console_run_binary("args", request, sizeof(request), &ret));
+    TEST_ESP_ERR(ESP_ERR_NOT_FOUND, esp_console_run_binary("none", request, sizeof(request), &ret));
+
+    char arg0[] = "args";
+    char arg1[] = "with space";
+    char *argv[] = {arg0, arg1, NULL};
+    TEST_ESP_OK(esp_console_run_argv(2, argv, &ret));
+    TEST_ASSERT_EQUAL(2, ret);
+
+    TEST_ESP_OK(esp_console_deinit());
+}
+
+TEST_CASE("esp console run batch of command lines", "[console]")
+{
+    esp_console_config_t console_config = ESP_CONSOLE_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_console_init(&console_config));
+
+    /* Enough commands to have several of them in each bucket of the lookup table */
+    static char names[100][8];
+    for (int i = 0; i < 100; i++) {
+        snprintf(names[i], sizeof(names[i]), "cmd%d", i);
+        const esp_console_cmd_t cmd = {
+            .command = names[i],
+            .func = do_count_args_cmd,
+        };
+        TEST_ESP_OK(esp_console_cmd_register(&cmd));
+    }
+    TEST_ESP_OK(esp_console_cmd_deregister("cmd42"));
+
+    const char *lines[] = {"cmd0", "cmd99 a b", "cmd41 a", "cmd42", "cmd43"};
+    int rets[5] = {0};
+    size_t num_run = 0;
+    TEST_ESP_OK(esp_console_run_batch(lines, 3, rets, &num_run));
+    TEST_ASSERT_EQUAL(3, num_run);
+    TEST_ASSERT_EQUAL(1, rets[0]);
+    TEST_ASSERT_EQUAL(3, rets[1]);
+    TEST_ASSERT_EQUAL(2, rets[2]);
+
+    /* The batch stops at the command which isn't registered anymore */
+    TEST_ESP_ERR(ESP_ERR_NOT_FOUND, esp_console_run_batch(lines, 5, rets, &num_run));
+    TEST_ASSERT_EQUAL(3, num_run);
+
+    TEST_ESP_OK(esp_console_deinit());
+}
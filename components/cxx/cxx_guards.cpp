@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -34,12 +34,47 @@ extern "C" void __cxa_guard_dummy(void);
  * Layout of the guard object (defined by the ABI).
  *
  * Compiler will check lower byte before calling guard functions.
+ *
+ * Once the scheduler has started, the fields are accessed atomically. A task starts the initialization
+ * by setting 'pending' with a compare-and-swap, without taking s_static_init_mutex. Only the tasks which
+ * find the guard pending, and the task releasing a guard which has waiters, take s_static_init_mutex,
+ * so the initialization of different statics by several tasks doesn't contend on the mutex.
  */
 typedef struct {
     uint8_t ready;      //!< nonzero if initialization is done
     uint8_t pending;    //!< nonzero if initialization is in progress
+    uint8_t waiters;    //!< nonzero if a task has waited for the initialization of this guard
 } guard_t;
 
+static inline uint8_t guard_load(uint8_t* field)
+{
+    return __atomic_load_n(field, __ATOMIC_SEQ_CST);
+}
+
+static inline void guard_store(uint8_t* field, uint8_t value)
+{
+    __atomic_store_n(field, value, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * Try to become the task doing the initialization.
+ * Returns 1 if g->pending has been set by the current task, and the initialization has to be done,
+ * 0 if the initialization is done already, or -1 if another task is doing the initialization.
+ */
+static int try_acquire_guard_obj(guard_t* g)
+{
+    uint8_t expected = 0;
+    if (!__atomic_compare_exchange_n(&g->pending, &expected, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+        return -1;
+    }
+    /* 'ready' is set before 'pending' is cleared by __cxa_guard_release, check it again */
+    if (guard_load(&g->ready)) {
+        guard_store(&g->pending, 0);
+        return 0;
+    }
+    return 1;
+}
+
 static void static_init_prepare()
 {
     portENTER_CRITICAL(&s_init_spinlock);
@@ -58,7 +93,7 @@ static void static_init_prepare()
  * Use s_static_init_wait_sem to wait until guard->pending == 0.
  * Preconditions:
  * - s_static_init_mutex taken
- * - guard.pending == 1
+ * - guard.waiters == 1
  * Postconditions:
  * - s_static_init_mutex taken
  * - guard.pending == 0
@@ -71,7 +106,7 @@ static void wait_for_guard_obj(guard_t* g)
                                                s_static_init_max_waiting_count);
 #endif
 
-    do {
+    while (guard_load(&g->pending)) {
         auto result = xSemaphoreGive(s_static_init_mutex);
         assert(result);
         static_cast<void>(result);
@@ -91,7 +126,7 @@ static void wait_for_guard_obj(guard_t* g)
         /* Semaphore may have been given because some other guard object became ready.
          * Check the guard object we need and wait again if it is still pending.
          */
-    } while (g->pending);
+    }
     s_static_init_waiting_count--;
 }
 
@@ -122,70 +157,87 @@ extern "C" int __cxa_guard_acquire(__guard* pg)
              */
             abort();
         }
-    } else {
-        if (s_static_init_mutex == NULL) {
-            static_init_prepare();
+        if (g->ready) {
+            /* Static initialization has been done already; nothing to do here */
+            return 0;
         }
-
-        /* We don't need to use double-checked locking pattern here, as the compiler
-         * must generate code to check if the first byte of *pg is non-zero, before
-         * calling __cxa_guard_acquire.
-         */
-        auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
-        assert(result);
-        static_cast<void>(result);
-        if (g->pending) {
-            /* Another task is doing initialization at the moment; wait until it calls
-             * __cxa_guard_release or __cxa_guard_abort
-             */
-            wait_for_guard_obj(g);
-            /* At this point there are two scenarios:
-             * - the task which was doing static initialization has called __cxa_guard_release,
-             *   which means that g->ready is set. We need to return 0.
-             * - the task which was doing static initialization has called __cxa_guard_abort,
-             *   which means that g->ready is not set; we should acquire the guard and return 1,
-             *   same as for the case if we didn't have to wait.
-             * Note: actually the second scenario is unlikely to occur in the current
-             * configuration because exception support is disabled.
-             */
-        }
-    }
-    int ret;
-    if (g->ready) {
-        /* Static initialization has been done by another task; nothing to do here */
-        ret = 0;
-    } else {
-        /* Current task can start doing static initialization */
         g->pending = 1;
-        ret = 1;
+        return 1;
     }
-    if (scheduler_started) {
-        auto result = xSemaphoreGive(s_static_init_mutex);
-        assert(result);
-        static_cast<void>(result);
+
+    /* We don't need to use double-checked locking pattern here, as the compiler
+     * must generate code to check if the first byte of *pg is non-zero, before
+     * calling __cxa_guard_acquire.
+     */
+    int ret = try_acquire_guard_obj(g);
+    if (ret >= 0) {
+        return ret;
+    }
+
+    /* Another task is doing initialization at the moment; wait until it calls
+     * __cxa_guard_release or __cxa_guard_abort
+     */
+    if (s_static_init_mutex == NULL) {
+        static_init_prepare();
     }
+    auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
+    assert(result);
+    static_cast<void>(result);
+    do {
+        /* Tell the initializing task to signal the waiting tasks. It clears 'pending' before checking
+         * 'waiters', so either it signals, or 'pending' is seen cleared here.
+         */
+        guard_store(&g->waiters, 1);
+        wait_for_guard_obj(g);
+        /* At this point there are two scenarios:
+         * - the task which was doing static initialization has called __cxa_guard_release,
+         *   which means that g->ready is set. We need to return 0.
+         * - the task which was doing static initialization has called __cxa_guard_abort,
+         *   which means that g->ready is not set; we should acquire the guard and return 1,
+         *   same as for the case if we didn't have to wait.
+         * Note: actually the second scenario is unlikely to occur in the current
+         * configuration because exception support is disabled.
+         * Another task may acquire the guard before this one, wait again then.
+         */
+        ret = try_acquire_guard_obj(g);
+    } while (ret < 0);
+    result = xSemaphoreGive(s_static_init_mutex);
+    assert(result);
+    static_cast<void>(result);
     return ret;
 }
 
+/**
+ * Clear guard->pending and unblock the tasks waiting for it, if any
+ */
+static void release_guard_obj(guard_t* g)
+{
+    guard_store(&g->pending, 0);
+    if (!guard_load(&g->waiters)) {
+        return;
+    }
+    /* s_static_init_mutex has been created by the waiting task */
+    auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
+    assert(result);
+    static_cast<void>(result);
+    signal_waiting_tasks();
+    result = xSemaphoreGive(s_static_init_mutex);
+    assert(result);
+    static_cast<void>(result);
+}
+
 extern "C" void __cxa_guard_release(__guard* pg) throw()
 {
     guard_t* g = reinterpret_cast<guard_t*>(pg);
     const auto scheduler_started = xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
-    if (scheduler_started) {
-        auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
-        assert(result);
-        static_cast<void>(result);
-    }
     assert(g->pending && "tried to release a guard which wasn't acquired");
-    g->pending = 0;
     /* Initialization was successful */
-    g->ready = 1;
+    guard_store(&g->ready, 1);
     if (scheduler_started) {
         /* Unblock the tasks waiting for static initialization to complete */
-        signal_waiting_tasks();
-        auto result = xSemaphoreGive(s_static_init_mutex);
-        assert(result);
-        static_cast<void>(result);
+        release_guard_obj(g);
+    } else {
+        g->pending = 0;
     }
 }
 
@@ -193,20 +245,13 @@ extern "C" void __cxa_guard_abort(__guard* pg) throw()
 {
     guard_t* g = reinterpret_cast<guard_t*>(pg);
     const auto scheduler_started = xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
-    if (scheduler_started) {
-        auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
-        assert(result);
-        static_cast<void>(result);
-    }
     assert(!g->ready && "tried to abort a guard which is ready");
     assert(g->pending && "tried to release a guard which is not acquired");
-    g->pending = 0;
     if (scheduler_started) {
         /* Unblock the tasks waiting for static initialization to complete */
-        signal_waiting_tasks();
-        auto result = xSemaphoreGive(s_static_init_mutex);
-        assert(result);
-        static_cast<void>(result);
+        release_guard_obj(g);
+    } else {
+        g->pending = 0;
     }
 }
 
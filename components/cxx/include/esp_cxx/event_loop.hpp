@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "esp_err.h"
+#include "esp_event.h"
+#include "sdkconfig.h"
+
+namespace esp_cxx {
+
+/**
+ * @brief Description of an event: its base, ID and the type of its data
+ *
+ * For example, with ``ESP_EVENT_DEFINE_BASE(APP_EVENT)``:
+ *
+ *     struct reading_t { int32_t value; };
+ *     using ReadingEvent = esp_cxx::Event<APP_EVENT, 0, reading_t>;
+ *
+ * @tparam Base Event base, defined with ESP_EVENT_DEFINE_BASE
+ * @tparam Id Event ID
+ * @tparam Data Type of the data of the event, trivially copyable, or void for an event without data
+ */
+template <const esp_event_base_t &Base, int32_t Id, typename Data = void>
+struct Event {
+    static_assert(std::is_void_v<Data> || std::is_trivially_copyable_v<Data>,
+                  "the data of the events is copied with memcpy");
+    using data_type = Data;
+    static constexpr int32_t id = Id;
+
+    static esp_event_base_t base()
+    {
+        return Base;
+    }
+};
+
+/**
+ * @brief Type of the handlers of event E: void (*)(const E::data_type &), or void (*)() if E has no data
+ */
+template <typename E>
+using EventHandler = std::conditional_t<std::is_void_v<typename E::data_type>, void (*)(),
+      void (*)(const std::conditional_t<std::is_void_v<typename E::data_type>, int, typename E::data_type> &)>;
+
+/**
+ * @brief Event loop which only accepts the events Events, with their data types
+ *
+ * Posting an event which isn't part of Events, or data of the wrong type, fails at compile time. Handlers are
+ * registered as template arguments, so that they are called directly from a trampoline function, without a
+ * heap-allocated closure. The component using this class needs esp_event in its requirements.
+ *
+ * The event loop itself is created with esp_event_loop_create(), which allocates its queue and task on the heap.
+ *
+ * @tparam Events Events accepted by the loop, instances of esp_cxx::Event
+ */
+template <typename... Events>
+class TypedEventLoop {
+    template <typename E>
+    static constexpr bool is_event = (std::is_same_v<E, Events> || ...);
+
+    template <typename E, EventHandler<E> Handler>
+    static void trampoline(void *, esp_event_base_t, int32_t, void *data)
+    {
+        if constexpr (std::is_void_v<typename E::data_type>) {
+            Handler();
+        } else {
+            Handler(*static_cast<const typename E::data_type *>(data));
+        }
+    }
+
+public:
+    TypedEventLoop() = default;
+
+    ~TypedEventLoop()
+    {
+        if (m_handle != nullptr) {
+            esp_event_loop_delete(m_handle);
+        }
+    }
+
+    TypedEventLoop(const TypedEventLoop &) = delete;
+    TypedEventLoop &operator=(const TypedEventLoop &) = delete;
+
+    /**
+     * @brief Create the event loop, see esp_event_loop_create()
+     */
+    esp_err_t create(const esp_event_loop_args_t &args)
+    {
+        if (m_handle != nullptr) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        return esp_event_loop_create(&args, &m_handle);
+    }
+
+    /**
+     * @brief Register Handler for the event E, see esp_event_handler_register_with()
+     */
+    template <typename E, EventHandler<E> Handler>
+    esp_err_t register_handler()
+    {
+        static_assert(is_event<E>, "the event isn't handled by this loop");
+        return esp_event_handler_register_with(m_handle, E::base(), E::id, &trampoline<E, Handler>, nullptr);
+    }
+
+    /**
+     * @brief Unregister Handler for the event E, see esp_event_handler_unregister_with()
+     */
+    template <typename E, EventHandler<E> Handler>
+    esp_err_t unregister_handler()
+    {
+        static_assert(is_event<E>, "the event isn't handled by this loop");
+        return esp_event_handler_unregister_with(m_handle, E::base(), E::id, &trampoline<E, Handler>);
+    }
+
+    /**
+     * @brief Post the event E with its data, see esp_event_post_to()
+     */
+    template <typename E, typename D = typename E::data_type, std::enable_if_t<!std::is_void_v<D>, int> = 0>
+    esp_err_t post(const std::type_identity_t<D> &data, TickType_t ticks_to_wait = portMAX_DELAY)
+    {
+        static_assert(is_event<E>, "the event isn't handled by this loop");
+        return esp_event_post_to(m_handle, E::base(), E::id, &data, sizeof(D), ticks_to_wait);
+    }
+
+    /**
+     * @brief Post the event E, which has no data, see esp_event_post_to()
+     */
+    template <typename E, std::enable_if_t<std::is_void_v<typename E::data_type>, int> = 0>
+    esp_err_t post(TickType_t ticks_to_wait = portMAX_DELAY)
+    {
+        static_assert(is_event<E>, "the event isn't handled by this loop");
+        return esp_event_post_to(m_handle, E::base(), E::id, nullptr, 0, ticks_to_wait);
+    }
+
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+    /**
+     * @brief Post the event E with its data from an ISR, see esp_event_isr_post_to()
+     */
+    template <typename E, typename D = typename E::data_type, std::enable_if_t<!std::is_void_v<D>, int> = 0>
+    esp_err_t post_from_isr(const std::type_identity_t<D> &data, BaseType_t *task_unblocked)
+    {
+        static_assert(is_event<E>, "the event isn't handled by this loop");
+        return esp_event_isr_post_to(m_handle, E::base(), E::id, &data, sizeof(D), task_unblocked);
+    }
+#endif
+
+    /**
+     * @brief Dispatch the posted events, for a loop created without a task, see esp_event_loop_run()
+     */
+    esp_err_t run(TickType_t ticks_to_run)
+    {
+        return esp_event_loop_run(m_handle, ticks_to_run);
+    }
+
+    esp_event_loop_handle_t handle() const
+    {
+        return m_handle;
+    }
+
+private:
+    esp_event_loop_handle_t m_handle = nullptr;
+};
+
+} // namespace esp_cxx
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "freertos/FreeRTOS.h"
+#include "freertos/ringbuf.h"
+
+namespace esp_cxx {
+
+/**
+ * @brief No-split ring buffer of up to N items of type T, with statically allocated storage
+ *
+ * The control block and the storage area (sized with RINGBUF_NOSPLIT_STORAGE_SIZE) are members of the object,
+ * no heap memory is used. Items are copied in and out of the ring buffer, so T must be trivially copyable.
+ * The component using this class needs esp_ringbuf in its requirements.
+ *
+ * @tparam T Type of the items
+ * @tparam N Maximum number of items in the ring buffer
+ */
+template <typename T, size_t N>
+class RingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "items of a ring buffer are copied with memcpy");
+    static_assert(N > 0, "a ring buffer holds at least one item");
+
+public:
+    RingBuffer()
+        : m_handle(xRingbufferCreateStatic(sizeof(m_storage), RINGBUF_TYPE_NOSPLIT, m_storage, &m_ringbuf)) { }
+
+    ~RingBuffer()
+    {
+        vRingbufferDelete(m_handle);
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    /**
+     * @brief Copy an item into the ring buffer
+     *
+     * @return true if the item has been sent, false if the ring buffer stayed full for ticks_to_wait
+     */
+    bool send(const T &item, TickType_t ticks_to_wait = portMAX_DELAY)
+    {
+        return xRingbufferSend(m_handle, &item, sizeof(T), ticks_to_wait) == pdTRUE;
+    }
+
+    /**
+     * @brief Copy an item into the ring buffer, from an ISR
+     *
+     * @return true if the item has been sent, false if the ring buffer is full
+     */
+    bool send_from_isr(const T &item, BaseType_t *higher_priority_task_woken)
+    {
+        return xRingbufferSendFromISR(m_handle, &item, sizeof(T), higher_priority_task_woken) == pdTRUE;
+    }
+
+    /**
+     * @brief Copy the oldest item of the ring buffer to item, and remove it from the ring buffer
+     *
+     * @return true if an item has been received, false if the ring buffer stayed empty for ticks_to_wait
+     */
+    bool receive(T &item, TickType_t ticks_to_wait = portMAX_DELAY)
+    {
+        size_t size;
+        void *data = xRingbufferReceive(m_handle, &size, ticks_to_wait);
+        if (data == nullptr) {
+            return false;
+        }
+        memcpy(&item, data, sizeof(T));
+        vRingbufferReturnItem(m_handle, data);
+        return true;
+    }
+
+    /**
+     * @brief Copy the oldest item of the ring buffer to item, and remove it from the ring buffer, from an ISR
+     *
+     * @return true if an item has been received, false if the ring buffer is empty
+     */
+    bool receive_from_isr(T &item, BaseType_t *higher_priority_task_woken)
+    {
+        size_t size;
+        void *data = xRingbufferReceiveFromISR(m_handle, &size);
+        if (data == nullptr) {
+            return false;
+        }
+        memcpy(&item, data, sizeof(T));
+        vRingbufferReturnItemFromISR(m_handle, data, higher_priority_task_woken);
+        return true;
+    }
+
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+    /**
+     * @brief Handle of the ring buffer, to use the ring buffer API (e.g. to acquire items in place)
+     */
+    RingbufHandle_t handle() const
+    {
+        return m_handle;
+    }
+
+private:
+    StaticRingbuffer_t m_ringbuf;
+    alignas(4) uint8_t m_storage[RINGBUF_NOSPLIT_STORAGE_SIZE(sizeof(T), N)];
+    RingbufHandle_t m_handle;
+};
+
+} // namespace esp_cxx
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+namespace esp_cxx {
+
+/**
+ * @brief FreeRTOS queue of up to N items of type T, with statically allocated storage
+ *
+ * The control block and the storage area are members of the object, no heap memory is used.
+ * Items are copied in and out of the queue, so T must be trivially copyable.
+ *
+ * @tparam T Type of the items
+ * @tparam N Maximum number of items in the queue
+ */
+template <typename T, size_t N>
+class StaticQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "items of a queue are copied with memcpy");
+    static_assert(N > 0, "a queue holds at least one item");
+
+public:
+    StaticQueue() : m_handle(xQueueCreateStatic(N, sizeof(T), m_storage, &m_queue)) { }
+
+    ~StaticQueue()
+    {
+        vQueueDelete(m_handle);
+    }
+
+    StaticQueue(const StaticQueue &) = delete;
+    StaticQueue &operator=(const StaticQueue &) = delete;
+
+    /**
+     * @brief Copy an item to the back of the queue
+     *
+     * @return true if the item has been sent, false if the queue stayed full for ticks_to_wait
+     */
+    bool send(const T &item, TickType_t ticks_to_wait = portMAX_DELAY)
+    {
+        return xQueueSend(m_handle, &item, ticks_to_wait) == pdTRUE;
+    }
+
+    /**
+     * @brief Copy an item to the front of the queue
+     *
+     * @return true if the item has been sent, false if the queue stayed full for ticks_to_wait
+     */
+    bool send_to_front(const T &item, TickType_t ticks_to_wait = portMAX_DELAY)
+    {
+        return xQueueSendToFront(m_handle, &item, ticks_to_wait) == pdTRUE;
+    }
+
+    /**
+     * @brief Copy an item to the back of the queue, from an ISR
+     *
+     * @return true if the item has been sent, false if the queue is full
+     */
+    bool send_from_isr(const T &item, BaseType_t *higher_priority_task_woken)
+    {
+        return xQueueSendFromISR(m_handle, &item, higher_priority_task_woken) == pdTRUE;
+    }
+
+    /**
+     * @brief Move the item at the front of the queue to item
+     *
+     * @return true if an item has been received, false if the queue stayed empty for ticks_to_wait
+     */
+    bool receive(T &item, TickType_t ticks_to_wait = portMAX_DELAY)
+    {
+        return xQueueReceive(m_handle, &item, ticks_to_wait) == pdTRUE;
+    }
+
+    /**
+     * @brief Move the item at the front of the queue to item, from an ISR
+     *
+     * @return true if an item has been received, false if the queue is empty
+     */
+    bool receive_from_isr(T &item, BaseType_t *higher_priority_task_woken)
+    {
+        return xQueueReceiveFromISR(m_handle, &item, higher_priority_task_woken) == pdTRUE;
+    }
+
+    /**
+     * @brief Number of items in the queue
+     */
+    size_t size() const
+    {
+        return uxQueueMessagesWaiting(m_handle);
+    }
+
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+    /**
+     * @brief Handle of the queue, to use the FreeRTOS API (e.g. with queue sets)
+     */
+    QueueHandle_t handle() const
+    {
+        return m_handle;
+    }
+
+private:
+    StaticQueue_t m_queue;
+    alignas(T) uint8_t m_storage[N * sizeof(T)];
+    QueueHandle_t m_handle;
+};
+
+} // namespace esp_cxx
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -14,6 +14,9 @@
 #include "unity.h"
 #include "unity_test_utils.h"
 #include "soc/soc.h"
+#include "esp_cxx/static_queue.hpp"
+#include "esp_cxx/ring_buffer.hpp"
+#include "esp_cxx/event_loop.hpp"
 
 extern "C" void setUp()
 {
@@ -319,6 +322,79 @@ TEST_CASE("stack smashing protection CXX", "[stack_smash]")
     recur_and_smash_cxx();
 }
 
+struct sample_t {
+    uint32_t seq;
+    int16_t value;
+};
+
+TEST_CASE("StaticQueue and RingBuffer copy typed items", "[misc]")
+{
+    esp_cxx::StaticQueue<sample_t, 4> queue;
+    esp_cxx::RingBuffer<sample_t, 4> ringbuf;
+    sample_t sample;
+
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue.send({i, static_cast<int16_t>(-i)}, 0));
+        TEST_ASSERT_TRUE(ringbuf.send({i, static_cast<int16_t>(-i)}, 0));
+    }
+    TEST_ASSERT_EQUAL(4, queue.size());
+    TEST_ASSERT_FALSE(queue.send({4, 0}, 0));
+    TEST_ASSERT_FALSE(ringbuf.send({4, 0}, 0));
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue.receive(sample, 0));
+        TEST_ASSERT_EQUAL(i, sample.seq);
+        TEST_ASSERT_EQUAL(-static_cast<int>(i), sample.value);
+        TEST_ASSERT_TRUE(ringbuf.receive(sample, 0));
+        TEST_ASSERT_EQUAL(i, sample.seq);
+        TEST_ASSERT_EQUAL(-static_cast<int>(i), sample.value);
+    }
+    TEST_ASSERT_FALSE(queue.receive(sample, 0));
+    TEST_ASSERT_FALSE(ringbuf.receive(sample, 0));
+}
+
+ESP_EVENT_DEFINE_BASE(TEST_CXX_EVENT);
+using SampleEvent = esp_cxx::Event<TEST_CXX_EVENT, 0, sample_t>;
+using StopEvent = esp_cxx::Event<TEST_CXX_EVENT, 1>;
+
+static uint32_t s_sample_sum;
+static int s_stop_count;
+
+static void on_sample(const sample_t &sample)
+{
+    s_sample_sum += sample.seq;
+}
+
+static void on_stop()
+{
+    s_stop_count++;
+}
+
+TEST_CASE("TypedEventLoop dispatches typed event data", "[misc]")
+{
+    s_sample_sum = 0;
+    s_stop_count = 0;
+    {
+        esp_cxx::TypedEventLoop<SampleEvent, StopEvent> loop;
+        esp_event_loop_args_t args = {
+            .queue_size = 4,
+            .task_name = NULL,
+            .task_priority = 0,
+            .task_stack_size = 0,
+            .task_core_id = 0,
+        };
+        TEST_ESP_OK(loop.create(args));
+        TEST_ESP_OK((loop.register_handler<SampleEvent, on_sample>()));
+        TEST_ESP_OK((loop.register_handler<StopEvent, on_stop>()));
+        TEST_ESP_OK(loop.post<SampleEvent>({3, 0}, 0));
+        TEST_ESP_OK(loop.post<SampleEvent>({4, 0}, 0));
+        TEST_ESP_OK(loop.post<StopEvent>(0));
+        TEST_ESP_OK(loop.run(pdMS_TO_TICKS(10)));
+        TEST_ASSERT_EQUAL(7, s_sample_sum);
+        TEST_ASSERT_EQUAL(1, s_stop_count);
+        TEST_ESP_OK((loop.unregister_handler<StopEvent, on_stop>()));
+    }
+}
+
 extern "C" void app_main(void)
 {
     s_testTLS.foo(); /* allocates memory that will be reused */
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -134,6 +134,71 @@ TEST_CASE("twai_mode_ext_no_ack_250kbps", "[twai-loop-back]")
     }
 }
 
+TEST_CASE("twai_receive_batch_with_rx_id_filter", "[twai-loop-back]")
+{
+    twai_timing_config_t t_config = TWAI_TIMING_CONFIG_500KBITS();
+    twai_filter_config_t f_config = TWAI_FILTER_CONFIG_ACCEPT_ALL();
+    // bind the TX and RX to the same GPIO to act like a loopback
+    twai_general_config_t g_config = TWAI_GENERAL_CONFIG_DEFAULT(0, 0, TWAI_MODE_NO_ACK);
+    g_config.tx_queue_len = 10;
+    g_config.rx_queue_len = 10;
+    TEST_ESP_OK(twai_driver_install(&g_config, &t_config, &f_config));
+    TEST_ESP_OK(twai_start());
+
+    const uint32_t ids[] = {0x100, 0x102, 0x1234567 | TWAI_RX_ID_FILTER_EXTD};
+    TEST_ESP_OK(twai_set_rx_id_filter(ids, sizeof(ids) / sizeof(ids[0])));
+    const uint32_t invalid_ids[] = {0x800};
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, twai_set_rx_id_filter(invalid_ids, 1));
+
+    // 0x100 to 0x103 as standard frames, then 0x1234567 as extended frame, 0x101 and 0x103 are filtered
+    twai_message_t tx_msg = {
+        .data_length_code = 1,
+        .self = true, // Transmitted message will also received by the same node
+    };
+    for (int i = 0; i < 4; i++) {
+        tx_msg.identifier = 0x100 + i;
+        tx_msg.data[0] = i;
+        TEST_ESP_OK(twai_transmit(&tx_msg, pdMS_TO_TICKS(1000)));
+    }
+    tx_msg.identifier = 0x1234567;
+    tx_msg.extd = true;
+    tx_msg.data[0] = 4;
+    TEST_ESP_OK(twai_transmit(&tx_msg, pdMS_TO_TICKS(1000)));
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    twai_rx_message_t rx_msgs[8];
+    size_t num = 0;
+    TEST_ESP_OK(twai_receive_batch(rx_msgs, 8, &num, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_EQUAL(3, num);
+    TEST_ASSERT_EQUAL_HEX32(0x100, rx_msgs[0].message.identifier);
+    TEST_ASSERT_EQUAL(0, rx_msgs[0].message.data[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x102, rx_msgs[1].message.identifier);
+    TEST_ASSERT_EQUAL(2, rx_msgs[1].message.data[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x1234567, rx_msgs[2].message.identifier);
+    TEST_ASSERT_TRUE(rx_msgs[2].message.extd);
+    for (int i = 1; i < num; i++) {
+        TEST_ASSERT_GREATER_OR_EQUAL(rx_msgs[i - 1].timestamp, rx_msgs[i].timestamp);
+    }
+    TEST_ASSERT_GREATER_THAN(0, rx_msgs[0].timestamp);
+    TEST_ESP_ERR(ESP_ERR_TIMEOUT, twai_receive_batch(rx_msgs, 8, &num, 0));
+
+    twai_status_info_t status_info;
+    TEST_ESP_OK(twai_get_status_info(&status_info));
+    TEST_ASSERT_EQUAL(2, status_info.rx_filtered_count);
+
+    // receive everything again after removing the filter
+    TEST_ESP_OK(twai_set_rx_id_filter(NULL, 0));
+    tx_msg.identifier = 0x101;
+    tx_msg.extd = false;
+    TEST_ESP_OK(twai_transmit(&tx_msg, pdMS_TO_TICKS(1000)));
+    twai_message_t rx_msg;
+    TEST_ESP_OK(twai_receive(&rx_msg, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_EQUAL_HEX32(0x101, rx_msg.identifier);
+
+    TEST_ESP_OK(twai_stop());
+    TEST_ESP_OK(twai_driver_uninstall());
+}
+
 static void s_test_sleep_retention(bool allow_pd)
 {
     // Prepare a TOP PD sleep
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -78,6 +78,7 @@ extern "C" {
 /** @endcond */
 
 #define TWAI_IO_UNUSED                   ((gpio_num_t) -1)   /**< Marks GPIO as unused in TWAI configuration */
+#define TWAI_RX_ID_FILTER_EXTD           0x80000000          /**< Flag to combine with an ID passed to twai_set_rx_id_filter() to match extended frames */
 
 /* ----------------------- Enum and Struct Definitions ---------------------- */
 
@@ -110,7 +111,7 @@ typedef struct {
     gpio_num_t clkout_io;           /**< CLKOUT GPIO number (optional, set to -1 if unused) */
     gpio_num_t bus_off_io;          /**< Bus off indicator GPIO number (optional, set to -1 if unused) */
     uint32_t tx_queue_len;          /**< Number of messages TX queue can hold (set to 0 to disable TX Queue) */
-    uint32_t rx_queue_len;          /**< Number of messages RX queue can hold */
+    uint32_t rx_queue_len;          /**< Number of messages RX queue (ring buffer filled by the ISR) can hold */
     uint32_t alerts_enabled;        /**< Bit field of alerts to enable (see documentation) */
     uint32_t clkout_divider;        /**< CLKOUT divider. Can be 1 or any even number from 2 to 14 (optional, set to 0 if unused) */
     int intr_flags;                 /**< Interrupt flags to set the priority of the driver's ISR. Note that to use the ESP_INTR_FLAG_IRAM, the CONFIG_TWAI_ISR_IN_IRAM option should be enabled first. */
@@ -136,8 +137,18 @@ typedef struct {
     uint32_t rx_overrun_count;      /**< Number of messages that were lost due to a RX FIFO overrun */
     uint32_t arb_lost_count;        /**< Number of instances arbitration was lost */
     uint32_t bus_error_count;       /**< Number of instances a bus error has occurred */
+    uint32_t rx_filtered_count;     /**< Number of messages that were dropped by the RX ID filter (see twai_set_rx_id_filter()) */
 } twai_status_info_t;
 
+/**
+ * @brief   Structure of a received message with its timestamp, see twai_receive_batch()
+ */
+typedef struct {
+    twai_message_t message;         /**< Received message */
+    int64_t timestamp;              /**< Time in microseconds since boot (esp_timer_get_time()) at which the ISR read the message from
+                                         the RX FIFO. All messages read by the same interrupt get the same timestamp. */
+} twai_rx_message_t;
+
 /* ------------------------------ Public API -------------------------------- */
 
 /**
@@ -365,6 +376,47 @@ esp_err_t twai_receive(twai_message_t *message, TickType_t ticks_to_wait);
  */
 esp_err_t twai_receive_v2(twai_handle_t handle, twai_message_t *message, TickType_t ticks_to_wait);
 
+/**
+ * @brief   Receive multiple TWAI messages with their timestamps
+ *
+ * This function blocks until at least one message is in the RX queue, then
+ * returns up to max_messages messages without blocking any further. Receiving
+ * the messages of a busy bus in batches needs far fewer calls than twai_receive(),
+ * e.g. when logging all the traffic.
+ *
+ * @param[out]  messages        Array of received messages, oldest first
+ * @param[in]   max_messages    Length of the array
+ * @param[out]  ret_num         Number of messages received
+ * @param[in]   ticks_to_wait   Number of FreeRTOS ticks to block waiting for the first message
+ *
+ * @return
+ *      - ESP_OK: At least one message successfully received from RX queue
+ *      - ESP_ERR_TIMEOUT: Timed out waiting for message
+ *      - ESP_ERR_INVALID_ARG: Arguments are invalid
+ *      - ESP_ERR_INVALID_STATE: TWAI driver is not installed
+ */
+esp_err_t twai_receive_batch(twai_rx_message_t *messages, size_t max_messages, size_t *ret_num, TickType_t ticks_to_wait);
+
+/**
+ * @brief Receive multiple TWAI messages with their timestamps via a given handle
+ *
+ * @note This is an advanced version of `twai_receive_batch` that can receive TWAI messages with a given handle.
+ *       Please refer to the documentation of `twai_receive_batch` for more details.
+ *
+ * @param[in]   handle          TWAI driver handle returned by `twai_driver_install_v2`
+ * @param[out]  messages        Array of received messages, oldest first
+ * @param[in]   max_messages    Length of the array
+ * @param[out]  ret_num         Number of messages received
+ * @param[in]   ticks_to_wait   Number of FreeRTOS ticks to block waiting for the first message
+ *
+ * @return
+ *      - ESP_OK: At least one message successfully received from RX queue
+ *      - ESP_ERR_TIMEOUT: Timed out waiting for message
+ *      - ESP_ERR_INVALID_ARG: Arguments are invalid
+ *      - ESP_ERR_INVALID_STATE: TWAI driver is not installed
+ */
+esp_err_t twai_receive_batch_v2(twai_handle_t handle, twai_rx_message_t *messages, size_t max_messages, size_t *ret_num, TickType_t ticks_to_wait);
+
 /**
  * @brief   Read TWAI driver alerts
  *
@@ -552,6 +604,46 @@ esp_err_t twai_clear_receive_queue(void);
  */
 esp_err_t twai_clear_receive_queue_v2(twai_handle_t handle);
 
+/**
+ * @brief   Set the IDs of the messages to receive
+ *
+ * The messages passing the acceptance filter (see twai_filter_config_t) are
+ * looked up in a hash table of the given IDs by the ISR, and dropped if their
+ * ID is not found, before they take up space in the RX queue. Unlike the
+ * acceptance filter, any set of IDs can be matched exactly. The dropped
+ * messages are counted in twai_status_info_t::rx_filtered_count.
+ *
+ * @note    The acceptance filter should still be used to drop as many messages
+ *          as possible in hardware, as each filtered message costs ISR time.
+ *
+ * @param[in] ids       IDs to receive, standard IDs, or extended IDs combined with TWAI_RX_ID_FILTER_EXTD
+ * @param[in] num_ids   Number of IDs, 0 to receive all the messages passing the acceptance filter
+ *
+ * @return
+ *      - ESP_OK: RX ID filter set
+ *      - ESP_ERR_INVALID_ARG: Arguments are invalid, e.g. an ID is out of range or more than 32768 IDs
+ *      - ESP_ERR_NO_MEM: Insufficient memory
+ *      - ESP_ERR_INVALID_STATE: TWAI driver is not installed
+ */
+esp_err_t twai_set_rx_id_filter(const uint32_t *ids, size_t num_ids);
+
+/**
+ * @brief   Set the IDs of the messages to receive via a given handle
+ *
+ * @note This is an advanced version of `twai_set_rx_id_filter` that can set the RX ID filter of a given TWAI driver handle.
+ *       Please refer to the documentation of `twai_set_rx_id_filter` for more details.
+ *
+ * @param[in] handle    TWAI driver handle returned by `twai_driver_install_v2`
+ * @param[in] ids       IDs to receive, standard IDs, or extended IDs combined with TWAI_RX_ID_FILTER_EXTD
+ * @param[in] num_ids   Number of IDs, 0 to receive all the messages passing the acceptance filter
+ *
+ * @return
+ *      - ESP_OK: RX ID filter set
+ *      - ESP_ERR_INVALID_ARG: Arguments are invalid, e.g. an ID is out of range or more than 32768 IDs
+ *      - ESP_ERR_NO_MEM: Insufficient memory
+ */
+esp_err_t twai_set_rx_id_filter_v2(twai_handle_t handle, const uint32_t *ids, size_t num_ids);
+
 #ifdef __cplusplus
 }
 #endif
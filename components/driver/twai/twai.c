@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <sys/param.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -16,6 +18,7 @@
 #include "esp_pm.h"
 #include "esp_attr.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "esp_clk_tree.h"
 #include "clk_ctrl_os.h"
 #include "esp_private/periph_ctrl.h"
@@ -53,6 +56,10 @@
 
 #define DRIVER_DEFAULT_INTERRUPTS   0xE7        //Exclude data overrun (bit[3]) and brp_div (bit[4])
 
+#define RX_POP_CHUNK                8           //Max frames parsed in one critical section when reading the RX ring buffer
+#define RX_ID_FILTER_EMPTY          0xFFFFFFFF  //Free slot of the RX ID filter table, not a valid ID
+#define RX_ID_FILTER_MAX_IDS        32768
+
 #define ALERT_LOG_LEVEL_WARNING     TWAI_ALERT_ARB_LOST  //Alerts above and including this level use ESP_LOGW
 #define ALERT_LOG_LEVEL_ERROR       TWAI_ALERT_TX_FAILED //Alerts above and including this level use ESP_LOGE
 
@@ -72,6 +79,18 @@
 
 /* ------------------ Typedefs, structures, and variables ------------------- */
 
+//Received frame in the RX ring buffer
+typedef struct {
+    int64_t timestamp;
+    twai_hal_frame_t frame;
+} twai_rx_slot_t;
+
+//Hash table of the IDs accepted by the RX ID filter (open addressing with linear probing, at most half full)
+typedef struct {
+    uint32_t shift;         //32 - log2(number of slots)
+    uint32_t keys[];        //ID | TWAI_RX_ID_FILTER_EXTD, or RX_ID_FILTER_EMPTY
+} twai_rx_id_filter_t;
+
 //Control structure for TWAI driver
 typedef struct twai_obj_t {
     int controller_id;
@@ -91,7 +110,12 @@ typedef struct twai_obj_t {
     intr_handle_t isr_handle;
     //TX and RX
     QueueHandle_t tx_queue;
-    QueueHandle_t rx_queue;
+    twai_rx_slot_t *rx_ring;            //Received frames, written by the ISR, rx_msg_count frames from rx_ring_read
+    uint32_t rx_ring_len;
+    uint32_t rx_ring_read;
+    SemaphoreHandle_t rx_semphr;        //Given by the ISR when frames were added to the RX ring buffer
+    twai_rx_id_filter_t *rx_id_filter;  //NULL to receive all the frames passing the acceptance filter
+    uint32_t rx_filtered_count;
     int tx_msg_count;
     int rx_msg_count;
     //Alerts
@@ -133,8 +157,49 @@ static void twai_alert_handler(twai_obj_t *p_twai_obj, uint32_t alert_code, int
     }
 }
 
+static inline bool twai_rx_id_accepted(const twai_rx_id_filter_t *filter, const twai_hal_frame_t *frame)
+{
+    twai_message_t message;
+    twai_hal_parse_frame((twai_hal_frame_t *)frame, &message);
+    uint32_t key = message.identifier | (message.extd ? TWAI_RX_ID_FILTER_EXTD : 0);
+    uint32_t mask = UINT32_MAX >> filter->shift;
+    for (uint32_t i = (key * 2654435761U) >> filter->shift; ; i = (i + 1) & mask) {
+        if (filter->keys[i] == key) {
+            return true;
+        }
+        if (filter->keys[i] == RX_ID_FILTER_EMPTY) {
+            return false;
+        }
+    }
+}
+
+static inline void twai_handle_rx_frame(twai_obj_t *p_twai_obj, const twai_hal_frame_t *frame, int64_t timestamp, bool *rx_added, int *alert_req)
+{
+    if (p_twai_obj->rx_id_filter != NULL && !twai_rx_id_accepted(p_twai_obj->rx_id_filter, frame)) {
+        p_twai_obj->rx_filtered_count++;
+        return;
+    }
+    if (p_twai_obj->rx_msg_count < p_twai_obj->rx_ring_len) {
+        uint32_t index = p_twai_obj->rx_ring_read + p_twai_obj->rx_msg_count;
+        if (index >= p_twai_obj->rx_ring_len) {
+            index -= p_twai_obj->rx_ring_len;
+        }
+        p_twai_obj->rx_ring[index].timestamp = timestamp;
+        p_twai_obj->rx_ring[index].frame = *frame;
+        p_twai_obj->rx_msg_count++;
+        *rx_added = true;
+        twai_alert_handler(p_twai_obj, TWAI_ALERT_RX_DATA, alert_req);
+    } else {    //RX ring buffer is full
+        p_twai_obj->rx_missed_count++;
+        twai_alert_handler(p_twai_obj, TWAI_ALERT_RX_QUEUE_FULL, alert_req);
+    }
+}
+
 static inline void twai_handle_rx_buffer_frames(twai_obj_t *p_twai_obj, BaseType_t *task_woken, int *alert_req)
 {
+    //All the frames drained by one interrupt get the same timestamp
+    int64_t timestamp = esp_timer_get_time();
+    bool rx_added = false;
 #ifdef SOC_TWAI_SUPPORTS_RX_STATUS
     uint32_t msg_count = twai_hal_get_rx_msg_count(&p_twai_obj->hal);
 
@@ -142,13 +207,7 @@ static inline void twai_handle_rx_buffer_frames(twai_obj_t *p_twai_obj, BaseType
         twai_hal_frame_t frame;
         if (twai_hal_read_rx_buffer_and_clear(&p_twai_obj->hal, &frame)) {
             //Valid frame copied from RX buffer
-            if (xQueueSendFromISR(p_twai_obj->rx_queue, &frame, task_woken) == pdTRUE) {
-                p_twai_obj->rx_msg_count++;
-                twai_alert_handler(p_twai_obj, TWAI_ALERT_RX_DATA, alert_req);
-            } else {    //Failed to send to queue
-                p_twai_obj->rx_missed_count++;
-                twai_alert_handler(p_twai_obj, TWAI_ALERT_RX_QUEUE_FULL, alert_req);
-            }
+            twai_handle_rx_frame(p_twai_obj, &frame, timestamp, &rx_added, alert_req);
         } else {    //Failed to read from RX buffer because message is overrun
             p_twai_obj->rx_overrun_count++;
             twai_alert_handler(p_twai_obj, TWAI_ALERT_RX_FIFO_OVERRUN, alert_req);
@@ -162,13 +221,7 @@ static inline void twai_handle_rx_buffer_frames(twai_obj_t *p_twai_obj, BaseType
         twai_hal_frame_t frame;
         if (twai_hal_read_rx_buffer_and_clear(&p_twai_obj->hal, &frame)) {
             //Valid frame copied from RX buffer
-            if (xQueueSendFromISR(p_twai_obj->rx_queue, &frame, task_woken) == pdTRUE) {
-                p_twai_obj->rx_msg_count++;
-                twai_alert_handler(p_twai_obj, TWAI_ALERT_RX_DATA, alert_req);
-            } else {
-                p_twai_obj->rx_missed_count++;
-                twai_alert_handler(p_twai_obj, TWAI_ALERT_RX_QUEUE_FULL, alert_req);
-            }
+            twai_handle_rx_frame(p_twai_obj, &frame, timestamp, &rx_added, alert_req);
         } else {
             overrun = true;
             break;
@@ -180,6 +233,10 @@ static inline void twai_handle_rx_buffer_frames(twai_obj_t *p_twai_obj, BaseType
         twai_alert_handler(p_twai_obj, TWAI_ALERT_RX_FIFO_OVERRUN, alert_req);
     }
 #endif  //SOC_TWAI_SUPPORTS_RX_STATUS
+    if (rx_added) {
+        //Wake up a receiving task once for all the frames, instead of a queue operation per frame
+        xSemaphoreGiveFromISR(p_twai_obj->rx_semphr, task_woken);
+    }
 }
 
 static inline void twai_handle_tx_buffer_frame(twai_obj_t *p_twai_obj, BaseType_t *task_woken, int *alert_req)
@@ -364,9 +421,11 @@ static void twai_free_driver_obj(twai_obj_t *p_obj)
     if (p_obj->tx_queue != NULL) {
         vQueueDeleteWithCaps(p_obj->tx_queue);
     }
-    if (p_obj->rx_queue != NULL) {
-        vQueueDeleteWithCaps(p_obj->rx_queue);
+    if (p_obj->rx_semphr != NULL) {
+        vSemaphoreDeleteWithCaps(p_obj->rx_semphr);
     }
+    heap_caps_free(p_obj->rx_ring);
+    heap_caps_free(p_obj->rx_id_filter);
     if (p_obj->alert_semphr != NULL) {
         vSemaphoreDeleteWithCaps(p_obj->alert_semphr);
     }
@@ -399,9 +458,11 @@ static esp_err_t twai_alloc_driver_obj(const twai_general_config_t *g_config, tw
     if (g_config->tx_queue_len > 0) {
         p_obj->tx_queue = xQueueCreateWithCaps(g_config->tx_queue_len, sizeof(twai_hal_frame_t), TWAI_MALLOC_CAPS);
     }
-    p_obj->rx_queue = xQueueCreateWithCaps(g_config->rx_queue_len, sizeof(twai_hal_frame_t), TWAI_MALLOC_CAPS);
+    p_obj->rx_ring = heap_caps_calloc(g_config->rx_queue_len, sizeof(twai_rx_slot_t), TWAI_MALLOC_CAPS);
+    p_obj->rx_ring_len = g_config->rx_queue_len;
+    p_obj->rx_semphr = xSemaphoreCreateBinaryWithCaps(TWAI_MALLOC_CAPS);
     p_obj->alert_semphr = xSemaphoreCreateBinaryWithCaps(TWAI_MALLOC_CAPS);
-    if ((g_config->tx_queue_len > 0 && p_obj->tx_queue == NULL) || p_obj->rx_queue == NULL || p_obj->alert_semphr == NULL) {
+    if ((g_config->tx_queue_len > 0 && p_obj->tx_queue == NULL) || p_obj->rx_ring == NULL || p_obj->rx_semphr == NULL || p_obj->alert_semphr == NULL) {
         ret = ESP_ERR_NO_MEM;
         goto err;
     }
@@ -648,11 +709,11 @@ esp_err_t twai_start_v2(twai_handle_t handle)
         return ESP_ERR_INVALID_STATE;
     }
 
-    //Reset RX queue, RX message count, amd TX queue
-    xQueueReset(p_twai_obj->rx_queue);
+    //Reset RX ring buffer, RX message count, amd TX queue
     if (p_twai_obj->tx_queue != NULL) {
         xQueueReset(p_twai_obj->tx_queue);
     }
+    p_twai_obj->rx_ring_read = 0;
     p_twai_obj->rx_msg_count = 0;
     p_twai_obj->tx_msg_count = 0;
     twai_hal_start(&p_twai_obj->hal, p_twai_obj->mode);
@@ -772,26 +833,60 @@ esp_err_t twai_transmit(const twai_message_t *message, TickType_t ticks_to_wait)
     return twai_transmit_v2(g_twai_objs[0], message, ticks_to_wait);
 }
 
+static size_t twai_rx_ring_pop(twai_obj_t *p_twai_obj, twai_rx_message_t *messages, size_t max_messages)
+{
+    size_t num = 0;
+    bool more = true;
+    //Parse a few frames at a time, so that the interrupts are not disabled for long
+    while (num < max_messages && more) {
+        portENTER_CRITICAL(&p_twai_obj->spinlock);
+        size_t chunk = MIN(MIN(max_messages - num, (size_t)p_twai_obj->rx_msg_count), RX_POP_CHUNK);
+        for (size_t i = 0; i < chunk; i++) {
+            twai_rx_slot_t *slot = &p_twai_obj->rx_ring[p_twai_obj->rx_ring_read];
+            messages[num + i].timestamp = slot->timestamp;
+            twai_hal_parse_frame(&slot->frame, &messages[num + i].message);
+            if (++p_twai_obj->rx_ring_read == p_twai_obj->rx_ring_len) {
+                p_twai_obj->rx_ring_read = 0;
+            }
+        }
+        p_twai_obj->rx_msg_count -= chunk;
+        more = p_twai_obj->rx_msg_count > 0;
+        portEXIT_CRITICAL(&p_twai_obj->spinlock);
+        num += chunk;
+    }
+    if (num > 0 && more) {
+        //The ISR only wakes up one task, pass it on to another task waiting for the remaining frames
+        xSemaphoreGive(p_twai_obj->rx_semphr);
+    }
+    return num;
+}
+
+static esp_err_t twai_receive_messages(twai_obj_t *p_twai_obj, twai_rx_message_t *messages, size_t max_messages, size_t *ret_num, TickType_t ticks_to_wait)
+{
+    TimeOut_t timeout;
+    vTaskSetTimeOutState(&timeout);
+    while ((*ret_num = twai_rx_ring_pop(p_twai_obj, messages, max_messages)) == 0) {
+        //The semaphore may also have been given for frames which were read by another task meanwhile
+        if (xTaskCheckForTimeOut(&timeout, &ticks_to_wait) == pdTRUE || xSemaphoreTake(p_twai_obj->rx_semphr, ticks_to_wait) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+    return ESP_OK;
+}
+
 esp_err_t twai_receive_v2(twai_handle_t handle, twai_message_t *message, TickType_t ticks_to_wait)
 {
     //Check arguments and state
     TWAI_CHECK(handle != NULL, ESP_ERR_INVALID_ARG);
     TWAI_CHECK(message != NULL, ESP_ERR_INVALID_ARG);
 
-    twai_obj_t *p_twai_obj = handle;
-    //Get frame from RX Queue or RX Buffer
-    twai_hal_frame_t rx_frame;
-    if (xQueueReceive(p_twai_obj->rx_queue, &rx_frame, ticks_to_wait) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+    twai_rx_message_t rx_message;
+    size_t num;
+    esp_err_t ret = twai_receive_messages(handle, &rx_message, 1, &num, ticks_to_wait);
+    if (ret == ESP_OK) {
+        *message = rx_message.message;
     }
-
-    portENTER_CRITICAL(&handle->spinlock);
-    p_twai_obj->rx_msg_count--;
-    portEXIT_CRITICAL(&handle->spinlock);
-
-    //Decode frame
-    twai_hal_parse_frame(&rx_frame, message);
-    return ESP_OK;
+    return ret;
 }
 
 esp_err_t twai_receive(twai_message_t *message, TickType_t ticks_to_wait)
@@ -800,6 +895,22 @@ esp_err_t twai_receive(twai_message_t *message, TickType_t ticks_to_wait)
     return twai_receive_v2(g_twai_objs[0], message, ticks_to_wait);
 }
 
+esp_err_t twai_receive_batch_v2(twai_handle_t handle, twai_rx_message_t *messages, size_t max_messages, size_t *ret_num, TickType_t ticks_to_wait)
+{
+    //Check arguments
+    TWAI_CHECK(handle != NULL, ESP_ERR_INVALID_ARG);
+    TWAI_CHECK(messages != NULL && max_messages > 0, ESP_ERR_INVALID_ARG);
+    TWAI_CHECK(ret_num != NULL, ESP_ERR_INVALID_ARG);
+
+    return twai_receive_messages(handle, messages, max_messages, ret_num, ticks_to_wait);
+}
+
+esp_err_t twai_receive_batch(twai_rx_message_t *messages, size_t max_messages, size_t *ret_num, TickType_t ticks_to_wait)
+{
+    // the handle-less driver API only support one TWAI controller, i.e. the g_twai_objs[0]
+    return twai_receive_batch_v2(g_twai_objs[0], messages, max_messages, ret_num, ticks_to_wait);
+}
+
 esp_err_t twai_read_alerts_v2(twai_handle_t handle, uint32_t *alerts, TickType_t ticks_to_wait)
 {
     //Check arguments and state
@@ -906,6 +1017,7 @@ esp_err_t twai_get_status_info_v2(twai_handle_t handle, twai_status_info_t *stat
     status_info->rx_overrun_count = p_twai_obj->rx_overrun_count;
     status_info->arb_lost_count = p_twai_obj->arb_lost_count;
     status_info->bus_error_count = p_twai_obj->bus_error_count;
+    status_info->rx_filtered_count = p_twai_obj->rx_filtered_count;
     status_info->state = p_twai_obj->state;
     portEXIT_CRITICAL(&handle->spinlock);
 
@@ -947,8 +1059,8 @@ esp_err_t twai_clear_receive_queue_v2(twai_handle_t handle)
     twai_obj_t *p_twai_obj = handle;
 
     portENTER_CRITICAL(&handle->spinlock);
+    p_twai_obj->rx_ring_read = 0;
     p_twai_obj->rx_msg_count = 0;
-    xQueueReset(p_twai_obj->rx_queue);
     portEXIT_CRITICAL(&handle->spinlock);
 
     return ESP_OK;
@@ -960,6 +1072,57 @@ esp_err_t twai_clear_receive_queue(void)
     return twai_clear_receive_queue_v2(g_twai_objs[0]);
 }
 
+esp_err_t twai_set_rx_id_filter_v2(twai_handle_t handle, const uint32_t *ids, size_t num_ids)
+{
+    //Check parameters
+    TWAI_CHECK(handle != NULL, ESP_ERR_INVALID_ARG);
+    TWAI_CHECK(ids != NULL || num_ids == 0, ESP_ERR_INVALID_ARG);
+    TWAI_CHECK(num_ids <= RX_ID_FILTER_MAX_IDS, ESP_ERR_INVALID_ARG);
+    twai_obj_t *p_twai_obj = handle;
+
+    twai_rx_id_filter_t *filter = NULL;
+    if (num_ids > 0) {
+        //At least twice as many slots as IDs, so that the probe sequences stay short
+        uint32_t bits = 1;
+        while ((1U << bits) < 2 * num_ids) {
+            bits++;
+        }
+        filter = heap_caps_malloc(sizeof(twai_rx_id_filter_t) + (sizeof(uint32_t) << bits), TWAI_MALLOC_CAPS);
+        if (filter == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        filter->shift = 32 - bits;
+        memset(filter->keys, 0xFF, sizeof(uint32_t) << bits);
+        uint32_t mask = (1U << bits) - 1;
+        for (size_t n = 0; n < num_ids; n++) {
+            uint32_t id = ids[n] & ~TWAI_RX_ID_FILTER_EXTD;
+            if (id > ((ids[n] & TWAI_RX_ID_FILTER_EXTD) ? TWAI_EXT_ID_MASK : TWAI_STD_ID_MASK)) {
+                heap_caps_free(filter);
+                return ESP_ERR_INVALID_ARG;
+            }
+            uint32_t i = (ids[n] * 2654435761U) >> filter->shift;
+            while (filter->keys[i] != RX_ID_FILTER_EMPTY && filter->keys[i] != ids[n]) {
+                i = (i + 1) & mask;
+            }
+            filter->keys[i] = ids[n];
+        }
+    }
+
+    portENTER_CRITICAL(&handle->spinlock);
+    twai_rx_id_filter_t *old_filter = p_twai_obj->rx_id_filter;
+    p_twai_obj->rx_id_filter = filter;
+    portEXIT_CRITICAL(&handle->spinlock);
+
+    heap_caps_free(old_filter);
+    return ESP_OK;
+}
+
+esp_err_t twai_set_rx_id_filter(const uint32_t *ids, size_t num_ids)
+{
+    // the handle-less driver API only support one TWAI controller, i.e. the g_twai_objs[0]
+    return twai_set_rx_id_filter_v2(g_twai_objs[0], ids, num_ids);
+}
+
 #if TWAI_USE_RETENTION_LINK
 static esp_err_t s_twai_create_sleep_retention_link_cb(void *obj)
 {
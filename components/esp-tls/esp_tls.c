@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,9 +7,11 @@
 #include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <time.h>
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netdb.h>
 
 #include <http_parser.h>
@@ -18,6 +20,9 @@
 #include "esp_tls_private.h"
 #include "esp_tls_platform_port.h"
 #include "esp_tls_error_capture_internal.h"
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+#include "esp_tls_client_session_cache.h"
+#endif
 #include <fcntl.h>
 #include <errno.h>
 
@@ -148,6 +153,32 @@ ssize_t esp_tls_conn_write(esp_tls_t *tls, const void  *data, size_t datalen)
     return tls->write(tls, (char *)data, datalen);
 }
 
+ssize_t esp_tls_conn_writev(esp_tls_t *tls, const struct iovec *iov, int iovcnt)
+{
+    if (!tls || !iov || iovcnt <= 0) {
+        return -1;
+    }
+    if (!tls->is_tls) {
+        /* Plain TCP, the segments are gathered by the TCP/IP stack */
+        return writev(tls->sockfd, iov, iovcnt);
+    }
+    ssize_t written = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len == 0) {
+            continue;
+        }
+        ssize_t ret = tls->write(tls, (const char *)iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            return (written > 0) ? written : ret;
+        }
+        written += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return written;
+}
+
 /**
  * @brief      Close the TLS connection and free any allocated resources.
  */
@@ -155,6 +186,9 @@ int esp_tls_conn_destroy(esp_tls_t *tls)
 {
     if (tls != NULL) {
         int ret = 0;
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+        esp_tls_client_session_cache_update(tls);
+#endif
         _esp_tls_conn_delete(tls);
         if (tls->sockfd >= 0) {
             ret = close(tls->sockfd);
@@ -352,12 +386,193 @@ static esp_err_t esp_tls_set_socket_non_blocking(int fd, bool non_blocking)
     return ESP_OK;
 }
 
+#if CONFIG_ESP_TLS_HAPPY_EYEBALLS
+static int64_t esp_tls_now_ms(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/* Starts a non-blocking connection to the address, returns the socket or -1 */
+static int esp_tls_start_connect(const struct addrinfo *ai, int port, const esp_tls_cfg_t *cfg)
+{
+    int fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "Failed to create socket (family %d socktype %d protocol %d)", ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        return -1;
+    }
+
+    socklen_t addrlen;
+    if (ai->ai_family == AF_INET) {
+        ((struct sockaddr_in *)ai->ai_addr)->sin_port = htons(port);
+        addrlen = sizeof(struct sockaddr_in);
+    } else {
+        ((struct sockaddr_in6 *)ai->ai_addr)->sin6_port = htons(port);
+        addrlen = sizeof(struct sockaddr_in6);
+    }
+
+    if (esp_tls_set_socket_options(fd, cfg) != ESP_OK || esp_tls_set_socket_non_blocking(fd, true) != ESP_OK) {
+        close(fd);
+        return -1;
+    }
+    if (connect(fd, ai->ai_addr, addrlen) < 0 && errno != EINPROGRESS) {
+        ESP_LOGD(TAG, "[sock=%d] connect() error: %s", fd, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    ESP_LOGD(TAG, "[sock=%d] Connecting to %s address", fd, ai->ai_family == AF_INET ? "IPv4" : "IPv6");
+    return fd;
+}
+
+/*
+ * Connects as described in RFC 8305 (happy eyeballs): the first IPv6 address of the host is tried first,
+ * and the first IPv4 address is tried in parallel if no connection is established within
+ * CONFIG_ESP_TLS_HAPPY_EYEBALLS_DELAY_MS, or as soon as the first attempt fails. The first connected socket wins.
+ */
+static esp_err_t esp_tls_happy_eyeballs_connect(const char *host, int hostlen, int port, const esp_tls_cfg_t *cfg,
+                                                esp_tls_error_handle_t error_handle, int *sockfd)
+{
+    struct addrinfo hints = {
+        .ai_family = AF_UNSPEC,
+        .ai_socktype = SOCK_STREAM,
+    };
+    struct addrinfo *address_info;
+
+    char *use_host = strndup(host, hostlen);
+    if (!use_host) {
+        return ESP_ERR_NO_MEM;
+    }
+    int res = getaddrinfo(use_host, NULL, &hints, &address_info);
+    if (res != 0 || address_info == NULL) {
+        ESP_LOGE(TAG, "couldn't get hostname for :%s: "
+                      "getaddrinfo() returns %d, addrinfo=%p", use_host, res, address_info);
+        free(use_host);
+        return ESP_ERR_ESP_TLS_CANNOT_RESOLVE_HOSTNAME;
+    }
+    free(use_host);
+
+    // addresses in the order they are tried
+    const struct addrinfo *candidates[2] = { NULL, NULL };
+    for (const struct addrinfo *ai = address_info; ai != NULL; ai = ai->ai_next) {
+        if (ai->ai_family == AF_INET6 && candidates[0] == NULL) {
+            candidates[0] = ai;
+        } else if (ai->ai_family == AF_INET && candidates[1] == NULL) {
+            candidates[1] = ai;
+        }
+    }
+    if (candidates[0] == NULL) {
+        candidates[0] = candidates[1];
+        candidates[1] = NULL;
+    }
+    if (candidates[0] == NULL) {
+        ESP_LOGE(TAG, "Unsupported protocol family %d", address_info->ai_family);
+        freeaddrinfo(address_info);
+        return ESP_ERR_ESP_TLS_UNSUPPORTED_PROTOCOL_FAMILY;
+    }
+
+    int timeout_ms = (cfg && cfg->timeout_ms > 0) ? cfg->timeout_ms : ESP_TLS_DEFAULT_CONN_TIMEOUT * 1000;
+    int64_t deadline = esp_tls_now_ms() + timeout_ms;
+    int64_t next_start = 0;
+    int fds[2] = { -1, -1 };
+    int started = 0;
+    int winner = -1;
+    esp_err_t ret = ESP_ERR_ESP_TLS_FAILED_CONNECT_TO_HOST;
+
+    while (winner < 0) {
+        int64_t now = esp_tls_now_ms();
+        bool can_start = started < 2 && candidates[started] != NULL;
+        if (can_start && (now >= next_start || (fds[0] < 0 && fds[1] < 0))) {
+            fds[started] = esp_tls_start_connect(candidates[started], port, cfg);
+            // start the next address right away if this one failed
+            next_start = (fds[started] < 0) ? now : now + CONFIG_ESP_TLS_HAPPY_EYEBALLS_DELAY_MS;
+            started++;
+            continue;
+        }
+        if (fds[0] < 0 && fds[1] < 0) {
+            break;
+        }
+        if (now >= deadline) {
+            ESP_LOGE(TAG, "Connection to %.*s timed out", hostlen, host);
+            ret = ESP_ERR_ESP_TLS_CONNECTION_TIMEOUT;
+            break;
+        }
+
+        int64_t wait = deadline - now;
+        if (can_start && next_start - now < wait) {
+            wait = next_start - now;
+        }
+        fd_set fdset;
+        int maxfd = -1;
+        FD_ZERO(&fdset);
+        for (int i = 0; i < 2; i++) {
+            if (fds[i] >= 0) {
+                FD_SET(fds[i], &fdset);
+                maxfd = fds[i] > maxfd ? fds[i] : maxfd;
+            }
+        }
+        struct timeval tv;
+        ms_to_timeval((int)wait, &tv);
+        res = select(maxfd + 1, NULL, &fdset, NULL, &tv);
+        if (res < 0) {
+            ESP_LOGE(TAG, "select() error: %s", strerror(errno));
+            ESP_INT_EVENT_TRACKER_CAPTURE(error_handle, ESP_TLS_ERR_TYPE_SYSTEM, errno);
+            break;
+        }
+        for (int i = 0; i < 2 && res > 0; i++) {
+            if (fds[i] < 0 || !FD_ISSET(fds[i], &fdset)) {
+                continue;
+            }
+            int sockerr;
+            socklen_t len = (socklen_t)sizeof(int);
+            if (getsockopt(fds[i], SOL_SOCKET, SO_ERROR, (void*)(&sockerr), &len) < 0) {
+                sockerr = errno;
+            }
+            if (sockerr == 0) {
+                winner = i;
+                break;
+            }
+            ESP_LOGD(TAG, "[sock=%d] delayed connect error: %s", fds[i], strerror(sockerr));
+            ESP_INT_EVENT_TRACKER_CAPTURE(error_handle, ESP_TLS_ERR_TYPE_SYSTEM, sockerr);
+            close(fds[i]);
+            fds[i] = -1;
+            next_start = now;
+        }
+    }
+
+    for (int i = 0; i < 2; i++) {
+        if (i != winner && fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+    freeaddrinfo(address_info);
+    if (winner < 0) {
+        return ret;
+    }
+
+    // only used for blocking connections, so reset back to blocking mode
+    ret = esp_tls_set_socket_non_blocking(fds[winner], false);
+    if (ret != ESP_OK) {
+        close(fds[winner]);
+        return ret;
+    }
+    ESP_LOGD(TAG, "[sock=%d] Connected to %.*s", fds[winner], hostlen, host);
+    *sockfd = fds[winner];
+    return ESP_OK;
+}
+#endif /* CONFIG_ESP_TLS_HAPPY_EYEBALLS */
+
 static inline esp_err_t tcp_connect(const char *host, int hostlen, int port, const esp_tls_cfg_t *cfg, esp_tls_error_handle_t error_handle, int *sockfd)
 {
     struct sockaddr_storage address;
     int fd;
 
     esp_tls_addr_family_t addr_family = (cfg != NULL) ? cfg->addr_family : ESP_TLS_AF_UNSPEC;
+#if CONFIG_ESP_TLS_HAPPY_EYEBALLS
+    if (addr_family == ESP_TLS_AF_UNSPEC && !(cfg && cfg->non_block)) {
+        return esp_tls_happy_eyeballs_connect(host, hostlen, port, cfg, error_handle, sockfd);
+    }
+#endif
     esp_err_t ret = esp_tls_hostname_to_fd(host, hostlen, port, addr_family, &address, &fd);
     if (ret != ESP_OK) {
         ESP_INT_EVENT_TRACKER_CAPTURE(error_handle, ESP_TLS_ERR_TYPE_SYSTEM, errno);
@@ -506,6 +721,12 @@ static int esp_tls_low_level_conn(const char *hostname, int hostlen, int port, c
             tls->conn_state = ESP_TLS_FAIL;
             return -1;
         }
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+        /* A session given by the user takes precedence over the cached one */
+        if (cfg && cfg->client_session == NULL) {
+            esp_tls_client_session_cache_lookup(tls, hostname, hostlen, port);
+        }
+#endif
         tls->read = _esp_tls_read;
         tls->write = _esp_tls_write;
         tls->conn_state = ESP_TLS_HANDSHAKE;
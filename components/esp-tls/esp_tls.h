@@ -7,6 +7,7 @@
 #define _ESP_TLS_H_
 
 #include <stdbool.h>
+#include <sys/uio.h>
 #include "esp_err.h"
 #include "esp_tls_errors.h"
 #include "sdkconfig.h"
@@ -484,6 +485,25 @@ int esp_tls_conn_http_new_async(const char *url, const esp_tls_cfg_t *cfg, esp_t
  */
 ssize_t esp_tls_conn_write(esp_tls_t *tls, const void *data, size_t datalen);
 
+/**
+ * @brief      Write the data from the given buffers to specified tls connection.
+ *
+ * The buffers are written in order, as if they were a single buffer. Plain TCP
+ * connections write them with a single call to writev(), TLS connections write
+ * them one after another without assembling a contiguous copy.
+ *
+ * @param[in]  tls      pointer to esp-tls as esp-tls handle.
+ * @param[in]  iov      Buffers from which data will be written.
+ * @param[in]  iovcnt   Number of buffers.
+ *
+ * @return
+ *             - >=0  if write operation was successful, the return value is the number
+ *                   of bytes actually written to the connection, which may be less than
+ *                   the total length of the buffers.
+ *             - <0  if write operation was not successful, see esp_tls_conn_write().
+ */
+ssize_t esp_tls_conn_writev(esp_tls_t *tls, const struct iovec *iov, int iovcnt);
+
 /**
  * @brief      Read from specified tls connection into the buffer 'data'.
  *
@@ -799,6 +819,17 @@ esp_tls_client_session_t *esp_tls_get_client_session(esp_tls_t *tls);
  *
  */
 void esp_tls_free_client_session(esp_tls_client_session_t *client_session);
+
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+/**
+ * @brief Drop all the sessions in the client session cache
+ *
+ * The sessions are cached automatically when CONFIG_ESP_TLS_CLIENT_SESSION_CACHE is enabled.
+ * A resumed session skips the server certificate verification, so this function should be called
+ * when the trusted CA certificates are changed, e.g., after updating the global CA store.
+ */
+void esp_tls_client_session_cache_clear(void);
+#endif /* CONFIG_ESP_TLS_CLIENT_SESSION_CACHE */
 #endif /* CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS */
 #ifdef __cplusplus
 }
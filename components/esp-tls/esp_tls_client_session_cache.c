@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/lock.h>
+#include "esp_log.h"
+#include "esp_tls.h"
+#include "esp_tls_private.h"
+#include "esp_tls_client_session_cache.h"
+
+static const char *TAG = "esp-tls-session-cache";
+
+typedef struct {
+    char *key;                      /*!< "hostname:port" of the server, NULL if the entry is free */
+    mbedtls_ssl_session session;    /*!< Saved session of the server */
+    uint32_t last_used;             /*!< Value of s_use_count when the entry is used last time, for the LRU replacement */
+} esp_tls_session_cache_entry_t;
+
+static esp_tls_session_cache_entry_t s_cache[CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE];
+static uint32_t s_use_count;
+static _lock_t s_cache_lock;
+
+static esp_tls_session_cache_entry_t *find_entry(const char *key)
+{
+    for (int i = 0; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE; i++) {
+        if (s_cache[i].key && strcmp(s_cache[i].key, key) == 0) {
+            return &s_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void free_entry(esp_tls_session_cache_entry_t *entry)
+{
+    mbedtls_ssl_session_free(&entry->session);
+    free(entry->key);
+    entry->key = NULL;
+}
+
+void esp_tls_client_session_cache_lookup(esp_tls_t *tls, const char *hostname, size_t hostlen, int port)
+{
+    if (asprintf(&tls->client_session_cache_key, "%.*s:%d", (int)hostlen, hostname, port) < 0) {
+        tls->client_session_cache_key = NULL;
+        ESP_LOGD(TAG, "Failed to allocate memory for the cache key");
+        return;
+    }
+
+    _lock_acquire(&s_cache_lock);
+    esp_tls_session_cache_entry_t *entry = find_entry(tls->client_session_cache_key);
+    if (entry) {
+        entry->last_used = ++s_use_count;
+        // the session is copied into the TLS context, so the entry can be replaced while the handshake is in progress
+        int ret = mbedtls_ssl_set_session(&tls->ssl, &entry->session);
+        if (ret == 0) {
+            ESP_LOGD(TAG, "Resuming the cached session of %s", entry->key);
+        } else {
+            ESP_LOGD(TAG, "mbedtls_ssl_set_session returned -0x%04X, dropping the cached session", -ret);
+            free_entry(entry);
+        }
+    }
+    _lock_release(&s_cache_lock);
+}
+
+void esp_tls_client_session_cache_update(esp_tls_t *tls)
+{
+    char *key = tls->client_session_cache_key;
+    if (key == NULL) {
+        return;
+    }
+    tls->client_session_cache_key = NULL;
+
+    if (tls->conn_state == ESP_TLS_DONE) {
+        // get the session here rather than right after the handshake, as TLS 1.3 tickets are received after the handshake
+        mbedtls_ssl_session session;
+        mbedtls_ssl_session_init(&session);
+        int ret = mbedtls_ssl_get_session(&tls->ssl, &session);
+        if (ret != 0) {
+            ESP_LOGD(TAG, "No session to cache for %s, mbedtls_ssl_get_session returned -0x%04X", key, -ret);
+            mbedtls_ssl_session_free(&session);
+            free(key);
+            return;
+        }
+
+        _lock_acquire(&s_cache_lock);
+        esp_tls_session_cache_entry_t *entry = find_entry(key);
+        if (entry == NULL) {
+            // use a free entry, or replace the least recently used one
+            entry = &s_cache[0];
+            for (int i = 1; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE && entry->key; i++) {
+                if (s_cache[i].key == NULL || s_cache[i].last_used < entry->last_used) {
+                    entry = &s_cache[i];
+                }
+            }
+        }
+        if (entry->key) {
+            free_entry(entry);
+        }
+        // the entry takes the ownership of the key and of the session content
+        entry->key = key;
+        entry->session = session;
+        entry->last_used = ++s_use_count;
+        _lock_release(&s_cache_lock);
+        ESP_LOGD(TAG, "Cached the session of %s", key);
+        return;
+    }
+
+    if (tls->conn_state == ESP_TLS_FAIL) {
+        // in case the cached session is the cause, do not try it again
+        _lock_acquire(&s_cache_lock);
+        esp_tls_session_cache_entry_t *entry = find_entry(key);
+        if (entry) {
+            free_entry(entry);
+        }
+        _lock_release(&s_cache_lock);
+    }
+    free(key);
+}
+
+void esp_tls_client_session_cache_clear(void)
+{
+    _lock_acquire(&s_cache_lock);
+    for (int i = 0; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE; i++) {
+        if (s_cache[i].key) {
+            free_entry(&s_cache[i]);
+        }
+    }
+    _lock_release(&s_cache_lock);
+}
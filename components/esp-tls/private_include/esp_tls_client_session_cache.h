@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "esp_tls.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Look up the client session cache for the server, and set the cached session to the TLS context if found
+ *
+ * This function should be called after the TLS context is set up and before the handshake starts.
+ * The cache key of the server is saved in the esp-tls handle, to be used by esp_tls_client_session_cache_update().
+ *
+ * @param[in]  tls      esp-tls handle
+ * @param[in]  hostname Hostname of the server, not necessarily NULL terminated
+ * @param[in]  hostlen  Length of the hostname
+ * @param[in]  port     Port of the server
+ */
+void esp_tls_client_session_cache_lookup(esp_tls_t *tls, const char *hostname, size_t hostlen, int port);
+
+/**
+ * @brief Update the client session cache before the connection is deleted
+ *
+ * The session is saved if the handshake is done, and the cached session is dropped if the handshake failed.
+ * The cache key saved by esp_tls_client_session_cache_lookup() is freed.
+ *
+ * @param[in]  tls      esp-tls handle
+ */
+void esp_tls_client_session_cache_update(esp_tls_t *tls);
+
+#ifdef __cplusplus
+}
+#endif
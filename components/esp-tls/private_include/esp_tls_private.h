@@ -94,6 +94,10 @@ struct esp_tls {
 
     esp_tls_error_handle_t error_handle;                                        /*!< handle to error descriptor */
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+    char *client_session_cache_key;                                             /*!< "hostname:port" key of the server in the client
+                                                                                     session cache */
+#endif
 };
 
 // Function pointer for the server configuration API
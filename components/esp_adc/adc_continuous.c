@@ -268,6 +268,10 @@ esp_err_t adc_continuous_start(adc_continuous_handle_t handle)
         adc_ll_reset_register();
     }
 
+    //drop the groups in progress of the previous conversions
+    memset(handle->decim_sum, 0, sizeof(handle->decim_sum));
+    memset(handle->decim_cnt, 0, sizeof(handle->decim_cnt));
+
     if (handle->pm_lock) {
         ESP_RETURN_ON_ERROR(esp_pm_lock_acquire(handle->pm_lock), ADC_TAG, "acquire pm_lock failed");
     }
@@ -412,6 +416,119 @@ esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint
     return ret;
 }
 
+esp_err_t adc_continuous_borrow_data(adc_continuous_handle_t handle, uint8_t **buf, uint32_t length_max, uint32_t *out_length, uint32_t timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_STATE, ADC_TAG, "The driver isn't initialised");
+    ESP_RETURN_ON_FALSE(buf && out_length, ESP_ERR_INVALID_ARG, ADC_TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(handle->fsm == ADC_FSM_STARTED, ESP_ERR_INVALID_STATE, ADC_TAG, "The driver is already stopped");
+    ESP_RETURN_ON_FALSE(!handle->borrowed_buf, ESP_ERR_INVALID_STATE, ADC_TAG, "the borrowed data isn't returned yet");
+
+    TickType_t ticks_to_wait = timeout_ms / portTICK_PERIOD_MS;
+    if (timeout_ms == ADC_MAX_DELAY) {
+        ticks_to_wait = portMAX_DELAY;
+    }
+
+    size_t size = 0;
+    uint8_t *data = xRingbufferReceiveUpTo(handle->ringbuf_hdl, &size, ticks_to_wait, length_max);
+    if (!data) {
+        ESP_LOGV(ADC_TAG, "No data, increase timeout");
+        *out_length = 0;
+        return ESP_ERR_TIMEOUT;
+    }
+    assert((size % 4) == 0);
+    handle->borrowed_buf = data;
+    *buf = data;
+    *out_length = size;
+
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_return_data(adc_continuous_handle_t handle, uint8_t *buf)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_STATE, ADC_TAG, "The driver isn't initialised");
+    ESP_RETURN_ON_FALSE(buf && buf == handle->borrowed_buf, ESP_ERR_INVALID_ARG, ADC_TAG, "buffer isn't borrowed from this driver");
+
+    handle->borrowed_buf = NULL;
+    vRingbufferReturnItem(handle->ringbuf_hdl, buf);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Get the unit, channel and value of a conversion result
+ *
+ * @return false if the result is invalid
+ */
+static inline bool adc_continuous_parse_result(adc_continuous_handle_t handle, const adc_digi_output_data_t *p, adc_unit_t *unit, uint32_t *channel, uint32_t *data)
+{
+#if CONFIG_IDF_TARGET_ESP32
+    *unit = ADC_UNIT_1;
+    *channel = p->type1.channel;
+    *data = p->type1.data;
+#elif CONFIG_IDF_TARGET_ESP32S2
+    if (handle->format == ADC_DIGI_OUTPUT_FORMAT_TYPE1) {
+        *unit = (handle->hal_digi_ctrlr_cfg.conv_mode == ADC_CONV_SINGLE_UNIT_2) ? ADC_UNIT_2 : ADC_UNIT_1;
+        *channel = p->type1.channel;
+        *data = p->type1.data;
+    } else {
+        *unit = p->type2.unit ? ADC_UNIT_2 : ADC_UNIT_1;
+        *channel = p->type2.channel;
+        *data = p->type2.data;
+    }
+#elif CONFIG_IDF_TARGET_ESP32C6 || CONFIG_IDF_TARGET_ESP32H2 || CONFIG_IDF_TARGET_ESP32C5 || CONFIG_IDF_TARGET_ESP32C61
+    *unit = ADC_UNIT_1;
+    *channel = p->type2.channel;
+    *data = p->type2.data;
+#else
+    *unit = p->type2.unit ? ADC_UNIT_2 : ADC_UNIT_1;
+    *channel = p->type2.channel;
+    *data = p->type2.data;
+#endif
+    return *channel < SOC_ADC_CHANNEL_NUM(*unit);
+}
+
+esp_err_t adc_continuous_read_decimated(adc_continuous_handle_t handle, int16_t *const out[], uint32_t out_len_max, uint32_t out_len[], uint32_t timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_STATE, ADC_TAG, "The driver isn't initialised");
+    ESP_RETURN_ON_FALSE(out && out_len && out_len_max, ESP_ERR_INVALID_ARG, ADC_TAG, "invalid argument");
+
+    uint32_t pattern_num = handle->hal_digi_ctrlr_cfg.adc_pattern_len;
+    uint32_t ratio = handle->decim_ratio;
+    for (int i = 0; i < pattern_num; i++) {
+        out_len[i] = 0;
+    }
+
+    // the results go through the patterns in turn, then no pattern gets more than `out_len_max * ratio` of them
+    uint8_t *buf = NULL;
+    uint32_t length = 0;
+    uint32_t length_max = pattern_num * out_len_max * ratio * SOC_ADC_DIGI_RESULT_BYTES;
+    ESP_RETURN_ON_ERROR(adc_continuous_borrow_data(handle, &buf, length_max, &length, timeout_ms), ADC_TAG, "borrow data failed");
+
+    for (uint32_t i = 0; i < length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        adc_unit_t unit;
+        uint32_t channel;
+        uint32_t data;
+        if (!adc_continuous_parse_result(handle, (const adc_digi_output_data_t *)&buf[i], &unit, &channel, &data)) {
+            continue;
+        }
+        int pattern_idx = handle->decim_pattern[unit][channel];
+        if (pattern_idx < 0) {
+            continue;
+        }
+        handle->decim_sum[pattern_idx] += data;
+        if (++handle->decim_cnt[pattern_idx] == ratio) {
+            // only after a result has been lost by the internal pool, a pattern may get one more group
+            if (out_len[pattern_idx] < out_len_max) {
+                out[pattern_idx][out_len[pattern_idx]++] = handle->decim_sum[pattern_idx] / ratio;
+            }
+            handle->decim_sum[pattern_idx] = 0;
+            handle->decim_cnt[pattern_idx] = 0;
+        }
+    }
+
+    return adc_continuous_return_data(handle, buf);
+}
+
 esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle)
 {
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_STATE, ADC_TAG, "The driver isn't initialised");
@@ -494,6 +611,16 @@ esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_contin
     memcpy(handle->hal_digi_ctrlr_cfg.adc_pattern, config->adc_pattern, config->pattern_num * sizeof(adc_digi_pattern_config_t));
     handle->hal_digi_ctrlr_cfg.clk_src = ADC_DIGI_CLK_SRC_DEFAULT;
     handle->hal_digi_ctrlr_cfg.clk_src_freq_hz = clk_src_freq_hz;
+    handle->format = config->format;
+
+    handle->decim_ratio = config->decim_ratio ? config->decim_ratio : 1;
+    memset(handle->decim_pattern, -1, sizeof(handle->decim_pattern));
+    for (int i = config->pattern_num - 1; i >= 0; i--) {
+        const adc_digi_pattern_config_t *pat = &config->adc_pattern[i];
+        ESP_RETURN_ON_FALSE(pat->unit < SOC_ADC_PERIPH_NUM && pat->channel < SOC_ADC_MAX_CHANNEL_NUM, ESP_ERR_INVALID_ARG, ADC_TAG, "invalid ADC unit or channel");
+        // the first pattern of a unit and channel gets all its results
+        handle->decim_pattern[pat->unit][pat->channel] = i;
+    }
 
     const int atten_uninitialized = 999;
     handle->adc1_atten = atten_uninitialized;
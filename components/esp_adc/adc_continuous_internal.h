@@ -102,6 +102,13 @@ struct adc_continuous_ctx_t {
     size_t                          adc_desc_size;
     adc_dma_t                       adc_dma;
     adc_dma_intr_func_t             adc_intr_func;
+    adc_digi_output_format_t        format;                     //Conversion result format
+    uint8_t                         *borrowed_buf;              //Conversion results borrowed from the ringbuffer, NULL if none
+    //Decimation of `adc_continuous_read_decimated`
+    uint32_t                        decim_ratio;                                            //Number of results averaged into one sample
+    uint32_t                        decim_sum[SOC_ADC_PATT_LEN_MAX];                        //Sum of the results of the group in progress, per pattern
+    uint32_t                        decim_cnt[SOC_ADC_PATT_LEN_MAX];                        //Number of results of the group in progress, per pattern
+    int8_t                          decim_pattern[SOC_ADC_PERIPH_NUM][SOC_ADC_MAX_CHANNEL_NUM]; //Pattern index of each unit and channel, -1 if not used
 };
 
 #ifdef __cplusplus
@@ -66,6 +66,7 @@ typedef struct {
     uint32_t sample_freq_hz;                /*!< The expected ADC sampling frequency in Hz. Please refer to `soc/soc_caps.h` to know available sampling frequency range*/
     adc_digi_convert_mode_t conv_mode;      ///< ADC DMA conversion mode, see `adc_digi_convert_mode_t`.
     adc_digi_output_format_t format;        ///< ADC DMA conversion output format, see `adc_digi_output_format_t`.
+    uint32_t decim_ratio;                   ///< Number of consecutive results of each pattern averaged into one sample by `adc_continuous_read_decimated`. 0 or 1 means no averaging.
 } adc_continuous_config_t;
 
 /**
@@ -175,6 +176,61 @@ esp_err_t adc_continuous_start(adc_continuous_handle_t handle);
  */
 esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint32_t length_max, uint32_t *out_length, uint32_t timeout_ms);
 
+/**
+ * @brief Borrow the Conversion Results from the driver internal pool, without copying them.
+ *
+ * @note The borrowed buffer should be given back by `adc_continuous_return_data` before borrowing or reading again.
+ *
+ * @param[in]  handle              ADC continuous mode driver handle
+ * @param[out] buf                 Pointer to the Conversion Results inside the driver internal pool
+ * @param[in]  length_max          Expected length of the Conversion Results, in bytes.
+ * @param[out] out_length          Real length of the borrowed Conversion Results, in bytes. It may be less than `length_max`
+ *                                 when the results wrap around the end of the pool.
+ * @param[in]  timeout_ms          Time to wait for data via this API, in millisecond.
+ *
+ * @return
+ *         - ESP_ERR_INVALID_STATE Driver state is invalid, or a buffer is already borrowed.
+ *         - ESP_ERR_INVALID_ARG   Invalid arguments
+ *         - ESP_ERR_TIMEOUT       Operation timed out
+ *         - ESP_OK                On success
+ */
+esp_err_t adc_continuous_borrow_data(adc_continuous_handle_t handle, uint8_t **buf, uint32_t length_max, uint32_t *out_length, uint32_t timeout_ms);
+
+/**
+ * @brief Give back the Conversion Results borrowed by `adc_continuous_borrow_data` to the driver internal pool.
+ *
+ * @param[in]  handle              ADC continuous mode driver handle
+ * @param[in]  buf                 Buffer got from `adc_continuous_borrow_data`
+ *
+ * @return
+ *         - ESP_ERR_INVALID_ARG   `buf` isn't the borrowed buffer
+ *         - ESP_OK                On success
+ */
+esp_err_t adc_continuous_return_data(adc_continuous_handle_t handle, uint8_t *buf);
+
+/**
+ * @brief Read the Conversion Results as one array of samples per pattern, averaged by `adc_continuous_config_t::decim_ratio`.
+ *
+ * The Conversion Results are parsed from the driver internal pool without being copied. The results of each
+ * pattern (`adc_continuous_config_t::adc_pattern[i]`) are averaged by groups of `decim_ratio` and written to `out[i]`.
+ * The results of a group that isn't complete yet are kept for the next call. Invalid results are skipped.
+ *
+ * @note When the same unit and channel is used by several patterns, all its results go to the first of these patterns.
+ *
+ * @param[in]  handle              ADC continuous mode driver handle
+ * @param[out] out                 Array of `pattern_num` pointers, `out[i]` receives the samples of `adc_pattern[i]`
+ * @param[in]  out_len_max         Maximum number of samples that can be written to each of the `out` arrays
+ * @param[out] out_len             Array of `pattern_num` numbers, `out_len[i]` is the number of samples written to `out[i]`
+ * @param[in]  timeout_ms          Time to wait for data via this API, in millisecond.
+ *
+ * @return
+ *         - ESP_ERR_INVALID_STATE Driver state is invalid, or a buffer is borrowed by `adc_continuous_borrow_data`.
+ *         - ESP_ERR_INVALID_ARG   Invalid arguments
+ *         - ESP_ERR_TIMEOUT       Operation timed out
+ *         - ESP_OK                On success
+ */
+esp_err_t adc_continuous_read_decimated(adc_continuous_handle_t handle, int16_t *const out[], uint32_t out_len_max, uint32_t out_len[], uint32_t timeout_ms);
+
 /**
  * @brief Stop the ADC. After this, the hardware stops working.
  *
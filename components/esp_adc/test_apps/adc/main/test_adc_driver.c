@@ -211,6 +211,65 @@ TEST_CASE("ADC continuous big conv_frame_size test", "[adc_continuous]")
     free(result);
 }
 
+#define ADC_DECIM_TEST_RATIO    16
+#define ADC_DECIM_TEST_LEN      64
+
+TEST_CASE("ADC continuous read decimated", "[adc_continuous]")
+{
+    adc_continuous_handle_t handle = NULL;
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_FRAME_TEST_SIZE,
+        .conv_frame_size = 1024,
+    };
+    TEST_ESP_OK(adc_continuous_new_handle(&adc_config, &handle));
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = 50 * 1000,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DRIVER_TEST_OUTPUT_TYPE,
+        .decim_ratio = ADC_DECIM_TEST_RATIO,
+    };
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    adc_pattern[0].atten = ADC_ATTEN_DB_12;
+    adc_pattern[0].channel = ADC1_TEST_CHAN0;
+    adc_pattern[0].unit = ADC_UNIT_1;
+    adc_pattern[0].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    dig_cfg.adc_pattern = adc_pattern;
+    dig_cfg.pattern_num = 1;
+    TEST_ESP_OK(adc_continuous_config(handle, &dig_cfg));
+
+    int16_t *samples = malloc(ADC_DECIM_TEST_LEN * sizeof(int16_t));
+    TEST_ASSERT(samples);
+    int16_t *const out[1] = {samples};
+    uint32_t out_len[1] = {0};
+
+    test_adc_set_io_level(ADC_UNIT_1, ADC1_TEST_CHAN0, 0);
+    TEST_ESP_OK(adc_continuous_start(handle));
+
+    // the borrowed results need to be returned before reading again
+    uint8_t *buf = NULL;
+    uint32_t length = 0;
+    TEST_ESP_OK(adc_continuous_borrow_data(handle, &buf, 256, &length, ADC_MAX_DELAY));
+    TEST_ASSERT(length > 0 && length <= 256);
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, adc_continuous_read_decimated(handle, out, ADC_DECIM_TEST_LEN, out_len, ADC_MAX_DELAY));
+    TEST_ESP_OK(adc_continuous_return_data(handle, buf));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, adc_continuous_return_data(handle, buf));
+
+    uint32_t total = 0;
+    while (total < 5 * ADC_DECIM_TEST_LEN) {
+        TEST_ESP_OK(adc_continuous_read_decimated(handle, out, ADC_DECIM_TEST_LEN, out_len, ADC_MAX_DELAY));
+        TEST_ASSERT_LESS_OR_EQUAL(ADC_DECIM_TEST_LEN, out_len[0]);
+        for (int i = 0; i < out_len[0]; i++) {
+            TEST_ASSERT_INT_WITHIN(ADC_TEST_LOW_THRESH, ADC_TEST_LOW_VAL, samples[i]);
+        }
+        total += out_len[0];
+    }
+
+    TEST_ESP_OK(adc_continuous_stop(handle));
+    TEST_ESP_OK(adc_continuous_deinit(handle));
+    free(samples);
+}
+
 #define ADC_FLUSH_TEST_SIZE    64
 
 TEST_CASE("ADC continuous flush internal pool", "[adc_continuous][manual][ignore]")
@@ -0,0 +1,127 @@
+#!/usr/bin/env python
+#
+# assetfsgen is a tool used to generate a read-only asset file system image from a directory
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+# Image layout, all fields little-endian:
+#
+#   header   magic, version, entry size, file count, index size, image size, 12 reserved bytes
+#   entries  name offset, name length, flags, data offset, data size; sorted by name
+#   names    full paths relative to the base directory, without the leading '/', zero terminated
+#   data     contents of the files, each aligned to the --align boundary
+#
+# The header, the entries and the names form the index, the offsets are from the beginning of the image.
+# The rest of the image is filled with 0xFF. The layout has to match assetfs_header_t and assetfs_entry_t
+# in esp_assetfs.c.
+import argparse
+import os
+import struct
+from typing import List
+from typing import Set
+from typing import Tuple
+
+ASSETFS_MAGIC = 0x53465341  # 'ASFS'
+ASSETFS_VERSION = 1
+
+HEADER_FORMAT = '<IHHIII12x'
+ENTRY_FORMAT = '<IHHII'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+ENTRY_SIZE = struct.calcsize(ENTRY_FORMAT)
+
+# struct dirent::d_name holds up to 255 characters
+MAX_NAME_COMPONENT_LEN = 255
+MAX_NAME_LEN = 0xFFFF
+
+
+class AssetfsFullError(RuntimeError):
+    pass
+
+
+def align_up(value: int, align: int) -> int:
+    return (value + align - 1) // align * align
+
+
+def collect_files(base_dir: str, follow_symlinks: bool = False) -> List[Tuple[bytes, str]]:
+    """Returns (name, path) of the files in base_dir, sorted by name as the target compares them"""
+    files = []
+    for root, dirs, names in os.walk(base_dir, followlinks=follow_symlinks):
+        for name in names:
+            full_path = os.path.join(root, name)
+            rel_path = os.path.relpath(full_path, base_dir).replace('\\', '/')
+            files.append((rel_path.encode('utf-8'), full_path))
+    files.sort(key=lambda f: f[0])
+    return files
+
+
+def generate_image(files: List[Tuple[bytes, bytes]], image_size: int, align: int = 4) -> bytes:
+    """Returns the image of the files given as (name, contents)"""
+    if align <= 0 or align & (align - 1):
+        raise ValueError('alignment %d is not a power of two' % align)
+    files = sorted(files, key=lambda f: f[0])
+    dirs: Set[bytes] = set()
+    for i, (name, _) in enumerate(files):
+        components = name.split(b'/')
+        if len(name) > MAX_NAME_LEN or b'\0' in name or \
+                any(not c or len(c) > MAX_NAME_COMPONENT_LEN for c in components):
+            raise ValueError('invalid file name %r' % name)
+        if i > 0 and files[i - 1][0] == name:
+            raise ValueError('duplicate file name %r' % name)
+        dirs.update(b'/'.join(components[:n]) for n in range(1, len(components)))
+    for name, _ in files:
+        if name in dirs:
+            raise ValueError('file name %r is also used as a directory' % name)
+
+    names = b''
+    name_offsets = []
+    names_start = HEADER_SIZE + ENTRY_SIZE * len(files)
+    for name, _ in files:
+        name_offsets.append(names_start + len(names))
+        names += name + b'\0'
+    index_size = names_start + len(names)
+
+    entries = b''
+    data = b''
+    data_start = align_up(index_size, align)
+    for (name, contents), name_offset in zip(files, name_offsets):
+        data += b'\xff' * (align_up(len(data), align) - len(data))
+        entries += struct.pack(ENTRY_FORMAT, name_offset, len(name), 0, data_start + len(data), len(contents))
+        data += contents
+    used_size = data_start + len(data)
+    if used_size > image_size:
+        raise AssetfsFullError('%d bytes of files do not fit into an image of %d bytes' % (used_size, image_size))
+
+    header = struct.pack(HEADER_FORMAT, ASSETFS_MAGIC, ASSETFS_VERSION, ENTRY_SIZE, len(files), index_size, used_size)
+    image = header + entries + names
+    image += b'\xff' * (data_start - len(image)) + data
+    return image + b'\xff' * (image_size - len(image))
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description='Read-only asset file system image generator')
+    parser.add_argument('image_size', help='Size of the created image')
+    parser.add_argument('base_dir', help='Path to directory from which the image will be created')
+    parser.add_argument('output_file', help='Created image output file path')
+    parser.add_argument('--align', type=lambda v: int(v, 0), default=4,
+                        help='Alignment of the contents of each file in the image, a power of two. Partitions are '
+                             'aligned to 4 KB, so up to 4 KB this is also the alignment of the mapped contents.')
+    parser.add_argument('--follow-symlinks', action='store_true',
+                        help='Take into account symbolic links during partition image creation.')
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.base_dir):
+        raise RuntimeError('given base directory %s does not exist' % args.base_dir)
+
+    files = []
+    for name, path in collect_files(args.base_dir, args.follow_symlinks):
+        with open(path, 'rb') as f:
+            files.append((name, f.read()))
+    image = generate_image(files, int(args.image_size, 0), args.align)
+
+    with open(args.output_file, 'wb') as image_file:
+        image_file.write(image)
+
+
+if __name__ == '__main__':
+    main()
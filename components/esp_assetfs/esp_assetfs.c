@@ -0,0 +1,617 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/errno.h>
+#include <sys/fcntl.h>
+#include <sys/lock.h>
+#include <sys/param.h>
+#include <sys/stat.h>
+#include "esp_assetfs.h"
+#include "esp_log.h"
+#include "esp_vfs.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "assetfs";
+
+#define ASSETFS_MAGIC   0x53465341  /* 'ASFS' */
+#define ASSETFS_VERSION 1
+
+/* Layout of the image, see assetfsgen.py. The offsets are from the beginning of the image. */
+typedef struct {
+    uint32_t magic;         /*!< ASSETFS_MAGIC */
+    uint16_t version;       /*!< ASSETFS_VERSION */
+    uint16_t entry_size;    /*!< sizeof(assetfs_entry_t) */
+    uint32_t file_count;    /*!< Number of entries, following the header */
+    uint32_t index_size;    /*!< Size of the header, the entries and the names */
+    uint32_t image_size;    /*!< Size of the image up to the end of the last file */
+    uint32_t reserved[3];
+} assetfs_header_t;
+
+typedef struct {
+    uint32_t name_offset;   /*!< Zero terminated path without the leading '/' */
+    uint16_t name_len;      /*!< Length of the path without the terminator */
+    uint16_t flags;         /*!< Reserved */
+    uint32_t data_offset;   /*!< Contents of the file */
+    uint32_t size;          /*!< Size of the file */
+} assetfs_entry_t;
+
+_Static_assert(sizeof(assetfs_header_t) == 32, "assetfs_header_t has to match assetfsgen.py");
+_Static_assert(sizeof(assetfs_entry_t) == 16, "assetfs_entry_t has to match assetfsgen.py");
+
+typedef struct {
+    const assetfs_entry_t *entry;   /*!< NULL if the descriptor is free */
+    size_t pos;
+} assetfs_fd_t;
+
+typedef struct {
+    const esp_partition_t *partition;
+    esp_partition_mmap_handle_t mmap_handle;
+    const uint8_t *image;           /*!< Mapped image, NULL if mmap is disabled */
+    const uint8_t *index;           /*!< Mapped image, or the index loaded into RAM */
+    const assetfs_entry_t *entries; /*!< Sorted by name */
+    uint32_t file_count;
+    _lock_t lock;                   /*!< Protects the descriptors */
+    size_t max_files;
+    char base_path[ESP_VFS_PATH_MAX + 1];
+    assetfs_fd_t fds[];
+} esp_assetfs_t;
+
+#ifdef CONFIG_VFS_SUPPORT_DIR
+typedef struct {
+    DIR dir;                /*!< VFS DIR struct */
+    uint32_t next;          /*!< Index of the next entry to look at */
+    long offset;            /*!< Number of entries returned so far */
+    struct dirent e;        /*!< Last returned dirent */
+    size_t prefix_len;
+    char prefix[];          /*!< Directory path with a trailing '/', or empty for the root */
+} vfs_assetfs_dir_t;
+#endif // CONFIG_VFS_SUPPORT_DIR
+
+static esp_assetfs_t *s_assetfs[CONFIG_ASSETFS_MAX_PARTITIONS];
+
+static inline const char *entry_name(const esp_assetfs_t *efs, const assetfs_entry_t *entry)
+{
+    return (const char *)efs->index + entry->name_offset;
+}
+
+static int compare_name(const esp_assetfs_t *efs, const assetfs_entry_t *entry, const char *key, size_t key_len)
+{
+    int cmp = memcmp(entry_name(efs, entry), key, MIN(entry->name_len, key_len));
+    if (cmp == 0) {
+        cmp = (entry->name_len > key_len) - (entry->name_len < key_len);
+    }
+    return cmp;
+}
+
+/* Index of the first entry whose name is not less than the key */
+static uint32_t lower_bound(const esp_assetfs_t *efs, const char *key, size_t key_len)
+{
+    uint32_t lo = 0;
+    uint32_t hi = efs->file_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (compare_name(efs, &efs->entries[mid], key, key_len) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static const char *skip_slashes(const char *path)
+{
+    while (*path == '/') {
+        path++;
+    }
+    return path;
+}
+
+static const assetfs_entry_t *find_file(const esp_assetfs_t *efs, const char *path)
+{
+    path = skip_slashes(path);
+    size_t len = strlen(path);
+    uint32_t i = lower_bound(efs, path, len);
+    if (i < efs->file_count && compare_name(efs, &efs->entries[i], path, len) == 0) {
+        return &efs->entries[i];
+    }
+    return NULL;
+}
+
+static bool entry_has_prefix(const esp_assetfs_t *efs, uint32_t i, const char *prefix, size_t prefix_len)
+{
+    return i < efs->file_count && efs->entries[i].name_len > prefix_len &&
+           memcmp(entry_name(efs, &efs->entries[i]), prefix, prefix_len) == 0;
+}
+
+/* Directories are not stored, a directory exists if a file name starts with its path */
+static bool is_dir(const esp_assetfs_t *efs, const char *path)
+{
+    path = skip_slashes(path);
+    size_t len = strlen(path);
+    while (len > 0 && path[len - 1] == '/') {
+        len--;
+    }
+    if (len == 0) {
+        return true;
+    }
+    uint32_t i = lower_bound(efs, path, len);
+    /* the entries which start with "dir" are sorted after it, and the ones with "dir/" among them */
+    for (; entry_has_prefix(efs, i, path, len); i++) {
+        char c = entry_name(efs, &efs->entries[i])[len];
+        if (c == '/') {
+            return true;
+        }
+        if (c > '/') {
+            break;
+        }
+    }
+    return false;
+}
+
+static ssize_t read_entry(const esp_assetfs_t *efs, const assetfs_entry_t *entry, void *dst, size_t size, size_t pos)
+{
+    if (pos >= entry->size) {
+        return 0;
+    }
+    size = MIN(size, entry->size - pos);
+    if (efs->image) {
+        memcpy(dst, efs->image + entry->data_offset + pos, size);
+    } else if (esp_partition_read(efs->partition, entry->data_offset + pos, dst, size) != ESP_OK) {
+        errno = EIO;
+        return -1;
+    }
+    return size;
+}
+
+static void fill_stat(const assetfs_entry_t *entry, struct stat *st)
+{
+    memset(st, 0, sizeof(*st));
+    if (entry) {
+        st->st_mode = S_IFREG | S_IRUSR | S_IRGRP | S_IROTH;
+        st->st_size = entry->size;
+    } else {
+        st->st_mode = S_IFDIR | S_IRUSR | S_IXUSR | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH;
+    }
+}
+
+static assetfs_fd_t *get_fd(esp_assetfs_t *efs, int fd)
+{
+    if (fd < 0 || (size_t)fd >= efs->max_files || efs->fds[fd].entry == NULL) {
+        errno = EBADF;
+        return NULL;
+    }
+    return &efs->fds[fd];
+}
+
+static int vfs_assetfs_open(void *ctx, const char *path, int flags, int mode)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    if ((flags & O_ACCMODE) != O_RDONLY) {
+        errno = EROFS;
+        return -1;
+    }
+    const assetfs_entry_t *entry = find_file(efs, path);
+    if (entry == NULL) {
+        errno = is_dir(efs, path) ? EISDIR : ENOENT;
+        return -1;
+    }
+    int fd = -1;
+    _lock_acquire(&efs->lock);
+    for (size_t i = 0; i < efs->max_files; i++) {
+        if (efs->fds[i].entry == NULL) {
+            efs->fds[i].entry = entry;
+            efs->fds[i].pos = 0;
+            fd = i;
+            break;
+        }
+    }
+    _lock_release(&efs->lock);
+    if (fd < 0) {
+        errno = ENFILE;
+    }
+    return fd;
+}
+
+static int vfs_assetfs_close(void *ctx, int fd)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    _lock_acquire(&efs->lock);
+    assetfs_fd_t *f = get_fd(efs, fd);
+    if (f) {
+        f->entry = NULL;
+    }
+    _lock_release(&efs->lock);
+    return f ? 0 : -1;
+}
+
+static ssize_t vfs_assetfs_read(void *ctx, int fd, void *dst, size_t size)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    assetfs_fd_t *f = get_fd(efs, fd);
+    if (f == NULL) {
+        return -1;
+    }
+    ssize_t res = read_entry(efs, f->entry, dst, size, f->pos);
+    if (res > 0) {
+        f->pos += res;
+    }
+    return res;
+}
+
+static ssize_t vfs_assetfs_pread(void *ctx, int fd, void *dst, size_t size, off_t offset)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    assetfs_fd_t *f = get_fd(efs, fd);
+    if (f == NULL) {
+        return -1;
+    }
+    if (offset < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    return read_entry(efs, f->entry, dst, size, offset);
+}
+
+static off_t vfs_assetfs_lseek(void *ctx, int fd, off_t offset, int mode)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    assetfs_fd_t *f = get_fd(efs, fd);
+    if (f == NULL) {
+        return -1;
+    }
+    off_t base;
+    switch (mode) {
+    case SEEK_SET:
+        base = 0;
+        break;
+    case SEEK_CUR:
+        base = f->pos;
+        break;
+    case SEEK_END:
+        base = f->entry->size;
+        break;
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+    if (offset < -base) {
+        errno = EINVAL;
+        return -1;
+    }
+    f->pos = base + offset;
+    return f->pos;
+}
+
+static int vfs_assetfs_fstat(void *ctx, int fd, struct stat *st)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    assetfs_fd_t *f = get_fd(efs, fd);
+    if (f == NULL) {
+        return -1;
+    }
+    fill_stat(f->entry, st);
+    return 0;
+}
+
+#ifdef CONFIG_VFS_SUPPORT_DIR
+
+static int vfs_assetfs_stat(void *ctx, const char *path, struct stat *st)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    const assetfs_entry_t *entry = find_file(efs, path);
+    if (entry == NULL && !is_dir(efs, path)) {
+        errno = ENOENT;
+        return -1;
+    }
+    fill_stat(entry, st);
+    return 0;
+}
+
+static int vfs_assetfs_access(void *ctx, const char *path, int amode)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    if (find_file(efs, path) == NULL && !is_dir(efs, path)) {
+        errno = ENOENT;
+        return -1;
+    }
+    if (amode & W_OK) {
+        errno = EROFS;
+        return -1;
+    }
+    return 0;
+}
+
+static DIR *vfs_assetfs_opendir(void *ctx, const char *name)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    if (!is_dir(efs, name)) {
+        errno = find_file(efs, name) ? ENOTDIR : ENOENT;
+        return NULL;
+    }
+    name = skip_slashes(name);
+    size_t len = strlen(name);
+    while (len > 0 && name[len - 1] == '/') {
+        len--;
+    }
+    vfs_assetfs_dir_t *dir = calloc(1, sizeof(vfs_assetfs_dir_t) + len + 2);
+    if (dir == NULL) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    if (len > 0) {
+        memcpy(dir->prefix, name, len);
+        dir->prefix[len++] = '/';
+    }
+    dir->prefix_len = len;
+    dir->next = lower_bound(efs, dir->prefix, dir->prefix_len);
+    return (DIR *)dir;
+}
+
+static int vfs_assetfs_closedir(void *ctx, DIR *pdir)
+{
+    free(pdir);
+    return 0;
+}
+
+static int vfs_assetfs_readdir_r(void *ctx, DIR *pdir, struct dirent *entry, struct dirent **out_dirent)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    vfs_assetfs_dir_t *dir = (vfs_assetfs_dir_t *)pdir;
+    if (!entry_has_prefix(efs, dir->next, dir->prefix, dir->prefix_len)) {
+        *out_dirent = NULL;
+        return 0;
+    }
+    const assetfs_entry_t *e = &efs->entries[dir->next];
+    const char *child = entry_name(efs, e) + dir->prefix_len;
+    size_t child_len = e->name_len - dir->prefix_len;
+    const char *slash = memchr(child, '/', child_len);
+    if (slash) {
+        /* a subdirectory, skip the other entries in it */
+        child_len = slash - child;
+        size_t sub_len = dir->prefix_len + child_len + 1;
+        do {
+            dir->next++;
+        } while (entry_has_prefix(efs, dir->next, entry_name(efs, e), sub_len));
+    } else {
+        dir->next++;
+    }
+    entry->d_ino = 0;
+    entry->d_type = slash ? DT_DIR : DT_REG;
+    child_len = MIN(child_len, sizeof(entry->d_name) - 1);
+    memcpy(entry->d_name, child, child_len);
+    entry->d_name[child_len] = '\0';
+    dir->offset++;
+    *out_dirent = entry;
+    return 0;
+}
+
+static struct dirent *vfs_assetfs_readdir(void *ctx, DIR *pdir)
+{
+    vfs_assetfs_dir_t *dir = (vfs_assetfs_dir_t *)pdir;
+    struct dirent *out_dirent;
+    vfs_assetfs_readdir_r(ctx, pdir, &dir->e, &out_dirent);
+    return out_dirent;
+}
+
+static long vfs_assetfs_telldir(void *ctx, DIR *pdir)
+{
+    vfs_assetfs_dir_t *dir = (vfs_assetfs_dir_t *)pdir;
+    return dir->offset;
+}
+
+static void vfs_assetfs_seekdir(void *ctx, DIR *pdir, long offset)
+{
+    esp_assetfs_t *efs = (esp_assetfs_t *)ctx;
+    vfs_assetfs_dir_t *dir = (vfs_assetfs_dir_t *)pdir;
+    dir->next = lower_bound(efs, dir->prefix, dir->prefix_len);
+    dir->offset = 0;
+    while (dir->offset < offset && vfs_assetfs_readdir(ctx, pdir) != NULL) {
+    }
+}
+
+static const esp_vfs_dir_ops_t s_vfs_assetfs_dir = {
+    .stat_p = &vfs_assetfs_stat,
+    .access_p = &vfs_assetfs_access,
+    .opendir_p = &vfs_assetfs_opendir,
+    .closedir_p = &vfs_assetfs_closedir,
+    .readdir_p = &vfs_assetfs_readdir,
+    .readdir_r_p = &vfs_assetfs_readdir_r,
+    .seekdir_p = &vfs_assetfs_seekdir,
+    .telldir_p = &vfs_assetfs_telldir,
+};
+#endif // CONFIG_VFS_SUPPORT_DIR
+
+static const esp_vfs_fs_ops_t s_vfs_assetfs = {
+    .lseek_p = &vfs_assetfs_lseek,
+    .read_p = &vfs_assetfs_read,
+    .pread_p = &vfs_assetfs_pread,
+    .open_p = &vfs_assetfs_open,
+    .close_p = &vfs_assetfs_close,
+    .fstat_p = &vfs_assetfs_fstat,
+#ifdef CONFIG_VFS_SUPPORT_DIR
+    .dir = &s_vfs_assetfs_dir,
+#endif // CONFIG_VFS_SUPPORT_DIR
+};
+
+static int assetfs_by_label(const char *label)
+{
+    for (int i = 0; i < CONFIG_ASSETFS_MAX_PARTITIONS; i++) {
+        if (s_assetfs[i] && label && strcmp(s_assetfs[i]->partition->label, label) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void assetfs_free(esp_assetfs_t *efs)
+{
+    if (efs->image) {
+        esp_partition_munmap(efs->mmap_handle);
+    } else {
+        free((void *)efs->index);
+    }
+    _lock_close(&efs->lock);
+    free(efs);
+}
+
+/* Check the index once, so that the lookups can trust the offsets */
+static esp_err_t assetfs_check_index(const esp_assetfs_t *efs, const assetfs_header_t *header)
+{
+    for (uint32_t i = 0; i < efs->file_count; i++) {
+        const assetfs_entry_t *e = &efs->entries[i];
+        if (e->name_offset < sizeof(*header) || e->name_len == 0 ||
+                (uint64_t)e->name_offset + e->name_len >= header->index_size ||
+                efs->index[e->name_offset + e->name_len] != '\0' ||
+                e->data_offset < header->index_size ||
+                (uint64_t)e->data_offset + e->size > header->image_size) {
+            ESP_LOGE(TAG, "invalid entry %"PRIu32, i);
+            return ESP_ERR_INVALID_VERSION;
+        }
+        if (i > 0 && compare_name(efs, &efs->entries[i - 1], entry_name(efs, e), e->name_len) >= 0) {
+            ESP_LOGE(TAG, "index is not sorted");
+            return ESP_ERR_INVALID_VERSION;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t assetfs_load(esp_assetfs_t *efs, bool disable_mmap)
+{
+    assetfs_header_t header;
+    esp_err_t err = esp_partition_read(efs->partition, 0, &header, sizeof(header));
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (header.magic != ASSETFS_MAGIC || header.version != ASSETFS_VERSION ||
+            header.entry_size != sizeof(assetfs_entry_t) ||
+            header.index_size < sizeof(header) + (uint64_t)header.file_count * sizeof(assetfs_entry_t) ||
+            header.image_size < header.index_size || header.image_size > efs->partition->size) {
+        ESP_LOGE(TAG, "partition %s does not hold a valid image", efs->partition->label);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    if (disable_mmap) {
+        uint8_t *index = malloc(header.index_size);
+        if (index == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        efs->index = index;
+        err = esp_partition_read(efs->partition, 0, index, header.index_size);
+    } else {
+        const void *image;
+        err = esp_partition_mmap(efs->partition, 0, header.image_size, ESP_PARTITION_MMAP_DATA,
+                                 &image, &efs->mmap_handle);
+        if (err == ESP_OK) {
+            efs->image = image;
+            efs->index = image;
+        }
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    efs->entries = (const assetfs_entry_t *)(efs->index + sizeof(header));
+    efs->file_count = header.file_count;
+    return assetfs_check_index(efs, &header);
+}
+
+esp_err_t esp_vfs_assetfs_register(const esp_vfs_assetfs_conf_t *conf)
+{
+    if (conf == NULL || conf->base_path == NULL || conf->partition_label == NULL ||
+            strlen(conf->base_path) > ESP_VFS_PATH_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (assetfs_by_label(conf->partition_label) >= 0) {
+        ESP_LOGE(TAG, "partition %s is already mounted", conf->partition_label);
+        return ESP_ERR_INVALID_STATE;
+    }
+    int index;
+    for (index = 0; index < CONFIG_ASSETFS_MAX_PARTITIONS && s_assetfs[index]; index++) {
+    }
+    if (index == CONFIG_ASSETFS_MAX_PARTITIONS) {
+        ESP_LOGE(TAG, "max mounted partitions reached");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                                conf->partition_label);
+    if (partition == NULL) {
+        ESP_LOGE(TAG, "partition %s could not be found", conf->partition_label);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_assetfs_t *efs = calloc(1, sizeof(esp_assetfs_t) + conf->max_files * sizeof(assetfs_fd_t));
+    if (efs == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    efs->partition = partition;
+    efs->max_files = conf->max_files;
+    strlcpy(efs->base_path, conf->base_path, sizeof(efs->base_path));
+
+    esp_err_t err = assetfs_load(efs, conf->disable_mmap);
+    if (err == ESP_OK) {
+        err = esp_vfs_register_fs(conf->base_path, &s_vfs_assetfs,
+                                  ESP_VFS_FLAG_CONTEXT_PTR | ESP_VFS_FLAG_STATIC | ESP_VFS_FLAG_READONLY_FS, efs);
+    }
+    if (err != ESP_OK) {
+        assetfs_free(efs);
+        return err;
+    }
+    s_assetfs[index] = efs;
+    ESP_LOGD(TAG, "mounted %"PRIu32" files of partition %s at %s", efs->file_count, partition->label, efs->base_path);
+    return ESP_OK;
+}
+
+esp_err_t esp_vfs_assetfs_unregister(const char *partition_label)
+{
+    int index = assetfs_by_label(partition_label);
+    if (index < 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = esp_vfs_unregister(s_assetfs[index]->base_path);
+    if (err != ESP_OK) {
+        return err;
+    }
+    assetfs_free(s_assetfs[index]);
+    s_assetfs[index] = NULL;
+    return ESP_OK;
+}
+
+bool esp_assetfs_mounted(const char *partition_label)
+{
+    return assetfs_by_label(partition_label) >= 0;
+}
+
+esp_err_t esp_assetfs_get_file(const char *path, esp_assetfs_file_t *file)
+{
+    if (path == NULL || file == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < CONFIG_ASSETFS_MAX_PARTITIONS; i++) {
+        const esp_assetfs_t *efs = s_assetfs[i];
+        if (efs == NULL) {
+            continue;
+        }
+        size_t base_len = strlen(efs->base_path);
+        if (strncmp(path, efs->base_path, base_len) != 0 || path[base_len] != '/') {
+            continue;
+        }
+        const assetfs_entry_t *entry = find_file(efs, path + base_len);
+        if (entry == NULL) {
+            continue;
+        }
+        file->data = efs->image ? efs->image + entry->data_offset : NULL;
+        file->size = entry->size;
+        file->partition = efs->partition;
+        file->offset = entry->data_offset;
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_partition.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configuration structure for esp_vfs_assetfs_register
+ */
+typedef struct {
+    const char *base_path;          /*!< File path prefix associated with the filesystem. */
+    const char *partition_label;    /*!< Label of the data partition which holds the image created by assetfsgen.py. */
+    size_t max_files;               /*!< Maximum files that could be open at the same time. */
+    bool disable_mmap;              /*!< If true, the image is not mapped into the address space, the files are read
+                                         with esp_partition_read() and the index is loaded into RAM. This saves MMU
+                                         pages for large images, but esp_assetfs_get_file() can not provide pointers. */
+} esp_vfs_assetfs_conf_t;
+
+/**
+ * @brief Location of a file in the asset file system
+ */
+typedef struct {
+    const void *data;                   /*!< Contents of the file in the mapped image, valid until the file system is
+                                             unregistered. NULL if the file system was registered with disable_mmap. */
+    size_t size;                        /*!< Size of the file in bytes */
+    const esp_partition_t *partition;   /*!< Partition which holds the image */
+    size_t offset;                      /*!< Offset of the contents from the beginning of the partition */
+} esp_assetfs_file_t;
+
+/**
+ * Register the read-only asset file system in a partition to VFS with given path prefix.
+ *
+ * The image is created on the host by assetfsgen.py, see assetfs_create_partition_image() in CMake.
+ * It holds an index of the files sorted by name, so open() and stat() do a binary search and
+ * do not need any RAM per file. Unless disable_mmap is set, the whole image is mapped with
+ * esp_partition_mmap() and read() copies directly from the mapping.
+ *
+ * @param conf Pointer to esp_vfs_assetfs_conf_t configuration structure
+ *
+ * @return
+ *          - ESP_OK                  if success
+ *          - ESP_ERR_INVALID_ARG     if the base path or the partition label is missing
+ *          - ESP_ERR_NO_MEM          if objects could not be allocated, or there are not enough free MMU pages
+ *          - ESP_ERR_INVALID_STATE   if already mounted, or CONFIG_ASSETFS_MAX_PARTITIONS are mounted
+ *          - ESP_ERR_NOT_FOUND       if the partition was not found
+ *          - ESP_ERR_INVALID_VERSION if the partition does not hold a valid image
+ */
+esp_err_t esp_vfs_assetfs_register(const esp_vfs_assetfs_conf_t *conf);
+
+/**
+ * Unregister the asset file system from VFS and unmap the image
+ *
+ * Pointers returned by esp_assetfs_get_file() are no longer valid after this call.
+ *
+ * @param partition_label Same label as passed to esp_vfs_assetfs_register.
+ *
+ * @return
+ *          - ESP_OK if successful
+ *          - ESP_ERR_INVALID_STATE already unregistered
+ */
+esp_err_t esp_vfs_assetfs_unregister(const char *partition_label);
+
+/**
+ * Check if the asset file system is mounted
+ *
+ * @param partition_label Label of the partition to check.
+ *
+ * @return
+ *          - true    if mounted
+ *          - false   if not mounted
+ */
+bool esp_assetfs_mounted(const char *partition_label);
+
+/**
+ * Get the location of a file, to use its contents without copying them
+ *
+ * The contents can be read through the returned pointer, or sent with httpd_resp_send_partition()
+ * using the returned partition and offset:
+ *
+ * @code{c}
+ * esp_assetfs_file_t file;
+ * if (esp_assetfs_get_file("/www/index.html", &file) == ESP_OK) {
+ *     httpd_resp_send_partition(req, file.partition, file.offset, file.size);
+ * }
+ * @endcode
+ *
+ * @param path      Full path of the file, including the base path of the file system
+ * @param[out] file Location of the file
+ *
+ * @return
+ *          - ESP_OK                  if successful
+ *          - ESP_ERR_INVALID_ARG     if path or file is NULL
+ *          - ESP_ERR_NOT_FOUND       if no asset file system is mounted at the path, or the file does not exist
+ */
+esp_err_t esp_assetfs_get_file(const char *path, esp_assetfs_file_t *file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,54 @@
+# assetfs_create_partition_image
+#
+# Create an asset file system image of the specified directory on the host during build and optionally
+# have the created image flashed using `idf.py flash`. ALIGN sets the alignment of the contents of each
+# file, e.g. for models which are used in place through the pointer from esp_assetfs_get_file().
+function(assetfs_create_partition_image partition base_dir)
+    set(options FLASH_IN_PROJECT)
+    set(single ALIGN)
+    set(multi DEPENDS)
+    cmake_parse_arguments(arg "${options}" "${single}" "${multi}" "${ARGN}")
+
+    idf_build_get_property(idf_path IDF_PATH)
+    set(assetfsgen_py ${PYTHON} ${idf_path}/components/esp_assetfs/assetfsgen.py)
+
+    get_filename_component(base_dir_full_path ${base_dir} ABSOLUTE)
+
+    partition_table_get_partition_info(size "--partition-name ${partition}" "size")
+    partition_table_get_partition_info(offset "--partition-name ${partition}" "offset")
+
+    if(NOT arg_ALIGN)
+        set(arg_ALIGN 4)
+    endif()
+
+    if("${size}" AND "${offset}")
+        set(image_file ${CMAKE_BINARY_DIR}/${partition}.bin)
+
+        # Execute image generation; this always executes as there is no way to specify for CMake to watch for
+        # contents of the base dir changing.
+        add_custom_target(assetfs_${partition}_bin ALL
+            COMMAND ${assetfsgen_py} ${size} ${base_dir_full_path} ${image_file} --align=${arg_ALIGN}
+            DEPENDS ${arg_DEPENDS}
+            )
+
+        set_property(DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}" APPEND PROPERTY
+            ADDITIONAL_CLEAN_FILES
+            ${image_file})
+
+        idf_component_get_property(main_args esptool_py FLASH_ARGS)
+        idf_component_get_property(sub_args esptool_py FLASH_SUB_ARGS)
+        esptool_py_flash_target(${partition}-flash "${main_args}" "${sub_args}" ALWAYS_PLAINTEXT)
+        esptool_py_flash_to_partition(${partition}-flash "${partition}" "${image_file}")
+
+        add_dependencies(${partition}-flash assetfs_${partition}_bin)
+
+        if(arg_FLASH_IN_PROJECT)
+            esptool_py_flash_to_partition(flash "${partition}" "${image_file}")
+            add_dependencies(flash assetfs_${partition}_bin)
+        endif()
+    else()
+        set(message "Failed to create asset file system image for partition '${partition}'. "
+                    "Check project configuration if using the correct partition table file.")
+        fail_at_build_time(assetfs_${partition}_bin "${message}")
+    endif()
+endfunction()
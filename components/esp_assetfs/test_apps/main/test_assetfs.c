@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "unity.h"
+#include "esp_assetfs.h"
+#include "esp_partition.h"
+
+static const char *hello_str = "Hello, World!\n";
+static const char *partition_label = "assets";
+
+void app_main(void)
+{
+    unity_run_menu();
+}
+
+static void mount(bool disable_mmap)
+{
+    esp_vfs_assetfs_conf_t conf = {
+        .base_path = "/assets",
+        .partition_label = partition_label,
+        .max_files = 2,
+        .disable_mmap = disable_mmap,
+    };
+    TEST_ESP_OK(esp_vfs_assetfs_register(&conf));
+}
+
+static void unmount(void)
+{
+    TEST_ESP_OK(esp_vfs_assetfs_unregister(partition_label));
+}
+
+static void check_read(void)
+{
+    char buf[32] = {};
+    FILE *f = fopen("/assets/hello.txt", "r");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(strlen(hello_str), fread(buf, 1, sizeof(buf), f));
+    TEST_ASSERT_EQUAL_STRING(hello_str, buf);
+    TEST_ASSERT_EQUAL(0, fseek(f, 7, SEEK_SET));
+    TEST_ASSERT_EQUAL('W', fgetc(f));
+    TEST_ASSERT_EQUAL(0, fclose(f));
+
+    int fd = open("/assets/models/weights.bin", O_RDONLY);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+    struct stat st;
+    TEST_ASSERT_EQUAL(0, fstat(fd, &st));
+    TEST_ASSERT_EQUAL(4096, st.st_size);
+    uint8_t data[4];
+    TEST_ASSERT_EQUAL(sizeof(data), pread(fd, data, sizeof(data), 256 + 100));
+    TEST_ASSERT_EQUAL(100, data[0]);
+    TEST_ASSERT_EQUAL(4096 - 2, lseek(fd, -2, SEEK_END));
+    TEST_ASSERT_EQUAL(2, read(fd, data, sizeof(data)));
+    TEST_ASSERT_EQUAL(0, read(fd, data, sizeof(data)));
+    TEST_ASSERT_EQUAL(0, close(fd));
+}
+
+TEST_CASE("can read files", "[assetfs]")
+{
+    mount(false);
+    check_read();
+    unmount();
+    mount(true);
+    check_read();
+    unmount();
+}
+
+TEST_CASE("can not write or open missing files", "[assetfs]")
+{
+    mount(false);
+    TEST_ASSERT_NULL(fopen("/assets/hello.txt", "w"));
+    TEST_ASSERT_EQUAL(EROFS, errno);
+    TEST_ASSERT_NULL(fopen("/assets/new.txt", "w"));
+    TEST_ASSERT_EQUAL(-1, open("/assets/missing.txt", O_RDONLY));
+    TEST_ASSERT_EQUAL(ENOENT, errno);
+    TEST_ASSERT_EQUAL(-1, open("/assets/css", O_RDONLY));
+    TEST_ASSERT_EQUAL(EISDIR, errno);
+    TEST_ASSERT_EQUAL(-1, unlink("/assets/hello.txt"));
+
+    int fd1 = open("/assets/hello.txt", O_RDONLY);
+    int fd2 = open("/assets/hello.txt", O_RDONLY);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd1);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd2);
+    TEST_ASSERT_EQUAL(-1, open("/assets/hello.txt", O_RDONLY));
+    TEST_ASSERT_EQUAL(0, close(fd1));
+    TEST_ASSERT_EQUAL(0, close(fd2));
+    unmount();
+}
+
+TEST_CASE("can list directories", "[assetfs]")
+{
+    mount(false);
+    struct stat st;
+    TEST_ASSERT_EQUAL(0, stat("/assets/css", &st));
+    TEST_ASSERT_TRUE(S_ISDIR(st.st_mode));
+    TEST_ASSERT_EQUAL(0, stat("/assets/css/main.css", &st));
+    TEST_ASSERT_TRUE(S_ISREG(st.st_mode));
+
+    DIR *dir = opendir("/assets");
+    TEST_ASSERT_NOT_NULL(dir);
+    char names[64] = "";
+    struct dirent *e;
+    while ((e = readdir(dir)) != NULL) {
+        strlcat(names, e->d_name, sizeof(names));
+        strlcat(names, e->d_type == DT_DIR ? "/ " : " ", sizeof(names));
+    }
+    TEST_ASSERT_EQUAL_STRING("css/ hello.txt models/ ", names);
+    rewinddir(dir);
+    e = readdir(dir);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_STRING("css", e->d_name);
+    TEST_ASSERT_EQUAL(0, closedir(dir));
+    unmount();
+}
+
+TEST_CASE("can get the contents without copying", "[assetfs]")
+{
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                                ESP_PARTITION_SUBTYPE_ANY, partition_label);
+    TEST_ASSERT_NOT_NULL_MESSAGE(partition, "partition table not set correctly");
+
+    mount(false);
+    esp_assetfs_file_t file;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_assetfs_get_file("/assets/missing.txt", &file));
+    TEST_ESP_OK(esp_assetfs_get_file("/assets/models/weights.bin", &file));
+    TEST_ASSERT_EQUAL(4096, file.size);
+    TEST_ASSERT_EQUAL_PTR(partition, file.partition);
+    // the image is created with ALIGN 16 in main/CMakeLists.txt
+    TEST_ASSERT_EQUAL(0, file.offset % 16);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)file.data % 16);
+    const uint8_t *data = file.data;
+    for (int i = 0; i < file.size; i++) {
+        TEST_ASSERT_EQUAL(i & 0xff, data[i]);
+    }
+    uint8_t buf[4];
+    TEST_ESP_OK(esp_partition_read(partition, file.offset + 5, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(5, buf[0]);
+    unmount();
+
+    mount(true);
+    TEST_ESP_OK(esp_assetfs_get_file("/assets/hello.txt", &file));
+    TEST_ASSERT_NULL(file.data);
+    TEST_ASSERT_EQUAL(strlen(hello_str), file.size);
+    unmount();
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_assetfs_get_file("/assets/hello.txt", &file));
+}
@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+import os
+import struct
+import sys
+import tempfile
+import unittest
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '..'))
+import assetfsgen  # noqa: E402
+
+
+def parse_image(image):  # type: (bytes) -> dict
+    """Returns the files in the image as {name: contents}, checking the index as the target does"""
+    magic, version, entry_size, file_count, index_size, used_size = struct.unpack_from(assetfsgen.HEADER_FORMAT, image)
+    assert magic == assetfsgen.ASSETFS_MAGIC and version == assetfsgen.ASSETFS_VERSION
+    assert entry_size == assetfsgen.ENTRY_SIZE
+    files = {}
+    names = []
+    for i in range(file_count):
+        name_offset, name_len, _, data_offset, size = struct.unpack_from(
+            assetfsgen.ENTRY_FORMAT, image, assetfsgen.HEADER_SIZE + i * entry_size)
+        assert name_offset + name_len < index_size and image[name_offset + name_len] == 0
+        assert index_size <= data_offset and data_offset + size <= used_size
+        name = image[name_offset:name_offset + name_len]
+        names.append(name)
+        files[name] = (data_offset, image[data_offset:data_offset + size])
+    assert names == sorted(names)
+    return files
+
+
+class AssetfsgenTest(unittest.TestCase):
+    def test_files(self):  # type: () -> None
+        files = [(b'index.html', b'<html></html>'), (b'css/main.css', b'body {}'), (b'css-old.css', b'x' * 1000),
+                 (b'models/m.bin', bytes(range(256))), (b'empty', b'')]
+        for align in (1, 4, 64):
+            image = assetfsgen.generate_image(files, 0x2000, align)
+            self.assertEqual(len(image), 0x2000)
+            parsed = parse_image(image)
+            self.assertEqual(len(parsed), len(files))
+            for name, contents in files:
+                data_offset, data = parsed[name]
+                self.assertEqual(data, contents)
+                self.assertEqual(data_offset % align, 0)
+            # bytewise order, as compared by memcmp() on the target
+            self.assertEqual(list(parsed), [b'css-old.css', b'css/main.css', b'empty', b'index.html', b'models/m.bin'])
+
+    def test_errors(self):  # type: () -> None
+        with self.assertRaises(assetfsgen.AssetfsFullError):
+            assetfsgen.generate_image([(b'a', b'x' * 0x1000)], 0x1000)
+        with self.assertRaises(ValueError):
+            assetfsgen.generate_image([(b'a', b''), (b'a', b'')], 0x1000)
+        with self.assertRaises(ValueError):
+            assetfsgen.generate_image([(b'a', b''), (b'a/b', b'')], 0x1000)
+        with self.assertRaises(ValueError):
+            assetfsgen.generate_image([(b'a//b', b'')], 0x1000)
+        with self.assertRaises(ValueError):
+            assetfsgen.generate_image([(b'a', b'')], 0x1000, align=3)
+
+    def test_directory(self):  # type: () -> None
+        with tempfile.TemporaryDirectory() as base_dir:
+            os.makedirs(os.path.join(base_dir, 'sub', 'dir'))
+            for name in ('a.txt', os.path.join('sub', 'b.txt'), os.path.join('sub', 'dir', 'c.txt')):
+                with open(os.path.join(base_dir, name), 'wb') as f:
+                    f.write(name.encode())
+            files = assetfsgen.collect_files(base_dir)
+            self.assertEqual([name for name, _ in files], [b'a.txt', b'sub/b.txt', b'sub/dir/c.txt'])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -292,6 +292,10 @@ static const esp_err_msg_t esp_err_msg_table[] = {
                                                                                 essentially first boot of firmware image
                                                                                 post upgrade and hence firmware upgrade
                                                                                 is not possible */
+#   endif
+#   ifdef      ESP_ERR_OTA_PATCH_BASE_MISMATCH
+    ERR_TBL_IT(ESP_ERR_OTA_PATCH_BASE_MISMATCH),                /*  5383 0x1507 Error if an OTA patch was created against
+                                                                                a different base image */
 #   endif
     // components/efuse/include/esp_efuse.h
 #   ifdef      ESP_ERR_EFUSE
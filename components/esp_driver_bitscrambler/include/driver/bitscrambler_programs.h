@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include "driver/bitscrambler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Library of common BitScrambler programs, assembled and embedded by the BitScrambler driver.
+ *
+ * The programs prefetch the input, so a transfer must carry at least 8 bytes of data.
+ * They can be loaded with bitscrambler_load_program() into a loopback BitScrambler, or into a
+ * BitScrambler attached to a peripheral to transform its DMA stream on the fly.
+ */
+
+/**
+ * @brief Swap the two bytes of every 16-bit word, e.g. to send RGB565 pixels MSB first
+ *
+ * Input `01 23 45 67` gives `23 01 67 45`. The data length must be a multiple of 2 bytes.
+ */
+BITSCRAMBLER_PROGRAM(bitscrambler_program_swap16, "esp_swap16");
+
+/**
+ * @brief Reverse the byte order of every 32-bit word, e.g. to convert big endian samples
+ *
+ * Input `01 23 45 67` gives `67 45 23 01`. The data length must be a multiple of 4 bytes.
+ */
+BITSCRAMBLER_PROGRAM(bitscrambler_program_swap32, "esp_swap32");
+
+/**
+ * @brief Reverse the bit order of every byte, e.g. to send data LSB first on an MSB first bus
+ *
+ * Input `01 23` gives `80 C4`. The data length must be a multiple of 4 bytes.
+ */
+BITSCRAMBLER_PROGRAM(bitscrambler_program_bitrev8, "esp_bitrev8");
+
+/**
+ * @brief Unpack every 24-bit word into a 32-bit word with a zero top byte, e.g. RGB888 to XRGB8888
+ *
+ * Input `01 23 45 67 89 AB` gives `01 23 45 00 67 89 AB 00`. The data length must be a multiple of
+ * 3 bytes, the output is 4/3 of the input length.
+ */
+BITSCRAMBLER_PROGRAM(bitscrambler_program_unpack24to32, "esp_unpack24to32");
+
+#ifdef __cplusplus
+}
+#endif
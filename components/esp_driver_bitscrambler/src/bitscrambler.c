@@ -307,7 +307,7 @@ esp_err_t bitscrambler_reset(bitscrambler_handle_t handle)
         timeout--;
     }
     if (timeout == 0) {
-        ESP_LOGE(TAG, "bitscrambler_reset: Timeout waiting for idle!");
+        ESP_DRAM_LOGE(TAG, "bitscrambler_reset: Timeout waiting for idle!");
         ret = ESP_ERR_TIMEOUT;
     }
     //Reset the fifos & eof trace ctrs
@@ -9,6 +9,7 @@
 #include "unity_test_utils.h"
 #include "driver/bitscrambler.h"
 #include "driver/bitscrambler_loopback.h"
+#include "driver/bitscrambler_programs.h"
 #include "esp_heap_caps.h"
 
 BITSCRAMBLER_PROGRAM(bitscrambler_program_trivial, "trivial");
@@ -200,3 +201,72 @@ TEST_CASE("BitScrambler with loop instruction", "[bs]")
 
     free(data_out);
 }
+
+TEST_CASE("BitScrambler program library", "[bs]")
+{
+    const size_t len = 48; // multiple of 2, 3 and 4
+    uint8_t *data_in = heap_caps_aligned_calloc(8, 1, len, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    uint8_t *data_out = heap_caps_aligned_calloc(8, 1, len * 2, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    uint8_t *expected = heap_caps_calloc(1, len * 2, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(data_in);
+    TEST_ASSERT_NOT_NULL(data_out);
+    TEST_ASSERT_NOT_NULL(expected);
+    for (size_t i = 0; i < len; i++) {
+        data_in[i] = (uint8_t)rand();
+    }
+
+    bitscrambler_handle_t bs;
+    size_t res_len = 0;
+    TEST_ESP_OK(bitscrambler_loopback_create(&bs, SOC_BITSCRAMBLER_ATTACH_I2S0, len * 2));
+
+    printf("swap16\n");
+    for (size_t i = 0; i < len; i += 2) {
+        expected[i] = data_in[i + 1];
+        expected[i + 1] = data_in[i];
+    }
+    TEST_ESP_OK(bitscrambler_load_program(bs, bitscrambler_program_swap16));
+    TEST_ESP_OK(bitscrambler_loopback_run(bs, data_in, len, data_out, len * 2, &res_len));
+    TEST_ASSERT_EQUAL(len, res_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, data_out, len);
+
+    printf("swap32\n");
+    for (size_t i = 0; i < len; i += 4) {
+        for (size_t j = 0; j < 4; j++) {
+            expected[i + j] = data_in[i + 3 - j];
+        }
+    }
+    TEST_ESP_OK(bitscrambler_load_program(bs, bitscrambler_program_swap32));
+    TEST_ESP_OK(bitscrambler_loopback_run(bs, data_in, len, data_out, len * 2, &res_len));
+    TEST_ASSERT_EQUAL(len, res_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, data_out, len);
+
+    printf("bitrev8\n");
+    for (size_t i = 0; i < len; i++) {
+        uint8_t rev = 0;
+        for (int bit = 0; bit < 8; bit++) {
+            rev |= ((data_in[i] >> bit) & 0x01) << (7 - bit);
+        }
+        expected[i] = rev;
+    }
+    TEST_ESP_OK(bitscrambler_load_program(bs, bitscrambler_program_bitrev8));
+    TEST_ESP_OK(bitscrambler_loopback_run(bs, data_in, len, data_out, len * 2, &res_len));
+    TEST_ASSERT_EQUAL(len, res_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, data_out, len);
+
+    printf("unpack24to32\n");
+    for (size_t i = 0; i < len / 3; i++) {
+        expected[i * 4] = data_in[i * 3];
+        expected[i * 4 + 1] = data_in[i * 3 + 1];
+        expected[i * 4 + 2] = data_in[i * 3 + 2];
+        expected[i * 4 + 3] = 0;
+    }
+    TEST_ESP_OK(bitscrambler_load_program(bs, bitscrambler_program_unpack24to32));
+    TEST_ESP_OK(bitscrambler_loopback_run(bs, data_in, len, data_out, len * 2, &res_len));
+    TEST_ASSERT_GREATER_OR_EQUAL(len / 3 * 4, res_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, data_out, len / 3 * 4);
+
+    bitscrambler_free(bs);
+    free(data_in);
+    free(data_out);
+    free(expected);
+}
@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_cache.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_cam_fb_pool.h"
+
+#if CONFIG_CAM_CTLR_MIPI_CSI_ISR_CACHE_SAFE || CONFIG_CAM_CTLR_ISP_DVP_ISR_CACHE_SAFE || CONFIG_CAM_CTLR_DVP_CAM_ISR_CACHE_SAFE
+#define FB_POOL_ISR_ATTR        IRAM_ATTR
+#define FB_POOL_MEM_ALLOC_CAPS  (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define FB_POOL_ISR_ATTR
+#define FB_POOL_MEM_ALLOC_CAPS  MALLOC_CAP_DEFAULT
+#endif
+
+#define FB_POOL_DMA_ALIGNMENT   4
+
+typedef struct {
+    void *buffer;           // Frame buffer
+    uint32_t ref_cnt;       // Number of references, 0 if the frame buffer is free
+    bool dirty;             // The CPU wrote into the frame buffer, its cache has to be written back
+} esp_cam_fb_t;
+
+struct esp_cam_fb_pool_t {
+    portMUX_TYPE spinlock;  // Spinlock protecting the reference counts
+    size_t fb_size;         // Size of each frame buffer
+    size_t fb_num;          // Number of frame buffers
+    bool cache_sync;        // Whether the frame buffers are accessed through the cache
+    esp_cam_fb_t fbs[];     // Frame buffers
+};
+
+static const char *TAG = "CAM_FB_POOL";
+
+esp_err_t esp_cam_new_fb_pool(const esp_cam_fb_pool_config_t *config, esp_cam_fb_pool_handle_t *ret_pool)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_pool, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    ESP_RETURN_ON_FALSE(config->fb_size && config->fb_num, ESP_ERR_INVALID_ARG, TAG, "invalid argument: fb_size or fb_num is 0");
+
+    uint32_t buf_caps = (config->flags.internal_mem ? MALLOC_CAP_INTERNAL : MALLOC_CAP_SPIRAM) | MALLOC_CAP_DMA;
+    size_t cache_alignment = 0;
+    ESP_RETURN_ON_ERROR(esp_cache_get_alignment(buf_caps, &cache_alignment), TAG, "failed to get cache alignment");
+    size_t alignment = MAX(cache_alignment, FB_POOL_DMA_ALIGNMENT);
+
+    esp_cam_fb_pool_handle_t pool = heap_caps_calloc(1, sizeof(struct esp_cam_fb_pool_t) + config->fb_num * sizeof(esp_cam_fb_t), FB_POOL_MEM_ALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(pool, ESP_ERR_NO_MEM, TAG, "no mem for frame buffer pool");
+    portMUX_INITIALIZE(&pool->spinlock);
+    // Round the size up, so that no other data shares the cache lines of the frame buffers
+    pool->fb_size = (config->fb_size + alignment - 1) & ~(alignment - 1);
+    pool->fb_num = config->fb_num;
+    pool->cache_sync = cache_alignment > 0;
+    for (size_t i = 0; i < pool->fb_num; i++) {
+        pool->fbs[i].buffer = heap_caps_aligned_calloc(alignment, 1, pool->fb_size, buf_caps);
+        ESP_GOTO_ON_FALSE(pool->fbs[i].buffer, ESP_ERR_NO_MEM, err, TAG, "no mem for frame buffer %zu", i);
+        if (pool->cache_sync) {
+            // Write back the zeroes of calloc, which could otherwise be evicted over the first frame
+            esp_cache_msync(pool->fbs[i].buffer, pool->fb_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+        }
+    }
+    ESP_LOGD(TAG, "new pool %p: %zu frame buffers of %zu bytes", pool, pool->fb_num, pool->fb_size);
+    *ret_pool = pool;
+    return ESP_OK;
+
+err:
+    for (size_t i = 0; i < pool->fb_num; i++) {
+        free(pool->fbs[i].buffer);
+    }
+    free(pool);
+    return ret;
+}
+
+esp_err_t esp_cam_del_fb_pool(esp_cam_fb_pool_handle_t pool)
+{
+    ESP_RETURN_ON_FALSE(pool, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    for (size_t i = 0; i < pool->fb_num; i++) {
+        ESP_RETURN_ON_FALSE(pool->fbs[i].ref_cnt == 0, ESP_ERR_INVALID_STATE, TAG, "frame buffer %p still referenced", pool->fbs[i].buffer);
+    }
+    for (size_t i = 0; i < pool->fb_num; i++) {
+        free(pool->fbs[i].buffer);
+    }
+    free(pool);
+    return ESP_OK;
+}
+
+static FB_POOL_ISR_ATTR esp_cam_fb_t *esp_cam_fb_pool_find(esp_cam_fb_pool_handle_t pool, const void *fb)
+{
+    for (size_t i = 0; i < pool->fb_num; i++) {
+        if (pool->fbs[i].buffer == fb) {
+            return &pool->fbs[i];
+        }
+    }
+    return NULL;
+}
+
+FB_POOL_ISR_ATTR esp_err_t esp_cam_fb_pool_alloc(esp_cam_fb_pool_handle_t pool, void **ret_fb)
+{
+    ESP_RETURN_ON_FALSE_ISR(pool && ret_fb, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    portENTER_CRITICAL_SAFE(&pool->spinlock);
+    for (size_t i = 0; i < pool->fb_num; i++) {
+        if (pool->fbs[i].ref_cnt == 0) {
+            pool->fbs[i].ref_cnt = 1;
+            *ret_fb = pool->fbs[i].buffer;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&pool->spinlock);
+    return ret;
+}
+
+FB_POOL_ISR_ATTR esp_err_t esp_cam_fb_pool_ref(esp_cam_fb_pool_handle_t pool, void *fb)
+{
+    ESP_RETURN_ON_FALSE_ISR(pool, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    esp_cam_fb_t *entry = esp_cam_fb_pool_find(pool, fb);
+    ESP_RETURN_ON_FALSE_ISR(entry, ESP_ERR_INVALID_ARG, TAG, "frame buffer not from this pool");
+    esp_err_t ret = ESP_OK;
+
+    portENTER_CRITICAL_SAFE(&pool->spinlock);
+    if (entry->ref_cnt) {
+        entry->ref_cnt++;
+    } else {
+        ret = ESP_ERR_INVALID_STATE;
+    }
+    portEXIT_CRITICAL_SAFE(&pool->spinlock);
+    return ret;
+}
+
+FB_POOL_ISR_ATTR esp_err_t esp_cam_fb_pool_unref(esp_cam_fb_pool_handle_t pool, void *fb)
+{
+    ESP_RETURN_ON_FALSE_ISR(pool, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    esp_cam_fb_t *entry = esp_cam_fb_pool_find(pool, fb);
+    ESP_RETURN_ON_FALSE_ISR(entry, ESP_ERR_INVALID_ARG, TAG, "frame buffer not from this pool");
+    esp_err_t ret = ESP_OK;
+    bool write_back = false;
+
+    portENTER_CRITICAL_SAFE(&pool->spinlock);
+    if (entry->ref_cnt == 0) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else if (entry->ref_cnt == 1 && entry->dirty) {
+        // Keep the last reference while the cache is written back, the frame buffer is freed below
+        write_back = true;
+    } else {
+        entry->ref_cnt--;
+    }
+    portEXIT_CRITICAL_SAFE(&pool->spinlock);
+
+    if (write_back) {
+        if (pool->cache_sync) {
+            esp_cache_msync(entry->buffer, pool->fb_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+        }
+        portENTER_CRITICAL_SAFE(&pool->spinlock);
+        entry->dirty = false;
+        entry->ref_cnt = 0;
+        portEXIT_CRITICAL_SAFE(&pool->spinlock);
+    }
+    return ret;
+}
+
+FB_POOL_ISR_ATTR esp_err_t esp_cam_fb_pool_set_dirty(esp_cam_fb_pool_handle_t pool, void *fb)
+{
+    ESP_RETURN_ON_FALSE_ISR(pool, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    esp_cam_fb_t *entry = esp_cam_fb_pool_find(pool, fb);
+    ESP_RETURN_ON_FALSE_ISR(entry, ESP_ERR_INVALID_ARG, TAG, "frame buffer not from this pool");
+    esp_err_t ret = ESP_OK;
+
+    portENTER_CRITICAL_SAFE(&pool->spinlock);
+    if (entry->ref_cnt) {
+        entry->dirty = true;
+    } else {
+        ret = ESP_ERR_INVALID_STATE;
+    }
+    portEXIT_CRITICAL_SAFE(&pool->spinlock);
+    return ret;
+}
+
+esp_err_t esp_cam_fb_pool_get_fb_size(esp_cam_fb_pool_handle_t pool, size_t *ret_fb_size)
+{
+    ESP_RETURN_ON_FALSE(pool && ret_fb_size, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    *ret_fb_size = pool->fb_size;
+    return ESP_OK;
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief ESP CAM frame buffer pool handle
+ */
+typedef struct esp_cam_fb_pool_t *esp_cam_fb_pool_handle_t;
+
+/**
+ * @brief ESP CAM frame buffer pool configuration
+ */
+typedef struct {
+    size_t fb_size;                 ///< Size of each frame buffer, in bytes. Rounded up to the cache line size
+    size_t fb_num;                  ///< Number of frame buffers
+    struct {
+        uint32_t internal_mem: 1;   ///< Allocate the frame buffers from internal memory instead of PSRAM
+    } flags;                        ///< Pool config flags
+} esp_cam_fb_pool_config_t;
+
+/**
+ * @brief Create a pool of frame buffers
+ *
+ * The frame buffers are aligned to the cache line size and to the DMA requirements, so they can be passed
+ * directly to the camera controller, ISP, JPEG, PPA and LCD drivers, without copying the frames.
+ *
+ * @param[in]  config    Pool configuration
+ * @param[out] ret_pool  Returned pool handle
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG: Invalid argument
+ *        - ESP_ERR_NO_MEM:      Out of memory
+ */
+esp_err_t esp_cam_new_fb_pool(const esp_cam_fb_pool_config_t *config, esp_cam_fb_pool_handle_t *ret_pool);
+
+/**
+ * @brief Delete a pool of frame buffers
+ *
+ * @param[in] pool  Pool handle
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument
+ *        - ESP_ERR_INVALID_STATE: Some frame buffers are still referenced
+ */
+esp_err_t esp_cam_del_fb_pool(esp_cam_fb_pool_handle_t pool);
+
+/**
+ * @brief Take a free frame buffer from the pool, with a reference count of 1
+ *
+ * @note This function can be called from the `on_get_new_trans` callback of the camera controller
+ *
+ * @param[in]  pool    Pool handle
+ * @param[out] ret_fb  Returned frame buffer
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG: Invalid argument
+ *        - ESP_ERR_NOT_FOUND:   No free frame buffer
+ */
+esp_err_t esp_cam_fb_pool_alloc(esp_cam_fb_pool_handle_t pool, void **ret_fb);
+
+/**
+ * @brief Add a reference to a frame buffer, e.g. before handing it to an additional consumer
+ *
+ * @note This function can be called from ISR context
+ *
+ * @param[in] pool  Pool handle
+ * @param[in] fb    Frame buffer taken from this pool
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument, or the frame buffer is not from this pool
+ *        - ESP_ERR_INVALID_STATE: The frame buffer is free
+ */
+esp_err_t esp_cam_fb_pool_ref(esp_cam_fb_pool_handle_t pool, void *fb);
+
+/**
+ * @brief Drop a reference to a frame buffer, once a consumer is done with it
+ *
+ * The frame buffer returns to the pool when its last reference is dropped.
+ *
+ * @note This function can be called from ISR context, e.g. from the done callback of a consumer driver
+ *
+ * @param[in] pool  Pool handle
+ * @param[in] fb    Frame buffer taken from this pool
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument, or the frame buffer is not from this pool
+ *        - ESP_ERR_INVALID_STATE: The frame buffer is free
+ */
+esp_err_t esp_cam_fb_pool_unref(esp_cam_fb_pool_handle_t pool, void *fb);
+
+/**
+ * @brief Mark a frame buffer as written by the CPU
+ *
+ * Call this function when the CPU wrote into a frame buffer, e.g. to draw an overlay. The cache of the frame buffer
+ * is written back before the buffer returns to the pool, so that the dirty cache lines can't overwrite the next frame
+ * written into it by a DMA. Frames written by a DMA, e.g. by the camera controller, don't need it.
+ *
+ * @note This function can be called from ISR context
+ *
+ * @param[in] pool  Pool handle
+ * @param[in] fb    Frame buffer taken from this pool
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument, or the frame buffer is not from this pool
+ *        - ESP_ERR_INVALID_STATE: The frame buffer is free
+ */
+esp_err_t esp_cam_fb_pool_set_dirty(esp_cam_fb_pool_handle_t pool, void *fb);
+
+/**
+ * @brief Get the size of the frame buffers of a pool
+ *
+ * @param[in]  pool         Pool handle
+ * @param[out] ret_fb_size  Size of each frame buffer, in bytes
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_cam_fb_pool_get_fb_size(esp_cam_fb_pool_handle_t pool, size_t *ret_fb_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,6 +8,7 @@
 #include "unity.h"
 #include "esp_cam_ctlr_csi.h"
 #include "esp_cam_ctlr.h"
+#include "esp_cam_fb_pool.h"
 
 TEST_CASE("TEST CSI driver allocation", "[csi]")
 {
@@ -61,3 +62,43 @@ TEST_CASE("TEST CSI driver no backup buffer usage", "[csi]")
     TEST_ASSERT_EQUAL(0, bk_buffer_len);
     TEST_ESP_OK(esp_cam_ctlr_del(handle));
 }
+
+TEST_CASE("TEST CAM frame buffer pool reference count", "[csi]")
+{
+    esp_cam_fb_pool_config_t pool_config = {
+        .fb_size = 1000,
+        .fb_num = 2,
+    };
+    esp_cam_fb_pool_handle_t pool = NULL;
+    TEST_ESP_OK(esp_cam_new_fb_pool(&pool_config, &pool));
+
+    size_t fb_size = 0;
+    TEST_ESP_OK(esp_cam_fb_pool_get_fb_size(pool, &fb_size));
+    TEST_ASSERT_GREATER_OR_EQUAL(pool_config.fb_size, fb_size);
+
+    void *fb0 = NULL;
+    void *fb1 = NULL;
+    void *fb2 = NULL;
+    TEST_ESP_OK(esp_cam_fb_pool_alloc(pool, &fb0));
+    TEST_ESP_OK(esp_cam_fb_pool_alloc(pool, &fb1));
+    TEST_ASSERT_NOT_EQUAL(fb0, fb1);
+    TEST_ESP_ERR(ESP_ERR_NOT_FOUND, esp_cam_fb_pool_alloc(pool, &fb2));
+
+    // Two consumers hold fb0, it is only free once both of them released it
+    TEST_ESP_OK(esp_cam_fb_pool_ref(pool, fb0));
+    TEST_ESP_OK(esp_cam_fb_pool_set_dirty(pool, fb0));
+    TEST_ESP_OK(esp_cam_fb_pool_unref(pool, fb0));
+    TEST_ESP_ERR(ESP_ERR_NOT_FOUND, esp_cam_fb_pool_alloc(pool, &fb2));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_cam_del_fb_pool(pool));
+    TEST_ESP_OK(esp_cam_fb_pool_unref(pool, fb0));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_cam_fb_pool_unref(pool, fb0));
+    TEST_ESP_OK(esp_cam_fb_pool_alloc(pool, &fb2));
+    TEST_ASSERT_EQUAL(fb0, fb2);
+
+    uint8_t not_from_pool[4];
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_cam_fb_pool_ref(pool, not_from_pool));
+
+    TEST_ESP_OK(esp_cam_fb_pool_unref(pool, fb1));
+    TEST_ESP_OK(esp_cam_fb_pool_unref(pool, fb2));
+    TEST_ESP_OK(esp_cam_del_fb_pool(pool));
+}
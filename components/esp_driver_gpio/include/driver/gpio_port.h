@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_attr.h"
+#include "soc/soc_caps.h"
+#include "soc/gpio_struct.h"
+#include "hal/gpio_ll.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The port functions access up to 32 GPIOs at once, with a single register access and without any argument check.
+ * Port N holds GPIO 32 * N to GPIO 32 * N + 31. The GPIOs must have been configured with gpio_config() first.
+ */
+
+/**
+ * @brief Number of GPIO ports
+ */
+#define GPIO_PORT_NUM               ((SOC_GPIO_PIN_COUNT + 31) / 32)
+
+/**
+ * @brief Port of a GPIO
+ */
+#define GPIO_PORT_OF(gpio_num)      ((uint32_t)(gpio_num) / 32)
+
+/**
+ * @brief Bit of a GPIO in the masks of its port. The bits of several GPIOs of a same port can be ORed.
+ */
+#define GPIO_PORT_BIT(gpio_num)     (1UL << ((uint32_t)(gpio_num) % 32))
+
+/**
+ * @brief Drive the GPIOs of a port selected by a mask high
+ *
+ * @param port Port number, less than GPIO_PORT_NUM
+ * @param mask Mask of the GPIOs to drive high, the other GPIOs of the port are not changed
+ */
+FORCE_INLINE_ATTR void gpio_port_set(uint32_t port, uint32_t mask)
+{
+    gpio_ll_port_set_mask(&GPIO, port, mask);
+}
+
+/**
+ * @brief Drive the GPIOs of a port selected by a mask low
+ *
+ * @param port Port number, less than GPIO_PORT_NUM
+ * @param mask Mask of the GPIOs to drive low, the other GPIOs of the port are not changed
+ */
+FORCE_INLINE_ATTR void gpio_port_clear(uint32_t port, uint32_t mask)
+{
+    gpio_ll_port_clear_mask(&GPIO, port, mask);
+}
+
+/**
+ * @brief Set the levels of the GPIOs of a port selected by a mask
+ *
+ * @note The GPIOs driven high change one register access before the GPIOs driven low.
+ *
+ * @param port  Port number, less than GPIO_PORT_NUM
+ * @param mask  Mask of the GPIOs to change, the other GPIOs of the port are not changed
+ * @param value Levels of the GPIOs, bit N is the level of the GPIO of bit N of mask
+ */
+FORCE_INLINE_ATTR void gpio_port_write(uint32_t port, uint32_t mask, uint32_t value)
+{
+    gpio_ll_port_set_mask(&GPIO, port, value & mask);
+    gpio_ll_port_clear_mask(&GPIO, port, ~value & mask);
+}
+
+/**
+ * @brief Get the input levels of the GPIOs of a port
+ *
+ * @param port Port number, less than GPIO_PORT_NUM
+ *
+ * @return Input levels, bit N is the level of GPIO 32 * port + N. The bits of the GPIOs which are not configured
+ *         for input are 0.
+ */
+FORCE_INLINE_ATTR uint32_t gpio_port_read(uint32_t port)
+{
+    return gpio_ll_port_get_level(&GPIO, port);
+}
+
+#ifdef __cplusplus
+}
+
+/**
+ * @brief Mask of GPIOs in their port, computed at compile time
+ *
+ * The GPIOs must all be in the same port, which is GPIO_PORT_OF(first).
+ */
+template <int first, int... others>
+constexpr uint32_t gpio_port_mask()
+{
+    static_assert(((GPIO_PORT_OF(others) == GPIO_PORT_OF(first)) && ...), "GPIOs must be in the same port");
+    return (GPIO_PORT_BIT(first) | ... | GPIO_PORT_BIT(others));
+}
+#endif
@@ -21,6 +21,7 @@
 #include "unity.h"
 #include "unity_test_utils.h"
 #include "driver/gpio.h"
+#include "driver/gpio_port.h"
 #include "hal/gpio_ll.h"
 #include "soc/gpio_periph.h"
 #include "freertos/FreeRTOS.h"
@@ -535,6 +536,33 @@ TEST_CASE("GPIO_set_output_level_get_input_level_test", "[gpio]")
     TEST_ASSERT_EQUAL_INT_MESSAGE(1, gpio_get_level(TEST_GPIO_EXT_IN_IO), "get level error! the level should be high!");
 }
 
+TEST_CASE("GPIO_port_write_and_read_test", "[gpio]")
+{
+    const uint32_t port = GPIO_PORT_OF(TEST_GPIO_INPUT_OUTPUT_IO1);
+    const uint32_t bit1 = GPIO_PORT_BIT(TEST_GPIO_INPUT_OUTPUT_IO1);
+    const uint32_t bit2 = GPIO_PORT_BIT(TEST_GPIO_INPUT_OUTPUT_IO2);
+    TEST_ASSERT_EQUAL(port, GPIO_PORT_OF(TEST_GPIO_INPUT_OUTPUT_IO2));
+    gpio_config_t io_conf = {
+        .pin_bit_mask = BIT64(TEST_GPIO_INPUT_OUTPUT_IO1) | BIT64(TEST_GPIO_INPUT_OUTPUT_IO2),
+        .mode = GPIO_MODE_INPUT_OUTPUT,
+    };
+    TEST_ESP_OK(gpio_config(&io_conf));
+
+    gpio_port_write(port, bit1 | bit2, bit1);
+    TEST_ASSERT_EQUAL_HEX32(bit1, gpio_port_read(port) & (bit1 | bit2));
+    TEST_ASSERT_EQUAL(1, gpio_get_level(TEST_GPIO_INPUT_OUTPUT_IO1));
+    TEST_ASSERT_EQUAL(0, gpio_get_level(TEST_GPIO_INPUT_OUTPUT_IO2));
+    gpio_port_set(port, bit2);
+    TEST_ASSERT_EQUAL_HEX32(bit1 | bit2, gpio_port_read(port) & (bit1 | bit2));
+    gpio_port_clear(port, bit1);
+    TEST_ASSERT_EQUAL_HEX32(bit2, gpio_port_read(port) & (bit1 | bit2));
+    gpio_port_write(port, bit1 | bit2, 0);
+    TEST_ASSERT_EQUAL_HEX32(0, gpio_port_read(port) & (bit1 | bit2));
+
+    gpio_reset_pin(TEST_GPIO_INPUT_OUTPUT_IO1);
+    gpio_reset_pin(TEST_GPIO_INPUT_OUTPUT_IO2);
+}
+
 // This test routes constant-high/low signal to pins, another way is to directly connect TEST_GPIO_EXT_IN_IO to
 // 3.3v or GND pin
 TEST_CASE("GPIO_get_level_from_fixed_voltage_test", "[gpio]")
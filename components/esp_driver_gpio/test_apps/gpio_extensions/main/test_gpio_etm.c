@@ -205,3 +205,84 @@ TEST_CASE("gpio_etm_self_trigger_multi_action", "[etm]")
     TEST_ESP_OK(esp_etm_del_channel(etm_channel_a));
     TEST_ESP_OK(esp_etm_del_channel(etm_channel_b));
 }
+
+TEST_CASE("gpio_etm_pipeline", "[etm]")
+{
+    // GPIO 0 any edge event ---> GPIO 1 toggle task
+    //                       \--> GPIO 2 set task
+    const uint32_t input_gpio = 0;
+    const uint32_t output_gpio1 = 1;
+    const uint32_t output_gpio2 = 2;
+
+    esp_etm_event_handle_t gpio_event = NULL;
+    gpio_etm_event_config_t gpio_event_config = {
+        .edge = GPIO_ETM_EVENT_EDGE_ANY,
+    };
+    TEST_ESP_OK(gpio_new_etm_event(&gpio_event_config, &gpio_event));
+    TEST_ESP_OK(gpio_etm_event_bind_gpio(gpio_event, input_gpio));
+    esp_etm_task_handle_t gpio_task_tog = NULL;
+    esp_etm_task_handle_t gpio_task_set = NULL;
+    gpio_etm_task_config_t gpio_task_config = {
+        .action = GPIO_ETM_TASK_ACTION_TOG,
+    };
+    TEST_ESP_OK(gpio_new_etm_task(&gpio_task_config, &gpio_task_tog));
+    gpio_task_config.action = GPIO_ETM_TASK_ACTION_SET;
+    TEST_ESP_OK(gpio_new_etm_task(&gpio_task_config, &gpio_task_set));
+    TEST_ESP_OK(gpio_etm_task_add_gpio(gpio_task_tog, output_gpio1));
+    TEST_ESP_OK(gpio_etm_task_add_gpio(gpio_task_set, output_gpio2));
+
+    gpio_config_t task_gpio_config = {
+        .mode = GPIO_MODE_INPUT_OUTPUT,
+        .pin_bit_mask = (1ULL << output_gpio1) | (1ULL << output_gpio2),
+    };
+    TEST_ESP_OK(gpio_config(&task_gpio_config));
+    TEST_ESP_OK(gpio_set_level(output_gpio1, 0));
+    TEST_ESP_OK(gpio_set_level(output_gpio2, 0));
+    gpio_config_t event_gpio_config = {
+        .mode = GPIO_MODE_INPUT_OUTPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pin_bit_mask = 1ULL << input_gpio,
+    };
+    TEST_ESP_OK(gpio_config(&event_gpio_config));
+    TEST_ESP_OK(gpio_set_level(input_gpio, 0));
+
+    esp_etm_pipeline_handle_t pipeline = NULL;
+    esp_etm_pipeline_link_t links[] = {
+        { .event = gpio_event, .task = gpio_task_tog },
+        { .event = gpio_event, .task = gpio_task_set },
+    };
+    esp_etm_pipeline_config_t pipeline_config = {
+        .links = links,
+        .num_links = 2,
+    };
+    // a link must not be given twice, and must have both an event and a task
+    links[1].task = gpio_task_tog;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_etm_new_pipeline(&pipeline_config, &pipeline));
+    links[1].task = NULL;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_etm_new_pipeline(&pipeline_config, &pipeline));
+    links[1].task = gpio_task_set;
+    TEST_ESP_OK(esp_etm_new_pipeline(&pipeline_config, &pipeline));
+    TEST_ESP_OK(esp_etm_pipeline_enable(pipeline));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_etm_del_pipeline(pipeline));
+    TEST_ESP_OK(esp_etm_dump(stdout));
+
+    for (int i = 1; i <= 3; i++) {
+        TEST_ESP_OK(gpio_set_level(input_gpio, i & 0x01));
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    // three edges
+    TEST_ASSERT_EQUAL(1, gpio_get_level(output_gpio1));
+    TEST_ASSERT_EQUAL(1, gpio_get_level(output_gpio2));
+
+    TEST_ESP_OK(esp_etm_pipeline_disable(pipeline));
+    TEST_ESP_OK(gpio_set_level(input_gpio, 0));
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(1, gpio_get_level(output_gpio1));
+    TEST_ESP_OK(esp_etm_del_pipeline(pipeline));
+
+    TEST_ESP_OK(gpio_etm_task_rm_gpio(gpio_task_tog, output_gpio1));
+    TEST_ESP_OK(gpio_etm_task_rm_gpio(gpio_task_set, output_gpio2));
+    TEST_ESP_OK(esp_etm_del_task(gpio_task_tog));
+    TEST_ESP_OK(esp_etm_del_task(gpio_task_set));
+    TEST_ESP_OK(esp_etm_del_event(gpio_event));
+}
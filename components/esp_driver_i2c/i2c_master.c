@@ -116,6 +116,8 @@ static esp_err_t s_i2c_hw_fsm_reset(i2c_master_bus_handle_t i2c_master)
 {
     esp_err_t ret = ESP_OK;
     i2c_hal_context_t *hal = &i2c_master->base->hal;
+    // Program the device timing again on the next transaction
+    i2c_master->timing_valid = false;
 #if !SOC_I2C_SUPPORT_HW_FSM_RST
     i2c_hal_timing_config_t timing_config;
     uint8_t filter_cfg;
@@ -611,15 +613,22 @@ static esp_err_t s_i2c_transaction_start(i2c_master_dev_handle_t i2c_dev, int xf
     i2c_master->rx_cnt = 0;
     i2c_master->read_len_static = 0;
 
-    I2C_CLOCK_SRC_ATOMIC() {
-        i2c_hal_set_bus_timing(hal, i2c_dev->scl_speed_hz, i2c_master->base->clk_src, i2c_master->base->clk_src_freq_hz);
-    }
+    // The timing only has to be programmed when the bus switches to a device with another one
+    if (!i2c_master->timing_valid || i2c_master->timing_scl_speed_hz != i2c_dev->scl_speed_hz ||
+            i2c_master->timing_scl_wait_us != i2c_dev->scl_wait_us) {
+        I2C_CLOCK_SRC_ATOMIC() {
+            i2c_hal_set_bus_timing(hal, i2c_dev->scl_speed_hz, i2c_master->base->clk_src, i2c_master->base->clk_src_freq_hz);
+        }
 
-    // Set the timeout value
-    i2c_hal_master_set_scl_timeout_val(hal, i2c_dev->scl_wait_us, i2c_master->base->clk_src_freq_hz);
+        // Set the timeout value
+        i2c_hal_master_set_scl_timeout_val(hal, i2c_dev->scl_wait_us, i2c_master->base->clk_src_freq_hz);
 
-    i2c_ll_master_set_fractional_divider(hal->dev, 0, 0);
-    i2c_ll_update(hal->dev);
+        i2c_ll_master_set_fractional_divider(hal->dev, 0, 0);
+        i2c_ll_update(hal->dev);
+        i2c_master->timing_scl_speed_hz = i2c_dev->scl_speed_hz;
+        i2c_master->timing_scl_wait_us = i2c_dev->scl_wait_us;
+        i2c_master->timing_valid = true;
+    }
 
     i2c_ll_txfifo_rst(hal->dev);
     i2c_ll_rxfifo_rst(hal->dev);
@@ -901,14 +910,13 @@ static esp_err_t s_i2c_asynchronous_transaction(i2c_master_dev_handle_t i2c_dev,
     return ESP_OK;
 }
 
-static esp_err_t s_i2c_synchronous_transaction(i2c_master_dev_handle_t i2c_dev, i2c_operation_t *i2c_ops, size_t ops_dim, int timeout_ms)
+/**
+ * @brief Run a transaction on the bus, which must be locked by the caller
+ */
+static esp_err_t s_i2c_synchronous_transaction_locked(i2c_master_dev_handle_t i2c_dev, i2c_operation_t *i2c_ops, size_t ops_dim, int timeout_ms)
 {
     esp_err_t ret = ESP_OK;
     i2c_dev->master_bus->trans_done = false;
-    TickType_t ticks_to_wait = (timeout_ms == -1) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
-    if (xSemaphoreTake(i2c_dev->master_bus->bus_lock_mux, ticks_to_wait) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
-    }
     memcpy(i2c_dev->master_bus->i2c_ops, i2c_ops, sizeof(i2c_operation_t) * ops_dim);
     i2c_dev->master_bus->addr_10bits_bus = i2c_dev->addr_10bits;
     i2c_dev->master_bus->i2c_trans = (i2c_transaction_t) {
@@ -922,12 +930,21 @@ static esp_err_t s_i2c_synchronous_transaction(i2c_master_dev_handle_t i2c_dev,
     i2c_dev->master_bus->queue_trans = false;
     i2c_dev->master_bus->ack_check_disable = i2c_dev->ack_check_disable;
     ESP_GOTO_ON_ERROR(s_i2c_transaction_start(i2c_dev, timeout_ms), err, TAG, "I2C transaction failed");
-    xSemaphoreGive(i2c_dev->master_bus->bus_lock_mux);
     return ret;
 
 err:
     // When error occurs, reset hardware fsm in case not influence following transactions.
     s_i2c_hw_fsm_reset(i2c_dev->master_bus);
+    return ret;
+}
+
+static esp_err_t s_i2c_synchronous_transaction(i2c_master_dev_handle_t i2c_dev, i2c_operation_t *i2c_ops, size_t ops_dim, int timeout_ms)
+{
+    TickType_t ticks_to_wait = (timeout_ms == -1) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    if (xSemaphoreTake(i2c_dev->master_bus->bus_lock_mux, ticks_to_wait) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    esp_err_t ret = s_i2c_synchronous_transaction_locked(i2c_dev, i2c_ops, ops_dim, timeout_ms);
     xSemaphoreGive(i2c_dev->master_bus->bus_lock_mux);
     return ret;
 }
@@ -1278,7 +1295,8 @@ esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus_handle, uint16_t address,
     };
 
     // I2C probe does not have i2c device module. So set the clock parameter independently
-    // This will not influence device transaction.
+    // This will not influence device transaction, which programs its own timing again.
+    bus_handle->timing_valid = false;
     I2C_CLOCK_SRC_ATOMIC() {
         i2c_ll_set_source_clk(hal->dev, bus_handle->base->clk_src);
         i2c_hal_set_bus_timing(hal, 100000, bus_handle->base->clk_src, bus_handle->base->clk_src_freq_hz);
@@ -1379,6 +1397,54 @@ esp_err_t i2c_master_execute_defined_operations(i2c_master_dev_handle_t i2c_dev,
     return ESP_OK;
 }
 
+esp_err_t i2c_master_poll_list_execute(i2c_master_poll_entry_t *poll_list, size_t poll_list_num, int xfer_timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(poll_list != NULL && poll_list_num > 0, ESP_ERR_INVALID_ARG, TAG, "invalid poll list");
+    ESP_RETURN_ON_FALSE(poll_list[0].device != NULL, ESP_ERR_INVALID_ARG, TAG, "i2c handle not initialized");
+    i2c_master_bus_handle_t bus_handle = poll_list[0].device->master_bus;
+    ESP_RETURN_ON_FALSE(bus_handle->async_trans == false, ESP_ERR_NOT_SUPPORTED, TAG, "poll list is not supported in asynchronous mode");
+    for (size_t i = 0; i < poll_list_num; i++) {
+        const i2c_master_poll_entry_t *entry = &poll_list[i];
+        ESP_RETURN_ON_FALSE(entry->device != NULL && entry->device->master_bus == bus_handle, ESP_ERR_INVALID_ARG, TAG, "poll list devices must be on the same bus");
+        ESP_RETURN_ON_FALSE(entry->write_size == 0 || entry->write_buffer != NULL, ESP_ERR_INVALID_ARG, TAG, "i2c transmit buffer or size invalid");
+        ESP_RETURN_ON_FALSE(entry->read_size == 0 || entry->read_buffer != NULL, ESP_ERR_INVALID_ARG, TAG, "i2c receive buffer or size invalid");
+        ESP_RETURN_ON_FALSE(entry->write_size > 0 || entry->read_size > 0, ESP_ERR_INVALID_ARG, TAG, "poll list entry is empty");
+    }
+
+    TickType_t ticks_to_wait = (xfer_timeout_ms == -1) ? portMAX_DELAY : pdMS_TO_TICKS(xfer_timeout_ms);
+    if (xSemaphoreTake(bus_handle->bus_lock_mux, ticks_to_wait) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    // Devices typically share the same timing, which is then programmed once for the whole list
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < poll_list_num; i++) {
+        i2c_master_poll_entry_t *entry = &poll_list[i];
+        i2c_master_dev_handle_t i2c_dev = entry->device;
+        i2c_operation_t i2c_ops[6];
+        size_t ops_num = 0;
+        i2c_ops[ops_num++] = (i2c_operation_t) {.hw_cmd = I2C_TRANS_START_COMMAND};
+        if (entry->write_size > 0) {
+            i2c_ops[ops_num++] = (i2c_operation_t) {.hw_cmd = I2C_TRANS_WRITE_COMMAND(i2c_dev->ack_check_disable ? false : true), .data = (uint8_t *)entry->write_buffer, .total_bytes = entry->write_size};
+        }
+        if (entry->read_size > 0) {
+            if (entry->write_size > 0) {
+                i2c_ops[ops_num++] = (i2c_operation_t) {.hw_cmd = I2C_TRANS_START_COMMAND};
+            }
+            i2c_ops[ops_num++] = (i2c_operation_t) {.hw_cmd = I2C_TRANS_READ_COMMAND(I2C_ACK_VAL), .data = entry->read_buffer, .total_bytes = entry->read_size - 1};
+            i2c_ops[ops_num++] = (i2c_operation_t) {.hw_cmd = I2C_TRANS_READ_COMMAND(I2C_NACK_VAL), .data = (entry->read_buffer + entry->read_size - 1), .total_bytes = 1};
+        }
+        i2c_ops[ops_num++] = (i2c_operation_t) {.hw_cmd = I2C_TRANS_STOP_COMMAND};
+
+        // A device which does not answer does not prevent the next ones to be polled
+        entry->status = s_i2c_synchronous_transaction_locked(i2c_dev, i2c_ops, ops_num, xfer_timeout_ms);
+        if (ret == ESP_OK) {
+            ret = entry->status;
+        }
+    }
+    xSemaphoreGive(bus_handle->bus_lock_mux);
+    return ret;
+}
+
 esp_err_t i2c_master_register_event_callbacks(i2c_master_dev_handle_t i2c_dev, const i2c_master_event_callbacks_t *cbs, void *user_data)
 {
     ESP_RETURN_ON_FALSE(i2c_dev != NULL, ESP_ERR_INVALID_ARG, TAG, "i2c handle not initialized");
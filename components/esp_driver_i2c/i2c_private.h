@@ -157,6 +157,9 @@ struct i2c_master_bus_t {
     bool ack_check_disable;                                          // Disable ACK check
     volatile bool trans_done;                                        // transaction command finish
     bool bypass_nack_log;                                             // Bypass the error log. Sometimes the error is expected.
+    bool timing_valid;                                               // The timing below is the one programmed in the hardware.
+    uint32_t timing_scl_speed_hz;                                    // SCL frequency programmed in the hardware
+    uint32_t timing_scl_wait_us;                                     // SCL timeout programmed in the hardware
     SLIST_HEAD(i2c_master_device_list_head, i2c_master_device_list) device_list;      // I2C device (instance) list
     // async trans members
     bool async_break;                                                // break transaction loop flag.
@@ -86,6 +86,18 @@ typedef struct {
     };
 } i2c_operation_job_t;
 
+/**
+ * @brief Entry of the list of transactions executed by `i2c_master_poll_list_execute`
+ */
+typedef struct {
+    i2c_master_dev_handle_t device;    /*!< Device to access */
+    const uint8_t *write_buffer;       /*!< Data to write, e.g. the register address, can be NULL if write_size is 0 */
+    size_t write_size;                 /*!< Number of bytes to write, 0 to only read */
+    uint8_t *read_buffer;              /*!< Buffer for the data read, can be NULL if read_size is 0 */
+    size_t read_size;                  /*!< Number of bytes to read, 0 to only write */
+    esp_err_t status;                  /*!< Result of the transaction, set by `i2c_master_poll_list_execute` */
+} i2c_master_poll_entry_t;
+
 /**
  * @brief I2C master transmit buffer information structure
  */
@@ -276,6 +288,31 @@ esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus_handle, uint16_t address,
  */
 esp_err_t i2c_master_execute_defined_operations(i2c_master_dev_handle_t i2c_dev, i2c_operation_job_t *i2c_operation, size_t operation_list_num, int xfer_timeout_ms);
 
+/**
+ * @brief Poll a list of I2C devices, in one call
+ *
+ * Each entry writes `write_buffer` to its device then reads `read_size` bytes from it (with a repeated start),
+ * or only writes or only reads when the other size is 0. The bus is locked for the whole list, and the bus timing
+ * is only programmed when it differs from the one of the previous device, so polling a set of sensors with this
+ * function costs less CPU time than one `i2c_master_transmit_receive` per sensor.
+ *
+ * All the entries are executed, even if some of them fail, e.g. a sensor which does not acknowledge its address.
+ * The result of each entry is stored in its `status` member.
+ *
+ * @note This function is only available in synchronous mode, i.e. when no callback is registered on the bus.
+ *
+ * @param[inout] poll_list       Entries to execute, in order. The devices must be on the same bus.
+ * @param[in]    poll_list_num   Number of entries
+ * @param[in]    xfer_timeout_ms Wait timeout of each entry, in ms. Note: -1 means wait forever.
+ * @return
+ *      - ESP_OK: All the entries succeeded
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: The bus is in asynchronous mode
+ *      - ESP_ERR_TIMEOUT: The bus could not be locked in time
+ *      - Otherwise: Error of the first entry which failed
+ */
+esp_err_t i2c_master_poll_list_execute(i2c_master_poll_entry_t *poll_list, size_t poll_list_num, int xfer_timeout_ms);
+
 /**
  * @brief Register I2C transaction callbacks for a master device
  *
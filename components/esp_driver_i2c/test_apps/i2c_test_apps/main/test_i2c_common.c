@@ -382,6 +382,29 @@ TEST_CASE("I2C master transaction receive check nack return value", "[i2c]")
     _test_i2c_del_bus_device(bus_handle, dev_handle);
 }
 
+TEST_CASE("I2C master poll list check nack return value", "[i2c]")
+{
+    uint8_t data_wr[DATA_LENGTH] = { 0 };
+    uint8_t data_rd[DATA_LENGTH] = { 0 };
+
+    i2c_master_bus_handle_t bus_handle;
+    i2c_master_dev_handle_t dev_handle;
+    _test_i2c_new_bus_device(&bus_handle, &dev_handle);
+
+    i2c_master_poll_entry_t poll_list[] = {
+        { .device = dev_handle, .write_buffer = data_wr, .write_size = DATA_LENGTH, .read_buffer = data_rd, .read_size = DATA_LENGTH },
+        { .device = dev_handle, .read_buffer = data_rd, .read_size = DATA_LENGTH },
+        { .device = dev_handle, .write_buffer = data_wr, .write_size = DATA_LENGTH },
+    };
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, i2c_master_poll_list_execute(poll_list, 0, -1));
+    // Every entry is executed, even after the first one failed
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, i2c_master_poll_list_execute(poll_list, sizeof(poll_list) / sizeof(poll_list[0]), -1));
+    for (int i = 0; i < sizeof(poll_list) / sizeof(poll_list[0]); i++) {
+        TEST_ESP_ERR(ESP_ERR_INVALID_STATE, poll_list[i].status);
+    }
+    _test_i2c_del_bus_device(bus_handle, dev_handle);
+}
+
 TEST_CASE("Test get handle with known port", "[i2c]")
 {
     i2c_master_bus_handle_t handle;
@@ -134,7 +134,8 @@ static void i2s_tx_channel_start(i2s_chan_handle_t handle)
     i2s_hal_tx_enable_dma(&(handle->controller->hal));
     i2s_hal_tx_start_link(&(handle->controller->hal), (uint32_t) handle->dma.desc[0]);
 #endif
-    if (!handle->is_etm_start) {
+    /* For the ETM start or the full-duplex pair start, only the DMA link is started here */
+    if (!handle->is_etm_start && !handle->is_pair_start) {
         i2s_hal_tx_start(&(handle->controller->hal));
     }
 }
@@ -156,7 +157,8 @@ static void i2s_rx_channel_start(i2s_chan_handle_t handle)
     i2s_hal_rx_enable_dma(&(handle->controller->hal));
     i2s_hal_rx_start_link(&(handle->controller->hal), (uint32_t) handle->dma.desc[0]);
 #endif
-    if (!handle->is_etm_start) {
+    /* For the ETM start or the full-duplex pair start, only the DMA link is started here */
+    if (!handle->is_etm_start && !handle->is_pair_start) {
         i2s_hal_rx_start(&(handle->controller->hal));
     }
 }
@@ -1231,6 +1233,62 @@ err:
     return ret;
 }
 
+esp_err_t i2s_channel_enable_pair(i2s_chan_handle_t handle)
+{
+    I2S_NULL_POINTER_CHECK(TAG, handle);
+    i2s_controller_t *i2s_obj = handle->controller;
+    ESP_RETURN_ON_FALSE(i2s_obj->full_duplex, ESP_ERR_INVALID_ARG, TAG, "the channel is not a full-duplex one");
+    i2s_chan_handle_t tx_handle = i2s_obj->tx_chan;
+    i2s_chan_handle_t rx_handle = i2s_obj->rx_chan;
+    ESP_RETURN_ON_FALSE(tx_handle && rx_handle, ESP_ERR_INVALID_STATE, TAG, "the pair channel has not been allocated");
+
+    esp_err_t ret = ESP_OK;
+
+    /* Always take the TX mutex first to avoid dead lock */
+    xSemaphoreTake(tx_handle->mutex, portMAX_DELAY);
+    xSemaphoreTake(rx_handle->mutex, portMAX_DELAY);
+    ESP_GOTO_ON_FALSE(tx_handle->state == I2S_CHAN_STATE_READY && rx_handle->state == I2S_CHAN_STATE_READY,
+                      ESP_ERR_INVALID_STATE, err, TAG, "the channels have already enabled or not initialized");
+#if CONFIG_PM_ENABLE
+    esp_pm_lock_acquire(tx_handle->pm_lock);
+    esp_pm_lock_acquire(rx_handle->pm_lock);
+#endif
+    /* Reset and start the DMA links of both directions first, the peripheral is not started yet */
+    tx_handle->is_pair_start = true;
+    rx_handle->is_pair_start = true;
+    tx_handle->start(tx_handle);
+    rx_handle->start(rx_handle);
+    tx_handle->is_pair_start = false;
+    rx_handle->is_pair_start = false;
+    /* Then start TX and RX back-to-back, so that the n-th TX DMA buffer and the n-th RX DMA buffer cover the same frames */
+    portENTER_CRITICAL(&g_i2s.spinlock);
+    if (!tx_handle->is_etm_start) {
+        i2s_hal_tx_start(&(i2s_obj->hal));
+    }
+    if (!rx_handle->is_etm_start) {
+        i2s_hal_rx_start(&(i2s_obj->hal));
+    }
+    portEXIT_CRITICAL(&g_i2s.spinlock);
+    tx_handle->state = I2S_CHAN_STATE_RUNNING;
+    rx_handle->state = I2S_CHAN_STATE_RUNNING;
+    /* Reset queue */
+    xQueueReset(tx_handle->msg_queue);
+    xQueueReset(rx_handle->msg_queue);
+    xSemaphoreGive(rx_handle->mutex);
+    xSemaphoreGive(tx_handle->mutex);
+    /* Give the binary semaphore to enable reading / writing task */
+    xSemaphoreGive(tx_handle->binary);
+    xSemaphoreGive(rx_handle->binary);
+
+    ESP_LOGD(TAG, "i2s full-duplex channels enabled");
+    return ret;
+
+err:
+    xSemaphoreGive(rx_handle->mutex);
+    xSemaphoreGive(tx_handle->mutex);
+    return ret;
+}
+
 esp_err_t i2s_channel_preload_data(i2s_chan_handle_t tx_handle, const void *src, size_t size, size_t *bytes_loaded)
 {
     I2S_NULL_POINTER_CHECK(TAG, tx_handle);
@@ -1376,6 +1434,50 @@ esp_err_t i2s_channel_read(i2s_chan_handle_t handle, void *dest, size_t size, si
     return ret;
 }
 
+esp_err_t i2s_channel_acquire_dma_buf(i2s_chan_handle_t handle, void **dma_buf, size_t *size, uint32_t timeout_ms)
+{
+    I2S_NULL_POINTER_CHECK(TAG, handle);
+    ESP_RETURN_ON_FALSE(dma_buf, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_err_t ret = ESP_OK;
+    *dma_buf = NULL;
+    /* The binary semaphore is kept until the buffer is released, so that no reading / writing operation can interleave */
+    ESP_RETURN_ON_FALSE(xSemaphoreTake(handle->binary, pdMS_TO_TICKS(timeout_ms)) == pdTRUE, ESP_ERR_INVALID_STATE, TAG, "The channel is not enabled");
+    ESP_GOTO_ON_FALSE(handle->state == I2S_CHAN_STATE_RUNNING, ESP_ERR_INVALID_STATE, err, TAG, "The channel is not enabled");
+    /* For RX, the buffer is the one just filled. For TX, it is the one just sent, which will be sent again after the other buffers */
+    if (xQueueReceive(handle->msg_queue, dma_buf, pdMS_TO_TICKS(timeout_ms)) == pdFALSE) {
+        ret = ESP_ERR_TIMEOUT;
+        goto err;
+    }
+    /* The partially read / written buffer of the copying APIs is dropped */
+    handle->dma.curr_ptr = NULL;
+    handle->dma.rw_pos = 0;
+    if (size) {
+        *size = handle->dma.buf_size;
+    }
+    return ESP_OK;
+
+err:
+    xSemaphoreGive(handle->binary);
+    return ret;
+}
+
+esp_err_t i2s_channel_release_dma_buf(i2s_chan_handle_t handle, void *dma_buf)
+{
+    I2S_NULL_POINTER_CHECK(TAG, handle);
+    ESP_RETURN_ON_FALSE(dma_buf, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+    /* Write back the data processed in place */
+    if (handle->dir == I2S_DIR_TX) {
+        esp_cache_msync(dma_buf, handle->dma.buf_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+    }
+#endif
+    xSemaphoreGive(handle->binary);
+
+    return ESP_OK;
+}
+
 esp_err_t i2s_channel_tune_rate(i2s_chan_handle_t handle, const i2s_tuning_config_t *tune_cfg, i2s_tuning_info_t *tune_info)
 {
     /** We tune the sample rate via the MCLK clock.
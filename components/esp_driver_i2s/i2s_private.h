@@ -162,6 +162,7 @@ struct i2s_channel_obj_t {
     struct {
         bool                is_etm_start: 1;   /*!< Whether start by etm tasks */
         bool                is_etm_stop: 1;    /*!< Whether stop by etm tasks */
+        bool                is_pair_start: 1;  /*!< Whether started together with its full-duplex pair by `i2s_channel_enable_pair` */
         bool                is_raw_pdm: 1;     /*!< Flag of whether send/receive PDM in raw data, i.e., no PCM2PDM/PDM2PCM filter enabled */
         bool                is_external: 1;    /*!< Whether use external clock */
 #if SOC_I2S_SUPPORTS_APLL
@@ -252,6 +252,57 @@ esp_err_t i2s_channel_register_event_callback(i2s_chan_handle_t handle, const i2
  */
 esp_err_t i2s_channel_preload_data(i2s_chan_handle_t tx_handle, const void *src, size_t size, size_t *bytes_loaded);
 
+/**
+ * @brief Enable the TX and RX channels of a full-duplex pair together
+ * @note  Only allowed to be called when both channels are in READY state,
+ *        both channels will enter RUNNING state once they are enabled successfully.
+ * @note  The TX and RX are started back-to-back, so the n-th TX DMA buffer and the n-th RX DMA buffer cover the same frames
+ *        on the line, which keeps the played and the captured samples aligned (e.g., for acoustic echo cancellation).
+ *        Disable the channels by `i2s_channel_disable` as usual.
+ *
+ * @param[in]   handle      I2S TX or RX channel handler of the full-duplex pair
+ * @return
+ *      - ESP_OK    Start successfully
+ *      - ESP_ERR_INVALID_ARG   NULL pointer or the channel is not a full-duplex one
+ *      - ESP_ERR_INVALID_STATE The pair channel is not allocated, or the channels have not initialized or already started
+ */
+esp_err_t i2s_channel_enable_pair(i2s_chan_handle_t handle);
+
+/**
+ * @brief Acquire the next DMA buffer to be processed in place, instead of copying the data by `i2s_channel_read` / `i2s_channel_write`
+ * @note  Only allowed to be called when the channel state is RUNNING.
+ *        For the RX channel, the acquired buffer is the latest received one.
+ *        For the TX channel, the acquired buffer is the latest sent one, the data written into it will be sent after the other DMA buffers.
+ * @note  The DMA keeps going while the buffer is acquired, the buffer should be released by `i2s_channel_release_dma_buf`
+ *        within (`dma_desc_num` - 1) DMA buffer periods, otherwise it will be overwritten (RX) or sent (TX) by the DMA.
+ * @note  The reading / writing operations on this channel are blocked until the buffer is released,
+ *        and the partially read / written DMA buffer of these operations is dropped.
+ *
+ * @param[in]   handle      I2S channel handler
+ * @param[out]  dma_buf     The pointer of the acquired DMA buffer
+ * @param[out]  size        The size of the DMA buffer in bytes, can be NULL if not needed
+ * @param[in]   timeout_ms  Max block time
+ * @return
+ *      - ESP_OK    Acquire successfully
+ *      - ESP_ERR_INVALID_ARG   NULL pointer
+ *      - ESP_ERR_TIMEOUT       No DMA buffer finished within timeout_ms
+ *      - ESP_ERR_INVALID_STATE The channel is not enabled or another buffer has not been released yet
+ */
+esp_err_t i2s_channel_acquire_dma_buf(i2s_chan_handle_t handle, void **dma_buf, size_t *size, uint32_t timeout_ms);
+
+/**
+ * @brief Release the DMA buffer acquired by `i2s_channel_acquire_dma_buf`
+ * @note  For the TX channel, the cache of the buffer is written back to the memory if necessary.
+ * @note  `i2s_channel_disable` waits until the acquired buffer is released.
+ *
+ * @param[in]   handle      I2S channel handler
+ * @param[in]   dma_buf     The DMA buffer acquired by `i2s_channel_acquire_dma_buf`
+ * @return
+ *      - ESP_OK    Release successfully
+ *      - ESP_ERR_INVALID_ARG   NULL pointer
+ */
+esp_err_t i2s_channel_release_dma_buf(i2s_chan_handle_t handle, void *dma_buf);
+
 /**
  * @brief Tune the I2S clock rate
  * @note  Only allowed to be called when the channel state is READY, (i.e., channel has been initialized, but not started)
@@ -987,6 +987,66 @@ TEST_CASE("I2S_asynchronous_read_write", "[i2s]")
     TEST_ASSERT(received);
 }
 
+TEST_CASE("I2S_zero_copy_full_duplex_test", "[i2s]")
+{
+    i2s_chan_handle_t tx_handle;
+    i2s_chan_handle_t rx_handle;
+
+    i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_0, I2S_ROLE_MASTER);
+    i2s_std_config_t std_cfg = {
+        .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(SAMPLE_RATE),
+        .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(SAMPLE_BITS, I2S_SLOT_MODE_STEREO),
+        .gpio_cfg = I2S_TEST_MASTER_DEFAULT_PIN,
+    };
+    std_cfg.gpio_cfg.din = std_cfg.gpio_cfg.dout;  // GPIO loopback
+
+    TEST_ESP_OK(i2s_new_channel(&chan_cfg, &tx_handle, &rx_handle));
+    TEST_ESP_OK(i2s_channel_init_std_mode(tx_handle, &std_cfg));
+    TEST_ESP_OK(i2s_channel_init_std_mode(rx_handle, &std_cfg));
+
+    void *buf = NULL;
+    size_t size = 0;
+    /* Not allowed before the channel is enabled */
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, i2s_channel_acquire_dma_buf(rx_handle, &buf, &size, 10));
+    TEST_ESP_OK(i2s_channel_enable_pair(tx_handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, i2s_channel_enable(rx_handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, i2s_channel_enable_pair(rx_handle));
+
+    bool received = false;
+    for (int n = 0; n < 100 && !received; n++) {
+        /* Fill the sent TX buffer in place, it will be sent again after the other buffers */
+        TEST_ESP_OK(i2s_channel_acquire_dma_buf(tx_handle, &buf, &size, 1000));
+        uint32_t *dma_buf = (uint32_t *)buf;
+        size_t len = size / sizeof(uint32_t);
+        for (int i = 0; i < len; i++) {
+            dma_buf[i] = i + TEST_I2S_BUF_DATA_OFFSET;
+        }
+        TEST_ESP_OK(i2s_channel_release_dma_buf(tx_handle, buf));
+
+        /* Check the received RX buffer in place */
+        TEST_ESP_OK(i2s_channel_acquire_dma_buf(rx_handle, &buf, &size, 1000));
+        dma_buf = (uint32_t *)buf;
+        len = size / sizeof(uint32_t);
+        for (int i = 0; i < len; i++) {
+            if (dma_buf[i] == TEST_I2S_BUF_DATA_OFFSET) {
+                for (int j = 0; i < len && dma_buf[i] == (j + TEST_I2S_BUF_DATA_OFFSET); i++, j++);
+                if (i == len) {
+                    received = true;
+                    break;
+                }
+            }
+        }
+        TEST_ESP_OK(i2s_channel_release_dma_buf(rx_handle, buf));
+    }
+
+    TEST_ESP_OK(i2s_channel_disable(tx_handle));
+    TEST_ESP_OK(i2s_channel_disable(rx_handle));
+    TEST_ESP_OK(i2s_del_channel(tx_handle));
+    TEST_ESP_OK(i2s_del_channel(rx_handle));
+
+    TEST_ASSERT(received);
+}
+
 #if SOC_I2S_SUPPORTS_PDM2PCM
 TEST_CASE("I2S_PDM2PCM_existence_test", "[i2s]")
 {
@@ -102,6 +102,33 @@ typedef struct {
  */
 typedef bool (*esp_isp_sharpen_callback_t)(isp_proc_handle_t proc, const esp_isp_sharpen_evt_data_t *edata, void *user_data);
 
+/**
+ * @brief Statistics of a frame, merged from all the statistics controllers in continuous mode
+ */
+typedef struct {
+    struct {
+        uint32_t af_valid:   1;     ///< `af_result` is valid, the AF controller is in continuous mode
+        uint32_t ae_valid:   1;     ///< `ae_result` is valid, the AE controller is in continuous mode
+        uint32_t awb_valid:  1;     ///< `awb_result` is valid, the AWB controller is in continuous mode
+        uint32_t hist_valid: 1;     ///< `hist_result` is valid, the histogram controller is in continuous mode
+    } flags;                        ///< Statistics present in this event
+    isp_af_result_t af_result;      ///< AF statistics result of the first AF controller
+    isp_ae_result_t ae_result;      ///< AE statistics result
+    isp_awb_stat_result_t awb_result;   ///< AWB statistics result
+    isp_hist_result_t hist_result;  ///< Histogram statistics result
+} esp_isp_stats_evt_data_t;
+
+/**
+ * @brief Prototype of ISP statistics event callback
+ *
+ * @param[in] proc      Processor handle
+ * @param[in] edata     ISP statistics event data
+ * @param[in] user_data User registered context, registered when in `esp_isp_register_event_callbacks()`
+ *
+ * @return Whether a high priority task is woken up by this function
+ */
+typedef bool (*esp_isp_stats_callback_t)(isp_proc_handle_t proc, const esp_isp_stats_evt_data_t *edata, void *user_data);
+
 /**
  * @brief Group of ISP event callbacks
  *
@@ -111,6 +138,8 @@ typedef bool (*esp_isp_sharpen_callback_t)(isp_proc_handle_t proc, const esp_isp
  */
 typedef struct {
     esp_isp_sharpen_callback_t on_sharpen_frame_done;       ///< Event callback, invoked when sharpen frame done
+    esp_isp_stats_callback_t on_stats_done;                 ///< Event callback, invoked once per frame when all the statistics controllers
+                                                            ///< in continuous mode have their results, with all these results
 } esp_isp_evt_cbs_t;
 
 #ifdef __cplusplus
@@ -91,6 +91,11 @@ typedef struct isp_processor_t {
         uint32_t                hist_isr_added:  1;
     } isr_users;
 
+    /* Per frame statistics */
+    uint32_t                    stats_continuous_mask;  // BIT(isp_submodule_t) of the statistics controllers in continuous mode
+    uint32_t                    stats_ready_mask;       // BIT(isp_submodule_t) of the results already in stats_edata
+    esp_isp_stats_evt_data_t    stats_edata;            // Statistics of the current frame, only accessed in the ISR
+
 } isp_processor_t;
 #endif
 
@@ -113,6 +118,11 @@ bool esp_isp_awb_isr(isp_proc_handle_t proc, uint32_t awb_events);
 bool esp_isp_sharpen_isr(isp_proc_handle_t proc, uint32_t sharp_events);
 bool esp_isp_hist_isr(isp_proc_handle_t proc, uint32_t hist_events);
 
+/*---------------------------------------------------------------
+                      Per frame statistics
+---------------------------------------------------------------*/
+void esp_isp_stats_set_continuous(isp_proc_handle_t proc, isp_submodule_t submodule, bool en);
+
 #ifdef __cplusplus
 }
 #endif
@@ -197,6 +197,7 @@ esp_err_t esp_isp_ae_controller_start_continuous_statistics(isp_ae_ctlr_t ae_ctl
 
     isp_fsm_t expected_fsm = ISP_FSM_ENABLE;
     ESP_RETURN_ON_FALSE_ISR(atomic_compare_exchange_strong(&ae_ctlr->fsm, &expected_fsm, ISP_FSM_CONTINUOUS), ESP_ERR_INVALID_STATE, TAG, "controller is not enabled yet");
+    esp_isp_stats_set_continuous(ae_ctlr->isp_proc, ISP_SUBMODULE_AE, true);
     isp_ll_ae_manual_update(ae_ctlr->isp_proc->hal.hw);
 
     return ESP_OK;
@@ -209,6 +210,7 @@ esp_err_t esp_isp_ae_controller_stop_continuous_statistics(isp_ae_ctlr_t ae_ctlr
     isp_fsm_t expected_fsm = ISP_FSM_CONTINUOUS;
     ESP_RETURN_ON_FALSE_ISR(atomic_compare_exchange_strong(&ae_ctlr->fsm, &expected_fsm, ISP_FSM_ENABLE),
                             ESP_ERR_INVALID_STATE, TAG, "controller is not running");
+    esp_isp_stats_set_continuous(ae_ctlr->isp_proc, ISP_SUBMODULE_AE, false);
     return ESP_OK;
 }
 
@@ -302,6 +304,10 @@ bool IRAM_ATTR esp_isp_ae_isr(isp_proc_handle_t proc, uint32_t ae_events)
      * Should decide a detector instance according to the hw event.
      */
     if (ae_events & ISP_LL_EVENT_AE_FDONE) {
+        if (proc->cbs.on_stats_done) {
+            proc->stats_edata.ae_result = edata.ae_result;
+            proc->stats_ready_mask |= BIT(ISP_SUBMODULE_AE);
+        }
         if (ae_ctlr->cbs.on_env_statistics_done) {
             need_yield |= ae_ctlr->cbs.on_env_statistics_done(ae_ctlr, &edata, ae_ctlr->user_data);
         }
@@ -216,6 +216,9 @@ esp_err_t esp_isp_af_controller_start_continuous_statistics(isp_af_ctlr_t af_ctl
     ESP_RETURN_ON_FALSE_ISR(af_ctlr, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
     isp_fsm_t expected_fsm = ISP_FSM_ENABLE;
     ESP_RETURN_ON_FALSE_ISR(atomic_compare_exchange_strong(&af_ctlr->fsm, &expected_fsm, ISP_FSM_CONTINUOUS), ESP_ERR_INVALID_STATE, TAG, "controller is not enabled yet");
+    if (af_ctlr == af_ctlr->isp_proc->af_ctlr[0]) {
+        esp_isp_stats_set_continuous(af_ctlr->isp_proc, ISP_SUBMODULE_AF, true);
+    }
     isp_ll_af_enable_auto_update(af_ctlr->isp_proc->hal.hw, true);
 
     return ESP_OK;
@@ -226,6 +229,9 @@ esp_err_t esp_isp_af_controller_stop_continuous_statistics(isp_af_ctlr_t af_ctlr
     ESP_RETURN_ON_FALSE_ISR(af_ctlr, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
     isp_fsm_t expected_fsm = ISP_FSM_CONTINUOUS;
     ESP_RETURN_ON_FALSE_ISR(atomic_compare_exchange_strong(&af_ctlr->fsm, &expected_fsm, ISP_FSM_ENABLE), ESP_ERR_INVALID_STATE, TAG, "controller is not enabled yet");
+    if (af_ctlr == af_ctlr->isp_proc->af_ctlr[0]) {
+        esp_isp_stats_set_continuous(af_ctlr->isp_proc, ISP_SUBMODULE_AF, false);
+    }
     isp_ll_af_enable_auto_update(af_ctlr->isp_proc->hal.hw, false);
 
     return ESP_OK;
@@ -308,6 +314,10 @@ bool IRAM_ATTR esp_isp_af_isr(isp_proc_handle_t proc, uint32_t af_events)
      * Should decide a detector instance according to the hw event.
      */
     if (af_events & ISP_LL_EVENT_AF_FDONE) {
+        if (proc->cbs.on_stats_done) {
+            proc->stats_edata.af_result = edata.af_result;
+            proc->stats_ready_mask |= BIT(ISP_SUBMODULE_AF);
+        }
         BaseType_t high_task_awake = false;
         // Send the event data to the queue, overwrite the legacy one if exist
         xQueueOverwriteFromISR(af_ctlr->evt_que, &edata.af_result, &high_task_awake);
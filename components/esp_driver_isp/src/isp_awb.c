@@ -205,6 +205,7 @@ esp_err_t esp_isp_awb_controller_start_continuous_statistics(isp_awb_ctlr_t awb_
 
     isp_fsm_t expected_fsm = ISP_FSM_ENABLE;
     ESP_RETURN_ON_FALSE_ISR(atomic_compare_exchange_strong(&awb_ctlr->fsm, &expected_fsm, ISP_FSM_CONTINUOUS), ESP_ERR_INVALID_STATE, TAG, "controller is not enabled yet");
+    esp_isp_stats_set_continuous(awb_ctlr->isp_proc, ISP_SUBMODULE_AWB, true);
     isp_ll_awb_enable(awb_ctlr->isp_proc->hal.hw, true);
 
     return ESP_OK;
@@ -216,6 +217,7 @@ esp_err_t esp_isp_awb_controller_stop_continuous_statistics(isp_awb_ctlr_t awb_c
 
     isp_fsm_t expected_fsm = ISP_FSM_CONTINUOUS;
     ESP_RETURN_ON_FALSE_ISR(atomic_compare_exchange_strong(&awb_ctlr->fsm, &expected_fsm, ISP_FSM_ENABLE), ESP_ERR_INVALID_STATE, TAG, "controller is not enabled yet");
+    esp_isp_stats_set_continuous(awb_ctlr->isp_proc, ISP_SUBMODULE_AWB, false);
     isp_ll_awb_enable(awb_ctlr->isp_proc->hal.hw, false);
 
     return ESP_OK;
@@ -239,6 +241,10 @@ bool IRAM_ATTR esp_isp_awb_isr(isp_proc_handle_t proc, uint32_t awb_events)
                 .sum_b = isp_ll_awb_get_accumulated_b_value(proc->hal.hw),
             },
         };
+        if (proc->cbs.on_stats_done) {
+            proc->stats_edata.awb_result = edata.awb_result;
+            proc->stats_ready_mask |= BIT(ISP_SUBMODULE_AWB);
+        }
         // Invoke the callback if the callback is registered
         if (awb_ctlr->cbs.on_statistics_done) {
             need_yield |= awb_ctlr->cbs.on_statistics_done(awb_ctlr, &edata, awb_ctlr->user_data);
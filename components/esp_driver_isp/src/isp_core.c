@@ -211,11 +211,15 @@ esp_err_t esp_isp_register_event_callbacks(isp_proc_handle_t proc, const esp_isp
     if (cbs->on_sharpen_frame_done) {
         ESP_RETURN_ON_FALSE(esp_ptr_in_iram(cbs->on_sharpen_frame_done), ESP_ERR_INVALID_ARG, TAG, "on_sharpen_frame_done callback not in IRAM");
     }
+    if (cbs->on_stats_done) {
+        ESP_RETURN_ON_FALSE(esp_ptr_in_iram(cbs->on_stats_done), ESP_ERR_INVALID_ARG, TAG, "on_stats_done callback not in IRAM");
+    }
     if (user_data) {
         ESP_RETURN_ON_FALSE(esp_ptr_internal(user_data), ESP_ERR_INVALID_ARG, TAG, "user context not in internal RAM");
     }
 #endif
     proc->cbs.on_sharpen_frame_done = cbs->on_sharpen_frame_done;
+    proc->cbs.on_stats_done = cbs->on_stats_done;
     proc->user_data = user_data;
 
     if (cbs->on_sharpen_frame_done) {
@@ -317,11 +321,39 @@ static void IRAM_ATTR s_isp_isr_dispatcher(void *arg)
         }
         do_dispatch = false;
     }
+
+    // Deliver the statistics of the frame at once, when the last of the continuous controllers got its result
+    if (proc->cbs.on_stats_done && proc->stats_ready_mask) {
+        portENTER_CRITICAL_ISR(&proc->spinlock);
+        uint32_t continuous_mask = proc->stats_continuous_mask;
+        portEXIT_CRITICAL_ISR(&proc->spinlock);
+
+        if ((proc->stats_ready_mask & continuous_mask) == continuous_mask) {
+            proc->stats_edata.flags.af_valid = !!(continuous_mask & BIT(ISP_SUBMODULE_AF));
+            proc->stats_edata.flags.ae_valid = !!(continuous_mask & BIT(ISP_SUBMODULE_AE));
+            proc->stats_edata.flags.awb_valid = !!(continuous_mask & BIT(ISP_SUBMODULE_AWB));
+            proc->stats_edata.flags.hist_valid = !!(continuous_mask & BIT(ISP_SUBMODULE_HIST));
+            need_yield |= proc->cbs.on_stats_done(proc, &proc->stats_edata, proc->user_data);
+            proc->stats_ready_mask = 0;
+        }
+    }
+
     if (need_yield) {
         portYIELD_FROM_ISR();
     }
 }
 
+void esp_isp_stats_set_continuous(isp_proc_handle_t proc, isp_submodule_t submodule, bool en)
+{
+    portENTER_CRITICAL_SAFE(&proc->spinlock);
+    if (en) {
+        proc->stats_continuous_mask |= BIT(submodule);
+    } else {
+        proc->stats_continuous_mask &= ~BIT(submodule);
+    }
+    portEXIT_CRITICAL_SAFE(&proc->spinlock);
+}
+
 esp_err_t esp_isp_register_isr(isp_proc_handle_t proc, isp_submodule_t submodule)
 {
     esp_err_t ret = ESP_FAIL;
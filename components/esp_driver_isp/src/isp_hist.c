@@ -209,6 +209,7 @@ esp_err_t esp_isp_hist_controller_start_continuous_statistics(isp_hist_ctlr_t hi
 
     isp_fsm_t expected_fsm = ISP_FSM_ENABLE;
     ESP_RETURN_ON_FALSE_ISR(atomic_compare_exchange_strong(&hist_ctlr->fsm, &expected_fsm, ISP_FSM_CONTINUOUS), ESP_ERR_INVALID_STATE, TAG, "controller is not enabled yet");
+    esp_isp_stats_set_continuous(hist_ctlr->isp_proc, ISP_SUBMODULE_HIST, true);
     isp_ll_hist_enable(hist_ctlr->isp_proc->hal.hw, true);
 
     return ESP_OK;
@@ -221,6 +222,7 @@ esp_err_t esp_isp_hist_controller_stop_continuous_statistics(isp_hist_ctlr_t his
     isp_fsm_t expected_fsm = ISP_FSM_CONTINUOUS;
     ESP_RETURN_ON_FALSE_ISR(atomic_compare_exchange_strong(&hist_ctlr->fsm, &expected_fsm, ISP_FSM_ENABLE),
                             ESP_ERR_INVALID_STATE, TAG, "controller is not running");
+    esp_isp_stats_set_continuous(hist_ctlr->isp_proc, ISP_SUBMODULE_HIST, false);
     isp_ll_hist_enable(hist_ctlr->isp_proc->hal.hw, false);
 
     return ESP_OK;
@@ -243,6 +245,10 @@ bool IRAM_ATTR esp_isp_hist_isr(isp_proc_handle_t proc, uint32_t hist_events)
         for (int i = 0; i < ISP_HIST_SEGMENT_NUMS; i++) {
             edata.hist_result.hist_value[i] = hist_value[i];
         }
+        if (proc->cbs.on_stats_done) {
+            proc->stats_edata.hist_result = edata.hist_result;
+            proc->stats_ready_mask |= BIT(ISP_SUBMODULE_HIST);
+        }
         // Invoke the callback if the callback is registered
         if (hist_ctlr->cbs.on_statistics_done) {
             need_yield |= hist_ctlr->cbs.on_statistics_done(hist_ctlr, &edata, hist_ctlr->user_data);
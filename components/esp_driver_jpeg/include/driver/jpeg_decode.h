@@ -15,6 +15,25 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Event data of a decoded stripe of the output picture
+ */
+typedef struct {
+    uint8_t *stripe_buf;      /*!< Pointer to the first line of the stripe, inside the decode output buffer */
+    uint32_t y_start;         /*!< Index of the first line of the stripe in the output picture */
+    uint32_t height;          /*!< Number of lines in the stripe */
+} jpeg_dec_stripe_event_data_t;
+
+/**
+ * @brief Prototype of the callback invoked when a stripe of the output picture is decoded
+ *
+ * @param[in] decoder_engine Handle of the JPEG decoder instance
+ * @param[in] edata Stripe event data
+ * @param[in] user_ctx User context, from `jpeg_decode_cfg_t::user_ctx`
+ * @return Whether a high priority task has been waken up by this function
+ */
+typedef bool (*jpeg_dec_stripe_done_cb_t)(jpeg_decoder_handle_t decoder_engine, const jpeg_dec_stripe_event_data_t *edata, void *user_ctx);
+
 /**
  * @brief Configuration parameters for a JPEG decoder image process.
  */
@@ -22,6 +41,12 @@ typedef struct {
     jpeg_dec_output_format_t output_format;   /*!< JPEG decoder output format */
     jpeg_dec_rgb_element_order_t rgb_order;   /*!< JPEG decoder output order */
     jpeg_yuv_rgb_conv_std_t conv_std;         /*!< JPEG decoder yuv->rgb standard */
+    uint32_t stripe_height;                   /*!< Height of the stripes reported by `on_stripe_done`, in lines. It's rounded up to a multiple of the MCU height.
+                                                   Set to 0 to report the whole picture as one stripe */
+    jpeg_dec_stripe_done_cb_t on_stripe_done; /*!< Invoked in the ISR context each time a stripe of the output picture has been decoded, can be NULL.
+                                                   The stripe can be processed by DMA (e.g. PPA) right away, while the following stripes are still being decoded.
+                                                   Note that the cache of the output buffer is only synchronized when `jpeg_decoder_process` returns */
+    void *user_ctx;                           /*!< User context passed to `on_stripe_done` */
 } jpeg_decode_cfg_t;
 
 /**
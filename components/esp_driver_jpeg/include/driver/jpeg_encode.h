@@ -32,8 +32,36 @@ typedef struct {
 typedef struct {
     int intr_priority;                    /*!< JPEG interrupt priority, if set to 0, driver will select the default priority (1,2,3). */
     int timeout_ms;                       /*!< JPEG timeout threshold for handling a picture, should larger than valid encode time in ms. For example, for 30fps encode, this value must larger than 34. -1 means wait forever */
+    uint32_t frame_queue_depth;           /*!< Number of frames that can be waiting to be encoded by `jpeg_encoder_enqueue`. Set to 0 if `jpeg_encoder_enqueue` is not used */
 } jpeg_encode_engine_cfg_t;
 
+/**
+ * @brief Event data of a frame encoded by the frame queue
+ */
+typedef struct {
+    const uint8_t *encode_inbuf;          /*!< Raw frame which has been encoded, the buffer can be reused (e.g. given back to the camera) */
+    uint8_t *encode_outbuf;               /*!< Output buffer holding the compressed bitstream */
+    uint32_t out_size;                    /*!< Size of the compressed bitstream, 0 if the encoding failed */
+    esp_err_t status;                     /*!< Result of the encoding, same as the return value of `jpeg_encoder_process` */
+    void *frame_ctx;                      /*!< Frame context given to `jpeg_encoder_enqueue` */
+} jpeg_enc_frame_done_event_data_t;
+
+/**
+ * @brief Prototype of the callback invoked when a queued frame has been encoded
+ *
+ * @param[in] encoder_engine Handle of the JPEG encoder instance
+ * @param[in] edata Frame event data
+ * @param[in] user_ctx User context, passed from `jpeg_encoder_register_event_callbacks`
+ */
+typedef void (*jpeg_enc_frame_done_cb_t)(jpeg_encoder_handle_t encoder_engine, const jpeg_enc_frame_done_event_data_t *edata, void *user_ctx);
+
+/**
+ * @brief Group of supported JPEG encoder callbacks
+ */
+typedef struct {
+    jpeg_enc_frame_done_cb_t on_frame_done;  /*!< Invoked in the encoder task when a frame given to `jpeg_encoder_enqueue` has been encoded */
+} jpeg_enc_event_callbacks_t;
+
 /**
  * @brief JPEG encoder memory allocation config
  */
@@ -75,11 +103,50 @@ esp_err_t jpeg_new_encoder_engine(const jpeg_encode_engine_cfg_t *enc_eng_cfg, j
  */
 esp_err_t jpeg_encoder_process(jpeg_encoder_handle_t encoder_engine, const jpeg_encode_cfg_t *encode_cfg, const uint8_t *encode_inbuf, uint32_t inbuf_size, uint8_t *encode_outbuf, uint32_t outbuf_size, uint32_t *out_size);
 
+/**
+ * @brief Register JPEG encoder event callbacks
+ *
+ * @note The callbacks should be registered before any frame is given to `jpeg_encoder_enqueue`.
+ *
+ * @param[in] encoder_engine Handle of the JPEG encoder instance
+ * @param[in] cbs Group of callback functions
+ * @param[in] user_ctx User data, which will be passed to the callback functions directly
+ * @return
+ *      - ESP_OK: Register callbacks successfully.
+ *      - ESP_ERR_INVALID_ARG: Register callbacks failed because of invalid argument.
+ */
+esp_err_t jpeg_encoder_register_event_callbacks(jpeg_encoder_handle_t encoder_engine, const jpeg_enc_event_callbacks_t *cbs, void *user_ctx);
+
+/**
+ * @brief Queue a frame to be encoded by the encoder task, without waiting for the encoding to be done.
+ *
+ * The frames are encoded one after another by a task of the encoder engine, in the order they are queued, and
+ * `jpeg_enc_event_callbacks_t::on_frame_done` is invoked for each of them. Thus the caller can keep capturing
+ * the next frames (e.g. with esp_driver_cam) while the previous ones are being encoded.
+ *
+ * @note The content of `encode_inbuf` and `encode_outbuf` should not be changed until `on_frame_done` is invoked for this frame.
+ * @note The encoder engine should be installed with a non-zero `jpeg_encode_engine_cfg_t::frame_queue_depth`.
+ *
+ * @param[in] encoder_engine Handle to the JPEG encoder engine to be used for encoding.
+ * @param[in] encode_cfg Pointer to the configuration structure for the JPEG encoding process, copied by the function.
+ * @param[in] encode_inbuf Pointer to the input buffer containing the raw image data.
+ * @param[in] inbuf_size Size of the input buffer in bytes.
+ * @param[in] encode_outbuf Pointer to the output buffer where the compressed bitstream will be stored.
+ * @param[in] outbuf_size The size of output buffer.
+ * @param[in] frame_ctx Frame context, passed to `on_frame_done` with this frame.
+ *
+ * @return
+ *      - ESP_OK: Frame queued successfully.
+ *      - ESP_ERR_INVALID_ARG: Queue frame failed because of invalid argument.
+ *      - ESP_ERR_INVALID_STATE: Queue frame failed because the frame queue is not enabled, or it is full.
+ */
+esp_err_t jpeg_encoder_enqueue(jpeg_encoder_handle_t encoder_engine, const jpeg_encode_cfg_t *encode_cfg, const uint8_t *encode_inbuf, uint32_t inbuf_size, uint8_t *encode_outbuf, uint32_t outbuf_size, void *frame_ctx);
+
 /**
  * @brief Release resources used by a JPEG encoder instance.
  *
  * This function releases the resources used by the specified JPEG encoder instance. The encoder instance is
- * specified by the `encoder_engine` parameter.
+ * specified by the `encoder_engine` parameter. The frames still waiting in the frame queue are encoded before.
  *
  * @param[in] encoder_engine Handle of the JPEG encoder instance to release resources for.
  * @return
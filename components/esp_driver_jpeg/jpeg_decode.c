@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <sys/param.h>
 #include "esp_err.h"
 #include "jpeg_private.h"
 #include "private/jpeg_parse_marker.h"
@@ -83,6 +84,7 @@ esp_err_t jpeg_new_decoder_engine(const jpeg_decode_engine_cfg_t *dec_eng_cfg, j
     decoder_engine->txlink = (dma2d_descriptor_t*)heap_caps_aligned_calloc(alignment, 1, dma_desc_mem_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | JPEG_MEM_ALLOC_CAPS);
     ESP_GOTO_ON_FALSE(decoder_engine->txlink, ESP_ERR_NO_MEM, err, TAG, "no memory for jpeg decode txlink");
     decoder_engine->dma_desc_size = dma_desc_mem_size;
+    decoder_engine->rxlink_num = 1;
 
     decoder_engine->header_info = (jpeg_dec_header_info_t*)heap_caps_calloc(1, sizeof(jpeg_dec_header_info_t), JPEG_MEM_ALLOC_CAPS);
     ESP_GOTO_ON_FALSE(decoder_engine->header_info, ESP_ERR_NO_MEM, err, TAG, "no memory for picture info");
@@ -224,6 +226,10 @@ esp_err_t jpeg_decoder_process(jpeg_decoder_handle_t decoder_engine, const jpeg_
     decoder_engine->rgb_order = decode_cfg->rgb_order;
     decoder_engine->conv_std = decode_cfg->conv_std;
     decoder_engine->decoded_buf = decode_outbuf;
+    decoder_engine->stripe_height = decode_cfg->stripe_height;
+    decoder_engine->on_stripe_done = decode_cfg->on_stripe_done;
+    decoder_engine->user_ctx = decode_cfg->user_ctx;
+    decoder_engine->stripe_idx = 0;
 
     ESP_GOTO_ON_ERROR(jpeg_parse_marker(decoder_engine, bit_stream, stream_size), err2, TAG, "jpeg parse marker failed");
     ESP_GOTO_ON_ERROR(jpeg_check_marker(decoder_engine), err2, TAG, "jpeg check marker failed");
@@ -411,8 +417,33 @@ static esp_err_t jpeg_dec_config_dma_descriptor(jpeg_decoder_handle_t decoder_en
     // Configure tx link descriptor
     cfg_desc(decoder_engine, decoder_engine->txlink, JPEG_DMA2D_2D_DISABLE, DMA2D_DESCRIPTOR_BLOCK_RW_MODE_SINGLE, decoder_engine->header_info->buffer_left & JPEG_DMA2D_MAX_SIZE, decoder_engine->header_info->buffer_left & JPEG_DMA2D_MAX_SIZE, JPEG_DMA2D_EOF_NOT_LAST, 1, DMA2D_DESCRIPTOR_BUFFER_OWNER_DMA, (decoder_engine->header_info->buffer_left >> JPEG_DMA2D_1D_HIGH_14BIT), (decoder_engine->header_info->buffer_left >> JPEG_DMA2D_1D_HIGH_14BIT), decoder_engine->header_info->buffer_offset, NULL);
 
-    // Configure rx link descriptor
-    cfg_desc(decoder_engine, decoder_engine->rxlink, JPEG_DMA2D_2D_ENABLE, DMA2D_DESCRIPTOR_BLOCK_RW_MODE_MULTIPLE, dma_vb, dma_hb, JPEG_DMA2D_EOF_NOT_LAST, dma2d_desc_pixel_format_to_pbyte_value(picture_format), DMA2D_DESCRIPTOR_BUFFER_OWNER_DMA, decoder_engine->header_info->process_v, decoder_engine->header_info->process_h, decoder_engine->decoded_buf, NULL);
+    // Split the output picture into stripes of whole MCU rows, each one is received by its own rx link descriptor
+    uint32_t process_v = decoder_engine->header_info->process_v;
+    uint32_t process_h = decoder_engine->header_info->process_h;
+    uint32_t stripe_height = process_v;
+    if (decoder_engine->stripe_height) {
+        stripe_height = MIN(JPEG_ALIGN_UP(decoder_engine->stripe_height, dma_vb), process_v);
+    }
+    uint32_t stripe_num = (process_v + stripe_height - 1) / stripe_height;
+    if (stripe_num > decoder_engine->rxlink_num) {
+        uint32_t alignment = cache_hal_get_cache_line_size(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA);
+        dma2d_descriptor_t *rxlink = (dma2d_descriptor_t*)heap_caps_aligned_calloc(alignment, stripe_num, decoder_engine->dma_desc_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | JPEG_MEM_ALLOC_CAPS);
+        ESP_RETURN_ON_FALSE(rxlink, ESP_ERR_NO_MEM, TAG, "no memory for jpeg decode rxlink");
+        free(decoder_engine->rxlink);
+        decoder_engine->rxlink = rxlink;
+        decoder_engine->rxlink_num = stripe_num;
+    }
+    decoder_engine->stripe_height = stripe_height;
+    decoder_engine->stripe_num = stripe_num;
+
+    // Configure rx link descriptor(s)
+    uint32_t bytes_per_line = process_h * decoder_engine->bit_per_pixel / 8;
+    for (uint32_t i = 0; i < stripe_num; i++) {
+        uint32_t y_start = i * stripe_height;
+        dma2d_descriptor_t *dsc = (dma2d_descriptor_t *)((uint8_t *)decoder_engine->rxlink + i * decoder_engine->dma_desc_size);
+        dma2d_descriptor_t *next_dsc = (i + 1 < stripe_num) ? (dma2d_descriptor_t *)((uint8_t *)dsc + decoder_engine->dma_desc_size) : NULL;
+        cfg_desc(decoder_engine, dsc, JPEG_DMA2D_2D_ENABLE, DMA2D_DESCRIPTOR_BLOCK_RW_MODE_MULTIPLE, dma_vb, dma_hb, JPEG_DMA2D_EOF_NOT_LAST, dma2d_desc_pixel_format_to_pbyte_value(picture_format), DMA2D_DESCRIPTOR_BUFFER_OWNER_DMA, MIN(stripe_height, process_v - y_start), process_h, decoder_engine->decoded_buf + y_start * bytes_per_line, next_dsc);
+    }
 
     return ESP_OK;
 }
@@ -431,6 +462,26 @@ static bool jpeg_rx_eof(dma2d_channel_handle_t dma2d_chan, dma2d_event_data_t *e
     return higher_priority_task_awoken;
 }
 
+static bool jpeg_rx_desc_done(dma2d_channel_handle_t dma2d_chan, dma2d_event_data_t *event_data, void *user_data)
+{
+    jpeg_decoder_handle_t decoder_engine = (jpeg_decoder_handle_t) user_data;
+    // every rx link descriptor holds one stripe, they are completed in order
+    uint32_t stripe_idx = decoder_engine->stripe_idx;
+    if (stripe_idx >= decoder_engine->stripe_num) {
+        return false;
+    }
+    decoder_engine->stripe_idx++;
+
+    uint32_t process_v = decoder_engine->header_info->process_v;
+    uint32_t y_start = stripe_idx * decoder_engine->stripe_height;
+    jpeg_dec_stripe_event_data_t edata = {
+        .stripe_buf = decoder_engine->decoded_buf + y_start * decoder_engine->header_info->process_h * decoder_engine->bit_per_pixel / 8,
+        .y_start = y_start,
+        .height = MIN(decoder_engine->stripe_height, process_v - y_start),
+    };
+    return decoder_engine->on_stripe_done(decoder_engine, &edata, decoder_engine->user_ctx);
+}
+
 static void jpeg_dec_config_dma_csc(jpeg_decoder_handle_t decoder_engine, dma2d_channel_handle_t rx_chan)
 {
 
@@ -546,6 +597,7 @@ static bool jpeg_dec_transaction_on_picked(uint32_t channel_num, const dma2d_tra
 
     dma2d_rx_event_callbacks_t jpeg_dec_cbs = {
         .on_recv_eof = jpeg_rx_eof,
+        .on_desc_done = decoder_engine->on_stripe_done ? jpeg_rx_desc_done : NULL,
     };
 
     dma2d_register_rx_event_callbacks(rx_chan, &jpeg_dec_cbs, decoder_engine);
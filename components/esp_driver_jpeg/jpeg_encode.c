@@ -9,6 +9,8 @@
 #include "esp_heap_caps.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #if CONFIG_JPEG_ENABLE_DEBUG_LOG
 // The local log level must be defined before including esp_log.h
 // Set the maximum log level for this source file
@@ -40,6 +42,7 @@ static void s_cfg_desc(jpeg_encoder_handle_t encoder_engine, dma2d_descriptor_t
 static void s_jpeg_enc_config_picture_color_space(jpeg_encoder_handle_t encoder_engine);
 static void s_jpeg_enc_select_sample_mode(jpeg_encoder_handle_t encoder_engine);
 static void s_encoder_error_log_print(uint32_t status);
+static void s_jpeg_enc_frame_task(void *arg);
 
 static void jpeg_encoder_isr_handle_default(void *arg)
 {
@@ -126,6 +129,15 @@ esp_err_t jpeg_new_encoder_engine(const jpeg_encode_engine_cfg_t *enc_eng_cfg, j
     encoder_engine->header_info = (jpeg_enc_header_info_t*)heap_caps_calloc(1, sizeof(jpeg_enc_header_info_t), JPEG_MEM_ALLOC_CAPS);
     ESP_GOTO_ON_FALSE(encoder_engine->header_info, ESP_ERR_NO_MEM, err, TAG, "no memory for jpeg header information structure");
 
+    if (enc_eng_cfg->frame_queue_depth) {
+        encoder_engine->frame_queue = xQueueCreateWithCaps(enc_eng_cfg->frame_queue_depth, sizeof(jpeg_enc_frame_t), JPEG_MEM_ALLOC_CAPS);
+        ESP_GOTO_ON_FALSE(encoder_engine->frame_queue, ESP_ERR_NO_MEM, err, TAG, "no memory for frame queue");
+        encoder_engine->frame_task_exit = xSemaphoreCreateBinaryWithCaps(JPEG_MEM_ALLOC_CAPS);
+        ESP_GOTO_ON_FALSE(encoder_engine->frame_task_exit, ESP_ERR_NO_MEM, err, TAG, "no memory for frame task semaphore");
+        BaseType_t task_created = xTaskCreate(s_jpeg_enc_frame_task, "jpeg_enc", CONFIG_JPEG_ENCODE_TASK_STACK_SIZE, encoder_engine, CONFIG_JPEG_ENCODE_TASK_PRIORITY, &encoder_engine->frame_task);
+        ESP_GOTO_ON_FALSE(task_created == pdPASS, ESP_ERR_NO_MEM, err, TAG, "create frame task failed");
+    }
+
     *ret_encoder = encoder_engine;
     return ESP_OK;
 err:
@@ -295,11 +307,81 @@ err2:
     return ret;
 }
 
+esp_err_t jpeg_encoder_register_event_callbacks(jpeg_encoder_handle_t encoder_engine, const jpeg_enc_event_callbacks_t *cbs, void *user_ctx)
+{
+    ESP_RETURN_ON_FALSE(encoder_engine && cbs, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    encoder_engine->on_frame_done = cbs->on_frame_done;
+    encoder_engine->user_ctx = user_ctx;
+    return ESP_OK;
+}
+
+esp_err_t jpeg_encoder_enqueue(jpeg_encoder_handle_t encoder_engine, const jpeg_encode_cfg_t *encode_cfg, const uint8_t *encode_inbuf, uint32_t inbuf_size, uint8_t *encode_outbuf, uint32_t outbuf_size, void *frame_ctx)
+{
+    ESP_RETURN_ON_FALSE(encoder_engine, ESP_ERR_INVALID_ARG, TAG, "jpeg encode handle is null");
+    ESP_RETURN_ON_FALSE(encode_cfg, ESP_ERR_INVALID_ARG, TAG, "jpeg encode config is null");
+    ESP_RETURN_ON_FALSE(encode_inbuf, ESP_ERR_INVALID_ARG, TAG, "jpeg encode picture buffer is null");
+    ESP_RETURN_ON_FALSE(encode_outbuf, ESP_ERR_INVALID_ARG, TAG, "jpeg encode bit stream is null");
+    ESP_RETURN_ON_FALSE(encoder_engine->frame_queue, ESP_ERR_INVALID_STATE, TAG, "frame queue is not enabled");
+
+    jpeg_enc_frame_t frame = {
+        .encode_cfg = *encode_cfg,
+        .encode_inbuf = encode_inbuf,
+        .inbuf_size = inbuf_size,
+        .encode_outbuf = encode_outbuf,
+        .outbuf_size = outbuf_size,
+        .frame_ctx = frame_ctx,
+    };
+    // don't block the capture loop, the caller decides whether to drop the frame or to retry
+    ESP_RETURN_ON_FALSE(xQueueSend(encoder_engine->frame_queue, &frame, 0) == pdTRUE, ESP_ERR_INVALID_STATE, TAG, "frame queue is full");
+    return ESP_OK;
+}
+
+static void s_jpeg_enc_frame_task(void *arg)
+{
+    jpeg_encoder_handle_t encoder_engine = (jpeg_encoder_handle_t) arg;
+    jpeg_enc_frame_t frame;
+
+    while (xQueueReceive(encoder_engine->frame_queue, &frame, portMAX_DELAY) == pdTRUE) {
+        if (frame.encode_inbuf == NULL) {
+            // stop request from jpeg_del_encoder_engine, all the frames queued before have been encoded
+            break;
+        }
+        jpeg_enc_frame_done_event_data_t edata = {
+            .encode_inbuf = frame.encode_inbuf,
+            .encode_outbuf = frame.encode_outbuf,
+            .frame_ctx = frame.frame_ctx,
+        };
+        edata.status = jpeg_encoder_process(encoder_engine, &frame.encode_cfg, frame.encode_inbuf, frame.inbuf_size, frame.encode_outbuf, frame.outbuf_size, &edata.out_size);
+        if (edata.status != ESP_OK) {
+            edata.out_size = 0;
+        }
+        if (encoder_engine->on_frame_done) {
+            encoder_engine->on_frame_done(encoder_engine, &edata, encoder_engine->user_ctx);
+        }
+    }
+
+    xSemaphoreGive(encoder_engine->frame_task_exit);
+    vTaskDelete(NULL);
+}
+
 esp_err_t jpeg_del_encoder_engine(jpeg_encoder_handle_t encoder_engine)
 {
     ESP_RETURN_ON_FALSE(encoder_engine, ESP_ERR_INVALID_ARG, TAG, "jpeg encoder handle is null");
 
     if (encoder_engine) {
+        if (encoder_engine->frame_task) {
+            jpeg_enc_frame_t stop_frame = {
+                .encode_inbuf = NULL,
+            };
+            xQueueSend(encoder_engine->frame_queue, &stop_frame, portMAX_DELAY);
+            xSemaphoreTake(encoder_engine->frame_task_exit, portMAX_DELAY);
+        }
+        if (encoder_engine->frame_queue) {
+            vQueueDeleteWithCaps(encoder_engine->frame_queue);
+        }
+        if (encoder_engine->frame_task_exit) {
+            vSemaphoreDeleteWithCaps(encoder_engine->frame_task_exit);
+        }
         if (encoder_engine->rxlink) {
             free(encoder_engine->rxlink);
         }
@@ -11,6 +11,8 @@
 #include "sys/queue.h"
 #include "esp_private/dma2d.h"
 #include "driver/jpeg_types.h"
+#include "driver/jpeg_decode.h"
+#include "driver/jpeg_encode.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
@@ -106,12 +108,19 @@ struct jpeg_decoder_t {
     jpeg_isr_handler_t *intr_handle;             // jpeg decoder interrupt handler
     //dma handles
     dma2d_pool_handle_t dma2d_group_handle;      // 2D-DMA group handle
-    dma2d_descriptor_t *rxlink;                  // Pointer to 2D-DMA rx descriptor
+    dma2d_descriptor_t *rxlink;                  // Pointer to 2D-DMA rx descriptor(s), one per stripe
     dma2d_descriptor_t *txlink;                  // Pointer to 2D-DMA tx descriptor
     uint32_t dma_desc_size;                      // tx and rx linker alignment
+    uint32_t rxlink_num;                         // Number of allocated 2D-DMA rx descriptors
     dma2d_channel_handle_t dma2d_rx_channel;     // DMA2D RX channel handle
     dma2d_channel_handle_t dma2d_tx_channel;     // DMA2D TX channel handle
     dma2d_trans_t* trans_desc;   // DMA2D transaction descriptor
+    // stripe mode
+    uint32_t stripe_height;                      // Height of the output stripes (in lines), 0 for the whole picture
+    uint32_t stripe_num;                         // Number of stripes of the picture being decoded
+    uint32_t stripe_idx;                         // Index of the next stripe to be reported
+    jpeg_dec_stripe_done_cb_t on_stripe_done;    // Callback invoked when a stripe is decoded
+    void *user_ctx;                              // User context of the stripe callback
 };
 
 typedef enum {
@@ -150,6 +159,15 @@ typedef struct {
     jpeg_down_sampling_type_t sub_sample;          // Picture sub-sampling method
 } jpeg_enc_header_info_t;
 
+typedef struct {
+    jpeg_encode_cfg_t encode_cfg;                  // Copy of the encode configuration of the frame
+    const uint8_t *encode_inbuf;                   // Raw frame, NULL to stop the frame task
+    uint32_t inbuf_size;                           // Size of the raw frame
+    uint8_t *encode_outbuf;                        // Output buffer of the compressed bitstream
+    uint32_t outbuf_size;                          // Size of the output buffer
+    void *frame_ctx;                               // Frame context given back in the frame done callback
+} jpeg_enc_frame_t;
+
 struct jpeg_encoder_t {
     jpeg_codec_t *codec_base;                      // Pointer to jpeg codec hardware base
     jpeg_enc_src_type_t color_space;               // Picture source color space
@@ -169,6 +187,12 @@ struct jpeg_encoder_t {
     dma2d_trans_t* trans_desc;                     // DMA2D transaction descriptor
     dma2d_channel_handle_t dma2d_rx_channel;       // DMA2D RX channel handle
     dma2d_channel_handle_t dma2d_tx_channel;       // DMA2D TX channel handle
+    // frame queue
+    QueueHandle_t frame_queue;                     // Frames waiting to be encoded by the frame task
+    TaskHandle_t frame_task;                       // Task encoding the queued frames
+    SemaphoreHandle_t frame_task_exit;             // Given by the frame task when it stops
+    jpeg_enc_frame_done_cb_t on_frame_done;        // Callback invoked when a queued frame is encoded
+    void *user_ctx;                                // User context of the callbacks
 };
 
 #define JPEG_DMA2D_2D_ENABLE       (1)        // DMA2D two dimension enable
@@ -10,6 +10,7 @@
 #include "unity.h"
 #include "test_utils.h"
 #include "esp_err.h"
+#include "esp_attr.h"
 #include "freertos/FreeRTOS.h"
 #include "esp_private/periph_ctrl.h"
 #include "driver/jpeg_decode.h"
@@ -133,3 +134,74 @@ TEST_CASE("JPEG decode image without Huffman table JPEG->RGB picture", "[jpeg]")
     free(tx_buf_no_huff);
     TEST_ESP_OK(jpeg_del_decoder_engine(jpgd_handle));
 }
+
+typedef struct {
+    uint32_t stripe_cnt;
+    uint32_t next_y;
+    bool in_order;
+} test_jpeg_stripe_ctx_t;
+
+static IRAM_ATTR bool test_jpeg_on_stripe_done(jpeg_decoder_handle_t decoder_engine, const jpeg_dec_stripe_event_data_t *edata, void *user_ctx)
+{
+    test_jpeg_stripe_ctx_t *ctx = (test_jpeg_stripe_ctx_t *)user_ctx;
+    if (edata->y_start != ctx->next_y) {
+        ctx->in_order = false;
+    }
+    ctx->next_y = edata->y_start + edata->height;
+    ctx->stripe_cnt++;
+    return false;
+}
+
+TEST_CASE("JPEG decode image by stripes JPEG->RGB picture", "[jpeg]")
+{
+    jpeg_decoder_handle_t jpgd_handle;
+
+    jpeg_decode_engine_cfg_t decode_eng_cfg = {
+        .intr_priority = 0,
+        .timeout_ms = 40,
+    };
+
+    test_jpeg_stripe_ctx_t stripe_ctx = {
+        .in_order = true,
+    };
+
+    jpeg_decode_cfg_t decode_cfg = {
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+        .stripe_height = 10, // rounded up to the MCU height
+        .on_stripe_done = test_jpeg_on_stripe_done,
+        .user_ctx = &stripe_ctx,
+    };
+
+    jpeg_decode_memory_alloc_cfg_t rx_mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER,
+    };
+
+    jpeg_decode_memory_alloc_cfg_t tx_mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER,
+    };
+
+    size_t rx_buffer_size;
+    uint8_t *rx_buf = (uint8_t*)jpeg_alloc_decoder_mem(120 * 160 * 3, &rx_mem_cfg, &rx_buffer_size);
+    uint32_t out_size = 0;
+
+    size_t bit_stream_length = (size_t)image_no_huff_jpg_end - (size_t)image_no_huff_jpg_start;
+
+    size_t tx_buffer_size;
+    uint8_t *tx_buf = (uint8_t*)jpeg_alloc_decoder_mem(bit_stream_length, &tx_mem_cfg, &tx_buffer_size);
+    memcpy(tx_buf, image_no_huff_jpg_start, bit_stream_length);
+    TEST_ESP_OK(jpeg_new_decoder_engine(&decode_eng_cfg, &jpgd_handle));
+
+    jpeg_decode_picture_info_t header_info;
+    TEST_ESP_OK(jpeg_decoder_get_info(tx_buf, bit_stream_length, &header_info));
+
+    TEST_ESP_OK(jpeg_decoder_process(jpgd_handle, &decode_cfg, tx_buf, bit_stream_length, rx_buf, rx_buffer_size, &out_size));
+    TEST_ASSERT_EQUAL(120 * 160 * 2, out_size);
+    // all the stripes are reported in order, and they cover the whole picture
+    TEST_ASSERT_TRUE(stripe_ctx.in_order);
+    TEST_ASSERT_GREATER_THAN(1, stripe_ctx.stripe_cnt);
+    TEST_ASSERT_EQUAL(out_size, stripe_ctx.next_y * header_info.width * 2);
+
+    free(rx_buf);
+    free(tx_buf);
+    TEST_ESP_OK(jpeg_del_decoder_engine(jpgd_handle));
+}
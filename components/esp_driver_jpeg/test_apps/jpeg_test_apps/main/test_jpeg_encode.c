@@ -11,6 +11,7 @@
 #include "test_utils.h"
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "esp_private/periph_ctrl.h"
 #include "driver/jpeg_encode.h"
 #include "driver/jpeg_decode.h"
@@ -118,3 +119,109 @@ TEST_CASE("jpeg initialize twice test", "[jpeg]")
     TEST_ESP_OK(jpeg_del_encoder_engine(encoder_handle));
     TEST_ESP_OK(jpeg_del_decoder_engine(decoder_handle));
 }
+
+typedef struct {
+    SemaphoreHandle_t done_sem;
+    uint32_t frame_cnt;
+    uint32_t out_size[2];
+    bool in_order;
+} test_jpeg_frame_ctx_t;
+
+static void test_jpeg_on_frame_done(jpeg_encoder_handle_t encoder_engine, const jpeg_enc_frame_done_event_data_t *edata, void *user_ctx)
+{
+    test_jpeg_frame_ctx_t *ctx = (test_jpeg_frame_ctx_t *)user_ctx;
+    uint32_t frame_idx = (uint32_t)edata->frame_ctx;
+    if (frame_idx != ctx->frame_cnt || edata->status != ESP_OK) {
+        ctx->in_order = false;
+    }
+    ctx->out_size[frame_idx % 2] = edata->out_size;
+    ctx->frame_cnt++;
+    xSemaphoreGive(ctx->done_sem);
+}
+
+TEST_CASE("JPEG encode frame queue test for 480*640 RGB->YUV picture", "[jpeg]")
+{
+    jpeg_encoder_handle_t jpeg_handle = NULL;
+
+    jpeg_encode_engine_cfg_t encode_eng_cfg = {
+        .intr_priority = 0,
+        .timeout_ms = 40,
+        .frame_queue_depth = 2,
+    };
+
+    jpeg_encode_cfg_t enc_config = {
+        .src_type = JPEG_ENCODE_IN_FORMAT_RGB888,
+        .sub_sample = JPEG_DOWN_SAMPLING_YUV422,
+        .image_quality = 80,
+        .width = 640,
+        .height = 480,
+    };
+
+    jpeg_encode_memory_alloc_cfg_t rx_mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER,
+    };
+
+    jpeg_encode_memory_alloc_cfg_t tx_mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER,
+    };
+
+    size_t rgb_file_size = (size_t)image_esp480_rgb_end - (size_t)image_esp480_rgb_start;
+
+    // double buffered output, the raw frame is the same for all the frames
+    size_t rx_buffer_size = 0;
+    uint8_t *jpg_buf[2];
+    for (int i = 0; i < 2; i++) {
+        jpg_buf[i] = (uint8_t*)jpeg_alloc_encoder_mem(480 * 640, &rx_mem_cfg, &rx_buffer_size);
+        TEST_ASSERT_NOT_NULL(jpg_buf[i]);
+    }
+
+    size_t tx_buffer_size = 0;
+    uint8_t *raw_buf_480p = (uint8_t*)jpeg_alloc_encoder_mem(rgb_file_size, &tx_mem_cfg, &tx_buffer_size);
+    TEST_ASSERT_NOT_NULL(raw_buf_480p);
+    memcpy(raw_buf_480p, image_esp480_rgb_start, rgb_file_size);
+
+    test_jpeg_frame_ctx_t frame_ctx = {
+        .done_sem = xSemaphoreCreateCounting(2, 0),
+        .in_order = true,
+    };
+    TEST_ASSERT_NOT_NULL(frame_ctx.done_sem);
+
+    TEST_ESP_OK(jpeg_new_encoder_engine(&encode_eng_cfg, &jpeg_handle));
+    jpeg_enc_event_callbacks_t cbs = {
+        .on_frame_done = test_jpeg_on_frame_done,
+    };
+    TEST_ESP_OK(jpeg_encoder_register_event_callbacks(jpeg_handle, &cbs, &frame_ctx));
+
+    // the frame queue is not enabled on this engine
+    jpeg_encoder_handle_t sync_handle = NULL;
+    jpeg_encode_engine_cfg_t sync_eng_cfg = {
+        .timeout_ms = 40,
+    };
+    TEST_ESP_OK(jpeg_new_encoder_engine(&sync_eng_cfg, &sync_handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, jpeg_encoder_enqueue(sync_handle, &enc_config, raw_buf_480p, rgb_file_size, jpg_buf[0], rx_buffer_size, NULL));
+    TEST_ESP_OK(jpeg_del_encoder_engine(sync_handle));
+
+    TEST_ESP_OK(jpeg_encoder_enqueue(jpeg_handle, &enc_config, raw_buf_480p, rgb_file_size, jpg_buf[0], rx_buffer_size, (void *)0));
+    TEST_ESP_OK(jpeg_encoder_enqueue(jpeg_handle, &enc_config, raw_buf_480p, rgb_file_size, jpg_buf[1], rx_buffer_size, (void *)1));
+    // a new frame is queued each time an output buffer is released
+    uint32_t frame_num = 10;
+    for (uint32_t i = 2; i < frame_num; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(frame_ctx.done_sem, pdMS_TO_TICKS(1000)));
+        TEST_ESP_OK(jpeg_encoder_enqueue(jpeg_handle, &enc_config, raw_buf_480p, rgb_file_size, jpg_buf[i % 2], rx_buffer_size, (void *)i));
+    }
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(frame_ctx.done_sem, pdMS_TO_TICKS(1000)));
+    }
+    TEST_ASSERT_EQUAL(frame_num, frame_ctx.frame_cnt);
+    TEST_ASSERT_TRUE(frame_ctx.in_order);
+    // same picture in both buffers
+    TEST_ASSERT_NOT_EQUAL(0, frame_ctx.out_size[0]);
+    TEST_ASSERT_EQUAL(frame_ctx.out_size[0], frame_ctx.out_size[1]);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(jpg_buf[0], jpg_buf[1], frame_ctx.out_size[0]);
+
+    TEST_ESP_OK(jpeg_del_encoder_engine(jpeg_handle));
+    vSemaphoreDelete(frame_ctx.done_sem);
+    free(jpg_buf[0]);
+    free(jpg_buf[1]);
+    free(raw_buf_480p);
+}
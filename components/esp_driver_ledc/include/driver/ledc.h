@@ -558,6 +558,38 @@ esp_err_t ledc_fade_stop(ledc_mode_t speed_mode, ledc_channel_t channel);
  */
 esp_err_t ledc_set_duty_and_update(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t duty, uint32_t hpoint);
 
+/**
+ * @brief Duty setting of one LEDC channel, for ledc_set_multi_duty_and_update function
+ */
+typedef struct {
+    ledc_channel_t channel;         /*!< LEDC channel (0 - LEDC_CHANNEL_MAX-1) */
+    uint32_t duty;                  /*!< LEDC channel duty, the range of duty setting is [0, (2**duty_resolution)] */
+    uint32_t hpoint;                /*!< LEDC channel hpoint value, the range is [0, (2**duty_resolution)-1] */
+} ledc_channel_duty_t;
+
+/**
+ * @brief A thread-safe API to set the duty of several LEDC channels and update them together
+ *
+ * The duty and hpoint of all the channels are written first, then the update of all the channels is triggered
+ * in a row, inside one critical section. If the channels are driven by the same LEDC timer, the new duties are
+ * therefore latched at the same timer overflow, without any PWM cycle mixing old and new duties, e.g., for RGB
+ * lighting effects.
+ *
+ * @note  For ESP32, hardware does not support any duty change while a fade operation is running in progress on that channel.
+ *        This function waits until the fade operations of all the channels have finished.
+ *
+ * @param speed_mode Select the LEDC channel group with specified speed mode. Note that not all targets support high speed mode.
+ * @param duties Duty settings of the channels, each channel can appear only once
+ * @param num_channels Number of entries in duties, [1, LEDC_CHANNEL_MAX]
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_STATE Channel not initialized
+ *      - ESP_ERR_INVALID_ARG Parameter error
+ *      - ESP_FAIL Fade function init error
+ */
+esp_err_t ledc_set_multi_duty_and_update(ledc_mode_t speed_mode, const ledc_channel_duty_t *duties, uint32_t num_channels);
+
 /**
  * @brief A thread-safe API to set and start LEDC fade function, with a limited time.
  *
@@ -1594,6 +1594,43 @@ esp_err_t ledc_set_duty_and_update(ledc_mode_t speed_mode, ledc_channel_t channe
     return ESP_OK;
 }
 
+esp_err_t ledc_set_multi_duty_and_update(ledc_mode_t speed_mode, const ledc_channel_duty_t *duties, uint32_t num_channels)
+{
+    LEDC_ARG_CHECK(speed_mode < LEDC_SPEED_MODE_MAX, "speed_mode");
+    LEDC_ARG_CHECK(duties && num_channels > 0 && num_channels <= LEDC_CHANNEL_MAX, "duties");
+    LEDC_CHECK(p_ledc_obj[speed_mode] != NULL, LEDC_NOT_INIT, ESP_ERR_INVALID_STATE);
+    uint32_t channel_mask = 0;
+    for (uint32_t i = 0; i < num_channels; i++) {
+        ledc_channel_t channel = duties[i].channel;
+        LEDC_ARG_CHECK(channel < LEDC_CHANNEL_MAX && !(channel_mask & BIT(channel)), "channel");
+        LEDC_ARG_CHECK(duties[i].duty <= ledc_get_max_duty(speed_mode, channel), "target_duty");
+        LEDC_ARG_CHECK(duties[i].hpoint <= LEDC_LL_HPOINT_VAL_MAX, "hpoint");
+        LEDC_CHECK(ledc_fade_channel_init_check(speed_mode, channel) == ESP_OK, LEDC_FADE_INIT_ERROR_STR, ESP_FAIL);
+        channel_mask |= BIT(channel);
+    }
+    // Acquire the channels in ascending order, so that concurrent callers can't deadlock
+    for (int channel = 0; channel < LEDC_CHANNEL_MAX; channel++) {
+        if (channel_mask & BIT(channel)) {
+            _ledc_fade_hw_acquire(speed_mode, channel);
+        }
+    }
+    portENTER_CRITICAL(&ledc_spinlock);
+    // The new duties only take effect once the channels are updated, write all of them before updating any channel
+    for (uint32_t i = 0; i < num_channels; i++) {
+        ledc_duty_config(speed_mode, duties[i].channel, duties[i].hpoint, duties[i].duty, 1, 1, 1, 0);
+    }
+    for (uint32_t i = 0; i < num_channels; i++) {
+        _ledc_update_duty(speed_mode, duties[i].channel);
+    }
+    portEXIT_CRITICAL(&ledc_spinlock);
+    for (int channel = 0; channel < LEDC_CHANNEL_MAX; channel++) {
+        if (channel_mask & BIT(channel)) {
+            _ledc_fade_hw_release(speed_mode, channel);
+        }
+    }
+    return ESP_OK;
+}
+
 esp_err_t ledc_set_fade_time_and_start(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t target_duty, uint32_t desired_fade_time_ms, ledc_fade_mode_t fade_mode)
 {
     LEDC_ARG_CHECK(speed_mode < LEDC_SPEED_MODE_MAX, "speed_mode");
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -252,6 +252,38 @@ TEST_CASE("LEDC fade with step", "[ledc]")
     ledc_fade_func_uninstall();
 }
 
+TEST_CASE("LEDC set multiple duties and update", "[ledc]")
+{
+    const ledc_mode_t test_speed_mode = TEST_SPEED_MODE;
+    fade_setup();
+    ledc_channel_config_t ledc_ch_config = initialize_channel_config();
+    ledc_ch_config.duty = 0;
+    ledc_ch_config.channel = LEDC_CHANNEL_1;
+    TEST_ESP_OK(ledc_channel_config(&ledc_ch_config));
+    ledc_ch_config.channel = LEDC_CHANNEL_2;
+    TEST_ESP_OK(ledc_channel_config(&ledc_ch_config));
+
+    ledc_channel_duty_t duties[] = {
+        { .channel = LEDC_CHANNEL_0, .duty = 1000, .hpoint = 0 },
+        { .channel = LEDC_CHANNEL_1, .duty = 2000, .hpoint = 0 },
+        { .channel = LEDC_CHANNEL_2, .duty = 3000, .hpoint = 100 },
+    };
+    TEST_ESP_OK(ledc_set_multi_duty_and_update(test_speed_mode, duties, 3));
+    vTaskDelay(5 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL_INT32(1000, ledc_get_duty(test_speed_mode, LEDC_CHANNEL_0));
+    TEST_ASSERT_EQUAL_INT32(2000, ledc_get_duty(test_speed_mode, LEDC_CHANNEL_1));
+    TEST_ASSERT_EQUAL_INT32(3000, ledc_get_duty(test_speed_mode, LEDC_CHANNEL_2));
+    TEST_ASSERT_EQUAL_INT32(100, ledc_get_hpoint(test_speed_mode, LEDC_CHANNEL_2));
+
+    // a channel can't appear twice
+    duties[1].channel = LEDC_CHANNEL_0;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, ledc_set_multi_duty_and_update(test_speed_mode, duties, 3));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, ledc_set_multi_duty_and_update(test_speed_mode, duties, 0));
+
+    //deinitialize fade service
+    ledc_fade_func_uninstall();
+}
+
 TEST_CASE("LEDC fast switching duty with fade_wait_done", "[ledc]")
 {
     const ledc_mode_t test_speed_mode = TEST_SPEED_MODE;
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "driver/mcpwm_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief MCPWM control loop configuration
+ */
+typedef struct {
+    const mcpwm_cmpr_handle_t *comparators;         /*!< Comparators updated by mcpwm_ctrl_loop_set_compare_values(), in this order */
+    size_t num_comparators;                         /*!< Number of comparators */
+    const mcpwm_cap_channel_handle_t *cap_channels; /*!< Capture channels read by mcpwm_ctrl_loop_get_capture_value(), in this order */
+    size_t num_cap_channels;                        /*!< Number of capture channels */
+} mcpwm_ctrl_loop_config_t;
+
+/**
+ * @brief Create a control loop, which binds comparators and capture channels for fast access
+ *
+ * All the checks are done here, and the registers of the comparators and capture channels are resolved, so that
+ * the control loop functions access the hardware directly, without locks nor argument checks. This is meant for
+ * control loops running in an ISR at tens of kHz, such as field oriented motor control.
+ *
+ * @note The comparators and the capture channels must stay allocated, and the comparator operators must stay
+ *       connected to the same timers, until the control loop is deleted.
+ *
+ * @param[in] config Control loop configuration
+ * @param[out] ret_loop Returned control loop handle
+ * @return
+ *      - ESP_OK: Create control loop successfully
+ *      - ESP_ERR_INVALID_ARG: Create control loop failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Create control loop failed because a comparator operator is not connected to a timer
+ *      - ESP_ERR_NO_MEM: Create control loop failed because out of memory
+ */
+esp_err_t mcpwm_new_ctrl_loop(const mcpwm_ctrl_loop_config_t *config, mcpwm_ctrl_loop_handle_t *ret_loop);
+
+/**
+ * @brief Delete a control loop
+ *
+ * @param[in] loop Control loop handle, allocated by `mcpwm_new_ctrl_loop()`
+ * @return
+ *      - ESP_OK: Delete control loop successfully
+ *      - ESP_ERR_INVALID_ARG: Delete control loop failed because of invalid argument
+ */
+esp_err_t mcpwm_del_ctrl_loop(mcpwm_ctrl_loop_handle_t loop);
+
+/**
+ * @brief Get the largest compare value accepted by the comparators of a control loop
+ *
+ * The control loop doesn't check the values passed to mcpwm_ctrl_loop_set_compare_values(), the caller has to limit
+ * them to this value.
+ *
+ * @param[in] loop Control loop handle
+ * @param[out] ret_peak_ticks Returned peak value of the timers connected to the comparators
+ * @return
+ *      - ESP_OK: Get the largest compare value successfully
+ *      - ESP_ERR_INVALID_ARG: Get the largest compare value failed because of invalid argument
+ */
+esp_err_t mcpwm_ctrl_loop_get_peak_ticks(mcpwm_ctrl_loop_handle_t loop, uint32_t *ret_peak_ticks);
+
+/**
+ * @brief Set the compare values of all the comparators of a control loop
+ *
+ * Each value is written to the comparator with a single register write. The new values take effect at the update
+ * events configured for the comparators, e.g. all at once when the timer counts to zero with `update_cmp_on_tez`.
+ *
+ * @note This function doesn't check its arguments and doesn't take any lock. It can be called from ISR context.
+ * @note This function is placed in IRAM when CONFIG_MCPWM_CTRL_FUNC_IN_IRAM is enabled.
+ *
+ * @param[in] loop Control loop handle
+ * @param[in] cmp_ticks Compare values, one per comparator in the order of mcpwm_ctrl_loop_config_t::comparators,
+ *                      each at most the value returned by mcpwm_ctrl_loop_get_peak_ticks()
+ */
+void mcpwm_ctrl_loop_set_compare_values(mcpwm_ctrl_loop_handle_t loop, const uint32_t *cmp_ticks);
+
+/**
+ * @brief Get the last value captured by a capture channel of a control loop
+ *
+ * @note This function doesn't check its arguments and doesn't take any lock. It can be called from ISR context.
+ * @note This function is placed in IRAM when CONFIG_MCPWM_CTRL_FUNC_IN_IRAM is enabled.
+ *
+ * @param[in] loop Control loop handle
+ * @param[in] index Index of the capture channel in mcpwm_ctrl_loop_config_t::cap_channels
+ * @return Capture timer count latched at the last capture event of the channel
+ */
+uint32_t mcpwm_ctrl_loop_get_capture_value(mcpwm_ctrl_loop_handle_t loop, size_t index);
+
+#ifdef __cplusplus
+}
+#endif
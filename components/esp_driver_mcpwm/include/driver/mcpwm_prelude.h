@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -19,3 +19,4 @@
 #include "driver/mcpwm_sync.h"
 #include "driver/mcpwm_cap.h"
 #include "driver/mcpwm_etm.h"
+#include "driver/mcpwm_ctrl_loop.h"
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -54,6 +54,11 @@ typedef struct mcpwm_cap_timer_t *mcpwm_cap_timer_handle_t;
  */
 typedef struct mcpwm_cap_channel_t *mcpwm_cap_channel_handle_t;
 
+/**
+ * @brief Type of MCPWM control loop handle
+ */
+typedef struct mcpwm_ctrl_loop_t *mcpwm_ctrl_loop_handle_t;
+
 /**
  * @brief MCPWM timer event data
  */
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <sys/cdefs.h>
+#include "sdkconfig.h"
+#if CONFIG_MCPWM_ENABLE_DEBUG_LOG
+// The local log level must be defined before including esp_log.h
+// Set the maximum log level for this source file
+#define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
+#endif
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "soc/soc_caps.h"
+#include "hal/mcpwm_ll.h"
+#include "driver/mcpwm_ctrl_loop.h"
+#include "mcpwm_private.h"
+
+static const char *TAG = "mcpwm";
+
+typedef struct {
+    volatile uint32_t *reg;     // compare value register
+    mcpwm_cmpr_t *cmpr;         // comparator, to keep its compare value up to date for the event callbacks
+} mcpwm_ctrl_loop_cmpr_t;
+
+typedef struct {
+    mcpwm_dev_t *dev;           // peripheral of the capture channel
+    int cap_chan_id;            // capture channel ID
+} mcpwm_ctrl_loop_cap_t;
+
+struct mcpwm_ctrl_loop_t {
+    uint32_t peak_ticks;            // smallest peak value of the timers connected to the comparators
+    size_t num_comparators;         // number of comparators
+    size_t num_cap_channels;        // number of capture channels
+    mcpwm_ctrl_loop_cmpr_t *cmprs;  // comparators, resolved at creation
+    mcpwm_ctrl_loop_cap_t *caps;    // capture channels, resolved at creation
+};
+
+esp_err_t mcpwm_new_ctrl_loop(const mcpwm_ctrl_loop_config_t *config, mcpwm_ctrl_loop_handle_t *ret_loop)
+{
+    ESP_RETURN_ON_FALSE(config && ret_loop, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->num_comparators || config->num_cap_channels, ESP_ERR_INVALID_ARG, TAG, "empty control loop");
+    ESP_RETURN_ON_FALSE(!config->num_comparators || config->comparators, ESP_ERR_INVALID_ARG, TAG, "invalid comparators");
+    ESP_RETURN_ON_FALSE(!config->num_cap_channels || config->cap_channels, ESP_ERR_INVALID_ARG, TAG, "invalid capture channels");
+
+    // the loop and its tables are allocated together, the tables are accessed from ISR context
+    size_t size = sizeof(struct mcpwm_ctrl_loop_t) + config->num_comparators * sizeof(mcpwm_ctrl_loop_cmpr_t) +
+                  config->num_cap_channels * sizeof(mcpwm_ctrl_loop_cap_t);
+    mcpwm_ctrl_loop_handle_t loop = heap_caps_calloc(1, size, MCPWM_MEM_ALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_NO_MEM, TAG, "no mem for control loop");
+    loop->cmprs = (mcpwm_ctrl_loop_cmpr_t *)(loop + 1);
+    loop->caps = (mcpwm_ctrl_loop_cap_t *)(loop->cmprs + config->num_comparators);
+    loop->peak_ticks = UINT32_MAX;
+
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < config->num_comparators; i++) {
+        mcpwm_cmpr_t *cmpr = config->comparators[i];
+        ESP_GOTO_ON_FALSE(cmpr, ESP_ERR_INVALID_ARG, err, TAG, "invalid comparator %zu", i);
+        mcpwm_oper_t *oper = cmpr->oper;
+        mcpwm_dev_t *dev = oper->group->hal.dev;
+        ESP_GOTO_ON_FALSE(oper->timer, ESP_ERR_INVALID_STATE, err, TAG, "comparator %zu: timer and operator are not connected", i);
+        if (oper->timer->peak_ticks < loop->peak_ticks) {
+            loop->peak_ticks = oper->timer->peak_ticks;
+        }
+        switch (cmpr->type) {
+        case MCPWM_OPERATOR_COMPARATOR:
+            loop->cmprs[i].reg = mcpwm_ll_operator_get_compare_value_reg(dev, oper->oper_id, cmpr->cmpr_id);
+            break;
+#if SOC_MCPWM_SUPPORT_EVENT_COMPARATOR
+        case MCPWM_EVENT_COMPARATOR:
+            loop->cmprs[i].reg = mcpwm_ll_operator_get_event_compare_value_reg(dev, oper->oper_id, cmpr->cmpr_id);
+            break;
+#endif
+        }
+        loop->cmprs[i].cmpr = cmpr;
+    }
+    loop->num_comparators = config->num_comparators;
+
+    for (size_t i = 0; i < config->num_cap_channels; i++) {
+        mcpwm_cap_channel_t *cap_chan = config->cap_channels[i];
+        ESP_GOTO_ON_FALSE(cap_chan, ESP_ERR_INVALID_ARG, err, TAG, "invalid capture channel %zu", i);
+        loop->caps[i].dev = cap_chan->cap_timer->group->hal.dev;
+        loop->caps[i].cap_chan_id = cap_chan->cap_chan_id;
+    }
+    loop->num_cap_channels = config->num_cap_channels;
+
+    ESP_LOGD(TAG, "new control loop @%p, %zu comparators, %zu capture channels, peak ticks %"PRIu32,
+             loop, loop->num_comparators, loop->num_cap_channels, loop->peak_ticks);
+    *ret_loop = loop;
+    return ESP_OK;
+
+err:
+    free(loop);
+    return ret;
+}
+
+esp_err_t mcpwm_del_ctrl_loop(mcpwm_ctrl_loop_handle_t loop)
+{
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(loop);
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_ctrl_loop_get_peak_ticks(mcpwm_ctrl_loop_handle_t loop, uint32_t *ret_peak_ticks)
+{
+    ESP_RETURN_ON_FALSE(loop && ret_peak_ticks, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    *ret_peak_ticks = loop->peak_ticks;
+    return ESP_OK;
+}
+
+void mcpwm_ctrl_loop_set_compare_values(mcpwm_ctrl_loop_handle_t loop, const uint32_t *cmp_ticks)
+{
+    for (size_t i = 0; i < loop->num_comparators; i++) {
+        *loop->cmprs[i].reg = cmp_ticks[i];
+        loop->cmprs[i].cmpr->compare_ticks = cmp_ticks[i];
+    }
+}
+
+uint32_t mcpwm_ctrl_loop_get_capture_value(mcpwm_ctrl_loop_handle_t loop, size_t index)
+{
+    return mcpwm_ll_capture_get_value(loop->caps[index].dev, loop->caps[index].cap_chan_id);
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,6 +11,7 @@
 #include "driver/mcpwm_timer.h"
 #include "driver/mcpwm_oper.h"
 #include "driver/mcpwm_cmpr.h"
+#include "driver/mcpwm_ctrl_loop.h"
 
 TEST_CASE("mcpwm_comparator_install_uninstall", "[mcpwm]")
 {
@@ -112,3 +113,64 @@ TEST_CASE("mcpwm_comparator_event_callback", "[mcpwm]")
     TEST_ESP_OK(mcpwm_del_operator(oper));
     TEST_ESP_OK(mcpwm_del_timer(timer));
 }
+
+TEST_CASE("mcpwm_control_loop_compare_update", "[mcpwm]")
+{
+    mcpwm_timer_handle_t timer;
+    mcpwm_oper_handle_t oper;
+    mcpwm_cmpr_handle_t comparators[SOC_MCPWM_COMPARATORS_PER_OPERATOR];
+    mcpwm_ctrl_loop_handle_t loop = NULL;
+
+    mcpwm_timer_config_t timer_config = {
+        .group_id = 0,
+        .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
+        .resolution_hz = 1 * 1000 * 1000,
+        .period_ticks = 1000,
+        .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
+    };
+    mcpwm_operator_config_t operator_config = {
+        .group_id = 0,
+    };
+    TEST_ESP_OK(mcpwm_new_timer(&timer_config, &timer));
+    TEST_ESP_OK(mcpwm_new_operator(&operator_config, &oper));
+    mcpwm_comparator_config_t comparator_config = {
+        .flags.update_cmp_on_tez = true,
+    };
+    for (int i = 0; i < SOC_MCPWM_COMPARATORS_PER_OPERATOR; i++) {
+        TEST_ESP_OK(mcpwm_new_comparator(oper, &comparator_config, &comparators[i]));
+    }
+
+    mcpwm_ctrl_loop_config_t loop_config = {
+        .comparators = comparators,
+        .num_comparators = SOC_MCPWM_COMPARATORS_PER_OPERATOR,
+    };
+    printf("operator is not connected to a timer yet\r\n");
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, mcpwm_new_ctrl_loop(&loop_config, &loop));
+
+    TEST_ESP_OK(mcpwm_operator_connect_timer(oper, timer));
+    TEST_ESP_OK(mcpwm_new_ctrl_loop(&loop_config, &loop));
+    uint32_t peak_ticks = 0;
+    TEST_ESP_OK(mcpwm_ctrl_loop_get_peak_ticks(loop, &peak_ticks));
+    TEST_ASSERT_EQUAL_UINT32(999, peak_ticks);
+
+    TEST_ESP_OK(mcpwm_timer_enable(timer));
+    TEST_ESP_OK(mcpwm_timer_start_stop(timer, MCPWM_TIMER_START_NO_STOP));
+    uint32_t cmp_ticks[SOC_MCPWM_COMPARATORS_PER_OPERATOR];
+    for (int step = 0; step < 10; step++) {
+        for (int i = 0; i < SOC_MCPWM_COMPARATORS_PER_OPERATOR; i++) {
+            cmp_ticks[i] = (step * 100 + i * 10) % peak_ticks;
+        }
+        mcpwm_ctrl_loop_set_compare_values(loop, cmp_ticks);
+        vTaskDelay(pdMS_TO_TICKS(2));
+    }
+    TEST_ESP_OK(mcpwm_timer_start_stop(timer, MCPWM_TIMER_STOP_EMPTY));
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ESP_OK(mcpwm_timer_disable(timer));
+
+    TEST_ESP_OK(mcpwm_del_ctrl_loop(loop));
+    for (int i = 0; i < SOC_MCPWM_COMPARATORS_PER_OPERATOR; i++) {
+        TEST_ESP_OK(mcpwm_del_comparator(comparators[i]));
+    }
+    TEST_ESP_OK(mcpwm_del_operator(oper));
+    TEST_ESP_OK(mcpwm_del_timer(timer));
+}
@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "driver/parlio_tx.h"
+#include "driver/bitscrambler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Decorate the Parallel IO TX unit with a BitScrambler, which transforms the payload on its way from the DMA to the TX unit
+ *
+ * @note The program must output as many bits as it reads, e.g. the byte swap and bit reverse programs in `driver/bitscrambler_programs.h`,
+ *       because the TX unit sends `payload_bits` bits for each transaction.
+ * @note Each payload must be at least 8 bytes long, as the BitScrambler prefetches 64 bits when it starts.
+ * @note This function must be called before `parlio_tx_unit_enable`.
+ *
+ * @param[in] tx_unit Parallel IO TX unit that created by `parlio_new_tx_unit`
+ * @param[in] program BitScrambler program, declared with `BITSCRAMBLER_PROGRAM`
+ * @return
+ *      - ESP_OK: Decorate the TX unit successfully
+ *      - ESP_ERR_INVALID_ARG: Decorate the TX unit failed because of invalid argument, or the program is not valid
+ *      - ESP_ERR_INVALID_STATE: Decorate the TX unit failed because the unit is enabled or already decorated
+ *      - ESP_ERR_NOT_FOUND: Decorate the TX unit failed because the BitScrambler TX channel is in use
+ *      - ESP_ERR_NO_MEM: Decorate the TX unit failed because of out of memory
+ */
+esp_err_t parlio_tx_unit_decorate_bitscrambler(parlio_tx_unit_handle_t tx_unit, const void *program);
+
+/**
+ * @brief Remove the BitScrambler from the Parallel IO TX unit
+ *
+ * @note This function must be called when the TX unit is disabled. Deleting the TX unit also removes its BitScrambler.
+ *
+ * @param[in] tx_unit Parallel IO TX unit decorated by `parlio_tx_unit_decorate_bitscrambler`
+ * @return
+ *      - ESP_OK: Remove the BitScrambler successfully
+ *      - ESP_ERR_INVALID_ARG: Remove the BitScrambler failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Remove the BitScrambler failed because the unit is enabled or not decorated
+ */
+esp_err_t parlio_tx_unit_undecorate_bitscrambler(parlio_tx_unit_handle_t tx_unit);
+
+#ifdef __cplusplus
+}
+#endif
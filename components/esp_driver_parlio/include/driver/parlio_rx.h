@@ -237,7 +237,10 @@ esp_err_t parlio_rx_unit_disable(parlio_rx_unit_handle_t rx_unit);
 typedef struct {
     parlio_rx_delimiter_handle_t delimiter;         /*!< The delimiter of this receiving transaction */
     struct {
-        uint32_t                 partial_rx_en: 1;  /*!< Whether this is an infinite transaction that supposed to receive continuously and partially */
+        uint32_t                 partial_rx_en: 1;  /*!< Whether this is an infinite transaction that supposed to receive continuously and partially.
+                                                     *   The DMA descriptors are linked as a ring over the payload, which is split in at least 2 parts,
+                                                     *   so that capture never stops: `on_partial_receive` is called when each part is filled,
+                                                     *   with the offset of this part in the payload */
         uint32_t                 indirect_mount: 1; /*!< This flag only take effect when `partial_rx_en` is enabled.
                                                      *   Enable this flag, an INTERNAL DMA buffer will be mounted to the DMA descriptor instead,
                                                      *   The data will be copy to the payload in every interrupt. So that to guarantee the payload buffer
@@ -294,6 +297,9 @@ typedef struct {
     parlio_rx_delimiter_handle_t    delimiter;      /*!< The current delimiter of this receiving event */
     void                            *data;          /*!< The data buffer address that just finished receiving */
     size_t                          recv_bytes;     /*!< The number of received bytes in the data buffer */
+    size_t                          offset;         /*!< Offset of the received data in the payload, only valid in `on_partial_receive`.
+                                                     *   In a `partial_rx_en` transaction, the payload is used as a ring buffer,
+                                                     *   and this is the index of the oldest data that the DMA won't overwrite before the next event */
 } parlio_rx_event_data_t;
 
 /**
@@ -411,15 +411,18 @@ static bool parlio_rx_default_desc_done_callback(gdma_channel_handle_t dma_chan,
         ESP_EARLY_LOGW(TAG, "failed to sync dma buffer from memory to cache");
     }
 #endif
+    /* Wrap around the ring before the data of this descriptor is accounted, it starts the payload again */
+    if (rx_unit->curr_trans.recv_bytes >= rx_unit->curr_trans.size) {
+        rx_unit->curr_trans.recv_bytes = 0;
+    }
     parlio_rx_event_data_t evt_data = {
         .delimiter = rx_unit->curr_trans.delimiter,
         .data = finished_desc->buffer,
         .recv_bytes = finished_desc->dw0.length,
+        .offset = (uint8_t *)finished_desc->buffer - (uint8_t *)rx_unit->curr_trans.payload,
     };
-    if (rx_unit->cbs.on_partial_receive) {
-        need_yield |= rx_unit->cbs.on_partial_receive(rx_unit, &evt_data, rx_unit->user_data);
-    }
-    /* For the infinite transaction, need to copy the data in DMA buffer to the user receiving buffer */
+    /* For the infinite transaction, need to copy the data in DMA buffer to the user receiving buffer,
+     * before the callback so that the data is already at `offset` in the user buffer */
     if (rx_unit->curr_trans.flags.infinite && rx_unit->curr_trans.flags.indirect_mount) {
         memcpy(rx_unit->usr_recv_buf + rx_unit->curr_trans.recv_bytes, evt_data.data, evt_data.recv_bytes);
     } else {
@@ -427,10 +430,10 @@ static bool parlio_rx_default_desc_done_callback(gdma_channel_handle_t dma_chan,
         rx_unit->curr_trans.delimiter->under_using = false;
         portEXIT_CRITICAL_ISR(&s_rx_spinlock);
     }
-    /* Update received bytes */
-    if (rx_unit->curr_trans.recv_bytes >= rx_unit->curr_trans.size) {
-        rx_unit->curr_trans.recv_bytes = 0;
+    if (rx_unit->cbs.on_partial_receive) {
+        need_yield |= rx_unit->cbs.on_partial_receive(rx_unit, &evt_data, rx_unit->user_data);
     }
+    /* Update received bytes */
     rx_unit->curr_trans.recv_bytes += evt_data.recv_bytes;
     /* Move to the next DMA descriptor */
     rx_unit->curr_desc = rx_unit->curr_desc->next;
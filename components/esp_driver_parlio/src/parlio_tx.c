@@ -39,6 +39,9 @@
 #include "esp_private/gdma.h"
 #include "esp_private/gdma_link.h"
 #include "esp_private/esp_dma_utils.h"
+#if SOC_BITSCRAMBLER_SUPPORTED
+#include "driver/parlio_bitscrambler.h"
+#endif
 
 static const char *TAG = "parlio-tx";
 
@@ -72,6 +75,9 @@ typedef struct parlio_tx_unit_t {
     _Atomic parlio_tx_fsm_t fsm;       // Driver FSM state
     parlio_tx_done_callback_t on_trans_done; // callback function when the transmission is done
     void *user_data;                   // user data passed to the callback function
+#if SOC_BITSCRAMBLER_SUPPORTED
+    bitscrambler_handle_t bs;          // BitScrambler transforming the TX DMA stream, NULL if not decorated
+#endif
     parlio_tx_trans_desc_t trans_desc_pool[];   // transaction descriptor pool
 } parlio_tx_unit_t;
 
@@ -110,6 +116,11 @@ exit:
 
 static esp_err_t parlio_destroy_tx_unit(parlio_tx_unit_t *tx_unit)
 {
+#if SOC_BITSCRAMBLER_SUPPORTED
+    if (tx_unit->bs) {
+        bitscrambler_free(tx_unit->bs);
+    }
+#endif
     if (tx_unit->intr) {
         ESP_RETURN_ON_ERROR(esp_intr_free(tx_unit->intr), TAG, "delete interrupt service failed");
     }
@@ -506,6 +517,13 @@ static void parlio_tx_do_transaction(parlio_tx_unit_t *tx_unit, parlio_tx_trans_
     parlio_ll_tx_set_idle_data_value(hal->regs, t->idle_value);
     parlio_ll_tx_set_trans_bit_len(hal->regs, t->payload_bits);
 
+#if SOC_BITSCRAMBLER_SUPPORTED
+    if (tx_unit->bs) {
+        // the program was stopped by the EOF of the previous payload, restart it with empty FIFOs
+        bitscrambler_reset(tx_unit->bs);
+        bitscrambler_start(tx_unit->bs);
+    }
+#endif
     gdma_start(tx_unit->dma_chan, gdma_link_get_head_addr(tx_unit->dma_link));
     // wait until the data goes from the DMA to TX unit's FIFO
     while (parlio_ll_tx_is_ready(hal->regs) == false);
@@ -611,6 +629,10 @@ esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *p
 #if !SOC_PARLIO_TRANS_BIT_ALIGN
     ESP_RETURN_ON_FALSE((payload_bits % 8) == 0, ESP_ERR_INVALID_ARG, TAG, "payload bit length must be multiple of 8");
 #endif // !SOC_PARLIO_TRANS_BIT_ALIGN
+#if SOC_BITSCRAMBLER_SUPPORTED
+    // the BitScrambler prefetches 64 bits of the payload when it starts
+    ESP_RETURN_ON_FALSE(!tx_unit->bs || payload_bits >= 64, ESP_ERR_INVALID_ARG, TAG, "payload too short for the BitScrambler");
+#endif
 
     size_t cache_line_size = 0;
     size_t alignment = 0;
@@ -666,6 +688,41 @@ esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *p
     return ESP_OK;
 }
 
+#if SOC_BITSCRAMBLER_SUPPORTED
+esp_err_t parlio_tx_unit_decorate_bitscrambler(parlio_tx_unit_handle_t tx_unit, const void *program)
+{
+    ESP_RETURN_ON_FALSE(tx_unit && program, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(atomic_load(&tx_unit->fsm) == PARLIO_TX_FSM_INIT, ESP_ERR_INVALID_STATE, TAG, "unit not in init state");
+    ESP_RETURN_ON_FALSE(!tx_unit->bs, ESP_ERR_INVALID_STATE, TAG, "unit already decorated");
+
+    // the BitScrambler sits between the GDMA channel and the TX unit, the DMA connection stays as it is
+    bitscrambler_config_t bs_config = {
+        .dir = BITSCRAMBLER_DIR_TX,
+        .attach_to = SOC_BITSCRAMBLER_ATTACH_PARL_IO,
+    };
+    bitscrambler_handle_t bs = NULL;
+    ESP_RETURN_ON_ERROR(bitscrambler_new(&bs_config, &bs), TAG, "create bitscrambler failed");
+    esp_err_t ret = bitscrambler_load_program(bs, program);
+    if (ret != ESP_OK) {
+        bitscrambler_free(bs);
+        ESP_LOGE(TAG, "load bitscrambler program failed");
+        return ret;
+    }
+    tx_unit->bs = bs;
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_undecorate_bitscrambler(parlio_tx_unit_handle_t tx_unit)
+{
+    ESP_RETURN_ON_FALSE(tx_unit, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(atomic_load(&tx_unit->fsm) == PARLIO_TX_FSM_INIT, ESP_ERR_INVALID_STATE, TAG, "unit not in init state");
+    ESP_RETURN_ON_FALSE(tx_unit->bs, ESP_ERR_INVALID_STATE, TAG, "unit not decorated");
+    bitscrambler_free(tx_unit->bs);
+    tx_unit->bs = NULL;
+    return ESP_OK;
+}
+#endif // SOC_BITSCRAMBLER_SUPPORTED
+
 static void parlio_tx_default_isr(void *args)
 {
     parlio_tx_unit_t *tx_unit = (parlio_tx_unit_t *)args;
@@ -62,6 +62,8 @@ typedef struct {
     uint32_t partial_recv_cnt;
     uint32_t recv_done_cnt;
     uint32_t timeout_cnt;
+    uint32_t offset_err_cnt;
+    size_t expected_offset;
 } test_data_t;
 
 #ifndef ALIGN_UP
@@ -73,6 +75,11 @@ static bool test_parlio_rx_partial_recv_callback(parlio_rx_unit_handle_t rx_unit
 {
     test_data_t *test_data = (test_data_t *)user_data;
     test_data->partial_recv_cnt++;
+    // The parts of the payload are received one after the other, wrapping around in the infinite transaction
+    if (edata->offset != test_data->expected_offset && edata->offset != 0) {
+        test_data->offset_err_cnt++;
+    }
+    test_data->expected_offset = edata->offset + edata->recv_bytes;
     return false;
 }
 
@@ -517,6 +524,7 @@ TEST_CASE("parallel_rx_unit_receive_transaction_test", "[parlio_rx]")
     TEST_ESP_OK(parlio_rx_soft_delimiter_start_stop(rx_unit, deli, false));
     TEST_ASSERT_GREATER_THAN(6, test_data.partial_recv_cnt);
     TEST_ASSERT_GREATER_THAN(3, test_data.recv_done_cnt);
+    TEST_ASSERT_EQUAL(0, test_data.offset_err_cnt);
     memset(&test_data, 0, sizeof(test_data_t));
 
     TEST_ESP_OK(parlio_rx_unit_disable(rx_unit));
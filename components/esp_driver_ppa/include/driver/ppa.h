@@ -287,6 +287,43 @@ typedef struct {
  */
 esp_err_t ppa_do_fill(ppa_client_handle_t ppa_client, const ppa_fill_oper_config_t *config);
 
+/**
+ * @brief Start recording a batch of PPA operations for a client
+ *
+ * The operations requested by `ppa_do_xxx` on the client after this call are prepared, but not started.
+ * They are all started at once by `ppa_client_submit_batch`, and run back-to-back on the PPA engine.
+ *
+ * @note Every recorded operation holds one of the client's pending transactions until the batch finishes,
+ *       so `max_pending_trans_num` of the client needs to be at least the number of the operations in a batch.
+ * @note The `mode` and `user_data` of the recorded operations are ignored, they are given to `ppa_client_submit_batch` for the whole batch.
+ *
+ * @param[in] ppa_client PPA client handle
+ *
+ * @return
+ *      - ESP_OK: Start recording a batch successfully
+ *      - ESP_ERR_INVALID_ARG: Start recording a batch failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Start recording a batch failed because the client is already recording a batch
+ */
+esp_err_t ppa_client_begin_batch(ppa_client_handle_t ppa_client);
+
+/**
+ * @brief Start the batch of PPA operations recorded since `ppa_client_begin_batch`
+ *
+ * The operations are queued to the PPA engine together, each one is started from the interrupt of the previous one.
+ * The `on_trans_done` callback is only invoked once, when the last operation of the batch finishes.
+ *
+ * @param[in] ppa_client PPA client handle
+ * @param[in] mode Determines whether to block until the whole batch finishes, see `ppa_trans_mode_t`
+ * @param[in] user_data User registered data to be passed into `done_cb` callback function, when the batch finishes
+ *
+ * @return
+ *      - ESP_OK: Submit the batch successfully (an empty batch is ignored)
+ *      - ESP_ERR_INVALID_ARG: Submit the batch failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Submit the batch failed because the client is not recording a batch
+ *      - ESP_FAIL: Submit the batch failed because of other error, the recorded operations are dropped
+ */
+esp_err_t ppa_client_submit_batch(ppa_client_handle_t ppa_client, ppa_trans_mode_t mode, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -276,6 +276,7 @@ esp_err_t ppa_register_client(const ppa_client_config_t *config, ppa_client_hand
     client->oper_type = config->oper_type;
     client->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
     client->data_burst_length = config->data_burst_length ? config->data_burst_length : PPA_DATA_BURST_LENGTH_128;
+    STAILQ_INIT(&client->batch_stailq);
     if (config->oper_type == PPA_OPERATION_SRM) {
         ppa_engine_config_t engine_config = {
             .engine = PPA_ENGINE_TYPE_SRM,
@@ -409,6 +410,15 @@ esp_err_t ppa_do_operation(ppa_client_handle_t ppa_client, ppa_engine_t *ppa_eng
     esp_err_t pm_lock_ret __attribute__((unused));
 
     portENTER_CRITICAL(&ppa_client->spinlock);
+    if (ppa_client->batch_recording) {
+        // Keep the transaction in the client, it will be sent to PPA engine queue with the whole batch
+        trans_elm->notify = false;
+        STAILQ_INSERT_TAIL(&ppa_client->batch_stailq, trans_elm, entry);
+        ppa_client->trans_cnt++;
+        portEXIT_CRITICAL(&ppa_client->spinlock);
+        return ESP_OK;
+    }
+    trans_elm->notify = true;
     // Send transaction into PPA engine queue
     portENTER_CRITICAL(&ppa_engine_base->spinlock);
     STAILQ_INSERT_TAIL(&ppa_engine_base->trans_stailq, trans_elm, entry);
@@ -463,6 +473,103 @@ err:
     return ret;
 }
 
+esp_err_t ppa_client_begin_batch(ppa_client_handle_t ppa_client)
+{
+    ESP_RETURN_ON_FALSE(ppa_client, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    bool recording = false;
+    portENTER_CRITICAL(&ppa_client->spinlock);
+    recording = ppa_client->batch_recording;
+    ppa_client->batch_recording = true;
+    portEXIT_CRITICAL(&ppa_client->spinlock);
+    ESP_RETURN_ON_FALSE(!recording, ESP_ERR_INVALID_STATE, TAG, "client is already recording a batch");
+    return ESP_OK;
+}
+
+esp_err_t ppa_client_submit_batch(ppa_client_handle_t ppa_client, ppa_trans_mode_t mode, void *user_data)
+{
+    esp_err_t ret = ESP_OK;
+    esp_err_t pm_lock_ret __attribute__((unused));
+    ESP_RETURN_ON_FALSE(ppa_client, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(mode <= PPA_TRANS_MODE_NON_BLOCKING, ESP_ERR_INVALID_ARG, TAG, "invalid mode");
+    ppa_engine_t *ppa_engine_base = ppa_client->engine;
+
+    bool recording = false;
+    ppa_trans_t *first_trans = NULL;
+    ppa_trans_t *last_trans = NULL;
+    portENTER_CRITICAL(&ppa_client->spinlock);
+    recording = ppa_client->batch_recording;
+    ppa_client->batch_recording = false;
+    first_trans = STAILQ_FIRST(&ppa_client->batch_stailq);
+    if (first_trans) {
+        // Only the last transaction of the batch invokes the done callback
+        last_trans = STAILQ_LAST(&ppa_client->batch_stailq, ppa_trans_s, entry);
+        last_trans->notify = true;
+        last_trans->user_data = user_data;
+        // Send all the transactions into PPA engine queue at once
+        portENTER_CRITICAL(&ppa_engine_base->spinlock);
+        STAILQ_CONCAT(&ppa_engine_base->trans_stailq, &ppa_client->batch_stailq);
+        portEXIT_CRITICAL(&ppa_engine_base->spinlock);
+    }
+    portEXIT_CRITICAL(&ppa_client->spinlock);
+    ESP_RETURN_ON_FALSE(recording, ESP_ERR_INVALID_STATE, TAG, "client is not recording a batch");
+    if (!first_trans) {
+        return ESP_OK;
+    }
+
+    // The rest of the batch is started from the ISR, one after another, see `ppa_transaction_done_cb`
+    TickType_t ticks_to_wait = (mode == PPA_TRANS_MODE_NON_BLOCKING) ? 0 : portMAX_DELAY;
+    if (xSemaphoreTake(ppa_engine_base->sem, ticks_to_wait) == pdTRUE) {
+        // The batch was sent to the engine queue at once, so either none or all of its transactions have been processed from the ISR
+        bool found = false;
+        ppa_trans_t *temp = NULL;
+        portENTER_CRITICAL(&ppa_engine_base->spinlock);
+        STAILQ_FOREACH(temp, &ppa_engine_base->trans_stailq, entry) {
+            if (temp == first_trans) {
+                found = true;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&ppa_engine_base->spinlock);
+        if (found) {
+#if CONFIG_PM_ENABLE
+            pm_lock_ret = esp_pm_lock_acquire(ppa_engine_base->pm_lock);
+            assert((pm_lock_ret == ESP_OK) && "acquire pm_lock failed");
+#endif
+            ret = ppa_dma2d_enqueue(first_trans);
+            if (ret != ESP_OK) {
+                // None of the batch has been started, drop all of it
+                portENTER_CRITICAL(&ppa_client->spinlock);
+                portENTER_CRITICAL(&ppa_engine_base->spinlock);
+                ppa_trans_t *trans_elm = first_trans;
+                while (trans_elm) {
+                    ppa_trans_t *next_trans = (trans_elm == last_trans) ? NULL : STAILQ_NEXT(trans_elm, entry);
+                    STAILQ_REMOVE(&ppa_engine_base->trans_stailq, trans_elm, ppa_trans_s, entry);
+                    ppa_recycle_transaction(ppa_client, trans_elm);
+                    ppa_client->trans_cnt--;
+                    trans_elm = next_trans;
+                }
+                portEXIT_CRITICAL(&ppa_engine_base->spinlock);
+                portEXIT_CRITICAL(&ppa_client->spinlock);
+                xSemaphoreGive(ppa_engine_base->sem);
+#if CONFIG_PM_ENABLE
+                pm_lock_ret = esp_pm_lock_release(ppa_engine_base->pm_lock);
+                assert((pm_lock_ret == ESP_OK) && "release pm_lock failed");
+#endif
+                ESP_LOGE(TAG, "failed to start the batch");
+                return ESP_FAIL;
+            }
+        } else {
+            xSemaphoreGive(ppa_engine_base->sem);
+        }
+    }
+
+    if (mode == PPA_TRANS_MODE_BLOCKING) {
+        xSemaphoreTake(last_trans->sem, portMAX_DELAY); // Given in the ISR
+    }
+    return ESP_OK;
+}
+
 bool ppa_transaction_done_cb(dma2d_channel_handle_t dma2d_chan, dma2d_event_data_t *event_data, void *user_data)
 {
     bool need_yield = false;
@@ -472,7 +579,7 @@ bool ppa_transaction_done_cb(dma2d_channel_handle_t dma2d_chan, dma2d_event_data
     ppa_dma2d_trans_on_picked_config_t *trans_on_picked_desc = (ppa_dma2d_trans_on_picked_config_t *)trans_elm->trans_desc->user_config;
     ppa_engine_t *engine_base = trans_on_picked_desc->ppa_engine;
     // Save callback contexts
-    ppa_event_callback_t done_cb = client->done_cb;
+    ppa_event_callback_t done_cb = trans_elm->notify ? client->done_cb : NULL;
     void *trans_elm_user_data = trans_elm->user_data;
 
     ppa_trans_t *next_start_trans = NULL;
@@ -85,6 +85,8 @@ struct ppa_client_t {
     ppa_event_callback_t done_cb;                 // Transaction done callback
     QueueHandle_t trans_elm_ptr_queue;            // Queue that contains the pointers to the allocated memory to save the transaction contexts
     ppa_data_burst_length_t data_burst_length;    // The desired data burst length for all the transactions of the client
+    bool batch_recording;                         // Whether the transactions are recorded into the batch instead of being started
+    STAILQ_HEAD(batch, ppa_trans_s) batch_stailq; // link head of the recorded transactions, not yet sent to the PPA engine
 };
 
 /****************************** OPERATION ************************************/
@@ -192,6 +194,7 @@ typedef struct ppa_trans_s {
     SemaphoreHandle_t sem;                        // Semaphore to block when the transaction has not finished
     ppa_client_t *client;                         // Pointer to the client who requested the transaction
     void *user_data;                              // User registered event data (per transaction)
+    bool notify;                                  // Whether to invoke the done callback, only the last transaction of a batch does
 } ppa_trans_t;
 
 typedef struct {
@@ -531,6 +531,93 @@ TEST_CASE("ppa_fill_basic_data_correctness_check", "[PPA]")
     free(out_buf);
 }
 
+TEST_CASE("ppa_fill_batch_data_correctness_check", "[PPA]")
+{
+    const uint32_t w = 80;
+    const uint32_t h = 120;
+    const uint32_t batch_size = 4;
+    const uint32_t block_h = h / batch_size;
+    const ppa_fill_color_mode_t out_cm = PPA_FILL_COLOR_MODE_RGB565;
+    const color_pixel_argb8888_data_t fill_colors[] = {
+        {.a = 0xFF, .r = 0xFF, .g = 0x00, .b = 0x00},
+        {.a = 0xFF, .r = 0x00, .g = 0xFF, .b = 0x00},
+        {.a = 0xFF, .r = 0x00, .g = 0x00, .b = 0xFF},
+        {.a = 0xFF, .r = 0xFF, .g = 0x55, .b = 0xAA},
+    };
+
+    color_space_pixel_format_t out_pixel_format = {
+        .color_type_id = out_cm,
+    };
+
+    uint32_t out_pixel_depth = color_hal_pixel_format_get_bit_depth(out_pixel_format); // bits
+    uint32_t out_buf_len = w * h * out_pixel_depth / 8;
+    uint32_t out_buf_size = ALIGN_UP(out_buf_len, 64);
+    uint8_t *out_buf = heap_caps_aligned_calloc(4, out_buf_size, sizeof(uint8_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(out_buf);
+
+    memset(out_buf, 0xFF, out_buf_len);
+
+    ppa_client_handle_t ppa_client_handle;
+    ppa_client_config_t ppa_client_config = {
+        .oper_type = PPA_OPERATION_FILL,
+        .max_pending_trans_num = batch_size,
+    };
+    TEST_ESP_OK(ppa_register_client(&ppa_client_config, &ppa_client_handle));
+
+    ppa_event_callbacks_t cbs = {
+        .on_trans_done = ppa_trans_done_cb,
+    };
+    ppa_client_register_event_callbacks(ppa_client_handle, &cbs);
+
+    SemaphoreHandle_t sem = xSemaphoreCreateCounting(batch_size, 0);
+    TEST_ASSERT_NOT_NULL(sem);
+
+    // A batch must be started before being submitted, and can only be started once
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, ppa_client_submit_batch(ppa_client_handle, PPA_TRANS_MODE_NON_BLOCKING, (void *)sem));
+    TEST_ESP_OK(ppa_client_begin_batch(ppa_client_handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, ppa_client_begin_batch(ppa_client_handle));
+
+    // Record one fill operation per stripe of the picture
+    ppa_fill_oper_config_t oper_config = {
+        .out.buffer = out_buf,
+        .out.buffer_size = out_buf_size,
+        .out.pic_w = w,
+        .out.pic_h = h,
+        .out.block_offset_x = 0,
+        .out.fill_cm = out_cm,
+
+        .fill_block_w = w,
+        .fill_block_h = block_h,
+    };
+    for (int i = 0; i < batch_size; i++) {
+        oper_config.out.block_offset_y = i * block_h;
+        oper_config.fill_argb_color = fill_colors[i];
+        TEST_ESP_OK(ppa_do_fill(ppa_client_handle, &oper_config));
+    }
+    // The client can not hold more transactions than max_pending_trans_num
+    TEST_ESP_ERR(ESP_FAIL, ppa_do_fill(ppa_client_handle, &oper_config));
+
+    TEST_ESP_OK(ppa_client_submit_batch(ppa_client_handle, PPA_TRANS_MODE_NON_BLOCKING, (void *)sem));
+    // The done callback is only invoked once, for the whole batch
+    TEST_ASSERT(xSemaphoreTake(sem, pdMS_TO_TICKS(1000)) == pdTRUE);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(0, uxSemaphoreGetCount(sem));
+
+    // Check result
+    for (int i = 0; i < batch_size; i++) {
+        const color_pixel_rgb565_data_t fill_pixel_expected = {.r = fill_colors[i].r >> 3,
+                                                               .g = fill_colors[i].g >> 2,
+                                                               .b = fill_colors[i].b >> 3,
+                                                              };
+        TEST_ASSERT_EACH_EQUAL_UINT16(fill_pixel_expected.val, (void *)((uint32_t)out_buf + w * i * block_h * out_pixel_depth / 8), w * block_h);
+    }
+
+    TEST_ESP_OK(ppa_unregister_client(ppa_client_handle));
+
+    vSemaphoreDelete(sem);
+    free(out_buf);
+}
+
 /* All performance tests are tested under the following situations:
  * - Testing PPA speed where in_buffer(s) and out_buffer all located in PSRAM
  * - Only 2D-DMA is using PSRAM
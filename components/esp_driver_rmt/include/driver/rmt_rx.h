@@ -58,6 +58,9 @@ typedef struct {
     struct extra_rmt_receive_flags {
         uint32_t en_partial_rx: 1; /*!< Set this flag if the incoming data is very long, and the driver can only receive the data piece by piece,
                                         because the user buffer is not sufficient to save all the data. */
+        uint32_t en_continuous_rx: 1; /*!< Set this flag to keep receiving frames until the channel is disabled, without calling `rmt_receive()` again.
+                                           The receiver is re-armed in the ISR once a frame is received,
+                                           and the frames are saved in the two halves of the user buffer by turns */
     } flags;                       /*!< Receive specific config flags */
 } rmt_receive_config_t;
 
@@ -83,6 +86,9 @@ esp_err_t rmt_new_rx_channel(const rmt_rx_channel_config_t *config, rmt_channel_
  *       User should check the received data from the `on_recv_done` callback that registered by `rmt_rx_register_event_callbacks()`.
  * @note This function can also be called in ISR context.
  * @note If you want this function to work even when the flash cache is disabled, please enable the `CONFIG_RMT_RECV_FUNC_IN_IRAM` option.
+ * @note In the continuous receive mode (`rmt_receive_config_t::extra_rmt_receive_flags::en_continuous_rx`), the symbols of a frame
+ *       are valid until the next frame is received, as the frame after the next one is saved in the same half of the `buffer`.
+ *       The continuous receive mode is not supported by the channel with DMA.
  *
  * @param[in] rx_channel RMT RX channel that created by `rmt_new_rx_channel()`
  * @param[in] buffer The buffer to store the received RMT symbols
@@ -92,6 +98,7 @@ esp_err_t rmt_new_rx_channel(const rmt_rx_channel_config_t *config, rmt_channel_
  *      - ESP_OK: Initiate receive job successfully
  *      - ESP_ERR_INVALID_ARG: Initiate receive job failed because of invalid argument
  *      - ESP_ERR_INVALID_STATE: Initiate receive job failed because channel is not enabled
+ *      - ESP_ERR_NOT_SUPPORTED: Initiate receive job failed because the partial or continuous receive is not supported
  *      - ESP_FAIL: Initiate receive job failed because of other error
  */
 esp_err_t rmt_receive(rmt_channel_handle_t rx_channel, void *buffer, size_t buffer_size, const rmt_receive_config_t *config);
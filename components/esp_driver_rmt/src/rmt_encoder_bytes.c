@@ -13,11 +13,22 @@ typedef struct rmt_bytes_encoder_t {
     size_t last_byte_index; // index of the encoding byte in the primary stream
     rmt_symbol_word_t bit0; // bit zero representing
     rmt_symbol_word_t bit1; // bit one representing
+    rmt_symbol_word_t nibble_symbols[16][4]; // pre-encoded symbols of each nibble, in the sending order
     struct {
         uint32_t msb_first: 1; // encode MSB firstly
     } flags;
 } rmt_bytes_encoder_t;
 
+static void rmt_bytes_encoder_build_table(rmt_bytes_encoder_t *bytes_encoder)
+{
+    for (int nibble = 0; nibble < 16; nibble++) {
+        for (int i = 0; i < 4; i++) {
+            int bit = bytes_encoder->flags.msb_first ? 3 - i : i;
+            bytes_encoder->nibble_symbols[nibble][i] = (nibble & (1 << bit)) ? bytes_encoder->bit1 : bytes_encoder->bit0;
+        }
+    }
+}
+
 static esp_err_t rmt_bytes_encoder_reset(rmt_encoder_t *encoder)
 {
     rmt_bytes_encoder_t *bytes_encoder = __containerof(encoder, rmt_bytes_encoder_t, base);
@@ -65,6 +76,28 @@ static size_t IRAM_ATTR rmt_encode_bytes(rmt_encoder_t *encoder, rmt_channel_han
     }
 
     size_t len = encode_len;
+    // fast path: encode the whole bytes by looking up the pre-encoded nibbles
+    if (bit_index == 0) {
+        const rmt_symbol_word_t (*nibble_symbols)[4] = bytes_encoder->nibble_symbols;
+        bool msb_first = bytes_encoder->flags.msb_first;
+        while (len >= 8) {
+            uint8_t cur_byte = raw_data[byte_index++];
+            const rmt_symbol_word_t *first = nibble_symbols[msb_first ? cur_byte >> 4 : cur_byte & 0x0F];
+            const rmt_symbol_word_t *second = nibble_symbols[msb_first ? cur_byte & 0x0F : cur_byte >> 4];
+            rmt_symbol_word_t *dst = &mem_to_nc[tx_chan->mem_off];
+            dst[0] = first[0];
+            dst[1] = first[1];
+            dst[2] = first[2];
+            dst[3] = first[3];
+            dst[4] = second[0];
+            dst[5] = second[1];
+            dst[6] = second[2];
+            dst[7] = second[3];
+            tx_chan->mem_off += 8;
+            len -= 8;
+        }
+    }
+    // slow path: the byte truncated by the last round or by the memory boundary of this round
     while (len > 0) {
         // start from last time truncated encoding
         uint8_t cur_byte = raw_data[byte_index];
@@ -150,6 +183,7 @@ esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t *config, rmt_en
     encoder->bit0 = config->bit0;
     encoder->bit1 = config->bit1;
     encoder->flags.msb_first = config->flags.msb_first;
+    rmt_bytes_encoder_build_table(encoder);
     // return general encoder handle
     *ret_encoder = &encoder->base;
     ESP_LOGD(TAG, "new bytes encoder @%p", encoder);
@@ -164,5 +198,6 @@ esp_err_t rmt_bytes_encoder_update_config(rmt_encoder_handle_t bytes_encoder, co
     encoder->bit0 = config->bit0;
     encoder->bit1 = config->bit1;
     encoder->flags.msb_first = config->flags.msb_first;
+    rmt_bytes_encoder_build_table(encoder);
     return ESP_OK;
 }
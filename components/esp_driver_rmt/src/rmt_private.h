@@ -202,11 +202,13 @@ struct rmt_tx_channel_t {
 typedef struct {
     void *buffer;               // buffer for saving the received symbols
     size_t buffer_size;         // size of the buffer, in bytes
+    void *ring_buffer;          // in continuous receive mode, the user buffer, whose two halves are used by turns as `buffer`
     size_t received_symbol_num; // track the number of received symbols
     size_t copy_dest_off;       // tracking offset in the copy destination
     int dma_desc_index;         // tracking the DMA descriptor used by ping-pong
     struct {
         uint32_t en_partial_rx: 1; // packet is too long, we need to notify the user to process the data piece by piece, in a ping-pong approach
+        uint32_t en_continuous_rx: 1; // re-arm the receiver in the ISR after each frame
     } flags;
 } rmt_rx_trans_desc_t;
 
@@ -357,6 +357,7 @@ esp_err_t rmt_receive(rmt_channel_handle_t channel, void *buffer, size_t buffer_
 #if !SOC_RMT_SUPPORT_RX_PINGPONG
     ESP_RETURN_ON_FALSE_ISR(!config->flags.en_partial_rx, ESP_ERR_NOT_SUPPORTED, TAG, "partial receive not supported");
 #endif
+    ESP_RETURN_ON_FALSE_ISR(!(config->flags.en_continuous_rx && channel->dma_chan), ESP_ERR_NOT_SUPPORTED, TAG, "continuous receive not supported with DMA");
     rmt_rx_channel_t *rx_chan = __containerof(channel, rmt_rx_channel_t, base);
     size_t mem_alignment = sizeof(rmt_symbol_word_t);
 
@@ -376,6 +377,8 @@ esp_err_t rmt_receive(rmt_channel_handle_t channel, void *buffer, size_t buffer_
     uint32_t align_check_mask = mem_alignment - 1;
     ESP_RETURN_ON_FALSE_ISR(((((uintptr_t)buffer) & align_check_mask) == 0) && (((buffer_size) & align_check_mask) == 0), ESP_ERR_INVALID_ARG,
                             TAG, "buffer address or size are not %zu bytes aligned", mem_alignment);
+    ESP_RETURN_ON_FALSE_ISR(!config->flags.en_continuous_rx || buffer_size >= 2 * mem_alignment, ESP_ERR_INVALID_ARG,
+                            TAG, "buffer too small to be split for continuous receive");
 
     rmt_group_t *group = channel->group;
     rmt_hal_context_t *hal = &group->hal;
@@ -400,6 +403,12 @@ esp_err_t rmt_receive(rmt_channel_handle_t channel, void *buffer, size_t buffer_
     t->copy_dest_off = 0;
     t->dma_desc_index = 0;
     t->flags.en_partial_rx = config->flags.en_partial_rx;
+    t->flags.en_continuous_rx = config->flags.en_continuous_rx;
+    if (config->flags.en_continuous_rx) {
+        // the frames are saved in the two halves of the user buffer by turns
+        t->ring_buffer = buffer;
+        t->buffer_size = ALIGN_DOWN(buffer_size / 2, mem_alignment);
+    }
 
 #if SOC_RMT_SUPPORT_DMA
     if (channel->dma_chan) {
@@ -645,8 +654,19 @@ static bool IRAM_ATTR rmt_isr_handle_rx_done(rmt_rx_channel_t *rx_chan)
 
     trans_desc->copy_dest_off += copy_size;
     trans_desc->received_symbol_num += copy_size / sizeof(rmt_symbol_word_t);
-    // switch back to the enable state, then user can call `rmt_receive` to start a new receive
-    atomic_store(&channel->fsm, RMT_FSM_ENABLE);
+    if (trans_desc->flags.en_continuous_rx) {
+        // re-arm the receiver for the next frame right away, unless the channel is being disabled
+        portENTER_CRITICAL_ISR(&channel->spinlock);
+        if (atomic_load(&channel->fsm) == RMT_FSM_RUN) {
+            rmt_ll_rx_reset_pointer(hal->regs, channel_id);
+            rmt_ll_rx_enable(hal->regs, channel_id, true);
+        }
+        portEXIT_CRITICAL_ISR(&channel->spinlock);
+        rx_chan->mem_off = 0;
+    } else {
+        // switch back to the enable state, then user can call `rmt_receive` to start a new receive
+        atomic_store(&channel->fsm, RMT_FSM_ENABLE);
+    }
 
     // notify the user that all RMT symbols are received done
     if (cb) {
@@ -659,6 +679,17 @@ static bool IRAM_ATTR rmt_isr_handle_rx_done(rmt_rx_channel_t *rx_chan)
             need_yield = true;
         }
     }
+
+    if (trans_desc->flags.en_continuous_rx) {
+        // save the next frame in the other half of the user buffer, so the frame just received is kept intact meanwhile
+        if (trans_desc->buffer == trans_desc->ring_buffer) {
+            trans_desc->buffer = (uint8_t *)trans_desc->ring_buffer + trans_desc->buffer_size;
+        } else {
+            trans_desc->buffer = trans_desc->ring_buffer;
+        }
+        trans_desc->copy_dest_off = 0;
+        trans_desc->received_symbol_num = 0;
+    }
     return need_yield;
 }
 
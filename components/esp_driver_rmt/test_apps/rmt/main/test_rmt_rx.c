@@ -316,6 +316,82 @@ TEST_CASE("rmt rx boundary conditions", "[rmt]")
     test_rmt_partial_receive(SOC_RMT_MEM_WORDS_PER_CHANNEL, SOC_RMT_MEM_WORDS_PER_CHANNEL + 1, false, RMT_CLK_SRC_DEFAULT);
 }
 
+typedef struct {
+    size_t frame_num;
+    size_t symbol_num_err;
+    rmt_symbol_word_t *last_frame;
+} test_continuous_rx_user_data_t;
+
+TEST_RMT_CALLBACK_ATTR
+static bool test_rmt_continuous_receive_done(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata, void *user_data)
+{
+    test_continuous_rx_user_data_t *test_user_data = (test_continuous_rx_user_data_t *)user_data;
+    // the last symbol also contains the stop signal, count the frames that have unexpected length
+    if (edata->num_symbols != 20) {
+        test_user_data->symbol_num_err++;
+    }
+    // the frames should be saved in the two halves of the user buffer by turns
+    if (edata->received_symbols == test_user_data->last_frame) {
+        test_user_data->symbol_num_err++;
+    }
+    test_user_data->last_frame = edata->received_symbols;
+    test_user_data->frame_num++;
+    return false;
+}
+
+TEST_CASE("rmt rx continuous frames", "[rmt]")
+{
+    uint32_t const test_rx_buffer_symbols = 64;
+    rmt_symbol_word_t *receive_user_buf = heap_caps_aligned_calloc(64, test_rx_buffer_symbols, sizeof(rmt_symbol_word_t),
+                                                                   MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(receive_user_buf);
+
+    gpio_config_t sig_simulator_io_conf = {
+        .mode = GPIO_MODE_OUTPUT,
+        .pin_bit_mask = 1ULL << TEST_RMT_GPIO_NUM_A,
+    };
+    TEST_ESP_OK(gpio_config(&sig_simulator_io_conf));
+    TEST_ESP_OK(gpio_set_level(TEST_RMT_GPIO_NUM_A, 0));
+
+    rmt_rx_channel_config_t rx_channel_cfg = {
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = 1000000, // 1MHz, 1 tick = 1us
+        .mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL,
+        .gpio_num = TEST_RMT_GPIO_NUM_A,
+    };
+    rmt_channel_handle_t rx_channel = NULL;
+    TEST_ESP_OK(rmt_new_rx_channel(&rx_channel_cfg, &rx_channel));
+
+    rmt_rx_event_callbacks_t cbs = {
+        .on_recv_done = test_rmt_continuous_receive_done,
+    };
+    test_continuous_rx_user_data_t test_user_data = {};
+    TEST_ESP_OK(rmt_rx_register_event_callbacks(rx_channel, &cbs, &test_user_data));
+    TEST_ESP_OK(rmt_enable(rx_channel));
+
+    rmt_receive_config_t rx_config = {
+        .signal_range_min_ns = 1250,
+        .signal_range_max_ns = 1000000, // 1ms idle ends a frame
+        .flags.en_continuous_rx = true,
+    };
+    // only call `rmt_receive` once
+    TEST_ESP_OK(rmt_receive(rx_channel, receive_user_buf, test_rx_buffer_symbols * sizeof(rmt_symbol_word_t), &rx_config));
+    // the receiver is running until the channel is disabled
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, rmt_receive(rx_channel, receive_user_buf, test_rx_buffer_symbols * sizeof(rmt_symbol_word_t), &rx_config));
+
+    for (int i = 0; i < 10; i++) {
+        pwm_bit_bang(TEST_RMT_GPIO_NUM_A, 20);
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    printf("received %zu frames\r\n", test_user_data.frame_num);
+    TEST_ASSERT_EQUAL(10, test_user_data.frame_num);
+    TEST_ASSERT_EQUAL(0, test_user_data.symbol_num_err);
+
+    TEST_ESP_OK(rmt_disable(rx_channel));
+    TEST_ESP_OK(rmt_del_channel(rx_channel));
+    free(receive_user_buf);
+}
+
 #endif // SOC_RMT_SUPPORT_RX_PINGPONG
 
 TEST_RMT_CALLBACK_ATTR
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -130,6 +130,20 @@ esp_err_t sdio_slave_recv_unregister_buf(sdio_slave_buf_handle_t handle);
  */
 esp_err_t sdio_slave_recv_load_buf(sdio_slave_buf_handle_t handle);
 
+/** Load several buffers to the queue waiting to receive data, in this order.
+ *
+ * Same as calling ``sdio_slave_recv_load_buf`` for each of the buffers, with a single critical section and a single
+ * update of the receiving DMA and of the buffer counter seen by the host.
+ *
+ * @param handles Handles to the buffers ready to receive data.
+ * @param num Number of handles.
+ *
+ * @return
+ *     - ESP_ERR_INVALID_ARG    if handles is NULL, num is 0, or a handle is invalid or already in the queue. No buffer is loaded in this case.
+ *     - ESP_OK if success
+ */
+esp_err_t sdio_slave_recv_load_bufs(const sdio_slave_buf_handle_t *handles, size_t num);
+
 /** Get buffer of received data if exist with packet information. The driver returns the ownership of the buffer to the app.
  *
  * When you see return value is ``ESP_ERR_NOT_FINISHED``, you should call this API iteratively until the return value is ``ESP_OK``.
@@ -169,6 +183,32 @@ esp_err_t sdio_slave_recv_packet(sdio_slave_buf_handle_t* handle_ret, TickType_t
  */
 esp_err_t sdio_slave_recv(sdio_slave_buf_handle_t* handle_ret, uint8_t **out_addr, size_t *out_len, TickType_t wait);
 
+/** Get all the buffers of received data, up to a maximum number. The driver returns the ownership of the buffers to the app.
+ *
+ * Waits for the first buffer only, then returns it together with the other buffers already received, in the order they were
+ * received. Use ``sdio_slave_recv_get_buf`` to get the data of each buffer and ``sdio_slave_recv_is_packet_end`` to find the
+ * packet boundaries. The buffers can be loaded again all at once with ``sdio_slave_recv_load_bufs``.
+ *
+ * @param[out] handles_ret Handles to the buffers holding received data.
+ * @param max_num Maximum number of buffers to return, size of handles_ret.
+ * @param[out] ret_num Number of buffers returned.
+ * @param wait Time to wait before data received.
+ *
+ * @return
+ *     - ESP_ERR_INVALID_ARG    if handles_ret or ret_num is NULL, or max_num is 0
+ *     - ESP_ERR_TIMEOUT        if timeout before receiving new data
+ *     - ESP_OK if success
+ */
+esp_err_t sdio_slave_recv_packets(sdio_slave_buf_handle_t *handles_ret, size_t max_num, size_t *ret_num, TickType_t wait);
+
+/** Check whether a received buffer is the end of a packet from the host.
+ *
+ * @param handle Handle to a buffer returned by ``sdio_slave_recv_packets``.
+ *
+ * @return true if the buffer is the last one of a packet, false if the packet continues in the next buffer.
+ */
+bool sdio_slave_recv_is_packet_end(sdio_slave_buf_handle_t handle);
+
 /** Retrieve the buffer corresponding to a handle.
  *
  * @param handle Handle to get the buffer.
@@ -197,6 +237,29 @@ uint8_t* sdio_slave_recv_get_buf(sdio_slave_buf_handle_t handle, size_t *len_o);
  */
 esp_err_t sdio_slave_send_queue(uint8_t* addr, size_t len, void* arg, TickType_t wait);
 
+/// Buffer to send, used by ``sdio_slave_send_queue_bufs``
+typedef struct {
+    uint8_t *addr;  ///< Address for data to be sent. The buffer should be DMA capable and 32-bit aligned.
+    size_t len;     ///< Length of the data, should not be longer than 4092 bytes.
+    void *arg;      ///< Argument to returned in ``sdio_slave_send_get_finished``, set to NULL if not needed.
+} sdio_slave_send_buf_t;
+
+/** Put several sending transfers into the send queue, in this order.
+ *
+ * Same as calling ``sdio_slave_send_queue`` for each of the buffers, with a single critical section. All the buffers queued
+ * are added to the length of data the host can read, so the host can read all of them in one transfer.
+ *
+ * @param bufs Buffers to send. The driver takes ownership of each buffer until it is returned by ``sdio_slave_send_get_finished``.
+ * @param num Number of buffers, not greater than the ``send_queue_size`` of the driver configuration.
+ * @param wait Time to wait until the send queue has room for all the buffers.
+ *
+ * @return
+ *     - ESP_ERR_INVALID_ARG if bufs is NULL, num is invalid, or a buffer is invalid.
+ *     - ESP_ERR_TIMEOUT if the queue has no room for all the buffers until timeout. No buffer is queued in this case.
+ *     - ESP_OK if success.
+ */
+esp_err_t sdio_slave_send_queue_bufs(const sdio_slave_send_buf_t *bufs, size_t num, TickType_t wait);
+
 /** Return the ownership of a finished transaction.
  * @param out_arg Argument of the finished transaction. Set to NULL if unused.
  * @param wait Time to wait if there's no finished sending transaction.
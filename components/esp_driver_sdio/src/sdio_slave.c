@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -76,6 +76,7 @@ The driver of FIFOs works as below:
 */
 
 #include <string.h>
+#include <sys/param.h>
 
 #include "soc/soc_memory_layout.h"
 #include "soc/gpio_periph.h"
@@ -88,6 +89,7 @@ The driver of FIFOs works as below:
 #include "hal/gpio_hal.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "esp_private/periph_ctrl.h"
 #include "esp_private/gpio.h"
 #if CONFIG_PM_POWER_DOWN_PERIPHERAL_IN_LIGHT_SLEEP
@@ -625,6 +627,43 @@ esp_err_t sdio_slave_send_queue(uint8_t *addr, size_t len, void *arg, TickType_t
     return ESP_OK;
 }
 
+esp_err_t sdio_slave_send_queue_bufs(const sdio_slave_send_buf_t *bufs, size_t num, TickType_t wait)
+{
+    SDIO_SLAVE_CHECK(bufs != NULL && num > 0 && num <= (size_t)context.config.send_queue_size, "invalid buffer number", ESP_ERR_INVALID_ARG);
+    for (size_t i = 0; i < num; i++) {
+        SDIO_SLAVE_CHECK(bufs[i].len > 0, "len <= 0", ESP_ERR_INVALID_ARG);
+        SDIO_SLAVE_CHECK(esp_ptr_dma_capable(bufs[i].addr) && (uint32_t)bufs[i].addr % 4 == 0, "buffer to send should be DMA capable and 32-bit aligned",
+                         ESP_ERR_INVALID_ARG);
+    }
+
+    // reserve the room for all the buffers first, so that either all or none of them are queued
+    TimeOut_t timeout;
+    TickType_t remaining = wait;
+    vTaskSetTimeOutState(&timeout);
+    size_t reserved = 0;
+    while (reserved < num) {
+        if (xSemaphoreTake(context.remain_cnt, remaining) != pdTRUE) {
+            break;
+        }
+        reserved++;
+        xTaskCheckForTimeOut(&timeout, &remaining);
+    }
+    if (reserved < num) {
+        while (reserved--) {
+            xSemaphoreGive(context.remain_cnt);
+        }
+        return ESP_ERR_TIMEOUT;
+    }
+
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL(&context.write_spinlock);
+    for (size_t i = 0; i < num && ret == ESP_OK; i++) {
+        ret = sdio_slave_hal_send_queue(context.hal, bufs[i].addr, bufs[i].len, bufs[i].arg);
+    }
+    portEXIT_CRITICAL(&context.write_spinlock);
+    return ret;
+}
+
 esp_err_t sdio_slave_send_get_finished(void **out_arg, TickType_t wait)
 {
     void *arg = NULL;
@@ -754,6 +793,31 @@ esp_err_t sdio_slave_recv_load_buf(sdio_slave_buf_handle_t handle)
     return ESP_OK;
 }
 
+esp_err_t sdio_slave_recv_load_bufs(const sdio_slave_buf_handle_t *handles, size_t num)
+{
+    SDIO_SLAVE_CHECK(handles != NULL && num > 0, "invalid handles", ESP_ERR_INVALID_ARG);
+    for (size_t i = 0; i < num; i++) {
+        recv_desc_t *desc = (recv_desc_t *)handles[i];
+        CHECK_HANDLE_IDLE(desc);
+    }
+
+    // load the buffers by chunks, each chunk restarts the DMA once
+    sdio_slave_hal_recv_desc_t *hal_descs[16];
+    for (size_t start = 0; start < num; start += sizeof(hal_descs) / sizeof(hal_descs[0])) {
+        size_t chunk = MIN(num - start, sizeof(hal_descs) / sizeof(hal_descs[0]));
+        critical_enter_recv();
+        for (size_t i = 0; i < chunk; i++) {
+            recv_desc_t *desc = (recv_desc_t *)handles[start + i];
+            TAILQ_REMOVE(&context.recv_reg_list, desc, tail_entry);
+            desc->not_receiving = 0;
+            hal_descs[i] = &desc->hal_desc;
+        }
+        sdio_slave_hal_load_bufs(context.hal, hal_descs, chunk);
+        critical_exit_recv();
+    }
+    return ESP_OK;
+}
+
 sdio_slave_buf_handle_t sdio_slave_recv_register_buf(uint8_t *start)
 {
     SDIO_SLAVE_CHECK(esp_ptr_dma_capable(start) && (uint32_t)start % 4 == 0,
@@ -815,6 +879,40 @@ esp_err_t sdio_slave_recv_packet(sdio_slave_buf_handle_t *handle_ret, TickType_t
     return ret;
 }
 
+esp_err_t sdio_slave_recv_packets(sdio_slave_buf_handle_t *handles_ret, size_t max_num, size_t *ret_num, TickType_t wait)
+{
+    SDIO_SLAVE_CHECK(handles_ret != NULL && ret_num != NULL && max_num > 0, "invalid argument", ESP_ERR_INVALID_ARG);
+    *ret_num = 0;
+    BaseType_t err = xSemaphoreTake(context.recv_event, wait);
+    if (err == pdFALSE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    // the buffers received together with the first one don't need to wait
+    size_t num = 1;
+    while (num < max_num && xSemaphoreTake(context.recv_event, 0) == pdTRUE) {
+        num++;
+    }
+
+    critical_enter_recv();
+    for (size_t i = 0; i < num; i++) {
+        //remove from queue, add back to reg list.
+        recv_desc_t *desc = (recv_desc_t *)sdio_slave_hal_recv_unload_desc(context.hal);
+        assert(desc != NULL && desc->hal_desc.owner == 0);
+        TAILQ_INSERT_TAIL(&context.recv_reg_list, desc, tail_entry);
+        handles_ret[i] = (sdio_slave_buf_handle_t)desc;
+    }
+    critical_exit_recv();
+
+    *ret_num = num;
+    return ESP_OK;
+}
+
+bool sdio_slave_recv_is_packet_end(sdio_slave_buf_handle_t handle)
+{
+    recv_desc_t *desc = (recv_desc_t *)handle;
+    return desc != NULL && desc->hal_desc.eof;
+}
+
 esp_err_t sdio_slave_recv_unregister_buf(sdio_slave_buf_handle_t handle)
 {
     recv_desc_t *desc = (recv_desc_t *)handle;
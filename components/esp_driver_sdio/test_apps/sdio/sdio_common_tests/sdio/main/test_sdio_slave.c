@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -181,7 +181,7 @@ TEST_CASE("SDIO_Slave: test fixed addr", "[sdio]")
 /*---------------------------------------------------------------
                 From Host Tests
 ---------------------------------------------------------------*/
-static void test_from_host(bool check_data)
+static void test_from_host(bool check_data, bool bulk)
 {
     //prepare buffer
     test_prepare_buffer_pool(TEST_RX_BUFFER_SIZE * 4, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
@@ -202,28 +202,44 @@ static void test_from_host(bool check_data)
         for (int j = 0; j < TEST_SLAVE_TRANS_BUF_NUMS; j++) {
             buf_handle[j] = sdio_slave_recv_register_buf(slave_rx_buffer[j]);
             TEST_ASSERT(buf_handle[j]);
-            TEST_ESP_OK(sdio_slave_recv_load_buf(buf_handle[j]));
+            if (!bulk) {
+                TEST_ESP_OK(sdio_slave_recv_load_buf(buf_handle[j]));
+            }
         }
 
-        void *tx_buf_ptr = NULL;
-        for (int j = 0; j < TEST_TRANS_NUMS; j++) {
-            ESP_LOGD(TAG, "j: %d", j);
-
-            sdio_slave_buf_handle_t used_buf_handle = NULL;
-            uint8_t* buf = NULL;
-            size_t rcv_len = 0;
-
-            TEST_ESP_OK(sdio_slave_recv(&used_buf_handle, &buf, &rcv_len, portMAX_DELAY));
-            ESP_LOGD(TAG, "rcv_len: 0d%d", rcv_len);
-            ESP_LOG_BUFFER_HEX_LEVEL(TAG, buf, TEST_RX_BUFFER_SIZE, TEST_HEX_LOG_LEVEL);
-
-            if (check_data) {
-                test_get_buffer_from_pool(j, TEST_RX_BUFFER_SIZE, &tx_buf_ptr);
-                ESP_LOG_BUFFER_HEX_LEVEL("Expect data", tx_buf_ptr, TEST_RX_BUFFER_SIZE, TEST_HEX_LOG_LEVEL);
-                TEST_ASSERT_EQUAL_HEX8_ARRAY(tx_buf_ptr, buf, rcv_len);
+        if (bulk) {
+            //load all the buffers at once, and recycle the received ones in batches
+            TEST_ESP_OK(sdio_slave_recv_load_bufs(buf_handle, TEST_SLAVE_TRANS_BUF_NUMS));
+            int received = 0;
+            while (received < TEST_TRANS_NUMS) {
+                size_t num = 0;
+                TEST_ESP_OK(sdio_slave_recv_packets(buf_handle, TEST_SLAVE_TRANS_BUF_NUMS, &num, portMAX_DELAY));
+                TEST_ASSERT(num > 0);
+                received += num;
+                TEST_ESP_OK(sdio_slave_recv_load_bufs(buf_handle, num));
             }
+            TEST_ASSERT_EQUAL(TEST_TRANS_NUMS, received);
+        } else {
+            void *tx_buf_ptr = NULL;
+            for (int j = 0; j < TEST_TRANS_NUMS; j++) {
+                ESP_LOGD(TAG, "j: %d", j);
+
+                sdio_slave_buf_handle_t used_buf_handle = NULL;
+                uint8_t* buf = NULL;
+                size_t rcv_len = 0;
+
+                TEST_ESP_OK(sdio_slave_recv(&used_buf_handle, &buf, &rcv_len, portMAX_DELAY));
+                ESP_LOGD(TAG, "rcv_len: 0d%d", rcv_len);
+                ESP_LOG_BUFFER_HEX_LEVEL(TAG, buf, TEST_RX_BUFFER_SIZE, TEST_HEX_LOG_LEVEL);
+
+                if (check_data) {
+                    test_get_buffer_from_pool(j, TEST_RX_BUFFER_SIZE, &tx_buf_ptr);
+                    ESP_LOG_BUFFER_HEX_LEVEL("Expect data", tx_buf_ptr, TEST_RX_BUFFER_SIZE, TEST_HEX_LOG_LEVEL);
+                    TEST_ASSERT_EQUAL_HEX8_ARRAY(tx_buf_ptr, buf, rcv_len);
+                }
 
-            TEST_ESP_OK(sdio_slave_recv_load_buf(used_buf_handle));
+                TEST_ESP_OK(sdio_slave_recv_load_buf(used_buf_handle));
+            }
         }
 
         wait_for_finish(&s_test_slv_ctx);
@@ -239,12 +255,12 @@ static void test_from_host(bool check_data)
 
 TEST_CASE("SDIO_Slave: test from host", "[sdio]")
 {
-    test_from_host(true);
+    test_from_host(true, false);
 }
 
 TEST_CASE("SDIO_Slave: test from host (Performance)", "[sdio_speed]")
 {
-    test_from_host(false);
+    test_from_host(false, true);
 }
 
 /*---------------------------------------------------------------
@@ -99,7 +99,8 @@ static void do_single_rw_perf_test(sdmmc_card_t* card, size_t start_block,
 
 void sdmmc_test_rw_unaligned_buffer(sdmmc_card_t* card)
 {
-    const size_t buffer_size = 4096;
+    // larger than the temporary buffer used by the driver, so that the transfers are split
+    const size_t buffer_size = 8192;
     const size_t block_count = buffer_size / 512;
     const size_t extra = 4;
     const size_t total_size = buffer_size + extra;
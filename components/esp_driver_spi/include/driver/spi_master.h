@@ -221,6 +221,34 @@ esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
  */
 esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait);
 
+/**
+ * @brief Queue a list of SPI transactions for interrupt transaction execution. Get the results by ``spi_device_get_trans_result``.
+ *
+ * The transactions are executed in the order of the list, the same as if they were queued one by one by ``spi_device_queue_trans``.
+ * However, the ISR is invoked only once for the whole list instead of once per transaction, and all the transactions are checked
+ * before any of them is queued. With ``CONFIG_SPI_MASTER_ISR_CHAIN_MAX_US`` enabled, the short transactions of the list are also
+ * executed by the ISR one after another, without an interrupt per transaction.
+ *
+ * @note When the queue gets full, the transactions queued so far are started and the function waits for room in the queue.
+ *       As the results are returned to a queue of ``queue_size`` too, the list should not be longer than the ``queue_size``
+ *       of the device, unless the flag ``SPI_DEVICE_NO_RETURN_RESULT`` is set or the results are got by another task meanwhile.
+ *
+ * @param handle Device handle obtained using spi_bus_add_device()
+ * @param trans_descs Array of pointers to the descriptions of the transactions to execute
+ * @param trans_num Number of the transactions in the array
+ * @param[out] queued_num Number of the transactions queued, the results of these transactions need to be got by
+ *                        ``spi_device_get_trans_result`` even if the function fails. Can be NULL.
+ * @param ticks_to_wait Ticks to wait until there's room in the queue for each transaction; use portMAX_DELAY to
+ *                      never time out.
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid, see ``spi_device_queue_trans``. In this case, no transaction is queued.
+ *         - ESP_ERR_TIMEOUT       if there was no room in the queue before ticks_to_wait expired
+ *         - ESP_ERR_NO_MEM        if allocating DMA-capable temporary buffer failed
+ *         - ESP_ERR_INVALID_STATE if previous transactions are not finished
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_queue_trans_batch(spi_device_handle_t handle, spi_transaction_t **trans_descs, uint32_t trans_num, uint32_t *queued_num, TickType_t ticks_to_wait);
+
 /**
  * @brief Get the result of a SPI transaction queued earlier by ``spi_device_queue_trans``.
  *
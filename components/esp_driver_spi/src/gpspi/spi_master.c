@@ -151,6 +151,11 @@ We have two bits to control the interrupt:
 #define SPI_MASTER_PERI_CLOCK_ATOMIC()
 #endif
 
+#if CONFIG_SPI_MASTER_ISR_CHAIN_MAX_US
+// Upper limit of the transactions executed in one ISR invocation, so that the ISR returns from time to time under a constant load
+#define SPI_MASTER_ISR_CHAIN_MAX_NUM    32
+#endif
+
 static const char *SPI_TAG = "spi_master";
 #define SPI_CHECK(a, str, ret_val, ...)  ESP_RETURN_ON_FALSE_ISR(a, ret_val, SPI_TAG, str, ##__VA_ARGS__)
 
@@ -227,6 +232,9 @@ struct spi_device_t {
     spi_hal_dev_config_t hal_dev;
     spi_host_t *host;
     spi_bus_lock_dev_handle_t dev_lock;
+#if CONFIG_SPI_MASTER_ISR_CHAIN_MAX_US
+    uint32_t isr_chain_max_bits;    //transactions not longer than this (in SPI clock cycles) are waited for in the ISR
+#endif
 };
 
 static spi_host_t* bus_driver_ctx[SOC_SPI_PERIPH_NUM] = {};
@@ -552,6 +560,9 @@ esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interfa
     hal_dev->as_cs = dev_config->flags & SPI_DEVICE_CLK_AS_CS ? 1 : 0;
 #endif
     hal_dev->positive_cs = dev_config->flags & SPI_DEVICE_POSITIVE_CS ? 1 : 0;
+#if CONFIG_SPI_MASTER_ISR_CHAIN_MAX_US
+    dev->isr_chain_max_bits = (uint64_t)CONFIG_SPI_MASTER_ISR_CHAIN_MAX_US * temp_timing_conf.real_freq / 1000000;
+#endif
 
     *handle = dev;
     ESP_LOGD(SPI_TAG, "SPI%d: New device added to CS%d, effective clock: %d Hz", host_id + 1, freecs, temp_timing_conf.real_freq);
@@ -919,6 +930,23 @@ static void SPI_MASTER_ISR_ATTR spi_post_sct_trans(spi_host_t *host)
 }
 #endif  //#if SOC_SPI_SCT_SUPPORTED
 
+#if CONFIG_SPI_MASTER_ISR_CHAIN_MAX_US
+// Check whether the transaction is short enough for the ISR to wait until it's done, instead of returning and being invoked again.
+// The length is an upper bound of the SPI clock cycles, the data phase is counted as if only one line was used.
+static inline bool SPI_MASTER_ISR_ATTR spi_trans_can_chain(spi_device_t *dev, const spi_transaction_t *trans)
+{
+    const spi_transaction_ext_t *t_ext = (const spi_transaction_ext_t *)trans;
+    uint32_t bits = dev->hal_dev.cs_setup + dev->hal_dev.cs_hold;
+
+    bits += (trans->flags & SPI_TRANS_VARIABLE_CMD) ? t_ext->command_bits : dev->cfg.command_bits;
+    bits += (trans->flags & SPI_TRANS_VARIABLE_ADDR) ? t_ext->address_bits : dev->cfg.address_bits;
+    bits += (trans->flags & SPI_TRANS_VARIABLE_DUMMY) ? t_ext->dummy_bits : dev->cfg.dummy_bits;
+    //Write and Read phases are sequential in half duplex mode, in full duplex mode rxlength is not longer than length
+    bits += dev->hal_dev.half_duplex ? trans->length + trans->rxlength : trans->length;
+    return bits <= dev->isr_chain_max_bits;
+}
+#endif
+
 // This is run in interrupt context.
 static void SPI_MASTER_ISR_ATTR spi_intr(void *arg)
 {
@@ -944,7 +972,12 @@ static void SPI_MASTER_ISR_ATTR spi_intr(void *arg)
      * (d) -> (a) -> (b) -> (c), and in this case the interrupt is disabled while there's pending BG request in the queue.
      * To avoid this, interrupt is disabled here, and re-enabled later if required.
      */
-    if (!spi_bus_lock_bg_entry(bus_attr->lock)) {
+    bool trans_in_flight = !spi_bus_lock_bg_entry(bus_attr->lock);
+#if CONFIG_SPI_MASTER_ISR_CHAIN_MAX_US
+    int chain_num = 0;
+isr_chain:
+#endif
+    if (trans_in_flight) {
         /*------------ deal with the in-flight transaction -----------------*/
         assert(host->cur_cs != DEV_NUM_MAX);
         //Okay, transaction is done.
@@ -1052,6 +1085,16 @@ static void SPI_MASTER_ISR_ATTR spi_intr(void *arg)
                 }
 #endif  //#if CONFIG_IDF_TARGET_ESP32
                 spi_new_trans(device_to_send, cur_trans_buf);
+#if CONFIG_SPI_MASTER_ISR_CHAIN_MAX_US
+                if (++chain_num < SPI_MASTER_ISR_CHAIN_MAX_NUM && spi_trans_can_chain(device_to_send, cur_trans_buf->trans)) {
+                    //The ISR stays entered and the interrupt disabled, wait here for the short transaction to be done
+                    //and go on with the next one right away, rather than spending an interrupt on it.
+                    while (!spi_hal_usr_is_done(&host->hal)) {
+                    }
+                    trans_in_flight = true;
+                    goto isr_chain;
+                }
+#endif
             }
         }
 
@@ -1272,6 +1315,72 @@ clean_up:
     return ret;
 }
 
+esp_err_t SPI_MASTER_ATTR spi_device_queue_trans_batch(spi_device_handle_t handle, spi_transaction_t **trans_descs, uint32_t trans_num, uint32_t *queued_num, TickType_t ticks_to_wait)
+{
+    esp_err_t ret = ESP_OK;
+    uint32_t num = 0;
+    bool bg_pending = false;
+
+    if (queued_num) {
+        *queued_num = 0;
+    }
+    SPI_CHECK(handle != NULL, "invalid dev handle", ESP_ERR_INVALID_ARG);
+    SPI_CHECK(trans_descs != NULL && trans_num > 0, "invalid transaction list", ESP_ERR_INVALID_ARG);
+    spi_host_t *host = handle->host;
+
+    SPI_CHECK(!spi_bus_device_is_polling(handle), "Cannot queue new transaction while previous polling transaction is not terminated.", ESP_ERR_INVALID_STATE);
+
+    //check the whole list first, so that an invalid transaction doesn't leave the list partly queued
+    for (uint32_t i = 0; i < trans_num; i++) {
+        ret = check_trans_valid(handle, trans_descs[i]);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        if (host->device_acquiring_lock != handle && (trans_descs[i]->flags & SPI_TRANS_CS_KEEP_ACTIVE)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    for (; num < trans_num; num++) {
+        spi_trans_priv_t trans_buf = { .trans = trans_descs[num], };
+        ret = setup_priv_desc(host, &trans_buf);
+        if (ret != ESP_OK) {
+            break;
+        }
+
+#ifdef CONFIG_PM_ENABLE
+        esp_pm_lock_acquire(host->bus_attr->pm_lock);
+#endif
+        BaseType_t r = xQueueSend(handle->trans_queue, (void *)&trans_buf, 0);
+        if (!r) {
+            //the queue is full, let the ISR start the transactions queued so far before waiting for room in it
+            if (bg_pending) {
+                spi_bus_lock_bg_request(handle->dev_lock);
+                bg_pending = false;
+            }
+            r = xQueueSend(handle->trans_queue, (void *)&trans_buf, ticks_to_wait);
+        }
+        if (!r) {
+            ret = ESP_ERR_TIMEOUT;
+#ifdef CONFIG_PM_ENABLE
+            esp_pm_lock_release(host->bus_attr->pm_lock);
+#endif
+            uninstall_priv_desc(&trans_buf);
+            break;
+        }
+        bg_pending = true;
+    }
+
+    // The ISR will be invoked at correct time by the lock with `spi_bus_intr_enable`, once for all the queued transactions.
+    if (bg_pending) {
+        spi_bus_lock_bg_request(handle->dev_lock);
+    }
+    if (queued_num) {
+        *queued_num = num;
+    }
+    return ret;
+}
+
 esp_err_t SPI_MASTER_ATTR spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait)
 {
     BaseType_t r;
@@ -356,6 +356,55 @@ TEST_CASE("SPI Master test", "[spi]")
     TEST_ASSERT(success);
 }
 
+#define TEST_BATCH_NUM  8
+static void spi_test_trans_batch(bool dma)
+{
+    spi_bus_config_t buscfg = SPI_BUS_TEST_DEFAULT_CONFIG();
+    buscfg.miso_io_num = PIN_NUM_MOSI;
+    spi_device_interface_config_t devcfg = SPI_DEVICE_TEST_DEFAULT_CONFIG();
+    devcfg.queue_size = TEST_BATCH_NUM;
+    spi_device_handle_t handle;
+    TEST_ESP_OK(spi_bus_initialize(TEST_SPI_HOST, &buscfg, dma ? SPI_DMA_CH_AUTO : SPI_DMA_DISABLED));
+    TEST_ESP_OK(spi_bus_add_device(TEST_SPI_HOST, &devcfg, &handle));
+    //connect MOSI to two devices breaks the output, fix it.
+    spitest_gpio_output_sel(PIN_NUM_MOSI, FUNC_GPIO, spi_periph_signal[TEST_SPI_HOST].spid_out);
+
+    spi_transaction_t trans[TEST_BATCH_NUM] = {};
+    spi_transaction_t *trans_list[TEST_BATCH_NUM];
+    uint32_t queued_num = 0;
+    for (int i = 0; i < TEST_BATCH_NUM; i++) {
+        trans[i].length = 4 * 8;
+        trans[i].flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA;
+        *(uint32_t *)trans[i].tx_data = 0x5a000000 | (i << 16) | (rand() & 0xffff);
+        trans_list[i] = &trans[i];
+    }
+
+    //an invalid transaction in the list, nothing is queued
+    trans[TEST_BATCH_NUM - 1].rxlength = 64;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, spi_device_queue_trans_batch(handle, trans_list, TEST_BATCH_NUM, &queued_num, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(0, queued_num);
+    trans[TEST_BATCH_NUM - 1].rxlength = 0;
+
+    TEST_ESP_OK(spi_device_queue_trans_batch(handle, trans_list, TEST_BATCH_NUM, &queued_num, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(TEST_BATCH_NUM, queued_num);
+    //results are returned in the order of the list
+    for (int i = 0; i < TEST_BATCH_NUM; i++) {
+        spi_transaction_t *ret_trans;
+        TEST_ESP_OK(spi_device_get_trans_result(handle, &ret_trans, portMAX_DELAY));
+        TEST_ASSERT_EQUAL_PTR(&trans[i], ret_trans);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(trans[i].tx_data, trans[i].rx_data, 4);
+    }
+    master_free_device_bus(handle);
+}
+
+TEST_CASE("SPI Master queue transaction batch", "[spi]")
+{
+    printf("Testing batch with DMA\n");
+    spi_test_trans_batch(true);
+    printf("Testing batch without DMA\n");
+    spi_test_trans_batch(false);
+}
+
 TEST_CASE("SPI Master test, interaction of multiple devs", "[spi]")
 {
     esp_err_t ret;
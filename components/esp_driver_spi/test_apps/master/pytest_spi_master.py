@@ -11,6 +11,7 @@ from pytest_embedded_idf.utils import idf_parametrize
     [
         'release',
         'freertos_flash',
+        'isr_chain',
     ],
     indirect=True,
 )
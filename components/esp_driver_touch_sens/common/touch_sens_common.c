@@ -48,11 +48,28 @@ static void touch_channel_pin_init(int id)
     gpio_config_as_analog(pin);
 }
 
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+static void s_touch_free_scan_buffer(touch_scan_buffer_t *scan_buf)
+{
+    if (!scan_buf) {
+        return;
+    }
+    if (scan_buf->sem) {
+        vSemaphoreDeleteWithCaps(scan_buf->sem);
+    }
+    free(scan_buf);
+}
+#endif
+
 static void s_touch_free_resource(touch_sensor_handle_t sens_handle)
 {
     if (!sens_handle) {
         return;
     }
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+    s_touch_free_scan_buffer(sens_handle->scan_buf);
+    sens_handle->scan_buf = NULL;
+#endif
     if (sens_handle->mutex) {
         vSemaphoreDeleteWithCaps(sens_handle->mutex);
         sens_handle->mutex = NULL;
@@ -446,6 +463,126 @@ esp_err_t touch_channel_read_data(touch_channel_handle_t chan_handle, touch_chan
     return touch_priv_channel_read_data(chan_handle, type, data);
 }
 
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+esp_err_t touch_sensor_config_scan_buffer(touch_sensor_handle_t sens_handle, const touch_scan_buffer_config_t *buf_cfg)
+{
+    TOUCH_NULL_POINTER_CHECK(sens_handle);
+    if (buf_cfg) {
+        ESP_RETURN_ON_FALSE(buf_cfg->scan_num > 0, ESP_ERR_INVALID_ARG, TAG, "The scan number should be greater than 0");
+    }
+
+    esp_err_t ret = ESP_OK;
+    touch_scan_buffer_t *scan_buf = NULL;
+    xSemaphoreTakeRecursive(sens_handle->mutex, portMAX_DELAY);
+    TOUCH_GOTO_ON_FALSE_FSM(!sens_handle->is_enabled, ESP_ERR_INVALID_STATE, err, TAG, "Please disable the touch sensor first");
+    if (buf_cfg) {
+        scan_buf = heap_caps_calloc(1, sizeof(touch_scan_buffer_t) + buf_cfg->scan_num * sizeof(touch_scan_data_t), TOUCH_MEM_ALLOC_CAPS);
+        ESP_GOTO_ON_FALSE(scan_buf, ESP_ERR_NO_MEM, err, TAG, "No memory for the scan buffer");
+        scan_buf->sem = xSemaphoreCreateBinaryWithCaps(TOUCH_MEM_ALLOC_CAPS);
+        ESP_GOTO_ON_FALSE(scan_buf->sem, ESP_ERR_NO_MEM, err, TAG, "No memory for the scan buffer semaphore");
+        scan_buf->len = buf_cfg->scan_num;
+        scan_buf->read_benchmark = buf_cfg->flags.read_benchmark;
+        scan_buf->wakeup_on_change = buf_cfg->flags.wakeup_on_change;
+    }
+    TOUCH_ENTER_CRITICAL(TOUCH_PERIPH_LOCK);
+    touch_scan_buffer_t *old_buf = sens_handle->scan_buf;
+    sens_handle->scan_buf = scan_buf;
+    TOUCH_EXIT_CRITICAL(TOUCH_PERIPH_LOCK);
+    scan_buf = old_buf;
+
+err:
+    s_touch_free_scan_buffer(scan_buf);
+    xSemaphoreGiveRecursive(sens_handle->mutex);
+    return ret;
+}
+
+esp_err_t touch_sensor_read_scan_data(touch_sensor_handle_t sens_handle, touch_scan_data_t *scans, uint32_t max_scans,
+                                      uint32_t *ret_scans, int timeout_ms)
+{
+    TOUCH_NULL_POINTER_CHECK(sens_handle);
+    TOUCH_NULL_POINTER_CHECK(scans);
+    TOUCH_NULL_POINTER_CHECK(ret_scans);
+    ESP_RETURN_ON_FALSE(max_scans > 0, ESP_ERR_INVALID_ARG, TAG, "The scan number should be greater than 0");
+    touch_scan_buffer_t *scan_buf = sens_handle->scan_buf;
+    ESP_RETURN_ON_FALSE(scan_buf, ESP_ERR_INVALID_STATE, TAG, "The scan buffer is not configured");
+
+    TickType_t ticks = timeout_ms < 0 ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    TimeOut_t timeout;
+    vTaskSetTimeOutState(&timeout);
+    uint32_t num = 0;
+    while (true) {
+        /* Copy one scan at a time, to keep the critical section short */
+        while (num < max_scans) {
+            TOUCH_ENTER_CRITICAL(TOUCH_PERIPH_LOCK);
+            bool has_scan = scan_buf->has_event && scan_buf->cnt > 0;
+            if (has_scan) {
+                memcpy(&scans[num], &scan_buf->scans[scan_buf->read], sizeof(touch_scan_data_t));
+                scan_buf->read = scan_buf->read + 1 == scan_buf->len ? 0 : scan_buf->read + 1;
+                scan_buf->cnt--;
+            }
+            /* Keep the rest ready if the scans array is not long enough to read all of them */
+            scan_buf->has_event = scan_buf->cnt > 0 && scan_buf->has_event;
+            TOUCH_EXIT_CRITICAL(TOUCH_PERIPH_LOCK);
+            if (!has_scan) {
+                break;
+            }
+            num++;
+        }
+        if (num > 0 || xTaskCheckForTimeOut(&timeout, &ticks) == pdTRUE || xSemaphoreTake(scan_buf->sem, ticks) != pdTRUE) {
+            break;
+        }
+    }
+    *ret_scans = num;
+    return num > 0 ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+bool IRAM_ATTR touch_priv_save_scan_data(uint32_t active_mask)
+{
+    touch_scan_buffer_t *scan_buf = g_touch->scan_buf;
+    BaseType_t need_yield = pdFALSE;
+
+    TOUCH_ENTER_CRITICAL_SAFE(TOUCH_PERIPH_LOCK);
+    /* Overwrite the oldest scan when the buffer is full */
+    if (scan_buf->cnt == scan_buf->len) {
+        scan_buf->read = scan_buf->read + 1 == scan_buf->len ? 0 : scan_buf->read + 1;
+        scan_buf->cnt--;
+    }
+    uint32_t idx = scan_buf->read + scan_buf->cnt;
+    idx = idx >= scan_buf->len ? idx - scan_buf->len : idx;
+    touch_scan_data_t *scan = &scan_buf->scans[idx];
+    scan->seq = scan_buf->seq++;
+    scan->active_mask = active_mask;
+    FOR_EACH_TOUCH_CHANNEL(i) {
+        if (!g_touch->ch[i]) {
+            continue;
+        }
+#if SOC_TOUCH_SENSOR_VERSION == 2
+        touch_ll_read_chan_data(i, TOUCH_LL_READ_SMOOTH, &scan->smooth_data[i][0]);
+        if (scan_buf->read_benchmark) {
+            touch_ll_read_chan_data(i, TOUCH_LL_READ_BENCHMARK, &scan->benchmark[i][0]);
+        }
+#else
+        for (int j = 0; j < g_touch->sample_cfg_num; j++) {
+            touch_ll_read_chan_data(i, j, TOUCH_LL_READ_SMOOTH, &scan->smooth_data[i][j]);
+            if (scan_buf->read_benchmark) {
+                touch_ll_read_chan_data(i, j, TOUCH_LL_READ_BENCHMARK, &scan->benchmark[i][j]);
+            }
+        }
+#endif
+    }
+    scan_buf->cnt++;
+    bool notify = !scan_buf->wakeup_on_change || active_mask != scan_buf->last_active_mask;
+    scan_buf->last_active_mask = active_mask;
+    scan_buf->has_event |= notify;
+    TOUCH_EXIT_CRITICAL_SAFE(TOUCH_PERIPH_LOCK);
+
+    if (notify) {
+        xSemaphoreGiveFromISR(scan_buf->sem, &need_yield);
+    }
+    return need_yield == pdTRUE;
+}
+#endif  // SOC_TOUCH_SENSOR_VERSION >= 2
+
 /******************************************************************************/
 /*                            Scope: Private APIs                             */
 /******************************************************************************/
@@ -78,6 +78,25 @@ extern portMUX_TYPE g_touch_spinlock;
 #define TOUCH_ENTER_CRITICAL_SAFE(spinlock)     portENTER_CRITICAL_SAFE(spinlock)
 #define TOUCH_EXIT_CRITICAL_SAFE(spinlock)      portEXIT_CRITICAL_SAFE(spinlock)
 
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+/**
+ * @brief The ring buffer of the scan data
+ *
+ */
+typedef struct {
+    SemaphoreHandle_t       sem;                        /*!< Binary semaphore to wake up the reader */
+    uint32_t                len;                        /*!< The number of scans that the buffer can hold */
+    uint32_t                read;                       /*!< The index of the oldest scan in the buffer */
+    uint32_t                cnt;                        /*!< The number of scans in the buffer */
+    uint32_t                seq;                        /*!< The sequence number of the next scan */
+    uint32_t                last_active_mask;           /*!< The active channel mask of the last scan */
+    bool                    read_benchmark;             /*!< Whether to store the benchmark data */
+    bool                    wakeup_on_change;           /*!< Whether to wake up the reader only when the active channel mask changes */
+    bool                    has_event;                  /*!< Whether the scans in the buffer are ready for the reader */
+    touch_scan_data_t       scans[];                    /*!< The scan data */
+} touch_scan_buffer_t;
+#endif
+
 /**
  * @brief The touch sensor controller instance structure
  * @note  A touch sensor controller includes multiple channels and sample configurations
@@ -94,6 +113,9 @@ struct touch_sensor_s {
     touch_channel_handle_t  guard_chan;                 /*!< The configured channel for the guard ring, will be NULL if not set */
     touch_channel_handle_t  shield_chan;                /*!< The configured channel for the shield pad, will be NULL if not set */
 #endif
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+    touch_scan_buffer_t     *scan_buf;                  /*!< The buffer of the scan data, will be NULL if the scan buffer is not configured */
+#endif
 #if SOC_TOUCH_SENSOR_VERSION == 1
     uint32_t                timer_interval_ms;          /*!< Timer interval in milliseconds for software filter */
     esp_timer_handle_t      sw_filter_timer;            /*!< Software filter timer handle */
@@ -171,6 +193,21 @@ void touch_priv_enable_module(bool enable);
  */
 void touch_priv_default_intr_handler(void *arg);
 
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+/**
+ * @brief Store the data of all the registered channels into the scan buffer
+ * @note  This is a private interface of `esp_driver_touch_sens`
+ *        It is implemented in the common part and called by the interrupt handler on the scan done interrupt,
+ *        only when the scan buffer is configured
+ *
+ * @param[in] active_mask   The active channel mask
+ * @return
+ *      - true      A higher priority task was woken up
+ *      - false     No task was woken up
+ */
+bool touch_priv_save_scan_data(uint32_t active_mask);
+#endif
+
 /**
  * @brief Touch sensor controller configuration interface
  * @note  This is a private interface of `esp_driver_touch_sens`
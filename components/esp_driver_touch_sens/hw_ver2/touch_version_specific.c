@@ -94,11 +94,13 @@ void IRAM_ATTR touch_priv_default_intr_handler(void *arg)
            The scan done interrupt will be triggered twice for channel 13 and 14,
            but we only hope it be triggered after channel 14 measurement done. */
         bool fake_scan_done = data.chan_id == 13 && (g_touch->chan_mask >> 13 == 0x03);
-        if (g_touch->cbs.on_scan_done && !fake_scan_done)
 #else
-        if (g_touch->cbs.on_scan_done)
+        bool fake_scan_done = false;
 #endif
-        {
+        if (g_touch->scan_buf && !fake_scan_done) {
+            need_yield |= touch_priv_save_scan_data(data.status_mask);
+        }
+        if (g_touch->cbs.on_scan_done && !fake_scan_done) {
             need_yield |= g_touch->cbs.on_scan_done(g_touch, &data, g_touch->user_ctx);
         }
     }
@@ -75,6 +75,9 @@ void IRAM_ATTR touch_priv_default_intr_handler(void *arg)
         }
     }
     if (status & TOUCH_LL_INTR_MASK_SCAN_DONE) {
+        if (g_touch->scan_buf) {
+            need_yield |= touch_priv_save_scan_data(data.status_mask);
+        }
         if (g_touch->cbs.on_scan_done) {
             need_yield |= g_touch->cbs.on_scan_done(g_touch, &data, g_touch->user_ctx);
         }
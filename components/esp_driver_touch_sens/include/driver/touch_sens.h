@@ -229,6 +229,47 @@ esp_err_t touch_sensor_register_callbacks(touch_sensor_handle_t sens_handle, con
  */
 esp_err_t touch_channel_read_data(touch_channel_handle_t chan_handle, touch_chan_data_type_t type, uint32_t *data);
 
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+/**
+ * @brief Configure the scan buffer, which stores the data of all the registered channels after each scan
+ * @note  This function can be called when the touch sensor controller is NOT enabled (i.e. INIT state).
+ * @note  The data are read in the scan done interrupt, so that the application can process all the channels of
+ *        several scans at once by `touch_sensor_read_scan_data`, instead of reading each channel after every scan.
+ *        The filtering and the active/inactive judgement are still done by the hardware,
+ *        see `touch_sensor_config_filter` and `touch_channel_config_t`.
+ *
+ * @param[in]  sens_handle      Touch sensor controller handle
+ * @param[in]  buf_cfg          Scan buffer configurations, set NULL to delete the scan buffer
+ * @return
+ *      - ESP_OK:                   Configure the scan buffer success
+ *      - ESP_ERR_INVALID_ARG:      The sensor handle is NULL or the scan number is 0
+ *      - ESP_ERR_INVALID_STATE:    The touch sensor is enabled
+ *      - ESP_ERR_NO_MEM:           No memory for the scan buffer
+ */
+esp_err_t touch_sensor_config_scan_buffer(touch_sensor_handle_t sens_handle, const touch_scan_buffer_config_t *buf_cfg);
+
+/**
+ * @brief Read the buffered scans, from the oldest to the newest
+ * @note  This function blocks until there are scans to read or timeout. If `touch_scan_buffer_config_t::flags::wakeup_on_change`
+ *        is set, it blocks until the active channel mask changes, and then returns the scans buffered until then.
+ * @note  This function can't be called in ISR/callback context.
+ *
+ * @param[in]  sens_handle      Touch sensor controller handle
+ * @param[out] scans            The array to store the scans
+ * @param[in]  max_scans        The length of the scans array
+ * @param[out] ret_scans        The number of scans that are read
+ * @param[in]  timeout_ms       Set a positive value or zero means the timeout in milliseconds
+ *                              Set a negative value means wait forever
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_TIMEOUT       No scan to read before timeout
+ *      - ESP_ERR_INVALID_ARG   NULL pointer or max_scans is 0
+ *      - ESP_ERR_INVALID_STATE The scan buffer is not configured
+ */
+esp_err_t touch_sensor_read_scan_data(touch_sensor_handle_t sens_handle, touch_scan_data_t *scans, uint32_t max_scans,
+                                      uint32_t *ret_scans, int timeout_ms);
+#endif  // SOC_TOUCH_SENSOR_VERSION >= 2
+
 #if SOC_TOUCH_SUPPORT_BENCHMARK
 /**
  * @brief Confiture the touch sensor benchmark for all the registered channels
@@ -37,6 +37,44 @@ typedef enum {
 typedef struct touch_sensor_s       *touch_sensor_handle_t;             /*!< The handle of touch sensor controller */
 typedef struct touch_channel_s      *touch_channel_handle_t;            /*!< The handle of touch channel */
 
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+/**
+ * @brief Touch sensor scan buffer configuration
+ *
+ */
+typedef struct {
+    uint32_t    scan_num;                   /*!< The number of scans that the buffer can hold,
+                                             *   the oldest scan will be overwritten when the buffer is full
+                                             */
+    struct {
+        uint32_t    read_benchmark: 1;      /*!< Whether to store the benchmark data of each scan as well,
+                                             *   it doubles the register reads in the scan done interrupt
+                                             */
+        uint32_t    wakeup_on_change: 1;    /*!< Set to only wake up the reader when the active channel mask changes,
+                                             *   i.e. when a channel becomes active or inactive,
+                                             *   otherwise the reader will be woken up after every scan
+                                             */
+    } flags;                                /*!< Scan buffer flags */
+} touch_scan_buffer_config_t;
+
+/**
+ * @brief The data of all the registered channels in one scan
+ * @note  The arrays are indexed by the channel id and the sample configuration index,
+ *        only the entries of the registered channels and the used sample configurations are valid
+ *
+ */
+typedef struct {
+    uint32_t    seq;                                                    /*!< The sequence number of this scan, it increases by one for each scan since the buffer is configured,
+                                                                         *   a gap in the sequence means the scans in between were overwritten before being read
+                                                                         */
+    uint32_t    active_mask;                                            /*!< The mask of the active channels when this scan is done */
+    uint32_t    smooth_data[TOUCH_TOTAL_CHAN_NUM][TOUCH_SAMPLE_CFG_NUM];  /*!< The smooth data of each channel and sample configuration */
+    uint32_t    benchmark[TOUCH_TOTAL_CHAN_NUM][TOUCH_SAMPLE_CFG_NUM];    /*!< The benchmark of each channel and sample configuration,
+                                                                         *   only valid when `touch_scan_buffer_config_t::flags::read_benchmark` is set
+                                                                         */
+} touch_scan_data_t;
+#endif  // SOC_TOUCH_SENSOR_VERSION >= 2
+
 #ifdef __cplusplus
 }
 #endif
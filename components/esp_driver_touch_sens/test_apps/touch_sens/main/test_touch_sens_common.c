@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include <inttypes.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -252,3 +253,76 @@ TEST_CASE("touch_sens_active_inactive_test", "[touch]")
     TEST_ASSERT_EQUAL_INT32(touch_cnt, cb_data.active_count);
     TEST_ASSERT_EQUAL_INT32(touch_cnt, cb_data.inactive_count);
 }
+
+#if SOC_TOUCH_SENSOR_VERSION >= 2
+TEST_CASE("touch_sens_scan_buffer_test", "[touch]")
+{
+    touch_sensor_handle_t touch = NULL;
+    touch_channel_handle_t touch_chan = NULL;
+
+    touch_sensor_config_t sens_cfg = TOUCH_SENSOR_DEFAULT_BASIC_CONFIG(TOUCH_SAMPLE_CFG_NUM, s_sample_cfg);
+    TEST_ESP_OK(touch_sensor_new_controller(&sens_cfg, &touch));
+    touch_sensor_filter_config_t filter_cfg = TOUCH_SENSOR_DEFAULT_FILTER_CONFIG();
+    TEST_ESP_OK(touch_sensor_config_filter(touch, &filter_cfg));
+    TEST_ESP_OK(touch_sensor_new_channel(touch, TOUCH_MIN_CHAN_ID, &s_chan_cfg, &touch_chan));
+#if SOC_TOUCH_SENSOR_VERSION == 3
+    touch_ll_enable_internal_capacitor(true);
+#endif  // SOC_TOUCH_SENSOR_VERSION == 3
+
+    s_test_touch_do_initial_scanning(touch, 3);
+    uint32_t benchmark[TOUCH_SAMPLE_CFG_NUM] = {0};
+    TEST_ESP_OK(touch_channel_read_data(touch_chan, TOUCH_CHAN_DATA_TYPE_BENCHMARK, benchmark));
+    touch_channel_config_t chan_cfg = s_test_get_chan_cfg_by_benchmark(benchmark, TOUCH_SAMPLE_CFG_NUM, TEST_ACTIVE_THRESH_RATIO);
+    TEST_ESP_OK(touch_sensor_reconfig_channel(touch_chan, &chan_cfg));
+
+    const uint32_t scan_num = 8;
+    touch_scan_data_t *scans = calloc(scan_num, sizeof(touch_scan_data_t));
+    TEST_ASSERT_NOT_NULL(scans);
+    uint32_t ret_scans = 0;
+    TEST_ASSERT(touch_sensor_read_scan_data(touch, scans, scan_num, &ret_scans, 0) == ESP_ERR_INVALID_STATE);
+
+    /* Wake up after every scan */
+    touch_scan_buffer_config_t buf_cfg = {
+        .scan_num = scan_num,
+        .flags.read_benchmark = true,
+    };
+    TEST_ESP_OK(touch_sensor_config_scan_buffer(touch, &buf_cfg));
+    TEST_ESP_OK(touch_sensor_enable(touch));
+    TEST_ASSERT(touch_sensor_config_scan_buffer(touch, NULL) == ESP_ERR_INVALID_STATE);
+    TEST_ESP_OK(touch_sensor_start_continuous_scanning(touch));
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ESP_OK(touch_sensor_read_scan_data(touch, scans, scan_num, &ret_scans, 1000));
+    TEST_ASSERT_GREATER_THAN(0, ret_scans);
+    for (int i = 0; i < ret_scans; i++) {
+        if (i > 0) {
+            TEST_ASSERT_EQUAL_UINT32(scans[i - 1].seq + 1, scans[i].seq);
+        }
+        for (int j = 0; j < TOUCH_SAMPLE_CFG_NUM; j++) {
+            TEST_ASSERT_GREATER_THAN(0, scans[i].smooth_data[TOUCH_MIN_CHAN_ID][j]);
+            TEST_ASSERT_GREATER_THAN(0, scans[i].benchmark[TOUCH_MIN_CHAN_ID][j]);
+        }
+    }
+    TEST_ESP_OK(touch_sensor_stop_continuous_scanning(touch));
+    TEST_ESP_OK(touch_sensor_disable(touch));
+
+    /* Only wake up when the channel becomes active or inactive */
+    buf_cfg.flags.wakeup_on_change = true;
+    TEST_ESP_OK(touch_sensor_config_scan_buffer(touch, &buf_cfg));
+    TEST_ESP_OK(touch_sensor_enable(touch));
+    TEST_ESP_OK(touch_sensor_start_continuous_scanning(touch));
+    TEST_ASSERT(touch_sensor_read_scan_data(touch, scans, scan_num, &ret_scans, 100) == ESP_ERR_TIMEOUT);
+    s_test_touch_simulate_touch(touch, touch_chan, true);
+    TEST_ESP_OK(touch_sensor_read_scan_data(touch, scans, scan_num, &ret_scans, 1000));
+    TEST_ASSERT_BIT_HIGH(TOUCH_MIN_CHAN_ID, scans[ret_scans - 1].active_mask);
+    s_test_touch_simulate_touch(touch, touch_chan, false);
+    TEST_ESP_OK(touch_sensor_read_scan_data(touch, scans, scan_num, &ret_scans, 1000));
+    TEST_ASSERT_BIT_LOW(TOUCH_MIN_CHAN_ID, scans[ret_scans - 1].active_mask);
+
+    TEST_ESP_OK(touch_sensor_stop_continuous_scanning(touch));
+    TEST_ESP_OK(touch_sensor_disable(touch));
+    TEST_ESP_OK(touch_sensor_config_scan_buffer(touch, NULL));
+    free(scans);
+    TEST_ESP_OK(touch_sensor_del_channel(touch_chan));
+    TEST_ESP_OK(touch_sensor_del_controller(touch));
+}
+#endif  // SOC_TOUCH_SENSOR_VERSION >= 2
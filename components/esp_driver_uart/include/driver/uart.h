@@ -563,6 +563,45 @@ int uart_write_bytes_with_break(uart_port_t uart_num, const void* src, size_t si
  */
 int uart_read_bytes(uart_port_t uart_num, void* buf, uint32_t length, TickType_t ticks_to_wait);
 
+/**
+ * @brief Borrow received data from the UART RX ring buffer, without copying it
+ *
+ * The data is given as a pointer into the RX ring buffer, and stays there until it is given back
+ * with uart_rx_return(). As the ring buffer wraps around, the data which is buffered may be
+ * returned in two parts by two subsequent calls.
+ *
+ * @note Until the data is returned, the task holds the RX lock of the port: other calls
+ *       to uart_read_bytes(), uart_rx_borrow() or uart_flush_input() on the port wait for it.
+ *       uart_rx_return() must be called by the same task, soon enough so that the ring buffer
+ *       doesn't overflow.
+ *
+ * @param uart_num UART port number, the max port number is (UART_NUM_MAX -1).
+ * @param[out] data Returned pointer to the received data
+ * @param[out] size Returned length of the received data
+ * @param max_size Maximum length of the data to borrow, 0 for no limit
+ * @param ticks_to_wait Timeout, count in RTOS ticks
+ *
+ * @return
+ *     - ESP_OK Success, data has been borrowed
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Driver is not installed, or the task has borrowed data which has not been returned yet
+ *     - ESP_ERR_TIMEOUT No data has been received before the timeout
+ */
+esp_err_t uart_rx_borrow(uart_port_t uart_num, const uint8_t **data, size_t *size, size_t max_size, TickType_t ticks_to_wait);
+
+/**
+ * @brief Give back the data borrowed by uart_rx_borrow() to the UART RX ring buffer
+ *
+ * @param uart_num UART port number, the max port number is (UART_NUM_MAX -1).
+ * @param data Pointer returned by uart_rx_borrow()
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error, or data is not the borrowed data
+ *     - ESP_ERR_INVALID_STATE Driver is not installed, or the data has been borrowed by another task
+ */
+esp_err_t uart_rx_return(uart_port_t uart_num, const uint8_t *data);
+
 /**
  * @brief Alias of uart_flush_input.
  *        UART ring buffer flush. This will discard all data in the UART RX buffer.
@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/uart.h"
+#include "driver/uhci_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UHCI controller configuration
+ */
+typedef struct {
+    uart_port_t uart_port;          /*!< UART port which the UHCI controller is attached to. The port must be configured with
+                                         `uart_param_config` and `uart_set_pin`, and the UART driver must not be installed on it */
+    size_t tx_trans_queue_depth;    /*!< Number of transmissions which can be queued by `uhci_transmit` */
+    size_t max_transmit_size;       /*!< Maximum size of one transmission, in bytes. This decides the number of DMA nodes used for each transmission */
+    size_t rx_node_size;            /*!< Size of each part of the RX buffer which is filled by the DMA, in bytes. It must be a multiple of 4 and at most 4092.
+                                         Set to 0 to use 1024 bytes. The RX event callback is called at least once per filled node */
+    size_t max_packet_receive;      /*!< Length of a packet in bytes, valid only if `rx_eof_flags.length_eof` is set */
+    struct {
+        uint32_t idle_eof: 1;       /*!< A packet ends when the RX line has been idle for the UART idle threshold */
+        uint32_t rx_brk_eof: 1;     /*!< A packet ends when a break (NULL frame) is received */
+        uint32_t length_eof: 1;     /*!< A packet ends after `max_packet_receive` bytes */
+    } rx_eof_flags;                 /*!< Conditions on which a received packet ends, and the RX event callback is called with `flags.eof` set */
+} uhci_controller_config_t;
+
+/**
+ * @brief UHCI event callbacks
+ */
+typedef struct {
+    uhci_rx_event_callback_t on_rx_trans_event; /*!< Called when a part of the RX buffer has been filled or a packet has ended */
+    uhci_tx_done_callback_t on_tx_trans_done;   /*!< Called when a transmission has been done */
+} uhci_event_callbacks_t;
+
+/**
+ * @brief Create a UHCI controller, which moves the data of a UART port to and from memory with the DMA
+ *
+ * @note Unlike the UART driver, the CPU doesn't copy the received data: the DMA writes it directly
+ *       into the buffer given to `uhci_receive`. This is meant for high baud rates, where emptying the
+ *       UART RX FIFO from an interrupt takes a large share of the CPU.
+ *
+ * @param[in] config UHCI controller configuration
+ * @param[out] ret_uhci_ctrl Returned UHCI controller handle
+ * @return
+ *      - ESP_OK: Create UHCI controller successfully
+ *      - ESP_ERR_INVALID_ARG: Create UHCI controller failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Create UHCI controller failed because the UART driver is installed on the port
+ *      - ESP_ERR_NO_MEM: Create UHCI controller failed because of out of memory
+ *      - ESP_ERR_NOT_FOUND: Create UHCI controller failed because all UHCI controllers or DMA channels are used up
+ *      - ESP_FAIL: Create UHCI controller failed because of other error
+ */
+esp_err_t uhci_new_controller(const uhci_controller_config_t *config, uhci_controller_handle_t *ret_uhci_ctrl);
+
+/**
+ * @brief Delete a UHCI controller
+ *
+ * @param[in] uhci_ctrl UHCI controller handle that created by `uhci_new_controller`
+ * @return
+ *      - ESP_OK: Delete UHCI controller successfully
+ *      - ESP_ERR_INVALID_ARG: Delete UHCI controller failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Delete UHCI controller failed because it is still receiving or transmitting
+ */
+esp_err_t uhci_del_controller(uhci_controller_handle_t uhci_ctrl);
+
+/**
+ * @brief Set event callbacks for a UHCI controller
+ *
+ * @note The callbacks are called from the ISR context. When CONFIG_UHCI_ISR_CACHE_SAFE is enabled,
+ *       the callbacks and the data they use should be placed in internal RAM.
+ *
+ * @param[in] uhci_ctrl UHCI controller handle
+ * @param[in] cbs Group of callback functions
+ * @param[in] user_data User data, which will be passed to the callback functions directly
+ * @return
+ *      - ESP_OK: Set event callbacks successfully
+ *      - ESP_ERR_INVALID_ARG: Set event callbacks failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Set event callbacks failed because the controller is receiving
+ */
+esp_err_t uhci_register_event_callbacks(uhci_controller_handle_t uhci_ctrl, const uhci_event_callbacks_t *cbs, void *user_data);
+
+/**
+ * @brief Start receiving data into a buffer
+ *
+ * The buffer is divided into nodes of `rx_node_size` bytes, which the DMA fills one after the other and
+ * then starts again from the first one, until `uhci_receive_stop` is called. The RX event callback gives
+ * the part of a node that has been received. This data stays valid until the DMA wraps around the buffer
+ * and reaches that node again, so the buffer should hold the data received while the application processes
+ * the previous data. If the DMA reaches a node which the driver hasn't given back to it yet, the data
+ * received in the meantime is lost and the next event has `flags.overrun` set.
+ *
+ * @param[in] uhci_ctrl UHCI controller handle
+ * @param[in] read_buffer Buffer in DMA-capable internal memory, aligned to 4 bytes
+ * @param[in] buffer_size Size of the buffer, a multiple of `rx_node_size`, at least 2 nodes
+ * @return
+ *      - ESP_OK: Start receiving successfully
+ *      - ESP_ERR_INVALID_ARG: Start receiving failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Start receiving failed because the controller is already receiving
+ *      - ESP_ERR_NO_MEM: Start receiving failed because of out of memory
+ */
+esp_err_t uhci_receive(uhci_controller_handle_t uhci_ctrl, uint8_t *read_buffer, size_t buffer_size);
+
+/**
+ * @brief Stop receiving data
+ *
+ * @param[in] uhci_ctrl UHCI controller handle
+ * @return
+ *      - ESP_OK: Stop receiving successfully
+ *      - ESP_ERR_INVALID_ARG: Stop receiving failed because of invalid argument
+ */
+esp_err_t uhci_receive_stop(uhci_controller_handle_t uhci_ctrl);
+
+/**
+ * @brief Transmit data
+ *
+ * @note The transmission is queued and the function returns without waiting for it to be done.
+ *       If the queue is full, the function waits for a queued transmission to be done first.
+ *       The buffer must not be modified until the TX done callback is called for it.
+ *
+ * @param[in] uhci_ctrl UHCI controller handle
+ * @param[in] write_buffer Buffer in DMA-capable internal memory
+ * @param[in] write_size Size of the data, at most `max_transmit_size`
+ * @return
+ *      - ESP_OK: Queue the transmission successfully
+ *      - ESP_ERR_INVALID_ARG: Queue the transmission failed because of invalid argument
+ */
+esp_err_t uhci_transmit(uhci_controller_handle_t uhci_ctrl, uint8_t *write_buffer, size_t write_size);
+
+/**
+ * @brief Wait for all the queued transmissions to be done
+ *
+ * @param[in] uhci_ctrl UHCI controller handle
+ * @param[in] timeout_ms Timeout in milliseconds, `-1` means to wait forever
+ * @return
+ *      - ESP_OK: All transmissions are done
+ *      - ESP_ERR_INVALID_ARG: Wait failed because of invalid argument
+ *      - ESP_ERR_TIMEOUT: Wait timed out
+ */
+esp_err_t uhci_wait_all_tx_transaction_done(uhci_controller_handle_t uhci_ctrl, int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
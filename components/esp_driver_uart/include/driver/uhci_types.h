@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Type of UHCI controller handle
+ */
+typedef struct uhci_controller_t *uhci_controller_handle_t;
+
+/**
+ * @brief UHCI RX event data
+ */
+typedef struct {
+    uint8_t *data;      /*!< Start of the received data, it points into the buffer given to `uhci_receive` */
+    size_t recv_size;   /*!< Number of bytes received in `data` */
+    struct {
+        uint32_t eof: 1;     /*!< The data ends a packet, i.e. it is followed by an idle line, a break or
+                                  the length set by `max_packet_receive` has been reached (see `rx_eof_flags`) */
+        uint32_t overrun: 1; /*!< Data has been lost before this data, because the RX buffer was full */
+    } flags;            /*!< Extra flags of the received data */
+} uhci_rx_event_data_t;
+
+/**
+ * @brief UHCI TX done event data
+ */
+typedef struct {
+    void *buffer;       /*!< Buffer which was given to `uhci_transmit` */
+    size_t sent_size;   /*!< Number of bytes which were sent */
+} uhci_tx_done_event_data_t;
+
+/**
+ * @brief UHCI RX event callback type
+ *
+ * @param[in] uhci_ctrl UHCI controller handle
+ * @param[in] edata RX event data
+ * @param[in] user_ctx User data, passed from `uhci_register_event_callbacks`
+ * @return Whether a high priority task has been woken up by this callback function
+ */
+typedef bool (*uhci_rx_event_callback_t)(uhci_controller_handle_t uhci_ctrl, const uhci_rx_event_data_t *edata, void *user_ctx);
+
+/**
+ * @brief UHCI TX done callback type
+ *
+ * @param[in] uhci_ctrl UHCI controller handle
+ * @param[in] edata TX done event data
+ * @param[in] user_ctx User data, passed from `uhci_register_event_callbacks`
+ * @return Whether a high priority task has been woken up by this callback function
+ */
+typedef bool (*uhci_tx_done_callback_t)(uhci_controller_handle_t uhci_ctrl, const uhci_tx_done_event_data_t *edata, void *user_ctx);
+
+#ifdef __cplusplus
+}
+#endif
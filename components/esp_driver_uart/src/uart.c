@@ -139,6 +139,8 @@ typedef struct {
     uint8_t *rx_data_buf;               /*!< Data buffer to stash FIFO data*/
     uint8_t rx_stash_len;               /*!< stashed data length.(When using flow control, after reading out FIFO data, if we fail to push to buffer, we can just stash them.) */
     uint32_t rx_int_usr_mask;           /*!< RX interrupt status. Valid at any time, regardless of RX buffer status. */
+    uint8_t *rx_borrowed_data;          /*!< Data lent out of the RX ring buffer by uart_rx_borrow(), NULL if none */
+    size_t rx_borrowed_len;             /*!< Length of the data lent out of the RX ring buffer */
     uart_pat_rb_t rx_pattern_pos;
     int tx_buf_size;                    /*!< TX ring buffer size */
     bool tx_waiting_fifo;               /*!< this flag indicates that some task is waiting for FIFO empty interrupt, used to send all data without any data buffer*/
@@ -1553,6 +1555,58 @@ int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length, TickType_t
     return copy_len;
 }
 
+esp_err_t uart_rx_borrow(uart_port_t uart_num, const uint8_t **data, size_t *size, size_t max_size, TickType_t ticks_to_wait)
+{
+    ESP_RETURN_ON_FALSE((uart_num < UART_NUM_MAX), ESP_ERR_INVALID_ARG, UART_TAG, "uart_num error");
+    ESP_RETURN_ON_FALSE((data && size), ESP_ERR_INVALID_ARG, UART_TAG, "arg pointer is NULL");
+    ESP_RETURN_ON_FALSE((p_uart_obj[uart_num]), ESP_ERR_INVALID_STATE, UART_TAG, "uart driver error");
+    uart_obj_t *p_uart = p_uart_obj[uart_num];
+    // the mutex is held until the data is returned, so taking it again from the same task would never succeed
+    ESP_RETURN_ON_FALSE(!(p_uart->rx_borrowed_data && xSemaphoreGetMutexHolder(p_uart->rx_mux) == xTaskGetCurrentTaskHandle()),
+                        ESP_ERR_INVALID_STATE, UART_TAG, "data already borrowed");
+    if (xSemaphoreTake(p_uart->rx_mux, (TickType_t)ticks_to_wait) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    uint8_t *buf = NULL;
+    size_t len = 0;
+    while (true) {
+        buf = (uint8_t *) xRingbufferReceiveUpTo(p_uart->rx_ring_buf, &len, (TickType_t) ticks_to_wait, max_size ? max_size : p_uart->rx_buf_size);
+        // see uart_read_bytes, data may be stashed while the ring buffer has become empty
+        if (buf || !uart_check_buf_full(uart_num)) {
+            break;
+        }
+    }
+    if (!buf) {
+        xSemaphoreGive(p_uart->rx_mux);
+        return ESP_ERR_TIMEOUT;
+    }
+    p_uart->rx_borrowed_data = buf;
+    p_uart->rx_borrowed_len = len;
+    *data = buf;
+    *size = len;
+    return ESP_OK;
+}
+
+esp_err_t uart_rx_return(uart_port_t uart_num, const uint8_t *data)
+{
+    ESP_RETURN_ON_FALSE((uart_num < UART_NUM_MAX), ESP_ERR_INVALID_ARG, UART_TAG, "uart_num error");
+    ESP_RETURN_ON_FALSE((p_uart_obj[uart_num]), ESP_ERR_INVALID_STATE, UART_TAG, "uart driver error");
+    uart_obj_t *p_uart = p_uart_obj[uart_num];
+    ESP_RETURN_ON_FALSE((data && data == p_uart->rx_borrowed_data), ESP_ERR_INVALID_ARG, UART_TAG, "data not borrowed");
+    ESP_RETURN_ON_FALSE((xSemaphoreGetMutexHolder(p_uart->rx_mux) == xTaskGetCurrentTaskHandle()), ESP_ERR_INVALID_STATE, UART_TAG,
+                        "data borrowed by another task");
+    UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+    p_uart->rx_buffered_len -= p_uart->rx_borrowed_len;
+    uart_pattern_queue_update(uart_num, p_uart->rx_borrowed_len);
+    UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+    p_uart->rx_borrowed_data = NULL;
+    p_uart->rx_borrowed_len = 0;
+    vRingbufferReturnItem(p_uart->rx_ring_buf, (void *)data);
+    uart_check_buf_full(uart_num);
+    xSemaphoreGive(p_uart->rx_mux);
+    return ESP_OK;
+}
+
 esp_err_t uart_get_buffered_data_len(uart_port_t uart_num, size_t *size)
 {
     ESP_RETURN_ON_FALSE((uart_num < UART_NUM_MAX), ESP_FAIL, UART_TAG, "uart_num error");
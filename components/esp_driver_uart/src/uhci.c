@@ -0,0 +1,472 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * UHCI moves the data of a UART port between its FIFOs and the GDMA, so that received data is written
+ * by the DMA directly into the application's buffer instead of being copied from the RX FIFO by the CPU.
+ *
+ * RX: the buffer given to uhci_receive is split into nodes, described by a circular list of DMA descriptors
+ * owned by the driver. The DMA fills a node, hands it back to the CPU (owner bit) and moves on to the next one.
+ * The ISR reports the received part of each node returned by the DMA and gives the node back to the DMA.
+ * With the owner check enabled, the DMA stops instead of overwriting a node which has not been given back yet;
+ * the driver then restarts it and marks the next data with the overrun flag.
+ *
+ * TX: the transmissions are queued in a ring of transactions, each one with its own descriptors. The EOF
+ * interrupt of a transaction starts the next queued one.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/lock.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#if CONFIG_UHCI_ENABLE_DEBUG_LOG
+// The local log level must be defined before including esp_log.h
+// Set the maximum log level for this source file
+#define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
+#endif
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/idf_additions.h"
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+#include "esp_private/gdma.h"
+#include "esp_private/periph_ctrl.h"
+#include "hal/dma_types.h"
+#include "hal/uhci_ll.h"
+#include "soc/soc_caps.h"
+#include "driver/uart.h"
+#include "driver/uhci.h"
+
+#if CONFIG_UHCI_OBJ_CACHE_SAFE
+#define UHCI_MEM_ALLOC_CAPS      (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define UHCI_MEM_ALLOC_CAPS      MALLOC_CAP_DEFAULT
+#endif
+#define UHCI_DMA_DESC_ALLOC_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA)
+
+#define UHCI_RX_NODE_SIZE_DEFAULT 1024
+
+static const char *TAG = "uhci";
+
+typedef struct {
+    void *buffer;                       // buffer of the transmission
+    size_t size;                        // size of the transmission
+    dma_descriptor_align4_t *desc;      // descriptors of the transmission, `tx_nodes_per_trans` of them
+} uhci_tx_trans_t;
+
+typedef struct uhci_controller_t {
+    int uhci_num;                       // UHCI controller number
+    uhci_dev_t *hw;                     // UHCI registers
+    uart_port_t uart_port;              // attached UART port
+    gdma_channel_handle_t tx_chan;      // GDMA TX channel
+    gdma_channel_handle_t rx_chan;      // GDMA RX channel
+    portMUX_TYPE spinlock;              // protects the TX queue
+    uhci_event_callbacks_t cbs;         // event callbacks
+    void *user_data;                    // user data of the callbacks
+    // RX
+    size_t rx_node_size;                // size of each RX node
+    dma_descriptor_align4_t *rx_desc;   // circular list of RX descriptors
+    size_t rx_desc_capacity;            // number of allocated RX descriptors
+    size_t rx_desc_num;                 // number of RX descriptors of the current reception
+    size_t rx_next;                     // next RX node to be returned by the DMA
+    bool rx_running;                    // reception is in progress
+    bool rx_overrun;                    // data has been lost before the next RX node
+    // TX
+    size_t max_transmit_size;           // maximum size of a transmission
+    size_t tx_queue_depth;              // number of transactions in the queue
+    size_t tx_nodes_per_trans;          // number of descriptors of each transaction
+    uhci_tx_trans_t *tx_trans;          // ring of transactions
+    dma_descriptor_align4_t *tx_desc;   // descriptors of all the transactions
+    size_t tx_head;                     // next transaction to be queued
+    size_t tx_tail;                     // transaction in progress
+    size_t tx_pending;                  // number of queued transactions, including the one in progress
+    SemaphoreHandle_t tx_free_sem;      // counts the free transactions
+} uhci_controller_t;
+
+typedef struct {
+    _lock_t mutex;                          // platform level mutex lock
+    uhci_controller_t *controllers[SOC_UHCI_NUM]; // array of UHCI controller instances
+} uhci_platform_t;
+
+static uhci_platform_t s_platform; // singleton platform
+
+static esp_err_t uhci_acquire_controller(uhci_controller_t *uhci_ctrl)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    _lock_acquire(&s_platform.mutex);
+    for (int i = 0; i < SOC_UHCI_NUM; i++) {
+        if (!s_platform.controllers[i]) {
+            s_platform.controllers[i] = uhci_ctrl;
+            uhci_ctrl->uhci_num = i;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    _lock_release(&s_platform.mutex);
+    return ret;
+}
+
+static void uhci_release_controller(uhci_controller_t *uhci_ctrl)
+{
+    _lock_acquire(&s_platform.mutex);
+    s_platform.controllers[uhci_ctrl->uhci_num] = NULL;
+    _lock_release(&s_platform.mutex);
+}
+
+static void uhci_rx_restart(uhci_controller_t *uhci_ctrl)
+{
+    gdma_reset(uhci_ctrl->rx_chan);
+    gdma_start(uhci_ctrl->rx_chan, (intptr_t)&uhci_ctrl->rx_desc[uhci_ctrl->rx_next]);
+}
+
+static bool uhci_rx_process_nodes(uhci_controller_t *uhci_ctrl)
+{
+    bool need_yield = false;
+    while (uhci_ctrl->rx_running) {
+        dma_descriptor_align4_t *desc = &uhci_ctrl->rx_desc[uhci_ctrl->rx_next];
+        if (desc->dw0.owner != DMA_DESCRIPTOR_BUFFER_OWNER_CPU) {
+            break;
+        }
+        uhci_rx_event_data_t evt_data = {
+            .data = desc->buffer,
+            .recv_size = desc->dw0.length,
+            .flags.eof = desc->dw0.suc_eof || desc->dw0.err_eof,
+            .flags.overrun = uhci_ctrl->rx_overrun,
+        };
+        if ((evt_data.recv_size || evt_data.flags.eof) && uhci_ctrl->cbs.on_rx_trans_event) {
+            if (uhci_ctrl->cbs.on_rx_trans_event(uhci_ctrl, &evt_data, uhci_ctrl->user_data)) {
+                need_yield = true;
+            }
+        }
+        uhci_ctrl->rx_overrun = false;
+        // give the node back to the DMA, the data stays there until the DMA wraps around the buffer
+        desc->dw0.length = 0;
+        desc->dw0.suc_eof = 0;
+        desc->dw0.err_eof = 0;
+        desc->dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+        uhci_ctrl->rx_next = (uhci_ctrl->rx_next + 1) % uhci_ctrl->rx_desc_num;
+    }
+    return need_yield;
+}
+
+static bool uhci_gdma_rx_done_callback(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
+{
+    // called for each node filled by the DMA, including the ones which end a packet
+    return uhci_rx_process_nodes((uhci_controller_t *)user_data);
+}
+
+static bool uhci_gdma_rx_descr_err_callback(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
+{
+    uhci_controller_t *uhci_ctrl = (uhci_controller_t *)user_data;
+    // the DMA has stopped at a node which was not given back yet, the data received since then is lost
+    bool need_yield = uhci_rx_process_nodes(uhci_ctrl);
+    if (uhci_ctrl->rx_running) {
+        uhci_ctrl->rx_overrun = true;
+        uhci_rx_restart(uhci_ctrl);
+    }
+    return need_yield;
+}
+
+static bool uhci_gdma_tx_eof_callback(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
+{
+    uhci_controller_t *uhci_ctrl = (uhci_controller_t *)user_data;
+    BaseType_t high_task_woken = pdFALSE;
+    bool need_yield = false;
+
+    portENTER_CRITICAL_ISR(&uhci_ctrl->spinlock);
+    uhci_tx_trans_t *trans = &uhci_ctrl->tx_trans[uhci_ctrl->tx_tail];
+    uhci_ctrl->tx_tail = (uhci_ctrl->tx_tail + 1) % uhci_ctrl->tx_queue_depth;
+    uhci_ctrl->tx_pending--;
+    if (uhci_ctrl->tx_pending) {
+        gdma_start(uhci_ctrl->tx_chan, (intptr_t)uhci_ctrl->tx_trans[uhci_ctrl->tx_tail].desc);
+    }
+    portEXIT_CRITICAL_ISR(&uhci_ctrl->spinlock);
+
+    uhci_tx_done_event_data_t evt_data = {
+        .buffer = trans->buffer,
+        .sent_size = trans->size,
+    };
+    if (uhci_ctrl->cbs.on_tx_trans_done) {
+        if (uhci_ctrl->cbs.on_tx_trans_done(uhci_ctrl, &evt_data, uhci_ctrl->user_data)) {
+            need_yield = true;
+        }
+    }
+    xSemaphoreGiveFromISR(uhci_ctrl->tx_free_sem, &high_task_woken);
+    return need_yield || high_task_woken == pdTRUE;
+}
+
+static void uhci_destroy(uhci_controller_t *uhci_ctrl)
+{
+    if (uhci_ctrl->hw) {
+        PERIPH_RCC_ATOMIC() {
+            uhci_ll_enable_bus_clock(uhci_ctrl->uhci_num, false);
+        }
+    }
+    if (uhci_ctrl->rx_chan) {
+        gdma_disconnect(uhci_ctrl->rx_chan);
+        gdma_del_channel(uhci_ctrl->rx_chan);
+    }
+    if (uhci_ctrl->tx_chan) {
+        gdma_disconnect(uhci_ctrl->tx_chan);
+        gdma_del_channel(uhci_ctrl->tx_chan);
+    }
+    if (uhci_ctrl->tx_free_sem) {
+        vSemaphoreDeleteWithCaps(uhci_ctrl->tx_free_sem);
+    }
+    if (uhci_ctrl->uhci_num >= 0) {
+        uhci_release_controller(uhci_ctrl);
+    }
+    free(uhci_ctrl->rx_desc);
+    free(uhci_ctrl->tx_desc);
+    free(uhci_ctrl->tx_trans);
+    free(uhci_ctrl);
+}
+
+esp_err_t uhci_new_controller(const uhci_controller_config_t *config, uhci_controller_handle_t *ret_uhci_ctrl)
+{
+    esp_err_t ret = ESP_OK;
+    uhci_controller_t *uhci_ctrl = NULL;
+    ESP_RETURN_ON_FALSE(config && ret_uhci_ctrl, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->uart_port >= 0 && config->uart_port < SOC_UART_HP_NUM, ESP_ERR_INVALID_ARG, TAG, "invalid UART port");
+    ESP_RETURN_ON_FALSE(!uart_is_driver_installed(config->uart_port), ESP_ERR_INVALID_STATE, TAG, "UART driver is installed on port %d", config->uart_port);
+    ESP_RETURN_ON_FALSE(config->tx_trans_queue_depth && config->max_transmit_size, ESP_ERR_INVALID_ARG, TAG, "invalid TX queue configuration");
+    size_t rx_node_size = config->rx_node_size ? config->rx_node_size : UHCI_RX_NODE_SIZE_DEFAULT;
+    ESP_RETURN_ON_FALSE(rx_node_size % 4 == 0 && rx_node_size <= DMA_DESCRIPTOR_BUFFER_MAX_SIZE_4B_ALIGNED,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid RX node size %u", (unsigned)rx_node_size);
+    if (config->rx_eof_flags.length_eof) {
+        ESP_RETURN_ON_FALSE(config->max_packet_receive, ESP_ERR_INVALID_ARG, TAG, "invalid packet length");
+    }
+
+    uhci_ctrl = heap_caps_calloc(1, sizeof(uhci_controller_t), UHCI_MEM_ALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(uhci_ctrl, ESP_ERR_NO_MEM, TAG, "no mem for UHCI controller");
+    uhci_ctrl->uhci_num = -1;
+    uhci_ctrl->uart_port = config->uart_port;
+    uhci_ctrl->rx_node_size = rx_node_size;
+    uhci_ctrl->max_transmit_size = config->max_transmit_size;
+    uhci_ctrl->tx_queue_depth = config->tx_trans_queue_depth;
+    uhci_ctrl->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    ESP_GOTO_ON_ERROR(uhci_acquire_controller(uhci_ctrl), err, TAG, "no free UHCI controller");
+
+    // the descriptors of all the transactions are allocated at once, each transaction uses its own part of them
+    uhci_ctrl->tx_nodes_per_trans = (config->max_transmit_size + DMA_DESCRIPTOR_BUFFER_MAX_SIZE_4B_ALIGNED - 1) / DMA_DESCRIPTOR_BUFFER_MAX_SIZE_4B_ALIGNED;
+    uhci_ctrl->tx_trans = heap_caps_calloc(uhci_ctrl->tx_queue_depth, sizeof(uhci_tx_trans_t), UHCI_MEM_ALLOC_CAPS);
+    uhci_ctrl->tx_desc = heap_caps_aligned_calloc(4, uhci_ctrl->tx_queue_depth * uhci_ctrl->tx_nodes_per_trans,
+                                                  sizeof(dma_descriptor_align4_t), UHCI_DMA_DESC_ALLOC_CAPS);
+    uhci_ctrl->tx_free_sem = xSemaphoreCreateCountingWithCaps(uhci_ctrl->tx_queue_depth, uhci_ctrl->tx_queue_depth, UHCI_MEM_ALLOC_CAPS);
+    ESP_GOTO_ON_FALSE(uhci_ctrl->tx_trans && uhci_ctrl->tx_desc && uhci_ctrl->tx_free_sem, ESP_ERR_NO_MEM, err, TAG, "no mem for TX queue");
+    for (size_t i = 0; i < uhci_ctrl->tx_queue_depth; i++) {
+        uhci_ctrl->tx_trans[i].desc = &uhci_ctrl->tx_desc[i * uhci_ctrl->tx_nodes_per_trans];
+    }
+
+    // TX and RX channels of the same pair, both connected to the UHCI
+    gdma_channel_alloc_config_t tx_alloc_config = {
+        .direction = GDMA_CHANNEL_DIRECTION_TX,
+        .flags.reserve_sibling = 1,
+    };
+    ESP_GOTO_ON_ERROR(gdma_new_ahb_channel(&tx_alloc_config, &uhci_ctrl->tx_chan), err, TAG, "alloc TX DMA channel failed");
+    gdma_channel_alloc_config_t rx_alloc_config = {
+        .direction = GDMA_CHANNEL_DIRECTION_RX,
+        .sibling_chan = uhci_ctrl->tx_chan,
+    };
+    ESP_GOTO_ON_ERROR(gdma_new_ahb_channel(&rx_alloc_config, &uhci_ctrl->rx_chan), err, TAG, "alloc RX DMA channel failed");
+    gdma_connect(uhci_ctrl->tx_chan, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_UHCI, 0));
+    gdma_connect(uhci_ctrl->rx_chan, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_UHCI, 0));
+
+    gdma_strategy_config_t tx_strategy = {
+        .auto_update_desc = false,
+        .owner_check = false,
+    };
+    gdma_apply_strategy(uhci_ctrl->tx_chan, &tx_strategy);
+    // the owner check stops the DMA before it overwrites a node that the driver has not processed yet
+    gdma_strategy_config_t rx_strategy = {
+        .auto_update_desc = false,
+        .owner_check = true,
+    };
+    gdma_apply_strategy(uhci_ctrl->rx_chan, &rx_strategy);
+
+    gdma_tx_event_callbacks_t tx_cbs = {
+        .on_trans_eof = uhci_gdma_tx_eof_callback,
+    };
+    ESP_GOTO_ON_ERROR(gdma_register_tx_event_callbacks(uhci_ctrl->tx_chan, &tx_cbs, uhci_ctrl), err, TAG, "register TX DMA callbacks failed");
+    gdma_rx_event_callbacks_t rx_cbs = {
+        .on_recv_done = uhci_gdma_rx_done_callback,
+        .on_descr_err = uhci_gdma_rx_descr_err_callback,
+    };
+    ESP_GOTO_ON_ERROR(gdma_register_rx_event_callbacks(uhci_ctrl->rx_chan, &rx_cbs, uhci_ctrl), err, TAG, "register RX DMA callbacks failed");
+
+    PERIPH_RCC_ATOMIC() {
+        uhci_ll_enable_bus_clock(uhci_ctrl->uhci_num, true);
+        uhci_ll_reset_register(uhci_ctrl->uhci_num);
+    }
+    uhci_ctrl->hw = UHCI_LL_GET_HW(uhci_ctrl->uhci_num);
+    uhci_ll_init(uhci_ctrl->hw);
+    uint32_t eof_mode = 0;
+    if (config->rx_eof_flags.idle_eof) {
+        eof_mode |= UHCI_RX_IDLE_EOF;
+    }
+    if (config->rx_eof_flags.rx_brk_eof) {
+        eof_mode |= UHCI_RX_BREAK_CHR_EOF;
+    }
+    if (config->rx_eof_flags.length_eof) {
+        eof_mode |= UHCI_RX_LEN_EOF;
+        uhci_ll_set_rx_packet_threshold(uhci_ctrl->hw, config->max_packet_receive);
+    }
+    uhci_ll_set_eof_mode(uhci_ctrl->hw, eof_mode);
+    // the data is transferred as is, without the SLIP separators and escapes
+    uhci_ctrl->hw->escape_conf.val = 0;
+    uhci_ll_attach_uart_port(uhci_ctrl->hw, uhci_ctrl->uart_port);
+
+    ESP_LOGD(TAG, "new controller %d on UART %d (%p)", uhci_ctrl->uhci_num, uhci_ctrl->uart_port, uhci_ctrl);
+    *ret_uhci_ctrl = uhci_ctrl;
+    return ESP_OK;
+
+err:
+    uhci_destroy(uhci_ctrl);
+    return ret;
+}
+
+esp_err_t uhci_del_controller(uhci_controller_handle_t uhci_ctrl)
+{
+    ESP_RETURN_ON_FALSE(uhci_ctrl, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!uhci_ctrl->rx_running, ESP_ERR_INVALID_STATE, TAG, "controller is still receiving");
+    ESP_RETURN_ON_FALSE(uhci_ctrl->tx_pending == 0, ESP_ERR_INVALID_STATE, TAG, "controller is still transmitting");
+    ESP_LOGD(TAG, "del controller %d", uhci_ctrl->uhci_num);
+    uhci_destroy(uhci_ctrl);
+    return ESP_OK;
+}
+
+esp_err_t uhci_register_event_callbacks(uhci_controller_handle_t uhci_ctrl, const uhci_event_callbacks_t *cbs, void *user_data)
+{
+    ESP_RETURN_ON_FALSE(uhci_ctrl && cbs, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!uhci_ctrl->rx_running, ESP_ERR_INVALID_STATE, TAG, "controller is receiving");
+#if CONFIG_UHCI_ISR_CACHE_SAFE
+    if (cbs->on_rx_trans_event) {
+        ESP_RETURN_ON_FALSE(esp_ptr_in_iram(cbs->on_rx_trans_event), ESP_ERR_INVALID_ARG, TAG, "on_rx_trans_event callback not in IRAM");
+    }
+    if (cbs->on_tx_trans_done) {
+        ESP_RETURN_ON_FALSE(esp_ptr_in_iram(cbs->on_tx_trans_done), ESP_ERR_INVALID_ARG, TAG, "on_tx_trans_done callback not in IRAM");
+    }
+    if (user_data) {
+        ESP_RETURN_ON_FALSE(esp_ptr_internal(user_data), ESP_ERR_INVALID_ARG, TAG, "user context not in internal RAM");
+    }
+#endif
+    portENTER_CRITICAL(&uhci_ctrl->spinlock);
+    uhci_ctrl->cbs = *cbs;
+    uhci_ctrl->user_data = user_data;
+    portEXIT_CRITICAL(&uhci_ctrl->spinlock);
+    return ESP_OK;
+}
+
+esp_err_t uhci_receive(uhci_controller_handle_t uhci_ctrl, uint8_t *read_buffer, size_t buffer_size)
+{
+    ESP_RETURN_ON_FALSE(uhci_ctrl && read_buffer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(esp_ptr_dma_capable(read_buffer) && ((uintptr_t)read_buffer % 4) == 0, ESP_ERR_INVALID_ARG, TAG,
+                        "buffer must be DMA capable and aligned to 4 bytes");
+    size_t node_size = uhci_ctrl->rx_node_size;
+    ESP_RETURN_ON_FALSE(buffer_size % node_size == 0 && buffer_size / node_size >= 2, ESP_ERR_INVALID_ARG, TAG,
+                        "buffer size must be a multiple of %u, at least 2 nodes", (unsigned)node_size);
+    ESP_RETURN_ON_FALSE(!uhci_ctrl->rx_running, ESP_ERR_INVALID_STATE, TAG, "controller is already receiving");
+
+    size_t num = buffer_size / node_size;
+    if (num > uhci_ctrl->rx_desc_capacity) {
+        dma_descriptor_align4_t *desc = heap_caps_aligned_calloc(4, num, sizeof(dma_descriptor_align4_t), UHCI_DMA_DESC_ALLOC_CAPS);
+        ESP_RETURN_ON_FALSE(desc, ESP_ERR_NO_MEM, TAG, "no mem for RX descriptors");
+        free(uhci_ctrl->rx_desc);
+        uhci_ctrl->rx_desc = desc;
+        uhci_ctrl->rx_desc_capacity = num;
+    }
+    // circular list, the DMA keeps filling the buffer until the reception is stopped
+    for (size_t i = 0; i < num; i++) {
+        dma_descriptor_align4_t *desc = &uhci_ctrl->rx_desc[i];
+        desc->dw0.size = node_size;
+        desc->dw0.length = 0;
+        desc->dw0.suc_eof = 0;
+        desc->dw0.err_eof = 0;
+        desc->dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+        desc->buffer = read_buffer + i * node_size;
+        desc->next = &uhci_ctrl->rx_desc[(i + 1) % num];
+    }
+    uhci_ctrl->rx_desc_num = num;
+    uhci_ctrl->rx_next = 0;
+    uhci_ctrl->rx_overrun = false;
+    uhci_ctrl->rx_running = true;
+    uhci_rx_restart(uhci_ctrl);
+    return ESP_OK;
+}
+
+esp_err_t uhci_receive_stop(uhci_controller_handle_t uhci_ctrl)
+{
+    ESP_RETURN_ON_FALSE(uhci_ctrl, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    gdma_stop(uhci_ctrl->rx_chan);
+    uhci_ctrl->rx_running = false;
+    gdma_reset(uhci_ctrl->rx_chan);
+    return ESP_OK;
+}
+
+esp_err_t uhci_transmit(uhci_controller_handle_t uhci_ctrl, uint8_t *write_buffer, size_t write_size)
+{
+    ESP_RETURN_ON_FALSE(uhci_ctrl && write_buffer && write_size, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(write_size <= uhci_ctrl->max_transmit_size, ESP_ERR_INVALID_ARG, TAG, "write size exceeds max_transmit_size");
+    ESP_RETURN_ON_FALSE(esp_ptr_dma_capable(write_buffer), ESP_ERR_INVALID_ARG, TAG, "buffer must be DMA capable");
+
+    xSemaphoreTake(uhci_ctrl->tx_free_sem, portMAX_DELAY);
+    portENTER_CRITICAL(&uhci_ctrl->spinlock);
+    uhci_tx_trans_t *trans = &uhci_ctrl->tx_trans[uhci_ctrl->tx_head];
+    uhci_ctrl->tx_head = (uhci_ctrl->tx_head + 1) % uhci_ctrl->tx_queue_depth;
+    trans->buffer = write_buffer;
+    trans->size = write_size;
+    size_t offset = 0;
+    for (dma_descriptor_align4_t *desc = trans->desc; ; desc++) {
+        size_t len = MIN(write_size - offset, DMA_DESCRIPTOR_BUFFER_MAX_SIZE_4B_ALIGNED);
+        desc->dw0.size = len;
+        desc->dw0.length = len;
+        desc->dw0.err_eof = 0;
+        desc->buffer = write_buffer + offset;
+        desc->dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+        offset += len;
+        if (offset == write_size) {
+            desc->dw0.suc_eof = 1;
+            desc->next = NULL;
+            break;
+        }
+        desc->dw0.suc_eof = 0;
+        desc->next = desc + 1;
+    }
+    // start the transaction if the DMA is idle, otherwise the EOF callback of the previous one starts it
+    if (uhci_ctrl->tx_pending++ == 0) {
+        gdma_start(uhci_ctrl->tx_chan, (intptr_t)trans->desc);
+    }
+    portEXIT_CRITICAL(&uhci_ctrl->spinlock);
+    return ESP_OK;
+}
+
+esp_err_t uhci_wait_all_tx_transaction_done(uhci_controller_handle_t uhci_ctrl, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(uhci_ctrl, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    TickType_t wait_ticks = timeout_ms < 0 ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    TimeOut_t timeout;
+    vTaskSetTimeOutState(&timeout);
+    // all the transactions are done once all of them are free
+    size_t taken = 0;
+    esp_err_t ret = ESP_OK;
+    while (taken < uhci_ctrl->tx_queue_depth) {
+        if (xTaskCheckForTimeOut(&timeout, &wait_ticks) == pdTRUE ||
+                xSemaphoreTake(uhci_ctrl->tx_free_sem, wait_ticks) != pdTRUE) {
+            ret = ESP_ERR_TIMEOUT;
+            break;
+        }
+        taken++;
+    }
+    while (taken--) {
+        xSemaphoreGive(uhci_ctrl->tx_free_sem);
+    }
+    return ret;
+}
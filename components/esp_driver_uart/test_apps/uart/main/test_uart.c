@@ -389,6 +389,56 @@ TEST_CASE("uart read write test", "[uart]")
     vTaskDelay(2); // wait for uart_write_task to exit
 }
 
+TEST_CASE("uart rx borrow and return", "[uart]")
+{
+    uart_port_param_t port_param = {};
+    TEST_ASSERT(port_select(&port_param));
+
+    uart_port_t uart_num = port_param.port_num;
+    uart_config_t uart_config = {
+        .baud_rate = 115200,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = port_param.default_src_clk,
+    };
+    const int rx_buf_size = 256;
+    const int len = 200;
+    uint8_t tx_buf[200];
+    TEST_ESP_OK(uart_driver_install(uart_num, rx_buf_size, 0, 0, NULL, 0));
+    TEST_ESP_OK(uart_param_config(uart_num, &uart_config));
+    TEST_ESP_OK(uart_set_loop_back(uart_num, true));
+    TEST_ESP_OK(uart_flush_input(uart_num));
+
+    const uint8_t *data = NULL;
+    size_t size = 0;
+    TEST_ESP_ERR(ESP_ERR_TIMEOUT, uart_rx_borrow(uart_num, &data, &size, 0, pdMS_TO_TICKS(10)));
+
+    // the second message wraps around the end of the ring buffer
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < len; i++) {
+            tx_buf[i] = i + round;
+        }
+        TEST_ASSERT_EQUAL(len, uart_write_bytes(uart_num, tx_buf, len));
+        TEST_ESP_OK(uart_wait_tx_done(uart_num, portMAX_DELAY));
+        int received = 0;
+        while (received < len) {
+            TEST_ESP_OK(uart_rx_borrow(uart_num, &data, &size, len - received, pdMS_TO_TICKS(100)));
+            TEST_ASSERT_TRUE(size > 0 && size <= len - received);
+            TEST_ESP_ERR(ESP_ERR_INVALID_STATE, uart_rx_borrow(uart_num, &data, &size, 0, 0));
+            TEST_ESP_ERR(ESP_ERR_INVALID_ARG, uart_rx_return(uart_num, tx_buf));
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(tx_buf + received, data, size);
+            received += size;
+            TEST_ESP_OK(uart_rx_return(uart_num, data));
+        }
+        size_t buffered = 0;
+        TEST_ESP_OK(uart_get_buffered_data_len(uart_num, &buffered));
+        TEST_ASSERT_EQUAL(0, buffered);
+    }
+    TEST_ESP_OK(uart_driver_delete(uart_num));
+}
+
 TEST_CASE("uart tx with ringbuffer test", "[uart]")
 {
     uart_port_param_t port_param = {};
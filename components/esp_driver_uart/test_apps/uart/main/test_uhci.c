@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "driver/uart.h"
+#include "driver/uhci.h"
+
+#define TEST_UHCI_TRANS_SIZE    2000
+#define TEST_UHCI_TRANS_NUM     8
+#define TEST_UHCI_RX_NODE_SIZE  512
+#define TEST_UHCI_RX_BUF_SIZE   (TEST_UHCI_RX_NODE_SIZE * 16)
+
+typedef struct {
+    uint8_t *data;
+    volatile size_t size;
+    bool overrun;
+    SemaphoreHandle_t done;
+} test_uhci_rx_ctx_t;
+
+static IRAM_ATTR bool test_uhci_on_rx(uhci_controller_handle_t uhci_ctrl, const uhci_rx_event_data_t *edata, void *user_ctx)
+{
+    test_uhci_rx_ctx_t *ctx = (test_uhci_rx_ctx_t *)user_ctx;
+    BaseType_t high_task_woken = pdFALSE;
+    if (ctx->size + edata->recv_size <= TEST_UHCI_TRANS_SIZE * TEST_UHCI_TRANS_NUM) {
+        memcpy(ctx->data + ctx->size, edata->data, edata->recv_size);
+    }
+    ctx->size += edata->recv_size;
+    ctx->overrun |= edata->flags.overrun;
+    if (edata->flags.eof) {
+        xSemaphoreGiveFromISR(ctx->done, &high_task_woken);
+    }
+    return high_task_woken == pdTRUE;
+}
+
+// UHCI is only connected to the HP UARTs
+TEST_CASE("uhci receives what it transmits in loop back mode", "[uart][hp-uart-only]")
+{
+    const uart_port_t uart_num = UART_NUM_1;
+    uart_config_t uart_config = {
+        .baud_rate = 3000000,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+    TEST_ESP_OK(uart_param_config(uart_num, &uart_config));
+    TEST_ESP_OK(uart_set_loop_back(uart_num, true));
+
+    uhci_controller_config_t uhci_config = {
+        .uart_port = uart_num,
+        .tx_trans_queue_depth = 4,
+        .max_transmit_size = TEST_UHCI_TRANS_SIZE,
+        .rx_node_size = TEST_UHCI_RX_NODE_SIZE,
+        .rx_eof_flags.idle_eof = 1,
+    };
+    uhci_controller_handle_t uhci_ctrl = NULL;
+    TEST_ESP_OK(uhci_new_controller(&uhci_config, &uhci_ctrl));
+
+    uint8_t *tx_buf = heap_caps_malloc(TEST_UHCI_TRANS_SIZE * TEST_UHCI_TRANS_NUM, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    uint8_t *rx_buf = heap_caps_malloc(TEST_UHCI_RX_BUF_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    test_uhci_rx_ctx_t *ctx = heap_caps_calloc(1, sizeof(test_uhci_rx_ctx_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(tx_buf);
+    TEST_ASSERT_NOT_NULL(rx_buf);
+    TEST_ASSERT_NOT_NULL(ctx);
+    ctx->data = heap_caps_malloc(TEST_UHCI_TRANS_SIZE * TEST_UHCI_TRANS_NUM, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ctx->done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(ctx->data);
+    TEST_ASSERT_NOT_NULL(ctx->done);
+    for (int i = 0; i < TEST_UHCI_TRANS_SIZE * TEST_UHCI_TRANS_NUM; i++) {
+        tx_buf[i] = i * 7 + (i >> 8);
+    }
+
+    uhci_event_callbacks_t cbs = {
+        .on_rx_trans_event = test_uhci_on_rx,
+    };
+    TEST_ESP_OK(uhci_register_event_callbacks(uhci_ctrl, &cbs, ctx));
+    // the buffer must be a multiple of the node size
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, uhci_receive(uhci_ctrl, rx_buf, TEST_UHCI_RX_BUF_SIZE - 4));
+    TEST_ESP_OK(uhci_receive(uhci_ctrl, rx_buf, TEST_UHCI_RX_BUF_SIZE));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, uhci_receive(uhci_ctrl, rx_buf, TEST_UHCI_RX_BUF_SIZE));
+
+    // more data than the RX buffer holds, sent without a pause so that the DMA wraps around
+    for (int i = 0; i < TEST_UHCI_TRANS_NUM; i++) {
+        TEST_ESP_OK(uhci_transmit(uhci_ctrl, tx_buf + i * TEST_UHCI_TRANS_SIZE, TEST_UHCI_TRANS_SIZE));
+    }
+    TEST_ESP_OK(uhci_wait_all_tx_transaction_done(uhci_ctrl, 1000));
+    // the line may also become idle between two transmissions, wait for the packet which ends the data
+    while (ctx->size < TEST_UHCI_TRANS_SIZE * TEST_UHCI_TRANS_NUM) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(ctx->done, pdMS_TO_TICKS(1000)));
+    }
+
+    TEST_ESP_OK(uhci_receive_stop(uhci_ctrl));
+    TEST_ASSERT_FALSE(ctx->overrun);
+    TEST_ASSERT_EQUAL(TEST_UHCI_TRANS_SIZE * TEST_UHCI_TRANS_NUM, ctx->size);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(tx_buf, ctx->data, TEST_UHCI_TRANS_SIZE * TEST_UHCI_TRANS_NUM);
+
+    TEST_ESP_OK(uhci_del_controller(uhci_ctrl));
+    vSemaphoreDelete(ctx->done);
+    free(ctx->data);
+    free(ctx);
+    free(rx_buf);
+    free(tx_buf);
+}
@@ -29,6 +29,17 @@ typedef struct {
     .rx_buffer_size = 256,\
 }
 
+/**
+ * @brief Throughput statistics of the usb-serial-jtag-driver
+ */
+typedef struct {
+    uint32_t tx_bytes;                          /*!< Bytes moved from the TX ring buffer to the host */
+    uint32_t tx_packets;                        /*!< USB packets sent to the host */
+    uint32_t tx_dropped_bytes;                  /*!< Bytes not accepted by usb_serial_jtag_write_bytes() because the TX ring buffer was full */
+    uint32_t rx_bytes;                          /*!< Bytes received from the host */
+    uint32_t rx_dropped_bytes;                  /*!< Bytes received from the host while the RX ring buffer was full */
+} usb_serial_jtag_stats_t;
+
 /**
  * @brief Install USB-SERIAL-JTAG driver and set the USB-SERIAL-JTAG to the default configuration.
  *
@@ -91,6 +102,29 @@ esp_err_t usb_serial_jtag_wait_tx_done(TickType_t ticks_to_wait);
  */
 esp_err_t usb_serial_jtag_driver_uninstall(void);
 
+/**
+ * @brief Get the throughput statistics of the driver
+ *
+ * The counters start from zero when the driver is installed and wrap around on overflow.
+ *
+ * @param[out] stats Returned statistics
+ *
+ * @return
+ *     - ESP_OK                 Success
+ *     - ESP_ERR_INVALID_ARG    stats is NULL
+ *     - ESP_ERR_INVALID_STATE  Driver is not installed
+ */
+esp_err_t usb_serial_jtag_get_stats(usb_serial_jtag_stats_t *stats);
+
+/**
+ * @brief Reset the throughput statistics of the driver to zero
+ *
+ * @return
+ *     - ESP_OK                 Success
+ *     - ESP_ERR_INVALID_STATE  Driver is not installed
+ */
+esp_err_t usb_serial_jtag_reset_stats(void);
+
 /**
  * @brief Check if the USB Serial/JTAG port is connected to the host
  *
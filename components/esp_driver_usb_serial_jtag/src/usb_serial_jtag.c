@@ -52,6 +52,9 @@ typedef struct {
     SemaphoreHandle_t tx_idle_sem;
 
     usj_select_notif_callback_t usj_select_notif_callback; /*!< Notification about select() events */
+
+    usb_serial_jtag_stats_t stats;      /*!< Throughput statistics */
+    portMUX_TYPE stats_lock;            /*!< Spinlock protecting the statistics */
 } usb_serial_jtag_obj_t;
 
 static usb_serial_jtag_obj_t *p_usb_serial_jtag_obj = NULL;
@@ -74,45 +77,55 @@ static void usb_serial_jtag_isr_handler_default(void *arg)
         // (ROM print routines?) have snuck in a full buffer before we got here. In that case,
         // we simply ignore the interrupt, a new one will come if the buffer is empty again.
         if (usb_serial_jtag_ll_txfifo_writable() == 1) {
-            // Retrieve data from either the stash buffer or, if that's empty, from the ring buffer.
+            // Fill the packet from either the stash buffer or, if that's empty, from the ring buffer.
             size_t queued_size;
             uint8_t *queued_buf = NULL;
+            size_t packet_size = 0;
             if (p_usb_serial_jtag_obj->tx_stash_cnt != 0) {
                 // Send stashed tx bytes before reading bytes from ring buffer
-                queued_buf = p_usb_serial_jtag_obj->tx_stash_buf;
-                queued_size = p_usb_serial_jtag_obj->tx_stash_cnt;
+                packet_size = usb_serial_jtag_ll_write_txfifo(p_usb_serial_jtag_obj->tx_stash_buf, p_usb_serial_jtag_obj->tx_stash_cnt);
+                p_usb_serial_jtag_obj->tx_stash_cnt -= packet_size;
+                memmove(p_usb_serial_jtag_obj->tx_stash_buf, &p_usb_serial_jtag_obj->tx_stash_buf[packet_size], p_usb_serial_jtag_obj->tx_stash_cnt);
             } else {
-                // Max 64 data payload size in a single EndPoint
-                queued_buf = (uint8_t *)xRingbufferReceiveUpToFromISR(p_usb_serial_jtag_obj->tx_ring_buf, &queued_size, USB_SER_JTAG_ENDP_SIZE);
+                // When the data wraps around the end of the ring buffer, a single read returns only the part
+                // before the end. Read again so that full packets are sent, a host only polls once per frame.
+                bool ringbuf_read = false;
+                while (packet_size < USB_SER_JTAG_ENDP_SIZE) {
+                    queued_buf = (uint8_t *)xRingbufferReceiveUpToFromISR(p_usb_serial_jtag_obj->tx_ring_buf, &queued_size, USB_SER_JTAG_ENDP_SIZE - packet_size);
+                    if (queued_buf == NULL || queued_size == 0) {
+                        break;
+                    }
+                    uint32_t sent_size = usb_serial_jtag_ll_write_txfifo(queued_buf, queued_size);
+                    packet_size += sent_size;
+                    if (sent_size < queued_size) {
+                        // Not all bytes could be sent at once; stash the unwritten bytes in a buffer
+                        // This will happen if e.g. the rom output functions manage to sneak a few bytes into the
+                        // TX FIFO before this interrupt triggers. Note stash_size will not larger than
+                        // USB_SER_JTAG_ENDP_SIZE because queued_size is obtained from xRingbufferReceiveUpToFromISR.
+                        size_t stash_size = queued_size - sent_size;
+                        memcpy(p_usb_serial_jtag_obj->tx_stash_buf, &queued_buf[sent_size], stash_size);
+                        p_usb_serial_jtag_obj->tx_stash_cnt = stash_size;
+                    }
+                    vRingbufferReturnItemFromISR(p_usb_serial_jtag_obj->tx_ring_buf, queued_buf, &xTaskWoken);
+                    ringbuf_read = true;
+                    if (sent_size < queued_size) {
+                        break;
+                    }
+                }
+                // We just moved items out of the TX ring buffer, the driver is considered write ready, since
+                // the TX ring buffer is assured to be not full.
+                if (ringbuf_read && p_usb_serial_jtag_obj->usj_select_notif_callback) {
+                    p_usb_serial_jtag_obj->usj_select_notif_callback(USJ_SELECT_WRITE_NOTIF, &xTaskWoken);
+                }
             }
 
-            if (queued_buf != NULL && queued_size > 0) {
+            if (packet_size > 0 || p_usb_serial_jtag_obj->tx_stash_cnt != 0) {
                 // We have some data to send. Send it.
-                uint32_t sent_size = usb_serial_jtag_ll_write_txfifo(queued_buf, queued_size);
                 usb_serial_jtag_ll_txfifo_flush();
-
-                // Check if we were able to send everything.
-                if (sent_size < queued_size) {
-                    // Not all bytes could be sent at once; stash the unwritten bytes in a buffer
-                    // This will happen if e.g. the rom output functions manage to sneak a few bytes into the
-                    // TX FIFO before this interrupt triggers. Note stash_size will not larger than
-                    // USB_SER_JTAG_ENDP_SIZE because queued_size is obtained from xRingbufferReceiveUpToFromISR.
-                    size_t stash_size = queued_size - sent_size;
-                    memcpy(p_usb_serial_jtag_obj->tx_stash_buf, &queued_buf[sent_size], stash_size);
-                    p_usb_serial_jtag_obj->tx_stash_cnt = stash_size;
-                } else {
-                    p_usb_serial_jtag_obj->tx_stash_cnt = 0;
-                }
-                // Return the buffer if we got it from the ring buffer.
-                if (queued_buf != p_usb_serial_jtag_obj->tx_stash_buf) {
-                    vRingbufferReturnItemFromISR(p_usb_serial_jtag_obj->tx_ring_buf, queued_buf, &xTaskWoken);
-
-                    // We just moved items out of the TX ring buffer, the driver is considered write ready, since
-                    // the TX ring buffer is assured to be not full.
-                    if (p_usb_serial_jtag_obj->usj_select_notif_callback) {
-                        p_usb_serial_jtag_obj->usj_select_notif_callback(USJ_SELECT_WRITE_NOTIF, &xTaskWoken);
-                    }
-                }
+                portENTER_CRITICAL_ISR(&p_usb_serial_jtag_obj->stats_lock);
+                p_usb_serial_jtag_obj->stats.tx_bytes += packet_size;
+                p_usb_serial_jtag_obj->stats.tx_packets++;
+                portEXIT_CRITICAL_ISR(&p_usb_serial_jtag_obj->stats_lock);
             } else {
                 // No data to send.
                 // The last transmit may have sent a full EP worth of data. The host will interpret
@@ -147,7 +160,14 @@ static void usb_serial_jtag_isr_handler_default(void *arg)
         // Read RX FIFO and send available data to ringbuffer.
         uint8_t buf[USB_SER_JTAG_RX_MAX_SIZE];
         uint32_t rx_fifo_len = usb_serial_jtag_ll_read_rxfifo(buf, USB_SER_JTAG_RX_MAX_SIZE);
-        xRingbufferSendFromISR(p_usb_serial_jtag_obj->rx_ring_buf, buf, rx_fifo_len, &xTaskWoken);
+        BaseType_t rx_sent = xRingbufferSendFromISR(p_usb_serial_jtag_obj->rx_ring_buf, buf, rx_fifo_len, &xTaskWoken);
+        portENTER_CRITICAL_ISR(&p_usb_serial_jtag_obj->stats_lock);
+        if (rx_sent == pdTRUE) {
+            p_usb_serial_jtag_obj->stats.rx_bytes += rx_fifo_len;
+        } else {
+            p_usb_serial_jtag_obj->stats.rx_dropped_bytes += rx_fifo_len;
+        }
+        portEXIT_CRITICAL_ISR(&p_usb_serial_jtag_obj->stats_lock);
 
         if (p_usb_serial_jtag_obj->usj_select_notif_callback) {
             p_usb_serial_jtag_obj->usj_select_notif_callback(USJ_SELECT_READ_NOTIF, &xTaskWoken);
@@ -174,6 +194,7 @@ esp_err_t usb_serial_jtag_driver_install(usb_serial_jtag_driver_config_t *usb_se
         return ESP_ERR_NO_MEM;
     }
     p_usb_serial_jtag_obj->tx_stash_cnt = 0;
+    portMUX_INITIALIZE(&p_usb_serial_jtag_obj->stats_lock);
 
     p_usb_serial_jtag_obj->rx_ring_buf = xRingbufferCreate(usb_serial_jtag_config->rx_buffer_size, RINGBUF_TYPE_BYTEBUF);
     if (p_usb_serial_jtag_obj->rx_ring_buf == NULL) {
@@ -262,6 +283,13 @@ int usb_serial_jtag_read_bytes(void* buf, uint32_t length, TickType_t ticks_to_w
     return data_read_len;
 }
 
+static void usb_serial_jtag_count_tx_dropped(size_t size)
+{
+    portENTER_CRITICAL(&p_usb_serial_jtag_obj->stats_lock);
+    p_usb_serial_jtag_obj->stats.tx_dropped_bytes += size;
+    portEXIT_CRITICAL(&p_usb_serial_jtag_obj->stats_lock);
+}
+
 int usb_serial_jtag_write_bytes(const void* src, size_t size, TickType_t ticks_to_wait)
 {
     ESP_RETURN_ON_FALSE(src && size, 0, USB_SERIAL_JTAG_TAG, "invalid buffer or size");
@@ -271,6 +299,7 @@ int usb_serial_jtag_write_bytes(const void* src, size_t size, TickType_t ticks_t
     //Note that the ringbuffer itself is thread-safe, so this is only needed to handle wait_tx_done.
     BaseType_t result = xSemaphoreTake(p_usb_serial_jtag_obj->tx_mux, ticks_to_wait);
     if (result == pdFALSE) {
+        usb_serial_jtag_count_tx_dropped(size);
         return 0;
     }
 
@@ -285,7 +314,11 @@ int usb_serial_jtag_write_bytes(const void* src, size_t size, TickType_t ticks_t
     // same point the ISR does a read-modify-write to disable the interrupt,
     usb_serial_jtag_ll_ena_intr_mask(USB_SERIAL_JTAG_INTR_SERIAL_IN_EMPTY);
     xSemaphoreGive(p_usb_serial_jtag_obj->tx_mux);
-    return (result == pdFALSE) ? 0 : size;
+    if (result == pdFALSE) {
+        usb_serial_jtag_count_tx_dropped(size);
+        return 0;
+    }
+    return size;
 }
 
 esp_err_t usb_serial_jtag_wait_tx_done(TickType_t ticks_to_wait)
@@ -354,6 +387,25 @@ esp_err_t usb_serial_jtag_driver_uninstall(void)
     return ESP_OK;
 }
 
+esp_err_t usb_serial_jtag_get_stats(usb_serial_jtag_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, USB_SERIAL_JTAG_TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(p_usb_serial_jtag_obj != NULL, ESP_ERR_INVALID_STATE, USB_SERIAL_JTAG_TAG, "driver is not initialized yet");
+    portENTER_CRITICAL(&p_usb_serial_jtag_obj->stats_lock);
+    *stats = p_usb_serial_jtag_obj->stats;
+    portEXIT_CRITICAL(&p_usb_serial_jtag_obj->stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t usb_serial_jtag_reset_stats(void)
+{
+    ESP_RETURN_ON_FALSE(p_usb_serial_jtag_obj != NULL, ESP_ERR_INVALID_STATE, USB_SERIAL_JTAG_TAG, "driver is not initialized yet");
+    portENTER_CRITICAL(&p_usb_serial_jtag_obj->stats_lock);
+    memset(&p_usb_serial_jtag_obj->stats, 0, sizeof(usb_serial_jtag_stats_t));
+    portEXIT_CRITICAL(&p_usb_serial_jtag_obj->stats_lock);
+    return ESP_OK;
+}
+
 bool usb_serial_jtag_is_driver_installed(void)
 {
     return (p_usb_serial_jtag_obj != NULL);
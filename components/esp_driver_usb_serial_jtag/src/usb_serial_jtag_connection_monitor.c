@@ -14,7 +14,8 @@
 #include "esp_check.h"
 #include "sdkconfig.h"
 
-static volatile bool s_usb_serial_jtag_conn_status;
+// Assumed connected until the monitor is started, so that the early console output isn't dropped
+static volatile bool s_usb_serial_jtag_conn_status = true;
 #if CONFIG_USJ_NO_AUTO_LS_ON_CONNECTION
 static esp_pm_lock_handle_t s_usb_serial_jtag_pm_lock;
 #endif
@@ -57,15 +57,18 @@
 #define USJ_VFS_MALLOC_FLAGS MALLOC_CAP_DEFAULT
 #endif
 
+// Size of the chunks written to the port after newline conversion, one USB packet
+#define TX_CHUNK_SIZE 64
+
 // write bytes function type
-typedef void (*tx_func_t)(int, int);
+typedef void (*tx_func_t)(int, const char *, size_t);
 // read bytes function type
 typedef int (*rx_func_t)(int);
 // fsync bytes function type
 typedef int (*fsync_func_t)(int);
 
 // Basic functions for sending and receiving bytes and fsync
-static void usb_serial_jtag_tx_char_no_driver(int fd, int c);
+static void usb_serial_jtag_tx_no_driver(int fd, const char *buf, size_t len);
 static int usb_serial_jtag_rx_char_no_driver(int fd);
 static int usb_serial_jtag_wait_tx_done_no_driver(int fd);
 
@@ -90,7 +93,8 @@ typedef struct {
     // The default implementation does not honor this flag, all reads
     // are non-blocking.
     // When the driver is used (via esp_vfs_usb_serial_jtag_use_driver),
-    // reads are either blocking or non-blocking depending on this flag.
+    // reads are either blocking or non-blocking depending on this flag,
+    // and non-blocking writes drop the data the TX buffer can't take.
     bool non_blocking;
     // TX has already tried a blocking send.
     bool tx_tried_blocking;
@@ -114,7 +118,7 @@ static usb_serial_jtag_vfs_context_t s_ctx = {
     .peek_char = NONE,
     .tx_mode = DEFAULT_TX_MODE,
     .rx_mode = DEFAULT_RX_MODE,
-    .tx_func = usb_serial_jtag_tx_char_no_driver,
+    .tx_func = usb_serial_jtag_tx_no_driver,
     .rx_func = usb_serial_jtag_rx_char_no_driver,
     .fsync_func = usb_serial_jtag_wait_tx_done_no_driver
 };
@@ -145,29 +149,34 @@ static int usb_serial_jtag_open(const char * path, int flags, int mode)
     return USJ_LOCAL_FD;
 }
 
-static void usb_serial_jtag_tx_char_no_driver(int fd, int c)
+static void usb_serial_jtag_tx_no_driver(int fd, const char *buf, size_t len)
 {
-    uint8_t cc = (uint8_t)c;
-    // Try to write to the buffer as long as we still expect the buffer to have
-    // a chance of being emptied by an active host. Just drop the data if there's
-    // no chance anymore.
-    // When we first try to send a character and the buffer is not accessible yet,
-    // we wait until the time has been more than TX_FLUSH_TIMEOUT_US since we successfully
-    // sent the last byte. If it takes longer than TX_FLUSH_TIMEOUT_US, we drop every
-    // byte until the buffer can be accessible again.
-    do {
-        if (usb_serial_jtag_ll_txfifo_writable()) {
-            usb_serial_jtag_ll_write_txfifo(&cc, 1);
-            if (c == '\n') {
-                //Make sure line doesn't linger in fifo
-                usb_serial_jtag_ll_txfifo_flush();
+    // No host is polling the port, the data would only be dropped after the timeout.
+    if (!usb_serial_jtag_is_connected()) {
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        uint8_t cc = (uint8_t)buf[i];
+        // Try to write to the buffer as long as we still expect the buffer to have
+        // a chance of being emptied by an active host. Just drop the data if there's
+        // no chance anymore.
+        // When we first try to send a character and the buffer is not accessible yet,
+        // we wait until the time has been more than TX_FLUSH_TIMEOUT_US since we successfully
+        // sent the last byte. If it takes longer than TX_FLUSH_TIMEOUT_US, we drop every
+        // byte until the buffer can be accessible again.
+        do {
+            if (usb_serial_jtag_ll_txfifo_writable()) {
+                usb_serial_jtag_ll_write_txfifo(&cc, 1);
+                if (cc == '\n') {
+                    //Make sure line doesn't linger in fifo
+                    usb_serial_jtag_ll_txfifo_flush();
+                }
+                //update time of last successful tx to now.
+                s_ctx.last_tx_ts = esp_timer_get_time();
+                break;
             }
-            //update time of last successful tx to now.
-            s_ctx.last_tx_ts = esp_timer_get_time();
-            break;
-        }
-    } while ((esp_timer_get_time() - s_ctx.last_tx_ts) < TX_FLUSH_TIMEOUT_US);
-
+        } while ((esp_timer_get_time() - s_ctx.last_tx_ts) < TX_FLUSH_TIMEOUT_US);
+    }
 }
 
 static int usb_serial_jtag_rx_char_no_driver(int fd)
@@ -183,20 +192,31 @@ static int usb_serial_jtag_rx_char_no_driver(int fd)
 static ssize_t usb_serial_jtag_write(int fd, const void * data, size_t size)
 {
     const char *data_c = (const char *)data;
+    // The converted data is passed to the port in chunks rather than byte by byte
+    char chunk[TX_CHUNK_SIZE];
+    size_t chunk_len = 0;
     /*  Even though newlib does stream locking on each individual stream, we need
      *  a dedicated lock if two streams (stdout and stderr) point to the
      *  same port.
      */
     _lock_acquire_recursive(&s_ctx.write_lock);
     for (size_t i = 0; i < size; i++) {
-        int c = data_c[i];
+        // keep room for a converted newline
+        if (chunk_len > TX_CHUNK_SIZE - 2) {
+            s_ctx.tx_func(fd, chunk, chunk_len);
+            chunk_len = 0;
+        }
+        char c = data_c[i];
         if (c == '\n' && s_ctx.tx_mode != ESP_LINE_ENDINGS_LF) {
-            s_ctx.tx_func(fd, '\r');
+            chunk[chunk_len++] = '\r';
             if (s_ctx.tx_mode == ESP_LINE_ENDINGS_CR) {
                 continue;
             }
         }
-        s_ctx.tx_func(fd, c);
+        chunk[chunk_len++] = c;
+    }
+    if (chunk_len > 0) {
+        s_ctx.tx_func(fd, chunk, chunk_len);
     }
     _lock_release_recursive(&s_ctx.write_lock);
     return size;
@@ -647,17 +667,23 @@ static int usbjtag_rx_char_via_driver(int fd)
     return c;
 }
 
-static void usbjtag_tx_char_via_driver(int fd, int c)
+static void usbjtag_tx_via_driver(int fd, const char *buf, size_t len)
 {
-    char ch = (char) c;
     TickType_t ticks = (TX_FLUSH_TIMEOUT_US / 1000) / portTICK_PERIOD_MS;
-    if (usb_serial_jtag_write_bytes(&ch, 1, 0) != 0) {
+    if (usb_serial_jtag_write_bytes(buf, len, 0) != 0) {
         s_ctx.tx_tried_blocking = false;
         return;
     }
 
+    // Don't wait for the TX buffer to drain when the caller asked not to block,
+    // or when no host is polling the port. The dropped bytes are counted in the
+    // driver statistics.
+    if (s_ctx.non_blocking || !usb_serial_jtag_is_connected()) {
+        return;
+    }
+
     if (s_ctx.tx_tried_blocking == false) {
-        if (usb_serial_jtag_write_bytes(&ch, 1, ticks) != 0) {
+        if (usb_serial_jtag_write_bytes(buf, len, ticks) != 0) {
             return;
         } else {
             s_ctx.tx_tried_blocking = true;
@@ -676,7 +702,7 @@ void usb_serial_jtag_vfs_use_nonblocking(void)
 {
     _lock_acquire_recursive(&s_ctx.read_lock);
     _lock_acquire_recursive(&s_ctx.write_lock);
-    s_ctx.tx_func = usb_serial_jtag_tx_char_no_driver;
+    s_ctx.tx_func = usb_serial_jtag_tx_no_driver;
     s_ctx.rx_func = usb_serial_jtag_rx_char_no_driver;
     s_ctx.fsync_func = usb_serial_jtag_wait_tx_done_no_driver;
     _lock_release_recursive(&s_ctx.write_lock);
@@ -687,7 +713,7 @@ void usb_serial_jtag_vfs_use_driver(void)
 {
     _lock_acquire_recursive(&s_ctx.read_lock);
     _lock_acquire_recursive(&s_ctx.write_lock);
-    s_ctx.tx_func = usbjtag_tx_char_via_driver;
+    s_ctx.tx_func = usbjtag_tx_via_driver;
     s_ctx.rx_func = usbjtag_rx_char_via_driver;
     s_ctx.fsync_func = usbjtag_wait_tx_done_via_driver;
     _lock_release_recursive(&s_ctx.write_lock);
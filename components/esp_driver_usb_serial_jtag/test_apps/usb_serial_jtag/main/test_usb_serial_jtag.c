@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
 #include <string.h>
 #include <sys/param.h>
 #include "unity.h"
@@ -136,3 +138,47 @@ TEST_CASE("test rom printf work after driver installed", "[usb_serial_jtag]")
     usb_serial_jtag_vfs_use_nonblocking();
     usb_serial_jtag_driver_uninstall();
 }
+
+TEST_CASE("test usb_serial_jtag driver statistics", "[usb_serial_jtag]")
+{
+    usb_serial_jtag_driver_config_t cfg = {
+        .tx_buffer_size = 1024,
+        .rx_buffer_size = 128
+    };
+    usb_serial_jtag_stats_t stats;
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, usb_serial_jtag_get_stats(&stats));
+    TEST_ESP_OK(usb_serial_jtag_driver_install(&cfg));
+
+    TEST_ESP_OK(usb_serial_jtag_get_stats(&stats));
+    TEST_ASSERT_EQUAL(0, stats.tx_bytes);
+
+    // 300 bytes take several packets, the ring buffer wraps around its end
+    char buf[300];
+    memset(buf, 0, sizeof(buf));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(sizeof(buf), usb_serial_jtag_write_bytes(buf, sizeof(buf), portMAX_DELAY));
+    }
+    TEST_ESP_OK(usb_serial_jtag_wait_tx_done(pdMS_TO_TICKS(100)));
+
+    TEST_ESP_OK(usb_serial_jtag_get_stats(&stats));
+    printf("tx %"PRIu32" bytes in %"PRIu32" packets\n", stats.tx_bytes, stats.tx_packets);
+    TEST_ASSERT_EQUAL(4 * sizeof(buf), stats.tx_bytes);
+    // the packets are filled up to the endpoint size
+    TEST_ASSERT_LESS_OR_EQUAL((4 * sizeof(buf) + 63) / 64 + 2, stats.tx_packets);
+    TEST_ASSERT_EQUAL(0, stats.tx_dropped_bytes);
+
+    // a write larger than the ring buffer can't be queued
+    char *big = calloc(1, 2048);
+    TEST_ASSERT_NOT_NULL(big);
+    TEST_ASSERT_EQUAL(0, usb_serial_jtag_write_bytes(big, 2048, 0));
+    free(big);
+    TEST_ESP_OK(usb_serial_jtag_get_stats(&stats));
+    TEST_ASSERT_EQUAL(2048, stats.tx_dropped_bytes);
+
+    TEST_ESP_OK(usb_serial_jtag_reset_stats());
+    TEST_ESP_OK(usb_serial_jtag_get_stats(&stats));
+    TEST_ASSERT_EQUAL(0, stats.tx_bytes);
+    TEST_ASSERT_EQUAL(0, stats.tx_dropped_bytes);
+
+    usb_serial_jtag_driver_uninstall();
+}
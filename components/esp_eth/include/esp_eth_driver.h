@@ -175,6 +175,7 @@ typedef enum {
     ETH_CMD_S_PHY_LOOPBACK,           /*!< Set PHY loopback */
     ETH_CMD_READ_PHY_REG,             /*!< Read PHY register */
     ETH_CMD_WRITE_PHY_REG,            /*!< Write PHY register */
+    ETH_CMD_G_TX_CHECKSUM_OFFLOAD,    /*!< Get whether TX checksums are inserted by the MAC */
 
     ETH_CMD_CUSTOM_MAC_CMDS = ETH_CMD_CUSTOM_MAC_CMDS_OFFSET, // Offset for start of MAC custom commands
     ETH_CMD_CUSTOM_PHY_CMDS = ETH_CMD_CUSTOM_PHY_CMDS_OFFSET, // Offset for start of PHY custom commands
@@ -300,6 +301,22 @@ esp_err_t esp_eth_update_input_path_info(
     esp_err_t (*stack_input_info)(esp_eth_handle_t hdl, uint8_t *buffer, uint32_t length, void *priv, void *info),
     void *priv);
 
+/**
+* @brief Release a buffer which the Ethernet driver passed to the input path
+*
+* @note The buffers passed to `stack_input` are usually allocated by malloc() and may also be released by free(). This API
+*       needs to be used instead when the MAC passes its own buffers to the input path, which is the case of the internal
+*       EMAC with CONFIG_ETH_DMA_RX_ZERO_COPY enabled.
+*
+* @param[in] hdl handle of Ethernet driver
+* @param[in] buf buffer to be released
+*
+* @return
+*       - ESP_OK: release buffer successfully
+*       - ESP_ERR_INVALID_ARG: release buffer failed because of some invalid argument
+*/
+esp_err_t esp_eth_free_rx_buffer(esp_eth_handle_t hdl, void *buf);
+
 /**
 * @brief General Transmit
 *
@@ -380,6 +397,7 @@ esp_err_t esp_eth_transmit_ctrl_vargs(esp_eth_handle_t hdl, void *ctrl, uint32_t
 *                            Preconditions: Ethernet driver needs to be stopped and auto-negotiation disabled.
 * @li @c ETH_CMD_G_DUPLEX_MODE gets current Ethernet link duplex mode.  @c data argument is pointer to memory of eth_duplex_t datatype to which the duplex mode is to be stored.
 * @li @c ETH_CMD_S_PHY_LOOPBACK sets/resets PHY to/from loopback mode. @c data argument is pointer to memory of bool datatype from which the configuration option is read.
+* @li @c ETH_CMD_G_TX_CHECKSUM_OFFLOAD gets whether the MAC inserts the IPv4 header and TCP checksums of the transmitted frames. @c data argument is pointer to memory of bool datatype to which the status is to be stored.
 *
 * @li Note that additional control commands may be available for specific MAC or PHY chips. Please consult specific MAC or PHY documentation or driver code.
 */
@@ -339,6 +339,34 @@ struct esp_eth_mac_s {
     *
     */
     esp_err_t (*del)(esp_eth_mac_t *mac);
+
+    /**
+    * @brief Get whether the MAC inserts the IPv4 header and TCP checksums of the transmitted frames
+    *
+    * @note This function may not be assigned when the MAC chip doesn't offload checksums.
+    *
+    * @param[in] mac: Ethernet MAC instance
+    * @param[out] enable: true if the checksums are inserted by the MAC
+    *
+    * @return
+    *      - ESP_OK: get checksum offload status successfully
+    *      - ESP_ERR_INVALID_ARG: get checksum offload status failed because of invalid argument
+    */
+    esp_err_t (*get_tx_checksum_offload)(esp_eth_mac_t *mac, bool *enable);
+
+    /**
+    * @brief Release a buffer which the MAC passed to the upper layer
+    *
+    * @note This function may not be assigned when the received frames are always passed in buffers allocated by malloc().
+    *
+    * @param[in] mac: Ethernet MAC instance
+    * @param[in] buf: buffer to be released
+    *
+    * @return
+    *      - ESP_OK: release buffer successfully
+    *      - ESP_ERR_INVALID_ARG: release buffer failed because of invalid argument
+    */
+    esp_err_t (*free_rx_buffer)(esp_eth_mac_t *mac, uint8_t *buf);
 };
 
 /**
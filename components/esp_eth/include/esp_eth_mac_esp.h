@@ -197,9 +197,27 @@ typedef enum {
     ETH_MAC_ESP_CMD_ADJ_PTP_FREQ,                                           /*!< Adjust current PTP time frequency increment by scale factor */
     ETH_MAC_ESP_CMD_ADJ_PTP_TIME,                                           /*!< Adjust base PTP time frequency increment by PPS */
     ETH_MAC_ESP_CMD_S_TARGET_TIME,                                          /*!< Set Target Time at which interrupt is invoked when PTP time exceeds this value*/
-    ETH_MAC_ESP_CMD_S_TARGET_CB                                             /*!< Set pointer to a callback function invoked when PTP time exceeds Target Time */
+    ETH_MAC_ESP_CMD_S_TARGET_CB,                                            /*!< Set pointer to a callback function invoked when PTP time exceeds Target Time */
+    ETH_MAC_ESP_CMD_S_RX_COALESCE_TIME,                                     /*!< Set maximum delay of the Rx interrupt in microseconds, 0 disables the coalescing (requires CONFIG_ETH_RX_POLLING) */
+    ETH_MAC_ESP_CMD_G_RX_COALESCE_TIME,                                     /*!< Get maximum delay of the Rx interrupt in microseconds (requires CONFIG_ETH_RX_POLLING) */
+    ETH_MAC_ESP_CMD_G_RX_POLL_STATS,                                        /*!< Get statistics of the Rx polls, see eth_mac_esp_rx_poll_stats_t (requires CONFIG_ETH_RX_POLLING) */
+    ETH_MAC_ESP_CMD_CLEAR_RX_POLL_STATS                                     /*!< Clear statistics of the Rx polls (requires CONFIG_ETH_RX_POLLING) */
 } eth_mac_esp_io_cmd_t;
 
+/**
+ * @brief Statistics of the Rx polls
+ *
+ * @note A poll starts when the Rx interrupt wakes up the EMAC Rx task, and ends when the task has processed all
+ *       the received frames and unmasks the Rx interrupt.
+ */
+typedef struct {
+    uint32_t polls;                 /*!< Number of polls */
+    uint32_t frames;                /*!< Number of frames processed in all the polls */
+    uint32_t max_frames_per_poll;   /*!< Maximum number of frames processed in a single poll */
+    uint64_t poll_time_us;          /*!< Time spent in all the polls, in microseconds */
+    uint32_t max_poll_time_us;      /*!< Maximum duration of a single poll, in microseconds */
+} eth_mac_esp_rx_poll_stats_t;
+
 #ifdef SOC_EMAC_IEEE1588V2_SUPPORTED
 /**
  * @brief Type of callback function invoked under Time Stamp target time exceeded interrupt
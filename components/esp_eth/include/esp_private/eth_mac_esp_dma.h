@@ -10,6 +10,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include "sdkconfig.h"
 #include "esp_err.h"
 #include "esp_eth_mac.h"
 
@@ -117,6 +118,37 @@ uint8_t *emac_esp_dma_alloc_recv_buf(emac_esp_dma_handle_t emac_esp_dma, uint32_
  */
 uint32_t emac_esp_dma_receive_frame(emac_esp_dma_handle_t emac_esp_dma, uint8_t *buf, uint32_t size, eth_mac_time_t *ts);
 
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+/**
+ * @brief Take the Rx DMA buffer holding received Ethernet frame, a spare buffer is given to the DMA instead of it.
+ *
+ * @param[in] emac_esp_dma EMAC DMA handle
+ * @param[in, out] size as an input defines maximum size of the frame. As an output, indicates actual size of received
+ *                      Ethernet frame which is waiting to be processed. Returned size may be 0 when there is no waiting valid frame.
+ * @param[out] ts time stamp at which the frame was received by EMAC. Only available on supported targets. Can be NULL
+ *                when time stamp is not required.
+ *
+ * @return Pointer to the buffer holding the frame, to be released by ::emac_esp_dma_free_recv_buf
+ *         NULL when the frame needs to be copied by ::emac_esp_dma_alloc_recv_buf and ::emac_esp_dma_receive_frame, because
+ *         it spans multiple buffers, is larger than @p size or when there is no spare buffer (returned @p size is non-zero)
+ *         NULL when there is no waiting Ethernet frame (returned @p size is zero)
+ *
+ * @note FCS field is not included in returned @p size
+ */
+uint8_t *emac_esp_dma_get_recv_buf(emac_esp_dma_handle_t emac_esp_dma, uint32_t *size, eth_mac_time_t *ts);
+
+/**
+ * @brief Return the buffer obtained by ::emac_esp_dma_get_recv_buf to the spare buffers
+ *
+ * @param[in] emac_esp_dma EMAC DMA handle
+ * @param[in] buf buffer to be released
+ *
+ * @return true when the buffer has been released
+ *         false when the buffer was not obtained by ::emac_esp_dma_get_recv_buf (e.g. allocated by ::emac_esp_dma_alloc_recv_buf)
+ */
+bool emac_esp_dma_free_recv_buf(emac_esp_dma_handle_t emac_esp_dma, uint8_t *buf);
+#endif // CONFIG_ETH_DMA_RX_ZERO_COPY
+
 /**
  * @brief Flush frame stored in Rx DMA
  *
@@ -157,6 +189,19 @@ void emac_esp_dma_clear_tdes0_ctrl_bits(emac_esp_dma_handle_t emac_esp_dma, uint
  */
 void emac_esp_dma_ts_enable(emac_esp_dma_handle_t emac_esp_dma, bool enable);
 
+#if CONFIG_ETH_RX_POLLING
+/**
+ * @brief Delays the Rx interrupt of the frames received from now on
+ *
+ * @note The Rx descriptors returned to DMA from now on do not raise the Rx interrupt when a frame is received into them,
+ *       the interrupt is then raised by the Rx interrupt watchdog. The watchdog must be set before enabling the delay.
+ *
+ * @param[in] emac_esp_dma EMAC DMA handle
+ * @param[in] enable enable when true
+ */
+void emac_esp_dma_set_rx_intr_delay(emac_esp_dma_handle_t emac_esp_dma, bool enable);
+#endif // CONFIG_ETH_RX_POLLING
+
 /**
  * @brief Creates a new instance of the ESP EMAC DMA
  *
@@ -109,7 +109,7 @@ static esp_err_t eth_stack_input(esp_eth_mediator_t *eth, uint8_t *buffer, uint3
         return eth_driver->stack_input_info((esp_eth_handle_t)eth_driver, buffer, length, eth_driver->priv, NULL);
     }
     // No stack input path has been installed, just drop the incoming packets
-    free(buffer); // IDF-11444
+    esp_eth_free_rx_buffer((esp_eth_handle_t)eth_driver, buffer); // IDF-11444
     return ESP_OK;
 }
 
@@ -124,7 +124,7 @@ static esp_err_t eth_stack_input_info(esp_eth_mediator_t *eth, uint8_t *buffer,
         return eth_driver->stack_input((esp_eth_handle_t)eth_driver, buffer, length, eth_driver->priv);
     }
     // No stack input path has been installed, just drop the incoming packets
-    free(buffer); // IDF-11444
+    esp_eth_free_rx_buffer((esp_eth_handle_t)eth_driver, buffer); // IDF-11444
     return ESP_OK;
 }
 
@@ -431,6 +431,21 @@ err:
     return ret;
 }
 
+esp_err_t esp_eth_free_rx_buffer(esp_eth_handle_t hdl, void *buf)
+{
+    esp_err_t ret = ESP_OK;
+    esp_eth_driver_t *eth_driver = (esp_eth_driver_t *)hdl;
+    ESP_GOTO_ON_FALSE(eth_driver, ESP_ERR_INVALID_ARG, err, TAG, "ethernet driver handle can't be null");
+    esp_eth_mac_t *mac = eth_driver->mac;
+    if (mac->free_rx_buffer != NULL) {
+        ret = mac->free_rx_buffer(mac, buf);
+    } else {
+        free(buf);
+    }
+err:
+    return ret;
+}
+
 esp_err_t esp_eth_ioctl(esp_eth_handle_t hdl, esp_eth_io_cmd_t cmd, void *data)
 {
     esp_err_t ret = ESP_OK;
@@ -523,6 +538,13 @@ esp_err_t esp_eth_ioctl(esp_eth_handle_t hdl, esp_eth_io_cmd_t cmd, void *data)
                           phy_addr, phy_w_data->reg_addr, *(phy_w_data->reg_value_p)), err, TAG, "failed to write PHY register");
         }
         break;
+    case ETH_CMD_G_TX_CHECKSUM_OFFLOAD:
+        ESP_GOTO_ON_FALSE(data, ESP_ERR_INVALID_ARG, err, TAG, "no mem to store tx checksum offload status");
+        *(bool *)data = false;
+        if (mac->get_tx_checksum_offload != NULL) {
+            ESP_GOTO_ON_ERROR(mac->get_tx_checksum_offload(mac, (bool *)data), err, TAG, "get tx checksum offload failed");
+        }
+        break;
     default:
         if (phy->custom_ioctl != NULL && cmd >= ETH_CMD_CUSTOM_PHY_CMDS) {
             ret = phy->custom_ioctl(phy, cmd, data);
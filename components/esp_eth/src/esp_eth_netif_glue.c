@@ -43,7 +43,7 @@ static esp_err_t eth_input_to_netif(esp_eth_handle_t eth_handle, uint8_t *buffer
 
 static void eth_l2_free(void *h, void* buffer)
 {
-    free(buffer);
+    esp_eth_free_rx_buffer((esp_eth_handle_t)h, buffer);
 }
 
 static esp_err_t esp_eth_post_attach(esp_netif_t *esp_netif, void *args)
@@ -55,10 +55,13 @@ static esp_err_t esp_eth_post_attach(esp_netif_t *esp_netif, void *args)
     esp_eth_update_input_path_info(netif_glue->eth_driver, eth_input_to_netif, esp_netif);
 
     // set driver related config to esp-netif
+    bool tx_checksum_offload = false;
+    esp_eth_ioctl(netif_glue->eth_driver, ETH_CMD_G_TX_CHECKSUM_OFFLOAD, &tx_checksum_offload);
     esp_netif_driver_ifconfig_t driver_ifconfig = {
         .handle =  netif_glue->eth_driver,
         .transmit = esp_eth_transmit,
-        .driver_free_rx_buffer = eth_l2_free
+        .driver_free_rx_buffer = eth_l2_free,
+        .tx_checksum_offload = tx_checksum_offload
     };
 
     ESP_ERROR_CHECK(esp_netif_set_driver_config(esp_netif, &driver_ifconfig));
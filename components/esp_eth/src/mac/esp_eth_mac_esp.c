@@ -17,6 +17,7 @@
 #include "esp_cpu.h"
 #include "esp_heap_caps.h"
 #include "esp_intr_alloc.h"
+#include "esp_timer.h"
 #ifdef CONFIG_IDF_TARGET_ESP32
 #include "esp_clock_output.h"
 #endif // CONFIG_IDF_TARGET_ESP32
@@ -43,6 +44,8 @@ static const char *TAG = "esp.emac";
 
 #define EMAC_ALLOW_INTR_PRIORITY_MASK   ESP_INTR_FLAG_LOWMED
 
+#define EMAC_RX_INTR_WDT_MAX            (255) // the Rx interrupt watchdog counts in units of 256 system clock cycles
+
 #define RMII_CLK_HZ                     (50000000)
 #define RMII_10M_SPEED_RX_TX_CLK_DIV    (19)
 #define RMII_100M_SPEED_RX_TX_CLK_DIV   (1)
@@ -74,6 +77,11 @@ typedef struct {
     esp_pm_lock_handle_t pm_lock;
 #endif
     eth_mac_dma_burst_len_t dma_burst_len;
+#if CONFIG_ETH_RX_POLLING
+    uint32_t rx_coalesce_us;
+    eth_mac_esp_rx_poll_stats_t rx_poll_stats;
+    portMUX_TYPE rx_poll_stats_lock;
+#endif
 
     // ---- Chip specifics ----
 #ifdef CONFIG_IDF_TARGET_ESP32
@@ -256,6 +264,22 @@ static esp_err_t emac_esp32_set_peer_pause_ability(esp_eth_mac_t *mac, uint32_t
     return ESP_OK;
 }
 
+#if CONFIG_ETH_RX_POLLING
+static esp_err_t emac_esp32_set_rx_coalesce_time(emac_esp32_t *emac, uint32_t time_us)
+{
+    uint32_t wdt_cnt = (uint64_t)time_us * esp_clk_apb_freq() / 1000000 / 256;
+    ESP_RETURN_ON_FALSE(wdt_cnt <= EMAC_RX_INTR_WDT_MAX, ESP_ERR_INVALID_ARG, TAG, "Rx coalescing time too long");
+    if (time_us > 0) {
+        emac_hal_set_rx_intr_watchdog(&emac->hal, wdt_cnt > 0 ? wdt_cnt : 1);
+    } else {
+        /* the watchdog is left running, since the descriptors owned by DMA may still have the Rx interrupt delayed */
+        emac_esp_dma_set_rx_intr_delay(emac->emac_dma_hndl, false);
+    }
+    emac->rx_coalesce_us = time_us;
+    return ESP_OK;
+}
+#endif // CONFIG_ETH_RX_POLLING
+
 esp_err_t emac_esp_custom_ioctl(esp_eth_mac_t *mac, int cmd, void *data)
 {
     emac_esp32_t *emac = __containerof(mac, emac_esp32_t, parent);
@@ -332,6 +356,33 @@ esp_err_t emac_esp_custom_ioctl(esp_eth_mac_t *mac, int cmd, void *data)
     case ETH_MAC_ESP_CMD_S_TARGET_TIME:
         return ESP_ERR_NOT_SUPPORTED;
 #endif
+#if CONFIG_ETH_RX_POLLING
+    case ETH_MAC_ESP_CMD_S_RX_COALESCE_TIME:
+        ESP_RETURN_ON_FALSE(data, ESP_ERR_INVALID_ARG, TAG, "Rx coalescing time invalid argument, can't be NULL");
+        ESP_RETURN_ON_ERROR(emac_esp32_set_rx_coalesce_time(emac, *(uint32_t *)data), TAG, "failed to set Rx coalescing time");
+        break;
+    case ETH_MAC_ESP_CMD_G_RX_COALESCE_TIME:
+        ESP_RETURN_ON_FALSE(data, ESP_ERR_INVALID_ARG, TAG, "Rx coalescing time invalid argument, can't be NULL");
+        *(uint32_t *)data = emac->rx_coalesce_us;
+        break;
+    case ETH_MAC_ESP_CMD_G_RX_POLL_STATS:
+        ESP_RETURN_ON_FALSE(data, ESP_ERR_INVALID_ARG, TAG, "Rx poll statistics invalid argument, can't be NULL");
+        portENTER_CRITICAL(&emac->rx_poll_stats_lock);
+        *(eth_mac_esp_rx_poll_stats_t *)data = emac->rx_poll_stats;
+        portEXIT_CRITICAL(&emac->rx_poll_stats_lock);
+        break;
+    case ETH_MAC_ESP_CMD_CLEAR_RX_POLL_STATS:
+        portENTER_CRITICAL(&emac->rx_poll_stats_lock);
+        memset(&emac->rx_poll_stats, 0, sizeof(emac->rx_poll_stats));
+        portEXIT_CRITICAL(&emac->rx_poll_stats_lock);
+        break;
+#else
+    case ETH_MAC_ESP_CMD_S_RX_COALESCE_TIME:
+    case ETH_MAC_ESP_CMD_G_RX_COALESCE_TIME:
+    case ETH_MAC_ESP_CMD_G_RX_POLL_STATS:
+    case ETH_MAC_ESP_CMD_CLEAR_RX_POLL_STATS:
+        return ESP_ERR_NOT_SUPPORTED;
+#endif // CONFIG_ETH_RX_POLLING
     case ETH_MAC_ESP_CMD_SET_TDES0_CFG_BITS:
         ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_INVALID_ARG, TAG, "cannot set DMA tx desc flag to null");
         emac_esp_dma_set_tdes0_ctrl_bits(emac->emac_dma_hndl, *(uint32_t *)data);
@@ -346,6 +397,17 @@ esp_err_t emac_esp_custom_ioctl(esp_eth_mac_t *mac, int cmd, void *data)
     return ESP_OK;
 }
 
+static esp_err_t emac_esp32_get_tx_checksum_offload(esp_eth_mac_t *mac, bool *enable)
+{
+    ESP_RETURN_ON_FALSE(enable != NULL, ESP_ERR_INVALID_ARG, TAG, "can't store tx checksum offload status to null");
+#if CONFIG_ETH_TX_CHECKSUM_OFFLOAD
+    *enable = true;
+#else
+    *enable = false;
+#endif
+    return ESP_OK;
+}
+
 static esp_err_t emac_esp32_transmit(esp_eth_mac_t *mac, uint8_t *buf, uint32_t length)
 {
     emac_esp32_t *emac = __containerof(mac, emac_esp32_t, parent);
@@ -398,44 +460,114 @@ err:
     return ret;
 }
 
+/* copies the frame out of the DMA buffers into an allocated buffer, which is passed to the upper layer */
+FORCE_INLINE_ATTR void emac_esp32_receive_frame_copy(emac_esp32_t *emac)
+{
+    /* set max expected frame len */
+    uint32_t frame_len = ETH_MAX_PACKET_SIZE;
+    uint8_t *buffer = emac_esp_dma_alloc_recv_buf(emac->emac_dma_hndl, &frame_len);
+    /* we have memory to receive the frame of maximal size previously defined */
+    if (buffer != NULL) {
+#ifdef SOC_EMAC_IEEE1588V2_SUPPORTED
+        eth_mac_time_t ts;
+        eth_mac_time_t *p_ts = &ts;
+#else
+        eth_mac_time_t *p_ts = NULL;
+#endif
+        uint32_t recv_len = emac_esp_dma_receive_frame(emac->emac_dma_hndl, buffer, EMAC_DMA_BUF_SIZE_AUTO, p_ts);
+        if (recv_len == 0) {
+            ESP_LOGE(TAG, "frame copy error");
+            free(buffer);
+            /* ensures that interface to EMAC does not get stuck with unprocessed frames */
+            emac_esp_dma_flush_recv_frame(emac->emac_dma_hndl);
+        } else if (frame_len > recv_len) {
+            ESP_LOGE(TAG, "received frame was truncated");
+            free(buffer);
+        } else {
+            ESP_LOGD(TAG, "receive len= %" PRIu32, recv_len);
+            emac->eth->stack_input_info(emac->eth, buffer, recv_len, (void *)p_ts);
+        }
+    /* if allocation failed and there is a waiting frame */
+    } else if (frame_len) {
+        ESP_LOGE(TAG, "no mem for receive buffer");
+        /* ensures that interface to EMAC does not get stuck with unprocessed frames */
+        emac_esp_dma_flush_recv_frame(emac->emac_dma_hndl);
+    }
+}
+
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+/* passes the DMA buffer holding the frame to the upper layer, returns false when the frame needs to be copied instead */
+FORCE_INLINE_ATTR bool emac_esp32_receive_frame_zero_copy(emac_esp32_t *emac)
+{
+#ifdef SOC_EMAC_IEEE1588V2_SUPPORTED
+    eth_mac_time_t ts;
+    eth_mac_time_t *p_ts = &ts;
+#else
+    eth_mac_time_t *p_ts = NULL;
+#endif
+    uint32_t frame_len = ETH_MAX_PACKET_SIZE;
+    uint8_t *buffer = emac_esp_dma_get_recv_buf(emac->emac_dma_hndl, &frame_len, p_ts);
+    if (buffer == NULL) {
+        return frame_len == 0;
+    }
+    ESP_LOGD(TAG, "receive len= %" PRIu32, frame_len);
+    emac->eth->stack_input_info(emac->eth, buffer, frame_len, (void *)p_ts);
+    return true;
+}
+
+static esp_err_t emac_esp32_free_rx_buffer(esp_eth_mac_t *mac, uint8_t *buf)
+{
+    emac_esp32_t *emac = __containerof(mac, emac_esp32_t, parent);
+    if (!emac_esp_dma_free_recv_buf(emac->emac_dma_hndl, buf)) {
+        free(buf);
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_ETH_DMA_RX_ZERO_COPY
+
+#if CONFIG_ETH_RX_POLLING
+/* ends the poll of received frames: updates the statistics, adapts the Rx interrupt coalescing and unmasks the Rx interrupt */
+FORCE_INLINE_ATTR void emac_esp32_end_rx_poll(emac_esp32_t *emac, uint32_t frames, uint32_t poll_time_us)
+{
+    eth_mac_esp_rx_poll_stats_t *stats = &emac->rx_poll_stats;
+    portENTER_CRITICAL(&emac->rx_poll_stats_lock);
+    stats->polls++;
+    stats->frames += frames;
+    stats->poll_time_us += poll_time_us;
+    if (frames > stats->max_frames_per_poll) {
+        stats->max_frames_per_poll = frames;
+    }
+    if (poll_time_us > stats->max_poll_time_us) {
+        stats->max_poll_time_us = poll_time_us;
+    }
+    portEXIT_CRITICAL(&emac->rx_poll_stats_lock);
+    /* delay the Rx interrupt only while the frames come in bursts, a single frame is processed with the lowest latency */
+    if (emac->rx_coalesce_us) {
+        emac_esp_dma_set_rx_intr_delay(emac->emac_dma_hndl, frames > 1);
+    }
+    /* a frame received after the last check has set the Rx interrupt status, so the interrupt is raised right away */
+    emac_hal_enable_corresponding_intr(&emac->hal, EMAC_LL_INTR_RECEIVE_ENABLE);
+}
+#endif // CONFIG_ETH_RX_POLLING
+
 static void emac_esp32_rx_task(void *arg)
 {
     emac_esp32_t *emac = (emac_esp32_t *)arg;
-    uint8_t *buffer = NULL;
     while (1) {
         // block indefinitely until got notification from underlay event
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        do {
-            /* set max expected frame len */
-            uint32_t frame_len = ETH_MAX_PACKET_SIZE;
-            buffer = emac_esp_dma_alloc_recv_buf(emac->emac_dma_hndl, &frame_len);
-            /* we have memory to receive the frame of maximal size previously defined */
-            if (buffer != NULL) {
-#ifdef SOC_EMAC_IEEE1588V2_SUPPORTED
-                eth_mac_time_t ts;
-                eth_mac_time_t *p_ts = &ts;
-#else
-                eth_mac_time_t *p_ts = NULL;
+#if CONFIG_ETH_RX_POLLING
+        uint32_t poll_frames = 0;
+        int64_t poll_start = esp_timer_get_time();
 #endif
-                uint32_t recv_len = emac_esp_dma_receive_frame(emac->emac_dma_hndl, buffer, EMAC_DMA_BUF_SIZE_AUTO, p_ts);
-                if (recv_len == 0) {
-                    ESP_LOGE(TAG, "frame copy error");
-                    free(buffer);
-                    /* ensures that interface to EMAC does not get stuck with unprocessed frames */
-                    emac_esp_dma_flush_recv_frame(emac->emac_dma_hndl);
-                } else if (frame_len > recv_len) {
-                    ESP_LOGE(TAG, "received frame was truncated");
-                    free(buffer);
-                } else {
-                    ESP_LOGD(TAG, "receive len= %" PRIu32, recv_len);
-                    emac->eth->stack_input_info(emac->eth, buffer, recv_len, (void *)p_ts);
-                }
-            /* if allocation failed and there is a waiting frame */
-            } else if (frame_len) {
-                ESP_LOGE(TAG, "no mem for receive buffer");
-                /* ensures that interface to EMAC does not get stuck with unprocessed frames */
-                emac_esp_dma_flush_recv_frame(emac->emac_dma_hndl);
+        do {
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+            if (!emac_esp32_receive_frame_zero_copy(emac)) {
+                emac_esp32_receive_frame_copy(emac);
             }
+#else
+            emac_esp32_receive_frame_copy(emac);
+#endif // CONFIG_ETH_DMA_RX_ZERO_COPY
             emac_esp_dma_get_remain_frames(emac->emac_dma_hndl, &emac->frames_remain, &emac->free_rx_descriptor);
 #if CONFIG_ETH_SOFT_FLOW_CONTROL
             // we need to do extra checking of remained frames in case there are no unhandled frames left, but pause frame is still undergoing
@@ -444,8 +576,14 @@ static void emac_esp32_rx_task(void *arg)
             } else if ((emac->free_rx_descriptor > emac->flow_control_high_water_mark) || !emac->frames_remain) {
                 emac_hal_send_pause_frame(&emac->hal, false);
             }
+#endif
+#if CONFIG_ETH_RX_POLLING
+            poll_frames++;
 #endif
         } while (emac->frames_remain);
+#if CONFIG_ETH_RX_POLLING
+        emac_esp32_end_rx_poll(emac, poll_frames, (uint32_t)(esp_timer_get_time() - poll_start));
+#endif
     }
 }
 
@@ -511,6 +649,13 @@ static esp_err_t emac_esp32_init(esp_eth_mac_t *mac)
     /* init dma registers with selected EMAC-DMA configuration */
     emac_hal_dma_config_t dma_config = { .dma_burst_len = emac->dma_burst_len };
     emac_hal_init_dma_default(&emac->hal, &dma_config);
+#if CONFIG_ETH_TX_CHECKSUM_OFFLOAD
+    /* checksums can only be inserted when the whole frame is in TX FIFO */
+    emac_ll_trans_store_forward_enable(emac->hal.dma_regs, true);
+#endif
+#if CONFIG_ETH_RX_POLLING
+    ESP_GOTO_ON_ERROR(emac_esp32_set_rx_coalesce_time(emac, emac->rx_coalesce_us), err, TAG, "set Rx coalescing time failed");
+#endif
     /* get emac address from efuse */
     ESP_GOTO_ON_ERROR(esp_read_mac(emac->addr, ESP_MAC_ETH), err, TAG, "fetch ethernet mac address failed");
     /* set MAC address to emac register */
@@ -597,6 +742,10 @@ IRAM_ATTR void emac_isr_default_handler(void *args)
 #if EMAC_LL_CONFIG_ENABLE_INTR_MASK & EMAC_LL_INTR_RECEIVE_ENABLE
     if (intr_stat & EMAC_LL_DMA_RECEIVE_FINISH_INTR) {
         BaseType_t rx_high_task_woken = pdFALSE;
+#if CONFIG_ETH_RX_POLLING
+        /* mask the Rx interrupt until the receive task has processed all the received frames */
+        emac_hal_disable_corresponding_intr(hal, EMAC_LL_INTR_RECEIVE_ENABLE);
+#endif
         /* notify receive task */
         vTaskNotifyGiveFromISR(emac->rx_task_hdl, &rx_high_task_woken);
         high_task_woken |= (bool)rx_high_task_woken;
@@ -655,6 +804,10 @@ static esp_err_t emac_esp_alloc_driver_obj(const eth_mac_config_t *config, emac_
     ESP_GOTO_ON_FALSE(emac, ESP_ERR_NO_MEM, err, TAG, "no mem for esp emac object");
 
     ESP_GOTO_ON_ERROR(emac_esp_new_dma(NULL, &emac->emac_dma_hndl), err, TAG, "create EMAC DMA object failed");
+#if CONFIG_ETH_TX_CHECKSUM_OFFLOAD
+    /* insert IPv4 header and TCP/UDP/ICMP checksums, TCP/UDP pseudo-header checksum is calculated by the EMAC */
+    emac_esp_dma_set_tdes0_ctrl_bits(emac->emac_dma_hndl, EMAC_HAL_TDES0_IP_CRC_INSERT_HDR_PAYLOAD_PSEUDO);
+#endif
 
     /* alloc PM lock */
 #ifdef CONFIG_PM_ENABLE
@@ -795,6 +948,10 @@ esp_eth_mac_t *esp_eth_mac_new_esp32(const eth_esp32_emac_config_t *esp32_config
 
     emac->flow_control_high_water_mark = FLOW_CONTROL_HIGH_WATER_MARK;
     emac->flow_control_low_water_mark = FLOW_CONTROL_LOW_WATER_MARK;
+#if CONFIG_ETH_RX_POLLING
+    emac->rx_coalesce_us = CONFIG_ETH_RX_INTR_COALESCE_US;
+    portMUX_INITIALIZE(&emac->rx_poll_stats_lock);
+#endif
     emac->parent.set_mediator = emac_esp32_set_mediator;
     emac->parent.init = emac_esp32_init;
     emac->parent.deinit = emac_esp32_deinit;
@@ -815,6 +972,10 @@ esp_eth_mac_t *esp_eth_mac_new_esp32(const eth_esp32_emac_config_t *esp32_config
     emac->parent.transmit_ctrl_vargs = emac_esp32_transmit_ctrl_vargs;
     emac->parent.receive = emac_esp32_receive;
     emac->parent.custom_ioctl = emac_esp_custom_ioctl;
+    emac->parent.get_tx_checksum_offload = emac_esp32_get_tx_checksum_offload;
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+    emac->parent.free_rx_buffer = emac_esp32_free_rx_buffer;
+#endif
 #ifdef SOC_EMAC_IEEE1588V2_SUPPORTED
     emac->ts_target_exceed_cb_from_isr = NULL;
 #endif // SOC_EMAC_IEEE1588V2_SUPPORTED
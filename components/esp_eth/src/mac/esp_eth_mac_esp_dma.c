@@ -4,12 +4,15 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
 #include "esp_check.h"
+#include "esp_attr.h"
 #include "sdkconfig.h"
 #include "soc/soc_caps.h"
 #include "esp_cache.h"
 #include "hal/emac_hal.h"
 #include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
 #include "esp_private/eth_mac_esp_dma.h"
 
 #define ETH_CRC_LENGTH (4)
@@ -21,6 +24,10 @@
 
 #define PTP_TX_TIMESTAMP_TO 50 //  maximum loops observed on P4 was 31 @ETH frame 1500B
 
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+#define EMAC_RX_POOL_BUFFER_NUM (CONFIG_ETH_DMA_RX_BUFFER_NUM + CONFIG_ETH_DMA_RX_ZERO_COPY_BUFFER_NUM)
+#endif
+
 #if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
 #define DMA_CACHE_WB(addr, size) do {                                                           \
     esp_err_t msync_ret = esp_cache_msync((void *)addr, size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);    \
@@ -50,6 +57,15 @@ struct emac_esp_dma_t {
     eth_dma_tx_descriptor_t *tx_desc;
     uint8_t *rx_buf[CONFIG_ETH_DMA_RX_BUFFER_NUM];
     uint8_t *tx_buf[CONFIG_ETH_DMA_TX_BUFFER_NUM];
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+    uint8_t *rx_pool;   // memory of all Rx buffers, each one is either attached to a descriptor, spare or owned by the upper layer
+    uint8_t *rx_spare_buf[CONFIG_ETH_DMA_RX_ZERO_COPY_BUFFER_NUM];
+    uint32_t rx_spare_cnt;
+    portMUX_TYPE rx_spare_lock;
+#endif
+#if CONFIG_ETH_RX_POLLING
+    bool rx_intr_delay; // set DisableInterruptOnComplete in the Rx descriptors returned to DMA
+#endif
 };
 
 typedef struct {
@@ -59,6 +75,16 @@ typedef struct {
     uint32_t copy_len;
 } __attribute__((packed)) emac_esp_dma_auto_buf_info_t;
 
+/* return the Rx descriptor to DMA */
+FORCE_INLINE_ATTR void emac_esp_dma_give_rx_desc(emac_esp_dma_handle_t emac_esp_dma, eth_dma_rx_descriptor_t *desc)
+{
+#if CONFIG_ETH_RX_POLLING
+    desc->RDES1.DisableInterruptOnComplete = emac_esp_dma->rx_intr_delay;
+#endif
+    desc->RDES0.Own = EMAC_LL_DMADESC_OWNER_DMA;
+    DMA_CACHE_WB(desc, EMAC_HAL_DMA_DESC_SIZE);
+}
+
 void emac_esp_dma_reset(emac_esp_dma_handle_t emac_esp_dma)
 {
     /* reset DMA descriptors */
@@ -73,7 +99,11 @@ void emac_esp_dma_reset(emac_esp_dma_handle_t emac_esp_dma)
         emac_esp_dma->rx_desc[i].RDES1.SecondAddressChained = 1;
         emac_esp_dma->rx_desc[i].RDES1.ReceiveBuffer1Size = CONFIG_ETH_DMA_BUFFER_SIZE;
         /* Enable Ethernet DMA Rx Descriptor interrupt */
+#if CONFIG_ETH_RX_POLLING
+        emac_esp_dma->rx_desc[i].RDES1.DisableInterruptOnComplete = emac_esp_dma->rx_intr_delay;
+#else
         emac_esp_dma->rx_desc[i].RDES1.DisableInterruptOnComplete = 0;
+#endif
         /* point to the buffer */
         emac_esp_dma->rx_desc[i].Buffer1Addr = (uint32_t)(emac_esp_dma->rx_buf[i]);
         /* point to next descriptor */
@@ -118,6 +148,13 @@ void emac_esp_dma_clear_tdes0_ctrl_bits(emac_esp_dma_handle_t emac_esp_dma, uint
     emac_esp_dma->tx_desc_flags &= ~flag;
 }
 
+#if CONFIG_ETH_RX_POLLING
+void emac_esp_dma_set_rx_intr_delay(emac_esp_dma_handle_t emac_esp_dma, bool enable)
+{
+    emac_esp_dma->rx_intr_delay = enable;
+}
+#endif // CONFIG_ETH_RX_POLLING
+
 void emac_esp_dma_ts_enable(emac_esp_dma_handle_t emac_esp_dma, bool enable)
 {
     if (enable) {
@@ -425,16 +462,14 @@ uint32_t emac_esp_dma_receive_frame(emac_esp_dma_handle_t emac_esp_dma, uint8_t
             buf += CONFIG_ETH_DMA_BUFFER_SIZE;
             copy_len -= CONFIG_ETH_DMA_BUFFER_SIZE;
             /* Set Own bit in Rx descriptors: gives the buffers back to DMA */
-            desc_iter->RDES0.Own = EMAC_LL_DMADESC_OWNER_DMA;
-            DMA_CACHE_WB(desc_iter, EMAC_HAL_DMA_DESC_SIZE);
+            emac_esp_dma_give_rx_desc(emac_esp_dma, desc_iter);
             desc_iter = (eth_dma_rx_descriptor_t *)(desc_iter->Buffer2NextDescAddr);
         }
         DMA_CACHE_INVALIDATE(desc_iter->Buffer1Addr, CONFIG_ETH_DMA_BUFFER_SIZE);
         memcpy(buf, (void *)(desc_iter->Buffer1Addr), copy_len);
         /* `copy_len` does not include CRC (which may be stored in separate buffer), hence check if we reached the last descriptor */
         while (!desc_iter->RDES0.LastDescriptor) {
-            desc_iter->RDES0.Own = EMAC_LL_DMADESC_OWNER_DMA;
-            DMA_CACHE_WB(desc_iter, EMAC_HAL_DMA_DESC_SIZE);
+            emac_esp_dma_give_rx_desc(emac_esp_dma, desc_iter);
             desc_iter = (eth_dma_rx_descriptor_t *)(desc_iter->Buffer2NextDescAddr);
         }
 #if SOC_EMAC_IEEE1588V2_SUPPORTED
@@ -447,8 +482,7 @@ uint32_t emac_esp_dma_receive_frame(emac_esp_dma_handle_t emac_esp_dma, uint8_t
         }
 #endif
         /* return last descriptor to DMA */
-        desc_iter->RDES0.Own = EMAC_LL_DMADESC_OWNER_DMA;
-        DMA_CACHE_WB(desc_iter, EMAC_HAL_DMA_DESC_SIZE);
+        emac_esp_dma_give_rx_desc(emac_esp_dma, desc_iter);
 
         /* update rxdesc */
         emac_esp_dma->rx_desc = (eth_dma_rx_descriptor_t *)(desc_iter->Buffer2NextDescAddr);
@@ -458,6 +492,74 @@ uint32_t emac_esp_dma_receive_frame(emac_esp_dma_handle_t emac_esp_dma, uint8_t
     return ret_len;
 }
 
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+uint8_t *emac_esp_dma_get_recv_buf(emac_esp_dma_handle_t emac_esp_dma, uint32_t *size, eth_mac_time_t *ts)
+{
+    uint32_t ret_len = 0;
+    uint8_t *buf = NULL;
+    uint8_t *spare_buf = NULL;
+
+    if (emac_esp_dma_get_valid_recv_len(emac_esp_dma, &ret_len) != ESP_OK) {
+        *size = 0;
+        return NULL;
+    }
+    eth_dma_rx_descriptor_t *desc = emac_esp_dma->rx_desc;
+    /* only frames held by a single descriptor can be passed without copying */
+    if (ret_len == 0 || ret_len > *size || !desc->RDES0.FirstDescriptor || !desc->RDES0.LastDescriptor) {
+        *size = ret_len;
+        return NULL;
+    }
+    *size = ret_len;
+
+    portENTER_CRITICAL(&emac_esp_dma->rx_spare_lock);
+    if (emac_esp_dma->rx_spare_cnt > 0) {
+        spare_buf = emac_esp_dma->rx_spare_buf[--emac_esp_dma->rx_spare_cnt];
+    }
+    portEXIT_CRITICAL(&emac_esp_dma->rx_spare_lock);
+    /* all spare buffers are held by the upper layer */
+    if (spare_buf == NULL) {
+        return NULL;
+    }
+
+    buf = (uint8_t *)(desc->Buffer1Addr);
+    DMA_CACHE_INVALIDATE(buf, CONFIG_ETH_DMA_BUFFER_SIZE);
+#if SOC_EMAC_IEEE1588V2_SUPPORTED
+    if (ts != NULL) {
+        if (emac_hal_get_rxdesc_timestamp(&emac_esp_dma->hal, desc, &ts->seconds, &ts->nanoseconds) != ESP_OK) {
+            /* zeros indicate invalid time stamp since it is not possible to ever get "zero time" under normal conditions */
+            ts->seconds = 0;
+            ts->nanoseconds = 0;
+        }
+    }
+#endif
+    /* the upper layer may have modified the spare buffer, write it back so that no dirty cache line overwrites the next frame */
+    DMA_CACHE_WB(spare_buf, CONFIG_ETH_DMA_BUFFER_SIZE);
+    /* attach the spare buffer to the descriptor and return it to DMA */
+    desc->Buffer1Addr = (uint32_t)spare_buf;
+    emac_esp_dma->rx_buf[desc - (eth_dma_rx_descriptor_t *)(emac_esp_dma->descriptors)] = spare_buf;
+    emac_esp_dma_give_rx_desc(emac_esp_dma, desc);
+
+    /* update rxdesc */
+    emac_esp_dma->rx_desc = (eth_dma_rx_descriptor_t *)(desc->Buffer2NextDescAddr);
+    /* poll rx demand */
+    emac_hal_receive_poll_demand(&emac_esp_dma->hal);
+    return buf;
+}
+
+bool emac_esp_dma_free_recv_buf(emac_esp_dma_handle_t emac_esp_dma, uint8_t *buf)
+{
+    uintptr_t pool_start = (uintptr_t)emac_esp_dma->rx_pool;
+    if ((uintptr_t)buf < pool_start || (uintptr_t)buf >= pool_start + EMAC_RX_POOL_BUFFER_NUM * CONFIG_ETH_DMA_BUFFER_SIZE) {
+        return false;
+    }
+    portENTER_CRITICAL(&emac_esp_dma->rx_spare_lock);
+    assert(emac_esp_dma->rx_spare_cnt < CONFIG_ETH_DMA_RX_ZERO_COPY_BUFFER_NUM);
+    emac_esp_dma->rx_spare_buf[emac_esp_dma->rx_spare_cnt++] = buf;
+    portEXIT_CRITICAL(&emac_esp_dma->rx_spare_lock);
+    return true;
+}
+#endif // CONFIG_ETH_DMA_RX_ZERO_COPY
+
 void emac_esp_dma_flush_recv_frame(emac_esp_dma_handle_t emac_esp_dma)
 {
     eth_dma_rx_descriptor_t *desc_iter = emac_esp_dma->rx_desc;
@@ -465,13 +567,11 @@ void emac_esp_dma_flush_recv_frame(emac_esp_dma_handle_t emac_esp_dma)
     DMA_CACHE_INVALIDATE(desc_iter, EMAC_HAL_DMA_DESC_SIZE);
     /* While not last descriptor => return back to DMA */
     while (!desc_iter->RDES0.LastDescriptor) {
-        desc_iter->RDES0.Own = EMAC_LL_DMADESC_OWNER_DMA;
-        DMA_CACHE_WB(desc_iter, EMAC_HAL_DMA_DESC_SIZE);
+        emac_esp_dma_give_rx_desc(emac_esp_dma, desc_iter);
         desc_iter = (eth_dma_rx_descriptor_t *)(desc_iter->Buffer2NextDescAddr);
     }
     /* the last descriptor */
-    desc_iter->RDES0.Own = EMAC_LL_DMADESC_OWNER_DMA;
-    DMA_CACHE_WB(desc_iter, EMAC_HAL_DMA_DESC_SIZE);
+    emac_esp_dma_give_rx_desc(emac_esp_dma, desc_iter);
     /* update rxdesc */
     emac_esp_dma->rx_desc = (eth_dma_rx_descriptor_t *)(desc_iter->Buffer2NextDescAddr);
     /* poll rx demand */
@@ -484,9 +584,19 @@ esp_err_t emac_esp_del_dma(emac_esp_dma_handle_t emac_esp_dma)
         for (int i = 0; i < CONFIG_ETH_DMA_TX_BUFFER_NUM; i++) {
             free(emac_esp_dma->tx_buf[i]);
         }
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+        if (emac_esp_dma->rx_pool && emac_esp_dma->rx_spare_cnt < CONFIG_ETH_DMA_RX_ZERO_COPY_BUFFER_NUM) {
+            /* the buffers still held by the upper layer would be written into freed memory when released */
+            ESP_LOGW(TAG, "%" PRIu32 " Rx buffers not released, leaking Rx buffer pool",
+                     CONFIG_ETH_DMA_RX_ZERO_COPY_BUFFER_NUM - emac_esp_dma->rx_spare_cnt);
+        } else {
+            free(emac_esp_dma->rx_pool);
+        }
+#else
         for (int i = 0; i < CONFIG_ETH_DMA_RX_BUFFER_NUM; i++) {
             free(emac_esp_dma->rx_buf[i]);
         }
+#endif // CONFIG_ETH_DMA_RX_ZERO_COPY
         free(emac_esp_dma->descriptors);
         free(emac_esp_dma);
     }
@@ -506,10 +616,24 @@ esp_err_t emac_esp_new_dma(const emac_esp_dma_config_t *config, emac_esp_dma_han
     emac_esp_dma->descriptors = heap_caps_aligned_calloc(4, 1, desc_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
     ESP_GOTO_ON_FALSE(emac_esp_dma->descriptors, ESP_ERR_NO_MEM, err, TAG, "no mem for descriptors");
     /* alloc memory for ethernet dma buffer */
+#if CONFIG_ETH_DMA_RX_ZERO_COPY
+    /* Rx buffers are allocated as one pool, so that the buffers passed to the upper layer can be recognized when released */
+    emac_esp_dma->rx_pool = heap_caps_aligned_calloc(4, EMAC_RX_POOL_BUFFER_NUM, CONFIG_ETH_DMA_BUFFER_SIZE, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_GOTO_ON_FALSE(emac_esp_dma->rx_pool, ESP_ERR_NO_MEM, err, TAG, "no mem for RX DMA buffers");
+    for (int i = 0; i < CONFIG_ETH_DMA_RX_BUFFER_NUM; i++) {
+        emac_esp_dma->rx_buf[i] = emac_esp_dma->rx_pool + i * CONFIG_ETH_DMA_BUFFER_SIZE;
+    }
+    for (int i = 0; i < CONFIG_ETH_DMA_RX_ZERO_COPY_BUFFER_NUM; i++) {
+        emac_esp_dma->rx_spare_buf[i] = emac_esp_dma->rx_pool + (CONFIG_ETH_DMA_RX_BUFFER_NUM + i) * CONFIG_ETH_DMA_BUFFER_SIZE;
+    }
+    emac_esp_dma->rx_spare_cnt = CONFIG_ETH_DMA_RX_ZERO_COPY_BUFFER_NUM;
+    portMUX_INITIALIZE(&emac_esp_dma->rx_spare_lock);
+#else
     for (int i = 0; i < CONFIG_ETH_DMA_RX_BUFFER_NUM; i++) {
         emac_esp_dma->rx_buf[i] = heap_caps_aligned_calloc(4, 1, CONFIG_ETH_DMA_BUFFER_SIZE, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
         ESP_GOTO_ON_FALSE(emac_esp_dma->rx_buf[i], ESP_ERR_NO_MEM, err, TAG, "no mem for RX DMA buffers");
     }
+#endif // CONFIG_ETH_DMA_RX_ZERO_COPY
     for (int i = 0; i < CONFIG_ETH_DMA_TX_BUFFER_NUM; i++) {
         emac_esp_dma->tx_buf[i] = heap_caps_aligned_calloc(4, 1, CONFIG_ETH_DMA_BUFFER_SIZE, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
         ESP_GOTO_ON_FALSE(emac_esp_dma->tx_buf[i], ESP_ERR_NO_MEM, err, TAG, "no mem for TX DMA buffers");
@@ -32,6 +32,7 @@
 static const char *TAG = "dm9051.mac";
 
 #define DM9051_SPI_LOCK_TIMEOUT_MS      (50)
+#define DM9051_SPI_POLLING_MAX_LEN      (128) // longer transactions are interrupt driven
 #define DM9051_PHY_OPERATION_TIMEOUT_US (1000)
 #define DM9051_MULTI_REG_AXS_TIMEOUT_MS (50)
 #define DM9051_RX_MEM_START_ADDR        (3072)
@@ -134,6 +135,16 @@ static inline bool dm9051_spi_unlock(eth_spi_info_t *spi)
     return xSemaphoreGive(spi->lock) == pdTRUE;
 }
 
+static inline esp_err_t dm9051_spi_transmit(eth_spi_info_t *spi, spi_transaction_t *trans)
+{
+    /* long transactions (frames) are queued and interrupt driven, so the CPU is free for other tasks
+       (e.g. lwIP processing the previous frame) while the DMA transfers the data */
+    if (trans->length > 8 * DM9051_SPI_POLLING_MAX_LEN) {
+        return spi_device_transmit(spi->hdl, trans);
+    }
+    return spi_device_polling_transmit(spi->hdl, trans);
+}
+
 static esp_err_t dm9051_spi_write(void *spi_ctx, uint32_t cmd, uint32_t addr, const void *value, uint32_t len)
 {
     esp_err_t ret = ESP_OK;
@@ -146,7 +157,7 @@ static esp_err_t dm9051_spi_write(void *spi_ctx, uint32_t cmd, uint32_t addr, co
         .tx_buffer = value
     };
     if (dm9051_spi_lock(spi)) {
-        if (spi_device_polling_transmit(spi->hdl, &trans) != ESP_OK) {
+        if (dm9051_spi_transmit(spi, &trans) != ESP_OK) {
             ESP_LOGE(TAG, "%s(%d): spi transmit failed", __FUNCTION__, __LINE__);
             ret = ESP_FAIL;
         }
@@ -170,7 +181,7 @@ static esp_err_t dm9051_spi_read(void *spi_ctx, uint32_t cmd, uint32_t addr, voi
         .rx_buffer = value
     };
     if (dm9051_spi_lock(spi)) {
-        if (spi_device_polling_transmit(spi->hdl, &trans) != ESP_OK) {
+        if (dm9051_spi_transmit(spi, &trans) != ESP_OK) {
             ESP_LOGE(TAG, "%s(%d): spi transmit failed", __FUNCTION__, __LINE__);
             ret = ESP_FAIL;
         }
@@ -24,6 +24,7 @@
 
 
 #define KSZ8851_ETH_MAC_RX_BUF_SIZE_AUTO (0)
+#define KSZ8851_SPI_POLLING_MAX_LEN (128) // longer transactions are interrupt driven
 
 typedef struct {
     spi_device_handle_t hdl;
@@ -126,6 +127,16 @@ static esp_err_t ksz8851_spi_deinit(void *spi_ctx)
     return ret;
 }
 
+static inline esp_err_t ksz8851_spi_transmit(eth_spi_info_t *spi, spi_transaction_t *trans)
+{
+    /* long transactions (frames) are queued and interrupt driven, so the CPU is free for other tasks
+       (e.g. lwIP processing the previous frame) while the DMA transfers the data */
+    if (trans->length > 8 * KSZ8851_SPI_POLLING_MAX_LEN) {
+        return spi_device_transmit(spi->hdl, trans);
+    }
+    return spi_device_polling_transmit(spi->hdl, trans);
+}
+
 static esp_err_t ksz8851_spi_read(void *spi_ctx, uint32_t cmd, uint32_t addr, void *value, uint32_t len)
 {
     eth_spi_info_t *spi = (eth_spi_info_t *)spi_ctx;
@@ -145,7 +156,7 @@ static esp_err_t ksz8851_spi_read(void *spi_ctx, uint32_t cmd, uint32_t addr, vo
     }
 
     // No need for mutex here since SPI access is protected at higher layer of this driver
-    ESP_RETURN_ON_ERROR(spi_device_polling_transmit(spi->hdl, &trans.base), TAG, "spi transmit failed");
+    ESP_RETURN_ON_ERROR(ksz8851_spi_transmit(spi, &trans.base), TAG, "spi transmit failed");
 
     if ((trans.base.flags & SPI_TRANS_USE_RXDATA) && len <= 4) {
         memcpy(value, trans.base.rx_data, len);  // copy register values to output
@@ -172,7 +183,7 @@ static esp_err_t ksz8851_spi_write(void *spi_ctx, uint32_t cmd, uint32_t addr, c
     }
 
     // No need for mutex here since SPI access is protected at higher layer of this driver
-    ESP_RETURN_ON_ERROR(spi_device_polling_transmit(spi->hdl, &trans.base), TAG, "spi transmit failed");
+    ESP_RETURN_ON_ERROR(ksz8851_spi_transmit(spi, &trans.base), TAG, "spi transmit failed");
 
     return ESP_OK;
 }
@@ -29,9 +29,11 @@
 static const char *TAG = "w5500.mac";
 
 #define W5500_SPI_LOCK_TIMEOUT_MS (50)
+#define W5500_SPI_POLLING_MAX_LEN (128) // longer transactions are interrupt driven
 #define W5500_TX_MEM_SIZE (0x4000)
 #define W5500_RX_MEM_SIZE (0x4000)
 #define W5500_ETH_MAC_RX_BUF_SIZE_AUTO (0)
+#define W5500_RX_HDR_LEN (2)
 
 typedef struct {
     uint32_t offset;
@@ -65,6 +67,10 @@ typedef struct {
     uint8_t addr[6];
     bool packets_remain;
     uint8_t *rx_buffer;
+    bool rx_hdr_prefetched; // header of the next frame was read together with the payload of the previous one
+    uint16_t rx_next_offset;
+    uint16_t rx_next_len;
+    uint16_t rx_next_remain;
 } emac_w5500_t;
 
 static void *w5500_spi_init(const void *spi_config)
@@ -125,6 +131,16 @@ static inline bool w5500_spi_unlock(eth_spi_info_t *spi)
     return xSemaphoreGive(spi->lock) == pdTRUE;
 }
 
+static inline esp_err_t w5500_spi_transmit(eth_spi_info_t *spi, spi_transaction_t *trans)
+{
+    /* long transactions (frames) are queued and interrupt driven, so the CPU is free for other tasks
+       (e.g. lwIP processing the previous frame) while the DMA transfers the data */
+    if (trans->length > 8 * W5500_SPI_POLLING_MAX_LEN) {
+        return spi_device_transmit(spi->hdl, trans);
+    }
+    return spi_device_polling_transmit(spi->hdl, trans);
+}
+
 static esp_err_t w5500_spi_write(void *spi_ctx, uint32_t cmd, uint32_t addr, const void *value, uint32_t len)
 {
     esp_err_t ret = ESP_OK;
@@ -137,7 +153,7 @@ static esp_err_t w5500_spi_write(void *spi_ctx, uint32_t cmd, uint32_t addr, con
         .tx_buffer = value
     };
     if (w5500_spi_lock(spi)) {
-        if (spi_device_polling_transmit(spi->hdl, &trans) != ESP_OK) {
+        if (w5500_spi_transmit(spi, &trans) != ESP_OK) {
             ESP_LOGE(TAG, "%s(%d): spi transmit failed", __FUNCTION__, __LINE__);
             ret = ESP_FAIL;
         }
@@ -161,7 +177,7 @@ static esp_err_t w5500_spi_read(void *spi_ctx, uint32_t cmd, uint32_t addr, void
         .rx_buffer = value
     };
     if (w5500_spi_lock(spi)) {
-        if (spi_device_polling_transmit(spi->hdl, &trans) != ESP_OK) {
+        if (w5500_spi_transmit(spi, &trans) != ESP_OK) {
             ESP_LOGE(TAG, "%s(%d): spi transmit failed", __FUNCTION__, __LINE__);
             ret = ESP_FAIL;
         }
@@ -281,6 +297,30 @@ err:
     return ret;
 }
 
+/* get the position and length of the frame at the RX read pointer, remain_bytes is zero when no frame is waiting */
+static esp_err_t w5500_get_rx_frame_info(emac_w5500_t *emac, uint16_t *offset, uint16_t *rx_len, uint16_t *remain_bytes)
+{
+    esp_err_t ret = ESP_OK;
+    if (emac->rx_hdr_prefetched) {
+        emac->rx_hdr_prefetched = false;
+        *offset = emac->rx_next_offset;
+        *rx_len = emac->rx_next_len;
+        *remain_bytes = emac->rx_next_remain;
+        return ESP_OK;
+    }
+    ESP_GOTO_ON_ERROR(w5500_get_rx_received_size(emac, remain_bytes), err, TAG, "get RX received size failed");
+    if (*remain_bytes) {
+        // get current read pointer
+        ESP_GOTO_ON_ERROR(w5500_read(emac, W5500_REG_SOCK_RX_RD(0), offset, sizeof(*offset)), err, TAG, "read RX RD failed");
+        *offset = __builtin_bswap16(*offset);
+        // read head
+        ESP_GOTO_ON_ERROR(w5500_read_buffer(emac, rx_len, sizeof(*rx_len), *offset), err, TAG, "read frame header failed");
+        *rx_len = __builtin_bswap16(*rx_len) - W5500_RX_HDR_LEN; // data size includes 2 bytes of header
+    }
+err:
+    return ret;
+}
+
 static esp_err_t w5500_set_mac_addr(emac_w5500_t *emac)
 {
     esp_err_t ret = ESP_OK;
@@ -373,6 +413,7 @@ static esp_err_t emac_w5500_start(esp_eth_mac_t *mac)
     esp_err_t ret = ESP_OK;
     emac_w5500_t *emac = __containerof(mac, emac_w5500_t, parent);
     uint8_t reg_value = 0;
+    emac->rx_hdr_prefetched = false;
     /* open SOCK0 */
     ESP_GOTO_ON_ERROR(w5500_send_command(emac, W5500_SCR_OPEN, 100), err, TAG, "issue OPEN command failed");
     /* enable interrupt for SOCK0 */
@@ -615,14 +656,8 @@ static esp_err_t emac_w5500_alloc_recv_buf(emac_w5500_t *emac, uint8_t **buf, ui
     uint16_t remain_bytes = 0;
     *buf = NULL;
 
-    w5500_get_rx_received_size(emac, &remain_bytes);
+    ESP_GOTO_ON_ERROR(w5500_get_rx_frame_info(emac, &offset, &rx_len, &remain_bytes), err, TAG, "get RX frame info failed");
     if (remain_bytes) {
-        // get current read pointer
-        ESP_GOTO_ON_ERROR(w5500_read(emac, W5500_REG_SOCK_RX_RD(0), &offset, sizeof(offset)), err, TAG, "read RX RD failed");
-        offset = __builtin_bswap16(offset);
-        // read head
-        ESP_GOTO_ON_ERROR(w5500_read_buffer(emac, &rx_len, sizeof(rx_len), offset), err, TAG, "read frame header failed");
-        rx_len = __builtin_bswap16(rx_len) - 2; // data size includes 2 bytes of header
         // frames larger than expected will be truncated
         copy_len = rx_len > *length ? *length : rx_len;
         // runt frames are not forwarded by W5500 (tested on target), but check the length anyway since it could be corrupted at SPI bus
@@ -652,17 +687,14 @@ static esp_err_t emac_w5500_receive(esp_eth_mac_t *mac, uint8_t *buf, uint32_t *
     uint16_t rx_len = 0;
     uint16_t copy_len = 0;
     uint16_t remain_bytes = 0;
+    uint16_t read_len = 0;
+    uint16_t next_len = 0;
+    uint16_t rd_ptr = 0;
     emac->packets_remain = false;
 
     if (*length != W5500_ETH_MAC_RX_BUF_SIZE_AUTO) {
-        w5500_get_rx_received_size(emac, &remain_bytes);
+        ESP_GOTO_ON_ERROR(w5500_get_rx_frame_info(emac, &offset, &rx_len, &remain_bytes), err, TAG, "get RX frame info failed");
         if (remain_bytes) {
-            // get current read pointer
-            ESP_GOTO_ON_ERROR(w5500_read(emac, W5500_REG_SOCK_RX_RD(0), &offset, sizeof(offset)), err, TAG, "read RX RD failed");
-            offset = __builtin_bswap16(offset);
-            // read head first
-            ESP_GOTO_ON_ERROR(w5500_read_buffer(emac, &rx_len, sizeof(rx_len), offset), err, TAG, "read frame header failed");
-            rx_len = __builtin_bswap16(rx_len) - 2; // data size includes 2 bytes of header
             // frames larger than expected will be truncated
             copy_len = rx_len > *length ? *length : rx_len;
         } else {
@@ -677,18 +709,34 @@ static esp_err_t emac_w5500_receive(esp_eth_mac_t *mac, uint8_t *buf, uint32_t *
         remain_bytes = buff_info->remain;
     }
     // 2 bytes of header
-    offset += 2;
+    offset += W5500_RX_HDR_LEN;
+    // check if there're more data need to process
+    remain_bytes -= rx_len + W5500_RX_HDR_LEN;
+    read_len = copy_len;
+    if (copy_len == rx_len && remain_bytes >= W5500_RX_HDR_LEN) {
+        // header of the next frame follows the payload, read it in the same SPI transaction
+        read_len += W5500_RX_HDR_LEN;
+    }
     // read the payload
-    ESP_GOTO_ON_ERROR(w5500_read_buffer(emac, emac->rx_buffer, copy_len, offset), err, TAG, "read payload failed, len=%" PRIu16 ", offset=%" PRIu16, rx_len, offset);
+    ESP_GOTO_ON_ERROR(w5500_read_buffer(emac, emac->rx_buffer, read_len, offset), err, TAG, "read payload failed, len=%" PRIu16 ", offset=%" PRIu16, rx_len, offset);
     memcpy(buf, emac->rx_buffer, copy_len);
     offset += rx_len;
+    if (read_len > copy_len) {
+        memcpy(&next_len, emac->rx_buffer + copy_len, sizeof(next_len));
+        next_len = __builtin_bswap16(next_len) - W5500_RX_HDR_LEN; // data size includes 2 bytes of header
+    }
     // update read pointer
-    offset = __builtin_bswap16(offset);
-    ESP_GOTO_ON_ERROR(w5500_write(emac, W5500_REG_SOCK_RX_RD(0), &offset, sizeof(offset)), err, TAG, "write RX RD failed");
+    rd_ptr = __builtin_bswap16(offset);
+    ESP_GOTO_ON_ERROR(w5500_write(emac, W5500_REG_SOCK_RX_RD(0), &rd_ptr, sizeof(rd_ptr)), err, TAG, "write RX RD failed");
     /* issue RECV command */
     ESP_GOTO_ON_ERROR(w5500_send_command(emac, W5500_SCR_RECV, 100), err, TAG, "issue RECV command failed");
-    // check if there're more data need to process
-    remain_bytes -= rx_len + 2;
+    if (read_len > copy_len) {
+        // next frame can be read without polling RSR, RD and the header again
+        emac->rx_next_offset = offset;
+        emac->rx_next_len = next_len;
+        emac->rx_next_remain = remain_bytes;
+        emac->rx_hdr_prefetched = true;
+    }
     emac->packets_remain = remain_bytes > 0;
 
     *length = copy_len;
@@ -705,6 +753,7 @@ static esp_err_t emac_w5500_flush_recv_frame(emac_w5500_t *emac)
     uint16_t rx_len = 0;
     uint16_t remain_bytes = 0;
     emac->packets_remain = false;
+    emac->rx_hdr_prefetched = false;
 
     w5500_get_rx_received_size(emac, &remain_bytes);
     if (remain_bytes) {
@@ -925,7 +974,8 @@ esp_eth_mac_t *esp_eth_mac_new_w5500(const eth_w5500_config_t *w5500_config, con
                            mac_config->rx_task_prio, &emac->rx_task_hdl, core_num);
     ESP_GOTO_ON_FALSE(xReturned == pdPASS, NULL, err, TAG, "create w5500 task failed");
 
-    emac->rx_buffer = heap_caps_malloc(ETH_MAX_PACKET_SIZE, MALLOC_CAP_DMA);
+    /* room for the header of the next frame, which is read together with the payload */
+    emac->rx_buffer = heap_caps_malloc(ETH_MAX_PACKET_SIZE + W5500_RX_HDR_LEN, MALLOC_CAP_DMA);
     ESP_GOTO_ON_FALSE(emac->rx_buffer, NULL, err, TAG, "RX buffer allocation failed");
 
     if (emac->int_gpio_num < 0) {
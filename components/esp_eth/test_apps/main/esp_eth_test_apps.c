@@ -88,6 +88,15 @@ TEST_CASE("ethernet io test", "[ethernet]")
     ESP_LOGI(TAG, "Ethernet PHY Address: %d", phy_addr);
     TEST_ASSERT(phy_addr >= 0 && phy_addr <= 31);
 #endif
+
+    /* get TX checksum offload status, only the internal EMAC inserts checksums */
+    bool tx_checksum_offload = true;
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_CMD_G_TX_CHECKSUM_OFFLOAD, &tx_checksum_offload));
+#if CONFIG_TARGET_USE_INTERNAL_ETHERNET && CONFIG_ETH_TX_CHECKSUM_OFFLOAD
+    TEST_ASSERT_TRUE(tx_checksum_offload);
+#else
+    TEST_ASSERT_FALSE(tx_checksum_offload);
+#endif
     TEST_ESP_OK(esp_eth_driver_uninstall(eth_handle));
     TEST_ESP_OK(phy->del(phy));
     TEST_ESP_OK(mac->del(mac));
@@ -305,7 +314,7 @@ static esp_err_t loopback_test_case_incoming_handler(esp_eth_handle_t eth_handle
 {
     TEST_ASSERT(memcmp(priv, buffer, LOOPBACK_TEST_PACKET_SIZE) == 0);
     xSemaphoreGive(loopback_test_case_data_received);
-    free(buffer);
+    esp_eth_free_rx_buffer(eth_handle, buffer);
     return ESP_OK;
 }
 
@@ -419,6 +428,33 @@ TEST_CASE("ethernet io loopback", "[ethernet]")
     TEST_ESP_OK(esp_eth_transmit(eth_handle, test_packet, LOOPBACK_TEST_PACKET_SIZE));
     TEST_ASSERT(xSemaphoreTake(loopback_test_case_data_received, pdMS_TO_TICKS(ETH_CONNECT_TIMEOUT_MS)) == pdTRUE);
 
+#if CONFIG_TARGET_USE_INTERNAL_ETHERNET && CONFIG_ETH_RX_POLLING
+    // all the looped back frames have been processed in Rx polls
+    eth_mac_esp_rx_poll_stats_t poll_stats;
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_G_RX_POLL_STATS, &poll_stats));
+    ESP_LOGI(TAG, "Rx polls: %" PRIu32 ", frames: %" PRIu32 ", max frames per poll: %" PRIu32 ", max poll time: %" PRIu32 " us",
+             poll_stats.polls, poll_stats.frames, poll_stats.max_frames_per_poll, poll_stats.max_poll_time_us);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, poll_stats.polls);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(poll_stats.polls, poll_stats.frames);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(poll_stats.max_poll_time_us, (uint32_t)poll_stats.poll_time_us);
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_CLEAR_RX_POLL_STATS, NULL));
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_G_RX_POLL_STATS, &poll_stats));
+    TEST_ASSERT_EQUAL_UINT32(0, poll_stats.polls);
+
+    // the frames are still received with the Rx interrupt coalescing
+    uint32_t coalesce_time_us = 100000;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_S_RX_COALESCE_TIME, &coalesce_time_us));
+    coalesce_time_us = 200;
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_S_RX_COALESCE_TIME, &coalesce_time_us));
+    coalesce_time_us = 0;
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_G_RX_COALESCE_TIME, &coalesce_time_us));
+    TEST_ASSERT_EQUAL_UINT32(200, coalesce_time_us);
+    for (int i = 0; i < 3; i++) {
+        TEST_ESP_OK(esp_eth_transmit(eth_handle, test_packet, LOOPBACK_TEST_PACKET_SIZE));
+        TEST_ASSERT(xSemaphoreTake(loopback_test_case_data_received, pdMS_TO_TICKS(ETH_CONNECT_TIMEOUT_MS)) == pdTRUE);
+    }
+#endif
+
     free(test_packet);
     loopback_en = false;
     TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_CMD_S_PHY_LOOPBACK, &loopback_en));
@@ -72,7 +72,7 @@ static esp_err_t eth_recv_esp_emac_check_cb(esp_eth_handle_t hdl, uint8_t *buffe
         TEST_FAIL();
     }
     memset(buffer, 0, length);
-    free(buffer);
+    esp_eth_free_rx_buffer(hdl, buffer);
     xSemaphoreGive(recv_info->mutex);
     return ESP_OK;
 }
@@ -490,7 +490,7 @@ TEST_CASE("internal emac erroneous frames", "[esp_emac]")
     for (i = 0; i < s_recv_frames_cnt; i++) {
         emac_frame_t *recv_frame = (emac_frame_t *)s_recv_frames[i];
         ESP_LOGI(TAG, "recv frame id %" PRIu8, recv_frame->data[0]);
-        free(recv_frame);
+        esp_eth_free_rx_buffer(eth_handle, recv_frame);
     }
     TEST_ASSERT_EQUAL_UINT8(TEST_FRAMES_NUM, s_recv_frames_cnt);
     s_recv_frames_cnt = 0;
@@ -516,7 +516,7 @@ TEST_CASE("internal emac erroneous frames", "[esp_emac]")
     for (i = 0; i < s_recv_frames_cnt; i++) {
         emac_frame_t *recv_frame = (emac_frame_t *)s_recv_frames[i];
         ESP_LOGI(TAG, "recv frame id %" PRIu8, recv_frame->data[0]);
-        free(recv_frame);
+        esp_eth_free_rx_buffer(eth_handle, recv_frame);
     }
     TEST_ASSERT_EQUAL_UINT8(TEST_FRAMES_NUM / 2, s_recv_frames_cnt);
     s_recv_frames_cnt = 0;
@@ -544,7 +544,7 @@ TEST_CASE("internal emac erroneous frames", "[esp_emac]")
     for (i = 0; i < s_recv_frames_cnt; i++) {
         emac_frame_t *recv_frame = (emac_frame_t *)s_recv_frames[i];
         ESP_LOGI(TAG, "recv frame id %" PRIu8, recv_frame->data[0]);
-        free(recv_frame);
+        esp_eth_free_rx_buffer(eth_handle, recv_frame);
     }
     TEST_ASSERT_EQUAL_INT(CONFIG_ETH_DMA_RX_BUFFER_NUM - 1, s_recv_frames_cnt); // one frame is missing due to "Descriptor Error"
     s_recv_frames_cnt = 0;
@@ -60,7 +60,7 @@ static esp_err_t l2_packet_txrx_test_cb(esp_eth_handle_t hdl, uint8_t *buffer, u
                 for (int i = 0; i < (length - ETH_HEADER_LEN); ++i) {
                     if (pkt->data[i] != (i & 0xff)) {
                         printf("payload mismatch\n");
-                        free(buffer);
+                        esp_eth_free_rx_buffer(hdl, buffer);
                         return ESP_OK;
                     }
                 }
@@ -84,7 +84,7 @@ static esp_err_t l2_packet_txrx_test_cb(esp_eth_handle_t hdl, uint8_t *buffer, u
             xEventGroupSetBits(eth_event_group, ETH_POKE_RESP_RECV_BIT);
         }
     }
-    free(buffer);
+    esp_eth_free_rx_buffer(hdl, buffer);
     return ESP_OK;
 }
 
@@ -249,7 +249,18 @@ def ethernet_heap_alloc_test(dut: IdfDut) -> None:
 
 # ----------- IP101 -----------
 @pytest.mark.ethernet
-@pytest.mark.parametrize('config', ['default_ip101', 'release_ip101', 'single_core_ip101'], indirect=True)
+@pytest.mark.parametrize(
+    'config',
+    [
+        'default_ip101',
+        'release_ip101',
+        'single_core_ip101',
+        'tx_checksum_offload_ip101',
+        'rx_zero_copy_ip101',
+        'rx_polling_ip101',
+    ],
+    indirect=True,
+)
 @pytest.mark.flaky(reruns=3, reruns_delay=5)
 @idf_parametrize('target', ['esp32'], indirect=['target'])
 def test_esp_ethernet(dut: IdfDut) -> None:
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -76,6 +76,15 @@ esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id,
                              event_data, event_data_size, ticks_to_wait);
 }
 
+esp_err_t esp_event_set_event_options(esp_event_base_t event_base, int32_t event_id, const esp_event_options_t *options)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_loop_set_event_options(s_default_loop, event_base, event_id, options);
+}
+
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
 esp_err_t esp_event_isr_post(esp_event_base_t event_base, int32_t event_id,
                              const void* event_data, size_t event_data_size, BaseType_t* task_unblocked)
@@ -100,7 +109,8 @@ esp_err_t esp_event_loop_create_default(void)
         .task_name = "sys_evt",
         .task_stack_size = ESP_TASKD_EVENT_STACK,
         .task_priority = ESP_TASKD_EVENT_PRIO,
-        .task_core_id = 0
+        .task_core_id = CONFIG_ESP_SYSTEM_EVENT_TASK_CORE_ID,
+        .num_priorities = CONFIG_ESP_EVENT_DEFAULT_LOOP_PRIORITIES,
     };
 
     esp_err_t err;
@@ -8,6 +8,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "esp_log.h"
 
@@ -19,6 +20,10 @@
 #include "esp_timer.h"
 #endif
 
+#if CONFIG_ESP_METRICS_SYSTEM
+#include "esp_metrics.h"
+#endif
+
 /* ---------------------------- Definitions --------------------------------- */
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
@@ -34,6 +39,18 @@
                                         } while(0);
 #endif
 
+// Initial number of buckets of the handler lookup index of a loop; the index doubles whenever
+// it holds more entries than buckets.
+#define LOOP_INDEX_INITIAL_SIZE       16
+
+#define INDEX_ENTRY_TO_NODE(entry, type) ((type*)((char*)(entry) - offsetof(type, index_entry)))
+
+#if CONFIG_ESP_METRICS_SYSTEM
+ESP_METRICS_COUNTER_DEFINE(s_post_metric, "esp_event_post_total", "Events posted to the event loops");
+ESP_METRICS_COUNTER_DEFINE(s_post_dropped_metric, "esp_event_post_dropped_total",
+                           "Events which could not be posted because the queue of the loop was full");
+#endif
+
 /* ------------------------- Static Variables ------------------------------- */
 
 static const char* TAG = "event";
@@ -113,30 +130,24 @@ static void esp_event_loop_run_task(void* args)
     vTaskSuspend(NULL);
 }
 
-static void handler_execute(esp_event_loop_instance_t* loop, esp_event_handler_node_t *handler, esp_event_post_instance_t post)
+static inline __attribute__((always_inline)) void* post_instance_data(esp_event_post_instance_t* post)
+{
+    if (!post->data_set) {
+        return NULL;
+    }
+    return post->data_allocated ? post->data.ptr : post->data.buf;
+}
+
+static void handler_execute(esp_event_loop_instance_t* loop, esp_event_handler_node_t *handler, esp_event_post_instance_t *post)
 {
-    ESP_LOGD(TAG, "running post %s:%"PRIu32" with handler %p and context %p on loop %p", post.base, post.id, handler->handler_ctx->handler, &handler->handler_ctx, loop);
+    ESP_LOGD(TAG, "running post %s:%"PRIu32" with handler %p and context %p on loop %p", post->base, post->id, handler->handler_ctx->handler, &handler->handler_ctx, loop);
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     int64_t start, diff;
     start = esp_timer_get_time();
 #endif
     // Execute the handler
-#if CONFIG_ESP_EVENT_POST_FROM_ISR
-    void* data_ptr = NULL;
-
-    if (post.data_set) {
-        if (post.data_allocated) {
-            data_ptr = post.data.ptr;
-        } else {
-            data_ptr = &post.data.val;
-        }
-    }
-
-    (*(handler->handler_ctx->handler))(handler->handler_ctx->arg, post.base, post.id, data_ptr);
-#else
-    (*(handler->handler_ctx->handler))(handler->handler_ctx->arg, post.base, post.id, post.data.ptr);
-#endif
+    (*(handler->handler_ctx->handler))(handler->handler_ctx->arg, post->base, post->id, post_instance_data(post));
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     diff = esp_timer_get_time() - start;
@@ -146,6 +157,92 @@ static void handler_execute(esp_event_loop_instance_t* loop, esp_event_handler_n
 #endif
 }
 
+static inline __attribute__((always_inline)) size_t loop_index_bucket(const esp_event_loop_instance_t* loop, const void* parent, uintptr_t key)
+{
+    uint32_t hash = ((uint32_t)(uintptr_t)parent >> 2) * 2654435761u;
+    hash ^= (uint32_t)key * 0x85ebca6bu;
+    hash ^= hash >> 15;
+    return hash & (loop->index_size - 1);
+}
+
+// Entries with the same parent and key end up in the same bucket in the order they were added,
+// which keeps the dispatch order of handlers the same as when scanning the lists.
+static void loop_index_append(esp_event_loop_instance_t* loop, esp_event_index_entry_t* entry)
+{
+    esp_event_index_entry_t** it = &(loop->index[loop_index_bucket(loop, entry->parent, entry->key)]);
+    while (*it != NULL) {
+        it = &((*it)->next);
+    }
+    entry->next = NULL;
+    *it = entry;
+}
+
+static void loop_index_grow(esp_event_loop_instance_t* loop)
+{
+    esp_event_index_entry_t** index = calloc(loop->index_size * 2, sizeof(*index));
+
+    if (!index) {
+        // Not fatal, lookups only get slower with longer bucket chains
+        ESP_LOGD(TAG, "alloc for larger lookup index of loop %p failed", loop);
+        return;
+    }
+
+    esp_event_index_entry_t** old_index = loop->index;
+    size_t old_size = loop->index_size;
+
+    loop->index = index;
+    loop->index_size = old_size * 2;
+
+    for (size_t i = 0; i < old_size; i++) {
+        esp_event_index_entry_t* entry = old_index[i];
+        while (entry != NULL) {
+            esp_event_index_entry_t* next = entry->next;
+            loop_index_append(loop, entry);
+            entry = next;
+        }
+    }
+
+    free(old_index);
+}
+
+static void loop_index_insert(esp_event_loop_instance_t* loop, esp_event_index_entry_t* entry, const void* parent, uintptr_t key)
+{
+    entry->parent = parent;
+    entry->key = key;
+
+    if (loop->index_count >= loop->index_size) {
+        loop_index_grow(loop);
+    }
+
+    loop_index_append(loop, entry);
+    loop->index_count++;
+}
+
+static void loop_index_remove(esp_event_loop_instance_t* loop, esp_event_index_entry_t* entry)
+{
+    esp_event_index_entry_t** it = &(loop->index[loop_index_bucket(loop, entry->parent, entry->key)]);
+    while (*it != entry) {
+        assert(*it != NULL);
+        it = &((*it)->next);
+    }
+    *it = entry->next;
+    loop->index_count--;
+}
+
+// Returns the first entry for parent and key if prev is NULL, otherwise the next one after prev.
+static esp_event_index_entry_t* loop_index_find(esp_event_loop_instance_t* loop, const void* parent, uintptr_t key, esp_event_index_entry_t* prev)
+{
+    esp_event_index_entry_t* entry = prev ? prev->next : loop->index[loop_index_bucket(loop, parent, key)];
+
+    for (; entry != NULL; entry = entry->next) {
+        if (entry->parent == parent && entry->key == key) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
 static esp_err_t handler_instances_add(esp_event_handler_nodes_t* handlers, esp_event_handler_t event_handler, void* event_handler_arg, esp_event_handler_instance_context_t **handler_ctx, bool legacy)
 {
     esp_event_handler_node_t *handler_instance = calloc(1, sizeof(*handler_instance));
@@ -195,7 +292,8 @@ static esp_err_t handler_instances_add(esp_event_handler_nodes_t* handlers, esp_
     return ESP_OK;
 }
 
-static esp_err_t base_node_add_handler(esp_event_base_node_t* base_node,
+static esp_err_t base_node_add_handler(esp_event_loop_instance_t* loop,
+                                       esp_event_base_node_t* base_node,
                                        int32_t id,
                                        esp_event_handler_t event_handler,
                                        void *event_handler_arg,
@@ -235,6 +333,7 @@ static esp_err_t base_node_add_handler(esp_event_base_node_t* base_node,
                 } else {
                     SLIST_INSERT_AFTER(last_id_node, id_node, next);
                 }
+                loop_index_insert(loop, &(id_node->index_entry), base_node, (uintptr_t)id);
             } else {
                 free(id_node);
             }
@@ -246,7 +345,8 @@ static esp_err_t base_node_add_handler(esp_event_base_node_t* base_node,
     }
 }
 
-static esp_err_t loop_node_add_handler(esp_event_loop_node_t* loop_node,
+static esp_err_t loop_node_add_handler(esp_event_loop_instance_t* loop,
+                                       esp_event_loop_node_t* loop_node,
                                        esp_event_base_t base,
                                        int32_t id,
                                        esp_event_handler_t event_handler,
@@ -283,7 +383,7 @@ static esp_err_t loop_node_add_handler(esp_event_loop_node_t* loop_node,
             SLIST_INIT(&(base_node->handlers));
             SLIST_INIT(&(base_node->id_nodes));
 
-            err = base_node_add_handler(base_node, id, event_handler, event_handler_arg, handler_ctx, legacy);
+            err = base_node_add_handler(loop, base_node, id, event_handler, event_handler_arg, handler_ctx, legacy);
 
             if (err == ESP_OK) {
                 if (!last_base_node) {
@@ -291,13 +391,14 @@ static esp_err_t loop_node_add_handler(esp_event_loop_node_t* loop_node,
                 } else {
                     SLIST_INSERT_AFTER(last_base_node, base_node, next);
                 }
+                loop_index_insert(loop, &(base_node->index_entry), loop_node, (uintptr_t)base);
             } else {
                 free(base_node);
             }
 
             return err;
         } else {
-            return base_node_add_handler(base_node, id, event_handler, event_handler_arg, handler_ctx, legacy);
+            return base_node_add_handler(loop, base_node, id, event_handler, event_handler_arg, handler_ctx, legacy);
         }
     }
 }
@@ -327,7 +428,7 @@ static esp_err_t handler_instances_remove(esp_event_handler_nodes_t* handlers, e
     return ESP_ERR_NOT_FOUND;
 }
 
-static esp_err_t base_node_remove_handler(esp_event_base_node_t* base_node, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
+static esp_err_t base_node_remove_handler(esp_event_loop_instance_t* loop, esp_event_base_node_t* base_node, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
 {
     if (id == ESP_EVENT_ANY_ID) {
         return handler_instances_remove(&(base_node->handlers), handler_ctx, legacy);
@@ -340,6 +441,7 @@ static esp_err_t base_node_remove_handler(esp_event_base_node_t* base_node, int3
                 if (res == ESP_OK) {
                     if (SLIST_EMPTY(&(it->handlers))) {
                         SLIST_REMOVE(&(base_node->id_nodes), it, esp_event_id_node, next);
+                        loop_index_remove(loop, &(it->index_entry));
                         free(it);
                     }
                     return ESP_OK;
@@ -351,7 +453,7 @@ static esp_err_t base_node_remove_handler(esp_event_base_node_t* base_node, int3
     return ESP_ERR_NOT_FOUND;
 }
 
-static esp_err_t loop_node_remove_handler(esp_event_loop_node_t* loop_node, esp_event_base_t base, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
+static esp_err_t loop_node_remove_handler(esp_event_loop_instance_t* loop, esp_event_loop_node_t* loop_node, esp_event_base_t base, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
 {
     if (base == esp_event_any_base && id == ESP_EVENT_ANY_ID) {
         return handler_instances_remove(&(loop_node->handlers), handler_ctx, legacy);
@@ -359,11 +461,12 @@ static esp_err_t loop_node_remove_handler(esp_event_loop_node_t* loop_node, esp_
         esp_event_base_node_t *it, *temp;
         SLIST_FOREACH_SAFE(it, &(loop_node->base_nodes), next, temp) {
             if (it->base == base) {
-                esp_err_t res = base_node_remove_handler(it, id, handler_ctx, legacy);
+                esp_err_t res = base_node_remove_handler(loop, it, id, handler_ctx, legacy);
 
                 if (res == ESP_OK) {
                     if (SLIST_EMPTY(&(it->handlers)) && SLIST_EMPTY(&(it->id_nodes))) {
                         SLIST_REMOVE(&(loop_node->base_nodes), it, esp_event_base_node, next);
+                        loop_index_remove(loop, &(it->index_entry));
                         free(it);
                     }
                     return ESP_OK;
@@ -379,7 +482,7 @@ static esp_err_t loop_remove_handler(esp_event_remove_handler_context_t* ctx)
 {
     esp_event_loop_node_t *it, *temp;
     SLIST_FOREACH_SAFE(it, &(ctx->loop->loop_nodes), next, temp) {
-        esp_err_t res = loop_node_remove_handler(it, ctx->event_base, ctx->event_id, ctx->handler_ctx, ctx->legacy);
+        esp_err_t res = loop_node_remove_handler(ctx->loop, it, ctx->event_base, ctx->event_id, ctx->handler_ctx, ctx->legacy);
 
         if (res == ESP_OK) {
             if (SLIST_EMPTY(&(it->base_nodes)) && SLIST_EMPTY(&(it->handlers))) {
@@ -428,15 +531,98 @@ static void loop_node_remove_all_handler(esp_event_loop_node_t* loop_node)
 
 static void inline __attribute__((always_inline)) post_instance_delete(esp_event_post_instance_t* post)
 {
-#if CONFIG_ESP_EVENT_POST_FROM_ISR
-    if (post->data_allocated)
-#endif
-    {
+    if (post->data_allocated) {
         free(post->data.ptr);
     }
     memset(post, 0, sizeof(*post));
 }
 
+// Must be called with the options lock taken. The options of the event take precedence over those of its base.
+static inline __attribute__((always_inline)) esp_event_options_node_t* loop_find_options(esp_event_loop_instance_t* loop,
+                                                                                        esp_event_base_t base, int32_t id)
+{
+    esp_event_options_node_t *options, *base_options = NULL;
+    SLIST_FOREACH(options, &(loop->options), next) {
+        if (options->base == base) {
+            if (options->id == id) {
+                return options;
+            }
+            if (options->id == ESP_EVENT_ANY_ID) {
+                base_options = options;
+            }
+        }
+    }
+    return base_options;
+}
+
+// Selects the queue of the post according to the options of the event. Returns false if the post has to be
+// discarded because the same coalesced event is already queued.
+static inline __attribute__((always_inline)) bool loop_prepare_post(esp_event_loop_instance_t* loop,
+                                                                   esp_event_post_instance_t* post, uint8_t* priority)
+{
+    bool queue_post = true;
+    *priority = 0;
+    if (SLIST_EMPTY(&(loop->options))) {
+        return true;
+    }
+
+    portENTER_CRITICAL_SAFE(&(loop->options_lock));
+    esp_event_options_node_t* options = loop_find_options(loop, post->base, post->id);
+    if (options != NULL) {
+        *priority = options->priority;
+        if (options->coalesce) {
+            if (options->queued) {
+                queue_post = false;
+            } else {
+                options->queued = true;
+                post->coalesced = options;
+            }
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&(loop->options_lock));
+    return queue_post;
+}
+
+// Called when a coalesced post leaves the queue, or could not be queued: the next post of the event is queued again
+static inline __attribute__((always_inline)) void loop_release_post(esp_event_loop_instance_t* loop, esp_event_post_instance_t* post)
+{
+    if (post->coalesced != NULL) {
+        portENTER_CRITICAL_SAFE(&(loop->options_lock));
+        post->coalesced->queued = false;
+        portEXIT_CRITICAL_SAFE(&(loop->options_lock));
+        post->coalesced = NULL;
+    }
+}
+
+static BaseType_t loop_send_post(esp_event_loop_instance_t* loop, esp_event_post_instance_t* post, uint8_t priority,
+                                 TickType_t ticks_to_wait)
+{
+    BaseType_t result = xQueueSendToBack(loop->queues[priority], post, ticks_to_wait);
+    if (result == pdTRUE && loop->pending != NULL) {
+        xSemaphoreGive(loop->pending);
+    }
+    return result;
+}
+
+// Receives the oldest post of the highest priority queue which is not empty
+static BaseType_t loop_receive_post(esp_event_loop_instance_t* loop, esp_event_post_instance_t* post, TickType_t ticks_to_wait)
+{
+    if (loop->pending == NULL) {
+        return xQueueReceive(loop->queues[0], post, ticks_to_wait);
+    }
+    if (xSemaphoreTake(loop->pending, ticks_to_wait) != pdTRUE) {
+        return pdFALSE;
+    }
+    // The semaphore is given after the post is queued, so one of the queues holds a post for each count taken
+    for (int i = loop->num_queues - 1; i >= 0; i--) {
+        if (xQueueReceive(loop->queues[i], post, 0) == pdTRUE) {
+            return pdTRUE;
+        }
+    }
+    assert(false);
+    return pdFALSE;
+}
+
 static esp_err_t find_and_unregister_handler(esp_event_remove_handler_context_t* ctx)
 {
     esp_event_handler_node_t *handler_to_unregister = NULL;
@@ -549,6 +735,11 @@ esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, es
         return ESP_ERR_INVALID_ARG;
     }
 
+    if (event_loop_args->num_priorities > ESP_EVENT_LOOP_MAX_PRIORITIES) {
+        ESP_LOGE(TAG, "too many event priorities");
+        return ESP_ERR_INVALID_ARG;
+    }
+
     esp_event_loop_instance_t* loop;
     esp_err_t err = ESP_ERR_NO_MEM; // most likely error
 
@@ -558,12 +749,26 @@ esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, es
         return err;
     }
 
-    loop->queue = xQueueCreate(event_loop_args->queue_size, sizeof(esp_event_post_instance_t));
-    if (loop->queue == NULL) {
-        ESP_LOGE(TAG, "create event loop queue failed");
-        goto on_err;
+    loop->num_queues = event_loop_args->num_priorities ? event_loop_args->num_priorities : 1;
+    for (int i = 0; i < loop->num_queues; i++) {
+        loop->queues[i] = xQueueCreate(event_loop_args->queue_size, sizeof(esp_event_post_instance_t));
+        if (loop->queues[i] == NULL) {
+            ESP_LOGE(TAG, "create event loop queue failed");
+            goto on_err;
+        }
+    }
+
+    if (loop->num_queues > 1) {
+        loop->pending = xSemaphoreCreateCounting(loop->num_queues * event_loop_args->queue_size, 0);
+        if (loop->pending == NULL) {
+            ESP_LOGE(TAG, "create event loop semaphore failed");
+            goto on_err;
+        }
     }
 
+    SLIST_INIT(&(loop->options));
+    portMUX_INITIALIZE(&(loop->options_lock));
+
     loop->mutex = xSemaphoreCreateRecursiveMutex();
     if (loop->mutex == NULL) {
         ESP_LOGE(TAG, "create event loop mutex failed");
@@ -572,6 +777,13 @@ esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, es
 
     SLIST_INIT(&(loop->loop_nodes));
 
+    loop->index = calloc(LOOP_INDEX_INITIAL_SIZE, sizeof(*(loop->index)));
+    if (loop->index == NULL) {
+        ESP_LOGE(TAG, "alloc for event loop lookup index failed");
+        goto on_err;
+    }
+    loop->index_size = LOOP_INDEX_INITIAL_SIZE;
+
     // Create the loop task if requested
     if (event_loop_args->task_name != NULL) {
         BaseType_t task_created = xTaskCreatePinnedToCore(esp_event_loop_run_task, event_loop_args->task_name,
@@ -607,25 +819,30 @@ esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, es
     return ESP_OK;
 
 on_err:
-    if (loop->queue != NULL) {
-        vQueueDelete(loop->queue);
+    for (int i = 0; i < loop->num_queues; i++) {
+        if (loop->queues[i] != NULL) {
+            vQueueDelete(loop->queues[i]);
+        }
+    }
+
+    if (loop->pending != NULL) {
+        vSemaphoreDelete(loop->pending);
     }
 
     if (loop->mutex != NULL) {
         vSemaphoreDelete(loop->mutex);
     }
 
+    free(loop->index);
     free(loop);
 
     return err;
 }
 
-// On event lookup performance: The library implements the event list as a linked list, which results to O(n)
-// lookup time. The test comparing this implementation to the O(lg n) performance of rbtrees
-// (https://github.com/freebsd/freebsd/blob/master/sys/sys/tree.h)
-// indicate that the difference is not that substantial, especially considering the additional
-// pointers per node of rbtrees. Code for the rbtree implementation of the event loop library is archived
-// in feature/esp_event_loop_library_rbtrees if needed.
+// On event lookup performance: The library keeps the registered handlers in linked lists, which define the order
+// handlers are executed in. Dispatch does not scan them, though: base nodes are looked up by (loop node, base) and
+// id nodes by (base node, id) in a hash index of the loop, so the cost of dispatching an event does not grow with
+// the number of registered bases and ids. Only the loop nodes, of which there are few, are walked.
 esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t ticks_to_run)
 {
     assert(event_loop);
@@ -641,15 +858,18 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
     int64_t remaining_ticks = ticks_to_run;
 #endif
 
-    while (xQueueReceive(loop->queue, &post, remaining_ticks) == pdTRUE) {
+    while (loop_receive_post(loop, &post, remaining_ticks) == pdTRUE) {
+        // The next post of a coalesced event has to be queued, even if it is posted by one of the handlers
+        loop_release_post(loop, &post);
+
         // The event has already been unqueued, so ensure it gets executed.
         xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
 
         // check if the event retrieve from the queue is the internal event that is
         // triggered when a handler needs to be removed..
         if (post.base == esp_event_handler_cleanup) {
-            assert(post.data.ptr != NULL);
-            esp_event_remove_handler_context_t* ctx = (esp_event_remove_handler_context_t*)post.data.ptr;
+            esp_event_remove_handler_context_t* ctx = (esp_event_remove_handler_context_t*)post_instance_data(&post);
+            assert(ctx != NULL);
             loop_remove_handler(ctx);
 
             // if the handler unregistration request came from legacy code,
@@ -666,39 +886,39 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
 
         esp_event_handler_node_t *handler, *temp_handler;
         esp_event_loop_node_t *loop_node, *temp_node;
-        esp_event_base_node_t *base_node, *temp_base;
-        esp_event_id_node_t *id_node, *temp_id_node;
+        esp_event_base_node_t *base_node;
+        esp_event_id_node_t *id_node;
 
         SLIST_FOREACH_SAFE(loop_node, &(loop->loop_nodes), next, temp_node) {
             // Execute loop level handlers
             SLIST_FOREACH_SAFE(handler, &(loop_node->handlers), next, temp_handler) {
                 if (!handler->unregistered) {
-                    handler_execute(loop, handler, post);
+                    handler_execute(loop, handler, &post);
                     exec |= true;
                 }
             }
 
-            SLIST_FOREACH_SAFE(base_node, &(loop_node->base_nodes), next, temp_base) {
-                if (base_node->base == post.base) {
-                    // Execute base level handlers
-                    SLIST_FOREACH_SAFE(handler, &(base_node->handlers), next, temp_handler) {
-                        if (!handler->unregistered) {
-                            handler_execute(loop, handler, post);
-                            exec |= true;
-                        }
+            esp_event_index_entry_t *base_entry = NULL;
+            while ((base_entry = loop_index_find(loop, loop_node, (uintptr_t)post.base, base_entry)) != NULL) {
+                base_node = INDEX_ENTRY_TO_NODE(base_entry, esp_event_base_node_t);
+
+                // Execute base level handlers
+                SLIST_FOREACH_SAFE(handler, &(base_node->handlers), next, temp_handler) {
+                    if (!handler->unregistered) {
+                        handler_execute(loop, handler, &post);
+                        exec |= true;
                     }
+                }
 
-                    SLIST_FOREACH_SAFE(id_node, &(base_node->id_nodes), next, temp_id_node) {
-                        if (id_node->id == post.id) {
-                            // Execute id level handlers
-                            SLIST_FOREACH_SAFE(handler, &(id_node->handlers), next, temp_handler) {
-                                if (!handler->unregistered) {
-                                    handler_execute(loop, handler, post);
-                                    exec |= true;
-                                }
-                            }
-                            // Skip to next base node
-                            break;
+                esp_event_index_entry_t *id_entry = loop_index_find(loop, base_node, (uintptr_t)post.id, NULL);
+                if (id_entry != NULL) {
+                    id_node = INDEX_ENTRY_TO_NODE(id_entry, esp_event_id_node_t);
+
+                    // Execute id level handlers
+                    SLIST_FOREACH_SAFE(handler, &(id_node->handlers), next, temp_handler) {
+                        if (!handler->unregistered) {
+                            handler_execute(loop, handler, &post);
+                            exec |= true;
                         }
                     }
                 }
@@ -764,14 +984,24 @@ esp_err_t esp_event_loop_delete(esp_event_loop_handle_t event_loop)
         free(it);
     }
 
-    // Drop existing posts on the queue
+    // Drop existing posts on the queues
     esp_event_post_instance_t post;
-    while (xQueueReceive(loop->queue, &post, 0) == pdTRUE) {
-        post_instance_delete(&post);
+    for (int i = 0; i < loop->num_queues; i++) {
+        while (xQueueReceive(loop->queues[i], &post, 0) == pdTRUE) {
+            post_instance_delete(&post);
+        }
+        vQueueDelete(loop->queues[i]);
     }
 
     // Cleanup loop
-    vQueueDelete(loop->queue);
+    if (loop->pending != NULL) {
+        vSemaphoreDelete(loop->pending);
+    }
+    esp_event_options_node_t *options, *temp_options;
+    SLIST_FOREACH_SAFE(options, &(loop->options), next, temp_options) {
+        free(options);
+    }
+    free(loop->index);
     free(loop);
     // Free loop mutex before deleting
     xSemaphoreGiveRecursive(loop_mutex);
@@ -823,7 +1053,7 @@ esp_err_t esp_event_handler_register_with_internal(esp_event_loop_handle_t event
         SLIST_INIT(&(loop_node->handlers));
         SLIST_INIT(&(loop_node->base_nodes));
 
-        err = loop_node_add_handler(loop_node, event_base, event_id, event_handler, event_handler_arg, handler_ctx_arg, legacy);
+        err = loop_node_add_handler(loop, loop_node, event_base, event_id, event_handler, event_handler_arg, handler_ctx_arg, legacy);
 
         if (err == ESP_OK) {
             if (!last_loop_node) {
@@ -835,7 +1065,7 @@ esp_err_t esp_event_handler_register_with_internal(esp_event_loop_handle_t event
             free(loop_node);
         }
     } else {
-        err = loop_node_add_handler(last_loop_node, event_base, event_id, event_handler, event_handler_arg, handler_ctx_arg, legacy);
+        err = loop_node_add_handler(loop, last_loop_node, event_base, event_id, event_handler, event_handler_arg, handler_ctx_arg, legacy);
     }
 
 on_err:
@@ -909,6 +1139,47 @@ esp_err_t esp_event_handler_instance_unregister_with(esp_event_loop_handle_t eve
     return esp_event_handler_unregister_with_internal(event_loop, event_base, event_id, (esp_event_handler_instance_context_t*) handler_ctx_arg, false);
 }
 
+esp_err_t esp_event_loop_set_event_options(esp_event_loop_handle_t event_loop, esp_event_base_t event_base,
+                                           int32_t event_id, const esp_event_options_t* options)
+{
+    assert(event_loop);
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    if (options == NULL || event_base == ESP_EVENT_ANY_BASE || options->priority >= loop->num_queues ||
+            (options->coalesce && event_id == ESP_EVENT_ANY_ID)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Allocate outside of the critical section, in case the options are new
+    esp_event_options_node_t* new_options = calloc(1, sizeof(*new_options));
+    if (new_options == NULL) {
+        ESP_LOGE(TAG, "alloc for event options failed");
+        return ESP_ERR_NO_MEM;
+    }
+
+    portENTER_CRITICAL(&(loop->options_lock));
+    esp_event_options_node_t* it;
+    SLIST_FOREACH(it, &(loop->options), next) {
+        if (it->base == event_base && it->id == event_id) {
+            break;
+        }
+    }
+    if (it == NULL) {
+        it = new_options;
+        new_options = NULL;
+        it->base = event_base;
+        it->id = event_id;
+        SLIST_INSERT_HEAD(&(loop->options), it, next);
+    }
+    it->priority = options->priority;
+    it->coalesce = options->coalesce;
+    portEXIT_CRITICAL(&(loop->options_lock));
+
+    free(new_options);
+    return ESP_OK;
+}
+
 esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id,
                             const void* event_data, size_t event_data_size, TickType_t ticks_to_wait)
 {
@@ -924,23 +1195,33 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t
     memset((void*)(&post), 0, sizeof(post));
 
     if (event_data != NULL && event_data_size != 0) {
-        // Make persistent copy of event data on heap.
-        void* event_data_copy = calloc(1, event_data_size);
+        if (event_data_size <= sizeof(post.data.buf)) {
+            // Small event data travels inside the queue item, no allocation needed.
+            memcpy(post.data.buf, event_data, event_data_size);
+        } else {
+            // Make persistent copy of event data on heap.
+            void* event_data_copy = calloc(1, event_data_size);
 
-        if (event_data_copy == NULL) {
-            return ESP_ERR_NO_MEM;
-        }
+            if (event_data_copy == NULL) {
+                return ESP_ERR_NO_MEM;
+            }
 
-        memcpy(event_data_copy, event_data, event_data_size);
-        post.data.ptr = event_data_copy;
-#if CONFIG_ESP_EVENT_POST_FROM_ISR
-        post.data_allocated = true;
+            memcpy(event_data_copy, event_data, event_data_size);
+            post.data.ptr = event_data_copy;
+            post.data_allocated = true;
+        }
         post.data_set = true;
-#endif
     }
     post.base = event_base;
     post.id = event_id;
 
+    uint8_t priority;
+    if (!loop_prepare_post(loop, &post, &priority)) {
+        // The same event is already queued
+        post_instance_delete(&post);
+        return ESP_OK;
+    }
+
     BaseType_t result = pdFALSE;
 
     // Find the task that currently executes the loop. It is safe to query loop->task since it is
@@ -952,26 +1233,30 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t
         if (result == pdTRUE) {
             if (loop->running_task != xTaskGetCurrentTaskHandle()) {
                 xSemaphoreGiveRecursive(loop->mutex);
-                result = xQueueSendToBack(loop->queue, &post, ticks_to_wait);
+                result = loop_send_post(loop, &post, priority, ticks_to_wait);
             } else {
                 xSemaphoreGiveRecursive(loop->mutex);
-                result = xQueueSendToBack(loop->queue, &post, 0);
+                result = loop_send_post(loop, &post, priority, 0);
             }
         }
     } else {
         // The loop has a dedicated task.
         if (loop->task != xTaskGetCurrentTaskHandle()) {
-            result = xQueueSendToBack(loop->queue, &post, ticks_to_wait);
+            result = loop_send_post(loop, &post, priority, ticks_to_wait);
         } else {
-            result = xQueueSendToBack(loop->queue, &post, 0);
+            result = loop_send_post(loop, &post, priority, 0);
         }
     }
 
     if (result != pdTRUE) {
+        loop_release_post(loop, &post);
         post_instance_delete(&post);
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
         atomic_fetch_add(&loop->events_dropped, 1);
+#endif
+#if CONFIG_ESP_METRICS_SYSTEM
+        esp_metrics_counter_inc(&s_post_dropped_metric);
 #endif
         return ESP_ERR_TIMEOUT;
     }
@@ -979,6 +1264,9 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     atomic_fetch_add(&loop->events_received, 1);
 #endif
+#if CONFIG_ESP_METRICS_SYSTEM
+    esp_metrics_counter_inc(&s_post_metric);
+#endif
 
     return ESP_OK;
 }
@@ -998,28 +1286,45 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop, esp_event_ba
     esp_event_post_instance_t post;
     memset((void*)(&post), 0, sizeof(post));
 
-    if (event_data_size > sizeof(post.data.val)) {
+    if (event_data_size > sizeof(post.data.buf)) {
         return ESP_ERR_INVALID_ARG;
     }
 
     if (event_data != NULL && event_data_size != 0) {
-        memcpy((void*)(&(post.data.val)), event_data, event_data_size);
+        memcpy(post.data.buf, event_data, event_data_size);
         post.data_allocated = false;
         post.data_set = true;
     }
     post.base = event_base;
     post.id = event_id;
 
+    uint8_t priority;
+    if (!loop_prepare_post(loop, &post, &priority)) {
+        // The same event is already queued
+        return ESP_OK;
+    }
+
     BaseType_t result = pdFALSE;
 
     // Post the event from an ISR,
-    result = xQueueSendToBackFromISR(loop->queue, &post, task_unblocked);
+    result = xQueueSendToBackFromISR(loop->queues[priority], &post, task_unblocked);
+    if (result == pdTRUE && loop->pending != NULL) {
+        BaseType_t pending_unblocked = pdFALSE;
+        xSemaphoreGiveFromISR(loop->pending, &pending_unblocked);
+        if (task_unblocked != NULL && pending_unblocked == pdTRUE) {
+            *task_unblocked = pdTRUE;
+        }
+    }
 
     if (result != pdTRUE) {
+        loop_release_post(loop, &post);
         post_instance_delete(&post);
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
         atomic_fetch_add(&loop->events_dropped, 1);
+#endif
+#if CONFIG_ESP_METRICS_SYSTEM
+        esp_metrics_counter_inc(&s_post_dropped_metric);
 #endif
         return ESP_FAIL;
     }
@@ -1027,6 +1332,9 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop, esp_event_ba
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     atomic_fetch_add(&loop->events_received, 1);
 #endif
+#if CONFIG_ESP_METRICS_SYSTEM
+    esp_metrics_counter_inc(&s_post_metric);
+#endif
 
     return ESP_OK;
 }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -20,17 +20,30 @@
 extern "C" {
 #endif
 
+/// Maximum number of event priorities of an event loop
+#define ESP_EVENT_LOOP_MAX_PRIORITIES   4
+
 /// Configuration for creating event loops
 typedef struct {
-    int32_t queue_size;                         /**< size of the event loop queue */
+    int32_t queue_size;                         /**< size of the event loop queue, of each priority */
     const char *task_name;                      /**< name of the event loop task; if NULL,
                                                         a dedicated task is not created for event loop*/
     UBaseType_t task_priority;                  /**< priority of the event loop task, ignored if task name is NULL */
     uint32_t task_stack_size;                   /**< stack size of the event loop task, ignored if task name is NULL */
     BaseType_t task_core_id;                    /**< core to which the event loop task is pinned to,
                                                         ignored if task name is NULL */
+    uint8_t num_priorities;                     /**< number of event priorities, up to ESP_EVENT_LOOP_MAX_PRIORITIES,
+                                                        each with its own queue; 0 is the same as 1 */
 } esp_event_loop_args_t;
 
+/// Options of the events posted to an event loop
+typedef struct {
+    uint8_t priority;                           /**< priority of the events, from 0 (the default, lowest) to the
+                                                        number of priorities of the loop minus one */
+    bool coalesce;                              /**< drop the posts of the event while a post of the same event
+                                                        is still queued; requires a specific event ID */
+} esp_event_options_t;
+
 /**
  * @brief Create a new event loop.
  *
@@ -106,6 +119,53 @@ esp_err_t esp_event_loop_delete_default(void);
  */
 esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t ticks_to_run);
 
+/**
+ * @brief Set the priority and coalescing options of events posted to an event loop
+ *
+ * Each priority of a loop has its own queue. The loop dispatches the events of the highest priority queue first,
+ * so an event of a higher priority is dispatched as soon as the handlers of the current event return, even if many
+ * events of lower priorities are queued. Events without options have priority 0.
+ *
+ * A coalesced event is queued at most once: while it waits in the queue, other posts of the event are discarded
+ * and reported as successful, and the handlers receive the data of the queued post. This cuts storms of events
+ * reporting a state, where only the occurrence matters.
+ *
+ * The options of a specific event take precedence over the options of its base (event_id of ESP_EVENT_ANY_ID).
+ * Setting the options of an event again replaces them.
+ *
+ * @param[in] event_loop the event loop, must not be NULL
+ * @param[in] event_base the base of the events, must not be ESP_EVENT_ANY_BASE
+ * @param[in] event_id the ID of the event, or ESP_EVENT_ANY_ID for all the events of the base
+ * @param[in] options the options, must not be NULL
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_NO_MEM: Cannot allocate memory for the options
+ *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event ID, priority not lower than the number of
+ *                          priorities of the loop, or coalescing requested for ESP_EVENT_ANY_ID
+ */
+esp_err_t esp_event_loop_set_event_options(esp_event_loop_handle_t event_loop,
+                                           esp_event_base_t event_base,
+                                           int32_t event_id,
+                                           const esp_event_options_t *options);
+
+/**
+ * @brief Set the priority and coalescing options of events posted to the default event loop
+ *
+ * The number of priorities of the default event loop is set by CONFIG_ESP_EVENT_DEFAULT_LOOP_PRIORITIES.
+ * See esp_event_loop_set_event_options().
+ *
+ * @param[in] event_base the base of the events, must not be ESP_EVENT_ANY_BASE
+ * @param[in] event_id the ID of the event, or ESP_EVENT_ANY_ID for all the events of the base
+ * @param[in] options the options, must not be NULL
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_STATE: The default event loop has not been created
+ *  - Others: See esp_event_loop_set_event_options()
+ */
+esp_err_t esp_event_set_event_options(esp_event_base_t event_base, int32_t event_id, const esp_event_options_t *options);
+
 /**
  * @brief Register an event handler to the system event loop (legacy).
  *
@@ -347,6 +407,9 @@ esp_err_t esp_event_handler_instance_unregister(esp_event_base_t event_base,
  * the copy's lifetime automatically (allocation + deletion); this ensures that the data the
  * handler receives is always valid.
  *
+ * Event data of up to CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE bytes is stored in the event queue, larger event data
+ * is copied to the heap.
+ *
  * @param[in] event_base the event base that identifies the event
  * @param[in] event_id the event ID that identifies the event
  * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler
@@ -402,7 +465,7 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop,
  * @param[in] event_base the event base that identifies the event
  * @param[in] event_id the event ID that identifies the event
  * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler
- * @param[in] event_data_size the size of the event data; max is 4 bytes
+ * @param[in] event_data_size the size of the event data; max is CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE bytes
  * @param[out] task_unblocked an optional parameter (can be NULL) which indicates that an event task with
  *                            higher priority than currently running task has been unblocked by the posted event;
  *                            a context switch should be requested before the interrupt is existed.
@@ -415,7 +478,7 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop,
  *  - ESP_OK: Success
  *  - ESP_FAIL: Event queue for the default event loop full
  *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event ID,
- *                          data size of more than 4 bytes
+ *                          data size of more than CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE bytes
  *  - Others: Fail
  */
 esp_err_t esp_event_isr_post(esp_event_base_t event_base,
@@ -444,7 +507,7 @@ esp_err_t esp_event_isr_post(esp_event_base_t event_base,
  *  - ESP_OK: Success
  *  - ESP_FAIL: Event queue for the loop full
  *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event ID,
- *                          data size of more than 4 bytes
+ *                          data size of more than CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE bytes
  *  - Others: Fail
  */
 esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop,
@@ -36,12 +36,20 @@ typedef struct esp_event_handler_node {
 
 typedef SLIST_HEAD(esp_event_handler_instances, esp_event_handler_node) esp_event_handler_nodes_t;
 
+/// Entry of the handler lookup index of an event loop
+typedef struct esp_event_index_entry {
+    struct esp_event_index_entry* next;                             /**< next entry in the same index bucket */
+    const void* parent;                                             /**< loop node of a base node, base node of an id node */
+    uintptr_t key;                                                  /**< event base of a base node, event id of an id node */
+} esp_event_index_entry_t;
+
 /// Event
 typedef struct esp_event_id_node {
     int32_t id;                                                     /**< id number of the event */
     esp_event_handler_nodes_t handlers;                             /**< list of handlers to be executed when
                                                                             this event is raised */
     SLIST_ENTRY(esp_event_id_node) next;                            /**< pointer to the next event node on the linked list */
+    esp_event_index_entry_t index_entry;                            /**< entry in the loop's lookup index */
 } esp_event_id_node_t;
 
 typedef SLIST_HEAD(esp_event_id_nodes, esp_event_id_node) esp_event_id_nodes_t;
@@ -52,6 +60,7 @@ typedef struct esp_event_base_node {
                                                                             all events with this base */
     esp_event_id_nodes_t id_nodes;                                  /**< list of event ids with this base */
     SLIST_ENTRY(esp_event_base_node) next;                          /**< pointer to the next base node on the linked list */
+    esp_event_index_entry_t index_entry;                            /**< entry in the loop's lookup index */
 } esp_event_base_node_t;
 
 typedef SLIST_HEAD(esp_event_base_nodes, esp_event_base_node) esp_event_base_nodes_t;
@@ -66,16 +75,40 @@ typedef struct esp_event_loop_node {
 
 typedef SLIST_HEAD(esp_event_loop_nodes, esp_event_loop_node) esp_event_loop_nodes_t;
 
+/// Options of the events of a loop, set with esp_event_loop_set_event_options()
+typedef struct esp_event_options_node {
+    esp_event_base_t base;                                          /**< event base the options apply to */
+    int32_t id;                                                     /**< event id the options apply to, ESP_EVENT_ANY_ID
+                                                                            for all the events of the base */
+    uint8_t priority;                                               /**< queue the events are posted to */
+    bool coalesce;                                                  /**< drop the posts of the event while it is queued */
+    bool queued;                                                    /**< a post of the coalesced event is queued */
+    SLIST_ENTRY(esp_event_options_node) next;                       /**< next options of the loop */
+} esp_event_options_node_t;
+
+typedef SLIST_HEAD(esp_event_options_nodes, esp_event_options_node) esp_event_options_nodes_t;
+
 /// Event loop
 typedef struct esp_event_loop_instance {
     const char* name;                                               /**< name of this event loop */
-    QueueHandle_t queue;                                            /**< event queue */
+    QueueHandle_t queues[ESP_EVENT_LOOP_MAX_PRIORITIES];            /**< event queue of each priority, the highest
+                                                                            non-empty one is dispatched first */
+    uint8_t num_queues;                                             /**< number of priorities of the loop */
+    SemaphoreHandle_t pending;                                      /**< counts the events queued to all the queues,
+                                                                            NULL if the loop has a single queue */
+    esp_event_options_nodes_t options;                              /**< options of the events posted to the loop */
+    portMUX_TYPE options_lock;                                      /**< protects the options, taken when posting */
     TaskHandle_t task;                                              /**< task that consumes the event queue */
     TaskHandle_t running_task;                                      /**< for loops with no dedicated task, the
                                                                             task that consumes the queue */
     SemaphoreHandle_t mutex;                                        /**< mutex for updating the events linked list */
     esp_event_loop_nodes_t loop_nodes;                              /**< set of linked lists containing the
                                                                             registered handlers for the loop */
+    esp_event_index_entry_t** index;                                /**< hash buckets indexing the base and id nodes
+                                                                            of the loop nodes, so that dispatch does not
+                                                                            have to scan the lists */
+    size_t index_size;                                              /**< number of buckets, a power of two */
+    size_t index_count;                                             /**< number of entries in the index */
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     atomic_uint_least32_t events_received;                          /**< number of events successfully posted to the loop */
     atomic_uint_least32_t events_dropped;                           /**< number of events dropped due to queue being full */
@@ -94,17 +127,17 @@ typedef struct esp_event_remove_handler_context_t {
 typedef union esp_event_post_data {
     uint32_t val;
     void *ptr;
+    uint8_t buf[CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE];             /**< event data small enough to be stored in the queue item */
 } esp_event_post_data_t;
 
 /// Event posted to the event queue
 typedef struct esp_event_post_instance {
-#if CONFIG_ESP_EVENT_POST_FROM_ISR
     bool data_allocated;                                             /**< indicates whether data is allocated from heap */
     bool data_set;                                                   /**< indicates if data is null */
-#endif
     esp_event_base_t base;                                           /**< the event base */
     int32_t id;                                                      /**< the event id */
     esp_event_post_data_t data;                                      /**< data associated with the event */
+    esp_event_options_node_t* coalesced;                             /**< options of the event if it is coalesced */
 } esp_event_post_instance_t;
 
 #ifdef __cplusplus
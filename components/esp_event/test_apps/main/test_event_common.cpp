@@ -1077,6 +1077,120 @@ TEST_CASE("events handlers for any base are dispatched in the order they are reg
     TEST_ASSERT_EQUAL_INT_ARRAY(ref_arr, test_data.test_data, 4);
 }
 
+#define TEST_MANY_IDS_NUM 100
+
+static void test_event_record_id(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
+{
+    int32_t *ids = (int32_t*) event_handler_arg;
+    ids[event_id]++;
+}
+
+TEST_CASE("events are dispatched to the right handler among many registered IDs", "[event][linux]")
+{
+    EV_LoopFix loop_fix;
+
+    int32_t ids[TEST_MANY_IDS_NUM] = {};
+
+    // enough IDs to make the loop's handler index grow a few times
+    for (int32_t id = 0; id < TEST_MANY_IDS_NUM; id++) {
+        TEST_ESP_OK(esp_event_handler_register_with(loop_fix.loop, s_test_base1, id, test_event_record_id, ids));
+    }
+
+    for (int32_t id = 0; id < TEST_MANY_IDS_NUM; id += 3) {
+        TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, id, NULL, 0, portMAX_DELAY));
+        TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+    }
+    // posting to another base must not reach any of the handlers
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base2, 0, NULL, 0, portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+
+    for (int32_t id = 0; id < TEST_MANY_IDS_NUM; id++) {
+        TEST_ASSERT_EQUAL(id % 3 == 0 ? 1 : 0, ids[id]);
+    }
+
+    for (int32_t id = 0; id < TEST_MANY_IDS_NUM; id += 2) {
+        TEST_ESP_OK(esp_event_handler_unregister_with(loop_fix.loop, s_test_base1, id, test_event_record_id));
+    }
+    memset(ids, 0, sizeof(ids));
+
+    for (int32_t id = 0; id < TEST_MANY_IDS_NUM; id++) {
+        TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, id, NULL, 0, portMAX_DELAY));
+        TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+    }
+
+    for (int32_t id = 0; id < TEST_MANY_IDS_NUM; id++) {
+        TEST_ASSERT_EQUAL(id % 2, ids[id]);
+    }
+}
+
+typedef struct {
+    int32_t ids[8];
+    size_t count;
+} test_event_order_t;
+
+static void test_event_record_order(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
+{
+    test_event_order_t *order = (test_event_order_t*) event_handler_arg;
+    order->ids[order->count++] = (event_base == s_test_base2) ? 10 + event_id : event_id;
+}
+
+TEST_CASE("events of higher priority are dispatched first and pending events are coalesced", "[event][linux]")
+{
+    esp_event_loop_handle_t loop;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+    loop_args.task_name = NULL;
+    loop_args.queue_size = 4;
+    loop_args.num_priorities = ESP_EVENT_LOOP_MAX_PRIORITIES + 1;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_event_loop_create(&loop_args, &loop));
+    loop_args.num_priorities = 2;
+    TEST_ESP_OK(esp_event_loop_create(&loop_args, &loop));
+
+    esp_event_options_t options = {
+        .priority = 2,
+        .coalesce = false,
+    };
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_event_loop_set_event_options(loop, s_test_base1, ESP_EVENT_ANY_ID, &options));
+    options.priority = 1;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_event_loop_set_event_options(loop, ESP_EVENT_ANY_BASE, ESP_EVENT_ANY_ID, &options));
+    options.coalesce = true;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_event_loop_set_event_options(loop, s_test_base2, ESP_EVENT_ANY_ID, &options));
+
+    // all events of base 2 are urgent, except EV1 of base 1 whose pending posts are merged
+    options.coalesce = false;
+    TEST_ESP_OK(esp_event_loop_set_event_options(loop, s_test_base2, ESP_EVENT_ANY_ID, &options));
+    options.priority = 0;
+    options.coalesce = true;
+    TEST_ESP_OK(esp_event_loop_set_event_options(loop, s_test_base1, TEST_EVENT_BASE1_EV2, &options));
+
+    test_event_order_t order = {};
+    TEST_ESP_OK(esp_event_handler_register_with(loop, ESP_EVENT_ANY_BASE, ESP_EVENT_ANY_ID, test_event_record_order, &order));
+
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV2, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV2, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base2, TEST_EVENT_BASE2_EV1, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop, ZERO_DELAY));
+
+    int32_t expected[] = {10 + TEST_EVENT_BASE2_EV1, TEST_EVENT_BASE1_EV1, TEST_EVENT_BASE1_EV2};
+    TEST_ASSERT_EQUAL(3, order.count);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, order.ids, 3);
+
+    // once dispatched, a coalesced event is queued again
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV2, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop, ZERO_DELAY));
+    TEST_ASSERT_EQUAL(4, order.count);
+
+    // the options of an event can be changed
+    options.coalesce = false;
+    TEST_ESP_OK(esp_event_loop_set_event_options(loop, s_test_base1, TEST_EVENT_BASE1_EV2, &options));
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV2, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV2, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop, ZERO_DELAY));
+    TEST_ASSERT_EQUAL(6, order.count);
+
+    TEST_ESP_OK(esp_event_loop_delete(loop));
+}
+
 static void test_create_loop_handler(void* handler_args, esp_event_base_t base, int32_t id, void* event_data)
 {
     esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
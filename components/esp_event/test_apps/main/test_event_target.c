@@ -760,3 +760,53 @@ TEST_CASE("can post events from interrupt handler", "[event][intr]")
 }
 
 #endif // CONFIG_ESP_EVENT_POST_FROM_ISR
+
+static int s_check_data_calls;
+
+static void test_handler_check_data(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
+{
+    const uint8_t *expected = (const uint8_t *) event_handler_arg;
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, event_data, event_id);
+    s_check_data_calls++;
+}
+
+TEST_CASE("small event data is carried in the queue item", "[event]")
+{
+    esp_event_loop_handle_t loop;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+
+    loop_args.task_name = NULL;
+    TEST_ESP_OK(esp_event_loop_create(&loop_args, &loop));
+
+    esp_event_post_instance_t post;
+    esp_event_loop_instance_t* loop_def = (esp_event_loop_instance_t*) loop;
+    uint8_t data[CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE + 1];
+    for (int i = 0; i < sizeof(data); i++) {
+        data[i] = i + 1;
+    }
+
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV1, data, CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(loop_def->queue, &post, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(true, post.data_set);
+    TEST_ASSERT_EQUAL(false, post.data_allocated);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, post.data.buf, CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE);
+
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV1, data, sizeof(data), portMAX_DELAY));
+    TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(loop_def->queue, &post, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(true, post.data_set);
+    TEST_ASSERT_EQUAL(true, post.data_allocated);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, post.data.ptr, sizeof(data));
+    free(post.data.ptr);
+
+    // Handlers get the data in both cases. The event id doubles as the data size to check.
+    s_check_data_calls = 0;
+    TEST_ESP_OK(esp_event_handler_register_with(loop, s_test_base1, ESP_EVENT_ANY_ID, test_handler_check_data, data));
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE, data, CONFIG_ESP_EVENT_POST_INLINE_DATA_SIZE, portMAX_DELAY));
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, sizeof(data), data, sizeof(data), portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop, pdMS_TO_TICKS(10)));
+    TEST_ASSERT_EQUAL(2, s_check_data_calls);
+
+    TEST_ESP_OK(esp_event_loop_delete(loop));
+
+    vTaskDelay(pdMS_TO_TICKS(TEST_CONFIG_TEARDOWN_WAIT));
+}
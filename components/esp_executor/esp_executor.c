@@ -0,0 +1,410 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/select.h>
+#include <sys/param.h>
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_vfs_eventfd.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_executor.h"
+
+static const char *TAG = "executor";
+
+#define EXECUTOR_INVALID_FD (-1)
+
+typedef struct {
+    int fd;                         /*!< EXECUTOR_INVALID_FD if the slot is free */
+    uint32_t events;
+    esp_executor_fd_cb_t cb;
+    void *arg;
+} executor_fd_t;
+
+typedef struct {
+    esp_executor_cb_t cb;
+    void *arg;
+} executor_item_t;
+
+typedef struct executor_timer {
+    esp_executor_timer_t id;
+    int64_t deadline;               /*!< esp_timer time at which the timer expires */
+    esp_executor_cb_t cb;
+    void *arg;
+    struct executor_timer *next;
+} executor_timer_t;
+
+struct esp_executor {
+    TaskHandle_t task;
+    int wake_fd;                    /*!< eventfd written to wake the executor task up from select() */
+    volatile bool stopping;
+    SemaphoreHandle_t stopped_sem;
+    SemaphoreHandle_t lock;         /*!< Protects the file descriptors and the timers */
+    executor_fd_t *fds;
+    size_t max_fds;
+    executor_timer_t *timers;       /*!< Sorted by deadline */
+    esp_executor_timer_t next_timer_id;
+    portMUX_TYPE queue_lock;        /*!< Protects the posted callbacks, which may be posted from ISRs */
+    executor_item_t *queue;
+    size_t queue_size;
+    size_t queue_head;
+    size_t queue_count;
+};
+
+static void executor_wake(esp_executor_handle_t ex)
+{
+    /* The executor task looks for new work before waiting in select() again */
+    if (xPortInIsrContext() || xTaskGetCurrentTaskHandle() != ex->task) {
+        uint64_t one = 1;
+        write(ex->wake_fd, &one, sizeof(one));
+    }
+}
+
+static bool executor_pop_item(esp_executor_handle_t ex, executor_item_t *item)
+{
+    bool popped = false;
+    portENTER_CRITICAL(&ex->queue_lock);
+    if (ex->queue_count > 0) {
+        *item = ex->queue[ex->queue_head];
+        ex->queue_head = (ex->queue_head + 1) % ex->queue_size;
+        ex->queue_count--;
+        popped = true;
+    }
+    portEXIT_CRITICAL(&ex->queue_lock);
+    return popped;
+}
+
+static void executor_run_posted(esp_executor_handle_t ex)
+{
+    /* Only the callbacks posted so far, the ones posted by the callbacks are run at the next iteration */
+    size_t count = ex->queue_count;
+    executor_item_t item;
+    while (count-- > 0 && executor_pop_item(ex, &item)) {
+        item.cb(item.arg);
+    }
+}
+
+/* Run the expired timers, return the time until the next timer expires, -1 if there is no timer */
+static int64_t executor_run_timers(esp_executor_handle_t ex)
+{
+    while (true) {
+        xSemaphoreTake(ex->lock, portMAX_DELAY);
+        executor_timer_t *timer = ex->timers;
+        if (timer == NULL) {
+            xSemaphoreGive(ex->lock);
+            return -1;
+        }
+        int64_t remaining = timer->deadline - esp_timer_get_time();
+        if (remaining > 0) {
+            xSemaphoreGive(ex->lock);
+            return remaining;
+        }
+        ex->timers = timer->next;
+        xSemaphoreGive(ex->lock);
+
+        timer->cb(timer->arg);
+        free(timer);
+    }
+}
+
+static void executor_dispatch_fds(esp_executor_handle_t ex, const fd_set *rfds, const fd_set *wfds)
+{
+    for (size_t i = 0; i < ex->max_fds; i++) {
+        xSemaphoreTake(ex->lock, portMAX_DELAY);
+        executor_fd_t entry = ex->fds[i];
+        xSemaphoreGive(ex->lock);
+        if (entry.fd == EXECUTOR_INVALID_FD) {
+            continue;
+        }
+        uint32_t events = 0;
+        if ((entry.events & ESP_EXECUTOR_FD_READ) && FD_ISSET(entry.fd, rfds)) {
+            events |= ESP_EXECUTOR_FD_READ;
+        }
+        if ((entry.events & ESP_EXECUTOR_FD_WRITE) && FD_ISSET(entry.fd, wfds)) {
+            events |= ESP_EXECUTOR_FD_WRITE;
+        }
+        if (events) {
+            entry.cb(entry.fd, events, entry.arg);
+        }
+    }
+}
+
+static void executor_task(void *arg)
+{
+    esp_executor_handle_t ex = arg;
+
+    while (!ex->stopping) {
+        executor_run_posted(ex);
+        int64_t timeout_us = executor_run_timers(ex);
+
+        fd_set rfds;
+        fd_set wfds;
+        FD_ZERO(&rfds);
+        FD_ZERO(&wfds);
+        FD_SET(ex->wake_fd, &rfds);
+        int max_fd = ex->wake_fd;
+        xSemaphoreTake(ex->lock, portMAX_DELAY);
+        for (size_t i = 0; i < ex->max_fds; i++) {
+            executor_fd_t *entry = &ex->fds[i];
+            if (entry->fd == EXECUTOR_INVALID_FD) {
+                continue;
+            }
+            if (entry->events & ESP_EXECUTOR_FD_READ) {
+                FD_SET(entry->fd, &rfds);
+            }
+            if (entry->events & ESP_EXECUTOR_FD_WRITE) {
+                FD_SET(entry->fd, &wfds);
+            }
+            max_fd = MAX(max_fd, entry->fd);
+        }
+        xSemaphoreGive(ex->lock);
+        if (ex->queue_count > 0) {
+            /* Callbacks have been posted by the callbacks, only poll the file descriptors */
+            timeout_us = 0;
+        }
+
+        struct timeval tv = {
+            .tv_sec = timeout_us / 1000000,
+            .tv_usec = timeout_us % 1000000,
+        };
+        int ret = select(max_fd + 1, &rfds, &wfds, NULL, timeout_us >= 0 ? &tv : NULL);
+        if (ret < 0) {
+            if (errno != EINTR) {
+                /* e.g. a file descriptor has been closed before being removed, do not spin */
+                ESP_LOGE(TAG, "select failed, errno=%d", errno);
+                vTaskDelay(1);
+            }
+            continue;
+        }
+        if (ret == 0) {
+            continue;
+        }
+        if (FD_ISSET(ex->wake_fd, &rfds)) {
+            uint64_t value;
+            read(ex->wake_fd, &value, sizeof(value));
+        }
+        executor_dispatch_fds(ex, &rfds, &wfds);
+    }
+
+    xSemaphoreGive(ex->stopped_sem);
+    vTaskDelete(NULL);
+}
+
+static void executor_free(esp_executor_handle_t ex)
+{
+    while (ex->timers) {
+        executor_timer_t *timer = ex->timers;
+        ex->timers = timer->next;
+        free(timer);
+    }
+    if (ex->wake_fd >= 0) {
+        close(ex->wake_fd);
+    }
+    if (ex->lock) {
+        vSemaphoreDelete(ex->lock);
+    }
+    if (ex->stopped_sem) {
+        vSemaphoreDelete(ex->stopped_sem);
+    }
+    free(ex->fds);
+    free(ex->queue);
+    free(ex);
+}
+
+esp_err_t esp_executor_create(const esp_executor_config_t *config, esp_executor_handle_t *ret_ex)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_ex, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->queue_size > 0, ESP_ERR_INVALID_ARG, TAG, "invalid queue size");
+
+    esp_executor_handle_t ex = calloc(1, sizeof(struct esp_executor));
+    ESP_RETURN_ON_FALSE(ex, ESP_ERR_NO_MEM, TAG, "no mem for executor");
+    ex->wake_fd = EXECUTOR_INVALID_FD;
+    ex->max_fds = config->max_fds;
+    ex->queue_size = config->queue_size;
+    ex->next_timer_id = 1;
+    portMUX_INITIALIZE(&ex->queue_lock);
+
+    ex->fds = calloc(config->max_fds, sizeof(executor_fd_t));
+    ex->queue = calloc(config->queue_size, sizeof(executor_item_t));
+    ex->lock = xSemaphoreCreateMutex();
+    ex->stopped_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE((ex->fds || config->max_fds == 0) && ex->queue && ex->lock && ex->stopped_sem, ESP_ERR_NO_MEM,
+                      err, TAG, "no mem for executor");
+    for (size_t i = 0; i < config->max_fds; i++) {
+        ex->fds[i].fd = EXECUTOR_INVALID_FD;
+    }
+
+    ex->wake_fd = eventfd(0, EFD_SUPPORT_ISR);
+    ESP_GOTO_ON_FALSE(ex->wake_fd >= 0, ESP_FAIL, err, TAG, "create eventfd failed, is the eventfd VFS registered?");
+
+    ESP_GOTO_ON_FALSE(xTaskCreatePinnedToCore(executor_task, "executor", config->stack_size, ex, config->priority,
+                                              &ex->task, config->core_id) == pdPASS,
+                      ESP_ERR_NO_MEM, err, TAG, "create executor task failed");
+
+    *ret_ex = ex;
+    return ESP_OK;
+
+err:
+    executor_free(ex);
+    return ret;
+}
+
+esp_err_t esp_executor_delete(esp_executor_handle_t ex)
+{
+    ESP_RETURN_ON_FALSE(ex, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ex->stopping = true;
+    executor_wake(ex);
+    xSemaphoreTake(ex->stopped_sem, portMAX_DELAY);
+    executor_free(ex);
+    return ESP_OK;
+}
+
+esp_err_t esp_executor_add_fd(esp_executor_handle_t ex, int fd, uint32_t events, esp_executor_fd_cb_t cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE(ex && fd >= 0 && fd < FD_SETSIZE && cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(events & (ESP_EXECUTOR_FD_READ | ESP_EXECUTOR_FD_WRITE), ESP_ERR_INVALID_ARG, TAG, "no event to wait for");
+
+    executor_fd_t *slot = NULL;
+    xSemaphoreTake(ex->lock, portMAX_DELAY);
+    for (size_t i = 0; i < ex->max_fds; i++) {
+        if (ex->fds[i].fd == fd) {
+            slot = &ex->fds[i];
+            break;
+        }
+        if (slot == NULL && ex->fds[i].fd == EXECUTOR_INVALID_FD) {
+            slot = &ex->fds[i];
+        }
+    }
+    if (slot) {
+        slot->fd = fd;
+        slot->events = events;
+        slot->cb = cb;
+        slot->arg = arg;
+    }
+    xSemaphoreGive(ex->lock);
+    ESP_RETURN_ON_FALSE(slot, ESP_ERR_NO_MEM, TAG, "too many file descriptors");
+
+    executor_wake(ex);
+    return ESP_OK;
+}
+
+esp_err_t esp_executor_remove_fd(esp_executor_handle_t ex, int fd)
+{
+    ESP_RETURN_ON_FALSE(ex, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    bool found = false;
+    xSemaphoreTake(ex->lock, portMAX_DELAY);
+    for (size_t i = 0; i < ex->max_fds; i++) {
+        if (ex->fds[i].fd == fd) {
+            ex->fds[i].fd = EXECUTOR_INVALID_FD;
+            found = true;
+            break;
+        }
+    }
+    xSemaphoreGive(ex->lock);
+    if (!found) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    executor_wake(ex);
+    return ESP_OK;
+}
+
+static esp_err_t executor_push_item(esp_executor_handle_t ex, esp_executor_cb_t cb, void *arg)
+{
+    bool pushed = false;
+    portENTER_CRITICAL_SAFE(&ex->queue_lock);
+    if (ex->queue_count < ex->queue_size) {
+        executor_item_t *item = &ex->queue[(ex->queue_head + ex->queue_count) % ex->queue_size];
+        item->cb = cb;
+        item->arg = arg;
+        ex->queue_count++;
+        pushed = true;
+    }
+    portEXIT_CRITICAL_SAFE(&ex->queue_lock);
+    if (!pushed) {
+        return ESP_ERR_NO_MEM;
+    }
+    executor_wake(ex);
+    return ESP_OK;
+}
+
+esp_err_t esp_executor_post(esp_executor_handle_t ex, esp_executor_cb_t cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE(ex && cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return executor_push_item(ex, cb, arg);
+}
+
+esp_err_t esp_executor_post_from_isr(esp_executor_handle_t ex, esp_executor_cb_t cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE_ISR(ex && cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return executor_push_item(ex, cb, arg);
+}
+
+esp_err_t esp_executor_call_after(esp_executor_handle_t ex, uint64_t delay_us, esp_executor_cb_t cb, void *arg,
+                                  esp_executor_timer_t *ret_timer)
+{
+    ESP_RETURN_ON_FALSE(ex && cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    executor_timer_t *timer = calloc(1, sizeof(executor_timer_t));
+    ESP_RETURN_ON_FALSE(timer, ESP_ERR_NO_MEM, TAG, "no mem for timer");
+    timer->deadline = esp_timer_get_time() + delay_us;
+    timer->cb = cb;
+    timer->arg = arg;
+
+    xSemaphoreTake(ex->lock, portMAX_DELAY);
+    timer->id = ex->next_timer_id++;
+    if (ex->next_timer_id == 0) {
+        ex->next_timer_id = 1;
+    }
+    /* Timers with the same deadline expire in the order they were started */
+    executor_timer_t **prev = &ex->timers;
+    while (*prev && (*prev)->deadline <= timer->deadline) {
+        prev = &(*prev)->next;
+    }
+    timer->next = *prev;
+    *prev = timer;
+    bool first = (ex->timers == timer);
+    /* The timer may expire and be freed as soon as the lock is released */
+    esp_executor_timer_t timer_id = timer->id;
+    xSemaphoreGive(ex->lock);
+
+    if (ret_timer) {
+        *ret_timer = timer_id;
+    }
+    if (first) {
+        /* The executor task may be waiting until a later deadline */
+        executor_wake(ex);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_executor_cancel_timer(esp_executor_handle_t ex, esp_executor_timer_t timer_id)
+{
+    ESP_RETURN_ON_FALSE(ex, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    executor_timer_t *timer = NULL;
+    xSemaphoreTake(ex->lock, portMAX_DELAY);
+    for (executor_timer_t **prev = &ex->timers; *prev; prev = &(*prev)->next) {
+        if ((*prev)->id == timer_id) {
+            timer = *prev;
+            *prev = timer->next;
+            break;
+        }
+    }
+    xSemaphoreGive(ex->lock);
+    if (timer == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    free(timer);
+    return ESP_OK;
+}
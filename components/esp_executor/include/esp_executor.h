@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Executor handle
+ */
+typedef struct esp_executor *esp_executor_handle_t;
+
+/**
+ * @brief Identifier of a timer of an executor, never 0
+ */
+typedef uint32_t esp_executor_timer_t;
+
+/**
+ * @brief Callback posted to an executor, or called when a timer of an executor expires
+ *
+ * @param arg Argument given with the callback
+ */
+typedef void (*esp_executor_cb_t)(void *arg);
+
+/**
+ * @brief Callback called when a file descriptor registered to an executor is ready
+ *
+ * @param fd      The file descriptor
+ * @param events  The ready events, ESP_EXECUTOR_FD_READ and/or ESP_EXECUTOR_FD_WRITE
+ * @param arg     Argument given when the file descriptor was registered
+ */
+typedef void (*esp_executor_fd_cb_t)(int fd, uint32_t events, void *arg);
+
+#define ESP_EXECUTOR_FD_READ    (1 << 0)    /*!< The file descriptor can be read without blocking */
+#define ESP_EXECUTOR_FD_WRITE   (1 << 1)    /*!< The file descriptor can be written without blocking */
+
+/**
+ * @brief Executor configuration
+ */
+typedef struct {
+    size_t max_fds;             /*!< Max number of file descriptors registered at the same time */
+    size_t queue_size;          /*!< Max number of posted callbacks waiting to be run */
+    uint32_t stack_size;        /*!< Stack size of the executor task, in bytes */
+    UBaseType_t priority;       /*!< Priority of the executor task */
+    BaseType_t core_id;         /*!< Core to which the executor task is pinned, or tskNO_AFFINITY */
+} esp_executor_config_t;
+
+/**
+ * @brief Default executor configuration
+ */
+#define ESP_EXECUTOR_DEFAULT_CONFIG() { \
+    .max_fds = 8,                       \
+    .queue_size = 16,                   \
+    .stack_size = 4096,                 \
+    .priority = 5,                      \
+    .core_id = tskNO_AFFINITY,          \
+}
+
+/**
+ * @brief Create an executor
+ *
+ * An executor runs the callbacks of many logical flows on a single task: callbacks called when file descriptors
+ * are ready (sockets, UART, eventfd, etc.), callbacks called when timers expire, and callbacks posted from other
+ * tasks or from ISRs, e.g. from the completion callbacks of drivers. The callbacks must not block.
+ *
+ * @note The eventfd VFS must have been registered with esp_vfs_eventfd_register(), one eventfd is used per executor.
+ *       CONFIG_VFS_SUPPORT_SELECT must be enabled.
+ *
+ * @param[in]  config  Executor configuration
+ * @param[out] ret_ex  Handle of the created executor
+ *
+ * @return
+ *      - ESP_OK: Executor created
+ *      - ESP_ERR_INVALID_ARG: Invalid configuration
+ *      - ESP_ERR_NO_MEM: Out of memory
+ *      - ESP_FAIL: The eventfd could not be created
+ */
+esp_err_t esp_executor_create(const esp_executor_config_t *config, esp_executor_handle_t *ret_ex);
+
+/**
+ * @brief Delete an executor
+ *
+ * The callbacks posted and the timers not run yet are discarded. The registered file descriptors are not closed.
+ *
+ * @note Must not be called from a callback of the executor
+ *
+ * @param[in] ex  Executor handle
+ *
+ * @return
+ *      - ESP_OK: Executor deleted
+ *      - ESP_ERR_INVALID_ARG: Invalid handle
+ */
+esp_err_t esp_executor_delete(esp_executor_handle_t ex);
+
+/**
+ * @brief Register a file descriptor to an executor
+ *
+ * The callback is called by the executor task as long as the file descriptor is ready for one of the given events.
+ * Registering a file descriptor again replaces its events, callback and argument.
+ *
+ * @note The file descriptor must support select(), and must be removed from the executor before being closed
+ *
+ * @param[in] ex      Executor handle
+ * @param[in] fd      File descriptor
+ * @param[in] events  Events to wait for, ESP_EXECUTOR_FD_READ and/or ESP_EXECUTOR_FD_WRITE
+ * @param[in] cb      Callback
+ * @param[in] arg     Argument of the callback
+ *
+ * @return
+ *      - ESP_OK: File descriptor registered
+ *      - ESP_ERR_INVALID_ARG: Invalid arguments
+ *      - ESP_ERR_NO_MEM: max_fds file descriptors are registered already
+ */
+esp_err_t esp_executor_add_fd(esp_executor_handle_t ex, int fd, uint32_t events, esp_executor_fd_cb_t cb, void *arg);
+
+/**
+ * @brief Remove a file descriptor from an executor
+ *
+ * @note When called from another task, the callback of the file descriptor may still be running when this function returns
+ *
+ * @param[in] ex  Executor handle
+ * @param[in] fd  File descriptor
+ *
+ * @return
+ *      - ESP_OK: File descriptor removed
+ *      - ESP_ERR_INVALID_ARG: Invalid handle
+ *      - ESP_ERR_NOT_FOUND: The file descriptor is not registered
+ */
+esp_err_t esp_executor_remove_fd(esp_executor_handle_t ex, int fd);
+
+/**
+ * @brief Post a callback to be run by the executor task
+ *
+ * @param[in] ex   Executor handle
+ * @param[in] cb   Callback
+ * @param[in] arg  Argument of the callback
+ *
+ * @return
+ *      - ESP_OK: Callback posted
+ *      - ESP_ERR_INVALID_ARG: Invalid arguments
+ *      - ESP_ERR_NO_MEM: queue_size callbacks are waiting to be run already
+ */
+esp_err_t esp_executor_post(esp_executor_handle_t ex, esp_executor_cb_t cb, void *arg);
+
+/**
+ * @brief Post a callback to be run by the executor task, from an ISR
+ *
+ * Same as esp_executor_post(), to be called from an ISR.
+ *
+ * @param[in] ex   Executor handle
+ * @param[in] cb   Callback
+ * @param[in] arg  Argument of the callback
+ *
+ * @return
+ *      - ESP_OK: Callback posted
+ *      - ESP_ERR_INVALID_ARG: Invalid arguments
+ *      - ESP_ERR_NO_MEM: queue_size callbacks are waiting to be run already
+ */
+esp_err_t esp_executor_post_from_isr(esp_executor_handle_t ex, esp_executor_cb_t cb, void *arg);
+
+/**
+ * @brief Call a callback from the executor task once a delay has elapsed
+ *
+ * @param[in]  ex         Executor handle
+ * @param[in]  delay_us   Delay, in microseconds
+ * @param[in]  cb         Callback
+ * @param[in]  arg        Argument of the callback
+ * @param[out] ret_timer  Identifier of the timer, to cancel it. Can be NULL.
+ *
+ * @return
+ *      - ESP_OK: Timer started
+ *      - ESP_ERR_INVALID_ARG: Invalid arguments
+ *      - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t esp_executor_call_after(esp_executor_handle_t ex, uint64_t delay_us, esp_executor_cb_t cb, void *arg,
+                                  esp_executor_timer_t *ret_timer);
+
+/**
+ * @brief Cancel a timer of an executor
+ *
+ * @param[in] ex     Executor handle
+ * @param[in] timer  Identifier of the timer
+ *
+ * @return
+ *      - ESP_OK: Timer cancelled, its callback will not be called
+ *      - ESP_ERR_INVALID_ARG: Invalid handle
+ *      - ESP_ERR_NOT_FOUND: The timer has expired already or has been cancelled
+ */
+esp_err_t esp_executor_cancel_timer(esp_executor_handle_t ex, esp_executor_timer_t timer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_vfs_eventfd.h"
+#include "unity.h"
+#include "esp_executor.h"
+
+#define TEST_CALLS_MAX  8
+
+static int s_calls[TEST_CALLS_MAX];
+static int s_calls_num;
+static SemaphoreHandle_t s_done;
+
+static void record_cb(void *arg)
+{
+    if (s_calls_num < TEST_CALLS_MAX) {
+        s_calls[s_calls_num++] = (int)arg;
+    }
+}
+
+static void done_cb(void *arg)
+{
+    xSemaphoreGive(s_done);
+}
+
+static void test_setup(esp_executor_handle_t *ex)
+{
+    esp_vfs_eventfd_config_t eventfd_config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_vfs_eventfd_register(&eventfd_config));
+    s_done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(s_done);
+    s_calls_num = 0;
+
+    esp_executor_config_t config = ESP_EXECUTOR_DEFAULT_CONFIG();
+    TEST_ESP_OK(esp_executor_create(&config, ex));
+}
+
+static void test_teardown(esp_executor_handle_t ex)
+{
+    TEST_ESP_OK(esp_executor_delete(ex));
+    vSemaphoreDelete(s_done);
+    TEST_ESP_OK(esp_vfs_eventfd_unregister());
+}
+
+TEST_CASE("executor runs the posted callbacks in order", "[executor]")
+{
+    esp_executor_handle_t ex;
+    test_setup(&ex);
+
+    TEST_ESP_OK(esp_executor_post(ex, record_cb, (void *)1));
+    TEST_ESP_OK(esp_executor_post(ex, record_cb, (void *)2));
+    TEST_ESP_OK(esp_executor_post(ex, record_cb, (void *)3));
+    TEST_ESP_OK(esp_executor_post(ex, done_cb, NULL));
+    TEST_ASSERT_TRUE(xSemaphoreTake(s_done, pdMS_TO_TICKS(1000)));
+
+    TEST_ASSERT_EQUAL(3, s_calls_num);
+    TEST_ASSERT_EQUAL(1, s_calls[0]);
+    TEST_ASSERT_EQUAL(2, s_calls[1]);
+    TEST_ASSERT_EQUAL(3, s_calls[2]);
+
+    test_teardown(ex);
+}
+
+TEST_CASE("executor calls the timers in deadline order", "[executor]")
+{
+    esp_executor_handle_t ex;
+    test_setup(&ex);
+
+    esp_executor_timer_t cancelled;
+    TEST_ESP_OK(esp_executor_call_after(ex, 30000, record_cb, (void *)3, NULL));
+    TEST_ESP_OK(esp_executor_call_after(ex, 10000, record_cb, (void *)1, NULL));
+    TEST_ESP_OK(esp_executor_call_after(ex, 20000, record_cb, (void *)2, &cancelled));
+    TEST_ESP_OK(esp_executor_call_after(ex, 40000, done_cb, NULL, NULL));
+    TEST_ESP_OK(esp_executor_cancel_timer(ex, cancelled));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_executor_cancel_timer(ex, cancelled));
+    TEST_ASSERT_TRUE(xSemaphoreTake(s_done, pdMS_TO_TICKS(1000)));
+
+    TEST_ASSERT_EQUAL(2, s_calls_num);
+    TEST_ASSERT_EQUAL(1, s_calls[0]);
+    TEST_ASSERT_EQUAL(3, s_calls[1]);
+
+    test_teardown(ex);
+}
+
+static void read_fd_cb(int fd, uint32_t events, void *arg)
+{
+    uint64_t value;
+    TEST_ASSERT_EQUAL(ESP_EXECUTOR_FD_READ, events);
+    TEST_ASSERT_EQUAL(sizeof(value), read(fd, &value, sizeof(value)));
+    record_cb((void *)(int)value);
+    xSemaphoreGive(s_done);
+}
+
+TEST_CASE("executor calls the callback of a readable file descriptor", "[executor]")
+{
+    esp_executor_handle_t ex;
+    test_setup(&ex);
+
+    int fd = eventfd(0, 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+    TEST_ESP_OK(esp_executor_add_fd(ex, fd, ESP_EXECUTOR_FD_READ, read_fd_cb, NULL));
+
+    uint64_t value = 42;
+    TEST_ASSERT_EQUAL(sizeof(value), write(fd, &value, sizeof(value)));
+    TEST_ASSERT_TRUE(xSemaphoreTake(s_done, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_EQUAL(1, s_calls_num);
+    TEST_ASSERT_EQUAL(42, s_calls[0]);
+
+    TEST_ESP_OK(esp_executor_remove_fd(ex, fd));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_executor_remove_fd(ex, fd));
+    close(fd);
+
+    test_teardown(ex);
+}
@@ -18,6 +18,7 @@
 #include "esp_transport_ssl.h"
 #include "http_utils.h"
 #include "http_auth.h"
+#include "http_conn_pool.h"
 #include "sdkconfig.h"
 #include "esp_http_client.h"
 #include "errno.h"
@@ -120,8 +121,13 @@ struct esp_http_client {
     char                        *post_data;
     char                        *location;
     char                        *auth_header;
-    char                        *current_header_key;
-    char                        *current_header_value;
+    char                        *header_buf;            /*!< key and value of the response header being parsed, reused for all the headers */
+    size_t                      header_buf_size;
+    size_t                      header_key_len;
+    size_t                      header_value_len;
+    bool                        header_on_value;        /*!< the value of the header is being parsed */
+    bool                        header_wanted;          /*!< the header is dispatched in HTTP_EVENT_ON_HEADER */
+    const char *const           *header_filter;
     int                         post_len;
     connection_info_t           connection_info;
     bool                        is_chunk_complete;
@@ -140,9 +146,17 @@ struct esp_http_client {
     esp_transport_keep_alive_t  keep_alive_cfg;
     struct ifreq                *if_name;
     unsigned                    cache_data_in_fetch_hdr: 1;
+    unsigned                    pipelining: 1;              /*!< esp_http_client_perform_pipelined() is in progress */
+    unsigned                    pipeline_msg_complete: 1;   /*!< the response being read by esp_http_client_perform_pipelined() is complete */
+    int                         pipeline_pending_len;       /*!< received bytes of the next pipelined responses, kept at the start of the rx buffer */
+    int                         max_pipelined_requests;
 #ifdef CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
     session_ticket_state_t      session_ticket_state;
 #endif
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    bool                        use_connection_pool;
+    esp_transport_list_handle_t pooled_transport_list;  /*!< transport list of the connection taken from the pool, if any */
+#endif
 };
 
 typedef struct esp_http_client esp_http_client_t;
@@ -153,6 +167,8 @@ static esp_err_t _clear_connection_info(esp_http_client_handle_t client);
  */
 #define DEFAULT_HTTP_PORT (80)
 #define DEFAULT_HTTPS_PORT (443)
+#define DEFAULT_MAX_PIPELINED_REQUESTS (4)
+#define DEFAULT_HEADER_BUF_SIZE (128)
 
 #define ASYNC_TRANS_CONNECT_FAIL -1
 #define ASYNC_TRANS_CONNECTING 0
@@ -222,6 +238,9 @@ static int http_on_message_begin(http_parser *parser)
 
     client->response->is_chunked = false;
     client->is_chunk_complete = false;
+    client->header_key_len = 0;
+    client->header_value_len = 0;
+    client->header_on_value = false;
     return 0;
 }
 
@@ -238,25 +257,63 @@ static int http_on_status(http_parser *parser, const char *at, size_t length)
 
 static int http_on_header_event(esp_http_client_handle_t client)
 {
-    if (client->current_header_key != NULL && client->current_header_value != NULL) {
-        ESP_LOGD(TAG, "HEADER=%s:%s", client->current_header_key, client->current_header_value);
-        client->event.header_key = client->current_header_key;
-        client->event.header_value = client->current_header_value;
+    if (client->header_on_value && client->header_wanted) {
+        char *key = client->header_buf;
+        char *value = client->header_buf + client->header_key_len + 1;
+        ESP_LOGD(TAG, "HEADER=%s:%s", key, value);
+        client->event.header_key = key;
+        client->event.header_value = value;
         http_dispatch_event(client, HTTP_EVENT_ON_HEADER, NULL, 0);
         http_dispatch_event_to_event_loop(HTTP_EVENT_ON_HEADER, &client, sizeof(esp_http_client_handle_t));
-        free(client->current_header_key);
-        free(client->current_header_value);
-        client->current_header_key = NULL;
-        client->current_header_value = NULL;
+        client->event.header_key = NULL;
+        client->event.header_value = NULL;
     }
+    client->header_key_len = 0;
+    client->header_value_len = 0;
+    client->header_on_value = false;
     return 0;
 }
 
+/* Append @p length bytes to the header buffer at @p offset, the buffer is only grown when a header larger than all the previous ones is received */
+static esp_err_t http_header_buf_append(esp_http_client_handle_t client, size_t offset, const char *at, size_t length)
+{
+    size_t needed = offset + length + 1;
+    if (needed > client->header_buf_size) {
+        size_t size = client->header_buf_size ? client->header_buf_size : DEFAULT_HEADER_BUF_SIZE;
+        while (size < needed) {
+            size *= 2;
+        }
+        char *buf = realloc(client->header_buf, size);
+        ESP_RETURN_ON_FALSE(buf, ESP_ERR_NO_MEM, TAG, "Memory exhausted");
+        client->header_buf = buf;
+        client->header_buf_size = size;
+    }
+    memcpy(client->header_buf + offset, at, length);
+    client->header_buf[offset + length] = 0;
+    return ESP_OK;
+}
+
+static bool http_header_is_wanted(esp_http_client_handle_t client, const char *key)
+{
+    if (client->header_filter == NULL) {
+        return true;
+    }
+    for (const char *const *filter = client->header_filter; *filter; filter++) {
+        if (strcasecmp(*filter, key) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static int http_on_header_field(http_parser *parser, const char *at, size_t length)
 {
     esp_http_client_t *client = parser->data;
-    http_on_header_event(client);
-    HTTP_RET_ON_FALSE_DBG(http_utils_append_string(&client->current_header_key, at, length), -1, TAG, "Failed to append string");
+    if (client->header_on_value) {
+        http_on_header_event(client);
+    }
+    HTTP_RET_ON_FALSE_DBG(http_header_buf_append(client, client->header_key_len, at, length) == ESP_OK, -1, TAG, "Failed to append string");
+    client->header_key_len += length;
 
     return 0;
 }
@@ -264,18 +321,28 @@ static int http_on_header_field(http_parser *parser, const char *at, size_t leng
 static int http_on_header_value(http_parser *parser, const char *at, size_t length)
 {
     esp_http_client_handle_t client = parser->data;
-    if (client->current_header_key == NULL) {
+    if (client->header_key_len == 0) {
         return 0;
     }
-    if (strcasecmp(client->current_header_key, "Location") == 0) {
+    const char *key = client->header_buf;
+    if (!client->header_on_value) {
+        client->header_on_value = true;
+        client->header_wanted = http_header_is_wanted(client, key);
+    }
+    if (strcasecmp(key, "Location") == 0) {
         HTTP_RET_ON_FALSE_DBG(http_utils_append_string(&client->location, at, length), -1, TAG, "Failed to append string");
-    } else if (strcasecmp(client->current_header_key, "Transfer-Encoding") == 0
+    } else if (strcasecmp(key, "Transfer-Encoding") == 0
                && memcmp(at, "chunked", length) == 0) {
         client->response->is_chunked = true;
-    } else if (strcasecmp(client->current_header_key, "WWW-Authenticate") == 0) {
+    } else if (strcasecmp(key, "WWW-Authenticate") == 0) {
         HTTP_RET_ON_FALSE_DBG(http_utils_append_string(&client->auth_header, at, length), -1, TAG, "Failed to append string");
     }
-    HTTP_RET_ON_FALSE_DBG(http_utils_append_string(&client->current_header_value, at, length), -1, TAG, "Failed to append string");
+    if (client->header_wanted) {
+        /* The value is stored right after the NUL terminated key */
+        HTTP_RET_ON_FALSE_DBG(http_header_buf_append(client, client->header_key_len + 1 + client->header_value_len, at, length) == ESP_OK,
+                              -1, TAG, "Failed to append string");
+        client->header_value_len += length;
+    }
     return 0;
 }
 
@@ -338,6 +405,11 @@ static int http_on_message_complete(http_parser *parser)
     ESP_LOGD(TAG, "http_on_message_complete, parser=%p", parser);
     esp_http_client_handle_t client = parser->data;
     client->is_chunk_complete = true;
+    if (client->pipelining) {
+        /* Stop parsing at the end of the response, the next bytes belong to the next pipelined response */
+        client->pipeline_msg_complete = true;
+        http_parser_pause(parser, 1);
+    }
     return 0;
 }
 
@@ -507,6 +579,8 @@ static esp_err_t _set_config(esp_http_client_handle_t client, const esp_http_cli
     client->buffer_size_rx = config->buffer_size;
     client->buffer_size_tx = config->buffer_size_tx;
     client->disable_auto_redirect = config->disable_auto_redirect;
+    client->max_pipelined_requests = config->max_pipelined_requests;
+    client->header_filter = config->response_header_filter;
 
     if (config->buffer_size == 0) {
         client->buffer_size_rx = DEFAULT_HTTP_BUF_SIZE;
@@ -520,6 +594,10 @@ static esp_err_t _set_config(esp_http_client_handle_t client, const esp_http_cli
         client->max_redirection_count = DEFAULT_MAX_REDIRECT;
     }
 
+    if (client->max_pipelined_requests <= 0) {
+        client->max_pipelined_requests = DEFAULT_MAX_PIPELINED_REQUESTS;
+    }
+
     if (client->max_authorization_retries == 0) {
         client->max_authorization_retries = DEFAULT_MAX_AUTH_RETRIES;
     } else if (client->max_authorization_retries == -1) {
@@ -895,6 +973,11 @@ esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *co
         ESP_LOGE(TAG, "Error set configurations");
         goto error;
     }
+
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    /* The pooled connections are blocking ones, made over the transports created by the client */
+    client->use_connection_pool = config->use_connection_pool && !config->is_async && !client->transport;
+#endif
     _success = (
                    (client->request->buffer->data  = malloc(client->buffer_size_tx))  &&
                    (client->response->buffer->data = malloc(client->buffer_size_rx))
@@ -996,12 +1079,87 @@ static void esp_http_client_cached_buf_cleanup(esp_http_buffer_t *res_buffer)
     }
 }
 
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+/**
+ * Take an idle connection to the server from the pool, instead of connecting the transport of the client.
+ * The transport list of the connection is kept aside of the one of the client, so that the client never
+ * reconnects over a transport configured by another client.
+ */
+static bool http_client_take_pooled_connection(esp_http_client_handle_t client)
+{
+    esp_transport_handle_t transport = NULL;
+    esp_transport_list_handle_t list = http_conn_pool_get(client->connection_info.scheme, client->connection_info.host,
+                                                          client->connection_info.port, &transport);
+    if (list == NULL) {
+        return false;
+    }
+    client->pooled_transport_list = list;
+    client->transport = transport;
+    return true;
+}
+
+/**
+ * Give the connection of the client back to the pool, if no request is in progress on it.
+ * @p own allows to give away the transport list of the client, only when it is cleaned up.
+ */
+static bool http_client_return_pooled_connection(esp_http_client_handle_t client, bool own)
+{
+    esp_transport_list_handle_t list = client->pooled_transport_list;
+
+    if (list == NULL) {
+        if (!own || !client->use_connection_pool) {
+            return false;
+        }
+        list = client->transport_list;
+    }
+    if (client->state < HTTP_STATE_CONNECTED ||
+            client->transport != esp_transport_list_get_transport(list, client->connection_info.scheme)) {
+        return false;
+    }
+    if (client->state > HTTP_STATE_CONNECTED) {
+        bool idle = client->state >= HTTP_STATE_RES_ON_DATA_START &&
+                    esp_http_client_is_complete_data_received(client) && http_should_keep_alive(client->parser);
+        if (!idle) {
+            return false;
+        }
+    }
+
+    http_conn_pool_put(client->connection_info.scheme, client->connection_info.host, client->connection_info.port,
+                       list, client->transport);
+    if (list == client->pooled_transport_list) {
+        client->pooled_transport_list = NULL;
+        client->transport = esp_transport_list_get_transport(client->transport_list, client->connection_info.scheme);
+    } else {
+        client->transport_list = NULL;
+        client->transport = NULL;
+    }
+    client->state = HTTP_STATE_INIT;
+    return true;
+}
+
+/**
+ * Close the connection taken from the pool, the client then connects over its own transport again
+ */
+static void http_client_close_pooled_connection(esp_http_client_handle_t client)
+{
+    esp_transport_close(client->transport);
+    esp_transport_list_destroy(client->pooled_transport_list);
+    client->pooled_transport_list = NULL;
+    client->transport = esp_transport_list_get_transport(client->transport_list, client->connection_info.scheme);
+}
+#endif /* CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL */
+
 esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
 {
     if (client == NULL) {
         return ESP_FAIL;
     }
-    esp_http_client_close(client);
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    if (!http_client_return_pooled_connection(client, true))
+#endif
+    {
+        esp_http_client_close(client);
+    }
     if (client->transport_list) {
         esp_transport_list_destroy(client->transport_list);
     }
@@ -1030,13 +1188,23 @@ esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
     _clear_connection_info(client);
     _clear_auth_data(client);
     free(client->auth_data);
-    free(client->current_header_key);
+    free(client->header_buf);
     free(client->location);
     free(client->auth_header);
     free(client);
     return ESP_OK;
 }
 
+esp_err_t esp_http_client_flush_connection_pool(void)
+{
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    http_conn_pool_flush();
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 esp_err_t esp_http_client_set_redirection(esp_http_client_handle_t client)
 {
     if (client == NULL) {
@@ -1465,6 +1633,13 @@ esp_err_t esp_http_client_perform(esp_http_client_handle_t client)
                     ESP_LOGD(TAG, "Close connection");
                     esp_http_client_close(client);
                 } else {
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+                    /* let the other clients use the pooled connection until the next request of this one */
+                    if (http_client_return_pooled_connection(client, false)) {
+                        client->first_line_prepared = false;
+                        break;
+                    }
+#endif
                     if (client->state > HTTP_STATE_CONNECTED) {
                         client->state = HTTP_STATE_CONNECTED;
                         client->first_line_prepared = false;
@@ -1478,6 +1653,151 @@ esp_err_t esp_http_client_perform(esp_http_client_handle_t client)
     return ESP_OK;
 }
 
+static esp_err_t http_client_pipeline_send(esp_http_client_handle_t client, const esp_http_client_pipeline_request_t *request)
+{
+    esp_err_t err;
+
+    client->connection_info.method = request->method;
+    client->post_data = (char *)request->post_data;
+    client->post_len = request->post_data ? request->post_len : 0;
+    client->state = HTTP_STATE_CONNECTED;
+    client->first_line_prepared = false;
+    if ((err = esp_http_client_request_send(client, client->post_len)) != ESP_OK) {
+        return err;
+    }
+    return esp_http_client_send_post_data(client);
+}
+
+static esp_err_t http_client_pipeline_read(esp_http_client_handle_t client, const esp_http_client_pipeline_request_t *request)
+{
+    esp_http_buffer_t *buffer = client->response->buffer;
+
+    /* The HEAD responses have no body, see http_on_headers_complete() */
+    client->connection_info.method = request->method;
+    free(client->location);
+    client->location = NULL;
+    free(client->auth_header);
+    client->auth_header = NULL;
+    http_parser_init(client->parser, HTTP_RESPONSE);
+    client->response->status_code = -1;
+    client->response->data_process = 0;
+    client->pipeline_msg_complete = false;
+    client->state = HTTP_STATE_REQ_COMPLETE_DATA;
+
+    while (!client->pipeline_msg_complete) {
+        int len = client->pipeline_pending_len;
+
+        if (len > 0) {
+            client->pipeline_pending_len = 0;
+        } else {
+            len = esp_transport_read(client->transport, buffer->data, client->buffer_size_rx, client->timeout_ms);
+            if (len <= 0) {
+                if (client->state >= HTTP_STATE_RES_COMPLETE_HEADER) {
+                    /* The body of the response may end with the connection */
+                    http_parser_execute(client->parser, client->parser_settings, NULL, 0);
+                    if (client->pipeline_msg_complete) {
+                        break;
+                    }
+                }
+                ESP_LOGE(TAG, "Failed to read the pipelined response");
+                return ESP_ERR_HTTP_FETCH_HEADER;
+            }
+        }
+
+        size_t parsed = http_parser_execute(client->parser, client->parser_settings, buffer->data, len);
+        if (HTTP_PARSER_ERRNO(client->parser) == HPE_PAUSED) {
+            client->pipeline_pending_len = len - parsed;
+            memmove(buffer->data, buffer->data + parsed, client->pipeline_pending_len);
+        } else if (parsed != (size_t)len) {
+            ESP_LOGE(TAG, "Failed to parse the pipelined response: %s", http_errno_name(HTTP_PARSER_ERRNO(client->parser)));
+            return ESP_FAIL;
+        }
+    }
+
+    client->state = HTTP_STATE_RES_COMPLETE_DATA;
+    http_dispatch_event(client, HTTP_EVENT_ON_FINISH, NULL, 0);
+    http_dispatch_event_to_event_loop(HTTP_EVENT_ON_FINISH, &client, sizeof(esp_http_client_handle_t));
+    client->response->buffer->raw_len = 0;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_perform_pipelined(esp_http_client_handle_t client, const esp_http_client_pipeline_request_t *requests, size_t count)
+{
+    ESP_RETURN_ON_FALSE(client && requests && count, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!client->is_async, ESP_ERR_NOT_SUPPORTED, TAG, "Pipelining is not supported in asynchronous mode");
+    ESP_RETURN_ON_FALSE(client->state == HTTP_STATE_INIT || client->state == HTTP_STATE_CONNECTED, ESP_ERR_INVALID_STATE,
+                        TAG, "A request is in progress");
+
+    /* The requests are sent with the path, method and body given for each of them, the ones of the client are restored at the end */
+    char *path = client->connection_info.path;
+    char *query = client->connection_info.query;
+    esp_http_client_method_t method = client->connection_info.method;
+    char *post_data = client->post_data;
+    int post_len = client->post_len;
+    esp_err_t err = ESP_OK;
+    size_t sent = 0;
+    size_t received = 0;
+
+    while (received < count) {
+        if (client->state < HTTP_STATE_CONNECTED) {
+            client->connection_info.path = path;
+            client->connection_info.query = query;
+            if ((err = esp_http_client_connect(client)) != ESP_OK) {
+                break;
+            }
+            /* The requests which have not been answered before the connection was closed are sent again */
+            sent = received;
+            client->pipeline_pending_len = 0;
+        }
+
+        client->pipelining = true;
+        client->cache_data_in_fetch_hdr = 0;
+        while (sent < count && sent - received < (size_t)client->max_pipelined_requests) {
+            client->connection_info.path = requests[sent].path ? (char *)requests[sent].path : path;
+            client->connection_info.query = requests[sent].path ? NULL : query;
+            if ((err = http_client_pipeline_send(client, &requests[sent])) != ESP_OK) {
+                break;
+            }
+            sent++;
+        }
+        if (err == ESP_OK) {
+            err = http_client_pipeline_read(client, &requests[received]);
+        }
+        client->pipelining = false;
+        client->cache_data_in_fetch_hdr = 1;
+        if (err != ESP_OK) {
+            break;
+        }
+        received++;
+
+        if (!http_should_keep_alive(client->parser)) {
+            ESP_LOGD(TAG, "Close connection");
+            esp_http_client_close(client);
+        }
+    }
+
+    client->connection_info.path = path;
+    client->connection_info.query = query;
+    client->connection_info.method = method;
+    client->post_data = post_data;
+    client->post_len = post_len;
+
+    if (err != ESP_OK) {
+        http_dispatch_event(client, HTTP_EVENT_ERROR, esp_transport_get_error_handle(client->transport), 0);
+        http_dispatch_event_to_event_loop(HTTP_EVENT_ERROR, &client, sizeof(esp_http_client_handle_t));
+        esp_http_client_close(client);
+        return err;
+    }
+    if (client->state > HTTP_STATE_CONNECTED) {
+        client->state = HTTP_STATE_CONNECTED;
+        client->first_line_prepared = false;
+    }
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    http_client_return_pooled_connection(client, false);
+#endif
+    return ESP_OK;
+}
+
 int64_t esp_http_client_fetch_headers(esp_http_client_handle_t client)
 {
     if (client->state < HTTP_STATE_REQ_COMPLETE_HEADER) {
@@ -1525,6 +1845,15 @@ static esp_err_t esp_http_client_connect(esp_http_client_handle_t client)
     }
 
     if (client->state < HTTP_STATE_CONNECTED) {
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+        if (client->use_connection_pool && http_client_take_pooled_connection(client)) {
+            ESP_LOGD(TAG, "Reuse pooled connection to: %s://%s:%d", client->connection_info.scheme, client->connection_info.host, client->connection_info.port);
+            client->state = HTTP_STATE_CONNECTED;
+            http_dispatch_event(client, HTTP_EVENT_ON_CONNECTED, NULL, 0);
+            http_dispatch_event_to_event_loop(HTTP_EVENT_ON_CONNECTED, &client, sizeof(esp_http_client_handle_t));
+            return ESP_OK;
+        }
+#endif
 #ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CUSTOM_TRANSPORT
         // If the custom transport is enabled and defined, we skip the selection of appropriate transport from the list
         // based on the scheme, since we already have the transport
@@ -1760,6 +2089,12 @@ esp_err_t esp_http_client_close(esp_http_client_handle_t client)
         http_dispatch_event(client, HTTP_EVENT_DISCONNECTED, esp_transport_get_error_handle(client->transport), 0);
         http_dispatch_event_to_event_loop(HTTP_EVENT_DISCONNECTED, &client, sizeof(esp_http_client_handle_t));
         client->state = HTTP_STATE_INIT;
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+        if (client->pooled_transport_list) {
+            http_client_close_pooled_connection(client);
+            return ESP_OK;
+        }
+#endif
         return esp_transport_close(client->transport);
     }
     return ESP_OK;
@@ -54,8 +54,8 @@ typedef struct esp_http_client_event {
     void *data;                             /*!< data of the event */
     int data_len;                           /*!< data length of data */
     void *user_data;                        /*!< user_data context, from esp_http_client_config_t user_data */
-    char *header_key;                       /*!< For HTTP_EVENT_ON_HEADER event_id, it's store current http header key */
-    char *header_value;                     /*!< For HTTP_EVENT_ON_HEADER event_id, it's store current http header value */
+    char *header_key;                       /*!< For HTTP_EVENT_ON_HEADER event_id, it's store current http header key, only valid during the event */
+    char *header_value;                     /*!< For HTTP_EVENT_ON_HEADER event_id, it's store current http header value, only valid during the event */
 } esp_http_client_event_t;
 
 /**
@@ -202,10 +202,29 @@ typedef struct {
 #endif
 #if CONFIG_ESP_HTTP_CLIENT_ENABLE_CUSTOM_TRANSPORT
     struct esp_transport_item_t *transport;
+#endif
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    bool use_connection_pool;               /*!< Reuse the idle connections of the connection pool and give the connection back to the pool when idle,
+                                                 see `esp_http_client_flush_connection_pool`. Not supported with `is_async` and custom transports.
+                                                 All the clients using the pool for a given server should have the same TLS configuration */
 #endif
     esp_http_client_addr_type_t addr_type;  /*!< Address type used in http client configurations */
+    int                         max_pipelined_requests; /*!< Max number of requests sent ahead of their responses by `esp_http_client_perform_pipelined`, using default value (4) if zero */
+    const char *const           *response_header_filter; /*!< NULL terminated list of the response headers for which HTTP_EVENT_ON_HEADER is dispatched, compared case-insensitively.
+                                                          The other headers are parsed without being stored. If NULL, the event is dispatched for all the headers.
+                                                          The list is not copied and must stay valid during the lifetime of the client */
 } esp_http_client_config_t;
 
+/**
+ * @brief HTTP request of `esp_http_client_perform_pipelined`
+ */
+typedef struct {
+    esp_http_client_method_t    method;         /*!< HTTP Method */
+    const char                  *path;          /*!< HTTP Path, including the query if any. If NULL, the path and query of the client are used */
+    const char                  *post_data;     /*!< Request body, NULL if none */
+    int                         post_len;       /*!< Length of the request body */
+} esp_http_client_pipeline_request_t;
+
 /**
  * Enum for the HTTP status codes.
  */
@@ -284,6 +303,30 @@ esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *co
  */
 esp_err_t esp_http_client_perform(esp_http_client_handle_t client);
 
+/**
+ * @brief      Invoke several requests to the server of the client over one connection, using HTTP/1.1 pipelining:
+ *             up to `max_pipelined_requests` requests are sent before reading their responses, which saves a round trip per request.
+ *             The responses are delivered in the order of the requests, through the events of each of them,
+ *             `HTTP_EVENT_ON_FINISH` marks the end of each response.
+ *
+ * @note       Only the requests which are safe to be sent again, e.g. idempotent ones, should be pipelined:
+ *             when the server closes the connection, the requests it has not answered are sent again over a new connection.
+ * @note       Redirections and authentication are not handled, the responses are delivered as they are received.
+ * @note       The method, path and post field of the client are restored when the function returns.
+ *
+ * @param[in]  client    The esp_http_client handle
+ * @param[in]  requests  The requests to send
+ * @param[in]  count     The number of requests
+ *
+ * @return
+ *     - ESP_OK on successful
+ *     - ESP_ERR_INVALID_ARG if the arguments are invalid
+ *     - ESP_ERR_NOT_SUPPORTED if the client is in the asynchronous mode
+ *     - ESP_ERR_INVALID_STATE if a request is in progress
+ *     - other error codes, if the connection or a request failed
+ */
+esp_err_t esp_http_client_perform_pipelined(esp_http_client_handle_t client, const esp_http_client_pipeline_request_t *requests, size_t count);
+
 /**
  * @brief       Cancel an ongoing HTTP request. This API closes the current socket and opens a new socket with the same esp_http_client context.
  *
@@ -643,6 +686,18 @@ esp_err_t esp_http_client_close(esp_http_client_handle_t client);
  */
 esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client);
 
+/**
+ * @brief      Close all the idle connections kept in the connection pool.
+ *             The connections are kept in the pool by the clients with `use_connection_pool` set, when they are cleaned up
+ *             or when they complete a request over a connection taken from the pool. This function can be called
+ *             e.g. when the network goes down, or to release the memory held by the idle connections.
+ *
+ * @return
+ *     - ESP_OK
+ *     - ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL is disabled
+ */
+esp_err_t esp_http_client_flush_connection_pool(void);
+
 /**
  * @brief      Get transport type
  *
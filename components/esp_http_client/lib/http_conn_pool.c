@@ -0,0 +1,204 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "http_conn_pool.h"
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+
+static const char *TAG = "HTTP_CONN_POOL";
+
+#define POOL_SIZE           CONFIG_ESP_HTTP_CLIENT_CONNECTION_POOL_SIZE
+#define POOL_MAX_PER_HOST   CONFIG_ESP_HTTP_CLIENT_CONNECTION_POOL_MAX_PER_HOST
+#define POOL_IDLE_TIMEOUT   pdMS_TO_TICKS(CONFIG_ESP_HTTP_CLIENT_CONNECTION_POOL_IDLE_TIMEOUT * 1000)
+
+/**
+ * Idle connection, the slot is free when list is NULL
+ */
+typedef struct {
+    char                        *key;           /*!< "scheme://host:port" of the connection */
+    esp_transport_list_handle_t list;           /*!< transport list holding the connected transport */
+    esp_transport_handle_t      transport;      /*!< connected transport */
+    TickType_t                  idle_since;     /*!< time at which the connection has been put into the pool */
+} http_conn_pool_entry_t;
+
+static http_conn_pool_entry_t s_pool[POOL_SIZE];
+/* Only protects the slots, the connections are closed and destroyed out of the critical section */
+static portMUX_TYPE s_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static char *http_conn_pool_key(const char *scheme, const char *host, int port)
+{
+    char *key = NULL;
+    if (asprintf(&key, "%s://%s:%d", scheme, host, port) < 0) {
+        return NULL;
+    }
+    return key;
+}
+
+static void http_conn_pool_entry_destroy(http_conn_pool_entry_t *entry)
+{
+    ESP_LOGD(TAG, "Close connection to %s", entry->key);
+    esp_transport_close(entry->transport);
+    esp_transport_list_destroy(entry->list);
+    free(entry->key);
+}
+
+/* Move the expired entries to @p expired, must be called in the critical section */
+static int http_conn_pool_take_expired(http_conn_pool_entry_t *expired, TickType_t now)
+{
+    int count = 0;
+    for (int i = 0; i < POOL_SIZE; i++) {
+        if (s_pool[i].list && now - s_pool[i].idle_since >= POOL_IDLE_TIMEOUT) {
+            expired[count++] = s_pool[i];
+            s_pool[i].list = NULL;
+        }
+    }
+    return count;
+}
+
+static bool http_conn_pool_is_alive(esp_transport_handle_t transport)
+{
+    if (esp_transport_get_socket(transport) < 0) {
+        return false;
+    }
+    /* An idle connection has nothing to read: data, FIN or TLS alert mean that it cannot be used for a new request */
+    return esp_transport_poll_read(transport, 0) == 0;
+}
+
+esp_transport_list_handle_t http_conn_pool_get(const char *scheme, const char *host, int port, esp_transport_handle_t *transport)
+{
+    http_conn_pool_entry_t expired[POOL_SIZE];
+    int expired_count;
+    char *key = http_conn_pool_key(scheme, host, port);
+    if (key == NULL) {
+        return NULL;
+    }
+
+    while (true) {
+        http_conn_pool_entry_t found = { 0 };
+
+        TickType_t now = xTaskGetTickCount();
+        portENTER_CRITICAL(&s_pool_lock);
+        expired_count = http_conn_pool_take_expired(expired, now);
+        /* The most recently used connection is the most likely to be still alive */
+        int best = -1;
+        for (int i = 0; i < POOL_SIZE; i++) {
+            if (s_pool[i].list && strcasecmp(s_pool[i].key, key) == 0 &&
+                    (best < 0 || now - s_pool[i].idle_since < now - s_pool[best].idle_since)) {
+                best = i;
+            }
+        }
+        if (best >= 0) {
+            found = s_pool[best];
+            s_pool[best].list = NULL;
+        }
+        portEXIT_CRITICAL(&s_pool_lock);
+
+        for (int i = 0; i < expired_count; i++) {
+            http_conn_pool_entry_destroy(&expired[i]);
+        }
+        if (found.list == NULL) {
+            break;
+        }
+        if (http_conn_pool_is_alive(found.transport)) {
+            ESP_LOGD(TAG, "Reuse connection to %s", key);
+            free(found.key);
+            free(key);
+            *transport = found.transport;
+            return found.list;
+        }
+        http_conn_pool_entry_destroy(&found);
+    }
+
+    free(key);
+    return NULL;
+}
+
+void http_conn_pool_put(const char *scheme, const char *host, int port, esp_transport_list_handle_t list, esp_transport_handle_t transport)
+{
+    http_conn_pool_entry_t expired[POOL_SIZE];
+    int expired_count;
+    http_conn_pool_entry_t entry = {
+        .key = http_conn_pool_key(scheme, host, port),
+        .list = list,
+        .transport = transport,
+        .idle_since = xTaskGetTickCount(),
+    };
+    http_conn_pool_entry_t evicted = { 0 };
+
+    if (entry.key == NULL) {
+        ESP_LOGE(TAG, "Memory exhausted");
+        esp_transport_close(transport);
+        esp_transport_list_destroy(list);
+        return;
+    }
+
+    portENTER_CRITICAL(&s_pool_lock);
+    expired_count = http_conn_pool_take_expired(expired, entry.idle_since);
+    int free_slot = -1;
+    int oldest = -1;
+    int host_count = 0;
+    for (int i = 0; i < POOL_SIZE; i++) {
+        if (s_pool[i].list == NULL) {
+            free_slot = i;
+            continue;
+        }
+        if (strcasecmp(s_pool[i].key, entry.key) == 0) {
+            host_count++;
+        }
+        if (oldest < 0 || entry.idle_since - s_pool[i].idle_since > entry.idle_since - s_pool[oldest].idle_since) {
+            oldest = i;
+        }
+    }
+    if (host_count >= POOL_MAX_PER_HOST) {
+        /* enough idle connections to this server already */
+        evicted = entry;
+    } else {
+        if (free_slot < 0) {
+            /* the pool is full, make room by closing the connection which has been idle for the longest time */
+            evicted = s_pool[oldest];
+            free_slot = oldest;
+        }
+        s_pool[free_slot] = entry;
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    for (int i = 0; i < expired_count; i++) {
+        http_conn_pool_entry_destroy(&expired[i]);
+    }
+    if (evicted.list) {
+        http_conn_pool_entry_destroy(&evicted);
+    }
+}
+
+void http_conn_pool_flush(void)
+{
+    http_conn_pool_entry_t entries[POOL_SIZE];
+    int count = 0;
+
+    portENTER_CRITICAL(&s_pool_lock);
+    for (int i = 0; i < POOL_SIZE; i++) {
+        if (s_pool[i].list) {
+            entries[count++] = s_pool[i];
+            s_pool[i].list = NULL;
+        }
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    for (int i = 0; i < count; i++) {
+        http_conn_pool_entry_destroy(&entries[i]);
+    }
+}
+
+#endif /* CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL */
@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _HTTP_CONN_POOL_H_
+#define _HTTP_CONN_POOL_H_
+
+#include "esp_err.h"
+#include "esp_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief      Take an idle connection to the given server out of the pool.
+ *             Connections which have been idle for too long, or have been closed by the server, are destroyed on the way.
+ *
+ * @param[in]  scheme     The scheme of the connection ("http" or "https")
+ * @param[in]  host       The host of the connection
+ * @param[in]  port       The port of the connection
+ * @param[out] transport  The connected transport, which belongs to the returned transport list
+ *
+ * @return
+ *     - The transport list holding the connected transport, owned by the caller from now on
+ *     - NULL if there is no reusable connection to the server in the pool
+ */
+esp_transport_list_handle_t http_conn_pool_get(const char *scheme, const char *host, int port, esp_transport_handle_t *transport);
+
+/**
+ * @brief      Put an idle connection into the pool. The pool takes ownership of the transport list in any case,
+ *             and destroys it when the limits of the pool do not allow to keep the connection.
+ *
+ * @param[in]  scheme     The scheme of the connection ("http" or "https")
+ * @param[in]  host       The host of the connection
+ * @param[in]  port       The port of the connection
+ * @param[in]  list       The transport list holding the connected transport
+ * @param[in]  transport  The connected transport, with no request in progress
+ */
+void http_conn_pool_put(const char *scheme, const char *host, int port, esp_transport_list_handle_t list, esp_transport_handle_t transport);
+
+/**
+ * @brief      Close and destroy all the connections of the pool
+ */
+void http_conn_pool_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HTTP_CONN_POOL_H_ */
@@ -16,6 +16,7 @@
 #include <esp_err.h>
 #include <esp_event.h>
 #include <esp_event_base.h>
+#include <esp_partition.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -78,7 +79,9 @@ initializer that should be kept in sync
         .keep_alive_count = 0,                          \
         .open_fn = NULL,                                \
         .close_fn = NULL,                               \
-        .uri_match_fn = NULL                            \
+        .uri_match_fn = NULL,                           \
+        .worker_count = 0,                              \
+        .worker_stack_size = 4096,                      \
 }
 
 #define ESP_ERR_HTTPD_BASE              (0xb000)                    /*!< Starting number of HTTPD error codes */
@@ -286,6 +289,21 @@ typedef struct httpd_config {
      * of the `httpd_uri_match_func_t` function prototype)
      */
     httpd_uri_match_func_t uri_match_fn;
+
+    /**
+     * Number of worker tasks for running URI handlers.
+     *
+     * When non-zero, the server creates this many worker tasks, pinned to
+     * the available cores in round-robin order. Requests for URIs registered
+     * with `run_on_worker` set are handed off to a worker, so that a slow
+     * handler does not stall processing of the other sessions in the server
+     * task. The session is not polled by the server task until the worker
+     * has finished with the request.
+     *
+     * When 0 (default), all handlers run in the server task.
+     */
+    uint8_t worker_count;
+    size_t  worker_stack_size;  /*!< Stack size of each worker task */
 } httpd_config_t;
 
 /**
@@ -441,6 +459,16 @@ typedef struct httpd_uri {
      */
     void *user_ctx;
 
+    /**
+     * Flag for running the handler in one of the server worker tasks
+     * (see `worker_count` in httpd_config_t) instead of the server task.
+     * The handler receives an asynchronous copy of the request, as returned
+     * by httpd_req_async_handler_begin(), which is released by the server
+     * once the handler returns. Ignored for WebSocket endpoints, or when the
+     * server has no worker tasks.
+     */
+    bool run_on_worker;
+
 #if CONFIG_HTTPD_WS_SUPPORT || __DOXYGEN__
     /**
      * Flag for indicating a WebSocket endpoint.
@@ -957,6 +985,43 @@ size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field);
  */
 esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *r, const char *field, char *val, size_t val_size);
 
+/**
+ * @brief   Check if a content coding is acceptable according to an Accept-Encoding header value
+ *
+ * The quality values are honoured: a coding listed with "q=0" is refused, and a coding which
+ * is not listed is accepted only if the "*" wildcard is listed with a non-zero quality.
+ * The "identity" coding is accepted unless it is refused explicitly.
+ *
+ * @param[in]  accept_encoding  Value of the Accept-Encoding header, e.g. "gzip, deflate, br;q=0.9"
+ * @param[in]  encoding         Content coding to check, e.g. "gzip" or "br"
+ *
+ * @return
+ *  - true  : The content coding is acceptable
+ *  - false : The content coding is not acceptable / Null arguments
+ */
+bool httpd_encoding_is_acceptable(const char *accept_encoding, const char *encoding);
+
+/**
+ * @brief   Check if the client accepts a content coding for the response, based on the
+ *          Accept-Encoding header of the request
+ *
+ * This helps to serve a precompressed variant of a static file, e.g. "index.html.gz", along
+ * with the "Content-Encoding" and "Vary: Accept-Encoding" response headers.
+ *
+ * @note
+ *  - This API is supposed to be called only from the context of
+ *    a URI handler where httpd_req_t* request pointer is valid.
+ *  - If the request has no Accept-Encoding header, only the "identity" coding is accepted.
+ *
+ * @param[in]  r         The request being responded to
+ * @param[in]  encoding  Content coding to check, e.g. "gzip" or "br"
+ *
+ * @return
+ *  - true  : The client accepts the content coding
+ *  - false : The client does not accept the content coding / Invalid request / Null arguments
+ */
+bool httpd_req_accepts_encoding(httpd_req_t *r, const char *encoding);
+
 /**
  * @brief   Get Query string length from the request URL
  *
@@ -1190,6 +1255,71 @@ static inline esp_err_t httpd_resp_sendstr_chunk(httpd_req_t *r, const char *str
     return httpd_resp_send_chunk(r, str, (str == NULL) ? 0 : HTTPD_RESP_USE_STRLEN);
 }
 
+/**
+ * @brief   API to send a region of a flash partition as a complete HTTP response.
+ *
+ * The requested region is memory mapped and handed to the socket layer
+ * directly, so the content is never copied into an intermediate user buffer.
+ * This is useful for serving static assets which are stored in a raw data
+ * partition. Headers are sent in the same way as httpd_resp_send(), with
+ * Content-Length set to the length of the region.
+ *
+ * @note
+ *  - This API is supposed to be called only from the context of
+ *    a URI handler where httpd_req_t* request pointer is valid.
+ *  - Once this API is called, the request has been responded to.
+ *  - The region is unmapped before this API returns.
+ *  - On encrypted partitions the content is read back decrypted, as with
+ *    esp_partition_mmap().
+ *
+ * @param[in] r         The request being responded to
+ * @param[in] partition Partition which holds the content
+ * @param[in] offset    Offset of the content from the beginning of the partition
+ * @param[in] len       Length of the content in bytes
+ *
+ * @return
+ *  - ESP_OK : On successfully sending the response packet
+ *  - ESP_ERR_INVALID_ARG : Null arguments or region out of partition bounds
+ *  - ESP_ERR_NO_MEM            : Not enough free MMU pages to map the region
+ *  - ESP_ERR_HTTPD_RESP_HDR    : Essential headers are too large for internal buffer
+ *  - ESP_ERR_HTTPD_RESP_SEND   : Error in raw send
+ *  - ESP_ERR_HTTPD_INVALID_REQ : Invalid request
+ */
+esp_err_t httpd_resp_send_partition(httpd_req_t *r, const esp_partition_t *partition, size_t offset, size_t len);
+
+/**
+ * @brief   API to send the metrics registered with esp_metrics as a complete HTTP response.
+ *
+ * The metrics are sent in the Prometheus text exposition format, using chunked
+ * encoding. The function has the signature of a URI handler, so it can be
+ * registered directly to let Prometheus scrape the device:
+ *
+ * @code{c}
+ * httpd_uri_t metrics_uri = {
+ *     .uri = "/metrics",
+ *     .method = HTTP_GET,
+ *     .handler = httpd_resp_send_metrics,
+ * };
+ * httpd_register_uri_handler(server, &metrics_uri);
+ * @endcode
+ *
+ * @note
+ *  - This API is supposed to be called only from the context of
+ *    a URI handler where httpd_req_t* request pointer is valid.
+ *  - Once this API is called, the request has been responded to.
+ *  - Metrics can not be registered or unregistered while the response is sent.
+ *
+ * @param[in] r The request being responded to
+ *
+ * @return
+ *  - ESP_OK : On successfully sending the response packet
+ *  - ESP_ERR_INVALID_ARG : Null request pointer
+ *  - ESP_ERR_HTTPD_RESP_HDR    : Essential headers are too large for internal buffer
+ *  - ESP_ERR_HTTPD_RESP_SEND   : Error in raw send
+ *  - ESP_ERR_HTTPD_INVALID_REQ : Invalid request
+ */
+esp_err_t httpd_resp_send_metrics(httpd_req_t *r);
+
 /* Some commonly used status codes */
 #define HTTPD_200      "200 OK"                     /*!< HTTP Response 200 */
 #define HTTPD_204      "204 No Content"             /*!< HTTP Response 204 */
@@ -1609,6 +1739,29 @@ esp_err_t httpd_sess_trigger_close(httpd_handle_t handle, int sockfd);
  */
 esp_err_t httpd_sess_update_lru_counter(httpd_handle_t handle, int sockfd);
 
+/**
+ * @brief   Mark a session as being processed outside of the server task
+ *
+ * While a session is marked, the server task does not wait for data on its
+ * socket, does not process requests on it and does not close it by the LRU
+ * purge logic. This is used, for example, by the HTTPS server to perform the
+ * TLS handshake of a new session in a separate task.
+ *
+ * @note    When the mark is cleared from another task, the server task starts
+ *          polling the session again only after it is woken up, e.g. by
+ *          a work queued with httpd_queue_work().
+ *
+ * @param[in] handle    Handle to server returned by httpd_start
+ * @param[in] sockfd    The socket descriptor of the session
+ * @param[in] async     True to mark the session, false to clear the mark
+ *
+ * @return
+ *  - ESP_OK : Socket found and session marked
+ *  - ESP_ERR_NOT_FOUND   : Socket not found
+ *  - ESP_ERR_INVALID_ARG : Null arguments
+ */
+esp_err_t httpd_sess_set_async(httpd_handle_t handle, int sockfd, bool async);
+
 /**
  * @brief   Returns list of current socket descriptors of active sessions
  *
@@ -1737,6 +1890,24 @@ typedef void (*transfer_complete_cb)(esp_err_t err, int socket, void *arg);
  */
 esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *pkt, size_t max_len);
 
+/**
+ * @brief Receive a part of the payload of a WebSocket frame
+ *
+ * Streams the payload of a frame whose header has been parsed by calling httpd_ws_recv_frame() with max_len as 0,
+ * without requiring a buffer for the whole payload. The part is unmasked in place in the supplied buffer.
+ * Call repeatedly until @p received is 0, i.e. the whole payload of the frame has been received.
+ *
+ * @param[in]   req         Current request
+ * @param[out]  buf         Buffer receiving the part of the payload
+ * @param[in]   buf_len     Length of the buffer
+ * @param[out]  received    Length of the part received, less than @p buf_len for the last part only
+ * @return
+ *  - ESP_OK                    : On successful
+ *  - ESP_FAIL                  : Socket errors occurs
+ *  - ESP_ERR_INVALID_ARG       : Argument is invalid (null or non-WebSocket)
+ */
+esp_err_t httpd_ws_recv_frame_part(httpd_req_t *req, uint8_t *buf, size_t buf_len, size_t *received);
+
 /**
  * @brief Construct and send a WebSocket frame
  * @param[in]   req     Current request
@@ -1766,6 +1937,25 @@ esp_err_t httpd_ws_send_frame(httpd_req_t *req, httpd_ws_frame_t *pkt);
  */
 esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame);
 
+/**
+ * @brief Low level send of the same WebSocket frame to several clients
+ *
+ * The frame is encoded once for all the clients. As httpd_ws_send_frame_async(), this API
+ * should be called from the context of the server, e.g. in a work queued with httpd_queue_work.
+ * A failure to send to a client does not prevent the frame from being sent to the other clients.
+ *
+ * @param[in] hd          Server instance data
+ * @param[in] fds         Socket descriptors of the clients
+ * @param[in] fds_count   Number of socket descriptors
+ * @param[in] frame       WebSocket frame
+ * @return
+ *  - ESP_OK                    : On successful
+ *  - ESP_FAIL                  : When the frame could not be sent to one of the clients, or one of the
+ *                                descriptors is not an active WebSocket client
+ *  - ESP_ERR_INVALID_ARG       : Argument is invalid (null)
+ */
+esp_err_t httpd_ws_send_frame_to_clients(httpd_handle_t hd, const int *fds, size_t fds_count, httpd_ws_frame_t *frame);
+
 /**
  * @brief Checks the supplied socket descriptor if it belongs to any active client
  * of this server instance and if the websoket protocol is active
@@ -16,6 +16,7 @@
 #include <esp_err.h>
 
 #include <esp_http_server.h>
+#include <freertos/queue.h>
 #include "osal.h"
 
 #ifdef __cplusplus
@@ -69,6 +70,9 @@ struct sock_db {
     char pending_data[PARSER_BLOCK_SIZE];   /*!< Buffer for pending data to be received */
     size_t pending_len;                     /*!< Length of pending data to be received */
     bool for_async_req;                     /*!< If true, the socket will not be LRU purged */
+    struct sock_db *fd_next;                /*!< Next session in the same bucket of the fd lookup table */
+    struct sock_db *lru_prev;               /*!< Previous (less recently used) session in the LRU list */
+    struct sock_db *lru_next;               /*!< Next (more recently used) session in the LRU list, or next free session */
 #ifdef CONFIG_HTTPD_WS_SUPPORT
     bool ws_handshake_done;                 /*!< True if it has done WebSocket handshake (if this socket is a valid WS) */
     bool ws_close;                          /*!< Set to true to close the socket later (when WS Close frame received) */
@@ -94,6 +98,12 @@ struct httpd_req_aux {
     char           *content_type;                   /*!< HTTP response's content type */
     bool            first_chunk_sent;               /*!< Used to indicate if first chunk sent */
     unsigned        req_hdrs_count;                 /*!< Count of total headers in request packet */
+    struct req_hdr_slot {
+        uint32_t hash;                              /*!< Hash of the lowercase header field */
+        uint32_t offset;                            /*!< Offset of the header in scratch buffer plus 1, 0 for an empty slot */
+    } *req_hdrs_index;                              /*!< Hash index of the request headers, built on the first header lookup */
+    unsigned        req_hdrs_index_size;            /*!< Number of slots in the header index (power of 2) */
+    unsigned        req_hdrs_indexed;               /*!< Count of headers the index was built for */
     unsigned        resp_hdrs_count;                /*!< Count of additional headers in response packet */
     struct resp_hdr {
         const char *field;
@@ -105,6 +115,8 @@ struct httpd_req_aux {
     httpd_ws_type_t ws_type;                        /*!< WebSocket frame type */
     bool ws_final;                                  /*!< WebSocket FIN bit (final frame or not) */
     uint8_t mask_key[4];                            /*!< WebSocket mask key for this payload */
+    size_t ws_payload_left;                         /*!< Length of the payload of the current WebSocket frame left to be received */
+    size_t ws_payload_offset;                       /*!< Length of the payload of the current WebSocket frame already received */
 #endif
 };
 
@@ -123,10 +135,21 @@ struct httpd_data {
     struct thread_data hd_td;               /*!< Information for the HTTPD thread */
     struct sock_db *hd_sd;                  /*!< The socket database */
     int hd_sd_active_count;                 /*!< The number of the active sockets */
+    struct sock_db **hd_sd_fd_map;          /*!< Lookup table of the active sessions, indexed by fd, chained through sock_db::fd_next */
+    size_t hd_sd_fd_map_size;               /*!< Number of buckets in the fd lookup table, power of 2 */
+    struct sock_db *hd_sd_lru_head;         /*!< Least recently used active session */
+    struct sock_db *hd_sd_lru_tail;         /*!< Most recently used active session */
+    struct sock_db *hd_sd_free;             /*!< List of the free session slots, chained through sock_db::lru_next */
     httpd_uri_t **hd_calls;                 /*!< Registered URI handlers */
+    uint16_t *uri_index;                    /*!< Hash index of exactly matched URI handlers (positions in hd_calls) */
+    size_t uri_index_size;                  /*!< Number of slots in the hash index, power of 2 */
+    uint16_t *uri_fallback;                 /*!< Positions of URI handlers which are not in the hash index */
+    uint16_t uri_fallback_count;            /*!< Number of entries in uri_fallback */
     struct httpd_req hd_req;                /*!< The current HTTPD request */
     struct httpd_req_aux hd_req_aux;        /*!< Additional data about the HTTPD request kept unexposed */
     uint64_t lru_counter;                   /*!< LRU counter */
+    QueueHandle_t worker_queue;             /*!< Queue of requests handed off to the worker tasks */
+    struct thread_data *hd_workers;         /*!< Information for the worker tasks, NULL if there are none */
 
     /* Array of registered error handler functions */
     httpd_err_handler_func_t *err_handler_fns;
@@ -314,6 +337,42 @@ void httpd_sess_close_all(struct httpd_data *hd);
  */
 esp_err_t httpd_uri(struct httpd_data *hd);
 
+/**
+ * @brief   Hands off a request to one of the worker tasks of the server
+ *
+ * An asynchronous copy of the request is created (as by
+ * httpd_req_async_handler_begin()) and queued for the worker tasks.
+ * The worker invokes the handler on this copy and releases it afterwards.
+ * If the request cannot be queued, the handler is invoked directly.
+ *
+ * @param[in] hd      Server instance data
+ * @param[in] r       Request being processed by the server task
+ * @param[in] handler URI handler to be invoked
+ *
+ * @return
+ *  - ESP_OK    : if request was queued, or handler executed successfully
+ *  - ESP_FAIL  : otherwise
+ */
+esp_err_t httpd_worker_dispatch(struct httpd_data *hd, httpd_req_t *r, esp_err_t (*handler)(httpd_req_t *r));
+
+/**
+ * @brief   Allocates the URI handler lookup index
+ *
+ * @param[in] hd  Server instance data, with configuration already set
+ *
+ * @return
+ *  - ESP_OK         : on success
+ *  - ESP_ERR_NO_MEM : if memory allocation failed
+ */
+esp_err_t httpd_uri_index_init(struct httpd_data *hd);
+
+/**
+ * @brief   Frees the URI handler lookup index
+ *
+ * @param[in] hd  Server instance data
+ */
+void httpd_uri_index_deinit(struct httpd_data *hd);
+
 /**
  * @brief   Unregister all URI handlers
  *
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -351,6 +351,128 @@ static void httpd_thread(void *arg)
     httpd_os_thread_delete();
 }
 
+typedef struct {
+    httpd_req_t *req;
+    esp_err_t (*handler)(httpd_req_t *r);
+} httpd_worker_job_t;
+
+static void httpd_worker_wakeup(void *arg)
+{
+    /* Nothing to do, the control message only unblocks select() so that
+     * the session released by a worker gets polled again */
+}
+
+esp_err_t httpd_worker_dispatch(struct httpd_data *hd, httpd_req_t *r, esp_err_t (*handler)(httpd_req_t *r))
+{
+    httpd_worker_job_t job = {
+        .handler = handler,
+    };
+    if (httpd_req_async_handler_begin(r, &job.req) != ESP_OK) {
+        ESP_LOGW(TAG, LOG_FMT("failed to create async request, running handler in server task"));
+        return handler(r) == ESP_OK ? ESP_OK : ESP_FAIL;
+    }
+    if (xQueueSend(hd->worker_queue, &job, 0) != pdTRUE) {
+        ESP_LOGW(TAG, LOG_FMT("worker queue full, running handler in server task"));
+        httpd_req_async_handler_complete(job.req);
+        return handler(r) == ESP_OK ? ESP_OK : ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/* Worker thread executing handlers of requests handed off by the server thread */
+static void httpd_worker_thread(void *arg)
+{
+    struct httpd_data *hd = (struct httpd_data *) arg;
+    httpd_worker_job_t job;
+
+    while (1) {
+        if (xQueueReceive(hd->worker_queue, &job, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (job.req == NULL) {
+            /* Request to exit */
+            break;
+        }
+        int fd = httpd_req_to_sockfd(job.req);
+        esp_err_t ret = job.handler(job.req);
+        httpd_req_async_handler_complete(job.req);
+        if (ret != ESP_OK) {
+            /* Handler returns error, this socket should be closed */
+            ESP_LOGW(TAG, LOG_FMT("uri handler execution failed"));
+            httpd_sess_trigger_close(hd, fd);
+        } else {
+            httpd_queue_work(hd, httpd_worker_wakeup, NULL);
+        }
+    }
+
+    ESP_LOGD(TAG, LOG_FMT("worker exiting"));
+    for (int i = 0; i < hd->config.worker_count; i++) {
+        if (hd->hd_workers[i].handle == httpd_os_thread_handle()) {
+            hd->hd_workers[i].status = THREAD_STOPPED;
+            break;
+        }
+    }
+    httpd_os_thread_delete();
+}
+
+static void httpd_workers_stop(struct httpd_data *hd)
+{
+    if (hd->hd_workers == NULL) {
+        return;
+    }
+    httpd_worker_job_t job = { 0 };
+    for (int i = 0; i < hd->config.worker_count; i++) {
+        if (hd->hd_workers[i].status == THREAD_RUNNING) {
+            xQueueSend(hd->worker_queue, &job, portMAX_DELAY);
+        }
+    }
+    for (int i = 0; i < hd->config.worker_count; i++) {
+        while (hd->hd_workers[i].status == THREAD_RUNNING) {
+            httpd_os_thread_sleep(10);
+        }
+    }
+    vQueueDelete(hd->worker_queue);
+    hd->worker_queue = NULL;
+    free(hd->hd_workers);
+    hd->hd_workers = NULL;
+}
+
+static esp_err_t httpd_workers_start(struct httpd_data *hd)
+{
+    if (hd->config.worker_count == 0) {
+        return ESP_OK;
+    }
+    hd->worker_queue = xQueueCreate(hd->config.max_open_sockets, sizeof(httpd_worker_job_t));
+    if (hd->worker_queue == NULL) {
+        ESP_LOGE(TAG, LOG_FMT("Failed to create worker queue"));
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    hd->hd_workers = calloc(hd->config.worker_count, sizeof(struct thread_data));
+    if (hd->hd_workers == NULL) {
+        ESP_LOGE(TAG, LOG_FMT("Failed to allocate memory for worker data"));
+        vQueueDelete(hd->worker_queue);
+        hd->worker_queue = NULL;
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    for (int i = 0; i < hd->config.worker_count; i++) {
+        /* Status is set before the task is created, so that a worker
+         * exiting right away can not be overwritten back to running */
+        hd->hd_workers[i].status = THREAD_RUNNING;
+        if (httpd_os_thread_create(&hd->hd_workers[i].handle, "httpd_wrk",
+                                   hd->config.worker_stack_size,
+                                   hd->config.task_priority,
+                                   httpd_worker_thread, hd,
+                                   i % portNUM_PROCESSORS,
+                                   hd->config.task_caps) != ESP_OK) {
+            ESP_LOGE(TAG, LOG_FMT("Failed to launch worker task %d"), i);
+            hd->hd_workers[i].status = THREAD_IDLE;
+            httpd_workers_stop(hd);
+            return ESP_ERR_HTTPD_TASK;
+        }
+    }
+    return ESP_OK;
+}
+
 static esp_err_t httpd_server_init(struct httpd_data *hd)
 {
 #if CONFIG_LWIP_IPV6
@@ -436,13 +558,20 @@ static struct httpd_data *httpd_create(const httpd_config_t *config)
         free(hd);
         return NULL;
     }
-    hd->hd_sd = calloc(config->max_open_sockets, sizeof(struct sock_db));
+    /* The fd lookup table of the sessions is allocated along with them */
+    size_t fd_map_size = 1;
+    while (fd_map_size < config->max_open_sockets) {
+        fd_map_size <<= 1;
+    }
+    hd->hd_sd = calloc(1, config->max_open_sockets * sizeof(struct sock_db) + fd_map_size * sizeof(struct sock_db *));
     if (!hd->hd_sd) {
         ESP_LOGE(TAG, LOG_FMT("Failed to allocate memory for HTTP session data"));
         free(hd->hd_calls);
         free(hd);
         return NULL;
     }
+    hd->hd_sd_fd_map = (struct sock_db **)(hd->hd_sd + config->max_open_sockets);
+    hd->hd_sd_fd_map_size = fd_map_size;
     struct httpd_req_aux *ra = &hd->hd_req_aux;
     ra->resp_hdrs = calloc(config->max_resp_headers, sizeof(struct resp_hdr));
     if (!ra->resp_hdrs) {
@@ -463,6 +592,15 @@ static struct httpd_data *httpd_create(const httpd_config_t *config)
     }
     /* Save the configuration for this instance */
     hd->config = *config;
+    if (httpd_uri_index_init(hd) != ESP_OK) {
+        ESP_LOGE(TAG, LOG_FMT("Failed to allocate memory for HTTP URI handler index"));
+        free(hd->err_handler_fns);
+        free(ra->resp_hdrs);
+        free(hd->hd_sd);
+        free(hd->hd_calls);
+        free(hd);
+        return NULL;
+    }
     return hd;
 }
 
@@ -476,6 +614,7 @@ static void httpd_delete(struct httpd_data *hd)
 
     /* Free registered URI handlers */
     httpd_unregister_all_uri_handlers(hd);
+    httpd_uri_index_deinit(hd);
     free(hd->hd_calls);
     free(hd);
 }
@@ -527,6 +666,15 @@ esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
     }
 
     httpd_sess_init(hd);
+    esp_err_t err = httpd_workers_start(hd);
+    if (err != ESP_OK) {
+        close(hd->listen_fd);
+        close(hd->msg_fd);
+        cs_free_ctrl_sock(hd->ctrl_fd);
+        httpd_delete(hd);
+        return err;
+    }
+
     if (httpd_os_thread_create(&hd->hd_td.handle, "httpd",
                                hd->config.stack_size,
                                hd->config.task_priority,
@@ -534,6 +682,7 @@ esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
                                hd->config.core_id,
                                hd->config.task_caps) != ESP_OK) {
         /* Failed to launch task */
+        httpd_workers_stop(hd);
         httpd_delete(hd);
         return ESP_ERR_HTTPD_TASK;
     }
@@ -564,6 +713,7 @@ esp_err_t httpd_stop(httpd_handle_t handle)
     while (hd->hd_td.status != THREAD_STOPPED) {
         httpd_os_thread_sleep(100);
     }
+    httpd_workers_stop(hd);
 
     /* Release global user context, if not NULL */
     if (hd->config.global_user_ctx) {
@@ -7,6 +7,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <sys/param.h>
 #include <esp_log.h>
 #include <esp_err.h>
@@ -708,6 +709,9 @@ static void init_req_aux(struct httpd_req_aux *ra, httpd_config_t *config)
     ra->resp_hdrs_count = 0;
     ra->scratch = NULL;
     ra->scratch_cur_size = 0;
+    ra->req_hdrs_index = NULL;
+    ra->req_hdrs_index_size = 0;
+    ra->req_hdrs_indexed = 0;
     ra->max_req_hdr_len = (config->max_req_hdr_len > 0) ? config->max_req_hdr_len : CONFIG_HTTPD_MAX_REQ_HDR_LEN;
     ra->max_uri_len = (config->max_uri_len > 0) ? config->max_uri_len : CONFIG_HTTPD_MAX_URI_LEN;
     ra->scratch_size_limit = ra->max_uri_len;
@@ -745,6 +749,10 @@ static void httpd_req_cleanup(httpd_req_t *r)
     ra->scratch = NULL;
     ra->scratch_size_limit = 0;
     ra->scratch_cur_size = 0;
+    free(ra->req_hdrs_index);
+    ra->req_hdrs_index = NULL;
+    ra->req_hdrs_index_size = 0;
+    ra->req_hdrs_indexed = 0;
     r->handle = NULL;
     r->aux = NULL;
     r->user_ctx = NULL;
@@ -995,18 +1003,112 @@ esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len)
     return ESP_ERR_NOT_FOUND;
 }
 
-/* Get the length of the value string of a header request field */
-size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field)
+/* Case insensitive FNV-1a hash of a header field */
+static uint32_t httpd_hdr_field_hash(const char *field, size_t len)
 {
-    if (r == NULL || field == NULL) {
-        return 0;
+    uint32_t hash = 2166136261U;
+    while (len--) {
+        hash ^= (uint8_t)tolower((unsigned char)*field++);
+        hash *= 16777619U;
     }
+    return hash;
+}
 
-    if (!httpd_valid_req(r)) {
-        return 0;
+/* Skip the ':' and the spaces following a header field */
+static const char *httpd_hdr_value_start(const char *val_ptr)
+{
+    /* Skip ':' */
+    val_ptr++;
+
+    /* Skip preceding space */
+    while ((*val_ptr != '\0') && (*val_ptr == ' ')) {
+        val_ptr++;
+    }
+    return val_ptr;
+}
+
+/* Index the request headers by the hash of their field, so that every
+ * lookup after the first one doesn't need to scan the whole scratch buffer */
+static esp_err_t httpd_req_index_hdrs(struct httpd_req_aux *ra)
+{
+    unsigned size = 4;
+    while (size < 2 * ra->req_hdrs_count) {
+        size <<= 1;
+    }
+
+    if (size != ra->req_hdrs_index_size) {
+        free(ra->req_hdrs_index);
+        ra->req_hdrs_index_size = 0;
+        ra->req_hdrs_index = malloc(size * sizeof(struct req_hdr_slot));
+        if (ra->req_hdrs_index == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        ra->req_hdrs_index_size = size;
     }
+    memset(ra->req_hdrs_index, 0, size * sizeof(struct req_hdr_slot));
+
+    const char *hdr_ptr = ra->scratch;
+    unsigned count = ra->req_hdrs_count;
+    while (count--) {
+        const char *val_ptr = strchr(hdr_ptr, ':');
+        if (!val_ptr) {
+            break;
+        }
 
+        size_t len = val_ptr - hdr_ptr;
+        uint32_t hash = httpd_hdr_field_hash(hdr_ptr, len);
+        for (unsigned i = hash & (size - 1); ; i = (i + 1) & (size - 1)) {
+            struct req_hdr_slot *slot = &ra->req_hdrs_index[i];
+            if (slot->offset == 0) {
+                slot->hash = hash;
+                slot->offset = hdr_ptr - ra->scratch + 1;
+                break;
+            }
+            /* Keep the first one of duplicate fields, as the linear search does */
+            const char *slot_ptr = ra->scratch + slot->offset - 1;
+            if (slot->hash == hash && slot_ptr[len] == ':' && !strncasecmp(slot_ptr, hdr_ptr, len)) {
+                break;
+            }
+        }
+
+        if (count) {
+            /* Jump to end of header field-value string and skip
+             * the null characters which replaced the line terminators */
+            hdr_ptr = 1 + strchr(hdr_ptr, '\0');
+            while (*hdr_ptr == '\0') {
+                hdr_ptr++;
+            }
+        }
+    }
+    ra->req_hdrs_indexed = ra->req_hdrs_count;
+    return ESP_OK;
+}
+
+/* Find a field in the request headers and get a pointer to its value string */
+static const char *httpd_req_find_hdr_value(httpd_req_t *r, const char *field)
+{
     struct httpd_req_aux *ra = r->aux;
+
+    if (ra->req_hdrs_count == 0) {
+        return NULL;
+    }
+
+    if ((ra->req_hdrs_index != NULL && ra->req_hdrs_indexed == ra->req_hdrs_count) ||
+        httpd_req_index_hdrs(ra) == ESP_OK) {
+        size_t len = strlen(field);
+        uint32_t hash = httpd_hdr_field_hash(field, len);
+        unsigned mask = ra->req_hdrs_index_size - 1;
+        for (unsigned i = hash & mask; ra->req_hdrs_index[i].offset != 0; i = (i + 1) & mask) {
+            const struct req_hdr_slot *slot = &ra->req_hdrs_index[i];
+            const char *hdr_ptr = ra->scratch + slot->offset - 1;
+            if (slot->hash == hash && hdr_ptr[len] == ':' && !strncasecmp(hdr_ptr, field, len)) {
+                return httpd_hdr_value_start(hdr_ptr + len);
+            }
+        }
+        return NULL;
+    }
+
+    /* Not enough memory for the index, fall back to scanning the headers */
     const char   *hdr_ptr = ra->scratch;         /*!< Request headers are kept in scratch buffer */
     unsigned      count   = ra->req_hdrs_count;  /*!< Count set during parsing  */
 
@@ -1038,16 +1140,24 @@ size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field)
             continue;
         }
 
-        /* Skip ':' */
-        val_ptr++;
+        return httpd_hdr_value_start(val_ptr);
+    }
+    return NULL;
+}
 
-        /* Skip preceding space */
-        while ((*val_ptr != '\0') && (*val_ptr == ' ')) {
-            val_ptr++;
-        }
-        return strlen(val_ptr);
+/* Get the length of the value string of a header request field */
+size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field)
+{
+    if (r == NULL || field == NULL) {
+        return 0;
     }
-    return 0;
+
+    if (!httpd_valid_req(r)) {
+        return 0;
+    }
+
+    const char *val_ptr = httpd_req_find_hdr_value(r, field);
+    return val_ptr ? strlen(val_ptr) : 0;
 }
 
 /* Get the value of a field from the request headers */
@@ -1061,60 +1171,110 @@ esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *r, const char *field, char *v
         return ESP_ERR_HTTPD_INVALID_REQ;
     }
 
-    struct httpd_req_aux *ra = r->aux;
-    const char   *hdr_ptr = ra->scratch;         /*!< Request headers are kept in scratch buffer */
-    unsigned     count    = ra->req_hdrs_count;  /*!< Count set during parsing  */
-    const size_t buf_len  = val_size;
+    const char *val_ptr = httpd_req_find_hdr_value(r, field);
+    if (!val_ptr) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    const size_t buf_len = val_size;
 
-    while (count--) {
-        /* Search for the ':' character. Else, it would mean
-         * that the field is invalid
-         */
-        const char *val_ptr = strchr(hdr_ptr, ':');
-        if (!val_ptr) {
-            break;
-        }
+    /* Get the NULL terminated value and copy it to the caller's buffer. */
+    strlcpy(val, val_ptr, buf_len);
 
-        /* If the field, does not match, continue searching.
-         * Compare lengths first as field from header is not
-         * null terminated (has ':' in the end).
-         */
-        if ((val_ptr - hdr_ptr != strlen(field)) ||
-            (strncasecmp(hdr_ptr, field, strlen(field)))) {
-            if (count) {
-                /* Jump to end of header field-value string */
-                hdr_ptr = 1 + strchr(hdr_ptr, '\0');
+    /* Update value length, including one byte for null */
+    val_size = strlen(val_ptr) + 1;
 
-                /* Skip all null characters (with which the line
-                 * terminators had been overwritten) */
-                while (*hdr_ptr == '\0') {
-                    hdr_ptr++;
+    /* If buffer length is smaller than needed, return truncation error */
+    if (buf_len < val_size) {
+        return ESP_ERR_HTTPD_RESULT_TRUNC;
+    }
+    return ESP_OK;
+}
+
+/* Check if a quality value of a header list element is zero, e.g. "q=0" or "q=0.000" */
+static bool httpd_qvalue_is_zero(const char *params, size_t params_len)
+{
+    const char *end = params + params_len;
+    while (params < end) {
+        /* Skip the ';' separator and spaces before the parameter name */
+        while (params < end && (*params == ';' || *params == ' ' || *params == '\t')) {
+            params++;
+        }
+        if (end - params >= 2 && (params[0] == 'q' || params[0] == 'Q') && params[1] == '=') {
+            params += 2;
+            if (params == end || *params != '0') {
+                return false;
+            }
+            params++;
+            if (params < end && *params == '.') {
+                params++;
+                while (params < end && *params == '0') {
+                    params++;
                 }
             }
-            continue;
+            /* Any non-zero digit makes the quality non-zero */
+            return params == end || *params < '1' || *params > '9';
+        }
+        /* Skip other parameters */
+        while (params < end && *params != ';') {
+            params++;
         }
+    }
+    return false;
+}
 
-        /* Skip ':' */
-        val_ptr++;
+bool httpd_encoding_is_acceptable(const char *accept_encoding, const char *encoding)
+{
+    if (accept_encoding == NULL || encoding == NULL) {
+        return false;
+    }
 
-        /* Skip preceding space */
-        while ((*val_ptr != '\0') && (*val_ptr == ' ')) {
-            val_ptr++;
+    const size_t enc_len = strlen(encoding);
+    int wildcard = -1;      /* -1: no "*" element, 0: "*;q=0", 1: "*" with non-zero quality */
+    const char *ptr = accept_encoding;
+    while (*ptr) {
+        /* Each list element is "coding[;q=value]", elements are separated by ',' */
+        while (*ptr == ' ' || *ptr == '\t' || *ptr == ',') {
+            ptr++;
         }
+        const char *name = ptr;
+        while (*ptr && *ptr != ',' && *ptr != ';' && *ptr != ' ' && *ptr != '\t') {
+            ptr++;
+        }
+        size_t name_len = ptr - name;
+        const char *params = ptr;
+        while (*ptr && *ptr != ',') {
+            ptr++;
+        }
+        if (name_len == 0) {
+            continue;
+        }
+        bool acceptable = !httpd_qvalue_is_zero(params, ptr - params);
+        if (name_len == enc_len && strncasecmp(name, encoding, enc_len) == 0) {
+            return acceptable;
+        }
+        if (name_len == 1 && *name == '*') {
+            wildcard = acceptable;
+        }
+    }
+    if (wildcard >= 0) {
+        return wildcard;
+    }
+    /* The identity encoding is acceptable unless refused explicitly */
+    return strcasecmp(encoding, "identity") == 0;
+}
 
-        /* Get the NULL terminated value and copy it to the caller's buffer. */
-        strlcpy(val, val_ptr, buf_len);
-
-        /* Update value length, including one byte for null */
-        val_size = strlen(val_ptr) + 1;
+bool httpd_req_accepts_encoding(httpd_req_t *r, const char *encoding)
+{
+    if (r == NULL || encoding == NULL || !httpd_valid_req(r)) {
+        return false;
+    }
 
-        /* If buffer length is smaller than needed, return truncation error */
-        if (buf_len < val_size) {
-            return ESP_ERR_HTTPD_RESULT_TRUNC;
-        }
-        return ESP_OK;
+    const char *accept_encoding = httpd_req_find_hdr_value(r, "Accept-Encoding");
+    if (!accept_encoding) {
+        /* Without Accept-Encoding any content coding is acceptable, but only send the identity encoding to be on the safe side */
+        return strcasecmp(encoding, "identity") == 0;
     }
-    return ESP_ERR_NOT_FOUND;
+    return httpd_encoding_is_acceptable(accept_encoding, encoding);
 }
 
 /* Helper function to get a cookie value from a cookie string of the type "cookie1=val1; cookie2=val2" */
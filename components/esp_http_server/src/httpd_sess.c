@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -17,24 +17,16 @@ static const char *TAG = "httpd_sess";
 
 typedef enum {
     HTTPD_TASK_NONE = 0,
-    HTTPD_TASK_INIT,            // Init session
-    HTTPD_TASK_GET_ACTIVE,      // Get active session (fd!=-1)
-    HTTPD_TASK_GET_FREE,        // Get free session slot (fd<0)
-    HTTPD_TASK_FIND_FD,         // Find session with specific fd
     HTTPD_TASK_SET_DESCRIPTOR,  // Set descriptor
     HTTPD_TASK_DELETE_INVALID,  // Delete invalid session
-    HTTPD_TASK_FIND_LOWEST_LRU, // Find session with lowest lru
     HTTPD_TASK_CLOSE            // Close session
 } task_t;
 
 typedef struct {
     task_t task;
-    int fd;
     fd_set *fdset;
     int max_fd;
     struct httpd_data *hd;
-    uint64_t lru_counter;
-    struct sock_db    *session;
 } enum_context_t;
 
 void httpd_sess_enum(struct httpd_data *hd, httpd_session_enum_function enum_function, void *context)
@@ -66,26 +58,7 @@ static int enum_function(struct sock_db *session, void *context)
         return 0;
     }
     enum_context_t *ctx = (enum_context_t *) context;
-    int found = 0;
     switch (ctx->task) {
-    // Initialize session
-    case HTTPD_TASK_INIT:
-        session->fd = -1;
-        session->ctx = NULL;
-        session->for_async_req = false;
-        break;
-    // Get active session
-    case HTTPD_TASK_GET_ACTIVE:
-        found = (session->fd != -1);
-        break;
-    // Get free slot
-    case HTTPD_TASK_GET_FREE:
-        found = (session->fd < 0);
-        break;
-    // Find fd
-    case HTTPD_TASK_FIND_FD:
-        found = (session->fd == ctx->fd);
-        break;
     // Set descriptor
     case HTTPD_TASK_SET_DESCRIPTOR:
         if (session->fd != -1 && !session->for_async_req) {
@@ -102,21 +75,6 @@ static int enum_function(struct sock_db *session, void *context)
             httpd_sess_delete(ctx->hd, session);
         }
         break;
-    // Find lowest lru
-    case HTTPD_TASK_FIND_LOWEST_LRU:
-        // Found free slot - no need to check other sessions
-        if (session->fd == -1) {
-            return 0;
-        }
-        // Only close sockets that are not in use
-        if (session->for_async_req == false) {
-            // Check/update lowest lru
-            if (session->lru_counter < ctx->lru_counter) {
-                ctx->lru_counter = session->lru_counter;
-                ctx->session = session;
-            }
-        }
-        break;
     case HTTPD_TASK_CLOSE:
         if (session->fd != -1) {
             ESP_LOGD(TAG, LOG_FMT("cleaning up socket %d"), session->fd);
@@ -126,13 +84,71 @@ static int enum_function(struct sock_db *session, void *context)
     default:
         return 0;
     }
-    if (found) {
-        ctx->session = session;
-        return 0;
-    }
     return 1;
 }
 
+// Bucket of the fd lookup table, the lwIP sockets are numbered consecutively so they spread evenly
+static inline struct sock_db **httpd_sess_fd_bucket(struct httpd_data *hd, int fd)
+{
+    return &hd->hd_sd_fd_map[(unsigned) fd & (hd->hd_sd_fd_map_size - 1)];
+}
+
+static void httpd_sess_fd_map_remove(struct httpd_data *hd, struct sock_db *session)
+{
+    struct sock_db **link = httpd_sess_fd_bucket(hd, session->fd);
+    while (*link) {
+        if (*link == session) {
+            *link = session->fd_next;
+            break;
+        }
+        link = &(*link)->fd_next;
+    }
+    session->fd_next = NULL;
+}
+
+static void httpd_sess_lru_unlink(struct httpd_data *hd, struct sock_db *session)
+{
+    if ((!session->lru_prev) && (hd->hd_sd_lru_head != session)) {
+        // not in the list yet
+        return;
+    }
+    if (session->lru_prev) {
+        session->lru_prev->lru_next = session->lru_next;
+    } else {
+        hd->hd_sd_lru_head = session->lru_next;
+    }
+    if (session->lru_next) {
+        session->lru_next->lru_prev = session->lru_prev;
+    } else {
+        hd->hd_sd_lru_tail = session->lru_prev;
+    }
+    session->lru_prev = NULL;
+    session->lru_next = NULL;
+}
+
+// Move the session to the most recently used end of the LRU list
+static void httpd_sess_lru_move_to_tail(struct httpd_data *hd, struct sock_db *session)
+{
+    if (hd->hd_sd_lru_tail == session) {
+        return;
+    }
+    httpd_sess_lru_unlink(hd, session);
+    session->lru_prev = hd->hd_sd_lru_tail;
+    if (hd->hd_sd_lru_tail) {
+        hd->hd_sd_lru_tail->lru_next = session;
+    } else {
+        hd->hd_sd_lru_head = session;
+    }
+    hd->hd_sd_lru_tail = session;
+}
+
+// Mark the session as the most recently used one
+static void httpd_sess_lru_touch(struct httpd_data *hd, struct sock_db *session)
+{
+    session->lru_counter = ++hd->lru_counter;
+    httpd_sess_lru_move_to_tail(hd, session);
+}
+
 static void httpd_sess_close(void *arg)
 {
     struct sock_db *sock_db = (struct sock_db *) arg;
@@ -154,11 +170,7 @@ struct sock_db *httpd_sess_get_free(struct httpd_data *hd)
     if ((!hd) || (hd->hd_sd_active_count == hd->config.max_open_sockets)) {
         return NULL;
     }
-    enum_context_t context = {
-        .task = HTTPD_TASK_GET_FREE
-    };
-    httpd_sess_enum(hd, enum_function, &context);
-    return context.session;
+    return hd->hd_sd_free;
 }
 
 bool httpd_is_sess_available(struct httpd_data *hd)
@@ -178,12 +190,12 @@ struct sock_db *httpd_sess_get(struct httpd_data *hd, int sockfd)
         return hd->hd_req_aux.sd;
     }
 
-    enum_context_t context = {
-        .task = HTTPD_TASK_FIND_FD,
-        .fd = sockfd
-    };
-    httpd_sess_enum(hd, enum_function, &context);
-    return context.session;
+    for (struct sock_db *session = *httpd_sess_fd_bucket(hd, sockfd); session; session = session->fd_next) {
+        if (session->fd == sockfd) {
+            return session;
+        }
+    }
+    return NULL;
 }
 
 esp_err_t httpd_sess_new(struct httpd_data *hd, int newfd)
@@ -201,13 +213,20 @@ esp_err_t httpd_sess_new(struct httpd_data *hd, int newfd)
         return ESP_FAIL;
     }
 
-    // Clear session data
+    // Take the slot out of the free list and clear session data
+    hd->hd_sd_free = session->lru_next;
     memset(session, 0, sizeof (struct sock_db));
     session->fd = newfd;
     session->handle = (httpd_handle_t) hd;
     session->send_fn = httpd_default_send;
     session->recv_fn = httpd_default_recv;
 
+    // Make the session reachable by its fd, as the most recently used one
+    struct sock_db **bucket = httpd_sess_fd_bucket(hd, newfd);
+    session->fd_next = *bucket;
+    *bucket = session;
+    httpd_sess_lru_move_to_tail(hd, session);
+
     // increment number of sessions
     hd->hd_sd_active_count++;
 
@@ -380,7 +399,11 @@ void httpd_sess_delete(struct httpd_data *hd, struct sock_db *session)
     httpd_sess_clear_ctx(session);
 
     // mark session slot as available
+    httpd_sess_fd_map_remove(hd, session);
+    httpd_sess_lru_unlink(hd, session);
     session->fd = -1;
+    session->lru_next = hd->hd_sd_free;
+    hd->hd_sd_free = session;
 
     // decrement number of sessions
     hd->hd_sd_active_count--;
@@ -392,10 +415,25 @@ void httpd_sess_delete(struct httpd_data *hd, struct sock_db *session)
 
 void httpd_sess_init(struct httpd_data *hd)
 {
-    enum_context_t context = {
-        .task = HTTPD_TASK_INIT
-    };
-    httpd_sess_enum(hd, enum_function, &context);
+    if ((!hd) || (!hd->hd_sd) || (!hd->config.max_open_sockets)) {
+        return;
+    }
+
+    hd->hd_sd_free = NULL;
+    hd->hd_sd_lru_head = NULL;
+    hd->hd_sd_lru_tail = NULL;
+    memset(hd->hd_sd_fd_map, 0, hd->hd_sd_fd_map_size * sizeof(struct sock_db *));
+    // chain all the slots into the free list, the first slot is handed out first
+    for (int i = hd->config.max_open_sockets - 1; i >= 0; i--) {
+        struct sock_db *session = &hd->hd_sd[i];
+        session->fd = -1;
+        session->ctx = NULL;
+        session->for_async_req = false;
+        session->fd_next = NULL;
+        session->lru_prev = NULL;
+        session->lru_next = hd->hd_sd_free;
+        hd->hd_sd_free = session;
+    }
 }
 
 bool httpd_sess_pending(struct httpd_data *hd, struct sock_db *session)
@@ -432,7 +470,7 @@ esp_err_t httpd_sess_process(struct httpd_data *hd, struct sock_db *session)
         return ESP_FAIL;
     }
     ESP_LOGD(TAG, LOG_FMT("success"));
-    session->lru_counter = ++hd->lru_counter;
+    httpd_sess_lru_touch(hd, session);
     return ESP_OK;
 }
 
@@ -444,32 +482,41 @@ esp_err_t httpd_sess_update_lru_counter(httpd_handle_t handle, int sockfd)
 
     struct httpd_data *hd = (struct httpd_data *) handle;
 
-    enum_context_t context = {
-        .task = HTTPD_TASK_FIND_FD,
-        .fd = sockfd
-    };
-    httpd_sess_enum(hd, enum_function, &context);
-    if (context.session) {
-        context.session->lru_counter = ++hd->lru_counter;
+    struct sock_db *session = httpd_sess_get(hd, sockfd);
+    if (session) {
+        httpd_sess_lru_touch(hd, session);
         return ESP_OK;
     }
     return ESP_ERR_NOT_FOUND;
 }
 
+esp_err_t httpd_sess_set_async(httpd_handle_t handle, int sockfd, bool async)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct sock_db *session = httpd_sess_get(handle, sockfd);
+    if (!session) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    session->for_async_req = async;
+    return ESP_OK;
+}
+
 esp_err_t httpd_sess_close_lru(struct httpd_data *hd)
 {
-    enum_context_t context = {
-        .task = HTTPD_TASK_FIND_LOWEST_LRU,
-        .lru_counter = UINT64_MAX,
-        .fd = -1
-    };
-    httpd_sess_enum(hd, enum_function, &context);
-    if (!context.session) {
+    // Walk from the least recently used session, only close sockets that are not in use
+    struct sock_db *session = hd->hd_sd_lru_head;
+    while (session && session->for_async_req) {
+        session = session->lru_next;
+    }
+    if (!session) {
         return ESP_OK;
     }
-    ESP_LOGD(TAG, LOG_FMT("Closing session with fd %d"), context.session->fd);
-    context.session->lru_socket = true;
-    return httpd_sess_trigger_close_(hd, context.session);
+    ESP_LOGD(TAG, LOG_FMT("Closing session with fd %d"), session->fd);
+    session->lru_socket = true;
+    return httpd_sess_trigger_close_(hd, session);
 }
 
 esp_err_t httpd_sess_trigger_close_(httpd_handle_t handle, struct sock_db *session)
@@ -11,6 +11,7 @@
 
 #include <esp_http_server.h>
 #include "esp_httpd_priv.h"
+#include "esp_metrics.h"
 #include <netinet/tcp.h>
 
 static const char *TAG = "httpd_txrx";
@@ -409,6 +410,101 @@ esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len
     return ESP_OK;
 }
 
+esp_err_t httpd_resp_send_partition(httpd_req_t *r, const esp_partition_t *partition, size_t offset, size_t len)
+{
+    if (r == NULL || partition == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!httpd_valid_req(r)) {
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+
+    if (offset > partition->size || len > partition->size - offset) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (len == 0) {
+        return httpd_resp_send(r, NULL, 0);
+    }
+
+    const void *data = NULL;
+    esp_partition_mmap_handle_t map_handle;
+    esp_err_t ret = esp_partition_mmap(partition, offset, len, ESP_PARTITION_MMAP_DATA, &data, &map_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, LOG_FMT("failed to mmap partition region (0x%x)"), ret);
+        return ret;
+    }
+
+    /* The mapped region is passed to the socket layer as is, which
+     * avoids staging the content in an intermediate buffer */
+    ret = httpd_resp_send(r, (const char *) data, len);
+    esp_partition_munmap(map_handle);
+    return ret;
+}
+
+/* The metrics are exported in many small pieces, which are gathered
+ * here so that each chunk of the response fills a TCP segment */
+typedef struct {
+    httpd_req_t *req;
+    size_t len;
+    char buf[256];
+} metrics_chunk_t;
+
+static esp_err_t metrics_flush(metrics_chunk_t *chunk)
+{
+    esp_err_t ret = (chunk->len > 0) ? httpd_resp_send_chunk(chunk->req, chunk->buf, chunk->len) : ESP_OK;
+    chunk->len = 0;
+    return ret;
+}
+
+static esp_err_t metrics_write(const void *data, size_t len, void *arg)
+{
+    metrics_chunk_t *chunk = arg;
+    while (len > 0) {
+        if (chunk->len == sizeof(chunk->buf)) {
+            esp_err_t ret = metrics_flush(chunk);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+        }
+        size_t n = MIN(len, sizeof(chunk->buf) - chunk->len);
+        memcpy(chunk->buf + chunk->len, data, n);
+        chunk->len += n;
+        data = (const char *) data + n;
+        len -= n;
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_metrics(httpd_req_t *r)
+{
+    if (r == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!httpd_valid_req(r)) {
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+
+    esp_err_t ret = httpd_resp_set_type(r, "text/plain; version=0.0.4");
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    metrics_chunk_t chunk = {
+        .req = r,
+    };
+    ret = esp_metrics_export_prometheus(metrics_write, &chunk);
+    if (ret == ESP_OK) {
+        ret = metrics_flush(&chunk);
+    }
+    if (ret == ESP_OK) {
+        ret = httpd_resp_send_chunk(r, NULL, 0);
+    }
+    return ret;
+}
+
 esp_err_t httpd_resp_send_err(httpd_req_t *req, httpd_err_code_t error, const char *usr_msg)
 {
     esp_err_t ret;
@@ -655,6 +751,23 @@ esp_err_t httpd_req_async_handler_begin(httpd_req_t *r, httpd_req_t **out)
     }
     memcpy(async_aux->resp_hdrs, r_aux->resp_hdrs, hd->config.max_resp_headers * sizeof(struct resp_hdr));
 
+    // Copy request header block, as the original one is freed once the handler returns
+    if (r_aux->scratch != NULL) {
+        async_aux->scratch = malloc(r_aux->scratch_cur_size);
+        if (async_aux->scratch == NULL) {
+            free(async_aux->resp_hdrs);
+            free(async_aux);
+            free(async);
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(async_aux->scratch, r_aux->scratch, r_aux->scratch_cur_size);
+    }
+
+    // The header index is rebuilt on demand for the copied headers
+    async_aux->req_hdrs_index = NULL;
+    async_aux->req_hdrs_index_size = 0;
+    async_aux->req_hdrs_indexed = 0;
+
     // Prevent the main thread from reading the rest of the request after the handler returns.
     r_aux->remaining_len = 0;
 
@@ -678,6 +791,7 @@ esp_err_t httpd_req_async_handler_complete(httpd_req_t *r)
     ra->scratch = NULL;
     ra->scratch_cur_size = 0;
     ra->scratch_size_limit = 0;
+    free(ra->req_hdrs_index);
     free(ra->resp_hdrs);
     free(r->aux);
     free(r);
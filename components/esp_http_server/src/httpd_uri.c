@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -12,9 +12,20 @@
 
 #include <esp_http_server.h>
 #include "esp_httpd_priv.h"
+#if CONFIG_ESP_METRICS_SYSTEM
+#include "esp_metrics.h"
+#include "esp_timer.h"
+#endif
 
 static const char *TAG = "httpd_uri";
 
+#if CONFIG_ESP_METRICS_SYSTEM
+ESP_METRICS_COUNTER_DEFINE(s_requests_metric, "httpd_requests_total", "Requests received by the HTTP servers");
+ESP_METRICS_HISTOGRAM_DEFINE(s_handler_duration_metric, "httpd_handler_duration_us",
+                             "Duration of the URI handlers run in the server task",
+                             1000, 5000, 10000, 50000, 100000, 500000, 1000000);
+#endif
+
 static bool httpd_uri_match_simple(const char *uri1, const char *uri2, size_t len2)
 {
     return strlen(uri1) == len2 &&          // First match lengths
@@ -80,47 +91,147 @@ bool httpd_uri_match_wildcard(const char *template, const char *uri, size_t len)
     }
 }
 
+/* Marks an unused slot of the URI handler index */
+#define HTTPD_URI_INDEX_EMPTY   UINT16_MAX
+
+/* FNV-1a hash of the URI string */
+static uint32_t httpd_uri_hash(const char *uri, size_t len)
+{
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t) uri[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+/* Returns true if the registered URI can only ever match an identical URI
+ * string with the configured matcher, in which case it is kept in the hash
+ * index. Templates of the wildcard matcher and URIs of custom matchers
+ * are matched by walking the fallback list instead. */
+static bool httpd_uri_is_indexable(const struct httpd_data *hd, const char *uri)
+{
+    if (hd->config.uri_match_fn == NULL) {
+        return true;
+    }
+    if (hd->config.uri_match_fn == httpd_uri_match_wildcard) {
+        /* Special characters are only recognized at the end of a template */
+        const size_t len = strlen(uri);
+        const char last = (const char) (len > 0 ? uri[len - 1] : 0);
+        return last != '*' && last != '?';
+    }
+    return false;
+}
+
+/* Rebuilds the URI handler index, must be called whenever hd_calls changes */
+static void httpd_uri_index_rebuild(struct httpd_data *hd)
+{
+    const size_t mask = hd->uri_index_size - 1;
+    for (size_t slot = 0; slot < hd->uri_index_size; slot++) {
+        hd->uri_index[slot] = HTTPD_URI_INDEX_EMPTY;
+    }
+    hd->uri_fallback_count = 0;
+
+    for (uint16_t i = 0; i < hd->config.max_uri_handlers; i++) {
+        if (!hd->hd_calls[i]) {
+            break;
+        }
+        const char *uri = hd->hd_calls[i]->uri;
+        if (httpd_uri_is_indexable(hd, uri)) {
+            /* Linear probing, the index is sized to at least twice
+             * the number of handlers so a free slot always exists */
+            size_t slot = httpd_uri_hash(uri, strlen(uri)) & mask;
+            while (hd->uri_index[slot] != HTTPD_URI_INDEX_EMPTY) {
+                slot = (slot + 1) & mask;
+            }
+            hd->uri_index[slot] = i;
+        } else {
+            /* Fallback list is kept in the order of registration */
+            hd->uri_fallback[hd->uri_fallback_count++] = i;
+        }
+    }
+}
+
+esp_err_t httpd_uri_index_init(struct httpd_data *hd)
+{
+    size_t size = 1;
+    while (size < 2 * (size_t) hd->config.max_uri_handlers) {
+        size <<= 1;
+    }
+    hd->uri_index = malloc(size * sizeof(uint16_t));
+    hd->uri_fallback = calloc(hd->config.max_uri_handlers ? hd->config.max_uri_handlers : 1, sizeof(uint16_t));
+    if (hd->uri_index == NULL || hd->uri_fallback == NULL) {
+        httpd_uri_index_deinit(hd);
+        return ESP_ERR_NO_MEM;
+    }
+    hd->uri_index_size = size;
+    httpd_uri_index_rebuild(hd);
+    return ESP_OK;
+}
+
+void httpd_uri_index_deinit(struct httpd_data *hd)
+{
+    free(hd->uri_index);
+    hd->uri_index = NULL;
+    free(hd->uri_fallback);
+    hd->uri_fallback = NULL;
+    hd->uri_index_size = 0;
+    hd->uri_fallback_count = 0;
+}
+
 /* Find handler with matching URI and method, and set
- * appropriate error code if URI or method not found */
+ * appropriate error code if URI or method not found.
+ *
+ * The result is the same as walking the registered handlers
+ * in the order of registration and returning the first one
+ * whose URI and method match. */
 static httpd_uri_t* httpd_find_uri_handler(struct httpd_data *hd,
                                            const char *uri, size_t uri_len,
                                            httpd_method_t method,
                                            httpd_err_code_t *err)
 {
-    if (err) {
-        *err = HTTPD_404_NOT_FOUND;
-    }
-
-    for (int i = 0; i < hd->config.max_uri_handlers; i++) {
-        if (!hd->hd_calls[i]) {
-            break;
+    uint16_t match = HTTPD_URI_INDEX_EMPTY;
+    bool uri_found = false;
+
+    /* Look up handlers registered for this exact URI first */
+    const size_t mask = hd->uri_index_size - 1;
+    size_t slot = httpd_uri_hash(uri, uri_len) & mask;
+    for (; hd->uri_index[slot] != HTTPD_URI_INDEX_EMPTY; slot = (slot + 1) & mask) {
+        const uint16_t i = hd->uri_index[slot];
+        if (!httpd_uri_match_simple(hd->hd_calls[i]->uri, uri, uri_len)) {
+            continue;
         }
         ESP_LOGD(TAG, LOG_FMT("[%d] = %s"), i, hd->hd_calls[i]->uri);
+        if (hd->hd_calls[i]->method == method || hd->hd_calls[i]->method == HTTP_ANY) {
+            if (i < match) {
+                match = i;
+            }
+        } else {
+            uri_found = true;
+        }
+    }
 
-        /* Check if custom URI matching function is set,
-         * else use simple string compare */
-        if (hd->config.uri_match_fn ?
-            hd->config.uri_match_fn(hd->hd_calls[i]->uri, uri, uri_len) :
-            httpd_uri_match_simple(hd->hd_calls[i]->uri, uri, uri_len)) {
-            /* URIs match. Now check if method is supported */
+    /* Only handlers registered earlier than the exact match can
+     * take precedence over it */
+    for (uint16_t f = 0; f < hd->uri_fallback_count && hd->uri_fallback[f] < match; f++) {
+        const uint16_t i = hd->uri_fallback[f];
+        ESP_LOGD(TAG, LOG_FMT("[%d] = %s"), i, hd->hd_calls[i]->uri);
+        if (hd->config.uri_match_fn(hd->hd_calls[i]->uri, uri, uri_len)) {
             if (hd->hd_calls[i]->method == method || hd->hd_calls[i]->method == HTTP_ANY) {
-                /* Match found! */
-                if (err) {
-                    /* Unset any error that may
-                     * have been set earlier */
-                    *err = 0;
-                }
-                return hd->hd_calls[i];
-            }
-            /* URI found but method not allowed.
-             * If URI is found later then this
-             * error must be set to 0 */
-            if (err) {
-                *err = HTTPD_405_METHOD_NOT_ALLOWED;
+                match = i;
+                break;
             }
+            uri_found = true;
         }
     }
-    return NULL;
+
+    if (err) {
+        /* A URI found with no supported method results in
+         * method not allowed, otherwise URI not found */
+        *err = (match != HTTPD_URI_INDEX_EMPTY) ? 0 :
+               (uri_found ? HTTPD_405_METHOD_NOT_ALLOWED : HTTPD_404_NOT_FOUND);
+    }
+    return (match != HTTPD_URI_INDEX_EMPTY) ? hd->hd_calls[match] : NULL;
 }
 
 esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
@@ -166,6 +277,7 @@ esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
             hd->hd_calls[i]->method   = uri_handler->method;
             hd->hd_calls[i]->handler  = uri_handler->handler;
             hd->hd_calls[i]->user_ctx = uri_handler->user_ctx;
+            hd->hd_calls[i]->run_on_worker = uri_handler->run_on_worker;
 #ifdef CONFIG_HTTPD_WS_SUPPORT
             hd->hd_calls[i]->is_websocket = uri_handler->is_websocket;
             hd->hd_calls[i]->handle_ws_control_frames = uri_handler->handle_ws_control_frames;
@@ -175,6 +287,7 @@ esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
                 hd->hd_calls[i]->supported_subprotocol = NULL;
             }
 #endif
+            httpd_uri_index_rebuild(hd);
             ESP_LOGD(TAG, LOG_FMT("[%d] installed %s"), i, uri_handler->uri);
             return ESP_OK;
         }
@@ -214,6 +327,7 @@ esp_err_t httpd_unregister_uri_handler(httpd_handle_t handle,
             }
             /* Nullify the following non null entry */
             hd->hd_calls[i-1] = NULL;
+            httpd_uri_index_rebuild(hd);
             return ESP_OK;
         }
     }
@@ -254,6 +368,7 @@ esp_err_t httpd_unregister_uri(httpd_handle_t handle, const char *uri)
     for (int k = (i - j); k < i; k++) {
         hd->hd_calls[k] = NULL;
     }
+    httpd_uri_index_rebuild(hd);
 
     if (!found) {
         ESP_LOGW(TAG, LOG_FMT("no handler found for URI %s"), uri);
@@ -273,6 +388,9 @@ void httpd_unregister_all_uri_handlers(struct httpd_data *hd)
         free(hd->hd_calls[i]);
         hd->hd_calls[i] = NULL;
     }
+    if (hd->uri_index) {
+        httpd_uri_index_rebuild(hd);
+    }
 }
 
 esp_err_t httpd_uri(struct httpd_data *hd)
@@ -285,6 +403,9 @@ esp_err_t httpd_uri(struct httpd_data *hd)
     httpd_err_code_t err = 0;
 
     ESP_LOGD(TAG, LOG_FMT("request for %s with type %d"), req->uri, req->method);
+#if CONFIG_ESP_METRICS_SYSTEM
+    esp_metrics_counter_inc(&s_requests_metric);
+#endif
 
     /* URL parser result contains offset and length of path string */
     if (res->field_set & (1 << UF_PATH)) {
@@ -327,8 +448,26 @@ esp_err_t httpd_uri(struct httpd_data *hd)
     }
 #endif
 
+    /* Hand the request off to a worker task, if requested */
+    if (uri->run_on_worker && hd->hd_workers != NULL) {
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+        if (!uri->is_websocket) {
+            return httpd_worker_dispatch(hd, req, uri->handler);
+        }
+#else
+        return httpd_worker_dispatch(hd, req, uri->handler);
+#endif
+    }
+
     /* Invoke handler */
-    if (uri->handler(req) != ESP_OK) {
+#if CONFIG_ESP_METRICS_SYSTEM
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = uri->handler(req);
+    esp_metrics_histogram_observe(&s_handler_duration_metric, MIN(esp_timer_get_time() - start, UINT32_MAX));
+#else
+    esp_err_t ret = uri->handler(req);
+#endif
+    if (ret != ESP_OK) {
         /* Handler returns error, this socket should be closed */
         ESP_LOGW(TAG, LOG_FMT("uri handler execution failed"));
         return ESP_FAIL;
@@ -8,6 +8,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <sys/param.h>
 #include <sys/random.h>
 #include <esp_log.h>
 #include <esp_err.h>
@@ -45,6 +46,11 @@ static const char *TAG="httpd_ws";
 #define HTTPD_WS_MASK_BIT       0x80U
 #define HTTPD_WS_LENGTH_BITS    0x7fU
 
+/* 2 bytes header and 8 bytes length */
+#define HTTPD_WS_MAX_HEADER_LEN      10
+/* Payload length up to which a broadcast frame is copied into a single buffer with its header */
+#define HTTPD_WS_COALESCE_MAX_LEN    1024
+
 /*
  * The magic GUID string used for handshake
  * Please refer to RFC6455 Section 1.3 for more details.
@@ -228,15 +234,44 @@ static esp_err_t httpd_ws_check_req(httpd_req_t *req)
     return ESP_OK;
 }
 
-static esp_err_t httpd_ws_unmask_payload(uint8_t *payload, size_t len, const uint8_t *mask_key)
+/**
+ * @brief Unmasks a part of the payload in place
+ *
+ * @param payload       Part of the payload
+ * @param len           Length of the part
+ * @param mask_key      Mask key of the frame
+ * @param mask_offset   Offset of the part in the payload of the frame
+ */
+static esp_err_t httpd_ws_unmask_payload(uint8_t *payload, size_t len, const uint8_t *mask_key, size_t mask_offset)
 {
     if (len < 1 || !payload) {
         ESP_LOGW(TAG, LOG_FMT("Invalid payload provided"));
         return ESP_ERR_INVALID_ARG;
     }
 
-    for (size_t idx = 0; idx < len; idx++) {
-        payload[idx] = (payload[idx] ^ mask_key[idx % 4]);
+    size_t idx = 0;
+    /* Byte by byte up to a word boundary */
+    for (; idx < len && ((uintptr_t)(payload + idx) & (sizeof(uint32_t) - 1)); idx++) {
+        payload[idx] ^= mask_key[(mask_offset + idx) % 4];
+    }
+    /* Then a word at a time, with the mask key rotated to start at the current offset */
+    if (len - idx >= sizeof(uint32_t)) {
+        uint8_t mask_bytes[4];
+        for (size_t i = 0; i < sizeof(mask_bytes); i++) {
+            mask_bytes[i] = mask_key[(mask_offset + idx + i) % 4];
+        }
+        uint32_t mask_word;
+        memcpy(&mask_word, mask_bytes, sizeof(mask_word));
+        for (; len - idx >= sizeof(uint32_t); idx += sizeof(uint32_t)) {
+            uint32_t word;
+            memcpy(&word, payload + idx, sizeof(word));
+            word ^= mask_word;
+            memcpy(payload + idx, &word, sizeof(word));
+        }
+    }
+    /* And the remaining bytes */
+    for (; idx < len; idx++) {
+        payload[idx] ^= mask_key[(mask_offset + idx) % 4];
     }
 
     return ESP_OK;
@@ -319,6 +354,8 @@ esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *frame, size_t
             ESP_LOGW(TAG, LOG_FMT("WS frame is not properly masked."));
             return ESP_ERR_INVALID_STATE;
         }
+        aux->ws_payload_left = frame->len;
+        aux->ws_payload_offset = 0;
     }
     /* We only accept the incoming packet length that is smaller than the max_len (or it will overflow the buffer!) */
     /* If max_len is 0, regard it OK for userspace to get frame len */
@@ -358,30 +395,70 @@ esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *frame, size_t
     }
 
     /* Unmask payload */
-    httpd_ws_unmask_payload(frame->payload, frame->len, aux->mask_key);
+    httpd_ws_unmask_payload(frame->payload, frame->len, aux->mask_key, 0);
+    aux->ws_payload_left = 0;
 
     return ESP_OK;
 }
 
-esp_err_t httpd_ws_send_frame(httpd_req_t *req, httpd_ws_frame_t *frame)
+esp_err_t httpd_ws_recv_frame_part(httpd_req_t *req, uint8_t *buf, size_t buf_len, size_t *received)
 {
     esp_err_t ret = httpd_ws_check_req(req);
     if (ret != ESP_OK) {
         return ret;
     }
-    return httpd_ws_send_frame_async(req->handle, httpd_req_to_sockfd(req), frame);
-}
 
-esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
-{
-    if (!frame) {
+    struct httpd_req_aux *aux = req->aux;
+    if (aux == NULL || buf == NULL || buf_len == 0 || received == NULL) {
         ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
         return ESP_ERR_INVALID_ARG;
     }
 
-    /* Prepare Tx buffer - maximum length is 14, which includes 2 bytes header, 8 bytes length, 4 bytes mask key */
-    uint8_t tx_len = 0;
-    uint8_t header_buf[10] = {0 };
+    *received = 0;
+    if (aux->ws_payload_left == 0) {
+        /* The whole payload has been received, or httpd_ws_recv_frame() has not been called */
+        return ESP_OK;
+    }
+
+    size_t len = MIN(buf_len, aux->ws_payload_left);
+    while (*received < len) {
+        int read_len = httpd_recv_with_opt(req, (char *)buf + *received, len - *received, false);
+        if (read_len <= 0) {
+            ESP_LOGW(TAG, LOG_FMT("Failed to receive payload"));
+            return ESP_FAIL;
+        }
+        *received += read_len;
+    }
+
+    /* Unmask in place, the mask key continues from where the previous part ended */
+    httpd_ws_unmask_payload(buf, len, aux->mask_key, aux->ws_payload_offset);
+    aux->ws_payload_offset += len;
+    aux->ws_payload_left -= len;
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_ws_send_frame(httpd_req_t *req, httpd_ws_frame_t *frame)
+{
+    esp_err_t ret = httpd_ws_check_req(req);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return httpd_ws_send_frame_async(req->handle, httpd_req_to_sockfd(req), frame);
+}
+
+/**
+ * @brief Encodes the header of a frame
+ *
+ * @param frame         Frame to be sent
+ * @param header_buf    Buffer of HTTPD_WS_MAX_HEADER_LEN bytes receiving the header
+ * @return Length of the header
+ */
+static size_t httpd_ws_encode_header(const httpd_ws_frame_t *frame, uint8_t *header_buf)
+{
+    /* Header length is 2 bytes header and up to 8 bytes length, no mask key is sent by the server */
+    size_t tx_len = 0;
+    memset(header_buf, 0, HTTPD_WS_MAX_HEADER_LEN);
     /* Set the `FIN` bit by default if message is not fragmented. Else, set it as per the `final` field */
     header_buf[0] |= (!frame->fragmented) ? HTTPD_WS_FIN_BIT : (frame->final? HTTPD_WS_FIN_BIT: HTTPD_WS_CONTINUE);
     header_buf[0] |= frame->type; /* Type (opcode): 4 bits */
@@ -410,13 +487,19 @@ esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t
     /* WebSocket server does not required to mask response payload, so leave the MASK bit as 0. */
     header_buf[1] &= (~HTTPD_WS_MASK_BIT);
 
+    return tx_len;
+}
+
+static esp_err_t httpd_ws_send_encoded(httpd_handle_t hd, int fd, const uint8_t *header_buf, size_t header_len,
+                                       const httpd_ws_frame_t *frame)
+{
     struct sock_db *sess = httpd_sess_get(hd, fd);
     if (!sess) {
         return ESP_ERR_INVALID_ARG;
     }
 
     /* Send off header */
-    if (sess->send_fn(hd, fd, (const char *)header_buf, tx_len, 0) < 0) {
+    if (sess->send_fn(hd, fd, (const char *)header_buf, header_len, 0) < 0) {
         ESP_LOGW(TAG, LOG_FMT("Failed to send WS header"));
         return ESP_FAIL;
     }
@@ -432,6 +515,64 @@ esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t
     return ESP_OK;
 }
 
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
+{
+    if (!frame) {
+        ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t header_buf[HTTPD_WS_MAX_HEADER_LEN];
+    size_t tx_len = httpd_ws_encode_header(frame, header_buf);
+
+    return httpd_ws_send_encoded(hd, fd, header_buf, tx_len, frame);
+}
+
+esp_err_t httpd_ws_send_frame_to_clients(httpd_handle_t hd, const int *fds, size_t fds_count, httpd_ws_frame_t *frame)
+{
+    if (!frame || !fds) {
+        ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t header_buf[HTTPD_WS_MAX_HEADER_LEN];
+    size_t header_len = httpd_ws_encode_header(frame, header_buf);
+
+    /* Small frames are encoded once into a single buffer, so that each client costs a single send */
+    uint8_t *frame_buf = NULL;
+    size_t payload_len = frame->payload ? frame->len : 0;
+    if (payload_len > 0 && payload_len <= HTTPD_WS_COALESCE_MAX_LEN) {
+        frame_buf = malloc(header_len + payload_len);
+        if (frame_buf) {
+            memcpy(frame_buf, header_buf, header_len);
+            memcpy(frame_buf + header_len, frame->payload, payload_len);
+        }
+    }
+
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < fds_count; i++) {
+        if (httpd_ws_get_fd_info(hd, fds[i]) != HTTPD_WS_CLIENT_WEBSOCKET) {
+            ESP_LOGD(TAG, LOG_FMT("fd %d is not an active WebSocket client"), fds[i]);
+            ret = ESP_FAIL;
+            continue;
+        }
+        esp_err_t err;
+        if (frame_buf) {
+            struct sock_db *sess = httpd_sess_get(hd, fds[i]);
+            err = sess->send_fn(hd, fds[i], (const char *)frame_buf, header_len + payload_len, 0) < 0 ? ESP_FAIL : ESP_OK;
+        } else {
+            err = httpd_ws_send_encoded(hd, fds[i], header_buf, header_len, frame);
+        }
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, LOG_FMT("Failed to send WS frame to fd %d"), fds[i]);
+            ret = ESP_FAIL;
+        }
+    }
+
+    free(frame_buf);
+    return ret;
+}
+
 esp_err_t httpd_ws_get_frame_type(httpd_req_t *req)
 {
     esp_err_t ret = httpd_ws_check_req(req);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,7 @@
 #include <stdbool.h>
 #include <esp_system.h>
 #include <esp_http_server.h>
+#include <esp_timer.h>
 
 #include "unity.h"
 #include "test_utils.h"
@@ -225,6 +226,39 @@ TEST_CASE("URI Wildcard Matcher Tests", "[HTTP SERVER]")
     }
 }
 
+TEST_CASE("Accept-Encoding Matcher Tests", "[HTTP SERVER]")
+{
+    struct enctest {
+        const char *accept_encoding;
+        const char *encoding;
+        bool acceptable;
+    };
+
+    struct enctest encs[] = {
+        {"gzip, deflate, br", "gzip", true},
+        {"gzip, deflate, br", "br", true},
+        {"deflate", "gzip", false},
+        {"GZIP ; q=1.0", "gzip", true},
+        {"x-gzip, gzip;q=0.5", "gzip", true},
+        {"br;q=0.000", "br", false},
+        {"br;q=0.001", "br", true},
+        {"gzip;q=0, *", "gzip", false},
+        {"*", "br", true},
+        {"*;q=0", "gzip", false},
+        {"", "identity", true},
+        {"identity;q=0", "identity", false},
+        {"*;q=0", "identity", false},
+        {}
+    };
+
+    struct enctest *et = &encs[0];
+
+    while (et->accept_encoding != 0) {
+        TEST_ASSERT(httpd_encoding_is_acceptable(et->accept_encoding, et->encoding) == et->acceptable);
+        et++;
+    }
+}
+
 TEST_CASE("Max Allowed Sockets Test", "[HTTP SERVER]")
 {
     test_case_uses_tcpip();
@@ -244,6 +278,43 @@ TEST_CASE("Max Allowed Sockets Test", "[HTTP SERVER]")
     TEST_ASSERT(httpd_start(&hd, &config) != ESP_OK);
 }
 
+#define HTTPD_TEST_LOOKUP_ITERATIONS    100
+
+TEST_CASE("URI Handler Lookup Benchmark", "[HTTP SERVER]")
+{
+    test_case_uses_tcpip();
+
+    const unsigned handler_counts[] = { 8, 32, 64, 128 };
+    static char uri_str[128][16];
+
+    httpd_handle_t hd;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.max_uri_handlers = 128;
+    TEST_ASSERT(httpd_start(&hd, &config) == ESP_OK);
+
+    unsigned registered = 0;
+    for (int c = 0; c < sizeof(handler_counts) / sizeof(handler_counts[0]); c++) {
+        for (; registered < handler_counts[c]; registered++) {
+            snprintf(uri_str[registered], sizeof(uri_str[registered]), "/api/v1/%u", registered);
+            httpd_uri_t uri = handler_limit_uri(uri_str[registered]);
+            TEST_ASSERT(httpd_register_uri_handler(hd, &uri) == ESP_OK);
+        }
+
+        /* Registering an already registered URI fails after a full
+         * handler lookup, which makes it a measure of the match cost */
+        httpd_uri_t last = handler_limit_uri(uri_str[registered - 1]);
+        int64_t start = esp_timer_get_time();
+        for (int i = 0; i < HTTPD_TEST_LOOKUP_ITERATIONS; i++) {
+            TEST_ASSERT(httpd_register_uri_handler(hd, &last) == ESP_ERR_HTTPD_HANDLER_EXISTS);
+        }
+        int64_t elapsed = esp_timer_get_time() - start;
+        IDF_LOG_PERFORMANCE("httpd_uri_lookup", "%d ns, handlers: %u",
+                            (int)(elapsed * 1000 / HTTPD_TEST_LOOKUP_ITERATIONS), handler_counts[c]);
+    }
+
+    TEST_ASSERT(httpd_stop(hd) == ESP_OK);
+}
+
 void app_main(void)
 {
     unity_run_menu();
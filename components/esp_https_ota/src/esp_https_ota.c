@@ -15,6 +15,10 @@
 #include <inttypes.h>
 #include "esp_check.h"
 #include "hal/efuse_hal.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 
 ESP_EVENT_DEFINE_BASE(ESP_HTTPS_OTA_EVENT);
 
@@ -32,6 +36,21 @@ static const int DEFAULT_MAX_AUTH_RETRIES = 10;
 
 static const char *TAG = "esp_https_ota";
 
+#define PIPELINE_BUF_COUNT CONFIG_ESP_HTTPS_OTA_PIPELINE_BUF_COUNT
+
+typedef enum {
+    PIPELINE_JOB_WRITE,
+    PIPELINE_JOB_FLUSH,     /* gives `done` once the jobs queued before it have been written */
+    PIPELINE_JOB_STOP,      /* like PIPELINE_JOB_FLUSH, then the writer task deletes itself */
+} pipeline_job_type_t;
+
+typedef struct {
+    pipeline_job_type_t type;
+    char *buf;              /* receive buffer to give back once written, NULL if the data is in a separate buffer */
+    const void *data;
+    size_t len;
+} pipeline_job_t;
+
 typedef enum {
     ESP_HTTPS_OTA_INIT,
     ESP_HTTPS_OTA_BEGIN,
@@ -56,7 +75,18 @@ struct esp_https_ota_handle {
     esp_https_ota_state state;
     bool bulk_flash_erase;
     bool partial_http_download;
+    bool ota_resumption;                      /*!< The written length is reported for resumption, so it must be in flash */
     int max_authorization_retries;
+    struct {                                  /*!< Writer task used if pipelined_write is enabled */
+        bool enabled;
+        char *bufs[PIPELINE_BUF_COUNT];       /*!< Receive buffers, bufs[0] is ota_upgrade_buf */
+        QueueHandle_t free_bufs;              /*!< Receive buffers which are not being received into or written */
+        QueueHandle_t jobs;                   /*!< pipeline_job_t for the writer task */
+        SemaphoreHandle_t done;
+        TaskHandle_t task;
+        volatile esp_err_t write_err;         /*!< First error returned by esp_ota_write, later data is dropped */
+        volatile int written_len;
+    } pipeline;
 #if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
     decrypt_cb_t decrypt_cb;
     void *decrypt_user_ctx;
@@ -248,12 +278,22 @@ static void esp_https_ota_decrypt_cb_free_buf(void *buffer)
 }
 #endif // CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
 
+static esp_err_t ota_write_data(esp_https_ota_t *handle, const void *buffer, size_t buf_len)
+{
+    esp_err_t err = esp_ota_write(handle->update_handle, buffer, buf_len);
+    if (err == ESP_OK && handle->ota_resumption) {
+        // the reported length may be stored to resume from, esp_ota_write must not keep the data buffered
+        err = esp_ota_flush(handle->update_handle);
+    }
+    return err;
+}
+
 static esp_err_t _ota_write(esp_https_ota_t *https_ota_handle, const void *buffer, size_t buf_len)
 {
     if (buffer == NULL || https_ota_handle == NULL) {
         return ESP_FAIL;
     }
-    esp_err_t err = esp_ota_write(https_ota_handle->update_handle, buffer, buf_len);
+    esp_err_t err = ota_write_data(https_ota_handle, buffer, buf_len);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error: esp_ota_write failed! err=0x%x", err);
     } else {
@@ -269,6 +309,143 @@ static esp_err_t _ota_write(esp_https_ota_t *https_ota_handle, const void *buffe
     return err;
 }
 
+static void ota_pipeline_task(void *arg)
+{
+    esp_https_ota_t *handle = (esp_https_ota_t *)arg;
+    pipeline_job_t job;
+
+    while (true) {
+        xQueueReceive(handle->pipeline.jobs, &job, portMAX_DELAY);
+        if (job.type != PIPELINE_JOB_WRITE) {
+            xSemaphoreGive(handle->pipeline.done);
+            if (job.type == PIPELINE_JOB_STOP) {
+                vTaskDelete(NULL);
+            }
+            continue;
+        }
+
+        if (handle->pipeline.write_err == ESP_OK) {
+            esp_err_t err = ota_write_data(handle, job.data, job.len);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Error: esp_ota_write failed! err=0x%x", err);
+                handle->pipeline.write_err = err;
+            } else {
+                handle->pipeline.written_len += job.len;
+                ESP_LOGD(TAG, "Written image length %d", handle->pipeline.written_len);
+                int written_len = handle->pipeline.written_len;
+                esp_https_ota_dispatch_event(ESP_HTTPS_OTA_WRITE_FLASH, (void *)(&written_len), sizeof(int));
+            }
+        }
+#if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
+        esp_https_ota_decrypt_cb_free_buf((void *) job.data);
+#endif
+        if (job.buf != NULL) {
+            xQueueSend(handle->pipeline.free_bufs, &job.buf, portMAX_DELAY);
+        }
+    }
+}
+
+static esp_err_t ota_pipeline_init(esp_https_ota_t *handle, size_t buf_size, uint32_t buffer_caps)
+{
+    handle->pipeline.bufs[0] = handle->ota_upgrade_buf;
+    handle->pipeline.free_bufs = xQueueCreate(PIPELINE_BUF_COUNT, sizeof(char *));
+    handle->pipeline.jobs = xQueueCreate(PIPELINE_BUF_COUNT + 1, sizeof(pipeline_job_t));
+    handle->pipeline.done = xSemaphoreCreateBinary();
+    if (!handle->pipeline.free_bufs || !handle->pipeline.jobs || !handle->pipeline.done) {
+        return ESP_ERR_NO_MEM;
+    }
+    // ota_upgrade_buf still holds the image header, it is given to the writer when the header is written
+    for (int i = 1; i < PIPELINE_BUF_COUNT; i++) {
+        handle->pipeline.bufs[i] = (buffer_caps != 0) ? heap_caps_malloc(buf_size, buffer_caps) : malloc(buf_size);
+        if (!handle->pipeline.bufs[i]) {
+            return ESP_ERR_NO_MEM;
+        }
+        xQueueSend(handle->pipeline.free_bufs, &handle->pipeline.bufs[i], 0);
+    }
+    if (xTaskCreate(ota_pipeline_task, "ota_pipeline", CONFIG_ESP_HTTPS_OTA_PIPELINE_TASK_STACK_SIZE, handle,
+                    CONFIG_ESP_HTTPS_OTA_PIPELINE_TASK_PRIORITY, &handle->pipeline.task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    handle->pipeline.enabled = true;
+    return ESP_OK;
+}
+
+/* Queue a PIPELINE_JOB_FLUSH or PIPELINE_JOB_STOP job and wait until the writer task has got to it */
+static void ota_pipeline_wait(esp_https_ota_t *handle, pipeline_job_type_t type)
+{
+    pipeline_job_t job = { .type = type };
+    xQueueSend(handle->pipeline.jobs, &job, portMAX_DELAY);
+    xSemaphoreTake(handle->pipeline.done, portMAX_DELAY);
+}
+
+/* Stop the writer task if it is running and free everything allocated by ota_pipeline_init except ota_upgrade_buf */
+static void ota_pipeline_deinit(esp_https_ota_t *handle)
+{
+    if (handle->pipeline.enabled) {
+        ota_pipeline_wait(handle, PIPELINE_JOB_STOP);
+        handle->pipeline.enabled = false;
+    }
+    for (int i = 1; i < PIPELINE_BUF_COUNT; i++) {
+        free(handle->pipeline.bufs[i]);
+        handle->pipeline.bufs[i] = NULL;
+    }
+    if (handle->pipeline.free_bufs) {
+        vQueueDelete(handle->pipeline.free_bufs);
+        handle->pipeline.free_bufs = NULL;
+    }
+    if (handle->pipeline.jobs) {
+        vQueueDelete(handle->pipeline.jobs);
+        handle->pipeline.jobs = NULL;
+    }
+    if (handle->pipeline.done) {
+        vSemaphoreDelete(handle->pipeline.done);
+        handle->pipeline.done = NULL;
+    }
+}
+
+/* Buffer to receive the next image data into, waits until the writer task has given one back if pipelined */
+static char *ota_get_buf(esp_https_ota_t *handle)
+{
+    char *buf = handle->ota_upgrade_buf;
+    if (handle->pipeline.enabled) {
+        xQueueReceive(handle->pipeline.free_bufs, &buf, portMAX_DELAY);
+    }
+    return buf;
+}
+
+static void ota_put_buf(esp_https_ota_t *handle, char *buf)
+{
+    if (handle->pipeline.enabled) {
+        xQueueSend(handle->pipeline.free_bufs, &buf, portMAX_DELAY);
+    }
+}
+
+/*
+ * Write image data which was received into `buf`. If pipelined, the data is queued for the writer task instead and
+ * `buf` is given back once it has been written.
+ */
+static esp_err_t ota_write_buf(esp_https_ota_t *handle, char *buf, const void *data, size_t len)
+{
+    if (!handle->pipeline.enabled) {
+        return _ota_write(handle, data, len);
+    }
+
+    pipeline_job_t job = {
+        .type = PIPELINE_JOB_WRITE,
+        .buf = buf,
+        .data = data,
+        .len = len,
+    };
+    if (data != buf) {
+        // decrypted into a separate buffer, which the writer task frees
+        job.buf = NULL;
+        ota_put_buf(handle, buf);
+    }
+    xQueueSend(handle->pipeline.jobs, &job, portMAX_DELAY);
+    handle->binary_file_len += len;
+    return ESP_ERR_HTTPS_OTA_IN_PROGRESS;
+}
+
 static bool is_server_verification_enabled(const esp_https_ota_config_t *ota_config) {
     return  (ota_config->http_config->cert_pem
             || ota_config->http_config->use_global_ca_store
@@ -317,6 +494,7 @@ esp_err_t esp_https_ota_begin(const esp_https_ota_config_t *ota_config, esp_http
     }
 
     https_ota_handle->partial_http_download = ota_config->partial_http_download;
+    https_ota_handle->ota_resumption = ota_config->ota_resumption;
     https_ota_handle->max_http_request_size = (ota_config->max_http_request_size == 0) ? DEFAULT_REQUEST_SIZE : ota_config->max_http_request_size;
     https_ota_handle->max_authorization_retries = ota_config->http_config->max_authorization_retries;
 
@@ -495,6 +673,15 @@ esp_err_t esp_https_ota_begin(const esp_https_ota_config_t *ota_config, esp_http
 #endif
     https_ota_handle->ota_upgrade_buf_size = alloc_size;
     https_ota_handle->bulk_flash_erase = ota_config->bulk_flash_erase;
+    if (ota_config->pipelined_write) {
+        err = ota_pipeline_init(https_ota_handle, alloc_size, ota_config->buffer_caps);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Couldn't allocate memory for pipelined write");
+            ota_pipeline_deinit(https_ota_handle);
+            free(https_ota_handle->ota_upgrade_buf);
+            goto http_cleanup;
+        }
+    }
     *handle = (esp_https_ota_handle_t)https_ota_handle;
     https_ota_handle->state = https_ota_handle->binary_file_len ? ESP_HTTPS_OTA_RESUME : ESP_HTTPS_OTA_BEGIN;
     return ESP_OK;
@@ -576,6 +763,14 @@ static esp_err_t get_description_from_image(esp_https_ota_handle_t https_ota_han
     void *img_info = NULL;
 
     if (handle->binary_file_len >= offset + img_info_len) {
+        if (handle->pipeline.enabled && handle->state == ESP_HTTPS_OTA_IN_PROGRESS) {
+            // the data must have been written, and ota_upgrade_buf must not be used by the writer task
+            ota_pipeline_wait(handle, PIPELINE_JOB_FLUSH);
+        }
+        if (handle->state == ESP_HTTPS_OTA_IN_PROGRESS) {
+            // the description may still be in the esp_ota_write buffer
+            ESP_RETURN_ON_ERROR(esp_ota_flush(handle->update_handle), TAG, "OTA flush failed");
+        }
         esp_err_t ret = esp_partition_read(handle->partition.staging, offset, handle->ota_upgrade_buf, img_info_len);
         ESP_RETURN_ON_ERROR(ret, TAG, "partition read failed %d", ret);
         img_info = (void *) handle->ota_upgrade_buf;
@@ -707,7 +902,7 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
                     return err;
                 }
             }
-            return _ota_write(handle, data_buf, binary_file_len);
+            return ota_write_buf(handle, handle->ota_upgrade_buf, data_buf, binary_file_len);
         case ESP_HTTPS_OTA_RESUME:
             ESP_LOGD(TAG, "OTA resumption case");
             err = esp_ota_resume(handle->partition.staging, erase_size, handle->binary_file_len, &handle->update_handle);
@@ -717,11 +912,20 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
             }
             esp_ota_set_final_partition(handle->update_handle, handle->partition.final, handle->partition.finalize_with_copy);
             handle->state = ESP_HTTPS_OTA_IN_PROGRESS;
+            handle->pipeline.written_len = handle->binary_file_len;
+            // no image header to write, so ota_upgrade_buf can be received into right away
+            ota_put_buf(handle, handle->ota_upgrade_buf);
             /* falls through */
-        case ESP_HTTPS_OTA_IN_PROGRESS:
-            data_read = esp_http_client_read(handle->http_client,
-                                             handle->ota_upgrade_buf,
-                                             handle->ota_upgrade_buf_size);
+        case ESP_HTTPS_OTA_IN_PROGRESS: {
+            char *buf = ota_get_buf(handle);
+            if (handle->pipeline.write_err != ESP_OK) {
+                ota_put_buf(handle, buf);
+                return handle->pipeline.write_err;
+            }
+            data_read = esp_http_client_read(handle->http_client, buf, handle->ota_upgrade_buf_size);
+            if (data_read <= 0) {
+                ota_put_buf(handle, buf);
+            }
             if (data_read == 0) {
                 /*
                  *  esp_http_client_is_complete_data_received is added to check whether
@@ -733,21 +937,22 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
                 }
                 ESP_LOGD(TAG, "Connection closed");
             } else if (data_read > 0) {
-                const void *data_buf = (const void *) handle->ota_upgrade_buf;
+                const void *data_buf = (const void *) buf;
                 int data_len = data_read;
 #if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
                 decrypt_cb_arg_t args = {};
-                args.data_in = handle->ota_upgrade_buf;
+                args.data_in = buf;
                 args.data_in_len = data_read;
                 err = esp_https_ota_decrypt_cb(handle, &args);
                 if (err == ESP_OK) {
                     data_buf = args.data_out;
                     data_len = args.data_out_len;
                 } else {
+                    ota_put_buf(handle, buf);
                     return err;
                 }
 #endif // CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
-                return _ota_write(handle, data_buf, data_len);
+                return ota_write_buf(handle, buf, data_buf, data_len);
             } else {
                 if (data_read == -ESP_ERR_HTTP_EAGAIN) {
                     ESP_LOGD(TAG, "ESP_ERR_HTTP_EAGAIN invoked: Call timed out before data was ready");
@@ -760,6 +965,7 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
                 handle->state = ESP_HTTPS_OTA_SUCCESS;
             }
             break;
+        }
          default:
             ESP_LOGE(TAG, "Invalid ESP HTTPS OTA State");
             return ESP_FAIL;
@@ -818,11 +1024,19 @@ esp_err_t esp_https_ota_finish(esp_https_ota_handle_t https_ota_handle)
         return ESP_FAIL;
     }
 
+    // wait for the queued data to be written
+    ota_pipeline_deinit(handle);
+
     esp_err_t err = ESP_OK;
     switch (handle->state) {
         case ESP_HTTPS_OTA_SUCCESS:
         case ESP_HTTPS_OTA_IN_PROGRESS:
-            err = esp_ota_end(handle->update_handle);
+            if (handle->pipeline.write_err != ESP_OK) {
+                esp_ota_abort(handle->update_handle);
+                err = handle->pipeline.write_err;
+            } else {
+                err = esp_ota_end(handle->update_handle);
+            }
             /* falls through */
         case ESP_HTTPS_OTA_BEGIN:
         case ESP_HTTPS_OTA_RESUME:
@@ -869,6 +1083,8 @@ esp_err_t esp_https_ota_abort(esp_https_ota_handle_t https_ota_handle)
         return ESP_FAIL;
     }
 
+    ota_pipeline_deinit(handle);
+
     esp_err_t err = ESP_OK;
     switch (handle->state) {
         case ESP_HTTPS_OTA_SUCCESS:
@@ -911,6 +1127,10 @@ int esp_https_ota_get_image_len_read(esp_https_ota_handle_t https_ota_handle)
     if (handle->state < ESP_HTTPS_OTA_IN_PROGRESS) {
         return -1;
     }
+    if (handle->pipeline.enabled) {
+        // only count what has been written, as this is what OTA resumption can continue from
+        return handle->pipeline.written_len;
+    }
     return handle->binary_file_len;
 }
 
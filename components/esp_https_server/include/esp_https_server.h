@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -135,6 +135,16 @@ struct httpd_ssl_config {
 
     /** TLS handshake timeout in milliseconds, default timeout is 10 seconds if not set */
     uint32_t tls_handshake_timeout_ms;
+
+    /** Perform the TLS handshakes of new sessions in separate tasks, so that the server task keeps serving
+     *  the established sessions meanwhile. The tasks use the stack size, priority and core of the server task.
+     *  The open_fn of the server and the HTTPD_SSL_USER_CB_SESS_CREATE user callback are then called from these tasks */
+    bool async_handshake;
+
+    /** Number of tasks performing the TLS handshakes when async_handshake is set (default 1).
+     *  Several tasks let a burst of new sessions complete their handshakes in parallel, e.g. on both cores
+     *  with core_id set to tskNO_AFFINITY, at the cost of one more task stack per handshake task */
+    uint8_t handshake_task_count;
 };
 
 typedef struct httpd_ssl_config httpd_ssl_config_t;
@@ -195,7 +205,9 @@ typedef struct httpd_ssl_config httpd_ssl_config_t;
     .ssl_userdata = NULL,                         \
     .cert_select_cb = NULL,                       \
     .alpn_protos = NULL,                          \
-    .tls_handshake_timeout_ms = 0                 \
+    .tls_handshake_timeout_ms = 0,                \
+    .async_handshake = false,                     \
+    .handshake_task_count = 1,                    \
 }
 
 /**
@@ -1,10 +1,14 @@
 /*
- * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_https_server.h"
 #include "esp_log.h"
 #include "sdkconfig.h"
@@ -16,11 +20,27 @@ typedef struct httpd_ssl_ctx {
     esp_tls_cfg_server_t *tls_cfg;
     httpd_open_func_t open_fn;
     esp_https_server_user_cb *user_cb;
+    QueueHandle_t handshake_queue;      /* Sessions waiting for the handshake tasks, NULL if handshakes run in the server task */
+    SemaphoreHandle_t handshake_lock;   /* Protects the handshake state of the sessions */
+    SemaphoreHandle_t handshake_exit;   /* Given by each handshake task when it exits */
+    uint8_t handshake_tasks;            /* Number of running handshake tasks */
 } httpd_ssl_ctx_t;
 
+typedef enum {
+    HTTPD_SSL_HANDSHAKE_DONE = 0,       /* Handshake finished (successfully or not), or performed in the server task */
+    HTTPD_SSL_HANDSHAKE_QUEUED,         /* Session waits in the queue of the handshake tasks */
+    HTTPD_SSL_HANDSHAKE_RUNNING,        /* A handshake task is working on the session */
+} httpd_ssl_handshake_state_t;
+
 typedef struct httpd_ssl_transport_ctx {
     esp_tls_t *tls;
     httpd_ssl_ctx_t *global_ctx;
+    httpd_handle_t server;
+    int sockfd;
+    httpd_ssl_handshake_state_t state;
+    bool closed;                        /* Session has been closed by the server */
+    bool connected;                     /* Handshake succeeded and the session creation has been reported */
+    SemaphoreHandle_t handshake_done;   /* Given by the handshake task when it is done with a closed session */
 } httpd_ssl_transport_ctx_t;
 
 ESP_EVENT_DEFINE_BASE(ESP_HTTPS_SERVER_EVENT);
@@ -40,6 +60,25 @@ static void http_dispatch_event_to_event_loop(int32_t event_id, const void* even
     }
 }
 
+static void http_dispatch_tls_error(esp_tls_t *tls)
+{
+    esp_tls_error_handle_t error_handle;
+    if (esp_tls_get_error_handle(tls, &error_handle) == ESP_OK) {
+        esp_https_server_last_error_t last_error = {0};
+        last_error.last_error = esp_tls_get_and_clear_last_error(error_handle, &last_error.esp_tls_error_code, &last_error.esp_tls_flags);
+        http_dispatch_event_to_event_loop(HTTPS_SERVER_EVENT_ERROR, &last_error, sizeof(last_error));
+    }
+}
+
+static void httpd_ssl_transport_ctx_free(httpd_ssl_transport_ctx_t *transport_ctx)
+{
+    esp_tls_server_session_delete(transport_ctx->tls);
+    if (transport_ctx->handshake_done) {
+        vSemaphoreDelete(transport_ctx->handshake_done);
+    }
+    free(transport_ctx);
+}
+
 /**
  * SSL socket close handler
  *
@@ -53,6 +92,29 @@ static void httpd_ssl_close(void *ctx)
     httpd_ssl_ctx_t *global_ctx = transport_ctx->global_ctx;
     esp_tls_t *tls = transport_ctx->tls;
 
+    if (global_ctx->handshake_queue) {
+        xSemaphoreTake(global_ctx->handshake_lock, portMAX_DELAY);
+        httpd_ssl_handshake_state_t state = transport_ctx->state;
+        transport_ctx->closed = true;
+        xSemaphoreGive(global_ctx->handshake_lock);
+
+        if (state == HTTPD_SSL_HANDSHAKE_QUEUED) {
+            // The handshake task frees the context when it gets to the session
+            ESP_LOGD(TAG, "Secure socket closed before handshake");
+            return;
+        }
+        if (state == HTTPD_SSL_HANDSHAKE_RUNNING) {
+            // The socket is already closed, so the handshake fails soon
+            xSemaphoreTake(transport_ctx->handshake_done, portMAX_DELAY);
+        }
+    }
+
+    if (!transport_ctx->connected) {
+        httpd_ssl_transport_ctx_free(transport_ctx);
+        ESP_LOGD(TAG, "Secure socket closed before the session was established");
+        return;
+    }
+
     if (global_ctx->user_cb) {
         esp_https_server_user_cb_arg_t user_cb_data = {0};
         user_cb_data.user_cb_state = HTTPD_SSL_USER_CB_SESS_CLOSE;
@@ -60,8 +122,7 @@ static void httpd_ssl_close(void *ctx)
         (global_ctx->user_cb)((void *)&user_cb_data);
     }
 
-    esp_tls_server_session_delete(tls);
-    free(ctx);
+    httpd_ssl_transport_ctx_free(transport_ctx);
     ESP_LOGD(TAG, "Secure socket closed");
     http_dispatch_event_to_event_loop(HTTPS_SERVER_EVENT_DISCONNECTED, NULL, 0);
 }
@@ -77,6 +138,9 @@ static int httpd_ssl_pending(httpd_handle_t server, int sockfd)
 {
     httpd_ssl_transport_ctx_t *transport_ctx = httpd_sess_get_transport_ctx(server, sockfd);
     assert(transport_ctx != NULL);
+    if (!transport_ctx->connected) {
+        return 0;
+    }
     esp_tls_t *tls = transport_ctx->tls;
     assert(tls != NULL);
     int ret = esp_tls_get_bytes_avail(tls);
@@ -105,6 +169,10 @@ static int httpd_ssl_recv(httpd_handle_t server, int sockfd, char *buf, size_t b
 {
     httpd_ssl_transport_ctx_t *transport_ctx = httpd_sess_get_transport_ctx(server, sockfd);
     assert(transport_ctx != NULL);
+    if (!transport_ctx->connected) {
+        // Handshake failed in a handshake task
+        return HTTPD_SOCK_ERR_FAIL;
+    }
     esp_tls_t *tls = transport_ctx->tls;
     assert(tls != NULL);
     int ret = esp_tls_conn_read(tls, buf, buf_len);
@@ -135,6 +203,9 @@ static int httpd_ssl_send(httpd_handle_t server, int sockfd, const char *buf, si
 {
     httpd_ssl_transport_ctx_t *transport_ctx = httpd_sess_get_transport_ctx(server, sockfd);
     assert(transport_ctx != NULL);
+    if (!transport_ctx->connected) {
+        return HTTPD_SOCK_ERR_FAIL;
+    }
     esp_tls_t *tls = transport_ctx->tls;
     assert(tls != NULL);
     int ret = esp_tls_conn_write(tls, buf, buf_len);
@@ -151,6 +222,124 @@ static int httpd_ssl_send(httpd_handle_t server, int sockfd, const char *buf, si
     return ret;
 }
 
+/**
+ * Finish opening of a SSL session once the handshake succeeded
+ *
+ * @param transport_ctx
+ */
+static void httpd_ssl_session_connected(httpd_ssl_transport_ctx_t *transport_ctx)
+{
+    httpd_ssl_ctx_t *global_ctx = transport_ctx->global_ctx;
+
+    // all access should now go through SSL
+    ESP_LOGD(TAG, "Secure socket open");
+
+    if (global_ctx->open_fn) {
+        (global_ctx->open_fn)(transport_ctx->server, transport_ctx->sockfd);
+    }
+
+    if (global_ctx->user_cb) {
+        esp_https_server_user_cb_arg_t user_cb_data = {0};
+        user_cb_data.user_cb_state = HTTPD_SSL_USER_CB_SESS_CREATE;
+        user_cb_data.tls = transport_ctx->tls;
+        (global_ctx->user_cb)((void *)&user_cb_data);
+    }
+    transport_ctx->connected = true;
+    http_dispatch_event_to_event_loop(HTTPS_SERVER_EVENT_ON_CONNECTED, NULL, 0);
+}
+
+static void httpd_ssl_wakeup(void *arg)
+{
+    // Nothing to do, the control message only unblocks the server task,
+    // so that the session released by the handshake task gets polled
+}
+
+typedef struct {
+    httpd_handle_t server;
+    int sockfd;
+} httpd_ssl_failed_session_t;
+
+static void httpd_ssl_close_failed(void *arg)
+{
+    // Runs in the server task, which owns the LRU list of the sessions
+    httpd_ssl_failed_session_t *failed = arg;
+    // The server skips closing of sessions which never exchanged data
+    httpd_sess_update_lru_counter(failed->server, failed->sockfd);
+    httpd_sess_trigger_close(failed->server, failed->sockfd);
+    free(failed);
+}
+
+/**
+ * Perform the handshake of a session handed over by httpd_ssl_open, runs in one of the handshake tasks
+ *
+ * @param transport_ctx
+ */
+static void httpd_ssl_handshake(httpd_ssl_transport_ctx_t *transport_ctx)
+{
+    httpd_ssl_ctx_t *global_ctx = transport_ctx->global_ctx;
+
+    xSemaphoreTake(global_ctx->handshake_lock, portMAX_DELAY);
+    bool closed = transport_ctx->closed;
+    transport_ctx->state = HTTPD_SSL_HANDSHAKE_RUNNING;
+    xSemaphoreGive(global_ctx->handshake_lock);
+    if (closed) {
+        // The server does not refer to the session anymore
+        httpd_ssl_transport_ctx_free(transport_ctx);
+        return;
+    }
+
+    ESP_LOGI(TAG, "performing session handshake");
+    int ret = esp_tls_server_session_create(global_ctx->tls_cfg, transport_ctx->sockfd, transport_ctx->tls);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "esp_tls_create_server_session failed, 0x%04x", -ret);
+        http_dispatch_tls_error(transport_ctx->tls);
+    } else {
+        httpd_ssl_session_connected(transport_ctx);
+    }
+
+    xSemaphoreTake(global_ctx->handshake_lock, portMAX_DELAY);
+    transport_ctx->state = HTTPD_SSL_HANDSHAKE_DONE;
+    if (transport_ctx->closed) {
+        // httpd_ssl_close waits for the handshake to finish
+        xSemaphoreGive(transport_ctx->handshake_done);
+    } else if (ret != 0) {
+        httpd_ssl_failed_session_t *failed = malloc(sizeof(httpd_ssl_failed_session_t));
+        if (failed) {
+            failed->server = transport_ctx->server;
+            failed->sockfd = transport_ctx->sockfd;
+            if (httpd_queue_work(transport_ctx->server, httpd_ssl_close_failed, failed) != ESP_OK) {
+                free(failed);
+                failed = NULL;
+            }
+        }
+        if (!failed) {
+            // Leave the session to the server, the next read from it fails and deletes it
+            ESP_LOGW(TAG, "Could not queue closing of the failed session");
+            httpd_sess_set_async(transport_ctx->server, transport_ctx->sockfd, false);
+        }
+    } else {
+        httpd_sess_set_async(transport_ctx->server, transport_ctx->sockfd, false);
+        httpd_queue_work(transport_ctx->server, httpd_ssl_wakeup, NULL);
+    }
+    xSemaphoreGive(global_ctx->handshake_lock);
+}
+
+static void httpd_ssl_handshake_task(void *arg)
+{
+    httpd_ssl_ctx_t *global_ctx = arg;
+    httpd_ssl_transport_ctx_t *transport_ctx;
+
+    while (xQueueReceive(global_ctx->handshake_queue, &transport_ctx, portMAX_DELAY) == pdTRUE) {
+        if (transport_ctx == NULL) {
+            // Request to exit
+            break;
+        }
+        httpd_ssl_handshake(transport_ctx);
+    }
+    xSemaphoreGive(global_ctx->handshake_exit);
+    vTaskDelete(NULL);
+}
+
 /**
  * Open a SSL socket for the server.
  * The fd is already open and ready to read / write raw data.
@@ -174,25 +363,39 @@ static esp_err_t httpd_ssl_open(httpd_handle_t server, int sockfd)
         http_dispatch_event_to_event_loop(HTTPS_SERVER_EVENT_ERROR, &last_error, sizeof(last_error));
         return ESP_ERR_NO_MEM;
     }
-    ESP_LOGI(TAG, "performing session handshake");
-    int ret = esp_tls_server_session_create(global_ctx->tls_cfg, sockfd, tls);
-    if (ret != 0) {
-        ESP_LOGE(TAG, "esp_tls_create_server_session failed, 0x%04x", -ret);
-        goto fail;
-    }
 
     // Pass a new structure containing the global context and the tls pointer to httpd_ssl_close
     // Store it in the context field of the HTTPD session object
     // NOTE: allocated memory will be freed by httpd_ssl_close
     httpd_ssl_transport_ctx_t *transport_ctx = (httpd_ssl_transport_ctx_t *)calloc(1, sizeof(httpd_ssl_transport_ctx_t));
-    if (!transport_ctx) {
+    if (transport_ctx) {
+        transport_ctx->tls = tls;
+        transport_ctx->global_ctx = global_ctx;
+        transport_ctx->server = server;
+        transport_ctx->sockfd = sockfd;
+        if (global_ctx->handshake_queue) {
+            transport_ctx->handshake_done = xSemaphoreCreateBinary();
+        }
+    }
+    if (!transport_ctx || (global_ctx->handshake_queue && !transport_ctx->handshake_done)) {
+        free(transport_ctx);
+        esp_tls_server_session_delete(tls);
         esp_https_server_last_error_t last_error = {0};
         last_error.last_error = ESP_ERR_NO_MEM;
         http_dispatch_event_to_event_loop(HTTPS_SERVER_EVENT_ERROR, &last_error, sizeof(last_error));
         return ESP_ERR_NO_MEM;
     }
-    transport_ctx->tls = tls;
-    transport_ctx->global_ctx = global_ctx;
+
+    if (!global_ctx->handshake_queue) {
+        ESP_LOGI(TAG, "performing session handshake");
+        int ret = esp_tls_server_session_create(global_ctx->tls_cfg, sockfd, tls);
+        if (ret != 0) {
+            ESP_LOGE(TAG, "esp_tls_create_server_session failed, 0x%04x", -ret);
+            http_dispatch_tls_error(tls);
+            httpd_ssl_transport_ctx_free(transport_ctx);
+            return ESP_FAIL;
+        }
+    }
 
     // Store the SSL session into the context field of the HTTPD session object
     httpd_sess_set_transport_ctx(server, sockfd, transport_ctx, httpd_ssl_close);
@@ -202,32 +405,38 @@ static esp_err_t httpd_ssl_open(httpd_handle_t server, int sockfd)
     httpd_sess_set_recv_override(server, sockfd, httpd_ssl_recv);
     httpd_sess_set_pending_override(server, sockfd, httpd_ssl_pending);
 
-    // all access should now go through SSL
-    ESP_LOGD(TAG, "Secure socket open");
-
-    if (global_ctx->open_fn) {
-        (global_ctx->open_fn)(server, sockfd);
+    if (!global_ctx->handshake_queue) {
+        httpd_ssl_session_connected(transport_ctx);
+        return ESP_OK;
     }
 
-    if (global_ctx->user_cb) {
-        esp_https_server_user_cb_arg_t user_cb_data = {0};
-        user_cb_data.user_cb_state = HTTPD_SSL_USER_CB_SESS_CREATE;
-        user_cb_data.tls = tls;
-        (global_ctx->user_cb)((void *)&user_cb_data);
+    // Keep the server task away from the session until the handshake task is done with it
+    httpd_sess_set_async(server, sockfd, true);
+    transport_ctx->state = HTTPD_SSL_HANDSHAKE_QUEUED;
+    if (xQueueSend(global_ctx->handshake_queue, &transport_ctx, 0) != pdTRUE) {
+        // The session gets deleted by the server, httpd_ssl_close frees the context
+        ESP_LOGE(TAG, "Handshake queue full");
+        transport_ctx->state = HTTPD_SSL_HANDSHAKE_DONE;
+        return ESP_FAIL;
     }
-    http_dispatch_event_to_event_loop(HTTPS_SERVER_EVENT_ON_CONNECTED, NULL, 0);
     return ESP_OK;
-fail:
-    {
-        esp_tls_error_handle_t error_handle;
-        if (esp_tls_get_error_handle(tls, &error_handle) == ESP_OK) {
-            esp_https_server_last_error_t last_error = {0};
-            last_error.last_error = esp_tls_get_and_clear_last_error(error_handle, &last_error.esp_tls_error_code, &last_error.esp_tls_flags);
-            http_dispatch_event_to_event_loop(HTTPS_SERVER_EVENT_ERROR, &last_error, sizeof(last_error));
-        }
-        esp_tls_server_session_delete(tls);
+}
+
+/**
+ * Stop the running handshake tasks, each one exits on its own exit request
+ *
+ * @param ssl_ctx
+ */
+static void stop_handshake_tasks(httpd_ssl_ctx_t *ssl_ctx)
+{
+    httpd_ssl_transport_ctx_t *exit_request = NULL;
+    for (int i = 0; i < ssl_ctx->handshake_tasks; i++) {
+        xQueueSend(ssl_ctx->handshake_queue, &exit_request, portMAX_DELAY);
+    }
+    for (int i = 0; i < ssl_ctx->handshake_tasks; i++) {
+        xSemaphoreTake(ssl_ctx->handshake_exit, portMAX_DELAY);
     }
-    return ESP_FAIL;
+    ssl_ctx->handshake_tasks = 0;
 }
 
 /**
@@ -252,9 +461,65 @@ static void free_secure_context(void *ctx)
     }
     esp_tls_cfg_server_session_tickets_free(cfg);
     free(cfg);
+    if (ssl_ctx->handshake_queue) {
+        stop_handshake_tasks(ssl_ctx);
+        vQueueDelete(ssl_ctx->handshake_queue);
+    }
+    if (ssl_ctx->handshake_lock) {
+        vSemaphoreDelete(ssl_ctx->handshake_lock);
+    }
+    if (ssl_ctx->handshake_exit) {
+        vSemaphoreDelete(ssl_ctx->handshake_exit);
+    }
     free(ssl_ctx);
 }
 
+/**
+ * Start the pool of tasks performing the TLS handshakes of new sessions
+ *
+ * @param config
+ * @param ssl_ctx
+ * @return success
+ */
+static esp_err_t create_handshake_tasks(const struct httpd_ssl_config *config, httpd_ssl_ctx_t *ssl_ctx)
+{
+    int task_count = config->handshake_task_count ? config->handshake_task_count : 1;
+    ssl_ctx->handshake_lock = xSemaphoreCreateMutex();
+    ssl_ctx->handshake_exit = xSemaphoreCreateCounting(task_count, 0);
+    // one more entry than sessions for each task, for the exit requests
+    QueueHandle_t queue = xQueueCreate(config->httpd.max_open_sockets + task_count, sizeof(httpd_ssl_transport_ctx_t *));
+    if (!ssl_ctx->handshake_lock || !ssl_ctx->handshake_exit || !queue) {
+        ESP_LOGE(TAG, "Could not allocate memory for handshake task");
+        goto exit;
+    }
+    ssl_ctx->handshake_queue = queue;
+    for (int i = 0; i < task_count; i++) {
+        if (xTaskCreatePinnedToCore(httpd_ssl_handshake_task, "httpd_ssl_hs", config->httpd.stack_size, ssl_ctx,
+                                    config->httpd.task_priority, NULL, config->httpd.core_id) != pdPASS) {
+            ESP_LOGE(TAG, "Could not create handshake task");
+            stop_handshake_tasks(ssl_ctx);
+            ssl_ctx->handshake_queue = NULL;
+            goto exit;
+        }
+        ssl_ctx->handshake_tasks++;
+    }
+    return ESP_OK;
+
+exit:
+    if (queue) {
+        vQueueDelete(queue);
+    }
+    if (ssl_ctx->handshake_lock) {
+        vSemaphoreDelete(ssl_ctx->handshake_lock);
+        ssl_ctx->handshake_lock = NULL;
+    }
+    if (ssl_ctx->handshake_exit) {
+        vSemaphoreDelete(ssl_ctx->handshake_exit);
+        ssl_ctx->handshake_exit = NULL;
+    }
+    return ESP_ERR_NO_MEM;
+}
+
 static esp_err_t create_secure_context(const struct httpd_ssl_config *config, httpd_ssl_ctx_t **ssl_ctx)
 {
     if (!ssl_ctx || !*ssl_ctx) {
@@ -366,6 +631,13 @@ static esp_err_t create_secure_context(const struct httpd_ssl_config *config, ht
         }
     }
 
+    if (config->async_handshake) {
+        ret = create_handshake_tasks(config, *ssl_ctx);
+        if (ret != ESP_OK) {
+            goto exit;
+        }
+    }
+
     return ret;
 
 exit:
@@ -422,7 +694,9 @@ esp_err_t httpd_ssl_start(httpd_handle_t *pHandle, struct httpd_ssl_config *conf
 
     ret = httpd_start(&handle, &config->httpd);
     if (ret != ESP_OK) {
-        free(ssl_ctx);
+        if (ssl_ctx) {
+            free_secure_context(ssl_ctx);
+        }
         ssl_ctx = NULL;
         return ret;
     }
@@ -66,6 +66,7 @@ typedef struct {
 static bool mcp_gdma_rx_eof_callback(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data);
 static esp_err_t mcp_gdma_del(async_memcpy_context_t *ctx);
 static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
+static esp_err_t mcp_gdma_memcpy_sg(async_memcpy_context_t *ctx, const async_memcpy_block_t *blocks, size_t num_blocks, async_memcpy_isr_cb_t cb_isr, void *cb_args);
 #if SOC_GDMA_SUPPORT_ETM
 static esp_err_t mcp_new_etm_event(async_memcpy_context_t *ctx, async_memcpy_etm_event_t event_type, esp_etm_event_handle_t *out_event);
 #endif // SOC_GDMA_SUPPORT_ETM
@@ -178,6 +179,7 @@ static esp_err_t esp_async_memcpy_install_gdma_template(const async_memcpy_confi
 
     mcp_gdma->parent.del = mcp_gdma_del;
     mcp_gdma->parent.memcpy = mcp_gdma_memcpy;
+    mcp_gdma->parent.memcpy_sg = mcp_gdma_memcpy_sg;
 #if SOC_GDMA_SUPPORT_ETM
     mcp_gdma->parent.new_etm_event = mcp_new_etm_event;
 #endif
@@ -297,51 +299,111 @@ static bool check_buffer_alignment(async_memcpy_gdma_context_t *mcp_gdma, void *
     return valid;
 }
 
-static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+/// @brief Check if the DMA engine can access the source and destination memory
+static bool check_buffer_location(async_memcpy_gdma_context_t *mcp_gdma, void *src, void *dst)
+{
+    bool valid = true;
+#if SOC_AHB_GDMA_SUPPORTED && !SOC_AHB_GDMA_SUPPORT_PSRAM
+    if (mcp_gdma->gdma_bus_id == SOC_GDMA_BUS_AHB) {
+        valid = valid && esp_ptr_internal(src) && esp_ptr_internal(dst);
+    }
+#endif // SOC_AHB_GDMA_SUPPORTED && !SOC_AHB_GDMA_SUPPORT_PSRAM
+#if SOC_AXI_GDMA_SUPPORTED && !SOC_AXI_GDMA_SUPPORT_PSRAM
+    if (mcp_gdma->gdma_bus_id == SOC_GDMA_BUS_AXI) {
+        valid = valid && esp_ptr_internal(src) && esp_ptr_internal(dst);
+    }
+#endif // SOC_AXI_GDMA_SUPPORTED && !SOC_AXI_GDMA_SUPPORT_PSRAM
+    return valid;
+}
+
+/// @brief Get the alignment of the DMA link list items required by the GDMA bus
+static size_t get_link_item_alignment(async_memcpy_gdma_context_t *mcp_gdma)
 {
-    esp_err_t ret = ESP_OK;
-    async_memcpy_gdma_context_t *mcp_gdma = __containerof(ctx, async_memcpy_gdma_context_t, parent);
-    size_t dma_link_item_alignment = 4;
-    // buffer location check
 #if SOC_AHB_GDMA_SUPPORTED
     if (mcp_gdma->gdma_bus_id == SOC_GDMA_BUS_AHB) {
-#if !SOC_AHB_GDMA_SUPPORT_PSRAM
-        ESP_RETURN_ON_FALSE(esp_ptr_internal(src) && esp_ptr_internal(dst), ESP_ERR_INVALID_ARG, TAG, "AHB GDMA can only access SRAM");
-#endif // !SOC_AHB_GDMA_SUPPORT_PSRAM
-        dma_link_item_alignment = GDMA_LL_AHB_DESC_ALIGNMENT;
+        return GDMA_LL_AHB_DESC_ALIGNMENT;
     }
 #endif // SOC_AHB_GDMA_SUPPORTED
 #if SOC_AXI_GDMA_SUPPORTED
     if (mcp_gdma->gdma_bus_id == SOC_GDMA_BUS_AXI) {
-#if !SOC_AXI_GDMA_SUPPORT_PSRAM
-        ESP_RETURN_ON_FALSE(esp_ptr_internal(src) && esp_ptr_internal(dst), ESP_ERR_INVALID_ARG, TAG, "AXI GDMA can only access SRAM");
-#endif // !SOC_AXI_GDMA_SUPPORT_PSRAM
-        dma_link_item_alignment = GDMA_LL_AXI_DESC_ALIGNMENT;
+        return GDMA_LL_AXI_DESC_ALIGNMENT;
     }
 #endif // SOC_AXI_GDMA_SUPPORTED
+    return 4;
+}
+
+/// @brief Get the data cache line size of the memory, 0 if the memory is not behind a cache
+static size_t get_cache_line_size(const void *buf)
+{
+    if (esp_ptr_external_ram(buf)) {
+        return cache_hal_get_cache_line_size(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA);
+    } else if (esp_ptr_internal(buf)) {
+        return cache_hal_get_cache_line_size(CACHE_LL_LEVEL_INT_MEM, CACHE_TYPE_DATA);
+    }
+    return 0;
+}
+
+/// @brief Pick one transaction from the idle queue, and clean up the configuration left by its last use
+static async_memcpy_transaction_t *pick_idle_transaction(async_memcpy_gdma_context_t *mcp_gdma)
+{
+    async_memcpy_transaction_t *trans = try_pop_trans_from_idle_queue(mcp_gdma);
+    if (trans) {
+        if (trans->tx_link_list) {
+            gdma_del_link_list(trans->tx_link_list);
+            trans->tx_link_list = NULL;
+        }
+        if (trans->rx_link_list) {
+            gdma_del_link_list(trans->rx_link_list);
+            trans->rx_link_list = NULL;
+        }
+        if (trans->stash_buffer) {
+            free(trans->stash_buffer);
+            trans->stash_buffer = NULL;
+        }
+    }
+    return trans;
+}
+
+/// @brief Insert a prepared transaction into the ready queue, and start it if the driver is idle
+static void submit_transaction(async_memcpy_gdma_context_t *mcp_gdma, async_memcpy_transaction_t *trans,
+                               async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    // save other transaction context
+    trans->cb = cb_isr;
+    trans->cb_args = cb_args;
+
+    portENTER_CRITICAL(&mcp_gdma->spin_lock);
+    // insert the trans to ready queue
+    STAILQ_INSERT_TAIL(&mcp_gdma->ready_queue_head, trans, ready_queue_entry);
+    portEXIT_CRITICAL(&mcp_gdma->spin_lock);
+
+    // check driver state, if there's no running transaction, start a new one
+    try_start_pending_transaction(mcp_gdma);
+}
+
+/// @brief Return a transaction that failed to be prepared to the idle queue
+static void recycle_transaction(async_memcpy_gdma_context_t *mcp_gdma, async_memcpy_transaction_t *trans)
+{
+    portENTER_CRITICAL(&mcp_gdma->spin_lock);
+    STAILQ_INSERT_TAIL(&mcp_gdma->idle_queue_head, trans, idle_queue_entry);
+    portEXIT_CRITICAL(&mcp_gdma->spin_lock);
+}
+
+static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    esp_err_t ret = ESP_OK;
+    async_memcpy_gdma_context_t *mcp_gdma = __containerof(ctx, async_memcpy_gdma_context_t, parent);
+    size_t dma_link_item_alignment = get_link_item_alignment(mcp_gdma);
+    // buffer location check
+    ESP_RETURN_ON_FALSE(check_buffer_location(mcp_gdma, src, dst), ESP_ERR_INVALID_ARG, TAG, "GDMA can only access SRAM");
     // alignment check
     ESP_RETURN_ON_FALSE(check_buffer_alignment(mcp_gdma, src, dst, n), ESP_ERR_INVALID_ARG, TAG, "address|size not aligned: %p -> %p, sz=%zu", src, dst, n);
 
-    async_memcpy_transaction_t *trans = NULL;
     // pick one transaction node from idle queue
-    trans = try_pop_trans_from_idle_queue(mcp_gdma);
+    async_memcpy_transaction_t *trans = pick_idle_transaction(mcp_gdma);
     // check if we get the transaction object successfully
     ESP_RETURN_ON_FALSE(trans, ESP_ERR_INVALID_STATE, TAG, "no free node in the idle queue");
 
-    // clean up the transaction configuration comes from the last one
-    if (trans->tx_link_list) {
-        gdma_del_link_list(trans->tx_link_list);
-        trans->tx_link_list = NULL;
-    }
-    if (trans->rx_link_list) {
-        gdma_del_link_list(trans->rx_link_list);
-        trans->rx_link_list = NULL;
-    }
-    if (trans->stash_buffer) {
-        free(trans->stash_buffer);
-        trans->stash_buffer = NULL;
-    }
-
     size_t buffer_alignment = 0;
     size_t num_dma_nodes = 0;
 
@@ -371,17 +433,8 @@ static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *s
     };
     gdma_link_mount_buffers(trans->tx_link_list, 0, tx_buf_mount_config, 1, NULL);
 
-    // read the cache line size of internal and external memory, we use this information to check if a given memory is behind the cache
     // write back the source data if it's behind the cache
-    size_t int_mem_cache_line_size = cache_hal_get_cache_line_size(CACHE_LL_LEVEL_INT_MEM, CACHE_TYPE_DATA);
-    size_t ext_mem_cache_line_size = cache_hal_get_cache_line_size(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA);
-    bool need_write_back = false;
-    if (esp_ptr_external_ram(src)) {
-        need_write_back = ext_mem_cache_line_size > 0;
-    } else if (esp_ptr_internal(src)) {
-        need_write_back = int_mem_cache_line_size > 0;
-    }
-    if (need_write_back) {
+    if (get_cache_line_size(src) > 0) {
         esp_cache_msync(src, n, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
     }
 
@@ -410,27 +463,115 @@ static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *s
     }
     gdma_link_mount_buffers(trans->rx_link_list, 0, rx_buf_mount_config, 3, NULL);
 
-    // save other transaction context
-    trans->cb = cb_isr;
-    trans->cb_args = cb_args;
+    submit_transaction(mcp_gdma, trans, cb_isr, cb_args);
+    return ESP_OK;
 
-    portENTER_CRITICAL(&mcp_gdma->spin_lock);
-    // insert the trans to ready queue
-    STAILQ_INSERT_TAIL(&mcp_gdma->ready_queue_head, trans, ready_queue_entry);
-    portEXIT_CRITICAL(&mcp_gdma->spin_lock);
+err:
+    if (trans) {
+        // return back the trans to idle queue
+        recycle_transaction(mcp_gdma, trans);
+    }
+    return ret;
+}
 
-    // check driver state, if there's no running transaction, start a new one
-    try_start_pending_transaction(mcp_gdma);
+/// @brief Count the DMA link list items needed to mount the blocks
+static size_t count_sg_nodes(const async_memcpy_block_t *blocks, size_t num_blocks, size_t buffer_alignment)
+{
+    size_t num_dma_nodes = 0;
+    for (size_t i = 0; i < num_blocks; i++) {
+        num_dma_nodes += esp_dma_calculate_node_count(blocks[i].size, buffer_alignment, MCP_DMA_DESCRIPTOR_BUFFER_MAX_SIZE);
+    }
+    return num_dma_nodes;
+}
+
+static esp_err_t mcp_gdma_memcpy_sg(async_memcpy_context_t *ctx, const async_memcpy_block_t *blocks, size_t num_blocks, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    esp_err_t ret = ESP_OK;
+    async_memcpy_gdma_context_t *mcp_gdma = __containerof(ctx, async_memcpy_gdma_context_t, parent);
+    size_t dma_link_item_alignment = get_link_item_alignment(mcp_gdma);
+    // the blocks share one link list per direction, which uses the strictest buffer alignment of the blocks
+    size_t tx_buffer_alignment = 1;
+    size_t rx_buffer_alignment = 1;
+    for (size_t i = 0; i < num_blocks; i++) {
+        void *src = blocks[i].src;
+        void *dst = blocks[i].dst;
+        size_t n = blocks[i].size;
+        ESP_RETURN_ON_FALSE(check_buffer_location(mcp_gdma, src, dst), ESP_ERR_INVALID_ARG, TAG, "GDMA can only access SRAM");
+        ESP_RETURN_ON_FALSE(check_buffer_alignment(mcp_gdma, src, dst, n), ESP_ERR_INVALID_ARG, TAG, "address|size not aligned: %p -> %p, sz=%zu", src, dst, n);
+        // unlike esp_async_memcpy, the destination is not split into cache aligned buffers, that would take a stash buffer per block
+        size_t cache_line_size = get_cache_line_size(dst);
+        ESP_RETURN_ON_FALSE(cache_line_size == 0 || ((((uintptr_t)dst | n) & (cache_line_size - 1)) == 0), ESP_ERR_INVALID_ARG, TAG,
+                            "destination not aligned to cache line: %p, sz=%zu", dst, n);
+        tx_buffer_alignment = MAX(tx_buffer_alignment, esp_ptr_internal(src) ? mcp_gdma->tx_int_mem_alignment : mcp_gdma->tx_ext_mem_alignment);
+        rx_buffer_alignment = MAX(rx_buffer_alignment, esp_ptr_internal(dst) ? mcp_gdma->rx_int_mem_alignment : mcp_gdma->rx_ext_mem_alignment);
+    }
+
+    // the mount configurations are only needed while the link lists are built
+    gdma_buffer_mount_config_t *mount_config = heap_caps_calloc(num_blocks, sizeof(gdma_buffer_mount_config_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(mount_config, ESP_ERR_NO_MEM, TAG, "no mem for mount config");
 
+    // pick one transaction node from idle queue
+    async_memcpy_transaction_t *trans = pick_idle_transaction(mcp_gdma);
+    ESP_GOTO_ON_FALSE(trans, ESP_ERR_INVALID_STATE, err, TAG, "no free node in the idle queue");
+    // the destination is not split, there is nothing to merge when the transaction is done
+    memset(&trans->rx_buf_array, 0, sizeof(trans->rx_buf_array));
+
+    // allocate gdma TX link, and mount the source blocks, the last one is marked as EOF
+    gdma_link_list_config_t tx_link_cfg = {
+        .buffer_alignment = tx_buffer_alignment,
+        .item_alignment = dma_link_item_alignment,
+        .num_items = count_sg_nodes(blocks, num_blocks, tx_buffer_alignment),
+        .flags = {
+            .check_owner = true,
+            .items_in_ext_mem = false,
+        },
+    };
+    ESP_GOTO_ON_ERROR(gdma_new_link_list(&tx_link_cfg, &trans->tx_link_list), err, TAG, "failed to create TX link list");
+    for (size_t i = 0; i < num_blocks; i++) {
+        mount_config[i].buffer = blocks[i].src;
+        mount_config[i].length = blocks[i].size;
+        mount_config[i].flags.mark_eof = (i == num_blocks - 1);
+        mount_config[i].flags.mark_final = (i == num_blocks - 1);
+        // write back the source data if it's behind the cache
+        if (get_cache_line_size(blocks[i].src) > 0) {
+            esp_cache_msync(blocks[i].src, blocks[i].size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+        }
+    }
+    ESP_GOTO_ON_ERROR(gdma_link_mount_buffers(trans->tx_link_list, 0, mount_config, num_blocks, NULL), err, TAG, "failed to mount TX buffers");
+
+    // allocate gdma RX link, and mount the destination blocks
+    gdma_link_list_config_t rx_link_cfg = {
+        .buffer_alignment = rx_buffer_alignment,
+        .item_alignment = dma_link_item_alignment,
+        .num_items = count_sg_nodes(blocks, num_blocks, rx_buffer_alignment),
+        .flags = {
+            .check_owner = true,
+            .items_in_ext_mem = false,
+        },
+    };
+    ESP_GOTO_ON_ERROR(gdma_new_link_list(&rx_link_cfg, &trans->rx_link_list), err, TAG, "failed to create RX link list");
+    for (size_t i = 0; i < num_blocks; i++) {
+        mount_config[i].buffer = blocks[i].dst;
+        mount_config[i].length = blocks[i].size;
+        mount_config[i].flags.mark_eof = false;
+        mount_config[i].flags.mark_final = (i == num_blocks - 1);
+        // invalidate the destination if it's behind the cache, the CPU must not read stale data after the copy
+        if (get_cache_line_size(blocks[i].dst) > 0) {
+            ESP_GOTO_ON_ERROR(esp_cache_msync(blocks[i].dst, blocks[i].size, ESP_CACHE_MSYNC_FLAG_DIR_M2C), err, TAG, "failed to do cache sync");
+        }
+    }
+    ESP_GOTO_ON_ERROR(gdma_link_mount_buffers(trans->rx_link_list, 0, mount_config, num_blocks, NULL), err, TAG, "failed to mount RX buffers");
+    free(mount_config);
+
+    submit_transaction(mcp_gdma, trans, cb_isr, cb_args);
     return ESP_OK;
 
 err:
     if (trans) {
         // return back the trans to idle queue
-        portENTER_CRITICAL(&mcp_gdma->spin_lock);
-        STAILQ_INSERT_TAIL(&mcp_gdma->idle_queue_head, trans, idle_queue_entry);
-        portEXIT_CRITICAL(&mcp_gdma->spin_lock);
+        recycle_transaction(mcp_gdma, trans);
     }
+    free(mount_config);
     return ret;
 }
 
@@ -1,10 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2020-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include "esp_check.h"
+#include "esp_heap_caps.h"
 #include "esp_async_memcpy.h"
 #include "esp_async_memcpy_priv.h"
 
@@ -22,6 +24,47 @@ esp_err_t esp_async_memcpy(async_memcpy_handle_t asmcp, void *dst, void *src, si
     return asmcp->memcpy(asmcp, dst, src, n, cb_isr, cb_args);
 }
 
+esp_err_t esp_async_memcpy_sg(async_memcpy_handle_t asmcp, const async_memcpy_block_t *blocks, size_t num_blocks,
+                              async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    ESP_RETURN_ON_FALSE(asmcp && blocks && num_blocks, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    for (size_t i = 0; i < num_blocks; i++) {
+        ESP_RETURN_ON_FALSE(blocks[i].dst && blocks[i].src && blocks[i].size, ESP_ERR_INVALID_ARG, TAG, "invalid block %zu", i);
+    }
+    ESP_RETURN_ON_FALSE(asmcp->memcpy_sg, ESP_ERR_NOT_SUPPORTED, TAG, "scatter-gather is not supported");
+    return asmcp->memcpy_sg(asmcp, blocks, num_blocks, cb_isr, cb_args);
+}
+
+esp_err_t esp_async_memcpy_2d(async_memcpy_handle_t asmcp, const async_memcpy_2d_config_t *config,
+                              async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    ESP_RETURN_ON_FALSE(asmcp && config && config->dst && config->src && config->width && config->height,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->dst_stride >= config->width && config->src_stride >= config->width,
+                        ESP_ERR_INVALID_ARG, TAG, "stride smaller than width");
+    // rows contiguous in both the source and the destination are copied as one block
+    if (config->dst_stride == config->width && config->src_stride == config->width) {
+        ESP_RETURN_ON_FALSE(config->height <= SIZE_MAX / config->width, ESP_ERR_INVALID_ARG, TAG, "size overflow");
+        async_memcpy_block_t block = {
+            .dst = config->dst,
+            .src = config->src,
+            .size = config->width * config->height,
+        };
+        return esp_async_memcpy_sg(asmcp, &block, 1, cb_isr, cb_args);
+    }
+    // the block array is only needed while the DMA link lists are built
+    async_memcpy_block_t *blocks = heap_caps_malloc(config->height * sizeof(async_memcpy_block_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(blocks, ESP_ERR_NO_MEM, TAG, "no mem for %zu rows", config->height);
+    for (size_t i = 0; i < config->height; i++) {
+        blocks[i].dst = (uint8_t *)config->dst + i * config->dst_stride;
+        blocks[i].src = (uint8_t *)config->src + i * config->src_stride;
+        blocks[i].size = config->width;
+    }
+    esp_err_t ret = esp_async_memcpy_sg(asmcp, blocks, config->height, cb_isr, cb_args);
+    free(blocks);
+    return ret;
+}
+
 #if SOC_ETM_SUPPORTED
 esp_err_t esp_async_memcpy_new_etm_event(async_memcpy_handle_t asmcp, async_memcpy_etm_event_t event_type, esp_etm_event_handle_t *out_event)
 {
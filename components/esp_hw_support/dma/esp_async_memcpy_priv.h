@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -31,6 +31,8 @@ typedef struct async_memcpy_context_t async_memcpy_context_t;
 struct async_memcpy_context_t {
     /// @brief Start a new async memcpy transaction
     esp_err_t (*memcpy)(async_memcpy_context_t *ctx, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
+    /// @brief Start a new scatter-gather async memcpy transaction, NULL if the backend doesn't support it
+    esp_err_t (*memcpy_sg)(async_memcpy_context_t *ctx, const async_memcpy_block_t *blocks, size_t num_blocks, async_memcpy_isr_cb_t cb_isr, void *cb_args);
 #if SOC_ETM_SUPPORTED
     /// @brief Create ETM event handle of specific event type
     esp_err_t (*new_etm_event)(async_memcpy_context_t *ctx, async_memcpy_etm_event_t event_type, esp_etm_event_handle_t *out_event);
@@ -8,6 +8,7 @@
 #include <inttypes.h>
 #include <string.h>
 #include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
 #include "esp_check.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
@@ -25,6 +26,16 @@ static const char *TAG = "dma_utils";
 
 #define ALIGN_UP_BY(num, align) (((num) + ((align) - 1)) & ~((align) - 1))
 
+struct esp_dma_buffer_pool_t {
+    portMUX_TYPE spinlock;  // protects the free list, the pool is used from ISR context as well
+    uint8_t *buffers;       // all the buffers, allocated as one DMA capable block
+    size_t buffer_size;     // size of each buffer, multiple of the alignment
+    size_t alignment;       // alignment of the buffers
+    size_t num_buffers;     // number of buffers
+    size_t num_free;        // number of buffers in the free list
+    void *free_list[];      // stack of free buffers
+};
+
 esp_err_t esp_dma_split_rx_buffer_to_cache_aligned(void *rx_buffer, size_t buffer_len, dma_buffer_split_array_t *align_buf_array, uint8_t** ret_stash_buffer)
 {
     esp_err_t ret = ESP_OK;
@@ -144,22 +155,34 @@ size_t esp_dma_calculate_node_count(size_t buffer_size, size_t buffer_alignment,
     return (buffer_size + max_buffer_size_per_node - 1) / max_buffer_size_per_node;
 }
 
-esp_err_t esp_dma_capable_malloc(size_t size, const esp_dma_mem_info_t *dma_mem_info, void **out_ptr, size_t *actual_size)
+static size_t s_get_dma_mem_alignment(const esp_dma_mem_info_t *dma_mem_info)
 {
-    ESP_RETURN_ON_FALSE_ISR(dma_mem_info && out_ptr, ESP_ERR_INVALID_ARG, TAG, "null pointer");
-
-    size_t alignment_bytes = 0;
-
     //dma align
     size_t dma_alignment_bytes = dma_mem_info->dma_alignment_bytes;
 
     //cache align
     int cache_flags = 0;
     size_t cache_alignment_bytes = 0;
+    if (dma_mem_info->extra_heap_caps & MALLOC_CAP_SPIRAM) {
+        cache_flags |= MALLOC_CAP_SPIRAM;
+    }
+
+    // Return value unused if asserts are disabled
+    esp_err_t __attribute((unused)) ret = esp_cache_get_alignment(cache_flags, &cache_alignment_bytes);
+    assert(ret == ESP_OK);
+
+    //Get the least common multiple of two alignment
+    return hal_utils_calc_lcm(dma_alignment_bytes, cache_alignment_bytes);
+}
+
+esp_err_t esp_dma_capable_malloc(size_t size, const esp_dma_mem_info_t *dma_mem_info, void **out_ptr, size_t *actual_size)
+{
+    ESP_RETURN_ON_FALSE_ISR(dma_mem_info && out_ptr, ESP_ERR_INVALID_ARG, TAG, "null pointer");
+
+    size_t alignment_bytes = s_get_dma_mem_alignment(dma_mem_info);
 
     int heap_caps = dma_mem_info->extra_heap_caps | MALLOC_CAP_DMA;
     if (dma_mem_info->extra_heap_caps & MALLOC_CAP_SPIRAM) {
-        cache_flags |= MALLOC_CAP_SPIRAM;
         heap_caps = dma_mem_info->extra_heap_caps | MALLOC_CAP_SPIRAM;
         /**
          * This is a workaround because we don't have `MALLOC_CAP_DMA | MALLOC_CAP_SPIRAM`
@@ -168,13 +191,6 @@ esp_err_t esp_dma_capable_malloc(size_t size, const esp_dma_mem_info_t *dma_mem_
         heap_caps &= ~MALLOC_CAP_DMA;
     }
 
-    // Return value unused if asserts are disabled
-    esp_err_t __attribute((unused)) ret = esp_cache_get_alignment(cache_flags, &cache_alignment_bytes);
-    assert(ret == ESP_OK);
-
-    //Get the least common multiple of two alignment
-    alignment_bytes = hal_utils_calc_lcm(dma_alignment_bytes, cache_alignment_bytes);
-
     //malloc
     size = ALIGN_UP_BY(size, alignment_bytes);
     void *ptr = heap_caps_aligned_alloc(alignment_bytes, size, heap_caps);
@@ -207,6 +223,92 @@ esp_err_t esp_dma_capable_calloc(size_t calloc_num, size_t size, const esp_dma_m
     return ret;
 }
 
+esp_err_t esp_dma_new_buffer_pool(const esp_dma_buffer_pool_config_t *config, esp_dma_buffer_pool_handle_t *ret_pool)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_pool && config->buffer_size && config->num_buffers, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    // the pool itself is accessed from ISR context, so it lives in internal memory
+    esp_dma_buffer_pool_handle_t pool = heap_caps_calloc(1, sizeof(struct esp_dma_buffer_pool_t) + config->num_buffers * sizeof(void *),
+                                                         MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(pool, ESP_ERR_NO_MEM, TAG, "no mem for buffer pool");
+
+    // every buffer starts and ends on the alignment, so the drivers never need to bounce it
+    size_t alignment = s_get_dma_mem_alignment(&config->dma_mem_info);
+    size_t buffer_size = ALIGN_UP_BY(config->buffer_size, alignment);
+    size_t total_size = 0;
+    ESP_GOTO_ON_FALSE(!__builtin_mul_overflow(buffer_size, config->num_buffers, &total_size), ESP_ERR_INVALID_ARG, err, TAG, "total size overflow");
+    ESP_GOTO_ON_ERROR(esp_dma_capable_malloc(total_size, &config->dma_mem_info, (void **)&pool->buffers, NULL), err, TAG, "no mem for buffers");
+
+    pool->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    pool->buffer_size = buffer_size;
+    pool->alignment = alignment;
+    pool->num_buffers = config->num_buffers;
+    // hand out the buffers in address order
+    for (size_t i = 0; i < config->num_buffers; i++) {
+        pool->free_list[i] = pool->buffers + (config->num_buffers - 1 - i) * buffer_size;
+    }
+    pool->num_free = config->num_buffers;
+
+    ESP_LOGD(TAG, "new buffer pool @%p, %zu buffers of %zu bytes at %p", pool, pool->num_buffers, pool->buffer_size, pool->buffers);
+    *ret_pool = pool;
+    return ESP_OK;
+
+err:
+    free(pool);
+    return ret;
+}
+
+esp_err_t esp_dma_del_buffer_pool(esp_dma_buffer_pool_handle_t pool)
+{
+    ESP_RETURN_ON_FALSE(pool, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(pool->num_free == pool->num_buffers, ESP_ERR_INVALID_STATE, TAG, "%zu buffers still in use", pool->num_buffers - pool->num_free);
+    free(pool->buffers);
+    free(pool);
+    return ESP_OK;
+}
+
+void *esp_dma_buffer_pool_get(esp_dma_buffer_pool_handle_t pool)
+{
+    void *buffer = NULL;
+    portENTER_CRITICAL_SAFE(&pool->spinlock);
+    if (pool->num_free) {
+        buffer = pool->free_list[--pool->num_free];
+    }
+    portEXIT_CRITICAL_SAFE(&pool->spinlock);
+    return buffer;
+}
+
+esp_err_t esp_dma_buffer_pool_put(esp_dma_buffer_pool_handle_t pool, void *buffer)
+{
+    ESP_RETURN_ON_FALSE_ISR(pool && buffer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    size_t offset = (uint8_t *)buffer - pool->buffers;
+    ESP_RETURN_ON_FALSE_ISR((uint8_t *)buffer >= pool->buffers && offset < pool->num_buffers * pool->buffer_size && (offset % pool->buffer_size) == 0,
+                            ESP_ERR_INVALID_ARG, TAG, "buffer %p not from pool", buffer);
+
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL_SAFE(&pool->spinlock);
+    if (pool->num_free < pool->num_buffers) {
+        pool->free_list[pool->num_free++] = buffer;
+    } else {
+        ret = ESP_ERR_INVALID_ARG; // more buffers given back than taken
+    }
+    portEXIT_CRITICAL_SAFE(&pool->spinlock);
+    return ret;
+}
+
+esp_err_t esp_dma_buffer_pool_get_info(esp_dma_buffer_pool_handle_t pool, size_t *buffer_size, size_t *alignment_bytes)
+{
+    ESP_RETURN_ON_FALSE(pool, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (buffer_size) {
+        *buffer_size = pool->buffer_size;
+    }
+    if (alignment_bytes) {
+        *alignment_bytes = pool->alignment;
+    }
+    return ESP_OK;
+}
+
 static bool s_buf_in_region(const void *ptr, size_t size, esp_dma_buf_location_t location)
 {
     bool found = false;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -185,6 +185,9 @@ search_done:
     }
 
     (*ret_chan)->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+#if CONFIG_GDMA_ENABLE_WEIGHTED_ARBITRATION
+    gdma_hal_set_weight(&group->hal, pair->pair_id, (*ret_chan)->direction, 1);
+#endif
     ESP_LOGD(TAG, "new %s channel (%d,%d) at %p", (config->direction == GDMA_CHANNEL_DIRECTION_TX) ? "tx" : "rx",
              group->group_id, pair->pair_id, *ret_chan);
     return ESP_OK;
@@ -250,6 +253,9 @@ esp_err_t gdma_del_channel(gdma_channel_handle_t dma_chan)
 
     // reset the channel priority to default
     gdma_hal_set_priority(hal, pair->pair_id, dma_chan->direction, 0);
+#if CONFIG_GDMA_ENABLE_WEIGHTED_ARBITRATION
+    gdma_hal_set_weight(hal, pair->pair_id, dma_chan->direction, 1);
+#endif
 
     // call `gdma_del_tx_channel` or `gdma_del_rx_channel` under the hood
     return dma_chan->del(dma_chan);
@@ -447,6 +453,40 @@ esp_err_t gdma_set_priority(gdma_channel_handle_t dma_chan, uint32_t priority)
     return ESP_OK;
 }
 
+#if SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+esp_err_t gdma_set_weight(gdma_channel_handle_t dma_chan, uint32_t weight)
+{
+    ESP_RETURN_ON_FALSE(dma_chan && weight >= 1 && weight <= GDMA_LL_CHANNEL_MAX_WEIGHT, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+#if CONFIG_GDMA_ENABLE_WEIGHTED_ARBITRATION
+    gdma_pair_t *pair = dma_chan->pair;
+    gdma_group_t *group = pair->group;
+    gdma_hal_context_t *hal = &group->hal;
+
+    gdma_hal_set_weight(hal, pair->pair_id, dma_chan->direction, weight);
+
+    return ESP_OK;
+#else
+    ESP_RETURN_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, TAG, "weighted arbitration is not enabled");
+#endif
+}
+#endif // SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+
+esp_err_t gdma_get_channel_stats(gdma_channel_handle_t dma_chan, gdma_channel_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(dma_chan && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+#if CONFIG_GDMA_ENABLE_CHANNEL_STATS
+    portENTER_CRITICAL(&dma_chan->spinlock);
+    *stats = dma_chan->stats;
+    if (reset) {
+        memset(&dma_chan->stats, 0, sizeof(dma_chan->stats));
+    }
+    portEXIT_CRITICAL(&dma_chan->spinlock);
+    return ESP_OK;
+#else
+    ESP_RETURN_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, TAG, "channel statistics are not enabled");
+#endif
+}
+
 esp_err_t gdma_register_tx_event_callbacks(gdma_channel_handle_t dma_chan, gdma_tx_event_callbacks_t *cbs, void *user_data)
 {
     ESP_RETURN_ON_FALSE(dma_chan && cbs && dma_chan->direction == GDMA_CHANNEL_DIRECTION_TX, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
@@ -542,6 +582,9 @@ esp_err_t gdma_start(gdma_channel_handle_t dma_chan, intptr_t desc_base_addr)
 
     portENTER_CRITICAL_SAFE(&dma_chan->spinlock);
     gdma_hal_start_with_desc(hal, pair->pair_id, dma_chan->direction, desc_base_addr);
+#if CONFIG_GDMA_ENABLE_CHANNEL_STATS
+    dma_chan->stats.start_count++;
+#endif
     portEXIT_CRITICAL_SAFE(&dma_chan->spinlock);
 
     return ESP_OK;
@@ -648,6 +691,10 @@ static gdma_group_t *gdma_acquire_group_handle(int group_id, void (*hal_init)(gd
             .group_id = group_id,
         };
         hal_init(&group->hal, &config);
+#if CONFIG_GDMA_ENABLE_WEIGHTED_ARBITRATION
+        gdma_hal_enable_weighted_arb(&group->hal, GDMA_CHANNEL_DIRECTION_TX, true);
+        gdma_hal_enable_weighted_arb(&group->hal, GDMA_CHANNEL_DIRECTION_RX, true);
+#endif
         ESP_LOGD(TAG, "new group (%d) at %p", group_id, group);
     } else {
         free(pre_alloc_group);
@@ -796,6 +843,12 @@ void gdma_default_rx_isr(void *args)
     // reading the raw interrupt status because we also want to know the EOF status, even if the EOF interrupt is not enabled
     uint32_t intr_status = gdma_hal_read_intr_status(hal, pair_id, GDMA_CHANNEL_DIRECTION_RX, true);
     gdma_hal_clear_intr(hal, pair_id, GDMA_CHANNEL_DIRECTION_RX, intr_status);
+#if CONFIG_GDMA_ENABLE_CHANNEL_STATS
+    portENTER_CRITICAL_ISR(&rx_chan->base.spinlock);
+    rx_chan->base.stats.eof_count += (intr_status & (GDMA_LL_EVENT_RX_SUC_EOF | GDMA_LL_EVENT_RX_ERR_EOF)) ? 1 : 0;
+    rx_chan->base.stats.descr_err_count += (intr_status & GDMA_LL_EVENT_RX_DESC_ERROR) ? 1 : 0;
+    portEXIT_CRITICAL_ISR(&rx_chan->base.spinlock);
+#endif
 
     // prepare data for different events
     uint32_t eof_addr = 0;
@@ -845,6 +898,12 @@ void gdma_default_tx_isr(void *args)
     // clear pending interrupt event
     uint32_t intr_status = gdma_hal_read_intr_status(hal, pair_id, GDMA_CHANNEL_DIRECTION_TX, false);
     gdma_hal_clear_intr(hal, pair_id, GDMA_CHANNEL_DIRECTION_TX, intr_status);
+#if CONFIG_GDMA_ENABLE_CHANNEL_STATS
+    portENTER_CRITICAL_ISR(&tx_chan->base.spinlock);
+    tx_chan->base.stats.eof_count += (intr_status & GDMA_LL_EVENT_TX_EOF) ? 1 : 0;
+    tx_chan->base.stats.descr_err_count += (intr_status & GDMA_LL_EVENT_TX_DESC_ERROR) ? 1 : 0;
+    portEXIT_CRITICAL_ISR(&tx_chan->base.spinlock);
+#endif
 
     if ((intr_status & GDMA_LL_EVENT_TX_EOF) && tx_chan->cbs.on_trans_eof) {
         uint32_t eof_addr = gdma_hal_get_eof_desc_addr(hal, pair_id, GDMA_CHANNEL_DIRECTION_TX, true);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -75,6 +75,9 @@ struct gdma_channel_t {
     struct {
         uint32_t start_stop_by_etm: 1; // whether the channel is started/stopped by ETM
     } flags;
+#if CONFIG_GDMA_ENABLE_CHANNEL_STATS
+    gdma_channel_stats_t stats; // channel statistics, updated by `gdma_start` and the interrupt handler
+#endif
 };
 
 struct gdma_tx_channel_t {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -79,6 +79,87 @@ typedef struct {
     bool on_psram;              ///< allocate DMA from the PSRAM
 } dma_alignment_info_t;
 
+/**
+ * @brief Type of DMA buffer pool handle
+ */
+typedef struct esp_dma_buffer_pool_t *esp_dma_buffer_pool_handle_t;
+
+/**
+ * @brief DMA buffer pool configuration
+ */
+typedef struct {
+    size_t buffer_size;                 ///< Size of each buffer in bytes, rounded up to the alignment of the pool
+    size_t num_buffers;                 ///< Number of buffers in the pool
+    esp_dma_mem_info_t dma_mem_info;    ///< DMA and memory info of the buffers, see `esp_dma_mem_info_t`
+} esp_dma_buffer_pool_config_t;
+
+/**
+ * @brief Create a pool of DMA capable buffers
+ *
+ * All the buffers are allocated at once. Each buffer starts and ends on the least common multiple of the DMA
+ * alignment and the cache line size of the memory it is placed in, so it can be handed to any DMA driver
+ * which requires that alignment, without the driver copying it to a bounce buffer.
+ *
+ * @param[in]  config     Pool configuration
+ * @param[out] ret_pool   Returned pool handle
+ *
+ * @return
+ *        - ESP_OK:
+ *        - ESP_ERR_INVALID_ARG: Invalid argument
+ *        - ESP_ERR_NO_MEM:      No enough memory for allocation
+ */
+esp_err_t esp_dma_new_buffer_pool(const esp_dma_buffer_pool_config_t *config, esp_dma_buffer_pool_handle_t *ret_pool);
+
+/**
+ * @brief Delete a DMA buffer pool
+ *
+ * @param[in] pool  Pool handle
+ *
+ * @return
+ *        - ESP_OK:
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument
+ *        - ESP_ERR_INVALID_STATE: Some buffers are still taken from the pool
+ */
+esp_err_t esp_dma_del_buffer_pool(esp_dma_buffer_pool_handle_t pool);
+
+/**
+ * @brief Take a buffer from a DMA buffer pool
+ *
+ * @note This function can be used in the ISR context.
+ *
+ * @param[in] pool  Pool handle
+ *
+ * @return Pointer to the buffer, or NULL if all the buffers are taken
+ */
+void *esp_dma_buffer_pool_get(esp_dma_buffer_pool_handle_t pool);
+
+/**
+ * @brief Give a buffer back to its DMA buffer pool
+ *
+ * @note This function can be used in the ISR context.
+ *
+ * @param[in] pool    Pool handle
+ * @param[in] buffer  Buffer taken from the pool with `esp_dma_buffer_pool_get`
+ *
+ * @return
+ *        - ESP_OK:
+ *        - ESP_ERR_INVALID_ARG: The buffer doesn't belong to the pool
+ */
+esp_err_t esp_dma_buffer_pool_put(esp_dma_buffer_pool_handle_t pool, void *buffer);
+
+/**
+ * @brief Get the buffer size and the alignment of a DMA buffer pool
+ *
+ * @param[in]  pool            Pool handle
+ * @param[out] buffer_size     Size of each buffer in bytes, a multiple of the alignment. Set null if you don't care this value.
+ * @param[out] alignment_bytes Alignment of the buffers in bytes. Set null if you don't care this value.
+ *
+ * @return
+ *        - ESP_OK:
+ *        - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_dma_buffer_pool_get_info(esp_dma_buffer_pool_handle_t pool, size_t *buffer_size, size_t *alignment_bytes);
+
 //-----------------------Deprecated APIs-----------------------//
 /**
  * DMA malloc flags
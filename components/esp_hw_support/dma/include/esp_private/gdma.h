@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,6 +11,7 @@
 #include "soc/gdma_channel.h"
 #include "hal/gdma_types.h"
 #include "esp_err.h"
+#include "soc/soc_caps.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -236,6 +237,50 @@ esp_err_t gdma_apply_strategy(gdma_channel_handle_t dma_chan, const gdma_strateg
  */
 esp_err_t gdma_set_priority(gdma_channel_handle_t dma_chan, uint32_t priority);
 
+#if SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+/**
+ * @brief Set GDMA channel arbitration weight
+ *
+ * @note Only takes effect when `CONFIG_GDMA_ENABLE_WEIGHTED_ARBITRATION` is enabled.
+ *       Channels with the same priority are then served in a weighted round-robin manner,
+ *       a channel with weight N gets N bus slots for each slot a channel with weight 1 gets.
+ * @note By default, all GDMA channels are with the same weight: 1.
+ *
+ * @param[in] dma_chan GDMA channel handle, allocated by `gdma_new_channel`
+ * @param[in] weight Arbitration weight of GDMA channel, in the range of [1,GDMA_LL_CHANNEL_MAX_WEIGHT]
+ * @return
+ *      - ESP_OK: Set GDMA channel weight successfully
+ *      - ESP_ERR_INVALID_ARG: Set GDMA channel weight failed because of invalid argument, e.g. weight out of range
+ *      - ESP_ERR_NOT_SUPPORTED: Set GDMA channel weight failed because weighted arbitration is not enabled
+ */
+esp_err_t gdma_set_weight(gdma_channel_handle_t dma_chan, uint32_t weight);
+#endif // SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+
+/**
+ * @brief GDMA channel statistics
+ */
+typedef struct {
+    uint32_t start_count;      /*!< Number of transfers started by `gdma_start` */
+    uint32_t eof_count;        /*!< Number of EOF events, only counted when the channel interrupt is installed */
+    uint32_t descr_err_count;  /*!< Number of descriptor error events, only counted when the channel interrupt is installed */
+} gdma_channel_stats_t;
+
+/**
+ * @brief Get the statistics of a GDMA channel
+ *
+ * @note The counters wrap around on overflow. Comparing two snapshots taken over a known interval
+ *       gives the transfer rate of the channel, which helps to tune its priority and weight.
+ *
+ * @param[in] dma_chan GDMA channel handle, allocated by `gdma_new_channel`
+ * @param[out] stats Returned channel statistics
+ * @param[in] reset Whether to clear the counters after reading them
+ * @return
+ *      - ESP_OK: Get GDMA channel statistics successfully
+ *      - ESP_ERR_INVALID_ARG: Get GDMA channel statistics failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Get GDMA channel statistics failed because `CONFIG_GDMA_ENABLE_CHANNEL_STATS` is disabled
+ */
+esp_err_t gdma_get_channel_stats(gdma_channel_handle_t dma_chan, gdma_channel_stats_t *stats, bool reset);
+
 /**
  * @brief Delete GDMA channel
  * @note If you call `gdma_new_channel` several times for a same peripheral, make sure you call this API the same times.
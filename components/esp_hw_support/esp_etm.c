@@ -70,6 +70,12 @@ struct esp_etm_channel_t {
     esp_etm_task_handle_t task;   // which task is connect to the channel
 };
 
+typedef struct esp_etm_pipeline_t {
+    bool enabled;                       // whether the channels of the pipeline are enabled
+    size_t num_chans;                   // number of channels, one per link
+    esp_etm_channel_handle_t chans[];   // channels, in the order of the links
+} esp_etm_pipeline_t;
+
 // ETM driver platform, it's always a singleton
 static etm_platform_t s_platform;
 
@@ -99,6 +105,14 @@ static void etm_create_retention_module(etm_group_t *group)
 }
 #endif // ETM_USE_RETENTION_LINK
 
+// the ETM registers only hold the channel configuration, so they are backed up for sleep only after they change
+static inline void etm_mark_retention_dirty(etm_group_t *group)
+{
+#if ETM_USE_RETENTION_LINK
+    sleep_retention_module_mark_dirty(etm_reg_retention_info[group->group_id].module);
+#endif
+}
+
 static etm_group_t *etm_acquire_group_handle(int group_id)
 {
     bool new_group = false;
@@ -128,7 +142,8 @@ static etm_group_t *etm_acquire_group_handle(int group_id)
                         .arg = group,
                     },
                 },
-                .depends = RETENTION_MODULE_BITMAP_INIT(CLOCK_SYSTEM)
+                .depends = RETENTION_MODULE_BITMAP_INIT(CLOCK_SYSTEM),
+                .attribute = SLEEP_RETENTION_MODULE_ATTR_DIRTY_TRACKING,
             };
             if (sleep_retention_module_init(module, &init_param) != ESP_OK) {
                 // even though the sleep retention module init failed, ETM driver may still work, so just warning here
@@ -286,6 +301,7 @@ esp_err_t esp_etm_del_channel(esp_etm_channel_handle_t chan)
     // disconnect the channel from any event or task
     etm_ll_channel_set_event(group->hal.regs, chan_id, 0);
     etm_ll_channel_set_task(group->hal.regs, chan_id, 0);
+    etm_mark_retention_dirty(group);
 
     ESP_LOGD(TAG, "del etm channel (%d,%d)", group_id, chan_id);
     // recycle memory resource
@@ -299,6 +315,7 @@ esp_err_t esp_etm_channel_enable(esp_etm_channel_handle_t chan)
     ESP_RETURN_ON_FALSE(chan->fsm == ETM_CHAN_FSM_INIT, ESP_ERR_INVALID_STATE, TAG, "channel is not in init state");
     etm_group_t *group = chan->group;
     etm_ll_enable_channel(group->hal.regs, chan->chan_id);
+    etm_mark_retention_dirty(group);
     chan->fsm = ETM_CHAN_FSM_ENABLE;
     return ESP_OK;
 }
@@ -309,6 +326,7 @@ esp_err_t esp_etm_channel_disable(esp_etm_channel_handle_t chan)
     ESP_RETURN_ON_FALSE(chan->fsm == ETM_CHAN_FSM_ENABLE, ESP_ERR_INVALID_STATE, TAG, "channel not in enable state");
     etm_group_t *group = chan->group;
     etm_ll_disable_channel(group->hal.regs, chan->chan_id);
+    etm_mark_retention_dirty(group);
     chan->fsm = ETM_CHAN_FSM_INIT;
     return ESP_OK;
 }
@@ -329,6 +347,7 @@ esp_err_t esp_etm_channel_connect(esp_etm_channel_handle_t chan, esp_etm_event_h
     }
     etm_ll_channel_set_event(group->hal.regs, chan->chan_id, event_id);
     etm_ll_channel_set_task(group->hal.regs, chan->chan_id, task_id);
+    etm_mark_retention_dirty(group);
     chan->event = event;
     chan->task = task;
     ESP_LOGD(TAG, "event %"PRIu32" => channel %d", event_id, chan->chan_id);
@@ -348,6 +367,85 @@ esp_err_t esp_etm_del_task(esp_etm_task_handle_t task)
     return task->del(task);
 }
 
+static void etm_pipeline_destroy(esp_etm_pipeline_t *pipeline)
+{
+    for (size_t i = 0; i < pipeline->num_chans; i++) {
+        if (pipeline->chans[i]) {
+            esp_etm_del_channel(pipeline->chans[i]);
+        }
+    }
+    free(pipeline);
+}
+
+esp_err_t esp_etm_new_pipeline(const esp_etm_pipeline_config_t *config, esp_etm_pipeline_handle_t *ret_pipeline)
+{
+    esp_err_t ret = ESP_OK;
+    esp_etm_pipeline_t *pipeline = NULL;
+    ESP_RETURN_ON_FALSE(config && ret_pipeline && config->links && config->num_links, ESP_ERR_INVALID_ARG, TAG, "invalid args");
+    const esp_etm_pipeline_link_t *links = config->links;
+    // validate all the links before allocating any channel
+    for (size_t i = 0; i < config->num_links; i++) {
+        ESP_RETURN_ON_FALSE(links[i].event && links[i].task, ESP_ERR_INVALID_ARG, TAG, "link %zu is incomplete", i);
+        for (size_t j = 0; j < i; j++) {
+            ESP_RETURN_ON_FALSE(links[j].event != links[i].event || links[j].task != links[i].task, ESP_ERR_INVALID_ARG,
+                                TAG, "link %zu duplicates link %zu", i, j);
+        }
+    }
+
+    pipeline = heap_caps_calloc(1, sizeof(esp_etm_pipeline_t) + config->num_links * sizeof(esp_etm_channel_handle_t),
+                                ETM_MEM_ALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(pipeline, ESP_ERR_NO_MEM, TAG, "no mem for pipeline");
+    pipeline->num_chans = config->num_links;
+    esp_etm_channel_config_t chan_config = {
+        .flags.allow_pd = config->flags.allow_pd,
+    };
+    for (size_t i = 0; i < config->num_links; i++) {
+        ESP_GOTO_ON_ERROR(esp_etm_new_channel(&chan_config, &pipeline->chans[i]), err, TAG, "no channel for link %zu", i);
+        ESP_GOTO_ON_ERROR(esp_etm_channel_connect(pipeline->chans[i], links[i].event, links[i].task), err, TAG,
+                          "connect link %zu failed", i);
+    }
+    ESP_LOGD(TAG, "new etm pipeline with %zu links at %p", config->num_links, pipeline);
+    *ret_pipeline = pipeline;
+    return ESP_OK;
+
+err:
+    etm_pipeline_destroy(pipeline);
+    return ret;
+}
+
+esp_err_t esp_etm_del_pipeline(esp_etm_pipeline_handle_t pipeline)
+{
+    ESP_RETURN_ON_FALSE(pipeline, ESP_ERR_INVALID_ARG, TAG, "invalid args");
+    ESP_RETURN_ON_FALSE(!pipeline->enabled, ESP_ERR_INVALID_STATE, TAG, "pipeline is still enabled");
+    ESP_LOGD(TAG, "del etm pipeline %p", pipeline);
+    etm_pipeline_destroy(pipeline);
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_pipeline_enable(esp_etm_pipeline_handle_t pipeline)
+{
+    ESP_RETURN_ON_FALSE(pipeline, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!pipeline->enabled, ESP_ERR_INVALID_STATE, TAG, "pipeline is enabled already");
+    // enable the downstream stages first, so that they are ready when the upstream ones trigger them
+    for (size_t i = pipeline->num_chans; i > 0; i--) {
+        esp_etm_channel_enable(pipeline->chans[i - 1]);
+    }
+    pipeline->enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_pipeline_disable(esp_etm_pipeline_handle_t pipeline)
+{
+    ESP_RETURN_ON_FALSE(pipeline, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(pipeline->enabled, ESP_ERR_INVALID_STATE, TAG, "pipeline is not enabled");
+    // stop the upstream stages first, so that no stage is left half triggered
+    for (size_t i = 0; i < pipeline->num_chans; i++) {
+        esp_etm_channel_disable(pipeline->chans[i]);
+    }
+    pipeline->enabled = false;
+    return ESP_OK;
+}
+
 esp_err_t esp_etm_dump(FILE *out_stream)
 {
     etm_group_t *group = NULL;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -161,6 +161,71 @@ esp_err_t esp_async_memcpy_uninstall(async_memcpy_handle_t mcp);
  */
 esp_err_t esp_async_memcpy(async_memcpy_handle_t mcp, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
 
+/**
+ * @brief Type of a memory block copied by a scatter-gather request
+ */
+typedef struct {
+    void *dst;   /*!< Destination address (copy to) */
+    void *src;   /*!< Source address (copy from) */
+    size_t size; /*!< Number of bytes to copy */
+} async_memcpy_block_t;
+
+/**
+ * @brief Type of a 2D memory copy request, e.g. to copy a tile of an image
+ */
+typedef struct {
+    void *dst;         /*!< Address of the first row of the destination */
+    void *src;         /*!< Address of the first row of the source */
+    size_t width;      /*!< Number of bytes to copy in each row */
+    size_t height;     /*!< Number of rows to copy */
+    size_t dst_stride; /*!< Distance in bytes between the starts of two rows in the destination, no less than width */
+    size_t src_stride; /*!< Distance in bytes between the starts of two rows in the source, no less than width */
+} async_memcpy_2d_config_t;
+
+/**
+ * @brief Send an asynchronous scatter-gather memory copy request
+ *
+ * All the blocks are copied by a single DMA transaction, and the callback is invoked once, after the last block is copied.
+ *
+ * @note Each block must meet the same address and size alignment as the memory of `esp_async_memcpy`.
+ *       In addition, a destination block behind a cache must be aligned to the cache line size, both in address and size.
+ * @note The callback function is invoked in interrupt context, never do blocking jobs in the callback.
+ *
+ * @param[in] mcp Handle of async memcpy driver that returned from `esp_async_memcpy_install`
+ * @param[in] blocks Array of the blocks to copy, it can be freed after this function returns
+ * @param[in] num_blocks Number of blocks in the array
+ * @param[in] cb_isr Callback function, which got invoked in interrupt context. Set to NULL can bypass the callback.
+ * @param[in] cb_args User defined argument to be passed to the callback function
+ * @return
+ *      - ESP_OK: Send memory copy request successfully
+ *      - ESP_ERR_INVALID_ARG: Send memory copy request failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Send memory copy request failed because out of memory
+ *      - ESP_ERR_NOT_SUPPORTED: Send memory copy request failed because the DMA backend doesn't support scatter-gather
+ *      - ESP_FAIL: Send memory copy request failed because of other error
+ */
+esp_err_t esp_async_memcpy_sg(async_memcpy_handle_t mcp, const async_memcpy_block_t *blocks, size_t num_blocks,
+                              async_memcpy_isr_cb_t cb_isr, void *cb_args);
+
+/**
+ * @brief Send an asynchronous 2D memory copy request
+ *
+ * The rows are copied as the blocks of a scatter-gather request, see `esp_async_memcpy_sg`.
+ * Rows contiguous in both the source and the destination are merged into one block.
+ *
+ * @param[in] mcp Handle of async memcpy driver that returned from `esp_async_memcpy_install`
+ * @param[in] config 2D memory copy configuration
+ * @param[in] cb_isr Callback function, which got invoked in interrupt context. Set to NULL can bypass the callback.
+ * @param[in] cb_args User defined argument to be passed to the callback function
+ * @return
+ *      - ESP_OK: Send memory copy request successfully
+ *      - ESP_ERR_INVALID_ARG: Send memory copy request failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Send memory copy request failed because out of memory
+ *      - ESP_ERR_NOT_SUPPORTED: Send memory copy request failed because the DMA backend doesn't support scatter-gather
+ *      - ESP_FAIL: Send memory copy request failed because of other error
+ */
+esp_err_t esp_async_memcpy_2d(async_memcpy_handle_t mcp, const async_memcpy_2d_config_t *config,
+                              async_memcpy_isr_cb_t cb_isr, void *cb_args);
+
 #if SOC_ETM_SUPPORTED
 /**
  * @brief Async memory copy specific events that supported by the ETM module
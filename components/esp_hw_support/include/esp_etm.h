@@ -28,6 +28,11 @@ typedef struct esp_etm_event_t *esp_etm_event_handle_t;
  */
 typedef struct esp_etm_task_t *esp_etm_task_handle_t;
 
+/**
+ * @brief ETM pipeline handle
+ */
+typedef struct esp_etm_pipeline_t *esp_etm_pipeline_handle_t;
+
 /**
  * @brief ETM channel configuration
  */
@@ -135,6 +140,83 @@ esp_err_t esp_etm_del_event(esp_etm_event_handle_t event);
  */
 esp_err_t esp_etm_del_task(esp_etm_task_handle_t task);
 
+/**
+ * @brief Link of an ETM pipeline
+ */
+typedef struct {
+    esp_etm_event_handle_t event; /*!< ETM event obtained from a driver/peripheral, e.g. `xxx_new_etm_event` */
+    esp_etm_task_handle_t task;   /*!< ETM task obtained from a driver/peripheral, e.g. `xxx_new_etm_task`,
+                                       triggered by the event */
+} esp_etm_pipeline_link_t;
+
+/**
+ * @brief ETM pipeline configuration
+ */
+typedef struct {
+    const esp_etm_pipeline_link_t *links; /*!< Links of the pipeline, each one is given an ETM channel. An event can
+                                               trigger several tasks, by giving it several links. */
+    size_t num_links;                     /*!< Number of links */
+    /// Extra configuration flags for ETM pipeline
+    struct etm_pipeline_flags {
+        uint32_t allow_pd : 1; /*!< Same as `esp_etm_channel_config_t::etm_chan_flags::allow_pd`, for all the channels */
+    } flags; /*!< ETM pipeline flags */
+} esp_etm_pipeline_config_t;
+
+/**
+ * @brief Allocate and connect the ETM channels of a pipeline
+ *
+ * A pipeline chains peripherals without any CPU work, e.g. "timer alarm -> ADC conversion -> DMA copy -> GPIO toggle",
+ * with one link per event and task pair. Either all the channels are allocated, or none.
+ *
+ * @note The pipeline does not own the events and tasks, delete them with `esp_etm_del_event` and `esp_etm_del_task`
+ *       after the pipeline.
+ * @param[in] config ETM pipeline configuration
+ * @param[out] ret_pipeline Returned ETM pipeline handle
+ * @return
+ *      - ESP_OK: Allocate ETM pipeline successfully
+ *      - ESP_ERR_INVALID_ARG: Allocate ETM pipeline failed because of invalid argument, e.g. a link without event or
+ *        task, or the same link given twice
+ *      - ESP_ERR_NO_MEM: Allocate ETM pipeline failed because of out of memory
+ *      - ESP_ERR_NOT_FOUND: Allocate ETM pipeline failed because there are not enough free channels
+ *      - ESP_FAIL: Allocate ETM pipeline failed because of other reasons
+ */
+esp_err_t esp_etm_new_pipeline(const esp_etm_pipeline_config_t *config, esp_etm_pipeline_handle_t *ret_pipeline);
+
+/**
+ * @brief Delete an ETM pipeline and free its channels
+ *
+ * @param[in] pipeline ETM pipeline handle that created by `esp_etm_new_pipeline`
+ * @return
+ *      - ESP_OK: Delete ETM pipeline successfully
+ *      - ESP_ERR_INVALID_ARG: Delete ETM pipeline failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Delete ETM pipeline failed because the pipeline is still enabled
+ */
+esp_err_t esp_etm_del_pipeline(esp_etm_pipeline_handle_t pipeline);
+
+/**
+ * @brief Enable all the channels of an ETM pipeline
+ *
+ * @note The channels are enabled from the last link to the first one, so that no stage is triggered before the stages
+ *       it triggers are ready.
+ * @param[in] pipeline ETM pipeline handle that created by `esp_etm_new_pipeline`
+ * @return
+ *      - ESP_OK: Enable ETM pipeline successfully
+ *      - ESP_ERR_INVALID_ARG: Enable ETM pipeline failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Enable ETM pipeline failed because the pipeline has been enabled already
+ */
+esp_err_t esp_etm_pipeline_enable(esp_etm_pipeline_handle_t pipeline);
+
+/**
+ * @brief Disable all the channels of an ETM pipeline, from the first link to the last one
+ *
+ * @param[in] pipeline ETM pipeline handle that created by `esp_etm_new_pipeline`
+ * @return
+ *      - ESP_OK: Disable ETM pipeline successfully
+ *      - ESP_ERR_INVALID_ARG: Disable ETM pipeline failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Disable ETM pipeline failed because the pipeline is not enabled yet
+ */
+esp_err_t esp_etm_pipeline_disable(esp_etm_pipeline_handle_t pipeline);
+
 /**
  * @brief Dump ETM channel usages to the given IO stream
  *
@@ -41,6 +41,7 @@ extern "C" {
 #define ESP_INTR_FLAG_EDGE          (1<<9)  ///< Edge-triggered interrupt
 #define ESP_INTR_FLAG_IRAM          (1<<10) ///< ISR can be called if cache is disabled
 #define ESP_INTR_FLAG_INTRDISABLED  (1<<11) ///< Return with this interrupt disabled
+#define ESP_INTR_FLAG_DIRECT        (1<<12) ///< ISR is called straight from the CPU interrupt table. Needs ESP_INTR_FLAG_IRAM, can't be shared
 
 #define ESP_INTR_FLAG_LOWMED    (ESP_INTR_FLAG_LEVEL1|ESP_INTR_FLAG_LEVEL2|ESP_INTR_FLAG_LEVEL3) ///< Low and medium prio interrupts. These can be handled in C.
 #define ESP_INTR_FLAG_HIGH      (ESP_INTR_FLAG_LEVEL4|ESP_INTR_FLAG_LEVEL5|ESP_INTR_FLAG_LEVEL6|ESP_INTR_FLAG_NMI) ///< High level interrupts. Need to be handled in assembly.
@@ -134,7 +135,11 @@ esp_err_t esp_intr_reserve(int intno, int cpu);
  *               1, 2 or 3. If ESP_INTR_FLAG_SHARED mask is provided, a shared interrupt of
  *               the given level will be allocated (or level 1 if not specified).
  *               Setting ESP_INTR_FLAG_INTRDISABLED will return from this function with the
- *               interrupt disabled.
+ *               interrupt disabled. Setting ESP_INTR_FLAG_DIRECT allocates an interrupt which
+ *               is never shared and whose handler is called by the CPU interrupt dispatcher
+ *               without any wrapper, for the lowest and most stable latency. It requires
+ *               ESP_INTR_FLAG_IRAM and a handler, and defaults to level 3 on targets where
+ *               the level of an interrupt is configurable.
  * @param handler The interrupt handler. Must be NULL when an interrupt of level >3
  *               is requested, because these types of interrupts aren't C-callable.
  * @param arg    Optional argument for passed to the interrupt handler
@@ -396,6 +396,24 @@ void *regdma_find_prev_module_link_tail(void *link, void *tail, int entry, int m
  */
 void *regdma_find_next_module_link_head(void *link, void *tail, int entry, int module);
 
+/**
+ * @brief Collect the nodes of the specified module that back up registers in the REGDMA linked list
+ * indicated by the entry argument starting from the link argument to the end of the tail argument
+ *
+ * Nodes that are already in the links array are not added again, so that the nodes shared by several
+ * linked lists can be collected by calling this function for each entry with the same links array.
+ *
+ * @param  link   The REGDMA linkded list head pointer
+ * @param  tail   The REGDMA linkded list tail pointer
+ * @param  entry  For nodes that support branching, use the branch specified by entry argument recursively
+ * @param  module Module bitmap Identification
+ * @param  links  The array the found nodes are added to
+ * @param  num    The number of nodes already in the links array
+ * @param  max    The capacity of the links array
+ * @return        The number of nodes in the links array, at most max
+ */
+int regdma_find_module_backup_links(void *link, void *tail, int entry, int module, void *links[], int num, int max);
+
 #define regdma_link_init_safe(pcfg, branch, module, ...)    regdma_link_init((pcfg), (branch), (module), ESP_VA_NARG(__VA_ARGS__), ##__VA_ARGS__)
 
 #define regdma_link_update_next_safe(link, ...)             regdma_link_update_next((link), ESP_VA_NARG(__VA_ARGS__), ##__VA_ARGS__)
@@ -45,7 +45,10 @@ typedef struct {
 } sleep_retention_module_callbacks_t;
 
 typedef enum {
-    SLEEP_RETENTION_MODULE_ATTR_PASSIVE = 0x1
+    SLEEP_RETENTION_MODULE_ATTR_PASSIVE = 0x1,
+    SLEEP_RETENTION_MODULE_ATTR_DIRTY_TRACKING = 0x2  /*!< The module calls sleep_retention_module_mark_dirty() after changing its
+                                                        retained registers, their backup is skipped while they are unchanged.
+                                                        Ignored for passive modules */
 } sleep_retention_module_attribute_t;
 
 /**
@@ -149,6 +152,32 @@ esp_err_t sleep_retention_module_allocate(sleep_retention_module_t module);
  */
 esp_err_t sleep_retention_module_free(sleep_retention_module_t module);
 
+/**
+ * @brief Mark the retained registers of a module as changed
+ *
+ * For a module initialized with the SLEEP_RETENTION_MODULE_ATTR_DIRTY_TRACKING
+ * attribute, the registers are backed up by the next sleep that powers down
+ * the TOP domain, the following sleeps skip their backup and restore them
+ * from the same retention buffer, until this function is called again.
+ * It must be called after any change of the registers listed in the retention
+ * linked list of the module. The call does nothing for other modules.
+ *
+ * @note This function can be called from an ISR.
+ *
+ * @param module   the module number whose registers have changed
+ */
+void sleep_retention_module_mark_dirty(sleep_retention_module_t module);
+
+/**
+ * @brief Notify that the retention context has been backed up
+ *
+ * The dirty tracking modules are set clean, the backup of their registers is
+ * skipped by the following sleeps until sleep_retention_module_mark_dirty() is
+ * called. It can only be called by the sleep procedure after a sleep that
+ * powers down the TOP domain.
+ */
+void sleep_retention_module_backup_done(void);
+
 /**
  * @brief Force take the power lock so that during sleep the power domain won't be powered off.
  *
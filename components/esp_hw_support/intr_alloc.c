@@ -79,6 +79,8 @@ struct shared_vector_desc_t {
 #define VECDESC_FL_SHARED       (1<<2)
 #define VECDESC_FL_NONSHARED    (1<<3)
 #define VECDESC_FL_TYPE_MASK    (0xf)
+/* Set along with VECDESC_FL_NONSHARED when the ISR was allocated with ESP_INTR_FLAG_DIRECT */
+#define VECDESC_FL_DIRECT       (1<<4)
 
 #if SOC_CPU_HAS_FLEXIBLE_INTC
 /* On targets that have configurable interrupts levels, store the assigned level in the flags */
@@ -539,10 +541,19 @@ esp_err_t esp_intr_alloc_intrstatus_bind(int source, int flags, uint32_t intrsta
     if (shared_handle != NULL && (flags & ESP_INTR_FLAG_SHARED) == 0) {
         return ESP_ERR_INVALID_ARG;
     }
+    //Direct ints can't be shared and need an IRAM-resident handler
+    if ((flags & ESP_INTR_FLAG_DIRECT) && ((flags & ESP_INTR_FLAG_SHARED) || !handler || !(flags & ESP_INTR_FLAG_IRAM))) {
+        return ESP_ERR_INVALID_ARG;
+    }
     //Default to prio 1 for shared interrupts. Default to prio 1, 2 or 3 for non-shared interrupts.
     if ((flags & ESP_INTR_FLAG_LEVELMASK) == 0) {
         if (flags & ESP_INTR_FLAG_SHARED) {
             flags |= ESP_INTR_FLAG_LEVEL1;
+#if SOC_CPU_HAS_FLEXIBLE_INTC
+        } else if (flags & ESP_INTR_FLAG_DIRECT) {
+            //Any int can be given any level: don't let other C handlers preempt a direct one
+            flags |= ESP_INTR_FLAG_LEVEL3;
+#endif
         } else {
             flags |= ESP_INTR_FLAG_LOWMED;
         }
@@ -629,7 +640,11 @@ esp_err_t esp_intr_alloc_intrstatus_bind(int source, int flags, uint32_t intrsta
     } else {
         //Mark as unusable for other interrupt sources. This is ours now!
         vd->flags = VECDESC_FL_NONSHARED;
-        if (handler) {
+        if (flags & ESP_INTR_FLAG_DIRECT) {
+            //No wrapper, even for tracing: the CPU dispatcher calls the handler itself
+            vd->flags |= VECDESC_FL_DIRECT;
+            esp_cpu_intr_set_handler(intr, (esp_cpu_intr_handler_t)handler, arg);
+        } else if (handler) {
 #if CONFIG_APPTRACE_SV_ENABLE
             non_shared_isr_arg_t *ns_isr_arg = heap_caps_malloc(sizeof(non_shared_isr_arg_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
             if (!ns_isr_arg) {
@@ -744,6 +759,9 @@ esp_err_t ESP_INTR_IRAM_ATTR esp_intr_set_in_iram(intr_handle_t handle, bool is_
     if (vd->flags & VECDESC_FL_SHARED) {
         return ESP_ERR_INVALID_ARG;
     }
+    if ((vd->flags & VECDESC_FL_DIRECT) && !is_in_iram) {
+        return ESP_ERR_INVALID_ARG;
+    }
     portENTER_CRITICAL(&spinlock);
     uint32_t mask = (1 << vd->intno);
     if (is_in_iram) {
@@ -831,7 +849,7 @@ static esp_err_t intr_free_for_current_cpu(intr_handle_t handle)
     if ((handle->vector_desc->flags & VECDESC_FL_NONSHARED) || free_shared_vector) {
         ESP_EARLY_LOGV(TAG, "esp_intr_free: Disabling int, killing handler");
 #if CONFIG_APPTRACE_SV_ENABLE
-        if (!free_shared_vector) {
+        if (!free_shared_vector && !(handle->vector_desc->flags & VECDESC_FL_DIRECT)) {
             void *isr_arg = esp_cpu_intr_get_handler_arg(handle->vector_desc->intno);
             if (isr_arg) {
                 free(isr_arg);
@@ -843,7 +861,7 @@ static esp_err_t intr_free_for_current_cpu(intr_handle_t handle)
         //Theoretically, we could free the vector_desc... not sure if that's worth the few bytes of memory
         //we save.(We can also not use the same exit path for empty shared ints anymore if we delete
         //the desc.) For now, just mark it as free.
-        handle->vector_desc->flags &= ~(VECDESC_FL_NONSHARED|VECDESC_FL_RESERVED|VECDESC_FL_SHARED);
+        handle->vector_desc->flags &= ~(VECDESC_FL_NONSHARED|VECDESC_FL_RESERVED|VECDESC_FL_SHARED|VECDESC_FL_DIRECT);
 #if SOC_CPU_HAS_FLEXIBLE_INTC
         //Clear the assigned level
         handle->vector_desc->flags &= ~(VECDESC_FL_LEVEL_MASK << VECDESC_FL_LEVEL_SHIFT);
@@ -1073,6 +1091,8 @@ esp_err_t esp_intr_dump(FILE *stream)
                     }
                 } else if (vd->flags & VECDESC_FL_RESERVED)  {
                     fprintf(stream, "Reserved (run-time)");
+                } else if (vd->flags & VECDESC_FL_DIRECT) {
+                    fprintf(stream, "Used (direct): %s", esp_isr_names[vd->source]);
                 } else if (vd->flags & VECDESC_FL_NONSHARED) {
                     fprintf(stream, "Used: %s", esp_isr_names[vd->source]);
                 } else if (vd->flags & VECDESC_FL_SHARED) {
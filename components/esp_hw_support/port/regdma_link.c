@@ -717,6 +717,30 @@ void * regdma_find_prev_module_link_tail(void *link, void *tail, int entry, int
     return NULL;
 }
 
+int regdma_find_module_backup_links(void *link, void *tail, int entry, int module, void *links[], int num, int max)
+{
+    assert(entry < REGDMA_LINK_ENTRY_NUM);
+
+    void *next = link;
+    if (link) {
+        do {
+            if ((regdma_link_get_stats(next)->module == module) && !REGDMA_LINK_HEAD(next).skip_b) {
+                int i = 0;
+                while ((i < num) && (links[i] != next)) {
+                    i++;
+                }
+                if ((i == num) && (num < max)) {
+                    links[num++] = next;
+                }
+            }
+            if (next == tail) {
+                break;
+            }
+        } while ((next = regdma_link_get_next(next, entry)) != NULL);
+    }
+    return num;
+}
+
 static __attribute__((unused)) const char *TAG = "regdma_link";
 static const char* s_link_mode_str[] = { "CONTINUOUS", "ADDR_MAP", "WRITE", "WAIT" };
 static const char* s_boolean_str[] = { "false", "true" };
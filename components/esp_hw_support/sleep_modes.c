@@ -1130,6 +1130,11 @@ static esp_err_t IRAM_ATTR esp_sleep_start(uint32_t sleep_flags, uint32_t clk_fl
             if (sleep_flags & PMU_SLEEP_PD_TOP) {
                 sleep_retention_do_system_retention(false);
             }
+#endif
+#if SOC_PM_SUPPORT_TOP_PD && SOC_PAU_SUPPORTED
+            if (sleep_flags & PMU_SLEEP_PD_TOP) {
+                sleep_retention_module_backup_done();
+            }
 #endif
         }
         misc_modules_wake_prepare(sleep_flags);
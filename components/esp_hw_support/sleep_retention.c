@@ -20,6 +20,7 @@
 #include "esp_private/sleep_retention.h"
 #include "sdkconfig.h"
 #include "esp_pmu.h"
+#include "freertos/FreeRTOS.h"
 
 #if SOC_PM_PAU_REGDMA_UPDATE_CACHE_BEFORE_WAIT_COMPARE
 #include "soc/pmu_reg.h" // for PMU_DATE_REG, it can provide full 32 bit read and write access
@@ -38,6 +39,9 @@ struct sleep_retention_module_object {
     sleep_retention_module_bitmap_t    references;  /* A bitmap indicating all other modules that depend on (or reference) the current module,
                                                      * It will update at runtime based on whether the module is referenced by other modules */
     sleep_retention_module_attribute_t attributes;  /* A bitmap indicating attribute of the current module */
+    void                             **backup_links; /* The nodes of the module whose backup is skipped while the module is clean,
+                                                     * only for modules with the SLEEP_RETENTION_MODULE_ATTR_DIRTY_TRACKING attribute */
+    int                                backup_links_num;
 };
 
 static inline void sleep_retention_module_object_ctor(struct sleep_retention_module_object * const self, sleep_retention_module_callbacks_t *cbs)
@@ -46,6 +50,8 @@ static inline void sleep_retention_module_object_ctor(struct sleep_retention_mod
     self->dependents = (sleep_retention_module_bitmap_t){ .bitmap = { 0 } };
     self->references = (sleep_retention_module_bitmap_t){ .bitmap = { 0 } };
     self->attributes = 0;
+    self->backup_links = NULL;
+    self->backup_links_num = 0;
 }
 
 static inline void sleep_retention_module_object_dtor(struct sleep_retention_module_object * const self)
@@ -113,6 +119,11 @@ static inline bool module_is_passive(struct sleep_retention_module_object * cons
     return (get_attributes(self) & SLEEP_RETENTION_MODULE_ATTR_PASSIVE) ? true : false;
 }
 
+static inline bool module_is_dirty_tracking(struct sleep_retention_module_object * const self)
+{
+    return (get_attributes(self) & SLEEP_RETENTION_MODULE_ATTR_DIRTY_TRACKING) ? true : false;
+}
+
 static inline bool module_is_inited(sleep_retention_module_t module)
 {
     sleep_retention_module_bitmap_t inited_modules = sleep_retention_get_inited_modules();
@@ -198,6 +209,11 @@ typedef struct {
     regdma_link_priority_t highpri;
     sleep_retention_module_bitmap_t inited_modules;
     sleep_retention_module_bitmap_t created_modules;
+    /* The dirty tracking modules whose registers may have changed since the
+     * last backup, the backup of the other dirty tracking modules is skipped,
+     * their retention buffers still hold the current register context. */
+    sleep_retention_module_bitmap_t dirty_modules;
+    portMUX_TYPE dirty_lock;
 
     struct sleep_retention_module_object instance[SLEEP_RETENTION_MODULE_MAX + 1];
 
@@ -207,7 +223,9 @@ typedef struct {
 static DRAM_ATTR __attribute__((unused)) sleep_retention_t s_retention = {
     .highpri = (uint8_t)-1,
     .inited_modules = (sleep_retention_module_bitmap_t){ .bitmap = { 0 } },
-    .created_modules = (sleep_retention_module_bitmap_t){ .bitmap = { 0 } }
+    .created_modules = (sleep_retention_module_bitmap_t){ .bitmap = { 0 } },
+    .dirty_modules = (sleep_retention_module_bitmap_t){ .bitmap = { 0 } },
+    .dirty_lock = portMUX_INITIALIZER_UNLOCKED
 };
 
 #define SLEEP_RETENTION_ENTRY_BITMAP_MASK       (BIT(REGDMA_LINK_ENTRY_NUM) - 1)
@@ -795,6 +813,89 @@ esp_err_t sleep_retention_module_deinit(sleep_retention_module_t module)
     return err;
 }
 
+#define SLEEP_RETENTION_BACKUP_LINKS_INIT_NUM   (8)
+
+static void sleep_retention_module_track_backup_links(sleep_retention_module_t module)
+{
+    void **links = NULL;
+    int num = 0;
+    _lock_acquire_recursive(&s_retention.lock);
+    for (int max = SLEEP_RETENTION_BACKUP_LINKS_INIT_NUM; ; max <<= 1) {
+        void **temp = heap_caps_realloc(links, max * sizeof(void *), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (temp == NULL) {
+            /* Not an error, the module is then backed up on every sleep */
+            ESP_LOGW(TAG, "No memory to track the backup of module %d", module);
+            heap_caps_free(links);
+            links = NULL;
+            num = 0;
+            break;
+        }
+        links = temp;
+        num = 0;
+        for (regdma_link_priority_t priority = 0; priority < SLEEP_RETENTION_REGDMA_LINK_NR_PRIORITIES; priority++) {
+            for (int entry = 0; entry < ARRAY_SIZE(s_retention.lists[priority].entries); entry++) {
+                num = regdma_find_module_backup_links(s_retention.lists[priority].entries[entry],
+                        s_retention.lists[priority].entries_tail, entry, module, links, num, max);
+            }
+        }
+        if (num < max) {
+            break;
+        }
+    }
+    /* The nodes of a newly created module are not skipped, the module starts dirty */
+    portENTER_CRITICAL(&s_retention.dirty_lock);
+    s_retention.instance[module].backup_links = links;
+    s_retention.instance[module].backup_links_num = num;
+    if (num) {
+        s_retention.dirty_modules.bitmap[module >> 5] |= BIT(module % 32);
+    }
+    portEXIT_CRITICAL(&s_retention.dirty_lock);
+    _lock_release_recursive(&s_retention.lock);
+}
+
+static void sleep_retention_module_untrack_backup_links(sleep_retention_module_t module)
+{
+    portENTER_CRITICAL(&s_retention.dirty_lock);
+    void **links = s_retention.instance[module].backup_links;
+    s_retention.instance[module].backup_links = NULL;
+    s_retention.instance[module].backup_links_num = 0;
+    s_retention.dirty_modules.bitmap[module >> 5] &= ~BIT(module % 32);
+    portEXIT_CRITICAL(&s_retention.dirty_lock);
+    heap_caps_free(links);
+}
+
+void IRAM_ATTR sleep_retention_module_mark_dirty(sleep_retention_module_t module)
+{
+    assert(module >= SLEEP_RETENTION_MODULE_MIN && module <= SLEEP_RETENTION_MODULE_MAX);
+    struct sleep_retention_module_object *self = &s_retention.instance[module];
+    portENTER_CRITICAL_SAFE(&s_retention.dirty_lock);
+    if (self->backup_links_num && !(s_retention.dirty_modules.bitmap[module >> 5] & BIT(module % 32))) {
+        for (int i = 0; i < self->backup_links_num; i++) {
+            REGDMA_LINK_HEAD(self->backup_links[i]).skip_b = 0;
+        }
+        s_retention.dirty_modules.bitmap[module >> 5] |= BIT(module % 32);
+    }
+    portEXIT_CRITICAL_SAFE(&s_retention.dirty_lock);
+}
+
+void IRAM_ATTR sleep_retention_module_backup_done(void)
+{
+    portENTER_CRITICAL_SAFE(&s_retention.dirty_lock);
+    for (int i = 0; i < SLEEP_RETENTION_MODULE_BITMAP_SZ; i++) {
+        uint32_t bitmap = s_retention.dirty_modules.bitmap[i];
+        for (int j = 0; bitmap; bitmap >>= 1, j++) {
+            if (bitmap & BIT(0)) {
+                struct sleep_retention_module_object *self = &s_retention.instance[(i << 5) + j];
+                for (int k = 0; k < self->backup_links_num; k++) {
+                    REGDMA_LINK_HEAD(self->backup_links[k]).skip_b = 1;
+                }
+            }
+        }
+        s_retention.dirty_modules.bitmap[i] = 0;
+    }
+    portEXIT_CRITICAL_SAFE(&s_retention.dirty_lock);
+}
+
 static esp_err_t sleep_retention_passive_module_allocate(sleep_retention_module_t module)
 {
     assert(module >= SLEEP_RETENTION_MODULE_MIN && module <= SLEEP_RETENTION_MODULE_MAX);
@@ -853,6 +954,9 @@ esp_err_t sleep_retention_module_allocate(sleep_retention_module_t module)
                     err = (*fn)(s_retention.instance[module].cbs.create.arg);
                 }
             }
+            if ((err == ESP_OK) && module_is_dirty_tracking(&s_retention.instance[module])) {
+                sleep_retention_module_track_backup_links(module);
+            }
         } else {
             err = ESP_ERR_INVALID_STATE;
         }
@@ -901,6 +1005,7 @@ esp_err_t sleep_retention_module_free(sleep_retention_module_t module)
     _lock_acquire_recursive(&s_retention.lock);
     if (!module_is_passive(&s_retention.instance[module])) {
         if (module_is_inited(module) && module_is_created(module)) {
+            sleep_retention_module_untrack_backup_links(module);
             sleep_retention_entries_destroy(module);
 
             sleep_retention_module_bitmap_t depends = get_dependencies(&s_retention.instance[module]);
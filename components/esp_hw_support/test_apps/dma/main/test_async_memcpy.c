@@ -227,6 +227,92 @@ TEST_CASE("memory copy by DMA (blocking)", "[async mcp]")
     vSemaphoreDelete(sem);
 }
 
+#if SOC_GDMA_SUPPORTED
+static void test_memory_copy_2d(async_memcpy_handle_t driver)
+{
+    // copy a 64x10 tile from a 256 byte wide source image to a 128 byte wide destination image
+    const size_t width = 64;
+    const size_t height = 10;
+    const size_t src_stride = 256;
+    const size_t dst_stride = 128;
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    uint8_t *src = heap_caps_aligned_calloc(64, height, src_stride, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    uint8_t *dst = heap_caps_aligned_calloc(64, height, dst_stride, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(dst);
+    for (int i = 0; i < height * src_stride; i++) {
+        src[i] = i % 251;
+    }
+
+    async_memcpy_2d_config_t tile = {
+        .dst = dst,
+        .src = src + 64,
+        .width = width,
+        .height = height,
+        .dst_stride = dst_stride,
+        .src_stride = src_stride,
+    };
+    TEST_ESP_OK(esp_async_memcpy_2d(driver, &tile, test_async_memcpy_cb_v1, sem));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(sem, pdMS_TO_TICKS(10)));
+    for (int row = 0; row < height; row++) {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(src + 64 + row * src_stride, dst + row * dst_stride, width);
+        // the bytes between the rows are not written
+        for (int i = width; i < dst_stride; i++) {
+            TEST_ASSERT_EQUAL_HEX8(0, dst[row * dst_stride + i]);
+        }
+    }
+
+    // the blocks of a scatter-gather request are copied by one transaction, with one callback
+    memset(dst, 0, height * dst_stride);
+    async_memcpy_block_t blocks[] = {
+        { .dst = dst + 3 * dst_stride, .src = src, .size = 64 },
+        { .dst = dst, .src = src + 2 * src_stride, .size = 128 },
+    };
+    TEST_ESP_OK(esp_async_memcpy_sg(driver, blocks, 2, test_async_memcpy_cb_v1, sem));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(sem, pdMS_TO_TICKS(10)));
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(sem, pdMS_TO_TICKS(10)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(src, dst + 3 * dst_stride, 64);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(src + 2 * src_stride, dst, 128);
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_async_memcpy_sg(driver, blocks, 0, NULL, NULL));
+    tile.dst_stride = width - 1;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_async_memcpy_2d(driver, &tile, NULL, NULL));
+
+    free(src);
+    free(dst);
+    vSemaphoreDelete(sem);
+}
+#endif // SOC_GDMA_SUPPORTED
+
+TEST_CASE("memory copy 2D and scatter-gather by DMA", "[async mcp]")
+{
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    async_memcpy_handle_t driver = NULL;
+
+#if SOC_AHB_GDMA_SUPPORTED
+    printf("Testing 2D memcpy by AHB GDMA\r\n");
+    TEST_ESP_OK(esp_async_memcpy_install_gdma_ahb(&config, &driver));
+    test_memory_copy_2d(driver);
+    TEST_ESP_OK(esp_async_memcpy_uninstall(driver));
+#endif // SOC_AHB_GDMA_SUPPORTED
+
+#if SOC_AXI_GDMA_SUPPORTED
+    printf("Testing 2D memcpy by AXI GDMA\r\n");
+    TEST_ESP_OK(esp_async_memcpy_install_gdma_axi(&config, &driver));
+    test_memory_copy_2d(driver);
+    TEST_ESP_OK(esp_async_memcpy_uninstall(driver));
+#endif // SOC_AXI_GDMA_SUPPORTED
+
+#if SOC_CP_DMA_SUPPORTED
+    printf("CP DMA doesn't support scatter-gather\r\n");
+    TEST_ESP_OK(esp_async_memcpy_install_cpdma(&config, &driver));
+    uint8_t buf[64];
+    async_memcpy_block_t block = { .dst = buf, .src = buf + 32, .size = 32 };
+    TEST_ESP_ERR(ESP_ERR_NOT_SUPPORTED, esp_async_memcpy_sg(driver, &block, 1, NULL, NULL));
+    TEST_ESP_OK(esp_async_memcpy_uninstall(driver));
+#endif // SOC_CP_DMA_SUPPORTED
+}
+
 TEST_CASE("memory copy with dest address unaligned", "[async mcp]")
 {
     [[maybe_unused]] async_memcpy_config_t driver_config = {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -79,3 +79,43 @@ TEST_CASE("test esp_dma_is_buffer_alignment_satisfied", "[dma_utils]")
     is_aligned = esp_dma_is_buffer_alignment_satisfied(test_ptr + 3, test_size, dma_mem_info);
     TEST_ASSERT(!is_aligned);
 }
+
+TEST_CASE("test esp_dma buffer pool", "[dma_utils]")
+{
+    const size_t num_buffers = 4;
+    esp_dma_buffer_pool_config_t pool_config = {
+        .buffer_size = 100,
+        .num_buffers = num_buffers,
+        .dma_mem_info = {
+            .dma_alignment_bytes = 4,
+        },
+    };
+    esp_dma_buffer_pool_handle_t pool = NULL;
+    TEST_ESP_OK(esp_dma_new_buffer_pool(&pool_config, &pool));
+    size_t buffer_size = 0;
+    size_t alignment = 0;
+    TEST_ESP_OK(esp_dma_buffer_pool_get_info(pool, &buffer_size, &alignment));
+    ESP_LOGI(TAG, "buffer size %zu, alignment %zu", buffer_size, alignment);
+    TEST_ASSERT_EQUAL(ALIGN_UP_BY(100, alignment), buffer_size);
+
+    void *buffers[num_buffers];
+    for (size_t i = 0; i < num_buffers; i++) {
+        buffers[i] = esp_dma_buffer_pool_get(pool);
+        TEST_ASSERT_NOT_NULL(buffers[i]);
+        TEST_ASSERT(esp_dma_is_buffer_alignment_satisfied(buffers[i], buffer_size, pool_config.dma_mem_info));
+        memset(buffers[i], 0xA5, buffer_size);
+    }
+    // pool is exhausted
+    TEST_ASSERT_NULL(esp_dma_buffer_pool_get(pool));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_dma_del_buffer_pool(pool));
+    // a buffer which is not from the pool is refused
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_dma_buffer_pool_put(pool, (uint8_t *)buffers[0] + 1));
+
+    for (size_t i = 0; i < num_buffers; i++) {
+        TEST_ESP_OK(esp_dma_buffer_pool_put(pool, buffers[i]));
+    }
+    // the buffer given back last is taken first
+    TEST_ASSERT_EQUAL_PTR(buffers[num_buffers - 1], esp_dma_buffer_pool_get(pool));
+    TEST_ESP_OK(esp_dma_buffer_pool_put(pool, buffers[num_buffers - 1]));
+    TEST_ESP_OK(esp_dma_del_buffer_pool(pool));
+}
@@ -383,6 +383,22 @@ static void test_gdma_m2m_mode(bool trig_retention_backup)
 #endif // SOC_AXI_GDMA_SUPPORTED
 }
 
+#if SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION && CONFIG_GDMA_ENABLE_WEIGHTED_ARBITRATION
+TEST_CASE("GDMA channel weight", "[GDMA]")
+{
+    gdma_channel_handle_t tx_chan = NULL;
+    gdma_channel_alloc_config_t tx_chan_alloc_config = {
+        .direction = GDMA_CHANNEL_DIRECTION_TX,
+    };
+    TEST_ESP_OK(gdma_new_ahb_channel(&tx_chan_alloc_config, &tx_chan));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, gdma_set_weight(tx_chan, 0));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, gdma_set_weight(tx_chan, GDMA_LL_CHANNEL_MAX_WEIGHT + 1));
+    TEST_ESP_OK(gdma_set_weight(tx_chan, GDMA_LL_CHANNEL_MAX_WEIGHT));
+    TEST_ESP_OK(gdma_set_weight(tx_chan, 1));
+    TEST_ESP_OK(gdma_del_channel(tx_chan));
+}
+#endif
+
 TEST_CASE("GDMA M2M Mode", "[GDMA][M2M]")
 {
     test_gdma_m2m_mode(false);
@@ -482,6 +498,18 @@ static void test_gdma_m2m_unaligned_buffer_test(uint8_t *dst_data, uint8_t *src_
         TEST_ASSERT_EQUAL(i % 256, dst_data[i + offset_len]);
     }
 
+#if CONFIG_GDMA_ENABLE_CHANNEL_STATS
+    gdma_channel_stats_t stats = {};
+    TEST_ESP_OK(gdma_get_channel_stats(tx_chan, &stats, true));
+    TEST_ASSERT_EQUAL(1, stats.start_count);
+    TEST_ESP_OK(gdma_get_channel_stats(rx_chan, &stats, true));
+    TEST_ASSERT_EQUAL(1, stats.start_count);
+    TEST_ASSERT_EQUAL(1, stats.eof_count);
+    TEST_ASSERT_EQUAL(0, stats.descr_err_count);
+    TEST_ESP_OK(gdma_get_channel_stats(rx_chan, &stats, false));
+    TEST_ASSERT_EQUAL(0, stats.eof_count);
+#endif
+
     TEST_ESP_OK(gdma_del_link_list(tx_link_list));
     TEST_ESP_OK(gdma_del_link_list(rx_link_list));
     TEST_ESP_OK(gdma_del_channel(tx_chan));
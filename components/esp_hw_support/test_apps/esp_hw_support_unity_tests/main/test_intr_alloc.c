@@ -8,6 +8,8 @@
 */
 
 #include <stdio.h>
+#include <inttypes.h>
+#include <sys/param.h>
 #include "sdkconfig.h"
 #include "esp_types.h"
 #include "esp_rom_sys.h"
@@ -23,6 +25,23 @@
 #include "hal/spi_ll.h"
 #include "esp_private/periph_ctrl.h"
 #include "esp_private/gptimer.h"
+#include "esp_cpu.h"
+#if CONFIG_IDF_TARGET_ESP32
+#include "soc/dport_reg.h"
+#define TEST_FROM_CPU_INTR2_REG DPORT_CPU_INTR_FROM_CPU_2_REG
+#elif CONFIG_IDF_TARGET_ESP32S2
+#include "soc/system_reg.h"
+#define TEST_FROM_CPU_INTR2_REG DPORT_CPU_INTR_FROM_CPU_2_REG
+#elif CONFIG_IDF_TARGET_ESP32C2 || CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32S3
+#include "soc/system_reg.h"
+#define TEST_FROM_CPU_INTR2_REG SYSTEM_CPU_INTR_FROM_CPU_2_REG
+#elif CONFIG_IDF_TARGET_ESP32P4
+#include "soc/hp_system_reg.h"
+#define TEST_FROM_CPU_INTR2_REG HP_SYSTEM_CPU_INT_FROM_CPU_2_REG
+#else
+#include "soc/intpri_reg.h"
+#define TEST_FROM_CPU_INTR2_REG INTPRI_CPU_INTR_FROM_CPU_2_REG
+#endif
 
 static bool on_timer_alarm(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_ctx)
 {
@@ -479,3 +498,84 @@ TEST_CASE("Intr_alloc test, CPU-local int source", "[intr_alloc]")
 }
 
 #endif // #if __XTENSA__
+
+
+#define LATENCY_SAMPLES         1000
+#define LATENCY_BUCKETS         12
+#define LATENCY_BUCKET_CYCLES   32
+
+static volatile uint32_t s_trigger_cycles;
+static volatile uint32_t s_latency_cycles;
+
+static void IRAM_ATTR latency_isr(void *arg)
+{
+    s_latency_cycles = esp_cpu_get_cycle_count() - s_trigger_cycles;
+    WRITE_PERI_REG(TEST_FROM_CPU_INTR2_REG, 0);
+}
+
+TEST_CASE("Intr_alloc test, direct ints can't be shared and must be in IRAM", "[intr_alloc]")
+{
+    intr_handle_t handle;
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_intr_alloc(ETS_FROM_CPU_INTR2_SOURCE, ESP_INTR_FLAG_DIRECT,
+                                                     latency_isr, NULL, &handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_intr_alloc(ETS_FROM_CPU_INTR2_SOURCE,
+                                                     ESP_INTR_FLAG_DIRECT | ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_SHARED,
+                                                     latency_isr, NULL, &handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_intr_alloc(ETS_FROM_CPU_INTR2_SOURCE, ESP_INTR_FLAG_DIRECT | ESP_INTR_FLAG_IRAM,
+                                                     NULL, NULL, &handle));
+
+    TEST_ESP_OK(esp_intr_alloc(ETS_FROM_CPU_INTR2_SOURCE, ESP_INTR_FLAG_DIRECT | ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_INTRDISABLED,
+                               latency_isr, NULL, &handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_intr_set_in_iram(handle, false));
+
+    /* No other source can be given the line of a direct interrupt */
+    intr_handle_t shared_handle;
+    TEST_ESP_ERR(ESP_ERR_NOT_FOUND, esp_intr_alloc_bind(ETS_FROM_CPU_INTR3_SOURCE, ESP_INTR_FLAG_SHARED,
+                                                        latency_isr, NULL, handle, &shared_handle));
+    TEST_ESP_OK(esp_intr_alloc(ETS_FROM_CPU_INTR3_SOURCE, ESP_INTR_FLAG_SHARED | ESP_INTR_FLAG_INTRDISABLED,
+                               latency_isr, NULL, &shared_handle));
+    TEST_ASSERT_NOT_EQUAL(esp_intr_get_intno(handle), esp_intr_get_intno(shared_handle));
+    esp_intr_dump(NULL);
+
+    TEST_ESP_OK(esp_intr_free(shared_handle));
+    TEST_ESP_OK(esp_intr_free(handle));
+}
+
+static void measure_entry_latency(const char *name, int flags)
+{
+    intr_handle_t handle;
+    uint32_t histogram[LATENCY_BUCKETS] = {0};
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    uint64_t sum = 0;
+
+    TEST_ESP_OK(esp_intr_alloc(ETS_FROM_CPU_INTR2_SOURCE, flags, latency_isr, NULL, &handle));
+    for (int i = 0; i < LATENCY_SAMPLES; i++) {
+        s_latency_cycles = 0;
+        s_trigger_cycles = esp_cpu_get_cycle_count();
+        WRITE_PERI_REG(TEST_FROM_CPU_INTR2_REG, 1);
+        while (s_latency_cycles == 0) {
+        }
+        uint32_t latency = s_latency_cycles;
+        min = MIN(min, latency);
+        max = MAX(max, latency);
+        sum += latency;
+        histogram[MIN(latency / LATENCY_BUCKET_CYCLES, LATENCY_BUCKETS - 1)]++;
+    }
+    TEST_ESP_OK(esp_intr_free(handle));
+
+    printf("%s: min %"PRIu32", avg %"PRIu32", max %"PRIu32" cycles\n", name, min, (uint32_t)(sum / LATENCY_SAMPLES), max);
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        if (histogram[i]) {
+            printf("  %4d%s cycles: %"PRIu32"\n", i * LATENCY_BUCKET_CYCLES, i == LATENCY_BUCKETS - 1 ? "+" : " ", histogram[i]);
+        }
+    }
+}
+
+TEST_CASE("Intr_alloc test, interrupt entry latency", "[intr_alloc]")
+{
+    measure_entry_latency("shared", ESP_INTR_FLAG_SHARED | ESP_INTR_FLAG_IRAM);
+    measure_entry_latency("non-shared", ESP_INTR_FLAG_IRAM);
+    measure_entry_latency("direct", ESP_INTR_FLAG_DIRECT | ESP_INTR_FLAG_IRAM);
+}
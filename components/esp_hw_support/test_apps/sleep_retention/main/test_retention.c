@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -13,6 +13,11 @@
 #include "esp_private/sleep_retention.h"
 #include "esp_sleep.h"
 #include "esp_private/sleep_cpu.h"
+#include "soc/soc_caps.h"
+#if SOC_ETM_SUPPORT_SLEEP_RETENTION
+#include "esp_etm.h"
+#include "hal/etm_ll.h"
+#endif
 
 const char TAG[] = "retention";
 
@@ -35,3 +40,41 @@ TEST_CASE("retention: can go to retention", "[retention]")
 
     sleep_cpu_configure(false);
 }
+
+#if SOC_ETM_SUPPORT_SLEEP_RETENTION
+static int etm_enabled_channels(void)
+{
+    int num = 0;
+    for (int i = 0; i < SOC_ETM_CHANNELS_PER_GROUP; i++) {
+        num += etm_ll_is_channel_enabled(&SOC_ETM, i) ? 1 : 0;
+    }
+    return num;
+}
+
+TEST_CASE("retention: unchanged module is restored without backup", "[retention]")
+{
+    esp_etm_channel_config_t config = {
+        .flags.allow_pd = true,
+    };
+    esp_etm_channel_handle_t chan = NULL;
+    TEST_ESP_OK(esp_etm_new_channel(&config, &chan));
+    TEST_ESP_OK(esp_etm_channel_enable(chan));
+
+    TEST_ESP_OK(esp_sleep_enable_timer_wakeup(100 * 1000));
+    sleep_cpu_configure(true);
+    TEST_ASSERT_EQUAL_INT32(true, peripheral_domain_pd_allowed());
+
+    // the first sleep backs up the ETM registers, the second one skips their backup
+    for (int i = 0; i < 2; i++) {
+        TEST_ESP_OK(esp_light_sleep_start());
+        TEST_ASSERT_EQUAL(1, etm_enabled_channels());
+    }
+    // the change makes the ETM registers dirty, they are backed up again by the next sleep
+    TEST_ESP_OK(esp_etm_channel_disable(chan));
+    TEST_ESP_OK(esp_light_sleep_start());
+    TEST_ASSERT_EQUAL(0, etm_enabled_channels());
+
+    sleep_cpu_configure(false);
+    TEST_ESP_OK(esp_etm_del_channel(chan));
+}
+#endif
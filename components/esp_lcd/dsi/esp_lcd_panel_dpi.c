@@ -46,7 +46,12 @@ struct esp_lcd_dpi_panel_t {
     dw_gdma_channel_handle_t dma_chan;    // DMA channel
     dw_gdma_link_list_handle_t link_lists[DPI_PANEL_MAX_FB_NUM]; // DMA link list
     esp_async_fbcpy_handle_t fbcpy_handle; // Use DMA2D to do frame buffer copy
-    SemaphoreHandle_t draw_sem;            // A semaphore used to synchronize the draw operations when DMA2D is used
+    SemaphoreHandle_t draw_sem;            // A counting semaphore of the free slots in the draw queue when DMA2D is used
+    esp_async_fbcpy_trans_desc_t *draw_jobs; // Queue of the draw operations to be done by DMA2D
+    size_t draw_queue_depth;               // Number of draw operations that can be queued
+    size_t draw_job_head;                  // Index of the draw operation in progress
+    size_t num_draw_jobs;                  // Number of queued draw operations, including the one in progress
+    portMUX_TYPE spinlock;                 // Spinlock to protect the draw queue
     esp_pm_lock_handle_t pm_lock;          // Power management lock
     esp_lcd_dpi_panel_color_trans_done_cb_t on_color_trans_done; // Callback invoked when color data transfer has finished
     esp_lcd_dpi_panel_refresh_done_cb_t on_refresh_done; // Callback invoked when one refresh operation finished (kinda like a vsync end)
@@ -58,8 +63,23 @@ static bool async_fbcpy_done_cb(esp_async_fbcpy_handle_t mcp, esp_async_fbcpy_ev
 {
     bool need_yield = false;
     esp_lcd_dpi_panel_t *dpi_panel = (esp_lcd_dpi_panel_t *)cb_args;
+    esp_async_fbcpy_trans_desc_t *next_job = NULL;
 
-    // release the draw semaphore first
+    // remove the finished draw operation from the queue
+    portENTER_CRITICAL_ISR(&dpi_panel->spinlock);
+    dpi_panel->draw_job_head = (dpi_panel->draw_job_head + 1) % dpi_panel->draw_queue_depth;
+    dpi_panel->num_draw_jobs--;
+    if (dpi_panel->num_draw_jobs) {
+        next_job = &dpi_panel->draw_jobs[dpi_panel->draw_job_head];
+    }
+    portEXIT_CRITICAL_ISR(&dpi_panel->spinlock);
+
+    // start the next draw operation right away, without waiting for the task to submit it
+    if (next_job) {
+        esp_async_fbcpy(dpi_panel->fbcpy_handle, next_job, async_fbcpy_done_cb, dpi_panel);
+    }
+
+    // release the slot of the finished draw operation
     BaseType_t task_woken = pdFALSE;
     xSemaphoreGiveFromISR(dpi_panel->draw_sem, &task_woken);
     if (task_woken == pdTRUE) {
@@ -214,6 +234,7 @@ esp_err_t esp_lcd_new_panel_dpi(esp_lcd_dsi_bus_handle_t bus, const esp_lcd_dpi_
     dpi_panel->out_color_format = out_color_format;
     dpi_panel->bus = bus;
     dpi_panel->num_fbs = num_fbs;
+    dpi_panel->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
 
     // allocate frame buffer from PSRAM
     uint32_t cache_line_size = cache_hal_get_cache_line_size(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA);
@@ -243,9 +264,16 @@ esp_err_t esp_lcd_new_panel_dpi(esp_lcd_dsi_bus_handle_t bus, const esp_lcd_dpi_
         esp_async_fbcpy_config_t fbcpy_config = {};
         ESP_GOTO_ON_ERROR(esp_async_fbcpy_install(&fbcpy_config, &fbcpy_ctx), err, TAG, "install async memcpy 2d failed");
         dpi_panel->fbcpy_handle = fbcpy_ctx;
-        dpi_panel->draw_sem = xSemaphoreCreateBinaryWithCaps(DSI_MEM_ALLOC_CAPS);
+        size_t draw_queue_depth = panel_config->dma2d_queue_depth;
+        // if the user doesn't specify the queue depth, then fallback to one draw operation at a time
+        if (draw_queue_depth == 0) {
+            draw_queue_depth = 1;
+        }
+        dpi_panel->draw_jobs = heap_caps_calloc(draw_queue_depth, sizeof(esp_async_fbcpy_trans_desc_t), DSI_MEM_ALLOC_CAPS);
+        ESP_GOTO_ON_FALSE(dpi_panel->draw_jobs, ESP_ERR_NO_MEM, err, TAG, "no memory for draw queue");
+        dpi_panel->draw_queue_depth = draw_queue_depth;
+        dpi_panel->draw_sem = xSemaphoreCreateCountingWithCaps(draw_queue_depth, draw_queue_depth, DSI_MEM_ALLOC_CAPS);
         ESP_GOTO_ON_FALSE(dpi_panel->draw_sem, ESP_ERR_NO_MEM, err, TAG, "no memory for draw semaphore");
-        xSemaphoreGive(dpi_panel->draw_sem);
     }
 #endif // SOC_DMA2D_SUPPORTED
 
@@ -375,6 +403,9 @@ static esp_err_t dpi_panel_del(esp_lcd_panel_t *panel)
     if (dpi_panel->draw_sem) {
         vSemaphoreDeleteWithCaps(dpi_panel->draw_sem);
     }
+    if (dpi_panel->draw_jobs) {
+        free(dpi_panel->draw_jobs);
+    }
     if (dpi_panel->pm_lock) {
         esp_pm_lock_release(dpi_panel->pm_lock);
         esp_pm_lock_delete(dpi_panel->pm_lock);
@@ -526,7 +557,7 @@ static esp_err_t dpi_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int
         }
     } else { // copy by DMA2D
         ESP_LOGV(TAG, "copy draw buffer by DMA2D");
-        // ensure the previous draw operation is finished
+        // ensure there's a free slot in the draw queue
         ESP_RETURN_ON_FALSE(xSemaphoreTake(dpi_panel->draw_sem, 0) == pdTRUE, ESP_ERR_INVALID_STATE,
                             TAG, "previous draw operation is not finished");
 
@@ -535,7 +566,11 @@ static esp_err_t dpi_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int
         size_t color_data_size = (x_end - x_start) * (y_end - y_start) * bits_per_pixel / 8;
         esp_cache_msync(draw_buffer, color_data_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
 
-        esp_async_fbcpy_trans_desc_t fbcpy_trans_config = {
+        // the tail of the queue is not moved by the DMA2D interrupt, and the slot is only read after the draw operation is counted in the queue
+        portENTER_CRITICAL(&dpi_panel->spinlock);
+        size_t job_index = (dpi_panel->draw_job_head + dpi_panel->num_draw_jobs) % dpi_panel->draw_queue_depth;
+        portEXIT_CRITICAL(&dpi_panel->spinlock);
+        dpi_panel->draw_jobs[job_index] = (esp_async_fbcpy_trans_desc_t) {
             .src_buffer = draw_buffer,
             .dst_buffer = (void *)frame_buffer,
             .src_buffer_size_x = x_end - x_start,
@@ -552,7 +587,23 @@ static esp_err_t dpi_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int
                 .color_type_id = dpi_panel->in_color_format,
             }
         };
-        ESP_RETURN_ON_ERROR(esp_async_fbcpy(dpi_panel->fbcpy_handle, &fbcpy_trans_config, async_fbcpy_done_cb, dpi_panel), TAG, "async memcpy failed");
+        // if the DMA2D is idle, start the draw operation now, otherwise it will be started when the previous ones are done
+        portENTER_CRITICAL(&dpi_panel->spinlock);
+        bool start_now = (dpi_panel->num_draw_jobs == 0);
+        dpi_panel->num_draw_jobs++;
+        portEXIT_CRITICAL(&dpi_panel->spinlock);
+        if (start_now) {
+            esp_err_t ret = esp_async_fbcpy(dpi_panel->fbcpy_handle, &dpi_panel->draw_jobs[job_index], async_fbcpy_done_cb, dpi_panel);
+            if (ret != ESP_OK) {
+                // nothing else is in the queue, so just drop the draw operation
+                portENTER_CRITICAL(&dpi_panel->spinlock);
+                dpi_panel->num_draw_jobs--;
+                portEXIT_CRITICAL(&dpi_panel->spinlock);
+                xSemaphoreGive(dpi_panel->draw_sem);
+                ESP_LOGE(TAG, "async memcpy failed");
+                return ret;
+            }
+        }
     }
 
     return ESP_OK;
@@ -90,6 +90,10 @@ typedef struct {
                                                     which is the format that the panel can accept */
     uint8_t num_fbs;                           /*!< Number of screen-sized frame buffers that allocated by the driver
                                                     By default (set to either 0 or 1) only one frame buffer will be created */
+    uint8_t dma2d_queue_depth;                 /*!< Number of draw operations that can be queued to the DMA2D, only valid when `use_dma2d` is set.
+                                                    The queued draw operations are started one after another from the DMA2D interrupt,
+                                                    and `on_color_trans_done` is invoked for each of them, in the order they were queued.
+                                                    By default (set to either 0 or 1) the draw function fails if the previous copy is not finished */
     esp_lcd_video_timing_t video_timing;       /*!< Video timing */
     /// Extra configuration flags for MIPI DSI DPI panel
     struct extra_dpi_panel_flags {
@@ -581,6 +581,26 @@ static esp_err_t rgb_panel_init(esp_lcd_panel_t *panel)
     return ret;
 }
 
+// Write back the cache of a rectangle in the frame buffer, so that the DMA can see the new pixels.
+// A narrow rectangle is written back line by line, instead of writing back the whole lines it covers.
+static void lcd_rgb_panel_cache_sync_rect(esp_rgb_panel_t *rgb_panel, uint8_t *fb, int x_start, int y_start, int x_end, int y_end)
+{
+    size_t bytes_per_pixel = rgb_panel->fb_bits_per_pixel / 8;
+    size_t bytes_per_line = rgb_panel->timings.h_res * bytes_per_pixel;
+    size_t rect_bytes_per_line = (x_end - x_start) * bytes_per_pixel;
+    uint8_t *sync_ptr = fb + y_start * bytes_per_line;
+
+    if (rect_bytes_per_line * 2 > bytes_per_line) {
+        esp_cache_msync(sync_ptr, (y_end - y_start) * bytes_per_line, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+        return;
+    }
+    sync_ptr += x_start * bytes_per_pixel;
+    for (int y = y_start; y < y_end; y++) {
+        esp_cache_msync(sync_ptr, rect_bytes_per_line, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+        sync_ptr += bytes_per_line;
+    }
+}
+
 static esp_err_t rgb_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int y_start, int x_end, int y_end, const void *color_data)
 {
     esp_rgb_panel_t *rgb_panel = __containerof(panel, esp_rgb_panel_t, base);
@@ -644,7 +664,12 @@ static esp_err_t rgb_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int
         }
         // do memory sync only when the frame buffer is mounted to the DMA link list and behind the cache
         if (!rgb_panel->bb_size && rgb_panel->flags.fb_behind_cache) {
-            esp_cache_msync(flush_ptr, bytes_to_flush, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+            if (rgb_panel->rotate_mask == 0) {
+                // only the drawn rectangle is dirty in the cache
+                lcd_rgb_panel_cache_sync_rect(rgb_panel, fb, x_start, y_start, x_end, y_end);
+            } else {
+                esp_cache_msync(flush_ptr, bytes_to_flush, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+            }
         }
         // after the draw buffer finished copying, notify the user to recycle the draw buffer
         if (cb) {
@@ -657,9 +682,13 @@ static esp_err_t rgb_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int
         // when this function is called, the frame buffer already reflects the draw buffer changes
         // if the frame buffer is also mounted to the DMA, we need to do the sync between them
         if (!rgb_panel->bb_size && rgb_panel->flags.fb_behind_cache) {
-            uint8_t *cache_sync_start = rgb_panel->fbs[draw_buf_fb_index] + (y_start * h_res) * bytes_per_pixel;
-            size_t cache_sync_size = (y_end - y_start) * bytes_per_line;
-            esp_cache_msync(cache_sync_start, cache_sync_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+            if (rgb_panel->rotate_mask == 0) {
+                lcd_rgb_panel_cache_sync_rect(rgb_panel, rgb_panel->fbs[draw_buf_fb_index], x_start, y_start, x_end, y_end);
+            } else {
+                uint8_t *cache_sync_start = rgb_panel->fbs[draw_buf_fb_index] + (y_start * h_res) * bytes_per_pixel;
+                size_t cache_sync_size = (y_end - y_start) * bytes_per_line;
+                esp_cache_msync(cache_sync_start, cache_sync_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+            }
         }
         // after the draw buffer finished copying, notify the user to recycle the draw buffer
         if (cb) {
@@ -44,17 +44,48 @@ static inline void copy_pixel_24bpp(uint8_t *to, const uint8_t *from)
     *to++ = *from++;
 }
 
+#define RGB_PANEL_ROTATE_STRIP_LINES 32
+
+/* In the swapped cases, each source pixel goes to another line of the frame buffer.
+ * The source is walked by strips of RGB_PANEL_ROTATE_STRIP_LINES lines, writing the part of each frame buffer line
+ * covered by the strip at once, so that the cache lines being filled stay in the cache. */
+#define COPY_PIXEL_SWAP_XY_BLOCK(_bpp, _to_row, _to_col, _to_step)                                \
+    for (int strip_y = y_start; strip_y < y_end; strip_y += RGB_PANEL_ROTATE_STRIP_LINES)         \
+    {                                                                                             \
+        int strip_y_end = MIN(strip_y + RGB_PANEL_ROTATE_STRIP_LINES, y_end);                     \
+        for (int x = x_start; x < x_end; x++)                                                     \
+        {                                                                                         \
+            int y = strip_y;                                                                      \
+            uint8_t *dst = to + ((_to_row) * h_res + (_to_col)) * bytes_per_pixel;                \
+            const uint8_t *src = from + y * copy_bytes_per_line + x * bytes_per_pixel - offset;   \
+            for (; y < strip_y_end; y++)                                                          \
+            {                                                                                     \
+                copy_pixel_##_bpp##bpp(dst, src);                                                 \
+                dst += (_to_step) * bytes_per_pixel;                                              \
+                src += copy_bytes_per_line;                                                       \
+            }                                                                                     \
+        }                                                                                         \
+    }
+
 #define COPY_PIXEL_CODE_BLOCK(_bpp)                                                               \
     switch (rgb_panel->rotate_mask)                                                               \
     {                                                                                             \
     case 0:                                                                                       \
     {                                                                                             \
         uint8_t *to = fb + (y_start * h_res + x_start) * bytes_per_pixel;                         \
-        for (int y = y_start; y < y_end; y++)                                                     \
+        if (copy_bytes_per_line == bytes_per_line)                                                \
         {                                                                                         \
-            memcpy(to, from, copy_bytes_per_line);                                                \
-            to += bytes_per_line;                                                                 \
-            from += copy_bytes_per_line;                                                          \
+            /* full lines are contiguous in the frame buffer, copy them at once */                \
+            memcpy(to, from, (y_end - y_start) * bytes_per_line);                                 \
+        }                                                                                         \
+        else                                                                                      \
+        {                                                                                         \
+            for (int y = y_start; y < y_end; y++)                                                 \
+            {                                                                                     \
+                memcpy(to, from, copy_bytes_per_line);                                            \
+                to += bytes_per_line;                                                             \
+                from += copy_bytes_per_line;                                                      \
+            }                                                                                     \
         }                                                                                         \
         bytes_to_flush = (y_end - y_start) * bytes_per_line;                                      \
         flush_ptr = fb + y_start * bytes_per_line;                                                \
@@ -102,54 +133,22 @@ static inline void copy_pixel_24bpp(uint8_t *to, const uint8_t *from)
         flush_ptr = fb + (v_res - y_end) * bytes_per_line;                                        \
         break;                                                                                    \
     case ROTATE_MASK_SWAP_XY:                                                                     \
-        for (int y = y_start; y < y_end; y++)                                                     \
-        {                                                                                         \
-            for (int x = x_start; x < x_end; x++)                                                 \
-            {                                                                                     \
-                uint32_t j = y * copy_bytes_per_line + x * bytes_per_pixel - offset;              \
-                uint32_t i = (x * h_res + y) * bytes_per_pixel;                                   \
-                copy_pixel_##_bpp##bpp(to + i, from + j);                                         \
-            }                                                                                     \
-        }                                                                                         \
+        COPY_PIXEL_SWAP_XY_BLOCK(_bpp, x, y, 1)                                                   \
         bytes_to_flush = (x_end - x_start) * bytes_per_line;                                      \
         flush_ptr = fb + x_start * bytes_per_line;                                                \
         break;                                                                                    \
     case ROTATE_MASK_SWAP_XY | ROTATE_MASK_MIRROR_X:                                              \
-        for (int y = y_start; y < y_end; y++)                                                     \
-        {                                                                                         \
-            for (int x = x_start; x < x_end; x++)                                                 \
-            {                                                                                     \
-                uint32_t j = y * copy_bytes_per_line + x * bytes_per_pixel - offset;              \
-                uint32_t i = (x * h_res + h_res - 1 - y) * bytes_per_pixel;                       \
-                copy_pixel_##_bpp##bpp(to + i, from + j);                                         \
-            }                                                                                     \
-        }                                                                                         \
+        COPY_PIXEL_SWAP_XY_BLOCK(_bpp, x, h_res - 1 - y, -1)                                      \
         bytes_to_flush = (x_end - x_start) * bytes_per_line;                                      \
         flush_ptr = fb + x_start * bytes_per_line;                                                \
         break;                                                                                    \
     case ROTATE_MASK_SWAP_XY | ROTATE_MASK_MIRROR_Y:                                              \
-        for (int y = y_start; y < y_end; y++)                                                     \
-        {                                                                                         \
-            for (int x = x_start; x < x_end; x++)                                                 \
-            {                                                                                     \
-                uint32_t j = y * copy_bytes_per_line + x * bytes_per_pixel - offset;              \
-                uint32_t i = ((v_res - 1 - x) * h_res + y) * bytes_per_pixel;                     \
-                copy_pixel_##_bpp##bpp(to + i, from + j);                                         \
-            }                                                                                     \
-        }                                                                                         \
+        COPY_PIXEL_SWAP_XY_BLOCK(_bpp, v_res - 1 - x, y, 1)                                       \
         bytes_to_flush = (x_end - x_start) * bytes_per_line;                                      \
         flush_ptr = fb + (v_res - x_end) * bytes_per_line;                                        \
         break;                                                                                    \
     case ROTATE_MASK_SWAP_XY | ROTATE_MASK_MIRROR_X | ROTATE_MASK_MIRROR_Y:                       \
-        for (int y = y_start; y < y_end; y++)                                                     \
-        {                                                                                         \
-            for (int x = x_start; x < x_end; x++)                                                 \
-            {                                                                                     \
-                uint32_t j = y * copy_bytes_per_line + x * bytes_per_pixel - offset;              \
-                uint32_t i = ((v_res - 1 - x) * h_res + h_res - 1 - y) * bytes_per_pixel;         \
-                copy_pixel_##_bpp##bpp(to + i, from + j);                                         \
-            }                                                                                     \
-        }                                                                                         \
+        COPY_PIXEL_SWAP_XY_BLOCK(_bpp, v_res - 1 - x, h_res - 1 - y, -1)                          \
         bytes_to_flush = (x_end - x_start) * bytes_per_line;                                      \
         flush_ptr = fb + (v_res - x_end) * bytes_per_line;                                        \
         break;                                                                                    \
@@ -164,6 +164,108 @@ TEST_CASE("MIPI DSI draw bitmap (EK79007)", "[mipi_dsi]")
     test_bsp_disable_dsi_phy_power();
 }
 
+#define TEST_DRAW_QUEUE_DEPTH 4
+
+static bool test_color_trans_done_cb(esp_lcd_panel_handle_t panel, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
+{
+    uint32_t *trans_done_count = (uint32_t *)user_ctx;
+    (*trans_done_count)++;
+    return false;
+}
+
+TEST_CASE("MIPI DSI draw bitmap with DMA2D queue (EK79007)", "[mipi_dsi]")
+{
+    esp_lcd_dsi_bus_handle_t mipi_dsi_bus;
+    esp_lcd_panel_io_handle_t mipi_dbi_io;
+    esp_lcd_panel_handle_t mipi_dpi_panel;
+    uint8_t *imgs[TEST_DRAW_QUEUE_DEPTH];
+
+    test_bsp_enable_dsi_phy_power();
+
+    for (int i = 0; i < TEST_DRAW_QUEUE_DEPTH; i++) {
+        imgs[i] = malloc(TEST_IMG_SIZE);
+        TEST_ASSERT_NOT_NULL(imgs[i]);
+    }
+
+    esp_lcd_dsi_bus_config_t bus_config = {
+        .bus_id = 0,
+        .num_data_lanes = 2,
+        .phy_clk_src = MIPI_DSI_PHY_CLK_SRC_DEFAULT,
+        .lane_bit_rate_mbps = 1000, // 1000 Mbps
+    };
+    TEST_ESP_OK(esp_lcd_new_dsi_bus(&bus_config, &mipi_dsi_bus));
+
+    esp_lcd_dbi_io_config_t dbi_config = {
+        .virtual_channel = 0,
+        .lcd_cmd_bits = 8,
+        .lcd_param_bits = 8,
+    };
+    TEST_ESP_OK(esp_lcd_new_panel_io_dbi(mipi_dsi_bus, &dbi_config, &mipi_dbi_io));
+
+    esp_lcd_dpi_panel_config_t dpi_config = {
+        .dpi_clk_src = MIPI_DSI_DPI_CLK_SRC_DEFAULT,
+        .dpi_clock_freq_mhz = MIPI_DSI_DPI_CLK_MHZ,
+        .virtual_channel = 0,
+        .in_color_format = LCD_COLOR_FMT_RGB565,
+        .dma2d_queue_depth = TEST_DRAW_QUEUE_DEPTH,
+        .video_timing = {
+            .h_size = MIPI_DSI_LCD_H_RES,
+            .v_size = MIPI_DSI_LCD_V_RES,
+            .hsync_back_porch = MIPI_DSI_LCD_HBP,
+            .hsync_pulse_width = MIPI_DSI_LCD_HSYNC,
+            .hsync_front_porch = MIPI_DSI_LCD_HFP,
+            .vsync_back_porch = MIPI_DSI_LCD_VBP,
+            .vsync_pulse_width = MIPI_DSI_LCD_VSYNC,
+            .vsync_front_porch = MIPI_DSI_LCD_VFP,
+        },
+        .flags = {
+            .use_dma2d = true,
+        }
+    };
+    ek79007_vendor_config_t vendor_config = {
+        .mipi_config = {
+            .dsi_bus = mipi_dsi_bus,
+            .dpi_config = &dpi_config,
+        },
+    };
+    esp_lcd_panel_dev_config_t lcd_dev_config = {
+        .reset_gpio_num = -1,
+        .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
+        .bits_per_pixel = 16,
+        .vendor_config = &vendor_config,
+    };
+    TEST_ESP_OK(esp_lcd_new_panel_ek79007(mipi_dbi_io, &lcd_dev_config, &mipi_dpi_panel));
+
+    uint32_t trans_done_count = 0;
+    esp_lcd_dpi_panel_event_callbacks_t cbs = {
+        .on_color_trans_done = test_color_trans_done_cb,
+    };
+    TEST_ESP_OK(esp_lcd_dpi_panel_register_event_callbacks(mipi_dpi_panel, &cbs, &trans_done_count));
+    TEST_ESP_OK(esp_lcd_panel_reset(mipi_dpi_panel));
+    TEST_ESP_OK(esp_lcd_panel_init(mipi_dpi_panel));
+
+    for (int i = 0; i < 10; i++) {
+        // queue several tiles at once, they are copied one after another by the DMA2D
+        for (int j = 0; j < TEST_DRAW_QUEUE_DEPTH; j++) {
+            memset(imgs[j], rand() & 0xFF, TEST_IMG_SIZE);
+            int x_start = rand() % (MIPI_DSI_LCD_H_RES - 100);
+            int y_start = rand() % (MIPI_DSI_LCD_V_RES - 100);
+            TEST_ESP_OK(esp_lcd_panel_draw_bitmap(mipi_dpi_panel, x_start, y_start, x_start + 100, y_start + 100, imgs[j]));
+        }
+        vTaskDelay(pdMS_TO_TICKS(100));
+        TEST_ASSERT_EQUAL_UINT32((i + 1) * TEST_DRAW_QUEUE_DEPTH, trans_done_count);
+    }
+
+    TEST_ESP_OK(esp_lcd_panel_del(mipi_dpi_panel));
+    TEST_ESP_OK(esp_lcd_panel_io_del(mipi_dbi_io));
+    TEST_ESP_OK(esp_lcd_del_dsi_bus(mipi_dsi_bus));
+    for (int i = 0; i < TEST_DRAW_QUEUE_DEPTH; i++) {
+        free(imgs[i]);
+    }
+
+    test_bsp_disable_dsi_phy_power();
+}
+
 TEST_CASE("MIPI DSI with multiple frame buffers (EK79007)", "[mipi_dsi]")
 {
     esp_lcd_dsi_bus_handle_t mipi_dsi_bus;
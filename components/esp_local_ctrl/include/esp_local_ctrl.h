@@ -367,6 +367,28 @@ esp_err_t esp_local_ctrl_remove_property(const char *name);
  */
 const esp_local_ctrl_prop_t *esp_local_ctrl_get_property(const char *name);
 
+/**
+ * @brief   Notify that the value of a property has changed
+ *
+ * Clients can read only the properties which have changed since their
+ * previous read, instead of polling the values of all the properties.
+ * For this, every change is given a sequence number: properties changed
+ * by clients through `set_prop_values()` or added / moved by
+ * `esp_local_ctrl_add_property()` / `esp_local_ctrl_remove_property()`
+ * are tracked internally, while changes made by the application itself
+ * must be reported with this API.
+ *
+ * @note    This may be called from any task, but not from an ISR.
+ *
+ * @param[in] name    Name of the property which has changed
+ *
+ * @return
+ *  - ESP_OK                : Success
+ *  - ESP_ERR_INVALID_STATE : Service not running
+ *  - ESP_ERR_NOT_FOUND     : Property not found
+ */
+esp_err_t esp_local_ctrl_notify_property_changed(const char *name);
+
 /**
  * @brief   Register protocomm handler for a custom endpoint
  *
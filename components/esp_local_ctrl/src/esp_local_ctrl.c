@@ -9,6 +9,7 @@
 #include <inttypes.h>
 #include <esp_err.h>
 #include <esp_log.h>
+#include <freertos/FreeRTOS.h>
 
 #include <protocomm.h>
 #include <protocomm_security0.h>
@@ -28,12 +29,30 @@ struct inst_ctx {
     esp_local_ctrl_config_t config;
     esp_local_ctrl_prop_t **props;
     size_t props_count;
+    uint32_t *props_seq;    /* Sequence number of the last change of each property */
+    uint32_t seq;           /* Sequence number of the last change of any property */
+    portMUX_TYPE seq_lock;
 };
 
 struct inst_ctx *local_ctrl_inst_ctx;
 
 static const char *TAG = "esp_local_ctrl";
 
+/* Records a change of the properties from index `first` to `last` (inclusive)
+ * under a single new sequence number */
+static void esp_local_ctrl_mark_changed(uint32_t first, uint32_t last)
+{
+    portENTER_CRITICAL(&local_ctrl_inst_ctx->seq_lock);
+    /* 0 is reserved for clients which haven't read any property yet */
+    if (++local_ctrl_inst_ctx->seq == 0) {
+        local_ctrl_inst_ctx->seq = 1;
+    }
+    for (uint32_t i = first; i <= last; i++) {
+        local_ctrl_inst_ctx->props_seq[i] = local_ctrl_inst_ctx->seq;
+    }
+    portEXIT_CRITICAL(&local_ctrl_inst_ctx->seq_lock);
+}
+
 esp_err_t esp_local_ctrl_start(const esp_local_ctrl_config_t *config)
 {
     esp_err_t ret;
@@ -70,11 +89,16 @@ esp_err_t esp_local_ctrl_start(const esp_local_ctrl_config_t *config)
         return ESP_ERR_NO_MEM;
     }
     memcpy(&local_ctrl_inst_ctx->config, config, sizeof(local_ctrl_inst_ctx->config));
+    portMUX_INITIALIZE(&local_ctrl_inst_ctx->seq_lock);
 
     local_ctrl_inst_ctx->props = calloc(local_ctrl_inst_ctx->config.max_properties,
                                         sizeof(esp_local_ctrl_prop_t *));
-    if (!local_ctrl_inst_ctx->props) {
+    local_ctrl_inst_ctx->props_seq = calloc(local_ctrl_inst_ctx->config.max_properties,
+                                            sizeof(uint32_t));
+    if (!local_ctrl_inst_ctx->props || !local_ctrl_inst_ctx->props_seq) {
         ESP_LOGE(TAG, "Failed to allocate memory for properties");
+        free(local_ctrl_inst_ctx->props);
+        free(local_ctrl_inst_ctx->props_seq);
         free(local_ctrl_inst_ctx);
         local_ctrl_inst_ctx = NULL;
         return ESP_ERR_NO_MEM;
@@ -240,6 +264,7 @@ esp_err_t esp_local_ctrl_stop(void)
             free(local_ctrl_inst_ctx->props[i]);
         }
         free(local_ctrl_inst_ctx->props);
+        free(local_ctrl_inst_ctx->props_seq);
         free(local_ctrl_inst_ctx);
         local_ctrl_inst_ctx = NULL;
     }
@@ -301,6 +326,7 @@ esp_err_t esp_local_ctrl_add_property(const esp_local_ctrl_prop_t *prop)
     local_ctrl_inst_ctx->props[i]->ctx   = prop->ctx;
     local_ctrl_inst_ctx->props[i]->ctx_free_fn = prop->ctx_free_fn;
     local_ctrl_inst_ctx->props_count++;
+    esp_local_ctrl_mark_changed(i, i);
     return ESP_OK;
 }
 
@@ -331,6 +357,12 @@ esp_err_t esp_local_ctrl_remove_property(const char *name)
         local_ctrl_inst_ctx->props[i-1] = local_ctrl_inst_ctx->props[i];
     }
     local_ctrl_inst_ctx->props_count--;
+
+    /* The following properties have moved to new indices, so clients
+     * tracking changes by index need to read them again */
+    if ((size_t)(idx - 1) < local_ctrl_inst_ctx->props_count) {
+        esp_local_ctrl_mark_changed(idx - 1, local_ctrl_inst_ctx->props_count - 1);
+    }
     return ESP_OK;
 }
 
@@ -437,11 +469,62 @@ esp_err_t esp_local_ctrl_set_prop_values(size_t total_indices, uint32_t *indices
 
     esp_local_ctrl_handlers_t *h = &local_ctrl_inst_ctx->config.handlers;
     esp_err_t ret = h->set_prop_values(total_indices, props, values, h->usr_ctx);
+    if (ret == ESP_OK) {
+        for (size_t i = 0; i < total_indices; i++) {
+            esp_local_ctrl_mark_changed(indices[i], indices[i]);
+        }
+    }
 
     free(props);
     return ret;
 }
 
+esp_err_t esp_local_ctrl_notify_property_changed(const char *name)
+{
+    if (!local_ctrl_inst_ctx) {
+        ESP_LOGE(TAG, "Service not running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    int idx = esp_local_ctrl_get_property_index(name);
+    if (idx < 0) {
+        ESP_LOGE(TAG, "Property %s not found", name ? name : "(null)");
+        return ESP_ERR_NOT_FOUND;
+    }
+    esp_local_ctrl_mark_changed(idx, idx);
+    return ESP_OK;
+}
+
+esp_err_t esp_local_ctrl_get_changed_props(uint32_t since, uint32_t *seq,
+                                           uint32_t *indices, size_t *count)
+{
+    if (!local_ctrl_inst_ctx) {
+        ESP_LOGE(TAG, "Service not running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!seq || !indices || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t changed = 0;
+    portENTER_CRITICAL(&local_ctrl_inst_ctx->seq_lock);
+    /* A sequence number ahead of the current one comes from a client of a
+     * previous instance of the service, which then needs all the properties */
+    if ((int32_t)(since - local_ctrl_inst_ctx->seq) > 0) {
+        since = 0;
+    }
+    for (uint32_t i = 0; i < local_ctrl_inst_ctx->props_count && changed < *count; i++) {
+        /* The difference handles the wrap around of the sequence numbers */
+        if (since == 0 || (int32_t)(local_ctrl_inst_ctx->props_seq[i] - since) > 0) {
+            indices[changed++] = i;
+        }
+    }
+    *seq = local_ctrl_inst_ctx->seq;
+    portEXIT_CRITICAL(&local_ctrl_inst_ctx->seq_lock);
+
+    *count = changed;
+    return ESP_OK;
+}
+
 esp_err_t esp_local_ctrl_set_handler(const char *ep_name,
                                      protocomm_req_handler_t handler,
                                      void *priv_data)
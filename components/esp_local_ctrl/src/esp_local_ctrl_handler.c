@@ -1,13 +1,15 @@
 /*
- * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 #include <esp_err.h>
 #include <esp_log.h>
+#include <protocomm_pb_arena.h>
 
 #include "esp_compiler.h"
 #include "esp_local_ctrl.h"
@@ -38,6 +40,9 @@ static esp_err_t cmd_get_prop_vals_handler(LocalCtrlMessage *req,
 static esp_err_t cmd_set_prop_vals_handler(LocalCtrlMessage *req,
                                            LocalCtrlMessage *resp, void **ctx);
 
+static esp_err_t cmd_get_changed_prop_vals_handler(LocalCtrlMessage *req,
+                                                   LocalCtrlMessage *resp, void **ctx);
+
 static esp_local_ctrl_cmd_t cmd_table[] = {
     {
         .cmd_num = LOCAL_CTRL_MSG_TYPE__TypeCmdGetPropertyCount,
@@ -50,6 +55,10 @@ static esp_local_ctrl_cmd_t cmd_table[] = {
     {
         .cmd_num = LOCAL_CTRL_MSG_TYPE__TypeCmdSetPropertyValues,
         .command_handler = cmd_set_prop_vals_handler
+    },
+    {
+        .cmd_num = LOCAL_CTRL_MSG_TYPE__TypeCmdGetChangedPropertyValues,
+        .command_handler = cmd_get_changed_prop_vals_handler
     }
 };
 
@@ -89,59 +98,134 @@ static esp_err_t cmd_get_prop_count_handler(LocalCtrlMessage *req,
 
 typedef void (*prop_val_free_fn_t)(void *val);
 
+/* Fills the pre-allocated `props` array with the descriptions and values of
+ * the properties at the given indices. The free functions of the values are
+ * stored in `free_fns`, for releasing them once the response is packed */
+static Status get_prop_infos(size_t count, uint32_t *indices, PropertyInfo **props,
+                             size_t *n_props, prop_val_free_fn_t *free_fns)
+{
+    esp_local_ctrl_prop_val_t *vals = calloc(count, sizeof(esp_local_ctrl_prop_val_t));
+    esp_local_ctrl_prop_t *descs = calloc(count, sizeof(esp_local_ctrl_prop_t));
+    if (!vals || !descs) {
+        ESP_LOGE(TAG, "Failed to allocate memory for getting values");
+        free(vals);
+        free(descs);
+        return STATUS__InternalError;
+    }
+
+    esp_err_t ret = esp_local_ctrl_get_prop_values(count, indices, descs, vals);
+    Status status = err_to_status(ret);
+    if (ret == ESP_OK) {
+        *n_props = 0;
+        for (size_t i = 0; i < count; i++) {
+            ESP_COMPILER_DIAGNOSTIC_PUSH_IGNORE("-Wanalyzer-malloc-leak") // False-positive detection. TODO GCC-366
+            props[i] = malloc(sizeof(PropertyInfo));
+            if (!props[i]) {
+                status = STATUS__InternalError;
+                break;
+            }
+            ESP_COMPILER_DIAGNOSTIC_POP("-Wanalyzer-malloc-leak")
+            (*n_props)++;
+            property_info__init(props[i]);
+            props[i]->name  = descs[i].name;
+            props[i]->type  = descs[i].type;
+            props[i]->flags = descs[i].flags;
+            props[i]->value.data = vals[i].data;
+            props[i]->value.len  = vals[i].size;
+            free_fns[i] = vals[i].free_fn;
+        }
+    }
+    free(vals);
+    free(descs);
+    return status;
+}
+
+static void free_prop_infos(PropertyInfo **props, size_t n_props, prop_val_free_fn_t *free_fns)
+{
+    for (size_t i = 0; i < n_props; i++) {
+        if (free_fns && free_fns[i]) {
+            free_fns[i](props[i]->value.data);
+        }
+        free(props[i]);
+    }
+    free(free_fns);
+    free(props);
+}
+
 static esp_err_t cmd_get_prop_vals_handler(LocalCtrlMessage *req,
                                            LocalCtrlMessage *resp, void **ctx)
 {
     SAFE_ALLOCATION(RespGetPropertyValues, resp_payload);
     resp_get_property_values__init(resp_payload);
 
-    esp_local_ctrl_prop_val_t *vals = calloc(req->cmd_get_prop_vals->n_indices,
-                                             sizeof(esp_local_ctrl_prop_val_t));
-    esp_local_ctrl_prop_t *descs = calloc(req->cmd_get_prop_vals->n_indices,
-                                          sizeof(esp_local_ctrl_prop_t));
     prop_val_free_fn_t *free_fns = calloc(req->cmd_get_prop_vals->n_indices,
                                           sizeof(prop_val_free_fn_t));
     resp_payload->props = calloc(req->cmd_get_prop_vals->n_indices,
                                  sizeof(PropertyInfo *));
-    if (!vals || !descs || !free_fns || !resp_payload->props) {
+    if (!free_fns || !resp_payload->props) {
         ESP_LOGE(TAG, "Failed to allocate memory for getting values");
-        free(vals);
-        free(descs);
         free(free_fns);
         free(resp_payload->props);
         free(resp_payload);
         return ESP_ERR_NO_MEM;
     }
 
-    esp_err_t ret = esp_local_ctrl_get_prop_values(req->cmd_get_prop_vals->n_indices,
-                                                   req->cmd_get_prop_vals->indices,
-                                                   descs, vals);
-    resp_payload->status = err_to_status(ret);
-    if (ret == ESP_OK) {
-        resp_payload->n_props = 0;
-        for (size_t i = 0; i < req->cmd_get_prop_vals->n_indices; i++) {
-            ESP_COMPILER_DIAGNOSTIC_PUSH_IGNORE("-Wanalyzer-malloc-leak") // False-positive detection. TODO GCC-366
-            resp_payload->props[i] = malloc(sizeof(PropertyInfo));
-            if (!resp_payload->props[i]) {
-                resp_payload->status = STATUS__InternalError;
-                break;
-            }
-            ESP_COMPILER_DIAGNOSTIC_POP("-Wanalyzer-malloc-leak")
-            resp_payload->n_props++;
-            property_info__init(resp_payload->props[i]);
-            resp_payload->props[i]->name  = descs[i].name;
-            resp_payload->props[i]->type  = descs[i].type;
-            resp_payload->props[i]->flags = descs[i].flags;
-            resp_payload->props[i]->value.data = vals[i].data;
-            resp_payload->props[i]->value.len  = vals[i].size;
-            free_fns[i] = vals[i].free_fn;
-        }
-    }
+    resp_payload->status = get_prop_infos(req->cmd_get_prop_vals->n_indices,
+                                          req->cmd_get_prop_vals->indices,
+                                          resp_payload->props, &resp_payload->n_props,
+                                          free_fns);
     resp->payload_case = LOCAL_CTRL_MESSAGE__PAYLOAD_RESP_GET_PROP_VALS;
     resp->resp_get_prop_vals = resp_payload;
     (*ctx) = (void *)free_fns;
-    free(vals);
-    free(descs);
+
+    /* Unless it's a fatal error, always return ESP_OK, otherwise
+     * the underlying connection will be closed by protocomm */
+    return ESP_OK;
+}
+
+static esp_err_t cmd_get_changed_prop_vals_handler(LocalCtrlMessage *req,
+                                                   LocalCtrlMessage *resp, void **ctx)
+{
+    SAFE_ALLOCATION(RespGetChangedPropertyValues, resp_payload);
+    resp_get_changed_property_values__init(resp_payload);
+    resp->payload_case = LOCAL_CTRL_MESSAGE__PAYLOAD_RESP_GET_CHANGED_PROP_VALS;
+    resp->resp_get_changed_prop_vals = resp_payload;
+
+    size_t prop_count = 0;
+    esp_err_t ret = esp_local_ctrl_get_prop_count(&prop_count);
+    if (ret != ESP_OK || prop_count == 0) {
+        resp_payload->status = err_to_status(ret);
+        resp_payload->seq = req->cmd_get_changed_prop_vals->since;
+        return ESP_OK;
+    }
+
+    prop_val_free_fn_t *free_fns = calloc(prop_count, sizeof(prop_val_free_fn_t));
+    resp_payload->indices = calloc(prop_count, sizeof(uint32_t));
+    resp_payload->props = calloc(prop_count, sizeof(PropertyInfo *));
+    if (!free_fns || !resp_payload->indices || !resp_payload->props) {
+        ESP_LOGE(TAG, "Failed to allocate memory for getting changed values");
+        free(free_fns);
+        free(resp_payload->indices);
+        free(resp_payload->props);
+        free(resp_payload);
+        resp->resp_get_changed_prop_vals = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    (*ctx) = (void *)free_fns;
+
+    size_t changed_count = prop_count;
+    ret = esp_local_ctrl_get_changed_props(req->cmd_get_changed_prop_vals->since,
+                                           &resp_payload->seq, resp_payload->indices,
+                                           &changed_count);
+    resp_payload->status = err_to_status(ret);
+    if (ret == ESP_OK && changed_count) {
+        resp_payload->n_indices = changed_count;
+        resp_payload->status = get_prop_infos(changed_count, resp_payload->indices,
+                                              resp_payload->props, &resp_payload->n_props,
+                                              free_fns);
+    }
+    ESP_LOGD(TAG, "%d properties changed since %" PRIu32, changed_count,
+             req->cmd_get_changed_prop_vals->since);
 
     /* Unless it's a fatal error, always return ESP_OK, otherwise
      * the underlying connection will be closed by protocomm */
@@ -206,19 +290,23 @@ static void esp_local_ctrl_command_cleanup(LocalCtrlMessage *resp, void **ctx)
             break;
         case LOCAL_CTRL_MSG_TYPE__TypeRespGetPropertyValues: {
                 if (resp->resp_get_prop_vals) {
-                    prop_val_free_fn_t *free_fns = (prop_val_free_fn_t *)(*ctx);
-                    for (size_t i = 0; i < resp->resp_get_prop_vals->n_props; i++) {
-                        if (free_fns && free_fns[i]) {
-                            free_fns[i](resp->resp_get_prop_vals->props[i]->value.data);
-                        }
-                        free(resp->resp_get_prop_vals->props[i]);
-                    }
-                    free(free_fns);
-                    free(resp->resp_get_prop_vals->props);
+                    free_prop_infos(resp->resp_get_prop_vals->props,
+                                    resp->resp_get_prop_vals->n_props,
+                                    (prop_val_free_fn_t *)(*ctx));
                     free(resp->resp_get_prop_vals);
                 }
             }
             break;
+        case LOCAL_CTRL_MSG_TYPE__TypeRespGetChangedPropertyValues: {
+                if (resp->resp_get_changed_prop_vals) {
+                    free_prop_infos(resp->resp_get_changed_prop_vals->props,
+                                    resp->resp_get_changed_prop_vals->n_props,
+                                    (prop_val_free_fn_t *)(*ctx));
+                    free(resp->resp_get_changed_prop_vals->indices);
+                    free(resp->resp_get_changed_prop_vals);
+                }
+            }
+            break;
         case LOCAL_CTRL_MSG_TYPE__TypeRespSetPropertyValues:
             free(resp->resp_set_prop_vals);
             break;
@@ -251,9 +339,12 @@ esp_err_t esp_local_ctrl_data_handler(uint32_t session_id, const uint8_t *inbuf,
                                       uint8_t **outbuf, ssize_t *outlen, void *priv_data)
 {
     void *temp_ctx = NULL;
-    LocalCtrlMessage *req = local_ctrl_message__unpack(NULL, inlen, inbuf);
+    protocomm_pb_arena_t *arena = protocomm_pb_arena_create(inlen);
+    ProtobufCAllocator *allocator = protocomm_pb_arena_get_allocator(arena);
+    LocalCtrlMessage *req = local_ctrl_message__unpack(allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack payload data");
+        protocomm_pb_arena_delete(arena);
         return ESP_ERR_INVALID_ARG;
     }
 
@@ -265,11 +356,13 @@ esp_err_t esp_local_ctrl_data_handler(uint32_t session_id, const uint8_t *inbuf,
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "command dispatcher failed");
         esp_local_ctrl_command_cleanup(&resp, &temp_ctx);
-        local_ctrl_message__free_unpacked(req, NULL);
+        local_ctrl_message__free_unpacked(req, allocator);
+        protocomm_pb_arena_delete(arena);
         return ESP_FAIL;
     }
 
-    local_ctrl_message__free_unpacked(req, NULL);
+    local_ctrl_message__free_unpacked(req, allocator);
+    protocomm_pb_arena_delete(arena);
 
     *outlen = local_ctrl_message__get_packed_size(&resp);
     if (*outlen <= 0) {
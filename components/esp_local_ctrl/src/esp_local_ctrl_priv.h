@@ -70,7 +70,8 @@ struct esp_local_ctrl_transport {
  * depending upon the request type:
  * - `esp_local_ctrl_get_prop_count()`
  * - `esp_local_ctrl_get_prop_values()`
- * -` esp_local_ctrl_set_prop_values()`
+ * - `esp_local_ctrl_set_prop_values()`
+ * - `esp_local_ctrl_get_changed_props()`
  * The output of the above functions are used to form the response messages
  * corresponding to request types. The formed response messages are packed and
  * sent back via the protocomm channel.
@@ -148,6 +149,24 @@ esp_err_t esp_local_ctrl_get_prop_values(size_t total_indices, uint32_t *indices
 esp_err_t esp_local_ctrl_set_prop_values(size_t total_indices, uint32_t *indices,
                                          const esp_local_ctrl_prop_val_t *values);
 
+/**
+ * @brief   Get the indices of the properties changed after a given sequence number
+ *
+ * @param[in]     since     Sequence number returned by the previous call made for
+ *                          the client, or 0 for getting all the properties
+ * @param[out]    seq       Sequence number of the last change, to be passed as
+ *                          `since` by the next call
+ * @param[out]    indices   A pre-allocated array for the indices of the changed properties
+ * @param[in,out] count     Size of the `indices` array as input, number of changed
+ *                          properties as output
+ *
+ * @return
+ *  - ESP_OK      : Success
+ *  - ESP_FAIL    : Failure
+ */
+esp_err_t esp_local_ctrl_get_changed_props(uint32_t since, uint32_t *seq,
+                                           uint32_t *indices, size_t *count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,299 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/lock.h>
+#include <sys/param.h>
+#include "esp_metrics.h"
+#include "esp_heap_caps.h"
+
+#define BINARY_VERSION  1
+
+/* Protects the registry. The newlib locks are no-ops before the scheduler is started,
+ * when the metrics defined with the ESP_METRICS_*_DEFINE macros are registered. */
+static _lock_t s_lock;
+static esp_metrics_metric_t *s_metrics;
+
+#if CONFIG_ESP_METRICS_SYSTEM
+static int64_t heap_free_bytes(void)
+{
+    return heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+}
+
+static int64_t heap_min_free_bytes(void)
+{
+    return heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+}
+
+ESP_METRICS_GAUGE_FN_DEFINE(s_heap_free, "heap_free_bytes", "Free size of the default heap", heap_free_bytes);
+ESP_METRICS_GAUGE_FN_DEFINE(s_heap_min_free, "heap_min_free_bytes", "Minimum free size of the default heap since boot",
+                            heap_min_free_bytes);
+#endif // CONFIG_ESP_METRICS_SYSTEM
+
+esp_err_t esp_metrics_register(esp_metrics_metric_t *metric)
+{
+    if (metric == NULL || metric->name == NULL || metric->type < ESP_METRICS_TYPE_COUNTER ||
+            metric->type > ESP_METRICS_TYPE_HISTOGRAM) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_OK;
+    esp_metrics_metric_t **tail;
+    _lock_acquire(&s_lock);
+    /* appended, so that the metrics are exported in the order of registration */
+    for (tail = &s_metrics; *tail != NULL; tail = &(*tail)->next) {
+        if (*tail == metric || strcmp((*tail)->name, metric->name) == 0) {
+            err = ESP_ERR_INVALID_STATE;
+            break;
+        }
+    }
+    if (err == ESP_OK) {
+        metric->next = NULL;
+        *tail = metric;
+    }
+    _lock_release(&s_lock);
+    return err;
+}
+
+esp_err_t esp_metrics_unregister(esp_metrics_metric_t *metric)
+{
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    _lock_acquire(&s_lock);
+    for (esp_metrics_metric_t **m = &s_metrics; *m != NULL; m = &(*m)->next) {
+        if (*m == metric) {
+            *m = metric->next;
+            metric->next = NULL;
+            err = ESP_OK;
+            break;
+        }
+    }
+    _lock_release(&s_lock);
+    return err;
+}
+
+esp_metrics_metric_t *esp_metrics_find(const char *name)
+{
+    esp_metrics_metric_t *m;
+    _lock_acquire(&s_lock);
+    for (m = s_metrics; m != NULL && strcmp(m->name, name) != 0; m = m->next) {
+    }
+    _lock_release(&s_lock);
+    return m;
+}
+
+/* Reads a slot which may be updated by the other core at the same time */
+static uint64_t slot_read(const esp_metrics_slot_t *slot)
+{
+    uint32_t seq;
+    uint64_t value;
+    do {
+        seq = slot->seq;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        value = slot->value;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || seq != slot->seq);
+    return value;
+}
+
+static uint64_t slots_sum(const esp_metrics_slot_t *slots)
+{
+    uint64_t sum = 0;
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        sum += slot_read(&slots[i]);
+    }
+    return sum;
+}
+
+uint64_t esp_metrics_counter_get(const esp_metrics_counter_t *counter)
+{
+    return slots_sum(counter->slots);
+}
+
+int64_t esp_metrics_gauge_get(const esp_metrics_gauge_t *gauge)
+{
+    return gauge->read ? gauge->read() : gauge->value;
+}
+
+static uint64_t histogram_bucket(const esp_metrics_histogram_t *histogram, uint32_t bucket)
+{
+    uint64_t count = 0;
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        count += histogram->buckets[i * (histogram->bound_count + 1) + bucket];
+    }
+    return count;
+}
+
+uint64_t esp_metrics_histogram_get(const esp_metrics_histogram_t *histogram, uint64_t *counts, uint64_t *out_sum)
+{
+    uint64_t total = 0;
+    for (uint32_t b = 0; b <= histogram->bound_count; b++) {
+        uint64_t count = histogram_bucket(histogram, b);
+        if (counts) {
+            counts[b] = count;
+        }
+        total += count;
+    }
+    if (out_sum) {
+        *out_sum = slots_sum(histogram->sums);
+    }
+    return total;
+}
+
+static esp_err_t write_fmt(esp_metrics_write_cb_t write, void *arg, const char *fmt, ...)
+{
+    char buf[64];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    return write(buf, MIN((size_t)len, sizeof(buf) - 1), arg);
+}
+
+static esp_err_t write_str(esp_metrics_write_cb_t write, void *arg, const char *str)
+{
+    return write(str, strlen(str), arg);
+}
+
+#define WRITE(expr) do { esp_err_t err_ = (expr); if (err_ != ESP_OK) { return err_; } } while (0)
+
+static const char *const s_type_names[] = {
+    [ESP_METRICS_TYPE_COUNTER] = "counter",
+    [ESP_METRICS_TYPE_GAUGE] = "gauge",
+    [ESP_METRICS_TYPE_HISTOGRAM] = "histogram",
+};
+
+static esp_err_t export_prometheus(const esp_metrics_metric_t *m, esp_metrics_write_cb_t write, void *arg)
+{
+    if (m->help) {
+        WRITE(write_str(write, arg, "# HELP "));
+        WRITE(write_str(write, arg, m->name));
+        WRITE(write_str(write, arg, " "));
+        WRITE(write_str(write, arg, m->help));
+        WRITE(write_str(write, arg, "\n"));
+    }
+    WRITE(write_str(write, arg, "# TYPE "));
+    WRITE(write_str(write, arg, m->name));
+    WRITE(write_fmt(write, arg, " %s\n", s_type_names[m->type]));
+
+    switch (m->type) {
+    case ESP_METRICS_TYPE_COUNTER:
+        WRITE(write_str(write, arg, m->name));
+        WRITE(write_fmt(write, arg, " %" PRIu64 "\n", esp_metrics_counter_get((const esp_metrics_counter_t *)m)));
+        break;
+    case ESP_METRICS_TYPE_GAUGE:
+        WRITE(write_str(write, arg, m->name));
+        WRITE(write_fmt(write, arg, " %" PRId64 "\n", esp_metrics_gauge_get((const esp_metrics_gauge_t *)m)));
+        break;
+    case ESP_METRICS_TYPE_HISTOGRAM: {
+        const esp_metrics_histogram_t *h = (const esp_metrics_histogram_t *)m;
+        uint64_t cumulative = 0;
+        for (uint32_t b = 0; b <= h->bound_count; b++) {
+            cumulative += histogram_bucket(h, b);
+            WRITE(write_str(write, arg, m->name));
+            if (b < h->bound_count) {
+                WRITE(write_fmt(write, arg, "_bucket{le=\"%" PRIu32 "\"} %" PRIu64 "\n", h->bounds[b], cumulative));
+            } else {
+                WRITE(write_fmt(write, arg, "_bucket{le=\"+Inf\"} %" PRIu64 "\n", cumulative));
+            }
+        }
+        WRITE(write_str(write, arg, m->name));
+        WRITE(write_fmt(write, arg, "_sum %" PRIu64 "\n", slots_sum(h->sums)));
+        WRITE(write_str(write, arg, m->name));
+        WRITE(write_fmt(write, arg, "_count %" PRIu64 "\n", cumulative));
+        break;
+    }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t export_binary(const esp_metrics_metric_t *m, esp_metrics_write_cb_t write, void *arg)
+{
+    size_t name_len = MIN(strlen(m->name), UINT8_MAX);
+    uint8_t head[2] = { m->type, name_len };
+    WRITE(write(head, sizeof(head), arg));
+    WRITE(write(m->name, name_len, arg));
+
+    /* the targets are little-endian, as the format */
+    switch (m->type) {
+    case ESP_METRICS_TYPE_COUNTER: {
+        uint64_t value = esp_metrics_counter_get((const esp_metrics_counter_t *)m);
+        WRITE(write(&value, sizeof(value), arg));
+        break;
+    }
+    case ESP_METRICS_TYPE_GAUGE: {
+        int64_t value = esp_metrics_gauge_get((const esp_metrics_gauge_t *)m);
+        WRITE(write(&value, sizeof(value), arg));
+        break;
+    }
+    case ESP_METRICS_TYPE_HISTOGRAM: {
+        const esp_metrics_histogram_t *h = (const esp_metrics_histogram_t *)m;
+        WRITE(write(&h->bound_count, sizeof(h->bound_count), arg));
+        WRITE(write(h->bounds, h->bound_count * sizeof(uint32_t), arg));
+        for (uint32_t b = 0; b <= h->bound_count; b++) {
+            uint64_t count = histogram_bucket(h, b);
+            WRITE(write(&count, sizeof(count), arg));
+        }
+        uint64_t sum = slots_sum(h->sums);
+        WRITE(write(&sum, sizeof(sum), arg));
+        break;
+    }
+    }
+    return ESP_OK;
+}
+
+/* The lock is held while the metrics are exported, so that they can not be unregistered meanwhile */
+static esp_err_t export_all(const char *prefix, esp_err_t (*export)(const esp_metrics_metric_t *, esp_metrics_write_cb_t, void *),
+                            esp_metrics_write_cb_t write, void *arg)
+{
+    esp_err_t err = ESP_OK;
+    size_t prefix_len = prefix ? strlen(prefix) : 0;
+    _lock_acquire(&s_lock);
+    for (const esp_metrics_metric_t *m = s_metrics; m != NULL && err == ESP_OK; m = m->next) {
+        if (strncmp(m->name, prefix ? prefix : "", prefix_len) == 0) {
+            err = export(m, write, arg);
+        }
+    }
+    _lock_release(&s_lock);
+    return err;
+}
+
+esp_err_t esp_metrics_export_prometheus(esp_metrics_write_cb_t write, void *arg)
+{
+    if (write == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return export_all(NULL, export_prometheus, write, arg);
+}
+
+esp_err_t esp_metrics_export_binary(esp_metrics_write_cb_t write, void *arg)
+{
+    if (write == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint8_t header[8] = { 'E', 'M', 'E', 'T', BINARY_VERSION };
+    WRITE(write(header, sizeof(header), arg));
+    WRITE(export_all(NULL, export_binary, write, arg));
+    const uint8_t end = 0;
+    return write(&end, sizeof(end), arg);
+}
+
+static esp_err_t write_stdout(const void *data, size_t len, void *arg)
+{
+    return fwrite(data, 1, len, stdout) == len ? ESP_OK : ESP_FAIL;
+}
+
+int esp_metrics_console_cmd(int argc, char **argv)
+{
+    if (argc > 2) {
+        printf("Usage: %s [prefix]\n", argv[0]);
+        return 1;
+    }
+    esp_err_t err = export_all(argc == 2 ? argv[1] : NULL, export_prometheus, write_stdout, NULL);
+    fflush(stdout);
+    return err == ESP_OK ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#!/usr/bin/env python
+#
+# esp_metrics_decode is a tool used to print a snapshot written by esp_metrics_export_binary()
+# in the Prometheus text exposition format, or as JSON
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+# Snapshot layout, all fields little-endian, see esp_metrics_export_binary() in esp_metrics.h:
+#
+#   header   magic "EMET", version, 3 reserved bytes
+#   metrics  type, name length, name, value depending on the type
+#   end      a 0 byte in place of the type
+import argparse
+import json
+import struct
+import sys
+from typing import Any
+from typing import BinaryIO
+from typing import Dict
+from typing import List
+
+MAGIC = b'EMET'
+VERSION = 1
+
+TYPE_COUNTER = 1
+TYPE_GAUGE = 2
+TYPE_HISTOGRAM = 3
+
+TYPE_NAMES = {TYPE_COUNTER: 'counter', TYPE_GAUGE: 'gauge', TYPE_HISTOGRAM: 'histogram'}
+
+
+class DecodeError(RuntimeError):
+    pass
+
+
+class Reader:
+    def __init__(self, data: bytes) -> None:
+        self.data = data
+        self.pos = 0
+
+    def unpack(self, fmt: str) -> Any:
+        size = struct.calcsize(fmt)
+        if self.pos + size > len(self.data):
+            raise DecodeError('snapshot is truncated at offset {}'.format(self.pos))
+        values = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += size
+        return values if len(values) > 1 else values[0]
+
+    def array(self, item_fmt: str, count: int) -> List[int]:
+        return [self.unpack('<' + item_fmt) for _ in range(count)]
+
+    def bytes(self, size: int) -> bytes:
+        if self.pos + size > len(self.data):
+            raise DecodeError('snapshot is truncated at offset {}'.format(self.pos))
+        value = self.data[self.pos:self.pos + size]
+        self.pos += size
+        return value
+
+
+def decode(data: bytes) -> List[Dict[str, Any]]:
+    reader = Reader(data)
+    magic, version = reader.unpack('<4sB3x')
+    if magic != MAGIC:
+        raise DecodeError('not a metrics snapshot')
+    if version != VERSION:
+        raise DecodeError('unsupported snapshot version {}'.format(version))
+
+    metrics = []
+    while True:
+        metric_type = reader.unpack('<B')
+        if metric_type == 0:
+            break
+        name = reader.bytes(reader.unpack('<B')).decode()
+        metric = {'name': name, 'type': TYPE_NAMES.get(metric_type)}  # type: Dict[str, Any]
+        if metric_type == TYPE_COUNTER:
+            metric['value'] = reader.unpack('<Q')
+        elif metric_type == TYPE_GAUGE:
+            metric['value'] = reader.unpack('<q')
+        elif metric_type == TYPE_HISTOGRAM:
+            count = reader.unpack('<I')
+            metric['bounds'] = reader.array('I', count)
+            metric['buckets'] = reader.array('Q', count + 1)
+            metric['sum'] = reader.unpack('<Q')
+        else:
+            raise DecodeError('unknown type {} of metric {}'.format(metric_type, name))
+        metrics.append(metric)
+    return metrics
+
+
+def to_prometheus(metrics: List[Dict[str, Any]]) -> str:
+    lines = []
+    for metric in metrics:
+        name = metric['name']
+        lines.append('# TYPE {} {}'.format(name, metric['type']))
+        if metric['type'] == 'histogram':
+            cumulative = 0
+            bounds = [str(b) for b in metric['bounds']] + ['+Inf']
+            for bound, count in zip(bounds, metric['buckets']):
+                cumulative += count
+                lines.append('{}_bucket{{le="{}"}} {}'.format(name, bound, cumulative))
+            lines.append('{}_sum {}'.format(name, metric['sum']))
+            lines.append('{}_count {}'.format(name, cumulative))
+        else:
+            lines.append('{} {}'.format(name, metric['value']))
+    return '\n'.join(lines) + '\n'
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description='Decode a snapshot written by esp_metrics_export_binary()')
+    parser.add_argument('input', type=argparse.FileType('rb'), help='Snapshot file, - for stdin')
+    parser.add_argument('--json', action='store_true', help='Print the metrics as JSON instead of the Prometheus format')
+    args = parser.parse_args()
+
+    infile = args.input  # type: BinaryIO
+    data = infile.read()
+    try:
+        metrics = decode(data)
+    except DecodeError as e:
+        sys.exit('error: {}'.format(e))
+
+    if args.json:
+        print(json.dumps(metrics, indent=2))
+    else:
+        sys.stdout.write(to_prometheus(metrics))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,378 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Type of a metric
+ */
+typedef enum {
+    ESP_METRICS_TYPE_COUNTER = 1,   /*!< Monotonically increasing count, e.g. of events or bytes */
+    ESP_METRICS_TYPE_GAUGE = 2,     /*!< Value which can go up and down, e.g. a queue depth */
+    ESP_METRICS_TYPE_HISTOGRAM = 3, /*!< Distribution of observed values, e.g. durations, in buckets */
+} esp_metrics_type_t;
+
+/**
+ * @brief Common part of all metrics, linking them in the registry
+ */
+typedef struct esp_metrics_metric {
+    const char *name;                   /*!< Name in the Prometheus format, e.g. "esp_event_post_total" */
+    const char *help;                   /*!< Description of the metric */
+    esp_metrics_type_t type;            /*!< Type of the metric */
+    struct esp_metrics_metric *next;    /*!< Next metric in the registry */
+} esp_metrics_metric_t;
+
+/**
+ * @brief 64-bit value updated by one core only
+ *
+ * The core updates the value with interrupts masked, so no lock is needed between
+ * the cores. The sequence number is odd while the value is being updated, so that
+ * a reader on the other core can retry instead of reading a torn value.
+ */
+typedef struct {
+    volatile uint32_t seq;  /*!< Incremented before and after each update */
+    uint64_t value;         /*!< Value */
+} esp_metrics_slot_t;
+
+/**
+ * @brief Counter, with one slot per core
+ */
+typedef struct {
+    esp_metrics_metric_t metric;                                /*!< Common part */
+    esp_metrics_slot_t slots[CONFIG_FREERTOS_NUMBER_OF_CORES];  /*!< Counts of the cores, summed when read */
+} esp_metrics_counter_t;
+
+/**
+ * @brief Gauge, either set by the application or read by a callback when exported
+ */
+typedef struct {
+    esp_metrics_metric_t metric;    /*!< Common part */
+    int64_t (*read)(void);          /*!< If set, called to get the value when the gauge is exported */
+    volatile int32_t value;         /*!< Value if read is not set */
+} esp_metrics_gauge_t;
+
+/**
+ * @brief Histogram, with bucket counts and a sum per core
+ */
+typedef struct {
+    esp_metrics_metric_t metric;                                /*!< Common part */
+    const uint32_t *bounds;                                     /*!< Inclusive upper bounds of the buckets, ascending */
+    uint32_t bound_count;                                       /*!< Number of bounds */
+    uint32_t *buckets;                                          /*!< bound_count + 1 counts per core, the last one
+                                                                     for values above all bounds */
+    esp_metrics_slot_t sums[CONFIG_FREERTOS_NUMBER_OF_CORES];   /*!< Sums of the observed values of the cores */
+} esp_metrics_histogram_t;
+
+/**
+ * @brief Function receiving the output of the export functions
+ *
+ * @param data Data to write
+ * @param len  Length of the data
+ * @param arg  Argument given to the export function
+ * @return ESP_OK to continue, other values stop the export and are returned by it
+ */
+typedef esp_err_t (*esp_metrics_write_cb_t)(const void *data, size_t len, void *arg);
+
+/** @cond */
+#define ESP_METRICS_METRIC_INIT(name_, help_, type_) { .name = (name_), .help = (help_), .type = (type_), .next = NULL }
+
+/* The metrics are defined statically and linked into the registry before app_main(), without allocating memory */
+#define ESP_METRICS_REGISTER_AT_STARTUP(var_) \
+    static __attribute__((constructor)) void var_##_register(void) \
+    { \
+        esp_metrics_register(&(var_).metric); \
+    }
+/** @endcond */
+
+/**
+ * @brief Define a static counter and register it at startup
+ *
+ * @code{c}
+ * ESP_METRICS_COUNTER_DEFINE(s_rx_bytes, "my_rx_bytes_total", "Bytes received by my driver");
+ *
+ * esp_metrics_counter_add(&s_rx_bytes, len);
+ * @endcode
+ *
+ * The counter is placed in internal RAM, so it can be updated while the flash cache is disabled.
+ */
+#define ESP_METRICS_COUNTER_DEFINE(var_, name_, help_) \
+    static DRAM_ATTR esp_metrics_counter_t var_ = { \
+        .metric = ESP_METRICS_METRIC_INIT(name_, help_, ESP_METRICS_TYPE_COUNTER), \
+    }; \
+    ESP_METRICS_REGISTER_AT_STARTUP(var_)
+
+/**
+ * @brief Define a static gauge, set with esp_metrics_gauge_set() or esp_metrics_gauge_add(), and register it at startup
+ */
+#define ESP_METRICS_GAUGE_DEFINE(var_, name_, help_) \
+    static DRAM_ATTR esp_metrics_gauge_t var_ = { \
+        .metric = ESP_METRICS_METRIC_INIT(name_, help_, ESP_METRICS_TYPE_GAUGE), \
+    }; \
+    ESP_METRICS_REGISTER_AT_STARTUP(var_)
+
+/**
+ * @brief Define a static gauge whose value is returned by read_fn_ when it is exported, and register it at startup
+ *
+ * This makes statistics which a component keeps anyway available without any cost on the hot path,
+ * e.g. the free heap size. The function is called from the task which exports the metrics.
+ */
+#define ESP_METRICS_GAUGE_FN_DEFINE(var_, name_, help_, read_fn_) \
+    static esp_metrics_gauge_t var_ = { \
+        .metric = ESP_METRICS_METRIC_INIT(name_, help_, ESP_METRICS_TYPE_GAUGE), \
+        .read = (read_fn_), \
+    }; \
+    ESP_METRICS_REGISTER_AT_STARTUP(var_)
+
+/**
+ * @brief Define a static histogram with the given inclusive upper bounds of its buckets, and register it at startup
+ *
+ * @code{c}
+ * ESP_METRICS_HISTOGRAM_DEFINE(s_latency, "my_latency_us", "Latency of my requests", 100, 1000, 10000);
+ *
+ * esp_metrics_histogram_observe(&s_latency, end - start);
+ * @endcode
+ *
+ * The bounds have to be in ascending order. Values above the last bound are counted in an extra bucket.
+ * The histogram and its buckets are placed in internal RAM.
+ */
+#define ESP_METRICS_HISTOGRAM_DEFINE(var_, name_, help_, ...) \
+    static DRAM_ATTR const uint32_t var_##_bounds[] = { __VA_ARGS__ }; \
+    static DRAM_ATTR uint32_t var_##_buckets[CONFIG_FREERTOS_NUMBER_OF_CORES] \
+                                            [sizeof(var_##_bounds) / sizeof(uint32_t) + 1]; \
+    static DRAM_ATTR esp_metrics_histogram_t var_ = { \
+        .metric = ESP_METRICS_METRIC_INIT(name_, help_, ESP_METRICS_TYPE_HISTOGRAM), \
+        .bounds = var_##_bounds, \
+        .bound_count = sizeof(var_##_bounds) / sizeof(uint32_t), \
+        .buckets = &var_##_buckets[0][0], \
+    }; \
+    ESP_METRICS_REGISTER_AT_STARTUP(var_)
+
+/** @cond */
+/* Called with interrupts masked, so that the current core is the only writer of the slot */
+FORCE_INLINE_ATTR void esp_metrics_slot_add(esp_metrics_slot_t *slot, uint64_t n)
+{
+    slot->seq++;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot->value += n;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot->seq++;
+}
+/** @endcond */
+
+/**
+ * @brief Add to a counter
+ *
+ * The counter of the current core is updated with interrupts masked for a few instructions,
+ * without taking a lock. Can be called from tasks and ISRs, also while the flash cache is disabled.
+ *
+ * @param counter Counter
+ * @param n       Number to add
+ */
+FORCE_INLINE_ATTR void esp_metrics_counter_add(esp_metrics_counter_t *counter, uint32_t n)
+{
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    esp_metrics_slot_add(&counter->slots[esp_cpu_get_core_id()], n);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+}
+
+/**
+ * @brief Increment a counter, see esp_metrics_counter_add()
+ *
+ * @param counter Counter
+ */
+FORCE_INLINE_ATTR void esp_metrics_counter_inc(esp_metrics_counter_t *counter)
+{
+    esp_metrics_counter_add(counter, 1);
+}
+
+/**
+ * @brief Set the value of a gauge
+ *
+ * @param gauge Gauge
+ * @param value Value
+ */
+FORCE_INLINE_ATTR void esp_metrics_gauge_set(esp_metrics_gauge_t *gauge, int32_t value)
+{
+    gauge->value = value;
+}
+
+/**
+ * @brief Add to the value of a gauge atomically
+ *
+ * @param gauge Gauge
+ * @param delta Number to add, negative to subtract
+ */
+FORCE_INLINE_ATTR void esp_metrics_gauge_add(esp_metrics_gauge_t *gauge, int32_t delta)
+{
+    __atomic_fetch_add(&gauge->value, delta, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Count a value in the bucket of a histogram and add it to its sum
+ *
+ * Like esp_metrics_counter_add(), this does not take a lock and can be called from tasks and ISRs.
+ *
+ * @param histogram Histogram
+ * @param value     Observed value
+ */
+FORCE_INLINE_ATTR void esp_metrics_histogram_observe(esp_metrics_histogram_t *histogram, uint32_t value)
+{
+    uint32_t bucket = 0;
+    while (bucket < histogram->bound_count && value > histogram->bounds[bucket]) {
+        bucket++;
+    }
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    int core = esp_cpu_get_core_id();
+    histogram->buckets[core * (histogram->bound_count + 1) + bucket]++;
+    esp_metrics_slot_add(&histogram->sums[core], value);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+}
+
+/**
+ * @brief Add a metric to the registry, so that it is exported
+ *
+ * The metrics defined with the ESP_METRICS_*_DEFINE macros are registered at startup. Use this function
+ * for metrics which are created at run time, e.g. one per instance of a driver. Initialize the common part
+ * with the name, the help and the type, and the rest of the metric with zeros, except the bounds and
+ * the buckets of a histogram.
+ *
+ * @note Not to be called from an ISR.
+ *
+ * @param metric Common part of the metric, has to stay valid until it is unregistered
+ * @return
+ *      - ESP_OK: Register the metric successfully
+ *      - ESP_ERR_INVALID_ARG: Register the metric failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Register the metric failed because a metric with the same name is registered
+ */
+esp_err_t esp_metrics_register(esp_metrics_metric_t *metric);
+
+/**
+ * @brief Remove a metric from the registry
+ *
+ * @note Not to be called from an ISR.
+ *
+ * @param metric Metric which was registered with esp_metrics_register()
+ * @return
+ *      - ESP_OK: Unregister the metric successfully
+ *      - ESP_ERR_NOT_FOUND: Unregister the metric failed because it is not registered
+ */
+esp_err_t esp_metrics_unregister(esp_metrics_metric_t *metric);
+
+/**
+ * @brief Find a registered metric by name
+ *
+ * @param name Name of the metric
+ * @return The metric, or NULL if there is no metric with this name
+ */
+esp_metrics_metric_t *esp_metrics_find(const char *name);
+
+/**
+ * @brief Get the value of a counter, summed over the cores
+ *
+ * @param counter Counter
+ * @return Value
+ */
+uint64_t esp_metrics_counter_get(const esp_metrics_counter_t *counter);
+
+/**
+ * @brief Get the value of a gauge, calling its read function if it has one
+ *
+ * @param gauge Gauge
+ * @return Value
+ */
+int64_t esp_metrics_gauge_get(const esp_metrics_gauge_t *gauge);
+
+/**
+ * @brief Get the number and the sum of the values observed by a histogram, summed over the cores
+ *
+ * @param histogram     Histogram
+ * @param[out] counts   Optional, bound_count + 1 counts of the buckets, not cumulative
+ * @param[out] out_sum  Optional, sum of the observed values
+ * @return Number of observed values
+ */
+uint64_t esp_metrics_histogram_get(const esp_metrics_histogram_t *histogram, uint64_t *counts, uint64_t *out_sum);
+
+/**
+ * @brief Export the registered metrics in the Prometheus text exposition format
+ *
+ * The output is written in small pieces, so it can be sent e.g. with httpd_resp_send_chunk().
+ * Each metric is preceded by its HELP and TYPE lines. The bucket counts of histograms are cumulative,
+ * as Prometheus expects.
+ *
+ * @note The registry is locked during the export, so the function must not register or unregister metrics.
+ *
+ * @param write Function receiving the output
+ * @param arg   Argument passed to the function
+ * @return
+ *      - ESP_OK: Export the metrics successfully
+ *      - ESP_ERR_INVALID_ARG: Export the metrics failed because of invalid argument
+ *      - Others: Value returned by the function, which stopped the export
+ */
+esp_err_t esp_metrics_export_prometheus(esp_metrics_write_cb_t write, void *arg);
+
+/**
+ * @brief Export the registered metrics in a compact binary format
+ *
+ * The format is meant for storing or uploading snapshots, decode it with esp_metrics_decode.py in the
+ * component directory. All values are little-endian:
+ *
+ * - Header: magic "EMET", format version (1 byte), 3 reserved bytes
+ * - For each metric: type (1 byte), length of the name (1 byte), name, and then
+ *   - counter: value (8 bytes)
+ *   - gauge: value (8 bytes, signed)
+ *   - histogram: number of bounds N (4 bytes), N bounds (4 bytes each), N + 1 bucket counts (8 bytes each,
+ *     not cumulative), sum (8 bytes)
+ * - End: a 0 byte in place of the type
+ *
+ * Names longer than 255 bytes are truncated.
+ *
+ * @note The registry is locked during the export, so the function must not register or unregister metrics.
+ *
+ * @param write Function receiving the output
+ * @param arg   Argument passed to the function
+ * @return
+ *      - ESP_OK: Export the metrics successfully
+ *      - ESP_ERR_INVALID_ARG: Export the metrics failed because of invalid argument
+ *      - Others: Value returned by the function, which stopped the export
+ */
+esp_err_t esp_metrics_export_binary(esp_metrics_write_cb_t write, void *arg);
+
+/**
+ * @brief Print the registered metrics in the Prometheus format to stdout
+ *
+ * The function has the signature of a console command, register it with esp_console_cmd_register():
+ *
+ * @code{c}
+ * const esp_console_cmd_t cmd = {
+ *     .command = "metrics",
+ *     .help = "Print the metrics, optionally only those whose name starts with the given prefix",
+ *     .hint = "[prefix]",
+ *     .func = &esp_metrics_console_cmd,
+ * };
+ * esp_console_cmd_register(&cmd);
+ * @endcode
+ *
+ * @param argc Number of arguments, 1 or 2
+ * @param argv Command name, and optionally a prefix of the names of the metrics to print
+ * @return 0 if successful, 1 otherwise
+ */
+int esp_metrics_console_cmd(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
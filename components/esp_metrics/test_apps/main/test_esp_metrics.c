@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_metrics.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/ringbuf.h"
+
+ESP_METRICS_COUNTER_DEFINE(s_counter, "test_counter_total", "Counter of the test");
+ESP_METRICS_GAUGE_DEFINE(s_gauge, "test_gauge", "Gauge of the test");
+ESP_METRICS_HISTOGRAM_DEFINE(s_histogram, "test_histogram_us", "Histogram of the test", 10, 100);
+
+#define INCREMENTS  10000
+
+void app_main(void)
+{
+    unity_run_menu();
+}
+
+static void increment_task(void *arg)
+{
+    for (int i = 0; i < INCREMENTS; i++) {
+        esp_metrics_counter_inc(&s_counter);
+    }
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("counters are not lost when updated on all cores", "[esp_metrics]")
+{
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(CONFIG_FREERTOS_NUMBER_OF_CORES, 0);
+    TEST_ASSERT_NOT_NULL(done);
+    uint64_t start = esp_metrics_counter_get(&s_counter);
+    for (int core = 0; core < CONFIG_FREERTOS_NUMBER_OF_CORES; core++) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(increment_task, "inc", 2048, done, 5, NULL, core));
+    }
+    for (int core = 0; core < CONFIG_FREERTOS_NUMBER_OF_CORES; core++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done, pdMS_TO_TICKS(1000)));
+    }
+    TEST_ASSERT_EQUAL_UINT64(start + CONFIG_FREERTOS_NUMBER_OF_CORES * INCREMENTS, esp_metrics_counter_get(&s_counter));
+    vTaskDelay(2); // let the idle task free the deleted tasks
+    vSemaphoreDelete(done);
+}
+
+TEST_CASE("gauges and histograms record values", "[esp_metrics]")
+{
+    esp_metrics_gauge_set(&s_gauge, 5);
+    esp_metrics_gauge_add(&s_gauge, -7);
+    TEST_ASSERT_EQUAL_INT64(-2, esp_metrics_gauge_get(&s_gauge));
+
+    uint64_t before[3], after[3], sum_before, sum_after;
+    uint64_t count = esp_metrics_histogram_get(&s_histogram, before, &sum_before);
+    esp_metrics_histogram_observe(&s_histogram, 10);
+    esp_metrics_histogram_observe(&s_histogram, 11);
+    esp_metrics_histogram_observe(&s_histogram, 1000);
+    TEST_ASSERT_EQUAL_UINT64(count + 3, esp_metrics_histogram_get(&s_histogram, after, &sum_after));
+    TEST_ASSERT_EQUAL_UINT64(sum_before + 1021, sum_after);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_UINT64(before[i] + 1, after[i]);
+    }
+}
+
+static int64_t read_answer(void)
+{
+    return 42;
+}
+
+TEST_CASE("metrics can be registered at run time", "[esp_metrics]")
+{
+    TEST_ASSERT_EQUAL_PTR(&s_counter.metric, esp_metrics_find("test_counter_total"));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_metrics_register(&s_counter.metric));
+
+    esp_metrics_gauge_t gauge = {
+        .metric = ESP_METRICS_METRIC_INIT("test_answer", NULL, ESP_METRICS_TYPE_GAUGE),
+        .read = read_answer,
+    };
+    TEST_ASSERT_NULL(esp_metrics_find("test_answer"));
+    TEST_ESP_OK(esp_metrics_register(&gauge.metric));
+    TEST_ASSERT_EQUAL_PTR(&gauge.metric, esp_metrics_find("test_answer"));
+    TEST_ASSERT_EQUAL_INT64(42, esp_metrics_gauge_get(&gauge));
+
+    esp_metrics_gauge_t same_name = {
+        .metric = ESP_METRICS_METRIC_INIT("test_answer", NULL, ESP_METRICS_TYPE_GAUGE),
+    };
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_metrics_register(&same_name.metric));
+
+    TEST_ESP_OK(esp_metrics_unregister(&gauge.metric));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_metrics_unregister(&gauge.metric));
+    TEST_ASSERT_NULL(esp_metrics_find("test_answer"));
+}
+
+typedef struct {
+    char buf[4096];
+    size_t len;
+} output_t;
+
+static esp_err_t write_output(const void *data, size_t len, void *arg)
+{
+    output_t *out = arg;
+    if (out->len + len >= sizeof(out->buf)) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(out->buf + out->len, data, len);
+    out->len += len;
+    out->buf[out->len] = '\0';
+    return ESP_OK;
+}
+
+TEST_CASE("metrics are exported in the Prometheus format", "[esp_metrics]")
+{
+    static output_t out;
+    out.len = 0;
+    esp_metrics_gauge_set(&s_gauge, -3);
+    TEST_ESP_OK(esp_metrics_export_prometheus(write_output, &out));
+    TEST_ASSERT_NOT_NULL(strstr(out.buf, "# HELP test_counter_total Counter of the test\n"
+                                "# TYPE test_counter_total counter\ntest_counter_total "));
+    TEST_ASSERT_NOT_NULL(strstr(out.buf, "# TYPE test_gauge gauge\ntest_gauge -3\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out.buf, "# TYPE test_histogram_us histogram\ntest_histogram_us_bucket{le=\"10\"} "));
+    TEST_ASSERT_NOT_NULL(strstr(out.buf, "test_histogram_us_bucket{le=\"+Inf\"} "));
+    TEST_ASSERT_NOT_NULL(strstr(out.buf, "test_histogram_us_sum "));
+    TEST_ASSERT_NOT_NULL(strstr(out.buf, "test_histogram_us_count "));
+
+    /* An error of the write function stops the export */
+    output_t *small = calloc(1, sizeof(output_t));
+    TEST_ASSERT_NOT_NULL(small);
+    small->len = sizeof(small->buf) - 10;
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, esp_metrics_export_prometheus(write_output, small));
+    free(small);
+}
+
+TEST_CASE("metrics are exported in the binary format", "[esp_metrics]")
+{
+    static output_t out;
+    out.len = 0;
+    TEST_ESP_OK(esp_metrics_export_binary(write_output, &out));
+    TEST_ASSERT_EQUAL_MEMORY("EMET\x01", out.buf, 5);
+    TEST_ASSERT_EQUAL(0, out.buf[out.len - 1]);
+
+    const char name[] = "test_gauge";
+    const uint8_t record_head[] = { ESP_METRICS_TYPE_GAUGE, sizeof(name) - 1 };
+    char *record = memmem(out.buf, out.len, name, sizeof(name) - 1);
+    TEST_ASSERT_NOT_NULL(record);
+    TEST_ASSERT_EQUAL_MEMORY(record_head, record - 2, 2);
+    int64_t value;
+    memcpy(&value, record + sizeof(name) - 1, sizeof(value));
+    TEST_ASSERT_EQUAL_INT64(esp_metrics_gauge_get(&s_gauge), value);
+}
+
+#if CONFIG_ESP_METRICS_SYSTEM
+TEST_CASE("system components define metrics", "[esp_metrics]")
+{
+    esp_metrics_metric_t *heap_free = esp_metrics_find("heap_free_bytes");
+    TEST_ASSERT_NOT_NULL(heap_free);
+    TEST_ASSERT_GREATER_THAN(0, esp_metrics_gauge_get((esp_metrics_gauge_t *)heap_free));
+
+    esp_metrics_counter_t *sent = (esp_metrics_counter_t *)esp_metrics_find("esp_ringbuf_send_total");
+    esp_metrics_counter_t *failed = (esp_metrics_counter_t *)esp_metrics_find("esp_ringbuf_send_failed_total");
+    TEST_ASSERT_NOT_NULL(sent);
+    TEST_ASSERT_NOT_NULL(failed);
+    uint64_t sent_before = esp_metrics_counter_get(sent);
+    uint64_t failed_before = esp_metrics_counter_get(failed);
+
+    RingbufHandle_t rb = xRingbufferCreate(64, RINGBUF_TYPE_BYTEBUF);
+    TEST_ASSERT_NOT_NULL(rb);
+    uint8_t data[48] = {};
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferSend(rb, data, sizeof(data), 0));
+    TEST_ASSERT_EQUAL(pdFALSE, xRingbufferSend(rb, data, sizeof(data), 0));
+    vRingbufferDelete(rb);
+
+    TEST_ASSERT_EQUAL_UINT64(sent_before + 1, esp_metrics_counter_get(sent));
+    TEST_ASSERT_EQUAL_UINT64(failed_before + 1, esp_metrics_counter_get(failed));
+}
+#endif
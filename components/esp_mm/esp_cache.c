@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -82,7 +82,20 @@ static void s_release_mutex_from_task_context(void)
 #endif  //#if CONFIG_ESP_MM_CACHE_MSYNC_C2M_CHUNKED_OPS
 }
 
-esp_err_t esp_cache_msync(void *addr, size_t size, int flags)
+static esp_err_t s_check_flags(int flags)
+{
+    bool both_dir = (flags & ESP_CACHE_MSYNC_FLAG_DIR_C2M) && (flags & ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+    bool both_type = (flags & ESP_CACHE_MSYNC_FLAG_TYPE_DATA) && (flags & ESP_CACHE_MSYNC_FLAG_TYPE_INST);
+    ESP_RETURN_ON_FALSE_ISR(!both_dir && !both_type, ESP_ERR_INVALID_ARG, TAG, "both C2M and M2C directions, or both data and instruction type are selected, you should only select one direction or one type");
+    if (flags & ESP_CACHE_MSYNC_FLAG_DIR_M2C) {
+        ESP_RETURN_ON_FALSE_ISR(!(flags & ESP_CACHE_MSYNC_FLAG_UNALIGNED), ESP_ERR_INVALID_ARG, TAG, "M2C direction doesn't allow ESP_CACHE_MSYNC_FLAG_UNALIGNED");
+    } else {
+        ESP_RETURN_ON_FALSE_ISR(!(flags & ESP_CACHE_MSYNC_FLAG_TYPE_INST), ESP_ERR_INVALID_ARG, TAG, "C2M direction doesn't support instruction type");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t s_check_range(void *addr, size_t size, int flags, uint32_t *out_cache_level, uint32_t *out_cache_line_size)
 {
     ESP_RETURN_ON_FALSE_ISR(addr, ESP_ERR_INVALID_ARG, TAG, "null pointer");
 
@@ -91,10 +104,6 @@ esp_err_t esp_cache_msync(void *addr, size_t size, int flags)
     ESP_EARLY_LOGV(TAG, "addr_end: 0x%" PRIx32, addr_end);
     ESP_RETURN_ON_FALSE_ISR(!ovf, ESP_ERR_INVALID_ARG, TAG, "wrong size, total size overflow");
 
-    bool both_dir = (flags & ESP_CACHE_MSYNC_FLAG_DIR_C2M) && (flags & ESP_CACHE_MSYNC_FLAG_DIR_M2C);
-    bool both_type = (flags & ESP_CACHE_MSYNC_FLAG_TYPE_DATA) && (flags & ESP_CACHE_MSYNC_FLAG_TYPE_INST);
-    ESP_RETURN_ON_FALSE_ISR(!both_dir && !both_type, ESP_ERR_INVALID_ARG, TAG, "both C2M and M2C directions, or both data and instruction type are selected, you should only select one direction or one type");
-
     uint32_t vaddr = (uint32_t)addr;
     bool valid = false;
     uint32_t cache_level = 0;
@@ -112,14 +121,19 @@ esp_err_t esp_cache_msync(void *addr, size_t size, int flags)
         ESP_RETURN_ON_FALSE_ISR(aligned_addr, ESP_ERR_INVALID_ARG, TAG, "start address: 0x%" PRIx32 ", or the size: 0x%" PRIx32 " is(are) not aligned with cache line size (0x%" PRIx32 ")B", (uint32_t)addr, (uint32_t)size, cache_line_size);
     }
 
-    s_acquire_mutex_from_task_context();
+    *out_cache_level = cache_level;
+    *out_cache_line_size = cache_line_size;
+    return ESP_OK;
+}
+
+//called with the mutex taken, the range and the flags have been checked
+static void s_msync_ops(uint32_t vaddr, size_t size, int flags)
+{
+    // Value unused if asserts are disabled
+    bool __attribute__((unused)) valid = true;
     if (flags & ESP_CACHE_MSYNC_FLAG_DIR_M2C) {
         ESP_EARLY_LOGV(TAG, "M2C DIR");
 
-        if (flags & ESP_CACHE_MSYNC_FLAG_UNALIGNED) {
-            ESP_RETURN_ON_FALSE_ISR(false, ESP_ERR_INVALID_ARG, TAG, "M2C direction doesn't allow ESP_CACHE_MSYNC_FLAG_UNALIGNED");
-        }
-
         esp_os_enter_critical_safe(&s_spinlock);
         //Add preload feature / flag here, IDF-7800
         valid = cache_hal_invalidate_addr(vaddr, size);
@@ -127,9 +141,6 @@ esp_err_t esp_cache_msync(void *addr, size_t size, int flags)
         assert(valid);
     } else {
         ESP_EARLY_LOGV(TAG, "C2M DIR");
-        if (flags & ESP_CACHE_MSYNC_FLAG_TYPE_INST) {
-            ESP_RETURN_ON_FALSE_ISR(false, ESP_ERR_INVALID_ARG, TAG, "C2M direction doesn't support instruction type");
-        }
 
 #if SOC_CACHE_WRITEBACK_SUPPORTED
         s_c2m_ops(vaddr, size);
@@ -142,11 +153,138 @@ esp_err_t esp_cache_msync(void *addr, size_t size, int flags)
         assert(valid);
 #endif  //#if SOC_CACHE_WRITEBACK_SUPPORTED
     }
+}
+
+esp_err_t esp_cache_msync(void *addr, size_t size, int flags)
+{
+    uint32_t cache_level = 0;
+    uint32_t cache_line_size = 0;
+    ESP_RETURN_ON_ERROR_ISR(s_check_flags(flags), TAG, "invalid flags");
+    ESP_RETURN_ON_ERROR_ISR(s_check_range(addr, size, flags, &cache_level, &cache_line_size), TAG, "invalid range");
+
+    s_acquire_mutex_from_task_context();
+    s_msync_ops((uint32_t)addr, size, flags);
+    s_release_mutex_from_task_context();
+
+    return ESP_OK;
+}
+
+esp_err_t esp_cache_msync_ranges(esp_cache_msync_range_t *ranges, size_t num_ranges, int flags)
+{
+    ESP_RETURN_ON_FALSE_ISR(ranges || num_ranges == 0, ESP_ERR_INVALID_ARG, TAG, "null pointer");
+    ESP_RETURN_ON_ERROR_ISR(s_check_flags(flags), TAG, "invalid flags");
+
+    // check all the ranges before doing any operation, and round the unaligned ones to the cache lines they touch
+    for (size_t i = 0; i < num_ranges; i++) {
+        uint32_t cache_level = 0;
+        uint32_t cache_line_size = 0;
+        ESP_RETURN_ON_ERROR_ISR(s_check_range(ranges[i].addr, ranges[i].size, flags, &cache_level, &cache_line_size), TAG, "invalid range %zu", i);
+        if (cache_line_size) {
+            uint32_t start = (uint32_t)ranges[i].addr & ~(cache_line_size - 1);
+            uint32_t end = ALIGN_UP_BY((uint32_t)ranges[i].addr + ranges[i].size, cache_line_size);
+            ranges[i].addr = (void *)start;
+            ranges[i].size = end - start;
+        }
+    }
+
+    // sort by address, in place: the arrays are short and this may run in an ISR
+    for (size_t i = 1; i < num_ranges; i++) {
+        esp_cache_msync_range_t range = ranges[i];
+        size_t j = i;
+        while (j > 0 && (uint32_t)ranges[j - 1].addr > (uint32_t)range.addr) {
+            ranges[j] = ranges[j - 1];
+            j--;
+        }
+        ranges[j] = range;
+    }
+
+    // merge the overlapping and adjacent ranges of the same cache, and sync each merged range once
+    s_acquire_mutex_from_task_context();
+    size_t i = 0;
+    while (i < num_ranges) {
+        uint32_t start = (uint32_t)ranges[i].addr;
+        uint32_t end = start + ranges[i].size;
+        uint32_t cache_level = 0;
+        uint32_t cache_id = 0;
+        for (i++; i < num_ranges && (uint32_t)ranges[i].addr <= end; i++) {
+            uint32_t new_end = MAX(end, (uint32_t)ranges[i].addr + ranges[i].size);
+            if (!cache_hal_vaddr_to_cache_level_id(start, new_end - start, &cache_level, &cache_id)) {
+                break;
+            }
+            end = new_end;
+        }
+        if (end > start) {
+            s_msync_ops(start, end - start, flags);
+        }
+    }
     s_release_mutex_from_task_context();
 
     return ESP_OK;
 }
 
+static esp_cache_msync_range_t s_deferred[CONFIG_ESP_MM_CACHE_MSYNC_DEFERRED_SLOTS];
+static size_t s_deferred_num;
+
+//move the deferred ranges overlapping [start, end) out of the table, all of them if end is 0
+static size_t s_take_deferred(uint32_t start, uint32_t end, esp_cache_msync_range_t *out)
+{
+    size_t num = 0;
+    esp_os_enter_critical_safe(&s_spinlock);
+    for (size_t i = 0; i < s_deferred_num;) {
+        uint32_t range_start = (uint32_t)s_deferred[i].addr;
+        uint32_t range_end = range_start + s_deferred[i].size;
+        if (end == 0 || (range_start < end && start < range_end)) {
+            out[num++] = s_deferred[i];
+            s_deferred[i] = s_deferred[--s_deferred_num];
+        } else {
+            i++;
+        }
+    }
+    esp_os_exit_critical_safe(&s_spinlock);
+    return num;
+}
+
+esp_err_t esp_cache_msync_defer_invalidate(void *addr, size_t size)
+{
+    uint32_t cache_level = 0;
+    uint32_t cache_line_size = 0;
+    ESP_RETURN_ON_ERROR_ISR(s_check_range(addr, size, ESP_CACHE_MSYNC_FLAG_DIR_M2C, &cache_level, &cache_line_size), TAG, "invalid range");
+
+    esp_cache_msync_range_t full[CONFIG_ESP_MM_CACHE_MSYNC_DEFERRED_SLOTS];
+    size_t num_full = 0;
+    esp_os_enter_critical_safe(&s_spinlock);
+    if (s_deferred_num == CONFIG_ESP_MM_CACHE_MSYNC_DEFERRED_SLOTS) {
+        // the table is full: invalidate the deferred ranges now, and start a new batch
+        memcpy(full, s_deferred, sizeof(s_deferred));
+        num_full = s_deferred_num;
+        s_deferred_num = 0;
+    }
+    s_deferred[s_deferred_num].addr = addr;
+    s_deferred[s_deferred_num].size = size;
+    s_deferred_num++;
+    esp_os_exit_critical_safe(&s_spinlock);
+
+    return esp_cache_msync_ranges(full, num_full, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+}
+
+esp_err_t esp_cache_msync_touch(void *addr, size_t size)
+{
+    ESP_RETURN_ON_FALSE_ISR(addr, ESP_ERR_INVALID_ARG, TAG, "null pointer");
+    uint32_t end = 0;
+    ESP_RETURN_ON_FALSE_ISR(!__builtin_add_overflow((uint32_t)addr, size, &end) && end, ESP_ERR_INVALID_ARG, TAG, "wrong size, total size overflow");
+
+    esp_cache_msync_range_t ranges[CONFIG_ESP_MM_CACHE_MSYNC_DEFERRED_SLOTS];
+    size_t num = s_take_deferred((uint32_t)addr, end, ranges);
+    return esp_cache_msync_ranges(ranges, num, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+}
+
+esp_err_t esp_cache_msync_flush_deferred(void)
+{
+    esp_cache_msync_range_t ranges[CONFIG_ESP_MM_CACHE_MSYNC_DEFERRED_SLOTS];
+    size_t num = s_take_deferred(0, 0, ranges);
+    return esp_cache_msync_ranges(ranges, num, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+}
+
 //The esp_cache_aligned_malloc function is marked deprecated but also called by other
 //(also deprecated) functions in this file. In order to work around that generating warnings, it's
 //split into a non-deprecated internal function and the stubbed external deprecated function.
@@ -288,6 +288,66 @@ esp_err_t esp_mmu_map_get_max_consecutive_free_block_size(mmu_mem_caps_t caps, m
     return ESP_OK;
 }
 
+/**
+ * Largest slot of a region which has blocks, the list starts with the dummy_head and ends with the dummy_tail
+ */
+static size_t s_get_max_slot_size(mem_region_t *region)
+{
+    mem_block_t *mem_block = NULL;
+    uint32_t last_end = TAILQ_FIRST(&region->mem_block_head)->laddr_end;
+    size_t max_slot_len = 0;
+
+    TAILQ_FOREACH(mem_block, &region->mem_block_head, entries) {
+        size_t slot_len = mem_block->laddr_start - last_end;
+        max_slot_len = (slot_len > max_slot_len) ? slot_len : max_slot_len;
+        last_end = mem_block->laddr_end;
+    }
+    return max_slot_len;
+}
+
+esp_err_t esp_mmu_map_get_stats(mmu_mem_caps_t caps, mmu_target_t target, esp_mmu_map_stats_t *out_stats)
+{
+    ESP_RETURN_ON_FALSE(out_stats, ESP_ERR_INVALID_ARG, TAG, "null pointer");
+    ESP_RETURN_ON_ERROR(s_mem_caps_check(caps), TAG, "invalid caps");
+    memset(out_stats, 0, sizeof(esp_mmu_map_stats_t));
+
+    for (int i = 0; i < s_mmu_ctx.num_regions; i++) {
+        mem_region_t *region = &s_mmu_ctx.mem_regions[i];
+        if (((region->caps & caps) != caps) || ((region->targets & target) != target)) {
+            continue;
+        }
+        out_stats->total_size += region->end - region->free_head;
+        if (TAILQ_EMPTY(&region->mem_block_head)) {
+            if (region->end > region->free_head) {
+                out_stats->free_size += region->end - region->free_head;
+                out_stats->free_block_num++;
+            }
+        } else {
+            mem_block_t *mem_block = NULL;
+            uint32_t last_end = TAILQ_FIRST(&region->mem_block_head)->laddr_end;
+            TAILQ_FOREACH(mem_block, &region->mem_block_head, entries) {
+                size_t slot_len = mem_block->laddr_start - last_end;
+                if (slot_len) {
+                    out_stats->free_size += slot_len;
+                    out_stats->free_block_num++;
+                }
+                if (mem_block->size) {
+                    //the dummy_head and the dummy_tail are empty
+                    out_stats->mapped_size += mem_block->size;
+                    out_stats->mapped_block_num++;
+                }
+                last_end = mem_block->laddr_end;
+            }
+        }
+        if (region->max_slot_size > out_stats->largest_free_block) {
+            out_stats->largest_free_block = region->max_slot_size;
+        }
+    }
+    out_stats->mmu_entry_num = out_stats->mapped_size / CONFIG_MMU_PAGE_SIZE;
+
+    return ESP_OK;
+}
+
 static int32_t s_find_available_region(mem_region_t *mem_regions, uint32_t region_nums, size_t size, mmu_mem_caps_t caps, mmu_target_t target)
 {
     int32_t found_region_id = -1;
@@ -524,40 +584,39 @@ esp_err_t esp_mmu_map(esp_paddr_t paddr_start, size_t size, mmu_target_t target,
     new_block = (mem_block_t *)heap_caps_calloc(1, sizeof(mem_block_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
     ESP_GOTO_ON_FALSE(new_block, ESP_ERR_NO_MEM, err, TAG, "no mem");
 
-    //Reserve this block as it'll be mapped
-    bool found = false;
+    /**
+     * Reserve this block as it'll be mapped, in the smallest slot it fits in (best fit).
+     * Placing the blocks in the first slot that fits would split the large slots, so that large
+     * blocks could no longer be mapped after a few small blocks were mapped and unmapped.
+     */
     // Get the end address of the dummy_head block, which is always first block on the list
     uint32_t last_end = TAILQ_FIRST(&found_region->mem_block_head)->laddr_end;
     size_t slot_len = 0;
-    size_t max_slot_len = 0;
+    size_t found_slot_len = SIZE_MAX;
     mem_block_t *found_block = NULL;  //This stands for the block we found, whose slot between its prior block is where we will insert the new block to
 
     TAILQ_FOREACH(mem_block, &found_region->mem_block_head, entries) {
         slot_len = mem_block->laddr_start - last_end;
-
-        if (!found) {
-            if (slot_len >= aligned_size) {
-                //Found it
-                found = true;
-                found_block = mem_block;
-                slot_len -= aligned_size;
-                new_block->laddr_start = last_end;
+        if (slot_len >= aligned_size && slot_len < found_slot_len) {
+            found_slot_len = slot_len;
+            found_block = mem_block;
+            new_block->laddr_start = last_end;
+            if (slot_len == aligned_size) {
+                break;
             }
         }
-
-        max_slot_len = (slot_len > max_slot_len) ? slot_len : max_slot_len;
         last_end = mem_block->laddr_end;
     }
 
-    assert(found);
+    assert(found_block);
     //insert the to-be-mapped new block to the list
     TAILQ_INSERT_BEFORE(found_block, new_block, entries);
+    new_block->laddr_end = new_block->laddr_start + aligned_size;
 
     //Finally, we update the max_slot_size
-    found_region->max_slot_size = max_slot_len;
+    found_region->max_slot_size = s_get_max_slot_size(found_region);
 
     //Now we fill others according to the found `new_block->laddr_start`
-    new_block->laddr_end = new_block->laddr_start + aligned_size;
     new_block->size = aligned_size;
     new_block->caps = caps;
     new_block->paddr_start = paddr_start;
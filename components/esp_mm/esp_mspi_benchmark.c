@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "esp_check.h"
+#include "esp_cpu.h"
+#include "esp_random.h"
+#include "esp_memory_utils.h"
+#include "esp_private/esp_clk.h"
+#include "soc/soc_caps.h"
+#include "hal/cache_hal.h"
+#include "hal/cache_types.h"
+#include "esp_cache.h"
+#include "esp_mspi_benchmark.h"
+
+static const char *TAG = "mspi_bench";
+
+#define RAND_READ_NUM    256    //number of cache line fills timed for the random read results
+
+//Make sure the next reads of the region come from the external memory
+static esp_err_t s_invalidate(uint32_t vaddr, size_t size)
+{
+    int flags = ESP_CACHE_MSYNC_FLAG_DIR_M2C;
+#if SOC_CACHE_WRITEBACK_SUPPORTED
+    if (esp_ptr_external_ram((void *)vaddr)) {
+        //write back the PSRAM data, the buffer would be corrupted otherwise
+        flags = ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE;
+    }
+#endif
+    return esp_cache_msync((void *)vaddr, size, flags);
+}
+
+static uint32_t s_kbps(uint64_t bytes, uint64_t cycles)
+{
+    return cycles ? (uint32_t)(bytes * esp_clk_cpu_freq() / cycles / 1024) : 0;
+}
+
+esp_err_t esp_mspi_benchmark_read(const void *vaddr, size_t size, esp_mspi_benchmark_result_t *out_result)
+{
+    ESP_RETURN_ON_FALSE(vaddr && out_result, ESP_ERR_INVALID_ARG, TAG, "null pointer");
+    uint32_t cache_level = 0;
+    uint32_t cache_id = 0;
+    ESP_RETURN_ON_FALSE(cache_hal_vaddr_to_cache_level_id((uint32_t)vaddr, size, &cache_level, &cache_id), ESP_ERR_INVALID_ARG, TAG, "not a cached external memory region");
+    uint32_t line_size = cache_hal_get_cache_line_size(cache_level, CACHE_TYPE_DATA);
+
+    //only whole cache lines are read, and invalidated
+    uint32_t start = ((uint32_t)vaddr + line_size - 1) & ~(line_size - 1);
+    uint32_t end = ((uint32_t)vaddr + size) & ~(line_size - 1);
+    ESP_RETURN_ON_FALSE(end > start && (end - start) / line_size >= 2, ESP_ERR_INVALID_SIZE, TAG, "region smaller than two cache lines");
+    uint32_t line_num = (end - start) / line_size;
+    uint32_t sum = 0;
+
+    //sequential reads of the whole region
+    ESP_RETURN_ON_ERROR(s_invalidate(start, end - start), TAG, "failed to invalidate the cache");
+    uint32_t begin = esp_cpu_get_cycle_count();
+    for (const volatile uint32_t *p = (const uint32_t *)start; p < (const uint32_t *)end; p++) {
+        sum += *p;
+    }
+    uint32_t seq_cycles = esp_cpu_get_cycle_count() - begin;
+
+    //a single word of random cache lines, each of them being invalidated before it is read
+    uint64_t rand_cycles = 0;
+    for (int i = 0; i < RAND_READ_NUM; i++) {
+        uint32_t line = start + (esp_random() % line_num) * line_size;
+        ESP_RETURN_ON_ERROR(s_invalidate(line, line_size), TAG, "failed to invalidate the cache");
+        begin = esp_cpu_get_cycle_count();
+        sum += *(const volatile uint32_t *)line;
+        rand_cycles += esp_cpu_get_cycle_count() - begin;
+    }
+    ESP_LOGD(TAG, "checksum 0x%"PRIx32, sum);
+
+    out_result->seq_read_bandwidth = s_kbps(end - start, seq_cycles);
+    out_result->rand_read_bandwidth = s_kbps((uint64_t)line_size * RAND_READ_NUM, rand_cycles);
+    out_result->rand_read_latency_ns = (uint32_t)(rand_cycles * 1000000000ULL / esp_clk_cpu_freq() / RAND_READ_NUM);
+
+    return ESP_OK;
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -79,6 +79,81 @@ extern "C" {
  */
 esp_err_t esp_cache_msync(void *addr, size_t size, int flags);
 
+/**
+ * @brief Address range of a batched memory sync
+ */
+typedef struct {
+    void *addr;     /*!< Starting address of the range */
+    size_t size;    /*!< Size of the range in bytes */
+} esp_cache_msync_range_t;
+
+/**
+ * @brief Memory sync between Cache and storage memory for several address ranges
+ *
+ * Same as calling `esp_cache_msync` for each range, but the ranges are checked, then sorted, and the overlapping and
+ * adjacent ranges of the same cache are merged, so that each cache line is synced once and the lock is taken once.
+ * This is cheaper than one `esp_cache_msync` per buffer when a transfer uses many small buffers.
+ *
+ * This API is cache-safe and thread-safe
+ *
+ * @note The ranges are rounded to the cache lines, sorted and merged in place: the content of the array is unspecified after the call
+ * @note No range is synced if one of them is invalid
+ *
+ * @param[inout] ranges      Array of the ranges to sync
+ * @param[in]    num_ranges  Number of ranges in the array
+ * @param[in]    flags       Flags, see `ESP_CACHE_MSYNC_FLAG_x`, applied to all the ranges
+ *
+ * @return
+ *        - ESP_OK:                Successful msync
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument, not cache supported addr, see printed logs
+ */
+esp_err_t esp_cache_msync_ranges(esp_cache_msync_range_t *ranges, size_t num_ranges, int flags);
+
+/**
+ * @brief Defer the invalidation of a buffer written by a DMA until the CPU touches it
+ *
+ * A driver receiving data by DMA can call this API instead of `esp_cache_msync` with the M2C direction, e.g. from the
+ * ISR of the transfer. The range is recorded, and is invalidated by `esp_cache_msync_touch` before the CPU reads it.
+ * All the deferred ranges are invalidated in one batch by `esp_cache_msync_flush_deferred`, or when the table of
+ * CONFIG_ESP_MM_CACHE_MSYNC_DEFERRED_SLOTS deferred ranges is full.
+ *
+ * This API is cache-safe and thread-safe
+ *
+ * @note The CPU must not access the buffer until it is touched: call `esp_cache_msync_touch` before reading, writing or freeing it
+ *
+ * @param[in] addr   Starting address of the buffer, aligned to the data cache line size
+ * @param[in] size   Size of the buffer, aligned to the data cache line size
+ *
+ * @return
+ *        - ESP_OK:                Range deferred
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument, not cache supported or not aligned addr, see printed logs
+ */
+esp_err_t esp_cache_msync_defer_invalidate(void *addr, size_t size);
+
+/**
+ * @brief Invalidate the deferred ranges overlapping a buffer, before the CPU accesses it
+ *
+ * This API is cache-safe and thread-safe
+ *
+ * @param[in] addr   Starting address of the buffer
+ * @param[in] size   Size of the buffer
+ *
+ * @return
+ *        - ESP_OK:                Successful, including if no deferred range overlaps the buffer
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument
+ */
+esp_err_t esp_cache_msync_touch(void *addr, size_t size);
+
+/**
+ * @brief Invalidate all the deferred ranges in one batch
+ *
+ * This API is cache-safe and thread-safe
+ *
+ * @return
+ *        - ESP_OK:                Successful msync
+ */
+esp_err_t esp_cache_msync_flush_deferred(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,6 +57,19 @@ extern "C" {
  */
 typedef uint32_t esp_paddr_t;
 
+/**
+ * @brief Usage of the virtual memory regions, see `esp_mmu_map_get_stats`
+ */
+typedef struct {
+    size_t total_size;           ///< Size of the virtual memory that can be dynamically mapped, in bytes
+    size_t mapped_size;          ///< Size of the mapped blocks, in bytes
+    size_t free_size;            ///< Size of the free slots, in bytes
+    size_t largest_free_block;   ///< Largest consecutive free block, in bytes. The largest block that can be mapped
+    size_t mapped_block_num;     ///< Number of mapped blocks
+    size_t free_block_num;       ///< Number of free slots, a high number for a given free size means a fragmented virtual memory
+    size_t mmu_entry_num;        ///< Number of MMU entries used by the mapped blocks
+} esp_mmu_map_stats_t;
+
 /**
  * @brief Map a physical memory block to external virtual address block, with given capabilities.
  *
@@ -112,6 +125,21 @@ esp_err_t esp_mmu_unmap(void *ptr);
  */
 esp_err_t esp_mmu_map_get_max_consecutive_free_block_size(mmu_mem_caps_t caps, mmu_target_t target, size_t *out_len);
 
+/**
+ * @brief Get the usage of the external virtual memory regions with given capabilities and given physical target
+ *
+ * @note This API does not guarantee thread safety
+ *
+ * @param[in] caps       Bitwise OR of MMU_MEM_CAP_* flags indicating the memory block
+ * @param[in] target     Physical memory target you're going to map to, see `mmu_target_t`.
+ * @param[out] out_stats Usage of the regions, summed over all the regions with these capabilities and target
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG: Invalid arguments, could be null pointer
+ */
+esp_err_t esp_mmu_map_get_stats(mmu_mem_caps_t caps, mmu_target_t target, esp_mmu_map_stats_t *out_stats);
+
 /**
  * Dump all the previously mapped blocks
  *
@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Results of `esp_mspi_benchmark_read`
+ */
+typedef struct {
+    uint32_t seq_read_bandwidth;    ///< Sequential read bandwidth, in KB/s
+    uint32_t rand_read_bandwidth;   ///< Bandwidth of the cache line fills from random addresses, in KB/s
+    uint32_t rand_read_latency_ns;  ///< Average time to fill a cache line from a random address, in ns
+} esp_mspi_benchmark_result_t;
+
+/**
+ * @brief Measure the read bandwidth and latency of the external memory (flash or PSRAM) through the cache
+ *
+ * The cache is invalidated before the measurements, so that all the data is read from the external memory by the
+ * MSPI. A PSRAM buffer is written back first, so its content is kept, but it mustn't be written during the
+ * measurements. Call this function from a high priority task: the time taken by interrupts and other tasks lowers
+ * the results.
+ *
+ * Comparing the results with the expected bandwidth of the configured mode and frequency shows whether the
+ * timing tuning, e.g. at another temperature, still provides a margin.
+ *
+ * @note This API does not guarantee thread safety
+ * @note This API is not available on ESP32, which can't invalidate a range of the cache
+ *
+ * @param[in] vaddr       Start of a mapped flash region or of a PSRAM buffer
+ * @param[in] size        Size of the region, at least two cache lines. The region is reduced to whole cache lines.
+ * @param[out] out_result Results of the measurements
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG: Null pointer, or the region isn't cached external memory
+ *        - ESP_ERR_INVALID_SIZE: The region is smaller than two cache lines
+ */
+esp_err_t esp_mspi_benchmark_read(const void *vaddr, size_t size, esp_mspi_benchmark_result_t *out_result);
+
+#ifdef __cplusplus
+}
+#endif
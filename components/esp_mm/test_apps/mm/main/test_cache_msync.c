@@ -215,3 +215,57 @@ TEST_CASE("test cache msync unaligned flag not work with M2C direction", "[cache
 {
     TEST_ASSERT(esp_cache_msync((void *)TEST_SYNC_START, 0x8000, ESP_CACHE_MSYNC_FLAG_UNALIGNED | ESP_CACHE_MSYNC_FLAG_DIR_M2C) == ESP_ERR_INVALID_ARG);
 }
+
+TEST_CASE("test cache msync of several ranges", "[cache]")
+{
+    size_t line_size = 0;
+    TEST_ESP_OK(esp_cache_get_alignment(MALLOC_CAP_SPIRAM, &line_size));
+    uint32_t start = TEST_SYNC_START;
+    esp_cache_msync_range_t ranges[] = {
+        { .addr = (void *)(start + 4 * line_size), .size = 2 * line_size },
+        { .addr = (void *)start, .size = line_size },
+        { .addr = (void *)(start + line_size), .size = 4 * line_size },  // adjacent to the 2nd range, overlapping the 1st one
+        { .addr = (void *)(start + 16 * line_size), .size = line_size },
+    };
+    TEST_ESP_OK(esp_cache_msync_ranges(ranges, 4, ESP_CACHE_MSYNC_FLAG_DIR_C2M));
+    TEST_ESP_OK(esp_cache_msync_ranges(NULL, 0, ESP_CACHE_MSYNC_FLAG_DIR_C2M));
+
+    esp_cache_msync_range_t unaligned[] = {
+        { .addr = (void *)(start + 3), .size = line_size },
+        { .addr = (void *)start, .size = line_size },
+    };
+    TEST_ESP_OK(esp_cache_msync_ranges(unaligned, 2, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED));
+    unaligned[0].addr = (void *)(start + 3);
+    unaligned[0].size = line_size;
+    TEST_ASSERT(esp_cache_msync_ranges(unaligned, 2, ESP_CACHE_MSYNC_FLAG_DIR_M2C) == ESP_ERR_INVALID_ARG);
+}
+
+#if CONFIG_SPIRAM
+TEST_CASE("test cache msync deferred invalidation", "[cache]")
+{
+    size_t line_size = 0;
+    TEST_ESP_OK(esp_cache_get_alignment(MALLOC_CAP_SPIRAM, &line_size));
+    const size_t num_bufs = CONFIG_ESP_MM_CACHE_MSYNC_DEFERRED_SLOTS + 2;
+    uint8_t *bufs = heap_caps_aligned_calloc(line_size, num_bufs, line_size, MALLOC_CAP_SPIRAM);
+    TEST_ASSERT_NOT_NULL(bufs);
+
+    // the data in memory is 0xA5, the cache holds dirty 0x5A data, as if a DMA had written the memory behind the cache
+    memset(bufs, 0xA5, num_bufs * line_size);
+    TEST_ESP_OK(esp_cache_msync(bufs, num_bufs * line_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M));
+    memset(bufs, 0x5A, num_bufs * line_size);
+
+    // more ranges than slots: the first ones are invalidated in a batch when the table is full
+    for (int i = 0; i < num_bufs; i++) {
+        TEST_ESP_OK(esp_cache_msync_defer_invalidate(bufs + i * line_size, line_size));
+    }
+    TEST_ESP_OK(esp_cache_msync_touch(bufs + (num_bufs - 1) * line_size, 1));
+    TEST_ASSERT_EQUAL_HEX8(0xA5, bufs[(num_bufs - 1) * line_size]);
+    TEST_ESP_OK(esp_cache_msync_flush_deferred());
+    for (int i = 0; i < num_bufs; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xA5, bufs[i * line_size]);
+    }
+
+    TEST_ASSERT(esp_cache_msync_defer_invalidate(bufs + 1, line_size) == ESP_ERR_INVALID_ARG);
+    free(bufs);
+}
+#endif  //#if CONFIG_SPIRAM
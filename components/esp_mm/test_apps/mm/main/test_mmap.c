@@ -15,6 +15,7 @@
 #include "esp_partition.h"
 
 #include "esp_mmu_map.h"
+#include "esp_mspi_benchmark.h"
 #include "esp_rom_sys.h"
 
 #define TEST_BLOCK_SIZE    CONFIG_MMU_PAGE_SIZE
@@ -71,6 +72,50 @@ TEST_CASE("Can find paddr caps by any paddr offset", "[mmu]")
     TEST_ESP_OK(esp_mmu_unmap(ptr0));
 }
 
+TEST_CASE("Mapped blocks are placed in the smallest free slot", "[mmu]")
+{
+    const esp_partition_t *part = s_get_partition();
+    esp_mmu_map_stats_t stats_before = {};
+    esp_mmu_map_stats_t stats = {};
+    TEST_ESP_OK(esp_mmu_map_get_stats(MMU_MEM_CAP_READ, MMU_TARGET_FLASH0, &stats_before));
+
+    void *ptr0 = NULL;
+    TEST_ESP_OK(esp_mmu_map(part->address, 2 * TEST_BLOCK_SIZE, MMU_TARGET_FLASH0, MMU_MEM_CAP_READ, 0, &ptr0));
+    void *ptr1 = NULL;
+    TEST_ESP_OK(esp_mmu_map(part->address + 2 * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE, MMU_TARGET_FLASH0, MMU_MEM_CAP_READ, 0, &ptr1));
+    void *ptr2 = NULL;
+    TEST_ESP_OK(esp_mmu_map(part->address + 3 * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE, MMU_TARGET_FLASH0, MMU_MEM_CAP_READ, 0, &ptr2));
+    void *ptr3 = NULL;
+    TEST_ESP_OK(esp_mmu_map(part->address + 4 * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE, MMU_TARGET_FLASH0, MMU_MEM_CAP_READ, 0, &ptr3));
+
+    TEST_ESP_OK(esp_mmu_map_get_stats(MMU_MEM_CAP_READ, MMU_TARGET_FLASH0, &stats));
+    TEST_ASSERT_EQUAL(stats_before.mapped_block_num + 4, stats.mapped_block_num);
+    TEST_ASSERT_EQUAL(stats_before.mapped_size + 5 * TEST_BLOCK_SIZE, stats.mapped_size);
+    TEST_ASSERT_EQUAL(stats_before.mmu_entry_num + 5, stats.mmu_entry_num);
+    TEST_ASSERT_EQUAL(stats.total_size, stats.mapped_size + stats.free_size);
+
+    //free a 2-page slot and a 1-page slot
+    TEST_ESP_OK(esp_mmu_unmap(ptr0));
+    TEST_ESP_OK(esp_mmu_unmap(ptr2));
+
+    //a 1-page block mustn't split the 2-page slot
+    void *ptr4 = NULL;
+    TEST_ESP_OK(esp_mmu_map(part->address + 5 * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE, MMU_TARGET_FLASH0, MMU_MEM_CAP_READ, 0, &ptr4));
+    TEST_ASSERT((uint8_t *)ptr4 < (uint8_t *)ptr0 || (uint8_t *)ptr4 >= (uint8_t *)ptr0 + 2 * TEST_BLOCK_SIZE);
+    void *ptr5 = NULL;
+    TEST_ESP_OK(esp_mmu_map(part->address, 2 * TEST_BLOCK_SIZE, MMU_TARGET_FLASH0, MMU_MEM_CAP_READ, 0, &ptr5));
+
+    esp_mmu_map_dump_mapped_blocks(stdout);
+
+    TEST_ESP_OK(esp_mmu_unmap(ptr1));
+    TEST_ESP_OK(esp_mmu_unmap(ptr3));
+    TEST_ESP_OK(esp_mmu_unmap(ptr4));
+    TEST_ESP_OK(esp_mmu_unmap(ptr5));
+    TEST_ESP_OK(esp_mmu_map_get_stats(MMU_MEM_CAP_READ, MMU_TARGET_FLASH0, &stats));
+    TEST_ASSERT_EQUAL(stats_before.mapped_block_num, stats.mapped_block_num);
+    TEST_ASSERT_EQUAL(stats_before.largest_free_block, stats.largest_free_block);
+}
+
 #if CONFIG_SPIRAM
 #if !CONFIG_IDF_TARGET_ESP32  //ESP32 doesn't support using `esp_mmu_map` to map to PSRAM
 TEST_CASE("Can find paddr when mapping to psram", "[mmu]")
@@ -93,3 +138,22 @@ TEST_CASE("Can find paddr when mapping to psram", "[mmu]")
 }
 #endif  //#if !CONFIG_IDF_TARGET_ESP32
 #endif  //#if CONFIG_SPIRAM
+
+#if !CONFIG_IDF_TARGET_ESP32
+TEST_CASE("Can measure the read bandwidth of the mapped flash", "[mmu]")
+{
+    const esp_partition_t *part = s_get_partition();
+    void *ptr = NULL;
+    TEST_ESP_OK(esp_mmu_map(part->address, 2 * TEST_BLOCK_SIZE, MMU_TARGET_FLASH0, MMU_MEM_CAP_READ | MMU_MEM_CAP_8BIT, 0, &ptr));
+
+    esp_mspi_benchmark_result_t result = {};
+    TEST_ESP_OK(esp_mspi_benchmark_read(ptr, 2 * TEST_BLOCK_SIZE, &result));
+    ESP_LOGI(TAG, "flash: sequential %"PRIu32" KB/s, random %"PRIu32" KB/s, latency %"PRIu32" ns",
+             result.seq_read_bandwidth, result.rand_read_bandwidth, result.rand_read_latency_ns);
+    TEST_ASSERT_NOT_EQUAL(0, result.seq_read_bandwidth);
+    TEST_ASSERT_NOT_EQUAL(0, result.rand_read_latency_ns);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_mspi_benchmark_read(ptr, 4, &result));
+
+    TEST_ESP_OK(esp_mmu_unmap(ptr));
+}
+#endif  //#if !CONFIG_IDF_TARGET_ESP32
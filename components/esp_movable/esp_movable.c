@@ -0,0 +1,312 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/lock.h>
+#include <sys/queue.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_movable.h"
+#if CONFIG_SOC_ASYNC_MEMCPY_SUPPORTED
+#include "esp_async_memcpy.h"
+#endif
+
+static const char *TAG = "esp_movable";
+
+// Buffers are allocated with a size and alignment the DMA of all the chips can copy in both tiers
+#define MOVABLE_ALIGN               64
+#define MOVABLE_CAPS_INTERNAL       (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DMA)
+#define MOVABLE_CAPS_SPIRAM         (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT | MALLOC_CAP_CACHE_ALIGNED)
+
+struct esp_movable_t {
+    void *ptr;
+    size_t size;
+    uint32_t accesses;      // Accesses since the previous rebalances, halved by each rebalance
+    uint16_t locks;
+    uint8_t tier;           // esp_movable_tier_t
+    uint8_t hint;           // esp_movable_hint_t
+    TAILQ_ENTRY(esp_movable_t) next;
+};
+
+static TAILQ_HEAD(, esp_movable_t) s_movables = TAILQ_HEAD_INITIALIZER(s_movables);
+// Protects the list, the buffers' fields and the statistics. It is held during a move, so that the buffer
+// being moved cannot be locked until the move is complete.
+static _lock_t s_lock;
+static esp_movable_stats_t s_stats;
+
+#if CONFIG_SOC_ASYNC_MEMCPY_SUPPORTED
+static async_memcpy_handle_t s_mcp;
+static SemaphoreHandle_t s_copy_done;
+static bool s_mcp_failed;   // Installing async memcpy failed, e.g. no free DMA channel: use the CPU
+
+static bool copy_done_cb(async_memcpy_handle_t mcp_hdl, async_memcpy_event_t *event, void *cb_args)
+{
+    BaseType_t high_task_wakeup = pdFALSE;
+    xSemaphoreGiveFromISR((SemaphoreHandle_t)cb_args, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
+static bool dma_copy(void *dst, void *src, size_t n)
+{
+    if (s_mcp_failed || !(esp_ptr_dma_capable(src) || esp_ptr_dma_ext_capable(src)) ||
+            !(esp_ptr_dma_capable(dst) || esp_ptr_dma_ext_capable(dst))) {
+        return false;
+    }
+    if (s_mcp == NULL) {
+        async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+        s_copy_done = xSemaphoreCreateBinary();
+        if (s_copy_done == NULL || esp_async_memcpy_install(&config, &s_mcp) != ESP_OK) {
+            ESP_LOGW(TAG, "async memcpy not available, buffers are moved by the CPU");
+            if (s_copy_done) {
+                vSemaphoreDelete(s_copy_done);
+                s_copy_done = NULL;
+            }
+            s_mcp = NULL;
+            s_mcp_failed = true;
+            return false;
+        }
+    }
+    // The DMA of some chips cannot access PSRAM or needs a stricter alignment: the error is not fatal
+    if (esp_async_memcpy(s_mcp, dst, src, n, copy_done_cb, s_copy_done) != ESP_OK) {
+        return false;
+    }
+    xSemaphoreTake(s_copy_done, portMAX_DELAY);
+    return true;
+}
+#else
+static bool dma_copy(void *dst, void *src, size_t n)
+{
+    return false;
+}
+#endif // CONFIG_SOC_ASYNC_MEMCPY_SUPPORTED
+
+static void *tier_alloc(size_t size, esp_movable_tier_t tier)
+{
+    if (tier == ESP_MOVABLE_TIER_SPIRAM) {
+        return heap_caps_aligned_alloc(MOVABLE_ALIGN, size, MOVABLE_CAPS_SPIRAM);
+    }
+    return heap_caps_aligned_alloc(MOVABLE_ALIGN, size, MOVABLE_CAPS_INTERNAL);
+}
+
+static void account(esp_movable_handle_t handle, bool add)
+{
+    size_t *bytes = handle->tier == ESP_MOVABLE_TIER_SPIRAM ? &s_stats.spiram_bytes : &s_stats.internal_bytes;
+    if (add) {
+        *bytes += handle->size;
+    } else {
+        *bytes -= handle->size;
+    }
+}
+
+// Called with s_lock held
+static esp_err_t migrate_locked(esp_movable_handle_t handle, esp_movable_tier_t tier)
+{
+    if (handle->tier == tier) {
+        return ESP_OK;
+    }
+    if (handle->locks) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    void *dst = tier_alloc(handle->size, tier);
+    if (dst == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (dma_copy(dst, handle->ptr, handle->size)) {
+        s_stats.dma_migrations++;
+    } else {
+        memcpy(dst, handle->ptr, handle->size);
+    }
+    heap_caps_free(handle->ptr);
+    account(handle, false);
+    handle->ptr = dst;
+    handle->tier = tier;
+    account(handle, true);
+    s_stats.migrations++;
+    return ESP_OK;
+}
+
+esp_err_t esp_movable_alloc(size_t size, esp_movable_tier_t tier, esp_movable_handle_t *ret)
+{
+    ESP_RETURN_ON_FALSE(size && ret, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(tier == ESP_MOVABLE_TIER_INTERNAL || tier == ESP_MOVABLE_TIER_SPIRAM, ESP_ERR_INVALID_ARG, TAG, "invalid tier");
+    ESP_RETURN_ON_FALSE(size <= SIZE_MAX - MOVABLE_ALIGN, ESP_ERR_NO_MEM, TAG, "size too large");
+
+    esp_movable_handle_t handle = calloc(1, sizeof(struct esp_movable_t));
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_NO_MEM, TAG, "no mem for handle");
+    handle->size = (size + MOVABLE_ALIGN - 1) & ~(MOVABLE_ALIGN - 1);
+    handle->hint = ESP_MOVABLE_HINT_AUTO;
+    handle->tier = tier;
+    handle->ptr = tier_alloc(handle->size, tier);
+    if (handle->ptr == NULL) {
+        handle->tier = tier == ESP_MOVABLE_TIER_SPIRAM ? ESP_MOVABLE_TIER_INTERNAL : ESP_MOVABLE_TIER_SPIRAM;
+        handle->ptr = tier_alloc(handle->size, handle->tier);
+    }
+    if (handle->ptr == NULL) {
+        free(handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    _lock_acquire(&s_lock);
+    TAILQ_INSERT_TAIL(&s_movables, handle, next);
+    s_stats.buffers++;
+    account(handle, true);
+    _lock_release(&s_lock);
+    *ret = handle;
+    return ESP_OK;
+}
+
+void esp_movable_free(esp_movable_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    _lock_acquire(&s_lock);
+    assert(handle->locks == 0 && "freeing a locked movable buffer");
+    TAILQ_REMOVE(&s_movables, handle, next);
+    s_stats.buffers--;
+    account(handle, false);
+    _lock_release(&s_lock);
+    heap_caps_free(handle->ptr);
+    free(handle);
+}
+
+void *esp_movable_lock(esp_movable_handle_t handle)
+{
+    assert(handle);
+    _lock_acquire(&s_lock);
+    assert(handle->locks < UINT16_MAX);
+    handle->locks++;
+    if (handle->accesses < UINT32_MAX) {
+        handle->accesses++;
+    }
+    void *ptr = handle->ptr;
+    _lock_release(&s_lock);
+    return ptr;
+}
+
+void esp_movable_unlock(esp_movable_handle_t handle)
+{
+    assert(handle);
+    _lock_acquire(&s_lock);
+    assert(handle->locks > 0 && "unlocking a movable buffer not locked");
+    handle->locks--;
+    _lock_release(&s_lock);
+}
+
+esp_movable_tier_t esp_movable_get_tier(esp_movable_handle_t handle)
+{
+    assert(handle);
+    _lock_acquire(&s_lock);
+    esp_movable_tier_t tier = handle->tier;
+    _lock_release(&s_lock);
+    return tier;
+}
+
+esp_err_t esp_movable_set_hint(esp_movable_handle_t handle, esp_movable_hint_t hint)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(hint <= ESP_MOVABLE_HINT_COLD, ESP_ERR_INVALID_ARG, TAG, "invalid hint");
+    esp_err_t ret = ESP_OK;
+    _lock_acquire(&s_lock);
+    handle->hint = hint;
+    if (hint != ESP_MOVABLE_HINT_AUTO) {
+        ret = migrate_locked(handle, hint == ESP_MOVABLE_HINT_HOT ? ESP_MOVABLE_TIER_INTERNAL : ESP_MOVABLE_TIER_SPIRAM);
+    }
+    _lock_release(&s_lock);
+    return ret;
+}
+
+esp_err_t esp_movable_migrate(esp_movable_handle_t handle, esp_movable_tier_t tier)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(tier == ESP_MOVABLE_TIER_INTERNAL || tier == ESP_MOVABLE_TIER_SPIRAM, ESP_ERR_INVALID_ARG, TAG, "invalid tier");
+    _lock_acquire(&s_lock);
+    esp_err_t ret = migrate_locked(handle, tier);
+    _lock_release(&s_lock);
+    return ret;
+}
+
+static int compare_accesses(const void *a, const void *b)
+{
+    uint32_t accesses_a = (*(const esp_movable_handle_t *)a)->accesses;
+    uint32_t accesses_b = (*(const esp_movable_handle_t *)b)->accesses;
+    // Most accessed first
+    return (accesses_a < accesses_b) - (accesses_a > accesses_b);
+}
+
+esp_err_t esp_movable_rebalance(size_t internal_budget, size_t *moved)
+{
+    size_t count = 0;
+    size_t moves = 0;
+    esp_err_t ret = ESP_OK;
+
+    _lock_acquire(&s_lock);
+    esp_movable_handle_t handle;
+    TAILQ_FOREACH(handle, &s_movables, next) {
+        count++;
+    }
+    esp_movable_handle_t *ranked = count ? malloc(count * sizeof(esp_movable_handle_t)) : NULL;
+    ESP_GOTO_ON_FALSE(ranked || count == 0, ESP_ERR_NO_MEM, out, TAG, "no mem to rank %zu buffers", count);
+
+    // Apply the hints that could not be applied when they were set, and rank the others
+    size_t n = 0;
+    TAILQ_FOREACH(handle, &s_movables, next) {
+        if (handle->hint == ESP_MOVABLE_HINT_AUTO) {
+            ranked[n++] = handle;
+        } else {
+            esp_movable_tier_t tier = handle->hint == ESP_MOVABLE_HINT_HOT ? ESP_MOVABLE_TIER_INTERNAL : ESP_MOVABLE_TIER_SPIRAM;
+            if (handle->tier != tier && migrate_locked(handle, tier) == ESP_OK) {
+                moves++;
+            }
+        }
+    }
+    qsort(ranked, n, sizeof(esp_movable_handle_t), compare_accesses);
+
+    // The hottest buffers fitting in the budget stay in, or move to, internal RAM
+    size_t hot = 0;
+    size_t used = 0;
+    while (hot < n && used + ranked[hot]->size <= internal_budget) {
+        used += ranked[hot]->size;
+        hot++;
+    }
+    // Evict the cold buffers first, so that their internal RAM is free for the hot ones
+    for (size_t i = hot; i < n; i++) {
+        if (ranked[i]->tier == ESP_MOVABLE_TIER_INTERNAL && migrate_locked(ranked[i], ESP_MOVABLE_TIER_SPIRAM) == ESP_OK) {
+            moves++;
+        }
+    }
+    for (size_t i = 0; i < hot; i++) {
+        if (ranked[i]->tier == ESP_MOVABLE_TIER_SPIRAM && migrate_locked(ranked[i], ESP_MOVABLE_TIER_INTERNAL) == ESP_OK) {
+            moves++;
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        ranked[i]->accesses /= 2;
+    }
+    free(ranked);
+out:
+    _lock_release(&s_lock);
+    if (moved) {
+        *moved = moves;
+    }
+    return ret;
+}
+
+esp_err_t esp_movable_get_stats(esp_movable_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    _lock_acquire(&s_lock);
+    *stats = s_stats;
+    _lock_release(&s_lock);
+    return ESP_OK;
+}
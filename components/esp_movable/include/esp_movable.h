@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Handle of a movable buffer
+ */
+typedef struct esp_movable_t *esp_movable_handle_t;
+
+/**
+ * @brief Memory tier of a movable buffer
+ */
+typedef enum {
+    ESP_MOVABLE_TIER_INTERNAL,  /*!< Internal RAM, fast */
+    ESP_MOVABLE_TIER_SPIRAM,    /*!< External PSRAM, large but slower */
+} esp_movable_tier_t;
+
+/**
+ * @brief Placement hint of a movable buffer
+ */
+typedef enum {
+    ESP_MOVABLE_HINT_AUTO,      /*!< The buffer is placed by esp_movable_rebalance() according to its accesses */
+    ESP_MOVABLE_HINT_HOT,       /*!< The buffer is kept in internal RAM, it is not moved by esp_movable_rebalance() */
+    ESP_MOVABLE_HINT_COLD,      /*!< The buffer is kept in PSRAM, it is not moved by esp_movable_rebalance() */
+} esp_movable_hint_t;
+
+/**
+ * @brief Statistics of the movable buffers
+ */
+typedef struct {
+    size_t buffers;             /*!< Number of movable buffers allocated */
+    size_t internal_bytes;      /*!< Bytes of the buffers in internal RAM */
+    size_t spiram_bytes;        /*!< Bytes of the buffers in PSRAM */
+    uint32_t migrations;        /*!< Number of buffers moved since boot */
+    uint32_t dma_migrations;    /*!< Number of the moves copied by async memcpy rather than by the CPU */
+} esp_movable_stats_t;
+
+/**
+ * @brief Allocate a movable buffer
+ *
+ * The buffer is not accessed through a fixed pointer, but through esp_movable_lock(), so that it can be moved
+ * between internal RAM and PSRAM while it is not locked.
+ *
+ * @param[in]  size  Size of the buffer in bytes
+ * @param[in]  tier  Tier to allocate the buffer from first. If it has not enough memory, or if the chip has no PSRAM,
+ *                   the buffer is allocated from the other tier.
+ * @param[out] ret   Handle of the buffer
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_NO_MEM if there is not enough memory in both tiers
+ */
+esp_err_t esp_movable_alloc(size_t size, esp_movable_tier_t tier, esp_movable_handle_t *ret);
+
+/**
+ * @brief Free a movable buffer
+ *
+ * The buffer must not be locked.
+ *
+ * @param handle Handle of the buffer, NULL is ignored
+ */
+void esp_movable_free(esp_movable_handle_t handle);
+
+/**
+ * @brief Lock a movable buffer and get its address
+ *
+ * The buffer is not moved until esp_movable_unlock() is called as many times as it was locked. Each lock counts as
+ * an access for esp_movable_rebalance(). If the buffer is being moved, this waits for the end of the move.
+ *
+ * @note Must not be called from an ISR.
+ *
+ * @param handle Handle of the buffer
+ *
+ * @return Address of the buffer, valid until it is unlocked
+ */
+void *esp_movable_lock(esp_movable_handle_t handle);
+
+/**
+ * @brief Unlock a movable buffer
+ *
+ * @param handle Handle of the buffer, locked by esp_movable_lock()
+ */
+void esp_movable_unlock(esp_movable_handle_t handle);
+
+/**
+ * @brief Get the tier a movable buffer is currently in
+ *
+ * @param handle Handle of the buffer
+ *
+ * @return Tier of the buffer
+ */
+esp_movable_tier_t esp_movable_get_tier(esp_movable_handle_t handle);
+
+/**
+ * @brief Set the placement hint of a movable buffer
+ *
+ * The hints ESP_MOVABLE_HINT_HOT and ESP_MOVABLE_HINT_COLD move the buffer to its tier at once, if it is not locked
+ * and there is enough memory in the tier.
+ *
+ * @param handle Handle of the buffer
+ * @param hint   Placement hint
+ *
+ * @return
+ *      - ESP_OK on success, the buffer is in the tier of the hint
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the buffer is locked, the hint is recorded and applied by the next rebalance
+ *      - ESP_ERR_NO_MEM if there is not enough memory in the tier, the hint is recorded and applied by the next
+ *        rebalance
+ */
+esp_err_t esp_movable_set_hint(esp_movable_handle_t handle, esp_movable_hint_t hint);
+
+/**
+ * @brief Move a movable buffer to a tier
+ *
+ * The data is copied by async memcpy (see :doc:`/api-reference/system/async_memcpy`) when the chip can copy between
+ * the tiers by DMA, otherwise by the CPU. The calling task blocks until the move is complete.
+ *
+ * @param handle Handle of the buffer
+ * @param tier   Tier to move the buffer to
+ *
+ * @return
+ *      - ESP_OK on success, including if the buffer was already in the tier
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the buffer is locked
+ *      - ESP_ERR_NO_MEM if there is not enough memory in the tier
+ */
+esp_err_t esp_movable_migrate(esp_movable_handle_t handle, esp_movable_tier_t tier);
+
+/**
+ * @brief Place the movable buffers according to their accesses
+ *
+ * The buffers with the ESP_MOVABLE_HINT_AUTO hint are ranked by their accesses since the previous rebalances,
+ * the most accessed are moved to internal RAM up to internal_budget bytes, the others to PSRAM. The access counts
+ * are then halved, so that the ranking follows the recent accesses. Locked buffers are not moved.
+ *
+ * Call this function periodically, e.g. from a low priority task.
+ *
+ * @param[in]  internal_budget Bytes of internal RAM the automatically placed buffers may use
+ * @param[out] moved           Number of buffers moved, can be NULL
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if there is not enough memory to rank the buffers
+ */
+esp_err_t esp_movable_rebalance(size_t internal_budget, size_t *moved);
+
+/**
+ * @brief Get the statistics of the movable buffers
+ *
+ * @param[out] stats Statistics
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ */
+esp_err_t esp_movable_get_stats(esp_movable_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_memory_utils.h"
+#include "esp_movable.h"
+
+#define TEST_BUF_SIZE 1000
+
+static void fill(esp_movable_handle_t handle, uint8_t seed)
+{
+    uint8_t *p = esp_movable_lock(handle);
+    for (int i = 0; i < TEST_BUF_SIZE; i++) {
+        p[i] = (uint8_t)(seed + i);
+    }
+    esp_movable_unlock(handle);
+}
+
+static void check(esp_movable_handle_t handle, uint8_t seed)
+{
+    uint8_t *p = esp_movable_lock(handle);
+    for (int i = 0; i < TEST_BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_HEX8((uint8_t)(seed + i), p[i]);
+    }
+    esp_movable_unlock(handle);
+}
+
+TEST_CASE("movable buffer keeps its data when moved", "[movable]")
+{
+    esp_movable_handle_t handle;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_movable_alloc(0, ESP_MOVABLE_TIER_INTERNAL, &handle));
+    TEST_ESP_OK(esp_movable_alloc(TEST_BUF_SIZE, ESP_MOVABLE_TIER_INTERNAL, &handle));
+    TEST_ASSERT_EQUAL(ESP_MOVABLE_TIER_INTERNAL, esp_movable_get_tier(handle));
+    TEST_ASSERT_TRUE(esp_ptr_internal(esp_movable_lock(handle)));
+    esp_movable_unlock(handle);
+    fill(handle, 0x5a);
+
+#if CONFIG_SPIRAM
+    TEST_ESP_OK(esp_movable_migrate(handle, ESP_MOVABLE_TIER_SPIRAM));
+    TEST_ASSERT_EQUAL(ESP_MOVABLE_TIER_SPIRAM, esp_movable_get_tier(handle));
+    TEST_ASSERT_TRUE(esp_ptr_external_ram(esp_movable_lock(handle)));
+    esp_movable_unlock(handle);
+    check(handle, 0x5a);
+    TEST_ESP_OK(esp_movable_migrate(handle, ESP_MOVABLE_TIER_INTERNAL));
+#else
+    // without PSRAM, the buffer cannot leave internal RAM
+    TEST_ESP_ERR(ESP_ERR_NO_MEM, esp_movable_migrate(handle, ESP_MOVABLE_TIER_SPIRAM));
+#endif
+    TEST_ASSERT_EQUAL(ESP_MOVABLE_TIER_INTERNAL, esp_movable_get_tier(handle));
+    check(handle, 0x5a);
+    esp_movable_free(handle);
+}
+
+TEST_CASE("locked movable buffer is not moved", "[movable]")
+{
+    esp_movable_handle_t handle;
+    TEST_ESP_OK(esp_movable_alloc(TEST_BUF_SIZE, ESP_MOVABLE_TIER_INTERNAL, &handle));
+    void *p = esp_movable_lock(handle);
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_movable_migrate(handle, ESP_MOVABLE_TIER_SPIRAM));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_movable_set_hint(handle, ESP_MOVABLE_HINT_COLD));
+    size_t moved;
+    TEST_ESP_OK(esp_movable_rebalance(0, &moved));
+    TEST_ASSERT_EQUAL(0, moved);
+    TEST_ASSERT_EQUAL_PTR(p, esp_movable_lock(handle));
+    esp_movable_unlock(handle);
+    esp_movable_unlock(handle);
+    esp_movable_free(handle);
+}
+
+TEST_CASE("movable buffer statistics", "[movable]")
+{
+    esp_movable_stats_t before, stats;
+    TEST_ESP_OK(esp_movable_get_stats(&before));
+    esp_movable_handle_t handle;
+    // the size is rounded up to the DMA alignment
+    TEST_ESP_OK(esp_movable_alloc(100, ESP_MOVABLE_TIER_INTERNAL, &handle));
+    TEST_ESP_OK(esp_movable_get_stats(&stats));
+    TEST_ASSERT_EQUAL(before.buffers + 1, stats.buffers);
+    TEST_ASSERT_EQUAL(before.internal_bytes + 128, stats.internal_bytes);
+    esp_movable_free(handle);
+    TEST_ESP_OK(esp_movable_get_stats(&stats));
+    TEST_ASSERT_EQUAL(before.buffers, stats.buffers);
+    TEST_ASSERT_EQUAL(before.internal_bytes, stats.internal_bytes);
+}
+
+#if CONFIG_SPIRAM
+TEST_CASE("rebalance moves the most accessed buffers to internal RAM", "[movable]")
+{
+    esp_movable_handle_t hot, cold, pinned;
+    TEST_ESP_OK(esp_movable_alloc(TEST_BUF_SIZE, ESP_MOVABLE_TIER_SPIRAM, &hot));
+    TEST_ESP_OK(esp_movable_alloc(TEST_BUF_SIZE, ESP_MOVABLE_TIER_INTERNAL, &cold));
+    TEST_ESP_OK(esp_movable_alloc(TEST_BUF_SIZE, ESP_MOVABLE_TIER_SPIRAM, &pinned));
+    TEST_ESP_OK(esp_movable_set_hint(pinned, ESP_MOVABLE_HINT_COLD));
+    fill(hot, 1);
+    fill(cold, 2);
+    for (int i = 0; i < 10; i++) {
+        esp_movable_lock(hot);
+        esp_movable_unlock(hot);
+        esp_movable_lock(pinned);
+        esp_movable_unlock(pinned);
+    }
+
+    // the budget fits only one buffer: the hot one takes the place of the cold one
+    size_t moved;
+    TEST_ESP_OK(esp_movable_rebalance(TEST_BUF_SIZE + 64, &moved));
+    TEST_ASSERT_EQUAL(2, moved);
+    TEST_ASSERT_EQUAL(ESP_MOVABLE_TIER_INTERNAL, esp_movable_get_tier(hot));
+    TEST_ASSERT_EQUAL(ESP_MOVABLE_TIER_SPIRAM, esp_movable_get_tier(cold));
+    TEST_ASSERT_EQUAL(ESP_MOVABLE_TIER_SPIRAM, esp_movable_get_tier(pinned));
+    check(hot, 1);
+    check(cold, 2);
+
+    // a stable placement is not changed
+    TEST_ESP_OK(esp_movable_rebalance(TEST_BUF_SIZE + 64, &moved));
+    TEST_ASSERT_EQUAL(0, moved);
+
+    TEST_ESP_OK(esp_movable_set_hint(cold, ESP_MOVABLE_HINT_HOT));
+    TEST_ASSERT_EQUAL(ESP_MOVABLE_TIER_INTERNAL, esp_movable_get_tier(cold));
+    check(cold, 2);
+
+    esp_movable_free(hot);
+    esp_movable_free(cold);
+    esp_movable_free(pinned);
+}
+#endif // CONFIG_SPIRAM
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+#include "esp_movable.h"
+
+#define TEST_MEMORY_LEAK_THRESHOLD (-300)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    // Add a short delay of 100ms to allow the idle task to free the memory of the deleted setup tasks
+    vTaskDelay(pdMS_TO_TICKS(100));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    // The first move installs async memcpy, which is never uninstalled: do it before the leak checks
+    esp_movable_handle_t handle;
+    ESP_ERROR_CHECK(esp_movable_alloc(64, ESP_MOVABLE_TIER_SPIRAM, &handle));
+    esp_movable_migrate(handle, ESP_MOVABLE_TIER_INTERNAL);
+    esp_movable_migrate(handle, ESP_MOVABLE_TIER_SPIRAM);
+    esp_movable_free(handle);
+
+    unity_run_menu();
+}
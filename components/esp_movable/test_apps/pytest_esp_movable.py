@@ -0,0 +1,19 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+import pytest
+from pytest_embedded import Dut
+from pytest_embedded_idf.utils import idf_parametrize
+
+
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['default'], indirect=True)
+@idf_parametrize('target', ['esp32', 'esp32c3', 'esp32s3'], indirect=['target'])
+def test_esp_movable(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
+
+
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['psram'], indirect=True)
+@idf_parametrize('target', ['esp32', 'esp32s3'], indirect=['target'])
+def test_esp_movable_psram(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
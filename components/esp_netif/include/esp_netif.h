@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -439,6 +439,9 @@ esp_err_t esp_netif_get_hostname(esp_netif_t *esp_netif, const char **hostname);
 /**
  * @brief  Test if supplied interface is up or down
  *
+ * The state is read from a copy updated by the TCP/IP stack on each change, without locking the stack,
+ * so this function can be called frequently from any task.
+ *
  * @param[in]  esp_netif Handle to esp-netif instance
  *
  * @return
@@ -450,8 +453,9 @@ bool esp_netif_is_netif_up(esp_netif_t *esp_netif);
 /**
  * @brief  Get interface's IP address information
  *
- * If the interface is up, IP information is read directly from the TCP/IP stack.
- * If the interface is down, IP information is read from a copy kept in the ESP-NETIF instance
+ * If the interface is up, IP information is the one of the TCP/IP stack.
+ * If the interface is down, IP information is the copy kept in the ESP-NETIF instance.
+ * In both cases, it is read from a copy updated on each change, without locking the TCP/IP stack.
  *
  * @param[in]  esp_netif Handle to esp-netif instance
  * @param[out]  ip_info If successful, IP information will be returned in this argument.
@@ -244,6 +244,7 @@ struct esp_netif_driver_ifconfig {
     esp_err_t (*transmit)(void *h, void *buffer, size_t len); /*!< transmit function pointer */
     esp_err_t (*transmit_wrap)(void *h, void *buffer, size_t len, void *netstack_buffer); /*!< transmit wrap function pointer */
     void (*driver_free_rx_buffer)(void *h, void* buffer); /*!< free rx buffer function pointer */
+    bool tx_checksum_offload;         /*!< driver inserts the IPv4 header and TCP checksums of transmitted frames and drops received frames with wrong checksums */
 };
 
 typedef struct esp_netif_driver_ifconfig esp_netif_driver_ifconfig_t;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <stdalign.h>
+#include <stddef.h>
+#include <time.h>
 #include "esp_err.h"
 
 
@@ -38,6 +40,8 @@ typedef enum {
     L2TAP_S_DEVICE_DRV_HNDL,    /*!< Bound the file descriptor to a specific Network Interface identified by IO Driver handle. */
     L2TAP_G_DEVICE_DRV_HNDL,    /*!< Get the Network Interface IO Driver handle the file descriptor is bound to. */
     L2TAP_S_TIMESTAMP_EN,       /*!< Enables the hardware Time Stamping (TS) processing by the file descriptor. TS needs to be supported by hardware and enabled in the IO driver. */
+    L2TAP_G_RX_FRAMES,          /*!< Get received frames in place, without copy, into `l2tap_rx_frames_t`. The frames need to be freed by ``L2TAP_S_RX_FRAMES_FREE``. */
+    L2TAP_S_RX_FRAMES_FREE,     /*!< Free the frames got by ``L2TAP_G_RX_FRAMES``, passed in `l2tap_rx_frames_t`. */
 } l2tap_ioctl_opt_t;
 
 /**
@@ -76,6 +80,25 @@ typedef struct {
 } l2tap_extended_buff_t;
 
 
+/**
+ * @brief Received frame accessed in place
+ *
+ */
+typedef struct {
+    void *buff;                 /*!< Received frame, in the receive buffer of the IO driver */
+    size_t len;                 /*!< Length of the frame */
+    struct timespec ts;         /*!< Time stamp of the frame, only valid when ``L2TAP_S_TIMESTAMP_EN`` is set */
+} l2tap_rx_frame_t;
+
+/**
+ * @brief Batch of received frames accessed in place
+ *
+ */
+typedef struct {
+    size_t num;                 /*!< Number of frames, the capacity of `frames` as input of ``L2TAP_G_RX_FRAMES``, the number of frames got as its output */
+    l2tap_rx_frame_t *frames;   /*!< Frames */
+} l2tap_rx_frames_t;
+
 /**
  * @brief Macros for operations with Information Records
  *
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -50,9 +50,14 @@
 #include "netif/dhcp_state.h"
 #include "esp_event.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
 #if IP_NAPT
 #include "lwip/lwip_napt.h"
 #endif
+#include "netif/esp_netif_flow_cache.h"
+#if CONFIG_ESP_METRICS_SYSTEM
+#include "esp_metrics.h"
+#endif
 
 
 //
@@ -63,6 +68,20 @@
 
 #define DHCP_CB_CHANGE (LWIP_NSC_IPV4_SETTINGS_CHANGED | LWIP_NSC_IPV4_ADDRESS_CHANGED | LWIP_NSC_IPV4_GATEWAY_CHANGED | LWIP_NSC_IPV4_NETMASK_CHANGED)
 
+#if CONFIG_ESP_METRICS_SYSTEM
+ESP_METRICS_COUNTER_DEFINE(s_rx_packets_metric, "esp_netif_rx_packets_total", "Packets passed from the drivers to lwIP");
+ESP_METRICS_COUNTER_DEFINE(s_rx_bytes_metric, "esp_netif_rx_bytes_total", "Bytes passed from the drivers to lwIP");
+ESP_METRICS_COUNTER_DEFINE(s_tx_packets_metric, "esp_netif_tx_packets_total", "Packets passed from lwIP to the drivers");
+ESP_METRICS_COUNTER_DEFINE(s_tx_bytes_metric, "esp_netif_tx_bytes_total", "Bytes passed from lwIP to the drivers");
+
+#define METRICS_COUNT_PACKET(dir, len) do { \
+        esp_metrics_counter_inc(&s_##dir##_packets_metric); \
+        esp_metrics_counter_add(&s_##dir##_bytes_metric, len); \
+    } while (0)
+#else
+#define METRICS_COUNT_PACKET(dir, len)
+#endif
+
 /**
  * @brief lwip thread safe tcpip function utility macros
  */
@@ -125,6 +144,7 @@ static u8_t lwip_netif_client_id = 0xff;
 static esp_netif_t *s_last_default_esp_netif = NULL;
 static bool s_is_last_default_esp_netif_overridden = false;
 static netif_ext_callback_t netif_callback = { .callback_fn = NULL, .next = NULL };
+static portMUX_TYPE s_snapshot_lock = portMUX_INITIALIZER_UNLOCKED;
 
 #if LWIP_IPV4
 static void esp_netif_internal_dhcpc_cb(struct netif *netif);
@@ -136,6 +156,25 @@ static void netif_unset_mldv6_flag(esp_netif_t *netif);
 #endif /* LWIP_IPV6 */
 
 static esp_err_t esp_netif_destroy_api(esp_netif_api_msg_t *msg);
+static void esp_netif_update_snapshot(esp_netif_t *esp_netif);
+
+static inline esp_netif_t* lwip_get_esp_netif(struct netif *netif)
+{
+#if LWIP_ESP_NETIF_DATA
+    return (esp_netif_t*)netif_get_client_data(netif, lwip_netif_client_id);
+#else
+    return (esp_netif_t*)netif->state;
+#endif
+}
+
+static inline void lwip_set_esp_netif(struct netif *netif, esp_netif_t* esp_netif)
+{
+#if LWIP_ESP_NETIF_DATA
+    netif_set_client_data(netif, lwip_netif_client_id, esp_netif);
+#else
+    netif->state = esp_netif;
+#endif
+}
 
 static void netif_callback_fn(struct netif* netif, netif_nsc_reason_t reason, const netif_ext_callback_args_t* args)
 {
@@ -154,6 +193,11 @@ static void netif_callback_fn(struct netif* netif, netif_nsc_reason_t reason, co
         }
     }
 #endif /* #if LWIP_IPV6 */
+    // netif status, link and address changes are all reported here, after the handlers above updated the ip_info
+    esp_netif_t *esp_netif = lwip_get_esp_netif(netif);
+    if (esp_netif != NULL) {
+        esp_netif_update_snapshot(esp_netif);
+    }
 }
 
 #ifdef CONFIG_LWIP_GARP_TMR_INTERVAL
@@ -395,24 +439,6 @@ esp_netif_t *esp_netif_get_default_netif(void)
     return s_last_default_esp_netif;
 }
 
-static inline esp_netif_t* lwip_get_esp_netif(struct netif *netif)
-{
-#if LWIP_ESP_NETIF_DATA
-    return (esp_netif_t*)netif_get_client_data(netif, lwip_netif_client_id);
-#else
-    return (esp_netif_t*)netif->state;
-#endif
-}
-
-static inline void lwip_set_esp_netif(struct netif *netif, esp_netif_t* esp_netif)
-{
-#if LWIP_ESP_NETIF_DATA
-    netif_set_client_data(netif, lwip_netif_client_id, esp_netif);
-#else
-    netif->state = esp_netif;
-#endif
-}
-
 #if CONFIG_ESP_NETIF_BRIDGE_EN
 esp_err_t esp_netif_bridge_add_port(esp_netif_t *esp_netif_br, esp_netif_t *esp_netif_port)
 {
@@ -796,6 +822,7 @@ static esp_err_t esp_netif_new_api(esp_netif_api_msg_t *msg)
         return ESP_FAIL;
     }
     lwip_set_esp_netif(lwip_netif, esp_netif);
+    esp_netif_update_snapshot(esp_netif);
 
     if (netif_callback.callback_fn == NULL ) {
         netif_add_ext_callback(&netif_callback, netif_callback_fn);
@@ -856,6 +883,7 @@ esp_netif_t *esp_netif_find_if(esp_netif_find_predicate_t fn, void *ctx)
 static void esp_netif_lwip_remove(esp_netif_t *esp_netif)
 {
     if (esp_netif->lwip_netif) {
+        esp_netif_flow_cache_flush();
         if (netif_is_up(esp_netif->lwip_netif)) {
             netif_set_down(esp_netif->lwip_netif);
         }
@@ -931,6 +959,13 @@ static esp_err_t esp_netif_lwip_add(esp_netif_t *esp_netif)
 #if CONFIG_ESP_NETIF_BRIDGE_EN
     }
 #endif // CONFIG_ESP_NETIF_BRIDGE_EN
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    if (esp_netif->driver_tx_checksum_offload) {
+        // IPv4 header and TCP checksums are inserted by the driver, UDP and ICMP ones are not (because of IP fragments)
+        // received checksums are verified by the driver and also need not be checked for frames looped back on this netif
+        NETIF_SET_CHECKSUM_CTRL(esp_netif->lwip_netif, NETIF_CHECKSUM_GEN_UDP | NETIF_CHECKSUM_GEN_ICMP | NETIF_CHECKSUM_GEN_ICMP6);
+    }
+#endif
     lwip_set_esp_netif(esp_netif->lwip_netif, esp_netif);
     return ESP_OK;
 }
@@ -1001,6 +1036,7 @@ esp_err_t esp_netif_set_driver_config(esp_netif_t *esp_netif,
     esp_netif->driver_transmit = driver_config->transmit;
     esp_netif->driver_transmit_wrap = driver_config->transmit_wrap;
     esp_netif->driver_free_rx_buffer = driver_config->driver_free_rx_buffer;
+    esp_netif->driver_tx_checksum_offload = driver_config->tx_checksum_offload;
     return ESP_OK;
 }
 
@@ -1010,6 +1046,7 @@ static esp_err_t esp_netif_reset_ip_info(esp_netif_t *esp_netif)
     ip4_addr_set_zero(&(esp_netif->ip_info->ip));
     ip4_addr_set_zero(&(esp_netif->ip_info->gw));
     ip4_addr_set_zero(&(esp_netif->ip_info->netmask));
+    esp_netif_update_snapshot(esp_netif);
     return ESP_OK;
 }
 #endif
@@ -1299,6 +1336,7 @@ esp_err_t esp_netif_transmit(esp_netif_t *esp_netif, void* data, size_t len)
         esp_event_post(IP_EVENT, IP_EVENT_TX_RX, &evt, sizeof(evt), 0);
     }
 #endif
+    METRICS_COUNT_PACKET(tx, len);
     return (esp_netif->driver_transmit)(esp_netif->driver_handle, data, len);
 }
 
@@ -1314,6 +1352,7 @@ esp_err_t esp_netif_transmit_wrap(esp_netif_t *esp_netif, void *data, size_t len
         esp_event_post(IP_EVENT, IP_EVENT_TX_RX, &evt, sizeof(evt), 0);
     }
 #endif
+    METRICS_COUNT_PACKET(tx, len);
     return (esp_netif->driver_transmit_wrap)(esp_netif->driver_handle, data, len, pbuf);
 }
 
@@ -1329,6 +1368,7 @@ esp_err_t esp_netif_receive(esp_netif_t *esp_netif, void *buffer, size_t len, vo
         esp_event_post(IP_EVENT, IP_EVENT_TX_RX, &evt, sizeof(evt), 0);
     }
 #endif
+    METRICS_COUNT_PACKET(rx, len);
 #ifdef CONFIG_ESP_NETIF_RECEIVE_REPORT_ERRORS
     return esp_netif->lwip_input_fn(esp_netif->netif_handle, buffer, len, eb);
 #else
@@ -1428,6 +1468,7 @@ static void esp_netif_ip_lost_timer(void *arg)
         ESP_LOGD(TAG, "if%p ip lost tmr: raise ip lost event", esp_netif);
         memset(esp_netif->ip_info_old, 0, sizeof(esp_netif_ip_info_t));
         memset(esp_netif->ip_info, 0, sizeof(esp_netif_ip_info_t));
+        esp_netif_update_snapshot(esp_netif);
         if (esp_netif->lost_ip_event) {
             ret = esp_event_post(IP_EVENT, esp_netif->lost_ip_event,
                                           &evt, sizeof(evt), 0);
@@ -1793,6 +1834,7 @@ static esp_err_t esp_netif_down_api(esp_netif_api_msg_t *msg)
 #endif
     netif_set_down(lwip_netif);
     netif_set_link_down(lwip_netif);
+    esp_netif_flow_cache_flush();
 
     if (esp_netif->flags & ESP_NETIF_DHCP_CLIENT) {
 #if CONFIG_LWIP_IPV4
@@ -1807,20 +1849,65 @@ static esp_err_t esp_netif_down_api(esp_netif_api_msg_t *msg)
 
 esp_err_t esp_netif_down(esp_netif_t *esp_netif) _RUN_IN_LWIP_TASK(esp_netif_down_api, esp_netif, NULL)
 
-bool esp_netif_is_netif_up(esp_netif_t *esp_netif)
+static void esp_netif_update_snapshot(esp_netif_t *esp_netif)
 {
-    ESP_LOGV(TAG, "%s esp_netif:%p", __func__, esp_netif);
+    struct netif *p_netif = esp_netif->lwip_netif;
+    esp_netif_snapshot_t *snapshot = &esp_netif->snapshot;
+    bool is_up = false;
 
-    if (esp_netif != NULL && esp_netif->lwip_netif != NULL) {
+    if (p_netif != NULL) {
         if (_IS_NETIF_ANY_POINT2POINT_TYPE(esp_netif)) {
             // ppp implementation uses netif_set_link_up/down to update link state
-            return netif_is_link_up(esp_netif->lwip_netif);
+            is_up = netif_is_link_up(p_netif);
+        } else {
+            // esp-netif handlers and drivers take care to set_netif_up/down on link state update
+            is_up = netif_is_up(p_netif);
         }
-        // esp-netif handlers and drivers take care to set_netif_up/down on link state update
-        return netif_is_up(esp_netif->lwip_netif);
-    } else {
+    }
+
+    // The writers are serialized by the lwIP context, the critical section only keeps a reader
+    // preempting the writer on the same core from spinning until the copy is complete
+    portENTER_CRITICAL_SAFE(&s_snapshot_lock);
+    __atomic_store_n(&snapshot->seq, snapshot->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    snapshot->is_up = is_up;
+#if CONFIG_LWIP_IPV4
+    if (p_netif != NULL && netif_is_up(p_netif)) {
+        ip4_addr_set(&snapshot->ip_info.ip, ip_2_ip4(&p_netif->ip_addr));
+        ip4_addr_set(&snapshot->ip_info.netmask, ip_2_ip4(&p_netif->netmask));
+        ip4_addr_set(&snapshot->ip_info.gw, ip_2_ip4(&p_netif->gw));
+    } else if (esp_netif->ip_info != NULL) {
+        memcpy(&snapshot->ip_info, esp_netif->ip_info, sizeof(esp_netif_ip_info_t));
+    }
+#endif
+    __atomic_store_n(&snapshot->seq, snapshot->seq + 1, __ATOMIC_RELEASE);
+    portEXIT_CRITICAL_SAFE(&s_snapshot_lock);
+}
+
+static void esp_netif_read_snapshot(esp_netif_t *esp_netif, esp_netif_snapshot_t *copy)
+{
+    const esp_netif_snapshot_t *snapshot = &esp_netif->snapshot;
+    uint32_t seq;
+
+    do {
+        seq = __atomic_load_n(&snapshot->seq, __ATOMIC_ACQUIRE);
+        copy->is_up = snapshot->is_up;
+        memcpy(&copy->ip_info, &snapshot->ip_info, sizeof(esp_netif_ip_info_t));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1U) || __atomic_load_n(&snapshot->seq, __ATOMIC_RELAXED) != seq);
+}
+
+bool esp_netif_is_netif_up(esp_netif_t *esp_netif)
+{
+    ESP_LOGV(TAG, "%s esp_netif:%p", __func__, esp_netif);
+
+    if (esp_netif == NULL) {
         return false;
     }
+
+    esp_netif_snapshot_t copy;
+    esp_netif_read_snapshot(esp_netif, &copy);
+    return copy.is_up;
 }
 
 #if CONFIG_LWIP_IPV4
@@ -1843,17 +1930,10 @@ esp_err_t esp_netif_get_ip_info(esp_netif_t *esp_netif, esp_netif_ip_info_t *ip_
         return ESP_ERR_INVALID_ARG;
     }
 
-    struct netif *p_netif = esp_netif->lwip_netif;
-
-    if (p_netif != NULL && netif_is_up(p_netif)) {
-        ip4_addr_set(&ip_info->ip, ip_2_ip4(&p_netif->ip_addr));
-        ip4_addr_set(&ip_info->netmask, ip_2_ip4(&p_netif->netmask));
-        ip4_addr_set(&ip_info->gw, ip_2_ip4(&p_netif->gw));
-
-        return ESP_OK;
-    }
-
-    memcpy(ip_info, esp_netif->ip_info, sizeof(esp_netif_ip_info_t));
+    // addresses of the lwIP netif while it is up, the esp-netif ones otherwise
+    esp_netif_snapshot_t copy;
+    esp_netif_read_snapshot(esp_netif, &copy);
+    memcpy(ip_info, &copy.ip_info, sizeof(esp_netif_ip_info_t));
 
     return ESP_OK;
 }
@@ -1912,6 +1992,7 @@ static esp_err_t esp_netif_set_ip_info_api(esp_netif_api_msg_t *msg)
     ip4_addr_copy(esp_netif->ip_info->ip, ip_info->ip);
     ip4_addr_copy(esp_netif->ip_info->gw, ip_info->gw);
     ip4_addr_copy(esp_netif->ip_info->netmask, ip_info->netmask);
+    esp_netif_update_snapshot(esp_netif);
 
     struct netif *p_netif = esp_netif->lwip_netif;
 
@@ -2607,6 +2688,8 @@ static esp_err_t esp_netif_napt_control_api(esp_netif_api_msg_t *msg)
     if (!netif_is_up(esp_netif->lwip_netif)) {
         return ESP_FAIL;
     }
+    /* the cached flows rely on the NAPT table */
+    esp_netif_flow_cache_flush();
 
     if (enable) {
         /* Disable napt on all other interface */
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -66,6 +66,18 @@ typedef struct netif_related_data {
     enum netif_types netif_type;
 } netif_related_data_t;
 
+/**
+ * @brief Copy of the netif state returned by esp_netif_is_netif_up() and esp_netif_get_ip_info()
+ *
+ * Written from the lwIP context whenever the state changes, read without locking the TCP/IP stack:
+ * seq is odd while the copy is being written and changes each time it is written (seqlock).
+ */
+typedef struct esp_netif_snapshot_s {
+    uint32_t seq;
+    bool is_up;
+    esp_netif_ip_info_t ip_info;
+} esp_netif_snapshot_t;
+
 /**
  * @brief Main esp-netif container with interface related information
  */
@@ -75,6 +87,9 @@ struct esp_netif_obj {
     esp_netif_ip_info_t* ip_info;
     esp_netif_ip_info_t* ip_info_old;
 
+    // state readable without locking the TCP/IP stack
+    esp_netif_snapshot_t snapshot;
+
     // lwip netif related
     struct netif *lwip_netif;
     err_t (*lwip_init_fn)(struct netif*);
@@ -89,6 +104,7 @@ struct esp_netif_obj {
     esp_err_t (*driver_transmit)(void *h, void *buffer, size_t len);
     esp_err_t (*driver_transmit_wrap)(void *h, void *buffer, size_t len, void *pbuf);
     void (*driver_free_rx_buffer)(void *h, void* buffer);
+    bool driver_tx_checksum_offload;
 
     // dhcp related
     esp_netif_dhcp_status_t dhcpc_status;
@@ -0,0 +1,274 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * @file esp_netif NAPT flow cache
+ * This file forwards the frames of known TCP and UDP flows between interfaces
+ * directly from the RX context of the drivers, without going through tcpip_thread,
+ * ip4_forward() and the NAPT table.
+ *
+ * A flow is learned from a frame forwarded by lwIP: the drivers record the headers of
+ * the frames they pass to lwIP, and the link output function compares them to the headers
+ * of the frame leaving the egress interface. The difference (addresses, ports, next hop)
+ * is then applied to the next frames of the flow.
+ *
+ * A flow is only forwarded for CONFIG_ESP_NETIF_NAPT_FLOW_CACHE_REFRESH_MS after it has been
+ * learned. The next frame goes through lwIP again, which keeps the NAPT and ARP entries alive
+ * and learns the flow again. TCP segments with SYN, FIN or RST always go through lwIP,
+ * so that NAPT tracks the state of the connections.
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "lwip/sys.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/prot/ethernet.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/tcp.h"
+#include "lwip/prot/udp.h"
+#include "esp_netif_flow_cache.h"
+#include "sdkconfig.h"
+
+#define FLOW_CACHE_SIZE     CONFIG_ESP_NETIF_NAPT_FLOW_CACHE_SIZE
+#define FLOW_REFRESH_MS     CONFIG_ESP_NETIF_NAPT_FLOW_CACHE_REFRESH_MS
+#define FLOW_PENDING_NUM    16      /* frames passed to lwIP whose headers are kept to learn their flow */
+
+/* addresses and ports are kept in network byte order, as in the headers */
+typedef struct {
+    u32_t src;
+    u32_t dst;
+    u16_t sport;
+    u16_t dport;
+    u8_t proto;
+} flow_key_t;
+
+typedef struct {
+    struct netif *in;       /* ingress interface, NULL if the entry is free */
+    struct netif *out;      /* egress interface */
+    u32_t expiry;           /* sys_now() after which the next frame is passed to lwIP */
+    flow_key_t key;         /* headers of the received frames */
+    flow_key_t rewrite;     /* headers of the forwarded frames */
+    u8_t eth_addrs[2 * ETH_HWADDR_LEN];   /* destination and source MAC addresses of the forwarded frames */
+    u32_t chksum_delta;     /* change of the TCP/UDP checksum caused by the rewrite */
+} flow_t;
+
+typedef struct {
+    struct pbuf *p;         /* frame passed to lwIP, NULL if the entry is free */
+    struct netif *in;
+    flow_key_t key;
+    u16_t id;
+    u8_t ttl;
+} flow_pending_t;
+
+static flow_t s_flows[FLOW_CACHE_SIZE];
+static flow_pending_t s_pending[FLOW_PENDING_NUM];
+static size_t s_pending_next;
+static portMUX_TYPE s_flow_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static inline struct ip_hdr *flow_ip_hdr(struct pbuf *p)
+{
+    return (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+}
+
+static inline void *flow_l4_hdr(struct pbuf *p)
+{
+    return (u8_t *)p->payload + SIZEOF_ETH_HDR + IP_HLEN;
+}
+
+/**
+ * @brief Get the flow of a frame, if it can be forwarded by the cache
+ *
+ * Only unfragmented IPv4 TCP and UDP packets without IP options are handled.
+ */
+static bool flow_parse(struct pbuf *p, flow_key_t *key, u8_t *tcp_flags)
+{
+    if (p->next != NULL || p->len < SIZEOF_ETH_HDR + IP_HLEN + UDP_HLEN) {
+        return false;
+    }
+    struct eth_hdr *ethhdr = (struct eth_hdr *)p->payload;
+    struct ip_hdr *iphdr = flow_ip_hdr(p);
+    if (ethhdr->type != PP_HTONS(ETHTYPE_IP) || IPH_V(iphdr) != 4 || IPH_HL_BYTES(iphdr) != IP_HLEN ||
+            (IPH_OFFSET(iphdr) & PP_HTONS(IP_OFFMASK | IP_MF)) != 0 ||
+            lwip_ntohs(IPH_LEN(iphdr)) > p->len - SIZEOF_ETH_HDR) {
+        return false;
+    }
+    key->proto = IPH_PROTO(iphdr);
+    key->src = iphdr->src.addr;
+    key->dst = iphdr->dest.addr;
+    if (key->proto == IP_PROTO_TCP) {
+        if (lwip_ntohs(IPH_LEN(iphdr)) < IP_HLEN + TCP_HLEN) {
+            return false;
+        }
+        struct tcp_hdr *tcphdr = flow_l4_hdr(p);
+        key->sport = tcphdr->src;
+        key->dport = tcphdr->dest;
+        *tcp_flags = TCPH_FLAGS(tcphdr);
+    } else if (key->proto == IP_PROTO_UDP) {
+        struct udp_hdr *udphdr = flow_l4_hdr(p);
+        key->sport = udphdr->src;
+        key->dport = udphdr->dest;
+        *tcp_flags = 0;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static inline bool flow_key_equal(const flow_key_t *a, const flow_key_t *b)
+{
+    return a->src == b->src && a->dst == b->dst && a->sport == b->sport && a->dport == b->dport && a->proto == b->proto;
+}
+
+static inline flow_t *flow_slot(const flow_key_t *key)
+{
+    u32_t hash = (key->src ^ key->dst ^ ((u32_t)key->sport << 16 | key->dport) ^ key->proto) * 2654435761u;
+    return &s_flows[(hash >> 8) % FLOW_CACHE_SIZE];
+}
+
+/* sum of the 16-bit words of the headers, as in the checksums: the byte order does not matter (RFC 1071) */
+static u32_t flow_chksum_delta(const flow_key_t *from, const flow_key_t *to)
+{
+    u32_t delta = 0;
+    delta += (u16_t)~(from->src >> 16) + (u16_t)~from->src + (to->src >> 16) + (u16_t)to->src;
+    delta += (u16_t)~(from->dst >> 16) + (u16_t)~from->dst + (to->dst >> 16) + (u16_t)to->dst;
+    delta += (u16_t)~from->sport + to->sport;
+    delta += (u16_t)~from->dport + to->dport;
+    return delta;
+}
+
+/* incremental checksum update, RFC 1624 eqn. 3 */
+static inline u16_t flow_chksum_adjust(u16_t chksum, u32_t delta)
+{
+    u32_t sum = (u16_t)~chksum + delta;
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (u16_t)~sum;
+}
+
+static void flow_rewrite(struct pbuf *p, const flow_t *flow)
+{
+    struct ip_hdr *iphdr = flow_ip_hdr(p);
+
+    memcpy(p->payload, flow->eth_addrs, sizeof(flow->eth_addrs));
+    iphdr->src.addr = flow->rewrite.src;
+    iphdr->dest.addr = flow->rewrite.dst;
+    IPH_TTL_SET(iphdr, IPH_TTL(iphdr) - 1);
+    IPH_CHKSUM_SET(iphdr, 0);
+    IPH_CHKSUM_SET(iphdr, inet_chksum(iphdr, IP_HLEN));
+    if (flow->key.proto == IP_PROTO_TCP) {
+        struct tcp_hdr *tcphdr = flow_l4_hdr(p);
+        tcphdr->src = flow->rewrite.sport;
+        tcphdr->dest = flow->rewrite.dport;
+        tcphdr->chksum = flow_chksum_adjust(tcphdr->chksum, flow->chksum_delta);
+    } else {
+        struct udp_hdr *udphdr = flow_l4_hdr(p);
+        udphdr->src = flow->rewrite.sport;
+        udphdr->dest = flow->rewrite.dport;
+        /* a zero UDP checksum means that the sender did not compute it */
+        if (udphdr->chksum != 0) {
+            u16_t chksum = flow_chksum_adjust(udphdr->chksum, flow->chksum_delta);
+            udphdr->chksum = chksum == 0 ? 0xffff : chksum;
+        }
+    }
+}
+
+bool esp_netif_flow_cache_input(struct pbuf *p, struct netif *netif)
+{
+    flow_key_t key;
+    u8_t tcp_flags;
+    flow_t flow;
+    bool hit = false;
+
+    if (!flow_parse(p, &key, &tcp_flags) ||
+            memcmp(((struct eth_hdr *)p->payload)->dest.addr, netif->hwaddr, ETH_HWADDR_LEN) != 0) {
+        return false;
+    }
+    struct ip_hdr *iphdr = flow_ip_hdr(p);
+    bool control = (tcp_flags & (TCP_SYN | TCP_FIN | TCP_RST)) != 0;
+    u32_t now = sys_now();
+
+    portENTER_CRITICAL(&s_flow_lock);
+    flow_t *slot = flow_slot(&key);
+    if (slot->in == netif && flow_key_equal(&slot->key, &key)) {
+        if (control) {
+            slot->in = NULL;
+        } else if ((s32_t)(slot->expiry - now) > 0) {
+            flow = *slot;
+            hit = true;
+        }
+    }
+    if (!hit && !control) {
+        flow_pending_t *pending = &s_pending[s_pending_next];
+        s_pending_next = (s_pending_next + 1) % FLOW_PENDING_NUM;
+        pending->p = p;
+        pending->in = netif;
+        pending->key = key;
+        pending->id = IPH_ID(iphdr);
+        pending->ttl = IPH_TTL(iphdr);
+    }
+    portEXIT_CRITICAL(&s_flow_lock);
+
+    if (!hit) {
+        return false;
+    }
+    /* expired TTL (ICMP error), frames larger than the egress MTU (fragmentation) are left to lwIP */
+    if (IPH_TTL(iphdr) <= 1 || lwip_ntohs(IPH_LEN(iphdr)) > flow.out->mtu ||
+            !netif_is_up(flow.out) || !netif_is_link_up(flow.out)) {
+        return false;
+    }
+    flow_rewrite(p, &flow);
+    flow.out->linkoutput(flow.out, p);
+    pbuf_free(p);
+    return true;
+}
+
+void esp_netif_flow_cache_learn(struct pbuf *p, struct netif *netif)
+{
+    flow_key_t rewrite;
+    u8_t tcp_flags;
+    flow_t flow = { 0 };
+    bool found = false;
+
+    if (!flow_parse(p, &rewrite, &tcp_flags) || (tcp_flags & (TCP_SYN | TCP_FIN | TCP_RST)) != 0) {
+        return;
+    }
+    struct ip_hdr *iphdr = flow_ip_hdr(p);
+
+    portENTER_CRITICAL(&s_flow_lock);
+    for (size_t i = 0; i < FLOW_PENDING_NUM; i++) {
+        flow_pending_t *pending = &s_pending[i];
+        /* the pbuf may have been reused since it was recorded, check that this is the same packet, forwarded */
+        if (pending->p == p && pending->key.proto == rewrite.proto && pending->id == IPH_ID(iphdr) &&
+                pending->ttl == IPH_TTL(iphdr) + 1) {
+            flow.in = pending->in;
+            flow.key = pending->key;
+            pending->p = NULL;
+            found = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_flow_lock);
+    if (!found) {
+        return;
+    }
+
+    flow.out = netif;
+    flow.expiry = sys_now() + FLOW_REFRESH_MS;
+    flow.rewrite = rewrite;
+    memcpy(flow.eth_addrs, p->payload, sizeof(flow.eth_addrs));
+    flow.chksum_delta = flow_chksum_delta(&flow.key, &rewrite);
+
+    portENTER_CRITICAL(&s_flow_lock);
+    *flow_slot(&flow.key) = flow;
+    portEXIT_CRITICAL(&s_flow_lock);
+}
+
+void esp_netif_flow_cache_flush(void)
+{
+    portENTER_CRITICAL(&s_flow_lock);
+    memset(s_flows, 0, sizeof(s_flows));
+    memset(s_pending, 0, sizeof(s_pending));
+    portEXIT_CRITICAL(&s_flow_lock);
+}
@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include "lwip/pbuf.h"
+#include "lwip/netif.h"
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_NETIF_NAPT_FLOW_CACHE
+
+/**
+ * @brief Forward a received frame of a known flow without the TCP/IP stack
+ *
+ * Called from the RX context of the driver. If the frame belongs to a forwarded TCP or UDP
+ * flow learned by esp_netif_flow_cache_learn(), its headers are rewritten as lwIP (IP forwarding
+ * and NAPT) rewrote the previous frames of the flow, and it is sent to the egress interface at once.
+ *
+ * @param p Received frame, a single pbuf starting with the Ethernet header
+ * @param netif Interface which received the frame
+ * @return true if the frame has been forwarded (the pbuf has been freed),
+ *         false if it has to be passed to lwIP
+ */
+bool esp_netif_flow_cache_input(struct pbuf *p, struct netif *netif);
+
+/**
+ * @brief Learn the flow of a frame forwarded by lwIP
+ *
+ * Called from the link output function of the interfaces, in tcpip_thread. If the frame is one
+ * of those recently passed to lwIP by the drivers, the rewrite lwIP applied to it is cached for
+ * the next frames of its flow.
+ *
+ * @param p Frame to send, starting with the Ethernet header
+ * @param netif Egress interface
+ */
+void esp_netif_flow_cache_learn(struct pbuf *p, struct netif *netif);
+
+/**
+ * @brief Forget all the cached flows, e.g. when an interface goes down or NAPT is disabled
+ */
+void esp_netif_flow_cache_flush(void);
+
+#else
+
+#define esp_netif_flow_cache_input(p, netif) false
+#define esp_netif_flow_cache_learn(p, netif)
+#define esp_netif_flow_cache_flush()
+
+#endif // CONFIG_ESP_NETIF_NAPT_FLOW_CACHE
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * @file esp_netif RX batch
+ * This file queues the frames received by the Wi-Fi and Ethernet drivers,
+ * so that tcpip_thread processes several of them per wakeup
+ */
+
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "lwip/tcpip.h"
+#include "lwip/ip.h"
+#include "netif/ethernet.h"
+#include "esp_netif_rx_batch.h"
+#include "sdkconfig.h"
+
+#define RX_BATCH_SIZE CONFIG_ESP_NETIF_RX_BATCH_SIZE
+
+typedef struct {
+    struct pbuf *p;
+    u8_t if_idx;    /* index of the netif, which is looked up again in tcpip_thread in case it has been removed */
+} rx_batch_entry_t;
+
+static rx_batch_entry_t s_rx_queue[RX_BATCH_SIZE];
+static size_t s_rx_head;         /* first queued frame, only moved by tcpip_thread */
+static size_t s_rx_count;        /* number of queued frames */
+static bool s_rx_scheduled;      /* rx_batch_process() is posted to or running in tcpip_thread */
+static portMUX_TYPE s_rx_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void rx_batch_input_one(rx_batch_entry_t *entry)
+{
+    struct pbuf *p = entry->p;
+    struct netif *netif = netif_get_by_index(entry->if_idx);
+    err_t err;
+
+    if (netif == NULL) {
+        pbuf_free(p);
+        return;
+    }
+    /* same input function as tcpip_input() would have chosen */
+#if LWIP_ETHERNET
+    if (netif->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)) {
+        err = ethernet_input(p, netif);
+    } else
+#endif /* LWIP_ETHERNET */
+    {
+        err = ip_input(p, netif);
+    }
+    if (err != ERR_OK) {
+        pbuf_free(p);
+    }
+}
+
+/**
+ * @brief Process the queued frames, runs in tcpip_thread
+ *
+ * Only the frames queued when the function starts are processed, so that the other messages
+ * of tcpip_thread (timers, socket API calls) are not delayed indefinitely under a constant RX load.
+ * If more frames have been queued in the meantime, the function posts itself again.
+ */
+static void rx_batch_process(void *ctx)
+{
+    bool pending;
+
+    do {
+        portENTER_CRITICAL(&s_rx_lock);
+        size_t count = s_rx_count;
+        portEXIT_CRITICAL(&s_rx_lock);
+
+        /* the drivers only write to the free entries, so the queued ones can be read without the lock */
+        for (size_t i = 0; i < count; i++) {
+            rx_batch_input_one(&s_rx_queue[(s_rx_head + i) % RX_BATCH_SIZE]);
+        }
+
+        portENTER_CRITICAL(&s_rx_lock);
+        s_rx_head = (s_rx_head + count) % RX_BATCH_SIZE;
+        s_rx_count -= count;
+        pending = s_rx_count > 0;
+        s_rx_scheduled = pending;
+        portEXIT_CRITICAL(&s_rx_lock);
+        /* if the mailbox is full, there is no way to post again, carry on with the next batch right away */
+    } while (pending && tcpip_try_callback(rx_batch_process, NULL) != ERR_OK);
+}
+
+err_t esp_netif_rx_batch_input(struct pbuf *p, struct netif *netif)
+{
+    bool schedule = false;
+
+    if (netif->input != tcpip_input) {
+        return netif->input(p, netif);
+    }
+
+    portENTER_CRITICAL(&s_rx_lock);
+    if (s_rx_count == RX_BATCH_SIZE) {
+        portEXIT_CRITICAL(&s_rx_lock);
+        return ERR_MEM;
+    }
+    rx_batch_entry_t *entry = &s_rx_queue[(s_rx_head + s_rx_count) % RX_BATCH_SIZE];
+    entry->p = p;
+    entry->if_idx = netif_get_index(netif);
+    s_rx_count++;
+    if (!s_rx_scheduled) {
+        s_rx_scheduled = true;
+        schedule = true;
+    }
+    portEXIT_CRITICAL(&s_rx_lock);
+
+    if (schedule && tcpip_try_callback(rx_batch_process, NULL) != ERR_OK) {
+        /* tcpip_thread mailbox is full: the frame stays queued, and the next received frame wakes tcpip_thread up */
+        portENTER_CRITICAL(&s_rx_lock);
+        s_rx_scheduled = false;
+        portEXIT_CRITICAL(&s_rx_lock);
+    }
+    return ERR_OK;
+}
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include "lwip/pbuf.h"
+#include "lwip/netif.h"
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_NETIF_RX_BATCH
+
+/**
+ * @brief Pass a received frame to lwIP through the RX batch queue
+ *
+ * The frame is appended to a queue shared by all interfaces, and tcpip_thread is woken up only
+ * when the queue goes from empty to non-empty. tcpip_thread then processes all the queued
+ * frames on each wakeup, instead of receiving one message per frame as with tcpip_input().
+ *
+ * @param p Received frame, a single pbuf
+ * @param netif Interface which received the frame
+ * @return ERR_OK if the frame has been queued (the pbuf is owned by lwIP from now on),
+ *         ERR_MEM if the queue is full (the pbuf has to be freed by the caller)
+ */
+err_t esp_netif_rx_batch_input(struct pbuf *p, struct netif *netif);
+
+/**
+ * @brief Input function used by the Wi-Fi and Ethernet interfaces for the received frames
+ */
+#define ESP_NETIF_RX_INPUT(p, netif) esp_netif_rx_batch_input(p, netif)
+
+#else
+
+#define ESP_NETIF_RX_INPUT(p, netif) (netif)->input(p, netif)
+
+#endif // CONFIG_ESP_NETIF_RX_BATCH
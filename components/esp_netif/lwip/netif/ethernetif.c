@@ -3,7 +3,7 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
- * SPDX-FileContributor: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2015-2025 Espressif Systems (Shanghai) CO LTD
  */
 /**
  * @file
@@ -23,6 +23,8 @@
 #include "esp_netif_net_stack.h"
 #include "lwip/esp_netif_net_stack.h"
 #include "lwip/esp_pbuf_ref.h"
+#include "esp_netif_rx_batch.h"
+#include "esp_netif_flow_cache.h"
 
 /* Define those to better describe your network interface. */
 #define IFNAME0 'e'
@@ -79,6 +81,7 @@ static err_t ethernet_low_level_output(struct netif *netif, struct pbuf *p)
         LWIP_DEBUGF(NETIF_DEBUG, ("corresponding esp-netif is NULL: netif=%p pbuf=%p len=%d\n", netif, p, p->len));
         return ERR_IF;
     }
+    esp_netif_flow_cache_learn(p, netif);
 
     if (q->next == NULL) {
         ret = esp_netif_transmit(esp_netif, q->payload, q->len);
@@ -135,8 +138,11 @@ esp_netif_recv_ret_t ethernetif_input(void *h, void *buffer, size_t len, void *l
         esp_netif_free_rx_buffer(esp_netif, buffer);
         return ESP_NETIF_OPTIONAL_RETURN_CODE(ESP_ERR_NO_MEM);
     }
+    if (esp_netif_flow_cache_input(p, netif)) {
+        return ESP_NETIF_OPTIONAL_RETURN_CODE(ESP_OK);
+    }
     /* full packet send to tcpip_thread to process */
-    if (unlikely(netif->input(p, netif) != ERR_OK)) {
+    if (unlikely(ESP_NETIF_RX_INPUT(p, netif) != ERR_OK)) {
         LWIP_DEBUGF(NETIF_DEBUG, ("ethernetif_input: IP input error\n"));
         pbuf_free(p);
         return ESP_NETIF_OPTIONAL_RETURN_CODE(ESP_FAIL);
@@ -3,7 +3,7 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
- * SPDX-FileContributor: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2015-2025 Espressif Systems (Shanghai) CO LTD
  */
 /**
  * @file
@@ -25,6 +25,8 @@
 #include "esp_compiler.h"
 #include "lwip/esp_pbuf_ref.h"
 #include "esp_netif_types.h"
+#include "esp_netif_rx_batch.h"
+#include "esp_netif_flow_cache.h"
 
 /**
  * In this function, the hardware should be initialized.
@@ -62,6 +64,34 @@ low_level_init(struct netif *netif)
 
 }
 
+/**
+ * Find the only pbuf holding data in a chain
+ *
+ * The WiFi driver takes a single contiguous buffer, which it references until
+ * it is sent, so a chain has to be copied, unless all but one of its pbufs are
+ * empty (e.g. a header pbuf left empty by the stack).
+ *
+ * @param p the chain to send
+ * @return the pbuf holding all the data of the chain, or NULL if the data is
+ *         spread over several pbufs
+ */
+static struct pbuf *single_data_pbuf(struct pbuf *p)
+{
+    struct pbuf *data = NULL;
+    for (struct pbuf *q = p; q != NULL; q = q->next) {
+        if (q->len != 0) {
+            if (data != NULL) {
+                return NULL;
+            }
+            data = q;
+        }
+        if (q->len == q->tot_len) {
+            break;
+        }
+    }
+    return data;
+}
+
 /**
  * This function should do the actual transmission of the packet. The packet is
  * contained in the pbuf that is passed to the function. This pbuf
@@ -83,16 +113,20 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
     if (esp_netif == NULL) {
         return ERR_IF;
     }
+    esp_netif_flow_cache_learn(p, netif);
 
     struct pbuf *q = p;
     esp_err_t netif_ret = ESP_FAIL;
     err_t ret = ERR_IF;
 
-    if(q->next == NULL) {
+    if (q->next != NULL) {
+        q = single_data_pbuf(p);
+    }
+    if (q != NULL) {
         netif_ret = esp_netif_transmit_wrap(esp_netif, q->payload, q->len, q);
 
     } else {
-        LWIP_DEBUGF(PBUF_DEBUG, ("low_level_output: pbuf is a list, application may has bug"));
+        LWIP_DEBUGF(PBUF_DEBUG, ("low_level_output: pbuf is a list, copied to a single pbuf"));
         q = pbuf_alloc(PBUF_RAW_TX, p->tot_len, PBUF_RAM);
         if (q != NULL) {
             pbuf_copy(q, p);
@@ -173,8 +207,11 @@ esp_netif_recv_ret_t wlanif_input(void *h, void *buffer, size_t len, void* l2_bu
 
 #endif
 
+    if (esp_netif_flow_cache_input(p, netif)) {
+        return ESP_NETIF_OPTIONAL_RETURN_CODE(ESP_OK);
+    }
     /* full packet send to tcpip_thread to process */
-    if (unlikely(netif->input(p, netif) != ERR_OK)) {
+    if (unlikely(ESP_NETIF_RX_INPUT(p, netif) != ERR_OK)) {
         LWIP_DEBUGF(NETIF_DEBUG, ("wlanif_input: IP input error\n"));
         pbuf_free(p);
         return ESP_NETIF_OPTIONAL_RETURN_CODE(ESP_FAIL);
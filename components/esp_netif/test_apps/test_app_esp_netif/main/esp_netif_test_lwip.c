@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -504,6 +504,42 @@ TEST(esp_netif, route_priority)
     }
 }
 
+TEST(esp_netif, state_follows_netif_changes)
+{
+    test_case_uses_tcpip();
+    esp_netif_driver_ifconfig_t driver_config = { .handle =  (void*)1, .transmit = dummy_transmit };
+    esp_netif_inherent_config_t base_netif_config = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+    base_netif_config.if_key = "state";
+    esp_netif_config_t cfg = {  .base = &base_netif_config,
+            .stack = ESP_NETIF_NETSTACK_DEFAULT_WIFI_STA,
+            .driver = &driver_config };
+    esp_netif_t *esp_netif = esp_netif_new(&cfg);
+    TEST_ASSERT_NOT_NULL(esp_netif);
+    TEST_ASSERT_FALSE(esp_netif_is_netif_up(esp_netif));
+
+    // the static address is reported while the netif is down
+    esp_netif_ip_info_t ip_info = {};
+    esp_netif_ip_info_t read_ip_info;
+    esp_netif_set_ip4_addr(&ip_info.ip, 192, 168, 4, 2);
+    esp_netif_set_ip4_addr(&ip_info.netmask, 255, 255, 255, 0);
+    esp_netif_set_ip4_addr(&ip_info.gw, 192, 168, 4, 1);
+    TEST_ESP_OK(esp_netif_dhcpc_stop(esp_netif));
+    TEST_ESP_OK(esp_netif_set_ip_info(esp_netif, &ip_info));
+    TEST_ESP_OK(esp_netif_get_ip_info(esp_netif, &read_ip_info));
+    TEST_ASSERT_EQUAL_MEMORY(&ip_info, &read_ip_info, sizeof(ip_info));
+
+    // ...and once the lwIP netif is up with this address
+    esp_netif_action_start(esp_netif, 0, 0, 0);
+    esp_netif_action_connected(esp_netif, 0, 0, 0);
+    TEST_ASSERT_TRUE(esp_netif_is_netif_up(esp_netif));
+    TEST_ESP_OK(esp_netif_get_ip_info(esp_netif, &read_ip_info));
+    TEST_ASSERT_EQUAL_MEMORY(&ip_info, &read_ip_info, sizeof(ip_info));
+
+    esp_netif_action_stop(esp_netif, 0, 0, 0);
+    TEST_ASSERT_FALSE(esp_netif_is_netif_up(esp_netif));
+    esp_netif_destroy(esp_netif);
+}
+
 // to probe DNS server info directly in LWIP
 const ip_addr_t * dns_getserver(u8_t numdns);
 
@@ -609,6 +645,7 @@ TEST_GROUP_RUNNER(esp_netif)
     RUN_TEST_CASE(esp_netif, dhcp_server_state_transitions_mesh)
 #endif
     RUN_TEST_CASE(esp_netif, route_priority)
+    RUN_TEST_CASE(esp_netif, state_follows_netif_changes)
     RUN_TEST_CASE(esp_netif, set_get_dnsserver)
 }
 
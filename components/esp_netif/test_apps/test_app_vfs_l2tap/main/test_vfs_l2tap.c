@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -664,6 +664,64 @@ TEST_CASE("esp32 l2tap - blocking read", "[ethernet]")
     ethernet_deinit(&eth_network_hndls);
 }
 
+/* ============================================================================= */
+/**
+ * @brief Verifies frames got in place
+ *
+ */
+TEST_CASE("esp32 l2tap - ioctl - RX_FRAMES", "[ethernet]")
+{
+    test_vfs_eth_network_t eth_network_hndls;
+    int eth_tap_fd;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_vfs_l2tap_intf_register(NULL));
+    ethernet_init(&eth_network_hndls);
+
+    eth_tap_fd = open("/dev/net/tap", 0);
+    TEST_ASSERT_NOT_EQUAL(-1, eth_tap_fd);
+    TEST_ASSERT_NOT_EQUAL(-1, ioctl(eth_tap_fd, L2TAP_S_INTF_DEVICE, "ETH_DEF"));
+    uint16_t eth_type_filter = ETH_FILTER_LE;
+    TEST_ASSERT_NOT_EQUAL(-1, ioctl(eth_tap_fd, L2TAP_S_RCV_FILTER, &eth_type_filter));
+
+    l2tap_rx_frame_t frames[4];
+    l2tap_rx_frames_t rx_frames = {
+        .num = 0,
+        .frames = frames,
+    };
+    // zero capacity is invalid
+    TEST_ASSERT_EQUAL(-1, ioctl(eth_tap_fd, L2TAP_G_RX_FRAMES, &rx_frames));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+
+    // non-blocking get with empty queue
+    TEST_ASSERT_EQUAL(0, fcntl(eth_tap_fd, F_SETFL, O_NONBLOCK));
+    rx_frames.num = sizeof(frames) / sizeof(frames[0]);
+    TEST_ASSERT_EQUAL(-1, ioctl(eth_tap_fd, L2TAP_G_RX_FRAMES, &rx_frames));
+    TEST_ASSERT_EQUAL(EAGAIN, errno);
+    TEST_ASSERT_EQUAL(0, rx_frames.num);
+    TEST_ASSERT_EQUAL(0, fcntl(eth_tap_fd, F_SETFL, 0));
+
+    send_task_control_t send_task_ctrl = {
+        .eth_network_hndls_p = &eth_network_hndls,
+        .eth_type = -1,
+        .send_delay_ms = DEFAULT_SEND_DELAY_MS,
+    };
+    xTaskCreate(send_task, "raw_eth_send_task", 1024, &send_task_ctrl, tskIDLE_PRIORITY + 2, NULL);
+
+    // blocking get waits for the frame, which is accessed in place
+    rx_frames.num = sizeof(frames) / sizeof(frames[0]);
+    TEST_ASSERT_EQUAL(0, ioctl(eth_tap_fd, L2TAP_G_RX_FRAMES, &rx_frames));
+    TEST_ASSERT_EQUAL(1, rx_frames.num);
+    TEST_ASSERT_EQUAL(sizeof(s_test_msg), frames[0].len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&s_test_msg, frames[0].buff, frames[0].len);
+    TEST_ASSERT_EQUAL(0, ioctl(eth_tap_fd, L2TAP_S_RX_FRAMES_FREE, &rx_frames));
+    TEST_ASSERT_EQUAL(0, rx_frames.num);
+
+    TEST_ASSERT_EQUAL(0, close(eth_tap_fd));
+    vTaskDelay(pdMS_TO_TICKS(50)); // just for sure to give some time to send task close fd
+    TEST_ASSERT_EQUAL(ESP_OK, esp_vfs_l2tap_intf_unregister(NULL));
+    ethernet_deinit(&eth_network_hndls);
+}
+
 /* ============================================================================= */
 /**
  * @brief Verifies write
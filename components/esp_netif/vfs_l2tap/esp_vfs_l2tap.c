@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -183,6 +183,43 @@ static esp_err_t pop_rx_queue(l2tap_context_t *l2tap_socket, void *buff, size_t
     return ESP_OK;
 }
 
+static esp_err_t pop_rx_frames(l2tap_context_t *l2tap_socket, l2tap_rx_frames_t *rx_frames)
+{
+    TickType_t timeout = portMAX_DELAY;
+    if (l2tap_socket->flags & L2TAP_FLAG_NON_BLOCK) {
+        timeout = 0;
+    }
+    size_t num = 0;
+    bool closing = false;
+
+    frame_queue_entry_t rx_frame_info;
+    // wait for the first frame only, then take the frames which are already queued
+    while (num < rx_frames->num && xQueueReceive(l2tap_socket->rx_queue, &rx_frame_info, num == 0 ? timeout : 0) == pdTRUE) {
+        // empty queue was issued indicating the fd is going to be closed
+        if (rx_frame_info.len == 0) {
+            // indicate to "clean_task" that task waiting for queue was unblocked
+            push_rx_queue(l2tap_socket, NULL, 0, NULL);
+            closing = true;
+            break;
+        }
+        l2tap_rx_frame_t *frame = &rx_frames->frames[num++];
+        frame->buff = rx_frame_info.buff;
+        frame->len = rx_frame_info.len;
+        if (l2tap_socket->flags & L2TAP_FLAG_TS) {
+            frame->ts.tv_sec = rx_frame_info.ts.seconds;
+            frame->ts.tv_nsec = rx_frame_info.ts.nanoseconds;
+        } else {
+            frame->ts.tv_sec = 0;
+            frame->ts.tv_nsec = 0;
+        }
+    }
+    rx_frames->num = num;
+    if (num == 0 && !closing) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
 static bool rx_queue_empty(l2tap_context_t *l2tap_socket)
 {
     return (uxQueueMessagesWaiting(l2tap_socket->rx_queue) == 0);
@@ -584,6 +621,36 @@ static int l2tap_ioctl(int fd, int cmd, va_list args)
         s_l2tap_sockets[fd].driver_transmit_ctrl_vargs = esp_eth_transmit_ctrl_vargs;
         l2tap_exit_critical();
         break;
+    case L2TAP_G_RX_FRAMES:{
+        l2tap_rx_frames_t *rx_frames = va_arg(args, l2tap_rx_frames_t *);
+        if (atomic_load(&s_l2tap_sockets[fd].state) != L2TAP_SOCK_STATE_OPENED) {
+            // bad file desc
+            errno = EBADF;
+            goto err;
+        }
+        if (rx_frames == NULL || rx_frames->frames == NULL || rx_frames->num == 0) {
+            errno = EINVAL;
+            goto err;
+        }
+        esp_err_t esp_ret = pop_rx_frames(&s_l2tap_sockets[fd], rx_frames);
+        if (esp_ret != ESP_OK) {
+            errno = l2tap_rx_esp_err_to_errno(esp_ret);
+            goto err;
+        }
+        break;
+    }
+    case L2TAP_S_RX_FRAMES_FREE:{
+        l2tap_rx_frames_t *rx_frames = va_arg(args, l2tap_rx_frames_t *);
+        if (rx_frames == NULL || (rx_frames->frames == NULL && rx_frames->num != 0)) {
+            errno = EINVAL;
+            goto err;
+        }
+        for (size_t i = 0; i < rx_frames->num; i++) {
+            s_l2tap_sockets[fd].driver_free_rx_buffer(s_l2tap_sockets[fd].driver_handle, rx_frames->frames[i].buff);
+        }
+        rx_frames->num = 0;
+        break;
+    }
     default:
         // unsupported operation
         errno = ENOSYS;
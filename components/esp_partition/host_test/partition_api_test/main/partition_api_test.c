@@ -659,6 +659,71 @@ TEST(partition_api, test_partition_stats)
     free(test_data_ptr);
 }
 
+TEST(partition_api, test_partition_timing_and_wear)
+{
+    const esp_partition_t *partition_data = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "storage");
+    TEST_ASSERT_NOT_NULL(partition_data);
+    TEST_ASSERT_GREATER_OR_EQUAL(4 * ESP_PARTITION_EMULATED_SECTOR_SIZE, partition_data->size);
+
+    // flat timing model: every read or write block of up to 4096 bytes costs the same time
+    esp_partition_timing_t timing = { .sector_erase_time_us = 1000 };
+    for (size_t i = 0; i < ESP_PARTITION_TIMING_TABLE_SIZE; i++) {
+        timing.read_time_us[i] = 10;
+        timing.write_time_us[i] = 20;
+    }
+    esp_partition_set_timing(&timing);
+
+    esp_partition_timing_t timing_act;
+    esp_partition_get_timing(&timing_act);
+    TEST_ASSERT_EQUAL_MEMORY(&timing, &timing_act, sizeof(timing));
+
+    size_t size = 2 * ESP_PARTITION_EMULATED_SECTOR_SIZE;
+    uint8_t *test_data_ptr = malloc(size);
+    TEST_ASSERT_NOT_NULL(test_data_ptr);
+    memset(test_data_ptr, 0xa5, size);
+
+    esp_partition_clear_stats();
+
+    // first sector erased twice, second one once
+    TEST_ESP_OK(esp_partition_erase_range(partition_data, 0, size));
+    TEST_ESP_OK(esp_partition_erase_range(partition_data, 0, ESP_PARTITION_EMULATED_SECTOR_SIZE));
+    TEST_ESP_OK(esp_partition_write(partition_data, 0, test_data_ptr, size));
+    TEST_ESP_OK(esp_partition_read(partition_data, 0, test_data_ptr, size));
+    TEST_ESP_OK(esp_partition_read(partition_data, 0, test_data_ptr, 100));
+
+    TEST_ASSERT_EQUAL(3 * 1000, esp_partition_get_erase_time());
+    TEST_ASSERT_EQUAL(2 * 20, esp_partition_get_write_time());
+    TEST_ASSERT_EQUAL(3 * 10, esp_partition_get_read_time());
+    TEST_ASSERT_EQUAL(3000 + 40 + 30, esp_partition_get_total_time());
+
+    esp_partition_wear_stats_t wear;
+    TEST_ESP_OK(esp_partition_get_wear_stats(partition_data, &wear));
+    TEST_ASSERT_EQUAL(partition_data->size / ESP_PARTITION_EMULATED_SECTOR_SIZE, wear.sector_count);
+    TEST_ASSERT_EQUAL(2, wear.erased_sectors);
+    TEST_ASSERT_EQUAL(0, wear.min_erase_count);
+    TEST_ASSERT_EQUAL(2, wear.max_erase_count);
+    TEST_ASSERT_EQUAL(3, wear.total_erase_count);
+    TEST_ASSERT_EQUAL(partition_data->address / ESP_PARTITION_EMULATED_SECTOR_SIZE, wear.max_erase_sector);
+
+    // whole flash
+    TEST_ESP_OK(esp_partition_get_wear_stats(NULL, &wear));
+    TEST_ASSERT_EQUAL(esp_partition_get_file_mmap_ctrl_act()->flash_file_size / ESP_PARTITION_EMULATED_SECTOR_SIZE, wear.sector_count);
+    TEST_ASSERT_EQUAL(3, wear.total_erase_count);
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_partition_get_wear_stats(partition_data, NULL));
+
+    // default model, timing of sizes between the table entries is interpolated
+    esp_partition_set_timing(NULL);
+    esp_partition_get_timing(&timing_act);
+    esp_partition_clear_stats();
+    TEST_ESP_OK(esp_partition_read(partition_data, 0, test_data_ptr, 4096 + 3072));
+    size_t expected = timing_act.read_time_us[10] + (timing_act.read_time_us[9] + timing_act.read_time_us[10]) / 2;
+    TEST_ASSERT_EQUAL(expected, esp_partition_get_read_time());
+
+    esp_partition_clear_stats();
+    free(test_data_ptr);
+}
+
 TEST(partition_api, test_partition_power_off_emulation)
 {
     const esp_partition_t *partition_data = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "storage");
@@ -782,6 +847,7 @@ TEST_GROUP_RUNNER(partition_api)
     RUN_TEST_CASE(partition_api, test_partition_mmap_pfile_nf);
     RUN_TEST_CASE(partition_api, test_partition_mmap_size_too_small);
     RUN_TEST_CASE(partition_api, test_partition_stats);
+    RUN_TEST_CASE(partition_api, test_partition_timing_and_wear);
     RUN_TEST_CASE(partition_api, test_partition_power_off_emulation);
     RUN_TEST_CASE(partition_api, test_partition_copy);
     RUN_TEST_CASE(partition_api, test_partition_register_external);
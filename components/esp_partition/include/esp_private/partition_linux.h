@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <limits.h>
 #include "esp_err.h"
+#include "esp_partition.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,6 +28,9 @@ extern "C" {
 /** @brief emulated whole flash size for the partition API on Linux */
 #define ESP_PARTITION_DEFAULT_EMULATED_FLASH_SIZE 0x400000 //4MB fixed
 
+/** @brief number of entries of the read/write time tables in esp_partition_timing_t (block sizes 4 to 4096 bytes) */
+#define ESP_PARTITION_TIMING_TABLE_SIZE 11
+
 /** @brief mode of fail after */
 #define ESP_PARTITION_FAIL_AFTER_MODE_ERASE 0x01
 #define ESP_PARTITION_FAIL_AFTER_MODE_WRITE 0x02
@@ -165,12 +169,68 @@ size_t esp_partition_get_write_bytes(void);
  *
  * Function returns estimated total time spent in esp_partition_read,
  * esp_partition_write and esp_partition_erase_range operations.
+ * The estimation uses the timing model set by esp_partition_set_timing.
  *
  * @return
- *      - estimated total time spent in read/write/erase operations in milliseconds
+ *      - estimated total time spent in read/write/erase operations in microseconds
  */
 size_t esp_partition_get_total_time(void);
 
+/**
+ * @brief Returns estimated time spent in esp_partition_read
+ *
+ * @return
+ *      - estimated time spent in read operations since recent esp_partition_clear_stats, in microseconds
+ */
+size_t esp_partition_get_read_time(void);
+
+/**
+ * @brief Returns estimated time spent in esp_partition_write
+ *
+ * @return
+ *      - estimated time spent in write operations since recent esp_partition_clear_stats, in microseconds
+ */
+size_t esp_partition_get_write_time(void);
+
+/**
+ * @brief Returns estimated time spent in esp_partition_erase_range
+ *
+ * @return
+ *      - estimated time spent in erase operations since recent esp_partition_clear_stats, in microseconds
+ */
+size_t esp_partition_get_erase_time(void);
+
+/**
+ * @brief Timing model of the emulated SPI FLASH device
+ *
+ * The time of a read or write of 4 << i bytes is read_time_us[i] or write_time_us[i]. Sizes in between are
+ * interpolated linearly, operations larger than 4096 bytes are accounted as a sequence of 4096 byte blocks.
+ * Each erased virtual sector costs sector_erase_time_us.
+ */
+typedef struct {
+    uint32_t read_time_us[ESP_PARTITION_TIMING_TABLE_SIZE];  /*!< read time of blocks of 4, 8, ... 4096 bytes */
+    uint32_t write_time_us[ESP_PARTITION_TIMING_TABLE_SIZE]; /*!< write time of blocks of 4, 8, ... 4096 bytes */
+    uint32_t sector_erase_time_us;                           /*!< erase time of one virtual sector */
+} esp_partition_timing_t;
+
+/**
+ * @brief Sets the timing model used to estimate the time of partition operations
+ *
+ * The default model is measured on a SPI FLASH chip clocked at 80MHz. Setting the model of another chip
+ * or flash configuration allows comparing the storage configurations without running them on hardware.
+ * The model applies to the operations following the call, the statistics gathered so far are kept.
+ *
+ * @param[in] timing Timing model to use, NULL to restore the default model
+ */
+void esp_partition_set_timing(const esp_partition_timing_t *timing);
+
+/**
+ * @brief Returns the timing model used to estimate the time of partition operations
+ *
+ * @param[out] timing Filled with the timing model in use
+ */
+void esp_partition_get_timing(esp_partition_timing_t *timing);
+
 /**
  * @brief Initializes emulation of lost power failure in write/erase operations
  *
@@ -200,6 +260,35 @@ void esp_partition_fail_after(size_t count, uint8_t mode);
 */
 size_t esp_partition_get_sector_erase_count(size_t sector);
 
+/**
+ * @brief Summary of the erase counts of the virtual sectors of a flash region
+ */
+typedef struct {
+    size_t sector_count;        /*!< number of virtual sectors in the region */
+    size_t erased_sectors;      /*!< number of virtual sectors erased at least once */
+    size_t min_erase_count;     /*!< lowest erase count of the sectors in the region */
+    size_t max_erase_count;     /*!< highest erase count of the sectors in the region */
+    size_t total_erase_count;   /*!< sum of the erase counts of the sectors in the region */
+    size_t max_erase_sector;    /*!< index of the first sector with the highest erase count */
+} esp_partition_wear_stats_t;
+
+/**
+ * @brief Summarizes the erase counts of the virtual sectors of a partition
+ *
+ * The ratio of max_erase_count to the average erase count (total_erase_count / sector_count) shows how evenly
+ * the writes of a file system are spread. max_erase_count compared to the endurance of the flash chip
+ * (typically 100000 cycles) gives the expected lifetime for the workload run since esp_partition_clear_stats.
+ *
+ * @param[in] partition Partition to summarize, NULL to summarize the whole emulated flash
+ * @param[out] stats Filled with the summary
+ *
+ * @return
+ *      - ESP_OK: Operation successful
+ *      - ESP_ERR_INVALID_ARG: stats is NULL or partition is not placed in the emulated flash
+ *      - ESP_ERR_INVALID_STATE: The emulated flash is not mapped
+ */
+esp_err_t esp_partition_get_wear_stats(const esp_partition_t *partition, esp_partition_wear_stats_t *stats);
+
 typedef struct {
     char flash_file_name[PATH_MAX];      /*!< name of flash dump file, zero-terminated ASCII string */
     size_t flash_file_size;              /*!< size of flash dump file in bytes */
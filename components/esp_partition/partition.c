@@ -56,6 +56,7 @@
 typedef struct partition_list_item_ {
     esp_partition_t info;
     bool user_registered;
+    uint32_t label_hash;                            // hash of info.label, compared before the labels
     SLIST_ENTRY(partition_list_item_) next;
 } partition_list_item_t;
 
@@ -63,6 +64,7 @@ typedef struct esp_partition_iterator_opaque_ {
     esp_partition_type_t type;                      // requested type
     esp_partition_subtype_t subtype;                // requested subtype
     const char *label;                              // requested label (can be NULL)
+    uint32_t label_hash;                            // hash of the requested label
     partition_list_item_t *next_item;               // next item to iterate to
     esp_partition_t *info;                          // pointer to info (it is redundant, but makes code more readable)
 } esp_partition_iterator_opaque_t;
@@ -72,6 +74,32 @@ static _lock_t s_partition_list_lock;
 
 static const char *TAG = "partition";
 
+/* FNV-1a, over at most the length of a partition label */
+static uint32_t label_hash(const char *label)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(((esp_partition_t *)0)->label) && label[i] != '\0'; i++) {
+        hash = (hash ^ (uint8_t)label[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool partition_matches(const partition_list_item_t *item, esp_partition_type_t type,
+                              esp_partition_subtype_t subtype, const char *label, uint32_t hash)
+{
+    const esp_partition_t *p = &item->info;
+    if (type != ESP_PARTITION_TYPE_ANY && type != p->type) {
+        return false;
+    }
+    if (subtype != ESP_PARTITION_SUBTYPE_ANY && subtype != p->subtype) {
+        return false;
+    }
+    if (label != NULL && (hash != item->label_hash || strcmp(label, p->label) != 0)) {
+        return false;
+    }
+    return true;
+}
+
 static bool is_partition_encrypted(bool encryption_config, esp_partition_type_t type, esp_partition_subtype_t subtype)
 {
 #if CONFIG_IDF_TARGET_LINUX
@@ -199,6 +227,7 @@ static esp_err_t load_partitions(void)
 #endif
         // item->info.label is initialized by calloc, so resulting string will be null terminated
         strncpy(item->info.label, (const char *) entry.label, sizeof(item->info.label) - 1);
+        item->label_hash = label_hash(item->info.label);
 
         // add it to the list
         if (last == NULL) {
@@ -295,6 +324,7 @@ static esp_partition_iterator_opaque_t *iterator_create(esp_partition_type_t typ
     it->type = type;
     it->subtype = subtype;
     it->label = label;
+    it->label_hash = label ? label_hash(label) : 0;
     it->next_item = SLIST_FIRST(&s_partition_list);
     it->info = NULL;
     return it;
@@ -333,18 +363,10 @@ esp_partition_iterator_t esp_partition_next(esp_partition_iterator_t it)
     }
     _lock_acquire(&s_partition_list_lock);
     for (; it->next_item != NULL; it->next_item = SLIST_NEXT(it->next_item, next)) {
-        esp_partition_t *p = &it->next_item->info;
-        if (it->type != ESP_PARTITION_TYPE_ANY && it->type != p->type) {
-            continue;
-        }
-        if (it->subtype != ESP_PARTITION_SUBTYPE_ANY && it->subtype != p->subtype) {
-            continue;
-        }
-        if (it->label != NULL && strcmp(it->label, p->label) != 0) {
-            continue;
+        if (partition_matches(it->next_item, it->type, it->subtype, it->label, it->label_hash)) {
+            // all constraints match, bail out
+            break;
         }
-        // all constraints match, bail out
-        break;
     }
     _lock_release(&s_partition_list_lock);
     if (it->next_item == NULL) {
@@ -359,12 +381,24 @@ esp_partition_iterator_t esp_partition_next(esp_partition_iterator_t it)
 const esp_partition_t *esp_partition_find_first(esp_partition_type_t type,
         esp_partition_subtype_t subtype, const char *label)
 {
-    esp_partition_iterator_t it = esp_partition_find(type, subtype, label);
-    if (it == NULL) {
+    if (ensure_partitions_loaded() != ESP_OK) {
         return NULL;
     }
-    const esp_partition_t *res = esp_partition_get(it);
-    esp_partition_iterator_release(it);
+    // Same constraints as esp_partition_find(), but without allocating an iterator
+    if (type == ESP_PARTITION_TYPE_ANY && subtype != ESP_PARTITION_SUBTYPE_ANY) {
+        return NULL;
+    }
+    uint32_t hash = label ? label_hash(label) : 0;
+    const esp_partition_t *res = NULL;
+    partition_list_item_t *item;
+    _lock_acquire(&s_partition_list_lock);
+    SLIST_FOREACH(item, &s_partition_list, next) {
+        if (partition_matches(item, type, subtype, label, hash)) {
+            res = &item->info;
+            break;
+        }
+    }
+    _lock_release(&s_partition_list_lock);
     return res;
 }
 
@@ -444,6 +478,7 @@ esp_err_t esp_partition_register_external(esp_flash_t *flash_chip, size_t offset
     item->info.readonly = false;
     item->user_registered = true;
     strlcpy(item->info.label, label, sizeof(item->info.label));
+    item->label_hash = label_hash(item->info.label);
 
     _lock_acquire(&s_partition_list_lock);
     partition_list_item_t *it = NULL;
@@ -40,6 +40,9 @@ static size_t s_esp_partition_stat_read_bytes = 0;
 static size_t s_esp_partition_stat_write_bytes = 0;
 static size_t s_esp_partition_stat_erase_ops = 0;
 static size_t s_esp_partition_stat_total_time = 0;
+static size_t s_esp_partition_stat_read_time = 0;
+static size_t s_esp_partition_stat_write_time = 0;
+static size_t s_esp_partition_stat_erase_time = 0;
 static size_t s_esp_partition_emulated_power_off_counter = SIZE_MAX;
 static uint8_t s_esp_partition_emulated_power_off_mode = 0;
 
@@ -571,21 +574,36 @@ uint32_t esp_partition_get_main_flash_sector_size(void)
 // timing data for ESP8266, 160MHz CPU frequency, 80MHz flash frequency
 // all values in microseconds
 // values are for block sizes starting at 4 bytes and going up to 4096 bytes
-static size_t s_esp_partition_stat_read_times[] = {7, 5, 6, 7, 11, 18, 32, 60, 118, 231, 459};
-static size_t s_esp_partition_stat_write_times[] = {19, 23, 35, 57, 106, 205, 417, 814, 1622, 3200, 6367};
-static size_t s_esp_partition_stat_block_erase_time = 37142;
+static const esp_partition_timing_t s_esp_partition_default_timing = {
+    .read_time_us = {7, 5, 6, 7, 11, 18, 32, 60, 118, 231, 459},
+    .write_time_us = {19, 23, 35, 57, 106, 205, 417, 814, 1622, 3200, 6367},
+    .sector_erase_time_us = 37142,
+};
 
-static size_t esp_partition_stat_time_interpolate(uint32_t bytes, size_t *lut)
+static esp_partition_timing_t s_esp_partition_timing = s_esp_partition_default_timing;
+
+// time of an operation on the given number of bytes, interpolated from the lut
+// operations larger than the last lut entry are accounted as a sequence of the largest blocks
+static size_t esp_partition_stat_time_interpolate(size_t bytes, const uint32_t *lut)
 {
-    const int lut_size = sizeof(s_esp_partition_stat_read_times) / sizeof(s_esp_partition_stat_read_times[0]);
-    int lz = __builtin_clz(bytes / 4);
-    int log_size = 32 - lz;
-    size_t x2 = 1 << (log_size + 2);
-    size_t upper_index = (log_size < lut_size - 1) ? log_size : lut_size - 1;
-    size_t y2 = lut[upper_index];
-    size_t x1 = 1 << (log_size + 1);
-    size_t y1 = lut[log_size - 1];
-    return (bytes - x1) * (y2 - y1) / (x2 - x1) + y1;
+    const size_t lut_max_bytes = 4 << (ESP_PARTITION_TIMING_TABLE_SIZE - 1);
+    size_t time = (bytes / lut_max_bytes) * lut[ESP_PARTITION_TIMING_TABLE_SIZE - 1];
+    bytes %= lut_max_bytes;
+
+    if (bytes < 4) {
+        return time + (bytes ? lut[0] : 0);
+    }
+
+    // lut[i] is the time for 4 << i bytes, find the entries surrounding the size
+    size_t lower_index = 29 - __builtin_clz((uint32_t) bytes);
+    size_t x1 = 4 << lower_index;
+    if (bytes == x1) {
+        return time + lut[lower_index];
+    }
+    size_t x2 = x1 << 1;
+    int64_t y1 = lut[lower_index];
+    int64_t y2 = lut[lower_index + 1];
+    return time + (size_t)(y1 + ((int64_t)(bytes - x1) * (y2 - y1)) / (int64_t)(x2 - x1));
 }
 
 // Registers read access statistics of emulated SPI FLASH device (Linux host)
@@ -598,7 +616,9 @@ static void esp_partition_hook_read(const void *srcAddr, const size_t size)
     // stats
     ++s_esp_partition_stat_read_ops;
     s_esp_partition_stat_read_bytes += size;
-    s_esp_partition_stat_total_time += esp_partition_stat_time_interpolate((uint32_t) size, s_esp_partition_stat_read_times);
+    size_t time = esp_partition_stat_time_interpolate(size, s_esp_partition_timing.read_time_us);
+    s_esp_partition_stat_read_time += time;
+    s_esp_partition_stat_total_time += time;
 }
 
 // Registers write access statistics of emulated SPI FLASH device (Linux host)
@@ -641,7 +661,9 @@ static bool esp_partition_hook_write(const void *dstAddr, size_t *size)
         // stats
         ++s_esp_partition_stat_write_ops;
         s_esp_partition_stat_write_bytes += write_cycles * 4;
-        s_esp_partition_stat_total_time += esp_partition_stat_time_interpolate((uint32_t) (*size), s_esp_partition_stat_write_times);
+        size_t time = esp_partition_stat_time_interpolate(*size, s_esp_partition_timing.write_time_us);
+        s_esp_partition_stat_write_time += time;
+        s_esp_partition_stat_total_time += time;
     }
 
     return ret_val;
@@ -694,7 +716,8 @@ static bool esp_partition_hook_erase(const void *dstAddr, size_t *size)
     for (size_t sector_index = first_sector_idx; sector_index < first_sector_idx + sector_count; sector_index++) {
         ++s_esp_partition_stat_erase_ops;
         s_esp_partition_stat_sector_erase_count[sector_index]++;
-        s_esp_partition_stat_total_time += s_esp_partition_stat_block_erase_time;
+        s_esp_partition_stat_erase_time += s_esp_partition_timing.sector_erase_time_us;
+        s_esp_partition_stat_total_time += s_esp_partition_timing.sector_erase_time_us;
     }
 
     return ret_val;
@@ -708,6 +731,9 @@ void esp_partition_clear_stats(void)
     s_esp_partition_stat_read_ops = 0;
     s_esp_partition_stat_write_ops = 0;
     s_esp_partition_stat_total_time = 0;
+    s_esp_partition_stat_read_time = 0;
+    s_esp_partition_stat_write_time = 0;
+    s_esp_partition_stat_erase_time = 0;
 
     memset(s_esp_partition_stat_sector_erase_count, 0, sizeof(size_t) * s_esp_partition_file_mmap_ctrl_act.flash_file_size / ESP_PARTITION_EMULATED_SECTOR_SIZE);
 }
@@ -742,6 +768,31 @@ size_t esp_partition_get_total_time(void)
     return s_esp_partition_stat_total_time;
 }
 
+size_t esp_partition_get_read_time(void)
+{
+    return s_esp_partition_stat_read_time;
+}
+
+size_t esp_partition_get_write_time(void)
+{
+    return s_esp_partition_stat_write_time;
+}
+
+size_t esp_partition_get_erase_time(void)
+{
+    return s_esp_partition_stat_erase_time;
+}
+
+void esp_partition_set_timing(const esp_partition_timing_t *timing)
+{
+    s_esp_partition_timing = (timing != NULL) ? *timing : s_esp_partition_default_timing;
+}
+
+void esp_partition_get_timing(esp_partition_timing_t *timing)
+{
+    *timing = s_esp_partition_timing;
+}
+
 void esp_partition_fail_after(size_t count, uint8_t mode)
 {
     s_esp_partition_emulated_power_off_counter = count;
@@ -752,4 +803,47 @@ size_t esp_partition_get_sector_erase_count(size_t sector)
 {
     return s_esp_partition_stat_sector_erase_count[sector];
 }
+
+esp_err_t esp_partition_get_wear_stats(const esp_partition_t *partition, esp_partition_wear_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_esp_partition_stat_sector_erase_count == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    size_t flash_size = s_esp_partition_file_mmap_ctrl_act.flash_file_size;
+    size_t first_sector_idx = 0;
+    size_t end_sector_idx = flash_size / ESP_PARTITION_EMULATED_SECTOR_SIZE;
+    if (partition != NULL) {
+        if (partition->flash_chip != NULL || partition->size == 0 ||
+                partition->address + partition->size > flash_size) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        first_sector_idx = partition->address / ESP_PARTITION_EMULATED_SECTOR_SIZE;
+        end_sector_idx = (partition->address + partition->size - 1) / ESP_PARTITION_EMULATED_SECTOR_SIZE + 1;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->sector_count = end_sector_idx - first_sector_idx;
+    stats->min_erase_count = SIZE_MAX;
+    stats->max_erase_sector = first_sector_idx;
+    for (size_t sector_index = first_sector_idx; sector_index < end_sector_idx; sector_index++) {
+        size_t count = s_esp_partition_stat_sector_erase_count[sector_index];
+        if (count > 0) {
+            stats->erased_sectors++;
+        }
+        if (count < stats->min_erase_count) {
+            stats->min_erase_count = count;
+        }
+        if (count > stats->max_erase_count) {
+            stats->max_erase_count = count;
+            stats->max_erase_sector = sector_index;
+        }
+        stats->total_erase_count += count;
+    }
+
+    return ESP_OK;
+}
 #endif
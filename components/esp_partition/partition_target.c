@@ -9,6 +9,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <sys/lock.h>
+#include <sys/queue.h>
 #include "sdkconfig.h"
 #include "esp_flash_partitions.h"
 #include "esp_attr.h"
@@ -144,13 +145,27 @@ esp_err_t esp_partition_erase_range(const esp_partition_t *partition,
 }
 
 /*
- * Note: current implementation ignores the possibility of multiple regions in the same partition being
- * mapped. Reference counting and address space reuse is delegated to spi_flash_mmap.
+ * Mappings made by esp_partition_mmap are reference counted: mapping a region which lies within a region
+ * already mapped with the same memory type returns the existing mapping instead of calling spi_flash_mmap
+ * again, e.g. when the same partition is mapped repeatedly by several components. The handle returned is
+ * the cache entry, the region is unmapped when the last handle referencing it is released.
  *
- * If this becomes a performance issue (i.e. if we need to map multiple regions within the partition),
- * we can add esp_partition_mmapv which will accept an array of offsets and sizes, and return array of
- * mapped pointers, and a single handle for all these regions.
+ * Regions which only overlap an existing mapping are mapped anew, as the virtual address range of the
+ * existing mapping can't be extended.
  */
+typedef struct partition_mmap_entry_ {
+    size_t mmap_addr;                       // page aligned flash address of the mapping
+    size_t mmap_size;                       // size of the mapping, from mmap_addr
+    esp_partition_mmap_memory_t memory;
+    const void *ptr;                        // virtual address of mmap_addr
+    spi_flash_mmap_handle_t handle;
+    uint32_t refcnt;
+    SLIST_ENTRY(partition_mmap_entry_) next;
+} partition_mmap_entry_t;
+
+static SLIST_HEAD(partition_mmap_list_, partition_mmap_entry_) s_mmap_list = SLIST_HEAD_INITIALIZER(s_mmap_list);
+static _lock_t s_mmap_list_lock;
+
 esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
                              esp_partition_mmap_memory_t memory,
                              const void **out_ptr, esp_partition_mmap_handle_t *out_handle)
@@ -169,17 +184,62 @@ esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, si
     // offset within mmu page size block
     size_t region_offset = phys_addr & (CONFIG_MMU_PAGE_SIZE - 1);
     size_t mmap_addr = phys_addr & ~(CONFIG_MMU_PAGE_SIZE - 1);
-    esp_err_t rc = spi_flash_mmap(mmap_addr, size + region_offset, (spi_flash_mmap_memory_t) memory, out_ptr, (spi_flash_mmap_handle_t*) out_handle);
-    // adjust returned pointer to point to the correct offset
+    esp_err_t rc = ESP_OK;
+    partition_mmap_entry_t *entry;
+
+    _lock_acquire(&s_mmap_list_lock);
+    SLIST_FOREACH(entry, &s_mmap_list, next) {
+        if (entry->memory == memory && mmap_addr >= entry->mmap_addr &&
+                phys_addr + size <= entry->mmap_addr + entry->mmap_size) {
+            entry->refcnt++;
+            break;
+        }
+    }
+    if (entry == NULL) {
+        entry = calloc(1, sizeof(partition_mmap_entry_t));
+        if (entry == NULL) {
+            rc = ESP_ERR_NO_MEM;
+        } else {
+            rc = spi_flash_mmap(mmap_addr, size + region_offset, (spi_flash_mmap_memory_t) memory, &entry->ptr, &entry->handle);
+            if (rc == ESP_OK) {
+                entry->mmap_addr = mmap_addr;
+                entry->mmap_size = size + region_offset;
+                entry->memory = memory;
+                entry->refcnt = 1;
+                SLIST_INSERT_HEAD(&s_mmap_list, entry, next);
+            } else {
+                free(entry);
+                entry = NULL;
+            }
+        }
+    }
+    _lock_release(&s_mmap_list_lock);
+
     if (rc == ESP_OK) {
-        *out_ptr = (void *) (((ptrdiff_t) * out_ptr) + region_offset);
+        // point to the requested offset within the mapping
+        *out_ptr = (const uint8_t *) entry->ptr + (phys_addr - entry->mmap_addr);
+        *out_handle = (esp_partition_mmap_handle_t) entry;
     }
     return rc;
 }
 
 void esp_partition_munmap(esp_partition_mmap_handle_t handle)
 {
-    spi_flash_munmap((spi_flash_mmap_handle_t) handle);
+    partition_mmap_entry_t *entry = (partition_mmap_entry_t *) handle;
+    assert(entry != NULL && entry->refcnt > 0);
+
+    _lock_acquire(&s_mmap_list_lock);
+    if (--entry->refcnt == 0) {
+        SLIST_REMOVE(&s_mmap_list, entry, partition_mmap_entry_, next);
+    } else {
+        entry = NULL;
+    }
+    _lock_release(&s_mmap_list_lock);
+
+    if (entry != NULL) {
+        spi_flash_munmap(entry->handle);
+        free(entry);
+    }
 }
 
 esp_err_t esp_partition_get_sha256(const esp_partition_t *partition, uint8_t *sha_256)
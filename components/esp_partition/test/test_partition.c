@@ -109,3 +109,26 @@ TEST_CASE("Can write, read, mmap partition", "[partition][ignore]")
 
     esp_partition_munmap(mmap_handle);
 }
+
+TEST_CASE("Mapping a mapped region of a partition reuses the mapping", "[partition]")
+{
+    const esp_partition_t *p = get_test_data_partition();
+
+    const uint8_t *outer;
+    const uint8_t *inner;
+    esp_partition_mmap_handle_t outer_handle;
+    esp_partition_mmap_handle_t inner_handle;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_partition_mmap(p, 0, 0x20000, ESP_PARTITION_MMAP_DATA,
+                      (const void **)&outer, &outer_handle));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_partition_mmap(p, 0x1234, 0x1000, ESP_PARTITION_MMAP_DATA,
+                      (const void **)&inner, &inner_handle));
+    TEST_ASSERT_EQUAL_PTR(outer + 0x1234, inner);
+    TEST_ASSERT_EQUAL(outer_handle, inner_handle);
+
+    // the mapping stays valid as long as a handle references it
+    esp_partition_munmap(outer_handle);
+    uint8_t buf[16];
+    TEST_ASSERT_EQUAL(ESP_OK, esp_partition_read(p, 0x1234, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(buf, inner, sizeof(buf));
+    esp_partition_munmap(inner_handle);
+}
@@ -196,6 +196,76 @@ esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle);
  */
 esp_err_t esp_pm_dump_locks(FILE* stream);
 
+/**
+ * @brief Number of buckets of the power management histograms
+ *
+ * Bucket 0 counts the values lower than 1, bucket N counts the values from 2^(N-1) to 2^N - 1,
+ * and the last bucket counts all the values from 2^(ESP_PM_HIST_BUCKETS - 2).
+ */
+#define ESP_PM_HIST_BUCKETS 16
+
+/**
+ * @brief Statistics of a power management lock
+ */
+typedef struct {
+    uint32_t times_taken;                               /*!< Number of times the lock was taken from a count of 0 */
+    int64_t time_held_us;                               /*!< Total time the lock was held, in microseconds */
+    uint32_t switch_latency_hist[ESP_PM_HIST_BUCKETS];  /*!< Histogram of the time esp_pm_lock_acquire took to switch
+                                                             to the mode of the lock when taking it from a count of 0,
+                                                             in microseconds */
+} esp_pm_lock_stats_t;
+
+/**
+ * @brief Reasons for which automatic light sleep was not entered by the idle task
+ */
+typedef enum {
+    ESP_PM_SLEEP_SKIP_OTHER_CORE,   /*!< The other CPU has just left light sleep */
+    ESP_PM_SLEEP_SKIP_LOCK,         /*!< A lock was held, or a mode switch was in progress */
+    ESP_PM_SLEEP_SKIP_PERIPH,       /*!< A peripheral driver skipped light sleep */
+    ESP_PM_SLEEP_SKIP_TOO_SHORT,    /*!< The next event was closer than CONFIG_FREERTOS_IDLE_TIME_BEFORE_SLEEP */
+    ESP_PM_SLEEP_SKIP_REJECTED,     /*!< esp_light_sleep_start rejected the sleep, e.g. a wakeup source had triggered */
+    ESP_PM_SLEEP_SKIP_MAX,
+} esp_pm_sleep_skip_reason_t;
+
+/**
+ * @brief Statistics of automatic light sleep
+ */
+typedef struct {
+    uint32_t light_sleep_counts;                        /*!< Number of light sleeps */
+    uint32_t skip_counts[ESP_PM_SLEEP_SKIP_MAX];        /*!< Number of light sleeps skipped, by reason.
+                                                             Only counted while light sleep is enabled */
+    uint32_t entry_latency_hist[ESP_PM_HIST_BUCKETS];   /*!< Histogram of the time from the decision to sleep to the call
+                                                             of esp_light_sleep_start, in microseconds */
+    uint32_t exit_latency_hist[ESP_PM_HIST_BUCKETS];    /*!< Histogram of the time from the return of
+                                                             esp_light_sleep_start to the return to the idle task,
+                                                             in microseconds */
+    uint32_t residency_hist[ESP_PM_HIST_BUCKETS];       /*!< Histogram of the time spent in light sleep,
+                                                             in milliseconds */
+} esp_pm_sleep_stats_t;
+
+/**
+ * @brief Get the statistics of a power management lock
+ *
+ * @param handle handle obtained from esp_pm_lock_create function
+ * @param[out] stats statistics of the lock
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if handle or stats is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_PM_PROFILING is not enabled in sdkconfig
+ */
+esp_err_t esp_pm_lock_get_stats(esp_pm_lock_handle_t handle, esp_pm_lock_stats_t *stats);
+
+/**
+ * @brief Get the statistics of automatic light sleep
+ *
+ * @param[out] stats statistics of light sleep
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_PM_PROFILING is not enabled in sdkconfig
+ */
+esp_err_t esp_pm_get_sleep_stats(esp_pm_sleep_stats_t *stats);
+
 #if CONFIG_PM_LIGHT_SLEEP_CALLBACKS
 /**
  * @brief Function prototype for light sleep callback functions (if CONFIG_FREERTOS_USE_TICKLESS_IDLE)
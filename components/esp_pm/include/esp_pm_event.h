@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_event_base.h"
+#include "esp_pm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Power management event base
+ *
+ * If CONFIG_PM_PROFILING_EVENT_PERIOD is not 0, the statistics of power management are posted
+ * to the default event loop with this base every CONFIG_PM_PROFILING_EVENT_PERIOD seconds.
+ */
+ESP_EVENT_DECLARE_BASE(ESP_PM_EVENT);
+
+/**
+ * @brief Power management events
+ */
+typedef enum {
+    ESP_PM_EVENT_SLEEP_STATS,   /*!< Statistics of light sleep, the event data is esp_pm_sleep_stats_t */
+    ESP_PM_EVENT_LOCK_STATS,    /*!< Statistics of a lock, posted for each lock, the event data is
+                                     esp_pm_event_lock_stats_t */
+} esp_pm_event_t;
+
+/**
+ * @brief Event data of ESP_PM_EVENT_LOCK_STATS
+ */
+typedef struct {
+    esp_pm_lock_handle_t handle;    /*!< Handle of the lock */
+    const char *name;               /*!< Name of the lock, as passed to esp_pm_lock_create, can be NULL */
+    esp_pm_lock_type_t type;        /*!< Type of the lock */
+    esp_pm_lock_stats_t stats;      /*!< Statistics of the lock */
+} esp_pm_event_lock_stats_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -150,6 +150,25 @@ static inline pm_time_t IRAM_ATTR pm_get_time(void)
 {
     return esp_timer_get_time();
 }
+
+/**
+ * @brief Count a value in a histogram of ESP_PM_HIST_BUCKETS buckets
+ */
+static inline void IRAM_ATTR pm_hist_add(uint32_t *hist, int64_t value)
+{
+    int bucket = 0;
+    /* Shift rather than count the leading zeros, which may need a library call outside of IRAM */
+    while (value > 0 && bucket < ESP_PM_HIST_BUCKETS - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    hist[bucket]++;
+}
+
+/**
+ * @brief Post ESP_PM_EVENT_LOCK_STATS for each lock, implemented in pm_locks.c
+ */
+void esp_pm_impl_post_lock_stats(void);
 #endif // WITH_PROFILING
 
 #ifdef __cplusplus
@@ -50,6 +50,10 @@
 #include "esp_private/esp_clk_utils.h"
 #include "esp_sleep.h"
 #include "esp_memory_utils.h"
+#include "esp_timer.h"
+#include "esp_freertos_hooks.h"
+#include "esp_event.h"
+#include "esp_pm_event.h"
 
 
 #if SOC_PERIPH_CLK_CTRL_SHARED
@@ -162,6 +166,32 @@ static bool s_core_idle[CONFIG_FREERTOS_NUMBER_OF_CORES];
  */
 static esp_pm_lock_handle_t s_rtos_lock_handle[CONFIG_FREERTOS_NUMBER_OF_CORES];
 
+#if CONFIG_PM_DFS_GOVERNOR
+/* With the load-based governor, a busy CPU takes s_rtos_lock_handle (CPU_FREQ_MAX) only
+ * while the load is high, and s_rtos_low_lock_handle (NO_LIGHT_SLEEP) otherwise.
+ * s_rtos_busy_lock tells which of them a busy CPU holds.
+ */
+static esp_pm_lock_handle_t s_rtos_low_lock_handle[CONFIG_FREERTOS_NUMBER_OF_CORES];
+static esp_pm_lock_handle_t s_rtos_busy_lock[CONFIG_FREERTOS_NUMBER_OF_CORES];
+
+/* Decision of the governor, the CPUs switch their lock on their next tick */
+static volatile bool s_governor_high = true;
+
+/* Busy time of each CPU since the last sample, protected using s_governor_lock */
+static portMUX_TYPE s_governor_lock = portMUX_INITIALIZER_UNLOCKED;
+static int64_t s_busy_since[CONFIG_FREERTOS_NUMBER_OF_CORES];
+static int64_t s_busy_time[CONFIG_FREERTOS_NUMBER_OF_CORES];
+static int64_t s_last_sample_time;
+static uint32_t s_governor_load;
+
+#define GOVERNOR_SAMPLE_TICKS   MAX(1, pdMS_TO_TICKS(CONFIG_PM_DFS_GOVERNOR_SAMPLE_PERIOD_MS))
+
+_Static_assert(CONFIG_PM_DFS_GOVERNOR_DOWN_THRESHOLD < CONFIG_PM_DFS_GOVERNOR_UP_THRESHOLD,
+               "PM_DFS_GOVERNOR_DOWN_THRESHOLD must be lower than PM_DFS_GOVERNOR_UP_THRESHOLD");
+
+static void governor_tick_hook(void);
+#endif // CONFIG_PM_DFS_GOVERNOR
+
 /* Lookup table of CPU frequency configs to be used in each mode.
  * Initialized by esp_pm_impl_init and modified by esp_pm_configure.
  */
@@ -189,9 +219,24 @@ static const char* s_mode_names[] = {
         "APB_MAX",
         "CPU_MAX"
 };
-static uint32_t s_light_sleep_counts, s_light_sleep_reject_counts;
+/* Light sleep counters and histograms, protected using s_switch_lock */
+static esp_pm_sleep_stats_t s_sleep_stats;
+/* Counts a reason for skipping light sleep, only while light sleep is enabled */
+#define PM_COUNT_SLEEP_SKIP(reason) do { \
+        if (s_light_sleep_en) { \
+            s_sleep_stats.skip_counts[ESP_PM_SLEEP_SKIP_ ## reason]++; \
+        } \
+    } while (0)
+#else
+#define PM_COUNT_SLEEP_SKIP(reason)
 #endif // WITH_PROFILING
 
+ESP_EVENT_DEFINE_BASE(ESP_PM_EVENT);
+
+#if CONFIG_PM_PROFILING_EVENT_PERIOD > 0
+static esp_timer_handle_t s_stats_event_timer;
+#endif
+
 #ifdef CONFIG_FREERTOS_SYSTICK_USES_CCOUNT
 /* Indicates to the ISR hook that CCOMPARE needs to be updated on the given CPU.
  * Used in conjunction with cross-core interrupt to update CCOMPARE on the other CPU.
@@ -489,6 +534,11 @@ esp_err_t esp_pm_configure(const void* vconfig)
     s_config_changed = true;
     portEXIT_CRITICAL(&s_switch_lock);
 
+#if CONFIG_PM_DFS_GOVERNOR
+    /* Start from the max frequency, the governor lowers it again if the load is low */
+    s_governor_high = true;
+#endif
+
     do_switch(PM_MODE_CPU_MAX);
     return ESP_OK;
 }
@@ -725,11 +775,71 @@ static void IRAM_ATTR leave_idle(void)
 {
     int core_id = xPortGetCoreID();
     if (s_core_idle[core_id]) {
+#if CONFIG_PM_DFS_GOVERNOR
+        s_rtos_busy_lock[core_id] = s_governor_high ? s_rtos_lock_handle[core_id] : s_rtos_low_lock_handle[core_id];
+        esp_pm_lock_acquire(s_rtos_busy_lock[core_id]);
+        portENTER_CRITICAL_ISR(&s_governor_lock);
+        s_busy_since[core_id] = esp_timer_get_time();
+        s_core_idle[core_id] = false;
+        portEXIT_CRITICAL_ISR(&s_governor_lock);
+#else
         // TODO: possible optimization: raise frequency here first
         esp_pm_lock_acquire(s_rtos_lock_handle[core_id]);
         s_core_idle[core_id] = false;
+#endif // CONFIG_PM_DFS_GOVERNOR
+    }
+}
+
+#if CONFIG_PM_DFS_GOVERNOR
+/* Called on every tick of each CPU, which is busy since it runs the tick interrupt.
+ * CPU 0 samples the load every CONFIG_PM_DFS_GOVERNOR_SAMPLE_PERIOD_MS, then
+ * each CPU switches its busy lock to follow the decision of the governor.
+ */
+static void IRAM_ATTR governor_tick_hook(void)
+{
+    static uint32_t s_ticks;
+    int core_id = xPortGetCoreID();
+
+    if (core_id == 0 && ++s_ticks >= GOVERNOR_SAMPLE_TICKS) {
+        s_ticks = 0;
+        uint32_t load = 0;
+        portENTER_CRITICAL_ISR(&s_governor_lock);
+        int64_t now = esp_timer_get_time();
+        int64_t period = now - s_last_sample_time;
+        for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+            int64_t busy = s_busy_time[i];
+            if (!s_core_idle[i]) {
+                busy += now - s_busy_since[i];
+                s_busy_since[i] = now;
+            }
+            s_busy_time[i] = 0;
+            /* The frequency is common to all CPUs, so the busiest one decides */
+            if (period > 0) {
+                load = MAX(load, (uint32_t) MIN(busy * 100 / period, 100));
+            }
+        }
+        s_last_sample_time = now;
+        s_governor_load = load;
+        portEXIT_CRITICAL_ISR(&s_governor_lock);
+
+        if (load >= CONFIG_PM_DFS_GOVERNOR_UP_THRESHOLD) {
+            s_governor_high = true;
+        } else if (load <= CONFIG_PM_DFS_GOVERNOR_DOWN_THRESHOLD) {
+            s_governor_high = false;
+        }
     }
+
+    esp_pm_lock_handle_t wanted = s_governor_high ? s_rtos_lock_handle[core_id] : s_rtos_low_lock_handle[core_id];
+    uint32_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    if (!s_core_idle[core_id] && s_rtos_busy_lock[core_id] != wanted) {
+        /* Take the new lock before releasing the old one, so that the mode does not drop in between */
+        esp_pm_lock_acquire(wanted);
+        esp_pm_lock_release(s_rtos_busy_lock[core_id]);
+        s_rtos_busy_lock[core_id] = wanted;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
 }
+#endif // CONFIG_PM_DFS_GOVERNOR
 
 #if CONFIG_FREERTOS_USE_TICKLESS_IDLE
 
@@ -784,12 +894,17 @@ static inline bool IRAM_ATTR should_skip_light_sleep(int core_id)
     if (s_skip_light_sleep[core_id]) {
         s_skip_light_sleep[core_id] = false;
         s_skipped_light_sleep[core_id] = true;
+        PM_COUNT_SLEEP_SKIP(OTHER_CORE);
         return true;
     }
 #endif // CONFIG_FREERTOS_NUMBER_OF_CORES == 2
 
-    if (s_mode != PM_MODE_LIGHT_SLEEP || s_is_switching || periph_should_skip_light_sleep()) {
+    if (s_mode != PM_MODE_LIGHT_SLEEP || s_is_switching) {
+        s_skipped_light_sleep[core_id] = true;
+        PM_COUNT_SLEEP_SKIP(LOCK);
+    } else if (periph_should_skip_light_sleep()) {
         s_skipped_light_sleep[core_id] = true;
+        PM_COUNT_SLEEP_SKIP(PERIPH);
     } else {
         s_skipped_light_sleep[core_id] = false;
     }
@@ -815,6 +930,9 @@ void IRAM_ATTR vApplicationSleep( TickType_t xExpectedIdleTime )
         int64_t wakeup_delay_us = portTICK_PERIOD_MS * 1000LL * xExpectedIdleTime;
         int64_t sleep_time_us = MIN(wakeup_delay_us, time_until_next_alarm);
         int64_t slept_us = 0;
+#ifdef WITH_PROFILING
+        int64_t sleep_end = 0;
+#endif
 #if CONFIG_PM_LIGHT_SLEEP_CALLBACKS
         uint32_t cycle = esp_cpu_get_cycle_count();
         esp_pm_execute_enter_sleep_callbacks(sleep_time_us);
@@ -825,15 +943,22 @@ void IRAM_ATTR vApplicationSleep( TickType_t xExpectedIdleTime )
             /* Enter sleep */
             ESP_PM_TRACE_ENTER(SLEEP, core_id);
             int64_t sleep_start = esp_timer_get_time();
+#ifdef WITH_PROFILING
+            pm_hist_add(s_sleep_stats.entry_latency_hist, sleep_start - now);
+#endif
             if (esp_light_sleep_start() != ESP_OK){
 #ifdef WITH_PROFILING
-                s_light_sleep_reject_counts++;
+                PM_COUNT_SLEEP_SKIP(REJECTED);
             } else {
-                s_light_sleep_counts++;
+                s_sleep_stats.light_sleep_counts++;
 #endif
             }
             slept_us = esp_timer_get_time() - sleep_start;
             ESP_PM_TRACE_EXIT(SLEEP, core_id);
+#ifdef WITH_PROFILING
+            sleep_end = sleep_start + slept_us;
+            pm_hist_add(s_sleep_stats.residency_hist, slept_us / 1000);
+#endif
 
             uint32_t slept_ticks = slept_us / (portTICK_PERIOD_MS * 1000LL);
             if (slept_ticks > 0) {
@@ -855,9 +980,16 @@ void IRAM_ATTR vApplicationSleep( TickType_t xExpectedIdleTime )
 #endif
             }
             other_core_should_skip_light_sleep(core_id);
+        } else {
+            PM_COUNT_SLEEP_SKIP(TOO_SHORT);
         }
 #if CONFIG_PM_LIGHT_SLEEP_CALLBACKS
         esp_pm_execute_exit_sleep_callbacks(slept_us);
+#endif
+#ifdef WITH_PROFILING
+        if (sleep_end != 0) {
+            pm_hist_add(s_sleep_stats.exit_latency_hist, esp_timer_get_time() - sleep_end);
+        }
 #endif
     }
     portEXIT_CRITICAL(&s_switch_lock);
@@ -865,6 +997,40 @@ void IRAM_ATTR vApplicationSleep( TickType_t xExpectedIdleTime )
 #endif //CONFIG_FREERTOS_USE_TICKLESS_IDLE
 
 #ifdef WITH_PROFILING
+/* Prints the non-empty buckets of a histogram as <lower bound>:<count> */
+static void dump_hist(FILE* out, const char* name, const uint32_t* hist)
+{
+    fprintf(out, "%-18s", name);
+    for (int i = 0; i < ESP_PM_HIST_BUCKETS; i++) {
+        if (hist[i] != 0) {
+            fprintf(out, " %lu:%"PRIu32, i == 0 ? 0 : 1UL << (i - 1), hist[i]);
+        }
+    }
+    fprintf(out, "\n");
+}
+
+esp_err_t esp_pm_get_sleep_stats(esp_pm_sleep_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_switch_lock);
+    *stats = s_sleep_stats;
+    portEXIT_CRITICAL(&s_switch_lock);
+    return ESP_OK;
+}
+
+#if CONFIG_PM_PROFILING_EVENT_PERIOD > 0
+static void post_stats_events(void *arg)
+{
+    esp_pm_sleep_stats_t stats;
+    esp_pm_get_sleep_stats(&stats);
+    // the default event loop may not exist, the statistics are then only available through the API
+    esp_event_post(ESP_PM_EVENT, ESP_PM_EVENT_SLEEP_STATS, &stats, sizeof(stats), 0);
+    esp_pm_impl_post_lock_stats();
+}
+#endif // CONFIG_PM_PROFILING_EVENT_PERIOD > 0
+
 void esp_pm_impl_dump_stats(FILE* out)
 {
     pm_time_t time_in_mode[PM_MODE_COUNT];
@@ -875,8 +1041,7 @@ void esp_pm_impl_dump_stats(FILE* out)
     pm_mode_t cur_mode = s_mode;
     pm_time_t now = pm_get_time();
     bool light_sleep_en = s_light_sleep_en;
-    uint32_t light_sleep_counts = s_light_sleep_counts;
-    uint32_t light_sleep_reject_counts = s_light_sleep_reject_counts;
+    esp_pm_sleep_stats_t sleep_stats = s_sleep_stats;
     portEXIT_CRITICAL_ISR(&s_switch_lock);
 
     time_in_mode[cur_mode] += now - last_mode_change_time;
@@ -897,8 +1062,24 @@ void esp_pm_impl_dump_stats(FILE* out)
     }
     if (light_sleep_en){
         fprintf(out, "\nSleep stats:\n");
-        fprintf(out, "light_sleep_counts:%ld  light_sleep_reject_counts:%ld\n", light_sleep_counts, light_sleep_reject_counts);
+        fprintf(out, "light_sleep_counts:%ld  light_sleep_reject_counts:%ld\n",
+                sleep_stats.light_sleep_counts, sleep_stats.skip_counts[ESP_PM_SLEEP_SKIP_REJECTED]);
+        fprintf(out, "skipped by other_core:%"PRIu32"  lock:%"PRIu32"  periph:%"PRIu32"  too_short:%"PRIu32"\n",
+                sleep_stats.skip_counts[ESP_PM_SLEEP_SKIP_OTHER_CORE], sleep_stats.skip_counts[ESP_PM_SLEEP_SKIP_LOCK],
+                sleep_stats.skip_counts[ESP_PM_SLEEP_SKIP_PERIPH], sleep_stats.skip_counts[ESP_PM_SLEEP_SKIP_TOO_SHORT]);
+        dump_hist(out, "entry_latency(us)", sleep_stats.entry_latency_hist);
+        dump_hist(out, "exit_latency(us)", sleep_stats.exit_latency_hist);
+        dump_hist(out, "residency(ms)", sleep_stats.residency_hist);
     }
+#if CONFIG_PM_DFS_GOVERNOR
+    fprintf(out, "\nGovernor stats:\n");
+    fprintf(out, "load:%"PRIu32"%%  state:%s\n", s_governor_load, s_governor_high ? "high" : "low");
+#endif
+}
+#else
+esp_err_t esp_pm_get_sleep_stats(esp_pm_sleep_stats_t *stats)
+{
+    return ESP_ERR_NOT_SUPPORTED;
 }
 #endif // WITH_PROFILING
 
@@ -960,6 +1141,22 @@ void esp_pm_impl_init(void)
     ESP_ERROR_CHECK(esp_pm_lock_acquire(s_rtos_lock_handle[1]));
 #endif // CONFIG_FREERTOS_NUMBER_OF_CORES == 2
 
+#if CONFIG_PM_DFS_GOVERNOR
+    /* The CPUs start busy, holding the CPU_FREQ_MAX locks taken above */
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "rtos0_low",
+            &s_rtos_low_lock_handle[0]));
+#if CONFIG_FREERTOS_NUMBER_OF_CORES == 2
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "rtos1_low",
+            &s_rtos_low_lock_handle[1]));
+#endif // CONFIG_FREERTOS_NUMBER_OF_CORES == 2
+    s_last_sample_time = esp_timer_get_time();
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        s_rtos_busy_lock[i] = s_rtos_lock_handle[i];
+        s_busy_since[i] = s_last_sample_time;
+        ESP_ERROR_CHECK(esp_register_freertos_tick_hook_for_cpu(governor_tick_hook, i));
+    }
+#endif // CONFIG_PM_DFS_GOVERNOR
+
     /* Configure all modes to use the default CPU frequency.
      * This will be modified later by a call to esp_pm_configure.
      */
@@ -971,6 +1168,17 @@ void esp_pm_impl_init(void)
         s_cpu_freq_by_mode[i] = default_config;
     }
 
+#if CONFIG_PM_PROFILING_EVENT_PERIOD > 0
+    const esp_timer_create_args_t stats_timer_args = {
+        .callback = post_stats_events,
+        .name = "pm_stats",
+        /* The statistics can wait for the chip to wake up */
+        .skip_unhandled_events = true,
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&stats_timer_args, &s_stats_event_timer));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(s_stats_event_timer, CONFIG_PM_PROFILING_EVENT_PERIOD * 1000000ULL));
+#endif
+
 #ifdef CONFIG_PM_DFS_INIT_AUTO
     int xtal_freq_mhz = esp_clk_xtal_freq() / MHZ;
     esp_pm_config_t cfg = {
@@ -995,8 +1203,16 @@ void esp_pm_impl_idle_hook(void)
     && !periph_should_skip_light_sleep()
 #endif
     ) {
+#if CONFIG_PM_DFS_GOVERNOR
+        portENTER_CRITICAL_ISR(&s_governor_lock);
+        s_busy_time[core_id] += esp_timer_get_time() - s_busy_since[core_id];
+        s_core_idle[core_id] = true;
+        portEXIT_CRITICAL_ISR(&s_governor_lock);
+        esp_pm_lock_release(s_rtos_busy_lock[core_id]);
+#else
         esp_pm_lock_release(s_rtos_lock_handle[core_id]);
         s_core_idle[core_id] = true;
+#endif // CONFIG_PM_DFS_GOVERNOR
     }
 #if CONFIG_FREERTOS_SMP
     portRESTORE_INTERRUPTS(state);
@@ -13,6 +13,8 @@
 #include "freertos/FreeRTOS.h"
 #include "esp_private/pm_impl.h"
 #include "esp_timer.h"
+#include "esp_event.h"
+#include "esp_pm_event.h"
 #include "sdkconfig.h"
 
 
@@ -29,6 +31,7 @@ typedef struct esp_pm_lock {
     pm_time_t time_held;            /*!< total time the lock was taken.
                                          If count > 0, this doesn't include the time since last_taken */
     size_t times_taken;             /*!< number of times the lock was ever taken */
+    uint32_t switch_latency_hist[ESP_PM_HIST_BUCKETS]; /*!< time to switch mode when the lock is taken */
 #endif
 } esp_pm_lock_t;
 
@@ -113,6 +116,7 @@ esp_err_t IRAM_ATTR esp_pm_lock_acquire(esp_pm_lock_handle_t handle)
 #ifdef WITH_PROFILING
         handle->last_taken = now;
         handle->times_taken++;
+        pm_hist_add(handle->switch_latency_hist, pm_get_time() - now);
 #endif
     }
     portEXIT_CRITICAL_SAFE(&handle->spinlock);
@@ -207,3 +211,43 @@ esp_err_t esp_pm_dump_locks(FILE* stream)
 #endif
     return ESP_OK;
 }
+
+esp_err_t esp_pm_lock_get_stats(esp_pm_lock_handle_t handle, esp_pm_lock_stats_t *stats)
+{
+#ifndef WITH_PROFILING
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    if (handle == NULL || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pm_time_t cur_time = pm_get_time();
+    portENTER_CRITICAL(&handle->spinlock);
+    stats->times_taken = handle->times_taken;
+    stats->time_held_us = handle->time_held;
+    if (handle->count > 0) {
+        stats->time_held_us += cur_time - handle->last_taken;
+    }
+    memcpy(stats->switch_latency_hist, handle->switch_latency_hist, sizeof(stats->switch_latency_hist));
+    portEXIT_CRITICAL(&handle->spinlock);
+    return ESP_OK;
+#endif // WITH_PROFILING
+}
+
+#ifdef WITH_PROFILING
+void esp_pm_impl_post_lock_stats(void)
+{
+    esp_pm_event_lock_stats_t data;
+    esp_pm_lock_t* it;
+
+    _lock_acquire(&s_list_lock);
+    SLIST_FOREACH(it, &s_list, next) {
+        data.handle = it;
+        data.name = it->name;
+        data.type = it->type;
+        esp_pm_lock_get_stats(it, &data.stats);
+        // the default event loop may not exist, the statistics are then only available through the API
+        esp_event_post(ESP_PM_EVENT, ESP_PM_EVENT_LOCK_STATS, &data, sizeof(data), 0);
+    }
+    _lock_release(&s_list_lock);
+}
+#endif // WITH_PROFILING
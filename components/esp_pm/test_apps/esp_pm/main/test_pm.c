@@ -85,6 +85,67 @@ TEST_CASE("Can switch frequency using esp_pm_configure", "[pm]")
     switch_freq(orig_freq_mhz);
 }
 
+#if CONFIG_PM_PROFILING
+TEST_CASE("Lock and sleep statistics are recorded", "[pm]")
+{
+    esp_pm_lock_handle_t lock;
+    esp_pm_lock_stats_t stats;
+    TEST_ESP_OK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "test", &lock));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_pm_lock_get_stats(lock, NULL));
+    for (int i = 0; i < 3; i++) {
+        TEST_ESP_OK(esp_pm_lock_acquire(lock));
+        // taking a lock again does not switch the mode
+        TEST_ESP_OK(esp_pm_lock_acquire(lock));
+        esp_rom_delay_us(100);
+        TEST_ESP_OK(esp_pm_lock_release(lock));
+        TEST_ESP_OK(esp_pm_lock_release(lock));
+    }
+    TEST_ESP_OK(esp_pm_lock_get_stats(lock, &stats));
+    TEST_ASSERT_EQUAL(3, stats.times_taken);
+    TEST_ASSERT_GREATER_OR_EQUAL(300, stats.time_held_us);
+    uint32_t switches = 0;
+    for (int i = 0; i < ESP_PM_HIST_BUCKETS; i++) {
+        switches += stats.switch_latency_hist[i];
+    }
+    TEST_ASSERT_EQUAL(3, switches);
+    TEST_ESP_OK(esp_pm_lock_delete(lock));
+
+    esp_pm_sleep_stats_t sleep_stats;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_pm_get_sleep_stats(NULL));
+    TEST_ESP_OK(esp_pm_get_sleep_stats(&sleep_stats));
+}
+#endif // CONFIG_PM_PROFILING
+
+#if CONFIG_PM_DFS_GOVERNOR
+TEST_CASE("Governor follows the CPU load", "[pm]")
+{
+    int max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = max_freq_mhz,
+        .min_freq_mhz = esp_clk_xtal_freq() / MHZ,
+    };
+    TEST_ESP_OK(esp_pm_configure(&pm_config));
+
+    // an idle system runs below the max frequency when it wakes up
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_PM_DFS_GOVERNOR_SAMPLE_PERIOD_MS * 5));
+    int idle_freq_mhz = esp_clk_cpu_freq() / MHZ;
+    printf("Frequency after idle: %d MHz\n", idle_freq_mhz);
+    TEST_ASSERT_LESS_THAN(max_freq_mhz, idle_freq_mhz);
+
+    // a busy system goes to the max frequency
+    int64_t end = esp_timer_get_time() + CONFIG_PM_DFS_GOVERNOR_SAMPLE_PERIOD_MS * 5 * 1000;
+    while (esp_timer_get_time() < end) {
+        esp_rom_delay_us(100);
+    }
+    int busy_freq_mhz = esp_clk_cpu_freq() / MHZ;
+    printf("Frequency when busy: %d MHz\n", busy_freq_mhz);
+    TEST_ASSERT_EQUAL(max_freq_mhz, busy_freq_mhz);
+
+    esp_pm_dump_locks(stdout);
+    switch_freq(max_freq_mhz);
+}
+#endif // CONFIG_PM_DFS_GOVERNOR
+
 #if CONFIG_FREERTOS_USE_TICKLESS_IDLE
 
 static void light_sleep_enable(void)
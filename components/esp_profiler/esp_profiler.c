@@ -0,0 +1,498 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "esp_check.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/task_snapshot.h"
+#include "driver/gptimer.h"
+#include "esp_profiler.h"
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+#include "xtensa_context.h"
+#else
+#include "riscv/rvruntime-frames.h"
+#endif
+
+static const char *TAG = "profiler";
+
+#define PROFILER_TIMER_RESOLUTION_HZ 1000000 // 1 tick = 1 us
+
+typedef struct {
+    TaskHandle_t handle;
+    esp_profiler_task_stats_t stats;
+} profiler_task_t;
+
+typedef struct {
+    gptimer_handle_t timer;
+    portMUX_TYPE lock;                  /*!< Protects the statistics from the readers, the sampler runs on this core */
+    esp_profiler_core_stats_t stats;
+    profiler_task_t *tasks;
+    size_t max_tasks;
+    size_t task_count;
+    profiler_task_t *last_task;         /*!< Task of the previous sample, most likely to be the task of the next one */
+    TaskHandle_t slice_owner;           /*!< Task running during the current run slice, NULL for an ISR */
+    uint32_t slice_samples;             /*!< Number of samples of the current run slice, 0 before the first sample */
+    uint32_t *pcs;                      /*!< PC ring */
+    size_t pc_ring_size;
+    size_t pc_next;
+    size_t pc_count;
+} profiler_core_t;
+
+typedef struct {
+    esp_profiler_config_t config;
+    profiler_core_t cores[CONFIG_FREERTOS_NUMBER_OF_CORES];
+} profiler_t;
+
+typedef struct {
+    profiler_core_t *core;
+    const esp_profiler_config_t *config;
+    SemaphoreHandle_t done;
+    esp_err_t err;
+} profiler_setup_t;
+
+static profiler_t *s_profiler;
+
+#if !CONFIG_FREERTOS_SMP
+/* Interrupt nesting level of the FreeRTOS port, increased by the entry of each interrupt */
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+extern unsigned port_interruptNesting[portNUM_PROCESSORS];
+#define PROFILER_INTERRUPT_NESTING()    port_interruptNesting[xPortGetCoreID()]
+#else
+extern volatile UBaseType_t port_uxInterruptNesting[portNUM_PROCESSORS];
+#define PROFILER_INTERRUPT_NESTING()    port_uxInterruptNesting[xPortGetCoreID()]
+#endif
+#endif // !CONFIG_FREERTOS_SMP
+
+FORCE_INLINE_ATTR uint32_t profiler_hist_bucket(uint32_t value)
+{
+    uint32_t bucket = value ? 32 - __builtin_clz(value) : 0;
+    return bucket < ESP_PROFILER_HIST_BUCKETS ? bucket : ESP_PROFILER_HIST_BUCKETS - 1;
+}
+
+/* Whether the sampling interrupt interrupted another ISR, rather than a task */
+FORCE_INLINE_ATTR bool profiler_interrupted_isr(void)
+{
+#if CONFIG_FREERTOS_SMP
+    return false;
+#else
+    return PROFILER_INTERRUPT_NESTING() > 1;
+#endif
+}
+
+static uint32_t IRAM_ATTR profiler_interrupted_pc(TaskHandle_t task)
+{
+#if CONFIG_FREERTOS_SMP
+    (void)task;
+    return 0;
+#else
+    /* When interrupting a task, the interrupt entry saves the context of the task on its stack
+     * and stores the stack pointer into the TCB */
+    TaskSnapshot_t snapshot;
+    if (task == NULL || !vTaskGetSnapshot(task, &snapshot)) {
+        return 0;
+    }
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+    return ((const XtExcFrame *)snapshot.pxTopOfStack)->pc;
+#else
+    return ((const RvExcFrame *)snapshot.pxTopOfStack)->mepc;
+#endif
+#endif // CONFIG_FREERTOS_SMP
+}
+
+/* Must be called with the lock of the core taken */
+static profiler_task_t *IRAM_ATTR profiler_find_task(profiler_core_t *core, TaskHandle_t handle)
+{
+    if (core->last_task && core->last_task->handle == handle) {
+        return core->last_task;
+    }
+    for (size_t i = 0; i < core->task_count; i++) {
+        if (core->tasks[i].handle == handle) {
+            return &core->tasks[i];
+        }
+    }
+    if (core->task_count == core->max_tasks) {
+        return NULL;
+    }
+    /* A task deleted and another one created later at the same address are accounted together */
+    profiler_task_t *task = &core->tasks[core->task_count++];
+    const char *name = pcTaskGetName(handle);
+    size_t len = 0;
+    while (len < sizeof(task->stats.name) - 1 && name[len]) {
+        task->stats.name[len] = name[len];
+        len++;
+    }
+    task->stats.name[len] = '\0';
+    task->stats.samples = 0;
+    task->handle = handle;
+    return task;
+}
+
+static bool IRAM_ATTR profiler_on_alarm(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_ctx)
+{
+    profiler_core_t *core = user_ctx;
+    /* The counter is reloaded to 0 by the alarm, hence its value is the time elapsed since the alarm */
+    uint32_t latency = (uint32_t)edata->count_value;
+    bool in_isr = profiler_interrupted_isr();
+    TaskHandle_t task = in_isr ? NULL : xTaskGetCurrentTaskHandle();
+    uint32_t pc = in_isr ? 0 : profiler_interrupted_pc(task);
+
+    portENTER_CRITICAL_ISR(&core->lock);
+    esp_profiler_core_stats_t *stats = &core->stats;
+    stats->samples++;
+    stats->latency_hist[profiler_hist_bucket(latency)]++;
+    if (latency > stats->latency_max_us) {
+        stats->latency_max_us = latency;
+    }
+    if (in_isr) {
+        stats->isr_samples++;
+    } else {
+        core->last_task = profiler_find_task(core, task);
+        if (core->last_task) {
+            core->last_task->stats.samples++;
+        } else {
+            stats->other_task_samples++;
+        }
+    }
+    if (core->slice_samples && task == core->slice_owner) {
+        core->slice_samples++;
+    } else {
+        if (core->slice_samples) {
+            stats->slice_hist[profiler_hist_bucket(core->slice_samples)]++;
+        }
+        core->slice_owner = task;
+        core->slice_samples = 1;
+    }
+    if (core->pcs) {
+        core->pcs[core->pc_next] = pc;
+        core->pc_next = (core->pc_next + 1) % core->pc_ring_size;
+        if (core->pc_count < core->pc_ring_size) {
+            core->pc_count++;
+        }
+    }
+    portEXIT_CRITICAL_ISR(&core->lock);
+    return false;
+}
+
+static esp_err_t profiler_timer_start(profiler_core_t *core, const esp_profiler_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = PROFILER_TIMER_RESOLUTION_HZ,
+        .intr_priority = config->intr_priority,
+    };
+    ESP_RETURN_ON_ERROR(gptimer_new_timer(&timer_config, &core->timer), TAG, "create timer failed");
+
+    gptimer_event_callbacks_t cbs = {
+        .on_alarm = profiler_on_alarm,
+    };
+    gptimer_alarm_config_t alarm_config = {
+        .alarm_count = config->sample_period_us,
+        .reload_count = 0,
+        .flags.auto_reload_on_alarm = true,
+    };
+    /* The interrupt is allocated on the core registering the callbacks */
+    ESP_GOTO_ON_ERROR(gptimer_register_event_callbacks(core->timer, &cbs, core), err, TAG, "register callbacks failed");
+    ESP_GOTO_ON_ERROR(gptimer_set_alarm_action(core->timer, &alarm_config), err, TAG, "set alarm failed");
+    ESP_GOTO_ON_ERROR(gptimer_enable(core->timer), err, TAG, "enable timer failed");
+    ESP_GOTO_ON_ERROR(gptimer_start(core->timer), err_disable, TAG, "start timer failed");
+    return ESP_OK;
+
+err_disable:
+    gptimer_disable(core->timer);
+err:
+    gptimer_del_timer(core->timer);
+    core->timer = NULL;
+    return ret;
+}
+
+static void profiler_timer_stop(profiler_core_t *core)
+{
+    if (core->timer) {
+        gptimer_stop(core->timer);
+        gptimer_disable(core->timer);
+        gptimer_del_timer(core->timer);
+        core->timer = NULL;
+    }
+}
+
+static void profiler_setup_task(void *arg)
+{
+    profiler_setup_t *setup = arg;
+    setup->err = profiler_timer_start(setup->core, setup->config);
+    /* setup is on the stack of the caller, it must not be accessed once done is given */
+    xSemaphoreGive(setup->done);
+    vTaskDelete(NULL);
+}
+
+static void profiler_free(profiler_t *profiler)
+{
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        profiler_timer_stop(&profiler->cores[i]);
+        free(profiler->cores[i].tasks);
+        free(profiler->cores[i].pcs);
+    }
+    free(profiler);
+}
+
+esp_err_t esp_profiler_start(const esp_profiler_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    SemaphoreHandle_t done = NULL;
+    ESP_RETURN_ON_FALSE(config && config->sample_period_us > 0 && config->max_tasks > 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(s_profiler == NULL, ESP_ERR_INVALID_STATE, TAG, "profiler already started");
+
+    /* Accessed from the sampling interrupt */
+    profiler_t *profiler = heap_caps_calloc(1, sizeof(profiler_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(profiler, ESP_ERR_NO_MEM, TAG, "no mem for profiler");
+    profiler->config = *config;
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        profiler_core_t *core = &profiler->cores[i];
+        portMUX_INITIALIZE(&core->lock);
+        core->max_tasks = config->max_tasks;
+        core->tasks = heap_caps_calloc(config->max_tasks, sizeof(profiler_task_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        ESP_GOTO_ON_FALSE(core->tasks, ESP_ERR_NO_MEM, err, TAG, "no mem for tasks");
+        if (config->pc_ring_size) {
+            core->pc_ring_size = config->pc_ring_size;
+            core->pcs = heap_caps_calloc(config->pc_ring_size, sizeof(uint32_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+            ESP_GOTO_ON_FALSE(core->pcs, ESP_ERR_NO_MEM, err, TAG, "no mem for pc samples");
+        }
+    }
+    done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(done, ESP_ERR_NO_MEM, err, TAG, "no mem for semaphore");
+    s_profiler = profiler;
+
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        profiler_setup_t setup = {
+            .core = &profiler->cores[i],
+            .config = &profiler->config,
+            .done = done,
+            .err = ESP_OK,
+        };
+        /* The sampling interrupt of each core must be allocated from that core */
+        BaseType_t res = xTaskCreatePinnedToCore(profiler_setup_task, "profiler", 3072, &setup,
+                                                 uxTaskPriorityGet(NULL), NULL, i);
+        ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "create setup task failed");
+        xSemaphoreTake(done, portMAX_DELAY);
+        ESP_GOTO_ON_ERROR(setup.err, err, TAG, "start sampling core %d failed", i);
+    }
+    vSemaphoreDelete(done);
+    return ESP_OK;
+
+err:
+    s_profiler = NULL;
+    profiler_free(profiler);
+    if (done) {
+        vSemaphoreDelete(done);
+    }
+    return ret;
+}
+
+esp_err_t esp_profiler_stop(void)
+{
+    ESP_RETURN_ON_FALSE(s_profiler, ESP_ERR_INVALID_STATE, TAG, "profiler not started");
+    profiler_t *profiler = s_profiler;
+    /* Deleting the timers frees their interrupts, no sampling interrupt can be running afterwards */
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        profiler_timer_stop(&profiler->cores[i]);
+    }
+    s_profiler = NULL;
+    profiler_free(profiler);
+    return ESP_OK;
+}
+
+esp_err_t esp_profiler_reset(void)
+{
+    ESP_RETURN_ON_FALSE(s_profiler, ESP_ERR_INVALID_STATE, TAG, "profiler not started");
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        profiler_core_t *core = &s_profiler->cores[i];
+        portENTER_CRITICAL(&core->lock);
+        memset(&core->stats, 0, sizeof(core->stats));
+        core->task_count = 0;
+        core->last_task = NULL;
+        core->slice_owner = NULL;
+        core->slice_samples = 0;
+        core->pc_next = 0;
+        core->pc_count = 0;
+        portEXIT_CRITICAL(&core->lock);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_profiler_get_core_stats(int core_id, esp_profiler_core_stats_t *stats, esp_profiler_task_stats_t *tasks, size_t *task_count)
+{
+    ESP_RETURN_ON_FALSE(core_id >= 0 && core_id < CONFIG_FREERTOS_NUMBER_OF_CORES && stats && (tasks || !task_count),
+                        ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(s_profiler, ESP_ERR_INVALID_STATE, TAG, "profiler not started");
+    profiler_core_t *core = &s_profiler->cores[core_id];
+    portENTER_CRITICAL(&core->lock);
+    *stats = core->stats;
+    if (task_count) {
+        size_t count = MIN(*task_count, core->task_count);
+        for (size_t i = 0; i < count; i++) {
+            tasks[i] = core->tasks[i].stats;
+        }
+        *task_count = count;
+    }
+    portEXIT_CRITICAL(&core->lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_profiler_get_pc_samples(int core_id, uint32_t *pcs, size_t *count)
+{
+    ESP_RETURN_ON_FALSE(core_id >= 0 && core_id < CONFIG_FREERTOS_NUMBER_OF_CORES && pcs && count,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(s_profiler, ESP_ERR_INVALID_STATE, TAG, "profiler not started");
+    profiler_core_t *core = &s_profiler->cores[core_id];
+    portENTER_CRITICAL(&core->lock);
+    size_t n = MIN(*count, core->pc_count);
+    /* Most recent samples, oldest first */
+    for (size_t i = 0; i < n; i++) {
+        pcs[i] = core->pcs[(core->pc_next + core->pc_ring_size - n + i) % core->pc_ring_size];
+    }
+    *count = n;
+    portEXIT_CRITICAL(&core->lock);
+    return ESP_OK;
+}
+
+static void profiler_print_json_string(FILE *stream, const char *str)
+{
+    fputc('"', stream);
+    for (; *str; str++) {
+        if (*str == '"' || *str == '\\') {
+            fputc('\\', stream);
+        }
+        if ((unsigned char)*str >= 0x20) {
+            fputc(*str, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+static void profiler_print_json_hist(FILE *stream, const char *name, const uint32_t *hist)
+{
+    fprintf(stream, "\"%s\":[", name);
+    for (int i = 0; i < ESP_PROFILER_HIST_BUCKETS; i++) {
+        fprintf(stream, "%s%" PRIu32, i ? "," : "", hist[i]);
+    }
+    fputc(']', stream);
+}
+
+static void profiler_print_text_hist(FILE *stream, const char *title, const uint32_t *hist, uint32_t unit)
+{
+    fprintf(stream, "  %s:\n", title);
+    for (int i = 0; i < ESP_PROFILER_HIST_BUCKETS; i++) {
+        if (hist[i] == 0) {
+            continue;
+        }
+        if (i == 0) {
+            fprintf(stream, "    0: %" PRIu32 "\n", hist[i]);
+        } else if (i == ESP_PROFILER_HIST_BUCKETS - 1) {
+            fprintf(stream, "    >= %" PRIu32 ": %" PRIu32 "\n", (UINT32_C(1) << (i - 1)) * unit, hist[i]);
+        } else {
+            fprintf(stream, "    [%" PRIu32 ", %" PRIu32 "): %" PRIu32 "\n", (UINT32_C(1) << (i - 1)) * unit,
+                    (UINT32_C(1) << i) * unit, hist[i]);
+        }
+    }
+}
+
+static void profiler_print_core(FILE *stream, esp_profiler_format_t format, int core_id, const esp_profiler_core_stats_t *stats,
+                                const esp_profiler_task_stats_t *tasks, size_t task_count, const uint32_t *pcs, size_t pc_count)
+{
+    uint32_t period = s_profiler->config.sample_period_us;
+    uint32_t total = stats->samples ? stats->samples : 1;
+
+    if (format == ESP_PROFILER_FORMAT_JSON) {
+        fprintf(stream, "{\"core\":%d,\"samples\":%" PRIu32 ",\"isr_samples\":%" PRIu32 ",\"other_task_samples\":%" PRIu32
+                ",\"latency_max_us\":%" PRIu32 ",", core_id, stats->samples, stats->isr_samples, stats->other_task_samples,
+                stats->latency_max_us);
+        profiler_print_json_hist(stream, "latency_hist", stats->latency_hist);
+        fputc(',', stream);
+        profiler_print_json_hist(stream, "slice_hist", stats->slice_hist);
+        fprintf(stream, ",\"tasks\":[");
+        for (size_t i = 0; i < task_count; i++) {
+            fprintf(stream, "%s{\"name\":", i ? "," : "");
+            profiler_print_json_string(stream, tasks[i].name);
+            fprintf(stream, ",\"samples\":%" PRIu32 "}", tasks[i].samples);
+        }
+        fprintf(stream, "],\"pcs\":[");
+        for (size_t i = 0; i < pc_count; i++) {
+            fprintf(stream, "%s\"0x%08" PRIx32 "\"", i ? "," : "", pcs[i]);
+        }
+        fprintf(stream, "]}");
+        return;
+    }
+
+    fprintf(stream, "Core %d: %" PRIu32 " samples\n", core_id, stats->samples);
+    fprintf(stream, "  %-*s %10s %7s\n", configMAX_TASK_NAME_LEN, "Task", "Samples", "CPU");
+    for (size_t i = 0; i < task_count; i++) {
+        fprintf(stream, "  %-*s %10" PRIu32 " %6" PRIu32 "%%\n", configMAX_TASK_NAME_LEN, tasks[i].name, tasks[i].samples,
+                tasks[i].samples * 100 / total);
+    }
+    if (stats->other_task_samples) {
+        fprintf(stream, "  %-*s %10" PRIu32 " %6" PRIu32 "%%\n", configMAX_TASK_NAME_LEN, "(other tasks)",
+                stats->other_task_samples, stats->other_task_samples * 100 / total);
+    }
+    fprintf(stream, "  %-*s %10" PRIu32 " %6" PRIu32 "%%\n", configMAX_TASK_NAME_LEN, "(ISR)", stats->isr_samples,
+            stats->isr_samples * 100 / total);
+    fprintf(stream, "  Sampling interrupt latency: max %" PRIu32 " us\n", stats->latency_max_us);
+    profiler_print_text_hist(stream, "Latency (us)", stats->latency_hist, 1);
+    profiler_print_text_hist(stream, "Run slices (us)", stats->slice_hist, period);
+    if (pc_count) {
+        fprintf(stream, "  PC samples (oldest first):");
+        for (size_t i = 0; i < pc_count; i++) {
+            fprintf(stream, "%s0x%08" PRIx32, i % 8 ? " " : "\n    ", pcs[i]);
+        }
+        fputc('\n', stream);
+    }
+}
+
+esp_err_t esp_profiler_print(FILE *stream, esp_profiler_format_t format)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(stream && (format == ESP_PROFILER_FORMAT_TEXT || format == ESP_PROFILER_FORMAT_JSON),
+                        ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(s_profiler, ESP_ERR_INVALID_STATE, TAG, "profiler not started");
+
+    esp_profiler_task_stats_t *tasks = calloc(s_profiler->config.max_tasks, sizeof(esp_profiler_task_stats_t));
+    uint32_t *pcs = calloc(s_profiler->config.pc_ring_size ? s_profiler->config.pc_ring_size : 1, sizeof(uint32_t));
+    ESP_GOTO_ON_FALSE(tasks && pcs, ESP_ERR_NO_MEM, err, TAG, "no mem for snapshot");
+
+    if (format == ESP_PROFILER_FORMAT_JSON) {
+        fprintf(stream, "{\"sample_period_us\":%" PRIu32 ",\"cores\":[", s_profiler->config.sample_period_us);
+    } else {
+        fprintf(stream, "Sampling period: %" PRIu32 " us\n", s_profiler->config.sample_period_us);
+    }
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        esp_profiler_core_stats_t stats;
+        size_t task_count = s_profiler->config.max_tasks;
+        size_t pc_count = s_profiler->config.pc_ring_size;
+        esp_profiler_get_core_stats(i, &stats, tasks, &task_count);
+        esp_profiler_get_pc_samples(i, pcs, &pc_count);
+        if (format == ESP_PROFILER_FORMAT_JSON && i > 0) {
+            fputc(',', stream);
+        }
+        profiler_print_core(stream, format, i, &stats, tasks, task_count, pcs, pc_count);
+    }
+    if (format == ESP_PROFILER_FORMAT_JSON) {
+        fprintf(stream, "]}\n");
+    }
+
+err:
+    free(tasks);
+    free(pcs);
+    return ret;
+}
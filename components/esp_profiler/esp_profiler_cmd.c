@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_console.h"
+#include "esp_err.h"
+#include "esp_profiler.h"
+
+static int profiler_cmd(int argc, char **argv)
+{
+    const char *action = argc > 1 ? argv[1] : "show";
+    esp_err_t err;
+
+    if (strcmp(action, "start") == 0) {
+        esp_profiler_config_t config = ESP_PROFILER_DEFAULT_CONFIG();
+        err = esp_profiler_start(&config);
+    } else if (strcmp(action, "stop") == 0) {
+        err = esp_profiler_stop();
+    } else if (strcmp(action, "reset") == 0) {
+        err = esp_profiler_reset();
+    } else if (strcmp(action, "show") == 0) {
+        err = esp_profiler_print(stdout, ESP_PROFILER_FORMAT_TEXT);
+    } else if (strcmp(action, "json") == 0) {
+        err = esp_profiler_print(stdout, ESP_PROFILER_FORMAT_JSON);
+    } else {
+        printf("%s: unknown argument '%s'\n", argv[0], action);
+        return 1;
+    }
+    if (err != ESP_OK) {
+        printf("%s %s: %s\n", argv[0], action, esp_err_to_name(err));
+        return 1;
+    }
+    return 0;
+}
+
+esp_err_t esp_profiler_register_console_cmd(void)
+{
+    const esp_console_cmd_t cmd = {
+        .command = "profiler",
+        .help = "Control the on-device profiler and print the CPU usage of the tasks and the interrupt latency",
+        .hint = "[start|stop|reset|show|json]",
+        .func = profiler_cmd,
+    };
+    return esp_console_cmd_register(&cmd);
+}
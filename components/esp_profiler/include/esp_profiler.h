@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of buckets of the histograms
+ *
+ * Bucket 0 counts the values equal to 0, bucket i (i > 0) counts the values in [2^(i-1), 2^i),
+ * the last bucket also counts all the larger values.
+ */
+#define ESP_PROFILER_HIST_BUCKETS 16
+
+/**
+ * @brief Profiler configuration
+ */
+typedef struct {
+    uint32_t sample_period_us;  /*!< Sampling period, in microseconds */
+    size_t max_tasks;           /*!< Max number of tasks accounted per core, the samples of the other tasks are accounted together */
+    size_t pc_ring_size;        /*!< Number of most recent PC samples kept per core, 0 to not record them */
+    int intr_priority;          /*!< Priority of the sampling interrupt, 0 to use the default priority */
+} esp_profiler_config_t;
+
+/**
+ * @brief Default profiler configuration
+ */
+#define ESP_PROFILER_DEFAULT_CONFIG() { \
+    .sample_period_us = 1000,           \
+    .max_tasks = 16,                    \
+    .pc_ring_size = 64,                 \
+    .intr_priority = 0,                 \
+}
+
+/**
+ * @brief Samples of a task
+ */
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN]; /*!< Name of the task when it was sampled for the first time */
+    uint32_t samples;                   /*!< Number of samples in which the task was running */
+} esp_profiler_task_stats_t;
+
+/**
+ * @brief Statistics of a core
+ */
+typedef struct {
+    uint32_t samples;                                   /*!< Total number of samples */
+    uint32_t isr_samples;                               /*!< Number of samples which interrupted another ISR */
+    uint32_t other_task_samples;                        /*!< Number of samples of the tasks beyond esp_profiler_config_t::max_tasks */
+    uint32_t latency_max_us;                            /*!< Max latency of the sampling interrupt */
+    uint32_t latency_hist[ESP_PROFILER_HIST_BUCKETS];   /*!< Histogram of the latency of the sampling interrupt, in microseconds */
+    uint32_t slice_hist[ESP_PROFILER_HIST_BUCKETS];     /*!< Histogram of the run slices of the tasks and ISRs, in sampling periods */
+} esp_profiler_core_stats_t;
+
+/**
+ * @brief Output format of esp_profiler_print()
+ */
+typedef enum {
+    ESP_PROFILER_FORMAT_TEXT,   /*!< Human readable tables */
+    ESP_PROFILER_FORMAT_JSON,   /*!< Single JSON object, e.g. to be served over HTTP */
+} esp_profiler_format_t;
+
+/**
+ * @brief Start sampling all the cores
+ *
+ * A timer interrupt is allocated on each core. At each period, it records the task running on the core,
+ * or that an ISR was running, the PC of the interrupted code and its own latency.
+ *
+ * @note The profiler is enabled once at a time. This function, esp_profiler_stop() and the other functions
+ *       of the profiler must not be called concurrently.
+ *
+ * @param[in] config Profiler configuration
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the configuration is invalid
+ *      - ESP_ERR_INVALID_STATE if the profiler is already started
+ *      - ESP_ERR_NO_MEM if out of memory
+ *      - Other errors returned by the GPTimer driver
+ */
+esp_err_t esp_profiler_start(const esp_profiler_config_t *config);
+
+/**
+ * @brief Stop sampling and free the statistics
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the profiler is not started
+ */
+esp_err_t esp_profiler_stop(void);
+
+/**
+ * @brief Clear the statistics of all the cores, sampling goes on
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the profiler is not started
+ */
+esp_err_t esp_profiler_reset(void);
+
+/**
+ * @brief Get a snapshot of the statistics of a core
+ *
+ * @param[in]     core_id     Core to get the statistics of
+ * @param[out]    stats       Statistics of the core
+ * @param[out]    tasks       Array receiving the statistics of the tasks, can be NULL if task_count is NULL
+ * @param[in,out] task_count  Capacity of the tasks array as an input, number of entries filled in as an output.
+ *                            Can be NULL if the statistics of the tasks are not needed.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the profiler is not started
+ */
+esp_err_t esp_profiler_get_core_stats(int core_id, esp_profiler_core_stats_t *stats, esp_profiler_task_stats_t *tasks, size_t *task_count);
+
+/**
+ * @brief Get the most recent PC samples of a core, oldest first
+ *
+ * A sample is 0 when the PC of the interrupted code could not be recorded, e.g., when an ISR was interrupted.
+ * The addresses can be converted to functions with ``xtensa-esp32-elf-addr2line`` or ``riscv32-esp-elf-addr2line``.
+ *
+ * @param[in]     core_id  Core to get the samples of
+ * @param[out]    pcs      Array receiving the samples
+ * @param[in,out] count    Capacity of the array as an input, number of samples filled in as an output
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the profiler is not started
+ */
+esp_err_t esp_profiler_get_pc_samples(int core_id, uint32_t *pcs, size_t *count);
+
+/**
+ * @brief Print the statistics of all the cores
+ *
+ * @param[in] stream  Stream to print to, e.g. stdout, or a memory stream opened with open_memstream()
+ * @param[in] format  Output format
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the profiler is not started
+ *      - ESP_ERR_NO_MEM if out of memory
+ */
+esp_err_t esp_profiler_print(FILE *stream, esp_profiler_format_t format);
+
+/**
+ * @brief Register the ``profiler`` console command
+ *
+ * The command takes one of the arguments ``start``, ``stop``, ``reset``, ``show`` (default) and ``json``.
+ * ``start`` uses the default configuration.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - Other errors returned by esp_console_cmd_register()
+ */
+esp_err_t esp_profiler_register_console_cmd(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_cpu.h"
+#include "unity.h"
+#include "esp_profiler.h"
+
+#define TEST_MAX_TASKS 16
+
+static void busy_task(void *arg)
+{
+    SemaphoreHandle_t done = arg;
+    TickType_t start = xTaskGetTickCount();
+    // keep the CPU for 100 ms without blocking
+    while (xTaskGetTickCount() - start < pdMS_TO_TICKS(100)) {
+        esp_cpu_get_cycle_count();
+    }
+    xSemaphoreGive(done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("profiler accounts the samples of a busy task", "[profiler]")
+{
+    esp_profiler_config_t config = ESP_PROFILER_DEFAULT_CONFIG();
+    SemaphoreHandle_t done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(done);
+
+    TEST_ESP_OK(esp_profiler_start(&config));
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(busy_task, "busy", 2048, done, uxTaskPriorityGet(NULL) + 1, NULL, 0));
+    xSemaphoreTake(done, portMAX_DELAY);
+
+    esp_profiler_core_stats_t stats;
+    esp_profiler_task_stats_t tasks[TEST_MAX_TASKS];
+    size_t task_count = TEST_MAX_TASKS;
+    TEST_ESP_OK(esp_profiler_get_core_stats(0, &stats, tasks, &task_count));
+    TEST_ESP_OK(esp_profiler_stop());
+    vSemaphoreDelete(done);
+
+    uint32_t busy_samples = 0;
+    uint32_t task_samples = 0;
+    for (size_t i = 0; i < task_count; i++) {
+        if (strcmp(tasks[i].name, "busy") == 0) {
+            busy_samples = tasks[i].samples;
+        }
+        task_samples += tasks[i].samples;
+    }
+    // 100 ms at 1 sample per ms, the busy task had the CPU most of the time
+    TEST_ASSERT_GREATER_THAN(50, stats.samples);
+    TEST_ASSERT_GREATER_THAN(stats.samples / 2, busy_samples);
+    TEST_ASSERT_EQUAL(stats.samples, task_samples + stats.isr_samples + stats.other_task_samples);
+
+    uint32_t latency_samples = 0;
+    for (int i = 0; i < ESP_PROFILER_HIST_BUCKETS; i++) {
+        latency_samples += stats.latency_hist[i];
+    }
+    TEST_ASSERT_EQUAL(stats.samples, latency_samples);
+}
+
+TEST_CASE("profiler records PC samples", "[profiler]")
+{
+    esp_profiler_config_t config = ESP_PROFILER_DEFAULT_CONFIG();
+    uint32_t pcs[8];
+    size_t count = 8;
+
+    TEST_ESP_OK(esp_profiler_start(&config));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ESP_OK(esp_profiler_get_pc_samples(0, pcs, &count));
+    TEST_ESP_OK(esp_profiler_reset());
+    esp_profiler_core_stats_t stats;
+    TEST_ESP_OK(esp_profiler_get_core_stats(0, &stats, NULL, NULL));
+    TEST_ESP_OK(esp_profiler_stop());
+
+    TEST_ASSERT_EQUAL(8, count);
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (pcs[i] != 0) {
+            valid++;
+        }
+    }
+#if !CONFIG_FREERTOS_SMP
+    TEST_ASSERT_GREATER_THAN(0, valid);
+#endif
+    // the reset happened a few microseconds ago at most
+    TEST_ASSERT_LESS_THAN(2, stats.samples);
+}
+
+TEST_CASE("profiler prints JSON and text summaries", "[profiler]")
+{
+    esp_profiler_config_t config = ESP_PROFILER_DEFAULT_CONFIG();
+    char *buf = NULL;
+    size_t len = 0;
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_profiler_print(stdout, ESP_PROFILER_FORMAT_TEXT));
+    TEST_ESP_OK(esp_profiler_start(&config));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_profiler_start(&config));
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    FILE *stream = open_memstream(&buf, &len);
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ESP_OK(esp_profiler_print(stream, ESP_PROFILER_FORMAT_JSON));
+    fclose(stream);
+    TEST_ESP_OK(esp_profiler_print(stdout, ESP_PROFILER_FORMAT_TEXT));
+    TEST_ESP_OK(esp_profiler_stop());
+
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL('{', buf[0]);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"cores\":[{\"core\":0,"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"latency_hist\":["));
+    free(buf);
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_profiler_stop());
+    config.sample_period_us = 0;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_profiler_start(&config));
+}
@@ -55,6 +55,24 @@ esp_err_t esp_psram_extram_reserve_dma_pool(size_t size);
  */
 bool esp_psram_extram_test(void);
 
+/**
+ * @brief Memory test for the PSRAM which is not added to the heap allocator.
+ *
+ * Used on initialization instead of esp_psram_extram_test() when CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
+ * is enabled, the rest of the PSRAM is tested in the background before being added to the heap allocator.
+ *
+ * @return true on success, false on failed memory test
+ */
+bool esp_psram_extram_test_non_heap(void);
+
+/**
+ * @brief Check whether the background memory test of the PSRAM heap has finished
+ *
+ * @return true if all the PSRAM heap has been tested and added to the heap allocator, or if
+ *         CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND is disabled
+ */
+bool esp_psram_extram_background_test_done(void);
+
 /**
  * @brief Init .bss on psram
  */
@@ -17,6 +17,7 @@
 #include "esp_err.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_heap_caps_init.h"
 #include "esp_psram.h"
 #include "esp_mmu_map.h"
@@ -29,6 +30,9 @@
 #include "esp_private/esp_mmu_map_private.h"
 #include "esp_private/esp_psram_impl.h"
 #include "esp_private/startup_internal.h"
+#if CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
+#include "esp_task.h"
+#endif
 #if SOC_SPIRAM_XIP_SUPPORTED
 #include "esp_private/mmu_psram_flash.h"
 #endif
@@ -100,15 +104,22 @@ typedef struct {
 static psram_ctx_t s_psram_ctx;
 static const DRAM_ATTR char TAG[] = "esp_psram";
 
+#if CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
+static volatile bool s_background_test_done;
+#endif
+
 ESP_SYSTEM_INIT_FN(add_psram_to_heap, CORE, BIT(0), 103)
 {
 #if CONFIG_SPIRAM_BOOT_INIT && (CONFIG_SPIRAM_USE_CAPS_ALLOC || CONFIG_SPIRAM_USE_MALLOC)
     if (esp_psram_is_initialized()) {
+#if !CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
+        // Otherwise, the PSRAM is added to the heap by the background memory test
         esp_err_t r = esp_psram_extram_add_to_heap_allocator();
         if (r != ESP_OK) {
             ESP_EARLY_LOGE(TAG, "External RAM could not be added to heap!");
             abort();
         }
+#endif
 #if CONFIG_SPIRAM_USE_MALLOC
         heap_caps_malloc_extmem_enable(CONFIG_SPIRAM_MALLOC_ALWAYSINTERNAL);
 #endif
@@ -385,24 +396,32 @@ esp_err_t esp_psram_init(void)
     return ESP_OK;
 }
 
+static esp_err_t s_add_region_to_heap(int mem_type, intptr_t start, intptr_t end)
+{
+    if (mem_type == PSRAM_MEM_8BIT_ALIGNED) {
+        uint32_t byte_aligned_caps[] = {MALLOC_CAP_SPIRAM | MALLOC_CAP_DEFAULT, 0, MALLOC_CAP_8BIT | MALLOC_CAP_32BIT | MALLOC_CAP_SIMD};
+        return heap_caps_add_region_with_caps(byte_aligned_caps, start, end);
+    }
+    uint32_t word_aligned_caps[] = {MALLOC_CAP_SPIRAM | MALLOC_CAP_DEFAULT, 0, MALLOC_CAP_32BIT};
+    return heap_caps_add_region_with_caps(word_aligned_caps, start, end);
+}
+
 esp_err_t esp_psram_extram_add_to_heap_allocator(void)
 {
     esp_err_t ret = ESP_FAIL;
 
-    uint32_t byte_aligned_caps[] = {MALLOC_CAP_SPIRAM | MALLOC_CAP_DEFAULT, 0, MALLOC_CAP_8BIT | MALLOC_CAP_32BIT | MALLOC_CAP_SIMD};
-    ret = heap_caps_add_region_with_caps(byte_aligned_caps,
-                                         s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_start,
-                                         s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_end);
+    ret = s_add_region_to_heap(PSRAM_MEM_8BIT_ALIGNED,
+                               s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_start,
+                               s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_end);
     if (ret != ESP_OK) {
         return ret;
     }
 
     if (s_psram_ctx.regions_to_heap[PSRAM_MEM_32BIT_ALIGNED].size) {
         assert(s_psram_ctx.regions_to_heap[PSRAM_MEM_32BIT_ALIGNED].vaddr_start);
-        uint32_t word_aligned_caps[] = {MALLOC_CAP_SPIRAM | MALLOC_CAP_DEFAULT, 0, MALLOC_CAP_32BIT};
-        ret = heap_caps_add_region_with_caps(word_aligned_caps,
-                                             s_psram_ctx.regions_to_heap[PSRAM_MEM_32BIT_ALIGNED].vaddr_start,
-                                             s_psram_ctx.regions_to_heap[PSRAM_MEM_32BIT_ALIGNED].vaddr_end);
+        ret = s_add_region_to_heap(PSRAM_MEM_32BIT_ALIGNED,
+                                   s_psram_ctx.regions_to_heap[PSRAM_MEM_32BIT_ALIGNED].vaddr_start,
+                                   s_psram_ctx.regions_to_heap[PSRAM_MEM_32BIT_ALIGNED].vaddr_end);
         if (ret != ESP_OK) {
             return ret;
         }
@@ -506,11 +525,8 @@ static bool s_test_psram(intptr_t v_start, size_t size, intptr_t reserved_start,
     if (errct) {
         ESP_EARLY_LOGE(TAG, "SPI SRAM memory test fail. %d/%d writes failed, first @ %X", errct, size / 32, initial_err + v_start);
         return false;
-    } else {
-        ESP_EARLY_LOGI(TAG, "SPI SRAM memory test OK");
-        return true;
     }
-
+    return true;
 }
 
 bool esp_psram_extram_test(void)
@@ -541,8 +557,86 @@ bool esp_psram_extram_test(void)
         return false;
     }
 
+    ESP_EARLY_LOGI(TAG, "SPI SRAM memory test OK");
+    return true;
+}
+
+bool esp_psram_extram_test_non_heap(void)
+{
+#if CONFIG_SPIRAM_ALLOW_NOINIT_SEG_EXTERNAL_MEMORY
+    intptr_t noinit_vstart = (intptr_t)&_ext_ram_noinit_start;
+    intptr_t noinit_vend = (intptr_t)&_ext_ram_noinit_end;
+#else
+    intptr_t noinit_vstart = 0;
+    intptr_t noinit_vend = 0;
+#endif
+    for (int i = 0; i < PSRAM_MEM_TYPE_NUM; i++) {
+        const psram_mem_t *mapped = &s_psram_ctx.mapped_regions[i];
+        const psram_mem_t *heap = &s_psram_ctx.regions_to_heap[i];
+        if (mapped->size == 0) {
+            continue;
+        }
+        // The heap region is inside the mapped region, test what is before and after it
+        if (!s_test_psram(mapped->vaddr_start, heap->vaddr_start - mapped->vaddr_start, noinit_vstart, noinit_vend) ||
+                !s_test_psram(heap->vaddr_end, mapped->vaddr_end - heap->vaddr_end, noinit_vstart, noinit_vend)) {
+            return false;
+        }
+    }
+
+    ESP_EARLY_LOGI(TAG, "SPI SRAM memory test OK, the heap is tested in the background");
+    return true;
+}
+
+bool esp_psram_extram_background_test_done(void)
+{
+#if CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
+    return s_background_test_done;
+#else
     return true;
+#endif
+}
+
+#if CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
+#define PSRAM_MEMTEST_CHUNK_SIZE    (CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND_CHUNK_SIZE * 1024)
+
+static void s_psram_memtest_task(void *arg)
+{
+    size_t added_size = 0;
+    for (int i = 0; i < PSRAM_MEM_TYPE_NUM; i++) {
+        const psram_mem_t *region = &s_psram_ctx.regions_to_heap[i];
+        if (region->size == 0) {
+            continue;
+        }
+        for (intptr_t start = region->vaddr_start; start < region->vaddr_end; start += PSRAM_MEMTEST_CHUNK_SIZE) {
+            intptr_t end = MIN(start + PSRAM_MEMTEST_CHUNK_SIZE, region->vaddr_end);
+            if (!s_test_psram(start, end - start, 0, 0)) {
+                ESP_LOGE(TAG, "PSRAM at %p-%p failed the memory test, not adding it to heap", (void *)start, (void *)end);
+                continue;
+            }
+            esp_err_t ret = s_add_region_to_heap(i, start, end);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "PSRAM at %p-%p could not be added to heap (0x%x)", (void *)start, (void *)end, ret);
+                continue;
+            }
+            added_size += end - start;
+        }
+    }
+    ESP_LOGI(TAG, "Background memory test done, added %dK of PSRAM memory to heap allocator", added_size / 1024);
+    s_background_test_done = true;
+    vTaskDelete(NULL);
+}
+
+ESP_SYSTEM_INIT_FN(start_psram_memtest_in_background, SECONDARY, BIT(0), 250)
+{
+    if (!esp_psram_is_initialized()) {
+        s_background_test_done = true;
+        return ESP_OK;
+    }
+    BaseType_t res = xTaskCreatePinnedToCore(s_psram_memtest_task, "psram_test", ESP_TASK_PSRAM_MEMTEST_STACK, NULL,
+                                             ESP_TASK_PSRAM_MEMTEST_PRIO, NULL, tskNO_AFFINITY);
+    return (res == pdTRUE) ? ESP_OK : ESP_ERR_NO_MEM;
 }
+#endif // CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
 
 void esp_psram_bss_init(void)
 {
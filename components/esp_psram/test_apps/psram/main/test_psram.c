@@ -22,8 +22,18 @@
 
 __attribute__((unused)) const static char *TAG = "PSRAM";
 
+static void s_wait_background_test_done(void)
+{
+    // With CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND, PSRAM is added to the heap while it is tested
+    for (int i = 0; i < 100 && !esp_psram_extram_background_test_done(); i++) {
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    TEST_ASSERT_TRUE(esp_psram_extram_background_test_done());
+}
+
 static void s_test_psram_heap_allocable(void)
 {
+    s_wait_background_test_done();
     size_t largest_size = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
     ESP_LOGI(TAG, "largest size is %zu", largest_size);
 
@@ -198,3 +208,19 @@ TEST_CASE("test psram unaligned access", "[psram]")
 
     heap_caps_free(ext_buffer);
 }
+
+#if CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
+TEST_CASE("test psram heap is added in chunks by the background memory test", "[psram]")
+{
+    s_wait_background_test_done();
+    size_t total_size = heap_caps_get_total_size(MALLOC_CAP_SPIRAM);
+    TEST_ASSERT_GREATER_THAN(0, total_size);
+    // each chunk is a separate heap
+    TEST_ASSERT_LESS_OR_EQUAL(CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND_CHUNK_SIZE * 1024, heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM));
+
+    void *p = heap_caps_malloc(CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND_CHUNK_SIZE * 1024 / 2, MALLOC_CAP_SPIRAM);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT(esp_psram_check_ptr_addr(p));
+    heap_caps_free(p);
+}
+#endif
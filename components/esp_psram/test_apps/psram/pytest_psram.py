@@ -78,7 +78,7 @@ def test_psram_esp32s3_octal(dut: Dut) -> None:
 @pytest.mark.generic
 @pytest.mark.parametrize(
     'config',
-    ['esp32p4_200m_release', 'esp32p4_xip'],
+    ['esp32p4_200m_release', 'esp32p4_xip', 'esp32p4_memtest_background'],
     indirect=True,
 )
 @idf_parametrize('target', ['esp32p4'], indirect=['target'])
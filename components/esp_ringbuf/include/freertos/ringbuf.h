@@ -41,6 +41,18 @@ typedef enum {
      * time.
      */
     RINGBUF_TYPE_BYTEBUF,
+    /**
+     * Single-producer/single-consumer byte buffers behave like byte buffers,
+     * but data is sent and received without entering a critical section as
+     * long as no task needs to block or be unblocked. Only a single task or
+     * ISR may send to the buffer, and only a single task or ISR may receive
+     * from it. One byte of the storage area is kept free to tell a full buffer
+     * from an empty one, so at most (buffer size - 1) bytes can be stored.
+     * Every byte sent since the last receive is retrieved in one call (up to
+     * the end of the storage area), so a receiver can drain many small sends
+     * per call. Queue sets are not supported.
+     */
+    RINGBUF_TYPE_BYTEBUF_SPSC,
     RINGBUF_TYPE_MAX,
 } RingbufferType_t;
 
@@ -61,10 +73,25 @@ typedef struct xSTATIC_RINGBUFFER {
     BaseType_t xDummy4;
     StaticList_t xDummy5[2];
     void * pvDummy6;
+    BaseType_t xDummy7[2];
     portMUX_TYPE muxDummy;
     /** @endcond */
 } StaticRingbuffer_t;
 
+/**
+ * @brief Size of the header preceding each item in no-split and allow-split ring buffers
+ */
+#define RINGBUF_ITEM_HEADER_SIZE    8
+
+/**
+ * @brief Size of the storage area of a no-split ring buffer able to hold item_num items of item_size bytes
+ *
+ * This is the buffer size used by xRingbufferCreateNoSplit(). It can be used to declare the storage area
+ * passed to xRingbufferCreateStatic(), the result is 32-bit aligned.
+ */
+#define RINGBUF_NOSPLIT_STORAGE_SIZE(item_size, item_num) \
+    (((((size_t)(item_size) + 3) & ~(size_t)3) + RINGBUF_ITEM_HEADER_SIZE) * (size_t)(item_num))
+
 /**
  * @brief       Create a ring buffer
  *
@@ -168,6 +195,35 @@ BaseType_t xRingbufferSendFromISR(RingbufHandle_t xRingbuffer,
                                   size_t xItemSize,
                                   BaseType_t *pxHigherPriorityTaskWoken);
 
+/**
+ * @brief       Insert multiple items into the ring buffer
+ *
+ * Attempt to insert xItemCount items into the ring buffer in order. All items
+ * that currently fit are copied within a single critical section, and a task
+ * waiting to receive is unblocked at most once. This function will only block
+ * (until it times out) if not even the first item fits.
+ *
+ * @param[in]   xRingbuffer     Ring buffer to insert the items into
+ * @param[in]   ppvItems        Array of xItemCount pointers to the data of each item.
+ *                              NULL entries are allowed if the corresponding size is 0.
+ * @param[in]   pxItemSizes     Array of xItemCount item sizes
+ * @param[in]   xItemCount      Number of items to insert
+ * @param[in]   xTicksToWait    Ticks to wait for room in the ring buffer for the first item.
+ *
+ * @note    Items are sent in order. Sending stops at the first item that does
+ *          not fit, so the items that were not sent are always at the end of the array.
+ * @note    The same rules as in xRingbufferSend() apply to each item. For byte
+ *          buffers, all items are merged into the stored byte sequence.
+ *
+ * @return  Number of items that were sent. 0 on time-out or when the first item
+ *          is larger than the maximum permissible size of the buffer.
+ */
+size_t xRingbufferSendBatch(RingbufHandle_t xRingbuffer,
+                            const void *const *ppvItems,
+                            const size_t *pxItemSizes,
+                            size_t xItemCount,
+                            TickType_t xTicksToWait);
+
 /**
  * @brief Acquire memory from the ring buffer to be written to by an external
  *        source and to be sent later.
@@ -364,6 +420,33 @@ void *xRingbufferReceiveUpTo(RingbufHandle_t xRingbuffer,
  */
 void *xRingbufferReceiveUpToFromISR(RingbufHandle_t xRingbuffer, size_t *pxItemSize, size_t xMaxSize);
 
+/**
+ * @brief   Retrieve multiple items from the ring buffer
+ *
+ * Attempt to retrieve up to xMaxItems items from the ring buffer within a single
+ * critical section. This function will block until at least one item is
+ * available or until it times out.
+ *
+ * @param[in]   xRingbuffer     Ring buffer to retrieve the items from
+ * @param[out]  ppvItems        Array of at least xMaxItems entries to which pointers to the retrieved items will be written
+ * @param[out]  pxItemSizes     Array of at least xMaxItems entries to which the sizes of the retrieved items will be written
+ * @param[in]   xMaxItems       Maximum number of items to retrieve
+ * @param[in]   xTicksToWait    Ticks to wait for items in the ring buffer.
+ *
+ * @note    Each retrieved item must be returned with vRingbufferReturnItem(),
+ *          or all of them at once with vRingbufferReturnItemBatch().
+ * @note    Byte buffers do not allow multiple retrievals before returning, so
+ *          at most one item (all continuous data) is retrieved from a byte buffer.
+ * @note    This function must not be called on allow-split buffers.
+ *
+ * @return  Number of items retrieved. 0 on timeout, the arrays are untouched in that case.
+ */
+size_t xRingbufferReceiveBatch(RingbufHandle_t xRingbuffer,
+                               void **ppvItems,
+                               size_t *pxItemSizes,
+                               size_t xMaxItems,
+                               TickType_t xTicksToWait);
+
 /**
  * @brief   Return a previously-retrieved item to the ring buffer
  *
@@ -386,6 +469,18 @@ void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void *pvItem);
  */
 void vRingbufferReturnItemFromISR(RingbufHandle_t xRingbuffer, void *pvItem, BaseType_t *pxHigherPriorityTaskWoken);
 
+/**
+ * @brief   Return multiple previously-retrieved items to the ring buffer
+ *
+ * All items are returned within a single critical section, and a task waiting
+ * to send is unblocked at most once.
+ *
+ * @param[in]   xRingbuffer     Ring buffer the items were retrieved from
+ * @param[in]   ppvItems        Array of xItemCount items that were retrieved
+ * @param[in]   xItemCount      Number of items to return
+ */
+void vRingbufferReturnItemBatch(RingbufHandle_t xRingbuffer, void *const *ppvItems, size_t xItemCount);
+
 /**
  * @brief   Delete a ring buffer
  *
@@ -543,6 +638,179 @@ RingbufHandle_t xRingbufferCreateWithCaps(size_t xBufferSize, RingbufferType_t x
  */
 void vRingbufferDeleteWithCaps(RingbufHandle_t xRingbuffer);
 
+/* ---------------------------------------------- Broadcast Ring Buffers ---------------------------------------------- */
+
+/**
+ * Type by which broadcast ring buffers are referenced. A broadcast ring buffer
+ * has a single writer and several readers, each reader receiving every item.
+ */
+typedef void * RingbufBroadcastHandle_t;
+
+/**
+ * @brief What the writer of a broadcast ring buffer does when the slowest reader has not received the oldest item
+ */
+typedef enum {
+    /**
+     * The oldest item is dropped for the lagging readers, the writer never
+     * waits for them. The writer only blocks if a lagging reader is viewing
+     * the oldest item.
+     */
+    RINGBUF_BROADCAST_DROP_OLDEST = 0,
+    /**
+     * The writer blocks until all the readers have returned the oldest item.
+     */
+    RINGBUF_BROADCAST_BLOCK_ON_SLOWEST,
+    RINGBUF_BROADCAST_POLICY_MAX,
+} RingbufBroadcastPolicy_t;
+
+/**
+ * @brief Create a broadcast ring buffer
+ *
+ * A broadcast ring buffer stores up to xItemNum items of at most xItemSize
+ * bytes in fixed slots. Each reader has its own cursor and receives every
+ * item sent after it was added, as a view into the storage area (i.e.,
+ * without copying). An item is overwritten once all the readers have
+ * returned it, or according to xPolicy if a reader lags behind.
+ *
+ * Only one task may send to the buffer. Each reader must be used by one task
+ * at a time. The functions must not be called from an ISR.
+ *
+ * @param[in]   xItemSize Maximum size of an item in bytes
+ * @param[in]   xItemNum Number of item slots
+ * @param[in]   uxMaxReaders Maximum number of readers
+ * @param[in]   xPolicy What the writer does when a reader lags by xItemNum items
+ *
+ * @return  A handle to the created broadcast ring buffer, or NULL if out of memory
+ */
+RingbufBroadcastHandle_t xRingbufferBroadcastCreate(size_t xItemSize, size_t xItemNum, UBaseType_t uxMaxReaders, RingbufBroadcastPolicy_t xPolicy);
+
+/**
+ * @brief   Delete a broadcast ring buffer
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer to delete
+ *
+ * @note    No task may be using the buffer when it is deleted
+ */
+void vRingbufferBroadcastDelete(RingbufBroadcastHandle_t xBroadcast);
+
+/**
+ * @brief   Add a reader to a broadcast ring buffer
+ *
+ * The reader receives the items sent after this call.
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[out]  puxReader Index of the reader, to pass to the receive functions
+ *
+ * @return
+ *      - pdTRUE if the reader was added
+ *      - pdFALSE if the buffer already has uxMaxReaders readers
+ */
+BaseType_t xRingbufferBroadcastAddReader(RingbufBroadcastHandle_t xBroadcast, UBaseType_t *puxReader);
+
+/**
+ * @brief   Remove a reader from a broadcast ring buffer
+ *
+ * The items the reader did not receive no longer hold back the writer.
+ * The view the reader may hold becomes invalid.
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[in]   uxReader Reader returned by xRingbufferBroadcastAddReader()
+ */
+void vRingbufferBroadcastRemoveReader(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader);
+
+/**
+ * @brief   Acquire the slot of the next item to send to a broadcast ring buffer
+ *
+ * The writer fills the slot in place, then publishes it to all the readers
+ * with xRingbufferBroadcastSendComplete().
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[out]  ppvItem Start of the slot, 32-bit aligned, of xItemSize bytes
+ * @param[in]   xTicksToWait Ticks to wait for a free slot
+ *
+ * @return
+ *      - pdTRUE if a slot was acquired
+ *      - pdFALSE on time out
+ */
+BaseType_t xRingbufferBroadcastSendAcquire(RingbufBroadcastHandle_t xBroadcast, void **ppvItem, TickType_t xTicksToWait);
+
+/**
+ * @brief   Publish the item acquired with xRingbufferBroadcastSendAcquire() to all the readers
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[in]   xItemSize Size of the item written in the slot
+ *
+ * @return
+ *      - pdTRUE if the item was published
+ *      - pdFALSE if xItemSize is larger than the slot, the slot stays acquired
+ */
+BaseType_t xRingbufferBroadcastSendComplete(RingbufBroadcastHandle_t xBroadcast, size_t xItemSize);
+
+/**
+ * @brief   Copy an item to a broadcast ring buffer
+ *
+ * Equivalent to xRingbufferBroadcastSendAcquire(), copying the item, then
+ * xRingbufferBroadcastSendComplete().
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[in]   pvItem Item to send
+ * @param[in]   xItemSize Size of the item
+ * @param[in]   xTicksToWait Ticks to wait for a free slot
+ *
+ * @return
+ *      - pdTRUE if the item was sent
+ *      - pdFALSE on time out or if the item is larger than a slot
+ */
+BaseType_t xRingbufferBroadcastSend(RingbufBroadcastHandle_t xBroadcast, const void *pvItem, size_t xItemSize, TickType_t xTicksToWait);
+
+/**
+ * @brief   Get a view of the next item of a reader of a broadcast ring buffer
+ *
+ * The item is not copied, it stays valid until it is returned with
+ * vRingbufferBroadcastReturnItem(). A reader holds at most one view at a
+ * time, and the other readers can view the same item meanwhile.
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[in]   uxReader Reader returned by xRingbufferBroadcastAddReader()
+ * @param[out]  pxItemSize Size of the item
+ * @param[in]   xTicksToWait Ticks to wait for an item
+ *
+ * @return
+ *      - Pointer to the item
+ *      - NULL on time out
+ */
+const void *xRingbufferBroadcastReceive(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader, size_t *pxItemSize, TickType_t xTicksToWait);
+
+/**
+ * @brief   Return the item viewed by a reader of a broadcast ring buffer
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[in]   uxReader Reader returned by xRingbufferBroadcastAddReader()
+ */
+void vRingbufferBroadcastReturnItem(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader);
+
+/**
+ * @brief   Get the number of items a reader of a broadcast ring buffer has missed
+ *
+ * Items are only dropped with the RINGBUF_BROADCAST_DROP_OLDEST policy.
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[in]   uxReader Reader returned by xRingbufferBroadcastAddReader()
+ *
+ * @return  Number of items dropped since the reader was added
+ */
+UBaseType_t uxRingbufferBroadcastGetDropped(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader);
+
+/**
+ * @brief   Get the number of items a reader of a broadcast ring buffer has not returned yet
+ *
+ * @param[in]   xBroadcast Broadcast ring buffer
+ * @param[in]   uxReader Reader returned by xRingbufferBroadcastAddReader()
+ *
+ * @return  Number of items, including the one being viewed
+ */
+UBaseType_t uxRingbufferBroadcastGetWaiting(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader);
+
 #ifdef __cplusplus
 }
 #endif
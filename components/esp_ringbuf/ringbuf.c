@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -13,6 +13,9 @@
 #include "freertos/queue.h"
 #include "freertos/ringbuf.h"
 #include "esp_heap_caps.h"
+#if CONFIG_ESP_METRICS_SYSTEM
+#include "esp_metrics.h"
+#endif
 
 // ------------------------------------------------- Macros and Types --------------------------------------------------
 
@@ -21,12 +24,17 @@
 #define rbALIGN_SIZE( xSize )       ( ( xSize + rbALIGN_MASK ) & ~rbALIGN_MASK )
 #define rbCHECK_ALIGNED( pvPtr )    ( ( ( UBaseType_t ) ( pvPtr ) & rbALIGN_MASK ) == 0 )
 
+//Atomic accessors for the state shared between the producer and the consumer of SPSC byte buffers
+#define rbSPSC_LOAD( xVar )             __atomic_load_n( &( xVar ), __ATOMIC_SEQ_CST )
+#define rbSPSC_STORE( xVar, xValue )    __atomic_store_n( &( xVar ), ( xValue ), __ATOMIC_SEQ_CST )
+
 //Ring buffer flags
 #define rbALLOW_SPLIT_FLAG          ( ( UBaseType_t ) 1 )   //The ring buffer allows items to be split
 #define rbBYTE_BUFFER_FLAG          ( ( UBaseType_t ) 2 )   //The ring buffer is a byte buffer
 #define rbBUFFER_FULL_FLAG          ( ( UBaseType_t ) 4 )   //The ring buffer is currently full (write pointer == free pointer)
 #define rbBUFFER_STATIC_FLAG        ( ( UBaseType_t ) 8 )   //The ring buffer is statically allocated
 #define rbUSING_QUEUE_SET           ( ( UBaseType_t ) 16 )  //The ring buffer has been added to a queue set
+#define rbSPSC_FLAG                 ( ( UBaseType_t ) 32 )  //The byte buffer has a single producer and a single consumer (lock-free fast path)
 
 //Item flags
 #define rbITEM_FREE_FLAG            ( ( UBaseType_t ) 1 )   //Item has been retrieved and returned by application, free to overwrite
@@ -71,11 +79,20 @@ typedef struct RingbufferDefinition {
     List_t xTasksWaitingToSend;                 //List of tasks that are blocked waiting to send/acquire onto this ring buffer. Stored in priority order.
     List_t xTasksWaitingToReceive;              //List of tasks that are blocked waiting to receive from this ring buffer. Stored in priority order.
     QueueSetHandle_t xQueueSet;                 //Ring buffer's read queue set handle.
+    BaseType_t xSenderWaiting;                  //SPSC only. Set by the producer before it checks for space and blocks
+    BaseType_t xReceiverWaiting;                //SPSC only. Set by the consumer before it checks for data and blocks
 
     portMUX_TYPE mux;                           //Spinlock required for SMP
 } Ringbuffer_t;
 
 _Static_assert(sizeof(StaticRingbuffer_t) == sizeof(Ringbuffer_t), "StaticRingbuffer_t != Ringbuffer_t");
+_Static_assert(sizeof(ItemHeader_t) == RINGBUF_ITEM_HEADER_SIZE, "RINGBUF_ITEM_HEADER_SIZE != sizeof(ItemHeader_t)");
+
+#if CONFIG_ESP_METRICS_SYSTEM
+ESP_METRICS_COUNTER_DEFINE(s_xSendMetric, "esp_ringbuf_send_total", "Items sent to the ring buffers");
+ESP_METRICS_COUNTER_DEFINE(s_xSendFailedMetric, "esp_ringbuf_send_failed_total",
+                           "Items which could not be sent because the ring buffer was full");
+#endif
 
 // ------------------------------------------------ Forward Declares ---------------------------------------------------
 
@@ -169,6 +186,49 @@ static size_t prvGetCurMaxSizeAllowSplit(Ringbuffer_t *pxRingbuffer);
 //Get the maximum size an item that can currently have if sent to a byte buffer
 static size_t prvGetCurMaxSizeByteBuf(Ringbuffer_t *pxRingbuffer);
 
+/*
+ * The following functions implement RINGBUF_TYPE_BYTEBUF_SPSC buffers. They ARE
+ * thread safe without a critical section provided that there is only one
+ * producer and one consumer:
+ * - pucWrite is only written by the producer, pucRead and pucFree are only
+ *   written by the consumer. Each side publishes its pointer with an atomic
+ *   store after touching the data and loads the other side's pointer atomically.
+ * - One byte is always kept free so that pucWrite == pucFree means empty.
+ * - xItemsWaiting and rbBUFFER_FULL_FLAG are not used.
+ */
+
+//Checks if an item will currently fit in an SPSC byte buffer. Must only be called by the producer
+static BaseType_t prvCheckItemFitsSpsc(Ringbuffer_t *pxRingbuffer, size_t xItemSize);
+
+//Copies an item to an SPSC byte buffer and publishes it. Only call this function after calling prvCheckItemFitsSpsc()
+static void prvCopyItemSpsc(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize);
+
+//Checks if data is available for retrieval from an SPSC byte buffer. Must only be called by the consumer
+static BaseType_t prvCheckItemAvailSpsc(Ringbuffer_t *pxRingbuffer);
+
+//Retrieve data from an SPSC byte buffer. Only call this function after calling prvCheckItemAvailSpsc()
+static void *prvGetItemSpsc(Ringbuffer_t *pxRingbuffer,
+                            BaseType_t *pxUnusedParam,
+                            size_t xMaxSize,
+                            size_t *pxItemSize);
+
+//Return data to an SPSC byte buffer, publishing the freed space to the producer
+static void prvReturnItemSpsc(Ringbuffer_t *pxRingbuffer, uint8_t *pucItem);
+
+//Get the maximum size an item that can currently have if sent to an SPSC byte buffer
+static size_t prvGetCurMaxSizeSpsc(Ringbuffer_t *pxRingbuffer);
+
+/*
+Unblock the task waiting on pxList if the other side of an SPSC buffer has
+flagged (via pxWaiting) that it is about to block. Must be called after the
+pointer update that the waiting side is waiting for has been published.
+*/
+static void prvNotifySpsc(Ringbuffer_t *pxRingbuffer,
+                          BaseType_t *pxWaiting,
+                          List_t *pxList,
+                          BaseType_t xFromISR,
+                          BaseType_t *pxHigherPriorityTaskWoken);
+
 /*
 Generic function used to send or acquire an item/buffer.
 - If sending, set ppvItem to NULL. pvItem remains unchanged on failure.
@@ -202,6 +262,40 @@ static BaseType_t prvReceiveGenericFromISR(Ringbuffer_t *pxRingbuffer,
                                            size_t *xItemSize2,
                                            size_t xMaxSize);
 
+/*
+Generic function used to send multiple items. Items are copied in order while
+they fit, and only the first item is waited for. Returns the number of items sent.
+*/
+static size_t prvSendBatchGeneric(Ringbuffer_t *pxRingbuffer,
+                                  const void *const *ppvItems,
+                                  const size_t *pxItemSizes,
+                                  size_t xItemCount,
+                                  TickType_t xTicksToWait);
+
+/*
+Generic function used to retrieve up to xMaxItems items from no-split/byte
+buffers. Returns the number of items retrieved, ppvItems and pxItemSizes must
+remain unchanged if no item is retrieved.
+*/
+static size_t prvReceiveBatchGeneric(Ringbuffer_t *pxRingbuffer,
+                                     void **ppvItems,
+                                     size_t *pxItemSizes,
+                                     size_t xMaxItems,
+                                     TickType_t xTicksToWait);
+
+//SPSC version of prvSendAcquireGeneric(). Sending only, acquiring is not supported by byte buffers
+static BaseType_t prvSendSpsc(Ringbuffer_t *pxRingbuffer,
+                              const void *pvItem,
+                              size_t xItemSize,
+                              TickType_t xTicksToWait);
+
+//SPSC version of prvReceiveGeneric(). If xMaxSize is 0, all continuous data is retrieved
+static BaseType_t prvReceiveSpsc(Ringbuffer_t *pxRingbuffer,
+                                 void **pvItem,
+                                 size_t *xItemSize,
+                                 size_t xMaxSize,
+                                 TickType_t xTicksToWait);
+
 // ------------------------------------------------ Static Functions ---------------------------------------------------
 
 static void prvInitializeNewRingbuffer(size_t xBufferSize,
@@ -241,6 +335,15 @@ static void prvInitializeNewRingbuffer(size_t xBufferSize,
         //Worst case an item is split into two, incurring two headers of overhead
         pxNewRingbuffer->xMaxItemSize = pxNewRingbuffer->xSize - (sizeof(ItemHeader_t) * 2);
         pxNewRingbuffer->xGetCurMaxSize = prvGetCurMaxSizeAllowSplit;
+    } else if (xBufferType == RINGBUF_TYPE_BYTEBUF_SPSC) {
+        pxNewRingbuffer->uxRingbufferFlags |= rbBYTE_BUFFER_FLAG | rbSPSC_FLAG;
+        pxNewRingbuffer->xCheckItemFits = prvCheckItemFitsSpsc;
+        pxNewRingbuffer->vCopyItem = prvCopyItemSpsc;
+        pxNewRingbuffer->pvGetItem = prvGetItemSpsc;
+        pxNewRingbuffer->vReturnItem = prvReturnItemSpsc;
+        //One byte is kept free to distinguish between a full and an empty buffer
+        pxNewRingbuffer->xMaxItemSize = pxNewRingbuffer->xSize - 1;
+        pxNewRingbuffer->xGetCurMaxSize = prvGetCurMaxSizeSpsc;
     } else { //Byte Buffer
         pxNewRingbuffer->uxRingbufferFlags |= rbBYTE_BUFFER_FLAG;
         pxNewRingbuffer->xCheckItemFits = prvCheckItemFitsByteBuffer;
@@ -255,6 +358,8 @@ static void prvInitializeNewRingbuffer(size_t xBufferSize,
     vListInitialise(&pxNewRingbuffer->xTasksWaitingToSend);
     vListInitialise(&pxNewRingbuffer->xTasksWaitingToReceive);
     pxNewRingbuffer->xQueueSet = NULL;
+    pxNewRingbuffer->xSenderWaiting = pdFALSE;
+    pxNewRingbuffer->xReceiverWaiting = pdFALSE;
 
     portMUX_INITIALIZE(&pxNewRingbuffer->mux);
 }
@@ -262,7 +367,9 @@ static void prvInitializeNewRingbuffer(size_t xBufferSize,
 static size_t prvGetFreeSize(Ringbuffer_t *pxRingbuffer)
 {
     size_t xReturn;
-    if (pxRingbuffer->uxRingbufferFlags & rbBUFFER_FULL_FLAG) {
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        xReturn = prvGetCurMaxSizeSpsc(pxRingbuffer);
+    } else if (pxRingbuffer->uxRingbufferFlags & rbBUFFER_FULL_FLAG) {
         xReturn =  0;
     } else {
         BaseType_t xFreeSize = pxRingbuffer->pucFree - pxRingbuffer->pucAcquire;
@@ -755,6 +862,130 @@ static size_t prvGetCurMaxSizeByteBuf(Ringbuffer_t *pxRingbuffer)
     return xFreeSize;
 }
 
+static BaseType_t prvCheckItemFitsSpsc(Ringbuffer_t *pxRingbuffer, size_t xItemSize)
+{
+    return (xItemSize <= prvGetCurMaxSizeSpsc(pxRingbuffer)) ? pdTRUE : pdFALSE;
+}
+
+static void prvCopyItemSpsc(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize)
+{
+    //pucWrite is only ever written by the producer, so it can be read without an atomic load here
+    uint8_t *pucWrite = pxRingbuffer->pucWrite;
+    configASSERT(pucWrite >= pxRingbuffer->pucHead && pucWrite < pxRingbuffer->pucTail);    //Check write pointer is within bounds
+
+    size_t xRemLen = pxRingbuffer->pucTail - pucWrite;    //Length from pucWrite until end of buffer
+    if (xRemLen < xItemSize) {
+        //Copy as much as possible into remaining length, then wrap around
+        memcpy(pucWrite, pucItem, xRemLen);
+        pucItem += xRemLen;
+        xItemSize -= xRemLen;
+        pucWrite = pxRingbuffer->pucHead;
+    }
+    //Copy all or remaining portion of the item
+    memcpy(pucWrite, pucItem, xItemSize);
+    pucWrite += xItemSize;
+    if (pucWrite == pxRingbuffer->pucTail) {
+        pucWrite = pxRingbuffer->pucHead;
+    }
+    //Publish the new data to the consumer. Must come after the copy.
+    rbSPSC_STORE(pxRingbuffer->pucWrite, pucWrite);
+}
+
+static BaseType_t prvCheckItemAvailSpsc(Ringbuffer_t *pxRingbuffer)
+{
+    if (pxRingbuffer->pucRead != pxRingbuffer->pucFree) {
+        return pdFALSE;     //Byte buffers do not allow multiple retrievals before return
+    }
+    return (rbSPSC_LOAD(pxRingbuffer->pucWrite) != pxRingbuffer->pucRead) ? pdTRUE : pdFALSE;
+}
+
+static void *prvGetItemSpsc(Ringbuffer_t *pxRingbuffer,
+                            BaseType_t *pxUnusedParam,
+                            size_t xMaxSize,
+                            size_t *pxItemSize)
+{
+    uint8_t *pucRead = pxRingbuffer->pucRead;
+    uint8_t *pucWrite = rbSPSC_LOAD(pxRingbuffer->pucWrite);
+    //Check arguments and buffer state
+    configASSERT(pucRead != pucWrite);      //Check there is data to be read
+    configASSERT(pucRead >= pxRingbuffer->pucHead && pucRead < pxRingbuffer->pucTail);    //Check read pointer is within bounds
+    configASSERT(pucRead == pxRingbuffer->pucFree);
+
+    uint8_t *ret = pucRead;
+    //If the available data wraps around, return the contiguous piece until the buffer tail
+    size_t xLen = (pucWrite > pucRead) ? (size_t)(pucWrite - pucRead) : (size_t)(pxRingbuffer->pucTail - pucRead);
+    if (xMaxSize != 0 && xLen > xMaxSize) {
+        xLen = xMaxSize;
+    }
+    *pxItemSize = xLen;
+    pucRead += xLen;
+    if (pucRead == pxRingbuffer->pucTail) {
+        pucRead = pxRingbuffer->pucHead;    //Wrap around read pointer
+    }
+    rbSPSC_STORE(pxRingbuffer->pucRead, pucRead);
+    return (void *)ret;
+}
+
+static void prvReturnItemSpsc(Ringbuffer_t *pxRingbuffer, uint8_t *pucItem)
+{
+    //Check pointer points to address inside buffer
+    configASSERT((uint8_t *)pucItem >= pxRingbuffer->pucHead);
+    configASSERT((uint8_t *)pucItem < pxRingbuffer->pucTail);
+    //Free the read memory and publish it to the producer. Must come after the application is done with the data.
+    rbSPSC_STORE(pxRingbuffer->pucFree, pxRingbuffer->pucRead);
+}
+
+static size_t prvGetCurMaxSizeSpsc(Ringbuffer_t *pxRingbuffer)
+{
+    uint8_t *pucWrite = rbSPSC_LOAD(pxRingbuffer->pucWrite);
+    uint8_t *pucFree = rbSPSC_LOAD(pxRingbuffer->pucFree);
+
+    //One byte is always kept free, pucWrite == pucFree means the buffer is empty
+    BaseType_t xFreeSize = pucFree - pucWrite - 1;
+    if (xFreeSize < 0) {
+        xFreeSize += pxRingbuffer->xSize;
+    }
+    return xFreeSize;
+}
+
+static void prvNotifySpsc(Ringbuffer_t *pxRingbuffer,
+                          BaseType_t *pxWaiting,
+                          List_t *pxList,
+                          BaseType_t xFromISR,
+                          BaseType_t *pxHigherPriorityTaskWoken)
+{
+    /*
+     * The waiting side sets its flag before re-checking the buffer inside the critical
+     * section, and the published pointer update is ordered before this load. So either
+     * the waiting side sees the update and does not block, or we see the flag here and
+     * take the critical section, which the waiting side only leaves once it is on pxList.
+     */
+    if (rbSPSC_LOAD(*pxWaiting) == pdFALSE) {
+        return;
+    }
+
+    if (xFromISR) {
+        portENTER_CRITICAL_ISR(&pxRingbuffer->mux);
+    } else {
+        portENTER_CRITICAL(&pxRingbuffer->mux);
+    }
+    if (listLIST_IS_EMPTY(pxList) == pdFALSE) {
+        if (xTaskRemoveFromEventList(pxList) == pdTRUE) {
+            //The unblocked task will preempt us.
+            if (!xFromISR) {
+                portYIELD_WITHIN_API();
+            } else if (pxHigherPriorityTaskWoken != NULL) {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+        }
+    }
+    if (xFromISR) {
+        portEXIT_CRITICAL_ISR(&pxRingbuffer->mux);
+    } else {
+        portEXIT_CRITICAL(&pxRingbuffer->mux);
+    }
+}
+
 static BaseType_t prvSendAcquireGeneric(Ringbuffer_t *pxRingbuffer,
                                         const void *pvItem,
                                         void **ppvItem,
@@ -767,6 +998,11 @@ static BaseType_t prvSendAcquireGeneric(Ringbuffer_t *pxRingbuffer,
     BaseType_t xNotifyQueueSet = pdFALSE;
     TimeOut_t xTimeOut;
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        configASSERT(ppvItem == NULL);
+        return prvSendSpsc(pxRingbuffer, pvItem, xItemSize, xTicksToWait);
+    }
+
     while (xExitLoop == pdFALSE) {
         portENTER_CRITICAL(&pxRingbuffer->mux);
         if (pxRingbuffer->xCheckItemFits(pxRingbuffer, xItemSize) == pdTRUE) {
@@ -837,6 +1073,10 @@ static BaseType_t prvReceiveGeneric(Ringbuffer_t *pxRingbuffer,
 
     ESP_STATIC_ANALYZER_CHECK(!pvItem1 || !xItemSize1, pdFALSE);
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        return prvReceiveSpsc(pxRingbuffer, pvItem1, xItemSize1, xMaxSize, xTicksToWait);
+    }
+
     while (xExitLoop == pdFALSE) {
         portENTER_CRITICAL(&pxRingbuffer->mux);
         if (prvCheckItemAvail(pxRingbuffer) == pdTRUE) {
@@ -899,6 +1139,15 @@ static BaseType_t prvReceiveGenericFromISR(Ringbuffer_t *pxRingbuffer,
 
     ESP_STATIC_ANALYZER_CHECK(!pvItem1 || !xItemSize1, pdFALSE);
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //Single consumer, no critical section is needed to retrieve data
+        if (prvCheckItemAvailSpsc(pxRingbuffer) == pdFALSE) {
+            return pdFALSE;
+        }
+        *pvItem1 = prvGetItemSpsc(pxRingbuffer, NULL, xMaxSize, xItemSize1);
+        return pdTRUE;
+    }
+
     portENTER_CRITICAL_ISR(&pxRingbuffer->mux);
     if (prvCheckItemAvail(pxRingbuffer) == pdTRUE) {
         BaseType_t xIsSplit = pdFALSE;
@@ -929,6 +1178,248 @@ static BaseType_t prvReceiveGenericFromISR(Ringbuffer_t *pxRingbuffer,
     return xReturn;
 }
 
+static size_t prvSendBatchGeneric(Ringbuffer_t *pxRingbuffer,
+                                  const void *const *ppvItems,
+                                  const size_t *pxItemSizes,
+                                  size_t xItemCount,
+                                  TickType_t xTicksToWait)
+{
+    size_t xSent = 0;
+    size_t xNotifyQueueSet = 0;
+    BaseType_t xExitLoop = pdFALSE;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        for (; xSent < xItemCount; xSent++) {
+            size_t xItemSize = pxItemSizes[xSent];
+            configASSERT(ppvItems[xSent] != NULL || xItemSize == 0);
+            if (xItemSize == 0) {
+                continue;   //Sending 0 bytes to byte buffer has no effect
+            }
+            if (prvCheckItemFitsSpsc(pxRingbuffer, xItemSize) == pdTRUE) {
+                prvCopyItemSpsc(pxRingbuffer, ppvItems[xSent], xItemSize);
+            } else if (xSent > 0 || xItemSize > pxRingbuffer->xMaxItemSize ||
+                       prvSendSpsc(pxRingbuffer, ppvItems[xSent], xItemSize, xTicksToWait) == pdFALSE) {
+                //Only the first item may block
+                break;
+            }
+        }
+        //If the consumer is waiting for data to arrive on the ring buffer, unblock it.
+        prvNotifySpsc(pxRingbuffer, &pxRingbuffer->xReceiverWaiting, &pxRingbuffer->xTasksWaitingToReceive, pdFALSE, NULL);
+        return xSent;
+    }
+
+    while (xExitLoop == pdFALSE) {
+        size_t xCopied = 0;
+        portENTER_CRITICAL(&pxRingbuffer->mux);
+        //Copy as many items as currently fit, in order
+        for (; xSent < xItemCount; xSent++) {
+            size_t xItemSize = pxItemSizes[xSent];
+            configASSERT(ppvItems[xSent] != NULL || xItemSize == 0);
+            if ((pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG) && xItemSize == 0) {
+                continue;   //Sending 0 bytes to byte buffer has no effect
+            }
+            if (xItemSize > pxRingbuffer->xMaxItemSize || pxRingbuffer->xCheckItemFits(pxRingbuffer, xItemSize) == pdFALSE) {
+                break;
+            }
+            pxRingbuffer->vCopyItem(pxRingbuffer, ppvItems[xSent], xItemSize);
+            xCopied++;
+        }
+        if (xSent > 0) {
+            if (xCopied > 0) {
+                if (pxRingbuffer->xQueueSet) {
+                    //If ring buffer was added to a queue set, notify the queue set once per item
+                    xNotifyQueueSet = xCopied;
+                } else {
+                    //If a task was waiting for data to arrive on the ring buffer, unblock it immediately.
+                    if (listLIST_IS_EMPTY(&pxRingbuffer->xTasksWaitingToReceive) == pdFALSE) {
+                        if (xTaskRemoveFromEventList(&pxRingbuffer->xTasksWaitingToReceive) == pdTRUE) {
+                            //The unblocked task will preempt us. Trigger a yield here.
+                            portYIELD_WITHIN_API();
+                        }
+                    }
+                }
+            }
+            xExitLoop = pdTRUE;
+            goto loop_end;
+        } else if (pxItemSizes[0] > pxRingbuffer->xMaxItemSize || xTicksToWait == (TickType_t) 0) {
+            //First item will never fit, or no block time. Return immediately.
+            xExitLoop = pdTRUE;
+            goto loop_end;
+        } else if (xEntryTimeSet == pdFALSE) {
+            //This is our first block. Set entry time
+            vTaskInternalSetTimeOutState(&xTimeOut);
+            xEntryTimeSet = pdTRUE;
+        }
+
+        if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdFALSE) {
+            //Not timed out yet. Block the current task
+            vTaskPlaceOnEventList(&pxRingbuffer->xTasksWaitingToSend, xTicksToWait);
+            portYIELD_WITHIN_API();
+        } else {
+            //We have timed out
+            xExitLoop = pdTRUE;
+        }
+loop_end:
+        portEXIT_CRITICAL(&pxRingbuffer->mux);
+    }
+    //Defer notifying the queue set until we are outside the loop and critical section.
+    for (size_t i = 0; i < xNotifyQueueSet; i++) {
+        xQueueSend((QueueHandle_t)pxRingbuffer->xQueueSet, (QueueSetMemberHandle_t *)&pxRingbuffer, 0);
+    }
+
+    return xSent;
+}
+
+static size_t prvReceiveBatchGeneric(Ringbuffer_t *pxRingbuffer,
+                                     void **ppvItems,
+                                     size_t *pxItemSizes,
+                                     size_t xMaxItems,
+                                     TickType_t xTicksToWait)
+{
+    size_t xReceived = 0;
+    BaseType_t xExitLoop = pdFALSE;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //Byte buffers only allow a single outstanding retrieval
+        return (prvReceiveSpsc(pxRingbuffer, &ppvItems[0], &pxItemSizes[0], 0, xTicksToWait) == pdTRUE) ? 1 : 0;
+    }
+
+    while (xExitLoop == pdFALSE) {
+        portENTER_CRITICAL(&pxRingbuffer->mux);
+        if (prvCheckItemAvail(pxRingbuffer) == pdTRUE) {
+            //Retrieve as many items as are available. Stops after one retrieval for byte buffers.
+            do {
+                BaseType_t xIsSplit = pdFALSE;
+                ppvItems[xReceived] = pxRingbuffer->pvGetItem(pxRingbuffer, &xIsSplit, 0, &pxItemSizes[xReceived]);
+                xReceived++;
+            } while (xReceived < xMaxItems && prvCheckItemAvail(pxRingbuffer) == pdTRUE);
+            xExitLoop = pdTRUE;
+            goto loop_end;
+        } else if (xTicksToWait == (TickType_t) 0) {
+            //No block time. Return immediately.
+            xExitLoop = pdTRUE;
+            goto loop_end;
+        } else if (xEntryTimeSet == pdFALSE) {
+            //This is our first block. Set entry time
+            vTaskInternalSetTimeOutState(&xTimeOut);
+            xEntryTimeSet = pdTRUE;
+        }
+
+        if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdFALSE) {
+            //Not timed out yet. Block the current task
+            vTaskPlaceOnEventList(&pxRingbuffer->xTasksWaitingToReceive, xTicksToWait);
+            portYIELD_WITHIN_API();
+        } else {
+            //We have timed out.
+            xExitLoop = pdTRUE;
+        }
+loop_end:
+        portEXIT_CRITICAL(&pxRingbuffer->mux);
+    }
+
+    return xReceived;
+}
+
+static BaseType_t prvSendSpsc(Ringbuffer_t *pxRingbuffer,
+                              const void *pvItem,
+                              size_t xItemSize,
+                              TickType_t xTicksToWait)
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+
+    //Fast path is lock-free. The critical section is only entered to block.
+    while (prvCheckItemFitsSpsc(pxRingbuffer, xItemSize) == pdFALSE) {
+        BaseType_t xTimedOut;
+        if (xTicksToWait == (TickType_t) 0) {
+            //No block time. Return immediately.
+            return pdFALSE;
+        }
+        portENTER_CRITICAL(&pxRingbuffer->mux);
+        if (xEntryTimeSet == pdFALSE) {
+            //This is our first block. Set entry time
+            vTaskInternalSetTimeOutState(&xTimeOut);
+            xEntryTimeSet = pdTRUE;
+        }
+        xTimedOut = xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait);
+        if (xTimedOut == pdFALSE) {
+            //Announce that we are about to block, then check again in case the consumer freed space meanwhile
+            rbSPSC_STORE(pxRingbuffer->xSenderWaiting, pdTRUE);
+            if (prvCheckItemFitsSpsc(pxRingbuffer, xItemSize) == pdFALSE) {
+                vTaskPlaceOnEventList(&pxRingbuffer->xTasksWaitingToSend, xTicksToWait);
+                portYIELD_WITHIN_API();
+            }
+        }
+        portEXIT_CRITICAL(&pxRingbuffer->mux);
+        //Only cleared once we have actually been unblocked
+        rbSPSC_STORE(pxRingbuffer->xSenderWaiting, pdFALSE);
+        if (xTimedOut == pdTRUE) {
+            return pdFALSE;
+        }
+    }
+
+    prvCopyItemSpsc(pxRingbuffer, pvItem, xItemSize);
+    //If the consumer is waiting for data to arrive on the ring buffer, unblock it.
+    prvNotifySpsc(pxRingbuffer, &pxRingbuffer->xReceiverWaiting, &pxRingbuffer->xTasksWaitingToReceive, pdFALSE, NULL);
+    return pdTRUE;
+}
+
+static BaseType_t prvReceiveSpsc(Ringbuffer_t *pxRingbuffer,
+                                 void **pvItem,
+                                 size_t *xItemSize,
+                                 size_t xMaxSize,
+                                 TickType_t xTicksToWait)
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+
+    //Fast path is lock-free. The critical section is only entered to block.
+    while (prvCheckItemAvailSpsc(pxRingbuffer) == pdFALSE) {
+        BaseType_t xTimedOut;
+        if (xTicksToWait == (TickType_t) 0) {
+            //No block time. Return immediately.
+            return pdFALSE;
+        }
+        portENTER_CRITICAL(&pxRingbuffer->mux);
+        if (xEntryTimeSet == pdFALSE) {
+            //This is our first block. Set entry time
+            vTaskInternalSetTimeOutState(&xTimeOut);
+            xEntryTimeSet = pdTRUE;
+        }
+        xTimedOut = xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait);
+        if (xTimedOut == pdFALSE) {
+            //Announce that we are about to block, then check again in case the producer sent data meanwhile
+            rbSPSC_STORE(pxRingbuffer->xReceiverWaiting, pdTRUE);
+            if (prvCheckItemAvailSpsc(pxRingbuffer) == pdFALSE) {
+                vTaskPlaceOnEventList(&pxRingbuffer->xTasksWaitingToReceive, xTicksToWait);
+                portYIELD_WITHIN_API();
+            }
+        }
+        portEXIT_CRITICAL(&pxRingbuffer->mux);
+        //Only cleared once we have actually been unblocked
+        rbSPSC_STORE(pxRingbuffer->xReceiverWaiting, pdFALSE);
+        if (xTimedOut == pdTRUE) {
+            return pdFALSE;
+        }
+    }
+
+    *pvItem = prvGetItemSpsc(pxRingbuffer, NULL, xMaxSize, xItemSize);
+    return pdTRUE;
+}
+
+//Counts the result of a send in the metrics, and returns it
+static inline BaseType_t prvCountSend(BaseType_t xResult)
+{
+#if CONFIG_ESP_METRICS_SYSTEM
+    esp_metrics_counter_inc(xResult == pdTRUE ? &s_xSendMetric : &s_xSendFailedMetric);
+#endif
+    return xResult;
+}
+
 // ------------------------------------------------ Public Functions ---------------------------------------------------
 
 RingbufHandle_t xRingbufferCreate(size_t xBufferSize, RingbufferType_t xBufferType)
@@ -937,7 +1428,7 @@ RingbufHandle_t xRingbufferCreate(size_t xBufferSize, RingbufferType_t xBufferTy
     configASSERT(xBufferType < RINGBUF_TYPE_MAX);
 
     //Allocate memory
-    if (xBufferType != RINGBUF_TYPE_BYTEBUF) {
+    if (xBufferType != RINGBUF_TYPE_BYTEBUF && xBufferType != RINGBUF_TYPE_BYTEBUF_SPSC) {
         xBufferSize = rbALIGN_SIZE(xBufferSize);    //xBufferSize is rounded up for no-split/allow-split buffers
     }
     Ringbuffer_t *pxNewRingbuffer = calloc(1, sizeof(Ringbuffer_t));
@@ -958,7 +1449,7 @@ err:
 
 RingbufHandle_t xRingbufferCreateNoSplit(size_t xItemSize, size_t xItemNum)
 {
-    return xRingbufferCreate((rbALIGN_SIZE(xItemSize) + rbHEADER_SIZE) * xItemNum, RINGBUF_TYPE_NOSPLIT);
+    return xRingbufferCreate(RINGBUF_NOSPLIT_STORAGE_SIZE(xItemSize, xItemNum), RINGBUF_TYPE_NOSPLIT);
 }
 
 RingbufHandle_t xRingbufferCreateStatic(size_t xBufferSize,
@@ -970,7 +1461,7 @@ RingbufHandle_t xRingbufferCreateStatic(size_t xBufferSize,
     configASSERT(xBufferSize > 0);
     configASSERT(xBufferType < RINGBUF_TYPE_MAX);
     configASSERT(pucRingbufferStorage != NULL && pxStaticRingbuffer != NULL);
-    if (xBufferType != RINGBUF_TYPE_BYTEBUF) {
+    if (xBufferType != RINGBUF_TYPE_BYTEBUF && xBufferType != RINGBUF_TYPE_BYTEBUF_SPSC) {
         //No-split/allow-split buffer sizes must be 32-bit aligned
         configASSERT(rbCHECK_ALIGNED(xBufferSize));
     }
@@ -1047,7 +1538,7 @@ BaseType_t xRingbufferSend(RingbufHandle_t xRingbuffer,
         return pdTRUE;      //Sending 0 bytes to byte buffer has no effect
     }
 
-    return prvSendAcquireGeneric(pxRingbuffer, pvItem, NULL, xItemSize, xTicksToWait);
+    return prvCountSend(prvSendAcquireGeneric(pxRingbuffer, pvItem, NULL, xItemSize, xTicksToWait));
 }
 
 BaseType_t xRingbufferSendFromISR(RingbufHandle_t xRingbuffer,
@@ -1068,6 +1559,15 @@ BaseType_t xRingbufferSendFromISR(RingbufHandle_t xRingbuffer,
     if ((pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG) && xItemSize == 0) {
         return pdTRUE;      //Sending 0 bytes to byte buffer has no effect
     }
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //Single producer, no critical section is needed to send data
+        if (prvCheckItemFitsSpsc(pxRingbuffer, xItemSize) == pdFALSE) {
+            return prvCountSend(pdFALSE);
+        }
+        prvCopyItemSpsc(pxRingbuffer, pvItem, xItemSize);
+        prvNotifySpsc(pxRingbuffer, &pxRingbuffer->xReceiverWaiting, &pxRingbuffer->xTasksWaitingToReceive, pdTRUE, pxHigherPriorityTaskWoken);
+        return prvCountSend(pdTRUE);
+    }
 
     portENTER_CRITICAL_ISR(&pxRingbuffer->mux);
     if (pxRingbuffer->xCheckItemFits(xRingbuffer, xItemSize) == pdTRUE) {
@@ -1095,7 +1595,25 @@ BaseType_t xRingbufferSendFromISR(RingbufHandle_t xRingbuffer,
     if (xNotifyQueueSet == pdTRUE) {
         xQueueSendFromISR((QueueHandle_t)pxRingbuffer->xQueueSet, (QueueSetMemberHandle_t *)&pxRingbuffer, pxHigherPriorityTaskWoken);
     }
-    return xReturn;
+    return prvCountSend(xReturn);
+}
+
+size_t xRingbufferSendBatch(RingbufHandle_t xRingbuffer,
+                            const void *const *ppvItems,
+                            const size_t *pxItemSizes,
+                            size_t xItemCount,
+                            TickType_t xTicksToWait)
+{
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+
+    //Check arguments
+    configASSERT(pxRingbuffer);
+    configASSERT((ppvItems != NULL && pxItemSizes != NULL) || xItemCount == 0);
+    if (xItemCount == 0) {
+        return 0;
+    }
+
+    return prvSendBatchGeneric(pxRingbuffer, ppvItems, pxItemSizes, xItemCount, xTicksToWait);
 }
 
 void *xRingbufferReceive(RingbufHandle_t xRingbuffer, size_t *pxItemSize, TickType_t xTicksToWait)
@@ -1206,12 +1724,37 @@ void *xRingbufferReceiveUpToFromISR(RingbufHandle_t xRingbuffer, size_t *pxItemS
     }
 }
 
+size_t xRingbufferReceiveBatch(RingbufHandle_t xRingbuffer,
+                               void **ppvItems,
+                               size_t *pxItemSizes,
+                               size_t xMaxItems,
+                               TickType_t xTicksToWait)
+{
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+
+    //Check arguments
+    configASSERT(pxRingbuffer && ppvItems && pxItemSizes);
+    configASSERT((pxRingbuffer->uxRingbufferFlags & rbALLOW_SPLIT_FLAG) == 0);    // This function must not be called for allow-split buffers
+
+    if (xMaxItems == 0) {
+        return 0;
+    }
+    return prvReceiveBatchGeneric(pxRingbuffer, ppvItems, pxItemSizes, xMaxItems, xTicksToWait);
+}
+
 void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void *pvItem)
 {
     Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
     configASSERT(pxRingbuffer);
     configASSERT(pvItem != NULL);
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        prvReturnItemSpsc(pxRingbuffer, (uint8_t *)pvItem);
+        //If the producer is waiting for space to send, unblock it.
+        prvNotifySpsc(pxRingbuffer, &pxRingbuffer->xSenderWaiting, &pxRingbuffer->xTasksWaitingToSend, pdFALSE, NULL);
+        return;
+    }
+
     portENTER_CRITICAL(&pxRingbuffer->mux);
     pxRingbuffer->vReturnItem(pxRingbuffer, (uint8_t *)pvItem);
     //If a task was waiting for space to send, unblock it immediately.
@@ -1230,6 +1773,13 @@ void vRingbufferReturnItemFromISR(RingbufHandle_t xRingbuffer, void *pvItem, Bas
     configASSERT(pxRingbuffer);
     configASSERT(pvItem != NULL);
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        prvReturnItemSpsc(pxRingbuffer, (uint8_t *)pvItem);
+        //If the producer is waiting for space to send, unblock it.
+        prvNotifySpsc(pxRingbuffer, &pxRingbuffer->xSenderWaiting, &pxRingbuffer->xTasksWaitingToSend, pdTRUE, pxHigherPriorityTaskWoken);
+        return;
+    }
+
     portENTER_CRITICAL_ISR(&pxRingbuffer->mux);
     pxRingbuffer->vReturnItem(pxRingbuffer, (uint8_t *)pvItem);
     //If a task was waiting for space to send, unblock it immediately.
@@ -1244,6 +1794,40 @@ void vRingbufferReturnItemFromISR(RingbufHandle_t xRingbuffer, void *pvItem, Bas
     portEXIT_CRITICAL_ISR(&pxRingbuffer->mux);
 }
 
+void vRingbufferReturnItemBatch(RingbufHandle_t xRingbuffer, void *const *ppvItems, size_t xItemCount)
+{
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+    configASSERT(pxRingbuffer);
+    configASSERT(ppvItems != NULL || xItemCount == 0);
+
+    if (xItemCount == 0) {
+        return;
+    }
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        for (size_t i = 0; i < xItemCount; i++) {
+            configASSERT(ppvItems[i] != NULL);
+            prvReturnItemSpsc(pxRingbuffer, (uint8_t *)ppvItems[i]);
+        }
+        //If the producer is waiting for space to send, unblock it.
+        prvNotifySpsc(pxRingbuffer, &pxRingbuffer->xSenderWaiting, &pxRingbuffer->xTasksWaitingToSend, pdFALSE, NULL);
+        return;
+    }
+
+    portENTER_CRITICAL(&pxRingbuffer->mux);
+    for (size_t i = 0; i < xItemCount; i++) {
+        configASSERT(ppvItems[i] != NULL);
+        pxRingbuffer->vReturnItem(pxRingbuffer, (uint8_t *)ppvItems[i]);
+    }
+    //If a task was waiting for space to send, unblock it immediately.
+    if (listLIST_IS_EMPTY(&pxRingbuffer->xTasksWaitingToSend) == pdFALSE) {
+        if (xTaskRemoveFromEventList(&pxRingbuffer->xTasksWaitingToSend) == pdTRUE) {
+            //The unblocked task will preempt us. Trigger a yield here.
+            portYIELD_WITHIN_API();
+        }
+    }
+    portEXIT_CRITICAL(&pxRingbuffer->mux);
+}
+
 void vRingbufferDelete(RingbufHandle_t xRingbuffer)
 {
     Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
@@ -1268,6 +1852,10 @@ size_t xRingbufferGetCurFreeSize(RingbufHandle_t xRingbuffer)
     Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
     configASSERT(pxRingbuffer);
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        return prvGetCurMaxSizeSpsc(pxRingbuffer);
+    }
+
     size_t xFreeSize;
     portENTER_CRITICAL(&pxRingbuffer->mux);
     xFreeSize = pxRingbuffer->xGetCurMaxSize(pxRingbuffer);
@@ -1281,6 +1869,7 @@ BaseType_t xRingbufferAddToQueueSetRead(RingbufHandle_t xRingbuffer, QueueSetHan
     BaseType_t xReturn;
 
     configASSERT(pxRingbuffer && xQueueSet);
+    configASSERT((pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) == 0);   //Queue sets are not supported by SPSC buffers
 
     portENTER_CRITICAL(&pxRingbuffer->mux);
     if (pxRingbuffer->xQueueSet != NULL || prvCheckItemAvail(pxRingbuffer) == pdTRUE) {
@@ -1349,6 +1938,17 @@ void vRingbufferGetInfo(RingbufHandle_t xRingbuffer,
     if (uxItemsWaiting != NULL) {
         *uxItemsWaiting = (UBaseType_t)(pxRingbuffer->xItemsWaiting);
     }
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //SPSC buffers do not track pucAcquire and xItemsWaiting, derive them from the write and read pointers
+        uint8_t *pucWrite = rbSPSC_LOAD(pxRingbuffer->pucWrite);
+        uint8_t *pucRead = rbSPSC_LOAD(pxRingbuffer->pucRead);
+        if (uxAcquire != NULL) {
+            *uxAcquire = (UBaseType_t)(pucWrite - pxRingbuffer->pucHead);
+        }
+        if (uxItemsWaiting != NULL) {
+            *uxItemsWaiting = (UBaseType_t)((pucWrite >= pucRead) ? pucWrite - pucRead : pxRingbuffer->xSize - (pucRead - pucWrite));
+        }
+    }
     portEXIT_CRITICAL(&pxRingbuffer->mux);
 }
 
@@ -1389,7 +1989,7 @@ RingbufHandle_t xRingbufferCreateWithCaps(size_t xBufferSize, RingbufferType_t x
     uint8_t *pucRingbufferStorage;
 
     //Allocate memory
-    if (xBufferType != RINGBUF_TYPE_BYTEBUF) {
+    if (xBufferType != RINGBUF_TYPE_BYTEBUF && xBufferType != RINGBUF_TYPE_BYTEBUF_SPSC) {
         xBufferSize = rbALIGN_SIZE(xBufferSize);    //xBufferSize is rounded up for no-split/allow-split buffers
     }
 
@@ -0,0 +1,327 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/list.h"
+#include "freertos/task.h"
+#include "freertos/ringbuf.h"
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+//32-bit alignment of the item slots
+#define rbbALIGN_MASK               (0x03)
+#define rbbALIGN_SIZE( xSize )      ( ( ( xSize ) + rbbALIGN_MASK ) & ~rbbALIGN_MASK )
+
+typedef struct {
+    uint32_t ulReadSeq;             //Sequence number of the next item to receive (or of the item being viewed)
+    UBaseType_t uxDropped;          //Number of items overwritten before this reader received them
+    BaseType_t xActive;             //The reader was added and not removed
+    BaseType_t xViewing;            //The reader holds a view of the item ulReadSeq
+} BroadcastReader_t;
+
+typedef struct {
+    size_t xSlotSize;               //Size of each item slot, 32-bit aligned
+    size_t xItemNum;                //Number of item slots
+    UBaseType_t uxMaxReaders;
+    RingbufBroadcastPolicy_t xPolicy;
+    uint32_t ulWriteSeq;            //Sequence number of the next item to send. Item n is stored in slot (n % xItemNum)
+    BaseType_t xAcquired;           //The writer holds slot ulWriteSeq
+    size_t *pxItemSizes;            //Size of the item stored in each slot
+    uint8_t *pucStorage;
+    List_t xTasksWaitingToSend;
+    List_t xTasksWaitingToReceive;
+    portMUX_TYPE mux;
+    BroadcastReader_t xReaders[];
+} RingbufBroadcast_t;
+
+// ------------------------------------------------ Static Declarations ------------------------------------------------
+
+/*
+ * WARNING: The following helper functions must only be called from within a
+ * critical section
+ */
+
+//Checks if slot ulWriteSeq can be written, dropping the oldest item for the lagging readers if allowed
+static BaseType_t prvBroadcastMakeRoom(RingbufBroadcast_t *pxBroadcast);
+
+//Unblocks all the tasks waiting on pxList. Returns pdTRUE if one of them preempts the caller
+static BaseType_t prvBroadcastWakeAll(List_t *pxList);
+
+//Blocks the calling task on pxList. Returns pdTRUE if the task was blocked, pdFALSE if it timed out
+static BaseType_t prvBroadcastBlock(List_t *pxList, TimeOut_t *pxTimeOut, BaseType_t *pxEntryTimeSet, TickType_t *pxTicksToWait);
+
+// ------------------------------------------------ Static Definitions -------------------------------------------------
+
+static BaseType_t prvBroadcastMakeRoom(RingbufBroadcast_t *pxBroadcast)
+{
+    BaseType_t xDrop = pdFALSE;
+
+    //A reader lagging by xItemNum items still needs the slot the writer is about to overwrite
+    for (UBaseType_t i = 0; i < pxBroadcast->uxMaxReaders; i++) {
+        BroadcastReader_t *pxReader = &pxBroadcast->xReaders[i];
+        if (pxReader->xActive == pdFALSE || pxBroadcast->ulWriteSeq - pxReader->ulReadSeq < pxBroadcast->xItemNum) {
+            continue;
+        }
+        if (pxBroadcast->xPolicy == RINGBUF_BROADCAST_BLOCK_ON_SLOWEST || pxReader->xViewing == pdTRUE) {
+            //Never overwrite an item being viewed, even when dropping is allowed
+            return pdFALSE;
+        }
+        xDrop = pdTRUE;
+    }
+
+    //Only drop once we know that the slot can be written, so that a blocked writer does not drop items repeatedly
+    if (xDrop == pdTRUE) {
+        for (UBaseType_t i = 0; i < pxBroadcast->uxMaxReaders; i++) {
+            BroadcastReader_t *pxReader = &pxBroadcast->xReaders[i];
+            if (pxReader->xActive == pdTRUE && pxBroadcast->ulWriteSeq - pxReader->ulReadSeq >= pxBroadcast->xItemNum) {
+                pxReader->ulReadSeq++;
+                pxReader->uxDropped++;
+            }
+        }
+    }
+    return pdTRUE;
+}
+
+static BaseType_t prvBroadcastWakeAll(List_t *pxList)
+{
+    BaseType_t xYield = pdFALSE;
+
+    while (listLIST_IS_EMPTY(pxList) == pdFALSE) {
+        if (xTaskRemoveFromEventList(pxList) == pdTRUE) {
+            xYield = pdTRUE;
+        }
+    }
+    return xYield;
+}
+
+static BaseType_t prvBroadcastBlock(List_t *pxList, TimeOut_t *pxTimeOut, BaseType_t *pxEntryTimeSet, TickType_t *pxTicksToWait)
+{
+    if (*pxTicksToWait == (TickType_t) 0) {
+        //No block time. Return immediately.
+        return pdFALSE;
+    }
+    if (*pxEntryTimeSet == pdFALSE) {
+        //This is our first block. Set entry time
+        vTaskInternalSetTimeOutState(pxTimeOut);
+        *pxEntryTimeSet = pdTRUE;
+    }
+    if (xTaskCheckForTimeOut(pxTimeOut, pxTicksToWait) == pdTRUE) {
+        return pdFALSE;
+    }
+    vTaskPlaceOnEventList(pxList, *pxTicksToWait);
+    portYIELD_WITHIN_API();
+    return pdTRUE;
+}
+
+// ------------------------------------------------- Public Definitions ------------------------------------------------
+
+RingbufBroadcastHandle_t xRingbufferBroadcastCreate(size_t xItemSize, size_t xItemNum, UBaseType_t uxMaxReaders, RingbufBroadcastPolicy_t xPolicy)
+{
+    configASSERT(xItemSize > 0 && xItemNum > 0 && uxMaxReaders > 0);
+    configASSERT(xPolicy < RINGBUF_BROADCAST_POLICY_MAX);
+
+    size_t xSlotSize = rbbALIGN_SIZE(xItemSize);
+    size_t xHeaderSize = rbbALIGN_SIZE(sizeof(RingbufBroadcast_t) + uxMaxReaders * sizeof(BroadcastReader_t));
+    RingbufBroadcast_t *pxBroadcast = calloc(1, xHeaderSize + xItemNum * (sizeof(size_t) + xSlotSize));
+    if (pxBroadcast == NULL) {
+        return NULL;
+    }
+
+    pxBroadcast->xSlotSize = xSlotSize;
+    pxBroadcast->xItemNum = xItemNum;
+    pxBroadcast->uxMaxReaders = uxMaxReaders;
+    pxBroadcast->xPolicy = xPolicy;
+    pxBroadcast->pxItemSizes = (size_t *)((uint8_t *)pxBroadcast + xHeaderSize);
+    pxBroadcast->pucStorage = (uint8_t *)(pxBroadcast->pxItemSizes + xItemNum);
+    vListInitialise(&pxBroadcast->xTasksWaitingToSend);
+    vListInitialise(&pxBroadcast->xTasksWaitingToReceive);
+    portMUX_INITIALIZE(&pxBroadcast->mux);
+    return (RingbufBroadcastHandle_t)pxBroadcast;
+}
+
+void vRingbufferBroadcastDelete(RingbufBroadcastHandle_t xBroadcast)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    configASSERT(pxBroadcast);
+    free(pxBroadcast);
+}
+
+BaseType_t xRingbufferBroadcastAddReader(RingbufBroadcastHandle_t xBroadcast, UBaseType_t *puxReader)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    BaseType_t xReturn = pdFALSE;
+    configASSERT(pxBroadcast && puxReader);
+
+    portENTER_CRITICAL(&pxBroadcast->mux);
+    for (UBaseType_t i = 0; i < pxBroadcast->uxMaxReaders; i++) {
+        BroadcastReader_t *pxReader = &pxBroadcast->xReaders[i];
+        if (pxReader->xActive == pdFALSE) {
+            //The new reader only receives the items sent from now on
+            pxReader->ulReadSeq = pxBroadcast->ulWriteSeq;
+            pxReader->uxDropped = 0;
+            pxReader->xViewing = pdFALSE;
+            pxReader->xActive = pdTRUE;
+            *puxReader = i;
+            xReturn = pdTRUE;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&pxBroadcast->mux);
+    return xReturn;
+}
+
+void vRingbufferBroadcastRemoveReader(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    configASSERT(pxBroadcast && uxReader < pxBroadcast->uxMaxReaders);
+
+    portENTER_CRITICAL(&pxBroadcast->mux);
+    pxBroadcast->xReaders[uxReader].xActive = pdFALSE;
+    pxBroadcast->xReaders[uxReader].xViewing = pdFALSE;
+    //The writer may have been waiting for this reader
+    if (prvBroadcastWakeAll(&pxBroadcast->xTasksWaitingToSend) == pdTRUE) {
+        portYIELD_WITHIN_API();
+    }
+    portEXIT_CRITICAL(&pxBroadcast->mux);
+}
+
+BaseType_t xRingbufferBroadcastSendAcquire(RingbufBroadcastHandle_t xBroadcast, void **ppvItem, TickType_t xTicksToWait)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    BaseType_t xReturn = pdFALSE;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    configASSERT(pxBroadcast && ppvItem);
+
+    portENTER_CRITICAL(&pxBroadcast->mux);
+    configASSERT(pxBroadcast->xAcquired == pdFALSE);
+    while (1) {
+        if (prvBroadcastMakeRoom(pxBroadcast) == pdTRUE) {
+            pxBroadcast->xAcquired = pdTRUE;
+            *ppvItem = pxBroadcast->pucStorage + (pxBroadcast->ulWriteSeq % pxBroadcast->xItemNum) * pxBroadcast->xSlotSize;
+            xReturn = pdTRUE;
+            break;
+        }
+        if (prvBroadcastBlock(&pxBroadcast->xTasksWaitingToSend, &xTimeOut, &xEntryTimeSet, &xTicksToWait) == pdFALSE) {
+            break;
+        }
+        //Unblocked by a returned item or a removed reader, or timed out. Check again.
+        portEXIT_CRITICAL(&pxBroadcast->mux);
+        portENTER_CRITICAL(&pxBroadcast->mux);
+    }
+    portEXIT_CRITICAL(&pxBroadcast->mux);
+    return xReturn;
+}
+
+BaseType_t xRingbufferBroadcastSendComplete(RingbufBroadcastHandle_t xBroadcast, size_t xItemSize)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    configASSERT(pxBroadcast);
+
+    if (xItemSize > pxBroadcast->xSlotSize) {
+        return pdFALSE;
+    }
+    portENTER_CRITICAL(&pxBroadcast->mux);
+    configASSERT(pxBroadcast->xAcquired == pdTRUE);
+    pxBroadcast->pxItemSizes[pxBroadcast->ulWriteSeq % pxBroadcast->xItemNum] = xItemSize;
+    pxBroadcast->ulWriteSeq++;
+    pxBroadcast->xAcquired = pdFALSE;
+    //Each reader has its own cursor, so all the waiting readers get the item
+    if (prvBroadcastWakeAll(&pxBroadcast->xTasksWaitingToReceive) == pdTRUE) {
+        portYIELD_WITHIN_API();
+    }
+    portEXIT_CRITICAL(&pxBroadcast->mux);
+    return pdTRUE;
+}
+
+BaseType_t xRingbufferBroadcastSend(RingbufBroadcastHandle_t xBroadcast, const void *pvItem, size_t xItemSize, TickType_t xTicksToWait)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    void *pvSlot;
+    configASSERT(pxBroadcast && (pvItem != NULL || xItemSize == 0));
+
+    if (xItemSize > pxBroadcast->xSlotSize) {
+        return pdFALSE;
+    }
+    if (xRingbufferBroadcastSendAcquire(xBroadcast, &pvSlot, xTicksToWait) == pdFALSE) {
+        return pdFALSE;
+    }
+    memcpy(pvSlot, pvItem, xItemSize);
+    return xRingbufferBroadcastSendComplete(xBroadcast, xItemSize);
+}
+
+const void *xRingbufferBroadcastReceive(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader, size_t *pxItemSize, TickType_t xTicksToWait)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    const void *pvReturn = NULL;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    configASSERT(pxBroadcast && pxItemSize && uxReader < pxBroadcast->uxMaxReaders);
+    BroadcastReader_t *pxReader = &pxBroadcast->xReaders[uxReader];
+
+    portENTER_CRITICAL(&pxBroadcast->mux);
+    configASSERT(pxReader->xActive == pdTRUE && pxReader->xViewing == pdFALSE);
+    while (1) {
+        if (pxReader->ulReadSeq != pxBroadcast->ulWriteSeq) {
+            size_t xSlot = pxReader->ulReadSeq % pxBroadcast->xItemNum;
+            pxReader->xViewing = pdTRUE;
+            *pxItemSize = pxBroadcast->pxItemSizes[xSlot];
+            pvReturn = pxBroadcast->pucStorage + xSlot * pxBroadcast->xSlotSize;
+            break;
+        }
+        if (prvBroadcastBlock(&pxBroadcast->xTasksWaitingToReceive, &xTimeOut, &xEntryTimeSet, &xTicksToWait) == pdFALSE) {
+            break;
+        }
+        //Unblocked by a sent item, or timed out. Check again.
+        portEXIT_CRITICAL(&pxBroadcast->mux);
+        portENTER_CRITICAL(&pxBroadcast->mux);
+    }
+    portEXIT_CRITICAL(&pxBroadcast->mux);
+    return pvReturn;
+}
+
+void vRingbufferBroadcastReturnItem(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    configASSERT(pxBroadcast && uxReader < pxBroadcast->uxMaxReaders);
+    BroadcastReader_t *pxReader = &pxBroadcast->xReaders[uxReader];
+
+    portENTER_CRITICAL(&pxBroadcast->mux);
+    configASSERT(pxReader->xViewing == pdTRUE);
+    pxReader->xViewing = pdFALSE;
+    pxReader->ulReadSeq++;
+    //Only the writer can be waiting for the slot to be released
+    if (prvBroadcastWakeAll(&pxBroadcast->xTasksWaitingToSend) == pdTRUE) {
+        portYIELD_WITHIN_API();
+    }
+    portEXIT_CRITICAL(&pxBroadcast->mux);
+}
+
+UBaseType_t uxRingbufferBroadcastGetDropped(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    UBaseType_t uxDropped;
+    configASSERT(pxBroadcast && uxReader < pxBroadcast->uxMaxReaders);
+
+    portENTER_CRITICAL(&pxBroadcast->mux);
+    uxDropped = pxBroadcast->xReaders[uxReader].uxDropped;
+    portEXIT_CRITICAL(&pxBroadcast->mux);
+    return uxDropped;
+}
+
+UBaseType_t uxRingbufferBroadcastGetWaiting(RingbufBroadcastHandle_t xBroadcast, UBaseType_t uxReader)
+{
+    RingbufBroadcast_t *pxBroadcast = (RingbufBroadcast_t *)xBroadcast;
+    UBaseType_t uxWaiting;
+    configASSERT(pxBroadcast && uxReader < pxBroadcast->uxMaxReaders);
+
+    portENTER_CRITICAL(&pxBroadcast->mux);
+    uxWaiting = pxBroadcast->ulWriteSeq - pxBroadcast->xReaders[uxReader].ulReadSeq;
+    portEXIT_CRITICAL(&pxBroadcast->mux);
+    return uxWaiting;
+}
@@ -12,6 +12,7 @@
 #include "sdkconfig.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
@@ -617,6 +618,125 @@ TEST_CASE("TC#3: Byte buffer", "[esp_ringbuf][linux]")
     vRingbufferDelete(buffer_handle);
 }
 
+TEST_CASE("TC#1: Byte buffer SPSC", "[esp_ringbuf][linux]")
+{
+    //Create buffer
+    RingbufHandle_t buffer_handle = xRingbufferCreate(BUFFER_SIZE, RINGBUF_TYPE_BYTEBUF_SPSC);
+    TEST_ASSERT_MESSAGE(buffer_handle != NULL, "Failed to create ring buffer");
+
+    //Check buffer free size and max item size upon buffer creation. One byte is reserved in SPSC buffers.
+    TEST_ASSERT_MESSAGE(xRingbufferGetCurFreeSize(buffer_handle) == BUFFER_SIZE - 1, "Incorrect buffer free size received");
+    TEST_ASSERT_MESSAGE(xRingbufferGetMaxItemSize(buffer_handle) == BUFFER_SIZE - 1, "Incorrect max item size received");
+
+    //Calculate number of items to send. Aim to almost fill buffer to setup for wrap around
+    int no_of_items = (BUFFER_SIZE - SMALL_ITEM_SIZE) / SMALL_ITEM_SIZE;
+
+    //Test sending items
+    for (int i = 0; i < no_of_items; i++) {
+        send_item_and_check(buffer_handle, small_item, SMALL_ITEM_SIZE, TIMEOUT_TICKS, false);
+    }
+
+    //Verify items waiting matches with the number of items sent
+    UBaseType_t items_waiting;
+    vRingbufferGetInfo(buffer_handle, NULL, NULL, NULL, NULL, &items_waiting);
+    TEST_ASSERT_MESSAGE(items_waiting == no_of_items * SMALL_ITEM_SIZE, "Incorrect number of bytes waiting");
+
+    //All items sent so far are contiguous, so a single receive should retrieve all of them
+    size_t item_size;
+    uint8_t *item = (uint8_t *)xRingbufferReceive(buffer_handle, &item_size, TIMEOUT_TICKS);
+    TEST_ASSERT_MESSAGE(item != NULL, "Failed to receive item");
+    TEST_ASSERT_EQUAL_MESSAGE(no_of_items * SMALL_ITEM_SIZE, item_size, "Not all contiguous data was received");
+    for (int i = 0; i < item_size; i++) {
+        TEST_ASSERT_MESSAGE(item[i] == small_item[i % SMALL_ITEM_SIZE], "Item data is invalid");
+    }
+    //No further retrieval is allowed until the data is returned
+    size_t dummy_size;
+    TEST_ASSERT_NULL(xRingbufferReceive(buffer_handle, &dummy_size, 0));
+    vRingbufferReturnItem(buffer_handle, (void *)item);
+
+    //Verify that no items are waiting
+    vRingbufferGetInfo(buffer_handle, NULL, NULL, NULL, NULL, &items_waiting);
+    TEST_ASSERT_MESSAGE(items_waiting == 0, "Incorrect number of bytes waiting");
+    TEST_ASSERT_MESSAGE(xRingbufferGetCurFreeSize(buffer_handle) == BUFFER_SIZE - 1, "Incorrect buffer free size received");
+
+    //Write pointer should be near the end, test wrap around
+    UBaseType_t write_pos_before, write_pos_after;
+    vRingbufferGetInfo(buffer_handle, NULL, NULL, &write_pos_before, NULL, NULL);
+    //Send large item that causes wrap around
+    send_item_and_check(buffer_handle, large_item, LARGE_ITEM_SIZE, TIMEOUT_TICKS, false);
+    //Receive wrapped item
+    receive_check_and_return_item_byte_buffer(buffer_handle, large_item, LARGE_ITEM_SIZE, TIMEOUT_TICKS, false);
+    vRingbufferGetInfo(buffer_handle, NULL, NULL, &write_pos_after, NULL, NULL);
+    TEST_ASSERT_MESSAGE(write_pos_after < write_pos_before, "Failed to wrap around");
+
+    //Fill the buffer completely. Sending a single further byte must fail.
+    for (int i = 0; i < BUFFER_SIZE - 1; i++) {
+        send_item_and_check(buffer_handle, small_item, 1, TIMEOUT_TICKS, false);
+    }
+    TEST_ASSERT_MESSAGE(xRingbufferGetCurFreeSize(buffer_handle) == 0, "Buffer full not achieved");
+    send_item_and_check_failure(buffer_handle, small_item, 1, TIMEOUT_TICKS, false);
+
+    //Cleanup
+    vRingbufferDelete(buffer_handle);
+}
+
+/* ------------------------ Test ring buffer batch API -------------------------
+ * The following test case tests sending, receiving and returning multiple items
+ * with a single call for no-split and byte buffers.
+ */
+
+TEST_CASE("Test ring buffer batch send and receive", "[esp_ringbuf][linux]")
+{
+    //BUFFER_SIZE fits exactly 4 medium items in a no-split buffer
+    const void *items[5];
+    size_t item_sizes[5];
+    void *rec_items[8];
+    size_t rec_sizes[8];
+    for (int i = 0; i < 5; i++) {
+        items[i] = large_item;
+        item_sizes[i] = MEDIUM_ITEM_SIZE;
+    }
+
+    RingbufHandle_t no_split_rb = xRingbufferCreate(BUFFER_SIZE, RINGBUF_TYPE_NOSPLIT);
+    TEST_ASSERT_MESSAGE(no_split_rb != NULL, "Failed to create ring buffer");
+    size_t free_size = xRingbufferGetCurFreeSize(no_split_rb);
+
+    //Only the items that fit should be sent
+    TEST_ASSERT_EQUAL(4, xRingbufferSendBatch(no_split_rb, items, item_sizes, 5, 0));
+    TEST_ASSERT_EQUAL(0, xRingbufferSendBatch(no_split_rb, items, item_sizes, 1, TIMEOUT_TICKS));
+
+    //All sent items should be retrieved with a single call, in order
+    TEST_ASSERT_EQUAL(4, xRingbufferReceiveBatch(no_split_rb, rec_items, rec_sizes, 8, TIMEOUT_TICKS));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(MEDIUM_ITEM_SIZE, rec_sizes[i]);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(large_item, rec_items[i], MEDIUM_ITEM_SIZE);
+        if (i > 0) {
+            TEST_ASSERT_TRUE(rec_items[i] > rec_items[i - 1]);
+        }
+    }
+    TEST_ASSERT_EQUAL(0, xRingbufferReceiveBatch(no_split_rb, rec_items, rec_sizes, 8, 0));
+    vRingbufferReturnItemBatch(no_split_rb, rec_items, 4);
+    TEST_ASSERT_EQUAL_MESSAGE(free_size, xRingbufferGetCurFreeSize(no_split_rb), "Items were not returned");
+    vRingbufferDelete(no_split_rb);
+
+    //Byte buffers merge all items, so they should be retrieved as a single item
+    for (int i = 0; i < 3; i++) {
+        items[i] = small_item;
+        item_sizes[i] = SMALL_ITEM_SIZE;
+    }
+    RingbufHandle_t byte_rb = xRingbufferCreate(BUFFER_SIZE, RINGBUF_TYPE_BYTEBUF);
+    TEST_ASSERT_MESSAGE(byte_rb != NULL, "Failed to create ring buffer");
+    TEST_ASSERT_EQUAL(3, xRingbufferSendBatch(byte_rb, items, item_sizes, 3, TIMEOUT_TICKS));
+    TEST_ASSERT_EQUAL(1, xRingbufferReceiveBatch(byte_rb, rec_items, rec_sizes, 8, TIMEOUT_TICKS));
+    TEST_ASSERT_EQUAL(3 * SMALL_ITEM_SIZE, rec_sizes[0]);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(small_item, (uint8_t *)rec_items[0] + i * SMALL_ITEM_SIZE, SMALL_ITEM_SIZE);
+    }
+    vRingbufferReturnItemBatch(byte_rb, rec_items, 1);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE, xRingbufferGetCurFreeSize(byte_rb));
+    vRingbufferDelete(byte_rb);
+}
+
 /* ----------------------- Ring buffer queue sets test ------------------------
  * The following test case will test receiving from ring buffers that have been
  * added to a queue set. The test case will do the following...
@@ -767,7 +887,7 @@ void read_from_buffer(RingbufHandle_t buffer, RingbufferType_t buf_type, size_t
 
             //Check received item and return it
             TEST_ASSERT_MESSAGE(item_data != NULL, "Failed to receive an item");
-            if (buf_type == RINGBUF_TYPE_BYTEBUF) {
+            if (buf_type == RINGBUF_TYPE_BYTEBUF || buf_type == RINGBUF_TYPE_BYTEBUF_SPSC) {
                 TEST_ASSERT_MESSAGE(item_size <= max_rec_size, "Received data exceeds max size");
             }
             for (int i = 0; i < item_size; i++) {
@@ -1124,3 +1244,103 @@ TEST_CASE("Test no-split buffers can receive items if the acquire pointer wraps
     // Cleanup
     vRingbufferDelete(buffer_handle);
 }
+
+/* --------------------------------------- Test broadcast ring buffers --------------------------------------- */
+
+#define BROADCAST_ITEM_NUM          4
+
+static void broadcast_send(RingbufBroadcastHandle_t broadcast, uint32_t value, TickType_t ticks_to_wait, BaseType_t expected)
+{
+    TEST_ASSERT_EQUAL(expected, xRingbufferBroadcastSend(broadcast, &value, sizeof(value), ticks_to_wait));
+}
+
+static void broadcast_receive_and_check(RingbufBroadcastHandle_t broadcast, UBaseType_t reader, uint32_t expected_value)
+{
+    size_t item_size;
+    const uint32_t *item = xRingbufferBroadcastReceive(broadcast, reader, &item_size, TIMEOUT_TICKS);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL(sizeof(uint32_t), item_size);
+    TEST_ASSERT_EQUAL(expected_value, *item);
+    vRingbufferBroadcastReturnItem(broadcast, reader);
+}
+
+TEST_CASE("Test broadcast ring buffer", "[esp_ringbuf][linux]")
+{
+    UBaseType_t readers[2];
+    size_t item_size;
+
+    // Block on the slowest reader
+    RingbufBroadcastHandle_t broadcast = xRingbufferBroadcastCreate(SMALL_ITEM_SIZE, BROADCAST_ITEM_NUM, 2, RINGBUF_BROADCAST_BLOCK_ON_SLOWEST);
+    TEST_ASSERT_NOT_NULL(broadcast);
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferBroadcastAddReader(broadcast, &readers[0]));
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferBroadcastAddReader(broadcast, &readers[1]));
+    TEST_ASSERT_EQUAL(pdFALSE, xRingbufferBroadcastAddReader(broadcast, &readers[1]));
+    TEST_ASSERT_NULL(xRingbufferBroadcastReceive(broadcast, readers[0], &item_size, 0));
+
+    for (uint32_t i = 0; i < BROADCAST_ITEM_NUM; i++) {
+        broadcast_send(broadcast, i, 0, pdTRUE);
+    }
+    broadcast_send(broadcast, BROADCAST_ITEM_NUM, TIMEOUT_TICKS, pdFALSE);
+    TEST_ASSERT_EQUAL(pdFALSE, xRingbufferBroadcastSend(broadcast, large_item, LARGE_ITEM_SIZE, 0));
+
+    // The fast reader receives everything, the slow reader still holds back the writer
+    for (uint32_t i = 0; i < BROADCAST_ITEM_NUM; i++) {
+        broadcast_receive_and_check(broadcast, readers[0], i);
+    }
+    TEST_ASSERT_EQUAL(0, uxRingbufferBroadcastGetWaiting(broadcast, readers[0]));
+    TEST_ASSERT_EQUAL(BROADCAST_ITEM_NUM, uxRingbufferBroadcastGetWaiting(broadcast, readers[1]));
+    broadcast_send(broadcast, BROADCAST_ITEM_NUM, 0, pdFALSE);
+
+    broadcast_receive_and_check(broadcast, readers[1], 0);
+    broadcast_send(broadcast, BROADCAST_ITEM_NUM, 0, pdTRUE);
+    broadcast_receive_and_check(broadcast, readers[0], BROADCAST_ITEM_NUM);
+
+    // Removing the slow reader frees the writer
+    vRingbufferBroadcastRemoveReader(broadcast, readers[1]);
+    broadcast_send(broadcast, BROADCAST_ITEM_NUM + 1, 0, pdTRUE);
+    TEST_ASSERT_EQUAL(0, uxRingbufferBroadcastGetDropped(broadcast, readers[0]));
+    vRingbufferBroadcastDelete(broadcast);
+
+    // Drop the oldest item for the slow reader
+    broadcast = xRingbufferBroadcastCreate(SMALL_ITEM_SIZE, BROADCAST_ITEM_NUM, 2, RINGBUF_BROADCAST_DROP_OLDEST);
+    TEST_ASSERT_NOT_NULL(broadcast);
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferBroadcastAddReader(broadcast, &readers[0]));
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferBroadcastAddReader(broadcast, &readers[1]));
+    for (uint32_t i = 0; i < BROADCAST_ITEM_NUM + 2; i++) {
+        broadcast_send(broadcast, i, 0, pdTRUE);
+        broadcast_receive_and_check(broadcast, readers[0], i);
+    }
+    TEST_ASSERT_EQUAL(0, uxRingbufferBroadcastGetDropped(broadcast, readers[0]));
+    TEST_ASSERT_EQUAL(2, uxRingbufferBroadcastGetDropped(broadcast, readers[1]));
+    TEST_ASSERT_EQUAL(BROADCAST_ITEM_NUM, uxRingbufferBroadcastGetWaiting(broadcast, readers[1]));
+
+    // An item being viewed is never overwritten
+    const uint32_t *view1 = xRingbufferBroadcastReceive(broadcast, readers[1], &item_size, 0);
+    TEST_ASSERT_NOT_NULL(view1);
+    TEST_ASSERT_EQUAL(2, *view1);
+    broadcast_send(broadcast, BROADCAST_ITEM_NUM + 2, 0, pdFALSE);
+    TEST_ASSERT_EQUAL(2, *view1);
+    vRingbufferBroadcastReturnItem(broadcast, readers[1]);
+    broadcast_send(broadcast, BROADCAST_ITEM_NUM + 2, 0, pdTRUE);
+    broadcast_receive_and_check(broadcast, readers[0], BROADCAST_ITEM_NUM + 2);
+    for (uint32_t i = 3; i < BROADCAST_ITEM_NUM + 3; i++) {
+        broadcast_receive_and_check(broadcast, readers[1], i);
+    }
+    TEST_ASSERT_EQUAL(2, uxRingbufferBroadcastGetDropped(broadcast, readers[1]));
+
+    // Zero-copy send, both readers view the item in place
+    void *slot;
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferBroadcastSendAcquire(broadcast, &slot, 0));
+    memcpy(slot, small_item, SMALL_ITEM_SIZE);
+    TEST_ASSERT_EQUAL(pdFALSE, xRingbufferBroadcastSendComplete(broadcast, LARGE_ITEM_SIZE));
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferBroadcastSendComplete(broadcast, SMALL_ITEM_SIZE));
+    for (int i = 0; i < 2; i++) {
+        const void *item = xRingbufferBroadcastReceive(broadcast, readers[i], &item_size, 0);
+        TEST_ASSERT_EQUAL_PTR(slot, item);
+        TEST_ASSERT_EQUAL(SMALL_ITEM_SIZE, item_size);
+        TEST_ASSERT_EQUAL_MEMORY(small_item, item, SMALL_ITEM_SIZE);
+        vRingbufferBroadcastReturnItem(broadcast, readers[i]);
+    }
+
+    vRingbufferBroadcastDelete(broadcast);
+}
@@ -77,9 +77,10 @@ def main() -> None:
     #    to have a stable sorting order in case when the same startup function is defined in multiple files,
     #    for example for different targets.
     #
-    def sort_key(entry: StartupEntry) -> typing.Tuple[str, int, str]:
-        # luckily 'core' and 'secondary' are in alphabetical order, so we can return the string
-        return (entry.stage, entry.priority, entry.filename)
+    def sort_key(entry: StartupEntry) -> typing.Tuple[int, int, str]:
+        # DEFERRABLE functions are listed among the SECONDARY ones, in the order they are executed by default
+        stage_order = {'CORE': 0, 'SECONDARY': 1, 'DEFERRABLE': 1}
+        return (stage_order[entry.stage], entry.priority, entry.filename)
 
     startup_entries = list(sorted(startup_entries, key=sort_key))
     startup_entries_lines = [str(entry) for entry in startup_entries]
@@ -13,6 +13,8 @@
 #include "soc/periph_defs.h"
 #include "soc/system_intr.h"
 #include "hal/crosscore_int_ll.h"
+#include "esp_private/esp_ipc.h"
+#include "esp_private/crosscore_int.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/portmacro.h"
@@ -26,6 +28,7 @@
 #define REASON_PRINT_BACKTRACE  BIT(2)
 #define REASON_GDB_CALL         BIT(3)
 #define REASON_TWDT_ABORT       BIT(4)
+#define REASON_IPC_CALL         BIT(5)
 
 static portMUX_TYPE reason_spinlock = portMUX_INITIALIZER_UNLOCKED;
 static volatile uint32_t reason[CONFIG_FREERTOS_NUMBER_OF_CORES];
@@ -83,6 +86,11 @@ static void IRAM_ATTR esp_crosscore_isr(void *arg)
     }
 #endif // CONFIG_ESP_TASK_WDT_EN
 
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+    if (my_reason_val & REASON_IPC_CALL) {
+        esp_ipc_fast_call_drain();
+    }
+#endif // CONFIG_ESP_IPC_FAST_CALL_ENABLE
 }
 
 //Initialize the crosscore interrupt on this core. Call this once
@@ -142,3 +150,10 @@ void IRAM_ATTR esp_crosscore_int_send_twdt_abort(int core_id)
     esp_crosscore_int_send(core_id, REASON_TWDT_ABORT);
 }
 #endif // CONFIG_ESP_TASK_WDT_EN
+
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+void IRAM_ATTR esp_crosscore_int_send_ipc_call(int core_id)
+{
+    esp_crosscore_int_send(core_id, REASON_IPC_CALL);
+}
+#endif // CONFIG_ESP_IPC_FAST_CALL_ENABLE
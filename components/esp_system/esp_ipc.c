@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -9,9 +9,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <stdatomic.h>
 #include "esp_err.h"
 #include "esp_ipc.h"
 #include "esp_private/esp_ipc_isr.h"
+#include "esp_private/esp_ipc.h"
+#include "esp_private/crosscore_int.h"
 #include "esp_attr.h"
 #include "esp_cpu.h"
 
@@ -49,6 +52,30 @@ static volatile esp_ipc_func_t s_no_block_func[portNUM_PROCESSORS] = { 0 };
 static volatile bool s_no_block_func_and_arg_are_ready[portNUM_PROCESSORS] = { 0 };
 static void * volatile s_no_block_func_arg[portNUM_PROCESSORS];
 
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+#define IPC_FAST_CALL_QUEUE_SIZE CONFIG_ESP_IPC_FAST_CALL_QUEUE_SIZE
+_Static_assert((IPC_FAST_CALL_QUEUE_SIZE & (IPC_FAST_CALL_QUEUE_SIZE - 1)) == 0, "CONFIG_ESP_IPC_FAST_CALL_QUEUE_SIZE must be a power of 2");
+
+typedef struct {
+    atomic_uint seq;        // position the cell is ready for: pos when free, pos + 1 when it holds the call of pos
+    esp_ipc_func_t func;
+    void *arg;
+} ipc_fast_call_cell_t;
+
+/*
+ * Bounded ring buffer with multiple producers (any CPU calling esp_ipc_call_fast) and a single consumer
+ * (the crosscore interrupt of the target CPU). A producer claims a position with a CAS on tail, writes the call
+ * into the cell and publishes it by updating the sequence number of the cell. The consumer reads the cells in order.
+ */
+typedef struct {
+    atomic_uint tail;       // next position to be claimed by a producer
+    unsigned head;          // next position to be executed, only accessed by the consumer
+    ipc_fast_call_cell_t cells[IPC_FAST_CALL_QUEUE_SIZE];
+} ipc_fast_call_queue_t;
+
+static DRAM_ATTR ipc_fast_call_queue_t s_fast_call_queue[CONFIG_FREERTOS_NUMBER_OF_CORES];
+#endif // CONFIG_ESP_IPC_FAST_CALL_ENABLE
+
 static void IRAM_ATTR ipc_task(void* arg)
 {
     const int cpuid = (int) arg;
@@ -115,6 +142,13 @@ static void esp_ipc_init(void)
                                                  IPC_MAX_PRIORITY, &s_ipc_task_handle[i], i);
         assert(res == pdTRUE);
         (void)res;
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+        atomic_init(&s_fast_call_queue[i].tail, 0);
+        s_fast_call_queue[i].head = 0;
+        for (unsigned pos = 0; pos < IPC_FAST_CALL_QUEUE_SIZE; pos++) {
+            atomic_init(&s_fast_call_queue[i].cells[pos].seq, pos);
+        }
+#endif
     }
 }
 
@@ -169,6 +203,35 @@ esp_err_t esp_ipc_call_blocking(uint32_t cpu_id, esp_ipc_func_t func, void* arg)
     return esp_ipc_call_and_wait(cpu_id, func, arg, IPC_WAIT_FOR_END);
 }
 
+typedef struct {
+    const esp_ipc_batch_entry_t *entries;
+    size_t count;
+} ipc_batch_t;
+
+static void ipc_batch_run(void *arg)
+{
+    const ipc_batch_t *batch = arg;
+    for (size_t i = 0; i < batch->count; i++) {
+        (*batch->entries[i].func)(batch->entries[i].arg);
+    }
+}
+
+esp_err_t esp_ipc_call_batch(uint32_t cpu_id, const esp_ipc_batch_entry_t *entries, size_t count)
+{
+    if (count == 0) {
+        return cpu_id < CONFIG_FREERTOS_NUMBER_OF_CORES ? ESP_OK : ESP_ERR_INVALID_ARG;
+    }
+    if (entries == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // The batch lives on the stack of the caller, which is blocked until the last callback has returned
+    ipc_batch_t batch = {
+        .entries = entries,
+        .count = count,
+    };
+    return esp_ipc_call_and_wait(cpu_id, ipc_batch_run, &batch, IPC_WAIT_FOR_END);
+}
+
 esp_err_t esp_ipc_call_nonblocking(uint32_t cpu_id, esp_ipc_func_t func, void* arg)
 {
     if (cpu_id >= portNUM_PROCESSORS || s_ipc_task_handle[cpu_id] == NULL) {
@@ -198,4 +261,61 @@ esp_err_t esp_ipc_call_nonblocking(uint32_t cpu_id, esp_ipc_func_t func, void* a
     return ESP_FAIL;
 }
 
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+esp_err_t IRAM_ATTR esp_ipc_call_fast(uint32_t cpu_id, esp_ipc_func_t func, void *arg)
+{
+    if (cpu_id >= CONFIG_FREERTOS_NUMBER_OF_CORES || func == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ipc_fast_call_queue_t *queue = &s_fast_call_queue[cpu_id];
+    ipc_fast_call_cell_t *cell;
+
+    // Interrupts are masked between claiming the cell and publishing it, a preempted caller would otherwise
+    // hold back the calls queued after its own. Callers running on the other CPU are not blocked.
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    unsigned pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    while (true) {
+        cell = &queue->cells[pos & (IPC_FAST_CALL_QUEUE_SIZE - 1)];
+        int diff = (int)(atomic_load_explicit(&cell->seq, memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the target CPU hasn't executed the call of this cell yet
+            portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+            return ESP_FAIL;
+        } else {
+            pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+    cell->func = func;
+    cell->arg = arg;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+
+    esp_crosscore_int_send_ipc_call(cpu_id);
+    return ESP_OK;
+}
+
+void IRAM_ATTR esp_ipc_fast_call_drain(void)
+{
+    ipc_fast_call_queue_t *queue = &s_fast_call_queue[esp_cpu_get_core_id()];
+
+    while (true) {
+        unsigned pos = queue->head;
+        ipc_fast_call_cell_t *cell = &queue->cells[pos & (IPC_FAST_CALL_QUEUE_SIZE - 1)];
+        if (atomic_load_explicit(&cell->seq, memory_order_acquire) != pos + 1) {
+            // empty, or the cell is still being written: its producer raises the interrupt again once published
+            break;
+        }
+        esp_ipc_func_t func = cell->func;
+        void *arg = cell->arg;
+        queue->head = pos + 1;
+        atomic_store_explicit(&cell->seq, pos + IPC_FAST_CALL_QUEUE_SIZE, memory_order_release);
+        (*func)(arg);
+    }
+}
+#endif // CONFIG_ESP_IPC_FAST_CALL_ENABLE
+
 #endif // !defined(CONFIG_FREERTOS_UNICORE) || defined(CONFIG_APPTRACE_GCOV_ENABLE)
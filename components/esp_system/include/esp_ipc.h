@@ -1,11 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #pragma once
 
+#include <stddef.h>
 #include <esp_err.h>
 
 #ifdef __cplusplus
@@ -71,6 +72,57 @@ esp_err_t esp_ipc_call(uint32_t cpu_id, esp_ipc_func_t func, void* arg);
  */
 esp_err_t esp_ipc_call_blocking(uint32_t cpu_id, esp_ipc_func_t func, void* arg);
 
+/**
+ * @brief IPC batch entry, see esp_ipc_call_batch()
+ */
+typedef struct {
+    esp_ipc_func_t func;    /*!< Callback to be executed */
+    void *arg;              /*!< Argument passed into the callback */
+} esp_ipc_batch_entry_t;
+
+/**
+ * @brief Execute several callbacks on a given CPU and block until they all complete
+ *
+ * The callbacks are executed in order by the IPC task of the given CPU, like esp_ipc_call_blocking()
+ * would do, but with a single wake-up of the IPC task and a single acknowledgment for the whole batch.
+ *
+ * @param[in]   cpu_id   CPU where the given functions should be executed (0 or 1)
+ * @param[in]   entries  Array of callbacks and arguments
+ * @param[in]   count    Number of entries in the array
+ *
+ * @return
+ *      - ESP_ERR_INVALID_ARG if cpu_id is invalid, or entries is NULL while count is not 0
+ *      - ESP_ERR_INVALID_STATE if the FreeRTOS scheduler is not running
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_call_batch(uint32_t cpu_id, const esp_ipc_batch_entry_t *entries, size_t count);
+
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+/**
+ * @brief Execute a callback on a given CPU from its crosscore interrupt, without blocking
+ *
+ * The callback is queued into a lock-free ring buffer of the given CPU, which is drained by the crosscore interrupt
+ * of that CPU. Unlike esp_ipc_call(), no mutex, semaphore or IPC task is involved, thus this function can be called
+ * from interrupts, when the scheduler is suspended and at high rates. The callbacks queued by a CPU are executed in
+ * order.
+ *
+ * @note The callback is executed in interrupt context: it must be short, must not block and must be placed in IRAM
+ *       along with the data it accesses if it may be called while the cache is disabled. Only FreeRTOS FromISR APIs
+ *       can be called from it.
+ * @note The function does not wait for the callback to begin or complete execution.
+ *
+ * @param[in]   cpu_id  CPU where the given function should be executed (0 or 1)
+ * @param[in]   func    Pointer to a function of type void func(void* arg) to be executed
+ * @param[in]   arg     Arbitrary argument of type void* to be passed into the function
+ *
+ * @return
+ *      - ESP_ERR_INVALID_ARG if cpu_id or func is invalid
+ *      - ESP_FAIL if the queue of the given CPU is full, see CONFIG_ESP_IPC_FAST_CALL_QUEUE_SIZE
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_call_fast(uint32_t cpu_id, esp_ipc_func_t func, void *arg);
+#endif // CONFIG_ESP_IPC_FAST_CALL_ENABLE
+
 #endif // !defined(CONFIG_FREERTOS_UNICORE) || defined(CONFIG_APPTRACE_GCOV_ENABLE)
 
 #ifdef __cplusplus
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -59,6 +59,19 @@ void esp_crosscore_int_send_gdb_call(int core_id);
  */
 void esp_crosscore_int_send_print_backtrace(int core_id);
 
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+/**
+ * Send an interrupt to a CPU indicating it should execute the IPC fast calls
+ * queued for it.
+ *
+ * This is used internally by esp_ipc_call_fast() and should not be called
+ * from application code.
+ *
+ * @param core_id Core that should execute the fast calls
+ */
+void esp_crosscore_int_send_ipc_call(int core_id);
+#endif // CONFIG_ESP_IPC_FAST_CALL_ENABLE
+
 #if CONFIG_ESP_TASK_WDT_EN
 /**
  * Send an interrupt to a CPU indicating it call `task_wdt_timeout_abort_xtensa`.
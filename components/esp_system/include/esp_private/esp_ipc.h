@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -40,6 +40,15 @@ extern "C" {
  */
 esp_err_t esp_ipc_call_nonblocking(uint32_t cpu_id, esp_ipc_func_t func, void* arg);
 
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+/**
+ * @brief Execute the fast calls queued for the current CPU by esp_ipc_call_fast()
+ *
+ * @note Called from the crosscore interrupt, should not be called from the application.
+ */
+void esp_ipc_fast_call_drain(void);
+#endif // CONFIG_ESP_IPC_FAST_CALL_ENABLE
+
 #endif // !defined(CONFIG_FREERTOS_UNICORE) || defined(CONFIG_APPTRACE_GCOV_ENABLE)
 
 #ifdef __cplusplus
@@ -45,17 +45,22 @@ void startup_resume_other_cores(void);
 typedef struct {
     esp_err_t (*fn)(void);   /*!< Pointer to the startup function */
     uint16_t cores;          /*!< Bit mask of cores where the function has to be called */
-    uint16_t stage;          /*!< Init stage number (0 or 1) */
+    uint16_t stage;          /*!< Init stage number (0, 1 or 2) */
 } esp_system_init_fn_t;
 
 #define ESP_SYSTEM_INIT_STAGE_CORE          0
 #define ESP_SYSTEM_INIT_STAGE_SECONDARY     1
+#if CONFIG_ESP_SYSTEM_DEFERRED_INIT
+#define ESP_SYSTEM_INIT_STAGE_DEFERRABLE    2
+#else
+#define ESP_SYSTEM_INIT_STAGE_DEFERRABLE    ESP_SYSTEM_INIT_STAGE_SECONDARY
+#endif
 
 /**
  * @brief Define a system initialization function which will be executed on the specified cores
  *
  * @param f  function name (identifier)
- * @param stage_  init stage name (CORE or SECONDARY)
+ * @param stage_  init stage name (CORE, SECONDARY or DEFERRABLE)
  * @param c  bit mask of cores to execute the function on (ex. if BIT0 is set, the function
  *           will be executed on CPU 0, if BIT1 is set - on CPU 1, and so on)
  * @param priority  integer, priority of the initialization function. Higher values mean that
@@ -65,6 +70,12 @@ typedef struct {
  * The function defined using this macro must return ESP_OK on success. Any other value will be
  * logged and the startup process will abort.
  *
+ * DEFERRABLE functions are SECONDARY functions which are not needed before app_main starts.
+ * If CONFIG_ESP_SYSTEM_DEFERRED_INIT is enabled, they are called after all the SECONDARY
+ * functions, in the order of their priorities, from a task running at the same time as app_main.
+ * The core mask must then be BIT(0), the task is pinned to the core which does not run app_main,
+ * if any.
+ *
  * Initialization functions should be placed in a compilation unit where at least one other
  * symbol is referenced in another compilation unit. This means that the reference should not itself
  * get optimized out by the compiler or discarded by the linker if the related feature is used.
@@ -87,6 +98,14 @@ typedef struct {
 #define ESP_SYSTEM_INIT_ALL_CORES (BIT(SOC_CPU_CORES_NUM) - 1)
 #endif
 
+/**
+ * @brief Wait until the DEFERRABLE init functions have been called
+ *
+ * Returns at once if CONFIG_ESP_SYSTEM_DEFERRED_INIT is disabled, as these functions are then
+ * called before app_main. Must not be called from a DEFERRABLE init function.
+ */
+void esp_system_init_wait_deferred(void);
+
 extern uint64_t g_startup_time;   // Startup time that serves as the point of origin for system time. Should be set by the entry
 // function in the port layer. May be 0 as well if this is not backed by a persistent counter, in which case
 // startup time = system time = 0 at the point the entry function sets this variable.
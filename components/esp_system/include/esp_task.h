@@ -56,5 +56,9 @@
 #define ESP_TASK_MAIN_PRIO            (ESP_TASK_PRIO_MIN + 1)
 #define ESP_TASK_MAIN_STACK           (CONFIG_ESP_MAIN_TASK_STACK_SIZE + TASK_EXTRA_STACK_SIZE)
 #define ESP_TASK_MAIN_CORE            CONFIG_ESP_MAIN_TASK_AFFINITY
+#define ESP_TASK_DEFERRED_INIT_PRIO   (ESP_TASK_PRIO_MIN + 1)
+#define ESP_TASK_DEFERRED_INIT_STACK  (CONFIG_ESP_SYSTEM_DEFERRED_INIT_TASK_STACK_SIZE + TASK_EXTRA_STACK_SIZE)
+#define ESP_TASK_PSRAM_MEMTEST_PRIO   (ESP_TASK_PRIO_MIN + 1)
+#define ESP_TASK_PSRAM_MEMTEST_STACK  (2048 + TASK_EXTRA_STACK_SIZE)
 
 #endif
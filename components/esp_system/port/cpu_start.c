@@ -633,7 +633,12 @@ void IRAM_ATTR call_start_cpu0(void)
 
 #if CONFIG_SPIRAM_MEMTEST
     if (esp_psram_is_initialized()) {
+#if CONFIG_SPIRAM_MEMTEST_IN_BACKGROUND
+        // The PSRAM heap is tested in the background, before being added to the heap allocator
+        bool ext_ram_ok = esp_psram_extram_test_non_heap();
+#else
         bool ext_ram_ok = esp_psram_extram_test();
+#endif
         if (!ext_ram_ok) {
             ESP_EARLY_LOGE(TAG, "External RAM failed memory test!");
             abort();
@@ -22,6 +22,13 @@
 
 #include "esp_private/startup_internal.h"
 
+#if CONFIG_ESP_SYSTEM_DEFERRED_INIT
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_task.h"
+#endif
+
 // Ensure that system configuration matches the underlying number of cores.
 // This should enable us to avoid checking for both every time.
 #if !(SOC_CPU_CORES_NUM > 1) && !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
@@ -114,7 +121,7 @@ static void do_global_ctors(void)
  * linker. The functions are sorted by their priority value.
  * The sequence of the init function calls (sorted by priority) is documented in
  * system_init_fn.txt file.
- * @param stage_num Stage number of the init function call (0, 1).
+ * @param stage_num Stage number of the init function call (0, 1, 2).
  */
 __attribute__((no_sanitize_undefined)) /* TODO: IDF-8133 */
 static void do_system_init_fn(uint32_t stage_num)
@@ -125,8 +132,14 @@ static void do_system_init_fn(uint32_t stage_num)
     esp_system_init_fn_t *p;
 
     int core_id = esp_cpu_get_core_id();
+#if CONFIG_ESP_SYSTEM_DEFERRED_INIT
+    // The deferred init task may run on any core, it calls all the DEFERRABLE functions
+    uint32_t core_mask = (stage_num == ESP_SYSTEM_INIT_STAGE_DEFERRABLE) ? UINT32_MAX : BIT(core_id);
+#else
+    uint32_t core_mask = BIT(core_id);
+#endif
     for (p = &_esp_system_init_fn_array_start; p < &_esp_system_init_fn_array_end; ++p) {
-        if (p->stage == stage_num && (p->cores & BIT(core_id)) != 0) {
+        if (p->stage == stage_num && (p->cores & core_mask) != 0) {
             // During core init, stdout is not initialized yet, so use early logging.
             ESP_EARLY_LOGD(TAG, "calling init function: %p on core: %d", p->fn, core_id);
             esp_err_t err = (*(p->fn))();
@@ -138,10 +151,57 @@ static void do_system_init_fn(uint32_t stage_num)
     }
 
 #if !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
+#if CONFIG_ESP_SYSTEM_DEFERRED_INIT
+    if (stage_num == ESP_SYSTEM_INIT_STAGE_DEFERRABLE) {
+        return;
+    }
+#endif
     s_system_inited[core_id] = true;
 #endif
 }
 
+#if CONFIG_ESP_SYSTEM_DEFERRED_INIT
+// Run the deferred init functions on the core which does not run app_main, if any
+#if !CONFIG_FREERTOS_UNICORE && ESP_TASK_MAIN_CORE == 0
+#define DEFERRED_INIT_TASK_CORE 1
+#elif !CONFIG_FREERTOS_UNICORE && ESP_TASK_MAIN_CORE == 1
+#define DEFERRED_INIT_TASK_CORE 0
+#else
+#define DEFERRED_INIT_TASK_CORE tskNO_AFFINITY
+#endif
+
+static SemaphoreHandle_t s_deferred_init_done;
+static StaticSemaphore_t s_deferred_init_done_buf;
+
+static void deferred_init_task(void *arg)
+{
+    do_system_init_fn(ESP_SYSTEM_INIT_STAGE_DEFERRABLE);
+    xSemaphoreGive(s_deferred_init_done);
+    vTaskDelete(NULL);
+}
+
+/* Create the task calling the deferred init functions. It starts with the scheduler. */
+static void start_deferred_init(void)
+{
+    s_deferred_init_done = xSemaphoreCreateBinaryStatic(&s_deferred_init_done_buf);
+    BaseType_t res = xTaskCreatePinnedToCore(deferred_init_task, "sys_init", ESP_TASK_DEFERRED_INIT_STACK, NULL,
+                                             ESP_TASK_DEFERRED_INIT_PRIO, NULL, DEFERRED_INIT_TASK_CORE);
+    if (res != pdTRUE) {
+        ESP_EARLY_LOGE(TAG, "failed to create the deferred init task, aborting");
+        abort();
+    }
+}
+#endif // CONFIG_ESP_SYSTEM_DEFERRED_INIT
+
+void esp_system_init_wait_deferred(void)
+{
+#if CONFIG_ESP_SYSTEM_DEFERRED_INIT
+    // Every waiter gives the semaphore back, so that the next one does not block
+    xSemaphoreTake(s_deferred_init_done, portMAX_DELAY);
+    xSemaphoreGive(s_deferred_init_done);
+#endif
+}
+
 #if !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
 static void  esp_startup_start_app_other_cores_default(void)
 {
@@ -209,6 +269,10 @@ static void start_cpu0_default(void)
     // until all cores finish (when !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE).
     do_secondary_init();
 
+#if CONFIG_ESP_SYSTEM_DEFERRED_INIT
+    start_deferred_init();
+#endif
+
 #if SOC_CPU_CORES_NUM > 1 && !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
     s_system_full_inited = true;
 #endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdatomic.h>
 #include <sys/queue.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
@@ -63,14 +64,27 @@ struct twdt_entry {
     SLIST_ENTRY(twdt_entry) slist_entry;
     TaskHandle_t task_handle;   // NULL if user entry
     const char *user_name;      // NULL if task entry
-    bool has_reset;
+    uint32_t slot;              // Index of the entry in the bitmaps of twdt_obj_t
 };
 
+/* Each entry owns a slot of the bitmaps below. Resetting an entry sets its bit in fed_bitmap with an atomic OR,
+ * without taking the spinlock, unless this completes the bitmap: the spinlock is then taken to feed the timer
+ * and clear the bitmap. */
+#define TWDT_BITMAP_WORDS   ((CONFIG_ESP_TASK_WDT_MAX_ENTRIES + 31) / 32)
+
+#if CONFIG_ESP_TASK_WDT_TLS_LOOKUP
+/* Slot + 1 of the entry of a subscribed task, the pthread API uses the first indexes */
+#define TWDT_TLS_INDEX      (CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS - 1)
+#endif
+
 // Structure used to hold run time configuration of the TWDT
 typedef struct twdt_obj twdt_obj_t;
 struct twdt_obj {
     twdt_ctx_t impl_ctx;
     SLIST_HEAD(entry_list_head, twdt_entry) entries_slist;
+    twdt_entry_t *slot_entries[CONFIG_ESP_TASK_WDT_MAX_ENTRIES];  // Entry owning each slot, NULL if free
+    atomic_uint used_bitmap[TWDT_BITMAP_WORDS];     // Slots of the subscribed entries, written with the spinlock held
+    atomic_uint fed_bitmap[TWDT_BITMAP_WORDS];      // Slots of the entries reset since the timer was fed
     uint32_t idle_core_mask;    // Current core's who's idle tasks are subscribed
     bool panic; // Flag to trigger panic when TWDT times out
     bool waiting_for_task; // Flag to start the timer as soon as a task is added
@@ -100,61 +114,128 @@ static void task_wdt_timer_feed(void)
 {
     esp_task_wdt_impl_timer_feed(p_twdt_obj->impl_ctx);
 
-    /* Clear the has_reset flag in each entry */
-    twdt_entry_t *entry;
-    SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
-        entry->has_reset = false;
+    /* Clear the reset flag of each entry */
+    for (int i = 0; i < TWDT_BITMAP_WORDS; i++) {
+        atomic_store(&p_twdt_obj->fed_bitmap[i], 0);
+    }
+}
+
+/**
+ * @brief Checks if all entries have been reset, except the ones of the ignored slot
+ *
+ * @param[in] ignored_slot Slot not checked, or CONFIG_ESP_TASK_WDT_MAX_ENTRIES to check all of them
+ * @return Whether all entries have been reset
+ */
+static bool check_all_reset(uint32_t ignored_slot)
+{
+    for (int i = 0; i < TWDT_BITMAP_WORDS; i++) {
+        uint32_t used = atomic_load(&p_twdt_obj->used_bitmap[i]);
+        if (ignored_slot / 32 == i) {
+            used &= ~BIT(ignored_slot % 32);
+        }
+        if ((atomic_load(&p_twdt_obj->fed_bitmap[i]) & used) != used) {
+            return false;
+        }
     }
+    return true;
+}
+
+static inline bool entry_has_reset(const twdt_entry_t *entry)
+{
+    return atomic_load(&p_twdt_obj->fed_bitmap[entry->slot / 32]) & BIT(entry->slot % 32);
 }
 
 /**
- * @brief Checks whether a user entry exists and if all other entries have been reset
+ * @brief Mark the entry of a slot as reset, and feed the timer if all entries have been reset
+ *
+ * The spinlock must not be held: it is only taken when the timer is fed.
+ * If the entry is being deleted concurrently, its bit may be set after the slot was freed. This is harmless, the bit
+ * of a slot is cleared when a new entry takes it.
+ *
+ * @param[in] slot Slot of the entry
+ */
+static void reset_slot(uint32_t slot)
+{
+    const uint32_t word = slot / 32;
+    const uint32_t fed = atomic_fetch_or(&p_twdt_obj->fed_bitmap[word], BIT(slot % 32)) | BIT(slot % 32);
+    const uint32_t used = atomic_load(&p_twdt_obj->used_bitmap[word]);
+    // Common case: the other entries sharing the word have not all been reset yet
+    if ((fed & used) != used || !check_all_reset(CONFIG_ESP_TASK_WDT_MAX_ENTRIES)) {
+        return;
+    }
+    portENTER_CRITICAL(&spinlock);
+    // Another task may have fed the timer in the meantime
+    if (check_all_reset(CONFIG_ESP_TASK_WDT_MAX_ENTRIES)) {
+        task_wdt_timer_feed();
+    }
+    portEXIT_CRITICAL(&spinlock);
+}
+
+/**
+ * @brief Checks whether a user entry exists
  *
  * @param[in] user_entry User entry
- * @param[out] all_reset Whether all entries have been reset
  * @return Whether the user entry exists
  */
-static bool find_entry_and_check_all_reset(twdt_entry_t *user_entry, bool *all_reset)
+static bool find_entry(twdt_entry_t *user_entry)
 {
-    bool found_user_entry = false;
-    bool found_non_reset = false;
-
     twdt_entry_t *entry;
     SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
         if (entry == user_entry) {
-            found_user_entry = true;
-        } else if (entry->has_reset == false) {
-            found_non_reset = true;
+            return true;
         }
     }
-
-    *all_reset = !found_non_reset;
-    return found_user_entry;
+    return false;
 }
 
 /**
- * @brief Find whether a task entry exists, and checks if all other entries have been reset
+ * @brief Find whether a task entry exists
  *
  * @param[in] handle Task handle
- * @param[out] all_reset Whether all entries have been reset
  * @return Task entry, or NULL if not found
  */
-static twdt_entry_t *find_entry_from_task_handle_and_check_all_reset(TaskHandle_t handle, bool *all_reset)
+static twdt_entry_t *find_entry_from_task_handle(TaskHandle_t handle)
 {
-    twdt_entry_t *target = NULL;
-    bool found_non_reset = false;
-
     twdt_entry_t *entry;
     SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
         if (entry->task_handle == handle) {
-            target = entry;
-        } else if (entry->has_reset == false) {
-            found_non_reset = true;
+            return entry;
         }
     }
+    return NULL;
+}
 
-    *all_reset = !found_non_reset;
-    return target;
+/**
+ * @brief Allocate a free slot for an entry
+ *
+ * @param[in] entry Entry
+ * @return Whether a slot was allocated
+ */
+static bool allocate_slot(twdt_entry_t *entry)
+{
+    for (int i = 0; i < TWDT_BITMAP_WORDS; i++) {
+        uint32_t used = atomic_load(&p_twdt_obj->used_bitmap[i]);
+        if (used == UINT32_MAX) {
+            continue;
+        }
+        uint32_t slot = i * 32 + __builtin_ctz(~used);
+        if (slot >= CONFIG_ESP_TASK_WDT_MAX_ENTRIES) {
+            break;
+        }
+        entry->slot = slot;
+        p_twdt_obj->slot_entries[slot] = entry;
+        // The entry has not been reset yet
+        atomic_fetch_and(&p_twdt_obj->fed_bitmap[i], ~BIT(slot % 32));
+        atomic_store(&p_twdt_obj->used_bitmap[i], used | BIT(slot % 32));
+        return true;
+    }
+    return false;
+}
+
+static void free_slot(twdt_entry_t *entry)
+{
+    atomic_fetch_and(&p_twdt_obj->used_bitmap[entry->slot / 32], ~BIT(entry->slot % 32));
+    p_twdt_obj->slot_entries[entry->slot] = NULL;
 }
 
 /**
@@ -184,16 +265,22 @@ static esp_err_t add_entry(bool is_task, void *entry_data, twdt_entry_t **entry_
     // Check TWDT state
     ESP_GOTO_ON_FALSE_ISR((p_twdt_obj != NULL), ESP_ERR_INVALID_STATE, state_err, TAG, "task watchdog was never initialized");
     // Check if the task is an entry, and if all entries have been reset
-    bool all_reset;
     if (is_task) {
-        twdt_entry_t *entry_found = find_entry_from_task_handle_and_check_all_reset(entry->task_handle, &all_reset);
+        twdt_entry_t *entry_found = find_entry_from_task_handle(entry->task_handle);
         ESP_GOTO_ON_FALSE_ISR((entry_found == NULL), ESP_ERR_INVALID_ARG, state_err, TAG, "task is already subscribed");
     } else {
-        bool entry_found = find_entry_and_check_all_reset(entry, &all_reset);
+        bool entry_found = find_entry(entry);
         ESP_GOTO_ON_FALSE_ISR(!entry_found, ESP_ERR_INVALID_ARG, state_err, TAG, "user is already subscribed");
     }
+    bool all_reset = check_all_reset(CONFIG_ESP_TASK_WDT_MAX_ENTRIES);
+    ESP_GOTO_ON_FALSE_ISR(allocate_slot(entry), ESP_ERR_NO_MEM, state_err, TAG, "too many subscribers");
     // Add entry to list
     SLIST_INSERT_HEAD(&p_twdt_obj->entries_slist, entry, slist_entry);
+#if CONFIG_ESP_TASK_WDT_TLS_LOOKUP
+    if (is_task) {
+        vTaskSetThreadLocalStoragePointer(entry->task_handle, TWDT_TLS_INDEX, (void *)(uintptr_t)(entry->slot + 1));
+    }
+#endif
     // Start the timer if it has not been started yet and was waiting on a task to registered
     if (p_twdt_obj->waiting_for_task) {
         esp_task_wdt_impl_timer_restart(p_twdt_obj->impl_ctx);
@@ -227,18 +314,24 @@ static esp_err_t delete_entry(bool is_task, void *entry_data)
     // Check TWDT state
     ESP_GOTO_ON_FALSE_ISR((p_twdt_obj != NULL), ESP_ERR_INVALID_STATE, err, TAG, "task watchdog was never initialized");
     // Find entry for task
-    bool all_reset;
     twdt_entry_t *entry;
     if (is_task) {
-        entry = find_entry_from_task_handle_and_check_all_reset((TaskHandle_t)entry_data, &all_reset);
+        entry = find_entry_from_task_handle((TaskHandle_t)entry_data);
         ESP_GOTO_ON_FALSE_ISR((entry != NULL), ESP_ERR_NOT_FOUND, err, TAG, "task not found");
     } else {
         entry = (twdt_entry_t *)entry_data;
-        bool entry_found = find_entry_and_check_all_reset(entry, &all_reset);
+        bool entry_found = find_entry(entry);
         ESP_GOTO_ON_FALSE_ISR(entry_found, ESP_ERR_NOT_FOUND, err, TAG, "user not found");
     }
+    bool all_reset = check_all_reset(entry->slot);
     // Remove entry
     SLIST_REMOVE(&p_twdt_obj->entries_slist, entry, twdt_entry, slist_entry);
+    free_slot(entry);
+#if CONFIG_ESP_TASK_WDT_TLS_LOOKUP
+    if (is_task) {
+        vTaskSetThreadLocalStoragePointer(entry->task_handle, TWDT_TLS_INDEX, NULL);
+    }
+#endif
     /* Stop the timer if we don't have any more tasks/objects to watch */
     if (SLIST_EMPTY(&p_twdt_obj->entries_slist)) {
         p_twdt_obj->waiting_for_task = true;
@@ -690,49 +783,46 @@ esp_err_t esp_task_wdt_add_user(const char *user_name, esp_task_wdt_user_handle_
 esp_err_t esp_task_wdt_reset(void)
 {
     ESP_RETURN_ON_FALSE(p_twdt_obj != NULL, ESP_ERR_INVALID_STATE, TAG, "TWDT was never initialized");
+#if CONFIG_ESP_TASK_WDT_TLS_LOOKUP
+    // The slot is only set and cleared while the task is subscribed, no need to search the list
+    uint32_t slot = (uint32_t)(uintptr_t)pvTaskGetThreadLocalStoragePointer(NULL, TWDT_TLS_INDEX);
+    ESP_RETURN_ON_FALSE(slot != 0, ESP_ERR_NOT_FOUND, TAG, "task not found");
+    reset_slot(slot - 1);
+    return ESP_OK;
+#else
     esp_err_t ret;
+    uint32_t slot = 0;
     TaskHandle_t handle = xTaskGetCurrentTaskHandle();
 
     portENTER_CRITICAL(&spinlock);
     // Find entry from task handle
-    bool all_reset;
-    twdt_entry_t *entry;
-    entry = find_entry_from_task_handle_and_check_all_reset(handle, &all_reset);
+    twdt_entry_t *entry = find_entry_from_task_handle(handle);
     ESP_GOTO_ON_FALSE_ISR((entry != NULL), ESP_ERR_NOT_FOUND, err, TAG, "task not found");
-    // Mark entry as reset and issue timer reset if all entries have been reset
-    entry->has_reset = true;    // Reset the task if it's on the task list
-    if (all_reset) {    // Reset if all other tasks in list have reset in
-        task_wdt_timer_feed();
-    }
+    slot = entry->slot;
     ret = ESP_OK;
 err:
     portEXIT_CRITICAL(&spinlock);
 
+    if (ret == ESP_OK) {
+        // Mark entry as reset and issue timer reset if all entries have been reset
+        reset_slot(slot);
+    }
     return ret;
+#endif
 }
 
 esp_err_t esp_task_wdt_reset_user(esp_task_wdt_user_handle_t user_handle)
 {
     ESP_RETURN_ON_FALSE(user_handle != NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
     ESP_RETURN_ON_FALSE(p_twdt_obj != NULL, ESP_ERR_INVALID_STATE, TAG, "TWDT was never initialized");
-    esp_err_t ret;
-
-    portENTER_CRITICAL(&spinlock);
-    // Check if entry exists
-    bool all_reset;
     twdt_entry_t *entry = (twdt_entry_t *)user_handle;
-    bool entry_found = find_entry_and_check_all_reset(entry, &all_reset);
-    ESP_GOTO_ON_FALSE_ISR(entry_found, ESP_ERR_NOT_FOUND, err, TAG, "user handle not found");
+    // Check if entry exists: a subscribed user owns the slot stored in its entry
+    const uint32_t slot = entry->slot;
+    ESP_RETURN_ON_FALSE(slot < CONFIG_ESP_TASK_WDT_MAX_ENTRIES && p_twdt_obj->slot_entries[slot] == entry,
+                        ESP_ERR_NOT_FOUND, TAG, "user handle not found");
     // Mark entry as reset and issue timer reset if all entries have been reset
-    entry->has_reset = true;    // Reset the task if it's on the task list
-    if (all_reset) {    // Reset if all other tasks in list have reset in
-        task_wdt_timer_feed();
-    }
-    ret = ESP_OK;
-err:
-    portEXIT_CRITICAL(&spinlock);
-
-    return ret;
+    reset_slot(slot);
+    return ESP_OK;
 }
 
 esp_err_t esp_task_wdt_delete(TaskHandle_t task_handle)
@@ -764,10 +854,8 @@ esp_err_t esp_task_wdt_status(TaskHandle_t task_handle)
 
     portENTER_CRITICAL(&spinlock);
     // Find entry for task
-    bool all_reset;
     twdt_entry_t *entry;
-    entry = find_entry_from_task_handle_and_check_all_reset(task_handle, &all_reset);
-    (void) all_reset;   // Unused
+    entry = find_entry_from_task_handle(task_handle);
     ret = (entry != NULL) ? ESP_OK : ESP_ERR_NOT_FOUND;
     portEXIT_CRITICAL(&spinlock);
 
@@ -792,7 +880,7 @@ esp_err_t esp_task_wdt_print_triggered_tasks(task_wdt_msg_handler msg_handler, v
 
     // Find what entries triggered the TWDT timeout (i.e., which entries have not been reset)
     SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
-        if (!entry->has_reset) {
+        if (!entry_has_reset(entry)) {
             const char *cpu;
             const char *name = entry->task_handle ? pcTaskGetName(entry->task_handle) : entry->user_name;
             const UBaseType_t affinity = get_task_affinity(entry->task_handle);
@@ -1,10 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -16,6 +17,7 @@
 #endif
 #include "esp_log.h"
 #include "esp_rom_sys.h"
+#include "esp_attr.h"
 
 #if !CONFIG_FREERTOS_UNICORE
 static void test_func_ipc_cb(void *arg)
@@ -209,4 +211,99 @@ TEST_CASE("Test ipc call nonblocking when FreeRTOS Scheduler is suspended", "[ip
     xTaskResumeAll();
 #endif
 }
+
+typedef struct {
+    int calls;
+    int order[4];
+    int cpu[4];
+} test_ipc_batch_t;
+
+static test_ipc_batch_t s_batch;
+
+static void test_func_ipc_batch(void *arg)
+{
+    int index = (int)arg;
+    s_batch.order[index] = s_batch.calls++;
+    s_batch.cpu[index] = xPortGetCoreID();
+}
+
+TEST_CASE("Test ipc call batch", "[ipc]")
+{
+    esp_ipc_batch_entry_t entries[4];
+    for (int i = 0; i < 4; i++) {
+        entries[i].func = test_func_ipc_batch;
+        // executed in the reverse order of the indexes
+        entries[i].arg = (void *)(3 - i);
+    }
+    memset(&s_batch, 0, sizeof(s_batch));
+
+    TEST_ESP_OK(esp_ipc_call_batch(!xPortGetCoreID(), entries, 4));
+    // blocking: all the callbacks have completed
+    TEST_ASSERT_EQUAL(4, s_batch.calls);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(3 - i, s_batch.order[i]);
+        TEST_ASSERT_EQUAL(!xPortGetCoreID(), s_batch.cpu[i]);
+    }
+
+    TEST_ESP_OK(esp_ipc_call_batch(!xPortGetCoreID(), NULL, 0));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_ipc_call_batch(!xPortGetCoreID(), NULL, 1));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_ipc_call_batch(CONFIG_FREERTOS_NUMBER_OF_CORES, entries, 4));
+}
+
+#if CONFIG_ESP_IPC_FAST_CALL_ENABLE
+#define TEST_FAST_CALLS 1000
+
+static volatile DRAM_ATTR int s_fast_calls;
+static volatile DRAM_ATTR int s_fast_call_errors;
+
+static void IRAM_ATTR test_func_ipc_fast(void *arg)
+{
+    // the calls queued by a CPU are executed in order, by the target CPU
+    if ((int)arg != s_fast_calls || xPortGetCoreID() == 0) {
+        s_fast_call_errors++;
+    }
+    s_fast_calls++;
+}
+
+TEST_CASE("Test ipc call fast", "[ipc]")
+{
+    s_fast_calls = 0;
+    s_fast_call_errors = 0;
+
+    for (int i = 0; i < TEST_FAST_CALLS; i++) {
+        esp_err_t err;
+        while ((err = esp_ipc_call_fast(1, test_func_ipc_fast, (void *)i)) == ESP_FAIL) {
+            // the queue is full, wait for the other CPU to drain it
+        }
+        TEST_ESP_OK(err);
+    }
+    while (s_fast_calls < TEST_FAST_CALLS) { };
+    TEST_ASSERT_EQUAL(TEST_FAST_CALLS, s_fast_calls);
+    TEST_ASSERT_EQUAL(0, s_fast_call_errors);
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_ipc_call_fast(CONFIG_FREERTOS_NUMBER_OF_CORES, test_func_ipc_fast, NULL));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_ipc_call_fast(1, NULL, NULL));
+}
+
+TEST_CASE("Test ipc call fast when FreeRTOS Scheduler is suspended", "[ipc]")
+{
+    s_fast_calls = 0;
+    s_fast_call_errors = 0;
+#ifdef CONFIG_FREERTOS_SMP
+    vTaskPreemptionDisable(NULL);
+#else
+    vTaskSuspendAll();
+#endif // CONFIG_FREERTOS_SMP
+
+    TEST_ESP_OK(esp_ipc_call_fast(1, test_func_ipc_fast, (void *)0));
+    while (s_fast_calls == 0) { };
+
+#ifdef CONFIG_FREERTOS_SMP
+    vTaskPreemptionEnable(NULL);
+#else
+    xTaskResumeAll();
+#endif
+    TEST_ASSERT_EQUAL(0, s_fast_call_errors);
+}
+#endif // CONFIG_ESP_IPC_FAST_CALL_ENABLE
 #endif /* !CONFIG_FREERTOS_UNICORE */
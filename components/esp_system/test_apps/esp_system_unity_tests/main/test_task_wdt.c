@@ -235,4 +235,39 @@ TEST_CASE("Task WDT user feed", "[task_wdt]")
     TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_deinit());
 }
 
+TEST_CASE("Task WDT feed by many users", "[task_wdt]")
+{
+    esp_task_wdt_user_handle_t user_handles[CONFIG_ESP_TASK_WDT_MAX_ENTRIES];
+    esp_task_wdt_user_handle_t extra_handle;
+    timeout_flag = false;
+    esp_task_wdt_config_t twdt_config = {
+        .timeout_ms = TASK_WDT_TIMEOUT_MS,
+        .idle_core_mask = 0,
+        .trigger_panic = false,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_init(&twdt_config));
+    for (int i = 0; i < CONFIG_ESP_TASK_WDT_MAX_ENTRIES; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add_user("test_user", &user_handles[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, esp_task_wdt_add_user("extra_user", &extra_handle));
+    // The watchdog is only fed once every user has reset it
+    for (int round = 0; round < 4; round++) {
+        esp_rom_delay_us((TASK_WDT_TIMEOUT_MS * 1000) / 4);
+        for (int i = 0; i < CONFIG_ESP_TASK_WDT_MAX_ENTRIES; i++) {
+            TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset_user(user_handles[i]));
+        }
+    }
+    TEST_ASSERT_EQUAL(false, timeout_flag);
+    // One user not resetting it is enough to time out
+    for (int i = 0; i < CONFIG_ESP_TASK_WDT_MAX_ENTRIES - 1; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset_user(user_handles[i]));
+    }
+    esp_rom_delay_us(TASK_WDT_TIMEOUT_MS * 1000);
+    TEST_ASSERT_EQUAL(true, timeout_flag);
+    for (int i = 0; i < CONFIG_ESP_TASK_WDT_MAX_ENTRIES; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete_user(user_handles[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_deinit());
+}
+
 #endif // CONFIG_ESP_TASK_WDT_EN
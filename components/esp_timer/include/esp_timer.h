@@ -76,6 +76,9 @@ typedef struct {
     //                                !< `CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD`
     const char* name;               //!< Timer name, used in esp_timer_dump() function
     bool skip_unhandled_events;     //!< Setting to skip unhandled events in light sleep for periodic timers
+    uint32_t slack_us;              //!< How late, in microseconds, the callback may be dispatched after the timeout.
+    //                                !< Timers whose dispatch windows overlap are dispatched together, which
+    //                                !< saves CPU wakeups. 0 (default) dispatches the callback as soon as possible.
 } esp_timer_create_args_t;
 
 /**
@@ -224,6 +227,10 @@ int64_t esp_timer_get_time(void);
 
 /**
  * @brief Get the timestamp of the next expected timeout
+ *
+ * For timers created with a non-zero ::esp_timer_create_args_t::slack_us, this is the
+ * latest time at which the callback may be dispatched, i.e. the timeout plus the slack.
+ *
  * @return Timestamp of the nearest timer event, in microseconds.
  *         The timebase is the same as for the values returned by esp_timer_get_time().
  */
@@ -292,6 +299,10 @@ esp_err_t esp_timer_get_expiry_time(esp_timer_handle_t timer, uint64_t *expiry);
  * - Times_skipped - number of times the callback was skipped
  * - Callback_exec_time - total time taken by callback to execute, across all calls
  *
+ * The list is followed by the number of timer callbacks which were dispatched together with
+ * an earlier timer thanks to their ::esp_timer_create_args_t::slack_us, i.e. the number of
+ * timer wakeups saved by coalescing.
+ *
  * @param stream stream (such as stdout) to which to dump the information
  * @return
  *      - ESP_OK on success
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+/**
+ * @file esp_timer_ticks.h
+ * @brief Inline reads of the esp_timer counter
+ *
+ * The functions of this header read the counter behind esp_timer_get_time() directly, without a function call,
+ * lock or conversion function pointer. They are meant for hot paths taking many timestamps, such as logging,
+ * tracing or packet timestamping: take the timestamps with esp_timer_get_ticks() and convert them to
+ * microseconds later, with esp_timer_ticks_to_us().
+ *
+ * The ticks follow esp_timer_get_time(): they are monotonic, are not affected by settimeofday() or SNTP, and
+ * are adjusted together with esp_timer time after light sleep. Timestamps of different cores can be compared.
+ */
+
+#include <stdint.h>
+#include <time.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#if CONFIG_ESP_TIMER_IMPL_SYSTIMER
+#include "hal/systimer_ll.h"
+#include "esp_private/systimer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_ESP_TIMER_IMPL_SYSTIMER || __DOXYGEN__
+/**
+ * @brief Number of ticks of esp_timer_get_ticks() per microsecond
+ */
+#define ESP_TIMER_TICKS_PER_US  SYSTIMER_LL_TICKS_PER_US
+#else
+#define ESP_TIMER_TICKS_PER_US  1
+#endif
+
+/**
+ * @brief Get the raw value of the esp_timer counter
+ *
+ * This function is inlined and reads the counter registers directly. It can be called from any context,
+ * including interrupt handlers and code running with the cache disabled.
+ *
+ * @note On targets without a system timer, the ticks are microseconds and this function calls
+ *       esp_timer_get_time().
+ *
+ * @return Counter value, ESP_TIMER_TICKS_PER_US ticks per microsecond, counted from the same origin as
+ *         esp_timer_get_time()
+ */
+FORCE_INLINE_ATTR uint64_t esp_timer_get_ticks(void)
+{
+#if CONFIG_ESP_TIMER_IMPL_SYSTIMER
+    uint32_t lo, lo_start, hi;
+    systimer_ll_counter_snapshot(&SYSTIMER, SYSTIMER_COUNTER_ESPTIMER);
+    while (!systimer_ll_is_counter_value_valid(&SYSTIMER, SYSTIMER_COUNTER_ESPTIMER));
+    /* An interrupt taking a snapshot between the reads would make HI and LO inconsistent, read LO again to detect it */
+    lo_start = systimer_ll_get_counter_value_low(&SYSTIMER, SYSTIMER_COUNTER_ESPTIMER);
+    do {
+        lo = lo_start;
+        hi = systimer_ll_get_counter_value_high(&SYSTIMER, SYSTIMER_COUNTER_ESPTIMER);
+        lo_start = systimer_ll_get_counter_value_low(&SYSTIMER, SYSTIMER_COUNTER_ESPTIMER);
+    } while (lo_start != lo);
+    return ((uint64_t)hi << 32) | lo;
+#else
+    return (uint64_t)esp_timer_get_time();
+#endif
+}
+
+/**
+ * @brief Convert a value of esp_timer_get_ticks() to microseconds
+ *
+ * @param ticks Value returned by esp_timer_get_ticks(), or difference of two values
+ * @return Time in microseconds
+ */
+FORCE_INLINE_ATTR int64_t esp_timer_ticks_to_us(uint64_t ticks)
+{
+    return (int64_t)(ticks / ESP_TIMER_TICKS_PER_US);
+}
+
+/**
+ * @brief Convert a value of esp_timer_get_ticks() to nanoseconds
+ *
+ * @param ticks Value returned by esp_timer_get_ticks(), or difference of two values
+ * @return Time in nanoseconds
+ */
+FORCE_INLINE_ATTR int64_t esp_timer_ticks_to_ns(uint64_t ticks)
+{
+    return (int64_t)(ticks * 1000 / ESP_TIMER_TICKS_PER_US);
+}
+
+/**
+ * @brief Get time in microseconds since boot, inlined
+ *
+ * Same value as esp_timer_get_time(), read without function calls.
+ *
+ * @return Number of microseconds since the initialization of esp_timer
+ */
+FORCE_INLINE_ATTR int64_t esp_timer_get_time_inline(void)
+{
+    return esp_timer_ticks_to_us(esp_timer_get_ticks());
+}
+
+/**
+ * @brief Get the monotonic time with the full resolution of the counter
+ *
+ * Equivalent of clock_gettime(CLOCK_MONOTONIC_RAW): the time is read from the esp_timer counter and is never
+ * adjusted by settimeofday(), adjtime() or SNTP. Unlike clock_gettime(CLOCK_MONOTONIC), which has a resolution of
+ * one microsecond, the nanoseconds keep the resolution of the counter. The function doesn't take any lock and is
+ * placed in IRAM when CONFIG_ESP_TIMER_IN_IRAM is enabled.
+ *
+ * @param[out] ts Time since the initialization of esp_timer
+ */
+void esp_timer_get_monotonic_raw(struct timespec *ts);
+
+#ifdef __cplusplus
+}
+#endif
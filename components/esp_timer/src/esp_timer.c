@@ -6,6 +6,7 @@
 
 #include <sys/param.h>
 #include <string.h>
+#include <inttypes.h>
 #include "soc/soc.h"
 #include "esp_types.h"
 #include "esp_attr.h"
@@ -49,6 +50,7 @@ struct esp_timer {
         uint32_t event_id;
     };
     void* arg;
+    uint32_t slack;     // the callback may be dispatched up to this many microseconds after the alarm
 #if WITH_PROFILING
     const char* name;
     size_t times_triggered;
@@ -56,7 +58,13 @@ struct esp_timer {
     size_t times_skipped;
     uint64_t total_callback_run_time;
 #endif // WITH_PROFILING
+#if CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+    uint32_t heap_index;    // position in s_timers[].nodes while armed
+    uint32_t heap_seq;      // insertion order, keeps timers with the same alarm in FIFO order
+#endif
+#if !CONFIG_ESP_TIMER_QUEUE_MIN_HEAP || WITH_PROFILING
     LIST_ENTRY(esp_timer) list_entry;
+#endif
 };
 
 static inline bool is_initialized(void);
@@ -65,6 +73,8 @@ static esp_err_t timer_remove(esp_timer_handle_t timer);
 static bool timer_armed(esp_timer_handle_t timer);
 static void timer_list_lock(esp_timer_dispatch_t timer_type);
 static void timer_list_unlock(esp_timer_dispatch_t timer_type);
+static esp_err_t timer_queue_reserve(esp_timer_dispatch_t dispatch_method);
+static void timer_queue_release(esp_timer_dispatch_t dispatch_method);
 
 #if WITH_PROFILING
 static void timer_insert_inactive(esp_timer_handle_t timer);
@@ -73,10 +83,31 @@ static void timer_remove_inactive(esp_timer_handle_t timer);
 
 __attribute__((unused)) static const char* TAG = "esp_timer";
 
+#if CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+typedef struct {
+    esp_timer_handle_t* nodes;  // binary min-heap of armed timers, nodes[0] expires first
+    size_t count;               // number of armed timers
+    size_t capacity;            // number of entries allocated in nodes
+    size_t reserved;            // number of entries reserved by created timers, never above capacity
+    uint32_t seq;               // next insertion sequence number
+} esp_timer_heap_t;
+
+// heaps of currently armed timers for two dispatch methods: ISR and TASK
+static esp_timer_heap_t s_timers[ESP_TIMER_MAX];
+
+#define TIMER_HEAP_INITIAL_CAPACITY 8
+
+#define TIMER_QUEUE_FOREACH(it, dispatch_method) \
+    for (size_t it##_index = 0; it##_index < s_timers[dispatch_method].count && \
+            ((it) = s_timers[dispatch_method].nodes[it##_index], true); ++it##_index)
+#else
 // lists of currently armed timers for two dispatch methods: ISR and TASK
 static LIST_HEAD(esp_timer_list, esp_timer) s_timers[ESP_TIMER_MAX] = {
     [0 ...(ESP_TIMER_MAX - 1)] = LIST_HEAD_INITIALIZER(s_timers)
 };
+
+#define TIMER_QUEUE_FOREACH(it, dispatch_method) LIST_FOREACH(it, &s_timers[dispatch_method], list_entry)
+#endif // CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
 #if WITH_PROFILING
 // lists of unarmed timers for two dispatch methods: ISR and TASK,
 // used only to be able to dump statistics about all the timers
@@ -92,11 +123,201 @@ static portMUX_TYPE s_timer_lock[ESP_TIMER_MAX] = {
     [0 ...(ESP_TIMER_MAX - 1)] = portMUX_INITIALIZER_UNLOCKED
 };
 
+// number of callbacks dispatched before their deadline together with an earlier timer, protected by s_timer_lock
+static uint32_t s_coalesced_count[ESP_TIMER_MAX];
+
 #ifdef CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
 // For ISR dispatch method, a callback function of the timer may require a context switch
 static volatile BaseType_t s_isr_dispatch_need_yield = pdFALSE;
 #endif // CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
 
+/* Armed timers are ordered by their deadline, the latest time at which the callback may be
+ * dispatched, and the hardware alarm is set to the earliest deadline. When it fires, every timer
+ * whose alarm has passed is dispatched, so timers with overlapping windows share one wakeup. */
+FORCE_INLINE_ATTR uint64_t timer_deadline(esp_timer_handle_t timer)
+{
+    return timer->alarm + timer->slack;
+}
+
+#if CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+
+FORCE_INLINE_ATTR bool timer_heap_before(esp_timer_handle_t a, esp_timer_handle_t b)
+{
+    uint64_t a_deadline = timer_deadline(a);
+    uint64_t b_deadline = timer_deadline(b);
+    return a_deadline < b_deadline || (a_deadline == b_deadline && (int32_t)(a->heap_seq - b->heap_seq) < 0);
+}
+
+FORCE_INLINE_ATTR void timer_heap_set(esp_timer_handle_t* nodes, size_t index, esp_timer_handle_t timer, bool track_index)
+{
+    nodes[index] = timer;
+    if (track_index) {
+        timer->heap_index = index;
+    }
+}
+
+static ESP_TIMER_IRAM_ATTR void timer_heap_sift_up(esp_timer_handle_t* nodes, size_t index)
+{
+    esp_timer_handle_t timer = nodes[index];
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!timer_heap_before(timer, nodes[parent])) {
+            break;
+        }
+        timer_heap_set(nodes, index, nodes[parent], true);
+        index = parent;
+    }
+    timer_heap_set(nodes, index, timer, true);
+}
+
+/* track_index is false when working on a copy of the heap, which must not touch the timers */
+static ESP_TIMER_IRAM_ATTR void timer_heap_sift_down(esp_timer_handle_t* nodes, size_t count, size_t index, bool track_index)
+{
+    esp_timer_handle_t timer = nodes[index];
+    while (true) {
+        size_t child = 2 * index + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && timer_heap_before(nodes[child + 1], nodes[child])) {
+            child++;
+        }
+        if (!timer_heap_before(nodes[child], timer)) {
+            break;
+        }
+        timer_heap_set(nodes, index, nodes[child], track_index);
+        index = child;
+    }
+    timer_heap_set(nodes, index, timer, track_index);
+}
+
+static ESP_TIMER_IRAM_ATTR esp_timer_handle_t timer_queue_first(esp_timer_dispatch_t dispatch_method)
+{
+    esp_timer_heap_t* heap = &s_timers[dispatch_method];
+    return (heap->count > 0) ? heap->nodes[0] : NULL;
+}
+
+static ESP_TIMER_IRAM_ATTR void timer_queue_add(esp_timer_handle_t timer)
+{
+    esp_timer_heap_t* heap = &s_timers[timer->flags & FL_ISR_DISPATCH_METHOD];
+    // the place was reserved when the timer was created
+    assert(heap->count < heap->capacity);
+    timer->heap_seq = heap->seq++;
+    heap->nodes[heap->count] = timer;
+    timer_heap_sift_up(heap->nodes, heap->count++);
+}
+
+static ESP_TIMER_IRAM_ATTR void timer_queue_del(esp_timer_handle_t timer)
+{
+    esp_timer_heap_t* heap = &s_timers[timer->flags & FL_ISR_DISPATCH_METHOD];
+    size_t index = timer->heap_index;
+    assert(index < heap->count && heap->nodes[index] == timer);
+    esp_timer_handle_t last = heap->nodes[--heap->count];
+    if (index < heap->count) {
+        heap->nodes[index] = last;
+        if (index > 0 && timer_heap_before(last, heap->nodes[(index - 1) / 2])) {
+            timer_heap_sift_up(heap->nodes, index);
+        } else {
+            timer_heap_sift_down(heap->nodes, heap->count, index, true);
+        }
+    }
+}
+
+/* Makes sure the heap can hold one more timer. Arming a timer happens in a critical section,
+ * possibly from an ISR, where the heap can not be reallocated. */
+static esp_err_t timer_queue_reserve(esp_timer_dispatch_t dispatch_method)
+{
+    esp_timer_heap_t* heap = &s_timers[dispatch_method];
+    esp_timer_handle_t* new_nodes = NULL;
+    size_t new_capacity = 0;
+
+    while (true) {
+        esp_timer_handle_t* unused = new_nodes;
+        bool reserved = false;
+
+        timer_list_lock(dispatch_method);
+        if (heap->reserved < heap->capacity) {
+            reserved = true;
+        } else if (new_capacity > heap->capacity) {
+            if (heap->count > 0) {
+                memcpy(new_nodes, heap->nodes, heap->count * sizeof(esp_timer_handle_t));
+            }
+            unused = heap->nodes;
+            heap->nodes = new_nodes;
+            heap->capacity = new_capacity;
+            reserved = true;
+        }
+        if (reserved) {
+            heap->reserved++;
+        }
+        new_capacity = (heap->capacity > 0) ? heap->capacity * 2 : TIMER_HEAP_INITIAL_CAPACITY;
+        timer_list_unlock(dispatch_method);
+
+        free(unused);
+        if (reserved) {
+            return ESP_OK;
+        }
+        new_nodes = heap_caps_malloc(new_capacity * sizeof(esp_timer_handle_t), MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+        if (new_nodes == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+}
+
+static ESP_TIMER_IRAM_ATTR void timer_queue_release(esp_timer_dispatch_t dispatch_method)
+{
+    timer_list_lock(dispatch_method);
+    assert(s_timers[dispatch_method].reserved > 0);
+    s_timers[dispatch_method].reserved--;
+    timer_list_unlock(dispatch_method);
+}
+
+#else // CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+
+static ESP_TIMER_IRAM_ATTR esp_timer_handle_t timer_queue_first(esp_timer_dispatch_t dispatch_method)
+{
+    return LIST_FIRST(&s_timers[dispatch_method]);
+}
+
+static ESP_TIMER_IRAM_ATTR void timer_queue_add(esp_timer_handle_t timer)
+{
+    esp_timer_handle_t it, last = NULL;
+    esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
+    if (LIST_FIRST(&s_timers[dispatch_method]) == NULL) {
+        LIST_INSERT_HEAD(&s_timers[dispatch_method], timer, list_entry);
+    } else {
+        LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
+            if (timer_deadline(timer) < timer_deadline(it)) {
+                LIST_INSERT_BEFORE(it, timer, list_entry);
+                break;
+            }
+            last = it;
+        }
+        if (it == NULL) {
+            assert(last);
+            LIST_INSERT_AFTER(last, timer, list_entry);
+        }
+    }
+}
+
+static ESP_TIMER_IRAM_ATTR void timer_queue_del(esp_timer_handle_t timer)
+{
+    LIST_REMOVE(timer, list_entry);
+}
+
+static esp_err_t timer_queue_reserve(esp_timer_dispatch_t dispatch_method)
+{
+    (void) dispatch_method;
+    return ESP_OK;
+}
+
+static ESP_TIMER_IRAM_ATTR void timer_queue_release(esp_timer_dispatch_t dispatch_method)
+{
+    (void) dispatch_method;
+}
+
+#endif // CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+
 esp_err_t esp_timer_create(const esp_timer_create_args_t* args,
                            esp_timer_handle_t* out_handle)
 {
@@ -113,8 +334,22 @@ esp_err_t esp_timer_create(const esp_timer_create_args_t* args,
     }
     result->callback = args->callback;
     result->arg = args->arg;
+    result->slack = args->slack_us;
     result->flags = (args->dispatch_method ? FL_ISR_DISPATCH_METHOD : 0) |
                     (args->skip_unhandled_events ? FL_SKIP_UNHANDLED_EVENTS : 0);
+    /* Every timer ends up on the TASK queue when it is deleted, so it needs a place there
+     * in any case, and one on the ISR queue if it is dispatched from the ISR. */
+    esp_err_t err = timer_queue_reserve(ESP_TIMER_TASK);
+    if (err == ESP_OK && args->dispatch_method == ESP_TIMER_ISR) {
+        err = timer_queue_reserve(ESP_TIMER_ISR);
+        if (err != ESP_OK) {
+            timer_queue_release(ESP_TIMER_TASK);
+        }
+    }
+    if (err != ESP_OK) {
+        free(result);
+        return err;
+    }
 #if WITH_PROFILING
     result->name = args->name;
     esp_timer_dispatch_t dispatch_method = result->flags & FL_ISR_DISPATCH_METHOD;
@@ -271,6 +506,7 @@ esp_err_t esp_timer_delete(esp_timer_handle_t timer)
 
     int64_t alarm = esp_timer_get_time();
     esp_err_t err;
+    bool was_isr_timer = timer->flags & FL_ISR_DISPATCH_METHOD;
     timer_list_lock(ESP_TIMER_TASK);
 
     /* Check if the timer is armed once the list is locked to avoid a data race */
@@ -278,16 +514,21 @@ esp_err_t esp_timer_delete(esp_timer_handle_t timer)
         err = ESP_ERR_INVALID_STATE;
     } else {
         // A case for the timer with ESP_TIMER_ISR:
-        // This ISR timer was removed from the ISR list in esp_timer_stop() or in timer_process_alarm() -> LIST_REMOVE(it, list_entry)
+        // This ISR timer was removed from the ISR list in esp_timer_stop() or in timer_process_alarm() -> timer_queue_del(it)
         // and here this timer will be added to another the TASK list, see below.
         // We do this because we want to free memory of the timer in a task context instead of an isr context.
         timer->flags &= ~FL_ISR_DISPATCH_METHOD;
         timer->event_id = EVENT_ID_DELETE_TIMER;
         timer->alarm = alarm;
         timer->period = 0;
+        timer->slack = 0;
         err = timer_insert(timer, false);
     }
     timer_list_unlock(ESP_TIMER_TASK);
+    if (err == ESP_OK && was_isr_timer) {
+        // The place on the TASK queue reserved in esp_timer_create() is released once the timer is freed
+        timer_queue_release(ESP_TIMER_ISR);
+    }
     return err;
 }
 
@@ -296,25 +537,10 @@ static ESP_TIMER_IRAM_ATTR esp_err_t timer_insert(esp_timer_handle_t timer, bool
 #if WITH_PROFILING
     timer_remove_inactive(timer);
 #endif
-    esp_timer_handle_t it, last = NULL;
     esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
-    if (LIST_FIRST(&s_timers[dispatch_method]) == NULL) {
-        LIST_INSERT_HEAD(&s_timers[dispatch_method], timer, list_entry);
-    } else {
-        LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
-            if (timer->alarm < it->alarm) {
-                LIST_INSERT_BEFORE(it, timer, list_entry);
-                break;
-            }
-            last = it;
-        }
-        if (it == NULL) {
-            assert(last);
-            LIST_INSERT_AFTER(last, timer, list_entry);
-        }
-    }
-    if (without_update_alarm == false && timer == LIST_FIRST(&s_timers[dispatch_method])) {
-        esp_timer_impl_set_alarm_id(timer->alarm, dispatch_method);
+    timer_queue_add(timer);
+    if (without_update_alarm == false && timer == timer_queue_first(dispatch_method)) {
+        esp_timer_impl_set_alarm_id(timer_deadline(timer), dispatch_method);
     }
     return ESP_OK;
 }
@@ -323,15 +549,15 @@ static ESP_TIMER_IRAM_ATTR esp_err_t timer_remove(esp_timer_handle_t timer)
 {
     esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
     timer_list_lock(dispatch_method);
-    esp_timer_handle_t first_timer = LIST_FIRST(&s_timers[dispatch_method]);
-    LIST_REMOVE(timer, list_entry);
+    esp_timer_handle_t first_timer = timer_queue_first(dispatch_method);
+    timer_queue_del(timer);
     timer->alarm = 0;
     timer->period = 0;
     if (timer == first_timer) { // if this timer was the first in the list.
         uint64_t next_timestamp = UINT64_MAX;
-        first_timer = LIST_FIRST(&s_timers[dispatch_method]);
+        first_timer = timer_queue_first(dispatch_method);
         if (first_timer) { // if after removing the timer from the list, this list is not empty.
-            next_timestamp = first_timer->alarm;
+            next_timestamp = timer_deadline(first_timer);
         }
         esp_timer_impl_set_alarm_id(next_timestamp, dispatch_method);
     }
@@ -393,7 +619,7 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
     bool processed = false;
     esp_timer_handle_t it;
     while (1) {
-        it = LIST_FIRST(&s_timers[dispatch_method]);
+        it = timer_queue_first(dispatch_method);
         int64_t now = esp_timer_impl_get_time();
         ESP_COMPILER_DIAGNOSTIC_PUSH_IGNORE("-Wanalyzer-use-after-free") // False-positive detection. TODO GCC-366
         if (it == NULL || it->alarm > now) {
@@ -401,11 +627,16 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
         }
         ESP_COMPILER_DIAGNOSTIC_POP("-Wanalyzer-use-after-free")
         processed = true;
-        LIST_REMOVE(it, list_entry);
+        if (timer_deadline(it) > now) {
+            // dispatched ahead of its deadline, in the same wakeup as an earlier timer
+            s_coalesced_count[dispatch_method]++;
+        }
+        timer_queue_del(it);
         if (it->event_id == EVENT_ID_DELETE_TIMER) {
             // It is handled only by ESP_TIMER_TASK (see esp_timer_delete()).
             // All the ESP_TIMER_ISR timers which should be deleted are moved by esp_timer_delete() to the ESP_TIMER_TASK list.
             // We want to free memory of the timer in a task context instead of an isr context.
+            timer_queue_release(ESP_TIMER_TASK);
             free(it);
             it = NULL;
         } else {
@@ -442,7 +673,7 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
     } // while(1)
     if (it) {
         if (dispatch_method == ESP_TIMER_TASK || (dispatch_method != ESP_TIMER_TASK && processed == true)) {
-            esp_timer_impl_set_alarm_id(it->alarm, dispatch_method);
+            esp_timer_impl_set_alarm_id(timer_deadline(it), dispatch_method);
         }
     } else {
         if (processed) {
@@ -575,7 +806,7 @@ esp_err_t esp_timer_deinit(void)
 
     /* Check if there are any active timers */
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
-        if (!LIST_EMPTY(&s_timers[dispatch_method])) {
+        if (timer_queue_first(dispatch_method) != NULL) {
             return ESP_ERR_INVALID_STATE;
         }
     }
@@ -633,7 +864,7 @@ esp_err_t esp_timer_dump(FILE* stream)
     size_t timer_count = 0;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
-        LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
+        TIMER_QUEUE_FOREACH(it, dispatch_method) {
             ++timer_count;
         }
 #if WITH_PROFILING
@@ -654,14 +885,39 @@ esp_err_t esp_timer_dump(FILE* stream)
     if (print_buf == NULL) {
         return ESP_ERR_NO_MEM;
     }
+#if CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+    /* Armed timers are printed in the order they expire, which takes a copy of the heap */
+    size_t sorted_size = timer_count + 3;
+    esp_timer_handle_t* sorted = calloc(sorted_size, sizeof(esp_timer_handle_t));
+    if (sorted == NULL) {
+        free(print_buf);
+        return ESP_ERR_NO_MEM;
+    }
+#endif
 
     /* Print to the buffer */
     char* pos = print_buf;
+    uint32_t coalesced_count = 0;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
+        coalesced_count += s_coalesced_count[dispatch_method];
+#if CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+        size_t sorted_count = MIN(s_timers[dispatch_method].count, sorted_size);
+        if (sorted_count > 0) {
+            memcpy(sorted, s_timers[dispatch_method].nodes, sorted_count * sizeof(esp_timer_handle_t));
+        }
+        while (sorted_count > 0) {
+            print_timer_info(sorted[0], &pos, &buf_size);
+            sorted[0] = sorted[--sorted_count];
+            if (sorted_count > 0) {
+                timer_heap_sift_down(sorted, sorted_count, 0, false);
+            }
+        }
+#else
         LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
             print_timer_info(it, &pos, &buf_size);
         }
+#endif
 #if WITH_PROFILING
         LIST_FOREACH(it, &s_inactive_timers[dispatch_method], list_entry) {
             print_timer_info(it, &pos, &buf_size);
@@ -681,8 +937,12 @@ esp_err_t esp_timer_dump(FILE* stream)
 
         /* Print the buffer */
         fputs(print_buf, stream);
+        fprintf(stream, "Wakeups saved by coalescing: %" PRIu32 "\n", coalesced_count);
     }
 
+#if CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+    free(sorted);
+#endif
     free(print_buf);
     return ESP_OK;
 }
@@ -692,10 +952,10 @@ int64_t ESP_TIMER_IRAM_ATTR esp_timer_get_next_alarm(void)
     int64_t next_alarm = INT64_MAX;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
-        esp_timer_handle_t it = LIST_FIRST(&s_timers[dispatch_method]);
+        esp_timer_handle_t it = timer_queue_first(dispatch_method);
         if (it) {
-            if (next_alarm > it->alarm) {
-                next_alarm = it->alarm;
+            if (next_alarm > timer_deadline(it)) {
+                next_alarm = timer_deadline(it);
             }
         }
         timer_list_unlock(dispatch_method);
@@ -709,13 +969,20 @@ int64_t ESP_TIMER_IRAM_ATTR esp_timer_get_next_alarm_for_wake_up(void)
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
         esp_timer_handle_t it = NULL;
-        LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
+        TIMER_QUEUE_FOREACH(it, dispatch_method) {
             // timers with the SKIP_UNHANDLED_EVENTS flag do not want to wake up CPU from a sleep mode.
             if ((it->flags & FL_SKIP_UNHANDLED_EVENTS) == 0) {
-                if (next_alarm > it->alarm) {
-                    next_alarm = it->alarm;
+                if (next_alarm > timer_deadline(it)) {
+                    next_alarm = timer_deadline(it);
                 }
+#if !CONFIG_ESP_TIMER_QUEUE_MIN_HEAP
+                // the list is sorted, the first match is the earliest one
                 break;
+#else
+                if (it == timer_queue_first(dispatch_method)) {
+                    break;
+                }
+#endif
             }
         }
         timer_list_unlock(dispatch_method);
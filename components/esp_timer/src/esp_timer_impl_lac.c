@@ -8,6 +8,7 @@
 #include "sys/param.h"
 #include "esp_timer_impl.h"
 #include "esp_timer.h"
+#include "esp_timer_ticks.h"
 #include "esp_err.h"
 #include "esp_system.h"
 #include "esp_task.h"
@@ -144,6 +145,15 @@ int64_t ESP_TIMER_IRAM_ATTR esp_timer_impl_get_time(void)
 
 int64_t esp_timer_get_time(void) __attribute__((alias("esp_timer_impl_get_time")));
 
+void ESP_TIMER_IRAM_ATTR esp_timer_get_monotonic_raw(struct timespec *ts)
+{
+    const uint64_t ticks_per_sec = TICKS_PER_US * 1000000ULL;
+    uint64_t ticks = esp_timer_impl_get_counter_reg();
+    uint64_t sec = ticks / ticks_per_sec;
+    ts->tv_sec = (time_t)sec;
+    ts->tv_nsec = (long)((ticks - sec * ticks_per_sec) * 1000 / TICKS_PER_US);
+}
+
 void ESP_TIMER_IRAM_ATTR esp_timer_impl_set_alarm_id(uint64_t timestamp, unsigned alarm_id)
 {
     assert(alarm_id < sizeof(timestamp_id) / sizeof(timestamp_id[0]));
@@ -9,6 +9,7 @@
 #include "esp_timer_impl.h"
 #include "esp_err.h"
 #include "esp_timer.h"
+#include "esp_timer_ticks.h"
 #include "esp_attr.h"
 #include "esp_intr_alloc.h"
 #include "esp_log.h"
@@ -68,12 +69,21 @@ uint64_t ESP_TIMER_IRAM_ATTR esp_timer_impl_get_counter_reg(void)
 int64_t ESP_TIMER_IRAM_ATTR esp_timer_impl_get_time(void)
 {
     // we hope the execution time of this function won't > 1us
-    // thus, to save one function call, we didn't use the existing `systimer_hal_get_time`
-    return systimer_hal.ticks_to_us(systimer_hal_get_counter_value(&systimer_hal, SYSTIMER_COUNTER_ESPTIMER));
+    // thus, the counter is read inline and converted with a constant instead of going through the HAL
+    return esp_timer_get_time_inline();
 }
 
 int64_t esp_timer_get_time(void) __attribute__((alias("esp_timer_impl_get_time")));
 
+void ESP_TIMER_IRAM_ATTR esp_timer_get_monotonic_raw(struct timespec *ts)
+{
+    const uint64_t ticks_per_sec = SYSTIMER_LL_TICKS_PER_US * 1000000ULL;
+    uint64_t ticks = esp_timer_get_ticks();
+    uint64_t sec = ticks / ticks_per_sec;
+    ts->tv_sec = (time_t)sec;
+    ts->tv_nsec = (long)((ticks - sec * ticks_per_sec) * 1000 / SYSTIMER_LL_TICKS_PER_US);
+}
+
 void ESP_TIMER_IRAM_ATTR esp_timer_impl_set_alarm_id(uint64_t timestamp, unsigned alarm_id)
 {
     assert(alarm_id < sizeof(timestamp_id) / sizeof(timestamp_id[0]));
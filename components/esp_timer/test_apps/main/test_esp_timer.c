@@ -1,16 +1,18 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include "sdkconfig.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include <time.h>
 #include <sys/time.h>
 #include <sys/param.h>
 #include "esp_timer.h"
+#include "esp_timer_ticks.h"
 #include "esp_timer_impl.h"
 #include "unity.h"
 #include "soc/timer_group_reg.h"
@@ -346,6 +348,128 @@ TEST_CASE("multiple timers are ordered correctly", "[esp_timer]")
 }
 #undef N
 
+#define MANY_TIMERS_NUM 200
+
+typedef struct {
+    uint64_t expiry[MANY_TIMERS_NUM];
+    int fired[MANY_TIMERS_NUM];
+    volatile int fired_count;
+    SemaphoreHandle_t done;
+} test_many_timers_ctx_t;
+
+static test_many_timers_ctx_t* s_many_timers_ctx;
+
+static void test_many_timers_func(void* arg)
+{
+    test_many_timers_ctx_t* ctx = s_many_timers_ctx;
+    ctx->fired[ctx->fired_count++] = (int) arg;
+    xSemaphoreGive(ctx->done);
+}
+
+TEST_CASE("many timers fire in the order of their expiry time", "[esp_timer]")
+{
+    test_many_timers_ctx_t* ctx = calloc(1, sizeof(test_many_timers_ctx_t));
+    TEST_ASSERT_NOT_NULL(ctx);
+    esp_timer_handle_t* timers = calloc(MANY_TIMERS_NUM, sizeof(esp_timer_handle_t));
+    TEST_ASSERT_NOT_NULL(timers);
+    ctx->done = xSemaphoreCreateCounting(MANY_TIMERS_NUM, 0);
+    s_many_timers_ctx = ctx;
+
+    for (int i = 0; i < MANY_TIMERS_NUM; ++i) {
+        esp_timer_create_args_t args = {
+            .callback = &test_many_timers_func,
+            .arg = (void*) i,
+        };
+        TEST_ESP_OK(esp_timer_create(&args, &timers[i]));
+    }
+    srand(MANY_TIMERS_NUM);
+    for (int i = 0; i < MANY_TIMERS_NUM; ++i) {
+        // plenty of timers share the same expiry time
+        TEST_ESP_OK(esp_timer_start_once(timers[i], 20000 + (rand() % 40) * 1000));
+        TEST_ESP_OK(esp_timer_get_expiry_time(timers[i], &ctx->expiry[i]));
+    }
+    int stopped = 0;
+    for (int i = 0; i < MANY_TIMERS_NUM; i += 4) {
+        TEST_ESP_OK(esp_timer_stop(timers[i]));
+        ++stopped;
+    }
+
+    for (int i = 0; i < MANY_TIMERS_NUM - stopped; ++i) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(ctx->done, pdMS_TO_TICKS(1000)));
+    }
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(MANY_TIMERS_NUM - stopped, ctx->fired_count);
+
+    for (int i = 0; i < ctx->fired_count; ++i) {
+        int index = ctx->fired[i];
+        TEST_ASSERT_NOT_EQUAL(0, index % 4);
+        if (i > 0) {
+            TEST_ASSERT_LESS_OR_EQUAL_UINT64(ctx->expiry[index], ctx->expiry[ctx->fired[i - 1]]);
+        }
+    }
+
+    for (int i = 0; i < MANY_TIMERS_NUM; ++i) {
+        TEST_ESP_OK(esp_timer_delete(timers[i]));
+    }
+    vTaskDelay(3); // wait for the esp_timer task to delete all timers
+    vSemaphoreDelete(ctx->done);
+    s_many_timers_ctx = NULL;
+    free(timers);
+    free(ctx);
+}
+
+static void test_slack_timer_func(void* arg)
+{
+    *(int64_t*) arg = esp_timer_get_time();
+}
+
+static uint32_t get_coalesced_wakeups(void)
+{
+    char* buf = NULL;
+    size_t buf_size = 0;
+    FILE* stream = open_memstream(&buf, &buf_size);
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ESP_OK(esp_timer_dump(stream));
+    fclose(stream);
+
+    const char* prefix = "Wakeups saved by coalescing: ";
+    char* line = strstr(buf, prefix);
+    TEST_ASSERT_NOT_NULL(line);
+    uint32_t count = strtoul(line + strlen(prefix), NULL, 10);
+    free(buf);
+    return count;
+}
+
+TEST_CASE("timers with overlapping slack are dispatched together", "[esp_timer]")
+{
+    int64_t t_fired[2] = { 0 };
+    esp_timer_handle_t timers[2];
+    for (int i = 0; i < 2; ++i) {
+        esp_timer_create_args_t args = {
+            .callback = &test_slack_timer_func,
+            .arg = &t_fired[i],
+            .slack_us = 20000,
+        };
+        TEST_ESP_OK(esp_timer_create(&args, &timers[i]));
+    }
+    uint32_t coalesced_before = get_coalesced_wakeups();
+
+    int64_t t_start = esp_timer_get_time();
+    TEST_ESP_OK(esp_timer_start_once(timers[0], 10000));
+    TEST_ESP_OK(esp_timer_start_once(timers[1], 20000));
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    TEST_ASSERT_FALSE(esp_timer_is_active(timers[0]));
+    TEST_ASSERT_FALSE(esp_timer_is_active(timers[1]));
+    TEST_ASSERT_GREATER_OR_EQUAL_INT64(t_start + 20000, t_fired[1]);
+    TEST_ASSERT_INT64_WITHIN(2000, t_fired[0], t_fired[1]);
+    TEST_ASSERT_EQUAL_UINT32(coalesced_before + 1, get_coalesced_wakeups());
+
+    TEST_ESP_OK(esp_timer_delete(timers[0]));
+    TEST_ESP_OK(esp_timer_delete(timers[1]));
+    vTaskDelay(3); // wait for the esp_timer task to delete all timers
+}
+
 static void test_short_intervals_timer_func(void* arg)
 {
     SemaphoreHandle_t done = (SemaphoreHandle_t) arg;
@@ -405,6 +529,45 @@ TEST_CASE("esp_timer_get_time call takes less than 1us", "[esp_timer]")
     test_esp_timer_get_time_performance();
 }
 
+TEST_CASE("esp_timer_get_ticks follows esp_timer_get_time", "[esp_timer]")
+{
+    uint64_t ticks_start = esp_timer_get_ticks();
+    int64_t us_start = esp_timer_get_time();
+    uint64_t prev = ticks_start;
+    for (int i = 0; i < 10000; ++i) {
+        uint64_t ticks = esp_timer_get_ticks();
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT64(prev, ticks);
+        prev = ticks;
+    }
+    esp_rom_delay_us(10000);
+    int64_t us_end = esp_timer_get_time();
+    uint64_t ticks_end = esp_timer_get_ticks();
+
+    // the two clocks are the same counter, read with a few instructions in between
+    int64_t ticks_us = esp_timer_ticks_to_us(ticks_end - ticks_start);
+    TEST_ASSERT_INT64_WITHIN(5, us_end - us_start, ticks_us);
+    TEST_ASSERT_INT64_WITHIN(1, esp_timer_get_time(), esp_timer_get_time_inline());
+
+    struct timespec raw;
+    int64_t before = esp_timer_get_time();
+    esp_timer_get_monotonic_raw(&raw);
+    int64_t after = esp_timer_get_time();
+    int64_t raw_us = raw.tv_sec * 1000000LL + raw.tv_nsec / 1000;
+    TEST_ASSERT_LESS_THAN(1000000000L, raw.tv_nsec);
+    TEST_ASSERT_TRUE(raw_us >= before && raw_us <= after);
+
+    const int iter_count = 10000;
+    int64_t begin = esp_timer_get_time();
+    volatile uint64_t end_ticks;
+    for (int i = 0; i < iter_count; ++i) {
+        end_ticks = esp_timer_get_ticks();
+    }
+    (void)end_ticks;
+    int ns_per_call = (int)((esp_timer_get_time() - begin) * 1000 / iter_count);
+    printf("esp_timer_get_ticks: %dns per call\n", ns_per_call);
+    TEST_ASSERT_LESS_THAN(1000, ns_per_call);
+}
+
 static int64_t IRAM_ATTR __attribute__((noinline)) get_clock_diff(void)
 {
     uint64_t hs_time = esp_timer_get_time();
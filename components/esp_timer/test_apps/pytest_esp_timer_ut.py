@@ -19,6 +19,8 @@ from pytest_embedded_idf.utils import idf_parametrize
         ('any_cpu_esp32', 'esp32'),
         ('cpu1_esp32s3', 'esp32s3'),
         ('any_cpu_esp32s3', 'esp32s3'),
+        ('min_heap', 'esp32'),
+        ('min_heap', 'esp32c3'),
     ],
     indirect=['config', 'target'],
 )
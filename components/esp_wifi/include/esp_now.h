@@ -92,6 +92,23 @@ typedef struct esp_now_recv_info {
     wifi_pkt_rx_ctrl_t * rx_ctrl;            /**< Rx control info of ESPNOW packet */
 } esp_now_recv_info_t;
 
+/**
+ * @brief ESPNOW frame to send with esp_now_send_batch()
+ */
+typedef struct esp_now_frame {
+    const uint8_t *peer_addr;                /**< Peer MAC address, NULL to send to all of the peers in the peer list */
+    const uint8_t *data;                     /**< Data to send */
+    size_t len;                              /**< Length of data */
+} esp_now_frame_t;
+
+/**
+ * @brief Counters of the send status of ESPNOW data, see esp_now_register_send_counters()
+ */
+typedef struct esp_now_send_counters {
+    uint32_t success;                        /**< Number of ESPNOW data sent with status ESP_NOW_SEND_SUCCESS */
+    uint32_t fail;                           /**< Number of ESPNOW data sent with status ESP_NOW_SEND_FAIL */
+} esp_now_send_counters_t;
+
 /**
  * @brief ESPNOW rate config
  */
@@ -212,6 +229,57 @@ esp_err_t esp_now_unregister_send_cb(void);
   */
 esp_err_t esp_now_send(const uint8_t *peer_addr, const uint8_t *data, size_t len);
 
+/**
+  * @brief     Send several ESPNOW data
+  *
+  * @attention 1. The frames are sent in order, as with esp_now_send(), and the sending stops at the first frame that
+  *               cannot be sent
+  * @attention 2. With the send counters registered by esp_now_register_send_counters(), a batch is sent without any
+  *               callback per frame
+  *
+  * @param     frames  frames to send
+  * @param     num  number of frames
+  * @param     num_sent  number of frames sent, the frames after them are not sent, can be NULL
+  *
+  * @return
+  *          - ESP_OK : succeed, all of the frames are sent
+  *          - ESP_ERR_ESPNOW_ARG : invalid argument
+  *          - others : the error of esp_now_send() for the first frame not sent. On ESP_ERR_ESPNOW_NO_MEM, you can
+  *                     delay a while before sending the remaining frames
+  */
+esp_err_t esp_now_send_batch(const esp_now_frame_t *frames, size_t num, size_t *num_sent);
+
+/**
+  * @brief     Count the send status of ESPNOW data instead of calling a send callback for each data
+  *
+  * This is meant for high sending rates, to save a callback, and usually a task wakeup, per data.
+  * Read the counters with esp_now_get_send_counters().
+  *
+  * @attention 1. The counters take the place of the sending callback function, registering a callback with
+  *               esp_now_register_send_cb() stops them, esp_now_unregister_send_cb() unregisters them
+  * @attention 2. The counters are reset to 0 when registered
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_ESPNOW_NOT_INIT : ESPNOW is not initialized
+  *          - ESP_ERR_ESPNOW_INTERNAL : internal error
+  */
+esp_err_t esp_now_register_send_counters(void);
+
+/**
+  * @brief     Get the counters of the send status of ESPNOW data
+  *
+  * The counters keep counting from their registration, compare two readings to get the status of the data sent in
+  * between.
+  *
+  * @param     counters  send counters
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_ESPNOW_ARG : invalid argument
+  */
+esp_err_t esp_now_get_send_counters(esp_now_send_counters_t *counters);
+
 /**
   * @brief     Add a peer to peer list
   *
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdatomic.h>
+#include "esp_now.h"
+
+/* Written by the WiFi task only, read by any task */
+static atomic_uint_least32_t s_send_success;
+static atomic_uint_least32_t s_send_fail;
+
+static void send_counters_cb(const uint8_t *mac_addr, esp_now_send_status_t status)
+{
+    if (status == ESP_NOW_SEND_SUCCESS) {
+        atomic_fetch_add_explicit(&s_send_success, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&s_send_fail, 1, memory_order_relaxed);
+    }
+}
+
+esp_err_t esp_now_send_batch(const esp_now_frame_t *frames, size_t num, size_t *num_sent)
+{
+    if (frames == NULL && num != 0) {
+        return ESP_ERR_ESPNOW_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    size_t i = 0;
+    for (; i < num; i++) {
+        ret = esp_now_send(frames[i].peer_addr, frames[i].data, frames[i].len);
+        if (ret != ESP_OK) {
+            break;
+        }
+    }
+    if (num_sent) {
+        *num_sent = i;
+    }
+    return ret;
+}
+
+esp_err_t esp_now_register_send_counters(void)
+{
+    atomic_store(&s_send_success, 0);
+    atomic_store(&s_send_fail, 0);
+    return esp_now_register_send_cb(send_counters_cb);
+}
+
+esp_err_t esp_now_get_send_counters(esp_now_send_counters_t *counters)
+{
+    if (counters == NULL) {
+        return ESP_ERR_ESPNOW_ARG;
+    }
+    counters->success = atomic_load_explicit(&s_send_success, memory_order_relaxed);
+    counters->fail = atomic_load_explicit(&s_send_fail, memory_order_relaxed);
+    return ESP_OK;
+}
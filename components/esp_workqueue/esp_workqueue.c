@@ -0,0 +1,264 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+#include "esp_check.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_workqueue.h"
+
+static const char *TAG = "workqueue";
+
+#define WORKQUEUE_NUM_WORKERS CONFIG_FREERTOS_NUMBER_OF_CORES
+
+typedef struct {
+    esp_workqueue_job_t job;
+    void *arg;
+} workqueue_item_t;
+
+/**
+ * Worker pinned to a core, with the jobs submitted from that core.
+ * The worker runs the newest jobs of its own queue first, while they are still in the cache,
+ * and steals the oldest jobs of the other queues.
+ */
+typedef struct {
+    portMUX_TYPE lock;              /*!< Protects the queue and the waiting flag */
+    workqueue_item_t *items;        /*!< Ring of queue_size items */
+    size_t head;                    /*!< Index of the oldest item */
+    size_t count;                   /*!< Number of items in the queue */
+    bool waiting;                   /*!< The worker has found no job and is about to wait for, or waiting for, a notification */
+    TaskHandle_t task;
+} workqueue_worker_t;
+
+struct esp_workqueue {
+    size_t queue_size;
+    volatile bool stopping;
+    SemaphoreHandle_t stopped_sem;  /*!< Given by each worker when it stops */
+    workqueue_worker_t workers[WORKQUEUE_NUM_WORKERS];
+};
+
+static bool workqueue_push(esp_workqueue_handle_t wq, workqueue_worker_t *worker, const workqueue_item_t *item)
+{
+    bool pushed = false;
+    portENTER_CRITICAL_SAFE(&worker->lock);
+    if (worker->count < wq->queue_size) {
+        worker->items[(worker->head + worker->count) % wq->queue_size] = *item;
+        worker->count++;
+        pushed = true;
+    }
+    portEXIT_CRITICAL_SAFE(&worker->lock);
+    return pushed;
+}
+
+static bool workqueue_pop_newest(esp_workqueue_handle_t wq, workqueue_worker_t *worker, workqueue_item_t *item)
+{
+    bool popped = false;
+    portENTER_CRITICAL(&worker->lock);
+    if (worker->count > 0) {
+        worker->count--;
+        *item = worker->items[(worker->head + worker->count) % wq->queue_size];
+        popped = true;
+    }
+    portEXIT_CRITICAL(&worker->lock);
+    return popped;
+}
+
+static bool workqueue_pop_oldest(esp_workqueue_handle_t wq, workqueue_worker_t *worker, workqueue_item_t *item)
+{
+    bool popped = false;
+    portENTER_CRITICAL(&worker->lock);
+    if (worker->count > 0) {
+        *item = worker->items[worker->head];
+        worker->head = (worker->head + 1) % wq->queue_size;
+        worker->count--;
+        popped = true;
+    }
+    portEXIT_CRITICAL(&worker->lock);
+    return popped;
+}
+
+static bool workqueue_find_job(esp_workqueue_handle_t wq, int core, workqueue_item_t *item)
+{
+    if (workqueue_pop_newest(wq, &wq->workers[core], item)) {
+        return true;
+    }
+    for (int i = 1; i < WORKQUEUE_NUM_WORKERS; i++) {
+        if (workqueue_pop_oldest(wq, &wq->workers[(core + i) % WORKQUEUE_NUM_WORKERS], item)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void workqueue_set_waiting(workqueue_worker_t *worker, bool waiting)
+{
+    portENTER_CRITICAL(&worker->lock);
+    worker->waiting = waiting;
+    portEXIT_CRITICAL(&worker->lock);
+}
+
+static void workqueue_worker_task(void *arg)
+{
+    esp_workqueue_handle_t wq = arg;
+    int core = xPortGetCoreID();
+    workqueue_worker_t *self = &wq->workers[core];
+    workqueue_item_t item;
+
+    while (true) {
+        if (workqueue_find_job(wq, core, &item)) {
+            item.job(item.arg);
+            continue;
+        }
+        /* The jobs submitted from now on notify this worker, look for jobs submitted in the meantime before waiting */
+        workqueue_set_waiting(self, true);
+        if (workqueue_find_job(wq, core, &item)) {
+            workqueue_set_waiting(self, false);
+            item.job(item.arg);
+            continue;
+        }
+        if (wq->stopping) {
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    xSemaphoreGive(wq->stopped_sem);
+    vTaskDelete(NULL);
+}
+
+/* Take the task of a worker waiting for jobs, starting with the worker of the given core */
+static TaskHandle_t workqueue_take_waiting_worker(esp_workqueue_handle_t wq, int core)
+{
+    for (int i = 0; i < WORKQUEUE_NUM_WORKERS; i++) {
+        workqueue_worker_t *worker = &wq->workers[(core + i) % WORKQUEUE_NUM_WORKERS];
+        bool waiting;
+        portENTER_CRITICAL_SAFE(&worker->lock);
+        waiting = worker->waiting;
+        worker->waiting = false;
+        portEXIT_CRITICAL_SAFE(&worker->lock);
+        if (waiting) {
+            return worker->task;
+        }
+    }
+    return NULL;
+}
+
+static esp_err_t workqueue_submit(esp_workqueue_handle_t wq, esp_workqueue_job_t job, void *arg, TaskHandle_t *ret_task)
+{
+    ESP_RETURN_ON_FALSE_ISR(wq && job, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE_ISR(!wq->stopping, ESP_ERR_INVALID_STATE, TAG, "work queue is being deleted");
+
+    workqueue_item_t item = {
+        .job = job,
+        .arg = arg,
+    };
+    int core = xPortGetCoreID();
+    for (int i = 0; i < WORKQUEUE_NUM_WORKERS; i++) {
+        int target = (core + i) % WORKQUEUE_NUM_WORKERS;
+        if (workqueue_push(wq, &wq->workers[target], &item)) {
+            *ret_task = workqueue_take_waiting_worker(wq, target);
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t esp_workqueue_submit(esp_workqueue_handle_t wq, esp_workqueue_job_t job, void *arg)
+{
+    TaskHandle_t task = NULL;
+    esp_err_t ret = workqueue_submit(wq, job, arg, &task);
+    if (task) {
+        xTaskNotifyGive(task);
+    }
+    return ret;
+}
+
+esp_err_t esp_workqueue_submit_from_isr(esp_workqueue_handle_t wq, esp_workqueue_job_t job, void *arg,
+                                        BaseType_t *pxHigherPriorityTaskWoken)
+{
+    TaskHandle_t task = NULL;
+    esp_err_t ret = workqueue_submit(wq, job, arg, &task);
+    if (task) {
+        vTaskNotifyGiveFromISR(task, pxHigherPriorityTaskWoken);
+    }
+    return ret;
+}
+
+static void workqueue_free(esp_workqueue_handle_t wq)
+{
+    for (int i = 0; i < WORKQUEUE_NUM_WORKERS; i++) {
+        free(wq->workers[i].items);
+    }
+    if (wq->stopped_sem) {
+        vSemaphoreDelete(wq->stopped_sem);
+    }
+    free(wq);
+}
+
+/* Stop the workers once they have run the pending jobs, and free the work queue */
+static void workqueue_stop(esp_workqueue_handle_t wq)
+{
+    wq->stopping = true;
+    int started = 0;
+    for (int i = 0; i < WORKQUEUE_NUM_WORKERS; i++) {
+        if (wq->workers[i].task) {
+            xTaskNotifyGive(wq->workers[i].task);
+            started++;
+        }
+    }
+    for (int i = 0; i < started; i++) {
+        xSemaphoreTake(wq->stopped_sem, portMAX_DELAY);
+    }
+    workqueue_free(wq);
+}
+
+esp_err_t esp_workqueue_create(const esp_workqueue_config_t *config, esp_workqueue_handle_t *ret_wq)
+{
+    ESP_RETURN_ON_FALSE(config && ret_wq, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->queue_size > 0, ESP_ERR_INVALID_ARG, TAG, "invalid queue size");
+
+    esp_workqueue_handle_t wq = calloc(1, sizeof(struct esp_workqueue));
+    ESP_RETURN_ON_FALSE(wq, ESP_ERR_NO_MEM, TAG, "no mem for work queue");
+    wq->queue_size = config->queue_size;
+    wq->stopped_sem = xSemaphoreCreateCounting(WORKQUEUE_NUM_WORKERS, 0);
+    if (wq->stopped_sem == NULL) {
+        workqueue_free(wq);
+        ESP_LOGE(TAG, "no mem for work queue");
+        return ESP_ERR_NO_MEM;
+    }
+    for (int i = 0; i < WORKQUEUE_NUM_WORKERS; i++) {
+        portMUX_INITIALIZE(&wq->workers[i].lock);
+        wq->workers[i].items = calloc(config->queue_size, sizeof(workqueue_item_t));
+        if (wq->workers[i].items == NULL) {
+            workqueue_free(wq);
+            ESP_LOGE(TAG, "no mem for job queues");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    for (int i = 0; i < WORKQUEUE_NUM_WORKERS; i++) {
+        if (xTaskCreatePinnedToCore(workqueue_worker_task, "workqueue", config->stack_size, wq, config->priority,
+                                    &wq->workers[i].task, i) != pdPASS) {
+            wq->workers[i].task = NULL;
+            workqueue_stop(wq);
+            ESP_LOGE(TAG, "create worker task failed");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    *ret_wq = wq;
+    return ESP_OK;
+}
+
+esp_err_t esp_workqueue_delete(esp_workqueue_handle_t wq)
+{
+    ESP_RETURN_ON_FALSE(wq, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    workqueue_stop(wq);
+    return ESP_OK;
+}
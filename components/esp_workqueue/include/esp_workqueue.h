@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Work queue handle
+ */
+typedef struct esp_workqueue *esp_workqueue_handle_t;
+
+/**
+ * @brief Job run by a worker of the work queue
+ *
+ * @param arg Argument given when the job was submitted
+ */
+typedef void (*esp_workqueue_job_t)(void *arg);
+
+/**
+ * @brief Work queue configuration
+ */
+typedef struct {
+    size_t queue_size;          /*!< Max number of pending jobs per core */
+    uint32_t stack_size;        /*!< Stack size of the workers, in bytes */
+    UBaseType_t priority;       /*!< Priority of the workers */
+} esp_workqueue_config_t;
+
+/**
+ * @brief Default work queue configuration
+ */
+#define ESP_WORKQUEUE_DEFAULT_CONFIG() { \
+    .queue_size = 32,                    \
+    .stack_size = 3072,                  \
+    .priority = 5,                       \
+}
+
+/**
+ * @brief Create a work queue
+ *
+ * A worker task is pinned to each core. The jobs submitted from a core are queued for the worker of that core,
+ * and a worker without pending jobs steals the oldest pending job of the other cores before waiting for new jobs.
+ * Submitting a job does not go through a FreeRTOS queue: it is added to the job queue of the core under a spinlock,
+ * and the worker is only notified when it is waiting for jobs.
+ *
+ * @param[in]  config  Work queue configuration
+ * @param[out] ret_wq  Handle of the created work queue
+ *
+ * @return
+ *      - ESP_OK: Work queue created
+ *      - ESP_ERR_INVALID_ARG: Invalid configuration
+ *      - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t esp_workqueue_create(const esp_workqueue_config_t *config, esp_workqueue_handle_t *ret_wq);
+
+/**
+ * @brief Delete a work queue
+ *
+ * The pending jobs are run, then the workers are stopped.
+ *
+ * @note Must not be called from a job of the work queue, nor while jobs are being submitted to the work queue
+ *
+ * @param[in] wq  Work queue handle
+ *
+ * @return
+ *      - ESP_OK: Work queue deleted
+ *      - ESP_ERR_INVALID_ARG: Invalid handle
+ */
+esp_err_t esp_workqueue_delete(esp_workqueue_handle_t wq);
+
+/**
+ * @brief Submit a job to a work queue
+ *
+ * The job is queued for the worker of the calling core, or for the worker of another core if the queue of the
+ * calling core is full. It may be run by any worker.
+ *
+ * @param[in] wq   Work queue handle
+ * @param[in] job  Job to run
+ * @param[in] arg  Argument of the job
+ *
+ * @return
+ *      - ESP_OK: Job submitted
+ *      - ESP_ERR_INVALID_ARG: Invalid arguments
+ *      - ESP_ERR_INVALID_STATE: The work queue is being deleted
+ *      - ESP_ERR_NO_MEM: The queues of all the cores are full
+ */
+esp_err_t esp_workqueue_submit(esp_workqueue_handle_t wq, esp_workqueue_job_t job, void *arg);
+
+/**
+ * @brief Submit a job to a work queue from an ISR
+ *
+ * Same as esp_workqueue_submit(), to be called from an ISR.
+ *
+ * @param[in]  wq                         Work queue handle
+ * @param[in]  job                        Job to run
+ * @param[in]  arg                        Argument of the job
+ * @param[out] pxHigherPriorityTaskWoken  Set to pdTRUE if a worker of higher priority than the interrupted task
+ *                                        has been woken up, in which case a context switch should be requested
+ *                                        before the ISR is exited. Can be NULL.
+ *
+ * @return
+ *      - ESP_OK: Job submitted
+ *      - ESP_ERR_INVALID_ARG: Invalid arguments
+ *      - ESP_ERR_INVALID_STATE: The work queue is being deleted
+ *      - ESP_ERR_NO_MEM: The queues of all the cores are full
+ */
+esp_err_t esp_workqueue_submit_from_isr(esp_workqueue_handle_t wq, esp_workqueue_job_t job, void *arg,
+                                        BaseType_t *pxHigherPriorityTaskWoken);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdatomic.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_rom_sys.h"
+#include "unity.h"
+#include "esp_workqueue.h"
+
+#define TEST_JOBS_NUM   1000
+
+static atomic_int s_jobs_done;
+static atomic_int s_jobs_per_core[CONFIG_FREERTOS_NUMBER_OF_CORES];
+
+static void count_job(void *arg)
+{
+    atomic_fetch_add(&s_jobs_done, 1);
+}
+
+static void busy_job(void *arg)
+{
+    atomic_fetch_add(&s_jobs_per_core[xPortGetCoreID()], 1);
+    esp_rom_delay_us(200);
+    atomic_fetch_add(&s_jobs_done, 1);
+}
+
+static void submit_job(esp_workqueue_handle_t wq, esp_workqueue_job_t job)
+{
+    esp_err_t ret;
+    while ((ret = esp_workqueue_submit(wq, job, NULL)) == ESP_ERR_NO_MEM) {
+        vTaskDelay(1);
+    }
+    TEST_ESP_OK(ret);
+}
+
+static void wait_jobs_done(int count)
+{
+    for (int i = 0; i < 1000 && atomic_load(&s_jobs_done) < count; i++) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    TEST_ASSERT_EQUAL(count, atomic_load(&s_jobs_done));
+}
+
+TEST_CASE("workqueue rejects invalid arguments", "[workqueue]")
+{
+    esp_workqueue_config_t config = ESP_WORKQUEUE_DEFAULT_CONFIG();
+    esp_workqueue_handle_t wq = NULL;
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_workqueue_create(NULL, &wq));
+    config.queue_size = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_workqueue_create(&config, &wq));
+
+    config.queue_size = 4;
+    TEST_ESP_OK(esp_workqueue_create(&config, &wq));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_workqueue_submit(wq, NULL, NULL));
+    TEST_ESP_OK(esp_workqueue_delete(wq));
+}
+
+TEST_CASE("workqueue runs all the submitted jobs", "[workqueue]")
+{
+    esp_workqueue_config_t config = ESP_WORKQUEUE_DEFAULT_CONFIG();
+    esp_workqueue_handle_t wq = NULL;
+    TEST_ESP_OK(esp_workqueue_create(&config, &wq));
+
+    atomic_store(&s_jobs_done, 0);
+    for (int i = 0; i < TEST_JOBS_NUM; i++) {
+        submit_job(wq, count_job);
+    }
+    wait_jobs_done(TEST_JOBS_NUM);
+
+    TEST_ESP_OK(esp_workqueue_delete(wq));
+}
+
+TEST_CASE("workqueue runs the pending jobs before being deleted", "[workqueue]")
+{
+    esp_workqueue_config_t config = ESP_WORKQUEUE_DEFAULT_CONFIG();
+    esp_workqueue_handle_t wq = NULL;
+    TEST_ESP_OK(esp_workqueue_create(&config, &wq));
+
+    atomic_store(&s_jobs_done, 0);
+    /* Keep the workers from running the jobs until the work queue is deleted */
+    vTaskPrioritySet(NULL, config.priority + 1);
+    for (int i = 0; i < config.queue_size; i++) {
+        TEST_ESP_OK(esp_workqueue_submit(wq, count_job, NULL));
+    }
+    vTaskPrioritySet(NULL, tskIDLE_PRIORITY + 1);
+    TEST_ESP_OK(esp_workqueue_delete(wq));
+
+    TEST_ASSERT_EQUAL(config.queue_size, atomic_load(&s_jobs_done));
+}
+
+#if CONFIG_FREERTOS_NUMBER_OF_CORES > 1
+TEST_CASE("workqueue jobs are stolen by the workers of the other cores", "[workqueue]")
+{
+    esp_workqueue_config_t config = ESP_WORKQUEUE_DEFAULT_CONFIG();
+    config.queue_size = 64;
+    esp_workqueue_handle_t wq = NULL;
+    TEST_ESP_OK(esp_workqueue_create(&config, &wq));
+
+    atomic_store(&s_jobs_done, 0);
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        atomic_store(&s_jobs_per_core[i], 0);
+    }
+    /* All the jobs are queued for the worker of the current core, which cannot run before they are all submitted */
+    vTaskPrioritySet(NULL, config.priority + 1);
+    for (int i = 0; i < config.queue_size; i++) {
+        TEST_ESP_OK(esp_workqueue_submit(wq, busy_job, NULL));
+    }
+    vTaskPrioritySet(NULL, tskIDLE_PRIORITY + 1);
+    wait_jobs_done(config.queue_size);
+
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        TEST_ASSERT_GREATER_THAN(0, atomic_load(&s_jobs_per_core[i]));
+    }
+    TEST_ESP_OK(esp_workqueue_delete(wq));
+}
+#endif
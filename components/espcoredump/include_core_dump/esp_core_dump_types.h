@@ -80,7 +80,11 @@ extern "C" {
 /**
  * @brief Macro defining the size of the cache used to write the core dump.
  */
+#if CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH
+#define COREDUMP_CACHE_SIZE CONFIG_ESP_COREDUMP_FLASH_WRITE_BUFFER_SIZE
+#else
 #define COREDUMP_CACHE_SIZE 32
+#endif
 
 /**
  * @brief If the core dump has to be written to an encrypted flash, the
@@ -132,7 +136,7 @@ typedef core_dump_sha_ctx_t checksum_ctx_t;
 typedef struct _core_dump_write_data_t {
     uint32_t off; /*!< Current offset of data being written */
     uint8_t  cached_data[COREDUMP_CACHE_SIZE]; /*!< Cache used to write to flash */
-    uint8_t  cached_bytes; /*!< Number of bytes filled in the cached */
+    uint16_t cached_bytes; /*!< Number of bytes filled in the cached */
     checksum_ctx_t checksum_ctx; /*!< Checksum context */
 } core_dump_write_data_t;
 
@@ -31,6 +31,10 @@ typedef struct _core_dump_partition_t {
     /* Flag set to true if the partition is empty. */
     bool empty;
 #endif
+#if CONFIG_ESP_COREDUMP_FLASH_PRE_ERASE
+    /* Flag set to true if all the sectors but the first one are erased. */
+    bool pre_erased;
+#endif
 } core_dump_partition_t;
 
 typedef struct _core_dump_flash_config_t {
@@ -114,6 +118,50 @@ static esp_err_t esp_core_dump_flash_hw_init(void)
     return ESP_OK;
 }
 
+#if CONFIG_ESP_COREDUMP_FLASH_PRE_ERASE
+static bool esp_core_dump_sector_is_blank(const esp_partition_t *core_part, uint32_t offset)
+{
+    uint32_t buf[16];
+
+    for (uint32_t off = 0; off < SPI_FLASH_SEC_SIZE; off += sizeof(buf)) {
+        /* Read the raw content, an erased encrypted sector is not blank once decrypted. */
+        if (esp_partition_read_raw(core_part, offset + off, buf, sizeof(buf)) != ESP_OK) {
+            return false;
+        }
+        for (int i = 0; i < sizeof(buf) / sizeof(buf[0]); i++) {
+            if (buf[i] != UINT32_MAX) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void esp_core_dump_flash_pre_erase(const esp_partition_t *core_part)
+{
+    uint32_t core_size = 0;
+
+    /* Keep the core dump in the partition, if any, until the application erases it. */
+    esp_err_t err = esp_partition_read(core_part, 0, &core_size, sizeof(core_size));
+    if (err != ESP_OK || core_size != BLANK_COREDUMP_SIZE) {
+        return;
+    }
+
+    /* The first sector holds the size of the core dump, it is erased when the core dump is saved. */
+    for (uint32_t off = SPI_FLASH_SEC_SIZE; off < core_part->size; off += SPI_FLASH_SEC_SIZE) {
+        if (esp_core_dump_sector_is_blank(core_part, off)) {
+            continue;
+        }
+        err = esp_partition_erase_range(core_part, off, SPI_FLASH_SEC_SIZE);
+        if (err != ESP_OK) {
+            ESP_COREDUMP_LOGE("Failed to erase core dump partition (%d)!", err);
+            return;
+        }
+    }
+    s_core_flash_config.partition.pre_erased = true;
+}
+#endif
+
 static void esp_core_dump_partition_init(void)
 {
     const esp_partition_t *core_part = NULL;
@@ -141,6 +189,10 @@ static void esp_core_dump_partition_init(void)
     }
 #endif
 
+#if CONFIG_ESP_COREDUMP_FLASH_PRE_ERASE
+    esp_core_dump_flash_pre_erase(core_part);
+#endif
+
     s_core_flash_config.partition_config_crc = esp_core_dump_calc_flash_config_crc();
 
     if (esp_flash_encryption_enabled() && !core_part->encrypted) {
@@ -233,6 +285,13 @@ static esp_err_t esp_core_dump_flash_write_prepare(core_dump_write_data_t *wr_da
         sec_num++;
     }
 
+#if CONFIG_ESP_COREDUMP_FLASH_PRE_ERASE
+    if (s_core_flash_config.partition.pre_erased) {
+        /* The other sectors have been erased in advance. */
+        sec_num = 1;
+    }
+#endif
+
     /* Erase the amount of sectors needed. */
     ESP_COREDUMP_LOGI("Erase flash %d bytes @ 0x%x", sec_num * SPI_FLASH_SEC_SIZE, s_core_flash_config.partition.start + 0);
     ESP_COREDUMP_ASSERT(sec_num * SPI_FLASH_SEC_SIZE <= s_core_flash_config.partition.size);
@@ -439,6 +498,14 @@ esp_err_t esp_core_dump_image_erase(void)
     }
 #endif
 
+#if CONFIG_ESP_COREDUMP_FLASH_PRE_ERASE
+    /* Only the first sector has been written since the whole partition was erased. */
+    if (err == ESP_OK && !s_core_flash_config.partition.pre_erased) {
+        s_core_flash_config.partition.pre_erased = true;
+        s_core_flash_config.partition_config_crc = esp_core_dump_calc_flash_config_crc();
+    }
+#endif
+
     return err;
 }
 
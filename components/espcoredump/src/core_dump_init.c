@@ -15,7 +15,7 @@ void esp_system_include_coredump_init(void)
 {
 }
 
-ESP_SYSTEM_INIT_FN(init_coredump, SECONDARY, BIT(0), 130)
+ESP_SYSTEM_INIT_FN(init_coredump, DEFERRABLE, BIT(0), 130)
 {
     esp_core_dump_init();
     return ESP_OK;
@@ -9,15 +9,121 @@
 /*-----------------------------------------------------------------------*/
 
 #include <string.h>
+#include <stdbool.h>
 #include <time.h>
 #include <stdlib.h>
 #include <sys/time.h>
+#include <sys/lock.h>
 #include "diskio_impl.h"
 #include "ffconf.h"
 #include "ff.h"
 
 static ff_diskio_impl_t * s_impls[FF_VOLUMES] = { NULL };
 
+#define FF_DISKIO_CACHE_FREE    ((LBA_t) -1)
+
+/* Write-through cache of single sectors, shared by all the files of a drive. FATFS reads the FAT
+   and directory sectors, and the partial sectors of the files, one at a time, and often reads
+   the same sectors again when several files are accessed in turn. */
+typedef struct {
+    _lock_t lock;
+    size_t sector_size;
+    size_t count;           /* number of cached sectors */
+    uint32_t tick;          /* access counter, to find the least recently used sector */
+    LBA_t *sectors;         /* sector number of each entry, FF_DISKIO_CACHE_FREE if the entry is free */
+    uint32_t *last_used;    /* tick of the last access of each entry */
+    BYTE *data;             /* count * sector_size bytes */
+} ff_diskio_cache_t;
+
+static ff_diskio_cache_t * s_caches[FF_VOLUMES] = { NULL };
+
+static void cache_free(BYTE pdrv)
+{
+    ff_diskio_cache_t *cache = s_caches[pdrv];
+    if (cache == NULL) {
+        return;
+    }
+    s_caches[pdrv] = NULL;
+    _lock_close(&cache->lock);
+    free(cache->data);
+    free(cache->last_used);
+    free(cache->sectors);
+    free(cache);
+}
+
+static void cache_invalidate(ff_diskio_cache_t *cache, LBA_t first, LBA_t last)
+{
+    for (size_t i = 0; i < cache->count; i++) {
+        if (cache->sectors[i] != FF_DISKIO_CACHE_FREE && cache->sectors[i] >= first && cache->sectors[i] <= last) {
+            cache->sectors[i] = FF_DISKIO_CACHE_FREE;
+        }
+    }
+}
+
+/* Find the entry of the sector, or a free or the least recently used entry if the sector is not cached */
+static size_t cache_find(ff_diskio_cache_t *cache, LBA_t sector, bool *found)
+{
+    size_t lru = 0;
+    for (size_t i = 0; i < cache->count; i++) {
+        if (cache->sectors[i] == sector) {
+            *found = true;
+            return i;
+        }
+        if (cache->sectors[lru] != FF_DISKIO_CACHE_FREE
+                && (cache->sectors[i] == FF_DISKIO_CACHE_FREE || (int32_t)(cache->last_used[i] - cache->last_used[lru]) < 0)) {
+            lru = i;
+        }
+    }
+    *found = false;
+    return lru;
+}
+
+static void cache_store(ff_diskio_cache_t *cache, size_t entry, LBA_t sector, const BYTE *buff)
+{
+    memcpy(cache->data + entry * cache->sector_size, buff, cache->sector_size);
+    cache->sectors[entry] = sector;
+    cache->last_used[entry] = ++cache->tick;
+}
+
+esp_err_t ff_diskio_set_cache(BYTE pdrv, size_t size)
+{
+    assert(pdrv < FF_VOLUMES);
+    if (s_impls[pdrv] == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    cache_free(pdrv);
+    WORD sector_size = 0;
+    if (s_impls[pdrv]->ioctl(pdrv, GET_SECTOR_SIZE, &sector_size) != RES_OK || sector_size == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    size_t count = size / sector_size;
+    if (count == 0) {
+        return ESP_OK;
+    }
+    ff_diskio_cache_t *cache = calloc(1, sizeof(ff_diskio_cache_t));
+    if (cache == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    cache->sectors = malloc(count * sizeof(LBA_t));
+    cache->last_used = calloc(count, sizeof(uint32_t));
+    cache->data = malloc(count * sector_size);
+    if (cache->sectors == NULL || cache->last_used == NULL || cache->data == NULL) {
+        free(cache->data);
+        free(cache->last_used);
+        free(cache->sectors);
+        free(cache);
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < count; i++) {
+        cache->sectors[i] = FF_DISKIO_CACHE_FREE;
+    }
+    cache->sector_size = sector_size;
+    cache->count = count;
+    _lock_init(&cache->lock);
+    s_caches[pdrv] = cache;
+    return ESP_OK;
+}
+
 #if FF_MULTI_PARTITION		/* Multiple partition configuration */
 const PARTITION VolToPart[FF_VOLUMES] = {
     {0, 0},    /* Logical drive 0 ==> Physical drive 0, auto detection */
@@ -67,6 +173,8 @@ void ff_diskio_register(BYTE pdrv, const ff_diskio_impl_t* discio_impl)
 {
     assert(pdrv < FF_VOLUMES);
 
+    cache_free(pdrv);
+
     if (s_impls[pdrv]) {
         ff_diskio_impl_t* im = s_impls[pdrv];
         s_impls[pdrv] = NULL;
@@ -85,6 +193,13 @@ void ff_diskio_register(BYTE pdrv, const ff_diskio_impl_t* discio_impl)
 
 DSTATUS ff_disk_initialize (BYTE pdrv)
 {
+    ff_diskio_cache_t *cache = s_caches[pdrv];
+    if (cache) {
+        // The medium may have been changed
+        _lock_acquire(&cache->lock);
+        cache_invalidate(cache, 0, FF_DISKIO_CACHE_FREE);
+        _lock_release(&cache->lock);
+    }
     return s_impls[pdrv]->init(pdrv);
 }
 DSTATUS ff_disk_status (BYTE pdrv)
@@ -93,14 +208,61 @@ DSTATUS ff_disk_status (BYTE pdrv)
 }
 DRESULT ff_disk_read (BYTE pdrv, BYTE* buff, LBA_t sector, UINT count)
 {
-    return s_impls[pdrv]->read(pdrv, buff, sector, count);
+    ff_diskio_cache_t *cache = s_caches[pdrv];
+    if (cache == NULL || count != 1) {
+        // Multi-sector reads of file data go to the disk, which holds the same data as the cache
+        return s_impls[pdrv]->read(pdrv, buff, sector, count);
+    }
+    _lock_acquire(&cache->lock);
+    bool found;
+    size_t entry = cache_find(cache, sector, &found);
+    DRESULT res = RES_OK;
+    if (found) {
+        memcpy(buff, cache->data + entry * cache->sector_size, cache->sector_size);
+        cache->last_used[entry] = ++cache->tick;
+    } else {
+        res = s_impls[pdrv]->read(pdrv, buff, sector, count);
+        if (res == RES_OK) {
+            cache_store(cache, entry, sector, buff);
+        }
+    }
+    _lock_release(&cache->lock);
+    return res;
 }
 DRESULT ff_disk_write (BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count)
 {
-    return s_impls[pdrv]->write(pdrv, buff, sector, count);
+    ff_diskio_cache_t *cache = s_caches[pdrv];
+    if (cache == NULL) {
+        return s_impls[pdrv]->write(pdrv, buff, sector, count);
+    }
+    _lock_acquire(&cache->lock);
+    DRESULT res = s_impls[pdrv]->write(pdrv, buff, sector, count);
+    if (res != RES_OK) {
+        // The sectors may have been partially written
+        cache_invalidate(cache, sector, sector + count - 1);
+    } else if (count == 1) {
+        bool found;
+        size_t entry = cache_find(cache, sector, &found);
+        cache_store(cache, entry, sector, buff);
+    } else {
+        for (size_t i = 0; i < cache->count; i++) {
+            if (cache->sectors[i] != FF_DISKIO_CACHE_FREE && cache->sectors[i] >= sector && cache->sectors[i] < sector + count) {
+                memcpy(cache->data + i * cache->sector_size, buff + (cache->sectors[i] - sector) * cache->sector_size, cache->sector_size);
+            }
+        }
+    }
+    _lock_release(&cache->lock);
+    return res;
 }
 DRESULT ff_disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
 {
+    ff_diskio_cache_t *cache = s_caches[pdrv];
+    if (cache && cmd == CTRL_TRIM) {
+        LBA_t *range = (LBA_t *) buff;
+        _lock_acquire(&cache->lock);
+        cache_invalidate(cache, range[0], range[1]);
+        _lock_release(&cache->lock);
+    }
     return s_impls[pdrv]->ioctl(pdrv, cmd, buff);
 }
 
@@ -66,6 +66,24 @@ void ff_diskio_register(BYTE pdrv, const ff_diskio_impl_t* discio_impl);
  */
 esp_err_t ff_diskio_get_drive(BYTE* out_pdrv);
 
+/**
+ * Enable the sector cache of given drive number
+ *
+ * The cache keeps the most recently read or written single sectors, such as the
+ * FAT and directory sectors, in RAM. It is shared by all the files of the drive.
+ * Writes go to the disk immediately, so the disk content is always up to date.
+ * The cache is freed when the drive is unregistered.
+ *
+ * @param pdrv drive number, with a registered diskio driver
+ * @param size size of the cache in bytes, rounded down to a multiple of the sector size;
+ *             0 to disable the cache
+ *
+ * @return  ESP_OK                  on success
+ *          ESP_ERR_INVALID_STATE   if no diskio driver is registered for the drive
+ *          ESP_ERR_NO_MEM          if the cache can not be allocated
+ */
+esp_err_t ff_diskio_set_cache(BYTE pdrv, size_t size);
+
 
 #ifdef __cplusplus
 }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,6 +11,7 @@
 #include <sys/time.h>
 #include <sys/unistd.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include "unity.h"
 #include "esp_partition.h"
 #include "esp_log.h"
@@ -216,6 +217,61 @@ TEST_CASE("(WL) can ftruncate", "[fatfs][wear_levelling]")
     test_teardown();
 }
 
+TEST_CASE("(WL) file buffer gives consistent reads and writes", "[fatfs][wear_levelling]")
+{
+    esp_vfs_fat_mount_config_t mount_config = {
+        .format_if_mount_failed = true,
+        .max_files = 5,
+        .file_buffer_size = 16 * 1024,
+    };
+    TEST_ESP_OK(esp_vfs_fat_spiflash_mount_rw_wl("/spiflash", NULL, &mount_config, &s_test_wl_handle));
+
+    test_fatfs_overwrite_append("/spiflash/hello.txt");
+    test_fatfs_lseek("/spiflash/seek.txt");
+    test_fatfs_create_file_with_text("/spiflash/hello.txt", fatfs_test_hello_str);
+    test_fatfs_pread_file("/spiflash/hello.txt");
+    test_fatfs_pwrite_file("/spiflash/hello.txt");
+    test_fatfs_ftruncate_file("/spiflash/ftrunc.txt", true);
+
+    // Small writes and reads, which are collected in the buffer
+    const size_t chunk_size = 100;
+    const size_t chunks = 1000;
+    uint8_t chunk[chunk_size];
+    int fd = open("/spiflash/chunks.bin", O_RDWR | O_CREAT | O_TRUNC);
+    TEST_ASSERT_NOT_EQUAL(-1, fd);
+    for (size_t i = 0; i < chunks; i++) {
+        memset(chunk, i, chunk_size);
+        TEST_ASSERT_EQUAL(chunk_size, write(fd, chunk, chunk_size));
+    }
+    struct stat st;
+    TEST_ASSERT_EQUAL(0, fstat(fd, &st));
+    TEST_ASSERT_EQUAL(chunk_size * chunks, st.st_size);
+    TEST_ASSERT_EQUAL(0, lseek(fd, 0, SEEK_SET));
+    for (size_t i = 0; i < chunks; i++) {
+        TEST_ASSERT_EQUAL(chunk_size, read(fd, chunk, chunk_size));
+        TEST_ASSERT_EACH_EQUAL_UINT8((uint8_t) i, chunk, chunk_size);
+        if (i % 10 == 9) {
+            // Overwrite the chunk which has just been read, then continue reading after it
+            memset(chunk, 0xa5, chunk_size);
+            TEST_ASSERT_EQUAL(i * chunk_size, lseek(fd, -(off_t) chunk_size, SEEK_CUR));
+            TEST_ASSERT_EQUAL(chunk_size, write(fd, chunk, chunk_size));
+        }
+    }
+    TEST_ASSERT_EQUAL(0, read(fd, chunk, chunk_size));
+    TEST_ASSERT_EQUAL(0, close(fd));
+
+    fd = open("/spiflash/chunks.bin", O_RDONLY);
+    TEST_ASSERT_NOT_EQUAL(-1, fd);
+    for (size_t i = 0; i < chunks; i++) {
+        TEST_ASSERT_EQUAL(chunk_size, read(fd, chunk, chunk_size));
+        TEST_ASSERT_EACH_EQUAL_UINT8((i % 10 == 9) ? 0xa5 : (uint8_t) i, chunk, chunk_size);
+    }
+    TEST_ASSERT_EQUAL(0, close(fd));
+    unlink("/spiflash/chunks.bin");
+
+    TEST_ESP_OK(esp_vfs_fat_spiflash_unmount_rw_wl("/spiflash", s_test_wl_handle));
+}
+
 #if FF_USE_EXPAND
 TEST_CASE("(WL) can esp_vfs_fat_create_contiguous_file", "[fatfs][wear_levelling]")
 {
@@ -295,6 +351,22 @@ TEST_CASE("(WL) multiple tasks can use same volume", "[fatfs][wear_levelling]")
     test_teardown();
 }
 
+TEST_CASE("(WL) multiple tasks can use same volume with file buffers and sector cache", "[fatfs][wear_levelling]")
+{
+    esp_vfs_fat_mount_config_t mount_config = {
+        .format_if_mount_failed = true,
+        .max_files = 5,
+        .file_buffer_size = 4096,
+        .sector_cache_size = 8 * 4096,
+    };
+    TEST_ESP_OK(esp_vfs_fat_spiflash_mount_rw_wl("/spiflash", NULL, &mount_config, &s_test_wl_handle));
+    test_fatfs_concurrent("/spiflash/f");
+    test_fatfs_create_file_with_text("/spiflash/hello.txt", fatfs_test_hello_str);
+    test_fatfs_read_file("/spiflash/hello.txt");
+    test_fatfs_opendir_readdir_rewinddir("/spiflash/dir");
+    TEST_ESP_OK(esp_vfs_fat_spiflash_unmount_rw_wl("/spiflash", s_test_wl_handle));
+}
+
 TEST_CASE("(WL) fatfs does not ignore leading spaces", "[fatfs][wear_levelling]")
 {
     // the functionality of ignoring leading and trailing whitespaces is not implemented yet
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -23,6 +23,8 @@ typedef struct {
     const char* base_path; /*!< Path prefix where FATFS should be registered, */
     const char* fat_drive; /*!< FATFS drive specification; if only one drive is used, can be an empty string. */
     size_t max_files;      /*!< Maximum number of files which can be open at the same time. */
+    size_t file_buffer_size; /*!< Size of the read-ahead and write buffer allocated for each open file, 0 to disable.
+                                  See esp_vfs_fat_mount_config_t::file_buffer_size. */
 } esp_vfs_fat_conf_t;
 
 /**
@@ -111,6 +113,36 @@ typedef struct {
      * may be different.
      */
     bool use_one_fat;
+    /**
+     * Size of the buffer allocated for each open file, in bytes.
+     * Setting this field to 0 disables the buffer.
+     *
+     * Small reads are then served from the buffer, which is filled by reading
+     * this many bytes from the file at once, and small writes are collected in
+     * the buffer until it is full. FATFS transfers these large blocks with
+     * multi-sector disk operations, instead of one sector at a time.
+     * This improves the throughput of sequential access with small read() and
+     * write() calls, at the cost of this much RAM per open file.
+     *
+     * FATFS transfers at most one cluster in a disk operation, so the size should be
+     * the allocation unit size, or a multiple of it.
+     * Data written to the buffer reaches the file system on fsync(), close(),
+     * lseek() or when the buffer is full, so errors such as a full disk may be
+     * reported by these calls rather than by write().
+     */
+    size_t file_buffer_size;
+    /**
+     * Size of the sector cache of the volume, in bytes.
+     * Setting this field to 0 disables the cache.
+     *
+     * The cache keeps the most recently used sectors which FATFS reads or
+     * writes one at a time, such as the FAT and directory sectors, and is
+     * shared by all the open files. This saves disk reads when several files
+     * are accessed in turn, e.g. one task serving files while another one
+     * appends to a log file. The sectors are written to the disk immediately,
+     * so the cache doesn't delay writes, and uses this much RAM per volume.
+     */
+    size_t sector_cache_size;
 } esp_vfs_fat_mount_config_t;
 
 #define VFS_FAT_MOUNT_DEFAULT_CONFIG() \
@@ -120,6 +152,8 @@ typedef struct {
         .allocation_unit_size = 0, \
         .disk_status_check_enable = false, \
         .use_one_fat = false, \
+        .file_buffer_size = 0, \
+        .sector_cache_size = 0, \
     }
 
 // Compatibility definition
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -12,6 +12,7 @@
 #include <sys/errno.h>
 #include <sys/fcntl.h>
 #include <sys/lock.h>
+#include <sys/param.h>
 #include "esp_vfs_fat.h"
 #include "esp_vfs.h"
 #include "esp_log.h"
@@ -35,6 +36,15 @@ struct cached_data{
 #define FILENAME_MAX 255
 #endif
 
+/* Read-ahead and write buffer of an open file */
+typedef struct {
+    uint8_t *data;      /* buffer of file_buffer_size bytes, NULL if the file has no buffer */
+    FSIZE_t start;      /* file offset of data[0] */
+    size_t len;         /* number of valid bytes in data */
+    FSIZE_t pos;        /* file position seen by the application, valid if len > 0 */
+    bool dirty;         /* data has to be written to the file at 'start' */
+} vfs_fat_file_buf_t;
+
 typedef struct {
     char fat_drive[8];  /* FAT drive name */
     char base_path[ESP_VFS_PATH_MAX];   /* base path in VFS where partition is registered */
@@ -44,6 +54,9 @@ typedef struct {
     char tmp_path_buf[FILENAME_MAX+3];  /* temporary buffer used to prepend drive name to the path */
     char tmp_path_buf2[FILENAME_MAX+3]; /* as above; used in functions which take two path arguments */
     uint32_t *flags; /* file descriptor flags, array of max_files size */
+    size_t file_buffer_size;        /* size of the buffer of each open file, 0 if disabled */
+    vfs_fat_file_buf_t *file_bufs;  /* file buffers, array of max_files size, NULL if disabled */
+    _lock_t *file_locks;            /* guards of the file buffers, array of max_files size, NULL if disabled */
 #ifdef CONFIG_VFS_SUPPORT_DIR
     char dir_path[FILENAME_MAX]; /* variable to store path of opened directory*/
     struct cached_data cached_fileinfo;
@@ -182,6 +195,17 @@ static const esp_vfs_fs_ops_t s_vfs_fat = {
 #endif // CONFIG_VFS_SUPPORT_DIR
 };
 
+static void free_file_locks(vfs_fat_ctx_t* fat_ctx)
+{
+    if (fat_ctx->file_locks == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < fat_ctx->max_files; i++) {
+        _lock_close(&fat_ctx->file_locks[i]);
+    }
+    free(fat_ctx->file_locks);
+}
+
 esp_err_t esp_vfs_fat_register_cfg(const esp_vfs_fat_conf_t* conf, FATFS** out_fs)
 {
     size_t ctx = find_context_index_by_path(conf->base_path);
@@ -211,12 +235,34 @@ esp_err_t esp_vfs_fat_register_cfg(const esp_vfs_fat_conf_t* conf, FATFS** out_f
         return ESP_ERR_NO_MEM;
     }
     memset(fat_ctx->flags, 0, max_files * sizeof(*fat_ctx->flags));
+    if (conf->file_buffer_size > 0) {
+        fat_ctx->file_bufs = ff_memalloc(max_files * sizeof(*fat_ctx->file_bufs));
+        if (fat_ctx->file_bufs == NULL) {
+            free(fat_ctx->flags);
+            free(fat_ctx);
+            return ESP_ERR_NO_MEM;
+        }
+        memset(fat_ctx->file_bufs, 0, max_files * sizeof(*fat_ctx->file_bufs));
+        fat_ctx->file_locks = ff_memalloc(max_files * sizeof(*fat_ctx->file_locks));
+        if (fat_ctx->file_locks == NULL) {
+            free(fat_ctx->file_bufs);
+            free(fat_ctx->flags);
+            free(fat_ctx);
+            return ESP_ERR_NO_MEM;
+        }
+        for (size_t i = 0; i < max_files; i++) {
+            _lock_init(&fat_ctx->file_locks[i]);
+        }
+        fat_ctx->file_buffer_size = conf->file_buffer_size;
+    }
     fat_ctx->max_files = max_files;
     strlcpy(fat_ctx->fat_drive, conf->fat_drive, sizeof(fat_ctx->fat_drive) - 1);
     strlcpy(fat_ctx->base_path, conf->base_path, sizeof(fat_ctx->base_path) - 1);
 
     esp_err_t err = esp_vfs_register_fs(conf->base_path, &s_vfs_fat, ESP_VFS_FLAG_CONTEXT_PTR | ESP_VFS_FLAG_STATIC, fat_ctx);
     if (err != ESP_OK) {
+        free_file_locks(fat_ctx);
+        free(fat_ctx->file_bufs);
         free(fat_ctx->flags);
         free(fat_ctx);
         return err;
@@ -245,6 +291,8 @@ esp_err_t esp_vfs_fat_unregister_path(const char* base_path)
         return err;
     }
     _lock_close(&fat_ctx->lock);
+    free_file_locks(fat_ctx);
+    free(fat_ctx->file_bufs);
     free(fat_ctx->flags);
     free(fat_ctx);
     s_fat_ctxs[ctx] = NULL;
@@ -350,6 +398,100 @@ static int fresult_to_errno(FRESULT fr)
 static void file_cleanup(vfs_fat_ctx_t* ctx, int fd)
 {
     memset(&ctx->files[fd], 0, sizeof(FIL));
+    if (ctx->file_bufs) {
+        ff_memfree(ctx->file_bufs[fd].data);
+        memset(&ctx->file_bufs[fd], 0, sizeof(vfs_fat_file_buf_t));
+    }
+}
+
+static inline vfs_fat_file_buf_t* file_buf(vfs_fat_ctx_t* ctx, int fd)
+{
+    if (ctx->file_bufs == NULL || ctx->file_bufs[fd].data == NULL) {
+        return NULL;
+    }
+    return &ctx->file_bufs[fd];
+}
+
+/*
+ * A read of a buffered file only takes the lock of the file: it is served from the file
+ * buffer, or by FATFS which serializes its accesses to the volume by itself. The other
+ * operations on an open file take ctx->lock, then the lock of the file.
+ */
+static inline void file_lock(vfs_fat_ctx_t* ctx, int fd)
+{
+    if (ctx->file_locks != NULL) {
+        _lock_acquire(&ctx->file_locks[fd]);
+    }
+}
+
+static inline void file_unlock(vfs_fat_ctx_t* ctx, int fd)
+{
+    if (ctx->file_locks != NULL) {
+        _lock_release(&ctx->file_locks[fd]);
+    }
+}
+
+/**
+ * @brief Write the pending data of the file buffer, or move the FATFS file
+ *        position to the position seen by the application, and empty the buffer
+ * @note Call this function with the lock of the file acquired.
+ * @return 0 on success, -1 with errno set on failure
+ */
+static int file_buf_flush(vfs_fat_ctx_t* ctx, int fd)
+{
+    vfs_fat_file_buf_t* fb = file_buf(ctx, fd);
+    if (fb == NULL || fb->len == 0) {
+        return 0;
+    }
+    FIL* file = &ctx->files[fd];
+    FRESULT res = FR_OK;
+    int rc = 0;
+    if (fb->dirty) {
+        // FATFS file position is at fb->start
+        unsigned written = 0;
+        res = f_write(file, fb->data, fb->len, &written);
+        if (res == FR_OK && written != fb->len) {
+            errno = ENOSPC;
+            rc = -1;
+        }
+    } else if (f_tell(file) != fb->pos) {
+        // FATFS file position is at the end of the buffered data
+        res = f_lseek(file, fb->pos);
+    }
+    if (res != FR_OK) {
+        ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
+        errno = fresult_to_errno(res);
+        rc = -1;
+    }
+    fb->len = 0;
+    fb->dirty = false;
+    return rc;
+}
+
+static FSIZE_t file_tell(vfs_fat_ctx_t* ctx, int fd)
+{
+    vfs_fat_file_buf_t* fb = file_buf(ctx, fd);
+    if (fb != NULL && fb->len > 0) {
+        return fb->pos;
+    }
+    return f_tell(&ctx->files[fd]);
+}
+
+static FSIZE_t file_size(vfs_fat_ctx_t* ctx, int fd)
+{
+    vfs_fat_file_buf_t* fb = file_buf(ctx, fd);
+    FSIZE_t size = f_size(&ctx->files[fd]);
+    if (fb != NULL && fb->dirty && fb->start + fb->len > size) {
+        return fb->start + fb->len;
+    }
+    return size;
+}
+
+/* Number of bytes the buffer takes when it starts at 'start', so that the following
+   transfers start at a multiple of the buffer size and cover whole sectors */
+static inline size_t file_buf_capacity(vfs_fat_ctx_t* ctx, FSIZE_t start)
+{
+    return ctx->file_buffer_size - (size_t)(start % ctx->file_buffer_size);
 }
 
 /**
@@ -427,6 +569,21 @@ static int vfs_fat_open(void* ctx, const char * path, int flags, int mode)
     }
 #endif
 
+    if (fat_ctx->file_bufs) {
+        fat_ctx->file_bufs[fd].data = ff_memalloc(fat_ctx->file_buffer_size);
+        if (fat_ctx->file_bufs[fd].data == NULL) {
+#ifdef CONFIG_FATFS_USE_FASTSEEK
+            ff_memfree(fat_ctx->files[fd].cltbl);
+#endif
+            f_close(&fat_ctx->files[fd]);
+            file_cleanup(fat_ctx, fd);
+            _lock_release(&fat_ctx->lock);
+            ESP_LOGE(TAG, "open: Failed to allocate the file buffer");
+            errno = ENOMEM;
+            return -1;
+        }
+    }
+
     // O_APPEND need to be stored because it is not compatible with FA_OPEN_APPEND:
     //  - FA_OPEN_APPEND means to jump to the end of file only after open()
     //  - O_APPEND means to jump to the end only before each write()
@@ -438,17 +595,15 @@ static int vfs_fat_open(void* ctx, const char * path, int flags, int mode)
     return fd;
 }
 
-static ssize_t vfs_fat_write(void* ctx, int fd, const void * data, size_t size)
+/* Write directly to FATFS, call with ctx->lock acquired */
+static ssize_t file_write(vfs_fat_ctx_t* fat_ctx, int fd, const void * data, size_t size)
 {
-    vfs_fat_ctx_t* fat_ctx = (vfs_fat_ctx_t*) ctx;
     FIL* file = &fat_ctx->files[fd];
     FRESULT res;
-    _lock_acquire(&fat_ctx->lock);
     if (fat_ctx->flags[fd] & O_APPEND) {
         if ((res = f_lseek(file, f_size(file))) != FR_OK) {
             ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
             errno = fresult_to_errno(res);
-            _lock_release(&fat_ctx->lock);
             return -1;
         }
     }
@@ -456,14 +611,12 @@ static ssize_t vfs_fat_write(void* ctx, int fd, const void * data, size_t size)
     res = f_write(file, data, size, &written);
     if (((written == 0) && (size != 0)) && (res == 0)) {
         errno = ENOSPC;
-        _lock_release(&fat_ctx->lock);
         return -1;
     }
     if (res != FR_OK) {
         ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
         errno = fresult_to_errno(res);
         if (written == 0) {
-            _lock_release(&fat_ctx->lock);
             return -1;
         }
     }
@@ -474,19 +627,148 @@ static ssize_t vfs_fat_write(void* ctx, int fd, const void * data, size_t size)
         if (res != FR_OK) {
             ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
             errno = fresult_to_errno(res);
-            _lock_release(&fat_ctx->lock);
             return -1;
         }
      }
 #endif
-    _lock_release(&fat_ctx->lock);
     return written;
 }
 
+/* Write through the file buffer, call with ctx->lock and the lock of the file acquired */
+static ssize_t file_buf_write(vfs_fat_ctx_t* fat_ctx, int fd, const void * data, size_t size)
+{
+    vfs_fat_file_buf_t* fb = file_buf(fat_ctx, fd);
+    if (!fb->dirty || ((fat_ctx->flags[fd] & O_APPEND) && fb->pos != file_size(fat_ctx, fd))) {
+        // Drop the read-ahead data, or write the pending data if it doesn't end the file in O_APPEND mode
+        if (file_buf_flush(fat_ctx, fd) != 0) {
+            return -1;
+        }
+    }
+#if !CONFIG_FATFS_IMMEDIATE_FSYNC
+    if (fb->dirty && fb->len + size > file_buf_capacity(fat_ctx, fb->start)) {
+        if (file_buf_flush(fat_ctx, fd) != 0) {
+            return -1;
+        }
+    }
+    if (size < fat_ctx->file_buffer_size) {
+        size_t written = 0;
+        if (!fb->dirty) {
+            FIL* file = &fat_ctx->files[fd];
+            if (fat_ctx->flags[fd] & O_APPEND) {
+                FRESULT res = f_lseek(file, f_size(file));
+                if (res != FR_OK) {
+                    ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
+                    errno = fresult_to_errno(res);
+                    return -1;
+                }
+            }
+            FSIZE_t start = f_tell(file);
+            size_t capacity = file_buf_capacity(fat_ctx, start);
+            if (size > capacity) {
+                // Write the data up to the next multiple of the buffer size directly, then buffer the rest
+                ssize_t ret = file_write(fat_ctx, fd, data, capacity);
+                if (ret < 0 || (size_t) ret != capacity) {
+                    return ret;
+                }
+                written = capacity;
+                data = (const uint8_t *) data + capacity;
+                size -= capacity;
+                start += capacity;
+            }
+            fb->start = start;
+        }
+        memcpy(fb->data + fb->len, data, size);
+        fb->len += size;
+        fb->pos = fb->start + fb->len;
+        fb->dirty = fb->len > 0;
+        return written + size;
+    }
+#endif // !CONFIG_FATFS_IMMEDIATE_FSYNC
+    // Large writes go directly to FATFS, which writes the whole sectors in one disk_write
+    if (file_buf_flush(fat_ctx, fd) != 0) {
+        return -1;
+    }
+    return file_write(fat_ctx, fd, data, size);
+}
+
+static ssize_t vfs_fat_write(void* ctx, int fd, const void * data, size_t size)
+{
+    vfs_fat_ctx_t* fat_ctx = (vfs_fat_ctx_t*) ctx;
+    ssize_t ret;
+    _lock_acquire(&fat_ctx->lock);
+    file_lock(fat_ctx, fd);
+    if (file_buf(fat_ctx, fd) != NULL) {
+        ret = file_buf_write(fat_ctx, fd, data, size);
+    } else {
+        ret = file_write(fat_ctx, fd, data, size);
+    }
+    file_unlock(fat_ctx, fd);
+    _lock_release(&fat_ctx->lock);
+    return ret;
+}
+
+/* Read through the file buffer, call with the lock of the file acquired */
+static ssize_t file_buf_read(vfs_fat_ctx_t* fat_ctx, int fd, uint8_t * dst, size_t size)
+{
+    vfs_fat_file_buf_t* fb = file_buf(fat_ctx, fd);
+    FIL* file = &fat_ctx->files[fd];
+    size_t done = 0;
+    if (fb->dirty && file_buf_flush(fat_ctx, fd) != 0) {
+        return -1;
+    }
+    while (done < size) {
+        if (fb->len > 0 && fb->pos >= fb->start && fb->pos < fb->start + fb->len) {
+            size_t offset = (size_t)(fb->pos - fb->start);
+            size_t chunk = MIN(fb->len - offset, size - done);
+            memcpy(dst + done, fb->data + offset, chunk);
+            fb->pos += chunk;
+            done += chunk;
+            continue;
+        }
+        // The buffered data is used up, continue reading from the current position
+        if (file_buf_flush(fat_ctx, fd) != 0) {
+            return done > 0 ? done : -1;
+        }
+        FRESULT res;
+        unsigned read = 0;
+        if (size - done >= fat_ctx->file_buffer_size) {
+            // Large reads go directly to the destination, FATFS reads the whole sectors in one disk_read
+            res = f_read(file, dst + done, size - done, &read);
+            done += read;
+            if (res != FR_OK) {
+                ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
+                errno = fresult_to_errno(res);
+                return done > 0 ? done : -1;
+            }
+            break;
+        }
+        FSIZE_t start = f_tell(file);
+        res = f_read(file, fb->data, file_buf_capacity(fat_ctx, start), &read);
+        if (res != FR_OK) {
+            ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
+            errno = fresult_to_errno(res);
+            return done > 0 ? done : -1;
+        }
+        if (read == 0) {
+            break; // end of file
+        }
+        fb->start = start;
+        fb->len = read;
+        fb->pos = start;
+    }
+    return done;
+}
+
 static ssize_t vfs_fat_read(void* ctx, int fd, void * dst, size_t size)
 {
     vfs_fat_ctx_t* fat_ctx = (vfs_fat_ctx_t*) ctx;
     FIL* file = &fat_ctx->files[fd];
+    if (file_buf(fat_ctx, fd) != NULL) {
+        file_lock(fat_ctx, fd);
+        ssize_t ret = file_buf_read(fat_ctx, fd, (uint8_t *) dst, size);
+        file_unlock(fat_ctx, fd);
+        return ret;
+    }
     unsigned read = 0;
     FRESULT res = f_read(file, dst, size, &read);
     if (res != FR_OK) {
@@ -504,7 +786,11 @@ static ssize_t vfs_fat_pread(void *ctx, int fd, void *dst, size_t size, off_t of
     ssize_t ret = -1;
     vfs_fat_ctx_t *fat_ctx = (vfs_fat_ctx_t *) ctx;
     _lock_acquire(&fat_ctx->lock);
+    file_lock(fat_ctx, fd);
     FIL *file = &fat_ctx->files[fd];
+    if (file_buf_flush(fat_ctx, fd) != 0) {
+        goto pread_release;
+    }
     const off_t prev_pos = f_tell(file);
 
     FRESULT f_res = f_lseek(file, offset);
@@ -535,6 +821,7 @@ static ssize_t vfs_fat_pread(void *ctx, int fd, void *dst, size_t size, off_t of
     }
 
 pread_release:
+    file_unlock(fat_ctx, fd);
     _lock_release(&fat_ctx->lock);
     return ret;
 }
@@ -544,7 +831,11 @@ static ssize_t vfs_fat_pwrite(void *ctx, int fd, const void *src, size_t size, o
     ssize_t ret = -1;
     vfs_fat_ctx_t *fat_ctx = (vfs_fat_ctx_t *) ctx;
     _lock_acquire(&fat_ctx->lock);
+    file_lock(fat_ctx, fd);
     FIL *file = &fat_ctx->files[fd];
+    if (file_buf_flush(fat_ctx, fd) != 0) {
+        goto pwrite_release;
+    }
     const off_t prev_pos = f_tell(file);
 
     FRESULT f_res = f_lseek(file, offset);
@@ -591,6 +882,7 @@ static ssize_t vfs_fat_pwrite(void *ctx, int fd, const void *src, size_t size, o
 #endif
 
 pwrite_release:
+    file_unlock(fat_ctx, fd);
     _lock_release(&fat_ctx->lock);
     return ret;
 }
@@ -599,8 +891,12 @@ static int vfs_fat_fsync(void* ctx, int fd)
 {
     vfs_fat_ctx_t* fat_ctx = (vfs_fat_ctx_t*) ctx;
     FIL* file = &fat_ctx->files[fd];
+    _lock_acquire(&fat_ctx->lock);
+    file_lock(fat_ctx, fd);
+    int rc = file_buf_flush(fat_ctx, fd);
     FRESULT res = f_sync(file);
-    int rc = 0;
+    file_unlock(fat_ctx, fd);
+    _lock_release(&fat_ctx->lock);
     if (res != FR_OK) {
         ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
         errno = fresult_to_errno(res);
@@ -613,6 +909,7 @@ static int vfs_fat_close(void* ctx, int fd)
 {
     vfs_fat_ctx_t* fat_ctx = (vfs_fat_ctx_t*) ctx;
     _lock_acquire(&fat_ctx->lock);
+    file_lock(fat_ctx, fd);
     FIL* file = &fat_ctx->files[fd];
 
 #ifdef CONFIG_FATFS_USE_FASTSEEK
@@ -620,10 +917,11 @@ static int vfs_fat_close(void* ctx, int fd)
     file->cltbl = NULL;
 #endif
 
+    int rc = file_buf_flush(fat_ctx, fd);
     FRESULT res = f_close(file);
     file_cleanup(fat_ctx, fd);
+    file_unlock(fat_ctx, fd);
     _lock_release(&fat_ctx->lock);
-    int rc = 0;
     if (res != FR_OK) {
         ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
         errno = fresult_to_errno(res);
@@ -637,25 +935,46 @@ static off_t vfs_fat_lseek(void* ctx, int fd, off_t offset, int mode)
     vfs_fat_ctx_t* fat_ctx = (vfs_fat_ctx_t*) ctx;
     FIL* file = &fat_ctx->files[fd];
     off_t new_pos;
+    _lock_acquire(&fat_ctx->lock);
+    file_lock(fat_ctx, fd);
     if (mode == SEEK_SET) {
         new_pos = offset;
     } else if (mode == SEEK_CUR) {
-        off_t cur_pos = f_tell(file);
+        off_t cur_pos = file_tell(fat_ctx, fd);
         new_pos = cur_pos + offset;
     } else if (mode == SEEK_END) {
-        off_t size = f_size(file);
+        off_t size = file_size(fat_ctx, fd);
         new_pos = size + offset;
     } else {
+        file_unlock(fat_ctx, fd);
+        _lock_release(&fat_ctx->lock);
         errno = EINVAL;
         return -1;
     }
 
+    vfs_fat_file_buf_t* fb = file_buf(fat_ctx, fd);
+    if (fb != NULL && fb->len > 0 && !fb->dirty && new_pos >= 0
+            && (FSIZE_t) new_pos >= fb->start && (FSIZE_t) new_pos <= fb->start + fb->len) {
+        // Seek within the read-ahead data
+        fb->pos = new_pos;
+        file_unlock(fat_ctx, fd);
+        _lock_release(&fat_ctx->lock);
+        return new_pos;
+    }
+    if (file_buf_flush(fat_ctx, fd) != 0) {
+        file_unlock(fat_ctx, fd);
+        _lock_release(&fat_ctx->lock);
+        return -1;
+    }
+
 #if FF_FS_EXFAT
     ESP_LOGD(TAG, "%s: offset=%ld, filesize:=%" PRIu64, __func__, new_pos, f_size(file));
 #else
     ESP_LOGD(TAG, "%s: offset=%ld, filesize:=%" PRIu32, __func__, new_pos, f_size(file));
 #endif
     FRESULT res = f_lseek(file, new_pos);
+    file_unlock(fat_ctx, fd);
+    _lock_release(&fat_ctx->lock);
     if (res != FR_OK) {
         ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
         errno = fresult_to_errno(res);
@@ -667,9 +986,12 @@ static off_t vfs_fat_lseek(void* ctx, int fd, off_t offset, int mode)
 static int vfs_fat_fstat(void* ctx, int fd, struct stat * st)
 {
     vfs_fat_ctx_t* fat_ctx = (vfs_fat_ctx_t*) ctx;
-    FIL* file = &fat_ctx->files[fd];
     memset(st, 0, sizeof(*st));
-    st->st_size = f_size(file);
+    _lock_acquire(&fat_ctx->lock);
+    file_lock(fat_ctx, fd);
+    st->st_size = file_size(fat_ctx, fd);
+    file_unlock(fat_ctx, fd);
+    _lock_release(&fat_ctx->lock);
     st->st_mode = S_IRWXU | S_IRWXG | S_IRWXO | S_IFREG;
     st->st_mtime = 0;
     st->st_atime = 0;
@@ -1263,6 +1585,7 @@ static int vfs_fat_ftruncate(void* ctx, int fd, off_t length)
     }
 
     _lock_acquire(&fat_ctx->lock);
+    file_lock(fat_ctx, fd);
     file = &fat_ctx->files[fd];
     if (file == NULL) {
         ESP_LOGD(TAG, "ftruncate NULL file pointer");
@@ -1271,6 +1594,11 @@ static int vfs_fat_ftruncate(void* ctx, int fd, off_t length)
         goto out;
     }
 
+    if (file_buf_flush(fat_ctx, fd) != 0) {
+        ret = -1;
+        goto out;
+    }
+
     FSIZE_t seek_ptr_pos = (FSIZE_t) f_tell(file); // current seek pointer position
     FSIZE_t sz = (FSIZE_t) f_size(file); // current file size (end of file position)
 
@@ -1327,6 +1655,7 @@ static int vfs_fat_ftruncate(void* ctx, int fd, off_t length)
 #endif
 
 out:
+    file_unlock(fat_ctx, fd);
     _lock_release(&fat_ctx->lock);
     return ret;
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -164,12 +164,19 @@ static esp_err_t mount_to_vfs_fat(const esp_vfs_fat_mount_config_t *mount_config
     ff_sdmmc_set_disk_status_check(pdrv, mount_config->disk_status_check_enable);
     ESP_LOGD(TAG, "using pdrv=%i", pdrv);
     char drv[3] = {(char)('0' + pdrv), ':', 0};
+    err = ff_diskio_set_cache(pdrv, mount_config->sector_cache_size);
+    if (err != ESP_OK) {
+        ESP_LOGD(TAG, "ff_diskio_set_cache failed 0x(%x)", err);
+        ff_diskio_unregister(pdrv);
+        return err;
+    }
 
     // connect FATFS to VFS
     esp_vfs_fat_conf_t conf = {
         .base_path = base_path,
         .fat_drive = drv,
         .max_files = mount_config->max_files,
+        .file_buffer_size = mount_config->file_buffer_size,
     };
     err = esp_vfs_fat_register_cfg(&conf, &fs);
     *out_fs = fs;
@@ -3322,7 +3322,10 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * to prvNotifyQueueSetContainer is preceded by a check that
          * pxQueueSetContainer != NULL */
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+        /* ESP-IDF additions: the multi waits created by xMultiWaitCreate() are
+         * queue sets without items, which are already full when signalled. */
+        configASSERT( ( pxQueueSetContainer->uxItemSize == ( UBaseType_t ) 0 ) ||
+                      ( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength ) );
 
         if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
         {
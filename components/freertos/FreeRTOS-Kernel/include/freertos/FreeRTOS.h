@@ -1330,6 +1330,9 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if CONFIG_FREERTOS_TASK_STATS
+        void * pvDummyTaskStats;
+    #endif
 } StaticTask_t;
 
 /*
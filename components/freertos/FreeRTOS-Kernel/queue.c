@@ -3359,7 +3359,10 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * to prvNotifyQueueSetContainer is preceded by a check that
          * pxQueueSetContainer != NULL */
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+        /* ESP-IDF additions: the multi waits created by xMultiWaitCreate() are
+         * queue sets without items, which are already full when signalled. */
+        configASSERT( ( pxQueueSetContainer->uxItemSize == ( UBaseType_t ) 0 ) ||
+                      ( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength ) );
 
         /* In SMP, queue sets have their own xQueueLock. Thus we need to also
          * acquire the queue set's xQueueLock before accessing it. */
@@ -484,6 +484,10 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if CONFIG_FREERTOS_TASK_STATS
+        void * pvTaskStats; /*< Statistics block of the task, NULL if the task has none. See freertos_tasks_c_additions.h */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -808,6 +812,19 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Maintain the statistics block of a task. Defined in freertos_tasks_c_additions.h
+ * and called with xKernelLock taken.
+ */
+#if CONFIG_FREERTOS_TASK_STATS
+
+    static void prvTaskStatsAdd( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvTaskStatsRemove( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvTaskStatsSwitchedOut( TCB_t * pxTCB,
+                                         BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+#endif /* CONFIG_FREERTOS_TASK_STATS */
+
 /*-----------------------------------------------------------*/
 
 #if ( configNUMBER_OF_CORES > 1 )
@@ -1238,6 +1255,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         uxCurrentNumberOfTasks++;
 
+        #if CONFIG_FREERTOS_TASK_STATS
+        {
+            prvTaskStatsAdd( pxNewTCB );
+        }
+        #endif /* CONFIG_FREERTOS_TASK_STATS */
+
         if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
         {
             /* This is the first task to be created so do the preliminary
@@ -1380,6 +1403,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * not return. */
             uxTaskNumber++;
 
+            #if CONFIG_FREERTOS_TASK_STATS
+            {
+                /* The task is no longer reported, even if it is still running
+                 * until the next context switch. */
+                prvTaskStatsRemove( pxTCB );
+            }
+            #endif /* CONFIG_FREERTOS_TASK_STATS */
+
             /* Check if the task is deleting itself, or is currently running on
              * the other core. */
             if( taskIS_CURRENTLY_RUNNING_ON_CORE( pxTCB, xCurCoreID ) == pdTRUE )
@@ -3716,11 +3747,25 @@ void vTaskSwitchContext( void )
             }
             #endif
 
+            #if CONFIG_FREERTOS_TASK_STATS
+                TCB_t * pxPreviousTCB = pxCurrentTCBs[ xCurCoreID ];
+            #endif
+
             /* Select a new task to run using either the generic C or port
              * optimised asm code. */
             taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
             traceTASK_SWITCHED_IN();
 
+            #if CONFIG_FREERTOS_TASK_STATS
+            {
+                /* The run time counter of the previous task was updated above */
+                if( pxCurrentTCBs[ xCurCoreID ] != pxPreviousTCB )
+                {
+                    prvTaskStatsSwitchedOut( pxPreviousTCB, xCurCoreID );
+                }
+            }
+            #endif /* CONFIG_FREERTOS_TASK_STATS */
+
             /* After the new task is switched in, update the global errno. */
             #if ( configUSE_POSIX_ERRNO == 1 )
             {
@@ -775,6 +775,156 @@ uint8_t * pxTaskGetStackStart( TaskHandle_t xTask )
 #endif /* ( INCLUDE_vTaskPrioritySet == 1 ) */
 /*----------------------------------------------------------*/
 
+/* ------------------------------------------------- Task Statistics ------------------------------------------------ */
+
+#if CONFIG_FREERTOS_TASK_STATS
+
+/*
+ * Statistics blocks are allocated statically so that they can be read after the
+ * task is deleted and its TCB freed. Each block is written with xKernelLock
+ * taken and read without any lock: ulSeq is odd while the block is being
+ * written, and changes each time it is written (seqlock).
+ */
+    typedef struct
+    {
+        uint32_t ulSeq;
+        TaskStats_t xStats; /* xStats.xHandle is NULL if the block is free */
+    } TaskStatsBlock_t;
+
+    static TaskStatsBlock_t xTaskStatsBlocks[ CONFIG_FREERTOS_TASK_STATS_MAX_TASKS ];
+
+    static inline void prvTaskStatsWriteBegin( TaskStatsBlock_t * pxBlock )
+    {
+        __atomic_store_n( &pxBlock->ulSeq, pxBlock->ulSeq + 1, __ATOMIC_RELAXED );
+        __atomic_thread_fence( __ATOMIC_RELEASE );
+    }
+
+    static inline void prvTaskStatsWriteEnd( TaskStatsBlock_t * pxBlock )
+    {
+        __atomic_store_n( &pxBlock->ulSeq, pxBlock->ulSeq + 1, __ATOMIC_RELEASE );
+    }
+
+    static inline uint32_t prvTaskStatsFreeStack( const TCB_t * pxTCB )
+    {
+        /* The stack grows down on all the supported ports. pxTopOfStack is the
+         * stack pointer saved when the task was last switched out. */
+        return ( uint32_t ) ( ( const uint8_t * ) pxTCB->pxTopOfStack - ( const uint8_t * ) pxTCB->pxStack );
+    }
+
+    static void prvTaskStatsAdd( TCB_t * pxTCB )
+    {
+        pxTCB->pvTaskStats = NULL;
+
+        for( UBaseType_t x = 0; x < CONFIG_FREERTOS_TASK_STATS_MAX_TASKS; x++ )
+        {
+            TaskStatsBlock_t * pxBlock = &xTaskStatsBlocks[ x ];
+
+            if( pxBlock->xStats.xHandle == NULL )
+            {
+                prvTaskStatsWriteBegin( pxBlock );
+                pxBlock->xStats.xHandle = ( TaskHandle_t ) pxTCB;
+                memcpy( pxBlock->xStats.pcTaskName, pxTCB->pcTaskName, configMAX_TASK_NAME_LEN );
+                pxBlock->xStats.uxCurrentPriority = pxTCB->uxPriority;
+                pxBlock->xStats.ulRunTimeCounter = 0;
+                pxBlock->xStats.ulContextSwitches = 0;
+                pxBlock->xStats.ulMinFreeStackSize = prvTaskStatsFreeStack( pxTCB );
+                pxBlock->xStats.xCoreID = tskNO_AFFINITY;
+                prvTaskStatsWriteEnd( pxBlock );
+                pxTCB->pvTaskStats = pxBlock;
+                break;
+            }
+        }
+    }
+/*----------------------------------------------------------*/
+
+    static void prvTaskStatsRemove( TCB_t * pxTCB )
+    {
+        TaskStatsBlock_t * pxBlock = ( TaskStatsBlock_t * ) pxTCB->pvTaskStats;
+
+        if( pxBlock != NULL )
+        {
+            prvTaskStatsWriteBegin( pxBlock );
+            pxBlock->xStats.xHandle = NULL;
+            prvTaskStatsWriteEnd( pxBlock );
+            pxTCB->pvTaskStats = NULL;
+        }
+    }
+/*----------------------------------------------------------*/
+
+    static void prvTaskStatsSwitchedOut( TCB_t * pxTCB,
+                                         BaseType_t xCoreID )
+    {
+        TaskStatsBlock_t * pxBlock = ( TaskStatsBlock_t * ) pxTCB->pvTaskStats;
+
+        if( pxBlock != NULL )
+        {
+            uint32_t ulFreeStack = prvTaskStatsFreeStack( pxTCB );
+
+            prvTaskStatsWriteBegin( pxBlock );
+            pxBlock->xStats.uxCurrentPriority = pxTCB->uxPriority;
+            pxBlock->xStats.ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+            pxBlock->xStats.ulContextSwitches++;
+
+            if( ulFreeStack < pxBlock->xStats.ulMinFreeStackSize )
+            {
+                pxBlock->xStats.ulMinFreeStackSize = ulFreeStack;
+            }
+
+            pxBlock->xStats.xCoreID = xCoreID;
+            prvTaskStatsWriteEnd( pxBlock );
+        }
+    }
+/*----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetStats( TaskStats_t * const pxTaskStatsArray,
+                                const UBaseType_t uxArraySize,
+                                configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {
+        UBaseType_t uxCount = 0;
+
+        configASSERT( ( pxTaskStatsArray != NULL ) || ( uxArraySize == 0 ) );
+
+        for( UBaseType_t x = 0; ( x < CONFIG_FREERTOS_TASK_STATS_MAX_TASKS ) && ( uxCount < uxArraySize ); x++ )
+        {
+            TaskStatsBlock_t * pxBlock = &xTaskStatsBlocks[ x ];
+            uint32_t ulSeq;
+
+            /* Copy the block until it was not written meanwhile. The writers
+             * only hold the block for a few instructions. */
+            do
+            {
+                ulSeq = __atomic_load_n( &pxBlock->ulSeq, __ATOMIC_ACQUIRE );
+
+                if( ( ulSeq & 1U ) != 0U )
+                {
+                    continue;
+                }
+
+                memcpy( &pxTaskStatsArray[ uxCount ], ( const void * ) &pxBlock->xStats, sizeof( TaskStats_t ) );
+                __atomic_thread_fence( __ATOMIC_ACQUIRE );
+            } while( ( ( ulSeq & 1U ) != 0U ) || ( __atomic_load_n( &pxBlock->ulSeq, __ATOMIC_RELAXED ) != ulSeq ) );
+
+            if( pxTaskStatsArray[ uxCount ].xHandle != NULL )
+            {
+                uxCount++;
+            }
+        }
+
+        if( pulTotalRunTime != NULL )
+        {
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+            #else
+                *pulTotalRunTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+        }
+
+        return uxCount;
+    }
+
+#endif /* CONFIG_FREERTOS_TASK_STATS */
+/*----------------------------------------------------------*/
+
 /* --------------------------------------------- TLSP Deletion Callbacks -------------------------------------------- */
 
 #if CONFIG_FREERTOS_TLSP_DELETION_CALLBACKS
@@ -423,3 +423,17 @@ err:
 
 #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 /*----------------------------------------------------------*/
+
+/* ------------------------------------------------------ Multi Wait ------------------------------------------------ */
+
+#if ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    MultiWaitHandle_t xMultiWaitCreate( void )
+    {
+        /* A queue set of a single item of size 0: the members receiving data only set its count to 1, the kernel
+         * skips the notification when it is already set. */
+        return ( MultiWaitHandle_t ) xQueueGenericCreate( 1, 0, queueQUEUE_TYPE_SET );
+    }
+
+#endif /* ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*----------------------------------------------------------*/
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -189,6 +189,50 @@ BaseType_t xTaskGetCoreID( TaskHandle_t xTask );
 
 #endif /* ( !CONFIG_FREERTOS_SMP && ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 
+#if CONFIG_FREERTOS_TASK_STATS
+
+/**
+ * @brief Statistics of a task, as returned by uxTaskGetStats()
+ */
+    typedef struct
+    {
+        TaskHandle_t xHandle;                         /**< Handle of the task. Only valid while the task exists */
+        char pcTaskName[ configMAX_TASK_NAME_LEN ];   /**< Name of the task */
+        UBaseType_t uxCurrentPriority;                /**< Priority of the task when it was last switched out */
+        configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /**< Run time of the task, up to the last time it was switched out */
+        uint32_t ulContextSwitches;                   /**< Number of times the task was switched out */
+        uint32_t ulMinFreeStackSize;                  /**< Lowest free stack space seen when the task was switched out, in bytes */
+        BaseType_t xCoreID;                           /**< Core the task last ran on, tskNO_AFFINITY if it has not been switched out yet */
+    } TaskStats_t;
+
+/**
+ * @brief Get the statistics of all the tasks without stopping the scheduler
+ *
+ * The scheduler updates the statistics block of a task each time the task is
+ * switched out. This function copies the blocks without suspending the
+ * scheduler or entering a critical section, each block being copied
+ * consistently. Unlike uxTaskGetSystemState(), it can thus be called
+ * periodically without delaying the other tasks.
+ *
+ * @note The statistics of a task which is running do not include its current
+ * time slice.
+ * @note ulMinFreeStackSize is sampled at context switches, so it can be larger
+ * than the high water mark returned by uxTaskGetStackHighWaterMark().
+ * @note Only CONFIG_FREERTOS_TASK_STATS_MAX_TASKS tasks have statistics. The
+ * tasks created when all the blocks are in use are not reported.
+ *
+ * @param pxTaskStatsArray Array to fill with the statistics of the tasks
+ * @param uxArraySize Number of elements of the array
+ * @param pulTotalRunTime If not NULL, set to the total run time since the
+ * scheduler started, see uxTaskGetSystemState()
+ * @return Number of tasks whose statistics were copied
+ */
+    UBaseType_t uxTaskGetStats( TaskStats_t * const pxTaskStatsArray,
+                                const UBaseType_t uxArraySize,
+                                configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime );
+
+#endif /* CONFIG_FREERTOS_TASK_STATS */
+
 /**
  * Returns the start of the stack associated with xTask.
  *
@@ -246,6 +290,99 @@ uint8_t * pxTaskGetStackStart( TaskHandle_t xTask );
 
 #endif /* CONFIG_FREERTOS_TLSP_DELETION_CALLBACKS */
 
+/* ---------------------------------------------------- Multi Wait ----------------------------------------------------
+ * A multi wait lets a task block until any of several queues, semaphores or ring buffers receives data, or until it is
+ * signalled. It is a queue set without items: a member receiving data only marks the multi wait as signalled if it
+ * isn't already, instead of sending its handle to the set for each item.
+ * ------------------------------------------------------------------------------------------------------------------ */
+
+/**
+ * Type of multi wait handle. A multi wait is a queue set, members are added
+ * with the queue set functions such as xQueueAddToSet() or
+ * xRingbufferAddToQueueSetRead().
+ */
+typedef QueueSetHandle_t MultiWaitHandle_t;
+
+#if ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+/**
+ * @brief Creates a multi wait
+ *
+ * Queues, semaphores (except mutexes) and ring buffers are added to the multi
+ * wait with xQueueAddToSet() or xRingbufferAddToQueueSetRead(), and removed
+ * with xQueueRemoveFromSet() or xRingbufferRemoveFromQueueSetRead(). As for
+ * queue sets, a member must be empty when it is added or removed, and can only
+ * belong to one queue set or multi wait.
+ *
+ * Stream buffers and event groups can't be members. The code sending to them
+ * or setting their bits can call xMultiWaitSignal() instead.
+ *
+ * @note The multi wait doesn't tell which members received data. After
+ * xMultiWaitWait() returns, the task must read each member without blocking
+ * until it is empty, as data received while it reads the members signals the
+ * multi wait again.
+ *
+ * @return Handle of the multi wait, NULL if out of memory.
+ */
+    MultiWaitHandle_t xMultiWaitCreate( void );
+
+/**
+ * @brief Deletes a multi wait
+ *
+ * All members must be removed before the multi wait is deleted.
+ *
+ * @param xMultiWait Handle of the multi wait
+ */
+    static inline void vMultiWaitDelete( MultiWaitHandle_t xMultiWait )
+    {
+        vQueueDelete( ( QueueHandle_t ) xMultiWait );
+    }
+
+/**
+ * @brief Waits until the multi wait is signalled
+ *
+ * A multi wait is signalled when one of its members receives data, or when
+ * xMultiWaitSignal() is called. Returning clears the signal.
+ *
+ * @param xMultiWait Handle of the multi wait
+ * @param xTicksToWait Maximum time to wait, in ticks
+ * @return pdTRUE if the multi wait was signalled, pdFALSE on timeout.
+ */
+    static inline BaseType_t xMultiWaitWait( MultiWaitHandle_t xMultiWait,
+                                             TickType_t xTicksToWait )
+    {
+        return xQueueReceive( ( QueueHandle_t ) xMultiWait, NULL, xTicksToWait );
+    }
+
+/**
+ * @brief Signals a multi wait
+ *
+ * Wakes up the task waiting on the multi wait, or makes its next call to
+ * xMultiWaitWait() return immediately. Signalling an already signalled multi
+ * wait has no effect.
+ *
+ * @param xMultiWait Handle of the multi wait
+ */
+    static inline void vMultiWaitSignal( MultiWaitHandle_t xMultiWait )
+    {
+        ( void ) xQueueGenericSend( ( QueueHandle_t ) xMultiWait, NULL, 0, queueSEND_TO_BACK );
+    }
+
+/**
+ * @brief Signals a multi wait from an ISR
+ *
+ * @param xMultiWait Handle of the multi wait
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a higher priority task was
+ * woken, and a context switch should be requested before exiting the ISR.
+ */
+    static inline void vMultiWaitSignalFromISR( MultiWaitHandle_t xMultiWait,
+                                                BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        ( void ) xQueueGiveFromISR( ( QueueHandle_t ) xMultiWait, pxHigherPriorityTaskWoken );
+    }
+
+#endif /* ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+
 /* -------------------------------------------- Creation With Memory Caps ----------------------------------------------
  * Helper functions to create various FreeRTOS objects (e.g., queues, semaphores) with specific memory capabilities
  * (e.g., MALLOC_CAP_INTERNAL).
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -168,6 +168,114 @@ TEST_CASE("IDF additions: Queue creation with memory caps", "[freertos]")
     vQueueDeleteWithCaps(queue_handle);
 }
 
+static void multi_wait_give_task(void *arg)
+{
+    vTaskDelay(pdMS_TO_TICKS(10));
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+    vTaskSuspend(NULL);
+}
+
+TEST_CASE("IDF additions: Multi wait on a queue and a semaphore", "[freertos]")
+{
+    MultiWaitHandle_t multi_wait = xMultiWaitCreate();
+    TEST_ASSERT_NOT_EQUAL(NULL, multi_wait);
+    QueueHandle_t queue = xQueueCreate(4, sizeof(uint32_t));
+    TEST_ASSERT_NOT_EQUAL(NULL, queue);
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_EQUAL(NULL, sem);
+    TEST_ASSERT_EQUAL(pdPASS, xQueueAddToSet(queue, multi_wait));
+    TEST_ASSERT_EQUAL(pdPASS, xQueueAddToSet(sem, multi_wait));
+    TEST_ASSERT_EQUAL(pdFALSE, xMultiWaitWait(multi_wait, 0));
+
+    // Several items only signal the multi wait once
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xQueueSend(queue, &i, 0));
+    }
+    TEST_ASSERT_EQUAL(pdTRUE, xMultiWaitWait(multi_wait, 0));
+    TEST_ASSERT_EQUAL(pdFALSE, xMultiWaitWait(multi_wait, 0));
+    uint32_t item;
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(queue, &item, 0));
+        TEST_ASSERT_EQUAL(i, item);
+    }
+
+    // Block until another task gives the semaphore
+    TaskHandle_t task_handle;
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(multi_wait_give_task, "give", 2048, sem, UNITY_FREERTOS_PRIORITY + 1, &task_handle, UNITY_FREERTOS_CPU));
+    TEST_ASSERT_EQUAL(pdTRUE, xMultiWaitWait(multi_wait, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(sem, 0));
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(sem, 0));
+    vTaskDelete(task_handle);
+
+    // Explicit signals
+    vMultiWaitSignal(multi_wait);
+    vMultiWaitSignal(multi_wait);
+    TEST_ASSERT_EQUAL(pdTRUE, xMultiWaitWait(multi_wait, 0));
+    TEST_ASSERT_EQUAL(pdFALSE, xMultiWaitWait(multi_wait, 0));
+
+    TEST_ASSERT_EQUAL(pdPASS, xQueueRemoveFromSet(queue, multi_wait));
+    TEST_ASSERT_EQUAL(pdPASS, xQueueRemoveFromSet(sem, multi_wait));
+    vSemaphoreDelete(sem);
+    vQueueDelete(queue);
+    vMultiWaitDelete(multi_wait);
+}
+
+#if CONFIG_FREERTOS_TASK_STATS
+
+#define STATS_TASK_YIELDS       10
+#define STATS_MAX_TASKS         CONFIG_FREERTOS_TASK_STATS_MAX_TASKS
+
+static void stats_task(void *arg)
+{
+    for (int i = 0; i < STATS_TASK_YIELDS; i++) {
+        vTaskDelay(1);
+    }
+    xTaskNotifyGive((TaskHandle_t)arg);
+    vTaskSuspend(NULL);
+}
+
+static bool get_task_stats(TaskHandle_t task, TaskStats_t *stats)
+{
+    static TaskStats_t all_stats[STATS_MAX_TASKS];
+    configRUN_TIME_COUNTER_TYPE total_run_time;
+    UBaseType_t num = uxTaskGetStats(all_stats, STATS_MAX_TASKS, &total_run_time);
+    TEST_ASSERT_GREATER_THAN(0, num);
+    TEST_ASSERT_GREATER_THAN(0, total_run_time);
+    for (UBaseType_t i = 0; i < num; i++) {
+        if (all_stats[i].xHandle == task) {
+            *stats = all_stats[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_CASE("IDF additions: Task statistics without stopping the scheduler", "[freertos]")
+{
+    TaskHandle_t task;
+    TaskStats_t stats;
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(stats_task, "stats", 4096, xTaskGetCurrentTaskHandle(), UNITY_FREERTOS_PRIORITY + 1, &task, 0));
+    TEST_ASSERT_NOT_EQUAL(0, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000)));
+
+    TEST_ASSERT_TRUE(get_task_stats(task, &stats));
+    TEST_ASSERT_EQUAL_STRING("stats", stats.pcTaskName);
+    TEST_ASSERT_GREATER_OR_EQUAL(STATS_TASK_YIELDS, stats.ulContextSwitches);
+    TEST_ASSERT_GREATER_THAN(0, stats.ulRunTimeCounter);
+    TEST_ASSERT_EQUAL(0, stats.xCoreID);
+    TEST_ASSERT_EQUAL(UNITY_FREERTOS_PRIORITY + 1, stats.uxCurrentPriority);
+    TEST_ASSERT_GREATER_THAN(0, stats.ulMinFreeStackSize);
+    TEST_ASSERT_LESS_THAN(4096, stats.ulMinFreeStackSize);
+
+    // The current task is reported as well
+    TEST_ASSERT_TRUE(get_task_stats(xTaskGetCurrentTaskHandle(), &stats));
+
+    // Deleted tasks are no longer reported
+    vTaskDelete(task);
+    TEST_ASSERT_FALSE(get_task_stats(task, &stats));
+}
+
+#endif /* CONFIG_FREERTOS_TASK_STATS */
+
 TEST_CASE("IDF additions: Semaphore creation with memory caps", "[freertos]")
 {
     SemaphoreHandle_t sem_handle;
@@ -546,12 +546,12 @@ static inline void emac_ll_disable_all_intr(emac_dma_dev_t *dma_regs)
     dma_regs->dmain_en.val = 0x00000000;
 }
 
-static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
+__attribute__((always_inline)) static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
 {
     dma_regs->dmain_en.val |= mask;
 }
 
-static inline void emac_ll_disable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
+__attribute__((always_inline)) static inline void emac_ll_disable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
 {
     dma_regs->dmain_en.val &= ~mask;
 }
@@ -587,6 +587,12 @@ static inline void emac_ll_receive_poll_demand(emac_dma_dev_t *dma_regs, uint32_
     dma_regs->dmarxpolldemand = val;
 }
 
+/* dmarintwdtimer */
+static inline void emac_ll_set_rx_intr_watchdog(emac_dma_dev_t *dma_regs, uint32_t cnt)
+{
+    HAL_FORCE_MODIFY_U32_REG_FIELD(dma_regs->dmarintwdtimer, riwtc, cnt);
+}
+
 /*************** End of dma regs operation *********************/
 
 /************** Start of ext regs operation ********************/
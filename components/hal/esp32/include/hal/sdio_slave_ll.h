@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -369,6 +369,18 @@ static inline void sdio_slave_ll_recv_size_inc(slc_dev_t *slc)
     slc->slc0_token1.val = FIELD_TO_VALUE2(SLC_SLC0_TOKEN1_WDATA, 1) | FIELD_TO_VALUE2(SLC_SLC0_TOKEN1_INC_MORE, 1);
 }
 
+/**
+ * Increase the receiving buffer counter by several buffers at once.
+ *
+ * @param slc Address of the SLC registers
+ * @param num Number of buffers to add, up to SLC_SLC0_TOKEN1_WDATA_V
+ */
+static inline void sdio_slave_ll_recv_size_add(slc_dev_t *slc, uint32_t num)
+{
+    // fields wdata and inc_more should be written by the same instruction.
+    slc->slc0_token1.val = FIELD_TO_VALUE2(SLC_SLC0_TOKEN1_WDATA, num) | FIELD_TO_VALUE2(SLC_SLC0_TOKEN1_INC_MORE, 1);
+}
+
 /**
  * Reset the receiving buffer.
  *
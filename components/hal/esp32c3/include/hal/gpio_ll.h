@@ -334,6 +334,49 @@ static inline int gpio_ll_get_level(gpio_dev_t *hw, uint32_t gpio_num)
     return (hw->in.data >> gpio_num) & 0x1;
 }
 
+/**
+ * @brief  Drive the GPIOs of a port selected by a mask high
+ *
+ * @param  hw Peripheral GPIO hardware instance address.
+ * @param  port Port number, port N holds GPIO 32 * N to GPIO 32 * N + 31.
+ * @param  mask Bit N set drives GPIO 32 * port + N high, the other GPIOs are not changed.
+ */
+__attribute__((always_inline))
+static inline void gpio_ll_port_set_mask(gpio_dev_t *hw, uint32_t port, uint32_t mask)
+{
+    (void)port;
+    hw->out_w1ts.val = mask;
+}
+
+/**
+ * @brief  Drive the GPIOs of a port selected by a mask low
+ *
+ * @param  hw Peripheral GPIO hardware instance address.
+ * @param  port Port number, port N holds GPIO 32 * N to GPIO 32 * N + 31.
+ * @param  mask Bit N set drives GPIO 32 * port + N low, the other GPIOs are not changed.
+ */
+__attribute__((always_inline))
+static inline void gpio_ll_port_clear_mask(gpio_dev_t *hw, uint32_t port, uint32_t mask)
+{
+    (void)port;
+    hw->out_w1tc.val = mask;
+}
+
+/**
+ * @brief  Get the input levels of all the GPIOs of a port
+ *
+ * @param  hw Peripheral GPIO hardware instance address.
+ * @param  port Port number, port N holds GPIO 32 * N to GPIO 32 * N + 31.
+ *
+ * @return Bit N is the input level of GPIO 32 * port + N
+ */
+__attribute__((always_inline))
+static inline uint32_t gpio_ll_port_get_level(gpio_dev_t *hw, uint32_t port)
+{
+    (void)port;
+    return hw->in.data;
+}
+
 /**
  * @brief Enable GPIO wake-up function.
  *
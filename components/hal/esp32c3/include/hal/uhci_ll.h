@@ -163,6 +163,17 @@ static inline void uhci_ll_set_eof_mode(uhci_dev_t *hw, uint32_t eof_mode)
     }
 }
 
+/**
+ * @brief Set the number of bytes after which a received packet ends, when UHCI_RX_LEN_EOF is enabled
+ *
+ * @param hw Beginning address of the peripheral registers
+ * @param length Packet length in bytes
+ */
+static inline void uhci_ll_set_rx_packet_threshold(uhci_dev_t *hw, uint32_t length)
+{
+    hw->pkt_thres.thrs = length;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -16,6 +16,9 @@
 extern "C" {
 #endif
 
+// Rate of the counters: XTAL (40 MHz) through the fixed 2.5 divider
+#define SYSTIMER_LL_TICKS_PER_US    16
+
 // TODO: [ESP32C5] IDF-8707
 
 // All these functions get invoked either from ISR or HAL that linked to IRAM.
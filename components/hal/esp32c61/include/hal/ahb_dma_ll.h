@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -22,6 +22,7 @@ extern "C" {
 #define AHB_DMA_LL_GET_HW(id) (((id) == 0) ? (&AHB_DMA) : NULL)
 
 #define GDMA_LL_CHANNEL_MAX_PRIORITY 5 // supported priority levels: [0,5]
+#define GDMA_LL_CHANNEL_MAX_WEIGHT   15 // supported weights: [1,15]
 
 #define GDMA_LL_RX_EVENT_MASK       (0x7F)
 #define GDMA_LL_TX_EVENT_MASK       (0x3F)
@@ -352,6 +353,22 @@ static inline void ahb_dma_ll_rx_set_priority(ahb_dma_dev_t *dev, uint32_t chann
     dev->channel[channel].in.in_pri.rx_pri_chn = prio;
 }
 
+/**
+ * @brief Set the arbitration weight (number of tokens) of DMA RX channel
+ */
+static inline void ahb_dma_ll_rx_set_weight(ahb_dma_dev_t *dev, uint32_t channel, uint32_t weight)
+{
+    dev->in_crc_arb[channel].ch_arb_weigh.rx_ch_arb_weigh_chn = weight;
+}
+
+/**
+ * @brief Enable the weighted arbitration of all the DMA RX channels
+ */
+static inline void ahb_dma_ll_rx_enable_weighted_arb(ahb_dma_dev_t *dev, bool enable)
+{
+    dev->weight_en_rx.weight_en_rx = enable;
+}
+
 /**
  * @brief Connect DMA RX channel to a given peripheral
  */
@@ -601,6 +618,22 @@ static inline void ahb_dma_ll_tx_set_priority(ahb_dma_dev_t *dev, uint32_t chann
     dev->channel[channel].out.out_pri.tx_pri_chn = prio;
 }
 
+/**
+ * @brief Set the arbitration weight (number of tokens) of DMA TX channel
+ */
+static inline void ahb_dma_ll_tx_set_weight(ahb_dma_dev_t *dev, uint32_t channel, uint32_t weight)
+{
+    dev->out_crc_arb[channel].ch_arb_weigh.tx_ch_arb_weigh_chn = weight;
+}
+
+/**
+ * @brief Enable the weighted arbitration of all the DMA TX channels
+ */
+static inline void ahb_dma_ll_tx_enable_weighted_arb(ahb_dma_dev_t *dev, bool enable)
+{
+    dev->weight_en_tx.weight_en_tx = enable;
+}
+
 /**
  * @brief Connect DMA TX channel to a given peripheral
  */
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -665,6 +665,21 @@ static inline void mcpwm_ll_operator_set_compare_value(mcpwm_dev_t *mcpwm, int o
     HAL_FORCE_MODIFY_U32_REG_FIELD(mcpwm->operators[operator_id].timestamp[compare_id], cmpr, compare_value);
 }
 
+/**
+ * @brief Get the address of the compare value register of a comparator
+ *
+ * @note The register only contains the compare value, so a new value can be written to it with a single store
+ *
+ * @param mcpwm Peripheral instance address
+ * @param operator_id Operator ID, index from 0 to 2
+ * @param compare_id Compare ID, index from 0 to 1
+ * @return Address of the compare value register
+ */
+static inline volatile uint32_t *mcpwm_ll_operator_get_compare_value_reg(mcpwm_dev_t *mcpwm, int operator_id, int compare_id)
+{
+    return (volatile uint32_t *)&mcpwm->operators[operator_id].timestamp[compare_id].val;
+}
+
 /**
  * @brief Update operator actions immediately
  *
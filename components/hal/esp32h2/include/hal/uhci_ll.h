@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include "hal/uhci_types.h"
 #include "soc/uhci_struct.h"
+#include "soc/pcr_struct.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +23,30 @@ typedef enum {
     UHCI_RX_EOF_MAX       = 0x7,
 } uhci_rxeof_cfg_t;
 
+/**
+ * @brief Enable the bus clock for UHCI module
+ *
+ * @param group_id Group ID
+ * @param enable true to enable, false to disable
+ */
+static inline void uhci_ll_enable_bus_clock(int group_id, bool enable)
+{
+    (void)group_id;
+    PCR.uhci_conf.uhci_clk_en = enable;
+}
+
+/**
+ * @brief Reset the UHCI module
+ *
+ * @param group_id Group ID
+ */
+static inline void uhci_ll_reset_register(int group_id)
+{
+    (void)group_id;
+    PCR.uhci_conf.uhci_rst_en = 1;
+    PCR.uhci_conf.uhci_rst_en = 0;
+}
+
 static inline void uhci_ll_init(uhci_dev_t *hw)
 {
     typeof(hw->conf0) conf0_reg;
@@ -128,6 +153,17 @@ static inline void uhci_ll_set_eof_mode(uhci_dev_t *hw, uint32_t eof_mode)
     }
 }
 
+/**
+ * @brief Set the number of bytes after which a received packet ends, when UHCI_RX_LEN_EOF is enabled
+ *
+ * @param hw Beginning address of the peripheral registers
+ * @param length Packet length in bytes
+ */
+static inline void uhci_ll_set_rx_packet_threshold(uhci_dev_t *hw, uint32_t length)
+{
+    hw->pkt_thres.pkt_thrs = length;
+}
+
 #ifdef __cplusplus
 }
 #endif
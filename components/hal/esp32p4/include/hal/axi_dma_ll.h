@@ -264,6 +264,22 @@ static inline void axi_dma_ll_rx_set_priority(axi_dma_dev_t *dev, uint32_t chann
     dev->in[channel].conf.in_pri.rx_pri_chn = prio;
 }
 
+/**
+ * @brief Set the arbitration weight (number of tokens) of DMA RX channel
+ */
+static inline void axi_dma_ll_rx_set_weight(axi_dma_dev_t *dev, uint32_t channel, uint32_t weight)
+{
+    dev->in[channel].conf.in_pri.rx_ch_arb_weigh_chn = weight;
+}
+
+/**
+ * @brief Enable the weighted arbitration of all the DMA RX channels
+ */
+static inline void axi_dma_ll_rx_enable_weighted_arb(axi_dma_dev_t *dev, bool enable)
+{
+    dev->weight_en.weight_en_rx = enable;
+}
+
 /**
  * @brief Connect DMA RX channel to a given peripheral
  */
@@ -499,6 +515,22 @@ static inline void axi_dma_ll_tx_set_priority(axi_dma_dev_t *dev, uint32_t chann
     dev->out[channel].conf.out_pri.tx_pri_chn = prio;
 }
 
+/**
+ * @brief Set the arbitration weight (number of tokens) of DMA TX channel
+ */
+static inline void axi_dma_ll_tx_set_weight(axi_dma_dev_t *dev, uint32_t channel, uint32_t weight)
+{
+    dev->out[channel].conf.out_pri.tx_ch_arb_weigh_chn = weight;
+}
+
+/**
+ * @brief Enable the weighted arbitration of all the DMA TX channels
+ */
+static inline void axi_dma_ll_tx_enable_weighted_arb(axi_dma_dev_t *dev, bool enable)
+{
+    dev->weight_en.weight_en_tx = enable;
+}
+
 /**
  * @brief Connect DMA TX channel to a given peripheral
  */
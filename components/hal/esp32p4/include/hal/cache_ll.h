@@ -1092,6 +1092,99 @@ static inline bool cache_ll_vaddr_to_cache_level_id(uint32_t vaddr_start, uint32
     return valid;
 }
 
+/*------------------------------------------------------------------------------
+ * Access Counters
+ *----------------------------------------------------------------------------*/
+/**
+ * @brief Enable or disable the L1 Cache access counters of the buses of a core
+ *
+ * @param core_id     ID of the core, its ibus counts in the L1 ICache and its dbus counts in the L1 DCache
+ * @param enable      True to enable, false to disable
+ */
+static inline void cache_ll_l1_enable_access_counter(uint32_t core_id, bool enable)
+{
+    uint32_t mask = BIT(core_id) | BIT(4 + core_id);
+    if (enable) {
+        CACHE.l1_cache_acs_cnt_ctrl.val |= mask;
+    } else {
+        CACHE.l1_cache_acs_cnt_ctrl.val &= ~mask;
+    }
+}
+
+/**
+ * @brief Clear the L1 Cache access counters of the buses of a core
+ *
+ * @param core_id     ID of the core
+ */
+static inline void cache_ll_l1_clear_access_counter(uint32_t core_id)
+{
+    CACHE.l1_cache_acs_cnt_ctrl.val |= BIT(16 + core_id) | BIT(20 + core_id);
+}
+
+/**
+ * @brief Get the L1 Cache access counters of a bus of a core
+ *
+ * @param core_id     ID of the core
+ * @param type        CACHE_TYPE_INSTRUCTION for the ibus, CACHE_TYPE_DATA for the dbus
+ * @param[out] hit    Number of hits
+ * @param[out] miss   Number of misses
+ */
+static inline void cache_ll_l1_get_access_counter(uint32_t core_id, cache_type_t type, uint32_t *hit, uint32_t *miss)
+{
+    if (type == CACHE_TYPE_INSTRUCTION) {
+        *hit = core_id == 0 ? CACHE.l1_ibus0_acs_hit_cnt.val : CACHE.l1_ibus1_acs_hit_cnt.val;
+        *miss = core_id == 0 ? CACHE.l1_ibus0_acs_miss_cnt.val : CACHE.l1_ibus1_acs_miss_cnt.val;
+    } else {
+        *hit = core_id == 0 ? CACHE.l1_dbus0_acs_hit_cnt.val : CACHE.l1_dbus1_acs_hit_cnt.val;
+        *miss = core_id == 0 ? CACHE.l1_dbus0_acs_miss_cnt.val : CACHE.l1_dbus1_acs_miss_cnt.val;
+    }
+}
+
+/**
+ * @brief Enable or disable the L2 Cache access counters of the buses of a core
+ *
+ * @param core_id     ID of the core
+ * @param enable      True to enable, false to disable
+ */
+static inline void cache_ll_l2_enable_access_counter(uint32_t core_id, bool enable)
+{
+    uint32_t mask = BIT(8 + core_id) | BIT(12 + core_id);
+    if (enable) {
+        CACHE.l2_cache_acs_cnt_ctrl.val |= mask;
+    } else {
+        CACHE.l2_cache_acs_cnt_ctrl.val &= ~mask;
+    }
+}
+
+/**
+ * @brief Clear the L2 Cache access counters of the buses of a core
+ *
+ * @param core_id     ID of the core
+ */
+static inline void cache_ll_l2_clear_access_counter(uint32_t core_id)
+{
+    CACHE.l2_cache_acs_cnt_ctrl.val |= BIT(24 + core_id) | BIT(28 + core_id);
+}
+
+/**
+ * @brief Get the L2 Cache access counters of a bus of a core
+ *
+ * @param core_id     ID of the core
+ * @param type        CACHE_TYPE_INSTRUCTION for the ibus, CACHE_TYPE_DATA for the dbus
+ * @param[out] hit    Number of hits
+ * @param[out] miss   Number of misses
+ */
+static inline void cache_ll_l2_get_access_counter(uint32_t core_id, cache_type_t type, uint32_t *hit, uint32_t *miss)
+{
+    if (type == CACHE_TYPE_INSTRUCTION) {
+        *hit = core_id == 0 ? CACHE.l2_ibus0_acs_hit_cnt.val : CACHE.l2_ibus1_acs_hit_cnt.val;
+        *miss = core_id == 0 ? CACHE.l2_ibus0_acs_miss_cnt.val : CACHE.l2_ibus1_acs_miss_cnt.val;
+    } else {
+        *hit = core_id == 0 ? CACHE.l2_dbus0_acs_hit_cnt.val : CACHE.l2_dbus1_acs_hit_cnt.val;
+        *miss = core_id == 0 ? CACHE.l2_dbus0_acs_miss_cnt.val : CACHE.l2_dbus1_acs_miss_cnt.val;
+    }
+}
+
 /*------------------------------------------------------------------------------
  * Interrupt
  *----------------------------------------------------------------------------*/
@@ -551,7 +551,7 @@ static inline void emac_ll_disable_all_intr(emac_dma_dev_t *dma_regs)
     dma_regs->dmain_en.val = 0x00000000;
 }
 
-static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
+__attribute__((always_inline)) static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
 {
     uint32_t temp_mask = dma_regs->dmain_en.val;
     temp_mask |= mask;
@@ -559,7 +559,7 @@ static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, u
 
 }
 
-static inline void emac_ll_disable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
+__attribute__((always_inline)) static inline void emac_ll_disable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
 {
     uint32_t temp_mask = dma_regs->dmain_en.val;
     temp_mask &= ~mask;
@@ -598,6 +598,12 @@ static inline void emac_ll_receive_poll_demand(emac_dma_dev_t *dma_regs, uint32_
     dma_regs->dmarxpolldemand = val;
 }
 
+/* dmarintwdtimer */
+static inline void emac_ll_set_rx_intr_watchdog(emac_dma_dev_t *dma_regs, uint32_t cnt)
+{
+    HAL_FORCE_MODIFY_U32_REG_FIELD(dma_regs->dmarintwdtimer, riwtc, cnt);
+}
+
 /*************** End of dma regs operation *********************/
 
 /************** Start of ptp regs operation ********************/
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -725,6 +725,21 @@ static inline void mcpwm_ll_operator_set_compare_value(mcpwm_dev_t *mcpwm, int o
     HAL_FORCE_MODIFY_U32_REG_FIELD(mcpwm->operators[operator_id].timestamp[compare_id], cmpr, compare_value);
 }
 
+/**
+ * @brief Get the address of the compare value register of a comparator
+ *
+ * @note The register only contains the compare value, so a new value can be written to it with a single store
+ *
+ * @param mcpwm Peripheral instance address
+ * @param operator_id Operator ID, index from 0 to 2
+ * @param compare_id Compare ID, index from 0 to 1
+ * @return Address of the compare value register
+ */
+static inline volatile uint32_t *mcpwm_ll_operator_get_compare_value_reg(mcpwm_dev_t *mcpwm, int operator_id, int compare_id)
+{
+    return (volatile uint32_t *)&mcpwm->operators[operator_id].timestamp[compare_id].val;
+}
+
 /**
  * @brief Set equal value for operator event comparator
  *
@@ -739,6 +754,19 @@ static inline void mcpwm_ll_operator_set_event_compare_value(mcpwm_dev_t *mcpwm,
     HAL_FORCE_MODIFY_U32_REG_FIELD(mcpwm->operators_timestamp[operator_id].timestamp[event_cmpr_id], op_tstmp_e, compare_value);
 }
 
+/**
+ * @brief Get the address of the compare value register of an event comparator
+ *
+ * @param mcpwm Peripheral instance address
+ * @param operator_id Operator ID, index from 0 to 2
+ * @param event_cmpr_id Event comparator ID, index from 0 to 1
+ * @return Address of the compare value register
+ */
+static inline volatile uint32_t *mcpwm_ll_operator_get_event_compare_value_reg(mcpwm_dev_t *mcpwm, int operator_id, int event_cmpr_id)
+{
+    return (volatile uint32_t *)&mcpwm->operators_timestamp[operator_id].timestamp[event_cmpr_id].val;
+}
+
 /**
  * @brief Update operator actions immediately
  *
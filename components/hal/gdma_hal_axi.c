@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -61,6 +61,26 @@ void gdma_axi_hal_set_priority(gdma_hal_context_t *hal, int chan_id, gdma_channe
     }
 }
 
+#if SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+void gdma_axi_hal_set_weight(gdma_hal_context_t *hal, int chan_id, gdma_channel_direction_t dir, uint32_t weight)
+{
+    if (dir == GDMA_CHANNEL_DIRECTION_RX) {
+        axi_dma_ll_rx_set_weight(hal->axi_dma_dev, chan_id, weight);
+    } else {
+        axi_dma_ll_tx_set_weight(hal->axi_dma_dev, chan_id, weight);
+    }
+}
+
+void gdma_axi_hal_enable_weighted_arb(gdma_hal_context_t *hal, gdma_channel_direction_t dir, bool en_or_dis)
+{
+    if (dir == GDMA_CHANNEL_DIRECTION_RX) {
+        axi_dma_ll_rx_enable_weighted_arb(hal->axi_dma_dev, en_or_dis);
+    } else {
+        axi_dma_ll_tx_enable_weighted_arb(hal->axi_dma_dev, en_or_dis);
+    }
+}
+#endif // SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+
 void gdma_axi_hal_connect_peri(gdma_hal_context_t *hal, int chan_id, gdma_channel_direction_t dir, gdma_trigger_peripheral_t periph, int periph_sub_id)
 {
     if (dir == GDMA_CHANNEL_DIRECTION_RX) {
@@ -267,5 +287,9 @@ void gdma_axi_hal_init(gdma_hal_context_t *hal, const gdma_hal_config_t *config)
 #if SOC_GDMA_SUPPORT_ETM
     hal->enable_etm_task = gdma_axi_hal_enable_etm_task;
 #endif // SOC_GDMA_SUPPORT_ETM
+#if SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+    hal->set_weight = gdma_axi_hal_set_weight;
+    hal->enable_weighted_arb = gdma_axi_hal_enable_weighted_arb;
+#endif // SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
     axi_dma_ll_set_default_memory_range(hal->axi_dma_dev);
 }
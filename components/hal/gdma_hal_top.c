@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -38,6 +38,18 @@ void gdma_hal_set_priority(gdma_hal_context_t *hal, int chan_id, gdma_channel_di
     hal->set_priority(hal, chan_id, dir, priority);
 }
 
+#if SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+void gdma_hal_set_weight(gdma_hal_context_t *hal, int chan_id, gdma_channel_direction_t dir, uint32_t weight)
+{
+    hal->set_weight(hal, chan_id, dir, weight);
+}
+
+void gdma_hal_enable_weighted_arb(gdma_hal_context_t *hal, gdma_channel_direction_t dir, bool en_or_dis)
+{
+    hal->enable_weighted_arb(hal, dir, en_or_dis);
+}
+#endif // SOC_GDMA_SUPPORT_WEIGHTED_ARBITRATION
+
 void gdma_hal_connect_peri(gdma_hal_context_t *hal, int chan_id, gdma_channel_direction_t dir, gdma_trigger_peripheral_t periph, int periph_sub_id)
 {
     hal->connect_peri(hal, chan_id, dir, periph, periph_sub_id);
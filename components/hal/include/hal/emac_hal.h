@@ -301,12 +301,25 @@ void emac_hal_enable_flow_ctrl(emac_hal_context_t *hal, bool enable);
 
 #define emac_hal_clear_all_intr(hal) emac_ll_clear_all_pending_intr((hal)->dma_regs)
 
+#define emac_hal_enable_corresponding_intr(hal, mask) emac_ll_enable_corresponding_intr((hal)->dma_regs, mask)
+
+#define emac_hal_disable_corresponding_intr(hal, mask) emac_ll_disable_corresponding_intr((hal)->dma_regs, mask)
+
 void emac_hal_set_rx_tx_desc_addr(emac_hal_context_t *hal, eth_dma_rx_descriptor_t *rx_desc, eth_dma_tx_descriptor_t *tx_desc);
 
 #define emac_hal_receive_poll_demand(hal) emac_ll_receive_poll_demand((hal)->dma_regs, 0)
 
 #define emac_hal_transmit_poll_demand(hal) emac_ll_transmit_poll_demand((hal)->dma_regs, 0)
 
+/**
+ * @brief Set the Rx interrupt watchdog, which raises the Rx interrupt after a frame received into a descriptor
+ *        with DisableInterruptOnComplete set
+ *
+ * @param hal EMAC HAL context infostructure
+ * @param cnt watchdog time in units of 256 system clock cycles, 0 disables the watchdog
+ */
+#define emac_hal_set_rx_intr_watchdog(hal, cnt) emac_ll_set_rx_intr_watchdog((hal)->dma_regs, cnt)
+
 #if SOC_EMAC_IEEE1588V2_SUPPORTED
 #define emac_hal_get_ts_status(hal) emac_ll_get_ts_status((hal)->ptp_regs);
 
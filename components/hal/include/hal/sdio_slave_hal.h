@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -415,6 +415,18 @@ void sdio_slave_hal_recv_init_desc(sdio_slave_context_t *hal, sdio_slave_hal_rec
  */
 void sdio_slave_hal_load_buf(sdio_slave_context_t *hal, sdio_slave_hal_recv_desc_t *desc);
 
+/**
+ * Load several buffers to the HAL to be used to receive data, in this order.
+ *
+ * Same as calling `sdio_slave_hal_load_buf` for each of the buffers, but the receiving DMA is (re)started and the
+ * buffer counter is increased only once.
+ *
+ * @param hal Context of the HAL layer.
+ * @param descs Descriptors to load to the HAL to receive.
+ * @param num Number of descriptors, 1 to 4095.
+ */
+void sdio_slave_hal_load_bufs(sdio_slave_context_t *hal, sdio_slave_hal_recv_desc_t *const *descs, size_t num);
+
 /**
  * Check and clear the interrupt indicating a buffer has finished receiving.
  *
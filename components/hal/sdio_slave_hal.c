@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -644,19 +644,26 @@ void sdio_slave_hal_recv_flush_one_buffer(sdio_slave_context_t *hal)
 
 void sdio_slave_hal_load_buf(sdio_slave_context_t *hal, sdio_slave_ll_desc_t *desc)
 {
-    sdio_slave_hal_recv_stailq_t *const queue = &(hal->recv_link_list);
-    desc->owner = 1;
+    sdio_slave_hal_load_bufs(hal, &desc, 1);
+}
 
+void sdio_slave_hal_load_bufs(sdio_slave_context_t *hal, sdio_slave_ll_desc_t *const *descs, size_t num)
+{
+    sdio_slave_hal_recv_stailq_t *const queue = &(hal->recv_link_list);
     sdio_slave_ll_desc_t *const tail = STAILQ_LAST(queue, sdio_slave_ll_desc_s, qe);
 
-    STAILQ_INSERT_TAIL(queue, desc, qe);
+    //link all the buffers first, the DMA is started or restarted only once for all of them.
+    for (size_t i = 0; i < num; i++) {
+        descs[i]->owner = 1;
+        STAILQ_INSERT_TAIL(queue, descs[i], qe);
+    }
     if (hal->recv_cur_ret == NULL) {
-        hal->recv_cur_ret = desc;
+        hal->recv_cur_ret = descs[0];
     }
 
     if (tail == NULL) {
         //no one in the ll, start new ll operation.
-        sdio_slave_ll_recv_start(hal->slc, desc);
+        sdio_slave_ll_recv_start(hal->slc, descs[0]);
         sdio_slave_ll_recv_intr_ena(hal->slc, true);
         HAL_LOGV(TAG, "recv_load_buf: start new");
     } else {
@@ -664,7 +671,7 @@ void sdio_slave_hal_load_buf(sdio_slave_context_t *hal, sdio_slave_ll_desc_t *de
         sdio_slave_ll_recv_restart(hal->slc);
         HAL_LOGV(TAG, "recv_load_buf: restart");
     }
-    sdio_slave_ll_recv_size_inc(hal->slc);
+    sdio_slave_ll_recv_size_add(hal->slc, num);
 }
 
 static inline void show_queue_item(sdio_slave_ll_desc_t *item)
@@ -12,6 +12,7 @@
 #include "esp_heap_caps.h"
 #include "multi_heap.h"
 #include "esp_log.h"
+#include "multi_heap_internal.h"
 #include "heap_private.h"
 #include "esp_system.h"
 
@@ -386,6 +387,7 @@ void heap_caps_get_info( multi_heap_info_t *info, uint32_t caps )
             info->total_blocks += hinfo.total_blocks;
         }
     }
+    info->fragmentation = multi_heap_fragmentation(info->largest_free_block, info->total_free_bytes);
 }
 
 void heap_caps_print_heap_info( uint32_t caps )
@@ -407,7 +409,8 @@ void heap_caps_print_heap_info( uint32_t caps )
     printf("  Totals:\n");
     heap_caps_get_info(&info, caps);
 
-    printf("    free %d allocated %d min_free %d largest_free_block %d\n", info.total_free_bytes, info.total_allocated_bytes, info.minimum_free_bytes, info.largest_free_block);
+    printf("    free %d allocated %d min_free %d largest_free_block %d fragmentation %d%%\n", info.total_free_bytes, info.total_allocated_bytes,
+           info.minimum_free_bytes, info.largest_free_block, info.fragmentation);
 }
 
 bool heap_caps_check_integrity(uint32_t caps, bool print_errors)
@@ -457,6 +460,13 @@ void heap_caps_dump_all(void)
     heap_caps_dump(MALLOC_CAP_INVALID);
 }
 
+void heap_caps_flush_cache(void)
+{
+#if CONFIG_HEAP_PER_CORE_CACHE
+    heap_caps_cache_drain();
+#endif
+}
+
 size_t heap_caps_get_allocated_size( void *ptr )
 {
     // add the block owner bytes back to ptr before handing over
@@ -28,6 +28,14 @@
 #define CALL_HOOK(hook, ...) {}
 #endif
 
+#if CONFIG_HEAP_PROFILER
+#define PROFILE_ALLOC(ptr, size) heap_profiler_record_alloc(ptr, size)
+#define PROFILE_FREE(ptr) heap_profiler_record_free(ptr)
+#else
+#define PROFILE_ALLOC(ptr, size)
+#define PROFILE_FREE(ptr)
+#endif
+
 //This is normally provided by the heap-memalign-hw component.
 extern void esp_heap_adjust_alignment_to_hw(size_t *p_alignment, size_t *p_size, uint32_t *p_caps);
 
@@ -67,6 +75,12 @@ HEAP_IRAM_ATTR void heap_caps_free( void *ptr)
         return;
     }
 
+    PROFILE_FREE(ptr);
+
+#if CONFIG_HEAP_PER_CORE_CACHE
+    // Blocks returned through their IRAM alias are never cached
+    void *user_ptr = ptr;
+#endif
     if ((!esp_dram_match_iram() && esp_ptr_in_diram_iram(ptr)) ||
         (!esp_rtc_dram_match_rtc_iram() && esp_ptr_in_rtc_iram_fast(ptr))) {
         //Memory allocated here is actually allocated in the DRAM alias region and
@@ -79,6 +93,13 @@ HEAP_IRAM_ATTR void heap_caps_free( void *ptr)
     heap_t *heap = find_containing_heap(block_owner_ptr);
     assert(heap != NULL && "free() target pointer is outside heap areas");
 
+#if CONFIG_HEAP_PER_CORE_CACHE
+    if (ptr == user_ptr && heap_caps_cache_free(heap, ptr)) {
+        CALL_HOOK(esp_heap_trace_free_hook, ptr);
+        return;
+    }
+#endif
+
 #if CONFIG_HEAP_TASK_TRACKING
     heap_caps_update_per_task_info_free(heap, ptr);
 #endif
@@ -134,6 +155,34 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
         size = (size + 3) & (~3); // int overflow checked above
     }
 
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+    // The short-lived hint selects the heaps searched first, it is not a capability the heaps must have
+    const bool short_lived = (caps & MALLOC_CAP_SHORT_LIVED) && size <= CONFIG_HEAP_SHORT_LIVED_MAX_ALLOC_SIZE;
+    bool search_arenas;
+    int arena_passes;
+#endif
+    caps &= ~MALLOC_CAP_SHORT_LIVED;
+
+#if CONFIG_HEAP_PER_CORE_CACHE
+    int cache_class = heap_caps_cache_class(size, alignment, caps);
+    if (cache_class >= 0) {
+        ret = heap_caps_cache_alloc(cache_class);
+        if (ret == NULL) {
+            ret = heap_caps_cache_refill(cache_class, caps);
+        }
+        if (ret != NULL) {
+            CALL_HOOK(esp_heap_trace_alloc_hook, ret, size, caps);
+            PROFILE_ALLOC(ret, size);
+            return ret;
+        }
+    }
+retry:
+#endif
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+    search_arenas = short_lived;
+    arena_passes = 0;
+search:
+#endif
     for (int prio = 0; prio < SOC_MEMORY_TYPE_NO_PRIOS; prio++) {
         //Iterate over heaps and check capabilities at this priority
         heap_t *heap;
@@ -141,6 +190,11 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
             if (heap->heap == NULL) {
                 continue;
             }
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+            if (heap_is_short_lived_arena(heap) != search_arenas) {
+                continue;
+            }
+#endif
             if ((heap->caps[prio] & caps) != 0) {
                 //Heap has at least one of the caps requested. If caps has other bits set that this prio
                 //doesn't cover, see if they're available in other prios.
@@ -168,6 +222,7 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
                             ret = MULTI_HEAP_ADD_BLOCK_OWNER_OFFSET(ret);
                             uint32_t *iptr = dram_alloc_to_iram_addr(ret, size + 4);  // int overflow checked above
                             CALL_HOOK(esp_heap_trace_alloc_hook, iptr, size, caps);
+                            PROFILE_ALLOC(iptr, size);
                             return iptr;
                         }
                     } else {
@@ -185,6 +240,7 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
                             MULTI_HEAP_SET_BLOCK_OWNER(ret);
                             ret = MULTI_HEAP_ADD_BLOCK_OWNER_OFFSET(ret);
                             CALL_HOOK(esp_heap_trace_alloc_hook, ret, size, caps);
+                            PROFILE_ALLOC(ret, size);
                             return ret;
                         }
                     }
@@ -193,6 +249,22 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
         }
     }
 
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+    //Short-lived allocations which do not fit in the arenas fall back to the other heaps, and the other
+    //allocations fall back to the arenas rather than failing.
+    if (++arena_passes < 2) {
+        search_arenas = !search_arenas;
+        goto search;
+    }
+#endif
+
+#if CONFIG_HEAP_PER_CORE_CACHE
+    //Blocks held in the per-core caches may be what prevents this allocation. Give them back and try again.
+    if (heap_caps_cache_drain()) {
+        goto retry;
+    }
+#endif
+
     //Nothing usable found.
     return NULL;
 }
@@ -259,7 +331,9 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_realloc_base( void *ptr, size_t siz
 
     // are the existing heap's capabilities compatible with the
     // requested ones?
-    bool compatible_caps = (caps & get_all_caps(heap)) == caps;
+    // (the short-lived hint does not make the block move to another heap)
+    const uint32_t required_caps = caps & ~MALLOC_CAP_SHORT_LIVED;
+    bool compatible_caps = (required_caps & get_all_caps(heap)) == required_caps;
 
     //Note we don't try realloc() on memory that needs to be aligned, that is handled
     //by the fallthrough code.
@@ -287,6 +361,8 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_realloc_base( void *ptr, size_t siz
 
             r = MULTI_HEAP_ADD_BLOCK_OWNER_OFFSET(r);
             CALL_HOOK(esp_heap_trace_alloc_hook, r, size, caps);
+            PROFILE_FREE(MULTI_HEAP_ADD_BLOCK_OWNER_OFFSET(ptr));
+            PROFILE_ALLOC(r, size);
             return r;
         }
     }
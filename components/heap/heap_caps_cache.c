@@ -0,0 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+  Per-core cache of small heap blocks.
+
+  Each core keeps, for every size class (16, 32, ... 256 bytes), a short stack
+  ("magazine") of blocks that have been freed but not yet given back to their heap.
+  Cached blocks stay allocated from the point of view of multi_heap, so poisoning and
+  integrity checks keep working on them. Refills and drains move half a magazine at a
+  time, so the heap lock is taken once per batch instead of once per block.
+*/
+
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "multi_heap.h"
+#include "multi_heap_internal.h"
+#include "heap_private.h"
+
+#define HEAP_CACHE_MIN_SHIFT    4
+#define HEAP_CACHE_CLASSES      5
+#define HEAP_CACHE_MAX_SIZE     (1 << (HEAP_CACHE_MIN_SHIFT + HEAP_CACHE_CLASSES - 1))
+#define HEAP_CACHE_DEPTH        CONFIG_HEAP_PER_CORE_CACHE_DEPTH
+#define HEAP_CACHE_BATCH        (HEAP_CACHE_DEPTH / 2)
+
+/* Only plain internal byte-accessible memory is cached. Requests whose caps are a subset of
+   these can be served by any cached block, heaps providing all of them can feed the cache. */
+#define HEAP_CACHE_CAPS         (MALLOC_CAP_DEFAULT | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_32BIT)
+
+typedef struct {
+    multi_heap_lock_t lock;
+    uint8_t count[HEAP_CACHE_CLASSES];
+    void *blocks[HEAP_CACHE_CLASSES][HEAP_CACHE_DEPTH];
+} heap_cache_t;
+
+static heap_cache_t s_cache[CONFIG_FREERTOS_NUMBER_OF_CORES] = {
+    [0 ... CONFIG_FREERTOS_NUMBER_OF_CORES - 1] = {
+        .lock = MULTI_HEAP_LOCK_STATIC_INITIALIZER,
+    },
+};
+
+FORCE_INLINE_ATTR size_t class_size(int class)
+{
+    return 1 << (HEAP_CACHE_MIN_SHIFT + class);
+}
+
+/* The calling task may migrate right after this returns. That is harmless: it then simply
+   uses the other core's cache, which is protected by its own lock. */
+FORCE_INLINE_ATTR heap_cache_t *get_core_cache(void)
+{
+    return &s_cache[xPortGetCoreID()];
+}
+
+/* Blocks handed out by the cache of the given class are class_size() bytes long, which
+   is what a poisoned block records as its allocation size. */
+HEAP_IRAM_ATTR static void cache_block_taken(void *p, int class)
+{
+#ifdef MULTI_HEAP_POISONING_SLOW
+    /* The block was filled with the free pattern when it was cached, make sure nobody
+       wrote to it since. */
+    bool unused = multi_heap_internal_check_block_poisoning(p, class_size(class), true, true);
+    assert(unused && "heap block written while held in the per-core cache");
+    (void)unused;
+    multi_heap_internal_poison_fill_region(p, class_size(class), false);
+#else
+    (void)p;
+    (void)class;
+#endif
+}
+
+HEAP_IRAM_ATTR static void cache_block_put(void *p, int class)
+{
+#ifdef MULTI_HEAP_POISONING_SLOW
+    multi_heap_internal_poison_fill_region(p, class_size(class), true);
+#else
+    (void)p;
+    (void)class;
+#endif
+}
+
+HEAP_IRAM_ATTR int heap_caps_cache_class(size_t size, size_t alignment, uint32_t caps)
+{
+    if (size > HEAP_CACHE_MAX_SIZE || alignment > 4 || (caps & ~HEAP_CACHE_CAPS) != 0) {
+        return -1;
+    }
+    if (size <= class_size(0)) {
+        return 0;
+    }
+    return (32 - __builtin_clz(size - 1)) - HEAP_CACHE_MIN_SHIFT;
+}
+
+HEAP_IRAM_ATTR void *heap_caps_cache_alloc(int class)
+{
+    heap_cache_t *cache = get_core_cache();
+    void *ret = NULL;
+
+    MULTI_HEAP_LOCK(&cache->lock);
+    if (cache->count[class] > 0) {
+        ret = cache->blocks[class][--cache->count[class]];
+    }
+    MULTI_HEAP_UNLOCK(&cache->lock);
+
+    if (ret != NULL) {
+        cache_block_taken(ret, class);
+    }
+    return ret;
+}
+
+HEAP_IRAM_ATTR void *heap_caps_cache_refill(int class, uint32_t caps)
+{
+    void *batch[HEAP_CACHE_BATCH];
+    size_t batch_len = 0;
+    void *ret = NULL;
+
+    for (int prio = 0; prio < SOC_MEMORY_TYPE_NO_PRIOS && ret == NULL; prio++) {
+        heap_t *heap;
+        SLIST_FOREACH(heap, &registered_heaps, next) {
+            if (heap->heap == NULL || (heap->caps[prio] & caps) == 0 || !heap_caps_match(heap, HEAP_CACHE_CAPS)) {
+                continue;
+            }
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+            /* Cached blocks live long, they would fragment the arenas */
+            if (heap_is_short_lived_arena(heap)) {
+                continue;
+            }
+#endif
+            /* One lock for the whole batch. multi_heap_malloc() takes the same (recursive) lock again. */
+            multi_heap_internal_lock(heap->heap);
+            ret = multi_heap_malloc(heap->heap, class_size(class));
+            if (ret != NULL) {
+                for (; batch_len < HEAP_CACHE_BATCH - 1; batch_len++) {
+                    batch[batch_len] = multi_heap_malloc(heap->heap, class_size(class));
+                    if (batch[batch_len] == NULL) {
+                        break;
+                    }
+                }
+            }
+            multi_heap_internal_unlock(heap->heap);
+            if (ret != NULL) {
+                break;
+            }
+        }
+    }
+
+    if (batch_len == 0) {
+        return ret;
+    }
+
+    heap_cache_t *cache = get_core_cache();
+    MULTI_HEAP_LOCK(&cache->lock);
+    while (batch_len > 0 && cache->count[class] < HEAP_CACHE_DEPTH) {
+        void *p = batch[--batch_len];
+        cache_block_put(p, class);
+        cache->blocks[class][cache->count[class]++] = p;
+    }
+    MULTI_HEAP_UNLOCK(&cache->lock);
+
+    /* The cache was filled concurrently, give back what did not fit */
+    while (batch_len > 0) {
+        void *p = batch[--batch_len];
+        multi_heap_free(find_containing_heap(p)->heap, p);
+    }
+    return ret;
+}
+
+HEAP_IRAM_ATTR bool heap_caps_cache_free(heap_t *heap, void *p)
+{
+    if (!heap_caps_match(heap, HEAP_CACHE_CAPS)) {
+        return false;
+    }
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+    if (heap_is_short_lived_arena(heap)) {
+        return false;
+    }
+#endif
+
+    /* A block can serve every class not larger than its usable size */
+    size_t size = multi_heap_get_allocated_size(heap->heap, p);
+    if (size < class_size(0)) {
+        return false;
+    }
+    int class = (31 - __builtin_clz(size)) - HEAP_CACHE_MIN_SHIFT;
+    if (class >= HEAP_CACHE_CLASSES) {
+        return false;
+    }
+
+#ifdef MULTI_HEAP_POISONING
+    /* Catch an overrun like multi_heap_free() would, then move the tail canary to the end of the
+       class size so the next owner of the block is checked against the size it may use. */
+    bool valid = multi_heap_internal_repoison_block(p, class_size(class));
+    assert(valid && "CORRUPT HEAP: block freed to the per-core cache is corrupt");
+    (void)valid;
+#endif
+
+    void *drained[HEAP_CACHE_BATCH];
+    size_t drained_len = 0;
+    heap_cache_t *cache = get_core_cache();
+
+    cache_block_put(p, class);
+    MULTI_HEAP_LOCK(&cache->lock);
+    if (cache->count[class] == HEAP_CACHE_DEPTH) {
+        /* Magazine is full, move the oldest half of it back to the heap */
+        drained_len = HEAP_CACHE_BATCH;
+        memcpy(drained, cache->blocks[class], sizeof(drained));
+        memmove(cache->blocks[class], &cache->blocks[class][HEAP_CACHE_BATCH],
+                (HEAP_CACHE_DEPTH - HEAP_CACHE_BATCH) * sizeof(void *));
+        cache->count[class] -= HEAP_CACHE_BATCH;
+    }
+    cache->blocks[class][cache->count[class]++] = p;
+    MULTI_HEAP_UNLOCK(&cache->lock);
+
+    for (size_t i = 0; i < drained_len; i++) {
+        multi_heap_free(find_containing_heap(drained[i])->heap, drained[i]);
+    }
+    return true;
+}
+
+HEAP_IRAM_ATTR bool heap_caps_cache_drain(void)
+{
+    bool drained_any = false;
+
+    for (int core = 0; core < CONFIG_FREERTOS_NUMBER_OF_CORES; core++) {
+        heap_cache_t *cache = &s_cache[core];
+        for (int class = 0; class < HEAP_CACHE_CLASSES; class++) {
+            void *drained[HEAP_CACHE_DEPTH];
+            size_t drained_len;
+
+            MULTI_HEAP_LOCK(&cache->lock);
+            drained_len = cache->count[class];
+            memcpy(drained, cache->blocks[class], drained_len * sizeof(void *));
+            cache->count[class] = 0;
+            MULTI_HEAP_UNLOCK(&cache->lock);
+
+            for (size_t i = 0; i < drained_len; i++) {
+                multi_heap_free(find_containing_heap(drained[i])->heap, drained[i]);
+            }
+            drained_any |= (drained_len > 0);
+        }
+    }
+    return drained_any;
+}
@@ -90,6 +90,29 @@ void heap_caps_enable_nonos_stack_heaps(void)
     }
 }
 
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+#define SHORT_LIVED_ARENA_REGION_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DEFAULT)
+
+/* Return the index of the region the short-lived arena is carved from: the largest region of default
+   internal memory which is at least twice as large as the arena, or -1 if there is none */
+static int find_short_lived_arena_region(const soc_memory_region_t *regions, size_t num_regions)
+{
+    int arena_region = -1;
+    for (size_t i = 0; i < num_regions; i++) {
+        const soc_memory_region_t *region = &regions[i];
+        if (region->type == -1 || region->startup_stack || region->size < 2 * CONFIG_HEAP_SHORT_LIVED_ARENA_SIZE) {
+            continue;
+        }
+        uint32_t caps = get_ored_caps(soc_memory_types[region->type].caps);
+        if ((caps & SHORT_LIVED_ARENA_REGION_CAPS) == SHORT_LIVED_ARENA_REGION_CAPS &&
+                (arena_region < 0 || region->size > regions[arena_region].size)) {
+            arena_region = i;
+        }
+    }
+    return arena_region;
+}
+#endif
+
 /* Initialize the heap allocator to use all of the memory not
    used by static data or reserved for other purposes
  */
@@ -126,6 +149,13 @@ void heap_caps_init(void)
         }
     }
 
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+    int arena_region = find_short_lived_arena_region(regions, num_regions);
+    if (arena_region >= 0) {
+        num_heaps++;
+    }
+#endif
+
     /* Start by allocating the registered heap data on the stack.
 
        Once we have a heap to copy it to, we will copy it to a heap buffer.
@@ -144,6 +174,11 @@ void heap_caps_init(void)
         }
         heap_idx++;
         assert(heap_idx <= num_heaps);
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+        if ((int)i == arena_region) {
+            region->size -= CONFIG_HEAP_SHORT_LIVED_ARENA_SIZE;
+        }
+#endif
 
         // add the name of the newly created heap to match the region name in which it will be created
 #if CONFIG_HEAP_TASK_TRACKING
@@ -163,6 +198,27 @@ void heap_caps_init(void)
 
         ESP_EARLY_LOGI(TAG, "At %08X len %08X (%d KiB): %s",
                        region->start, region->size, region->size / 1024, type->name);
+
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+        if ((int)i == arena_region) {
+            /* The arena follows the heap it is carved from, with the same capabilities and the short-lived hint */
+            heap_t *arena = &temp_heaps[heap_idx++];
+            assert(heap_idx <= num_heaps);
+#if CONFIG_HEAP_TASK_TRACKING
+            arena->name = type->name;
+#endif // CONFIG_HEAP_TASK_TRACKING
+            memcpy(arena->caps, type->caps, sizeof(arena->caps));
+            arena->caps[0] |= MALLOC_CAP_SHORT_LIVED;
+            arena->start = heap->end;
+            arena->end = heap->end + CONFIG_HEAP_SHORT_LIVED_ARENA_SIZE;
+            MULTI_HEAP_LOCK_INIT(&arena->heap_mux);
+            register_heap(arena);
+            SLIST_NEXT(arena, next) = NULL;
+
+            ESP_EARLY_LOGI(TAG, "At %08X len %08X (%d KiB): %s, short-lived arena",
+                           arena->start, CONFIG_HEAP_SHORT_LIVED_ARENA_SIZE, CONFIG_HEAP_SHORT_LIVED_ARENA_SIZE / 1024, type->name);
+        }
+#endif
     }
 
     assert(heap_idx == num_heaps);
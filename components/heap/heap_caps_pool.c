@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/param.h>
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_heap_caps_pool.h"
+
+/*
+  The free objects form a singly linked list (a Treiber stack). Each free object stores the
+  index of the next free one in its first word. The list head packs the index of the first
+  free object (plus one, so that 0 means empty) with a tag which changes on every update,
+  so a compare-and-swap cannot succeed on a head which was popped and pushed again in between.
+*/
+#define POOL_INDEX_MASK     0xffffU
+#define POOL_TAG_INCREMENT  0x10000U
+#define POOL_MAX_COUNT      POOL_INDEX_MASK
+
+struct heap_caps_pool {
+    uint32_t head;
+    uint32_t free_count;
+    uint32_t min_free_count;
+    size_t obj_size;
+    size_t count;
+    uint8_t *storage;
+};
+
+FORCE_INLINE_ATTR uint32_t *pool_obj(heap_caps_pool_handle_t pool, uint32_t index)
+{
+    return (uint32_t *)(pool->storage + (index - 1) * pool->obj_size);
+}
+
+FORCE_INLINE_ATTR uint32_t pool_next_head(uint32_t head, uint32_t index)
+{
+    return ((head + POOL_TAG_INCREMENT) & ~POOL_INDEX_MASK) | index;
+}
+
+heap_caps_pool_handle_t heap_caps_pool_create(size_t obj_size, size_t count, uint32_t caps)
+{
+    if (obj_size == 0 || count == 0 || count > POOL_MAX_COUNT) {
+        return NULL;
+    }
+    obj_size = (MAX(obj_size, sizeof(uint32_t)) + 3) & ~3;
+    if (obj_size > (SIZE_MAX - sizeof(struct heap_caps_pool)) / count) {
+        return NULL;
+    }
+
+    heap_caps_pool_handle_t pool = heap_caps_malloc(sizeof(struct heap_caps_pool) + obj_size * count, caps);
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->obj_size = obj_size;
+    pool->count = count;
+    pool->storage = (uint8_t *)&pool[1];
+    for (uint32_t index = 1; index < count; index++) {
+        *pool_obj(pool, index) = index + 1;
+    }
+    *pool_obj(pool, count) = 0;
+    pool->head = 1;
+    pool->free_count = count;
+    pool->min_free_count = count;
+    return pool;
+}
+
+void heap_caps_pool_delete(heap_caps_pool_handle_t pool)
+{
+    heap_caps_free(pool);
+}
+
+HEAP_IRAM_ATTR void *heap_caps_pool_alloc(heap_caps_pool_handle_t pool)
+{
+    assert(pool != NULL);
+
+    uint32_t head = __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE);
+    uint32_t *obj;
+    do {
+        uint32_t index = head & POOL_INDEX_MASK;
+        if (index == 0) {
+            return NULL;
+        }
+        obj = pool_obj(pool, index);
+        // If another context takes this object first, the link read here is garbage, but the head
+        // tag has changed and the exchange below fails.
+        uint32_t next = __atomic_load_n(obj, __ATOMIC_RELAXED) & POOL_INDEX_MASK;
+        if (__atomic_compare_exchange_n(&pool->head, &head, pool_next_head(head, next), true,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+    } while (true);
+
+    uint32_t free_count = __atomic_sub_fetch(&pool->free_count, 1, __ATOMIC_RELAXED);
+    uint32_t min_free_count = __atomic_load_n(&pool->min_free_count, __ATOMIC_RELAXED);
+    while (free_count < min_free_count &&
+           !__atomic_compare_exchange_n(&pool->min_free_count, &min_free_count, free_count, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+    return obj;
+}
+
+HEAP_IRAM_ATTR void heap_caps_pool_free(heap_caps_pool_handle_t pool, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    assert(pool != NULL);
+
+    size_t offset = (uint8_t *)ptr - pool->storage;
+    assert((uint8_t *)ptr >= pool->storage && offset < pool->obj_size * pool->count &&
+           offset % pool->obj_size == 0 && "pointer does not belong to this pool");
+    uint32_t index = offset / pool->obj_size + 1;
+    uint32_t *obj = ptr;
+
+    // Count the object as free before publishing it, so that a concurrent allocation of it can never
+    // make the counter drop below zero.
+    __atomic_add_fetch(&pool->free_count, 1, __ATOMIC_RELAXED);
+
+    uint32_t head = __atomic_load_n(&pool->head, __ATOMIC_RELAXED);
+    do {
+        __atomic_store_n(obj, head & POOL_INDEX_MASK, __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&pool->head, &head, pool_next_head(head, index), true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+void heap_caps_pool_get_info(heap_caps_pool_handle_t pool, multi_heap_info_t *info)
+{
+    assert(pool != NULL && info != NULL);
+
+    // a free in progress may count its object twice for a moment
+    size_t free_count = MIN(__atomic_load_n(&pool->free_count, __ATOMIC_RELAXED), pool->count);
+    size_t min_free_count = __atomic_load_n(&pool->min_free_count, __ATOMIC_RELAXED);
+
+    memset(info, 0, sizeof(multi_heap_info_t));
+    info->total_free_bytes = free_count * pool->obj_size;
+    info->total_allocated_bytes = (pool->count - free_count) * pool->obj_size;
+    info->largest_free_block = free_count > 0 ? pool->obj_size : 0;
+    info->minimum_free_bytes = min_free_count * pool->obj_size;
+    info->allocated_blocks = pool->count - free_count;
+    info->free_blocks = free_count;
+    info->total_blocks = pool->count;
+}
@@ -12,6 +12,7 @@
 #include "multi_heap_platform.h"
 #include "sys/queue.h"
 #include "esp_attr.h"
+#include "esp_heap_caps.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -64,6 +65,14 @@ FORCE_INLINE_ATTR uint32_t get_all_caps(const heap_t *heap)
     return get_ored_caps(heap->caps);
 }
 
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+/* Arenas only serve the allocations hinted with MALLOC_CAP_SHORT_LIVED, unless no other heap can serve an allocation */
+FORCE_INLINE_ATTR bool heap_is_short_lived_arena(const heap_t *heap)
+{
+    return (get_all_caps(heap) & MALLOC_CAP_SHORT_LIVED) != 0;
+}
+#endif
+
 /* Find the heap which belongs to ptr, or return NULL if it's
    not in any heap.
 
@@ -95,6 +104,35 @@ void *heap_caps_calloc_base(size_t n, size_t size, uint32_t caps);
 void *heap_caps_malloc_base(size_t size, uint32_t caps);
 void *heap_caps_aligned_alloc_base(size_t alignment, size_t size, uint32_t caps);
 
+#if CONFIG_HEAP_PER_CORE_CACHE
+/* Per-core cache of small blocks, see heap_caps_cache.c */
+
+/* Return the cache size class serving an allocation, or -1 if the allocation is not cacheable */
+int heap_caps_cache_class(size_t size, size_t alignment, uint32_t caps);
+
+/* Take a block of the given class from the calling core's cache, or return NULL if it is empty */
+void *heap_caps_cache_alloc(int class);
+
+/* Allocate a block of the given class from the heap, and a batch of more blocks for the calling core's cache */
+void *heap_caps_cache_refill(int class, uint32_t caps);
+
+/* Keep a freed block in the calling core's cache. Returns false if the block is not cacheable. */
+bool heap_caps_cache_free(heap_t *heap, void *p);
+
+/* Give all cached blocks of all cores back to their heaps. Returns true if there were any. */
+bool heap_caps_cache_drain(void);
+#endif
+
+#if CONFIG_HEAP_PROFILER
+/* Sampling allocation profiler, see heap_profiler.c */
+
+/* Account an allocation of size bytes returned to the application at ptr */
+void heap_profiler_record_alloc(void *ptr, size_t size);
+
+/* Account the free of a block returned to the application at ptr */
+void heap_profiler_record_free(void *ptr);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
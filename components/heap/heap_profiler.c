@@ -0,0 +1,455 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+  Sampling allocation profiler.
+
+  Each core counts down the bytes allocated on it, and samples the allocation which
+  reaches zero. The countdown is then restarted from an exponentially distributed
+  interval whose mean is the sampling period, so that each byte has the same
+  probability to be sampled (this is what pprof assumes for "heap_v2" profiles).
+  Allocations which are not sampled only pay for the countdown.
+
+  A sample records the backtrace of the allocation into a table of callsites, and the
+  pointer into a table of live samples, so that its free can be accounted to the callsite.
+  Frees look up a small counting filter without the lock first: most freed blocks were
+  never sampled and are discarded there.
+*/
+
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_macros.h"
+#include "soc/soc_memory_layout.h"
+#include "multi_heap.h"
+#include "multi_heap_platform.h"
+#include "esp_heap_profiler.h"
+#include "heap_private.h"
+
+#define PROFILER_DEPTH          CONFIG_HEAP_PROFILER_STACK_DEPTH
+#define PROFILER_CALLSITES      CONFIG_HEAP_PROFILER_CALLSITES
+#define PROFILER_LIVE_SAMPLES   CONFIG_HEAP_PROFILER_LIVE_SAMPLES
+/* Open addressing tables are kept at most half full */
+#define CALLSITE_SLOTS          (2 * PROFILER_CALLSITES)
+#define LIVE_SLOTS              (2 * PROFILER_LIVE_SAMPLES)
+#define FILTER_SIZE             (8 * PROFILER_LIVE_SAMPLES)
+#define FILTER_SATURATED        UINT8_MAX
+
+ESP_STATIC_ASSERT((PROFILER_CALLSITES & (PROFILER_CALLSITES - 1)) == 0, "CONFIG_HEAP_PROFILER_CALLSITES must be a power of 2");
+ESP_STATIC_ASSERT((PROFILER_LIVE_SAMPLES & (PROFILER_LIVE_SAMPLES - 1)) == 0, "CONFIG_HEAP_PROFILER_LIVE_SAMPLES must be a power of 2");
+ESP_STATIC_ASSERT(PROFILER_CALLSITES < UINT16_MAX, "callsite indexes are 16 bits");
+
+typedef struct {
+    void *ptr;              /* NULL if the slot is free */
+    uint32_t size;
+    uint16_t callsite;
+} live_sample_t;
+
+typedef struct {
+    uint32_t bytes_left;    /* bytes to allocate on this core before the next sample */
+    uint32_t seed;          /* state of the random generator of the intervals */
+} core_sampler_t;
+
+typedef struct {
+    multi_heap_lock_t lock;
+    volatile bool enabled;
+    size_t sample_period;
+    uint32_t samples;
+    uint32_t dropped;
+    size_t callsite_count;
+    volatile size_t live_count;
+    core_sampler_t cores[CONFIG_FREERTOS_NUMBER_OF_CORES];
+    uint16_t callsite_slots[CALLSITE_SLOTS];    /* index + 1 in callsites, 0 if the slot is free */
+    uint32_t callsite_hashes[PROFILER_CALLSITES];
+    heap_profiler_callsite_t callsites[PROFILER_CALLSITES];
+    live_sample_t live[LIVE_SLOTS];
+    /* Number of live samples whose pointer hashes to each entry, read without the lock by the frees.
+       A saturated entry is never decremented again, it only makes the frees take the lock. */
+    volatile uint8_t filter[FILTER_SIZE];
+} heap_profiler_t;
+
+static heap_profiler_t s_profiler = {
+    .lock = MULTI_HEAP_LOCK_STATIC_INITIALIZER,
+};
+
+/* Skip the frames of get_call_stack() and record_sample(): the backtraces begin in the allocation functions,
+   which pprof recognizes and drops */
+#define STACK_OFFSET  2
+
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+#define HEAP_ARCH_INVALID_PC  0x40000000
+
+#define TEST_STACK(N) do {                                              \
+        if (PROFILER_DEPTH == N) {                                      \
+            return;                                                     \
+        }                                                               \
+        pcs[N] = __builtin_return_address(N + STACK_OFFSET);            \
+        if (!esp_ptr_executable(pcs[N])                                 \
+            || pcs[N] == (void *) HEAP_ARCH_INVALID_PC) {               \
+            pcs[N] = NULL;                                              \
+            return;                                                     \
+        }                                                               \
+    } while(0)
+
+/* __builtin_return_address() needs a constant argument, so the walk is unrolled */
+static HEAP_IRAM_ATTR __attribute__((noinline)) void get_call_stack(void **pcs)
+{
+    memset(pcs, 0, sizeof(void *) * PROFILER_DEPTH);
+    TEST_STACK(0);
+    TEST_STACK(1);
+    TEST_STACK(2);
+    TEST_STACK(3);
+    TEST_STACK(4);
+    TEST_STACK(5);
+    TEST_STACK(6);
+    TEST_STACK(7);
+    TEST_STACK(8);
+    TEST_STACK(9);
+    TEST_STACK(10);
+    TEST_STACK(11);
+    TEST_STACK(12);
+    TEST_STACK(13);
+    TEST_STACK(14);
+    TEST_STACK(15);
+}
+
+#else // !CONFIG_IDF_TARGET_ARCH_XTENSA
+
+extern uint32_t esp_fp_get_callers(uint32_t frame, void** callers, void** stacks, uint32_t depth);
+
+static HEAP_IRAM_ATTR __attribute__((noinline)) void get_call_stack(void **pcs)
+{
+    void *callers[PROFILER_DEPTH + STACK_OFFSET] = { 0 };
+    /* The first caller is the return address of get_call_stack() */
+    esp_fp_get_callers((uint32_t) __builtin_frame_address(0), callers, NULL, PROFILER_DEPTH + STACK_OFFSET);
+    memcpy(pcs, &callers[STACK_OFFSET], sizeof(void *) * PROFILER_DEPTH);
+}
+
+#endif
+
+ESP_STATIC_ASSERT(PROFILER_DEPTH >= 1 && PROFILER_DEPTH <= 16, "CONFIG_HEAP_PROFILER_STACK_DEPTH must be in range 1-16");
+
+FORCE_INLINE_ATTR uint32_t hash_ptr(const void *ptr)
+{
+    /* Fibonacci hashing, the blocks are at least 4-byte aligned */
+    return ((uint32_t)ptr >> 2) * 2654435761U;
+}
+
+FORCE_INLINE_ATTR size_t filter_index(const void *ptr)
+{
+    return (hash_ptr(ptr) >> 16) & (FILTER_SIZE - 1);
+}
+
+static HEAP_IRAM_ATTR uint32_t hash_call_stack(void *const *pcs)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+    for (int i = 0; i < PROFILER_DEPTH; i++) {
+        hash = (hash ^ (uint32_t)pcs[i]) * 16777619U;
+    }
+    return hash;
+}
+
+/* Exponentially distributed interval with a mean of the sampling period.
+   -ln(u) = (32 - log2(r)) * ln(2) for u = r / 2^32, log2() uses a linear approximation of the mantissa,
+   offset by its mean error so that the mean interval is unbiased. */
+#define LOG2_LINEAR_ERROR_Q16   3755    /* mean of log2(1 + m) - m over [0, 1) */
+
+static HEAP_IRAM_ATTR uint32_t next_interval(core_sampler_t *core, size_t period)
+{
+    /* xorshift32 */
+    uint32_t r = core->seed;
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    core->seed = r;
+
+    int msb = 31;
+    while ((r & (1U << msb)) == 0) {
+        msb--;
+    }
+    uint32_t mantissa = msb >= 16 ? r >> (msb - 16) : r << (16 - msb);
+    uint32_t log2_q16 = (((uint32_t)msb << 16) | (mantissa & 0xffff)) + LOG2_LINEAR_ERROR_Q16;
+    uint32_t neg_log2_q16 = log2_q16 < (32U << 16) ? (32U << 16) - log2_q16 : 0;
+    /* ln(2) = 45426 / 2^16 */
+    uint64_t interval = ((uint64_t)period * neg_log2_q16 * 45426) >> 32;
+    return interval > 0 ? (uint32_t)interval : 1;
+}
+
+/* Must be called with the lock taken. Returns the index of the callsite, or -1 if the table is full. */
+static HEAP_IRAM_ATTR int find_or_add_callsite(void *const *pcs, uint32_t hash)
+{
+    size_t slot = hash & (CALLSITE_SLOTS - 1);
+    while (s_profiler.callsite_slots[slot] != 0) {
+        int index = s_profiler.callsite_slots[slot] - 1;
+        if (s_profiler.callsite_hashes[index] == hash &&
+                memcmp(s_profiler.callsites[index].pcs, pcs, sizeof(void *) * PROFILER_DEPTH) == 0) {
+            return index;
+        }
+        slot = (slot + 1) & (CALLSITE_SLOTS - 1);
+    }
+    if (s_profiler.callsite_count == PROFILER_CALLSITES) {
+        return -1;
+    }
+    int index = s_profiler.callsite_count++;
+    heap_profiler_callsite_t *callsite = &s_profiler.callsites[index];
+    memcpy(callsite->pcs, pcs, sizeof(void *) * PROFILER_DEPTH);
+    callsite->alloc_count = 0;
+    callsite->alloc_bytes = 0;
+    callsite->live_count = 0;
+    callsite->live_bytes = 0;
+    s_profiler.callsite_hashes[index] = hash;
+    s_profiler.callsite_slots[slot] = index + 1;
+    return index;
+}
+
+/* Must be called with the lock taken. Returns the slot of ptr, or -1 if it is not a live sample. */
+static HEAP_IRAM_ATTR int find_live_sample(const void *ptr)
+{
+    size_t slot = hash_ptr(ptr) & (LIVE_SLOTS - 1);
+    while (s_profiler.live[slot].ptr != NULL) {
+        if (s_profiler.live[slot].ptr == ptr) {
+            return slot;
+        }
+        slot = (slot + 1) & (LIVE_SLOTS - 1);
+    }
+    return -1;
+}
+
+/* Must be called with the lock taken, the table must not be full */
+static HEAP_IRAM_ATTR void add_live_sample(void *ptr, uint32_t size, int callsite)
+{
+    size_t slot = hash_ptr(ptr) & (LIVE_SLOTS - 1);
+    while (s_profiler.live[slot].ptr != NULL) {
+        slot = (slot + 1) & (LIVE_SLOTS - 1);
+    }
+    s_profiler.live[slot] = (live_sample_t) {
+        .ptr = ptr,
+        .size = size,
+        .callsite = callsite,
+    };
+    s_profiler.live_count++;
+    size_t index = filter_index(ptr);
+    if (s_profiler.filter[index] != FILTER_SATURATED) {
+        s_profiler.filter[index]++;
+    }
+}
+
+/* Must be called with the lock taken. Removes the sample with backward shift deletion, so that no tombstones are needed. */
+static HEAP_IRAM_ATTR void remove_live_sample(int slot)
+{
+    size_t index = filter_index(s_profiler.live[slot].ptr);
+    if (s_profiler.filter[index] != FILTER_SATURATED) {
+        s_profiler.filter[index]--;
+    }
+    s_profiler.live_count--;
+
+    size_t hole = slot;
+    size_t next = (hole + 1) & (LIVE_SLOTS - 1);
+    while (s_profiler.live[next].ptr != NULL) {
+        size_t home = hash_ptr(s_profiler.live[next].ptr) & (LIVE_SLOTS - 1);
+        /* move the entry into the hole if its home slot is not in (hole, next] */
+        if (((next - home) & (LIVE_SLOTS - 1)) >= ((next - hole) & (LIVE_SLOTS - 1))) {
+            s_profiler.live[hole] = s_profiler.live[next];
+            hole = next;
+        }
+        next = (next + 1) & (LIVE_SLOTS - 1);
+    }
+    s_profiler.live[hole].ptr = NULL;
+}
+
+static HEAP_IRAM_ATTR __attribute__((noinline)) void record_sample(void *ptr, size_t size)
+{
+    void *pcs[PROFILER_DEPTH];
+    get_call_stack(pcs);
+    uint32_t hash = hash_call_stack(pcs);
+
+    MULTI_HEAP_LOCK(&s_profiler.lock);
+    if (s_profiler.enabled) {
+        s_profiler.samples++;
+        int index = -1;
+        if (s_profiler.live_count < PROFILER_LIVE_SAMPLES) {
+            index = find_or_add_callsite(pcs, hash);
+        }
+        if (index >= 0) {
+            heap_profiler_callsite_t *callsite = &s_profiler.callsites[index];
+            callsite->alloc_count++;
+            callsite->alloc_bytes += size;
+            callsite->live_count++;
+            callsite->live_bytes += size;
+            add_live_sample(ptr, size, index);
+        } else {
+            s_profiler.dropped++;
+        }
+    }
+    MULTI_HEAP_UNLOCK(&s_profiler.lock);
+}
+
+HEAP_IRAM_ATTR void heap_profiler_record_alloc(void *ptr, size_t size)
+{
+    if (!s_profiler.enabled) {
+        return;
+    }
+
+    bool sample = false;
+    uint32_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    core_sampler_t *core = &s_profiler.cores[xPortGetCoreID()];
+    if (size >= core->bytes_left) {
+        core->bytes_left = next_interval(core, s_profiler.sample_period);
+        sample = true;
+    } else {
+        core->bytes_left -= size;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+
+    if (sample) {
+        record_sample(ptr, size);
+    }
+}
+
+HEAP_IRAM_ATTR void heap_profiler_record_free(void *ptr)
+{
+    /* Frees are accounted even when the profiler is stopped, so that the live samples stay accurate */
+    if (s_profiler.live_count == 0 || s_profiler.filter[filter_index(ptr)] == 0) {
+        return;
+    }
+
+    MULTI_HEAP_LOCK(&s_profiler.lock);
+    int slot = find_live_sample(ptr);
+    if (slot >= 0) {
+        heap_profiler_callsite_t *callsite = &s_profiler.callsites[s_profiler.live[slot].callsite];
+        callsite->live_count--;
+        callsite->live_bytes -= s_profiler.live[slot].size;
+        remove_live_sample(slot);
+    }
+    MULTI_HEAP_UNLOCK(&s_profiler.lock);
+}
+
+esp_err_t heap_profiler_start(size_t sample_period)
+{
+    if (sample_period == 0 || sample_period > UINT32_MAX / 32) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    MULTI_HEAP_LOCK(&s_profiler.lock);
+    if (s_profiler.enabled) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        s_profiler.sample_period = sample_period;
+        s_profiler.samples = 0;
+        s_profiler.dropped = 0;
+        s_profiler.callsite_count = 0;
+        s_profiler.live_count = 0;
+        memset(s_profiler.callsite_slots, 0, sizeof(s_profiler.callsite_slots));
+        memset(s_profiler.live, 0, sizeof(s_profiler.live));
+        memset((void *)s_profiler.filter, 0, sizeof(s_profiler.filter));
+        uint32_t seed = esp_cpu_get_cycle_count() | 1;
+        for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+            s_profiler.cores[i].seed = seed + i * 2;
+            s_profiler.cores[i].bytes_left = next_interval(&s_profiler.cores[i], sample_period);
+        }
+        s_profiler.enabled = true;
+    }
+    MULTI_HEAP_UNLOCK(&s_profiler.lock);
+    return ret;
+}
+
+esp_err_t heap_profiler_stop(void)
+{
+    esp_err_t ret = ESP_OK;
+    MULTI_HEAP_LOCK(&s_profiler.lock);
+    if (!s_profiler.enabled) {
+        ret = ESP_ERR_INVALID_STATE;
+    }
+    s_profiler.enabled = false;
+    MULTI_HEAP_UNLOCK(&s_profiler.lock);
+    return ret;
+}
+
+esp_err_t heap_profiler_get_stats(heap_profiler_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    MULTI_HEAP_LOCK(&s_profiler.lock);
+    *stats = (heap_profiler_stats_t) {
+        .sample_period = s_profiler.sample_period,
+        .samples = s_profiler.samples,
+        .dropped = s_profiler.dropped,
+        .callsites = s_profiler.callsite_count,
+        .live_samples = s_profiler.live_count,
+    };
+    MULTI_HEAP_UNLOCK(&s_profiler.lock);
+    return ESP_OK;
+}
+
+/* Copy a callsite out of the lock, returns false past the last one */
+static bool get_callsite(size_t index, heap_profiler_callsite_t *callsite)
+{
+    bool found = false;
+    MULTI_HEAP_LOCK(&s_profiler.lock);
+    if (index < s_profiler.callsite_count) {
+        *callsite = s_profiler.callsites[index];
+        found = true;
+    }
+    MULTI_HEAP_UNLOCK(&s_profiler.lock);
+    return found;
+}
+
+esp_err_t heap_profiler_get_callsites(heap_profiler_callsite_t *callsites, size_t *count)
+{
+    if (callsites == NULL || count == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t n = 0;
+    while (n < *count && get_callsite(n, &callsites[n])) {
+        n++;
+    }
+    *count = n;
+    return ESP_OK;
+}
+
+esp_err_t heap_profiler_dump_pprof(FILE *stream)
+{
+    if (stream == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    heap_profiler_callsite_t callsite;
+    heap_profiler_callsite_t total = { 0 };
+    heap_profiler_stats_t stats;
+    heap_profiler_get_stats(&stats);
+    for (size_t i = 0; get_callsite(i, &callsite); i++) {
+        total.alloc_count += callsite.alloc_count;
+        total.alloc_bytes += callsite.alloc_bytes;
+        total.live_count += callsite.live_count;
+        total.live_bytes += callsite.live_bytes;
+    }
+
+    /* Legacy text format of the gperftools heap profiler, with the counts of the samples only:
+       pprof scales them according to the sampling period given in the header */
+    fprintf(stream, "heap profile: %" PRIu32 ": %" PRIu32 " [%" PRIu32 ": %" PRIu32 "] @ heap_v2/%u\n",
+            total.live_count, total.live_bytes, total.alloc_count, total.alloc_bytes, (unsigned)stats.sample_period);
+    for (size_t i = 0; get_callsite(i, &callsite); i++) {
+        fprintf(stream, "%" PRIu32 ": %" PRIu32 " [%" PRIu32 ": %" PRIu32 "] @",
+                callsite.live_count, callsite.live_bytes, callsite.alloc_count, callsite.alloc_bytes);
+        for (int j = 0; j < PROFILER_DEPTH && callsite.pcs[j] != NULL; j++) {
+            fprintf(stream, " %p", callsite.pcs[j]);
+        }
+        fputc('\n', stream);
+    }
+    /* The addresses are those of the application ELF file, which pprof then symbolizes */
+    fprintf(stream, "\nMAPPED_LIBRARIES:\n00000000-ffffffffffffffff r-xp 00000000 00:00 0 app.elf\n");
+    return ferror(stream) ? ESP_FAIL : ESP_OK;
+}
@@ -47,6 +47,7 @@ extern "C" {
 #define MALLOC_CAP_DMA_DESC_AXI     (1<<18) ///< Memory must be capable of containing AXI DMA descriptors
 #define MALLOC_CAP_CACHE_ALIGNED    (1<<19) ///< Memory must be aligned to the cache line size of any intermediate caches
 #define MALLOC_CAP_SIMD             (1<<20) ///< Memory must be capable of being used for SIMD instructions (i.e. allow for SIMD-specific-bit data accesses)
+#define MALLOC_CAP_SHORT_LIVED      (1<<21) ///< Hint that the memory will be freed soon, see CONFIG_HEAP_SHORT_LIVED_ARENA. Does not restrict the memory returned.
 
 #define MALLOC_CAP_INVALID          (1<<31) ///< Memory can't be used / list end marker
 
@@ -272,7 +273,12 @@ esp_err_t heap_caps_monitor_local_minimum_free_size_stop(void);
  *
  * Calls multi_heap_info() on all heaps which share the given capabilities. The information returned is an aggregate
  * across all matching heaps. The meanings of fields are the same as defined for multi_heap_info_t, except that
- * ``minimum_free_bytes`` has the same caveats described in heap_caps_get_minimum_free_size().
+ * ``minimum_free_bytes`` has the same caveats described in heap_caps_get_minimum_free_size(), and ``fragmentation``
+ * compares the largest free block of all the heaps to the free bytes of all the heaps.
+ *
+ * The fragmentation rises when the free memory is broken up into blocks too small for the allocations the
+ * application needs, even though ``total_free_bytes`` stays high. Sample it periodically to follow its trend
+ * over the uptime of the device.
  *
  * @param info        Pointer to a structure which will be filled with relevant
  *                    heap metadata.
@@ -435,6 +441,15 @@ void heap_caps_dump(uint32_t caps);
  */
 void heap_caps_dump_all(void);
 
+/**
+ * @brief Give the blocks held in the per-core allocation caches back to their heaps
+ *
+ * With CONFIG_HEAP_PER_CORE_CACHE enabled, freed small blocks are kept in a per-core
+ * cache and still count as allocated. Call this before measuring free heap size, e.g.
+ * to check for memory leaks. Does nothing if the cache is disabled.
+ */
+void heap_caps_flush_cache(void);
+
 /**
  * @brief Return the size that a particular pointer was allocated with.
  *
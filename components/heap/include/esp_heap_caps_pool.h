@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "multi_heap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque handle to a pool of fixed-size objects
+ */
+typedef struct heap_caps_pool *heap_caps_pool_handle_t;
+
+/**
+ * @brief Create a pool of fixed-size objects
+ *
+ * The storage for all objects is allocated at once with heap_caps_malloc(). Allocating and
+ * freeing an object afterwards does not touch the heap: both are lock-free, take constant
+ * time and can be called from any task or ISR.
+ *
+ * To use the pool from an ISR which runs while the cache is disabled, `caps` must include
+ * MALLOC_CAP_INTERNAL and CONFIG_HEAP_PLACE_FUNCTION_INTO_FLASH must be disabled.
+ *
+ * @param obj_size Size of each object in bytes. Objects are aligned to 4 bytes.
+ * @param count    Number of objects in the pool, at most 65535
+ * @param caps     Bitwise OR of MALLOC_CAP_* flags for the memory backing the pool
+ *
+ * @return Handle to the pool, or NULL if the arguments are invalid or there is not enough memory
+ */
+heap_caps_pool_handle_t heap_caps_pool_create(size_t obj_size, size_t count, uint32_t caps);
+
+/**
+ * @brief Delete a pool and free its storage
+ *
+ * All objects of the pool become invalid. The pool must not be in use by any other task or ISR.
+ *
+ * @param pool Pool to delete. NULL is ignored.
+ */
+void heap_caps_pool_delete(heap_caps_pool_handle_t pool);
+
+/**
+ * @brief Take an object from a pool
+ *
+ * @param pool Pool to allocate from
+ *
+ * @return Pointer to an object of the pool's object size, or NULL if all objects are in use
+ */
+void *heap_caps_pool_alloc(heap_caps_pool_handle_t pool);
+
+/**
+ * @brief Give an object back to its pool
+ *
+ * @param pool Pool the object was taken from
+ * @param ptr  Object returned by heap_caps_pool_alloc() for the same pool. NULL is ignored.
+ */
+void heap_caps_pool_free(heap_caps_pool_handle_t pool, void *ptr);
+
+/**
+ * @brief Get usage statistics of a pool
+ *
+ * The fields are filled in the same way as heap_caps_get_info() does for a heap, with every
+ * object counted as one block of the pool's object size. The storage of the pool itself is
+ * reported as allocated by heap_caps_get_info().
+ *
+ * @param pool Pool to query
+ * @param info Pointer to a structure which will be filled with the statistics
+ */
+void heap_caps_pool_get_info(heap_caps_pool_handle_t pool, multi_heap_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !CONFIG_HEAP_PROFILER
+#define CONFIG_HEAP_PROFILER_STACK_DEPTH 1
+#endif
+
+/**
+ * @brief Statistics of the profiler
+ */
+typedef struct {
+    size_t sample_period;   ///< Mean number of bytes allocated between two samples
+    uint32_t samples;       ///< Number of samples taken since the profiler started
+    uint32_t dropped;       ///< Number of samples not recorded because the callsite or live sample tables were full
+    size_t callsites;       ///< Number of allocation callsites recorded
+    size_t live_samples;    ///< Number of sampled blocks not freed yet
+} heap_profiler_stats_t;
+
+/**
+ * @brief Samples aggregated for one allocation callsite
+ *
+ * The counts are those of the samples: multiply the bytes by about sample_period / size of the samples
+ * to estimate the number of allocations of the callsite, as pprof does.
+ */
+typedef struct {
+    void *pcs[CONFIG_HEAP_PROFILER_STACK_DEPTH];    ///< Backtrace of the allocations, from the allocation functions, NULL terminated if shorter
+    uint32_t alloc_count;   ///< Number of sampled allocations
+    uint32_t alloc_bytes;   ///< Bytes of the sampled allocations
+    uint32_t live_count;    ///< Number of sampled allocations not freed yet
+    uint32_t live_bytes;    ///< Bytes of the sampled allocations not freed yet
+} heap_profiler_callsite_t;
+
+/**
+ * @brief Start sampling the allocations
+ *
+ * The previous profile is cleared. On average, one allocation is sampled every sample_period bytes allocated,
+ * so that big allocations are more likely to be sampled than small ones. Sampled allocations are recorded with
+ * their backtrace, and their frees are accounted until the profile is cleared, even when the profiler is stopped.
+ *
+ * @param sample_period Mean number of bytes allocated between two samples, e.g. 4096. Smaller periods give
+ *                      more accurate profiles but fill the tables faster.
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG if sample_period is 0 or above UINT32_MAX / 32
+ *  - ESP_ERR_INVALID_STATE if the profiler is already running
+ */
+esp_err_t heap_profiler_start(size_t sample_period);
+
+/**
+ * @brief Stop sampling the allocations
+ *
+ * The profile is kept and can still be read.
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_STATE if the profiler is not running
+ */
+esp_err_t heap_profiler_stop(void);
+
+/**
+ * @brief Get the statistics of the profiler
+ *
+ * @param[out] stats Statistics
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG if stats is NULL
+ */
+esp_err_t heap_profiler_get_stats(heap_profiler_stats_t *stats);
+
+/**
+ * @brief Get the allocation callsites recorded by the profiler
+ *
+ * @param[out]    callsites Array receiving the callsites
+ * @param[in,out] count     Size of the array in entries, set to the number of callsites copied
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG if an argument is NULL
+ */
+esp_err_t heap_profiler_get_callsites(heap_profiler_callsite_t *callsites, size_t *count);
+
+/**
+ * @brief Print the profile in the text format of the gperftools heap profiler
+ *
+ * The profile can be read by pprof with the ELF file of the application to symbolize the addresses, e.g.
+ * ``pprof -sample_index=inuse_space -top build/app.elf heap.prof`` ranks the callsites holding the most memory
+ * (e.g. leaks), and ``-sample_index=alloc_space`` those allocating the most.
+ *
+ * @param stream Stream to print to, e.g. stdout or a file
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG if stream is NULL
+ *  - ESP_FAIL if the stream reported an error
+ */
+esp_err_t heap_profiler_dump_pprof(FILE *stream);
+
+#ifdef __cplusplus
+}
+#endif
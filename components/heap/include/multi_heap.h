@@ -168,6 +168,7 @@ typedef struct {
     size_t allocated_blocks;      ///<  Number of (variable size) blocks allocated in the heap.
     size_t free_blocks;           ///<  Number of (variable size) free blocks in the heap.
     size_t total_blocks;          ///<  Total number of (variable size) blocks in the heap.
+    size_t fragmentation;         ///<  Fragmentation of the free memory in percent: 100 * (1 - largest_free_block / total_free_bytes), 0 if nothing is free.
 } multi_heap_info_t;
 
 /** @brief Return metadata about a given heap
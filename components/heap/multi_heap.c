@@ -429,6 +429,7 @@ void multi_heap_get_info_impl(multi_heap_handle_t heap, multi_heap_info_t *info)
     info->minimum_free_bytes = heap->minimum_free_bytes;
     info->total_free_bytes = heap->free_bytes;
     info->largest_free_block = tlsf_fit_size(heap->heap_data, info->largest_free_block);
+    info->fragmentation = multi_heap_fragmentation(info->largest_free_block, info->total_free_bytes);
     multi_heap_internal_unlock(heap);
 }
 
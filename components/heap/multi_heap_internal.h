@@ -5,6 +5,9 @@
  */
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 /* Define a noclone attribute when compiled with GCC as certain functions
  * in the heap component should not be cloned by the compiler */
 #if defined __has_attribute && __has_attribute(noclone)
@@ -57,6 +60,15 @@ size_t multi_heap_minimum_free_size_impl(multi_heap_handle_t heap);
 size_t multi_heap_get_allocated_size_impl(multi_heap_handle_t heap, void *p);
 void *multi_heap_get_block_address_impl(multi_heap_block_handle_t block);
 
+/* Fragmentation of the free memory in percent, see multi_heap_info_t */
+static inline size_t multi_heap_fragmentation(size_t largest_free_block, size_t total_free_bytes)
+{
+    if (total_free_bytes == 0 || largest_free_block >= total_free_bytes) {
+        return 0;
+    }
+    return 100 - (size_t)(((uint64_t)largest_free_block * 100) / total_free_bytes);
+}
+
 /* Some internal functions for heap poisoning use */
 
 /* Check an allocated block's poison bytes are correct. Called by multi_heap_check(). */
@@ -67,6 +79,12 @@ bool multi_heap_internal_check_block_poisoning(void *start, size_t size, bool is
 */
 void multi_heap_internal_poison_fill_region(void *start, size_t size, bool is_free);
 
+/* Check the poison bytes of the allocated block 'p' and move its tail canary so it looks like a block of
+   'size' bytes. 'size' must not exceed the usable size of the block. Used by the per-core heap cache when
+   it keeps a freed block to hand out again. Returns false if the block is corrupt.
+*/
+bool multi_heap_internal_repoison_block(void *p, size_t size);
+
 /* Allow heap poisoning to lock/unlock the heap to avoid race conditions
    if multi_heap_check() is running concurrently.
 */
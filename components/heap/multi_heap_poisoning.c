@@ -403,6 +403,7 @@ void multi_heap_get_info(multi_heap_handle_t heap, multi_heap_info_t *info)
        a block this big may be available. */
     subtract_poison_overhead(&info->total_free_bytes);
     subtract_poison_overhead(&info->minimum_free_bytes);
+    info->fragmentation = multi_heap_fragmentation(info->largest_free_block, info->total_free_bytes);
 }
 
 size_t multi_heap_free_size(multi_heap_handle_t heap)
@@ -450,6 +451,16 @@ void multi_heap_internal_poison_fill_region(void *start, size_t size, bool is_fr
     memset(start, is_free ? FREE_FILL_PATTERN : MALLOC_FILL_PATTERN, size);
 }
 
+bool multi_heap_internal_repoison_block(void *p, size_t size)
+{
+    poison_head_t *head = verify_allocated_region(p, true);
+    if (head == NULL) {
+        return false;
+    }
+    poison_allocated_region(head, size);
+    return true;
+}
+
 #else // !MULTI_HEAP_POISONING
 
 #ifdef MULTI_HEAP_POISONING_SLOW
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include "unity.h"
+#include "stdio.h"
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+
+// This test only apply when the per-core cache is enabled
+#if CONFIG_HEAP_PER_CORE_CACHE
+
+TEST_CASE("per-core cache hands out the last freed block of a size class", "[heap][cache]")
+{
+    uint8_t *a = malloc(40);
+    TEST_ASSERT_NOT_NULL(a);
+    memset(a, 0xaa, 40);
+    free(a);
+
+    // 33 to 64 bytes share a size class
+    uint8_t *b = malloc(50);
+    TEST_ASSERT_EQUAL_PTR(a, b);
+    // the whole size class is usable
+    memset(b, 0xbb, 64);
+    free(b);
+
+    TEST_ASSERT_TRUE(heap_caps_check_integrity_all(true));
+    heap_caps_flush_cache();
+}
+
+TEST_CASE("per-core cache blocks count as allocated until flushed", "[heap][cache]")
+{
+    void *blocks[CONFIG_HEAP_PER_CORE_CACHE_DEPTH];
+
+    heap_caps_flush_cache();
+    size_t before = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    for (int i = 0; i < CONFIG_HEAP_PER_CORE_CACHE_DEPTH; i++) {
+        blocks[i] = malloc(100);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    for (int i = 0; i < CONFIG_HEAP_PER_CORE_CACHE_DEPTH; i++) {
+        free(blocks[i]);
+    }
+    TEST_ASSERT_LESS_THAN(before, heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+
+    heap_caps_flush_cache();
+    TEST_ASSERT_EQUAL(before, heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+}
+
+#define STRESS_ITERATIONS 2000
+#define STRESS_SLOTS 16
+
+static SemaphoreHandle_t s_stress_done;
+
+static void stress_task(void *arg)
+{
+    uint8_t *slots[STRESS_SLOTS] = { NULL };
+    uint32_t seed = (uint32_t)arg;
+
+    for (int i = 0; i < STRESS_ITERATIONS; i++) {
+        seed = seed * 1103515245 + 12345;
+        int slot = (seed >> 16) % STRESS_SLOTS;
+        if (slots[slot] != NULL) {
+            size_t len = slots[slot][0];
+            for (size_t j = 1; j < len; j++) {
+                TEST_ASSERT_EQUAL_HEX8((uint8_t)(len + slot), slots[slot][j]);
+            }
+            free(slots[slot]);
+            slots[slot] = NULL;
+        } else {
+            size_t len = 1 + (seed >> 8) % 255;
+            slots[slot] = malloc(len);
+            TEST_ASSERT_NOT_NULL(slots[slot]);
+            slots[slot][0] = len;
+            memset(&slots[slot][1], (uint8_t)(len + slot), len - 1);
+        }
+    }
+    for (int i = 0; i < STRESS_SLOTS; i++) {
+        free(slots[i]);
+    }
+    xSemaphoreGive(s_stress_done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("per-core cache stays consistent when used from all cores", "[heap][cache]")
+{
+    s_stress_done = xSemaphoreCreateCounting(CONFIG_FREERTOS_NUMBER_OF_CORES * 2, 0);
+    TEST_ASSERT_NOT_NULL(s_stress_done);
+
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES * 2; i++) {
+        // two tasks per core, and one of them may migrate between cores
+        BaseType_t core = (i == 0) ? tskNO_AFFINITY : i % CONFIG_FREERTOS_NUMBER_OF_CORES;
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(stress_task, "cache_stress", 4096, (void *)(i + 1),
+                                                          UNITY_FREERTOS_PRIORITY - 1, NULL, core));
+    }
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES * 2; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(s_stress_done, pdMS_TO_TICKS(10000)));
+    }
+    vSemaphoreDelete(s_stress_done);
+    vTaskDelay(pdMS_TO_TICKS(10)); // let the idle tasks clean up the deleted tasks
+
+    TEST_ASSERT_TRUE(heap_caps_check_integrity_all(true));
+    heap_caps_flush_cache();
+}
+
+#endif // CONFIG_HEAP_PER_CORE_CACHE
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ Tests for the fixed-size object pool allocator.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_heap_caps_pool.h"
+#include "esp_memory_utils.h"
+
+#define POOL_OBJ_SIZE   30
+#define POOL_COUNT      10
+
+TEST_CASE("pool hands out each object once until it is freed", "[heap][pool]")
+{
+    uint8_t *objs[POOL_COUNT];
+    multi_heap_info_t info;
+
+    TEST_ASSERT_NULL(heap_caps_pool_create(0, POOL_COUNT, MALLOC_CAP_DEFAULT));
+    TEST_ASSERT_NULL(heap_caps_pool_create(POOL_OBJ_SIZE, 0, MALLOC_CAP_DEFAULT));
+
+    heap_caps_pool_handle_t pool = heap_caps_pool_create(POOL_OBJ_SIZE, POOL_COUNT, MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(pool);
+
+    for (int i = 0; i < POOL_COUNT; i++) {
+        objs[i] = heap_caps_pool_alloc(pool);
+        TEST_ASSERT_NOT_NULL(objs[i]);
+        TEST_ASSERT_TRUE(esp_ptr_internal(objs[i]));
+        TEST_ASSERT_EQUAL(0, (intptr_t)objs[i] % 4);
+        memset(objs[i], i, POOL_OBJ_SIZE);
+    }
+    TEST_ASSERT_NULL(heap_caps_pool_alloc(pool));
+
+    for (int i = 0; i < POOL_COUNT; i++) {
+        for (int j = 0; j < POOL_OBJ_SIZE; j++) {
+            TEST_ASSERT_EQUAL_UINT8(i, objs[i][j]);
+        }
+    }
+
+    heap_caps_pool_get_info(pool, &info);
+    TEST_ASSERT_EQUAL(POOL_COUNT, info.total_blocks);
+    TEST_ASSERT_EQUAL(POOL_COUNT, info.allocated_blocks);
+    TEST_ASSERT_EQUAL(0, info.free_blocks);
+    TEST_ASSERT_EQUAL(0, info.largest_free_block);
+    TEST_ASSERT_EQUAL(0, info.minimum_free_bytes);
+
+    heap_caps_pool_free(pool, objs[3]);
+    TEST_ASSERT_EQUAL_PTR(objs[3], heap_caps_pool_alloc(pool));
+
+    for (int i = 0; i < POOL_COUNT; i++) {
+        heap_caps_pool_free(pool, objs[i]);
+    }
+    heap_caps_pool_free(pool, NULL);
+
+    heap_caps_pool_get_info(pool, &info);
+    TEST_ASSERT_EQUAL(POOL_COUNT, info.free_blocks);
+    TEST_ASSERT_EQUAL(0, info.allocated_blocks);
+    TEST_ASSERT_EQUAL(0, info.minimum_free_bytes);
+    TEST_ASSERT_GREATER_OR_EQUAL(POOL_OBJ_SIZE, info.largest_free_block);
+
+    heap_caps_pool_delete(pool);
+}
+
+#define STRESS_ITERATIONS   10000
+#define STRESS_HELD         4
+
+static heap_caps_pool_handle_t s_stress_pool;
+static SemaphoreHandle_t s_stress_done;
+
+static void pool_stress_task(void *arg)
+{
+    uint32_t *held[STRESS_HELD];
+    int n_held = 0;
+    uint32_t tag = (uint32_t)arg;
+
+    for (int i = 0; i < STRESS_ITERATIONS; i++) {
+        if (n_held < STRESS_HELD && (i % 3) != 0) {
+            uint32_t *obj = heap_caps_pool_alloc(s_stress_pool);
+            if (obj != NULL) {
+                obj[0] = tag;
+                obj[1] = tag;
+                held[n_held++] = obj;
+            }
+        } else if (n_held > 0) {
+            uint32_t *obj = held[--n_held];
+            TEST_ASSERT_EQUAL_HEX32(tag, obj[0]);
+            TEST_ASSERT_EQUAL_HEX32(tag, obj[1]);
+            heap_caps_pool_free(s_stress_pool, obj);
+        }
+    }
+    while (n_held > 0) {
+        heap_caps_pool_free(s_stress_pool, held[--n_held]);
+    }
+    xSemaphoreGive(s_stress_done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("pool objects are never handed out twice under contention", "[heap][pool]")
+{
+    const int n_tasks = CONFIG_FREERTOS_NUMBER_OF_CORES * 2;
+    multi_heap_info_t info;
+
+    // fewer objects than the tasks want to hold, so the pool runs empty regularly
+    s_stress_pool = heap_caps_pool_create(2 * sizeof(uint32_t), STRESS_HELD * n_tasks / 2, MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(s_stress_pool);
+    s_stress_done = xSemaphoreCreateCounting(n_tasks, 0);
+    TEST_ASSERT_NOT_NULL(s_stress_done);
+
+    for (int i = 0; i < n_tasks; i++) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(pool_stress_task, "pool_stress", 4096, (void *)(0x1000 + i),
+                                                          UNITY_FREERTOS_PRIORITY - 1, NULL,
+                                                          i % CONFIG_FREERTOS_NUMBER_OF_CORES));
+    }
+    for (int i = 0; i < n_tasks; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(s_stress_done, pdMS_TO_TICKS(10000)));
+    }
+    vSemaphoreDelete(s_stress_done);
+    vTaskDelay(pdMS_TO_TICKS(10)); // let the idle tasks clean up the deleted tasks
+
+    heap_caps_pool_get_info(s_stress_pool, &info);
+    TEST_ASSERT_EQUAL(info.total_blocks, info.free_blocks);
+    heap_caps_pool_delete(s_stress_pool);
+}
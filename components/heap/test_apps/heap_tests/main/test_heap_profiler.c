@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include "unity.h"
+#include "stdio.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+
+// This test only apply when the heap profiler is enabled
+#if CONFIG_HEAP_PROFILER
+#include "esp_heap_profiler.h"
+
+#define TEST_LOOP_SIZE 76
+#define TEST_LEAK_SIZE 333
+
+static heap_profiler_callsite_t s_callsites[CONFIG_HEAP_PROFILER_CALLSITES];
+
+static NOINLINE_ATTR void *alloc_from_here(size_t size)
+{
+    return malloc(size);
+}
+
+static size_t get_callsites(void)
+{
+    size_t count = CONFIG_HEAP_PROFILER_CALLSITES;
+    TEST_ESP_OK(heap_profiler_get_callsites(s_callsites, &count));
+    return count;
+}
+
+TEST_CASE("heap profiler samples about one allocation per period", "[heap][profiler]")
+{
+    void *blocks[256];
+
+    // 256 * 76 bytes, about 19 samples with a period of 1 KB
+    TEST_ESP_OK(heap_profiler_start(1024));
+    for (int i = 0; i < 256; i++) {
+        blocks[i] = alloc_from_here(TEST_LOOP_SIZE);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    heap_profiler_stats_t stats;
+    TEST_ESP_OK(heap_profiler_get_stats(&stats));
+    TEST_ASSERT_EQUAL(1024, stats.sample_period);
+    TEST_ASSERT_GREATER_OR_EQUAL(4, stats.samples);
+    TEST_ASSERT_LESS_OR_EQUAL(40, stats.samples);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, stats.callsites);
+
+    for (int i = 0; i < 256; i++) {
+        free(blocks[i]);
+    }
+    TEST_ESP_OK(heap_profiler_stop());
+
+    // frees are accounted after the profiler stopped, all the samples of the loop are gone
+    size_t count = get_callsites();
+    uint32_t loop_allocs = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (s_callsites[i].alloc_bytes == s_callsites[i].alloc_count * TEST_LOOP_SIZE) {
+            loop_allocs += s_callsites[i].alloc_count;
+            TEST_ASSERT_EQUAL(0, s_callsites[i].live_count);
+            TEST_ASSERT_EQUAL(0, s_callsites[i].live_bytes);
+        }
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(4, loop_allocs);
+}
+
+TEST_CASE("heap profiler reports the live blocks of a callsite", "[heap][profiler]")
+{
+    void *blocks[3];
+
+    // with a period of 1 byte, all the allocations are sampled
+    TEST_ESP_OK(heap_profiler_start(1));
+    for (int i = 0; i < 3; i++) {
+        blocks[i] = alloc_from_here(TEST_LEAK_SIZE);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    free(blocks[0]);
+    free(blocks[2]);
+    TEST_ESP_OK(heap_profiler_stop());
+
+    size_t count = get_callsites();
+    const heap_profiler_callsite_t *leak = NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (s_callsites[i].alloc_bytes == 3 * TEST_LEAK_SIZE) {
+            leak = &s_callsites[i];
+        }
+    }
+    TEST_ASSERT_NOT_NULL(leak);
+    TEST_ASSERT_EQUAL(3, leak->alloc_count);
+    TEST_ASSERT_EQUAL(1, leak->live_count);
+    TEST_ASSERT_EQUAL(TEST_LEAK_SIZE, leak->live_bytes);
+    TEST_ASSERT_NOT_NULL(leak->pcs[0]);
+
+    free(blocks[1]);
+    count = get_callsites();
+    for (size_t i = 0; i < count; i++) {
+        if (s_callsites[i].alloc_bytes == 3 * TEST_LEAK_SIZE) {
+            TEST_ASSERT_EQUAL(0, s_callsites[i].live_count);
+        }
+    }
+}
+
+TEST_CASE("heap profiler prints a pprof heap profile", "[heap][profiler]")
+{
+    char *buf = NULL;
+    size_t len = 0;
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, heap_profiler_start(0));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, heap_profiler_stop());
+    TEST_ESP_OK(heap_profiler_start(256));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, heap_profiler_start(256));
+    void *p = alloc_from_here(4096);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ESP_OK(heap_profiler_stop());
+
+    FILE *stream = open_memstream(&buf, &len);
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ESP_OK(heap_profiler_dump_pprof(stream));
+    fclose(stream);
+    free(p);
+
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL(0, strncmp(buf, "heap profile: ", 14));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "@ heap_v2/256\n"));
+    // the 4 KB block is always sampled
+    TEST_ASSERT_NOT_NULL(strstr(buf, "1: 4096 [1: 4096] @ 0x"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\nMAPPED_LIBRARIES:\n"));
+    free(buf);
+}
+
+#endif // CONFIG_HEAP_PROFILER
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include "unity.h"
+#include "stdio.h"
+#include <stdlib.h>
+
+#include "esp_heap_caps.h"
+
+// This test only apply when the short-lived arena is enabled
+#if CONFIG_HEAP_SHORT_LIVED_ARENA
+
+TEST_CASE("short-lived allocations are served by the arena", "[heap][short-lived]")
+{
+    size_t arena_size = heap_caps_get_total_size(MALLOC_CAP_SHORT_LIVED);
+    TEST_ASSERT_GREATER_OR_EQUAL(CONFIG_HEAP_SHORT_LIVED_ARENA_SIZE - 1024, arena_size);
+    size_t arena_free = heap_caps_get_free_size(MALLOC_CAP_SHORT_LIVED);
+
+    void *p = heap_caps_malloc(64, MALLOC_CAP_8BIT | MALLOC_CAP_SHORT_LIVED);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_LESS_THAN(arena_free, heap_caps_get_free_size(MALLOC_CAP_SHORT_LIVED));
+    // a block reallocated with the hint stays in the arena
+    p = heap_caps_realloc(p, 96, MALLOC_CAP_8BIT | MALLOC_CAP_SHORT_LIVED);
+    TEST_ASSERT_NOT_NULL(p);
+    free(p);
+    TEST_ASSERT_EQUAL(arena_free, heap_caps_get_free_size(MALLOC_CAP_SHORT_LIVED));
+
+    // allocations without the hint, or larger than the limit, do not use the arena
+    p = heap_caps_malloc(64, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(p);
+    void *big = heap_caps_malloc(CONFIG_HEAP_SHORT_LIVED_MAX_ALLOC_SIZE + 4, MALLOC_CAP_8BIT | MALLOC_CAP_SHORT_LIVED);
+    TEST_ASSERT_NOT_NULL(big);
+    TEST_ASSERT_EQUAL(arena_free, heap_caps_get_free_size(MALLOC_CAP_SHORT_LIVED));
+    free(big);
+    free(p);
+}
+
+TEST_CASE("short-lived allocations fall back to the other heaps when the arena is full", "[heap][short-lived]")
+{
+    const size_t block_size = 256;
+    const size_t max_blocks = CONFIG_HEAP_SHORT_LIVED_ARENA_SIZE / block_size + 8;
+    void **blocks = calloc(max_blocks, sizeof(void *));
+    TEST_ASSERT_NOT_NULL(blocks);
+
+    size_t n = 0;
+    for (; n < max_blocks; n++) {
+        blocks[n] = heap_caps_malloc(block_size, MALLOC_CAP_8BIT | MALLOC_CAP_SHORT_LIVED);
+        TEST_ASSERT_NOT_NULL(blocks[n]);
+    }
+    // more blocks than fit in the arena were allocated
+    TEST_ASSERT_LESS_THAN(block_size, heap_caps_get_free_size(MALLOC_CAP_SHORT_LIVED));
+    for (size_t i = 0; i < n; i++) {
+        free(blocks[i]);
+    }
+    free(blocks);
+    TEST_ASSERT_TRUE(heap_caps_check_integrity_all(true));
+}
+
+TEST_CASE("heap_caps_get_info reports the fragmentation of the free memory", "[heap][short-lived]")
+{
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_SHORT_LIVED);
+    size_t initial = info.fragmentation;
+
+    // free every other block: the holes are not contiguous with the rest of the free memory
+    void *blocks[16];
+    for (int i = 0; i < 16; i++) {
+        blocks[i] = heap_caps_malloc(128, MALLOC_CAP_8BIT | MALLOC_CAP_SHORT_LIVED);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    for (int i = 0; i < 16; i += 2) {
+        free(blocks[i]);
+    }
+    heap_caps_get_info(&info, MALLOC_CAP_SHORT_LIVED);
+    TEST_ASSERT_GREATER_THAN(initial, info.fragmentation);
+    heap_caps_print_heap_info(MALLOC_CAP_SHORT_LIVED);
+
+    for (int i = 1; i < 16; i += 2) {
+        free(blocks[i]);
+    }
+    heap_caps_get_info(&info, MALLOC_CAP_SHORT_LIVED);
+    TEST_ASSERT_EQUAL(initial, info.fragmentation);
+}
+
+#endif // CONFIG_HEAP_SHORT_LIVED_ARENA
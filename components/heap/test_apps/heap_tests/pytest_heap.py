@@ -70,6 +70,33 @@ def test_heap_misc_options(dut: Dut) -> None:
     dut.expect('Backtrace: ')
 
 
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['per_core_cache'])
+@idf_parametrize('target', ['esp32', 'esp32s3', 'esp32c3'], indirect=['target'])
+def test_heap_per_core_cache(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='cache')
+
+
+@pytest.mark.generic
+@idf_parametrize(
+    'config,target',
+    [
+        ('heap_profiler_esp32', 'esp32'),
+        ('heap_profiler_esp32c3', 'esp32c3'),
+    ],
+    indirect=['config', 'target'],
+)
+def test_heap_profiler(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='profiler')
+
+
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['short_lived_arena'])
+@idf_parametrize('target', ['esp32', 'esp32s3', 'esp32c3'], indirect=['target'])
+def test_heap_short_lived_arena(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='short-lived')
+
+
 @pytest.mark.generic
 @idf_parametrize(
     'config,target',
@@ -383,6 +383,41 @@ TEST_CASE("multi_heap_get_info() function", "[multi_heap]")
     REQUIRE( after.minimum_free_bytes == freed.minimum_free_bytes );
 }
 
+TEST_CASE("multi_heap_get_info() fragmentation", "[multi_heap]")
+{
+    uint8_t heapdata[4096];
+    void *p[16];
+    const size_t NUM_P = sizeof(p) / sizeof(void *);
+    multi_heap_handle_t heap = multi_heap_register(heapdata, sizeof(heapdata));
+    multi_heap_info_t info;
+
+    multi_heap_get_info(heap, &info);
+    REQUIRE( info.fragmentation < 5 );
+    size_t initial_fragmentation = info.fragmentation;
+
+    for (size_t i = 0; i < NUM_P; i++) {
+        p[i] = multi_heap_malloc(heap, 128);
+        REQUIRE( p[i] != NULL );
+    }
+    /* every other block leaves a hole which can't be merged with the free memory */
+    for (size_t i = 0; i < NUM_P; i += 2) {
+        multi_heap_free(heap, p[i]);
+    }
+    multi_heap_get_info(heap, &info);
+    printf("fragmentation %zu%% largest_free_block %zu total_free_bytes %zu\n",
+           info.fragmentation, info.largest_free_block, info.total_free_bytes);
+    REQUIRE( info.fragmentation > initial_fragmentation );
+    REQUIRE( info.fragmentation == 100 - (info.largest_free_block * 100) / info.total_free_bytes );
+
+    for (size_t i = 1; i < NUM_P; i += 2) {
+        multi_heap_free(heap, p[i]);
+    }
+    multi_heap_get_info(heap, &info);
+    /* largest_free_block is rounded down to a TLSF size class, so a single free block
+       can still show a few percent */
+    REQUIRE( info.fragmentation < 5 );
+}
+
 TEST_CASE("multi_heap minimum-size allocations", "[multi_heap]")
 {
     uint8_t heapdata[4096];
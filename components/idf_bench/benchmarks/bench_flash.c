@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_partition.h"
+#include "unity.h"
+#include "idf_bench.h"
+
+#define FLASH_BENCH_SIZE        4096    /* one sector */
+#define FLASH_BENCH_ITERATIONS  8
+
+typedef struct {
+    const esp_partition_t *part;
+    uint8_t *buf;
+    size_t offset;
+} flash_bench_arg_t;
+
+static void bench_flash_read(void *arg)
+{
+    flash_bench_arg_t *flash = arg;
+    esp_partition_read(flash->part, flash->offset, flash->buf, FLASH_BENCH_SIZE);
+    flash->offset = (flash->offset + FLASH_BENCH_SIZE) % flash->part->size;
+}
+
+static void bench_flash_erase_write(void *arg)
+{
+    flash_bench_arg_t *flash = arg;
+    esp_partition_erase_range(flash->part, flash->offset, FLASH_BENCH_SIZE);
+    esp_partition_write(flash->part, flash->offset, flash->buf, FLASH_BENCH_SIZE);
+    flash->offset = (flash->offset + FLASH_BENCH_SIZE) % flash->part->size;
+}
+
+TEST_CASE("flash read and write throughput", "[bench]")
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                           CONFIG_IDF_BENCH_FLASH_PARTITION);
+    if (part == NULL || part->size < FLASH_BENCH_SIZE) {
+        TEST_IGNORE_MESSAGE("no partition to benchmark the flash, see CONFIG_IDF_BENCH_FLASH_PARTITION");
+    }
+    flash_bench_arg_t arg = {
+        .part = part,
+        .buf = malloc(FLASH_BENCH_SIZE),
+    };
+    idf_bench_result_t result;
+    TEST_ASSERT_NOT_NULL(arg.buf);
+    memset(arg.buf, 0xa5, FLASH_BENCH_SIZE);
+
+    /* the partition is erased and written before the reads, so that they read actual data */
+    TEST_ESP_OK(idf_bench_measure(bench_flash_erase_write, &arg, FLASH_BENCH_ITERATIONS, &result));
+    idf_bench_report("flash_erase_write_4k", &result, FLASH_BENCH_SIZE);
+    TEST_ESP_OK(idf_bench_measure(bench_flash_read, &arg, FLASH_BENCH_ITERATIONS, &result));
+    idf_bench_report("flash_read_4k", &result, FLASH_BENCH_SIZE);
+
+    free(arg.buf);
+}
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include "sdkconfig.h"
+#include "esp_heap_caps.h"
+#include "unity.h"
+#include "idf_bench.h"
+
+#define HEAP_BENCH_ITERATIONS   256
+#define HEAP_BENCH_FRAGMENTS    32
+
+typedef struct {
+    size_t size;
+    uint32_t caps;
+} heap_bench_arg_t;
+
+static void bench_malloc_free(void *arg)
+{
+    void *p = malloc(*(size_t *)arg);
+    free(p);
+}
+
+static void bench_heap_caps_malloc_free(void *arg)
+{
+    heap_bench_arg_t *heap = arg;
+    void *p = heap_caps_malloc(heap->size, heap->caps);
+    heap_caps_free(p);
+}
+
+static void run_malloc_bench(const char *name, size_t size)
+{
+    idf_bench_result_t result;
+    TEST_ESP_OK(idf_bench_measure_cpu(bench_malloc_free, &size, HEAP_BENCH_ITERATIONS, &result));
+    idf_bench_report(name, &result, 0);
+}
+
+static void run_heap_caps_bench(const char *name, size_t size, uint32_t caps)
+{
+    heap_bench_arg_t arg = { .size = size, .caps = caps };
+    idf_bench_result_t result;
+    TEST_ESP_OK(idf_bench_measure_cpu(bench_heap_caps_malloc_free, &arg, HEAP_BENCH_ITERATIONS, &result));
+    idf_bench_report(name, &result, 0);
+}
+
+TEST_CASE("malloc and free time", "[bench]")
+{
+    void *fragments[HEAP_BENCH_FRAGMENTS];
+
+    run_malloc_bench("malloc_free_32", 32);
+    run_malloc_bench("malloc_free_256", 256);
+    run_malloc_bench("malloc_free_4k", 4096);
+    run_heap_caps_bench("heap_caps_malloc_free_internal_256", 256, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    run_heap_caps_bench("heap_caps_malloc_free_dma_256", 256, MALLOC_CAP_DMA);
+#if CONFIG_SPIRAM
+    run_heap_caps_bench("heap_caps_malloc_free_psram_256", 256, MALLOC_CAP_SPIRAM);
+#endif
+
+    /* free blocks in the middle of the heap make the allocator search further */
+    for (int i = 0; i < HEAP_BENCH_FRAGMENTS; i++) {
+        fragments[i] = malloc(48 + (i % 4) * 16);
+    }
+    for (int i = 0; i < HEAP_BENCH_FRAGMENTS; i += 2) {
+        free(fragments[i]);
+        fragments[i] = NULL;
+    }
+    run_malloc_bench("malloc_free_256_fragmented", 256);
+    for (int i = 0; i < HEAP_BENCH_FRAGMENTS; i++) {
+        free(fragments[i]);
+    }
+}
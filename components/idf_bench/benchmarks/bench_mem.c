@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_heap_caps.h"
+#include "unity.h"
+#include "idf_bench.h"
+
+#define MEM_BENCH_SIZE          4096
+#define MEM_BENCH_ITERATIONS    64
+
+/* sizes of the copies made by a network stack and the drivers: addresses, headers, small and full packets */
+static const size_t s_mixed_sizes[] = { 4, 6, 8, 14, 20, 32, 40, 64, 128, 256, 576, 1460 };
+#define MIXED_SIZES_NUM     (sizeof(s_mixed_sizes) / sizeof(s_mixed_sizes[0]))
+
+typedef struct {
+    uint8_t *dst;
+    const uint8_t *src;
+} mem_bench_arg_t;
+
+static void bench_memcpy(void *arg)
+{
+    mem_bench_arg_t *mem = arg;
+    memcpy(mem->dst, mem->src, MEM_BENCH_SIZE);
+}
+
+static void bench_memset(void *arg)
+{
+    mem_bench_arg_t *mem = arg;
+    memset(mem->dst, 0x5a, MEM_BENCH_SIZE);
+}
+
+static void bench_memcpy_mixed(void *arg)
+{
+    mem_bench_arg_t *mem = arg;
+    /* the offsets change the alignment of the source and of the destination between the copies */
+    for (size_t i = 0; i < MIXED_SIZES_NUM; i++) {
+        memcpy(mem->dst + (i & 3), mem->src + (i * 3 & 3), s_mixed_sizes[i]);
+    }
+}
+
+static void bench_strlen(void *arg)
+{
+    mem_bench_arg_t *mem = arg;
+    mem->dst[0] = strlen((const char *)mem->src + 1) & 0xff;
+}
+
+static void bench_memcmp(void *arg)
+{
+    mem_bench_arg_t *mem = arg;
+    /* the result is stored so that the call isn't optimized out */
+    mem->dst[0] = memcmp(mem->dst + 1, mem->src + 1, MEM_BENCH_SIZE - 1) != 0;
+}
+
+static void run_mem_bench_size(const char *name, void (*func)(void *), uint8_t *dst, const uint8_t *src,
+                               size_t bytes_per_call)
+{
+    mem_bench_arg_t arg = { .dst = dst, .src = src };
+    idf_bench_result_t result;
+    TEST_ESP_OK(idf_bench_measure_cpu(func, &arg, MEM_BENCH_ITERATIONS, &result));
+    idf_bench_report(name, &result, bytes_per_call);
+}
+
+static void run_mem_bench(const char *name, void (*func)(void *), uint8_t *dst, const uint8_t *src)
+{
+    run_mem_bench_size(name, func, dst, src, MEM_BENCH_SIZE);
+}
+
+TEST_CASE("memcpy, memset, memcmp and strlen throughput", "[bench]")
+{
+    /* 3 extra bytes for the unaligned copies */
+    uint8_t *src = heap_caps_malloc(MEM_BENCH_SIZE + 3, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    uint8_t *dst = heap_caps_malloc(MEM_BENCH_SIZE + 3, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(dst);
+    memset(src, 0xa5, MEM_BENCH_SIZE + 3);
+    memset(dst, 0xa5, MEM_BENCH_SIZE + 3);
+
+    run_mem_bench("memcpy_4k_aligned", bench_memcpy, dst, src);
+    run_mem_bench("memcpy_4k_unaligned", bench_memcpy, dst + 3, src + 1);
+    run_mem_bench("memset_4k_aligned", bench_memset, dst, NULL);
+    run_mem_bench("memset_4k_unaligned", bench_memset, dst + 1, NULL);
+    /* equal buffers, compared up to the end */
+    memcpy(dst, src, MEM_BENCH_SIZE + 3);
+    run_mem_bench("memcmp_4k", bench_memcmp, dst, src);
+
+    size_t mixed_bytes = 0;
+    for (size_t i = 0; i < MIXED_SIZES_NUM; i++) {
+        mixed_bytes += s_mixed_sizes[i];
+    }
+    run_mem_bench_size("memcpy_mixed_sizes", bench_memcpy_mixed, dst, src, mixed_bytes);
+
+    /* a string of MEM_BENCH_SIZE - 1 characters after the first byte */
+    src[MEM_BENCH_SIZE] = '\0';
+    run_mem_bench_size("strlen_4k", bench_strlen, dst, src, MEM_BENCH_SIZE - 1);
+
+#if CONFIG_SPIRAM
+    uint8_t *ext = heap_caps_malloc(MEM_BENCH_SIZE, MALLOC_CAP_SPIRAM);
+    TEST_ASSERT_NOT_NULL(ext);
+    memset(ext, 0xa5, MEM_BENCH_SIZE);
+    run_mem_bench("memcpy_4k_psram_to_internal", bench_memcpy, dst, ext);
+    run_mem_bench("memcpy_4k_internal_to_psram", bench_memcpy, ext, src);
+    run_mem_bench("memset_4k_psram", bench_memset, ext, NULL);
+    free(ext);
+#endif
+
+    free(src);
+    free(dst);
+}
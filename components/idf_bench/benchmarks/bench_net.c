@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_netif.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "idf_bench.h"
+#if CONFIG_IDF_BENCH_TLS
+#include "esp_tls.h"
+#endif
+
+#define NET_BENCH_TCP_PORT      5001
+#define NET_BENCH_TLS_PORT      5002
+#define NET_BENCH_TCP_BYTES     (512 * 1024)
+#define NET_BENCH_TCP_CHUNK     1436    /* one TCP_MSS */
+#define NET_BENCH_TASK_STACK    6144
+#define NET_BENCH_TASK_PRIO     (tskIDLE_PRIORITY + 5)
+#define NET_BENCH_HANDSHAKES    2       /* handshakes per round */
+
+typedef struct {
+    int listen_fd;
+    SemaphoreHandle_t done;
+    size_t received;        /* bytes received by the TCP sink */
+    uint32_t sessions;      /* handshakes to serve by the TLS server */
+    uint32_t failures;      /* handshakes which failed on the server side */
+} net_bench_t;
+
+static int net_bench_listen(uint16_t port)
+{
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int opt = 1;
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    TEST_ASSERT_EQUAL(0, bind(fd, (struct sockaddr *)&addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL(0, listen(fd, 1));
+    return fd;
+}
+
+static void net_bench_init(void)
+{
+    /* starts the TCP/IP stack and its loopback interface, may be called several times */
+    esp_err_t err = esp_netif_init();
+    TEST_ASSERT(err == ESP_OK || err == ESP_ERR_INVALID_STATE);
+}
+
+static void tcp_sink_task(void *arg)
+{
+    net_bench_t *bench = arg;
+    uint8_t buf[NET_BENCH_TCP_CHUNK];
+    int len;
+
+    int fd = accept(bench->listen_fd, NULL, NULL);
+    if (fd >= 0) {
+        while ((len = recv(fd, buf, sizeof(buf), 0)) > 0) {
+            bench->received += len;
+        }
+        close(fd);
+    }
+    xSemaphoreGive(bench->done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("lwIP TCP loopback throughput", "[bench]")
+{
+    static uint8_t chunk[NET_BENCH_TCP_CHUNK];
+    net_bench_t bench = {
+        .done = xSemaphoreCreateBinary(),
+    };
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(NET_BENCH_TCP_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    size_t sent = 0;
+
+    TEST_ASSERT_NOT_NULL(bench.done);
+    net_bench_init();
+    bench.listen_fd = net_bench_listen(NET_BENCH_TCP_PORT);
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(tcp_sink_task, "bench_sink", NET_BENCH_TASK_STACK, &bench,
+                                          NET_BENCH_TASK_PRIO, NULL));
+
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+    TEST_ASSERT_EQUAL(0, connect(fd, (struct sockaddr *)&addr, sizeof(addr)));
+    int64_t start = esp_timer_get_time();
+    while (sent < NET_BENCH_TCP_BYTES) {
+        int len = send(fd, chunk, MIN(sizeof(chunk), NET_BENCH_TCP_BYTES - sent), 0);
+        TEST_ASSERT_GREATER_THAN(0, len);
+        sent += len;
+    }
+    close(fd);
+    TEST_ASSERT_TRUE(xSemaphoreTake(bench.done, pdMS_TO_TICKS(10000)));
+    int64_t elapsed_us = esp_timer_get_time() - start;
+
+    TEST_ASSERT_EQUAL(NET_BENCH_TCP_BYTES, bench.received);
+    idf_bench_report_value("lwip_tcp_loopback", (uint32_t)((uint64_t)NET_BENCH_TCP_BYTES * 1000000 / 1024 / elapsed_us),
+                           "KB/s");
+    close(bench.listen_fd);
+    vSemaphoreDelete(bench.done);
+}
+
+#if CONFIG_IDF_BENCH_TLS
+extern const uint8_t bench_server_cert_pem_start[] asm("_binary_bench_server_cert_pem_start");
+extern const uint8_t bench_server_cert_pem_end[]   asm("_binary_bench_server_cert_pem_end");
+extern const uint8_t bench_server_key_pem_start[]  asm("_binary_bench_server_key_pem_start");
+extern const uint8_t bench_server_key_pem_end[]    asm("_binary_bench_server_key_pem_end");
+
+static void tls_server_task(void *arg)
+{
+    net_bench_t *bench = arg;
+    esp_tls_cfg_server_t cfg = {
+        .servercert_buf = bench_server_cert_pem_start,
+        .servercert_bytes = bench_server_cert_pem_end - bench_server_cert_pem_start,
+        .serverkey_buf = bench_server_key_pem_start,
+        .serverkey_bytes = bench_server_key_pem_end - bench_server_key_pem_start,
+    };
+
+    for (uint32_t i = 0; i < bench->sessions; i++) {
+        int fd = accept(bench->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            bench->failures++;
+            continue;
+        }
+        esp_tls_t *tls = esp_tls_init();
+        if (tls == NULL || esp_tls_server_session_create(&cfg, fd, tls) != 0) {
+            bench->failures++;
+        }
+        esp_tls_server_session_delete(tls);
+        close(fd);
+    }
+    xSemaphoreGive(bench->done);
+    vTaskDelete(NULL);
+}
+
+static void bench_tls_handshake(void *arg)
+{
+    net_bench_t *bench = arg;
+    const esp_tls_cfg_t cfg = {
+        .cacert_buf = bench_server_cert_pem_start,
+        .cacert_bytes = bench_server_cert_pem_end - bench_server_cert_pem_start,
+        .common_name = "localhost",
+        .timeout_ms = 10000,
+    };
+    esp_tls_t *tls = esp_tls_init();
+    if (tls == NULL || esp_tls_conn_new_sync("127.0.0.1", strlen("127.0.0.1"), NET_BENCH_TLS_PORT, &cfg, tls) != 1) {
+        bench->failures++;
+    }
+    esp_tls_conn_destroy(tls);
+}
+
+TEST_CASE("TLS handshake time over loopback", "[bench]")
+{
+    net_bench_t bench = {
+        .done = xSemaphoreCreateBinary(),
+        /* warm-up call and rounds of idf_bench_measure() */
+        .sessions = 1 + NET_BENCH_HANDSHAKES * CONFIG_IDF_BENCH_ROUNDS,
+    };
+    idf_bench_result_t result;
+
+    TEST_ASSERT_NOT_NULL(bench.done);
+    net_bench_init();
+    bench.listen_fd = net_bench_listen(NET_BENCH_TLS_PORT);
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(tls_server_task, "bench_tls", NET_BENCH_TASK_STACK, &bench,
+                                          NET_BENCH_TASK_PRIO, NULL));
+
+    /* includes the time taken by the server, running on the same chip */
+    TEST_ESP_OK(idf_bench_measure(bench_tls_handshake, &bench, NET_BENCH_HANDSHAKES, &result));
+    TEST_ASSERT_TRUE(xSemaphoreTake(bench.done, pdMS_TO_TICKS(20000)));
+    TEST_ASSERT_EQUAL(0, bench.failures);
+    idf_bench_report("tls_handshake_ecdsa_p256", &result, 0);
+
+    close(bench.listen_fd);
+    vSemaphoreDelete(bench.done);
+}
+#endif // CONFIG_IDF_BENCH_TLS
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/ringbuf.h"
+#include "esp_event.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "idf_bench.h"
+
+#define RTOS_BENCH_ITERATIONS   256
+#define RTOS_BENCH_ITEM_SIZE    32
+
+typedef struct {
+    uint8_t data[RTOS_BENCH_ITEM_SIZE];
+} rtos_bench_item_t;
+
+static void bench_queue_send_receive(void *arg)
+{
+    QueueHandle_t queue = arg;
+    rtos_bench_item_t item = { 0 };
+    xQueueSend(queue, &item, 0);
+    xQueueReceive(queue, &item, 0);
+}
+
+static void bench_semaphore_give_take(void *arg)
+{
+    SemaphoreHandle_t sem = arg;
+    xSemaphoreGive(sem);
+    xSemaphoreTake(sem, 0);
+}
+
+static void bench_ringbuf_send_receive(void *arg)
+{
+    RingbufHandle_t ringbuf = arg;
+    rtos_bench_item_t item = { 0 };
+    size_t size;
+    xRingbufferSend(ringbuf, &item, sizeof(item), 0);
+    void *received = xRingbufferReceive(ringbuf, &size, 0);
+    if (received) {
+        vRingbufferReturnItem(ringbuf, received);
+    }
+}
+
+TEST_CASE("queue, semaphore and ring buffer operation time", "[bench]")
+{
+    idf_bench_result_t result;
+
+    QueueHandle_t queue = xQueueCreate(4, sizeof(rtos_bench_item_t));
+    TEST_ASSERT_NOT_NULL(queue);
+    TEST_ESP_OK(idf_bench_measure_cpu(bench_queue_send_receive, queue, RTOS_BENCH_ITERATIONS, &result));
+    idf_bench_report("queue_send_receive_32", &result, 0);
+    vQueueDelete(queue);
+
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(sem);
+    TEST_ESP_OK(idf_bench_measure_cpu(bench_semaphore_give_take, sem, RTOS_BENCH_ITERATIONS, &result));
+    idf_bench_report("semaphore_give_take", &result, 0);
+    vSemaphoreDelete(sem);
+
+    RingbufHandle_t ringbuf = xRingbufferCreateNoSplit(sizeof(rtos_bench_item_t), 4);
+    TEST_ASSERT_NOT_NULL(ringbuf);
+    TEST_ESP_OK(idf_bench_measure_cpu(bench_ringbuf_send_receive, ringbuf, RTOS_BENCH_ITERATIONS, &result));
+    idf_bench_report("ringbuf_send_receive_32", &result, 0);
+    vRingbufferDelete(ringbuf);
+}
+
+ESP_EVENT_DEFINE_BASE(IDF_BENCH_EVENT);
+
+static void bench_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data)
+{
+    (*(uint32_t *)arg)++;
+}
+
+static void bench_event_post_dispatch(void *arg)
+{
+    esp_event_loop_handle_t loop = arg;
+    rtos_bench_item_t item = { 0 };
+    esp_event_post_to(loop, IDF_BENCH_EVENT, 0, &item, sizeof(item), 0);
+    esp_event_loop_run(loop, 0);
+}
+
+TEST_CASE("esp_event post and dispatch time", "[bench]")
+{
+    esp_event_loop_handle_t loop;
+    esp_event_loop_args_t args = {
+        .queue_size = 4,
+        .task_name = NULL,  /* dispatched by the benchmark itself */
+    };
+    uint32_t handled = 0;
+    idf_bench_result_t result;
+
+    TEST_ESP_OK(esp_event_loop_create(&args, &loop));
+    TEST_ESP_OK(esp_event_handler_register_with(loop, IDF_BENCH_EVENT, 0, bench_event_handler, &handled));
+    /* the loop takes mutexes, it can't be measured with the scheduler suspended */
+    TEST_ESP_OK(idf_bench_measure(bench_event_post_dispatch, loop, RTOS_BENCH_ITERATIONS, &result));
+    idf_bench_report("esp_event_post_dispatch_32", &result, 0);
+    TEST_ASSERT_EQUAL(RTOS_BENCH_ITERATIONS * result.rounds + 1, handled);
+    TEST_ESP_OK(esp_event_loop_delete(loop));
+}
+
+static void bench_timer_cb(void *arg)
+{
+}
+
+static void bench_timer_start_stop(void *arg)
+{
+    esp_timer_handle_t timer = arg;
+    esp_timer_start_once(timer, 1000000);
+    esp_timer_stop(timer);
+}
+
+TEST_CASE("esp_timer start and stop time", "[bench]")
+{
+    esp_timer_handle_t timer;
+    const esp_timer_create_args_t args = {
+        .callback = bench_timer_cb,
+        .name = "idf_bench",
+    };
+    idf_bench_result_t result;
+
+    TEST_ESP_OK(esp_timer_create(&args, &timer));
+    TEST_ESP_OK(idf_bench_measure_cpu(bench_timer_start_stop, timer, RTOS_BENCH_ITERATIONS, &result));
+    idf_bench_report("esp_timer_start_stop", &result, 0);
+    TEST_ESP_OK(esp_timer_delete(timer));
+}
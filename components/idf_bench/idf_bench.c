@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_idf_version.h"
+#include "esp_perfmon.h"
+#include "esp_private/esp_clk.h"
+#include "idf_bench.h"
+
+#define BENCH_ROUNDS    CONFIG_IDF_BENCH_ROUNDS
+
+static const char *TAG = "idf_bench";
+
+static void sort_rounds(uint32_t *ns, size_t num)
+{
+    for (size_t i = 1; i < num; i++) {
+        uint32_t value = ns[i];
+        size_t j = i;
+        for (; j > 0 && ns[j - 1] > value; j--) {
+            ns[j] = ns[j - 1];
+        }
+        ns[j] = value;
+    }
+}
+
+esp_err_t idf_bench_measure(void (*func)(void *arg), void *arg, uint32_t iterations, idf_bench_result_t *result)
+{
+    ESP_RETURN_ON_FALSE(func && iterations > 0 && result, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    uint32_t ns[BENCH_ROUNDS];
+
+    func(arg);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        int64_t start = esp_timer_get_time();
+        for (uint32_t i = 0; i < iterations; i++) {
+            func(arg);
+        }
+        int64_t elapsed_ns = (esp_timer_get_time() - start) * 1000;
+        ns[round] = (uint32_t)MIN(elapsed_ns / iterations, UINT32_MAX);
+    }
+    sort_rounds(ns, BENCH_ROUNDS);
+
+    *result = (idf_bench_result_t) {
+        .iterations = iterations,
+        .rounds = BENCH_ROUNDS,
+        .ns_min = ns[0],
+        .ns_median = ns[BENCH_ROUNDS / 2],
+        .ns_max = ns[BENCH_ROUNDS - 1],
+    };
+    return ESP_OK;
+}
+
+esp_err_t idf_bench_measure_cpu(void (*func)(void *arg), void *arg, uint32_t iterations, idf_bench_result_t *result)
+{
+    esp_perfmon_benchmark_result_t cpu;
+
+    ESP_RETURN_ON_ERROR(idf_bench_measure(func, arg, iterations, result), TAG, "measure failed");
+    ESP_RETURN_ON_ERROR(esp_perfmon_benchmark(func, arg, iterations, &cpu), TAG, "counting the cycles failed");
+    result->cycles = cpu.cycles;
+    result->instructions = cpu.instructions;
+    return ESP_OK;
+}
+
+static void print_header(const char *name)
+{
+    printf(IDF_BENCH_REPORT_PREFIX "{\"name\":\"%s\",\"target\":\"%s\",\"idf\":\"%s\",\"cpu_mhz\":%d,",
+           name, CONFIG_IDF_TARGET, esp_get_idf_version(), esp_clk_cpu_freq() / 1000000);
+}
+
+void idf_bench_report(const char *name, const idf_bench_result_t *result, size_t bytes_per_call)
+{
+    if (name == NULL || result == NULL) {
+        return;
+    }
+    print_header(name);
+    if (bytes_per_call > 0) {
+        /* bytes per ns to KB/s */
+        uint64_t kbps = (uint64_t)bytes_per_call * 1000000000 / 1024 / MAX(result->ns_median, 1);
+        printf("\"value\":%" PRIu64 ",\"unit\":\"KB/s\",", kbps);
+    } else {
+        printf("\"value\":%" PRIu32 ",\"unit\":\"ns\",", result->ns_median);
+    }
+    printf("\"iterations\":%" PRIu32 ",\"rounds\":%" PRIu32 ",\"ns_min\":%" PRIu32 ",\"ns_median\":%" PRIu32
+           ",\"ns_max\":%" PRIu32 ",\"cycles\":%" PRIu32 ",\"instructions\":%" PRIu32 "}\n",
+           result->iterations, result->rounds, result->ns_min, result->ns_median, result->ns_max,
+           result->cycles, result->instructions);
+}
+
+void idf_bench_report_value(const char *name, uint32_t value, const char *unit)
+{
+    if (name == NULL || unit == NULL) {
+        return;
+    }
+    print_header(name);
+    printf("\"value\":%" PRIu32 ",\"unit\":\"%s\"}\n", value, unit);
+}
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Prefix of the lines printed by idf_bench_report() and idf_bench_report_value(), followed by a JSON object
+ */
+#define IDF_BENCH_REPORT_PREFIX "IDF_BENCH "
+
+/**
+ * @brief Result of idf_bench_measure() or idf_bench_measure_cpu()
+ */
+typedef struct {
+    uint32_t iterations;    /*!< Calls of the function per round */
+    uint32_t rounds;        /*!< Number of rounds measured, see CONFIG_IDF_BENCH_ROUNDS */
+    uint32_t ns_min;        /*!< Time per call in the fastest round, in nanoseconds */
+    uint32_t ns_median;     /*!< Median of the time per call of the rounds, in nanoseconds */
+    uint32_t ns_max;        /*!< Time per call in the slowest round, in nanoseconds */
+    uint32_t cycles;        /*!< Average CPU cycles per call, 0 if not measured */
+    uint32_t instructions;  /*!< Average retired instructions per call, 0 if not measured or not supported */
+} idf_bench_result_t;
+
+/**
+ * @brief Measure the time taken by a function
+ *
+ * The function is called once to warm the caches up, then CONFIG_IDF_BENCH_ROUNDS rounds of ``iterations`` calls
+ * are timed with esp_timer. The median of the rounds is less sensitive to the interrupts and the other tasks than
+ * the average. The function may block.
+ *
+ * @param[in]  func        Function to measure
+ * @param[in]  arg         Argument of the function
+ * @param[in]  iterations  Number of calls per round
+ * @param[out] result      Result of the measure
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ */
+esp_err_t idf_bench_measure(void (*func)(void *arg), void *arg, uint32_t iterations, idf_bench_result_t *result);
+
+/**
+ * @brief Measure the time, CPU cycles and instructions taken by a function
+ *
+ * Same as idf_bench_measure(), the cycles and instructions are then counted with esp_perfmon_benchmark(), which
+ * suspends the scheduler: the function must not block.
+ *
+ * @param[in]  func        Function to measure
+ * @param[in]  arg         Argument of the function
+ * @param[in]  iterations  Number of calls per round
+ * @param[out] result      Result of the measure
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the performance counters of the core are already used
+ */
+esp_err_t idf_bench_measure_cpu(void (*func)(void *arg), void *arg, uint32_t iterations, idf_bench_result_t *result);
+
+/**
+ * @brief Print the result of a benchmark to the console
+ *
+ * Prints a line made of IDF_BENCH_REPORT_PREFIX and a JSON object with the name of the benchmark, the target,
+ * the ESP-IDF version, the CPU frequency and the members of the result. The ``value`` of the object is the median
+ * time per call in ``ns``, or the throughput in ``KB/s`` if ``bytes_per_call`` is not 0.
+ *
+ * @param[in] name            Name of the benchmark, unique in the suite, without quotes or backslashes
+ * @param[in] result          Result of the benchmark
+ * @param[in] bytes_per_call  Bytes processed by each call of the function, to report the throughput, or 0
+ */
+void idf_bench_report(const char *name, const idf_bench_result_t *result, size_t bytes_per_call);
+
+/**
+ * @brief Print a value measured by a benchmark to the console
+ *
+ * Same format as idf_bench_report(), for the results which are not a time per call, e.g., a throughput measured
+ * over a whole transfer.
+ *
+ * @param[in] name   Name of the benchmark, unique in the suite, without quotes or backslashes
+ * @param[in] value  Measured value
+ * @param[in] unit   Unit of the value
+ */
+void idf_bench_report_value(const char *name, uint32_t value, const char *unit);
+
+#ifdef __cplusplus
+}
+#endif
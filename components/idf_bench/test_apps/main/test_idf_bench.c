@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include "esp_rom_sys.h"
+#include "unity.h"
+#include "idf_bench.h"
+
+static void delay_10us(void *arg)
+{
+    (*(uint32_t *)arg)++;
+    esp_rom_delay_us(10);
+}
+
+TEST_CASE("idf_bench_measure() times the calls in rounds", "[idf_bench]")
+{
+    idf_bench_result_t result;
+    uint32_t calls = 0;
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, idf_bench_measure(NULL, NULL, 1, &result));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, idf_bench_measure(delay_10us, &calls, 0, &result));
+
+    TEST_ESP_OK(idf_bench_measure(delay_10us, &calls, 100, &result));
+    /* warm-up call and rounds */
+    TEST_ASSERT_EQUAL(1 + 100 * CONFIG_IDF_BENCH_ROUNDS, calls);
+    TEST_ASSERT_EQUAL(100, result.iterations);
+    TEST_ASSERT_EQUAL(CONFIG_IDF_BENCH_ROUNDS, result.rounds);
+    TEST_ASSERT_LESS_OR_EQUAL(result.ns_median, result.ns_min);
+    TEST_ASSERT_LESS_OR_EQUAL(result.ns_max, result.ns_median);
+    TEST_ASSERT_UINT32_WITHIN(2000, 10000, result.ns_median);
+    TEST_ASSERT_EQUAL(0, result.cycles);
+    idf_bench_report("test_delay_10us", &result, 0);
+}
+
+TEST_CASE("idf_bench_measure_cpu() counts the cycles of the calls", "[idf_bench]")
+{
+    idf_bench_result_t result;
+    uint32_t calls = 0;
+
+    TEST_ESP_OK(idf_bench_measure_cpu(delay_10us, &calls, 100, &result));
+    /* 10 us at the CPU frequency, in MHz */
+    TEST_ASSERT_UINT32_WITHIN(2 * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, 10 * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, result.cycles);
+    idf_bench_report("test_delay_10us_cpu", &result, 4);
+    idf_bench_report_value("test_value", 42, "units");
+}
@@ -0,0 +1,46 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+import json
+import os
+import re
+from typing import Callable
+from typing import Dict
+from typing import List
+
+import pytest
+from pytest_embedded import Dut
+from pytest_embedded_idf.utils import idf_parametrize
+
+# see IDF_BENCH_REPORT_PREFIX in idf_bench.h
+BENCH_RE = re.compile(rb'IDF_BENCH (\{.*?\})\r?\n')
+SUMMARY_RE = re.compile(rb'(\d+) Tests (\d+) Failures (\d+) Ignored')
+
+
+def run_benchmarks(dut: Dut) -> List[Dict]:
+    """
+    Run the test cases tagged [bench] and return the results they printed.
+    """
+    results = []
+    dut.expect_exact('Press ENTER to see the list of tests')
+    dut.write('[bench]')
+    while True:
+        match = dut.expect([BENCH_RE, SUMMARY_RE], timeout=300)
+        if match.re is SUMMARY_RE:
+            assert int(match.group(2)) == 0, 'a benchmark failed'
+            return results
+        results.append(json.loads(match.group(1)))
+
+
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['default', 'libc_optimized_mem'], indirect=True)
+@idf_parametrize('target', ['esp32', 'esp32c3', 'esp32c6', 'esp32p4', 'esp32s3'], indirect=['target'])
+def test_idf_bench(dut: Dut, config: str, log_performance: Callable[[str, object], None]) -> None:
+    results = run_benchmarks(dut)
+    for result in results:
+        name = result['name'] if config == 'default' else f'{config}_{result["name"]}'
+        log_performance(name, f'{result["value"]} {result["unit"]}')
+    # kept with the logs, to compare the results of two runs
+    with open(os.path.join(dut.logdir, 'idf_bench.json'), 'w', encoding='utf-8') as f:
+        json.dump(results, f, indent=2)
+
+    dut.run_all_single_board_cases(group='idf_bench')
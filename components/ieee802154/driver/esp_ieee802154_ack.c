@@ -23,9 +23,27 @@ static ieee802154_pending_table_t ieee802154_pending_table;
 #define BIT_CLR(mask, pos) (GET_MASK_ITEM_FROM_TABLE(mask, pos) &= ~(1UL << (pos % IEEE802154_PENDING_TABLE_MASK_BITS)))
 #define BIT_IST(mask, pos) (GET_MASK_ITEM_FROM_TABLE(mask, pos) & (1UL << (pos % IEEE802154_PENDING_TABLE_MASK_BITS)))
 
+/*
+ * The frame pending decision is made in the ISR, between the reception of the frame and its ACK. Most of the frames
+ * come from devices which are not in the table: the filters tell it without searching the table. A bit is set when
+ * an address with its hash is added, and only cleared when the table is reset, so that clearing an address stays fast.
+ */
+static IRAM_ATTR uint32_t ieee802154_pending_addr_filter_bit(const uint8_t *addr, bool is_short)
+{
+    uint8_t hash = 0;
+    for (uint8_t i = 0; i < (is_short ? IEEE802154_FRAME_SHORT_ADDR_SIZE : IEEE802154_FRAME_EXT_ADDR_SIZE); i++) {
+        hash = (hash * 31) + addr[i];
+    }
+    return 1UL << (hash % 32);
+}
+
 static IRAM_ATTR bool ieee802154_addr_in_pending_table(const uint8_t *addr, bool is_short)
 {
     bool ret = false;
+    uint32_t filter = is_short ? ieee802154_pending_table.short_addr_filter : ieee802154_pending_table.ext_addr_filter;
+    if (!(filter & ieee802154_pending_addr_filter_bit(addr, is_short))) {
+        return false;
+    }
     if (is_short) {
         for (uint8_t index = 0; index < CONFIG_IEEE802154_PENDING_TABLE_SIZE; index++) {
             if (BIT_IST(ieee802154_pending_table.short_addr_mask, index) &&
@@ -63,6 +81,7 @@ esp_err_t ieee802154_add_pending_addr(const uint8_t *addr, bool is_short)
         }
         if (first_empty_index != -1) {
             memcpy(ieee802154_pending_table.short_addr[first_empty_index], addr, IEEE802154_FRAME_SHORT_ADDR_SIZE);
+            ieee802154_pending_table.short_addr_filter |= ieee802154_pending_addr_filter_bit(addr, true);
             BIT_SET(ieee802154_pending_table.short_addr_mask, first_empty_index);
             ret = ESP_OK;
         }
@@ -78,6 +97,7 @@ esp_err_t ieee802154_add_pending_addr(const uint8_t *addr, bool is_short)
         }
         if (first_empty_index != -1) {
             memcpy(ieee802154_pending_table.ext_addr[first_empty_index], addr, IEEE802154_FRAME_EXT_ADDR_SIZE);
+            ieee802154_pending_table.ext_addr_filter |= ieee802154_pending_addr_filter_bit(addr, false);
             BIT_SET(ieee802154_pending_table.ext_addr_mask, first_empty_index);
             ret = ESP_OK;
         }
@@ -117,8 +137,10 @@ void ieee802154_reset_pending_table(bool is_short)
     // Consider this function may be called in ISR, only clear the mask bits for finishing the process quickly.
     if (is_short) {
         memset(ieee802154_pending_table.short_addr_mask, 0, IEEE802154_PENDING_TABLE_MASK_SIZE);
+        ieee802154_pending_table.short_addr_filter = 0;
     } else {
         memset(ieee802154_pending_table.ext_addr_mask, 0, IEEE802154_PENDING_TABLE_MASK_SIZE);
+        ieee802154_pending_table.ext_addr_filter = 0;
     }
 }
 
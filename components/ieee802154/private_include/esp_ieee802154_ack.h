@@ -27,6 +27,8 @@ typedef struct {
     uint8_t ext_addr[CONFIG_IEEE802154_PENDING_TABLE_SIZE][IEEE802154_FRAME_EXT_ADDR_SIZE];     /*!< Extend address table */
     uint8_t short_addr_mask[IEEE802154_PENDING_TABLE_MASK_SIZE];                                /*!< The mask which the index of short address table is used */
     uint8_t ext_addr_mask[IEEE802154_PENDING_TABLE_MASK_SIZE];                                  /*!< The mask which the index of extended address table is used */
+    uint32_t short_addr_filter;                                                                 /*!< Bit of the hash of each short address added to the table, a clear bit means that no address with this hash is in the table */
+    uint32_t ext_addr_filter;                                                                   /*!< Bit of the hash of each extended address added to the table */
 } ieee802154_pending_table_t;
 
 /**
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "cJSON.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configuration of a JSON arena
+ */
+typedef struct {
+    size_t block_size;          /*!< Size of the memory blocks the arena allocates from the heap. 0 selects 1024 bytes */
+    size_t max_token_len;       /*!< Longest key, string or number accepted, see esp_json_reader_config_t */
+    size_t max_depth;           /*!< Deepest nesting accepted, see esp_json_reader_config_t */
+} esp_json_arena_config_t;
+
+/**
+ * @brief Type of JSON arena handle
+ */
+typedef struct esp_json_arena_t *esp_json_arena_handle_t;
+
+/**
+ * @brief Create a JSON arena
+ *
+ * The arena parses documents into cJSON trees whose items, keys and strings are allocated from a few large memory
+ * blocks instead of one heap allocation each. The document can be fed in chunks. All trees are freed at once by
+ * esp_json_arena_reset() or esp_json_arena_delete().
+ *
+ * The trees can be read with the cJSON functions which don't modify them, such as cJSON_GetObjectItem() or
+ * cJSON_PrintUnformatted(). They must not be passed to cJSON_Delete() or to the functions adding, replacing,
+ * detaching or deleting items.
+ *
+ * @param[in] config Arena configuration
+ * @param[out] ret_arena Returned arena handle
+ * @return
+ *      - ESP_OK: Arena created
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t esp_json_arena_new(const esp_json_arena_config_t *config, esp_json_arena_handle_t *ret_arena);
+
+/**
+ * @brief Parse the next chunk of a document into the arena
+ *
+ * On error, the document is discarded and the next call starts a new one.
+ *
+ * @param[in] arena Arena handle
+ * @param[in] data Chunk of the document
+ * @param[in] len Length of the chunk
+ * @return
+ *      - ESP_OK: Chunk parsed
+ *      - ESP_ERR_NO_MEM: Out of memory
+ *      - Others: See esp_json_reader_feed()
+ */
+esp_err_t esp_json_arena_feed(esp_json_arena_handle_t arena, const char *data, size_t len);
+
+/**
+ * @brief Complete the document fed with esp_json_arena_feed() and get its tree
+ *
+ * After this call, the next esp_json_arena_feed() starts a new document. The trees of the previous documents
+ * stay valid until the arena is reset.
+ *
+ * @param[in] arena Arena handle
+ * @param[out] ret_root Returned root item of the document
+ * @return
+ *      - ESP_OK: Document complete
+ *      - ESP_ERR_NO_MEM: Out of memory
+ *      - Others: See esp_json_reader_finish()
+ */
+esp_err_t esp_json_arena_finish(esp_json_arena_handle_t arena, cJSON **ret_root);
+
+/**
+ * @brief Parse a complete document into the arena
+ *
+ * Equivalent to esp_json_arena_feed() followed by esp_json_arena_finish().
+ *
+ * @param[in] arena Arena handle
+ * @param[in] data Document, it doesn't need to be zero-terminated
+ * @param[in] len Length of the document
+ * @param[out] ret_root Returned root item of the document
+ * @return See esp_json_arena_feed() and esp_json_arena_finish()
+ */
+esp_err_t esp_json_arena_parse(esp_json_arena_handle_t arena, const char *data, size_t len, cJSON **ret_root);
+
+/**
+ * @brief Free all the trees of the arena
+ *
+ * The first memory block is kept for the next documents, the others are returned to the heap.
+ * A document being fed is discarded.
+ *
+ * @param[in] arena Arena handle
+ * @return
+ *      - ESP_OK: Arena reset
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_json_arena_reset(esp_json_arena_handle_t arena);
+
+/**
+ * @brief Get the number of bytes allocated from the heap by the arena
+ *
+ * @param[in] arena Arena handle
+ * @return Size of the memory blocks, 0 if arena is NULL
+ */
+size_t esp_json_arena_get_size(esp_json_arena_handle_t arena);
+
+/**
+ * @brief Delete a JSON arena and free all its trees
+ *
+ * @param[in] arena Arena handle
+ * @return
+ *      - ESP_OK: Arena deleted
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_json_arena_delete(esp_json_arena_handle_t arena);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,311 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Types of the events produced by the streaming JSON reader
+ */
+typedef enum {
+    ESP_JSON_EVENT_OBJECT_START,    /*!< '{' */
+    ESP_JSON_EVENT_OBJECT_END,      /*!< '}' */
+    ESP_JSON_EVENT_ARRAY_START,     /*!< '[' */
+    ESP_JSON_EVENT_ARRAY_END,       /*!< ']' */
+    ESP_JSON_EVENT_KEY,             /*!< Name of an object member, in str/len */
+    ESP_JSON_EVENT_STRING,          /*!< String value, in str/len */
+    ESP_JSON_EVENT_NUMBER,          /*!< Number value, in number, its text in str/len */
+    ESP_JSON_EVENT_TRUE,            /*!< true */
+    ESP_JSON_EVENT_FALSE,           /*!< false */
+    ESP_JSON_EVENT_NULL,            /*!< null */
+} esp_json_event_type_t;
+
+/**
+ * @brief Event produced by the streaming JSON reader
+ */
+typedef struct {
+    esp_json_event_type_t type;     /*!< Event type */
+    const char *str;                /*!< Unescaped, zero-terminated text of keys, strings and numbers. Only valid during the callback */
+    size_t len;                     /*!< Length of str, strings may contain zero bytes escaped as \u0000 */
+    double number;                  /*!< Value of numbers */
+    size_t depth;                   /*!< Nesting level of the value, 0 for the top level value */
+} esp_json_event_t;
+
+/**
+ * @brief Callback receiving the events of the streaming JSON reader
+ *
+ * @param event Event
+ * @param arg User argument given in the configuration
+ * @return ESP_OK to continue, any other value stops the parsing and is returned by esp_json_reader_feed()
+ */
+typedef esp_err_t (*esp_json_event_cb_t)(const esp_json_event_t *event, void *arg);
+
+/**
+ * @brief Configuration of the streaming JSON reader
+ */
+typedef struct {
+    esp_json_event_cb_t callback;   /*!< Callback receiving the events */
+    void *arg;                      /*!< User argument passed to the callback */
+    size_t max_token_len;           /*!< Longest key, string or number text accepted, in bytes. 0 selects 256 */
+    size_t max_depth;               /*!< Deepest nesting of objects and arrays accepted. 0 selects 16 */
+} esp_json_reader_config_t;
+
+/**
+ * @brief Type of streaming JSON reader handle
+ */
+typedef struct esp_json_reader_t *esp_json_reader_handle_t;
+
+/**
+ * @brief Create a streaming JSON reader
+ *
+ * The reader accepts a document in chunks of any size, for example as returned by esp_http_client_read(),
+ * and reports its keys and values through the callback as they are complete. The only memory used is allocated
+ * here: a buffer of max_token_len bytes for the token being read and max_depth bytes of nesting state.
+ *
+ * @param[in] config Reader configuration
+ * @param[out] ret_reader Returned reader handle
+ * @return
+ *      - ESP_OK: Reader created
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t esp_json_reader_new(const esp_json_reader_config_t *config, esp_json_reader_handle_t *ret_reader);
+
+/**
+ * @brief Parse the next chunk of the document
+ *
+ * @param[in] reader Reader handle
+ * @param[in] data Chunk of the document
+ * @param[in] len Length of the chunk
+ * @return
+ *      - ESP_OK: Chunk parsed
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_RESPONSE: The document is not valid JSON
+ *      - ESP_ERR_INVALID_SIZE: A token is longer than max_token_len or the nesting deeper than max_depth
+ *      - ESP_ERR_INVALID_STATE: A previous call failed, the reader needs to be reset
+ *      - Others: Error returned by the callback
+ */
+esp_err_t esp_json_reader_feed(esp_json_reader_handle_t reader, const char *data, size_t len);
+
+/**
+ * @brief Signal the end of the document
+ *
+ * A number at the top level is only complete at the end of the document, its event is reported here.
+ *
+ * @param[in] reader Reader handle
+ * @return
+ *      - ESP_OK: The document is complete
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_RESPONSE: The document is incomplete or not valid JSON
+ *      - ESP_ERR_INVALID_STATE: A previous call failed, the reader needs to be reset
+ *      - Others: Error returned by the callback
+ */
+esp_err_t esp_json_reader_finish(esp_json_reader_handle_t reader);
+
+/**
+ * @brief Reset the reader to parse a new document
+ *
+ * @param[in] reader Reader handle
+ * @return
+ *      - ESP_OK: Reader reset
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_json_reader_reset(esp_json_reader_handle_t reader);
+
+/**
+ * @brief Delete a streaming JSON reader
+ *
+ * @param[in] reader Reader handle
+ * @return
+ *      - ESP_OK: Reader deleted
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_json_reader_delete(esp_json_reader_handle_t reader);
+
+/**
+ * @brief Callback receiving the output of the streaming JSON writer
+ *
+ * @param data Next part of the document
+ * @param len Length of data
+ * @param arg User argument given in the configuration
+ * @return ESP_OK to continue, any other value is returned by the writer function that flushed the output
+ */
+typedef esp_err_t (*esp_json_output_cb_t)(const char *data, size_t len, void *arg);
+
+/**
+ * @brief Configuration of the streaming JSON writer
+ */
+typedef struct {
+    esp_json_output_cb_t output;    /*!< Callback receiving the output, for example a wrapper of httpd_resp_send_chunk() */
+    void *arg;                      /*!< User argument passed to the callback */
+    size_t buffer_size;             /*!< Size of the output buffer, the callback is called when it is full. 0 selects 256 */
+} esp_json_writer_config_t;
+
+/**
+ * @brief Type of streaming JSON writer handle
+ */
+typedef struct esp_json_writer_t *esp_json_writer_handle_t;
+
+/**
+ * @brief Deepest nesting of objects and arrays supported by the writer
+ */
+#define ESP_JSON_WRITER_MAX_DEPTH 32
+
+/**
+ * @brief Create a streaming JSON writer
+ *
+ * The writer serializes the values in the order of the calls, adding the separators and escaping the strings.
+ * The document never needs to fit in memory: it is passed to the output callback each time the buffer is full.
+ *
+ * @param[in] config Writer configuration
+ * @param[out] ret_writer Returned writer handle
+ * @return
+ *      - ESP_OK: Writer created
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t esp_json_writer_new(const esp_json_writer_config_t *config, esp_json_writer_handle_t *ret_writer);
+
+/**
+ * @brief Start an object
+ *
+ * @note Inside an object, each value is preceded by a call to esp_json_writer_key().
+ *
+ * @param[in] writer Writer handle
+ * @return
+ *      - ESP_OK: Written
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_STATE: A value is not allowed here, or the nesting is deeper than ESP_JSON_WRITER_MAX_DEPTH
+ *      - Others: Error returned by the output callback
+ */
+esp_err_t esp_json_writer_object_start(esp_json_writer_handle_t writer);
+
+/**
+ * @brief End the current object
+ *
+ * @param[in] writer Writer handle
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_object_end(esp_json_writer_handle_t writer);
+
+/**
+ * @brief Start an array
+ *
+ * @param[in] writer Writer handle
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_array_start(esp_json_writer_handle_t writer);
+
+/**
+ * @brief End the current array
+ *
+ * @param[in] writer Writer handle
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_array_end(esp_json_writer_handle_t writer);
+
+/**
+ * @brief Write the name of the next member of the current object
+ *
+ * @param[in] writer Writer handle
+ * @param[in] key Zero-terminated member name
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_key(esp_json_writer_handle_t writer, const char *key);
+
+/**
+ * @brief Write a string value
+ *
+ * @param[in] writer Writer handle
+ * @param[in] str Zero-terminated string
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_string(esp_json_writer_handle_t writer, const char *str);
+
+/**
+ * @brief Write a number value
+ *
+ * Numbers are written with the shortest representation that reads back to the same double, as cJSON_Print() does.
+ * Infinity and NaN are written as null.
+ *
+ * @param[in] writer Writer handle
+ * @param[in] number Value
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_number(esp_json_writer_handle_t writer, double number);
+
+/**
+ * @brief Write an integer value
+ *
+ * @param[in] writer Writer handle
+ * @param[in] number Value
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_int(esp_json_writer_handle_t writer, int64_t number);
+
+/**
+ * @brief Write true or false
+ *
+ * @param[in] writer Writer handle
+ * @param[in] value Value
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_bool(esp_json_writer_handle_t writer, bool value);
+
+/**
+ * @brief Write null
+ *
+ * @param[in] writer Writer handle
+ * @return See esp_json_writer_object_start()
+ */
+esp_err_t esp_json_writer_null(esp_json_writer_handle_t writer);
+
+/**
+ * @brief Pass the buffered output to the output callback
+ *
+ * @param[in] writer Writer handle
+ * @return
+ *      - ESP_OK: Flushed
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - Others: Error returned by the output callback
+ */
+esp_err_t esp_json_writer_flush(esp_json_writer_handle_t writer);
+
+/**
+ * @brief Reset the writer to write a new document
+ *
+ * The buffered output is discarded.
+ *
+ * @param[in] writer Writer handle
+ * @return
+ *      - ESP_OK: Writer reset
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_json_writer_reset(esp_json_writer_handle_t writer);
+
+/**
+ * @brief Delete a streaming JSON writer
+ *
+ * The buffered output is discarded, call esp_json_writer_flush() first to keep it.
+ *
+ * @param[in] writer Writer handle
+ * @return
+ *      - ESP_OK: Writer deleted
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_json_writer_delete(esp_json_writer_handle_t writer);
+
+#ifdef __cplusplus
+}
+#endif
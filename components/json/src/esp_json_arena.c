@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "esp_check.h"
+#include "esp_json_stream.h"
+#include "esp_json_arena.h"
+
+static const char *TAG = "json_arena";
+
+#define JSON_ARENA_DEFAULT_BLOCK_SIZE   1024
+#define JSON_ARENA_DEFAULT_MAX_DEPTH    16
+#define JSON_ARENA_ALIGN                sizeof(double)
+
+typedef struct json_arena_block_t {
+    struct json_arena_block_t *next;
+    size_t size;
+    size_t used;
+    _Alignas(JSON_ARENA_ALIGN) uint8_t data[];
+} json_arena_block_t;
+
+typedef struct esp_json_arena_t {
+    json_arena_block_t *blocks;     // block being allocated from, followed by the full ones
+    size_t block_size;
+    size_t total_size;
+    esp_json_reader_handle_t reader;
+    cJSON *root;                    // root of the document being fed
+    char *key;                      // name of the next member of the current object
+    size_t depth;
+    cJSON *parents[];               // object or array being filled at each nesting level
+} esp_json_arena_t;
+
+static void *json_arena_alloc(esp_json_arena_t *arena, size_t size)
+{
+    size = (size + JSON_ARENA_ALIGN - 1) & ~(JSON_ARENA_ALIGN - 1);
+    json_arena_block_t *block = arena->blocks;
+    if (block == NULL || block->size - block->used < size) {
+        size_t block_size = (size > arena->block_size) ? size : arena->block_size;
+        json_arena_block_t *new_block = malloc(sizeof(json_arena_block_t) + block_size);
+        if (new_block == NULL) {
+            return NULL;
+        }
+        new_block->size = block_size;
+        new_block->used = 0;
+        arena->total_size += sizeof(json_arena_block_t) + block_size;
+        if (block != NULL && size > arena->block_size) {
+            // keep allocating the small items from the current block, the oversized one is full already
+            new_block->next = block->next;
+            block->next = new_block;
+        } else {
+            new_block->next = block;
+            arena->blocks = new_block;
+        }
+        block = new_block;
+    }
+    void *ptr = block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+static char *json_arena_strdup(esp_json_arena_t *arena, const char *str, size_t len)
+{
+    char *copy = json_arena_alloc(arena, len + 1);
+    if (copy != NULL) {
+        memcpy(copy, str, len);
+        copy[len] = '\0';
+    }
+    return copy;
+}
+
+// Adds the item to the current object or array the same way as cJSON_AddItemToArray():
+// the prev pointer of the first child points to the last child
+static void json_arena_attach(esp_json_arena_t *arena, cJSON *item)
+{
+    if (arena->depth == 0) {
+        arena->root = item;
+        return;
+    }
+    cJSON *parent = arena->parents[arena->depth - 1];
+    if (parent->type == cJSON_Object) {
+        item->string = arena->key;
+        arena->key = NULL;
+    }
+    if (parent->child == NULL) {
+        parent->child = item;
+    } else {
+        cJSON *last = parent->child->prev;
+        last->next = item;
+        item->prev = last;
+    }
+    parent->child->prev = item;
+}
+
+static esp_err_t json_arena_on_event(const esp_json_event_t *event, void *arg)
+{
+    esp_json_arena_t *arena = arg;
+    cJSON *item;
+
+    switch (event->type) {
+    case ESP_JSON_EVENT_KEY:
+        arena->key = json_arena_strdup(arena, event->str, event->len);
+        return arena->key ? ESP_OK : ESP_ERR_NO_MEM;
+    case ESP_JSON_EVENT_OBJECT_END:
+    case ESP_JSON_EVENT_ARRAY_END:
+        arena->depth--;
+        return ESP_OK;
+    default:
+        break;
+    }
+
+    item = json_arena_alloc(arena, sizeof(cJSON));
+    if (item == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    memset(item, 0, sizeof(cJSON));
+
+    switch (event->type) {
+    case ESP_JSON_EVENT_OBJECT_START:
+    case ESP_JSON_EVENT_ARRAY_START:
+        item->type = (event->type == ESP_JSON_EVENT_OBJECT_START) ? cJSON_Object : cJSON_Array;
+        json_arena_attach(arena, item);
+        // the reader limits the nesting to the size of parents[]
+        arena->parents[arena->depth++] = item;
+        return ESP_OK;
+    case ESP_JSON_EVENT_STRING:
+        item->type = cJSON_String;
+        item->valuestring = json_arena_strdup(arena, event->str, event->len);
+        if (item->valuestring == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        break;
+    case ESP_JSON_EVENT_NUMBER:
+        item->type = cJSON_Number;
+        item->valuedouble = event->number;
+        // saturate valueint as cJSON does
+        if (event->number >= INT_MAX) {
+            item->valueint = INT_MAX;
+        } else if (event->number <= (double)INT_MIN) {
+            item->valueint = INT_MIN;
+        } else {
+            item->valueint = (int)event->number;
+        }
+        break;
+    case ESP_JSON_EVENT_TRUE:
+        item->type = cJSON_True;
+        item->valueint = 1;
+        break;
+    case ESP_JSON_EVENT_FALSE:
+        item->type = cJSON_False;
+        break;
+    default:
+        item->type = cJSON_NULL;
+        break;
+    }
+    json_arena_attach(arena, item);
+    return ESP_OK;
+}
+
+static void json_arena_restart(esp_json_arena_t *arena)
+{
+    esp_json_reader_reset(arena->reader);
+    arena->root = NULL;
+    arena->key = NULL;
+    arena->depth = 0;
+}
+
+esp_err_t esp_json_arena_new(const esp_json_arena_config_t *config, esp_json_arena_handle_t *ret_arena)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_arena, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    size_t max_depth = config->max_depth ? config->max_depth : JSON_ARENA_DEFAULT_MAX_DEPTH;
+    esp_json_arena_t *arena = calloc(1, sizeof(esp_json_arena_t) + max_depth * sizeof(cJSON *));
+    ESP_RETURN_ON_FALSE(arena, ESP_ERR_NO_MEM, TAG, "no mem for arena");
+    arena->block_size = config->block_size ? config->block_size : JSON_ARENA_DEFAULT_BLOCK_SIZE;
+
+    esp_json_reader_config_t reader_config = {
+        .callback = json_arena_on_event,
+        .arg = arena,
+        .max_token_len = config->max_token_len,
+        .max_depth = max_depth,
+    };
+    ESP_GOTO_ON_ERROR(esp_json_reader_new(&reader_config, &arena->reader), err, TAG, "create reader failed");
+    *ret_arena = arena;
+    return ESP_OK;
+
+err:
+    free(arena);
+    return ret;
+}
+
+esp_err_t esp_json_arena_feed(esp_json_arena_handle_t arena, const char *data, size_t len)
+{
+    ESP_RETURN_ON_FALSE(arena, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_err_t ret = esp_json_reader_feed(arena->reader, data, len);
+    if (ret != ESP_OK) {
+        // discard the document, the items allocated for it are freed by the next reset
+        json_arena_restart(arena);
+    }
+    return ret;
+}
+
+esp_err_t esp_json_arena_finish(esp_json_arena_handle_t arena, cJSON **ret_root)
+{
+    ESP_RETURN_ON_FALSE(arena && ret_root, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_err_t ret = esp_json_reader_finish(arena->reader);
+    *ret_root = (ret == ESP_OK) ? arena->root : NULL;
+    json_arena_restart(arena);
+    return ret;
+}
+
+esp_err_t esp_json_arena_parse(esp_json_arena_handle_t arena, const char *data, size_t len, cJSON **ret_root)
+{
+    ESP_RETURN_ON_FALSE(arena && ret_root, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_err_t ret = esp_json_arena_feed(arena, data, len);
+    if (ret != ESP_OK) {
+        *ret_root = NULL;
+        return ret;
+    }
+    return esp_json_arena_finish(arena, ret_root);
+}
+
+esp_err_t esp_json_arena_reset(esp_json_arena_handle_t arena)
+{
+    ESP_RETURN_ON_FALSE(arena, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    json_arena_restart(arena);
+
+    // keep the last block of the list, the first one allocated, unless it is an oversized one
+    json_arena_block_t *keep = NULL;
+    json_arena_block_t *block = arena->blocks;
+    while (block != NULL) {
+        json_arena_block_t *next = block->next;
+        if (next == NULL && block->size == arena->block_size) {
+            keep = block;
+        } else {
+            arena->total_size -= sizeof(json_arena_block_t) + block->size;
+            free(block);
+        }
+        block = next;
+    }
+    if (keep != NULL) {
+        keep->used = 0;
+    }
+    arena->blocks = keep;
+    return ESP_OK;
+}
+
+size_t esp_json_arena_get_size(esp_json_arena_handle_t arena)
+{
+    return arena ? arena->total_size : 0;
+}
+
+esp_err_t esp_json_arena_delete(esp_json_arena_handle_t arena)
+{
+    ESP_RETURN_ON_FALSE(arena, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_json_arena_reset(arena);
+    free(arena->blocks);
+    esp_json_reader_delete(arena->reader);
+    free(arena);
+    return ESP_OK;
+}
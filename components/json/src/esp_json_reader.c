@@ -0,0 +1,457 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_json_stream.h"
+
+static const char *TAG = "json_reader";
+
+#define JSON_READER_DEFAULT_MAX_TOKEN_LEN   256
+#define JSON_READER_DEFAULT_MAX_DEPTH       16
+
+typedef enum {
+    JSON_STATE_VALUE,           // expecting a value
+    JSON_STATE_VALUE_OR_END,    // expecting the first element of an array or ']'
+    JSON_STATE_KEY,             // expecting the name of a member
+    JSON_STATE_KEY_OR_END,      // expecting the name of the first member of an object or '}'
+    JSON_STATE_COLON,           // expecting ':' after a member name
+    JSON_STATE_NEXT,            // expecting ',' or the end of the current object or array
+    JSON_STATE_STRING,          // inside a string
+    JSON_STATE_STRING_ESCAPE,   // after '\' inside a string
+    JSON_STATE_STRING_UNICODE,  // inside the hex digits of a \u escape
+    JSON_STATE_NUMBER,          // inside a number
+    JSON_STATE_LITERAL,         // inside true, false or null
+    JSON_STATE_DONE,            // the top level value is complete
+    JSON_STATE_ERROR,           // a previous call failed
+} json_state_t;
+
+typedef enum {
+    JSON_CONTAINER_OBJECT,
+    JSON_CONTAINER_ARRAY,
+} json_container_t;
+
+typedef struct esp_json_reader_t {
+    esp_json_event_cb_t callback;
+    void *arg;
+    json_state_t state;
+    bool string_is_key;         // the string being read is a member name
+    uint8_t unicode_digits;     // number of hex digits of the \u escape read so far
+    uint32_t unicode_code;      // value of the \u escape being read
+    uint32_t high_surrogate;    // first half of a surrogate pair waiting for the second one, 0 if none
+    const char *literal;        // true, false or null being read
+    size_t literal_pos;
+    esp_json_event_type_t literal_type;
+    size_t depth;
+    size_t max_depth;
+    uint8_t *stack;             // json_container_t of each nesting level
+    size_t token_len;
+    size_t token_size;
+    char token[];               // key, string or number being read
+} esp_json_reader_t;
+
+static inline bool json_is_whitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static esp_err_t json_reader_emit(esp_json_reader_t *reader, esp_json_event_type_t type, const char *str, size_t len, double number)
+{
+    esp_json_event_t event = {
+        .type = type,
+        .str = str,
+        .len = len,
+        .number = number,
+        .depth = reader->depth,
+    };
+    return reader->callback(&event, reader->arg);
+}
+
+static esp_err_t json_reader_token_append(esp_json_reader_t *reader, const char *data, size_t len)
+{
+    // keep room for the terminating zero
+    if (reader->token_len + len >= reader->token_size) {
+        ESP_LOGD(TAG, "token longer than %u bytes", (unsigned)(reader->token_size - 1));
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(reader->token + reader->token_len, data, len);
+    reader->token_len += len;
+    return ESP_OK;
+}
+
+static esp_err_t json_reader_append_utf8(esp_json_reader_t *reader, uint32_t code)
+{
+    char utf8[4];
+    size_t len;
+    if (code < 0x80) {
+        utf8[0] = (char)code;
+        len = 1;
+    } else if (code < 0x800) {
+        utf8[0] = (char)(0xC0 | (code >> 6));
+        utf8[1] = (char)(0x80 | (code & 0x3F));
+        len = 2;
+    } else if (code < 0x10000) {
+        utf8[0] = (char)(0xE0 | (code >> 12));
+        utf8[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (code & 0x3F));
+        len = 3;
+    } else {
+        utf8[0] = (char)(0xF0 | (code >> 18));
+        utf8[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+        utf8[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+        utf8[3] = (char)(0x80 | (code & 0x3F));
+        len = 4;
+    }
+    return json_reader_token_append(reader, utf8, len);
+}
+
+static void json_reader_value_done(esp_json_reader_t *reader)
+{
+    reader->state = (reader->depth == 0) ? JSON_STATE_DONE : JSON_STATE_NEXT;
+}
+
+static esp_err_t json_reader_push(esp_json_reader_t *reader, json_container_t container)
+{
+    if (reader->depth == reader->max_depth) {
+        ESP_LOGD(TAG, "nesting deeper than %u", (unsigned)reader->max_depth);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    esp_json_event_type_t type = (container == JSON_CONTAINER_OBJECT) ? ESP_JSON_EVENT_OBJECT_START : ESP_JSON_EVENT_ARRAY_START;
+    esp_err_t ret = json_reader_emit(reader, type, NULL, 0, 0);
+    reader->stack[reader->depth++] = container;
+    reader->state = (container == JSON_CONTAINER_OBJECT) ? JSON_STATE_KEY_OR_END : JSON_STATE_VALUE_OR_END;
+    return ret;
+}
+
+static esp_err_t json_reader_pop(esp_json_reader_t *reader, json_container_t container)
+{
+    if (reader->stack[reader->depth - 1] != container) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    reader->depth--;
+    json_reader_value_done(reader);
+    esp_json_event_type_t type = (container == JSON_CONTAINER_OBJECT) ? ESP_JSON_EVENT_OBJECT_END : ESP_JSON_EVENT_ARRAY_END;
+    return json_reader_emit(reader, type, NULL, 0, 0);
+}
+
+static esp_err_t json_reader_start_literal(esp_json_reader_t *reader, const char *literal, esp_json_event_type_t type)
+{
+    reader->literal = literal;
+    reader->literal_pos = 1;
+    reader->literal_type = type;
+    reader->state = JSON_STATE_LITERAL;
+    return ESP_OK;
+}
+
+static esp_err_t json_reader_start_value(esp_json_reader_t *reader, char c)
+{
+    switch (c) {
+    case '{':
+        return json_reader_push(reader, JSON_CONTAINER_OBJECT);
+    case '[':
+        return json_reader_push(reader, JSON_CONTAINER_ARRAY);
+    case '"':
+        reader->string_is_key = false;
+        reader->token_len = 0;
+        reader->state = JSON_STATE_STRING;
+        return ESP_OK;
+    case 't':
+        return json_reader_start_literal(reader, "true", ESP_JSON_EVENT_TRUE);
+    case 'f':
+        return json_reader_start_literal(reader, "false", ESP_JSON_EVENT_FALSE);
+    case 'n':
+        return json_reader_start_literal(reader, "null", ESP_JSON_EVENT_NULL);
+    default:
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            reader->token_len = 0;
+            reader->state = JSON_STATE_NUMBER;
+            return json_reader_token_append(reader, &c, 1);
+        }
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+}
+
+static esp_err_t json_reader_end_number(esp_json_reader_t *reader)
+{
+    char *end;
+    reader->token[reader->token_len] = '\0';
+    double number = strtod(reader->token, &end);
+    if (end != reader->token + reader->token_len) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    json_reader_value_done(reader);
+    return json_reader_emit(reader, ESP_JSON_EVENT_NUMBER, reader->token, reader->token_len, number);
+}
+
+static esp_err_t json_reader_end_unicode(esp_json_reader_t *reader)
+{
+    uint32_t code = reader->unicode_code;
+    reader->state = JSON_STATE_STRING;
+    if (reader->high_surrogate) {
+        if (code < 0xDC00 || code > 0xDFFF) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        code = 0x10000 + (((reader->high_surrogate & 0x3FF) << 10) | (code & 0x3FF));
+        reader->high_surrogate = 0;
+    } else if (code >= 0xD800 && code <= 0xDBFF) {
+        // the second half must follow as another \u escape
+        reader->high_surrogate = code;
+        return ESP_OK;
+    } else if (code >= 0xDC00 && code <= 0xDFFF) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    return json_reader_append_utf8(reader, code);
+}
+
+static int json_hex_value(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// Parses one character. Sets *consumed to false when the character ends a number and has to be parsed again.
+static esp_err_t json_reader_char(esp_json_reader_t *reader, char c, bool *consumed)
+{
+    *consumed = true;
+
+    switch (reader->state) {
+    case JSON_STATE_VALUE:
+        if (json_is_whitespace(c)) {
+            return ESP_OK;
+        }
+        return json_reader_start_value(reader, c);
+
+    case JSON_STATE_VALUE_OR_END:
+        if (json_is_whitespace(c)) {
+            return ESP_OK;
+        }
+        if (c == ']') {
+            return json_reader_pop(reader, JSON_CONTAINER_ARRAY);
+        }
+        return json_reader_start_value(reader, c);
+
+    case JSON_STATE_KEY_OR_END:
+        if (c == '}') {
+            return json_reader_pop(reader, JSON_CONTAINER_OBJECT);
+        }
+    /* fall through */
+    case JSON_STATE_KEY:
+        if (json_is_whitespace(c)) {
+            return ESP_OK;
+        }
+        if (c != '"') {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        reader->string_is_key = true;
+        reader->token_len = 0;
+        reader->state = JSON_STATE_STRING;
+        return ESP_OK;
+
+    case JSON_STATE_COLON:
+        if (json_is_whitespace(c)) {
+            return ESP_OK;
+        }
+        if (c != ':') {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        reader->state = JSON_STATE_VALUE;
+        return ESP_OK;
+
+    case JSON_STATE_NEXT:
+        if (json_is_whitespace(c)) {
+            return ESP_OK;
+        }
+        if (c == ',') {
+            reader->state = (reader->stack[reader->depth - 1] == JSON_CONTAINER_OBJECT) ? JSON_STATE_KEY : JSON_STATE_VALUE;
+            return ESP_OK;
+        }
+        if (c == '}') {
+            return json_reader_pop(reader, JSON_CONTAINER_OBJECT);
+        }
+        if (c == ']') {
+            return json_reader_pop(reader, JSON_CONTAINER_ARRAY);
+        }
+        return ESP_ERR_INVALID_RESPONSE;
+
+    case JSON_STATE_STRING:
+        if (reader->high_surrogate && c != '\\') {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        if (c == '\\') {
+            reader->state = JSON_STATE_STRING_ESCAPE;
+            return ESP_OK;
+        }
+        if (c == '"') {
+            reader->token[reader->token_len] = '\0';
+            if (reader->string_is_key) {
+                reader->state = JSON_STATE_COLON;
+                return json_reader_emit(reader, ESP_JSON_EVENT_KEY, reader->token, reader->token_len, 0);
+            }
+            json_reader_value_done(reader);
+            return json_reader_emit(reader, ESP_JSON_EVENT_STRING, reader->token, reader->token_len, 0);
+        }
+        if ((unsigned char)c < 0x20) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        return json_reader_token_append(reader, &c, 1);
+
+    case JSON_STATE_STRING_ESCAPE: {
+        char unescaped;
+        if (reader->high_surrogate && c != 'u') {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+            unescaped = c;
+            break;
+        case 'b':
+            unescaped = '\b';
+            break;
+        case 'f':
+            unescaped = '\f';
+            break;
+        case 'n':
+            unescaped = '\n';
+            break;
+        case 'r':
+            unescaped = '\r';
+            break;
+        case 't':
+            unescaped = '\t';
+            break;
+        case 'u':
+            reader->unicode_code = 0;
+            reader->unicode_digits = 0;
+            reader->state = JSON_STATE_STRING_UNICODE;
+            return ESP_OK;
+        default:
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        reader->state = JSON_STATE_STRING;
+        return json_reader_token_append(reader, &unescaped, 1);
+    }
+
+    case JSON_STATE_STRING_UNICODE: {
+        int digit = json_hex_value(c);
+        if (digit < 0) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        reader->unicode_code = (reader->unicode_code << 4) | digit;
+        if (++reader->unicode_digits < 4) {
+            return ESP_OK;
+        }
+        return json_reader_end_unicode(reader);
+    }
+
+    case JSON_STATE_NUMBER:
+        if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+            return json_reader_token_append(reader, &c, 1);
+        }
+        *consumed = false;
+        return json_reader_end_number(reader);
+
+    case JSON_STATE_LITERAL:
+        if (c != reader->literal[reader->literal_pos]) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        if (reader->literal[++reader->literal_pos] != '\0') {
+            return ESP_OK;
+        }
+        json_reader_value_done(reader);
+        return json_reader_emit(reader, reader->literal_type, NULL, 0, 0);
+
+    case JSON_STATE_DONE:
+        return json_is_whitespace(c) ? ESP_OK : ESP_ERR_INVALID_RESPONSE;
+
+    default:
+        return ESP_ERR_INVALID_STATE;
+    }
+}
+
+esp_err_t esp_json_reader_new(const esp_json_reader_config_t *config, esp_json_reader_handle_t *ret_reader)
+{
+    ESP_RETURN_ON_FALSE(config && config->callback && ret_reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    size_t token_size = (config->max_token_len ? config->max_token_len : JSON_READER_DEFAULT_MAX_TOKEN_LEN) + 1;
+    size_t max_depth = config->max_depth ? config->max_depth : JSON_READER_DEFAULT_MAX_DEPTH;
+    esp_json_reader_t *reader = calloc(1, sizeof(esp_json_reader_t) + token_size + max_depth);
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_NO_MEM, TAG, "no mem for reader");
+
+    reader->callback = config->callback;
+    reader->arg = config->arg;
+    reader->token_size = token_size;
+    reader->max_depth = max_depth;
+    reader->stack = (uint8_t *)reader->token + token_size;
+    reader->state = JSON_STATE_VALUE;
+    *ret_reader = reader;
+    return ESP_OK;
+}
+
+esp_err_t esp_json_reader_feed(esp_json_reader_handle_t reader, const char *data, size_t len)
+{
+    ESP_RETURN_ON_FALSE(reader && (data || len == 0), ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(reader->state != JSON_STATE_ERROR, ESP_ERR_INVALID_STATE, TAG, "reader needs a reset");
+
+    size_t pos = 0;
+    while (pos < len) {
+        bool consumed;
+        esp_err_t ret = json_reader_char(reader, data[pos], &consumed);
+        if (ret != ESP_OK) {
+            ESP_LOGD(TAG, "parsing stopped at byte %u of the chunk: %s", (unsigned)pos, esp_err_to_name(ret));
+            reader->state = JSON_STATE_ERROR;
+            return ret;
+        }
+        if (consumed) {
+            pos++;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_json_reader_finish(esp_json_reader_handle_t reader)
+{
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(reader->state != JSON_STATE_ERROR, ESP_ERR_INVALID_STATE, TAG, "reader needs a reset");
+
+    esp_err_t ret = ESP_ERR_INVALID_RESPONSE;
+    if (reader->state == JSON_STATE_NUMBER && reader->depth == 0) {
+        ret = json_reader_end_number(reader);
+    } else if (reader->state == JSON_STATE_DONE) {
+        ret = ESP_OK;
+    }
+    if (ret != ESP_OK) {
+        reader->state = JSON_STATE_ERROR;
+    }
+    return ret;
+}
+
+esp_err_t esp_json_reader_reset(esp_json_reader_handle_t reader)
+{
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    reader->state = JSON_STATE_VALUE;
+    reader->depth = 0;
+    reader->token_len = 0;
+    reader->high_surrogate = 0;
+    return ESP_OK;
+}
+
+esp_err_t esp_json_reader_delete(esp_json_reader_handle_t reader)
+{
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(reader);
+    return ESP_OK;
+}
@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+#include "esp_check.h"
+#include "esp_json_stream.h"
+
+static const char *TAG = "json_writer";
+
+#define JSON_WRITER_DEFAULT_BUFFER_SIZE 256
+
+typedef struct esp_json_writer_t {
+    esp_json_output_cb_t output;
+    void *arg;
+    uint32_t object_mask;       // bit n is set when the container at depth n is an object
+    uint32_t not_empty_mask;    // bit n is set when the container at depth n already has a value
+    size_t depth;
+    bool after_key;             // a member name was written, its value is expected
+    bool done;                  // the top level value is complete
+    size_t len;
+    size_t size;
+    char buf[];
+} esp_json_writer_t;
+
+static esp_err_t json_writer_flush(esp_json_writer_t *writer)
+{
+    esp_err_t ret = ESP_OK;
+    if (writer->len) {
+        ret = writer->output(writer->buf, writer->len, writer->arg);
+        writer->len = 0;
+    }
+    return ret;
+}
+
+static esp_err_t json_writer_put(esp_json_writer_t *writer, const char *data, size_t len)
+{
+    while (len) {
+        if (writer->len == writer->size) {
+            ESP_RETURN_ON_ERROR(json_writer_flush(writer), TAG, "output failed");
+        }
+        size_t chunk = writer->size - writer->len;
+        if (chunk > len) {
+            chunk = len;
+        }
+        memcpy(writer->buf + writer->len, data, chunk);
+        writer->len += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+    return ESP_OK;
+}
+
+static inline esp_err_t json_writer_putc(esp_json_writer_t *writer, char c)
+{
+    if (writer->len < writer->size) {
+        writer->buf[writer->len++] = c;
+        return ESP_OK;
+    }
+    return json_writer_put(writer, &c, 1);
+}
+
+static inline bool json_writer_in_object(const esp_json_writer_t *writer)
+{
+    return writer->depth && (writer->object_mask & (1UL << (writer->depth - 1)));
+}
+
+// Checks that a value is allowed here and writes the separator preceding it
+static esp_err_t json_writer_begin_value(esp_json_writer_t *writer)
+{
+    if (writer->done || (json_writer_in_object(writer) && !writer->after_key)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (writer->after_key) {
+        writer->after_key = false;
+        return ESP_OK;
+    }
+    if (writer->depth) {
+        uint32_t bit = 1UL << (writer->depth - 1);
+        if (writer->not_empty_mask & bit) {
+            return json_writer_putc(writer, ',');
+        }
+        writer->not_empty_mask |= bit;
+    }
+    return ESP_OK;
+}
+
+static void json_writer_end_value(esp_json_writer_t *writer)
+{
+    if (writer->depth == 0) {
+        writer->done = true;
+    }
+}
+
+static esp_err_t json_writer_put_string(esp_json_writer_t *writer, const char *str)
+{
+    static const char hex[] = "0123456789abcdef";
+    ESP_RETURN_ON_ERROR(json_writer_putc(writer, '"'), TAG, "output failed");
+    const char *run = str;
+    for (const char *p = str; ; p++) {
+        unsigned char c = (unsigned char) * p;
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        // write the characters not needing an escape at once
+        ESP_RETURN_ON_ERROR(json_writer_put(writer, run, p - run), TAG, "output failed");
+        run = p + 1;
+        if (c == '\0') {
+            break;
+        }
+        char escape[6] = {'\\', (char)c};
+        size_t escape_len = 2;
+        switch (c) {
+        case '"':
+        case '\\':
+            break;
+        case '\b':
+            escape[1] = 'b';
+            break;
+        case '\f':
+            escape[1] = 'f';
+            break;
+        case '\n':
+            escape[1] = 'n';
+            break;
+        case '\r':
+            escape[1] = 'r';
+            break;
+        case '\t':
+            escape[1] = 't';
+            break;
+        default:
+            memcpy(escape + 1, "u00", 3);
+            escape[4] = hex[c >> 4];
+            escape[5] = hex[c & 0xF];
+            escape_len = 6;
+            break;
+        }
+        ESP_RETURN_ON_ERROR(json_writer_put(writer, escape, escape_len), TAG, "output failed");
+    }
+    return json_writer_putc(writer, '"');
+}
+
+static esp_err_t json_writer_start(esp_json_writer_t *writer, bool object)
+{
+    ESP_RETURN_ON_FALSE(writer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(writer->depth < ESP_JSON_WRITER_MAX_DEPTH, ESP_ERR_INVALID_STATE, TAG, "nesting too deep");
+    ESP_RETURN_ON_FALSE(json_writer_begin_value(writer) == ESP_OK, ESP_ERR_INVALID_STATE, TAG, "value not allowed here");
+
+    uint32_t bit = 1UL << writer->depth;
+    if (object) {
+        writer->object_mask |= bit;
+    } else {
+        writer->object_mask &= ~bit;
+    }
+    writer->not_empty_mask &= ~bit;
+    writer->depth++;
+    return json_writer_putc(writer, object ? '{' : '[');
+}
+
+static esp_err_t json_writer_end(esp_json_writer_t *writer, bool object)
+{
+    ESP_RETURN_ON_FALSE(writer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(writer->depth && json_writer_in_object(writer) == object && !writer->after_key,
+                        ESP_ERR_INVALID_STATE, TAG, "no %s to end", object ? "object" : "array");
+    writer->depth--;
+    json_writer_end_value(writer);
+    return json_writer_putc(writer, object ? '}' : ']');
+}
+
+// Writes a value which needs no escaping
+static esp_err_t json_writer_raw_value(esp_json_writer_t *writer, const char *text, size_t len)
+{
+    ESP_RETURN_ON_FALSE(writer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(json_writer_begin_value(writer) == ESP_OK, ESP_ERR_INVALID_STATE, TAG, "value not allowed here");
+    json_writer_end_value(writer);
+    return json_writer_put(writer, text, len);
+}
+
+esp_err_t esp_json_writer_new(const esp_json_writer_config_t *config, esp_json_writer_handle_t *ret_writer)
+{
+    ESP_RETURN_ON_FALSE(config && config->output && ret_writer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    size_t size = config->buffer_size ? config->buffer_size : JSON_WRITER_DEFAULT_BUFFER_SIZE;
+    esp_json_writer_t *writer = calloc(1, sizeof(esp_json_writer_t) + size);
+    ESP_RETURN_ON_FALSE(writer, ESP_ERR_NO_MEM, TAG, "no mem for writer");
+
+    writer->output = config->output;
+    writer->arg = config->arg;
+    writer->size = size;
+    *ret_writer = writer;
+    return ESP_OK;
+}
+
+esp_err_t esp_json_writer_object_start(esp_json_writer_handle_t writer)
+{
+    return json_writer_start(writer, true);
+}
+
+esp_err_t esp_json_writer_object_end(esp_json_writer_handle_t writer)
+{
+    return json_writer_end(writer, true);
+}
+
+esp_err_t esp_json_writer_array_start(esp_json_writer_handle_t writer)
+{
+    return json_writer_start(writer, false);
+}
+
+esp_err_t esp_json_writer_array_end(esp_json_writer_handle_t writer)
+{
+    return json_writer_end(writer, false);
+}
+
+esp_err_t esp_json_writer_key(esp_json_writer_handle_t writer, const char *key)
+{
+    ESP_RETURN_ON_FALSE(writer && key, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(json_writer_in_object(writer) && !writer->after_key, ESP_ERR_INVALID_STATE, TAG, "key not allowed here");
+
+    uint32_t bit = 1UL << (writer->depth - 1);
+    if (writer->not_empty_mask & bit) {
+        ESP_RETURN_ON_ERROR(json_writer_putc(writer, ','), TAG, "output failed");
+    }
+    writer->not_empty_mask |= bit;
+    writer->after_key = true;
+    ESP_RETURN_ON_ERROR(json_writer_put_string(writer, key), TAG, "output failed");
+    return json_writer_putc(writer, ':');
+}
+
+esp_err_t esp_json_writer_string(esp_json_writer_handle_t writer, const char *str)
+{
+    ESP_RETURN_ON_FALSE(writer && str, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(json_writer_begin_value(writer) == ESP_OK, ESP_ERR_INVALID_STATE, TAG, "value not allowed here");
+    json_writer_end_value(writer);
+    return json_writer_put_string(writer, str);
+}
+
+esp_err_t esp_json_writer_number(esp_json_writer_handle_t writer, double number)
+{
+    char text[26];
+    int len;
+    if (isnan(number) || isinf(number)) {
+        return json_writer_raw_value(writer, "null", 4);
+    }
+    // same representation as cJSON_Print(): 15 digits, or 17 when 15 don't read back to the same value
+    len = snprintf(text, sizeof(text), "%1.15g", number);
+    if (strtod(text, NULL) != number) {
+        len = snprintf(text, sizeof(text), "%1.17g", number);
+    }
+    return json_writer_raw_value(writer, text, len);
+}
+
+esp_err_t esp_json_writer_int(esp_json_writer_handle_t writer, int64_t number)
+{
+    char text[21];
+    int len = snprintf(text, sizeof(text), "%" PRId64, number);
+    return json_writer_raw_value(writer, text, len);
+}
+
+esp_err_t esp_json_writer_bool(esp_json_writer_handle_t writer, bool value)
+{
+    return value ? json_writer_raw_value(writer, "true", 4) : json_writer_raw_value(writer, "false", 5);
+}
+
+esp_err_t esp_json_writer_null(esp_json_writer_handle_t writer)
+{
+    return json_writer_raw_value(writer, "null", 4);
+}
+
+esp_err_t esp_json_writer_flush(esp_json_writer_handle_t writer)
+{
+    ESP_RETURN_ON_FALSE(writer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return json_writer_flush(writer);
+}
+
+esp_err_t esp_json_writer_reset(esp_json_writer_handle_t writer)
+{
+    ESP_RETURN_ON_FALSE(writer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    writer->depth = 0;
+    writer->after_key = false;
+    writer->done = false;
+    writer->len = 0;
+    return ESP_OK;
+}
+
+esp_err_t esp_json_writer_delete(esp_json_writer_handle_t writer)
+{
+    ESP_RETURN_ON_FALSE(writer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(writer);
+    return ESP_OK;
+}
@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include "unity.h"
+#include "esp_json_stream.h"
+#include "esp_json_arena.h"
+
+static const char s_test_doc[] = "{\"name\": \"Jack (\\\"Bee\\\") Nimble\", \"format\": {\"type\": \"rect\", "
+                                 "\"width\": 1920, \"rate\": -2.5e1, \"interlace\": false, \"tags\": [true, null, \"\\u00e9\\ud83d\\ude00\"]}, "
+                                 "\"empty\": {}, \"list\": []}";
+
+typedef struct {
+    char log[512];
+    size_t events;
+} test_events_t;
+
+static esp_err_t test_log_event(const esp_json_event_t *event, void *arg)
+{
+    test_events_t *events = arg;
+    size_t len = strlen(events->log);
+    snprintf(events->log + len, sizeof(events->log) - len, "%d/%u%s%s ", event->type, (unsigned)event->depth,
+             event->str ? ":" : "", event->str ? event->str : "");
+    events->events++;
+    return ESP_OK;
+}
+
+TEST_CASE("json reader reports the events of a document fed byte per byte", "[json][linux]")
+{
+    test_events_t whole = {};
+    test_events_t bytes = {};
+    esp_json_reader_config_t config = {
+        .callback = test_log_event,
+        .arg = &whole,
+    };
+    esp_json_reader_handle_t reader;
+    TEST_ESP_OK(esp_json_reader_new(&config, &reader));
+    TEST_ESP_OK(esp_json_reader_feed(reader, s_test_doc, strlen(s_test_doc)));
+    TEST_ESP_OK(esp_json_reader_finish(reader));
+    TEST_ESP_OK(esp_json_reader_delete(reader));
+
+    config.arg = &bytes;
+    TEST_ESP_OK(esp_json_reader_new(&config, &reader));
+    for (size_t i = 0; i < strlen(s_test_doc); i++) {
+        TEST_ESP_OK(esp_json_reader_feed(reader, &s_test_doc[i], 1));
+    }
+    TEST_ESP_OK(esp_json_reader_finish(reader));
+    TEST_ESP_OK(esp_json_reader_delete(reader));
+
+    TEST_ASSERT_EQUAL(27, whole.events);
+    TEST_ASSERT_EQUAL_STRING(whole.log, bytes.log);
+    TEST_ASSERT_NOT_NULL(strstr(whole.log, "4/1:name 5/1:Jack (\"Bee\") Nimble "));
+    TEST_ASSERT_NOT_NULL(strstr(whole.log, "6/2:-2.5e1 "));
+    TEST_ASSERT_NOT_NULL(strstr(whole.log, "5/3:\xc3\xa9\xf0\x9f\x98\x80 "));
+}
+
+TEST_CASE("json reader rejects invalid documents", "[json][linux]")
+{
+    static const char *const invalid_docs[] = {
+        "[1,]", "{\"a\"}", "{\"a\":1,}", "[1]]", "[1}", "[tru]", "[01x]", "\"\\ud83d\"", "\"\\q\"", "\"a\nb\"", "1 2",
+    };
+    test_events_t events = {};
+    esp_json_reader_config_t config = {
+        .callback = test_log_event,
+        .arg = &events,
+        .max_depth = 4,
+        .max_token_len = 8,
+    };
+    esp_json_reader_handle_t reader;
+    TEST_ESP_OK(esp_json_reader_new(&config, &reader));
+
+    for (size_t i = 0; i < sizeof(invalid_docs) / sizeof(invalid_docs[0]); i++) {
+        TEST_ESP_OK(esp_json_reader_reset(reader));
+        esp_err_t ret = esp_json_reader_feed(reader, invalid_docs[i], strlen(invalid_docs[i]));
+        if (ret == ESP_OK) {
+            ret = esp_json_reader_finish(reader);
+        }
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_ERR_INVALID_RESPONSE, ret, invalid_docs[i]);
+        // the reader stays in error until reset
+        TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_json_reader_feed(reader, " ", 1));
+    }
+
+    // incomplete document
+    TEST_ESP_OK(esp_json_reader_reset(reader));
+    TEST_ESP_OK(esp_json_reader_feed(reader, "[1", 2));
+    TEST_ESP_ERR(ESP_ERR_INVALID_RESPONSE, esp_json_reader_finish(reader));
+
+    // limits
+    TEST_ESP_OK(esp_json_reader_reset(reader));
+    TEST_ESP_ERR(ESP_ERR_INVALID_SIZE, esp_json_reader_feed(reader, "[[[[[", 5));
+    TEST_ESP_OK(esp_json_reader_reset(reader));
+    TEST_ESP_ERR(ESP_ERR_INVALID_SIZE, esp_json_reader_feed(reader, "\"123456789\"", 11));
+
+    // a top level number is complete at the end of the document
+    TEST_ESP_OK(esp_json_reader_reset(reader));
+    events.events = 0;
+    TEST_ESP_OK(esp_json_reader_feed(reader, "42", 2));
+    TEST_ASSERT_EQUAL(0, events.events);
+    TEST_ESP_OK(esp_json_reader_finish(reader));
+    TEST_ASSERT_EQUAL(1, events.events);
+
+    TEST_ESP_OK(esp_json_reader_delete(reader));
+}
+
+typedef struct {
+    char text[256];
+    size_t len;
+    size_t calls;
+} test_output_t;
+
+static esp_err_t test_output(const char *data, size_t len, void *arg)
+{
+    test_output_t *output = arg;
+    TEST_ASSERT_LESS_THAN(sizeof(output->text), output->len + len);
+    memcpy(output->text + output->len, data, len);
+    output->len += len;
+    output->calls++;
+    return ESP_OK;
+}
+
+TEST_CASE("json writer serializes through a small buffer", "[json][linux]")
+{
+    test_output_t output = {};
+    esp_json_writer_config_t config = {
+        .output = test_output,
+        .arg = &output,
+        .buffer_size = 8,
+    };
+    esp_json_writer_handle_t writer;
+    TEST_ESP_OK(esp_json_writer_new(&config, &writer));
+
+    TEST_ESP_OK(esp_json_writer_object_start(writer));
+    TEST_ESP_OK(esp_json_writer_key(writer, "values"));
+    TEST_ESP_OK(esp_json_writer_array_start(writer));
+    TEST_ESP_OK(esp_json_writer_int(writer, -1234567890123LL));
+    TEST_ESP_OK(esp_json_writer_number(writer, 0.1));
+    TEST_ESP_OK(esp_json_writer_bool(writer, true));
+    TEST_ESP_OK(esp_json_writer_null(writer));
+    TEST_ESP_OK(esp_json_writer_array_end(writer));
+    // a value needs a key inside an object
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_json_writer_string(writer, "value"));
+    TEST_ESP_OK(esp_json_writer_key(writer, "esc\"\n\x01"));
+    TEST_ESP_OK(esp_json_writer_string(writer, "a\\b"));
+    TEST_ESP_OK(esp_json_writer_key(writer, "empty"));
+    TEST_ESP_OK(esp_json_writer_object_start(writer));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_json_writer_array_end(writer));
+    TEST_ESP_OK(esp_json_writer_object_end(writer));
+    TEST_ESP_OK(esp_json_writer_object_end(writer));
+    // only one top level value
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_json_writer_null(writer));
+    TEST_ESP_OK(esp_json_writer_flush(writer));
+    TEST_ESP_OK(esp_json_writer_delete(writer));
+
+    output.text[output.len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("{\"values\":[-1234567890123,0.1,true,null],\"esc\\\"\\n\\u0001\":\"a\\\\b\",\"empty\":{}}", output.text);
+    TEST_ASSERT_GREATER_THAN(1, output.calls);
+}
+
+TEST_CASE("json arena builds cJSON trees", "[json][linux]")
+{
+    esp_json_arena_config_t config = {
+        .block_size = 256,
+    };
+    esp_json_arena_handle_t arena;
+    TEST_ESP_OK(esp_json_arena_new(&config, &arena));
+
+    // the document is fed in chunks, as read from an HTTP client
+    cJSON *root;
+    for (size_t pos = 0; pos < strlen(s_test_doc); pos += 7) {
+        size_t len = strlen(s_test_doc) - pos;
+        TEST_ESP_OK(esp_json_arena_feed(arena, s_test_doc + pos, len < 7 ? len : 7));
+    }
+    TEST_ESP_OK(esp_json_arena_finish(arena, &root));
+
+    TEST_ASSERT_TRUE(cJSON_IsObject(root));
+    TEST_ASSERT_EQUAL_STRING("Jack (\"Bee\") Nimble", cJSON_GetStringValue(cJSON_GetObjectItem(root, "name")));
+    cJSON *format = cJSON_GetObjectItem(root, "format");
+    TEST_ASSERT_EQUAL(1920, cJSON_GetObjectItem(format, "width")->valueint);
+    TEST_ASSERT_EQUAL_DOUBLE(-25.0, cJSON_GetNumberValue(cJSON_GetObjectItem(format, "rate")));
+    TEST_ASSERT_TRUE(cJSON_IsFalse(cJSON_GetObjectItem(format, "interlace")));
+    cJSON *tags = cJSON_GetObjectItem(format, "tags");
+    TEST_ASSERT_EQUAL(3, cJSON_GetArraySize(tags));
+    TEST_ASSERT_TRUE(cJSON_IsNull(cJSON_GetArrayItem(tags, 1)));
+    TEST_ASSERT_EQUAL_PTR(cJSON_GetArrayItem(tags, 2), tags->child->prev);
+    TEST_ASSERT_EQUAL(0, cJSON_GetArraySize(cJSON_GetObjectItem(root, "list")));
+
+    char *printed = cJSON_PrintUnformatted(root);
+    TEST_ASSERT_NOT_NULL(printed);
+    cJSON *reparsed = cJSON_Parse(printed);
+    TEST_ASSERT_TRUE(cJSON_Compare(root, reparsed, true));
+    cJSON_Delete(reparsed);
+    cJSON_free(printed);
+
+    // a failed document doesn't affect the next one
+    TEST_ESP_ERR(ESP_ERR_INVALID_RESPONSE, esp_json_arena_parse(arena, "[1,]", 4, &root));
+    TEST_ASSERT_NULL(root);
+    TEST_ESP_OK(esp_json_arena_parse(arena, "[1,2]", 5, &root));
+    TEST_ASSERT_EQUAL(2, cJSON_GetArraySize(root));
+
+    size_t size = esp_json_arena_get_size(arena);
+    TEST_ASSERT_GREATER_THAN(config.block_size, size);
+    TEST_ESP_OK(esp_json_arena_reset(arena));
+    TEST_ASSERT_LESS_THAN(size, esp_json_arena_get_size(arena));
+
+    TEST_ESP_OK(esp_json_arena_delete(arena));
+}
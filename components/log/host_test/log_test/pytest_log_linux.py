@@ -20,6 +20,7 @@ from pytest_embedded_idf.utils import idf_parametrize
         'v2_system_timestamp',
         'tag_level_linked_list',
         'tag_level_linked_list_and_array_cache',
+        'tag_level_linked_list_and_binary_heap_cache',
         'tag_level_none',
     ],
     indirect=True,
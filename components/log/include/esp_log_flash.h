@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start storing the log output in the flash partition labeled CONFIG_LOG_FLASH_SINK_PARTITION_LABEL
+ *
+ * The output of the log functions is copied into a RAM buffer and then passed on to the function which was
+ * set by esp_log_set_vprintf() before. A low priority task writes the buffer to the partition in flash pages,
+ * as a circular log which survives resets. The sector after the one being written is erased in advance,
+ * so the oldest sector of the log is dropped when the partition is full.
+ *
+ * If CONFIG_LOG_BINARY is enabled, the binary frames are stored, decode them with tools/log_binary_decode.py.
+ *
+ * @note Call esp_log_set_vprintf() before this function if the output should go to another destination as well.
+ * @note Only available if CONFIG_LOG_FLASH_SINK is enabled. This function is not thread safe.
+ *
+ * @return
+ *      - ESP_OK: Start the flash sink successfully, or it was already started
+ *      - ESP_ERR_NOT_FOUND: Start the flash sink failed because the partition was not found
+ *      - ESP_ERR_INVALID_SIZE: Start the flash sink failed because the partition has less than 2 sectors
+ *      - ESP_ERR_NO_MEM: Start the flash sink failed because of out of memory
+ *      - Others: Start the flash sink failed because of a flash error
+ */
+esp_err_t esp_log_flash_sink_start(void);
+
+/**
+ * @brief Stop storing the log output in flash, and write the buffered output
+ *
+ * The output function which was set before esp_log_flash_sink_start() is restored. The task and the buffer
+ * are kept, so that the log can still be read and the sink can be started again.
+ *
+ * @note Only available if CONFIG_LOG_FLASH_SINK is enabled. This function is not thread safe.
+ *
+ * @return
+ *      - ESP_OK: Stop the flash sink successfully
+ *      - ESP_ERR_INVALID_STATE: Stop the flash sink failed because it is not started, or another output function
+ *        has been set after esp_log_flash_sink_start()
+ *      - Others: Write the buffered output failed because of a flash error
+ */
+esp_err_t esp_log_flash_sink_stop(void);
+
+/**
+ * @brief Write the buffered log output to flash
+ *
+ * The writer task only writes full pages, and the rest after CONFIG_LOG_FLASH_SINK_FLUSH_PERIOD_MS without new output.
+ * Call this function to write the rest now, e.g. before esp_restart() or esp_log_flash_sink_read().
+ *
+ * @note Only available if CONFIG_LOG_FLASH_SINK is enabled.
+ *
+ * @return
+ *      - ESP_OK: Write the buffered output successfully
+ *      - ESP_ERR_INVALID_STATE: Write the buffered output failed because the sink was never started
+ *      - Others: Write the buffered output failed because of a flash error
+ */
+esp_err_t esp_log_flash_sink_flush(void);
+
+/**
+ * @brief Read the log stored in flash, from the oldest to the newest output
+ *
+ * Each call reads as many flash pages as fit into the buffer with a single flash read, and returns the
+ * log output they hold. Pages which have been overwritten or were not completely written are skipped.
+ *
+ * @code{c}
+ * uint32_t pos = 0;
+ * size_t len;
+ * while (esp_log_flash_sink_read(&pos, buf, sizeof(buf), &len) == ESP_OK && len > 0) {
+ *     upload(buf, len);
+ * }
+ * @endcode
+ *
+ * @note Only available if CONFIG_LOG_FLASH_SINK is enabled.
+ *
+ * @param[inout] pos Position to read from, updated to the position of the next read. 0 reads from the oldest
+ *                   output. The positions keep increasing across resets, so a position stored after an upload
+ *                   can be used to upload only the newer output later.
+ * @param[out] buf Buffer for the log output, also used for reading the pages
+ * @param[in] size Size of the buffer, at least 256 bytes (one page)
+ * @param[out] out_len Number of bytes of log output in the buffer, 0 if there is no more output to read
+ * @return
+ *      - ESP_OK: Read the log successfully
+ *      - ESP_ERR_INVALID_ARG: Read the log failed because of invalid argument
+ *      - ESP_ERR_INVALID_SIZE: Read the log failed because the buffer is smaller than a page
+ *      - ESP_ERR_INVALID_STATE: Read the log failed because the sink was never started
+ *      - Others: Read the log failed because of a flash error
+ */
+esp_err_t esp_log_flash_sink_read(uint32_t *pos, void *buf, size_t size, size_t *out_len);
+
+/**
+ * @brief Get the number of bytes of log output which were dropped because the RAM buffer was full
+ *
+ * @note Only available if CONFIG_LOG_FLASH_SINK is enabled.
+ *
+ * @return Number of bytes dropped since startup.
+ */
+uint32_t esp_log_flash_sink_get_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -67,6 +67,27 @@ void esp_log_write(esp_log_level_t level, const char* tag, const char* format, .
  */
 void esp_log_writev(esp_log_level_t level, const char* tag, const char* format, va_list args);
 
+/**
+ * @brief Wait until the deferred log messages have been output
+ *
+ * Waits for the messages which were written before this call, if CONFIG_LOG_DEFERRED is enabled.
+ * Messages are lost if they are still in the buffer when the chip resets, so this function should
+ * be called before esp_restart(), for example.
+ *
+ * @note Only available if CONFIG_LOG_DEFERRED is enabled. It returns immediately if called from
+ *       the function set by esp_log_set_vprintf().
+ */
+void esp_log_deferred_flush(void);
+
+/**
+ * @brief Get the number of deferred log messages which were dropped because the buffer was full
+ *
+ * @note Only available if CONFIG_LOG_DEFERRED is enabled.
+ *
+ * @return Number of messages dropped since startup.
+ */
+uint32_t esp_log_deferred_get_dropped(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_LOG_ARGS_MAX_SPEC_LEN              (16) /*!< Longer conversion specifications are not supported */
+
+/**
+ * @brief Type of the argument of a conversion
+ */
+typedef enum {
+    ESP_LOG_ARG_INT,        /*!< int, also for char and short */
+    ESP_LOG_ARG_LONG,       /*!< long */
+    ESP_LOG_ARG_LONG_LONG,  /*!< long long */
+    ESP_LOG_ARG_INTMAX,     /*!< intmax_t */
+    ESP_LOG_ARG_SIZE,       /*!< size_t */
+    ESP_LOG_ARG_PTRDIFF,    /*!< ptrdiff_t */
+    ESP_LOG_ARG_DOUBLE,     /*!< double, also for float */
+    ESP_LOG_ARG_PTR,        /*!< void * */
+    ESP_LOG_ARG_STR,        /*!< const char * */
+} esp_log_arg_type_t;
+
+/**
+ * @brief A conversion specification of a format string
+ */
+typedef struct {
+    const char *end;            /*!< First character after the specification */
+    esp_log_arg_type_t type;    /*!< Type of the argument */
+    bool is_signed;             /*!< The argument is a signed integer (%d or %i) */
+    bool width_star;            /*!< The width is an int argument before the value */
+    bool precision_star;        /*!< The precision is an int argument before the value */
+    int precision;              /*!< Precision given in the format string, or -1 */
+} esp_log_conv_t;
+
+/**
+ * @brief Parse a conversion specification of a format string.
+ *
+ * Used by the log modes which store the arguments of a message instead of formatting it.
+ *
+ * @param[in]  p    Conversion specification, just after the '%'. "%%" is not a conversion.
+ * @param[out] conv Result.
+ *
+ * @return false for conversions which are not supported (%n, long double, wide characters,
+ *         specifications longer than ESP_LOG_ARGS_MAX_SPEC_LEN) and invalid ones.
+ */
+bool esp_log_args_parse(const char *p, esp_log_conv_t *conv);
+
+/**
+ * @brief Size of an argument in bytes.
+ *
+ * @param type Type of the argument.
+ *
+ * @return The size, for ESP_LOG_ARG_STR the size of the pointer.
+ */
+size_t esp_log_args_size(esp_log_arg_type_t type);
+
+/**
+ * @brief Fetch the next argument of a conversion.
+ *
+ * @param[in]    type  Type of the argument.
+ * @param[inout] args  Arguments, advanced past this one.
+ * @param[out]   value Buffer of at least 8 bytes for the value.
+ */
+void esp_log_args_fetch(esp_log_arg_type_t type, va_list *args, void *value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include "esp_log_config.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond */
+#if CONFIG_LOG_BINARY && !NON_OS_BUILD
+#define ESP_LOG_BINARY                           (1)
+#else
+#define ESP_LOG_BINARY                           (0)
+#endif
+/** @endcond */
+
+/**
+ * @brief Write a log message as a binary frame.
+ *
+ * Instead of the formatted text, the frame holds the addresses of the format string and the tag,
+ * and the arguments in a compact encoding. tools/log_binary_decode.py formats the message on the host,
+ * using the strings from the ELF file of the application.
+ *
+ * @param config    The config of the message.
+ * @param tag       The tag of the message, or NULL.
+ * @param timestamp The timestamp of the message (Log V2).
+ * @param format    The format string.
+ * @param args      The arguments.
+ *
+ * @return
+ *      - true if the message has been written.
+ *      - false if the format string or the tag are not located in flash, or the format string has
+ *        conversions which are not supported. The caller has to write the message as text.
+ */
+bool esp_log_binary_write(esp_log_config_t config, const char *tag, uint64_t timestamp, const char *format, va_list args);
+
+#ifdef __cplusplus
+}
+#endif
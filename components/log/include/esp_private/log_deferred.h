@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include "esp_log_config.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond */
+#if CONFIG_LOG_DEFERRED && !NON_OS_BUILD
+#define ESP_LOG_DEFERRED                         (1)
+#else
+#define ESP_LOG_DEFERRED                         (0)
+#endif
+/** @endcond */
+
+/**
+ * @brief Queue a log message to be formatted and output later by the log task.
+ *
+ * The format string and the arguments are copied into the ring buffer of the current core,
+ * without taking any lock. The strings passed for %s are copied, the format string itself is
+ * only referenced and must therefore be located in flash.
+ *
+ * @param config    The config of the message, it must not be from a constrained environment.
+ * @param tag       The tag of the message, or NULL.
+ * @param timestamp The timestamp of the message (Log V2).
+ * @param format    The format string.
+ * @param args      The arguments.
+ *
+ * @return
+ *      - true if the message has been queued, or dropped because the buffer is full.
+ *      - false if the message can not be deferred and has to be written by the caller.
+ */
+bool esp_log_deferred_write(esp_log_config_t config, const char *tag, uint64_t timestamp, const char *format, va_list args);
+
+#ifdef __cplusplus
+}
+#endif
@@ -55,6 +55,26 @@ __attribute__((always_inline)) static inline void esp_log_vprintf(esp_log_config
  */
 void esp_log_printf(esp_log_config_t config, const char *format, ...) __attribute__((format(printf, 2, 3)));
 
+#if ESP_LOG_VERSION == 2
+/**
+ * @brief Print "<color_start><level_name> <(time)> <tag>: " before a message if it requires formatting.
+ *
+ * For messages which are not from a constrained environment, this also locks stdout until esp_log_print_suffix().
+ *
+ * @param[inout] config    The config of the message. dis_color is set if the level has no color.
+ * @param[in]    tag       The tag of the message, or NULL.
+ * @param[in]    timestamp The timestamp of the message.
+ */
+void esp_log_print_prefix(esp_log_config_t *config, const char *tag, uint64_t timestamp);
+
+/**
+ * @brief Print "<color_end><\n>" after a message if it requires formatting.
+ *
+ * @param config The config of the message, as updated by esp_log_print_prefix().
+ */
+void esp_log_print_suffix(esp_log_config_t config);
+#endif // ESP_LOG_VERSION == 2
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,6 +16,8 @@
 #include "esp_private/log_lock.h"
 #include "esp_private/log_util.h"
 #include "esp_private/log_print.h"
+#include "esp_private/log_deferred.h"
+#include "esp_private/log_binary.h"
 #include "sdkconfig.h"
 
 static __attribute__((unused)) const char s_lvl_name[ESP_LOG_MAX] = {
@@ -49,10 +51,65 @@ static __attribute__((unused)) bool is_level_loggable(esp_log_config_t config)
 #endif
 }
 
+#if ESP_LOG_VERSION == 2
+void esp_log_print_prefix(esp_log_config_t *config, const char *tag, uint64_t timestamp)
+{
+    if (!config->opts.require_formatting) {
+        return;
+    }
+    // print "<color_start><level_name> <(time)> <tag>: "
+#if !ESP_LOG_CONSTRAINED_ENV
+    if (!config->opts.constrained_env) {
+        // flockfile&funlockfile are used here to prevent other threads
+        // from writing to the same stream simultaneously using printf-like functions.
+        // Below is formatting log, there are multiple calls to vprintf to log a single message.
+        flockfile(stdout);
+    }
+#endif
+    config->opts.dis_color = !ESP_LOG_SUPPORT_COLOR || config->opts.dis_color || (s_lvl_color[config->opts.log_level][0] == '\0');
+    char timestamp_buffer[32] = { 0 };
+    if (!config->opts.dis_timestamp) {
+        esp_log_timestamp_str(config->opts.constrained_env, timestamp, timestamp_buffer);
+    }
+    esp_log_printf(*config, "%s%c %s%s%s%s%s",
+                   (!config->opts.dis_color) ? s_lvl_color[config->opts.log_level] : "",
+                   s_lvl_name[config->opts.log_level],
+                   (!config->opts.dis_timestamp) ? "(" : "",
+                   timestamp_buffer,
+                   (!config->opts.dis_timestamp) ? ") " : "",
+                   (tag) ? tag : "",
+                   (tag) ? ": " : "");
+}
+
+void esp_log_print_suffix(esp_log_config_t config)
+{
+    if (!config.opts.require_formatting) {
+        return;
+    }
+    // print "<color_end><\n>"
+    esp_log_printf(config, "%s", (config.opts.dis_color) ? "\n" : LOG_RESET_COLOR"\n");
+#if !ESP_LOG_CONSTRAINED_ENV
+    if (!config.opts.constrained_env) {
+        funlockfile(stdout);
+    }
+#endif
+}
+#endif // ESP_LOG_VERSION == 2
+
 void __attribute__((optimize("-O3"))) esp_log_va(esp_log_config_t config, const char *tag, const char *format, va_list args)
 {
 #if ESP_LOG_VERSION == 1
     if (config.opts.log_level != ESP_LOG_NONE && esp_log_is_tag_loggable(config.opts.log_level, tag)) {
+#if ESP_LOG_DEFERRED
+        if (!esp_log_util_is_constrained() && esp_log_deferred_write(config, tag, 0, format, args)) {
+            return;
+        }
+#endif
+#if ESP_LOG_BINARY
+        if (!esp_log_util_is_constrained() && esp_log_binary_write(config, tag, 0, format, args)) {
+            return;
+        }
+#endif
         extern vprintf_like_t esp_log_vprint_func;
         esp_log_vprint_func(format, args);
     }
@@ -69,41 +126,19 @@ void __attribute__((optimize("-O3"))) esp_log_va(esp_log_config_t config, const
             return;
         }
 #endif
-        // formatting log
-        if (config.opts.require_formatting) { // 1. print "<color_start><level_name> <(time)> <tag>: "
-#if !ESP_LOG_CONSTRAINED_ENV
-            if (!config.opts.constrained_env) {
-                // flockfile&funlockfile are used here to prevent other threads
-                // from writing to the same stream simultaneously using printf-like functions.
-                // Below is formatting log, there are multiple calls to vprintf to log a single message.
-                flockfile(stdout);
-            }
-#endif
-            config.opts.dis_color = !ESP_LOG_SUPPORT_COLOR || config.opts.dis_color || (s_lvl_color[config.opts.log_level][0] == '\0');
-            char timestamp_buffer[32] = { 0 };
-            if (!config.opts.dis_timestamp) {
-                esp_log_timestamp_str(config.opts.constrained_env, timestamp, timestamp_buffer);
-            }
-            esp_log_printf(config, "%s%c %s%s%s%s%s",
-                           (!config.opts.dis_color) ? s_lvl_color[config.opts.log_level] : "",
-                           s_lvl_name[config.opts.log_level],
-                           (!config.opts.dis_timestamp) ? "(" : "",
-                           timestamp_buffer,
-                           (!config.opts.dis_timestamp) ? ") " : "",
-                           (tag) ? tag : "",
-                           (tag) ? ": " : "");
+#if ESP_LOG_DEFERRED
+        if (!config.opts.constrained_env && esp_log_deferred_write(config, tag, timestamp, format, args)) {
+            return;
         }
-
-        esp_log_vprintf(config, format, args); // 2. print user message
-
-        if (config.opts.require_formatting) { // 3. print "<color_end><\n>"
-            esp_log_printf(config, "%s", (config.opts.dis_color) ? "\n" : LOG_RESET_COLOR"\n");
-#if !ESP_LOG_CONSTRAINED_ENV
-            if (!config.opts.constrained_env) {
-                funlockfile(stdout);
-            }
 #endif
+#if ESP_LOG_BINARY
+        if (!config.opts.constrained_env && esp_log_binary_write(config, tag, timestamp, format, args)) {
+            return;
         }
+#endif
+        esp_log_print_prefix(&config, tag, timestamp);
+        esp_log_vprintf(config, format, args);
+        esp_log_print_suffix(config);
     }
 #endif // ESP_LOG_VERSION == 2
 }
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * This file implements a lock-free hash table cache for storing and retrieving
+ * log tag levels in the ESP-IDF log library. Like the other cache
+ * implementations, it is used in conjunction with the linked list approach and
+ * stores the log levels of recently used tags, identified by their pointers.
+ *
+ * The table is open-addressed with linear probing, indexed by a multiplicative
+ * hash of the tag pointer. esp_log_cache_get_level only reads the table and
+ * can be called without taking the log lock, so a log call for a cached tag
+ * costs a hash, a few loads and compares. All other functions modify the table
+ * and must be called with the lock held.
+ *
+ * Tags are only removed from the table by esp_log_cache_clean, or when the
+ * table is full and the home slot of a new tag is reused for it. In both cases
+ * the slot's tag pointer is cleared before its level is changed, so that a
+ * concurrent reader either sees a cache miss (and takes the slow path under the
+ * lock) or the level stored for the tag it looked for.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "esp_log_level.h"
+#include "esp_private/log_level.h"
+#include "esp_assert.h"
+#include "sdkconfig.h"
+#include "log_cache.h"
+
+ESP_STATIC_ASSERT(((CONFIG_LOG_TAG_LEVEL_IMPL_CACHE_SIZE & (CONFIG_LOG_TAG_LEVEL_IMPL_CACHE_SIZE + 1)) == 0), "Number of tags to be cached must be 2**n - 1, n >= 2. [1, 3, 7, 15, 31, 63, 127, 255, ...]");
+#define TABLE_SIZE (CONFIG_LOG_TAG_LEVEL_IMPL_CACHE_SIZE + 1)
+#define TABLE_MASK (CONFIG_LOG_TAG_LEVEL_IMPL_CACHE_SIZE)
+
+static const char *s_tags[TABLE_SIZE];
+static uint8_t s_levels[TABLE_SIZE];
+
+static inline uint32_t home_slot(const char *tag)
+{
+    // Fibonacci hashing, the upper bits of the product are the best mixed ones
+    return (((uint32_t)(uintptr_t)tag * 2654435769U) >> (32 - __builtin_ctz(TABLE_SIZE))) & TABLE_MASK;
+}
+
+bool esp_log_cache_get_level(const char *tag, esp_log_level_t *level)
+{
+    uint32_t slot = home_slot(tag);
+    for (uint32_t i = 0; i < TABLE_SIZE; ++i, slot = (slot + 1) & TABLE_MASK) {
+        const char *slot_tag = __atomic_load_n(&s_tags[slot], __ATOMIC_ACQUIRE);
+        if (slot_tag == NULL) {
+            return false;
+        }
+        if (slot_tag == tag) {
+            uint8_t slot_level = __atomic_load_n(&s_levels[slot], __ATOMIC_ACQUIRE);
+            // the slot may have been reused for another tag in the meantime
+            if (__atomic_load_n(&s_tags[slot], __ATOMIC_RELAXED) != tag) {
+                return false;
+            }
+            *level = (esp_log_level_t)slot_level;
+            return true;
+        }
+    }
+    return false;
+}
+
+void esp_log_cache_set_level(const char *tag, esp_log_level_t level)
+{
+    // the same tag string may be cached with several pointers
+    for (uint32_t slot = 0; slot < TABLE_SIZE; ++slot) {
+        if (s_tags[slot] != NULL && strcmp(s_tags[slot], tag) == 0) {
+            __atomic_store_n(&s_levels[slot], level, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+void esp_log_cache_clean(void)
+{
+    for (uint32_t slot = 0; slot < TABLE_SIZE; ++slot) {
+        __atomic_store_n(&s_tags[slot], NULL, __ATOMIC_RELEASE);
+    }
+}
+
+void esp_log_cache_add(const char *tag, esp_log_level_t level)
+{
+    uint32_t home = home_slot(tag);
+    uint32_t slot = home;
+    for (uint32_t i = 0; i < TABLE_SIZE; ++i, slot = (slot + 1) & TABLE_MASK) {
+        if (s_tags[slot] == NULL) {
+            break;
+        }
+    }
+    if (s_tags[slot] != NULL) {
+        // the table is full, replace the entry in the home slot
+        slot = home;
+        __atomic_store_n(&s_tags[slot], NULL, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&s_levels[slot], level, __ATOMIC_RELEASE);
+    __atomic_store_n(&s_tags[slot], tag, __ATOMIC_RELEASE);
+}
@@ -18,13 +18,20 @@
 #include "linked_list/log_linked_list.h"
 #endif
 
-#if CONFIG_LOG_TAG_LEVEL_CACHE_ARRAY || CONFIG_LOG_TAG_LEVEL_CACHE_BINARY_MIN_HEAP
+#if CONFIG_LOG_TAG_LEVEL_CACHE_ARRAY || CONFIG_LOG_TAG_LEVEL_CACHE_BINARY_MIN_HEAP || CONFIG_LOG_TAG_LEVEL_CACHE_HASH_TABLE
 #define CACHE_ENABLED 1
 #include "cache/log_cache.h"
 #else
 #define CACHE_ENABLED 0
 #endif
 
+#if CONFIG_LOG_TAG_LEVEL_CACHE_HASH_TABLE
+// esp_log_cache_get_level() can be called without the lock
+#define CACHE_LOCK_FREE 1
+#else
+#define CACHE_LOCK_FREE 0
+#endif
+
 #if !CONFIG_LOG_TAG_LEVEL_IMPL_NONE
 
 static inline void log_level_set(const char *tag, esp_log_level_t level);
@@ -61,6 +68,11 @@ static esp_log_level_t log_level_get(const char *tag, bool timeout)
     if (tag == NULL) {
         return level_for_tag;
     }
+#if CACHE_LOCK_FREE
+    if (esp_log_cache_get_level(tag, &level_for_tag)) {
+        return level_for_tag;
+    }
+#endif
     if (timeout) {
         if (esp_log_impl_lock_timeout() == false) {
             return ESP_LOG_NONE;
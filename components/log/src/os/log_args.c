@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "esp_private/log_args.h"
+
+bool esp_log_args_parse(const char *p, esp_log_conv_t *conv)
+{
+    const char *start = p;
+    conv->width_star = false;
+    conv->precision_star = false;
+    conv->precision = -1;
+    conv->is_signed = false;
+
+    p += strspn(p, "-+ #0");
+    if (*p == '*') {
+        conv->width_star = true;
+        p++;
+    } else {
+        p += strspn(p, "0123456789");
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            conv->precision_star = true;
+            p++;
+        } else {
+            conv->precision = 0;
+            for (; *p >= '0' && *p <= '9'; p++) {
+                conv->precision = conv->precision * 10 + (*p - '0');
+            }
+        }
+    }
+
+    const char *length = p;
+    esp_log_arg_type_t int_type = ESP_LOG_ARG_INT;
+    switch (*p) {
+    case 'h':
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        int_type = (p[1] == 'l') ? ESP_LOG_ARG_LONG_LONG : ESP_LOG_ARG_LONG;
+        p += (p[1] == 'l') ? 2 : 1;
+        break;
+    case 'j':
+        int_type = ESP_LOG_ARG_INTMAX;
+        p++;
+        break;
+    case 'z':
+        int_type = ESP_LOG_ARG_SIZE;
+        p++;
+        break;
+    case 't':
+        int_type = ESP_LOG_ARG_PTRDIFF;
+        p++;
+        break;
+    default:
+        break;
+    }
+    size_t length_len = p - length;
+
+    switch (*p) {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+        conv->type = int_type;
+        conv->is_signed = (*p == 'd' || *p == 'i');
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        // "l" has no effect here, "L" (long double) is not supported
+        if (length_len != 0 && int_type != ESP_LOG_ARG_LONG) {
+            return false;
+        }
+        conv->type = ESP_LOG_ARG_DOUBLE;
+        break;
+    case 'c':
+    case 's':
+        // wide characters are not supported
+        if (length_len != 0) {
+            return false;
+        }
+        conv->type = (*p == 's') ? ESP_LOG_ARG_STR : ESP_LOG_ARG_INT;
+        break;
+    case 'p':
+        conv->type = ESP_LOG_ARG_PTR;
+        break;
+    default:
+        // %n and anything unknown
+        return false;
+    }
+    conv->end = p + 1;
+    return conv->end - start < ESP_LOG_ARGS_MAX_SPEC_LEN;
+}
+
+size_t esp_log_args_size(esp_log_arg_type_t type)
+{
+    switch (type) {
+    case ESP_LOG_ARG_LONG:
+        return sizeof(long);
+    case ESP_LOG_ARG_LONG_LONG:
+        return sizeof(long long);
+    case ESP_LOG_ARG_INTMAX:
+        return sizeof(intmax_t);
+    case ESP_LOG_ARG_SIZE:
+        return sizeof(size_t);
+    case ESP_LOG_ARG_PTRDIFF:
+        return sizeof(ptrdiff_t);
+    case ESP_LOG_ARG_DOUBLE:
+        return sizeof(double);
+    case ESP_LOG_ARG_PTR:
+        return sizeof(void *);
+    default:
+        return sizeof(int);
+    }
+}
+
+void esp_log_args_fetch(esp_log_arg_type_t type, va_list *args, void *value)
+{
+    switch (type) {
+    case ESP_LOG_ARG_INT: {
+        int v = va_arg(*args, int);
+        memcpy(value, &v, sizeof(v));
+        break;
+    }
+    case ESP_LOG_ARG_LONG: {
+        long v = va_arg(*args, long);
+        memcpy(value, &v, sizeof(v));
+        break;
+    }
+    case ESP_LOG_ARG_LONG_LONG: {
+        long long v = va_arg(*args, long long);
+        memcpy(value, &v, sizeof(v));
+        break;
+    }
+    case ESP_LOG_ARG_INTMAX: {
+        intmax_t v = va_arg(*args, intmax_t);
+        memcpy(value, &v, sizeof(v));
+        break;
+    }
+    case ESP_LOG_ARG_SIZE: {
+        size_t v = va_arg(*args, size_t);
+        memcpy(value, &v, sizeof(v));
+        break;
+    }
+    case ESP_LOG_ARG_PTRDIFF: {
+        ptrdiff_t v = va_arg(*args, ptrdiff_t);
+        memcpy(value, &v, sizeof(v));
+        break;
+    }
+    case ESP_LOG_ARG_DOUBLE: {
+        double v = va_arg(*args, double);
+        memcpy(value, &v, sizeof(v));
+        break;
+    }
+    case ESP_LOG_ARG_PTR:
+    case ESP_LOG_ARG_STR: {
+        void *v = va_arg(*args, void *);
+        memcpy(value, &v, sizeof(v));
+        break;
+    }
+    }
+}
@@ -0,0 +1,231 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_memory_utils.h"
+#include "esp_log_config.h"
+#include "esp_log_color.h"
+#include "esp_private/log_args.h"
+#include "esp_private/log_binary.h"
+#include "esp_private/log_print.h"
+#include "sdkconfig.h"
+
+/*
+ * A message is output as one frame, which starts with STX and ends with '\n':
+ *
+ *   STX, flags, [timestamp], format address, [tag address], arguments..., '\n'
+ *
+ * - flags: bits 0-2 the log level, bit 3 require_formatting, bit 4 dis_color, bit 5 dis_timestamp.
+ * - timestamp: varint, only if require_formatting is set and dis_timestamp is not.
+ * - format and tag address: 32 bits, little endian. The tag only if require_formatting is set, 0 for no tag.
+ * - arguments, in the order of the conversions of the format string:
+ *   - '*' width and precision: signed varint.
+ *   - %d, %i: signed varint. Other integer conversions, %c and %p: varint.
+ *   - floating point conversions: the double, 64 bits, little endian.
+ *   - %s: 0 and the 32-bit address of a string in flash, or the length of the string + 1 as a varint,
+ *     followed by the string (up to the precision, if there is one).
+ *
+ * Varints are LEB128, signed varints are zigzag encoded first. Within the frame, the bytes
+ * 0x00, STX, DLE, '\r' and '\n' are replaced by DLE and the byte XORed with 0x20, so that a frame is a
+ * single line of text. tools/log_binary_decode.py finds the strings in the ELF file and prints the messages.
+ */
+
+#define STX                 0x02
+#define DLE                 0x10
+#define DLE_XOR             0x20
+
+typedef struct {
+    esp_log_config_t config;
+    size_t len;
+    char buf[48];
+} frame_t;
+
+static void frame_flush(frame_t *frame)
+{
+    frame->buf[frame->len] = '\0';
+    esp_log_printf(frame->config, "%s", frame->buf);
+    frame->len = 0;
+}
+
+static void frame_put_raw(frame_t *frame, uint8_t byte)
+{
+    if (frame->len + 1 >= sizeof(frame->buf)) {
+        frame_flush(frame);
+    }
+    frame->buf[frame->len++] = byte;
+}
+
+static void frame_put(frame_t *frame, uint8_t byte)
+{
+    if (byte == 0x00 || byte == STX || byte == DLE || byte == '\r' || byte == '\n') {
+        frame_put_raw(frame, DLE);
+        byte ^= DLE_XOR;
+    }
+    frame_put_raw(frame, byte);
+}
+
+static void frame_put_bytes(frame_t *frame, const void *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        frame_put(frame, ((const uint8_t *)data)[i]);
+    }
+}
+
+static void frame_put_u32(frame_t *frame, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        frame_put(frame, value >> (8 * i));
+    }
+}
+
+static void frame_put_varint(frame_t *frame, uint64_t value)
+{
+    while (value >= 0x80) {
+        frame_put(frame, (value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    frame_put(frame, value);
+}
+
+static void frame_put_svarint(frame_t *frame, int64_t value)
+{
+    frame_put_varint(frame, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/* Integer value of an argument, sign extended for the signed conversions */
+static uint64_t int_value(const esp_log_conv_t *conv, const void *value)
+{
+    switch (conv->type) {
+    case ESP_LOG_ARG_INT: {
+        int v;
+        memcpy(&v, value, sizeof(v));
+        return conv->is_signed ? (uint64_t)(int64_t)v : (unsigned)v;
+    }
+    case ESP_LOG_ARG_LONG: {
+        long v;
+        memcpy(&v, value, sizeof(v));
+        return conv->is_signed ? (uint64_t)(int64_t)v : (unsigned long)v;
+    }
+    case ESP_LOG_ARG_SIZE:
+    case ESP_LOG_ARG_PTRDIFF: {
+        ptrdiff_t v;
+        memcpy(&v, value, sizeof(v));
+        return conv->is_signed ? (uint64_t)(int64_t)v : (size_t)v;
+    }
+    case ESP_LOG_ARG_PTR: {
+        uintptr_t v;
+        memcpy(&v, value, sizeof(v));
+        return v;
+    }
+    default: {
+        uint64_t v;
+        memcpy(&v, value, sizeof(v));
+        return v;
+    }
+    }
+}
+
+/* Returns whether all conversions of the format string can be encoded */
+static bool format_is_supported(const char *format)
+{
+    for (const char *p = strchr(format, '%'); p != NULL; p = strchr(p, '%')) {
+        esp_log_conv_t conv;
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+        if (!esp_log_args_parse(p + 1, &conv)) {
+            return false;
+        }
+        p = conv.end;
+    }
+    return true;
+}
+
+bool esp_log_binary_write(esp_log_config_t config, const char *tag, uint64_t timestamp, const char *format, va_list args)
+{
+    // the decoder takes these strings from the ELF file
+    if (!esp_ptr_in_drom(format) || (config.opts.require_formatting && tag != NULL && !esp_ptr_in_drom(tag))) {
+        return false;
+    }
+    if (!format_is_supported(format)) {
+        return false;
+    }
+
+    frame_t frame = { .config = config };
+    bool with_timestamp = config.opts.require_formatting && !config.opts.dis_timestamp;
+    uint8_t flags = config.opts.log_level
+                    | (config.opts.require_formatting << 3)
+                    | ((!ESP_LOG_SUPPORT_COLOR || config.opts.dis_color) << 4)
+                    | (!with_timestamp << 5);
+
+    // flockfile&funlockfile keep the frame together, it takes several calls to vprintf
+    flockfile(stdout);
+    frame_put_raw(&frame, STX);
+    frame_put(&frame, flags);
+    if (with_timestamp) {
+        frame_put_varint(&frame, timestamp);
+    }
+    frame_put_u32(&frame, (uint32_t)(uintptr_t)format);
+    if (config.opts.require_formatting) {
+        frame_put_u32(&frame, (uint32_t)(uintptr_t)tag);
+    }
+
+    va_list ap;
+    va_copy(ap, args);
+    for (const char *p = strchr(format, '%'); p != NULL; p = strchr(p, '%')) {
+        esp_log_conv_t conv;
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+        esp_log_args_parse(p + 1, &conv);
+        p = conv.end;
+
+        if (conv.width_star) {
+            frame_put_svarint(&frame, va_arg(ap, int));
+        }
+        if (conv.precision_star) {
+            conv.precision = va_arg(ap, int);
+            frame_put_svarint(&frame, conv.precision);
+        }
+        union {
+            long long ll;
+            double d;
+            intmax_t im;
+            const char *str;
+        } value;
+        esp_log_args_fetch(conv.type, &ap, &value);
+        if (conv.type == ESP_LOG_ARG_STR) {
+            const char *str = (value.str != NULL) ? value.str : "(null)";
+            if (esp_ptr_in_drom(str)) {
+                frame_put(&frame, 0);
+                frame_put_u32(&frame, (uint32_t)(uintptr_t)str);
+            } else {
+                size_t len = (conv.precision >= 0) ? strnlen(str, conv.precision) : strlen(str);
+                frame_put_varint(&frame, len + 1);
+                frame_put_bytes(&frame, str, len);
+            }
+        } else if (conv.type == ESP_LOG_ARG_DOUBLE) {
+            frame_put_bytes(&frame, &value.d, sizeof(value.d));
+        } else if (conv.is_signed) {
+            frame_put_svarint(&frame, (int64_t)int_value(&conv, &value));
+        } else {
+            frame_put_varint(&frame, int_value(&conv, &value));
+        }
+    }
+    va_end(ap);
+
+    frame_put_raw(&frame, '\n');
+    frame_flush(&frame);
+    funlockfile(stdout);
+    return true;
+}
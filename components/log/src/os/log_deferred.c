@@ -0,0 +1,454 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "esp_cpu.h"
+#include "esp_assert.h"
+#include "esp_log.h"
+#include "esp_private/log_args.h"
+#include "esp_private/log_deferred.h"
+#include "esp_private/log_print.h"
+#include "sdkconfig.h"
+
+/*
+ * Each core has a ring buffer of entries, which any number of tasks reserve space in with a
+ * compare-and-swap of the ring's head. The log task is the only reader. An entry is valid once
+ * its state has the ENTRY_COMMITTED bit set, and the log task zeroes it again after printing it,
+ * before it advances the tail.
+ *
+ * An entry holds the format string pointer, a copy of the tag and one copy of each argument,
+ * in the order of the conversions in the format string. The log task walks the format string
+ * again and prints each conversion on its own.
+ */
+
+static const char *TAG = "log";
+
+#define RING_SIZE           CONFIG_LOG_DEFERRED_BUFFER_SIZE
+#define MAX_ENTRY_SIZE      (RING_SIZE / 4)
+#define ENTRY_ALIGN         8
+
+#define ENTRY_COMMITTED     (1UL << 31)
+#define ENTRY_PADDING       (1UL << 30)
+#define ENTRY_SIZE_MASK     (ENTRY_PADDING - 1)
+
+ESP_STATIC_ASSERT((RING_SIZE & (RING_SIZE - 1)) == 0, "CONFIG_LOG_DEFERRED_BUFFER_SIZE must be a power of two");
+
+typedef struct {
+    uint32_t state;             // size of the entry in bytes | ENTRY_COMMITTED | ENTRY_PADDING
+    uint32_t seq;               // for printing the entries of all cores in the order they were written
+    esp_log_config_t config;
+    const char *format;
+    uint64_t timestamp;
+    // followed by the tag and the arguments
+} entry_t;
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t head;              // bytes reserved so far, the ring index is head % RING_SIZE
+    uint32_t tail;              // bytes printed so far
+} ring_t;
+
+typedef enum {
+    STATE_STOPPED,
+    STATE_STARTING,
+    STATE_RUNNING,
+    STATE_FAILED,
+} deferred_state_t;
+
+static ring_t s_rings[portNUM_PROCESSORS];
+static uint32_t s_state = STATE_STOPPED;
+static TaskHandle_t s_task;
+static uint32_t s_seq;
+static uint32_t s_dropped;
+static uint32_t s_task_waiting;
+
+static inline uint32_t align_up(uint32_t size, uint32_t align)
+{
+    return (size + align - 1) & ~(align - 1);
+}
+
+/*
+ * Walk the format string and the arguments, and return the size the arguments need in the entry.
+ * If out is not NULL, also copy them to out. Returns false if the message can't be deferred.
+ */
+static bool pack_args(const char *format, va_list args, uint8_t *out, size_t *out_size)
+{
+    va_list ap;
+    va_copy(ap, args);
+    bool ok = true;
+    size_t size = 0;
+    for (const char *p = strchr(format, '%'); p != NULL; p = strchr(p, '%')) {
+        esp_log_conv_t conv;
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+        if (!esp_log_args_parse(p + 1, &conv)) {
+            ok = false;
+            break;
+        }
+        p = conv.end;
+
+        int star_args[2];
+        int num_stars = 0;
+        if (conv.width_star) {
+            star_args[num_stars++] = va_arg(ap, int);
+        }
+        if (conv.precision_star) {
+            star_args[num_stars] = va_arg(ap, int);
+            conv.precision = star_args[num_stars++];
+        }
+        if (out) {
+            memcpy(out + size, star_args, num_stars * sizeof(int));
+        }
+        size += num_stars * sizeof(int);
+
+        union {
+            long long ll;
+            double d;
+            intmax_t im;
+            const char *str;
+        } value;
+        esp_log_args_fetch(conv.type, &ap, &value);
+        if (conv.type == ESP_LOG_ARG_STR) {
+            // copy the string, only up to the precision as it doesn't have to be terminated then
+            const char *str = (value.str != NULL) ? value.str : "(null)";
+            size_t len = (conv.precision >= 0) ? strnlen(str, conv.precision) : strlen(str);
+            if (out) {
+                memcpy(out + size, str, len);
+                out[size + len] = '\0';
+            }
+            size += align_up(len + 1, sizeof(int));
+        } else {
+            size_t len = esp_log_args_size(conv.type);
+            if (out) {
+                memcpy(out + size, &value, len);
+            }
+            size += align_up(len, sizeof(int));
+        }
+        if (size > MAX_ENTRY_SIZE) {
+            ok = false;
+            break;
+        }
+    }
+    va_end(ap);
+    *out_size = size;
+    return ok;
+}
+
+/* Reserve size bytes in the ring, which must be a multiple of ENTRY_ALIGN */
+static entry_t *ring_reserve(ring_t *ring, uint32_t size)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t padding;
+    do {
+        uint32_t index = head % RING_SIZE;
+        // an entry never wraps around the end of the ring, the rest of the ring becomes padding instead
+        padding = (index + size > RING_SIZE) ? RING_SIZE - index : 0;
+        if (head + padding + size - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) > RING_SIZE) {
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&ring->head, &head, head + padding + size, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    if (padding) {
+        entry_t *pad = (entry_t *)(ring->buf + head % RING_SIZE);
+        __atomic_store_n(&pad->state, padding | ENTRY_PADDING | ENTRY_COMMITTED, __ATOMIC_RELEASE);
+    }
+    return (entry_t *)(ring->buf + (head + padding) % RING_SIZE);
+}
+
+/* Returns the entry at the tail of the ring, or NULL if the ring is empty */
+static entry_t *ring_peek(ring_t *ring)
+{
+    while (ring->tail != __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+        entry_t *entry = (entry_t *)(ring->buf + ring->tail % RING_SIZE);
+        uint32_t state = __atomic_load_n(&entry->state, __ATOMIC_ACQUIRE);
+        if ((state & (ENTRY_COMMITTED | ENTRY_PADDING)) != (ENTRY_COMMITTED | ENTRY_PADDING)) {
+            return entry;
+        }
+        memset(entry, 0, state & ENTRY_SIZE_MASK);
+        __atomic_store_n(&ring->tail, ring->tail + (state & ENTRY_SIZE_MASK), __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+static void ring_release(ring_t *ring, entry_t *entry)
+{
+    uint32_t size = entry->state & ENTRY_SIZE_MASK;
+    memset(entry, 0, size);
+    __atomic_store_n(&ring->tail, ring->tail + size, __ATOMIC_RELEASE);
+}
+
+/* Print the conversion spec, with any '*' replaced by the stored width and precision */
+static const uint8_t *print_conversion(esp_log_config_t config, const char *start, const esp_log_conv_t *conv, const uint8_t *arg)
+{
+    char spec[ESP_LOG_ARGS_MAX_SPEC_LEN + 2 * sizeof("-2147483648")];
+    size_t len = 0;
+    int star_args[2];
+    int num_stars = (conv->width_star ? 1 : 0) + (conv->precision_star ? 1 : 0);
+    memcpy(star_args, arg, num_stars * sizeof(int));
+    arg += num_stars * sizeof(int);
+
+    int star = 0;
+    for (const char *p = start; p < conv->end; p++) {
+        if (*p != '*') {
+            spec[len++] = *p;
+        } else if (p[-1] == '.' && star_args[star] < 0) {
+            len--;  // a negative precision is taken as if it was omitted
+            star++;
+        } else {
+            len += snprintf(spec + len, sizeof(spec) - len, "%d", star_args[star++]);
+        }
+    }
+    spec[len] = '\0';
+
+    union {
+        int i;
+        long l;
+        long long ll;
+        intmax_t im;
+        size_t z;
+        ptrdiff_t t;
+        double d;
+        void *ptr;
+    } value;
+    switch (conv->type) {
+    case ESP_LOG_ARG_STR:
+        esp_log_printf(config, spec, (const char *)arg);
+        return arg + align_up(strlen((const char *)arg) + 1, sizeof(int));
+    case ESP_LOG_ARG_INT:
+        memcpy(&value, arg, sizeof(value.i));
+        esp_log_printf(config, spec, value.i);
+        break;
+    case ESP_LOG_ARG_LONG:
+        memcpy(&value, arg, sizeof(value.l));
+        esp_log_printf(config, spec, value.l);
+        break;
+    case ESP_LOG_ARG_LONG_LONG:
+        memcpy(&value, arg, sizeof(value.ll));
+        esp_log_printf(config, spec, value.ll);
+        break;
+    case ESP_LOG_ARG_INTMAX:
+        memcpy(&value, arg, sizeof(value.im));
+        esp_log_printf(config, spec, value.im);
+        break;
+    case ESP_LOG_ARG_SIZE:
+        memcpy(&value, arg, sizeof(value.z));
+        esp_log_printf(config, spec, value.z);
+        break;
+    case ESP_LOG_ARG_PTRDIFF:
+        memcpy(&value, arg, sizeof(value.t));
+        esp_log_printf(config, spec, value.t);
+        break;
+    case ESP_LOG_ARG_DOUBLE:
+        memcpy(&value, arg, sizeof(value.d));
+        esp_log_printf(config, spec, value.d);
+        break;
+    case ESP_LOG_ARG_PTR:
+        memcpy(&value, arg, sizeof(value.ptr));
+        esp_log_printf(config, spec, value.ptr);
+        break;
+    }
+    return arg + align_up(esp_log_args_size(conv->type), sizeof(int));
+}
+
+static void print_entry(const entry_t *entry)
+{
+    esp_log_config_t config = entry->config;
+    const char *tag = (const char *)(entry + 1);
+    const uint8_t *arg = (const uint8_t *)tag + align_up(strlen(tag) + 1, sizeof(int));
+
+#if ESP_LOG_VERSION == 2
+    esp_log_print_prefix(&config, (tag[0] != '\0') ? tag : NULL, entry->timestamp);
+#else
+    flockfile(stdout);
+#endif
+    const char *p = entry->format;
+    while (*p != '\0') {
+        const char *percent = strchr(p, '%');
+        if (percent == NULL) {
+            esp_log_printf(config, "%s", p);
+            break;
+        }
+        if (percent > p) {
+            esp_log_printf(config, "%.*s", (int)(percent - p), p);
+        }
+        if (percent[1] == '%') {
+            esp_log_printf(config, "%%");
+            p = percent + 2;
+            continue;
+        }
+        esp_log_conv_t conv;
+        esp_log_args_parse(percent + 1, &conv);  // it has been checked when the entry was written
+        arg = print_conversion(config, percent, &conv, arg);
+        p = conv.end;
+    }
+#if ESP_LOG_VERSION == 2
+    esp_log_print_suffix(config);
+#else
+    funlockfile(stdout);
+#endif
+}
+
+/*
+ * Returns the entry to print next, the oldest of the entries at the tails of the rings, or NULL.
+ * While a writer hasn't committed the entry it reserved, no entry is printed, as it might be
+ * older than the ones in the other rings, e.g. of the same task before it moved to another core.
+ */
+static entry_t *next_entry(ring_t **ring)
+{
+    entry_t *oldest = NULL;
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        entry_t *entry = ring_peek(&s_rings[i]);
+        if (entry == NULL) {
+            continue;
+        }
+        if (!(__atomic_load_n(&entry->state, __ATOMIC_ACQUIRE) & ENTRY_COMMITTED)) {
+            return NULL;
+        }
+        if (oldest == NULL || (int32_t)(entry->seq - oldest->seq) < 0) {
+            oldest = entry;
+            *ring = &s_rings[i];
+        }
+    }
+    return oldest;
+}
+
+static void log_deferred_task(void *arg)
+{
+    uint32_t dropped_reported = 0;
+    while (true) {
+        ring_t *ring;
+        entry_t *entry = next_entry(&ring);
+        if (entry != NULL) {
+            print_entry(entry);
+            ring_release(ring, entry);
+            continue;
+        }
+
+        uint32_t dropped = __atomic_load_n(&s_dropped, __ATOMIC_RELAXED);
+        if (dropped != dropped_reported) {
+            ESP_LOGW(TAG, "%"PRIu32" deferred messages dropped", dropped - dropped_reported);
+            dropped_reported = dropped;
+        }
+
+        // the writers wake the task up after committing an entry if they see the flag set
+        __atomic_exchange_n(&s_task_waiting, 1, __ATOMIC_SEQ_CST);
+        if (next_entry(&ring) != NULL) {
+            __atomic_store_n(&s_task_waiting, 0, __ATOMIC_SEQ_CST);
+            continue;
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+static bool log_deferred_start(void)
+{
+    uint32_t state = STATE_STOPPED;
+    if (!__atomic_compare_exchange_n(&s_state, &state, STATE_STARTING, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return state == STATE_RUNNING;
+    }
+
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        s_rings[i].buf = heap_caps_calloc(1, RING_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (s_rings[i].buf == NULL) {
+            goto err;
+        }
+    }
+    if (xTaskCreatePinnedToCore(log_deferred_task, "log_deferred", CONFIG_LOG_DEFERRED_TASK_STACK_SIZE, NULL,
+                                CONFIG_LOG_DEFERRED_TASK_PRIORITY, &s_task, tskNO_AFFINITY) != pdPASS) {
+        goto err;
+    }
+    __atomic_store_n(&s_state, STATE_RUNNING, __ATOMIC_RELEASE);
+    return true;
+
+err:
+    // keep logging synchronously
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        free(s_rings[i].buf);
+        s_rings[i].buf = NULL;
+    }
+    __atomic_store_n(&s_state, STATE_FAILED, __ATOMIC_RELEASE);
+    return false;
+}
+
+bool esp_log_deferred_write(esp_log_config_t config, const char *tag, uint64_t timestamp, const char *format, va_list args)
+{
+    // the format string is only referenced, so it must stay valid until the entry is printed
+    if (!esp_ptr_in_drom(format)) {
+        return false;
+    }
+    if (__atomic_load_n(&s_state, __ATOMIC_ACQUIRE) != STATE_RUNNING && !log_deferred_start()) {
+        return false;
+    }
+    // messages of the log task itself, e.g. from a vprintf function set by esp_log_set_vprintf()
+    if (xTaskGetCurrentTaskHandle() == s_task) {
+        return false;
+    }
+
+    size_t args_size;
+    if (!pack_args(format, args, NULL, &args_size)) {
+        return false;
+    }
+#if ESP_LOG_VERSION == 1
+    tag = NULL;     // with Log V1, the tag is part of the format string
+#endif
+    size_t tag_size = align_up((tag != NULL) ? strlen(tag) + 1 : 1, sizeof(int));
+    uint32_t size = align_up(sizeof(entry_t) + tag_size + args_size, ENTRY_ALIGN);
+    if (size > MAX_ENTRY_SIZE) {
+        return false;
+    }
+
+    ring_t *ring = &s_rings[esp_cpu_get_core_id()];
+    entry_t *entry = ring_reserve(ring, size);
+    if (entry == NULL) {
+        __atomic_fetch_add(&s_dropped, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+    entry->seq = __atomic_fetch_add(&s_seq, 1, __ATOMIC_RELAXED);
+    entry->config = config;
+    entry->format = format;
+    entry->timestamp = timestamp;
+    char *entry_tag = (char *)(entry + 1);
+    strcpy(entry_tag, (tag != NULL) ? tag : "");
+    pack_args(format, args, (uint8_t *)entry_tag + tag_size, &args_size);
+    __atomic_store_n(&entry->state, size | ENTRY_COMMITTED, __ATOMIC_RELEASE);
+
+    if (__atomic_exchange_n(&s_task_waiting, 0, __ATOMIC_SEQ_CST)) {
+        xTaskNotifyGive(s_task);
+    }
+    return true;
+}
+
+void esp_log_deferred_flush(void)
+{
+    if (__atomic_load_n(&s_state, __ATOMIC_ACQUIRE) != STATE_RUNNING || xTaskGetCurrentTaskHandle() == s_task) {
+        return;
+    }
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        // wait for the entries which have been reserved so far
+        uint32_t head = __atomic_load_n(&s_rings[i].head, __ATOMIC_ACQUIRE);
+        while ((int32_t)(head - __atomic_load_n(&s_rings[i].tail, __ATOMIC_ACQUIRE)) > 0) {
+            xTaskNotifyGive(s_task);
+            vTaskDelay(1);
+        }
+    }
+}
+
+uint32_t esp_log_deferred_get_dropped(void)
+{
+    return __atomic_load_n(&s_dropped, __ATOMIC_RELAXED);
+}
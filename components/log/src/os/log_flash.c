@@ -0,0 +1,432 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_assert.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_log.h"
+#include "esp_log_flash.h"
+#include "sdkconfig.h"
+
+/*
+ * The partition is a ring of flash pages. Each page is programmed once, with a header and up to
+ * PAGE_PAYLOAD_SIZE bytes of log output, and the pages get increasing sequence numbers which also give their
+ * position: page seq is at offset (seq % s_num_pages) * PAGE_SIZE. So the newest sector is the one whose
+ * first page has the highest sequence number, and no other metadata has to be written.
+ *
+ * The writer keeps the sector after the one it writes erased, so that it never waits for an erase when it
+ * crosses into the next sector. Every sector is erased once per pass through the partition.
+ *
+ * The log functions only copy their output into a RAM ring. The writer task takes it from there, a full page
+ * at a time, or the rest after CONFIG_LOG_FLASH_SINK_FLUSH_PERIOD_MS without a full page.
+ */
+
+static const char *TAG = "log_flash";
+
+#define PAGE_SIZE           256
+#define PAGE_PAYLOAD_SIZE   (PAGE_SIZE - sizeof(page_header_t))
+#define RING_SIZE           CONFIG_LOG_FLASH_SINK_BUFFER_SIZE
+#define LINE_BUF_SIZE       128
+
+ESP_STATIC_ASSERT((RING_SIZE & (RING_SIZE - 1)) == 0, "CONFIG_LOG_FLASH_SINK_BUFFER_SIZE must be a power of two");
+
+typedef struct {
+    uint32_t seq;
+    uint16_t len;
+    uint16_t len_inv;           // ~len, tells a written header from an erased one
+    uint32_t crc;               // of seq, len, len_inv and the payload
+} page_header_t;
+
+typedef struct {
+    page_header_t header;
+    uint8_t payload[PAGE_SIZE - sizeof(page_header_t)];
+} page_t;
+
+ESP_STATIC_ASSERT(sizeof(page_t) == PAGE_SIZE, "page_t must be one flash page");
+
+static const esp_partition_t *s_part;
+static uint32_t s_pages_per_sector;
+static uint32_t s_num_pages;
+static uint32_t s_head;                 // sequence number of the next page to write
+static uint32_t s_erased_end;           // pages [s_head, s_erased_end) are erased
+static page_t s_page;                   // page being written, used by the writer only
+
+static uint8_t *s_ring;
+static uint32_t s_ring_head;            // bytes put into the ring so far, the index is s_ring_head % RING_SIZE
+static uint32_t s_ring_tail;            // bytes taken from the ring so far
+static portMUX_TYPE s_ring_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_dropped;
+
+static SemaphoreHandle_t s_write_lock;  // held while writing pages
+static TaskHandle_t s_task;
+static vprintf_like_t s_prev_vprintf;
+static bool s_running;
+
+static inline uint32_t page_offset(uint32_t seq)
+{
+    return (seq % s_num_pages) * PAGE_SIZE;
+}
+
+static inline uint32_t sector_offset(uint32_t seq)
+{
+    return page_offset(seq - seq % s_pages_per_sector);
+}
+
+static uint32_t page_crc(const page_header_t *header, const uint8_t *payload)
+{
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)header, offsetof(page_header_t, crc));
+    return esp_rom_crc32_le(crc, payload, header->len);
+}
+
+/* Returns whether the page holds output, the header is copied as the page may not be aligned */
+static bool page_is_valid(const uint8_t *page, page_header_t *header)
+{
+    memcpy(header, page, sizeof(*header));
+    return header->len > 0 && header->len <= PAGE_PAYLOAD_SIZE && header->len_inv == (uint16_t)~header->len
+           && header->crc == page_crc(header, page + sizeof(*header));
+}
+
+static bool page_is_erased(const page_t *page)
+{
+    const uint32_t *words = (const uint32_t *)page;
+    for (size_t i = 0; i < PAGE_SIZE / sizeof(uint32_t); i++) {
+        if (words[i] != UINT32_MAX) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static esp_err_t sector_is_erased(uint32_t seq, bool *erased)
+{
+    for (uint32_t i = 0; i < s_pages_per_sector; i++) {
+        esp_err_t err = esp_partition_read(s_part, sector_offset(seq) + i * PAGE_SIZE, &s_page, PAGE_SIZE);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (!page_is_erased(&s_page)) {
+            *erased = false;
+            return ESP_OK;
+        }
+    }
+    *erased = true;
+    return ESP_OK;
+}
+
+/* Find the page to continue from, after the last page which is not erased in the newest sector */
+static esp_err_t log_flash_mount(void)
+{
+    uint32_t num_sectors = s_part->size / s_part->erase_size;
+    if (num_sectors < 2) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    s_pages_per_sector = s_part->erase_size / PAGE_SIZE;
+    s_num_pages = num_sectors * s_pages_per_sector;
+
+    bool found = false;
+    uint32_t newest = 0;
+    page_header_t header;
+    for (uint32_t sector = 0; sector < num_sectors; sector++) {
+        esp_err_t err = esp_partition_read(s_part, sector * s_part->erase_size, &s_page, PAGE_SIZE);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (page_is_valid((const uint8_t *)&s_page, &header) && header.seq % s_pages_per_sector == 0
+                && sector_offset(header.seq) == sector * s_part->erase_size && (!found || header.seq > newest)) {
+            newest = header.seq;
+            found = true;
+        }
+    }
+
+    s_head = 0;
+    s_erased_end = 0;
+    if (found) {
+        uint32_t last = 0;
+        for (uint32_t i = 1; i < s_pages_per_sector; i++) {
+            esp_err_t err = esp_partition_read(s_part, page_offset(newest + i), &s_page, PAGE_SIZE);
+            if (err != ESP_OK) {
+                return err;
+            }
+            if (!page_is_erased(&s_page)) {
+                last = i;
+            }
+        }
+        s_head = newest + last + 1;
+        s_erased_end = newest + s_pages_per_sector;
+    }
+
+    // the sector ahead may not have been erased completely before the reset
+    if (s_erased_end - s_head < s_pages_per_sector) {
+        bool erased;
+        esp_err_t err = sector_is_erased(s_erased_end, &erased);
+        if (err == ESP_OK && !erased) {
+            err = esp_partition_erase_range(s_part, sector_offset(s_erased_end), s_part->erase_size);
+        }
+        if (err != ESP_OK) {
+            return err;
+        }
+        s_erased_end += s_pages_per_sector;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t page_write(void)
+{
+    esp_err_t err = ESP_OK;
+    if (s_head == s_erased_end) {
+        // only if erasing the sector ahead failed
+        err = esp_partition_erase_range(s_part, sector_offset(s_head), s_part->erase_size);
+        if (err != ESP_OK) {
+            return err;
+        }
+        __atomic_store_n(&s_erased_end, s_head + s_pages_per_sector, __ATOMIC_RELEASE);
+    }
+
+    s_page.header.seq = s_head;
+    s_page.header.len_inv = ~s_page.header.len;
+    s_page.header.crc = page_crc(&s_page.header, s_page.payload);
+    memset(s_page.payload + s_page.header.len, 0xff, PAGE_PAYLOAD_SIZE - s_page.header.len);
+    err = esp_partition_write(s_part, page_offset(s_head), &s_page, PAGE_SIZE);
+    // a page which failed may be partly programmed, so it is skipped in any case
+    __atomic_store_n(&s_head, s_head + 1, __ATOMIC_RELEASE);
+
+    if (s_erased_end - s_head < s_pages_per_sector) {
+        esp_err_t erase_err = esp_partition_erase_range(s_part, sector_offset(s_erased_end), s_part->erase_size);
+        if (erase_err == ESP_OK) {
+            __atomic_store_n(&s_erased_end, s_erased_end + s_pages_per_sector, __ATOMIC_RELEASE);
+        } else if (err == ESP_OK) {
+            err = erase_err;
+        }
+    }
+    return err;
+}
+
+/* Write the output from the ring in pages, including a last page which is not full if flush is set */
+static esp_err_t write_pages(bool flush)
+{
+    esp_err_t ret = ESP_OK;
+    while (true) {
+        portENTER_CRITICAL(&s_ring_lock);
+        uint32_t len = MIN(s_ring_head - s_ring_tail, PAGE_PAYLOAD_SIZE);
+        if (len == 0 || (len < PAGE_PAYLOAD_SIZE && !flush)) {
+            portEXIT_CRITICAL(&s_ring_lock);
+            break;
+        }
+        uint32_t index = s_ring_tail % RING_SIZE;
+        uint32_t first = MIN(len, RING_SIZE - index);
+        memcpy(s_page.payload, s_ring + index, first);
+        memcpy(s_page.payload + first, s_ring, len - first);
+        s_ring_tail += len;
+        portEXIT_CRITICAL(&s_ring_lock);
+
+        s_page.header.len = len;
+        esp_err_t err = page_write();
+        if (err != ESP_OK) {
+            ret = err;
+        }
+    }
+    return ret;
+}
+
+static void ring_put(const char *str, size_t len)
+{
+    bool notify = false;
+    portENTER_CRITICAL(&s_ring_lock);
+    uint32_t used = s_ring_head - s_ring_tail;
+    if (len > RING_SIZE - used) {
+        s_dropped += len;
+    } else {
+        uint32_t index = s_ring_head % RING_SIZE;
+        uint32_t first = MIN(len, RING_SIZE - index);
+        memcpy(s_ring + index, str, first);
+        memcpy(s_ring, str + first, len - first);
+        s_ring_head += len;
+        // the writer takes all full pages when it wakes up, so it only needs a notification when the first one is full
+        notify = used < PAGE_PAYLOAD_SIZE && used + len >= PAGE_PAYLOAD_SIZE;
+    }
+    portEXIT_CRITICAL(&s_ring_lock);
+    if (notify) {
+        xTaskNotifyGive(s_task);
+    }
+}
+
+static int log_flash_vprintf(const char *format, va_list args)
+{
+    va_list ap;
+    va_copy(ap, args);
+    char line[LINE_BUF_SIZE];
+    char *heap_line = NULL;
+    const char *str;
+    int len;
+    if (strchr(format, '%') == NULL) {
+        str = format;
+        len = strlen(str);
+    } else if (strcmp(format, "%s") == 0) {
+        // the text pieces of Log V2 and the binary frames
+        str = va_arg(ap, const char *);
+        len = strlen(str);
+    } else {
+        va_list ap2;
+        va_copy(ap2, ap);
+        len = vsnprintf(line, sizeof(line), format, ap);
+        if (len >= (int)sizeof(line)) {
+            heap_line = malloc(len + 1);
+            if (heap_line != NULL) {
+                vsnprintf(heap_line, len + 1, format, ap2);
+            } else {
+                len = sizeof(line) - 1;
+            }
+        }
+        va_end(ap2);
+        str = (heap_line != NULL) ? heap_line : line;
+    }
+    va_end(ap);
+
+    if (len > 0) {
+        ring_put(str, len);
+    }
+    free(heap_line);
+    return s_prev_vprintf(format, args);
+}
+
+static void log_flash_task(void *arg)
+{
+    uint32_t dropped_reported = 0;
+    while (true) {
+        uint32_t notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_LOG_FLASH_SINK_FLUSH_PERIOD_MS));
+        xSemaphoreTake(s_write_lock, portMAX_DELAY);
+        esp_err_t err = write_pages(notified == 0);
+        xSemaphoreGive(s_write_lock);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "writing to flash failed (0x%x)", err);
+        }
+
+        uint32_t dropped = __atomic_load_n(&s_dropped, __ATOMIC_RELAXED);
+        if (dropped != dropped_reported) {
+            ESP_LOGW(TAG, "%"PRIu32" bytes of log output dropped", dropped - dropped_reported);
+            dropped_reported = dropped;
+        }
+    }
+}
+
+esp_err_t esp_log_flash_sink_start(void)
+{
+    if (s_running) {
+        return ESP_OK;
+    }
+    if (s_task == NULL) {
+        s_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, CONFIG_LOG_FLASH_SINK_PARTITION_LABEL);
+        if (s_part == NULL) {
+            ESP_LOGE(TAG, "partition '%s' not found", CONFIG_LOG_FLASH_SINK_PARTITION_LABEL);
+            return ESP_ERR_NOT_FOUND;
+        }
+        esp_err_t err = log_flash_mount();
+        if (err != ESP_OK) {
+            return err;
+        }
+        s_ring = heap_caps_malloc(RING_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_write_lock = xSemaphoreCreateMutex();
+        if (s_ring == NULL || s_write_lock == NULL
+                || xTaskCreatePinnedToCore(log_flash_task, "log_flash", CONFIG_LOG_FLASH_SINK_TASK_STACK_SIZE, NULL,
+                                           CONFIG_LOG_FLASH_SINK_TASK_PRIORITY, &s_task, tskNO_AFFINITY) != pdPASS) {
+            free(s_ring);
+            s_ring = NULL;
+            if (s_write_lock != NULL) {
+                vSemaphoreDelete(s_write_lock);
+                s_write_lock = NULL;
+            }
+            s_task = NULL;
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    s_prev_vprintf = esp_log_set_vprintf(log_flash_vprintf);
+    s_running = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_log_flash_sink_stop(void)
+{
+    extern vprintf_like_t esp_log_vprint_func;
+    vprintf_like_t expected = log_flash_vprintf;
+    if (!s_running || !__atomic_compare_exchange_n(&esp_log_vprint_func, &expected, s_prev_vprintf, false,
+                                                   __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_running = false;
+    return esp_log_flash_sink_flush();
+}
+
+esp_err_t esp_log_flash_sink_flush(void)
+{
+    if (s_task == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_write_lock, portMAX_DELAY);
+    esp_err_t err = write_pages(true);
+    xSemaphoreGive(s_write_lock);
+    return err;
+}
+
+esp_err_t esp_log_flash_sink_read(uint32_t *pos, void *buf, size_t size, size_t *out_len)
+{
+    if (pos == NULL || buf == NULL || out_len == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (size < PAGE_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (s_task == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *out_len = 0;
+
+    // the pages before the erased ones have been overwritten
+    uint32_t head = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    uint32_t erased_end = __atomic_load_n(&s_erased_end, __ATOMIC_ACQUIRE);
+    uint32_t oldest = (erased_end > s_num_pages) ? erased_end - s_num_pages : 0;
+    uint32_t seq = (*pos < oldest || *pos > head) ? oldest : *pos;
+    uint8_t *data = buf;
+    size_t len = 0;
+    // continue while all pages read so far were skipped, so that 0 bytes means the end of the log
+    while (len == 0 && seq != head) {
+        uint32_t count = MIN(MIN(size / PAGE_SIZE, head - seq), s_num_pages - seq % s_num_pages);
+        esp_err_t err = esp_partition_read(s_part, page_offset(seq), data, count * PAGE_SIZE);
+        if (err != ESP_OK) {
+            return err;
+        }
+        // move the payloads together, each one is behind the end of the previous one
+        for (uint32_t i = 0; i < count; i++) {
+            const uint8_t *page = data + i * PAGE_SIZE;
+            page_header_t header;
+            if (page_is_valid(page, &header) && header.seq == seq + i) {
+                memmove(data + len, page + sizeof(header), header.len);
+                len += header.len;
+            }
+        }
+        seq += count;
+    }
+    *pos = seq;
+    *out_len = len;
+    return ESP_OK;
+}
+
+uint32_t esp_log_flash_sink_get_dropped(void)
+{
+    return __atomic_load_n(&s_dropped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#if CONFIG_LOG_DEFERRED
+
+static const char *TAG = "deferred";
+
+#define BUFFER_SIZE (1024)
+static unsigned s_counter = 0;
+static char s_print_buffer[BUFFER_SIZE];
+
+static int print_to_buffer(const char *format, va_list args)
+{
+    int ret = vsnprintf(&s_print_buffer[s_counter], BUFFER_SIZE - s_counter, format, args);
+    s_counter += ret;
+    assert(s_counter < BUFFER_SIZE);
+    return ret;
+}
+
+static void reset_buffer(void)
+{
+    s_counter = 0;
+    s_print_buffer[0] = 0;
+}
+
+TEST_CASE("deferred logs are formatted by the log task", "[log_deferred]")
+{
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_buffer();
+
+    char stack_str[16];
+    strcpy(stack_str, "on stack");
+    ESP_LOGI(TAG, "int %d, %5" PRIu32 "|%-4x|, %llu, str %s %.3s|%*d|, %.2f, %c%%", -5, (uint32_t)42, 0xab,
+             1ULL << 40, stack_str, "abcdef", 4, 7, 1.5, 'z');
+    // the string is copied, not referenced
+    strcpy(stack_str, "overwritten");
+    esp_log_deferred_flush();
+    TEST_ASSERT_NOT_NULL(strstr(s_print_buffer, "deferred: int -5,    42|ab  |, 1099511627776, str on stack abc|   7|, 1.50, z%\n"));
+
+    // order is kept
+    reset_buffer();
+    for (int i = 0; i < 5; i++) {
+        ESP_LOGI(TAG, "message %d", i);
+    }
+    esp_log_deferred_flush();
+    const char *p = s_print_buffer;
+    for (int i = 0; i < 5; i++) {
+        char expected[16];
+        snprintf(expected, sizeof(expected), "message %d", i);
+        p = strstr(p, expected);
+        TEST_ASSERT_NOT_NULL(p);
+    }
+
+    esp_log_set_vprintf(old_vprintf);
+}
+
+static int slow_vprintf(const char *format, va_list args)
+{
+    esp_rom_delay_us(100);
+    return 0;
+}
+
+TEST_CASE("deferred logs do not wait for the output", "[log_deferred]")
+{
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(slow_vprintf);
+    uint32_t dropped = esp_log_deferred_get_dropped();
+
+    const int ITERATIONS = 100;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ESP_LOGI(TAG, "some test data, %d, %d, %d", i, ITERATIONS - i, 12);
+    }
+    int64_t diff = esp_timer_get_time() - start;
+    esp_log_deferred_flush();
+    esp_log_set_vprintf(old_vprintf);
+
+    printf("%d deferred logs took %d usec, %"PRIu32" dropped\n", ITERATIONS, (int)diff, esp_log_deferred_get_dropped() - dropped);
+    // each message needs several calls of slow_vprintf when it is output
+    TEST_ASSERT_LESS_THAN(ITERATIONS * 100, diff);
+}
+
+#endif // CONFIG_LOG_DEFERRED
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_log_flash.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#if CONFIG_LOG_FLASH_SINK
+
+static const char *TAG = "flash_sink";
+
+#define READ_BUF_SIZE   (4 * 256)
+
+/* Read the log from pos to the end, returns whether it contains the string */
+static bool log_contains(uint32_t *pos, const char *str)
+{
+    // the output may be split between two reads, keep the end of the previous one
+    const size_t keep = strlen(str);
+    char *buf = malloc(keep + READ_BUF_SIZE + 1);
+    TEST_ASSERT_NOT_NULL(buf);
+    bool found = false;
+    size_t kept = 0;
+    size_t len;
+    while (true) {
+        TEST_ESP_OK(esp_log_flash_sink_read(pos, buf + kept, READ_BUF_SIZE, &len));
+        if (len == 0) {
+            break;
+        }
+        buf[kept + len] = '\0';
+        found |= strstr(buf, str) != NULL;
+        size_t total = kept + len;
+        kept = MIN(keep, total);
+        memmove(buf, buf + total - kept, kept);
+    }
+    free(buf);
+    return found;
+}
+
+TEST_CASE("flash sink stores the log output", "[log_flash]")
+{
+    TEST_ESP_OK(esp_log_flash_sink_start());
+
+    char marker[32];
+    snprintf(marker, sizeof(marker), "marker %08"PRIx32, esp_random());
+    ESP_LOGI(TAG, "%s", marker);
+    TEST_ESP_OK(esp_log_flash_sink_flush());
+    uint32_t pos = 0;
+    TEST_ASSERT_TRUE(log_contains(&pos, marker));
+
+    // only the newer output is read from the position of the previous read
+    char marker2[32];
+    snprintf(marker2, sizeof(marker2), "marker %08"PRIx32, esp_random());
+    for (int i = 0; i < 20; i++) {
+        ESP_LOGI(TAG, "filling more than one page, line %d", i);
+    }
+    ESP_LOGI(TAG, "%s", marker2);
+    TEST_ESP_OK(esp_log_flash_sink_flush());
+    uint32_t pos2 = pos;
+    TEST_ASSERT_TRUE(log_contains(&pos2, marker2));
+    pos2 = pos;
+    TEST_ASSERT_FALSE(log_contains(&pos2, marker));
+
+    TEST_ESP_OK(esp_log_flash_sink_stop());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_log_flash_sink_stop());
+}
+
+TEST_CASE("flash sink keeps a burst of logs which fits into the buffer", "[log_flash]")
+{
+    TEST_ESP_OK(esp_log_flash_sink_start());
+    uint32_t dropped = esp_log_flash_sink_get_dropped();
+
+    // about 40 bytes each, less than CONFIG_LOG_FLASH_SINK_BUFFER_SIZE in total
+    const int ITERATIONS = 40;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ESP_LOGI(TAG, "some test data, %d, %d, %d", i, ITERATIONS - i, 12);
+    }
+    int64_t diff = esp_timer_get_time() - start;
+    TEST_ESP_OK(esp_log_flash_sink_stop());
+
+    printf("%d logs took %d usec\n", ITERATIONS, (int)diff);
+    TEST_ASSERT_EQUAL(dropped, esp_log_flash_sink_get_dropped());
+    uint32_t pos = 0;
+    TEST_ASSERT_TRUE(log_contains(&pos, "some test data, 39, 1, 12"));
+}
+
+#endif // CONFIG_LOG_FLASH_SINK
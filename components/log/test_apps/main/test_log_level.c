@@ -152,3 +152,36 @@ TEST_CASE("LOG_LOCAL_LEVEL can be re-defined", "[log]")
     esp_rom_install_uart_printf();
     esp_log_level_set("*", ESP_LOG_INFO);
 }
+
+#if !CONFIG_LOG_TAG_LEVEL_IMPL_NONE
+TEST_CASE("tag levels are kept when there are more tags than cache entries", "[log]")
+{
+    const int tag_count = 100;
+    char (*tags)[8] = calloc(tag_count, sizeof(*tags));
+    TEST_ASSERT_NOT_NULL(tags);
+    for (int i = 0; i < tag_count; i++) {
+        snprintf(tags[i], sizeof(tags[i]), "tag%d", i);
+        esp_log_level_set(tags[i], (i % 2) ? ESP_LOG_DEBUG : ESP_LOG_WARN);
+    }
+    // twice, the second time most of the tags are cached
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < tag_count; i++) {
+            TEST_ASSERT_EQUAL((i % 2) ? ESP_LOG_DEBUG : ESP_LOG_WARN, esp_log_level_get(tags[i]));
+        }
+    }
+
+    // a copy of a cached tag string gets the same level
+    char copy[8];
+    strcpy(copy, tags[1]);
+    TEST_ASSERT_EQUAL(ESP_LOG_DEBUG, esp_log_level_get(copy));
+    esp_log_level_set(copy, ESP_LOG_ERROR);
+    TEST_ASSERT_EQUAL(ESP_LOG_ERROR, esp_log_level_get(tags[1]));
+    TEST_ASSERT_EQUAL(ESP_LOG_ERROR, esp_log_level_get(copy));
+
+    esp_log_level_set("*", ESP_LOG_INFO);
+    for (int i = 0; i < tag_count; i++) {
+        TEST_ASSERT_EQUAL(ESP_LOG_INFO, esp_log_level_get(tags[i]));
+    }
+    free(tags);
+}
+#endif // !CONFIG_LOG_TAG_LEVEL_IMPL_NONE
@@ -6,6 +6,21 @@ from pytest_embedded_idf.utils import idf_parametrize
 
 
 @pytest.mark.generic
+@pytest.mark.parametrize('config', ['default'], indirect=True)
 @idf_parametrize('target', ['esp32'], indirect=['target'])
 def test_esp_log(dut: Dut) -> None:
     dut.run_all_single_board_cases()
+
+
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['deferred'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_esp_log_deferred(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='log_deferred')
+
+
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['flash_sink'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_esp_log_flash_sink(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='log_flash')
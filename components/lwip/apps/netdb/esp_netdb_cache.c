@@ -0,0 +1,399 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/lock.h>
+#include "lwip/opt.h"
+#include "lwip/netdb.h"
+#include "lwip/dns.h"
+#include "lwip/memp.h"
+#include "lwip/sockets.h"
+#include "lwip/tcpip.h"
+#include "lwip/sys.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_netdb.h"
+
+#define NETDB_CACHE_TTL_MS          (CONFIG_LWIP_DNS_CACHE_TTL * 1000UL)
+#define NETDB_CACHE_NEGATIVE_TTL_MS (CONFIG_LWIP_DNS_CACHE_NEGATIVE_TTL * 1000UL)
+
+/* One answer per address family: index 0 for A, index 1 for AAAA */
+#define NETDB_CACHE_V4 0
+#define NETDB_CACHE_V6 1
+
+typedef struct {
+    char *name;                     /* host name, NULL if the entry is free */
+    int family;                     /* AF_INET, AF_INET6 or AF_UNSPEC, as requested */
+    ip_addr_t addrs[2];
+    bool valid[2];
+    u32_t stored;                   /* sys_now() when the answers were stored */
+    u32_t lifetime;                 /* ms, the entry is negative if no answer is valid */
+    u32_t last_used;                /* value of s_use_count when the entry was used last, for the LRU replacement */
+    bool refreshing;                /* a prefetch of the entry is in progress */
+} netdb_cache_entry_t;
+
+struct netdb_cache_query;
+
+typedef struct {
+    struct netdb_cache_query *query;
+    ip_addr_t addr;
+    bool found;
+} netdb_cache_answer_t;
+
+typedef struct netdb_cache_query {
+    char *name;
+    int family;
+    u8_t pending;                   /* number of DNS queries not answered yet, only accessed in lwIP context */
+    netdb_cache_answer_t answers[2];
+    SemaphoreHandle_t done;         /* given when all queries are answered, NULL for a prefetch */
+} netdb_cache_query_t;
+
+static netdb_cache_entry_t s_cache[CONFIG_LWIP_DNS_CACHE_SIZE];
+static u32_t s_use_count;
+static _lock_t s_cache_lock;
+
+static bool netdb_cache_wants(int family, int index)
+{
+#if LWIP_IPV4 && LWIP_IPV6
+    return family == AF_UNSPEC || family == (index == NETDB_CACHE_V4 ? AF_INET : AF_INET6);
+#elif LWIP_IPV4
+    return index == NETDB_CACHE_V4;
+#else
+    return index == NETDB_CACHE_V6;
+#endif
+}
+
+static netdb_cache_entry_t *netdb_cache_find(const char *name, int family)
+{
+    for (int i = 0; i < CONFIG_LWIP_DNS_CACHE_SIZE; i++) {
+        if (s_cache[i].name && s_cache[i].family == family && strcasecmp(s_cache[i].name, name) == 0) {
+            return &s_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void netdb_cache_free_query(netdb_cache_query_t *query)
+{
+    if (query->done) {
+        vSemaphoreDelete(query->done);
+    }
+    free(query->name);
+    free(query);
+}
+
+/* Stores the answers of the query, replacing the least recently used entry if needed */
+static void netdb_cache_store(const netdb_cache_query_t *query)
+{
+    bool found = query->answers[NETDB_CACHE_V4].found || query->answers[NETDB_CACHE_V6].found;
+
+    _lock_acquire(&s_cache_lock);
+    netdb_cache_entry_t *entry = netdb_cache_find(query->name, query->family);
+    if (!found && (query->done == NULL || NETDB_CACHE_NEGATIVE_TTL_MS == 0)) {
+        // a failed prefetch keeps the current answers until they expire
+        if (entry != NULL) {
+            entry->refreshing = false;
+        }
+        _lock_release(&s_cache_lock);
+        return;
+    }
+    if (entry == NULL) {
+        entry = &s_cache[0];
+        for (int i = 0; i < CONFIG_LWIP_DNS_CACHE_SIZE; i++) {
+            if (s_cache[i].name == NULL) {
+                entry = &s_cache[i];
+                break;
+            }
+            if (s_cache[i].last_used < entry->last_used) {
+                entry = &s_cache[i];
+            }
+        }
+        char *name = strdup(query->name);
+        if (name == NULL) {
+            _lock_release(&s_cache_lock);
+            return;
+        }
+        free(entry->name);
+        entry->name = name;
+        entry->family = query->family;
+        entry->last_used = ++s_use_count;
+    }
+    for (int i = 0; i < 2; i++) {
+        entry->valid[i] = query->answers[i].found;
+        ip_addr_copy(entry->addrs[i], query->answers[i].addr);
+    }
+    entry->stored = sys_now();
+    entry->lifetime = found ? NETDB_CACHE_TTL_MS : NETDB_CACHE_NEGATIVE_TTL_MS;
+    entry->refreshing = false;
+    _lock_release(&s_cache_lock);
+}
+
+/* Called in lwIP context when the answer to one of the queries is known */
+static void netdb_cache_answer_done(netdb_cache_answer_t *answer, const ip_addr_t *ipaddr)
+{
+    netdb_cache_query_t *query = answer->query;
+    if (ipaddr != NULL) {
+        ip_addr_copy(answer->addr, *ipaddr);
+        answer->found = true;
+    }
+    if (--query->pending > 0) {
+        return;
+    }
+    if (query->done) {
+        xSemaphoreGive(query->done);
+    } else {
+        // nobody waits for a prefetch
+        netdb_cache_store(query);
+        netdb_cache_free_query(query);
+    }
+}
+
+static void netdb_cache_found(const char *name, const ip_addr_t *ipaddr, void *arg)
+{
+    LWIP_UNUSED_ARG(name);
+    netdb_cache_answer_done((netdb_cache_answer_t *)arg, ipaddr);
+}
+
+/* Sends the A and AAAA queries at once, the answers already in the lwIP DNS table are known immediately */
+static void netdb_cache_start_query(void *arg)
+{
+    netdb_cache_query_t *query = (netdb_cache_query_t *)arg;
+    netdb_cache_answer_t *start[2];
+    int num = 0;
+
+    // count the queries first, so that an immediate answer to the first one doesn't complete the request
+    for (int i = 0; i < 2; i++) {
+        if (query->answers[i].query != NULL) {
+            start[num++] = &query->answers[i];
+        }
+    }
+    query->pending = num;
+    for (int i = 0; i < num; i++) {
+        u8_t addrtype = (start[i] == &query->answers[NETDB_CACHE_V4]) ? LWIP_DNS_ADDRTYPE_IPV4 : LWIP_DNS_ADDRTYPE_IPV6;
+        ip_addr_t addr;
+        err_t err = dns_gethostbyname_addrtype(query->name, &addr, netdb_cache_found, start[i], addrtype);
+        if (err == ERR_OK) {
+            netdb_cache_answer_done(start[i], &addr);
+        } else if (err != ERR_INPROGRESS) {
+            netdb_cache_answer_done(start[i], NULL);
+        }
+    }
+}
+
+static netdb_cache_query_t *netdb_cache_new_query(const char *name, int family, bool wait)
+{
+    netdb_cache_query_t *query = calloc(1, sizeof(netdb_cache_query_t));
+    if (query == NULL) {
+        return NULL;
+    }
+    query->name = strdup(name);
+    query->family = family;
+    if (wait) {
+        query->done = xSemaphoreCreateBinary();
+    }
+    if (query->name == NULL || (wait && query->done == NULL)) {
+        netdb_cache_free_query(query);
+        return NULL;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (netdb_cache_wants(family, i)) {
+            query->answers[i].query = query;
+        }
+    }
+    return query;
+}
+
+static void netdb_cache_prefetch(netdb_cache_entry_t *entry)
+{
+    netdb_cache_query_t *query = netdb_cache_new_query(entry->name, entry->family, false);
+    if (query == NULL) {
+        return;
+    }
+    // called with the cache locked, so don't wait for room in the lwIP mailbox
+    if (tcpip_try_callback(netdb_cache_start_query, query) != ERR_OK) {
+        netdb_cache_free_query(query);
+        return;
+    }
+    entry->refreshing = true;
+}
+
+/* Gets the answers from the cache, or resolves them and waits for them. Returns EAI_FAIL for a negative answer. */
+static int netdb_cache_resolve(const char *name, int family, ip_addr_t addrs[2], bool valid[2])
+{
+    _lock_acquire(&s_cache_lock);
+    netdb_cache_entry_t *entry = netdb_cache_find(name, family);
+    if (entry != NULL) {
+        u32_t age = sys_now() - entry->stored;
+        if (age < entry->lifetime) {
+            entry->last_used = ++s_use_count;
+            for (int i = 0; i < 2; i++) {
+                valid[i] = entry->valid[i];
+                ip_addr_copy(addrs[i], entry->addrs[i]);
+            }
+#if CONFIG_LWIP_DNS_CACHE_PREFETCH
+            // refresh a used entry in its last quarter of life, so that it never expires while in use
+            if (!entry->refreshing && (valid[NETDB_CACHE_V4] || valid[NETDB_CACHE_V6]) &&
+                    age >= entry->lifetime - entry->lifetime / 4) {
+                netdb_cache_prefetch(entry);
+            }
+#endif
+            _lock_release(&s_cache_lock);
+            return (valid[NETDB_CACHE_V4] || valid[NETDB_CACHE_V6]) ? 0 : EAI_FAIL;
+        }
+    }
+    _lock_release(&s_cache_lock);
+
+    netdb_cache_query_t *query = netdb_cache_new_query(name, family, true);
+    if (query == NULL) {
+        return EAI_MEMORY;
+    }
+    if (tcpip_callback(netdb_cache_start_query, query) != ERR_OK) {
+        netdb_cache_free_query(query);
+        return EAI_FAIL;
+    }
+    // lwIP answers each query, at the latest when it times out
+    xSemaphoreTake(query->done, portMAX_DELAY);
+    netdb_cache_store(query);
+    for (int i = 0; i < 2; i++) {
+        valid[i] = query->answers[i].found;
+        ip_addr_copy(addrs[i], query->answers[i].addr);
+    }
+    netdb_cache_free_query(query);
+    return (valid[NETDB_CACHE_V4] || valid[NETDB_CACHE_V6]) ? 0 : EAI_FAIL;
+}
+
+/* Allocates an addrinfo the same way as lwip_getaddrinfo(), so that it is freed by freeaddrinfo() */
+static struct addrinfo *netdb_cache_new_addrinfo(const ip_addr_t *addr, u16_t port, const char *nodename,
+                                                 const struct addrinfo *hints)
+{
+    struct addrinfo *ai = (struct addrinfo *)memp_malloc(MEMP_NETDB);
+    if (ai == NULL) {
+        return NULL;
+    }
+    memset(ai, 0, NETDB_ELEM_SIZE);
+    struct sockaddr_storage *sa = (struct sockaddr_storage *)(void *)((u8_t *)ai + sizeof(struct addrinfo));
+#if LWIP_IPV6
+    if (IP_IS_V6(addr)) {
+        struct sockaddr_in6 *sa6 = (struct sockaddr_in6 *)sa;
+        inet6_addr_from_ip6addr(&sa6->sin6_addr, ip_2_ip6(addr));
+        sa6->sin6_family = AF_INET6;
+        sa6->sin6_len = sizeof(struct sockaddr_in6);
+        sa6->sin6_port = lwip_htons(port);
+        sa6->sin6_scope_id = ip6_addr_zone(ip_2_ip6(addr));
+        ai->ai_family = AF_INET6;
+    }
+#endif
+#if LWIP_IPV4
+    if (IP_IS_V4(addr)) {
+        struct sockaddr_in *sa4 = (struct sockaddr_in *)sa;
+        inet_addr_from_ip4addr(&sa4->sin_addr, ip_2_ip4(addr));
+        sa4->sin_family = AF_INET;
+        sa4->sin_len = sizeof(struct sockaddr_in);
+        sa4->sin_port = lwip_htons(port);
+        ai->ai_family = AF_INET;
+    }
+#endif
+    if (hints != NULL) {
+        ai->ai_socktype = hints->ai_socktype;
+        ai->ai_protocol = hints->ai_protocol;
+        if (hints->ai_flags & AI_CANONNAME) {
+            ai->ai_canonname = (char *)sa + sizeof(struct sockaddr_storage);
+            strlcpy(ai->ai_canonname, nodename, DNS_MAX_NAME_LENGTH + 1);
+        }
+    }
+    ai->ai_addrlen = sizeof(struct sockaddr_storage);
+    ai->ai_addr = (struct sockaddr *)sa;
+    return ai;
+}
+
+static int netdb_cache_uncached_getaddrinfo(const char *nodename, const char *servname,
+                                            const struct addrinfo *hints, struct addrinfo **res)
+{
+#if CONFIG_LWIP_USE_ESP_GETADDRINFO
+    if (hints != NULL) {
+        return esp_getaddrinfo(nodename, servname, hints, res);
+    }
+#endif
+    return lwip_getaddrinfo(nodename, servname, hints, res);
+}
+
+int esp_netdb_cache_getaddrinfo(const char *nodename, const char *servname,
+                                const struct addrinfo *hints, struct addrinfo **res)
+{
+    ip_addr_t numeric;
+
+    if (res == NULL) {
+        return EAI_FAIL;
+    }
+    *res = NULL;
+    // numeric and local addresses, and the lookups the cache doesn't implement, are left to lwIP
+    if (nodename == NULL || strlen(nodename) > DNS_MAX_NAME_LENGTH || ipaddr_aton(nodename, &numeric) ||
+            (hints != NULL && (hints->ai_flags & (AI_NUMERICHOST | AI_PASSIVE | AI_V4MAPPED)))) {
+        return netdb_cache_uncached_getaddrinfo(nodename, servname, hints, res);
+    }
+
+    int family = (hints != NULL) ? hints->ai_family : AF_UNSPEC;
+    if (family != AF_UNSPEC && family != AF_INET && family != AF_INET6) {
+        return EAI_FAMILY;
+    }
+#if !LWIP_IPV6
+    if (family == AF_INET6) {
+        return EAI_FAMILY;
+    }
+    family = AF_INET;
+#elif !LWIP_IPV4
+    if (family == AF_INET) {
+        return EAI_FAMILY;
+    }
+    family = AF_INET6;
+#endif
+
+    u16_t port = 0;
+    if (servname != NULL) {
+        // lwIP supports numeric service names only
+        char *end;
+        long port_nr = strtol(servname, &end, 10);
+        if (*servname == '\0' || *end != '\0' || port_nr < 0 || port_nr > 0xffff) {
+            return EAI_SERVICE;
+        }
+        port = (u16_t)port_nr;
+    }
+
+    ip_addr_t addrs[2];
+    bool valid[2];
+    int ret = netdb_cache_resolve(nodename, family, addrs, valid);
+    if (ret != 0) {
+        return ret;
+    }
+
+    // the IPv4 address comes first, as with esp_getaddrinfo()
+    struct addrinfo **next = res;
+    for (int i = 0; i < 2; i++) {
+        if (!valid[i]) {
+            continue;
+        }
+        *next = netdb_cache_new_addrinfo(&addrs[i], port, nodename, hints);
+        if (*next == NULL) {
+            lwip_freeaddrinfo(*res);
+            *res = NULL;
+            return EAI_MEMORY;
+        }
+        next = &(*next)->ai_next;
+    }
+    return 0;
+}
+
+void esp_netdb_cache_flush(void)
+{
+    _lock_acquire(&s_cache_lock);
+    for (int i = 0; i < CONFIG_LWIP_DNS_CACHE_SIZE; i++) {
+        free(s_cache[i].name);
+        s_cache[i].name = NULL;
+    }
+    _lock_release(&s_cache_lock);
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -32,6 +32,40 @@ int esp_getaddrinfo(const char *nodename, const char *servname,
                         const struct addrinfo *hints, struct addrinfo **res);
 #endif
 
+#if CONFIG_LWIP_DNS_CACHE
+/**
+ * @brief getaddrinfo() with a cache of the resolved host names
+ *
+ * Replaces getaddrinfo() when CONFIG_LWIP_DNS_CACHE is enabled. The answers are kept for
+ * CONFIG_LWIP_DNS_CACHE_TTL seconds, and the failures for CONFIG_LWIP_DNS_CACHE_NEGATIVE_TTL seconds.
+ * With CONFIG_LWIP_DNS_CACHE_PREFETCH, an answer used in the last quarter of its lifetime is refreshed
+ * in the background, so that the host names used regularly are always resolved from the cache.
+ *
+ * With AF_UNSPEC, the A and AAAA queries are sent at the same time, and the result lists the IPv4 address
+ * first, followed by the IPv6 address.
+ *
+ * Numeric addresses and the AI_NUMERICHOST, AI_PASSIVE or AI_V4MAPPED lookups are not cached.
+ *
+ * @return 0 on success, or an error code on failure.
+ *         - `EAI_FAIL`: The host name couldn't be resolved, now or less than CONFIG_LWIP_DNS_CACHE_NEGATIVE_TTL
+ *           seconds ago.
+ *         - `EAI_FAMILY`: Address family not supported.
+ *         - `EAI_SERVICE`: Service name is not a port number.
+ *         - `EAI_MEMORY`: Out of memory.
+ *
+ * @note Caller must free the result list with freeaddrinfo().
+ */
+int esp_netdb_cache_getaddrinfo(const char *nodename, const char *servname,
+                                const struct addrinfo *hints, struct addrinfo **res);
+
+/**
+ * @brief Drop all the entries of the getaddrinfo() cache
+ *
+ * Useful when the network changes, e.g., after switching to another interface or DNS server.
+ */
+void esp_netdb_cache_flush(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,7 +8,7 @@
 #include <stddef.h>
 #include_next "lwip/netdb.h"
 #include "sdkconfig.h"
-#if CONFIG_LWIP_USE_ESP_GETADDRINFO
+#if CONFIG_LWIP_USE_ESP_GETADDRINFO || CONFIG_LWIP_DNS_CACHE
 #include_next "esp_netdb.h"
 #endif
 
@@ -39,7 +39,9 @@ static inline struct hostent *gethostbyname(const char *name)
 static inline void freeaddrinfo(struct addrinfo *ai)
 { lwip_freeaddrinfo(ai); }
 static inline int getaddrinfo(const char *nodename, const char *servname, const struct addrinfo *hints, struct addrinfo **res)
-#ifdef CONFIG_LWIP_USE_ESP_GETADDRINFO
+#if defined(CONFIG_LWIP_DNS_CACHE)
+{ return esp_netdb_cache_getaddrinfo(nodename, servname, hints, res); }
+#elif defined(CONFIG_LWIP_USE_ESP_GETADDRINFO)
 { return esp_getaddrinfo(nodename, servname, hints, res); }
 #else
 { return lwip_getaddrinfo(nodename, servname, hints, res); }
@@ -1,11 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #pragma once
 
 #include_next "lwip/sockets.h"
+#include <time.h>
 #include "sdkconfig.h"
 
 #ifdef __cplusplus
@@ -34,6 +35,90 @@ extern "C" {
 int socketpair(int domain, int type, int protocol, int sv[2]);
 #endif
 
+struct pbuf;
+
+/**
+ * @brief Receives data from a socket without copying it
+ *
+ * Instead of copying the received data into a user buffer as ``recv()`` does, this function
+ * returns the lwIP pbuf chain which holds it. For TCP sockets, the chain holds the data which
+ * the TCP layer has passed to the socket at once (or what is left of it after a previous ``recv()``),
+ * for UDP and RAW sockets, it holds one datagram. The data is accessed by following
+ * ``p->next`` and reading ``len`` bytes from ``payload`` in each pbuf of the chain.
+ *
+ * @note The chain has to be given back with ``lwip_pbuf_free()``. It stays in memory until then,
+ *       and TCP advertises the receive window as if the data had been read, so the application
+ *       should release the chains as soon as it has processed them.
+ * @note The socket must not be closed by another task while this function is called.
+ *
+ * @param[in]  s     Socket descriptor
+ * @param[out] p     Received pbuf chain, NULL if the peer closed the connection or on error
+ * @param[in]  flags 0, or a combination of ``MSG_DONTWAIT`` and ``MSG_PEEK``. With ``MSG_PEEK``,
+ *                   the same data is also returned by the next receive call, and the chain
+ *                   still has to be freed.
+ *
+ * @return
+ *     - Number of bytes in the chain on success.
+ *     - 0 if the peer closed the TCP connection.
+ *     - -1 on failure, with `errno` set to indicate the error.
+ */
+ssize_t lwip_recv_pbuf(int s, struct pbuf **p, int flags);
+
+/**
+ * @brief Frees a pbuf chain returned by ``lwip_recv_pbuf()``
+ *
+ * @param[in] p pbuf chain, may be NULL
+ */
+void lwip_pbuf_free(struct pbuf *p);
+
+#ifndef MSG_WAITFORONE
+#define MSG_WAITFORONE      0x10000 /* lwip_recvmmsg(): only wait for the first datagram */
+#endif
+
+/**
+ * @brief Message header of ``lwip_sendmmsg()`` and ``lwip_recvmmsg()``
+ */
+struct mmsghdr {
+    struct msghdr msg_hdr;  /*!< Datagram, as passed to ``sendmsg()`` or ``recvmsg()`` */
+    unsigned int msg_len;   /*!< Number of bytes sent or received for this datagram */
+};
+
+/**
+ * @brief Sends several datagrams on a UDP socket
+ *
+ * Unlike calling ``sendmsg()`` for each datagram, which posts one message to the TCP/IP task per
+ * datagram, this function sends up to 16 datagrams per message to the TCP/IP task.
+ *
+ * @param[in]    s      UDP socket descriptor
+ * @param[inout] msgvec Datagrams to send. ``msg_name`` may be NULL for a connected socket.
+ *                      ``msg_len`` is set to the number of bytes sent for each datagram.
+ * @param[in]    vlen   Number of datagrams in ``msgvec``
+ * @param[in]    flags  0, or a combination of ``MSG_DONTWAIT`` and ``MSG_MORE``, which have no effect on UDP sockets
+ *
+ * @return
+ *     - Number of datagrams sent, which is less than ``vlen`` if an error occurred after the first datagram.
+ *     - -1 if no datagram could be sent, with `errno` set to indicate the error.
+ */
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+
+/**
+ * @brief Receives several datagrams from a socket
+ *
+ * @param[in]    s       Socket descriptor
+ * @param[inout] msgvec  Buffers for the datagrams, as for ``recvmsg()``. ``msg_len`` is set to the
+ *                       number of bytes received for each datagram.
+ * @param[in]    vlen    Number of datagrams in ``msgvec``
+ * @param[in]    flags   Flags passed to ``recvmsg()`` for each datagram. With ``MSG_WAITFORONE``,
+ *                       only the first datagram is waited for.
+ * @param[in]    timeout If not NULL, no more datagrams are waited for once this time has elapsed.
+ *                       As on Linux, it is only checked after each received datagram.
+ *
+ * @return
+ *     - Number of datagrams received.
+ *     - -1 if no datagram has been received, with `errno` set to indicate the error.
+ */
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout);
+
 static inline int accept(int s,struct sockaddr *addr,socklen_t *addrlen)
 { return lwip_accept(s,addr,addrlen); }
 static inline int bind(int s,const struct sockaddr *name, socklen_t namelen)
@@ -56,6 +141,10 @@ static inline int listen(int s,int backlog)
 { return lwip_listen(s,backlog); }
 static inline ssize_t recvmsg(int sockfd, struct msghdr *msg, int flags)
 { return lwip_recvmsg(sockfd, msg, flags); }
+static inline int recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{ return lwip_recvmmsg(s, msgvec, vlen, flags, timeout); }
+static inline int sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{ return lwip_sendmmsg(s, msgvec, vlen, flags); }
 static inline ssize_t recv(int s,void *mem,size_t len,int flags)
 { return lwip_recv(s,mem,len,flags); }
 static inline ssize_t recvfrom(int s,void *mem,size_t len,int flags,struct sockaddr *from,socklen_t *fromlen)
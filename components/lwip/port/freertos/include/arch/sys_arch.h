@@ -3,7 +3,7 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
- * SPDX-FileContributor: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2018-2025 Espressif Systems (Shanghai) CO LTD
  */
 #ifndef __SYS_ARCH_H__
 #define __SYS_ARCH_H__
@@ -24,6 +24,9 @@ typedef TaskHandle_t sys_thread_t;
 
 typedef struct sys_mbox_s {
   QueueHandle_t os_mbox;
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+  struct sys_mbox_lock_free_s *lock_free; /* used instead of os_mbox if the mailbox is created with SYS_MBOX_SIZE_LOCK_FREE */
+#endif
 }* sys_mbox_t;
 
 /** This is returned by _fromisr() sys functions to tell the outermost function
@@ -3,12 +3,13 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
- * SPDX-FileContributor: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2018-2025 Espressif Systems (Shanghai) CO LTD
  */
 
 /* lwIP includes. */
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
@@ -195,6 +196,160 @@ sys_sem_free(sys_sem_t *sem)
   *sem = NULL;
 }
 
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+
+/* Task notification of the consumer task used by the lock-free mailbox */
+#define SYS_MBOX_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+
+typedef struct {
+  atomic_uint seq;      /* position the cell is ready for: pos when free, pos + 1 when it holds the message of pos */
+  void *msg;
+} sys_mbox_cell_t;
+
+/**
+ * Bounded ring buffer with multiple producers and a single consumer (the tcpip thread).
+ * A producer claims a position with a CAS on tail, writes the message into the cell of this
+ * position and then publishes it by updating the sequence number of the cell. The consumer
+ * reads the cells in order, without any atomic read-modify-write. It blocks on a task
+ * notification, which the producers only send when it has announced that it is waiting.
+ */
+struct sys_mbox_lock_free_s {
+  atomic_uint tail;             /* next position to be claimed by a producer */
+  unsigned head;                /* next position to be read, only accessed by the consumer */
+  unsigned mask;                /* number of cells - 1, the number of cells is a power of 2 */
+  atomic_bool waiting;          /* the consumer is waiting, or about to wait, for a notification */
+  TaskHandle_t consumer;
+  sys_mbox_cell_t cells[];
+};
+
+static err_t
+sys_mbox_lock_free_new(sys_mbox_t mbox, int size)
+{
+  unsigned cells = 1;
+
+  while (cells < (unsigned)size) {
+    cells <<= 1;
+  }
+  struct sys_mbox_lock_free_s *mb = mem_malloc(sizeof(struct sys_mbox_lock_free_s) + cells * sizeof(sys_mbox_cell_t));
+  if (mb == NULL) {
+    return ERR_MEM;
+  }
+  atomic_init(&mb->tail, 0);
+  mb->head = 0;
+  mb->mask = cells - 1;
+  atomic_init(&mb->waiting, false);
+  mb->consumer = NULL;
+  for (unsigned i = 0; i < cells; i++) {
+    atomic_init(&mb->cells[i].seq, i);
+    mb->cells[i].msg = NULL;
+  }
+  mbox->lock_free = mb;
+  return ERR_OK;
+}
+
+/**
+ * @brief Post a message, from a task or an ISR
+ *
+ * Interrupts are masked on the current core between claiming the cell and publishing it,
+ * so that the producer can't be preempted there. Otherwise a preempted low priority task
+ * would hold back the messages posted after its own until it runs again. Producers
+ * running on other cores are not blocked, the ring buffer itself doesn't use a lock.
+ *
+ * @return ERR_OK on success, ERR_MEM when the mailbox is full,
+ *         ERR_NEED_SCHED (only if woken is non-NULL) when the consumer task has been woken up from ISR
+ */
+static err_t
+sys_mbox_lock_free_post(struct sys_mbox_lock_free_s *mb, void *msg, BaseType_t *woken)
+{
+  sys_mbox_cell_t *cell;
+  UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+  unsigned pos = atomic_load_explicit(&mb->tail, memory_order_relaxed);
+
+  for (;;) {
+    cell = &mb->cells[pos & mb->mask];
+    int diff = (int)(atomic_load_explicit(&cell->seq, memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (atomic_compare_exchange_weak_explicit(&mb->tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      /* the consumer hasn't read this cell yet */
+      portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+      return ERR_MEM;
+    } else {
+      pos = atomic_load_explicit(&mb->tail, memory_order_relaxed);
+    }
+  }
+  cell->msg = msg;
+  atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+
+  /* pairs with the fence in sys_mbox_lock_free_fetch(): either the consumer sees the message, or we see it waiting */
+  atomic_thread_fence(memory_order_seq_cst);
+  if (atomic_load_explicit(&mb->waiting, memory_order_relaxed) &&
+      atomic_exchange_explicit(&mb->waiting, false, memory_order_relaxed)) {
+    if (woken) {
+      vTaskNotifyGiveIndexedFromISR(mb->consumer, SYS_MBOX_NOTIFY_INDEX, woken);
+      return *woken == pdTRUE ? ERR_NEED_SCHED : ERR_OK;
+    }
+    xTaskNotifyGiveIndexed(mb->consumer, SYS_MBOX_NOTIFY_INDEX);
+  }
+  return ERR_OK;
+}
+
+static bool
+sys_mbox_lock_free_tryfetch(struct sys_mbox_lock_free_s *mb, void **msg)
+{
+  sys_mbox_cell_t *cell = &mb->cells[mb->head & mb->mask];
+
+  if (atomic_load_explicit(&cell->seq, memory_order_acquire) != mb->head + 1) {
+    return false;
+  }
+  *msg = cell->msg;
+  /* the cell is free for the position one turn later */
+  atomic_store_explicit(&cell->seq, mb->head + mb->mask + 1, memory_order_release);
+  mb->head++;
+  return true;
+}
+
+static u32_t
+sys_mbox_lock_free_fetch(struct sys_mbox_lock_free_s *mb, void **msg, u32_t timeout)
+{
+  TickType_t timeout_ticks = timeout / portTICK_PERIOD_MS;
+  TickType_t start = xTaskGetTickCount();
+
+  if (unlikely(mb->consumer == NULL)) {
+    mb->consumer = xTaskGetCurrentTaskHandle();
+  }
+  LWIP_ASSERT("lock-free mbox fetched from several tasks", mb->consumer == xTaskGetCurrentTaskHandle());
+
+  while (!sys_mbox_lock_free_tryfetch(mb, msg)) {
+    TickType_t wait = portMAX_DELAY;
+
+    if (timeout != 0) {
+      TickType_t elapsed = xTaskGetTickCount() - start;
+      if (elapsed >= timeout_ticks) {
+        *msg = NULL;
+        return SYS_ARCH_TIMEOUT;
+      }
+      wait = timeout_ticks - elapsed;
+    }
+    atomic_store_explicit(&mb->waiting, true, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    /* check again, a message may have been posted before the producer could see that we are waiting */
+    if (sys_mbox_lock_free_tryfetch(mb, msg)) {
+      atomic_store_explicit(&mb->waiting, false, memory_order_relaxed);
+      break;
+    }
+    /* a notification left over from a previous wait only causes one more iteration */
+    ulTaskNotifyTakeIndexed(SYS_MBOX_NOTIFY_INDEX, pdTRUE, wait);
+    atomic_store_explicit(&mb->waiting, false, memory_order_relaxed);
+  }
+  return 0;
+}
+
+#endif /* CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE */
+
 /**
  * @brief Create an empty mailbox.
  *
@@ -211,6 +366,20 @@ sys_mbox_new(sys_mbox_t *mbox, int size)
     return ERR_MEM;
   }
 
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+  (*mbox)->lock_free = NULL;
+  if (size & SYS_MBOX_SIZE_LOCK_FREE) {
+    (*mbox)->os_mbox = NULL;
+    if (sys_mbox_lock_free_new(*mbox, size & ~SYS_MBOX_SIZE_LOCK_FREE) != ERR_OK) {
+      LWIP_DEBUGF(ESP_THREAD_SAFE_DEBUG, ("fail to new lock-free mbox\n"));
+      free(*mbox);
+      return ERR_MEM;
+    }
+    LWIP_DEBUGF(ESP_THREAD_SAFE_DEBUG, ("new *mbox ok mbox=%p lock_free=%p\n", *mbox, (*mbox)->lock_free));
+    return ERR_OK;
+  }
+#endif
+
   (*mbox)->os_mbox = xQueueCreate(size, sizeof(void *));
 
   if ((*mbox)->os_mbox == NULL) {
@@ -232,6 +401,15 @@ sys_mbox_new(sys_mbox_t *mbox, int size)
 void
 sys_mbox_post(sys_mbox_t *mbox, void *msg)
 {
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+  if ((*mbox)->lock_free) {
+    /* there is nothing to block on while the mailbox is full, let the consumer run */
+    while (sys_mbox_lock_free_post((*mbox)->lock_free, msg, NULL) != ERR_OK) {
+      vTaskDelay(1);
+    }
+    return;
+  }
+#endif
   BaseType_t ret = xQueueSendToBack((*mbox)->os_mbox, &msg, portMAX_DELAY);
   LWIP_ASSERT("mbox post failed", ret == pdTRUE);
   (void)ret;
@@ -249,6 +427,16 @@ sys_mbox_trypost(sys_mbox_t *mbox, void *msg)
 {
   err_t xReturn;
 
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+  if ((*mbox)->lock_free) {
+    xReturn = sys_mbox_lock_free_post((*mbox)->lock_free, msg, NULL);
+    if (xReturn != ERR_OK) {
+      LWIP_DEBUGF(ESP_THREAD_SAFE_DEBUG, ("trypost mbox=%p fail\n", (*mbox)->lock_free));
+    }
+    return xReturn;
+  }
+#endif
+
   if (xQueueSend((*mbox)->os_mbox, &msg, 0) == pdTRUE) {
     xReturn = ERR_OK;
   } else {
@@ -274,6 +462,12 @@ sys_mbox_trypost_fromisr(sys_mbox_t *mbox, void *msg)
   BaseType_t ret;
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+  if ((*mbox)->lock_free) {
+    return sys_mbox_lock_free_post((*mbox)->lock_free, msg, &xHigherPriorityTaskWoken);
+  }
+#endif
+
   ret = xQueueSendFromISR((*mbox)->os_mbox, &msg, &xHigherPriorityTaskWoken);
   if (ret == pdTRUE) {
     if (xHigherPriorityTaskWoken == pdTRUE) {
@@ -304,6 +498,12 @@ sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
     msg = &msg_dummy;
   }
 
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+  if ((*mbox)->lock_free) {
+    return sys_mbox_lock_free_fetch((*mbox)->lock_free, msg, timeout);
+  }
+#endif
+
   if (timeout == 0) {
     /* wait infinite */
     ret = xQueueReceive((*mbox)->os_mbox, &(*msg), portMAX_DELAY);
@@ -338,6 +538,15 @@ sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg)
   if (msg == NULL) {
     msg = &msg_dummy;
   }
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+  if ((*mbox)->lock_free) {
+    if (!sys_mbox_lock_free_tryfetch((*mbox)->lock_free, msg)) {
+      *msg = NULL;
+      return SYS_MBOX_EMPTY;
+    }
+    return 0;
+  }
+#endif
   ret = xQueueReceive((*mbox)->os_mbox, &(*msg), 0);
   if (ret == errQUEUE_EMPTY) {
     *msg = NULL;
@@ -359,6 +568,16 @@ sys_mbox_free(sys_mbox_t *mbox)
   if ((NULL == mbox) || (NULL == *mbox)) {
     return;
   }
+#if CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+  if ((*mbox)->lock_free) {
+    LWIP_ASSERT("mbox quence not empty",
+                atomic_load(&(*mbox)->lock_free->tail) == (*mbox)->lock_free->head);
+    free((*mbox)->lock_free);
+    free(*mbox);
+    *mbox = NULL;
+    return;
+  }
+#endif
   UBaseType_t msgs_waiting = uxQueueMessagesWaiting((*mbox)->os_mbox);
   LWIP_ASSERT("mbox quence not empty", msgs_waiting == 0);
 
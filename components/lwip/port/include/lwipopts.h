@@ -867,7 +867,17 @@ static inline uint32_t timeout_from_offered(uint32_t lease, uint32_t min)
  * The queue size value itself is platform-dependent, but is passed to
  * sys_mbox_new() when tcpip_init is called.
  */
+#ifdef CONFIG_LWIP_TCPIP_MBOX_LOCK_FREE
+/**
+ * SYS_MBOX_SIZE_LOCK_FREE: Flag added to the size passed to sys_mbox_new(),
+ * which makes the port create a lock-free mailbox with a single consumer.
+ * It is only used for the tcpip thread mailbox.
+ */
+#define SYS_MBOX_SIZE_LOCK_FREE         0x10000
+#define TCPIP_MBOX_SIZE                 (CONFIG_LWIP_TCPIP_RECVMBOX_SIZE | SYS_MBOX_SIZE_LOCK_FREE)
+#else
 #define TCPIP_MBOX_SIZE                 CONFIG_LWIP_TCPIP_RECVMBOX_SIZE
+#endif
 
 /**
  * DEFAULT_UDP_RECVMBOX_SIZE: The mailbox size for the incoming packets on a
@@ -1209,6 +1219,16 @@ static inline uint32_t timeout_from_offered(uint32_t lease, uint32_t min)
 #define CHECKSUM_CHECK_ICMP             0
 #endif
 
+/**
+ * LWIP_CHECKSUM_CTRL_PER_NETIF==1: Checksum generation/check can be enabled/disabled
+ * per netif.
+ */
+#ifdef CONFIG_LWIP_CHECKSUM_CTRL_PER_NETIF
+#define LWIP_CHECKSUM_CTRL_PER_NETIF    1
+#else
+#define LWIP_CHECKSUM_CTRL_PER_NETIF    0
+#endif
+
 /*
    ---------------------------------------
    ---------- IPv6 options ---------------
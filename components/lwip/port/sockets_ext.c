@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,6 +11,11 @@
 #include "lwip/tcp.h"
 #include "lwip/raw.h"
 #include "lwip/udp.h"
+#include "lwip/pbuf.h"
+#include "lwip/mem.h"
+#include "lwip/errno.h"
+#include "lwip/inet.h"
+#include "lwip/priv/tcpip_priv.h"
 
 #define LWIP_SOCKOPT_CHECK_OPTLEN_CONN_PCB(sock, optlen, opttype) do { \
   if (((optlen) < sizeof(opttype)) || ((sock)->conn == NULL) || ((sock)->conn->pcb.tcp == NULL)) { *err=EINVAL; goto exit; } }while(0)
@@ -106,3 +111,270 @@ exit:
     return true;
 #endif /* LWIP_IPV6 */
 }
+
+ssize_t lwip_recv_pbuf(int s, struct pbuf **p, int flags)
+{
+    struct lwip_sock *sock;
+    struct pbuf *q;
+    u8_t apiflags = 0;
+    err_t err;
+
+    if (p == NULL || (flags & ~(MSG_PEEK | MSG_DONTWAIT)) != 0) {
+        set_errno(EINVAL);
+        return -1;
+    }
+    *p = NULL;
+    sock = lwip_socket_dbg_get_socket(s);
+    if (sock == NULL || sock->conn == NULL) {
+        set_errno(EBADF);
+        return -1;
+    }
+    if (flags & MSG_DONTWAIT) {
+        apiflags = NETCONN_DONTBLOCK;
+    }
+
+    /* Data left by a previous recv() with MSG_PEEK or a partial read is returned first,
+       as lwip_recv() would do */
+    if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+        q = sock->lastdata.pbuf;
+        if (q == NULL) {
+            /* like lwip_recv_tcp(), update the receive window only once the data is consumed */
+            err = netconn_recv_tcp_pbuf_flags(sock->conn, &q, apiflags | NETCONN_NOAUTORCVD);
+            if (err == ERR_CLSD) {
+                /* connection closed by the peer */
+                return 0;
+            }
+            if (err != ERR_OK) {
+                set_errno(err_to_errno(err));
+                return -1;
+            }
+        }
+        if (flags & MSG_PEEK) {
+            sock->lastdata.pbuf = q;
+            pbuf_ref(q);
+        } else {
+            sock->lastdata.pbuf = NULL;
+            netconn_tcp_recvd(sock->conn, q->tot_len);
+        }
+    } else {
+        struct netbuf *buf = sock->lastdata.netbuf;
+        if (buf == NULL) {
+            err = netconn_recv_udp_raw_netbuf_flags(sock->conn, &buf, apiflags);
+            if (err != ERR_OK) {
+                set_errno(err_to_errno(err));
+                return -1;
+            }
+        }
+        q = buf->p;
+        if (flags & MSG_PEEK) {
+            sock->lastdata.netbuf = buf;
+            pbuf_ref(q);
+        } else {
+            /* take the pbuf out of the netbuf before freeing it */
+            sock->lastdata.netbuf = NULL;
+            buf->p = buf->ptr = NULL;
+            netbuf_delete(buf);
+        }
+    }
+
+    *p = q;
+    return q->tot_len;
+}
+
+void lwip_pbuf_free(struct pbuf *p)
+{
+    if (p != NULL) {
+        pbuf_free(p);
+    }
+}
+
+/* Number of datagrams sent by lwip_sendmmsg() in one call to the TCPIP task */
+#define LWIP_SENDMMSG_BATCH 16
+
+typedef struct {
+    struct tcpip_api_call_data call;
+    struct netconn *conn;
+    unsigned int count;
+    unsigned int sent;
+    struct {
+        struct pbuf *p;
+        bool has_addr;
+        ip_addr_t addr;
+        u16_t port;
+    } dgram[LWIP_SENDMMSG_BATCH];
+} sendmmsg_api_msg_t;
+
+static bool sockaddr_to_ipaddr_port(const struct sockaddr *name, socklen_t namelen, ip_addr_t *addr, u16_t *port)
+{
+#if LWIP_IPV4
+    if (name->sa_family == AF_INET && namelen >= sizeof(struct sockaddr_in)) {
+        const struct sockaddr_in *sin = (const struct sockaddr_in *)name;
+        inet_addr_to_ip4addr(ip_2_ip4(addr), &sin->sin_addr);
+        IP_SET_TYPE(addr, IPADDR_TYPE_V4);
+        *port = lwip_ntohs(sin->sin_port);
+        return true;
+    }
+#endif /* LWIP_IPV4 */
+#if LWIP_IPV6
+    if (name->sa_family == AF_INET6 && namelen >= sizeof(struct sockaddr_in6)) {
+        const struct sockaddr_in6 *sin6 = (const struct sockaddr_in6 *)name;
+        inet6_addr_to_ip6addr(ip_2_ip6(addr), &sin6->sin6_addr);
+        IP_SET_TYPE(addr, IPADDR_TYPE_V6);
+#if LWIP_IPV6_SCOPES
+        ip6_addr_set_zone(ip_2_ip6(addr), (u8_t)sin6->sin6_scope_id);
+#endif /* LWIP_IPV6_SCOPES */
+#if LWIP_IPV4
+        /* as lwip_sendto(), send IPv4-mapped IPv6 addresses as IPv4 */
+        if (ip6_addr_isipv4mappedipv6(ip_2_ip6(addr))) {
+            unmap_ipv4_mapped_ipv6(ip_2_ip4(addr), ip_2_ip6(addr));
+            IP_SET_TYPE(addr, IPADDR_TYPE_V4);
+        }
+#endif /* LWIP_IPV4 */
+        *port = lwip_ntohs(sin6->sin6_port);
+        return true;
+    }
+#endif /* LWIP_IPV6 */
+    return false;
+}
+
+/* Runs in the TCPIP task, sends the datagrams until the first error */
+static err_t sendmmsg_api(struct tcpip_api_call_data *call)
+{
+    sendmmsg_api_msg_t *msg = (sendmmsg_api_msg_t *)call;
+    struct udp_pcb *pcb = msg->conn->pcb.udp;
+    err_t err = ERR_OK;
+
+    if (pcb == NULL) {
+        return ERR_CONN;
+    }
+    for (msg->sent = 0; msg->sent < msg->count; msg->sent++) {
+        if (msg->dgram[msg->sent].has_addr) {
+            err = udp_sendto(pcb, msg->dgram[msg->sent].p, &msg->dgram[msg->sent].addr, msg->dgram[msg->sent].port);
+        } else {
+            err = udp_send(pcb, msg->dgram[msg->sent].p);
+        }
+        if (err != ERR_OK) {
+            break;
+        }
+    }
+    return err;
+}
+
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    struct lwip_sock *sock;
+    sendmmsg_api_msg_t *msg;
+    unsigned int done = 0;
+    err_t err = ERR_OK;
+
+    if (msgvec == NULL || (flags & ~(MSG_DONTWAIT | MSG_MORE)) != 0) {
+        set_errno(EINVAL);
+        return -1;
+    }
+    sock = lwip_socket_dbg_get_socket(s);
+    if (sock == NULL || sock->conn == NULL) {
+        set_errno(EBADF);
+        return -1;
+    }
+    if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) != NETCONN_UDP) {
+        set_errno(EOPNOTSUPP);
+        return -1;
+    }
+    msg = mem_malloc(sizeof(sendmmsg_api_msg_t));
+    if (msg == NULL) {
+        set_errno(ENOMEM);
+        return -1;
+    }
+    msg->conn = sock->conn;
+
+    while (done < vlen && err == ERR_OK) {
+        /* build the pbufs of a batch in the calling task, then send them all in one TCPIP task call */
+        for (msg->count = 0; msg->count < LWIP_SENDMMSG_BATCH && done + msg->count < vlen; msg->count++) {
+            const struct msghdr *hdr = &msgvec[done + msg->count].msg_hdr;
+            size_t len = 0;
+
+            if (hdr->msg_iovlen < 0 || (hdr->msg_iovlen > 0 && hdr->msg_iov == NULL)) {
+                err = ERR_VAL;
+                break;
+            }
+            for (int i = 0; i < hdr->msg_iovlen; i++) {
+                len += hdr->msg_iov[i].iov_len;
+            }
+            if (len > 0xFFFF) {
+                err = ERR_VAL;
+                break;
+            }
+            msg->dgram[msg->count].has_addr = hdr->msg_name != NULL;
+            if (hdr->msg_name != NULL &&
+                !sockaddr_to_ipaddr_port(hdr->msg_name, hdr->msg_namelen, &msg->dgram[msg->count].addr, &msg->dgram[msg->count].port)) {
+                err = ERR_VAL;
+                break;
+            }
+            struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, (u16_t)len, PBUF_RAM);
+            if (p == NULL) {
+                err = ERR_MEM;
+                break;
+            }
+            for (int i = 0, offset = 0; i < hdr->msg_iovlen; offset += hdr->msg_iov[i].iov_len, i++) {
+                pbuf_take_at(p, hdr->msg_iov[i].iov_base, (u16_t)hdr->msg_iov[i].iov_len, (u16_t)offset);
+            }
+            msg->dgram[msg->count].p = p;
+        }
+        msg->sent = 0;
+        if (msg->count > 0) {
+            err_t send_err = tcpip_api_call(sendmmsg_api, &msg->call);
+            if (err == ERR_OK) {
+                err = send_err;
+            }
+        }
+        for (unsigned int i = 0; i < msg->count; i++) {
+            if (i < msg->sent) {
+                msgvec[done + i].msg_len = msg->dgram[i].p->tot_len;
+            }
+            pbuf_free(msg->dgram[i].p);
+        }
+        done += msg->sent;
+    }
+    mem_free(msg);
+
+    /* like sendmmsg() on Linux, the error is only reported if no datagram has been sent */
+    if (done == 0 && err != ERR_OK) {
+        set_errno(err_to_errno(err));
+        return -1;
+    }
+    return (int)done;
+}
+
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+    unsigned int done = 0;
+    u32_t start = sys_now();
+    u32_t timeout_ms = 0;
+
+    if (msgvec == NULL) {
+        set_errno(EINVAL);
+        return -1;
+    }
+    if (timeout != NULL) {
+        timeout_ms = (u32_t)(timeout->tv_sec * 1000 + timeout->tv_nsec / 1000000);
+    }
+    for (; done < vlen; done++) {
+        int rcv_flags = flags & ~MSG_WAITFORONE;
+
+        if (done > 0 && (flags & MSG_WAITFORONE)) {
+            rcv_flags |= MSG_DONTWAIT;
+        }
+        ssize_t len = lwip_recvmsg(s, &msgvec[done].msg_hdr, rcv_flags);
+        if (len < 0) {
+            break;
+        }
+        msgvec[done].msg_len = (unsigned int)len;
+        /* like recvmmsg() on Linux, the timeout is only checked after each received datagram */
+        if (timeout != NULL && (u32_t)(sys_now() - start) >= timeout_ms) {
+            done++;
+            break;
+        }
+    }
+    /* errno is set by lwip_recvmsg(), the error is only reported if no datagram has been received */
+    return done > 0 ? (int)done : -1;
+}
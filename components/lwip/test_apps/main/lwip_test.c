@@ -1,10 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <esp_types.h>
 
 #include "freertos/FreeRTOS.h"
@@ -19,6 +20,7 @@
 #include "lwip/netdb.h"
 #include "lwip/sockets.h"
 #include "lwip/tcpip.h"
+#include "lwip/pbuf.h"
 #include "lwip/prot/iana.h"
 #include "ping/ping_sock.h"
 #include "dhcpserver/dhcpserver.h"
@@ -402,6 +404,97 @@ TEST(lwip, sntp_client_time_2048)
     test_sntp_timestamps(2048, false); // NTP timestamp MSB is cleared for time after 2036
 }
 
+TEST(lwip, udp_recv_pbuf_localhost)
+{
+    test_case_uses_tcpip();
+    const char *msg = "zero-copy datagram";
+    const size_t msg_len = strlen(msg);
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(5010),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, sock);
+    TEST_ASSERT_EQUAL(0, bind(sock, (struct sockaddr *)&addr, sizeof(addr)));
+
+    struct pbuf *p = NULL;
+    TEST_ASSERT_EQUAL(-1, lwip_recv_pbuf(sock, &p, MSG_DONTWAIT));
+    TEST_ASSERT_EQUAL(EWOULDBLOCK, errno);
+    TEST_ASSERT_NULL(p);
+
+    TEST_ASSERT_EQUAL(msg_len, sendto(sock, msg, msg_len, 0, (struct sockaddr *)&addr, sizeof(addr)));
+    // peek leaves the datagram in the socket, for recv_pbuf and for recv()
+    TEST_ASSERT_EQUAL(msg_len, lwip_recv_pbuf(sock, &p, MSG_PEEK));
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_EQUAL(0, pbuf_memcmp(p, 0, msg, msg_len));
+    lwip_pbuf_free(p);
+    char buf[32];
+    TEST_ASSERT_EQUAL(msg_len, recv(sock, buf, sizeof(buf), MSG_PEEK));
+    TEST_ASSERT_EQUAL(msg_len, lwip_recv_pbuf(sock, &p, 0));
+    TEST_ASSERT_EQUAL(0, pbuf_memcmp(p, 0, msg, msg_len));
+    lwip_pbuf_free(p);
+    // the datagram has been consumed
+    TEST_ASSERT_EQUAL(-1, recv(sock, buf, sizeof(buf), MSG_DONTWAIT));
+
+    TEST_ASSERT_EQUAL(-1, lwip_recv_pbuf(sock, &p, MSG_WAITALL));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    close(sock);
+}
+
+#define TEST_MMSG_COUNT 20 // more than one batch of lwip_sendmmsg()
+
+TEST(lwip, udp_sendmmsg_recvmmsg_localhost)
+{
+    test_case_uses_tcpip();
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(5011),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, sock);
+    TEST_ASSERT_EQUAL(0, bind(sock, (struct sockaddr *)&addr, sizeof(addr)));
+
+    uint32_t tx_data[TEST_MMSG_COUNT];
+    struct iovec tx_iov[TEST_MMSG_COUNT];
+    struct mmsghdr tx_msgs[TEST_MMSG_COUNT] = { 0 };
+    for (int i = 0; i < TEST_MMSG_COUNT; i++) {
+        tx_data[i] = 0x1000 + i;
+        tx_iov[i].iov_base = &tx_data[i];
+        tx_iov[i].iov_len = sizeof(tx_data[i]);
+        tx_msgs[i].msg_hdr.msg_name = &addr;
+        tx_msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+        tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+        tx_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    TEST_ASSERT_EQUAL(TEST_MMSG_COUNT, sendmmsg(sock, tx_msgs, TEST_MMSG_COUNT, 0));
+    for (int i = 0; i < TEST_MMSG_COUNT; i++) {
+        TEST_ASSERT_EQUAL(sizeof(uint32_t), tx_msgs[i].msg_len);
+    }
+
+    // the datagrams which don't fit in the socket mailbox are dropped, the others are received in order
+    uint32_t rx_data[TEST_MMSG_COUNT];
+    struct iovec rx_iov[TEST_MMSG_COUNT];
+    struct mmsghdr rx_msgs[TEST_MMSG_COUNT] = { 0 };
+    for (int i = 0; i < TEST_MMSG_COUNT; i++) {
+        rx_iov[i].iov_base = &rx_data[i];
+        rx_iov[i].iov_len = sizeof(rx_data[i]);
+        rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+        rx_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    // MSG_WAITFORONE returns once the socket is empty
+    int received = recvmmsg(sock, rx_msgs, TEST_MMSG_COUNT, MSG_WAITFORONE, NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, received);
+    for (int i = 0; i < received; i++) {
+        TEST_ASSERT_EQUAL(sizeof(uint32_t), rx_msgs[i].msg_len);
+        TEST_ASSERT_EQUAL_HEX32(tx_data[i], rx_data[i]);
+    }
+    TEST_ASSERT_EQUAL(-1, recvmmsg(sock, rx_msgs, 1, MSG_DONTWAIT, NULL));
+    TEST_ASSERT_EQUAL(EWOULDBLOCK, errno);
+    close(sock);
+}
+
 TEST_GROUP_RUNNER(lwip)
 {
     RUN_TEST_CASE(lwip, localhost_ping_test)
@@ -410,6 +503,8 @@ TEST_GROUP_RUNNER(lwip)
     RUN_TEST_CASE(lwip, dhcp_server_dns_options)
     RUN_TEST_CASE(lwip, sntp_client_time_2015)
     RUN_TEST_CASE(lwip, sntp_client_time_2048)
+    RUN_TEST_CASE(lwip, udp_recv_pbuf_localhost)
+    RUN_TEST_CASE(lwip, udp_sendmmsg_recvmmsg_localhost)
 }
 
 void app_main(void)
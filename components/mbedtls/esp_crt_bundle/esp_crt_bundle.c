@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -10,6 +10,7 @@
 #include "esp_check.h"
 #include "esp_crt_bundle.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
 
 #include "mbedtls/pk.h"
 #include "mbedtls/oid.h"
@@ -64,6 +65,23 @@ typedef const uint8_t* cert_t;
 
 static bundle_t s_crt_bundle;
 
+#if CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE > 0
+/* Parsed public keys of the roots used last, so that connecting to the same servers again does not
+ * parse the key again. An entry in use by a verification is not shared, another verification with
+ * the same root parses the key on its own. */
+typedef struct {
+    cert_t cert;                //<! certificate of the key, NULL if the entry is empty
+    mbedtls_pk_context pk;
+    uint32_t last_use;
+    bool in_use;
+    bool stale;                 //<! the bundle was changed while in use, free on release
+} key_cache_entry_t;
+
+static key_cache_entry_t s_key_cache[CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE];
+static uint32_t s_key_cache_clock;
+static portMUX_TYPE s_key_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
 // Read a 16-bit value stored in little-endian format from the given address
 static uint16_t get16_le(const uint8_t* ptr)
 {
@@ -122,21 +140,115 @@ static cert_t esp_crt_get_cert(const bundle_t bundle, const uint32_t index)
     return bundle + esp_crt_get_cert_offset(bundle, index);
 }
 
-static int esp_crt_check_signature(const mbedtls_x509_crt* child, const uint8_t* pub_key_buf, const size_t pub_key_len)
+#if CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE > 0
+static key_cache_entry_t *esp_crt_key_cache_get(const cert_t cert)
+{
+    key_cache_entry_t *found = NULL;
+    portENTER_CRITICAL(&s_key_cache_lock);
+    for (int i = 0; i < CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE; i++) {
+        if (s_key_cache[i].cert == cert && !s_key_cache[i].in_use && !s_key_cache[i].stale) {
+            found = &s_key_cache[i];
+            found->in_use = true;
+            found->last_use = ++s_key_cache_clock;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_key_cache_lock);
+    return found;
+}
+
+static void esp_crt_key_cache_release(key_cache_entry_t *entry)
+{
+    mbedtls_pk_context evicted;
+    mbedtls_pk_init(&evicted);
+    portENTER_CRITICAL(&s_key_cache_lock);
+    entry->in_use = false;
+    if (entry->stale) {
+        evicted = entry->pk;
+        mbedtls_pk_init(&entry->pk);
+        entry->cert = NULL;
+        entry->stale = false;
+    }
+    portEXIT_CRITICAL(&s_key_cache_lock);
+    mbedtls_pk_free(&evicted);
+}
+
+/* Takes over the parsed key, replacing the least recently used entry which is not in use */
+static void esp_crt_key_cache_put(const cert_t cert, mbedtls_pk_context *pk)
+{
+    key_cache_entry_t *victim = NULL;
+    mbedtls_pk_context evicted;
+    mbedtls_pk_init(&evicted);
+    portENTER_CRITICAL(&s_key_cache_lock);
+    for (int i = 0; i < CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE; i++) {
+        key_cache_entry_t *entry = &s_key_cache[i];
+        if (entry->in_use) {
+            continue;
+        }
+        if (entry->cert == NULL) {
+            victim = entry;
+            break;
+        }
+        if (victim == NULL || (int32_t)(entry->last_use - victim->last_use) < 0) {
+            victim = entry;
+        }
+    }
+    if (victim) {
+        evicted = victim->pk;
+        victim->cert = cert;
+        victim->pk = *pk;
+        victim->last_use = ++s_key_cache_clock;
+        mbedtls_pk_init(pk);
+    }
+    portEXIT_CRITICAL(&s_key_cache_lock);
+    mbedtls_pk_free(&evicted);
+    mbedtls_pk_free(pk);
+}
+
+static void esp_crt_key_cache_flush(void)
+{
+    for (int i = 0; i < CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE; i++) {
+        mbedtls_pk_context evicted;
+        mbedtls_pk_init(&evicted);
+        portENTER_CRITICAL(&s_key_cache_lock);
+        key_cache_entry_t *entry = &s_key_cache[i];
+        if (entry->cert != NULL) {
+            if (entry->in_use) {
+                entry->stale = true;
+            } else {
+                evicted = entry->pk;
+                mbedtls_pk_init(&entry->pk);
+                entry->cert = NULL;
+            }
+        }
+        portEXIT_CRITICAL(&s_key_cache_lock);
+        mbedtls_pk_free(&evicted);
+    }
+}
+#endif /* CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE > 0 */
+
+static int esp_crt_check_signature(const mbedtls_x509_crt* child, const cert_t cert)
 {
     int ret = 0;
-    mbedtls_pk_context pubkey;
+    mbedtls_pk_context parsed_key;
+    mbedtls_pk_context *pubkey = &parsed_key;
     const mbedtls_md_info_t *md_info;
 
-    mbedtls_pk_init(&pubkey);
+    mbedtls_pk_init(&parsed_key);
 
-    if (unlikely((ret = mbedtls_pk_parse_public_key(&pubkey, pub_key_buf, pub_key_len)) != 0)) {
+#if CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE > 0
+    key_cache_entry_t *cached = esp_crt_key_cache_get(cert);
+    if (cached) {
+        pubkey = &cached->pk;
+    } else
+#endif
+    if (unlikely((ret = mbedtls_pk_parse_public_key(&parsed_key, esp_crt_get_key(cert), esp_crt_get_key_len(cert))) != 0)) {
         ESP_LOGE(TAG, "PK parse failed with error 0x%x", -ret);
         goto cleanup;
     }
 
     // Fast check to avoid expensive computations when not necessary
-    if (unlikely(!mbedtls_pk_can_do(&pubkey, child->MBEDTLS_PRIVATE(sig_pk)))) {
+    if (unlikely(!mbedtls_pk_can_do(pubkey, child->MBEDTLS_PRIVATE(sig_pk)))) {
         ESP_LOGE(TAG, "Unsuitable public key");
         ret = MBEDTLS_ERR_PK_TYPE_MISMATCH;
         goto cleanup;
@@ -158,7 +270,7 @@ static int esp_crt_check_signature(const mbedtls_x509_crt* child, const uint8_t*
         goto cleanup;
     }
 
-    if (unlikely((ret = mbedtls_pk_verify_ext(child->MBEDTLS_PRIVATE(sig_pk), child->MBEDTLS_PRIVATE(sig_opts), &pubkey,
+    if (unlikely((ret = mbedtls_pk_verify_ext(child->MBEDTLS_PRIVATE(sig_pk), child->MBEDTLS_PRIVATE(sig_opts), pubkey,
                                               child->MBEDTLS_PRIVATE(sig_md), hash, md_size,
                                               child->MBEDTLS_PRIVATE(sig).p, child->MBEDTLS_PRIVATE(sig).len)) != 0)) {
         ESP_LOGE(TAG, "PK verify failed with error 0x%x", -ret);
@@ -166,7 +278,18 @@ static int esp_crt_check_signature(const mbedtls_x509_crt* child, const uint8_t*
     }
 
 cleanup:
-    mbedtls_pk_free(&pubkey);
+#if CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE > 0
+    if (cached) {
+        esp_crt_key_cache_release(cached);
+        return ret;
+    }
+    if (ret == 0) {
+        // only keep keys which verified a certificate
+        esp_crt_key_cache_put(cert, &parsed_key);
+        return ret;
+    }
+#endif
+    mbedtls_pk_free(&parsed_key);
     return ret;
 }
 
@@ -237,7 +360,7 @@ int esp_crt_verify_callback(void *buf, mbedtls_x509_crt* const crt, const int de
 
     if (likely(cert != NULL)) {
 
-        const int ret = esp_crt_check_signature(child, esp_crt_get_key(cert), esp_crt_get_key_len(cert));
+        const int ret = esp_crt_check_signature(child, cert);
 
         if (likely(ret == 0)) {
             ESP_LOGI(TAG, "Certificate validated");
@@ -324,6 +447,10 @@ static esp_err_t esp_crt_bundle_init(const uint8_t* const x509_bundle, const siz
 {
     if (likely(esp_crt_check_bundle(x509_bundle, bundle_size))) {
         s_crt_bundle = x509_bundle;
+#if CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE > 0
+        // the bundle may have been rewritten in place
+        esp_crt_key_cache_flush();
+#endif
         return ESP_OK;
     } else {
         return ESP_ERR_INVALID_ARG;
@@ -359,6 +486,9 @@ esp_err_t esp_crt_bundle_attach(void *conf)
 void esp_crt_bundle_detach(mbedtls_ssl_config *conf)
 {
     s_crt_bundle = NULL;
+#if CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE > 0
+    esp_crt_key_cache_flush();
+#endif
     if (conf) {
         mbedtls_ssl_conf_verify(conf, NULL, NULL);
     }
@@ -27,7 +27,9 @@
  */
 
 #include <string.h>
+#include <stdlib.h>
 #include "mbedtls/aes.h"
+#include "mbedtls/platform_util.h"
 #include "esp_log.h"
 #include "esp_crypto_lock.h"
 #include "hal/aes_hal.h"
@@ -52,6 +54,14 @@
 
 static const char *TAG = "esp-aes";
 
+/* Operations with less data are done block by block in the typical mode of the peripheral,
+   as setting up the DMA takes longer than transforming a few blocks */
+#ifdef CONFIG_MBEDTLS_AES_DMA_MIN_LEN
+#define AES_DMA_MIN_LEN CONFIG_MBEDTLS_AES_DMA_MIN_LEN
+#else
+#define AES_DMA_MIN_LEN 0
+#endif
+
 void esp_aes_acquire_hardware( void )
 {
     /* Released by esp_aes_release_hardware()*/
@@ -102,6 +112,60 @@ static int esp_aes_validate_input(esp_aes_context *ctx, const unsigned char *inp
 }
 
 
+/*
+ * Transform a single block in the typical (non-DMA) mode, the key has to be written to the hardware already
+ */
+static int esp_aes_block(esp_aes_context *ctx, const void *input, void *output)
+{
+    uint8_t input_copy[AES_BLOCK_BYTES];
+
+    /* If no key is written to hardware yet, either the user hasn't called
+       mbedtls_aes_setkey_enc/mbedtls_aes_setkey_dec - meaning we also don't
+       know which mode to use - or a fault skipped the
+       key write to hardware. Treat this as a fatal error and zero the output block.
+    */
+    if (ctx->key_in_hardware != ctx->key_bytes) {
+        mbedtls_platform_zeroize(output, AES_BLOCK_BYTES);
+        return MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH;
+    }
+    memcpy(input_copy, input, AES_BLOCK_BYTES);
+
+#ifdef CONFIG_MBEDTLS_AES_USE_PSEUDO_ROUND_FUNC
+    esp_aes_enable_pseudo_rounds(CONFIG_MBEDTLS_AES_USE_PSEUDO_ROUND_FUNC_STRENGTH);
+#endif /* CONFIG_MBEDTLS_AES_USE_PSEUDO_ROUND_FUNC */
+
+    aes_hal_transform_block(input, output);
+
+    /* Physical security check: Verify the AES accelerator actually ran, and wasn't
+       skipped due to external fault injection while starting the peripheral.
+
+       Note that the input is copied in case input==output.
+
+       Bypassing this check requires at least one additional fault.
+    */
+    if (memcmp(input_copy, output, AES_BLOCK_BYTES) == 0) {
+        // calling zeroing functions to narrow the
+        // window for a double-fault of the abort step, here
+        memset(output, 0, AES_BLOCK_BYTES);
+        mbedtls_platform_zeroize(output, AES_BLOCK_BYTES);
+        abort();
+    }
+
+    return 0;
+}
+
+/*
+ * Transform a single block in ECB mode, the key has to be written to the hardware already
+ */
+static int esp_aes_process_ecb_block(esp_aes_context *ctx, const unsigned char input[16], unsigned char output[16])
+{
+    if (AES_BLOCK_BYTES < AES_DMA_MIN_LEN) {
+        return esp_aes_block(ctx, input, output);
+    }
+    aes_hal_mode_init(ESP_AES_BLOCK_MODE_ECB);
+    return esp_aes_process_dma(ctx, input, output, AES_BLOCK_BYTES, NULL);
+}
+
 /*
  * AES-ECB single block encryption
  */
@@ -122,8 +186,7 @@ int esp_internal_aes_encrypt(esp_aes_context *ctx,
     esp_aes_acquire_hardware();
     ctx->key_in_hardware = 0;
     ctx->key_in_hardware = aes_hal_setkey(ctx->key, ctx->key_bytes, ESP_AES_ENCRYPT);
-    aes_hal_mode_init(ESP_AES_BLOCK_MODE_ECB);
-    r = esp_aes_process_dma(ctx, input, output, AES_BLOCK_BYTES, NULL);
+    r = esp_aes_process_ecb_block(ctx, input, output);
     esp_aes_release_hardware();
 
     return r;
@@ -156,8 +219,7 @@ int esp_internal_aes_decrypt(esp_aes_context *ctx,
     esp_aes_acquire_hardware();
     ctx->key_in_hardware = 0;
     ctx->key_in_hardware = aes_hal_setkey(ctx->key, ctx->key_bytes, ESP_AES_DECRYPT);
-    aes_hal_mode_init(ESP_AES_BLOCK_MODE_ECB);
-    r = esp_aes_process_dma(ctx, input, output, AES_BLOCK_BYTES, NULL);
+    r = esp_aes_process_ecb_block(ctx, input, output);
     esp_aes_release_hardware();
 
     return r;
@@ -192,8 +254,7 @@ int esp_aes_crypt_ecb(esp_aes_context *ctx,
     esp_aes_acquire_hardware();
     ctx->key_in_hardware = 0;
     ctx->key_in_hardware = aes_hal_setkey(ctx->key, ctx->key_bytes, mode);
-    aes_hal_mode_init(ESP_AES_BLOCK_MODE_ECB);
-    r = esp_aes_process_dma(ctx, input, output, AES_BLOCK_BYTES, NULL);
+    r = esp_aes_process_ecb_block(ctx, input, output);
     esp_aes_release_hardware();
 
     return r;
@@ -481,6 +542,45 @@ int esp_aes_crypt_ofb(esp_aes_context *ctx,
     return 0;
 }
 
+/*
+ * AES-CTR buffer encryption/decryption block by block in the typical mode
+ */
+static int esp_aes_crypt_ctr_block(esp_aes_context *ctx,
+                                   size_t length,
+                                   unsigned char nonce_counter[16],
+                                   unsigned char stream_block[16],
+                                   const unsigned char *input,
+                                   unsigned char *output)
+{
+    unsigned char *output_start = output;
+    size_t output_len = length;
+
+    while (length > 0) {
+        int r = esp_aes_block(ctx, nonce_counter, stream_block);
+        if (r != 0) {
+            mbedtls_platform_zeroize(output_start, output_len);
+            return r;
+        }
+
+        /* Same 32 bit increment as set by aes_hal_mode_init() for the DMA mode */
+        for (int i = AES_BLOCK_BYTES; i > AES_BLOCK_BYTES - 4; i--) {
+            if (++nonce_counter[i - 1] != 0) {
+                break;
+            }
+        }
+
+        size_t n = (length < AES_BLOCK_BYTES) ? length : AES_BLOCK_BYTES;
+        for (size_t i = 0; i < n; i++) {
+            output[i] = (unsigned char)(input[i] ^ stream_block[i]);
+        }
+        input += n;
+        output += n;
+        length -= n;
+    }
+
+    return 0;
+}
+
 /*
  * AES-CTR buffer encryption/decryption
  */
@@ -527,7 +627,21 @@ int esp_aes_crypt_ctr(esp_aes_context *ctx,
         length--;
     }
 
-    if (length > 0) {
+    if (length > 0 && length < AES_DMA_MIN_LEN) {
+
+        esp_aes_acquire_hardware();
+        ctx->key_in_hardware = 0;
+        /* The counter blocks are encrypted in the typical mode */
+        ctx->key_in_hardware = aes_hal_setkey(ctx->key, ctx->key_bytes, ESP_AES_ENCRYPT);
+
+        int r = esp_aes_crypt_ctr_block(ctx, length, nonce_counter, stream_block, input, output);
+
+        esp_aes_release_hardware();
+
+        if (r != 0) {
+            return r;
+        }
+    } else if (length > 0) {
 
         esp_aes_acquire_hardware();
         ctx->key_in_hardware = 0;
@@ -5,9 +5,15 @@
  */
 
 #include <string.h>
+#include <sys/param.h>
 #include "esp_mbedtls_dynamic_impl.h"
 #include "sdkconfig.h"
 
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE
+#include "freertos/FreeRTOS.h"
+#include "mbedtls/platform_util.h"
+#endif
+
 #if CONFIG_MBEDTLS_CERTIFICATE_BUNDLE
 #include "esp_crt_bundle.h"
 #endif
@@ -18,6 +24,21 @@
 
 #define TX_IDLE_BUFFER_SIZE (MBEDTLS_SSL_HEADER_LEN + CACHE_BUFFER_SIZE)
 
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE
+/**
+ * Record buffers of at least SSL_BUF_POOL_MIN_LEN bytes are taken from slabs of the maximum record buffer length,
+ * which are shared by all the SSL contexts. Up to CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE free slabs are kept
+ * instead of being freed, so that the heap is not fragmented by the buffers allocated and freed for each record.
+ * Smaller buffers, like the ones caching the counter and IV between the records, are still allocated from the heap.
+ */
+#define SSL_BUF_POOL_MIN_LEN (256)
+#define SSL_BUF_POOL_SLAB_LEN MAX(MBEDTLS_SSL_IN_BUFFER_LEN, MBEDTLS_SSL_OUT_BUFFER_LEN)
+
+static struct esp_mbedtls_ssl_buf *s_buf_pool[CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE];
+static size_t s_buf_pool_count;
+static portMUX_TYPE s_buf_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+#endif /* CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE */
+
 static const char *TAG = "Dynamic Impl";
 
 static void esp_mbedtls_set_buf_state(unsigned char *buf, esp_mbedtls_ssl_buf_states state)
@@ -32,10 +53,62 @@ static esp_mbedtls_ssl_buf_states esp_mbedtls_get_buf_state(unsigned char *buf)
     return temp->state;
 }
 
+/**
+ * Allocate a zeroed buffer of @p len bytes, from the buffer pool when enabled and large enough
+ */
+static struct esp_mbedtls_ssl_buf *esp_mbedtls_alloc_ssl_buf(size_t len)
+{
+    struct esp_mbedtls_ssl_buf *esp_buf = NULL;
+
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE
+    if (len >= SSL_BUF_POOL_MIN_LEN && len <= SSL_BUF_POOL_SLAB_LEN) {
+        portENTER_CRITICAL(&s_buf_pool_lock);
+        if (s_buf_pool_count) {
+            esp_buf = s_buf_pool[--s_buf_pool_count];
+        }
+        portEXIT_CRITICAL(&s_buf_pool_lock);
+
+        if (!esp_buf) {
+            esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + SSL_BUF_POOL_SLAB_LEN);
+        }
+        if (esp_buf) {
+            esp_buf->pooled = true;
+            return esp_buf;
+        }
+        /* no room for a whole slab, try with the requested length */
+    }
+#endif /* CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE */
+
+    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + len);
+
+    return esp_buf;
+}
+
 void esp_mbedtls_free_buf(unsigned char *buf)
 {
     struct esp_mbedtls_ssl_buf *temp = __containerof(buf, struct esp_mbedtls_ssl_buf, buf[0]);
     ESP_LOGV(TAG, "free buffer @ %p", temp);
+
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE
+    if (temp->pooled) {
+        bool kept = false;
+
+        /* the slab is going to be used by another SSL context, don't leave any record data in it */
+        mbedtls_platform_zeroize(temp, SSL_BUF_HEAD_OFFSET_SIZE + SSL_BUF_POOL_SLAB_LEN);
+
+        portENTER_CRITICAL(&s_buf_pool_lock);
+        if (s_buf_pool_count < CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE) {
+            s_buf_pool[s_buf_pool_count++] = temp;
+            kept = true;
+        }
+        portEXIT_CRITICAL(&s_buf_pool_lock);
+
+        if (kept) {
+            return;
+        }
+    }
+#endif /* CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE */
+
     mbedtls_free(temp);
 }
 
@@ -149,7 +222,7 @@ static int esp_mbedtls_alloc_tx_buf(mbedtls_ssl_context *ssl, int len)
         ssl->MBEDTLS_PRIVATE(out_buf) = NULL;
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + len);
+    esp_buf = esp_mbedtls_alloc_ssl_buf(len);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + len);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -210,7 +283,7 @@ int esp_mbedtls_reset_add_rx_buffer(mbedtls_ssl_context *ssl)
         ssl->MBEDTLS_PRIVATE(in_buf) = NULL;
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + MBEDTLS_SSL_IN_BUFFER_LEN);
+    esp_buf = esp_mbedtls_alloc_ssl_buf(MBEDTLS_SSL_IN_BUFFER_LEN);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + MBEDTLS_SSL_IN_BUFFER_LEN);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -261,7 +334,7 @@ int esp_mbedtls_add_tx_buffer(mbedtls_ssl_context *ssl, size_t buffer_len)
 
     buffer_len = tx_buffer_len(ssl, buffer_len);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
+    esp_buf = esp_mbedtls_alloc_ssl_buf(buffer_len);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%zu bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -306,7 +379,7 @@ int esp_mbedtls_free_tx_buffer(mbedtls_ssl_context *ssl)
     esp_mbedtls_free_buf(ssl->MBEDTLS_PRIVATE(out_buf));
     init_tx_buffer(ssl, NULL);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + TX_IDLE_BUFFER_SIZE);
+    esp_buf = esp_mbedtls_alloc_ssl_buf(TX_IDLE_BUFFER_SIZE);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + TX_IDLE_BUFFER_SIZE);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -374,7 +447,7 @@ int esp_mbedtls_add_rx_buffer(mbedtls_ssl_context *ssl)
         init_rx_buffer(ssl, NULL);
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
+    esp_buf = esp_mbedtls_alloc_ssl_buf(buffer_len);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -440,7 +513,7 @@ int esp_mbedtls_free_rx_buffer(mbedtls_ssl_context *ssl)
     esp_mbedtls_free_buf(ssl->MBEDTLS_PRIVATE(in_buf));
     init_rx_buffer(ssl, NULL);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + 16);
+    esp_buf = esp_mbedtls_alloc_ssl_buf(16);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + 16);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -55,6 +55,9 @@ typedef enum {
 struct esp_mbedtls_ssl_buf {
     esp_mbedtls_ssl_buf_states state;
     unsigned int len;
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SIZE
+    bool pooled;    /* slab of SSL_BUF_POOL_SLAB_LEN bytes, returned to the buffer pool when freed */
+#endif
     unsigned char buf[];
 };
 
@@ -32,6 +32,8 @@
 #endif /* MBEDTLS_PLATFORM_C */
 #endif /* MBEDTLS_SELF_TEST */
 
+#include <sys/param.h>
+
 #include "esp_sha_internal.h"
 #include "sha/sha_core.h"
 
@@ -162,15 +164,19 @@ int mbedtls_sha1_update(mbedtls_sha1_context *ctx, const unsigned char *input, s
 
     len = SHA_ALIGN_DOWN(ilen , 64);
 
-    if (len || local_len) {
+    /* Long inputs are hashed in slices, releasing the hardware in between,
+       so that the other hashing streams waiting for it are served in turn */
+    size_t offset = 0;
+    while (offset < len || local_len) {
+        size_t slice_len = MIN(len - offset, SHA_HW_MAX_HOLD_LEN);
 
         esp_sha_acquire_hardware();
 
         esp_internal_sha_update_state(ctx);
 
 #if SOC_SHA_SUPPORT_DMA
-        if (sha_operation_mode(len) == SHA_DMA_MODE) {
-            int ret = esp_sha_dma(SHA1, input, len, ctx->buffer, local_len, ctx->first_block);
+        if (sha_operation_mode(slice_len) == SHA_DMA_MODE) {
+            int ret = esp_sha_dma(SHA1, input + offset, slice_len, ctx->buffer, local_len, ctx->first_block);
             if (ret != 0) {
                 esp_sha_release_hardware();
                 return ret;
@@ -184,8 +190,8 @@ int mbedtls_sha1_update(mbedtls_sha1_context *ctx, const unsigned char *input, s
             }
 
             uint32_t length_processed = 0;
-            while (len - length_processed != 0) {
-                esp_internal_sha1_block_process(ctx, input + length_processed);
+            while (slice_len - length_processed != 0) {
+                esp_internal_sha1_block_process(ctx, input + offset + length_processed);
                 length_processed += 64;
             }
         }
@@ -194,6 +200,8 @@ int mbedtls_sha1_update(mbedtls_sha1_context *ctx, const unsigned char *input, s
 
         esp_sha_release_hardware();
 
+        offset += slice_len;
+        local_len = 0;
     }
 
     if (ilen > 0) {
@@ -38,6 +38,8 @@
 #endif /* MBEDTLS_PLATFORM_C */
 #endif /* MBEDTLS_SELF_TEST */
 
+#include <sys/param.h>
+
 #include "esp_sha_internal.h"
 #include "sha/sha_core.h"
 
@@ -216,7 +218,11 @@ int mbedtls_sha512_update(mbedtls_sha512_context *ctx, const unsigned char *inpu
 
     len = SHA_ALIGN_DOWN(ilen , 128);
 
-    if (len || local_len) {
+    /* Long inputs are hashed in slices, releasing the hardware in between,
+       so that the other hashing streams waiting for it are served in turn */
+    size_t offset = 0;
+    while (offset < len || local_len) {
+        size_t slice_len = MIN(len - offset, SHA_HW_MAX_HOLD_LEN);
 
         esp_sha_acquire_hardware();
 
@@ -228,8 +234,8 @@ int mbedtls_sha512_update(mbedtls_sha512_context *ctx, const unsigned char *inpu
         }
 
 #if SOC_SHA_SUPPORT_DMA
-        if (sha_operation_mode(len) == SHA_DMA_MODE) {
-            ret = esp_sha_dma(ctx->mode, input, len, ctx->buffer, local_len, ctx->first_block);
+        if (sha_operation_mode(slice_len) == SHA_DMA_MODE) {
+            ret = esp_sha_dma(ctx->mode, input + offset, slice_len, ctx->buffer, local_len, ctx->first_block);
             if (ret != 0) {
                 esp_sha_release_hardware();
                 return ret;
@@ -243,8 +249,8 @@ int mbedtls_sha512_update(mbedtls_sha512_context *ctx, const unsigned char *inpu
             }
 
             uint32_t length_processed = 0;
-            while (len - length_processed != 0) {
-                esp_internal_sha512_block_process(ctx, input + length_processed);
+            while (slice_len - length_processed != 0) {
+                esp_internal_sha512_block_process(ctx, input + offset + length_processed);
                 length_processed += 128;
             }
         }
@@ -252,6 +258,9 @@ int mbedtls_sha512_update(mbedtls_sha512_context *ctx, const unsigned char *inpu
         esp_sha_read_digest_state(ctx->mode, ctx->state);
 
         esp_sha_release_hardware();
+
+        offset += slice_len;
+        local_len = 0;
     }
 
     if (ilen > 0) {
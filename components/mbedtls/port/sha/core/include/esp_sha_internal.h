@@ -37,6 +37,20 @@ extern "C" {
 #endif
 #endif /* SOC_SHA_SUPPORT_DMA */
 
+/*
+ * Maximum length of input data hashed while holding the SHA peripheral in a single update call.
+ * Longer inputs are hashed in slices of this length, and the peripheral is released between the slices,
+ * so that a task hashing a large buffer does not hold the peripheral until it is done, while other tasks
+ * with their own SHA contexts wait for it. The waiting tasks then take turns at the slice boundaries.
+ *
+ * The value must be a multiple of the largest SHA block length (128 bytes).
+ */
+#if SOC_SHA_SUPPORT_DMA
+#define SHA_HW_MAX_HOLD_LEN (4 * SOC_SHA_DMA_MAX_BUFFER_SIZE)
+#else
+#define SHA_HW_MAX_HOLD_LEN 4096
+#endif /* SOC_SHA_SUPPORT_DMA */
+
 #define SHA_ALIGN_DOWN(num, align)  ((num) & ~((align) - 1))
 
 typedef enum {
@@ -531,6 +531,65 @@ TEST_CASE("mbedtls AES GCM performance, crypt-and-tag", "[aes-gcm]")
 #endif
 }
 
+TEST_CASE("mbedtls AES GCM performance, TLS record sizes", "[aes-gcm][timeout=60]")
+{
+    /* Encrypts back to back records the way the TLS record layer does:
+       12 bytes IV, 13 bytes of additional data (record header) and a 16 bytes tag per record */
+    const size_t record_sizes[] = { 32, 64, 128, 256, 1024, 4096, 16384 };
+    const size_t TOTAL_SZ = 256 * 1024;
+    mbedtls_gcm_context ctx;
+    unsigned char tag_buf[16] = {};
+    uint8_t iv[12];
+    uint8_t key[16];
+    uint8_t aad[13];
+
+    memset(iv, 0xEE, sizeof(iv));
+    memset(key, 0x44, sizeof(key));
+    memset(aad, 0x17, sizeof(aad));
+
+    // allocate internal memory
+    const size_t max_record_sz = record_sizes[sizeof(record_sizes) / sizeof(record_sizes[0]) - 1];
+    uint8_t *plaintext = heap_caps_malloc(max_record_sz, MALLOC_CAP_DMA | MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+    uint8_t *ciphertext = heap_caps_malloc(max_record_sz, MALLOC_CAP_DMA | MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+    uint8_t *decrypted = heap_caps_malloc(max_record_sz, MALLOC_CAP_DMA | MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(plaintext);
+    TEST_ASSERT_NOT_NULL(ciphertext);
+    TEST_ASSERT_NOT_NULL(decrypted);
+    for (size_t i = 0; i < max_record_sz; i++) {
+        plaintext[i] = i;
+    }
+
+    mbedtls_gcm_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, 128));
+
+    for (int s = 0; s < sizeof(record_sizes) / sizeof(record_sizes[0]); s++) {
+        const size_t record_sz = record_sizes[s];
+        const unsigned records = TOTAL_SZ / record_sz;
+
+        ccomp_timer_start();
+        for (int r = 0; r < records; r++) {
+            /* explicit part of the nonce changes per record */
+            iv[11] = r;
+            TEST_ASSERT_EQUAL(0, mbedtls_gcm_crypt_and_tag(&ctx, MBEDTLS_GCM_ENCRYPT, record_sz, iv, sizeof(iv),
+                                                           aad, sizeof(aad), plaintext, ciphertext, sizeof(tag_buf), tag_buf));
+        }
+        float elapsed_usec = ccomp_timer_stop();
+
+        /* Sanity check: the last record decrypts and authenticates */
+        TEST_ASSERT_EQUAL(0, mbedtls_gcm_auth_decrypt(&ctx, record_sz, iv, sizeof(iv), aad, sizeof(aad),
+                                                      tag_buf, sizeof(tag_buf), ciphertext, decrypted));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(plaintext, decrypted, record_sz);
+
+        // bytes/usec = MB/sec
+        printf("GCM encryption rate of %u bytes records %.3fMB/sec\n", (unsigned) record_sz, (record_sz * records) / elapsed_usec);
+    }
+
+    mbedtls_gcm_free(&ctx);
+    free(plaintext);
+    free(ciphertext);
+    free(decrypted);
+}
+
 TEST_CASE("mbedtls AES GCM - Combine different IV/Key/Plaintext/AAD lengths", "[aes-gcm]")
 {
     #define IV_BYTES_VALUE 0xA2
@@ -6,7 +6,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  *
- * SPDX-FileContributor: 2019-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2019-2025 Espressif Systems (Shanghai) CO LTD
  */
 #include <string.h>
 #include "esp_err.h"
@@ -28,6 +28,7 @@
 
 #include "esp_crt_bundle.h"
 #include "esp_random.h"
+#include "esp_timer.h"
 
 #include "unity.h"
 #include "test_utils.h"
@@ -441,6 +442,34 @@ TEST_CASE("custom certificate bundle - wrong signature", "[mbedtls]")
     esp_crt_bundle_detach(NULL);
 }
 
+#if CONFIG_MBEDTLS_CERTIFICATE_BUNDLE_KEY_CACHE_SIZE > 0
+TEST_CASE("custom certificate bundle - cached root key", "[mbedtls]")
+{
+    mbedtls_x509_crt crt;
+    uint32_t flags = 0;
+
+    esp_crt_bundle_attach(NULL);
+
+    mbedtls_x509_crt_init( &crt );
+    mbedtls_x509_crt_parse(&crt, correct_sig_crt_pem_start, correct_sig_crt_pem_end - correct_sig_crt_pem_start);
+    for (int i = 0; i < 3; i++) {
+        int64_t start = esp_timer_get_time();
+        TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_verify(&crt, NULL, NULL, NULL, &flags, esp_crt_verify_callback, NULL));
+        printf("Verification %d took %d us\n", i, (int)(esp_timer_get_time() - start));
+    }
+    mbedtls_x509_crt_free(&crt);
+
+    /* The signature is still checked with the cached key of the same root */
+    mbedtls_x509_crt_init( &crt );
+    mbedtls_x509_crt_parse(&crt, wrong_sig_crt_pem_start, wrong_sig_crt_pem_end - wrong_sig_crt_pem_start);
+    TEST_ASSERT_NOT_EQUAL(0, mbedtls_x509_crt_verify(&crt, NULL, NULL, NULL, &flags, esp_crt_verify_callback, NULL));
+    mbedtls_x509_crt_free(&crt);
+
+    /* Frees the cached keys */
+    esp_crt_bundle_detach(NULL);
+}
+#endif
+
 TEST_CASE("custom certificate bundle init API - bound checking - NULL certificate bundle", "[mbedtls]")
 {
     esp_err_t esp_ret;
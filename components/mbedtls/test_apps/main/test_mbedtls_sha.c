@@ -8,6 +8,7 @@
  * mbedTLS SHA unit tests
  */
 #include <string.h>
+#include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <esp_system.h>
@@ -159,6 +160,62 @@ TEST_CASE("mbedtls SHA multithreading", "[mbedtls]")
     vSemaphoreDelete(done_sem);
 }
 
+#define SHA_LONG_INPUT_LEN (40 * 1024 + 17)
+
+static void tskRunSHA256LongTest(void *pvParameters)
+{
+    const unsigned char *input = (const unsigned char *)pvParameters;
+    unsigned char expected[32];
+    unsigned char sha256[32];
+
+    /* Reference digest, updates of 100 bytes are never sliced */
+    mbedtls_sha256_context sha256_ctx;
+    mbedtls_sha256_init(&sha256_ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_starts(&sha256_ctx, false));
+    for (int j = 0; j < SHA_LONG_INPUT_LEN; j += 100) {
+        size_t chunk = (SHA_LONG_INPUT_LEN - j < 100) ? SHA_LONG_INPUT_LEN - j : 100;
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_update(&sha256_ctx, input + j, chunk));
+    }
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_finish(&sha256_ctx, expected));
+    mbedtls_sha256_free(&sha256_ctx);
+
+    for (int i = 0; i < 20; i++) {
+        mbedtls_sha256_init(&sha256_ctx);
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_starts(&sha256_ctx, false));
+        /* Unaligned start, so that the buffered block is hashed with the first slice */
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_update(&sha256_ctx, input, 5));
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_update(&sha256_ctx, input + 5, SHA_LONG_INPUT_LEN - 5));
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_finish(&sha256_ctx, sha256));
+        mbedtls_sha256_free(&sha256_ctx);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected, sha256, 32, "SHA256 calculation");
+    }
+    xSemaphoreGive(done_sem);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("mbedtls SHA multithreading, long updates", "[mbedtls]")
+{
+    unsigned char *input = malloc(SHA_LONG_INPUT_LEN);
+    TEST_ASSERT_NOT_NULL(input);
+    for (int i = 0; i < SHA_LONG_INPUT_LEN; i++) {
+        input[i] = (unsigned char)(i * 7 + 3);
+    }
+
+    done_sem = xSemaphoreCreateCounting(4, 0);
+    xTaskCreate(tskRunSHA256LongTest, "SHA256Long1", SHA_TASK_STACK_SIZE, input, 3, NULL);
+    xTaskCreate(tskRunSHA256LongTest, "SHA256Long2", SHA_TASK_STACK_SIZE, input, 3, NULL);
+    xTaskCreate(tskRunSHA1Test, "SHA1Task1", SHA_TASK_STACK_SIZE, NULL, 3, NULL);
+    xTaskCreate(tskRunSHA256Test, "SHA256Task1", SHA_TASK_STACK_SIZE, NULL, 3, NULL);
+
+    for (int i = 0; i < 4; i++) {
+        if (!xSemaphoreTake(done_sem, 20000 / portTICK_PERIOD_MS)) {
+            TEST_FAIL_MESSAGE("done_sem not released by test task");
+        }
+    }
+    vSemaphoreDelete(done_sem);
+    free(input);
+}
+
 void tskRunSHASelftests(void *param)
 {
     for (int i = 0; i < 5; i++) {
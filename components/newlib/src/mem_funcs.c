@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * memset, memcpy, memcmp and strlen, used instead of the ROM versions when CONFIG_LIBC_OPTIMIZED_MEM_FUNCS is
+ * enabled. They process 32-bit words, 16 bytes per iteration for the bulk of the buffers, and fall back to bytes
+ * for the short ones, where setting up the word loops costs more than it saves.
+ *
+ * Xtensa cores raise an exception on misaligned word accesses, and the RISC-V cores split them into several bus
+ * accesses, so misaligned sources are read as aligned words which are shifted and merged together.
+ * The word reads never cross the aligned word holding the last byte of the buffer, so they never touch
+ * another memory region.
+ *
+ * This file is built with -fno-builtin and -fno-tree-loop-distribute-patterns, otherwise the byte loops
+ * would be turned into calls to the functions they implement.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define WORD_SIZE       sizeof(word_t)
+#define WORD_MASK       (WORD_SIZE - 1)
+#define BLOCK_SIZE      (4 * WORD_SIZE)
+#define SMALL_SIZE      16                  /* buffers shorter than this are processed byte per byte */
+
+#define ONES            0x01010101u
+#define HIGHS           0x80808080u
+#define HAS_ZERO(w)     (((w) - ONES) & ~(w) & HIGHS)
+
+typedef uint32_t __attribute__((__may_alias__)) word_t;
+
+void *memset(void *dst, int c, size_t n)
+{
+    uint8_t *d = dst;
+
+    if (n >= SMALL_SIZE) {
+        const word_t w = (uint8_t)c * ONES;
+
+        while ((uintptr_t)d & WORD_MASK) {
+            *d++ = (uint8_t)c;
+            n--;
+        }
+        word_t *dw = (word_t *)d;
+        for (; n >= BLOCK_SIZE; n -= BLOCK_SIZE, dw += 4) {
+            dw[0] = w;
+            dw[1] = w;
+            dw[2] = w;
+            dw[3] = w;
+        }
+        for (; n >= WORD_SIZE; n -= WORD_SIZE) {
+            *dw++ = w;
+        }
+        d = (uint8_t *)dw;
+    }
+    while (n--) {
+        *d++ = (uint8_t)c;
+    }
+    return dst;
+}
+
+void *memcpy(void *restrict dst, const void *restrict src, size_t n)
+{
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+
+    if (n >= SMALL_SIZE) {
+        /* align the destination, the stores can't be merged like the loads */
+        while ((uintptr_t)d & WORD_MASK) {
+            *d++ = *s++;
+            n--;
+        }
+        word_t *dw = (word_t *)d;
+        const size_t offset = (uintptr_t)s & WORD_MASK;
+
+        if (offset == 0) {
+            const word_t *sw = (const word_t *)s;
+            for (; n >= BLOCK_SIZE; n -= BLOCK_SIZE, sw += 4, dw += 4) {
+                word_t w0 = sw[0], w1 = sw[1], w2 = sw[2], w3 = sw[3];
+                dw[0] = w0;
+                dw[1] = w1;
+                dw[2] = w2;
+                dw[3] = w3;
+            }
+            for (; n >= WORD_SIZE; n -= WORD_SIZE) {
+                *dw++ = *sw++;
+            }
+            s = (const uint8_t *)sw;
+        } else {
+            /* little endian: each word of the destination is made of the upper bytes of a word of the source
+               and the lower bytes of the next one */
+            const unsigned shift = offset * 8;
+            const word_t *sw = (const word_t *)(s - offset);
+            word_t prev = *sw++;
+            for (; n >= BLOCK_SIZE; n -= BLOCK_SIZE, sw += 4, dw += 4) {
+                word_t w0 = sw[0], w1 = sw[1], w2 = sw[2], w3 = sw[3];
+                dw[0] = (prev >> shift) | (w0 << (32 - shift));
+                dw[1] = (w0 >> shift) | (w1 << (32 - shift));
+                dw[2] = (w1 >> shift) | (w2 << (32 - shift));
+                dw[3] = (w2 >> shift) | (w3 << (32 - shift));
+                prev = w3;
+            }
+            for (; n >= WORD_SIZE; n -= WORD_SIZE) {
+                word_t w = *sw++;
+                *dw++ = (prev >> shift) | (w << (32 - shift));
+                prev = w;
+            }
+            /* the source bytes left start in the last word read */
+            s = (const uint8_t *)(sw - 1) + offset;
+        }
+        d = (uint8_t *)dw;
+    }
+    while (n--) {
+        *d++ = *s++;
+    }
+    return dst;
+}
+
+int memcmp(const void *s1, const void *s2, size_t n)
+{
+    const uint8_t *a = s1;
+    const uint8_t *b = s2;
+
+    /* the words are only compared when both buffers can be aligned, they only tell where the first difference is */
+    if (n >= SMALL_SIZE && (((uintptr_t)a ^ (uintptr_t)b) & WORD_MASK) == 0) {
+        while ((uintptr_t)a & WORD_MASK) {
+            if (*a != *b) {
+                return *a - *b;
+            }
+            a++;
+            b++;
+            n--;
+        }
+        const word_t *aw = (const word_t *)a;
+        const word_t *bw = (const word_t *)b;
+        for (; n >= BLOCK_SIZE; n -= BLOCK_SIZE, aw += 4, bw += 4) {
+            if (((aw[0] ^ bw[0]) | (aw[1] ^ bw[1]) | (aw[2] ^ bw[2]) | (aw[3] ^ bw[3])) != 0) {
+                break;
+            }
+        }
+        for (; n >= WORD_SIZE && *aw == *bw; n -= WORD_SIZE) {
+            aw++;
+            bw++;
+        }
+        a = (const uint8_t *)aw;
+        b = (const uint8_t *)bw;
+    }
+    for (; n > 0; n--, a++, b++) {
+        if (*a != *b) {
+            return *a - *b;
+        }
+    }
+    return 0;
+}
+
+size_t strlen(const char *str)
+{
+    const char *s = str;
+
+    while ((uintptr_t)s & WORD_MASK) {
+        if (*s == '\0') {
+            return s - str;
+        }
+        s++;
+    }
+    /* an aligned word never crosses into another memory region, it can be read past the terminator */
+    const word_t *sw = (const word_t *)s;
+    while (!HAS_ZERO(*sw)) {
+        sw++;
+    }
+    for (s = (const char *)sw; *s != '\0'; s++) {
+    }
+    return s - str;
+}
+
+/* No-op function, used to force linker to include these changes */
+void esp_libc_include_mem_funcs_impl(void)
+{
+}
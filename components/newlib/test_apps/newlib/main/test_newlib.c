@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -7,6 +7,7 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include <errno.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -172,6 +173,14 @@ TEST_CASE("check if ROM or Flash is used for functions", "[newlib]")
     TEST_ASSERT_FALSE(fn_in_rom(atoi));
     TEST_ASSERT_FALSE(fn_in_rom(strtol));
 #endif // CONFIG_LIBC_NEWLIB
+
+#if CONFIG_LIBC_OPTIMIZED_MEM_FUNCS
+    TEST_ASSERT_FALSE(fn_in_rom(memcpy));
+    TEST_ASSERT_FALSE(fn_in_rom(strlen));
+#elif !CONFIG_SPIRAM_CACHE_WORKAROUND
+    TEST_ASSERT(fn_in_rom(memcpy));
+    TEST_ASSERT(fn_in_rom(strlen));
+#endif // CONFIG_LIBC_OPTIMIZED_MEM_FUNCS
 }
 
 #ifndef CONFIG_NEWLIB_NANO_FORMAT
@@ -209,6 +218,48 @@ TEST_CASE("test 64bit int formats", "[newlib]")
 }
 #endif // CONFIG_NEWLIB_NANO_FORMAT
 
+TEST_CASE("memset, memcpy, memcmp and strlen work with all sizes and alignments", "[newlib]")
+{
+    static uint8_t src[160], dst[160 + 8];
+
+    for (size_t i = 0; i < sizeof(src); i++) {
+        src[i] = 1 + i % 251;
+    }
+    for (int src_offset = 0; src_offset < 4; src_offset++) {
+        for (int dst_offset = 0; dst_offset < 4; dst_offset++) {
+            for (size_t n = 0; n <= 128; n++) {
+                const uint8_t *s = src + src_offset;
+                uint8_t *d = dst + dst_offset;
+
+                memset(dst, 0xA5, sizeof(dst));
+                TEST_ASSERT_EQUAL_PTR(d, memcpy(d, s, n));
+                for (size_t i = 0; i < sizeof(dst); i++) {
+                    /* the bytes around the copy must be left untouched */
+                    uint8_t expected = (dst + i >= d && dst + i < d + n) ? s[dst + i - d] : 0xA5;
+                    TEST_ASSERT_EQUAL_HEX8(expected, dst[i]);
+                }
+
+                TEST_ASSERT_EQUAL(0, memcmp(d, s, n));
+                if (n > 0) {
+                    d[n - 1]++;
+                    TEST_ASSERT_GREATER_THAN(0, memcmp(d, s, n));
+                    TEST_ASSERT_LESS_THAN(0, memcmp(s, d, n));
+                }
+
+                TEST_ASSERT_EQUAL_PTR(d, memset(d, 0, n));
+                for (size_t i = 0; i < n; i++) {
+                    TEST_ASSERT_EQUAL_HEX8(0, d[i]);
+                }
+                TEST_ASSERT_EQUAL_HEX8(0xA5, d[n]);
+
+                memcpy(d, s, n);
+                d[n] = '\0';
+                TEST_ASSERT_EQUAL(n, strlen((const char *)d));
+            }
+        }
+    }
+}
+
 TEST_CASE("fmod and fmodf work as expected", "[newlib]")
 {
     TEST_ASSERT_EQUAL(0.1, fmod(10.1, 2.0));
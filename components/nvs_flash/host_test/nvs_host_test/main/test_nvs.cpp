@@ -3895,6 +3895,270 @@ TEST_CASE("nvs find key tests", "[nvs]")
     nvs_close(handle_2);
     TEST_ESP_OK(nvs_flash_deinit_partition(NVS_DEFAULT_PART_NAME));
 }
+TEST_CASE("nvs batch writes staged values together", "[nvs]")
+{
+    PartitionEmulationFixture f(0, 10);
+    const uint32_t NVS_FLASH_SECTOR = 6;
+    const uint32_t NVS_FLASH_SECTOR_COUNT_MIN = 3;
+    const int KEY_COUNT = 20;
+    char key[16];
+    int32_t value;
+    nvs_handle_t handle;
+
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(),
+                                                                      NVS_FLASH_SECTOR,
+                                                                      NVS_FLASH_SECTOR_COUNT_MIN));
+    TEST_ESP_OK(nvs_open("ns", NVS_READWRITE, &handle));
+    TEST_ESP_ERR(nvs_end_batch(handle), ESP_ERR_INVALID_STATE);
+
+    esp_partition_clear_stats();
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "single%d", i);
+        TEST_ESP_OK(nvs_set_i32(handle, key, i));
+    }
+    const size_t singleWriteOps = esp_partition_get_write_ops();
+
+    TEST_ESP_OK(nvs_begin_batch(handle));
+    TEST_ESP_ERR(nvs_begin_batch(handle), ESP_ERR_INVALID_STATE);
+    esp_partition_clear_stats();
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "batch%d", i);
+        TEST_ESP_OK(nvs_set_i32(handle, key, -1));
+        TEST_ESP_OK(nvs_set_i32(handle, key, i));
+    }
+    TEST_ESP_OK(nvs_set_str(handle, "batch_str", "staged string"));
+    TEST_ESP_ERR(nvs_set_blob(handle, "blob", "x", 1), ESP_ERR_NOT_SUPPORTED);
+    TEST_ESP_ERR(nvs_erase_key(handle, "single0"), ESP_ERR_NOT_SUPPORTED);
+    TEST_ESP_ERR(nvs_erase_all(handle), ESP_ERR_NOT_SUPPORTED);
+
+    // nothing is written before the batch ends
+    CHECK(esp_partition_get_write_ops() == 0);
+    TEST_ESP_ERR(nvs_get_i32(handle, "batch0", &value), ESP_ERR_NVS_NOT_FOUND);
+
+    TEST_ESP_OK(nvs_end_batch(handle));
+    CHECK(esp_partition_get_write_ops() < singleWriteOps);
+    s_perf << "Write ops for " << KEY_COUNT << " items: " << singleWriteOps << " one by one, "
+           << esp_partition_get_write_ops() << " in a batch (with one string)" << std::endl;
+
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "batch%d", i);
+        TEST_ESP_OK(nvs_get_i32(handle, key, &value));
+        CHECK(value == i);
+    }
+    char str[32];
+    size_t str_len = sizeof(str);
+    TEST_ESP_OK(nvs_get_str(handle, "batch_str", str, &str_len));
+    CHECK(strcmp(str, "staged string") == 0);
+
+    // updating existing keys leaves a single copy of each of them
+    TEST_ESP_OK(nvs_begin_batch(handle));
+    TEST_ESP_OK(nvs_set_i32(handle, "batch0", 100));
+    TEST_ESP_OK(nvs_set_i32(handle, "batch1", 1));
+    TEST_ESP_OK(nvs_set_u8(handle, "single0", 7));
+    TEST_ESP_OK(nvs_end_batch(handle));
+    TEST_ESP_OK(nvs_get_i32(handle, "batch0", &value));
+    CHECK(value == 100);
+    TEST_ESP_OK(nvs_get_i32(handle, "batch1", &value));
+    CHECK(value == 1);
+    uint8_t value_u8;
+    TEST_ESP_OK(nvs_get_u8(handle, "single0", &value_u8));
+    CHECK(value_u8 == 7);
+    TEST_ESP_ERR(nvs_get_i32(handle, "single0", &value), ESP_ERR_NVS_TYPE_MISMATCH);
+    size_t used_entries;
+    TEST_ESP_OK(nvs_get_used_entry_count(handle, &used_entries));
+    CHECK(used_entries == 2 * KEY_COUNT + 2);
+
+    // a batch which does not fit into one page is rejected as a whole
+    TEST_ESP_OK(nvs_begin_batch(handle));
+    for (size_t i = 0; i < nvs::Page::ENTRY_COUNT + 1; ++i) {
+        snprintf(key, sizeof(key), "big%d", static_cast<int>(i));
+        TEST_ESP_OK(nvs_set_i32(handle, key, i));
+    }
+    TEST_ESP_ERR(nvs_end_batch(handle), ESP_ERR_NVS_NOT_ENOUGH_SPACE);
+    TEST_ESP_ERR(nvs_get_i32(handle, "big0", &value), ESP_ERR_NVS_NOT_FOUND);
+
+    // closing the handle discards an open batch
+    TEST_ESP_OK(nvs_begin_batch(handle));
+    TEST_ESP_OK(nvs_set_i32(handle, "discarded", 1));
+    nvs_close(handle);
+    TEST_ESP_OK(nvs_open("ns", NVS_READONLY, &handle));
+    TEST_ESP_ERR(nvs_get_i32(handle, "discarded", &value), ESP_ERR_NVS_NOT_FOUND);
+    TEST_ESP_ERR(nvs_begin_batch(handle), ESP_ERR_NVS_READ_ONLY);
+    nvs_close(handle);
+
+    TEST_ESP_OK(nvs_flash_deinit_partition(NVS_DEFAULT_PART_NAME));
+}
+
+TEST_CASE("nvs batch is written completely or not at all on power loss", "[nvs]")
+{
+    const uint32_t NVS_FLASH_SECTOR = 0;
+    const uint32_t NVS_FLASH_SECTOR_COUNT_MIN = 3;
+    const int KEY_COUNT = 8;
+    const char str[] = "a string spanning a few entries 0123456789abcdef";
+    char key[16];
+
+    for (size_t errDelay = 0; ; ++errDelay) {
+        INFO(errDelay);
+        PartitionEmulationFixture f(0, NVS_FLASH_SECTOR_COUNT_MIN);
+        uint8_t nsIndex;
+        {
+            nvs::Storage storage(f.part());
+            TEST_ESP_OK(storage.init(NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT_MIN));
+            TEST_ESP_OK(storage.createOrOpenNamespace("ns", true, nsIndex));
+            TEST_ESP_OK(storage.writeItem(nsIndex, "key0", static_cast<int32_t>(-1)));
+        }
+
+        esp_partition_fail_after(errDelay, ESP_PARTITION_FAIL_AFTER_MODE_BOTH);
+        esp_err_t err;
+        {
+            nvs::Storage storage(f.part());
+            err = storage.init(NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT_MIN);
+            if (err == ESP_OK) {
+                nvs::Storage::TBatchList batch;
+                for (int i = 0; i < KEY_COUNT; ++i) {
+                    nvs::Storage::BatchItem* item = new (std::nothrow) nvs::Storage::BatchItem;
+                    REQUIRE(item != nullptr);
+                    snprintf(item->key, sizeof(item->key), "key%d", i);
+                    item->datatype = (i == KEY_COUNT - 1) ? nvs::ItemType::SZ : nvs::ItemType::I32;
+                    item->dataSize = (i == KEY_COUNT - 1) ? sizeof(str) : sizeof(int32_t);
+                    item->data = new (std::nothrow) uint8_t[item->dataSize];
+                    REQUIRE(item->data != nullptr);
+                    if (i == KEY_COUNT - 1) {
+                        memcpy(item->data, str, sizeof(str));
+                    } else {
+                        memcpy(item->data, &i, sizeof(i));
+                    }
+                    batch.push_back(item);
+                }
+                err = storage.writeItemBatch(nsIndex, batch);
+                batch.clearAndFreeNodes();
+            }
+        }
+        esp_partition_fail_after(SIZE_MAX, ESP_PARTITION_FAIL_AFTER_MODE_BOTH);
+
+        nvs::Storage storage(f.part());
+        TEST_ESP_OK(storage.init(NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT_MIN));
+        int32_t value;
+        TEST_ESP_OK(storage.readItem(nsIndex, "key0", value));
+        const bool written = (value == 0);
+        if (!written) {
+            CHECK(value == -1);
+        }
+        for (int i = 1; i < KEY_COUNT - 1; ++i) {
+            snprintf(key, sizeof(key), "key%d", i);
+            if (written) {
+                TEST_ESP_OK(storage.readItem(nsIndex, key, value));
+                CHECK(value == i);
+            } else {
+                TEST_ESP_ERR(storage.readItem(nsIndex, key, value), ESP_ERR_NVS_NOT_FOUND);
+            }
+        }
+        char out[sizeof(str)];
+        if (written) {
+            TEST_ESP_OK(storage.readItem(nsIndex, nvs::ItemType::SZ, "key7", out, sizeof(out)));
+            CHECK(strcmp(out, str) == 0);
+        } else {
+            TEST_ESP_ERR(storage.readItem(nsIndex, nvs::ItemType::SZ, "key7", out, sizeof(out)), ESP_ERR_NVS_NOT_FOUND);
+        }
+
+        if (err == ESP_OK) {
+            // the failure was not triggered any more
+            break;
+        }
+    }
+}
+
+TEST_CASE("nvs blob can be read and written in parts", "[nvs]")
+{
+    PartitionEmulationFixture f(0, 10);
+    const uint32_t NVS_FLASH_SECTOR = 0;
+    const uint32_t NVS_FLASH_SECTOR_COUNT_MIN = 10;
+    const size_t BLOB_SIZE = 20000;
+    const size_t PART_SIZE = 1000;
+    nvs_handle_t handle;
+    nvs_blob_handle_t blob;
+
+    uint8_t* data = new (std::nothrow) uint8_t[BLOB_SIZE];
+    uint8_t* out = new (std::nothrow) uint8_t[BLOB_SIZE];
+    REQUIRE(data != nullptr);
+    REQUIRE(out != nullptr);
+    for (size_t i = 0; i < BLOB_SIZE; ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+    }
+
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(),
+                                                                      NVS_FLASH_SECTOR,
+                                                                      NVS_FLASH_SECTOR_COUNT_MIN));
+    TEST_ESP_OK(nvs_open("ns", NVS_READWRITE, &handle));
+    TEST_ESP_ERR(nvs_blob_open(handle, "a_too_long_blob_key", &blob), ESP_ERR_NVS_KEY_TOO_LONG);
+
+    TEST_ESP_OK(nvs_blob_open(handle, "blob", &blob));
+    TEST_ESP_ERR(nvs_blob_read_at(blob, 0, out, 1), ESP_ERR_NVS_NOT_FOUND);
+    for (size_t offset = 0; offset < BLOB_SIZE; offset += PART_SIZE) {
+        TEST_ESP_OK(nvs_blob_write_chunk(blob, data + offset, PART_SIZE));
+    }
+    // the blob gets its value when it is closed
+    size_t size = BLOB_SIZE;
+    TEST_ESP_ERR(nvs_get_blob(handle, "blob", out, &size), ESP_ERR_NVS_NOT_FOUND);
+    TEST_ESP_OK(nvs_blob_close(blob));
+
+    TEST_ESP_OK(nvs_get_blob(handle, "blob", out, &size));
+    CHECK(size == BLOB_SIZE);
+    CHECK(memcmp(out, data, BLOB_SIZE) == 0);
+
+    // parts spanning several chunks and pages
+    TEST_ESP_OK(nvs_blob_open(handle, "blob", &blob));
+    for (size_t offset = 0; offset < BLOB_SIZE; offset += 3333) {
+        const size_t len = std::min(static_cast<size_t>(5000), BLOB_SIZE - offset);
+        memset(out, 0, len);
+        TEST_ESP_OK(nvs_blob_read_at(blob, offset, out, len));
+        CHECK(memcmp(out, data + offset, len) == 0);
+    }
+    TEST_ESP_ERR(nvs_blob_read_at(blob, BLOB_SIZE - 1, out, 2), ESP_ERR_NVS_INVALID_LENGTH);
+
+    // discarding the new value keeps the previous one
+    size_t used_entries;
+    TEST_ESP_OK(nvs_get_used_entry_count(handle, &used_entries));
+    TEST_ESP_OK(nvs_blob_write_chunk(blob, data, BLOB_SIZE / 2));
+    nvs_blob_abort(blob);
+    size_t used_entries_after_abort;
+    TEST_ESP_OK(nvs_get_used_entry_count(handle, &used_entries_after_abort));
+    CHECK(used_entries_after_abort == used_entries);
+    TEST_ESP_OK(nvs_get_blob(handle, "blob", out, &size));
+    CHECK(size == BLOB_SIZE);
+
+    // a new value written in parts replaces the previous one, and can be replaced by nvs_set_blob
+    TEST_ESP_OK(nvs_blob_open(handle, "blob", &blob));
+    TEST_ESP_OK(nvs_blob_write_chunk(blob, data + 1, BLOB_SIZE / 4));
+    TEST_ESP_OK(nvs_blob_write_chunk(blob, data + 1 + BLOB_SIZE / 4, BLOB_SIZE / 4));
+    TEST_ESP_OK(nvs_blob_close(blob));
+    size = BLOB_SIZE;
+    TEST_ESP_OK(nvs_get_blob(handle, "blob", out, &size));
+    CHECK(size == BLOB_SIZE / 2);
+    CHECK(memcmp(out, data + 1, BLOB_SIZE / 2) == 0);
+    TEST_ESP_OK(nvs_set_blob(handle, "blob", data, 100));
+    TEST_ESP_OK(nvs_blob_open(handle, "blob", &blob));
+    TEST_ESP_OK(nvs_blob_read_at(blob, 50, out, 50));
+    CHECK(memcmp(out, data + 50, 50) == 0);
+    TEST_ESP_OK(nvs_blob_close(blob));
+
+    // the handle has to stay open
+    TEST_ESP_OK(nvs_blob_open(handle, "blob", &blob));
+    nvs_close(handle);
+    TEST_ESP_ERR(nvs_blob_read_at(blob, 0, out, 1), ESP_ERR_NVS_INVALID_HANDLE);
+    TEST_ESP_ERR(nvs_blob_close(blob), ESP_ERR_NVS_INVALID_HANDLE);
+
+    TEST_ESP_OK(nvs_open("ns", NVS_READONLY, &handle));
+    TEST_ESP_OK(nvs_blob_open(handle, "blob", &blob));
+    TEST_ESP_ERR(nvs_blob_write_chunk(blob, data, 1), ESP_ERR_NVS_READ_ONLY);
+    TEST_ESP_ERR(nvs_blob_close(blob), ESP_ERR_INVALID_STATE);
+    nvs_close(handle);
+
+    delete [] data;
+    delete [] out;
+    TEST_ESP_OK(nvs_flash_deinit_partition(NVS_DEFAULT_PART_NAME));
+}
+
 /* Add new tests above */
 /* This test has to be the final one */
 
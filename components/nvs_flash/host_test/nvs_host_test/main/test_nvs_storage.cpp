@@ -43,3 +43,57 @@ TEST_CASE("Storage iterator recognizes blob with VerOffset::VER_1_OFFSET", "[nvs
 
     REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition("test") == ESP_OK);
 }
+
+TEST_CASE("Storage finds items after they were moved to other pages", "[nvs_storage]")
+{
+    const uint32_t NVS_FLASH_SECTOR = 0;
+    const uint32_t NVS_FLASH_SECTOR_COUNT = 8;
+    const size_t KEY_COUNT = 300;
+    PartitionEmulationFixture f(NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT, "test");
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT)
+            == ESP_OK);
+    nvs::Storage *storage = nvs::NVSPartitionManager::get_instance()->lookup_storage_from_name("test");
+    uint8_t ns_index;
+    REQUIRE(storage->createOrOpenNamespace("test_ns", true, ns_index) == ESP_OK);
+
+    char key[16];
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "key_%u", (unsigned) i);
+        REQUIRE(storage->writeItem(ns_index, key, static_cast<uint32_t>(i)) == ESP_OK);
+    }
+
+    // updating the values fills up the pages and makes the garbage collection move the items around
+    for (uint32_t round = 1; round <= 3; ++round) {
+        for (size_t i = 0; i < KEY_COUNT; ++i) {
+            snprintf(key, sizeof(key), "key_%u", (unsigned) i);
+            uint32_t value = 0;
+            REQUIRE(storage->readItem(ns_index, key, value) == ESP_OK);
+            CHECK(value == i + (round - 1) * KEY_COUNT);
+            REQUIRE(storage->writeItem(ns_index, key, static_cast<uint32_t>(i + round * KEY_COUNT)) == ESP_OK);
+        }
+    }
+
+    for (size_t i = 0; i < KEY_COUNT; i += 2) {
+        snprintf(key, sizeof(key), "key_%u", (unsigned) i);
+        REQUIRE(storage->eraseItem(ns_index, key) == ESP_OK);
+    }
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition("test") == ESP_OK);
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT)
+            == ESP_OK);
+    storage = nvs::NVSPartitionManager::get_instance()->lookup_storage_from_name("test");
+    REQUIRE(storage->createOrOpenNamespace("test_ns", false, ns_index) == ESP_OK);
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "key_%u", (unsigned) i);
+        uint32_t value = 0;
+        if (i % 2 == 0) {
+            CHECK(storage->readItem(ns_index, key, value) == ESP_ERR_NVS_NOT_FOUND);
+        } else {
+            CHECK(storage->readItem(ns_index, key, value) == ESP_OK);
+            CHECK(value == i + 3 * KEY_COUNT);
+        }
+    }
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition("test") == ESP_OK);
+}
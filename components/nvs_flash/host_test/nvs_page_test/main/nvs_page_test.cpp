@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -919,6 +919,70 @@ void test_Page_calcEntries__invalid()
     TEST_ASSERT_EQUAL(0, nvsStats.namespace_count);
 }
 
+void test_Page_load__reads_entries_in_blocks()
+{
+    NVSPageFixture fix;
+    const size_t ITEM_COUNT = 100;
+
+    for (size_t i = 0; i < ITEM_COUNT; ++i) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%u", (unsigned) i);
+        TEST_ASSERT_EQUAL(ESP_OK, fix.page.writeItem<uint32_t>(1, key, i));
+    }
+
+    esp_partition_clear_stats();
+    Page page;
+    TEST_ASSERT_EQUAL(ESP_OK, page.load(&fix.part, 0));
+    TEST_ASSERT_EQUAL(Page::PageState::ACTIVE, page.state());
+    TEST_ASSERT_EQUAL(ITEM_COUNT, page.getUsedEntryCount());
+    TEST_ASSERT_LESS_THAN(ITEM_COUNT / 4, esp_partition_get_read_ops());
+
+    // the page never contained a namespace entry, so looking for one must not read the flash
+    esp_partition_clear_stats();
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, page.findItem(Page::NS_INDEX, nvs::ItemType::U8, nullptr));
+    TEST_ASSERT_EQUAL(0, esp_partition_get_read_ops());
+
+    uint32_t value;
+    TEST_ASSERT_EQUAL(ESP_OK, page.readItem<uint32_t>(1, "key42", value));
+    TEST_ASSERT_EQUAL(42, value);
+}
+
+void test_Page_findItem__read_ahead()
+{
+    NVSPageFixture fix;
+    const size_t ITEM_COUNT = 64;
+
+    for (size_t i = 0; i < ITEM_COUNT; ++i) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%u", (unsigned) i);
+        TEST_ASSERT_EQUAL(ESP_OK, fix.page.writeItem<uint32_t>(1 + i % 2, key, i));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, fix.page.eraseItem<uint32_t>(1, "key10"));
+
+    // the page never contained namespace 3, so iterating over it must not read the flash
+    esp_partition_clear_stats();
+    size_t itemIndex = 0;
+    Item item;
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, fix.page.findItem(3, nvs::ItemType::ANY, nullptr, itemIndex, item));
+    TEST_ASSERT_EQUAL(0, esp_partition_get_read_ops());
+
+    Page::ReadAhead readAhead = {};
+    size_t found = 0;
+    esp_partition_clear_stats();
+    while (fix.page.findItem(1, nvs::ItemType::ANY, nullptr, itemIndex, item,
+                             Page::CHUNK_ANY, VerOffset::VER_ANY, &readAhead) == ESP_OK) {
+        uint32_t value;
+        item.getValue(value);
+        TEST_ASSERT_EQUAL(1, item.nsIndex);
+        TEST_ASSERT_EQUAL(0, value % 2);
+        TEST_ASSERT_NOT_EQUAL(10, value);
+        itemIndex += item.span;
+        ++found;
+    }
+    TEST_ASSERT_EQUAL(ITEM_COUNT / 2 - 1, found);
+    TEST_ASSERT_LESS_THAN(ITEM_COUNT / 4, esp_partition_get_read_ops());
+}
+
 int main(int argc, char **argv)
 {
 #define TEMPORARILY_DISABLED(x)
@@ -978,6 +1042,8 @@ int main(int argc, char **argv)
     RUN_TEST(test_Page_calcEntries__active_wo_blob);
     RUN_TEST(test_Page_calcEntries__active_with_blob);
     RUN_TEST(test_Page_calcEntries__invalid);
+    RUN_TEST(test_Page_load__reads_entries_in_blocks);
+    RUN_TEST(test_Page_findItem__read_ahead);
     int failures = UNITY_END();
     return failures;
 }
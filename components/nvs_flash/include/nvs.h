@@ -127,6 +127,11 @@ typedef struct {
  */
 typedef struct nvs_opaque_iterator_t *nvs_iterator_t;
 
+/**
+ * Opaque pointer type representing a blob which is read or written in parts
+ */
+typedef struct nvs_opaque_blob_t *nvs_blob_handle_t;
+
 /**
  * @brief      Open non-volatile storage with a given namespace from the default NVS partition
  *
@@ -576,6 +581,167 @@ esp_err_t nvs_erase_all(nvs_handle_t handle);
  */
 esp_err_t nvs_commit(nvs_handle_t handle);
 
+/**
+ * @brief      Start a batch of writes
+ *
+ * Until nvs_end_batch() is called, the nvs_set_* functions (except nvs_set_blob) only stage the
+ * new values in RAM. Reading a key through any handle returns the value it had before the batch.
+ * nvs_end_batch() then writes all staged values together to one NVS page, which takes fewer flash
+ * writes than setting them one by one.
+ *
+ * nvs_set_blob, nvs_erase_key and nvs_erase_all return ESP_ERR_NOT_SUPPORTED while a batch is open.
+ * Closing the handle discards the staged values.
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *                     Handles that were opened read only cannot be used.
+ *
+ * @return
+ *             - ESP_OK if the batch was started
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_READ_ONLY if handle was opened as read only
+ *             - ESP_ERR_INVALID_STATE if a batch is already open on this handle
+ */
+esp_err_t nvs_begin_batch(nvs_handle_t handle);
+
+/**
+ * @brief      Write the values staged since nvs_begin_batch() and end the batch
+ *
+ * Either all or none of the staged values are written. The new values are marked valid with a
+ * single flash write, so other tasks never see a part of them, and neither does the application
+ * after a power loss during the write. If power is lost afterwards, while the superseded values
+ * are being erased, some keys may read their previous value after the restart, as it is the case
+ * when setting values one by one.
+ *
+ * The staged values must fit into one NVS page (126 entries, one per integer value and one plus
+ * one per 32 bytes for each string).
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *
+ * @return
+ *             - ESP_OK if all values have been written
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_INVALID_STATE if no batch is open on this handle
+ *             - ESP_ERR_NVS_NOT_ENOUGH_SPACE if the values do not fit into one page or there is not
+ *               enough space left in the partition
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_end_batch(nvs_handle_t handle);
+
+/**
+ * @brief      Open a blob to read or write it in parts
+ *
+ * nvs_blob_read_at and nvs_blob_write_chunk work on single chunks of a blob, so large blobs can be
+ * accessed without a buffer holding the whole value:
+ *
+ * \code{c}
+ * // Example (without error checking) of writing a certificate bundle received in parts:
+ * nvs_blob_handle_t blob;
+ * nvs_blob_open(my_handle, "ca_bundle", &blob);
+ * while ((len = receive(buf, sizeof(buf))) > 0) {
+ *     nvs_blob_write_chunk(blob, buf, len);
+ * }
+ * nvs_blob_close(blob);
+ * \endcode
+ *
+ * The blob does not need to exist. Opening it does not access the flash. The handle has to stay
+ * open while the blob is in use, and the blob must not be set or erased by other means until it is
+ * closed.
+ *
+ * @param[in]  handle    Handle obtained from nvs_open function.
+ * @param[in]  key       Key name. Maximum length is (NVS_KEY_NAME_MAX_SIZE-1) characters. Shouldn't be empty.
+ * @param[out] out_blob  Set to the blob handle, which has to be released with
+ *                       nvs_blob_close or nvs_blob_abort.
+ *
+ * @return
+ *             - ESP_OK if the blob was opened
+ *             - ESP_ERR_INVALID_ARG if key or out_blob is NULL
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_KEY_TOO_LONG if the key name is too long
+ *             - ESP_ERR_NO_MEM if memory for the blob handle could not be allocated
+ */
+esp_err_t nvs_blob_open(nvs_handle_t handle, const char *key, nvs_blob_handle_t *out_blob);
+
+/**
+ * @brief      Read a part of the current value of a blob
+ *
+ * Only the chunks of the blob which contain the requested part are read. Each of them is still read
+ * in full to verify its checksum, the required RAM does not depend on the chunk size though.
+ * Values written with nvs_blob_write_chunk are not visible before nvs_blob_close.
+ *
+ * @param[in]  blob       Blob handle obtained from nvs_blob_open.
+ * @param[in]  offset     Offset in the blob of the first byte to read.
+ * @param[out] out_value  Buffer for the read data.
+ * @param[in]  length     Number of bytes to read.
+ *
+ * @return
+ *             - ESP_OK if the data was read
+ *             - ESP_ERR_INVALID_ARG if blob or out_value is NULL
+ *             - ESP_ERR_NVS_NOT_FOUND if the blob doesn't exist
+ *             - ESP_ERR_NVS_INVALID_HANDLE if the handle the blob was opened with has been closed
+ *             - ESP_ERR_NVS_INVALID_LENGTH if the requested part goes beyond the end of the blob
+ */
+esp_err_t nvs_blob_read_at(nvs_blob_handle_t blob, size_t offset, void *out_value, size_t length);
+
+/**
+ * @brief      Append data to the new value of a blob
+ *
+ * The data is written to flash right away, but the blob keeps its previous value until
+ * nvs_blob_close is called. Each call stores the data in one chunk, or in several ones if it does
+ * not fit the space left on the current page. Since a blob consists of at most 127 chunks, the
+ * data should be written in parts of at least a few hundred bytes.
+ *
+ * If this function fails, the data written so far is discarded and the following calls of
+ * nvs_blob_write_chunk and nvs_blob_close return ESP_ERR_INVALID_STATE.
+ *
+ * @param[in]  blob    Blob handle obtained from nvs_blob_open.
+ *                     The handle it was opened with must not be read only.
+ * @param[in]  value   The data to append.
+ * @param[in]  length  Length of the data in bytes.
+ *
+ * @return
+ *             - ESP_OK if the data was written
+ *             - ESP_ERR_INVALID_ARG if blob or value is NULL
+ *             - ESP_ERR_INVALID_STATE if a previous call failed
+ *             - ESP_ERR_NVS_INVALID_HANDLE if the handle the blob was opened with has been closed
+ *             - ESP_ERR_NVS_READ_ONLY if the handle was opened as read only
+ *             - ESP_ERR_NOT_SUPPORTED if a batch is open on the handle
+ *             - ESP_ERR_NVS_NOT_ENOUGH_SPACE if there is not enough space to save the data
+ *             - ESP_ERR_NVS_VALUE_TOO_LONG if the blob gets too long or consists of too many chunks
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_blob_write_chunk(nvs_blob_handle_t blob, const void *value, size_t length);
+
+/**
+ * @brief      Make the data written with nvs_blob_write_chunk the value of the blob and release
+ *             the blob handle
+ *
+ * If no data has been written, the blob is not changed. Otherwise the previous value of the blob
+ * is replaced. After a power loss before this function returns, the blob has either its previous
+ * or its new value.
+ *
+ * The blob handle is released even if an error is returned.
+ *
+ * @param[in]  blob  Blob handle obtained from nvs_blob_open.
+ *
+ * @return
+ *             - ESP_OK if the blob was saved
+ *             - ESP_ERR_INVALID_ARG if blob is NULL
+ *             - ESP_ERR_INVALID_STATE if a call of nvs_blob_write_chunk failed, the blob is not changed
+ *             - ESP_ERR_NVS_INVALID_HANDLE if the handle the blob was opened with has been closed
+ *             - ESP_ERR_NVS_NOT_ENOUGH_SPACE if there is not enough space to save the blob index
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_blob_close(nvs_blob_handle_t blob);
+
+/**
+ * @brief      Discard the data written with nvs_blob_write_chunk and release the blob handle
+ *
+ * The blob keeps its previous value.
+ *
+ * @param[in]  blob  Blob handle obtained from nvs_blob_open. If NULL, nothing is done.
+ */
+void nvs_blob_abort(nvs_blob_handle_t blob);
+
 /**
  * @brief      Close the storage handle and free any allocated resources
  *
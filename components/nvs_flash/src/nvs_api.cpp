@@ -418,6 +418,30 @@ extern "C" esp_err_t nvs_commit(nvs_handle_t c_handle)
     return handle->commit();
 }
 
+extern "C" esp_err_t nvs_begin_batch(nvs_handle_t c_handle)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s", __func__);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->begin_batch();
+}
+
+extern "C" esp_err_t nvs_end_batch(nvs_handle_t c_handle)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s", __func__);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->end_batch();
+}
+
 extern "C" esp_err_t nvs_set_str(nvs_handle_t c_handle, const char* key, const char* value)
 {
     Lock lock;
@@ -536,6 +560,107 @@ extern "C" esp_err_t nvs_get_blob(nvs_handle_t c_handle, const char* key, void*
     return nvs_get_str_or_blob(c_handle, nvs::ItemType::BLOB, key, out_value, length);
 }
 
+extern "C" esp_err_t nvs_blob_open(nvs_handle_t c_handle, const char* key, nvs_blob_handle_t* out_blob)
+{
+    if (key == nullptr || out_blob == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s", __func__, key);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (strlen(key) > nvs::Item::MAX_KEY_LENGTH) {
+        return ESP_ERR_NVS_KEY_TOO_LONG;
+    }
+
+    nvs_blob_handle_t blob = (nvs_blob_handle_t)calloc(1, sizeof(nvs_opaque_blob_t));
+    if (blob == nullptr) {
+        return ESP_ERR_NO_MEM;
+    }
+    blob->handle = c_handle;
+    strncpy(blob->key, key, sizeof(blob->key));
+    blob->writer = nvs::Storage::BlobWriter();
+    *out_blob = blob;
+    return ESP_OK;
+}
+
+extern "C" esp_err_t nvs_blob_read_at(nvs_blob_handle_t blob, size_t offset, void* out_value, size_t length)
+{
+    if (blob == nullptr || (out_value == nullptr && length > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s %d %d", __func__, blob->key, static_cast<int>(offset), static_cast<int>(length));
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(blob->handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->read_blob_at(blob->key, offset, out_value, length);
+}
+
+extern "C" esp_err_t nvs_blob_write_chunk(nvs_blob_handle_t blob, const void* value, size_t length)
+{
+    if (blob == nullptr || (value == nullptr && length > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s %d", __func__, blob->key, static_cast<int>(length));
+    if (blob->failed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(blob->handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = handle->write_blob_chunk(blob->key, blob->writer, value, length);
+    if (err != ESP_OK) {
+        // Don't commit a blob with a part missing, discard what was written so far
+        handle->abort_blob(blob->key, blob->writer);
+        blob->failed = true;
+    }
+    return err;
+}
+
+extern "C" esp_err_t nvs_blob_close(nvs_blob_handle_t blob)
+{
+    if (blob == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s", __func__, blob->key);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(blob->handle, &handle);
+    if (err == ESP_OK) {
+        err = blob->failed ? ESP_ERR_INVALID_STATE : handle->commit_blob(blob->key, blob->writer);
+    }
+    free(blob);
+    return err;
+}
+
+extern "C" void nvs_blob_abort(nvs_blob_handle_t blob)
+{
+    if (blob == nullptr) {
+        return;
+    }
+
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s", __func__, blob->key);
+    NVSHandleSimple *handle;
+    if (nvs_find_ns_handle(blob->handle, &handle) == ESP_OK) {
+        handle->abort_blob(blob->key, blob->writer);
+    }
+    free(blob);
+}
+
 extern "C" esp_err_t nvs_get_stats(const char* part_name, nvs_stats_t* nvs_stats)
 {
     Lock lock;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -10,66 +10,143 @@
 
 namespace nvs {
 
+/* Number of entries decrypted by a single AES-CBC call, bounds the work buffer on the stack */
+static const size_t DECRYPT_BATCH_ENTRIES = 8;
+
+/* Number of bytes written which are encrypted in a buffer on the stack instead of the heap */
+static const size_t ENCRYPT_STACK_BUF_SIZE = 2 * sizeof(Item);
+
+static const size_t XTS_BLOCK_SIZE = 16;
+
 NVSEncryptedPartition::NVSEncryptedPartition(const esp_partition_t *partition)
-    : NVSPartition(partition) { }
+    : NVSPartition(partition)
+{
+    mbedtls_aes_xts_init(&mEctxt);
+    mbedtls_aes_init(&mTweakCtxt);
+    mbedtls_aes_init(&mBlockDctxt);
+}
+
+NVSEncryptedPartition::~NVSEncryptedPartition()
+{
+    mbedtls_aes_xts_free(&mEctxt);
+    mbedtls_aes_free(&mTweakCtxt);
+    mbedtls_aes_free(&mBlockDctxt);
+}
 
 esp_err_t NVSEncryptedPartition::init(nvs_sec_cfg_t* cfg)
 {
     uint8_t* eky = reinterpret_cast<uint8_t*>(cfg);
 
-    mbedtls_aes_xts_init(&mEctxt);
-    mbedtls_aes_xts_init(&mDctxt);
-
     if (mbedtls_aes_xts_setkey_enc(&mEctxt, eky, 2 * NVS_KEY_SIZE * 8) != 0) {
         return ESP_ERR_NVS_XTS_CFG_FAILED;
     }
 
-    if (mbedtls_aes_xts_setkey_dec(&mDctxt, eky, 2 * NVS_KEY_SIZE * 8) != 0) {
+    // XTS uses the first half of the key for the data and the second half for the tweak
+    if (mbedtls_aes_setkey_dec(&mBlockDctxt, eky, NVS_KEY_SIZE * 8) != 0) {
+        return ESP_ERR_NVS_XTS_CFG_FAILED;
+    }
+
+    if (mbedtls_aes_setkey_enc(&mTweakCtxt, eky + NVS_KEY_SIZE, NVS_KEY_SIZE * 8) != 0) {
         return ESP_ERR_NVS_XTS_CFG_FAILED;
     }
 
     return ESP_OK;
 }
 
-esp_err_t NVSEncryptedPartition::read(size_t src_offset, void* dst, size_t size)
+/* Multiply the XTS tweak by x in GF(2^128), giving the tweak of the next block */
+static void xts_next_tweak(uint8_t tweak[XTS_BLOCK_SIZE])
 {
-    /** Currently upper layer of NVS reads entries one by one even for variable size
-    * multi-entry data types. So length should always be equal to size of an entry.*/
-    if (size != sizeof(Item)) return ESP_ERR_INVALID_SIZE;
-
-    // read data
-    esp_err_t read_result = esp_partition_read(mESPPartition, src_offset, dst, size);
-    if (read_result != ESP_OK) {
-        return read_result;
+    uint8_t carry = 0;
+    for (size_t i = 0; i < XTS_BLOCK_SIZE; i++) {
+        uint8_t next_carry = tweak[i] >> 7;
+        tweak[i] = (tweak[i] << 1) | carry;
+        carry = next_carry;
+    }
+    if (carry) {
+        tweak[0] ^= 0x87;
     }
+}
 
-    // decrypt data
-    //sector num required as an arr by mbedtls. Should have been just uint64/32.
-    uint8_t data_unit[16];
+/* Decrypt entries, each one being an XTS data unit numbered by its address.
+ *
+ * XTS decrypts block j as D(C_j ^ T_j) ^ T_j. The blocks X_j = C_j ^ T_j of all the entries are decrypted by
+ * one AES-CBC call, which gives D(X_j) ^ X_(j-1), so the data is then XORed with X_(j-1) ^ T_j to get the plaintext.
+ * Only the tweaks need one AES call per entry. */
+esp_err_t NVSEncryptedPartition::decrypt_entries(uint32_t rel_addr, uint8_t *data, size_t count)
+{
+    uint8_t blocks[DECRYPT_BATCH_ENTRIES * sizeof(Item)];
+
+    while (count > 0) {
+        size_t batch = (count < DECRYPT_BATCH_ENTRIES) ? count : DECRYPT_BATCH_ENTRIES;
+        size_t batch_size = batch * sizeof(Item);
+
+        for (size_t offset = 0; offset < batch_size; offset += sizeof(Item)) {
+            //sector num required as an arr by mbedtls. Should have been just uint64/32.
+            uint8_t data_unit[XTS_BLOCK_SIZE] = {};
+            uint32_t entry_addr = rel_addr + offset;
+            memcpy(data_unit, &entry_addr, sizeof(entry_addr));
+
+            uint8_t tweak[XTS_BLOCK_SIZE];
+            if (mbedtls_aes_crypt_ecb(&mTweakCtxt, MBEDTLS_AES_ENCRYPT, data_unit, tweak) != 0) {
+                return ESP_ERR_NVS_XTS_DECR_FAILED;
+            }
+
+            for (size_t block = offset; block < offset + sizeof(Item); block += XTS_BLOCK_SIZE) {
+                for (size_t i = 0; i < XTS_BLOCK_SIZE; i++) {
+                    blocks[block + i] = data[block + i] ^ tweak[i];
+                    // the ciphertext is not needed anymore, keep the mask applied after the CBC decryption
+                    data[block + i] = (block > 0 ? blocks[block - XTS_BLOCK_SIZE + i] : 0) ^ tweak[i];
+                }
+                xts_next_tweak(tweak);
+            }
+        }
 
-    uint32_t relAddr = src_offset;
+        uint8_t iv[XTS_BLOCK_SIZE] = {};
+        if (mbedtls_aes_crypt_cbc(&mBlockDctxt, MBEDTLS_AES_DECRYPT, batch_size, iv, blocks, blocks) != 0) {
+            return ESP_ERR_NVS_XTS_DECR_FAILED;
+        }
 
-    memset(data_unit, 0, sizeof(data_unit));
+        for (size_t i = 0; i < batch_size; i++) {
+            data[i] ^= blocks[i];
+        }
 
-    memcpy(data_unit, &relAddr, sizeof(relAddr));
+        rel_addr += batch_size;
+        data += batch_size;
+        count -= batch;
+    }
+
+    return ESP_OK;
+}
 
-    uint8_t *destination = reinterpret_cast<uint8_t*>(dst);
+esp_err_t NVSEncryptedPartition::read(size_t src_offset, void* dst, size_t size)
+{
+    /** Upper layer of NVS reads whole entries, one or several at a time.
+    * Each entry is an XTS data unit, numbered by its address.*/
+    if (size == 0 || size % sizeof(Item) != 0) return ESP_ERR_INVALID_SIZE;
 
-    if (mbedtls_aes_crypt_xts(&mDctxt, MBEDTLS_AES_DECRYPT, size, data_unit, destination, destination) != 0)  {
-        return ESP_ERR_NVS_XTS_DECR_FAILED;
+    // read data
+    esp_err_t read_result = esp_partition_read(mESPPartition, src_offset, dst, size);
+    if (read_result != ESP_OK) {
+        return read_result;
     }
 
-    return ESP_OK;
+    // decrypt data
+    return decrypt_entries(src_offset, reinterpret_cast<uint8_t*>(dst), size / sizeof(Item));
 }
 
 esp_err_t NVSEncryptedPartition::write(size_t addr, const void* src, size_t size)
 {
     if (size % ESP_ENCRYPT_BLOCK_SIZE != 0) return ESP_ERR_INVALID_SIZE;
 
-    // copy data to buffer for encryption
-    uint8_t* buf = new (std::nothrow) uint8_t [size];
-
-    if (!buf) return ESP_ERR_NO_MEM;
+    // copy data to buffer for encryption, most writes are one or two entries and fit on the stack
+    uint8_t stack_buf[ENCRYPT_STACK_BUF_SIZE];
+    uint8_t* heap_buf = nullptr;
+    uint8_t* buf = stack_buf;
+    if (size > sizeof(stack_buf)) {
+        heap_buf = new (std::nothrow) uint8_t [size];
+        if (!heap_buf) return ESP_ERR_NO_MEM;
+        buf = heap_buf;
+    }
 
     memcpy(buf, src, size);
 
@@ -97,7 +174,7 @@ esp_err_t NVSEncryptedPartition::write(size_t addr, const void* src, size_t size
                                   data_unit,
                                   buf + offset,
                                   buf + offset) != 0)  {
-            delete [] buf;
+            delete [] heap_buf;
             return ESP_ERR_NVS_XTS_ENCR_FAILED;
         }
     }
@@ -105,7 +182,7 @@ esp_err_t NVSEncryptedPartition::write(size_t addr, const void* src, size_t size
     // write data
     esp_err_t result = esp_partition_write(mESPPartition, addr, buf, size);
 
-    delete [] buf;
+    delete [] heap_buf;
 
     return result;
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <cstdlib>
+#include <cstring>
 #include "nvs_handle.hpp"
 #include "nvs_partition_manager.hpp"
 
@@ -11,12 +12,14 @@ namespace nvs {
 
 NVSHandleSimple::~NVSHandleSimple() {
     NVSPartitionManager::get_instance()->close_handle(this);
+    mBatch.clearAndFreeNodes();
 }
 
 esp_err_t NVSHandleSimple::set_typed_item(ItemType datatype, const char *key, const void* data, size_t dataSize)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mBatching) return stage_item(datatype, key, data, dataSize);
 
     return mStoragePtr->writeItem(mNsIndex, datatype, key, data, dataSize);
 }
@@ -32,6 +35,7 @@ esp_err_t NVSHandleSimple::set_string(const char *key, const char* str)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mBatching) return stage_item(nvs::ItemType::SZ, key, str, strlen(str) + 1);
 
     return mStoragePtr->writeItem(mNsIndex, nvs::ItemType::SZ, key, str, strlen(str) + 1);
 }
@@ -40,6 +44,7 @@ esp_err_t NVSHandleSimple::set_blob(const char *key, const void* blob, size_t le
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mBatching) return ESP_ERR_NOT_SUPPORTED;
 
     return mStoragePtr->writeItem(mNsIndex, nvs::ItemType::BLOB, key, blob, len);
 }
@@ -86,6 +91,7 @@ esp_err_t NVSHandleSimple::erase_item(const char* key)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mBatching) return ESP_ERR_NOT_SUPPORTED;
 
     return mStoragePtr->eraseItem(mNsIndex, key);
 }
@@ -94,6 +100,7 @@ esp_err_t NVSHandleSimple::erase_all()
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mBatching) return ESP_ERR_NOT_SUPPORTED;
 
     return mStoragePtr->eraseNamespace(mNsIndex);
 }
@@ -119,6 +126,92 @@ esp_err_t NVSHandleSimple::get_used_entry_count(size_t& used_entries)
     return err;
 }
 
+esp_err_t NVSHandleSimple::begin_batch()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mBatching) return ESP_ERR_INVALID_STATE;
+
+    mBatching = true;
+    return ESP_OK;
+}
+
+esp_err_t NVSHandleSimple::end_batch()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (!mBatching) return ESP_ERR_INVALID_STATE;
+
+    mBatching = false;
+    esp_err_t err = mStoragePtr->writeItemBatch(mNsIndex, mBatch);
+    mBatch.clearAndFreeNodes();
+    return err;
+}
+
+esp_err_t NVSHandleSimple::read_blob_at(const char *key, size_t offset, void *out_blob, size_t len)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+
+    return mStoragePtr->readBlobAt(mNsIndex, key, offset, out_blob, len);
+}
+
+esp_err_t NVSHandleSimple::write_blob_chunk(const char *key, Storage::BlobWriter &writer, const void *blob, size_t len)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mBatching) return ESP_ERR_NOT_SUPPORTED;
+
+    return mStoragePtr->writeBlobChunk(mNsIndex, key, writer, blob, len);
+}
+
+esp_err_t NVSHandleSimple::commit_blob(const char *key, Storage::BlobWriter &writer)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+
+    return mStoragePtr->commitBlob(mNsIndex, key, writer);
+}
+
+esp_err_t NVSHandleSimple::abort_blob(const char *key, Storage::BlobWriter &writer)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+
+    return mStoragePtr->abortBlob(mNsIndex, key, writer);
+}
+
+esp_err_t NVSHandleSimple::stage_item(ItemType datatype, const char *key, const void *data, size_t dataSize)
+{
+    if (strlen(key) > Item::MAX_KEY_LENGTH) return ESP_ERR_NVS_KEY_TOO_LONG;
+    if (dataSize > Page::CHUNK_MAX_SIZE) return ESP_ERR_NVS_VALUE_TOO_LONG;
+
+    uint8_t* buf = new (std::nothrow) uint8_t[dataSize];
+    if (!buf) return ESP_ERR_NO_MEM;
+    memcpy(buf, data, dataSize);
+
+    // A value set again replaces the staged one
+    Storage::BatchItem* item = nullptr;
+    for (auto it = mBatch.begin(); it != mBatch.end(); ++it) {
+        if (strncmp(it->key, key, sizeof(it->key)) == 0) {
+            item = it;
+            delete [] item->data;
+            break;
+        }
+    }
+    if (!item) {
+        item = new (std::nothrow) Storage::BatchItem;
+        if (!item) {
+            delete [] buf;
+            return ESP_ERR_NO_MEM;
+        }
+        strncpy(item->key, key, sizeof(item->key));
+        mBatch.push_back(item);
+    }
+    item->datatype = datatype;
+    item->data = buf;
+    item->dataSize = dataSize;
+    return ESP_OK;
+}
+
 void NVSHandleSimple::debugDump() {
     return mStoragePtr->debugDump();
 }
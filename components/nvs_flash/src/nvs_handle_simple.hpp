@@ -61,6 +61,34 @@ public:
 
     esp_err_t get_used_entry_count(size_t &usedEntries) override;
 
+    /**
+     * Start staging the values set through this handle in RAM instead of writing them.
+     * Only integer and string values can be staged; set_blob(), erase_item() and erase_all()
+     * return ESP_ERR_NOT_SUPPORTED until the batch ends.
+     */
+    esp_err_t begin_batch();
+
+    /**
+     * Write all values staged since begin_batch() together and stop staging. Either all or none of
+     * the values are written.
+     */
+    esp_err_t end_batch();
+
+    /**
+     * Read len bytes of a blob starting at offset.
+     */
+    esp_err_t read_blob_at(const char *key, size_t offset, void *out_blob, size_t len);
+
+    /**
+     * Append len bytes to a new version of the blob, see Storage::writeBlobChunk().
+     * The blob keeps its previous value until commit_blob() is called.
+     */
+    esp_err_t write_blob_chunk(const char *key, Storage::BlobWriter &writer, const void *blob, size_t len);
+
+    esp_err_t commit_blob(const char *key, Storage::BlobWriter &writer);
+
+    esp_err_t abort_blob(const char *key, Storage::BlobWriter &writer);
+
     esp_err_t getItemDataSize(ItemType datatype, const char *key, size_t &dataSize);
 
     void debugDump();
@@ -101,6 +129,15 @@ private:
      * Upon opening, a handle is valid. It becomes invalid if the underlying storage is de-initialized.
      */
     uint8_t valid;
+
+    /**
+     * Whether set operations are staged in mBatch, see begin_batch().
+     */
+    bool mBatching = false;
+
+    Storage::TBatchList mBatch;
+
+    esp_err_t stage_item(ItemType datatype, const char *key, const void *data, size_t dataSize);
 };
 
 } // nvs
@@ -26,6 +26,21 @@ public:
     size_t find(size_t start, const Item& item);
     void clear();
 
+    /**
+     * Call f with the 24-bit hash of every item in the list
+     */
+    template<typename F>
+    void forEachHash(F f)
+    {
+        for (auto it = mBlockList.begin(); it != mBlockList.end(); ++it) {
+            for (size_t index = 0; index < it->mCount; ++index) {
+                if (it->mNodes[index].mIndex != 0xff) {
+                    f(static_cast<uint32_t>(it->mNodes[index].mHash));
+                }
+            }
+        }
+    }
+
 private:
     HashList(const HashList& other);
     const HashList& operator= (const HashList& rhs);
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <new>
+#include "nvs_key_index.hpp"
+
+namespace nvs
+{
+
+KeyIndex::~KeyIndex()
+{
+    delete [] mBuckets;
+}
+
+esp_err_t KeyIndex::init(size_t slotCount)
+{
+    delete [] mBuckets;
+    mBuckets = nullptr;
+    mBucketCount = (slotCount + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    if (mBucketCount == 0) {
+        return ESP_OK;
+    }
+
+    mBuckets = new (std::nothrow) Bucket[mBucketCount];
+    if (!mBuckets) {
+        mBucketCount = 0;
+        return ESP_ERR_NO_MEM;
+    }
+    clear();
+    return ESP_OK;
+}
+
+void KeyIndex::clear()
+{
+    for (size_t i = 0; i < mBucketCount; ++i) {
+        for (size_t j = 0; j < BUCKET_SIZE; ++j) {
+            mBuckets[i].mSlots[j] = EMPTY_SLOT;
+        }
+    }
+}
+
+void KeyIndex::insert(uint32_t hash, size_t pageIndex)
+{
+    if (!mBuckets || pageIndex >= MAX_PAGE_COUNT) {
+        return;
+    }
+
+    uint32_t* slots = mBuckets[bucketOf(hash)].mSlots;
+    const uint32_t tag = tagOf(hash);
+
+    // Keep the bucket ordered from newest to oldest entry, the oldest one is dropped if the bucket is full
+    size_t pos = BUCKET_SIZE - 1;
+    for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+        if (slots[i] == EMPTY_SLOT || slotTag(slots[i]) == tag) {
+            pos = i;
+            break;
+        }
+    }
+    for (; pos > 0; --pos) {
+        slots[pos] = slots[pos - 1];
+    }
+    slots[0] = (tag << 12) | static_cast<uint32_t>(pageIndex + 1);
+}
+
+size_t KeyIndex::find(uint32_t hash)
+{
+    if (!mBuckets) {
+        return SIZE_MAX;
+    }
+
+    uint32_t* slots = mBuckets[bucketOf(hash)].mSlots;
+    const uint32_t tag = tagOf(hash);
+    for (size_t i = 0; i < BUCKET_SIZE && slots[i] != EMPTY_SLOT; ++i) {
+        if (slotTag(slots[i]) == tag) {
+            return (slots[i] & MAX_PAGE_COUNT) - 1;
+        }
+    }
+    return SIZE_MAX;
+}
+
+void KeyIndex::erase(uint32_t hash)
+{
+    if (!mBuckets) {
+        return;
+    }
+
+    uint32_t* slots = mBuckets[bucketOf(hash)].mSlots;
+    const uint32_t tag = tagOf(hash);
+    for (size_t i = 0; i < BUCKET_SIZE && slots[i] != EMPTY_SLOT; ++i) {
+        if (slotTag(slots[i]) == tag) {
+            for (; i < BUCKET_SIZE - 1; ++i) {
+                slots[i] = slots[i + 1];
+            }
+            slots[BUCKET_SIZE - 1] = EMPTY_SLOT;
+            return;
+        }
+    }
+}
+
+} // namespace nvs
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef nvs_key_index_hpp
+#define nvs_key_index_hpp
+
+#include <cstdint>
+#include <cstddef>
+#include "esp_err.h"
+#include "nvs_memory_management.hpp"
+
+namespace nvs
+{
+
+/**
+ * RAM index telling on which page an item is stored, so that Storage::findItem() does not need to
+ * search all pages.
+ *
+ * Items are identified by the same 24-bit hash of namespace index, key and chunk index which
+ * HashList uses. The index is set-associative with a fixed number of slots: when a bucket is full,
+ * the entry inserted longest ago is dropped. Entries are hints only: the item is always looked up on
+ * the page the index points to, and searched on all pages if it is not there. This means that
+ * entries may become stale, e.g. when pages are garbage collected, without affecting correctness.
+ */
+class KeyIndex
+{
+public:
+    KeyIndex() { }
+    ~KeyIndex();
+
+    /**
+     * Allocate the index. A slotCount of 0 leaves the index disabled.
+     */
+    esp_err_t init(size_t slotCount);
+
+    bool isEnabled() const
+    {
+        return mBuckets != nullptr;
+    }
+
+    void clear();
+
+    void insert(uint32_t hash, size_t pageIndex);
+
+    /**
+     * @return index of the page the item was last seen on, or SIZE_MAX if it is not indexed
+     */
+    size_t find(uint32_t hash);
+
+    void erase(uint32_t hash);
+
+    /**
+     * Pages with a higher index are not indexed
+     */
+    static const size_t MAX_PAGE_COUNT = (1 << 12) - 1;
+
+private:
+    KeyIndex(const KeyIndex& other);
+    const KeyIndex& operator= (const KeyIndex& rhs);
+
+protected:
+    static const size_t BUCKET_SIZE = 4;
+    static const uint32_t EMPTY_SLOT = 0;
+
+    // Each slot packs the upper 20 bits of the item hash with the page index plus one
+    struct Bucket : public ExceptionlessAllocatable {
+        uint32_t mSlots[BUCKET_SIZE];
+    };
+
+    size_t bucketOf(uint32_t hash) const
+    {
+        return (hash & 0xffffff) % mBucketCount;
+    }
+
+    static uint32_t tagOf(uint32_t hash)
+    {
+        return (hash & 0xffffff) >> 4;
+    }
+
+    static uint32_t slotTag(uint32_t slot)
+    {
+        return slot >> 12;
+    }
+
+    Bucket* mBuckets = nullptr;
+    size_t mBucketCount = 0;
+}; // class KeyIndex
+
+} // namespace nvs
+
+#endif /* nvs_key_index_hpp */
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,7 @@
 #include <esp_rom_crc.h>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 #include "nvs_internal.h"
 #include "esp_partition.h"
 
@@ -34,6 +35,8 @@ esp_err_t Page::load(Partition *partition, uint32_t sectorNumber)
     mBaseAddress = sectorNumber * SEC_SIZE;
     mUsedEntryCount = 0;
     mErasedEntryCount = 0;
+    mItemKinds = 0;
+    mNamespaceMask = 0;
 
     Header header;
     auto rc = mPartition->read_raw(mBaseAddress, &header, sizeof(header));
@@ -110,9 +113,11 @@ esp_err_t Page::writeEntry(const Item &item)
         return err;
     }
 
-    err = alterEntryState(mNextFreeEntry, EntryState::WRITTEN);
-    if (err != ESP_OK) {
-        return err;
+    if (mBatchStart == INVALID_ENTRY) {
+        err = alterEntryState(mNextFreeEntry, EntryState::WRITTEN);
+        if (err != ESP_OK) {
+            return err;
+        }
     }
 
     if (mFirstUsedEntry == INVALID_ENTRY) {
@@ -141,9 +146,11 @@ esp_err_t Page::writeEntryData(const uint8_t* data, size_t size)
         mState = PageState::INVALID;
         return rc;
     }
-    auto err = alterEntryRangeState(mNextFreeEntry, mNextFreeEntry + count, EntryState::WRITTEN);
-    if (err != ESP_OK) {
-        return err;
+    if (mBatchStart == INVALID_ENTRY) {
+        auto err = alterEntryRangeState(mNextFreeEntry, mNextFreeEntry + count, EntryState::WRITTEN);
+        if (err != ESP_OK) {
+            return err;
+        }
     }
     mUsedEntryCount += count;
     mNextFreeEntry += count;
@@ -208,6 +215,7 @@ esp_err_t Page::writeItem(uint8_t nsIndex, ItemType datatype, const char* key, c
     if (err != ESP_OK) {
         return err;
     }
+    addItemKind(item);
 
     if (!isVariableLengthType(datatype)) {
         memcpy(item.data, data, dataSize);
@@ -301,6 +309,60 @@ esp_err_t Page::readItem(uint8_t nsIndex, ItemType datatype, const char* key, vo
     return ESP_OK;
 }
 
+esp_err_t Page::readItemRange(uint8_t nsIndex, ItemType datatype, const char* key, size_t offset, void* data, size_t dataSize, uint8_t chunkIdx)
+{
+    size_t index = 0;
+    Item item;
+
+    if (mState == PageState::INVALID) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+
+    esp_err_t rc = findItem(nsIndex, datatype, key, index, item, chunkIdx);
+    if (rc != ESP_OK) {
+        return rc;
+    }
+
+    if (!isVariableLengthType(datatype)) {
+        return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+
+    const size_t itemSize = item.varLength.dataSize;
+    if (offset > itemSize || dataSize > itemSize - offset) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    uint8_t* dst = reinterpret_cast<uint8_t*>(data);
+    uint32_t crc32 = 0xffffffff;
+    size_t pos = 0;
+    for (size_t i = index + 1; i < index + item.span; ++i) {
+        Item ditem;
+        rc = readEntry(i, ditem);
+        if (rc != ESP_OK) {
+            return rc;
+        }
+        size_t willRead = ENTRY_SIZE;
+        willRead = (itemSize - pos < willRead) ? itemSize - pos : willRead;
+        crc32 = esp_rom_crc32_le(crc32, ditem.rawData, willRead);
+
+        // copy the part of this entry which overlaps with [offset, offset + dataSize)
+        size_t from = (offset > pos) ? offset : pos;
+        size_t to = (offset + dataSize < pos + willRead) ? offset + dataSize : pos + willRead;
+        if (from < to) {
+            memcpy(dst + (from - offset), ditem.rawData + (from - pos), to - from);
+        }
+        pos += willRead;
+    }
+    if (crc32 != item.varLength.dataCrc32) {
+        rc = eraseEntryAndSpan(index);
+        if (rc != ESP_OK) {
+            return rc;
+        }
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
 esp_err_t Page::cmpItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx, VerOffset chunkStart)
 {
     size_t index = 0;
@@ -500,6 +562,7 @@ esp_err_t Page::copyItems(Page &other)
         if (err != ESP_OK) {
             return err;
         }
+        other.addItemKind(entry);
 
         err = other.writeEntry(entry);
         if (err != ESP_OK) {
@@ -540,6 +603,30 @@ esp_err_t Page::mLoadEntryTable()
         }
     }
 
+    // Item headers are read in blocks of entries, which takes far fewer flash reads than reading them
+    // one by one. If the block can't be allocated, entries are read one by one.
+    std::unique_ptr<Item[]> block(new (std::nothrow) Item[LOAD_BLOCK_ENTRY_COUNT]);
+    size_t blockBegin = INVALID_ENTRY;
+    auto loadEntry = [&](size_t index, Item& dst) -> esp_err_t {
+        if (!block) {
+            return readEntry(index, dst);
+        }
+        if (blockBegin == INVALID_ENTRY || index < blockBegin || index >= blockBegin + LOAD_BLOCK_ENTRY_COUNT) {
+            size_t count = ENTRY_COUNT - index;
+            if (count > LOAD_BLOCK_ENTRY_COUNT) {
+                count = LOAD_BLOCK_ENTRY_COUNT;
+            }
+            blockBegin = INVALID_ENTRY;
+            esp_err_t rc = readEntries(index, block.get(), count);
+            if (rc != ESP_OK) {
+                return rc;
+            }
+            blockBegin = index;
+        }
+        dst = block[index - blockBegin];
+        return ESP_OK;
+    };
+
     EntryState state;
     esp_err_t err;
     mErasedEntryCount = 0;
@@ -641,7 +728,7 @@ esp_err_t Page::mLoadEntryTable()
 
             lastItemIndex = i;
 
-            auto err = readEntry(i, item);
+            auto err = loadEntry(i, item);
             if (err != ESP_OK) {
                 mState = PageState::INVALID;
                 return err;
@@ -661,6 +748,7 @@ esp_err_t Page::mLoadEntryTable()
                 mState = PageState::INVALID;
                 return err;
             }
+            addItemKind(item);
 
             // search for potential duplicate item
             size_t duplicateIndex = mHashList.find(0, item);
@@ -721,7 +809,7 @@ esp_err_t Page::mLoadEntryTable()
                 continue;
             }
 
-            err = readEntry(i, item);
+            err = loadEntry(i, item);
             if (err != ESP_OK) {
                 mState = PageState::INVALID;
                 return err;
@@ -743,6 +831,7 @@ esp_err_t Page::mLoadEntryTable()
                 mState = PageState::INVALID;
                 return err;
             }
+            addItemKind(item);
 
             size_t span = item.span;
 
@@ -862,7 +951,40 @@ esp_err_t Page::readEntry(size_t index, Item &dst) const
     return ESP_OK;
 }
 
-esp_err_t Page::findItem(uint8_t nsIndex, ItemType datatype, const char* key, size_t &itemIndex, Item &item, uint8_t chunkIdx, VerOffset chunkStart)
+esp_err_t Page::readEntries(size_t index, Item* dst, size_t count) const
+{
+    NVS_ASSERT_OR_RETURN(count > 0 && index + count <= ENTRY_COUNT, ESP_FAIL);
+    uint32_t phyAddr;
+    esp_err_t rc = getEntryAddress(index, &phyAddr);
+    if (rc != ESP_OK) {
+        return rc;
+    }
+    return mPartition->read(phyAddr, dst, count * sizeof(Item));
+}
+
+esp_err_t Page::readEntryAhead(size_t index, size_t end, Item& dst, ReadAhead& readAhead) const
+{
+    if (readAhead.page != this || readAhead.seqNumber != mSeqNumber ||
+            index < readAhead.first || index >= readAhead.first + readAhead.count) {
+        size_t count = end - index;
+        if (count > ReadAhead::BLOCK_ENTRY_COUNT) {
+            count = ReadAhead::BLOCK_ENTRY_COUNT;
+        }
+        readAhead.count = 0;
+        esp_err_t rc = readEntries(index, readAhead.items, count);
+        if (rc != ESP_OK) {
+            return rc;
+        }
+        readAhead.page = this;
+        readAhead.seqNumber = mSeqNumber;
+        readAhead.first = index;
+        readAhead.count = count;
+    }
+    dst = readAhead.items[index - readAhead.first];
+    return ESP_OK;
+}
+
+esp_err_t Page::findItem(uint8_t nsIndex, ItemType datatype, const char* key, size_t &itemIndex, Item &item, uint8_t chunkIdx, VerOffset chunkStart, ReadAhead* readAhead)
 {
     if (mState == PageState::CORRUPT || mState == PageState::INVALID || mState == PageState::UNINITIALIZED) {
         return ESP_ERR_NVS_NOT_FOUND;
@@ -873,6 +995,18 @@ esp_err_t Page::findItem(uint8_t nsIndex, ItemType datatype, const char* key, si
         return ESP_ERR_NVS_NOT_FOUND;
     }
 
+    // Storage::init() searches all pages for namespaces and blobs, skip the pages which never had any
+    if ((nsIndex == NS_INDEX && !(mItemKinds & ITEM_KIND_NAMESPACE)) ||
+            (datatype == ItemType::BLOB_DATA && !(mItemKinds & ITEM_KIND_BLOB_DATA)) ||
+            (datatype == ItemType::BLOB_IDX && !(mItemKinds & ITEM_KIND_BLOB_INDEX))) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    // Iteration and entry counting search all pages for a namespace, skip the pages which never had it
+    if (!mayContainNamespace(nsIndex)) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
     size_t start = mFirstUsedEntry;
     if (findBeginIndex > mFirstUsedEntry && findBeginIndex < ENTRY_COUNT) {
         start = findBeginIndex;
@@ -908,7 +1042,7 @@ esp_err_t Page::findItem(uint8_t nsIndex, ItemType datatype, const char* key, si
             continue;
         }
 
-        rc = readEntry(i, item);
+        rc = readAhead ? readEntryAhead(i, end, item, *readAhead) : readEntry(i, item);
         if (rc != ESP_OK) {
             mState = PageState::INVALID;
             return rc;
@@ -1034,6 +1168,8 @@ esp_err_t Page::erase()
     mNextFreeEntry = INVALID_ENTRY;
     mState = PageState::UNINITIALIZED;
     mHashList.clear();
+    mItemKinds = 0;
+    mNamespaceMask = 0;
     return ESP_OK;
 }
 
@@ -1064,6 +1200,79 @@ size_t Page::getVarDataTailroom() const
     return ((mNextFreeEntry < (ENTRY_COUNT - 1)) ? ((ENTRY_COUNT - mNextFreeEntry - 1) * ENTRY_SIZE) : 0);
 }
 
+size_t Page::getFreeEntryCount() const
+{
+    if (mState == PageState::UNINITIALIZED) {
+        return ENTRY_COUNT;
+    } else if (mState != PageState::ACTIVE || mNextFreeEntry > ENTRY_COUNT) {
+        return 0;
+    }
+    return ENTRY_COUNT - mNextFreeEntry;
+}
+
+size_t Page::getEntryCount(ItemType datatype, size_t dataSize)
+{
+    if (!isVariableLengthType(datatype)) {
+        return 1;
+    }
+    return 1 + (dataSize + ENTRY_SIZE - 1) / ENTRY_SIZE;
+}
+
+esp_err_t Page::beginBatch()
+{
+    NVS_ASSERT_OR_RETURN(mBatchStart == INVALID_ENTRY, ESP_FAIL);
+
+    if (mState == PageState::UNINITIALIZED) {
+        esp_err_t err = initialize();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    if (mState == PageState::FULL) {
+        return ESP_ERR_NVS_PAGE_FULL;
+    } else if (mState != PageState::ACTIVE) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+
+    mBatchStart = mNextFreeEntry;
+    return ESP_OK;
+}
+
+esp_err_t Page::commitBatch()
+{
+    NVS_ASSERT_OR_RETURN(mBatchStart != INVALID_ENTRY, ESP_FAIL);
+
+    size_t begin = mBatchStart;
+    mBatchStart = INVALID_ENTRY;
+    if (mNextFreeEntry == begin) {
+        return ESP_OK;
+    }
+
+    // The range is written from its end, so the first entry of the batch is marked written last.
+    // If power is lost before that, load() finds the first entry empty and erases the whole batch.
+    return alterEntryRangeState(begin, mNextFreeEntry, EntryState::WRITTEN);
+}
+
+esp_err_t Page::abortBatch()
+{
+    NVS_ASSERT_OR_RETURN(mBatchStart != INVALID_ENTRY, ESP_FAIL);
+
+    size_t begin = mBatchStart;
+    mBatchStart = INVALID_ENTRY;
+    if (mNextFreeEntry == begin || mNextFreeEntry > ENTRY_COUNT) {
+        return ESP_OK;
+    }
+
+    for (size_t i = begin; i < mNextFreeEntry; ++i) {
+        mHashList.erase(i);
+    }
+    const size_t count = mNextFreeEntry - begin;
+    mUsedEntryCount -= count;
+    mErasedEntryCount += count;
+    return alterEntryRangeState(begin, mNextFreeEntry, EntryState::ERASED);
+}
+
 const char* Page::pageStateToName(PageState ps)
 {
     switch (ps) {
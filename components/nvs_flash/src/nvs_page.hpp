@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -49,6 +49,21 @@ public:
 
     static const uint8_t NVS_VERSION = NVS_CONST_NVS_VERSION; // Decrement to upgrade
 
+    /**
+     * Entries read ahead by findItem() while it scans a page without a key, so that iterating over the entries
+     * reads them from flash in blocks. The block is tied to the page contents by the page sequence number,
+     * entries which are erased meanwhile are skipped as their state is checked before the block is used.
+     */
+    struct ReadAhead {
+        static const size_t BLOCK_ENTRY_COUNT = 8;
+
+        const Page* page;
+        uint32_t seqNumber;
+        size_t first;
+        size_t count;
+        Item items[BLOCK_ENTRY_COUNT];
+    };
+
     enum class PageState : uint32_t {
         // All bits set, default state after flash erase. Page has not been initialized yet.
         UNINITIALIZED = NVS_CONST_PAGE_STATE_UNINITIALIZED,
@@ -90,13 +105,19 @@ public:
 
     esp_err_t readItem(uint8_t nsIndex, ItemType datatype, const char* key, void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
+    /**
+     * Read dataSize bytes starting at offset from the data of a variable length item.
+     * The whole item is still read from flash to check its CRC, but only the requested part is copied.
+     */
+    esp_err_t readItemRange(uint8_t nsIndex, ItemType datatype, const char* key, size_t offset, void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY);
+
     esp_err_t cmpItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
     esp_err_t eraseItem(uint8_t nsIndex, ItemType datatype, const char* key, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
     esp_err_t findItem(uint8_t nsIndex, ItemType datatype, const char* key, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
-    esp_err_t findItem(uint8_t nsIndex, ItemType datatype, const char* key, size_t &itemIndex, Item& item, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
+    esp_err_t findItem(uint8_t nsIndex, ItemType datatype, const char* key, size_t &itemIndex, Item& item, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY, ReadAhead* readAhead = nullptr);
 
     esp_err_t eraseEntryAndSpan(size_t index);
 
@@ -135,6 +156,27 @@ public:
     }
     size_t getVarDataTailroom() const ;
 
+    /**
+     * Number of entries which can still be written to this page
+     */
+    size_t getFreeEntryCount() const;
+
+    /**
+     * Number of entries taken by an item of the given type and data size
+     */
+    static size_t getEntryCount(ItemType datatype, size_t dataSize);
+
+    /**
+     * Start a batch of writes. Items written until commitBatch() is called are not visible, neither
+     * to readers nor after a restart. commitBatch() then marks all of them written with a single
+     * update of the entry state table, abortBatch() erases them.
+     */
+    esp_err_t beginBatch();
+
+    esp_err_t commitBatch();
+
+    esp_err_t abortBatch();
+
     esp_err_t markFull();
 
     esp_err_t markFreeing();
@@ -147,6 +189,15 @@ public:
 
     esp_err_t calcEntries(nvs_stats_t &nvsStats);
 
+    /**
+     * Call f with the 24-bit hash of namespace index, key and chunk index of every item on this page
+     */
+    template<typename F>
+    void forEachItemHash(F f)
+    {
+        mHashList.forEachHash(f);
+    }
+
 protected:
 
     class Header
@@ -186,12 +237,39 @@ protected:
 
     esp_err_t readEntry(size_t index, Item& dst) const;
 
+    esp_err_t readEntries(size_t index, Item* dst, size_t count) const;
+
+    esp_err_t readEntryAhead(size_t index, size_t end, Item& dst, ReadAhead& readAhead) const;
+
     esp_err_t writeEntry(const Item& item);
 
     esp_err_t writeEntryData(const uint8_t* data, size_t size);
 
     esp_err_t updateFirstUsedEntry(size_t index, size_t span);
 
+    void addItemKind(const Item& item)
+    {
+        mNamespaceMask |= namespaceBit(item.nsIndex);
+        if (item.nsIndex == NS_INDEX) {
+            mItemKinds |= ITEM_KIND_NAMESPACE;
+        }
+        if (item.datatype == ItemType::BLOB_IDX) {
+            mItemKinds |= ITEM_KIND_BLOB_INDEX;
+        } else if (item.datatype == ItemType::BLOB_DATA) {
+            mItemKinds |= ITEM_KIND_BLOB_DATA;
+        }
+    }
+
+    static constexpr uint32_t namespaceBit(uint8_t nsIndex)
+    {
+        return 1U << (nsIndex % 32);
+    }
+
+    bool mayContainNamespace(uint8_t nsIndex) const
+    {
+        return nsIndex == NS_ANY || (mNamespaceMask & namespaceBit(nsIndex)) != 0;
+    }
+
     static constexpr size_t getAlignmentForType(ItemType type)
     {
         return static_cast<uint8_t>(type) & 0x0f;
@@ -218,6 +296,9 @@ protected:
     size_t mFirstUsedEntry = INVALID_ENTRY;
     uint16_t mUsedEntryCount = 0;
     uint16_t mErasedEntryCount = 0;
+    size_t mBatchStart = INVALID_ENTRY;
+    uint8_t mItemKinds = 0;
+    uint32_t mNamespaceMask = 0; // namespaces stored on this page since it was loaded or erased, bit nsIndex % 32
 
     /**
      * This hash list stores hashes of namespace index, key, and ChunkIndex for quick lookup when searching items.
@@ -226,6 +307,13 @@ protected:
 
     Partition *mPartition;
 
+    static const size_t LOAD_BLOCK_ENTRY_COUNT = 16;
+
+    // Kinds of items which have been stored on this page since it was loaded or erased, see mItemKinds
+    static const uint8_t ITEM_KIND_NAMESPACE = 0x01;
+    static const uint8_t ITEM_KIND_BLOB_INDEX = 0x02;
+    static const uint8_t ITEM_KIND_BLOB_DATA = 0x04;
+
     static const uint32_t HEADER_OFFSET = NVS_CONST_PAGE_HEADER_OFFSET;
     static const uint32_t ENTRY_TABLE_OFFSET = NVS_CONST_PAGE_ENTRY_TABLE_OFFSET;
     static const uint32_t ENTRY_DATA_OFFSET = NVS_CONST_PAGE_ENTRY_DATA_OFFSET;
@@ -52,6 +52,16 @@ public:
         return mPageCount;
     }
 
+    Page* getPage(size_t index)
+    {
+        return (index < mPageCount) ? &mPages[index] : nullptr;
+    }
+
+    size_t getPageIndex(const Page& page)
+    {
+        return &page - mPages.get();
+    }
+
     esp_err_t requestNewPage();
 
     esp_err_t fillStats(nvs_stats_t& nvsStats);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -241,6 +241,13 @@ esp_err_t Storage::init(uint32_t baseSector, uint32_t sectorCount)
     // Purge the blob index list
     blobIdxList.clearAndFreeNodes();
 
+#ifdef CONFIG_NVS_KEY_INDEX
+    // The index is optional, keep working without it if there is not enough memory
+    if (mKeyIndex.init(CONFIG_NVS_KEY_INDEX_SLOTS) == ESP_OK) {
+        populateKeyIndex();
+    }
+#endif
+
     mState = StorageState::ACTIVE;
 
 #ifdef DEBUG_STORAGE
@@ -254,35 +261,96 @@ bool Storage::isValid() const
     return mState == StorageState::ACTIVE;
 }
 
+void Storage::populateKeyIndex()
+{
+    // If an item is present on several pages (e.g. after a power loss during an update), the full
+    // search in findItem() returns its copy on the first page, so the first page seen must win here too.
+    for (auto it = mPageManager.begin(); it != mPageManager.end(); ++it) {
+        const size_t pageIndex = mPageManager.getPageIndex(*it);
+        it->forEachItemHash([this, pageIndex](uint32_t hash) {
+            if (mKeyIndex.find(hash) == SIZE_MAX) {
+                mKeyIndex.insert(hash, pageIndex);
+            }
+        });
+    }
+}
+
 esp_err_t Storage::findItem(uint8_t nsIndex, ItemType datatype, const char* key, Page* &page, Item& item, uint8_t chunkIdx, VerOffset chunkStart)
 {
+    // Same condition as for the use of the page hash list in Page::findItem()
+    const bool useKeyIndex = mKeyIndex.isEnabled() && nsIndex != Page::NS_ANY && key != nullptr &&
+            (datatype != ItemType::BLOB_DATA || chunkIdx != Page::CHUNK_ANY);
+    uint32_t hash = 0;
+    if (useKeyIndex) {
+        hash = keyIndexHash(nsIndex, key, chunkIdx);
+        Page* hintPage = mPageManager.getPage(mKeyIndex.find(hash));
+        if (hintPage) {
+            size_t itemIndex = 0;
+            if (hintPage->findItem(nsIndex, datatype, key, itemIndex, item, chunkIdx, chunkStart) == ESP_OK) {
+                page = hintPage;
+                return ESP_OK;
+            }
+        }
+    }
+
     for (auto it = std::begin(mPageManager); it != std::end(mPageManager); ++it) {
         size_t itemIndex = 0;
         auto err = it->findItem(nsIndex, datatype, key, itemIndex, item, chunkIdx, chunkStart);
         if (err == ESP_OK) {
             page = it;
+            if (useKeyIndex) {
+                mKeyIndex.insert(hash, mPageManager.getPageIndex(*it));
+            }
             return ESP_OK;
         }
     }
     return ESP_ERR_NVS_NOT_FOUND;
 }
 
-esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const void* data, size_t dataSize, VerOffset chunkStart)
+size_t Storage::getMaxMultiPageBlobSize()
 {
-    uint8_t chunkCount = 0;
-    TUsedPageList usedPages;
-    size_t remainingSize = dataSize;
-    size_t offset = 0;
-    esp_err_t err = ESP_OK;
-
     /* Check how much maximum data can be accommodated**/
     uint32_t max_pages = mPageManager.getPageCount() - 1;
 
     if(max_pages > (Page::CHUNK_ANY-1)/2) {
        max_pages = (Page::CHUNK_ANY-1)/2;
     }
+    return max_pages * Page::CHUNK_MAX_SIZE;
+}
+
+esp_err_t Storage::writeItemToCurrentPage(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx)
+{
+    Page& page = getCurrentPage();
+    auto err = page.writeItem(nsIndex, datatype, key, data, dataSize, chunkIdx);
+    if (err != ESP_ERR_NVS_PAGE_FULL) {
+        return err;
+    }
+    if (page.state() != Page::PageState::FULL) {
+        err = page.markFull();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    err = mPageManager.requestNewPage();
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = getCurrentPage().writeItem(nsIndex, datatype, key, data, dataSize, chunkIdx);
+    if (err == ESP_ERR_NVS_PAGE_FULL) {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+    return err;
+}
 
-    if (dataSize > max_pages * Page::CHUNK_MAX_SIZE) {
+esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const void* data, size_t dataSize, VerOffset chunkStart)
+{
+    uint8_t chunkCount = 0;
+    TUsedPageList usedPages;
+    size_t remainingSize = dataSize;
+    size_t offset = 0;
+    esp_err_t err = ESP_OK;
+
+    if (dataSize > getMaxMultiPageBlobSize()) {
         return ESP_ERR_NVS_VALUE_TOO_LONG;
     }
 
@@ -521,6 +589,121 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
             return err;
         }
     }
+
+    // The new item (or blob index) is on the current page. Only update the index now that the previous
+    // copy is erased, the lookups above must still find the previous copy.
+    if (mKeyIndex.isEnabled()) {
+        mKeyIndex.insert(keyIndexHash(nsIndex, key), mPageManager.getPageIndex(getCurrentPage()));
+    }
+#ifdef DEBUG_STORAGE
+    debugCheck();
+#endif
+    return ESP_OK;
+}
+
+esp_err_t Storage::writeItemBatch(uint8_t nsIndex, TBatchList& items)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    // Look up the current values first, unchanged items are not written again
+    size_t entryCount = 0;
+    for (auto it = std::begin(items); it != std::end(items); ++it) {
+        NVS_ASSERT_OR_RETURN(it->datatype != ItemType::BLOB, ESP_ERR_INVALID_ARG);
+
+        Item item;
+        Page* findPage = nullptr;
+#ifdef CONFIG_NVS_LEGACY_DUP_KEYS_COMPATIBILITY
+        auto err = findItem(nsIndex, it->datatype, it->key, findPage, item);
+#else
+        auto err = findItem(nsIndex, ItemType::ANY, it->key, findPage, item);
+#endif
+        if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+            return err;
+        }
+        it->hasPrevious = (err == ESP_OK);
+        it->needsWrite = !it->hasPrevious || item.datatype != it->datatype ||
+                findPage->cmpItem(nsIndex, it->datatype, it->key, it->data, it->dataSize) != ESP_OK;
+        if (it->needsWrite) {
+            entryCount += Page::getEntryCount(it->datatype, it->dataSize);
+        }
+    }
+
+    if (entryCount == 0) {
+        return ESP_OK;
+    }
+    if (entryCount > Page::ENTRY_COUNT) {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+
+    if (getCurrentPage().getFreeEntryCount() < entryCount) {
+        Page& page = getCurrentPage();
+        if (page.state() != Page::PageState::FULL) {
+            auto err = page.markFull();
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+        auto err = mPageManager.requestNewPage();
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (getCurrentPage().getFreeEntryCount() < entryCount) {
+            return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+        }
+    }
+
+    Page& page = getCurrentPage();
+    auto err = page.beginBatch();
+    if (err != ESP_OK) {
+        return err;
+    }
+    for (auto it = std::begin(items); it != std::end(items); ++it) {
+        if (!it->needsWrite) {
+            continue;
+        }
+        err = page.writeItem(nsIndex, it->datatype, it->key, it->data, it->dataSize);
+        if (err != ESP_OK) {
+            page.abortBatch();
+            return err;
+        }
+    }
+    err = page.commitBatch();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // Erase the previous values. They were written before the batch, so they are found before the new ones.
+    for (auto it = std::begin(items); it != std::end(items); ++it) {
+        if (!it->needsWrite) {
+            continue;
+        }
+        if (it->hasPrevious) {
+            Item item;
+            Page* findPage = nullptr;
+#ifdef CONFIG_NVS_LEGACY_DUP_KEYS_COMPATIBILITY
+            err = findItem(nsIndex, it->datatype, it->key, findPage, item);
+            if (err == ESP_OK) {
+                err = findPage->eraseItem(nsIndex, it->datatype, it->key);
+            }
+#else
+            err = findItem(nsIndex, ItemType::ANY, it->key, findPage, item);
+            if (err == ESP_OK) {
+                err = findPage->eraseItem(nsIndex, ItemType::ANY, it->key);
+            }
+#endif
+            if (err == ESP_ERR_FLASH_OP_FAIL) {
+                return ESP_ERR_NVS_REMOVE_FAILED;
+            }
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+        if (mKeyIndex.isEnabled()) {
+            mKeyIndex.insert(keyIndexHash(nsIndex, it->key), mPageManager.getPageIndex(page));
+        }
+    }
 #ifdef DEBUG_STORAGE
     debugCheck();
 #endif
@@ -763,6 +946,213 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
     return ESP_OK;
 }
 
+esp_err_t Storage::readBlobAt(uint8_t nsIndex, const char* key, size_t offset, void* data, size_t dataSize)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    Item item;
+    Page* findPage = nullptr;
+    auto err = findItem(nsIndex, ItemType::BLOB_IDX, key, findPage, item);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        /* Support for earlier versions where BLOBS were stored without index */
+        err = findItem(nsIndex, ItemType::BLOB, key, findPage, item);
+        if (err != ESP_OK) {
+            return err;
+        }
+        return findPage->readItemRange(nsIndex, ItemType::BLOB, key, offset, data, dataSize);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (offset > item.blobIndex.dataSize || dataSize > item.blobIndex.dataSize - offset) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    uint8_t chunkCount = item.blobIndex.chunkCount;
+    VerOffset chunkStart = item.blobIndex.chunkStart;
+    uint8_t* dst = static_cast<uint8_t*>(data);
+    size_t chunkOffset = 0;
+
+    /* Only read the chunks which overlap with the requested range */
+    for (uint8_t chunkNum = 0; chunkNum < chunkCount && dataSize > 0; chunkNum++) {
+        uint8_t chunkIdx = static_cast<uint8_t> (chunkStart) + chunkNum;
+        err = findItem(nsIndex, ItemType::BLOB_DATA, key, findPage, item, chunkIdx);
+        if (err != ESP_OK) {
+            return err;
+        }
+        size_t chunkSize = item.varLength.dataSize;
+        if (offset < chunkOffset + chunkSize) {
+            size_t readOffset = offset - chunkOffset;
+            size_t readSize = (chunkSize - readOffset < dataSize) ? chunkSize - readOffset : dataSize;
+            err = findPage->readItemRange(nsIndex, ItemType::BLOB_DATA, key, readOffset, dst, readSize, chunkIdx);
+            if (err != ESP_OK) {
+                return err;
+            }
+            dst += readSize;
+            offset += readSize;
+            dataSize -= readSize;
+        }
+        chunkOffset += chunkSize;
+    }
+
+    if (dataSize > 0) {
+        /* The size of the entry in the index is inconsistent with the sum of the sizes of chunks */
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    return ESP_OK;
+}
+
+esp_err_t Storage::writeBlobChunk(uint8_t nsIndex, const char* key, BlobWriter& writer, const void* data, size_t dataSize)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    if (writer.chunkStart == VerOffset::VER_ANY) {
+        /* Use the version which the current value of the blob does not use */
+        Item item;
+        Page* findPage = nullptr;
+        auto err = findItem(nsIndex, ItemType::BLOB_IDX, key, findPage, item);
+        if (err == ESP_OK) {
+            writer.chunkStart = (item.blobIndex.chunkStart == VerOffset::VER_1_OFFSET) ? VerOffset::VER_0_OFFSET : VerOffset::VER_1_OFFSET;
+        } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+            writer.chunkStart = VerOffset::VER_0_OFFSET;
+        } else {
+            return err;
+        }
+        writer.chunkCount = 0;
+        writer.dataSize = 0;
+    }
+
+    if (dataSize > getMaxMultiPageBlobSize() - writer.dataSize) {
+        return ESP_ERR_NVS_VALUE_TOO_LONG;
+    }
+
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    while (dataSize > 0) {
+        Page& page = getCurrentPage();
+        size_t tailroom = page.getVarDataTailroom();
+        if (tailroom == 0 || (tailroom < dataSize && tailroom < Page::CHUNK_MAX_SIZE/10)) {
+            /* Don't split the data into chunks which are too small */
+            if (page.state() != Page::PageState::FULL) {
+                auto err = page.markFull();
+                if (err != ESP_OK) {
+                    return err;
+                }
+            }
+            auto err = mPageManager.requestNewPage();
+            if (err != ESP_OK) {
+                return err;
+            }
+            if (getCurrentPage().getVarDataTailroom() == tailroom) {
+                /* We got the same page or we are not improving.*/
+                return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+            }
+            continue;
+        }
+
+        if (writer.chunkCount >= (Page::CHUNK_ANY-1)/2) {
+            return ESP_ERR_NVS_VALUE_TOO_LONG;
+        }
+
+        size_t chunkSize = (dataSize > tailroom) ? tailroom : dataSize;
+        auto err = page.writeItem(nsIndex, ItemType::BLOB_DATA, key, src, chunkSize,
+                static_cast<uint8_t> (writer.chunkStart) + writer.chunkCount);
+        if (err != ESP_OK) {
+            NVS_ASSERT_OR_RETURN(err != ESP_ERR_NVS_PAGE_FULL, err);
+            return err;
+        }
+        writer.chunkCount++;
+        writer.dataSize += chunkSize;
+        src += chunkSize;
+        dataSize -= chunkSize;
+    }
+    return ESP_OK;
+}
+
+esp_err_t Storage::commitBlob(uint8_t nsIndex, const char* key, BlobWriter& writer)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    if (writer.chunkStart == VerOffset::VER_ANY) {
+        return ESP_OK;
+    }
+
+    esp_err_t err = ESP_OK;
+    if (writer.chunkCount == 0) {
+        /* An empty blob is stored as a single empty chunk, as writeMultiPageBlob() does */
+        err = writeItemToCurrentPage(nsIndex, ItemType::BLOB_DATA, key, nullptr, 0, static_cast<uint8_t> (writer.chunkStart));
+        if (err == ESP_OK) {
+            writer.chunkCount = 1;
+        }
+    }
+
+    Item item;
+    if (err == ESP_OK) {
+        std::fill_n(item.data, sizeof(item.data), 0xff);
+        item.blobIndex.dataSize = writer.dataSize;
+        item.blobIndex.chunkCount = writer.chunkCount;
+        item.blobIndex.chunkStart = writer.chunkStart;
+        err = writeItemToCurrentPage(nsIndex, ItemType::BLOB_IDX, key, item.data, sizeof(item.data));
+    }
+    if (err != ESP_OK) {
+        /* Without the index the chunks are orphans, don't leave them until the next Storage::init() */
+        abortBlob(nsIndex, key, writer);
+        return err;
+    }
+
+    /* Erase the previous version of the blob, or the blob stored without index by earlier versions */
+    VerOffset prevStart = (writer.chunkStart == VerOffset::VER_1_OFFSET) ? VerOffset::VER_0_OFFSET : VerOffset::VER_1_OFFSET;
+    err = eraseMultiPageBlob(nsIndex, key, prevStart);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        Page* findPage = nullptr;
+        err = findItem(nsIndex, ItemType::BLOB, key, findPage, item);
+        if (err == ESP_OK) {
+            err = findPage->eraseItem(nsIndex, ItemType::BLOB, key);
+        } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+            err = ESP_OK;
+        }
+    }
+    if (err == ESP_ERR_FLASH_OP_FAIL) {
+        return ESP_ERR_NVS_REMOVE_FAILED;
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (mKeyIndex.isEnabled()) {
+        mKeyIndex.insert(keyIndexHash(nsIndex, key), mPageManager.getPageIndex(getCurrentPage()));
+    }
+    writer = BlobWriter();
+    return ESP_OK;
+}
+
+esp_err_t Storage::abortBlob(uint8_t nsIndex, const char* key, BlobWriter& writer)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    for (uint8_t chunkNum = 0; writer.chunkStart != VerOffset::VER_ANY && chunkNum < writer.chunkCount; chunkNum++) {
+        uint8_t chunkIdx = static_cast<uint8_t> (writer.chunkStart) + chunkNum;
+        Item item;
+        Page* findPage = nullptr;
+        auto err = findItem(nsIndex, ItemType::BLOB_DATA, key, findPage, item, chunkIdx);
+        if (err == ESP_OK) {
+            err = findPage->eraseItem(nsIndex, ItemType::BLOB_DATA, key, chunkIdx);
+        }
+        if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+            return err;
+        }
+    }
+    writer = BlobWriter();
+    return ESP_OK;
+}
+
 esp_err_t Storage::eraseItem(uint8_t nsIndex, ItemType datatype, const char* key)
 {
     if (mState != StorageState::ACTIVE) {
@@ -979,7 +1369,8 @@ bool Storage::nextEntry(nvs_opaque_iterator_t* it)
 
     for (auto page = it->page; page != mPageManager.end(); ++page) {
         do {
-            err = page->findItem(it->nsIndex, (ItemType)it->type, nullptr, it->entryIndex, item);
+            err = page->findItem(it->nsIndex, (ItemType)it->type, nullptr, it->entryIndex, item,
+                                 Page::CHUNK_ANY, VerOffset::VER_ANY, &it->readAhead);
             it->entryIndex += item.span;
             if(err == ESP_OK && isIterableItem(item) && !isMultipageBlob(item)) {
                 fillEntryInfo(item, it->entry_info);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -13,6 +13,7 @@
 #include "nvs_types.hpp"
 #include "nvs_page.hpp"
 #include "nvs_pagemanager.hpp"
+#include "nvs_key_index.hpp"
 #include "nvs_memory_management.hpp"
 #include "partition.hpp"
 
@@ -56,6 +57,35 @@ class Storage : public intrusive_list_node<Storage>, public ExceptionlessAllocat
     typedef intrusive_list<BlobIndexNode> TBlobIndexList;
 
 public:
+    /**
+     * Item staged in RAM until it is written together with other items by writeItemBatch()
+     */
+    struct BatchItem : public intrusive_list_node<BatchItem>, public ExceptionlessAllocatable {
+        public:
+            ~BatchItem()
+            {
+                delete [] data;
+            }
+
+            char key[Item::MAX_KEY_LENGTH + 1];
+            ItemType datatype;
+            uint8_t* data = nullptr;
+            size_t dataSize;
+            bool hasPrevious;
+            bool needsWrite;
+    };
+
+    typedef intrusive_list<BatchItem> TBatchList;
+
+    /**
+     * State of a multi-page blob which is written in parts by writeBlobChunk()
+     */
+    struct BlobWriter {
+        VerOffset chunkStart = VerOffset::VER_ANY; // VER_ANY until the first part is written
+        uint8_t chunkCount = 0;
+        size_t dataSize = 0;
+    };
+
     ~Storage();
 
     Storage(Partition *partition) : mPartition(partition) {
@@ -74,6 +104,14 @@ public:
 
     esp_err_t readItem(uint8_t nsIndex, ItemType datatype, const char* key, void* data, size_t dataSize);
 
+    /**
+     * Write all items of the list to a single page and make them visible with one update of its
+     * entry state table. If an error is returned, none of the items was written.
+     *
+     * BLOB items are not supported. The items must fit on one page.
+     */
+    esp_err_t writeItemBatch(uint8_t nsIndex, TBatchList& items);
+
     esp_err_t findKey(const uint8_t nsIndex, const char* key, ItemType* datatype);
 
     esp_err_t getItemDataSize(uint8_t nsIndex, ItemType datatype, const char* key, size_t& dataSize);
@@ -122,6 +160,28 @@ public:
 
     esp_err_t eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffset chunkStart = VerOffset::VER_ANY);
 
+    /**
+     * Read dataSize bytes of a blob starting at offset, without reading the whole blob into RAM.
+     */
+    esp_err_t readBlobAt(uint8_t nsIndex, const char* key, size_t offset, void* data, size_t dataSize);
+
+    /**
+     * Append data to a new version of a blob. The data is written immediately, split into chunks
+     * where it does not fit the current page, but the blob keeps its previous value until
+     * commitBlob() writes the blob index.
+     */
+    esp_err_t writeBlobChunk(uint8_t nsIndex, const char* key, BlobWriter& writer, const void* data, size_t dataSize);
+
+    /**
+     * Write the index of the blob started by writeBlobChunk() and erase the previous version.
+     */
+    esp_err_t commitBlob(uint8_t nsIndex, const char* key, BlobWriter& writer);
+
+    /**
+     * Erase the chunks written by writeBlobChunk(), the blob keeps its previous value.
+     */
+    esp_err_t abortBlob(uint8_t nsIndex, const char* key, BlobWriter& writer);
+
     void debugDump();
 
     void debugCheck();
@@ -155,10 +215,22 @@ protected:
 
     esp_err_t findItem(uint8_t nsIndex, ItemType datatype, const char* key, Page* &page, Item& item, uint8_t chunkIdx = Page::CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
+    void populateKeyIndex();
+
+    size_t getMaxMultiPageBlobSize();
+
+    esp_err_t writeItemToCurrentPage(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx = Page::CHUNK_ANY);
+
+    static uint32_t keyIndexHash(uint8_t nsIndex, const char* key, uint8_t chunkIdx = Page::CHUNK_ANY)
+    {
+        return Item(nsIndex, ItemType::ANY, 0, key, chunkIdx).calculateCrc32WithoutValue() & 0xffffff;
+    }
+
 protected:
     Partition *mPartition;
     size_t mPageCount;
     PageManager mPageManager;
+    KeyIndex mKeyIndex;
     TNamespaces mNamespaces;
     CompressedEnumTable<bool, 1, 256> mNamespaceUsage;
     StorageState mState = StorageState::INVALID;
@@ -174,6 +246,15 @@ struct nvs_opaque_iterator_t
     nvs::Storage *storage;
     intrusive_list<nvs::Page>::iterator page;
     nvs_entry_info_t entry_info;
+    nvs::Page::ReadAhead readAhead;
+};
+
+struct nvs_opaque_blob_t
+{
+    nvs_handle_t handle;
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    nvs::Storage::BlobWriter writer;
+    bool failed;
 };
 
 #endif /* nvs_storage_hpp */
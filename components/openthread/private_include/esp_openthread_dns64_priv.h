@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief This function drops the cached NAT64 prefix, it is looked up again in the network data on the next use.
+ *
+ * @note This function is called by the OpenThread task when the network data has changed.
+ *
+ */
+void esp_openthread_dns64_netdata_changed(void);
+
+#ifdef __cplusplus
+}
+#endif
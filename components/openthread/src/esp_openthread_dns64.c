@@ -1,10 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "esp_openthread_dns64.h"
+#include "esp_openthread_dns64_priv.h"
 #include "esp_netif.h"
 #include "esp_netif_types.h"
 #include "esp_openthread_lock.h"
@@ -32,12 +33,28 @@ typedef struct dns_resolve_entry {
 
 static dns_resolve_entry_t s_dns_resolve_entry[DNS_TABLE_SIZE];
 
+/* The NAT64 prefix is looked up in the network data once per change, instead of taking the
+ * OpenThread lock for every resolution. The generation drops a lookup raced by a change. */
+static portMUX_TYPE s_nat64_prefix_lock = portMUX_INITIALIZER_UNLOCKED;
+static ip6_addr_t s_nat64_prefix;
+static esp_err_t s_nat64_prefix_err = ESP_ERR_INVALID_STATE; // not looked up yet
+static uint32_t s_nat64_prefix_generation;
+
 esp_err_t esp_openthread_dns64_client_init(void)
 {
     memset(s_dns_resolve_entry, 0, sizeof(s_dns_resolve_entry));
+    esp_openthread_dns64_netdata_changed();
     return ESP_OK;
 }
 
+void esp_openthread_dns64_netdata_changed(void)
+{
+    portENTER_CRITICAL(&s_nat64_prefix_lock);
+    s_nat64_prefix_err = ESP_ERR_INVALID_STATE;
+    s_nat64_prefix_generation++;
+    portEXIT_CRITICAL(&s_nat64_prefix_lock);
+}
+
 esp_err_t esp_openthread_get_dnsserver_addr_with_type(ip6_addr_t *dnsserver_addr,
                                                       esp_netif_dns_type_t dns_type)
 {
@@ -83,9 +100,22 @@ esp_err_t esp_openthread_get_nat64_prefix(ip6_addr_t *nat64_prefix)
     otNetworkDataIterator iter = OT_NETWORK_DATA_ITERATOR_INIT;
     otInstance *instance = esp_openthread_get_instance();
     otExternalRouteConfig route;
+    esp_err_t err;
+
+    portENTER_CRITICAL(&s_nat64_prefix_lock);
+    err = s_nat64_prefix_err;
+    if (err == ESP_OK) {
+        memcpy(nat64_prefix->addr, s_nat64_prefix.addr, sizeof(nat64_prefix->addr));
+    }
+    portEXIT_CRITICAL(&s_nat64_prefix_lock);
+    if (err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
 
     memset(&route, 0, sizeof(route));
     esp_openthread_task_switching_lock_acquire(portMAX_DELAY);
+    // the network data cannot change while the lock is held
+    uint32_t generation = s_nat64_prefix_generation;
     while (otNetDataGetNextRoute(instance, &iter, &route) == OT_ERROR_NONE) {
         if (route.mNat64) {
             break;
@@ -93,12 +123,18 @@ esp_err_t esp_openthread_get_nat64_prefix(ip6_addr_t *nat64_prefix)
     }
     esp_openthread_task_switching_lock_release();
 
-    if (route.mNat64) {
+    err = route.mNat64 ? ESP_OK : ESP_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_nat64_prefix_lock);
+    if (generation == s_nat64_prefix_generation) {
+        memcpy(s_nat64_prefix.addr, route.mPrefix.mPrefix.mFields.m8, sizeof(s_nat64_prefix.addr));
+        s_nat64_prefix_err = err;
+    }
+    portEXIT_CRITICAL(&s_nat64_prefix_lock);
+
+    if (err == ESP_OK) {
         memcpy(nat64_prefix->addr, route.mPrefix.mPrefix.mFields.m8, sizeof(nat64_prefix->addr));
-        return ESP_OK;
-    } else {
-        return ESP_ERR_NOT_FOUND;
     }
+    return err;
 }
 
 static void dns_found_handler(const char *name, const ip_addr_t *ipaddr, void *callback_arg)
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -40,7 +40,6 @@ const struct esp_netif_netstack_config g_esp_netif_netstack_default_openthread =
 
 static err_t openthread_output_ip6(struct netif *netif, struct pbuf *p, const struct ip6_addr *peer_addr)
 {
-    struct pbuf *q = p;
     esp_netif_t *esp_netif = esp_netif_get_handle_from_netif_impl(netif);
     esp_err_t ret = ESP_FAIL;
     if (!esp_netif) {
@@ -48,20 +47,8 @@ static err_t openthread_output_ip6(struct netif *netif, struct pbuf *p, const st
         return ERR_IF;
     }
 
-    if (q->next == NULL) {
-        ret = esp_netif_transmit(esp_netif, q->payload, q->len);
-    } else {
-        LWIP_DEBUGF(PBUF_DEBUG, ("low_level_output: pbuf is a list, application may has bug"));
-        q = pbuf_alloc(PBUF_RAW_TX, p->tot_len, PBUF_RAM);
-        if (q != NULL) {
-            pbuf_copy(q, p);
-        } else {
-            return ERR_MEM;
-        }
-        ret = esp_netif_transmit(esp_netif, q->payload, q->len);
-        /* content in payload has been copied to OpenThread queue, it's safe to free pbuf now */
-        pbuf_free(q);
-    }
+    /* The pbuf (or chain) is queued to the OpenThread task, which copies it into an OpenThread message */
+    ret = esp_netif_transmit_wrap(esp_netif, p->payload, p->tot_len, p);
     /* Check error */
     switch (ret) {
     case ESP_ERR_NO_MEM:
@@ -92,10 +79,15 @@ static void openthread_netif_input(void *h, void *buffer, size_t len, void *eb)
         return;
     }
 
-    if (unlikely(otMessageRead(message, 0, p->payload, len) != otMessageGetLength(message))) {
-        LWIP_DEBUGF(NETIF_DEBUG, ("Failed to read OpenThread message\n"));
-        pbuf_free(p);
-        return;
+    /* The pool pbufs may be chained for a full-sized packet */
+    uint16_t offset = 0;
+    for (struct pbuf *q = p; q != NULL; q = q->next) {
+        if (unlikely(otMessageRead(message, offset, q->payload, q->len) != q->len)) {
+            LWIP_DEBUGF(NETIF_DEBUG, ("Failed to read OpenThread message\n"));
+            pbuf_free(p);
+            return;
+        }
+        offset += q->len;
     }
 
     /* full packet send to tcpip_thread to process */
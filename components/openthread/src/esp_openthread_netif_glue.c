@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -28,6 +28,7 @@
 #include "common/code_utils.hpp"
 #include "config/link_quality.h"
 #include "freertos/FreeRTOS.h"
+#include "lwip/pbuf.h"
 #include "openthread/error.h"
 #include "openthread/icmp6.h"
 #include "openthread/instance.h"
@@ -46,6 +47,12 @@ static esp_openthread_netif_glue_t s_openthread_netif_glue = {
     .event_fd = -1,
 };
 
+/* Packet from the netif to be sent by the OpenThread task */
+typedef struct {
+    otMessage *message;     /* Message built by openthread_netif_transmit() */
+    struct pbuf *pbuf;      /* Or the lwIP packet, converted by the OpenThread task */
+} netif_packet_t;
+
 ESP_EVENT_DEFINE_BASE(OPENTHREAD_EVENT);
 
 static QueueHandle_t s_packet_queue;
@@ -140,15 +147,38 @@ static void process_thread_receive(otMessage *message, void *context)
     otMessageFree(message);
 }
 
+static otMessage *pbuf_to_message(struct pbuf *p)
+{
+    otMessage *message = otIp6NewMessage(esp_openthread_get_instance(), NULL);
+    if (message == NULL) {
+        ESP_LOGE(OT_PLAT_LOG_TAG, "Failed to allocate OpenThread message");
+        return NULL;
+    }
+    for (struct pbuf *q = p; q != NULL; q = q->next) {
+        otError ot_error = otMessageAppend(message, q->payload, q->len);
+        if (ot_error != OT_ERROR_NONE) {
+            ESP_LOGE(OT_PLAT_LOG_TAG, "Failed to copy to OpenThread message: %s", otThreadErrorToString(ot_error));
+            otMessageFree(message);
+            return NULL;
+        }
+    }
+    return message;
+}
+
 static esp_err_t process_thread_transmit(otInstance *instance)
 {
-    otMessage *msg = NULL;
+    netif_packet_t packet;
     esp_err_t error = ESP_OK;
     uint64_t event;
 
     int ret = read(s_openthread_netif_glue.event_fd, &event, sizeof(event));
     assert(ret == sizeof(event));
-    while (xQueueReceive(s_packet_queue, &msg, 0) == pdTRUE) {
+    while (xQueueReceive(s_packet_queue, &packet, 0) == pdTRUE) {
+        otMessage *msg = packet.message;
+        if (packet.pbuf) {
+            msg = pbuf_to_message(packet.pbuf);
+            pbuf_free(packet.pbuf);
+        }
         if (msg) {
             otError ot_error = otIp6Send(esp_openthread_get_instance(), msg);
             if (ot_error != OT_ERROR_NONE && ot_error != OT_ERROR_DROP) {
@@ -177,6 +207,7 @@ static esp_err_t openthread_netif_transmit(void *handle, void *buffer, size_t le
 {
     esp_err_t error = ESP_OK;
     otError ot_error = OT_ERROR_NONE;
+    netif_packet_t packet = { 0 };
 
     esp_openthread_task_switching_lock_acquire(portMAX_DELAY);
     otMessage *message = otIp6NewMessage(esp_openthread_get_instance(), NULL);
@@ -191,7 +222,8 @@ static esp_err_t openthread_netif_transmit(void *handle, void *buffer, size_t le
         ExitNow(error = ESP_ERR_NO_MEM);
     }
 
-    if (xQueueSend(s_packet_queue, &message, 0) != pdTRUE) {
+    packet.message = message;
+    if (xQueueSend(s_packet_queue, &packet, 0) != pdTRUE) {
         ESP_LOGE(OT_PLAT_LOG_TAG, "Failed to send to Thread netif: packet queue full");
         ExitNow(error = ESP_ERR_NO_MEM, ot_error = OT_ERROR_NO_BUFS);
     }
@@ -205,6 +237,38 @@ exit:
     return error;
 }
 
+/*
+ * Transmits an lwIP packet without taking the OpenThread lock: the packet is queued as is and copied into
+ * an OpenThread message by the OpenThread task, which holds the lock anyway, instead of making the lwIP
+ * task wait for the OpenThread task to release the lock for every packet.
+ */
+static esp_err_t openthread_netif_transmit_wrap(void *handle, void *buffer, size_t len, void *netstack_buffer)
+{
+    struct pbuf *p = (struct pbuf *)netstack_buffer;
+    if (p == NULL) {
+        return openthread_netif_transmit(handle, buffer, len);
+    }
+
+    netif_packet_t packet = { 0 };
+    if (PBUF_NEEDS_COPY(p)) {
+        // the payload may be changed by the sender after returning, e.g. PBUF_REF
+        packet.pbuf = pbuf_clone(PBUF_RAW, PBUF_RAM, p);
+        if (packet.pbuf == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    } else {
+        pbuf_ref(p);
+        packet.pbuf = p;
+    }
+
+    if (xQueueSend(s_packet_queue, &packet, 0) != pdTRUE) {
+        ESP_LOGE(OT_PLAT_LOG_TAG, "Failed to send to Thread netif: packet queue full");
+        pbuf_free(packet.pbuf);
+        return ESP_ERR_NO_MEM;
+    }
+    return notify_packets_pending();
+}
+
 static esp_event_handler_t meshcop_e_publish_handler = NULL;
 static void esp_openthread_meshcop_e_publish_handler(void *args, esp_event_base_t base, int32_t event_id, void *data)
 {
@@ -290,7 +354,10 @@ static esp_err_t openthread_netif_post_attach(esp_netif_t *esp_netif, void *args
 
     // set driver related config to esp-netif
     esp_netif_driver_ifconfig_t driver_ifconfig = {
-        .handle = &s_openthread_netif_glue, .transmit = openthread_netif_transmit, .driver_free_rx_buffer = NULL};
+        .handle = &s_openthread_netif_glue,
+        .transmit = openthread_netif_transmit,
+        .transmit_wrap = openthread_netif_transmit_wrap,
+        .driver_free_rx_buffer = NULL};
 
     ESP_ERROR_CHECK(esp_netif_set_driver_config(esp_netif, &driver_ifconfig));
 
@@ -313,7 +380,7 @@ void *esp_openthread_netif_glue_init(const esp_openthread_platform_config_t *con
         return NULL;
     }
 
-    s_packet_queue = xQueueCreate(config->port_config.netif_queue_size, sizeof(otMessage *));
+    s_packet_queue = xQueueCreate(config->port_config.netif_queue_size, sizeof(netif_packet_t));
     if (s_packet_queue == NULL) {
         ESP_LOGE(OT_PLAT_LOG_TAG, "Failed to allocate Thread netif packet queue");
         ExitNow(error = ESP_ERR_NO_MEM);
@@ -346,6 +413,13 @@ void esp_openthread_netif_glue_deinit(void)
     otIp6SetAddressCallback(instance, NULL, NULL);
     otIp6SetReceiveCallback(instance, NULL, NULL);
     if (s_packet_queue) {
+        // the messages belong to the OpenThread message pool, but the lwIP packets have to be returned
+        netif_packet_t packet;
+        while (xQueueReceive(s_packet_queue, &packet, 0) == pdTRUE) {
+            if (packet.pbuf) {
+                pbuf_free(packet.pbuf);
+            }
+        }
         vQueueDelete(s_packet_queue);
         s_packet_queue = NULL;
     }
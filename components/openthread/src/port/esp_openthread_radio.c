@@ -733,8 +733,11 @@ void IRAM_ATTR esp_ieee802154_receive_done(uint8_t *data, esp_ieee802154_frame_i
     s_with_security_enh_ack = false;
 #endif // OPENTHREAD_CONFIG_THREAD_VERSION >= OT_THREAD_VERSION_1_2
     s_recv_queue.tail = (s_recv_queue.tail + 1) % CONFIG_IEEE802154_RX_BUFFER_SIZE;
-    atomic_fetch_add(&s_recv_queue.used, 1);
-    set_event(EVENT_RX_DONE);
+    // esp_openthread_radio_process() delivers all the queued frames: only wake it up for the first one,
+    // the frames received before it runs are delivered in the same batch.
+    if (atomic_fetch_add(&s_recv_queue.used, 1) == 0) {
+        set_event(EVENT_RX_DONE);
+    }
 }
 
 void IRAM_ATTR esp_ieee802154_transmit_failed(const uint8_t *frame, esp_ieee802154_tx_error_t error)
@@ -11,6 +11,7 @@
 #include <esp_event.h>
 #include <esp_log.h>
 #include <esp_openthread_dns64.h>
+#include <esp_openthread_dns64_priv.h>
 #include <esp_openthread_netif_glue_priv.h>
 #include <esp_openthread_radio.h>
 #include <esp_openthread_state.h>
@@ -37,6 +38,7 @@ static void handle_ot_netif_state_change(otInstance* instance)
 static void handle_ot_netdata_change(void)
 {
 #if CONFIG_OPENTHREAD_DNS64_CLIENT
+    esp_openthread_dns64_netdata_changed();
     ip6_addr_t dns_server_addr = *IP6_ADDR_ANY6;
     if (esp_openthread_get_nat64_prefix(&dns_server_addr) == ESP_OK) {
         dns_server_addr.addr[3] = ipaddr_addr(CONFIG_OPENTHREAD_DNS_SERVER_ADDR);
@@ -0,0 +1,319 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "sdkconfig.h"
+#include "soc/soc_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_bit_defs.h"
+#include "esp_check.h"
+#include "esp_cpu.h"
+#include "esp_perfmon.h"
+#if __XTENSA__
+#include "xtensa_perfmon_access.h"
+#include "xtensa/xt_perf_consts.h"
+#include "xtensa-debug-module.h"
+#else
+#include "riscv/rv_utils.h"
+#endif
+#if SOC_CACHE_ACS_CNT_SUPPORTED
+#include "hal/cache_ll.h"
+#endif
+
+static const char *TAG = "perfmon";
+
+static const char *const s_event_names[ESP_PERFMON_EVENT_MAX] = {
+    [ESP_PERFMON_EVENT_CYCLES] = "CYCLES",
+    [ESP_PERFMON_EVENT_INSTRUCTIONS] = "INSTRUCTIONS",
+    [ESP_PERFMON_EVENT_LOADS] = "LOADS",
+    [ESP_PERFMON_EVENT_STORES] = "STORES",
+    [ESP_PERFMON_EVENT_BRANCHES_TAKEN] = "BRANCHES_TAKEN",
+    [ESP_PERFMON_EVENT_DATA_STALLS] = "DATA_STALLS",
+    [ESP_PERFMON_EVENT_ICACHE_MISS_STALLS] = "ICACHE_MISS_STALLS",
+    [ESP_PERFMON_EVENT_DCACHE_MISS_STALLS] = "DCACHE_MISS_STALLS",
+};
+
+#if __XTENSA__ || SOC_CPU_HAS_CSR_PC
+/* The core has a single counter for all the events, only accessed by the core itself with its interrupts masked */
+#define PERFMON_EXCLUSIVE_COUNTER 1
+static bool s_counter_used[portNUM_PROCESSORS];
+#endif
+
+#if __XTENSA__
+/* Counter 0 of the Xtensa performance monitor, counting at all the interrupt levels */
+static const struct {
+    uint16_t select;
+    uint16_t mask;
+} s_xtensa_events[ESP_PERFMON_EVENT_MAX] = {
+    [ESP_PERFMON_EVENT_CYCLES] = { XTPERF_CNT_CYCLES, XTPERF_MASK_CYCLES },
+    [ESP_PERFMON_EVENT_INSTRUCTIONS] = { XTPERF_CNT_INSN, XTPERF_MASK_INSN_ALL },
+    [ESP_PERFMON_EVENT_LOADS] = { XTPERF_CNT_D_LOAD_U1, XTPERF_MASK_D_LOAD_ALL },
+    [ESP_PERFMON_EVENT_STORES] = { XTPERF_CNT_D_STORE_U1, XTPERF_MASK_D_STORE_ALL },
+    [ESP_PERFMON_EVENT_BRANCHES_TAKEN] = { XTPERF_CNT_INSN, XTPERF_MASK_INSN_BRANCH_TAKEN },
+    [ESP_PERFMON_EVENT_DATA_STALLS] = { XTPERF_CNT_D_STALL, XTPERF_MASK_D_STALL_ALL },
+    [ESP_PERFMON_EVENT_ICACHE_MISS_STALLS] = { XTPERF_CNT_I_STALL, XTPERF_MASK_I_STALL_CACHE_MISS },
+    [ESP_PERFMON_EVENT_DCACHE_MISS_STALLS] = { XTPERF_CNT_D_STALL, XTPERF_MASK_D_STALL_CACHE_MISS },
+};
+#elif SOC_CPU_HAS_CSR_PC
+/* Events selected in the machine performance counter event register, 0 if not supported */
+static const uint32_t s_pcer_events[ESP_PERFMON_EVENT_MAX] = {
+    [ESP_PERFMON_EVENT_CYCLES] = BIT(0),
+    [ESP_PERFMON_EVENT_INSTRUCTIONS] = BIT(1),
+    [ESP_PERFMON_EVENT_LOADS] = BIT(5),
+    [ESP_PERFMON_EVENT_STORES] = BIT(6),
+    [ESP_PERFMON_EVENT_BRANCHES_TAKEN] = BIT(9),
+    [ESP_PERFMON_EVENT_DATA_STALLS] = BIT(2),
+};
+#define PCMR_COUNT_ENABLE BIT(0)
+#endif
+
+#if SOC_CACHE_ACS_CNT_SUPPORTED
+/* The enable and clear bits of all the buses share the control registers */
+static portMUX_TYPE s_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool s_cache_counter_used[portNUM_PROCESSORS];
+#endif
+
+bool esp_perfmon_event_is_supported(esp_perfmon_event_t event)
+{
+    if ((unsigned)event >= ESP_PERFMON_EVENT_MAX) {
+        return false;
+    }
+#if __XTENSA__
+    return true;
+#elif SOC_CPU_HAS_CSR_PC
+    return s_pcer_events[event] != 0;
+#else
+    /* Only the standard mcycle and minstret counters */
+    return event == ESP_PERFMON_EVENT_CYCLES || event == ESP_PERFMON_EVENT_INSTRUCTIONS;
+#endif
+}
+
+const char *esp_perfmon_event_to_name(esp_perfmon_event_t event)
+{
+    if ((unsigned)event >= ESP_PERFMON_EVENT_MAX) {
+        return "UNKNOWN";
+    }
+    return s_event_names[event];
+}
+
+FORCE_INLINE_ATTR uint32_t perfmon_read_counter(esp_perfmon_event_t event)
+{
+#if __XTENSA__
+    return xtensa_perfmon_value(0);
+#elif SOC_CPU_HAS_CSR_PC
+    return RV_READ_CSR(CSR_PCCR_MACHINE);
+#else
+    if (event == ESP_PERFMON_EVENT_CYCLES) {
+        return RV_READ_CSR(mcycle);
+    }
+    return RV_READ_CSR(minstret);
+#endif
+}
+
+/* The functions below do not log: they are also called by the benchmark with the scheduler suspended */
+static esp_err_t perfmon_region_begin(esp_perfmon_region_t *region, esp_perfmon_event_t event)
+{
+    uint32_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    int core_id = esp_cpu_get_core_id();
+#if PERFMON_EXCLUSIVE_COUNTER
+    if (s_counter_used[core_id]) {
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_counter_used[core_id] = true;
+#endif
+#if __XTENSA__
+    xtensa_perfmon_stop();
+    xtensa_perfmon_init(0, s_xtensa_events[event].select, s_xtensa_events[event].mask, 0, PMCTRL_TRACELEVEL_MASK);
+    xtensa_perfmon_start();
+#elif SOC_CPU_HAS_CSR_PC
+    /* The counter keeps its value, so the cycle count only runs slower while another event is counted */
+    region->saved[0] = RV_READ_CSR(CSR_PCER_MACHINE);
+    region->saved[1] = RV_READ_CSR(CSR_PCMR_MACHINE);
+    RV_WRITE_CSR(CSR_PCER_MACHINE, s_pcer_events[event]);
+    RV_WRITE_CSR(CSR_PCMR_MACHINE, PCMR_COUNT_ENABLE);
+#endif
+    region->event = event;
+    region->core_id = core_id;
+    region->active = true;
+    region->start = perfmon_read_counter(event);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+    return ESP_OK;
+}
+
+static esp_err_t perfmon_region_end(esp_perfmon_region_t *region, uint32_t *count)
+{
+    uint32_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    uint32_t value = perfmon_read_counter(region->event);
+    if (region->core_id != esp_cpu_get_core_id()) {
+        /* the counter of the other core stays reserved, only a task running on it could release it */
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+        return ESP_ERR_INVALID_STATE;
+    }
+#if __XTENSA__
+    xtensa_perfmon_stop();
+#elif SOC_CPU_HAS_CSR_PC
+    RV_WRITE_CSR(CSR_PCER_MACHINE, region->saved[0]);
+    RV_WRITE_CSR(CSR_PCMR_MACHINE, region->saved[1]);
+#endif
+#if PERFMON_EXCLUSIVE_COUNTER
+    s_counter_used[region->core_id] = false;
+#endif
+    region->active = false;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+
+    *count = value - region->start;
+    return ESP_OK;
+}
+
+#if SOC_CACHE_ACS_CNT_SUPPORTED
+static esp_err_t perfmon_cache_begin(void)
+{
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL_SAFE(&s_cache_lock);
+    int core_id = esp_cpu_get_core_id();
+    if (s_cache_counter_used[core_id]) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        s_cache_counter_used[core_id] = true;
+        cache_ll_l1_clear_access_counter(core_id);
+        cache_ll_l2_clear_access_counter(core_id);
+        cache_ll_l1_enable_access_counter(core_id, true);
+        cache_ll_l2_enable_access_counter(core_id, true);
+    }
+    portEXIT_CRITICAL_SAFE(&s_cache_lock);
+    return ret;
+}
+
+static esp_err_t perfmon_cache_end(esp_perfmon_cache_stats_t *stats)
+{
+    esp_err_t ret = ESP_OK;
+    uint32_t l2_ibus_hits = 0;
+    uint32_t l2_ibus_misses = 0;
+    portENTER_CRITICAL_SAFE(&s_cache_lock);
+    int core_id = esp_cpu_get_core_id();
+    if (!s_cache_counter_used[core_id]) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        cache_ll_l1_get_access_counter(core_id, CACHE_TYPE_INSTRUCTION, &stats->icache_hits, &stats->icache_misses);
+        cache_ll_l1_get_access_counter(core_id, CACHE_TYPE_DATA, &stats->dcache_hits, &stats->dcache_misses);
+        cache_ll_l2_get_access_counter(core_id, CACHE_TYPE_INSTRUCTION, &l2_ibus_hits, &l2_ibus_misses);
+        cache_ll_l2_get_access_counter(core_id, CACHE_TYPE_DATA, &stats->l2_hits, &stats->l2_misses);
+        cache_ll_l1_enable_access_counter(core_id, false);
+        cache_ll_l2_enable_access_counter(core_id, false);
+        s_cache_counter_used[core_id] = false;
+    }
+    portEXIT_CRITICAL_SAFE(&s_cache_lock);
+    if (ret == ESP_OK) {
+        stats->l2_hits += l2_ibus_hits;
+        stats->l2_misses += l2_ibus_misses;
+    }
+    return ret;
+}
+#endif
+
+esp_err_t esp_perfmon_region_begin(esp_perfmon_region_t *region, esp_perfmon_event_t event)
+{
+    ESP_RETURN_ON_FALSE(region, ESP_ERR_INVALID_ARG, TAG, "region is NULL");
+    region->active = false;
+    ESP_RETURN_ON_FALSE((unsigned)event < ESP_PERFMON_EVENT_MAX, ESP_ERR_INVALID_ARG, TAG, "invalid event");
+    ESP_RETURN_ON_FALSE(esp_perfmon_event_is_supported(event), ESP_ERR_NOT_SUPPORTED, TAG, "%s not supported", s_event_names[event]);
+    ESP_RETURN_ON_ERROR(perfmon_region_begin(region, event), TAG, "counter of the core already used");
+    return ESP_OK;
+}
+
+esp_err_t esp_perfmon_region_end(esp_perfmon_region_t *region, uint32_t *count)
+{
+    ESP_RETURN_ON_FALSE(region && count, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    *count = 0;
+    ESP_RETURN_ON_FALSE(region->active, ESP_ERR_INVALID_STATE, TAG, "region not begun");
+    ESP_RETURN_ON_ERROR(perfmon_region_end(region, count), TAG, "region begun on core %d", region->core_id);
+    return ESP_OK;
+}
+
+esp_err_t esp_perfmon_cache_begin(void)
+{
+#if SOC_CACHE_ACS_CNT_SUPPORTED
+    ESP_RETURN_ON_ERROR(perfmon_cache_begin(), TAG, "cache counters of the core already used");
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_perfmon_cache_end(esp_perfmon_cache_stats_t *stats)
+{
+#if SOC_CACHE_ACS_CNT_SUPPORTED
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "stats is NULL");
+    ESP_RETURN_ON_ERROR(perfmon_cache_end(stats), TAG, "cache counters of the core not started");
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static esp_err_t perfmon_benchmark_count(void (*func)(void *arg), void *arg, uint32_t repeat, esp_perfmon_event_t event, uint32_t *count)
+{
+    esp_perfmon_region_t region;
+    esp_err_t err = perfmon_region_begin(&region, event);
+    if (err != ESP_OK) {
+        return err;
+    }
+    for (uint32_t i = 0; i < repeat; i++) {
+        func(arg);
+    }
+    return perfmon_region_end(&region, count);
+}
+
+static float perfmon_hit_rate(uint32_t hits, uint32_t misses)
+{
+    if (hits + misses == 0) {
+        return 0;
+    }
+    return (float)hits / ((float)hits + (float)misses);
+}
+
+esp_err_t esp_perfmon_benchmark(void (*func)(void *arg), void *arg, uint32_t repeat, esp_perfmon_benchmark_result_t *result)
+{
+    ESP_RETURN_ON_FALSE(func && repeat > 0 && result, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    uint32_t cycles = 0;
+    uint32_t instructions = 0;
+    esp_err_t err;
+
+    memset(result, 0, sizeof(*result));
+    /* keep the task on this core and measure it alone */
+    vTaskSuspendAll();
+#if SOC_CACHE_ACS_CNT_SUPPORTED
+    err = perfmon_cache_begin();
+    if (err == ESP_OK) {
+        err = perfmon_benchmark_count(func, arg, repeat, ESP_PERFMON_EVENT_CYCLES, &cycles);
+        esp_err_t cache_err = perfmon_cache_end(&result->cache);
+        if (err == ESP_OK) {
+            err = cache_err;
+        }
+    }
+#else
+    err = perfmon_benchmark_count(func, arg, repeat, ESP_PERFMON_EVENT_CYCLES, &cycles);
+#endif
+    if (err == ESP_OK && esp_perfmon_event_is_supported(ESP_PERFMON_EVENT_INSTRUCTIONS)) {
+        err = perfmon_benchmark_count(func, arg, repeat, ESP_PERFMON_EVENT_INSTRUCTIONS, &instructions);
+    }
+    xTaskResumeAll();
+    ESP_RETURN_ON_ERROR(err, TAG, "counters of the core already used");
+
+    result->cycles = cycles / repeat;
+    result->instructions = instructions / repeat;
+    result->ipc = cycles ? (float)instructions / (float)cycles : 0;
+#if SOC_CACHE_ACS_CNT_SUPPORTED
+    result->has_cache_stats = true;
+    result->icache_hit_rate = perfmon_hit_rate(result->cache.icache_hits, result->cache.icache_misses);
+    result->dcache_hit_rate = perfmon_hit_rate(result->cache.dcache_hits, result->cache.dcache_misses);
+    result->l2_hit_rate = perfmon_hit_rate(result->cache.l2_hits, result->cache.l2_misses);
+#endif
+    return ESP_OK;
+}
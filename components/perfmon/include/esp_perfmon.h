@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Events counted by the CPU performance counters
+ *
+ * The events which are not supported by the CPU of the target are reported by esp_perfmon_event_is_supported().
+ */
+typedef enum {
+    ESP_PERFMON_EVENT_CYCLES,               /*!< CPU cycles */
+    ESP_PERFMON_EVENT_INSTRUCTIONS,         /*!< Retired instructions */
+    ESP_PERFMON_EVENT_LOADS,                /*!< Load instructions */
+    ESP_PERFMON_EVENT_STORES,               /*!< Store instructions */
+    ESP_PERFMON_EVENT_BRANCHES_TAKEN,       /*!< Taken conditional branches */
+    ESP_PERFMON_EVENT_DATA_STALLS,          /*!< Cycles stalled on data accesses, load-use hazards on RISC-V */
+    ESP_PERFMON_EVENT_ICACHE_MISS_STALLS,   /*!< Cycles stalled on ICache misses */
+    ESP_PERFMON_EVENT_DCACHE_MISS_STALLS,   /*!< Cycles stalled on DCache misses */
+    ESP_PERFMON_EVENT_MAX,                  /*!< Number of events */
+} esp_perfmon_event_t;
+
+/**
+ * @brief Measure region, see esp_perfmon_region_begin()
+ *
+ * @note The members are private, they must not be accessed by the application.
+ */
+typedef struct {
+    esp_perfmon_event_t event;  /*!< Counted event */
+    int core_id;                /*!< Core the region has begun on */
+    bool active;                /*!< Whether the region has begun successfully and has not ended yet */
+    uint32_t start;             /*!< Value of the counter when the region began */
+    uint32_t saved[2];          /*!< Counter configuration restored when the region ends */
+} esp_perfmon_region_t;
+
+/**
+ * @brief Cache access statistics of the buses of a core
+ */
+typedef struct {
+    uint32_t icache_hits;       /*!< Instruction fetches which hit the L1 ICache */
+    uint32_t icache_misses;     /*!< Instruction fetches which missed the L1 ICache */
+    uint32_t dcache_hits;       /*!< Loads and stores which hit the L1 DCache */
+    uint32_t dcache_misses;     /*!< Loads and stores which missed the L1 DCache */
+    uint32_t l2_hits;           /*!< Accesses of the core which hit the L2 Cache */
+    uint32_t l2_misses;         /*!< Accesses of the core which missed the L2 Cache */
+} esp_perfmon_cache_stats_t;
+
+/**
+ * @brief Result of esp_perfmon_benchmark()
+ */
+typedef struct {
+    uint32_t cycles;                    /*!< Average CPU cycles per call */
+    uint32_t instructions;              /*!< Average retired instructions per call, 0 if not supported */
+    float ipc;                          /*!< Instructions per cycle, 0 if not supported */
+    bool has_cache_stats;               /*!< Whether the cache statistics below are valid */
+    esp_perfmon_cache_stats_t cache;    /*!< Cache accesses of all the calls */
+    float icache_hit_rate;              /*!< L1 ICache hit rate, between 0 and 1 */
+    float dcache_hit_rate;              /*!< L1 DCache hit rate, between 0 and 1 */
+    float l2_hit_rate;                  /*!< L2 Cache hit rate, between 0 and 1 */
+} esp_perfmon_benchmark_result_t;
+
+/**
+ * @brief Check whether an event can be counted on this target
+ *
+ * @param[in] event Event
+ *
+ * @return True if the event is supported
+ */
+bool esp_perfmon_event_is_supported(esp_perfmon_event_t event);
+
+/**
+ * @brief Get the name of an event
+ *
+ * @param[in] event Event
+ *
+ * @return Name of the event, "UNKNOWN" if the event is invalid
+ */
+const char *esp_perfmon_event_to_name(esp_perfmon_event_t event);
+
+/**
+ * @brief Begin counting an event on the current core
+ *
+ * The counters are those of the core the calling task runs on, they also count the events of the interrupts
+ * served, and of the tasks scheduled, on this core until esp_perfmon_region_end() is called. The task should not
+ * block in the region, and must not be moved to another core, e.g. it is pinned or the scheduler is suspended.
+ *
+ * Except for ESP_PERFMON_EVENT_CYCLES and ESP_PERFMON_EVENT_INSTRUCTIONS on the RISC-V chips which have
+ * free running counters for them, the region reconfigures the only counter of the core which is then used
+ * exclusively: regions counting those events cannot be nested on one core, and the counter must not be
+ * used through another API (e.g., xtensa_perfmon_exec()) meanwhile. On the RISC-V chips where the cycle counter
+ * is shared with the other events, esp_cpu_get_cycle_count() counts the event of the region instead of the cycles
+ * until the region ends.
+ *
+ * The counters are 32 bits wide: a region must count less than 2^32 events.
+ *
+ * @param[out] region  Region, to be passed to esp_perfmon_region_end()
+ * @param[in]  event   Event to count
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_NOT_SUPPORTED if the event cannot be counted on this target
+ *      - ESP_ERR_INVALID_STATE if the counter of the core is already used by another region
+ */
+esp_err_t esp_perfmon_region_begin(esp_perfmon_region_t *region, esp_perfmon_event_t event);
+
+/**
+ * @brief End counting the event of a region
+ *
+ * @param[in,out] region  Region begun by esp_perfmon_region_begin()
+ * @param[out]    count   Number of events counted since the region began, 0 on error
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the region has not begun successfully, or has begun on another core
+ */
+esp_err_t esp_perfmon_region_end(esp_perfmon_region_t *region, uint32_t *count);
+
+/**
+ * @brief Count an event during the statement or block which follows
+ *
+ * @code{c}
+ * uint32_t cycles;
+ * ESP_PERFMON_MEASURE(ESP_PERFMON_EVENT_CYCLES, &cycles) {
+ *     do_work();
+ * }
+ * @endcode
+ *
+ * The block runs once, even if the region could not begin, in which case the count is 0. The block must not be
+ * left with ``break``, ``return`` or ``goto``, as the region would not end. The same rules as for
+ * esp_perfmon_region_begin() apply.
+ *
+ * @param event  Event to count
+ * @param count  Pointer to a uint32_t receiving the number of events counted by the block
+ */
+#define ESP_PERFMON_MEASURE(event, count)                                                                   \
+    for (esp_perfmon_region_t _esp_perfmon_region, *_esp_perfmon_once = &_esp_perfmon_region;               \
+         _esp_perfmon_once != NULL && (esp_perfmon_region_begin(_esp_perfmon_once, (event)), true);         \
+         (void)esp_perfmon_region_end(_esp_perfmon_once, (count)), _esp_perfmon_once = NULL)
+
+/**
+ * @brief Clear and start the cache access counters of the buses of the current core
+ *
+ * Only supported by the chips with cache access counters (ESP32-P4). The counters count the accesses of all the code
+ * which runs on the core until esp_perfmon_cache_end() is called. Like a region, the measure is exclusive on each core
+ * and the task must not be moved to another core meanwhile.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_SUPPORTED if the chip has no cache access counters
+ *      - ESP_ERR_INVALID_STATE if the counters of the core are already started
+ */
+esp_err_t esp_perfmon_cache_begin(void);
+
+/**
+ * @brief Stop the cache access counters of the current core and get their values
+ *
+ * @param[out] stats  Cache access statistics since esp_perfmon_cache_begin()
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if the chip has no cache access counters
+ *      - ESP_ERR_INVALID_STATE if the counters of the core are not started
+ */
+esp_err_t esp_perfmon_cache_end(esp_perfmon_cache_stats_t *stats);
+
+/**
+ * @brief Measure the cycles, instructions and cache accesses of a function
+ *
+ * The function is called ``repeat`` times for each CPU event counted, the cache access counters, when supported,
+ * are read during the calls measuring the cycles. The scheduler of the current core is suspended during the
+ * measure, so the function must not block. Interrupts are still served and are measured as part of the function.
+ * Call the function once before to measure it with warm caches.
+ *
+ * @param[in]  func    Function to measure
+ * @param[in]  arg     Argument of the function
+ * @param[in]  repeat  Number of calls per event, the results are the averages of the calls
+ * @param[out] result  Result of the measure
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid
+ *      - ESP_ERR_INVALID_STATE if the counters of the core are already used
+ */
+esp_err_t esp_perfmon_benchmark(void (*func)(void *arg), void *arg, uint32_t repeat, esp_perfmon_benchmark_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
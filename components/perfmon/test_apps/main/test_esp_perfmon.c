@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "soc/soc_caps.h"
+#include "unity.h"
+#include "esp_perfmon.h"
+
+static volatile uint32_t s_sink;
+
+static void test_loop(void *arg)
+{
+    int iterations = (int)arg;
+    for (int i = 0; i < iterations; i++) {
+        s_sink += i;
+    }
+}
+
+TEST_CASE("esp_perfmon region counts more events for a longer loop", "[esp_perfmon]")
+{
+    for (esp_perfmon_event_t event = 0; event < ESP_PERFMON_EVENT_MAX; event++) {
+        uint32_t short_count;
+        uint32_t long_count;
+        esp_perfmon_region_t region;
+
+        if (!esp_perfmon_event_is_supported(event)) {
+            TEST_ESP_ERR(ESP_ERR_NOT_SUPPORTED, esp_perfmon_region_begin(&region, event));
+            continue;
+        }
+        vTaskSuspendAll();
+        ESP_PERFMON_MEASURE(event, &short_count) {
+            test_loop((void *)100);
+        }
+        ESP_PERFMON_MEASURE(event, &long_count) {
+            test_loop((void *)1000);
+        }
+        xTaskResumeAll();
+        printf("%s: %"PRIu32" / %"PRIu32"\n", esp_perfmon_event_to_name(event), short_count, long_count);
+        if (event != ESP_PERFMON_EVENT_ICACHE_MISS_STALLS && event != ESP_PERFMON_EVENT_DCACHE_MISS_STALLS &&
+                event != ESP_PERFMON_EVENT_DATA_STALLS) {
+            // the stalls may not happen at all in a loop running from the cache or internal memory
+            TEST_ASSERT_GREATER_THAN_UINT32(short_count, long_count);
+        }
+    }
+    TEST_ASSERT_TRUE(esp_perfmon_event_is_supported(ESP_PERFMON_EVENT_CYCLES));
+    TEST_ASSERT_FALSE(esp_perfmon_event_is_supported(ESP_PERFMON_EVENT_MAX));
+}
+
+TEST_CASE("esp_perfmon region errors", "[esp_perfmon]")
+{
+    esp_perfmon_region_t region;
+    uint32_t count = 1;
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_perfmon_region_begin(&region, ESP_PERFMON_EVENT_MAX));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_perfmon_region_end(&region, &count));
+    TEST_ASSERT_EQUAL_UINT32(0, count);
+
+    // the tests run in the main task, which is pinned to a core
+    TEST_ESP_OK(esp_perfmon_region_begin(&region, ESP_PERFMON_EVENT_INSTRUCTIONS));
+#if CONFIG_IDF_TARGET_ARCH_XTENSA || SOC_CPU_HAS_CSR_PC
+    // the only counter of the core is used by the first region
+    esp_perfmon_region_t nested;
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_perfmon_region_begin(&nested, ESP_PERFMON_EVENT_CYCLES));
+#endif
+    TEST_ESP_OK(esp_perfmon_region_end(&region, &count));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, count);
+}
+
+TEST_CASE("esp_perfmon benchmark reports IPC and cache statistics", "[esp_perfmon]")
+{
+    esp_perfmon_benchmark_result_t result;
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_perfmon_benchmark(test_loop, (void *)100, 0, &result));
+    test_loop((void *)100);
+    TEST_ESP_OK(esp_perfmon_benchmark(test_loop, (void *)100, 10, &result));
+    printf("cycles %"PRIu32", instructions %"PRIu32", IPC %.2f\n", result.cycles, result.instructions, result.ipc);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(100, result.cycles);
+    TEST_ASSERT_GREATER_THAN_UINT32(100, result.instructions);
+    TEST_ASSERT_TRUE(result.ipc > 0 && result.ipc <= 2);
+#if SOC_CACHE_ACS_CNT_SUPPORTED
+    printf("ICache %.3f, DCache %.3f, L2 %.3f\n", result.icache_hit_rate, result.dcache_hit_rate, result.l2_hit_rate);
+    TEST_ASSERT_TRUE(result.has_cache_stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, result.cache.icache_hits + result.cache.icache_misses);
+    TEST_ASSERT_TRUE(result.icache_hit_rate > 0.5);
+#else
+    TEST_ASSERT_FALSE(result.has_cache_stats);
+    esp_perfmon_cache_stats_t stats;
+    TEST_ESP_ERR(ESP_ERR_NOT_SUPPORTED, esp_perfmon_cache_begin());
+    TEST_ESP_ERR(ESP_ERR_NOT_SUPPORTED, esp_perfmon_cache_end(&stats));
+#endif
+}
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Defined in protobuf-c.h */
+struct ProtobufCAllocator;
+
+/**
+ * @brief   Arena for unpacking one protobuf-c request message
+ *
+ * protobuf-c allocates each message, field, string and repeated element of an
+ * unpacked message separately. The arena serves these allocations from a single
+ * buffer sized after the packed message, so a request costs one heap allocation.
+ * Allocations not fitting in the buffer fall back to the heap.
+ *
+ * Typical use in a protocomm endpoint handler:
+ *
+ * @code{c}
+ * protocomm_pb_arena_t *arena = protocomm_pb_arena_create(inlen);
+ * struct ProtobufCAllocator *allocator = protocomm_pb_arena_get_allocator(arena);
+ * SessionData *req = session_data__unpack(allocator, inlen, inbuf);
+ * ...
+ * session_data__free_unpacked(req, allocator);
+ * protocomm_pb_arena_delete(arena);
+ * @endcode
+ */
+typedef struct protocomm_pb_arena protocomm_pb_arena_t;
+
+/**
+ * @brief   Create an arena for unpacking a message
+ *
+ * The buffer size is the packed message length plus CONFIG_ESP_PROTOCOMM_PB_ARENA_EXTRA_SIZE
+ * bytes for the message structures.
+ *
+ * @param[in] packed_len  Length of the packed message
+ *
+ * @return
+ *  - Arena
+ *  - NULL if CONFIG_ESP_PROTOCOMM_PB_ARENA_EXTRA_SIZE is 0 or on allocation failure.
+ *    The functions of this API accept NULL, unpacking then uses the default allocator.
+ */
+protocomm_pb_arena_t *protocomm_pb_arena_create(size_t packed_len);
+
+/**
+ * @brief   Get the protobuf-c allocator of an arena
+ *
+ * @param[in] arena  Arena, may be NULL
+ *
+ * @return
+ *  - Allocator to pass to the unpack and free_unpacked functions
+ *  - NULL if arena is NULL, which selects the default allocator of protobuf-c
+ */
+struct ProtobufCAllocator *protocomm_pb_arena_get_allocator(protocomm_pb_arena_t *arena);
+
+/**
+ * @brief   Delete an arena
+ *
+ * The message unpacked in the arena must be freed with its free_unpacked function before,
+ * which releases the allocations that fell back to the heap.
+ *
+ * @param[in] arena  Arena, may be NULL
+ */
+void protocomm_pb_arena_delete(protocomm_pb_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
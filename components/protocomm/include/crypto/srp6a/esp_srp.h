@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -187,6 +187,23 @@ esp_err_t esp_srp_gen_salt_verifier(const char *username, int username_len,
 esp_err_t esp_srp_set_salt_verifier(esp_srp_handle_t *hd, const char *salt, int salt_len,
                                     const char *verifier, int verifier_len);
 
+/**
+ * @brief   Compute the server's private ephemeral b and g^b in advance
+ *
+ * These do not depend on the salt and verifier, and g^b is the most expensive part of
+ * computing B. Calling this function before the client's request, e.g. from a low priority
+ * task, leaves only kv + g^b to be computed by esp_srp_srv_pubkey() and
+ * esp_srp_srv_pubkey_from_salt_verifier().
+ *
+ * @param hd        esp_srp handle
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_INVALID_ARG: the handle is NULL
+ *      - ESP_ERR_INVALID_STATE: b has already been generated for this handle
+ *      - ESP_ERR_NO_MEM: out of memory
+ */
+esp_err_t esp_srp_precompute_srv_ephemeral(esp_srp_handle_t *hd);
+
 /**
  * @brief   Returns B (pub key)[Step2.b] when the salt and verifier are set using esp_srp_set_salt_verifier()
  *
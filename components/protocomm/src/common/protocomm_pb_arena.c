@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <sdkconfig.h>
+#include <protobuf-c/protobuf-c.h>
+
+#include "protocomm_pb_arena.h"
+
+/* Alignment of the allocations, protobuf-c messages may hold 64 bit fields */
+#define PB_ARENA_ALIGN  8
+
+struct protocomm_pb_arena {
+    ProtobufCAllocator allocator;
+    size_t size;
+    size_t used;
+    _Alignas(PB_ARENA_ALIGN) uint8_t buf[];
+};
+
+static void *pb_arena_alloc(void *allocator_data, size_t size)
+{
+    protocomm_pb_arena_t *arena = allocator_data;
+    size_t aligned_size = (size + PB_ARENA_ALIGN - 1) & ~(size_t)(PB_ARENA_ALIGN - 1);
+    if (arena->size - arena->used < aligned_size) {
+        return malloc(size);
+    }
+    void *ptr = arena->buf + arena->used;
+    arena->used += aligned_size;
+    return ptr;
+}
+
+static void pb_arena_free(void *allocator_data, void *ptr)
+{
+    protocomm_pb_arena_t *arena = allocator_data;
+    /* Arena allocations are released all at once by protocomm_pb_arena_delete() */
+    if ((uint8_t *)ptr >= arena->buf && (uint8_t *)ptr < arena->buf + arena->size) {
+        return;
+    }
+    free(ptr);
+}
+
+protocomm_pb_arena_t *protocomm_pb_arena_create(size_t packed_len)
+{
+#if CONFIG_ESP_PROTOCOMM_PB_ARENA_EXTRA_SIZE > 0
+    /* Strings and bytes fields take at most their packed length plus a terminating zero,
+     * the extra size covers the message structures and these terminators */
+    size_t size = (packed_len + CONFIG_ESP_PROTOCOMM_PB_ARENA_EXTRA_SIZE + PB_ARENA_ALIGN - 1) & ~(size_t)(PB_ARENA_ALIGN - 1);
+    protocomm_pb_arena_t *arena = malloc(sizeof(protocomm_pb_arena_t) + size);
+    if (!arena) {
+        return NULL;
+    }
+    arena->allocator.alloc = pb_arena_alloc;
+    arena->allocator.free = pb_arena_free;
+    arena->allocator.allocator_data = arena;
+    arena->size = size;
+    arena->used = 0;
+    return arena;
+#else
+    (void) packed_len;
+    return NULL;
+#endif
+}
+
+struct ProtobufCAllocator *protocomm_pb_arena_get_allocator(protocomm_pb_arena_t *arena)
+{
+    return arena ? &arena->allocator : NULL;
+}
+
+void protocomm_pb_arena_delete(protocomm_pb_arena_t *arena)
+{
+    free(arena);
+}
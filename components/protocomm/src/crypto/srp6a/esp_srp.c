@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -47,6 +47,8 @@ typedef struct esp_srp_handle {
     int      len_B;
     /* b */
     esp_mpi_t *b;
+    /* g^b, if precomputed by esp_srp_precompute_srv_ephemeral() */
+    esp_mpi_t *gb;
     /* A */
     esp_mpi_t *A;
     char    *bytes_A;
@@ -164,6 +166,9 @@ void esp_srp_free(esp_srp_handle_t *hd)
     if (hd->b) {
         esp_mpi_free(hd->b);
     }
+    if (hd->gb) {
+        esp_mpi_free(hd->gb);
+    }
     if (hd->A) {
         esp_mpi_free(hd->A);
     }
@@ -258,40 +263,70 @@ static esp_mpi_t *calculate_u(esp_srp_handle_t *hd, char *A, int len_A)
     return calculate_padded_hash(hd, A, len_A, hd->bytes_B, hd->len_B);
 }
 
+static esp_err_t __esp_srp_srv_ephemeral(esp_srp_handle_t *hd)
+{
+    hd->b = esp_mpi_new();
+    hd->gb = esp_mpi_new();
+    if (!hd->b || !hd->gb) {
+        goto error;
+    }
+    esp_mpi_get_rand(hd->b, 256, -1, 0);
+    hexdump_mpi("b", hd->b);
+    esp_mpi_a_exp_b_mod_c(hd->gb, hd->g, hd->b, hd->n, hd->ctx);
+    return ESP_OK;
+error:
+    if (hd->gb) {
+        esp_mpi_free(hd->gb);
+        hd->gb = NULL;
+    }
+    if (hd->b) {
+        esp_mpi_free(hd->b);
+        hd->b = NULL;
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t esp_srp_precompute_srv_ephemeral(esp_srp_handle_t *hd)
+{
+    if (!hd) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (hd->b) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return __esp_srp_srv_ephemeral(hd);
+}
+
 static esp_err_t __esp_srp_srv_pubkey(esp_srp_handle_t *hd, char **bytes_B, int *len_B)
 {
     esp_mpi_t *k = calculate_k(hd);
     esp_mpi_t *kv = NULL;
-    esp_mpi_t *gb = NULL;
     if (!k) {
         goto error;
     }
     hexdump_mpi("k", k);
 
-    hd->b = esp_mpi_new();
-    if (!hd->b) {
+    /* g^b does not depend on the verifier, it may have been computed in advance */
+    if (!hd->gb && __esp_srp_srv_ephemeral(hd) != ESP_OK) {
         goto error;
     }
-    esp_mpi_get_rand(hd->b, 256, -1, 0);
-    hexdump_mpi("b", hd->b);
 
     /* B = kv + g^b */
     kv = esp_mpi_new();
-    gb = esp_mpi_new();
     hd->B = esp_mpi_new();
-    if (!kv || !gb || ! hd->B) {
+    if (!kv || ! hd->B) {
         goto error;
     }
     esp_mpi_a_mul_b_mod_c(kv, k, hd->v, hd->n, hd->ctx);
-    esp_mpi_a_exp_b_mod_c(gb, hd->g, hd->b, hd->n, hd->ctx);
-    esp_mpi_a_add_b_mod_c(hd->B, kv, gb, hd->n, hd->ctx);
+    esp_mpi_a_add_b_mod_c(hd->B, kv, hd->gb, hd->n, hd->ctx);
     hd->bytes_B = esp_mpi_to_bin(hd->B, len_B);
     hd->len_B = *len_B;
     *bytes_B = hd->bytes_B;
 
     esp_mpi_free(k);
     esp_mpi_free(kv);
-    esp_mpi_free(gb);
+    esp_mpi_free(hd->gb);
+    hd->gb = NULL;
     return ESP_OK;
 error:
     if (k) {
@@ -300,8 +335,9 @@ error:
     if (kv) {
         esp_mpi_free(kv);
     }
-    if (gb) {
-        esp_mpi_free(gb);
+    if (hd->gb) {
+        esp_mpi_free(hd->gb);
+        hd->gb = NULL;
     }
     if (hd->B) {
         esp_mpi_free(hd->B);
@@ -12,6 +12,10 @@
 #include <esp_check.h>
 #include <inttypes.h>
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
 #include <mbedtls/gcm.h>
 #include <mbedtls/error.h>
 #include <mbedtls/entropy.h>
@@ -19,6 +23,7 @@
 
 #include <protocomm_security.h>
 #include <protocomm_security2.h>
+#include <protocomm_pb_arena.h>
 
 #include "session.pb-c.h"
 #include "sec2.pb-c.h"
@@ -39,6 +44,8 @@ ESP_EVENT_DEFINE_BASE(PROTOCOMM_SECURITY_SESSION_EVENT);
 #define AES_GCM_TAG_LEN             (16)
 #define SESSION_ID_LEN              (8)
 
+#define SEC2_PRECOMPUTE_TASK_STACK  (4096)
+
 #define SESSION_STATE_CMD0  0 /* Session is not setup: Initial State*/
 #define SESSION_STATE_CMD1  1 /* Session is not setup: Cmd0 done */
 #define SESSION_STATE_DONE  2 /* Session setup successful */
@@ -50,6 +57,16 @@ typedef struct aes_gcm_iv {
 
 static_assert(sizeof(aes_gcm_iv_t) == AES_GCM_IV_SIZE, "Invalid size of AES GCM IV");
 
+#if CONFIG_ESP_PROTOCOMM_SEC2_PRECOMPUTE
+/* SRP handle with b and g^b prepared in advance by a low priority task */
+typedef struct sec2_precompute {
+    SemaphoreHandle_t lock;
+    esp_srp_handle_t *srp_hd;   /* Prepared handle, NULL if none */
+    bool running;               /* The task is preparing a handle */
+    bool closed;                /* The security handle was cleaned up, the task frees this */
+} sec2_precompute_t;
+#endif
+
 typedef struct session {
     /* Session data */
     uint32_t id;
@@ -67,6 +84,9 @@ typedef struct session {
     /* mbedtls context data for AES-GCM */
     mbedtls_gcm_context ctx_gcm;
     esp_srp_handle_t *srp_hd;
+#if CONFIG_ESP_PROTOCOMM_SEC2_PRECOMPUTE
+    sec2_precompute_t *precompute;
+#endif
 } session_t;
 
 static void hexdump(const char *msg, char *buf, int len)
@@ -83,6 +103,108 @@ static inline void sec2_gcm_iv_counter_increment(uint8_t *iv_buf)
 
 static esp_err_t sec2_new_session(protocomm_security_handle_t handle, uint32_t session_id);
 
+#if CONFIG_ESP_PROTOCOMM_SEC2_PRECOMPUTE
+static void sec2_precompute_task(void *arg)
+{
+    sec2_precompute_t *pre = (sec2_precompute_t *) arg;
+    esp_srp_handle_t *srp_hd = esp_srp_init(ESP_NG_3072);
+    if (srp_hd && esp_srp_precompute_srv_ephemeral(srp_hd) != ESP_OK) {
+        esp_srp_free(srp_hd);
+        srp_hd = NULL;
+    }
+
+    xSemaphoreTake(pre->lock, portMAX_DELAY);
+    pre->running = false;
+    bool closed = pre->closed;
+    if (!closed) {
+        pre->srp_hd = srp_hd;
+        srp_hd = NULL;
+    }
+    xSemaphoreGive(pre->lock);
+
+    if (closed) {
+        esp_srp_free(srp_hd);
+        vSemaphoreDelete(pre->lock);
+        free(pre);
+    }
+    vTaskDelete(NULL);
+}
+
+/* Must be called with pre->lock held */
+static void sec2_precompute_start(sec2_precompute_t *pre)
+{
+    if (pre->running || pre->srp_hd) {
+        return;
+    }
+    if (xTaskCreate(sec2_precompute_task, "sec2_precompute", SEC2_PRECOMPUTE_TASK_STACK,
+                    pre, tskIDLE_PRIORITY + 1, NULL) != pdPASS) {
+        ESP_LOGW(TAG, "Failed to create precompute task");
+        return;
+    }
+    pre->running = true;
+}
+
+static sec2_precompute_t *sec2_precompute_create(void)
+{
+    sec2_precompute_t *pre = (sec2_precompute_t *) calloc(1, sizeof(sec2_precompute_t));
+    if (!pre) {
+        return NULL;
+    }
+    pre->lock = xSemaphoreCreateMutex();
+    if (!pre->lock) {
+        free(pre);
+        return NULL;
+    }
+    xSemaphoreTake(pre->lock, portMAX_DELAY);
+    sec2_precompute_start(pre);
+    xSemaphoreGive(pre->lock);
+    return pre;
+}
+
+/* Returns the prepared SRP handle, or NULL if it is not ready */
+static esp_srp_handle_t *sec2_precompute_take(sec2_precompute_t *pre)
+{
+    if (!pre) {
+        return NULL;
+    }
+    xSemaphoreTake(pre->lock, portMAX_DELAY);
+    esp_srp_handle_t *srp_hd = pre->srp_hd;
+    pre->srp_hd = NULL;
+    xSemaphoreGive(pre->lock);
+    return srp_hd;
+}
+
+/* Prepares the handle for the next session, not during the session setup
+ * as the task would compete with it for the MPI hardware */
+static void sec2_precompute_next(sec2_precompute_t *pre)
+{
+    if (!pre) {
+        return;
+    }
+    xSemaphoreTake(pre->lock, portMAX_DELAY);
+    sec2_precompute_start(pre);
+    xSemaphoreGive(pre->lock);
+}
+
+static void sec2_precompute_delete(sec2_precompute_t *pre)
+{
+    if (!pre) {
+        return;
+    }
+    xSemaphoreTake(pre->lock, portMAX_DELAY);
+    if (pre->running) {
+        /* The task frees everything when it finishes */
+        pre->closed = true;
+        xSemaphoreGive(pre->lock);
+        return;
+    }
+    xSemaphoreGive(pre->lock);
+    esp_srp_free(pre->srp_hd);
+    vSemaphoreDelete(pre->lock);
+    free(pre);
+}
+#endif
+
 static esp_err_t handle_session_command0(session_t *cur_session,
         uint32_t session_id,
         SessionData *req, SessionData *resp,
@@ -125,7 +247,14 @@ static esp_err_t handle_session_command0(session_t *cur_session,
     hexdump("Client Public Key", (char *) in->sc0->client_pubkey.data, PUBLIC_KEY_LEN);
 
     /* Initialize mu srp context */
+#if CONFIG_ESP_PROTOCOMM_SEC2_PRECOMPUTE
+    cur_session->srp_hd = sec2_precompute_take(cur_session->precompute);
+    if (cur_session->srp_hd == NULL) {
+        cur_session->srp_hd = esp_srp_init(ESP_NG_3072);
+    }
+#else
     cur_session->srp_hd = esp_srp_init(ESP_NG_3072);
+#endif
     if (cur_session->srp_hd == NULL) {
         ESP_LOGE(TAG, "Failed to initialise security context!");
         return ESP_FAIL;
@@ -400,8 +529,15 @@ static esp_err_t sec2_close_session(protocomm_security_handle_t handle, uint32_t
         esp_srp_free(cur_session->srp_hd);
     }
 
+#if CONFIG_ESP_PROTOCOMM_SEC2_PRECOMPUTE
+    sec2_precompute_t *precompute = cur_session->precompute;
+    sec2_precompute_next(precompute);
+#endif
     memset(cur_session, 0, sizeof(session_t));
     cur_session->id = -1;
+#if CONFIG_ESP_PROTOCOMM_SEC2_PRECOMPUTE
+    cur_session->precompute = precompute;
+#endif
     return ESP_OK;
 }
 
@@ -433,6 +569,10 @@ static esp_err_t sec2_init(protocomm_security_handle_t *handle)
         return ESP_ERR_NO_MEM;
     }
     cur_session->id = -1;
+#if CONFIG_ESP_PROTOCOMM_SEC2_PRECOMPUTE
+    /* Without it, the key is computed when the client asks for it */
+    cur_session->precompute = sec2_precompute_create();
+#endif
     *handle = (protocomm_security_handle_t) cur_session;
     return ESP_OK;
 }
@@ -441,6 +581,11 @@ static esp_err_t sec2_cleanup(protocomm_security_handle_t handle)
 {
     session_t *cur_session = (session_t *) handle;
     if (cur_session) {
+#if CONFIG_ESP_PROTOCOMM_SEC2_PRECOMPUTE
+        sec2_precompute_t *precompute = cur_session->precompute;
+        cur_session->precompute = NULL;
+        sec2_precompute_delete(precompute);
+#endif
         sec2_close_session(handle, cur_session->id);
     }
     free(handle);
@@ -566,14 +711,18 @@ static esp_err_t sec2_req_handler(protocomm_security_handle_t handle,
     SessionData resp;
     esp_err_t ret;
 
-    req = session_data__unpack(NULL, inlen, inbuf);
+    protocomm_pb_arena_t *arena = protocomm_pb_arena_create(inlen);
+    ProtobufCAllocator *allocator = protocomm_pb_arena_get_allocator(arena);
+    req = session_data__unpack(allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack setup_req");
+        protocomm_pb_arena_delete(arena);
         return ESP_ERR_INVALID_ARG;
     }
     if (req->sec_ver != protocomm_security2.ver) {
         ESP_LOGE(TAG, "Security version mismatch. Closing connection");
-        session_data__free_unpacked(req, NULL);
+        session_data__free_unpacked(req, allocator);
+        protocomm_pb_arena_delete(arena);
         return ESP_ERR_INVALID_ARG;
     }
 
@@ -581,12 +730,14 @@ static esp_err_t sec2_req_handler(protocomm_security_handle_t handle,
     ret = sec2_session_setup(cur_session, session_id, req, &resp, (protocomm_security2_params_t *) sec_params);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Session setup error %d", ret);
-        session_data__free_unpacked(req, NULL);
+        session_data__free_unpacked(req, allocator);
+        protocomm_pb_arena_delete(arena);
         return ESP_FAIL;
     }
 
     resp.sec_ver = req->sec_ver;
-    session_data__free_unpacked(req, NULL);
+    session_data__free_unpacked(req, allocator);
+    protocomm_pb_arena_delete(arena);
 
     *outlen = session_data__get_packed_size(&resp);
     *outbuf = (uint8_t *) malloc(*outlen);
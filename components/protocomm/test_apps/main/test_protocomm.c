@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -39,6 +39,10 @@
 #include <protocomm_security.h>
 #include <protocomm_security0.h>
 #include <protocomm_security1.h>
+#include <protocomm_pb_arena.h>
+#if CONFIG_ESP_PROTOCOMM_SUPPORT_SECURITY_VERSION_2
+#include <esp_srp.h>
+#endif
 #include "test_utils.h"
 
 #include "session.pb-c.h"
@@ -1156,6 +1160,76 @@ TEST_CASE("leak test", "[PROTOCOMM]")
     TEST_ASSERT(pre_start_mem == post_stop_mem);
 }
 
+TEST_CASE("protobuf arena unpack test", "[PROTOCOMM]")
+{
+    uint8_t pubkey[PUBLIC_KEY_LEN] = {0};
+    S1SessionCmd0 cmd0 = S1_SESSION_CMD0__INIT;
+    Sec1Payload sec1 = SEC1_PAYLOAD__INIT;
+    SessionData req = SESSION_DATA__INIT;
+
+    memset(pubkey, 0xA5, sizeof(pubkey));
+    cmd0.client_pubkey.data = pubkey;
+    cmd0.client_pubkey.len = sizeof(pubkey);
+    sec1.msg = SEC1_MSG_TYPE__Session_Command0;
+    sec1.payload_case = SEC1_PAYLOAD__PAYLOAD_SC0;
+    sec1.sc0 = &cmd0;
+    req.sec_ver = SEC_SCHEME_VERSION__SecScheme1;
+    req.proto_case = SESSION_DATA__PROTO_SEC1;
+    req.sec1 = &sec1;
+
+    size_t inlen = session_data__get_packed_size(&req);
+    uint8_t *inbuf = malloc(inlen);
+    TEST_ASSERT_NOT_NULL(inbuf);
+    session_data__pack(&req, inbuf);
+
+    /* Run twice so that allocations made on first use don't show up as a leak */
+    unsigned pre_start_mem = 0;
+    for (int i = 0; i < 2; i++) {
+        if (i == 1) {
+            pre_start_mem = esp_get_free_heap_size();
+        }
+        protocomm_pb_arena_t *arena = protocomm_pb_arena_create(inlen);
+        ProtobufCAllocator *allocator = protocomm_pb_arena_get_allocator(arena);
+#if CONFIG_ESP_PROTOCOMM_PB_ARENA_EXTRA_SIZE > 0
+        TEST_ASSERT_NOT_NULL(allocator);
+#endif
+        SessionData *resp = session_data__unpack(allocator, inlen, inbuf);
+        TEST_ASSERT_NOT_NULL(resp);
+        TEST_ASSERT_EQUAL(SESSION_DATA__PROTO_SEC1, resp->proto_case);
+        TEST_ASSERT_EQUAL(SEC1_PAYLOAD__PAYLOAD_SC0, resp->sec1->payload_case);
+        TEST_ASSERT_EQUAL(sizeof(pubkey), resp->sec1->sc0->client_pubkey.len);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(pubkey, resp->sec1->sc0->client_pubkey.data, sizeof(pubkey));
+        session_data__free_unpacked(resp, allocator);
+        protocomm_pb_arena_delete(arena);
+    }
+    TEST_ASSERT_EQUAL(pre_start_mem, esp_get_free_heap_size());
+
+    /* Fields not fitting in the arena are allocated from the heap, here the arena is
+     * sized for an empty request and the key exceeds the largest extra size */
+    free(inbuf);
+    size_t big_len = 2 * 4096;
+    uint8_t *big_key = malloc(big_len);
+    TEST_ASSERT_NOT_NULL(big_key);
+    memset(big_key, 0x5A, big_len);
+    cmd0.client_pubkey.data = big_key;
+    cmd0.client_pubkey.len = big_len;
+    inlen = session_data__get_packed_size(&req);
+    inbuf = malloc(inlen);
+    TEST_ASSERT_NOT_NULL(inbuf);
+    session_data__pack(&req, inbuf);
+
+    protocomm_pb_arena_t *arena = protocomm_pb_arena_create(0);
+    ProtobufCAllocator *allocator = protocomm_pb_arena_get_allocator(arena);
+    SessionData *resp = session_data__unpack(allocator, inlen, inbuf);
+    TEST_ASSERT_NOT_NULL(resp);
+    TEST_ASSERT_EQUAL(big_len, resp->sec1->sc0->client_pubkey.len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(big_key, resp->sec1->sc0->client_pubkey.data, big_len);
+    session_data__free_unpacked(resp, allocator);
+    protocomm_pb_arena_delete(arena);
+    free(big_key);
+    free(inbuf);
+}
+
 TEST_CASE("security 0 basic test", "[PROTOCOMM]")
 {
     TEST_ASSERT(test_security0() == ESP_OK);
@@ -1191,6 +1265,57 @@ TEST_CASE("security 1 weak session test", "[PROTOCOMM]")
     TEST_ASSERT(test_security1_weak_session() == ESP_OK);
 }
 
+#if CONFIG_ESP_PROTOCOMM_SUPPORT_SECURITY_VERSION_2
+TEST_CASE("srp6a precomputed server key test", "[PROTOCOMM]")
+{
+    const char *username = "wifiprov";
+    const char *password = "abcd1234";
+    char *salt = NULL;
+    char *verifier = NULL;
+    int verifier_len = 0;
+    TEST_ESP_OK(esp_srp_gen_salt_verifier(username, strlen(username), password, strlen(password),
+                                          &salt, 16, &verifier, &verifier_len));
+
+    /* Any value below N will do as the client's public key here */
+    char client_pubkey[384];
+    memset(client_pubkey, 0x5A, sizeof(client_pubkey));
+
+    /* Run twice so that allocations made on first use don't show up as a leak */
+    unsigned pre_start_mem = 0;
+    for (int i = 0; i < 2; i++) {
+        if (i == 1) {
+            pre_start_mem = esp_get_free_heap_size();
+        }
+        for (int precompute = 0; precompute < 2; precompute++) {
+            esp_srp_handle_t *hd = esp_srp_init(ESP_NG_3072);
+            TEST_ASSERT_NOT_NULL(hd);
+            if (precompute) {
+                TEST_ESP_OK(esp_srp_precompute_srv_ephemeral(hd));
+                TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_srp_precompute_srv_ephemeral(hd));
+            }
+            TEST_ESP_OK(esp_srp_set_salt_verifier(hd, salt, 16, verifier, verifier_len));
+            char *pubkey = NULL;
+            int pubkey_len = 0;
+            TEST_ESP_OK(esp_srp_srv_pubkey_from_salt_verifier(hd, &pubkey, &pubkey_len));
+            TEST_ASSERT_NOT_NULL(pubkey);
+            TEST_ASSERT_GREATER_THAN(0, pubkey_len);
+            /* b has been used for B, it must not be generated again */
+            TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_srp_precompute_srv_ephemeral(hd));
+
+            char *key = NULL;
+            uint16_t key_len = 0;
+            TEST_ESP_OK(esp_srp_get_session_key(hd, client_pubkey, sizeof(client_pubkey), &key, &key_len));
+            TEST_ASSERT_NOT_NULL(key);
+            esp_srp_free(hd);
+        }
+    }
+    TEST_ASSERT_EQUAL(pre_start_mem, esp_get_free_heap_size());
+
+    free(salt);
+    free(verifier);
+}
+#endif
+
 void app_main(void)
 {
     unity_run_menu();
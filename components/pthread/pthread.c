@@ -10,6 +10,7 @@
 #include <pthread.h>
 #include <string.h>
 #include <sys/lock.h>
+#include <stdatomic.h>
 #include "esp_err.h"
 #include "esp_attr.h"
 #include "esp_cpu.h"
@@ -40,7 +41,10 @@ enum esp_pthread_task_state {
 
 /** pthread thread FreeRTOS wrapper */
 typedef struct esp_pthread_entry {
-    SLIST_ENTRY(esp_pthread_entry)  list_node;  ///< Tasks list node struct.
+    SLIST_ENTRY(esp_pthread_entry)  list_node;  ///< Node of the registry bucket indexed by the descriptor
+#if !CONFIG_PTHREAD_SELF_TLS_POINTER
+    SLIST_ENTRY(esp_pthread_entry)  handle_node; ///< Node of the registry bucket indexed by the task handle
+#endif
     TaskHandle_t                handle;         ///< FreeRTOS task handle
     TaskHandle_t                join_task;      ///< Handle of the task waiting to join
     enum esp_pthread_task_state state;          ///< pthread task state
@@ -58,14 +62,42 @@ typedef struct {
 
 /** pthread mutex FreeRTOS wrapper */
 typedef struct {
-    SemaphoreHandle_t   sem;        ///< Handle of the task waiting to join
+    SemaphoreHandle_t   sem;        ///< FreeRTOS mutex, or binary semaphore the contending tasks wait on with the fast path
     int                 type;       ///< Mutex type. Currently supported PTHREAD_MUTEX_NORMAL and PTHREAD_MUTEX_RECURSIVE
+#if CONFIG_PTHREAD_MUTEX_FAST_PATH
+    atomic_uint         state;      ///< MUTEX_UNLOCKED, MUTEX_LOCKED or MUTEX_CONTENDED
+    TaskHandle_t        owner;      ///< Task holding the mutex
+    unsigned            count;      ///< Number of times a recursive mutex is held by its owner
+#endif
 } esp_pthread_mutex_t;
 
+#if CONFIG_PTHREAD_MUTEX_FAST_PATH
+/* The mutex is taken with a compare-and-swap of its state when it is free. A task finding it taken
+ * marks it as contended and waits on the semaphore, which is only given when a contended mutex is
+ * released. A spurious give only makes a waiter check the state again. */
+#define MUTEX_UNLOCKED  0   ///< Mutex is free
+#define MUTEX_LOCKED    1   ///< Mutex is taken, no task is waiting
+#define MUTEX_CONTENDED 2   ///< Mutex is taken, tasks may be waiting on the semaphore
+#endif
+
+/* The threads are registered in hash buckets indexed by their descriptor, to check the pthread_t passed
+ * to pthread_join() and friends, and by their task handle, to find the descriptor of the current task.
+ * The latter is replaced by a thread local storage pointer if CONFIG_PTHREAD_SELF_TLS_POINTER is set. */
+#define PTHREAD_REGISTRY_BUCKETS_BITS   5
+#define PTHREAD_REGISTRY_BUCKETS        (1 << PTHREAD_REGISTRY_BUCKETS_BITS)
+
+#if CONFIG_PTHREAD_SELF_TLS_POINTER
+#define PTHREAD_SELF_TLS_INDEX          1   ///< Index 0 holds the values of pthread_setspecific()
+#endif
+
+SLIST_HEAD(esp_thread_list_head, esp_pthread_entry);
+
 static _lock_t s_threads_lock;
 portMUX_TYPE pthread_lazy_init_lock  = portMUX_INITIALIZER_UNLOCKED; // Used for mutexes and cond vars and rwlocks
-static SLIST_HEAD(esp_thread_list_head, esp_pthread_entry) s_threads_list
-    = SLIST_HEAD_INITIALIZER(s_threads_list);
+static struct esp_thread_list_head s_threads_by_desc[PTHREAD_REGISTRY_BUCKETS];
+#if !CONFIG_PTHREAD_SELF_TLS_POINTER
+static struct esp_thread_list_head s_threads_by_handle[PTHREAD_REGISTRY_BUCKETS];
+#endif
 static pthread_key_t s_pthread_cfg_key;
 
 static int pthread_mutex_lock_internal(esp_pthread_mutex_t *mux, TickType_t tmo);
@@ -95,47 +127,58 @@ esp_err_t esp_pthread_init(void)
     return ESP_OK;
 }
 
-static void *pthread_list_find_item(void *(*item_check)(esp_pthread_t *, void *arg), void *check_arg)
+static inline struct esp_thread_list_head *pthread_registry_bucket(struct esp_thread_list_head *buckets, const void *ptr)
 {
-    esp_pthread_t *it;
-    SLIST_FOREACH(it, &s_threads_list, list_node) {
-        void *val = item_check(it, check_arg);
-        if (val) {
-            return val;
-        }
-    }
-    return NULL;
+    // Fibonacci hashing, the top bits of the product depend on all the bits of the pointer
+    return &buckets[((uint32_t)(uintptr_t)ptr * 2654435761U) >> (32 - PTHREAD_REGISTRY_BUCKETS_BITS)];
 }
 
-static void *pthread_get_handle_by_desc(esp_pthread_t *item, void *desc)
+static void pthread_registry_add(esp_pthread_t *pthread)
 {
-    if (item == desc) {
-        return item->handle;
-    }
-    return NULL;
+    SLIST_INSERT_HEAD(pthread_registry_bucket(s_threads_by_desc, pthread), pthread, list_node);
+#if CONFIG_PTHREAD_SELF_TLS_POINTER
+    // the task waits for the start notification, it doesn't read the pointer before it is set
+    vTaskSetThreadLocalStoragePointer(pthread->handle, PTHREAD_SELF_TLS_INDEX, pthread);
+#else
+    SLIST_INSERT_HEAD(pthread_registry_bucket(s_threads_by_handle, pthread->handle), pthread, handle_node);
+#endif
 }
 
-static void *pthread_get_desc_by_handle(esp_pthread_t *item, void *hnd)
+static TaskHandle_t pthread_find_handle(pthread_t thread)
 {
-    if (hnd == item->handle) {
-        return item;
+    esp_pthread_t *it;
+    SLIST_FOREACH(it, pthread_registry_bucket(s_threads_by_desc, (void *)thread), list_node) {
+        if (it == (esp_pthread_t *)thread) {
+            return it->handle;
+        }
     }
     return NULL;
 }
 
-static inline TaskHandle_t pthread_find_handle(pthread_t thread)
+/* Returns the descriptor of the current task, NULL if it wasn't created by pthread_create().
+ * Without the thread local storage pointer, s_threads_lock must be held. */
+static esp_pthread_t *pthread_find_self(void)
 {
-    return pthread_list_find_item(pthread_get_handle_by_desc, (void *)thread);
-}
-
-static esp_pthread_t *pthread_find(TaskHandle_t task_handle)
-{
-    return pthread_list_find_item(pthread_get_desc_by_handle, task_handle);
+#if CONFIG_PTHREAD_SELF_TLS_POINTER
+    return pvTaskGetThreadLocalStoragePointer(NULL, PTHREAD_SELF_TLS_INDEX);
+#else
+    TaskHandle_t task_handle = xTaskGetCurrentTaskHandle();
+    esp_pthread_t *it;
+    SLIST_FOREACH(it, pthread_registry_bucket(s_threads_by_handle, task_handle), handle_node) {
+        if (it->handle == task_handle) {
+            return it;
+        }
+    }
+    return NULL;
+#endif
 }
 
 static void pthread_delete(esp_pthread_t *pthread)
 {
-    SLIST_REMOVE(&s_threads_list, pthread, esp_pthread_entry, list_node);
+    SLIST_REMOVE(pthread_registry_bucket(s_threads_by_desc, pthread), pthread, esp_pthread_entry, list_node);
+#if !CONFIG_PTHREAD_SELF_TLS_POINTER
+    SLIST_REMOVE(pthread_registry_bucket(s_threads_by_handle, pthread->handle), pthread, esp_pthread_entry, handle_node);
+#endif
     free(pthread);
 }
 
@@ -406,8 +449,7 @@ int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
     pthread->handle = xHandle;
 
     _lock_acquire(&s_threads_lock);
-
-    SLIST_INSERT_HEAD(&s_threads_list, pthread, list_node);
+    pthread_registry_add(pthread);
     _lock_release(&s_threads_lock);
 
     // start task
@@ -446,7 +488,7 @@ int pthread_join(pthread_t thread, void **retval)
         // join to self not allowed
         ret = EDEADLK;
     } else {
-        esp_pthread_t *cur_pthread = pthread_find(xTaskGetCurrentTaskHandle());
+        esp_pthread_t *cur_pthread = pthread_find_self();
         if (cur_pthread && cur_pthread->join_task == handle) {
             // join to each other not allowed
             ret = EDEADLK;
@@ -522,7 +564,7 @@ void pthread_exit(void *value_ptr)
 
     _lock_acquire(&s_threads_lock);
 
-    esp_pthread_t *pthread = pthread_find(xTaskGetCurrentTaskHandle());
+    esp_pthread_t *pthread = pthread_find_self();
     if (!pthread) {
         assert(false && "Failed to find pthread for current task!");
     }
@@ -576,13 +618,17 @@ int sched_yield(void)
 
 pthread_t pthread_self(void)
 {
+#if CONFIG_PTHREAD_SELF_TLS_POINTER
+    // the pointer of the current task only changes while it is created
+    esp_pthread_t *pthread = pthread_find_self();
+#else
     _lock_acquire(&s_threads_lock);
-
-    esp_pthread_t *pthread = pthread_find(xTaskGetCurrentTaskHandle());
+    esp_pthread_t *pthread = pthread_find_self();
+    _lock_release(&s_threads_lock);
+#endif
     if (!pthread) {
         assert(false && "Failed to find current thread ID!");
     }
-    _lock_release(&s_threads_lock);
     return (pthread_t)pthread;
 }
 
@@ -644,11 +690,18 @@ int pthread_mutex_init(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr)
     }
     mux->type = type;
 
+#if CONFIG_PTHREAD_MUTEX_FAST_PATH
+    atomic_init(&mux->state, MUTEX_UNLOCKED);
+    mux->owner = NULL;
+    mux->count = 0;
+    mux->sem = xSemaphoreCreateBinary();
+#else
     if (mux->type == PTHREAD_MUTEX_RECURSIVE) {
         mux->sem = xSemaphoreCreateRecursiveMutex();
     } else {
         mux->sem = xSemaphoreCreateMutex();
     }
+#endif
     if (!mux->sem) {
         free(mux);
         return EAGAIN;
@@ -677,6 +730,12 @@ int pthread_mutex_destroy(pthread_mutex_t *mutex)
         return EINVAL;
     }
 
+#if CONFIG_PTHREAD_MUTEX_FAST_PATH
+    // check if mux is busy
+    if (atomic_load(&mux->state) != MUTEX_UNLOCKED) {
+        return EBUSY;
+    }
+#else
     // check if mux is busy
     int res = pthread_mutex_lock_internal(mux, 0);
     if (res == EBUSY) {
@@ -691,12 +750,72 @@ int pthread_mutex_destroy(pthread_mutex_t *mutex)
     if (res != pdTRUE) {
         assert(false && "Failed to release mutex!");
     }
+#endif
     vSemaphoreDelete(mux->sem);
     free(mux);
 
     return 0;
 }
 
+#if CONFIG_PTHREAD_MUTEX_FAST_PATH
+static int pthread_mutex_lock_internal(esp_pthread_mutex_t *mux, TickType_t tmo)
+{
+    if (!mux) {
+        return EINVAL;
+    }
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    if (mux->type != PTHREAD_MUTEX_NORMAL && mux->owner == self) {
+        if (mux->type == PTHREAD_MUTEX_ERRORCHECK) {
+            return EDEADLK;
+        }
+        mux->count++;
+        return 0;
+    }
+
+    unsigned expected = MUTEX_UNLOCKED;
+    if (!atomic_compare_exchange_strong(&mux->state, &expected, MUTEX_LOCKED)) {
+        if (tmo == 0) {
+            return EBUSY;
+        }
+        TimeOut_t timeout;
+        vTaskSetTimeOutState(&timeout);
+        // Taking the mutex as contended, as other tasks may still be waiting
+        while (atomic_exchange(&mux->state, MUTEX_CONTENDED) != MUTEX_UNLOCKED) {
+            if (xSemaphoreTake(mux->sem, tmo) != pdTRUE) {
+                // The mutex stays marked as contended, its next release gives the semaphore once for nothing
+                return EBUSY;
+            }
+            if (tmo != portMAX_DELAY && xTaskCheckForTimeOut(&timeout, &tmo) == pdTRUE) {
+                // try once more without waiting
+                tmo = 0;
+            }
+        }
+    }
+    mux->owner = self;
+    mux->count = 1;
+    return 0;
+}
+
+static int pthread_mutex_unlock_internal(esp_pthread_mutex_t *mux)
+{
+    if (mux->type != PTHREAD_MUTEX_NORMAL && mux->owner != xTaskGetCurrentTaskHandle()) {
+        return EPERM;
+    }
+    if (mux->count == 0) {
+        // not locked
+        return EPERM;
+    }
+    if (--mux->count > 0) {
+        return 0;
+    }
+    mux->owner = NULL;
+    if (atomic_exchange(&mux->state, MUTEX_UNLOCKED) == MUTEX_CONTENDED) {
+        xSemaphoreGive(mux->sem);
+    }
+    return 0;
+}
+#else
 static int pthread_mutex_lock_internal(esp_pthread_mutex_t *mux, TickType_t tmo)
 {
     if (!mux) {
@@ -721,6 +840,27 @@ static int pthread_mutex_lock_internal(esp_pthread_mutex_t *mux, TickType_t tmo)
     return 0;
 }
 
+static int pthread_mutex_unlock_internal(esp_pthread_mutex_t *mux)
+{
+    if (((mux->type == PTHREAD_MUTEX_RECURSIVE) ||
+            (mux->type == PTHREAD_MUTEX_ERRORCHECK)) &&
+            (xSemaphoreGetMutexHolder(mux->sem) != xTaskGetCurrentTaskHandle())) {
+        return EPERM;
+    }
+
+    int ret;
+    if (mux->type == PTHREAD_MUTEX_RECURSIVE) {
+        ret = xSemaphoreGiveRecursive(mux->sem);
+    } else {
+        ret = xSemaphoreGive(mux->sem);
+    }
+    if (ret != pdTRUE) {
+        assert(false && "Failed to unlock mutex!");
+    }
+    return 0;
+}
+#endif // CONFIG_PTHREAD_MUTEX_FAST_PATH
+
 static int pthread_mutex_init_if_static(pthread_mutex_t *mutex)
 {
     int res = 0;
@@ -791,23 +931,7 @@ int pthread_mutex_unlock(pthread_mutex_t *mutex)
     if (!mux) {
         return EINVAL;
     }
-
-    if (((mux->type == PTHREAD_MUTEX_RECURSIVE) ||
-            (mux->type == PTHREAD_MUTEX_ERRORCHECK)) &&
-            (xSemaphoreGetMutexHolder(mux->sem) != xTaskGetCurrentTaskHandle())) {
-        return EPERM;
-    }
-
-    int ret;
-    if (mux->type == PTHREAD_MUTEX_RECURSIVE) {
-        ret = xSemaphoreGiveRecursive(mux->sem);
-    } else {
-        ret = xSemaphoreGive(mux->sem);
-    }
-    if (ret != pdTRUE) {
-        assert(false && "Failed to unlock mutex!");
-    }
-    return 0;
+    return pthread_mutex_unlock_internal(mux);
 }
 
 int pthread_mutexattr_init(pthread_mutexattr_t *attr)
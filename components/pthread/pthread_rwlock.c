@@ -26,22 +26,30 @@ const static char *TAG = "pthread_rw_lock";
 /** pthread rw_mutex FreeRTOS wrapper */
 typedef struct {
     /**
-     *
+     * Readers count and RWLOCK_WRITER and RWLOCK_WAITERS flags.
+     * The lock is taken and released with a compare-and-swap of this word while no task waits for it.
      */
-    pthread_cond_t cv;
+    atomic_uint state;
 
-    pthread_mutex_t resource_mutex;
+    /**
+     * Signaled when the lock is released, waited on by the tasks which can't take it
+     */
+    pthread_cond_t cv;
 
     /**
-     * Number of current readers holding this lock, negative number means waiting readers
+     * Protects the waiting tasks counters and the state changes made by the waiting tasks
      */
-    int8_t active_readers;
+    pthread_mutex_t resource_mutex;
 
-    uint8_t active_writers;
+    uint8_t waiting_readers;
     uint8_t waiting_writers;
 
 } esp_pthread_rwlock_t;
 
+#define RWLOCK_READERS_MASK 0x3FFFFFFFU     ///< Number of readers holding the lock
+#define RWLOCK_WRITER       0x40000000U     ///< A writer holds the lock
+#define RWLOCK_WAITERS      0x80000000U     ///< Tasks are waiting, the lock has to be taken and released under resource_mutex
+
 #define WRITER_QUEUE_SIZE 4
 #define READER_QUEUE_SIZE 4
 
@@ -76,8 +84,8 @@ int pthread_rwlock_init(pthread_rwlock_t *rwlock,
         return ENOMEM;
     }
 
-    esp_rwlock->active_readers = 0;
-    esp_rwlock->active_writers = 0;
+    atomic_init(&esp_rwlock->state, 0);
+    esp_rwlock->waiting_readers = 0;
     esp_rwlock->waiting_writers = 0;
 
     *rwlock = (pthread_rwlock_t) esp_rwlock;
@@ -120,7 +128,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
     // TODO: necessary?
     pthread_mutex_lock(&esp_rwlock->resource_mutex);
 
-    if (esp_rwlock->active_readers != 0 || esp_rwlock->active_writers > 0 || esp_rwlock->waiting_writers > 0) {
+    if (atomic_load(&esp_rwlock->state) != 0 || esp_rwlock->waiting_readers > 0 || esp_rwlock->waiting_writers > 0) {
         pthread_mutex_unlock(&esp_rwlock->resource_mutex);
         return EBUSY;
     }
@@ -157,6 +165,26 @@ static int checkrw_lock(pthread_rwlock_t *rwlock)
     return 0;
 }
 
+/* Adds a reader if no writer holds the lock and no task waits for it */
+static bool rwlock_try_add_reader(esp_pthread_rwlock_t *esp_rwlock)
+{
+    unsigned state = atomic_load(&esp_rwlock->state);
+    while ((state & (RWLOCK_WRITER | RWLOCK_WAITERS)) == 0) {
+        if (atomic_compare_exchange_weak(&esp_rwlock->state, &state, state + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Must be called with resource_mutex held, once a waiting task has stopped waiting */
+static void rwlock_waiter_done(esp_pthread_rwlock_t *esp_rwlock)
+{
+    if (esp_rwlock->waiting_readers == 0 && esp_rwlock->waiting_writers == 0) {
+        atomic_fetch_and(&esp_rwlock->state, ~RWLOCK_WAITERS);
+    }
+}
+
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 {
     esp_pthread_rwlock_t *esp_rwlock;
@@ -168,22 +196,24 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
+    if (rwlock_try_add_reader(esp_rwlock)) {
+        return 0;
+    }
+
     res = pthread_mutex_lock(&esp_rwlock->resource_mutex);
     if (res != 0) {
         return res;
     }
 
-    if (esp_rwlock->active_writers == 0) {
-        esp_rwlock->active_readers++;
-    } else {
-        while (true) {
-            pthread_cond_wait(&esp_rwlock->cv, &esp_rwlock->resource_mutex);
-            if (esp_rwlock->active_writers == 0 && esp_rwlock->waiting_writers == 0) {
-                esp_rwlock->active_readers++;
-                break;
-            }
-        }
+    // From now on, the writer has to release the lock under resource_mutex and signal cv
+    esp_rwlock->waiting_readers++;
+    atomic_fetch_or(&esp_rwlock->state, RWLOCK_WAITERS);
+    while ((atomic_load(&esp_rwlock->state) & RWLOCK_WRITER) || esp_rwlock->waiting_writers > 0) {
+        pthread_cond_wait(&esp_rwlock->cv, &esp_rwlock->resource_mutex);
     }
+    esp_rwlock->waiting_readers--;
+    atomic_fetch_add(&esp_rwlock->state, 1);
+    rwlock_waiter_done(esp_rwlock);
 
     pthread_mutex_unlock(&esp_rwlock->resource_mutex);
 
@@ -201,13 +231,18 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
+    if (rwlock_try_add_reader(esp_rwlock)) {
+        return 0;
+    }
+
+    // Tasks are waiting, a reader may still join the current readers if no writer is waiting
     res = pthread_mutex_trylock(&esp_rwlock->resource_mutex);
     if (res != 0) {
         return res;
     }
 
-    if (esp_rwlock->active_writers == 0) {
-        esp_rwlock->active_readers++;
+    if ((atomic_load(&esp_rwlock->state) & RWLOCK_WRITER) == 0 && esp_rwlock->waiting_writers == 0) {
+        atomic_fetch_add(&esp_rwlock->state, 1);
         res = 0;
     } else {
         res = EBUSY;
@@ -229,17 +264,25 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
+    unsigned expected = 0;
+    if (atomic_compare_exchange_strong(&esp_rwlock->state, &expected, RWLOCK_WRITER)) {
+        return 0;
+    }
+
     res = pthread_mutex_lock(&esp_rwlock->resource_mutex);
     if (res != 0) {
         return res;
     }
 
+    // From now on, the readers and the writer have to release the lock under resource_mutex and signal cv
     esp_rwlock->waiting_writers++;
-    while (esp_rwlock->active_readers > 0 || esp_rwlock->active_writers > 0) {
+    atomic_fetch_or(&esp_rwlock->state, RWLOCK_WAITERS);
+    while (atomic_load(&esp_rwlock->state) & (RWLOCK_READERS_MASK | RWLOCK_WRITER)) {
         pthread_cond_wait(&esp_rwlock->cv, &esp_rwlock->resource_mutex);
     }
     esp_rwlock->waiting_writers--;
-    esp_rwlock->active_writers++;
+    atomic_fetch_or(&esp_rwlock->state, RWLOCK_WRITER);
+    rwlock_waiter_done(esp_rwlock);
 
     pthread_mutex_unlock(&esp_rwlock->resource_mutex);
 
@@ -257,23 +300,13 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
-    res = pthread_mutex_trylock(&esp_rwlock->resource_mutex);
-    if (res != 0) {
-        return res;
-    }
-
-    if (esp_rwlock->active_readers > 0 ||
-            esp_rwlock->active_writers > 0 ||
-            esp_rwlock->waiting_writers > 0) { // the last check for waiting_writers is to avoid skipping the queue
-        res = EBUSY;
-    } else {
-        esp_rwlock->active_writers++;
-        res = 0;
+    // Fails when there are readers, a writer or waiting tasks, the last check is to avoid skipping the queue
+    unsigned expected = 0;
+    if (!atomic_compare_exchange_strong(&esp_rwlock->state, &expected, RWLOCK_WRITER)) {
+        return EBUSY;
     }
 
-    pthread_mutex_unlock(&esp_rwlock->resource_mutex);
-
-    return res;
+    return 0;
 }
 
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
@@ -287,23 +320,36 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
+    unsigned state = atomic_load(&esp_rwlock->state);
+
+    assert(!((state & RWLOCK_READERS_MASK) > 0 && (state & RWLOCK_WRITER)));
+    if ((state & (RWLOCK_READERS_MASK | RWLOCK_WRITER)) == 0) {
+        // not locked
+        return 0;
+    }
+
+    // Nobody is waiting, release the lock without waking anyone
+    while ((state & RWLOCK_WAITERS) == 0) {
+        unsigned new_state = (state & RWLOCK_WRITER) ? 0 : state - 1;
+        if (atomic_compare_exchange_weak(&esp_rwlock->state, &state, new_state)) {
+            return 0;
+        }
+    }
+
     res = pthread_mutex_lock(&esp_rwlock->resource_mutex);
     if (res != 0) {
         return res;
     }
 
-    assert(!(esp_rwlock->active_readers > 0 && esp_rwlock->active_writers > 0));
-
-    if (esp_rwlock->active_readers > 0) {
+    if (atomic_load(&esp_rwlock->state) & RWLOCK_WRITER) {
+        // we are a writer
+        atomic_fetch_and(&esp_rwlock->state, ~RWLOCK_WRITER);
+        pthread_cond_broadcast(&esp_rwlock->cv);
+    } else {
         // we are a reader
-        esp_rwlock->active_readers--;
-        if (esp_rwlock->active_readers == 0) {
+        if ((atomic_fetch_sub(&esp_rwlock->state, 1) & RWLOCK_READERS_MASK) == 1) {
             pthread_cond_broadcast(&esp_rwlock->cv);
         }
-    } else {
-        // we are a writer
-        esp_rwlock->active_writers = 0;
-        pthread_cond_broadcast(&esp_rwlock->cv);
     }
 
     pthread_mutex_unlock(&esp_rwlock->resource_mutex);
@@ -299,6 +299,76 @@ TEST_CASE("pthread mutex trylock timedlock", "[pthread]")
     }
 }
 
+#define CONTENDED_MUTEX_THREADS     4
+#define CONTENDED_MUTEX_ITERATIONS  10000
+
+static pthread_mutex_t s_contended_mutex;
+static volatile int s_contended_counter;
+
+static void *contended_mutex_thread(void *arg)
+{
+    for (int i = 0; i < CONTENDED_MUTEX_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_mutex_lock(&s_contended_mutex));
+        int value = s_contended_counter;
+        if ((i % 64) == 0) {
+            // let the other threads find the mutex taken
+            vTaskDelay(1);
+        }
+        s_contended_counter = value + 1;
+        TEST_ASSERT_EQUAL_INT(0, pthread_mutex_unlock(&s_contended_mutex));
+    }
+    return NULL;
+}
+
+TEST_CASE("pthread mutex contended by several threads", "[pthread]")
+{
+    pthread_t threads[CONTENDED_MUTEX_THREADS];
+    pthread_mutexattr_t attr;
+
+    for (int type = PTHREAD_MUTEX_NORMAL; type <= PTHREAD_MUTEX_ERRORCHECK; type++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_mutexattr_init(&attr));
+        TEST_ASSERT_EQUAL_INT(0, pthread_mutexattr_settype(&attr, type));
+        TEST_ASSERT_EQUAL_INT(0, pthread_mutex_init(&s_contended_mutex, &attr));
+        s_contended_counter = 0;
+
+        for (int i = 0; i < CONTENDED_MUTEX_THREADS; i++) {
+            TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, contended_mutex_thread, NULL));
+        }
+        for (int i = 0; i < CONTENDED_MUTEX_THREADS; i++) {
+            TEST_ASSERT_EQUAL_INT(0, pthread_join(threads[i], NULL));
+        }
+
+        TEST_ASSERT_EQUAL_INT(CONTENDED_MUTEX_THREADS * CONTENDED_MUTEX_ITERATIONS, s_contended_counter);
+        TEST_ASSERT_EQUAL_INT(0, pthread_mutex_destroy(&s_contended_mutex));
+        TEST_ASSERT_EQUAL_INT(0, pthread_mutexattr_destroy(&attr));
+    }
+}
+
+#define REGISTRY_THREADS 24
+
+static void *self_id_thread(void *arg)
+{
+    pthread_t *self = (pthread_t *)arg;
+    *self = pthread_self();
+    return NULL;
+}
+
+TEST_CASE("pthread self and join with many threads", "[pthread]")
+{
+    pthread_t threads[REGISTRY_THREADS];
+    pthread_t self_ids[REGISTRY_THREADS];
+
+    for (int i = 0; i < REGISTRY_THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, self_id_thread, &self_ids[i]));
+    }
+    // join in the reverse order to remove the threads from the middle of the buckets
+    for (int i = REGISTRY_THREADS - 1; i >= 0; i--) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(threads[i], NULL));
+        TEST_ASSERT_TRUE(pthread_equal(threads[i], self_ids[i]));
+        TEST_ASSERT_EQUAL_INT(ESRCH, pthread_join(threads[i], NULL));
+    }
+}
+
 static volatile bool finish_test;
 
 static void *test_thread(void * arg)
@@ -382,3 +382,50 @@ TEST_CASE("trywrlock lock statically initialized lock", "[pthread][rwlock]")
     TEST_ASSERT_EQUAL_INT(pthread_rwlock_unlock(&rwlock), 0);
     TEST_ASSERT_EQUAL_INT(pthread_rwlock_destroy(&rwlock), 0);
 }
+
+#define RWLOCK_STRESS_THREADS       4
+#define RWLOCK_STRESS_ITERATIONS    5000
+
+static pthread_rwlock_t s_stress_rwlock;
+static atomic_int s_stress_readers;
+static atomic_int s_stress_writers;
+
+static void *rwlock_stress_thread(void *arg)
+{
+    for (int i = 0; i < RWLOCK_STRESS_ITERATIONS; i++) {
+        if ((i % 8) == 0) {
+            TEST_ASSERT_EQUAL_INT(0, pthread_rwlock_wrlock(&s_stress_rwlock));
+            TEST_ASSERT_EQUAL_INT(0, atomic_fetch_add(&s_stress_writers, 1));
+            TEST_ASSERT_EQUAL_INT(0, atomic_load(&s_stress_readers));
+            if ((i % 256) == 0) {
+                vTaskDelay(1);
+            }
+            atomic_fetch_sub(&s_stress_writers, 1);
+        } else {
+            TEST_ASSERT_EQUAL_INT(0, pthread_rwlock_rdlock(&s_stress_rwlock));
+            atomic_fetch_add(&s_stress_readers, 1);
+            TEST_ASSERT_EQUAL_INT(0, atomic_load(&s_stress_writers));
+            atomic_fetch_sub(&s_stress_readers, 1);
+        }
+        TEST_ASSERT_EQUAL_INT(0, pthread_rwlock_unlock(&s_stress_rwlock));
+    }
+    return NULL;
+}
+
+TEST_CASE("readers and writers contend for the lock", "[pthread][rwlock]")
+{
+    pthread_t threads[RWLOCK_STRESS_THREADS];
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_rwlock_init(&s_stress_rwlock, NULL));
+    for (int i = 0; i < RWLOCK_STRESS_THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, rwlock_stress_thread, NULL));
+    }
+    for (int i = 0; i < RWLOCK_STRESS_THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(threads[i], NULL));
+    }
+
+    // the lock is free and nobody waits for it anymore
+    TEST_ASSERT_EQUAL_INT(0, pthread_rwlock_trywrlock(&s_stress_rwlock));
+    TEST_ASSERT_EQUAL_INT(0, pthread_rwlock_unlock(&s_stress_rwlock));
+    TEST_ASSERT_EQUAL_INT(0, pthread_rwlock_destroy(&s_stress_rwlock));
+}
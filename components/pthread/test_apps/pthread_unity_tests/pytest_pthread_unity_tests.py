@@ -10,6 +10,8 @@ from pytest_embedded_idf.utils import idf_parametrize
     'config',
     [
         'default',
+        'mutex_fast_path',
+        'self_tls_pointer',
     ],
     indirect=True,
 )
@@ -47,6 +47,12 @@ extern "C" {
 #define SDMMC_DEFAULT_CMD_TIMEOUT_MS  1000   // Max timeout of ordinary commands
 #define SDMMC_WRITE_CMD_TIMEOUT_MS    5000   // Max timeout of write commands
 
+/* Maximum size of the temporary DMA-capable buffer used for transfers from/to
+ * buffers which can't be used by the DMA, in sectors. Transfers are done with
+ * multi-block commands through this buffer, instead of one command per sector.
+ */
+#define SDMMC_BOUNCE_BUF_MAX_SECTORS  8
+
 
 #define SDMMC_SD_DISCARD_TIMEOUT  250    // SD erase (discard) timeout
 
@@ -85,6 +91,7 @@ esp_err_t sdmmc_send_cmd_set_bus_width(sdmmc_card_t* card, int width);
 esp_err_t sdmmc_send_cmd_send_status(sdmmc_card_t* card, uint32_t* out_status);
 esp_err_t sdmmc_send_cmd_crc_on_off(sdmmc_card_t* card, bool crc_enable);
 esp_err_t sdmmc_send_cmd_num_of_written_blocks(sdmmc_card_t* card, size_t* out_num_blocks);
+esp_err_t sdmmc_send_cmd_set_wr_blk_erase_count(sdmmc_card_t* card, size_t block_count);
 esp_err_t sdmmc_send_cmd_voltage_switch(sdmmc_card_t* card);
 
 /* Higher level functions */
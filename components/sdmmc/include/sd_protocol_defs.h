@@ -70,6 +70,7 @@ extern "C" {
 #define SD_APP_SET_BUS_WIDTH            6       /* R1 */
 #define SD_APP_SD_STATUS                13      /* R2 */
 #define SD_APP_SEND_NUM_WR_BLOCKS       22      /* R1 */
+#define SD_APP_SET_WR_BLK_ERASE_COUNT   23      /* R1 */
 #define SD_APP_OP_COND                  41      /* R3 */
 #define SD_APP_SEND_SCR                 51      /* R1 */
 
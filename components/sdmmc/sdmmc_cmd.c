@@ -443,6 +443,35 @@ esp_err_t sdmmc_send_cmd_num_of_written_blocks(sdmmc_card_t* card, size_t* out_n
     return err;
 }
 
+esp_err_t sdmmc_send_cmd_set_wr_blk_erase_count(sdmmc_card_t* card, size_t block_count)
+{
+    sdmmc_command_t cmd = {
+        .opcode = SD_APP_SET_WR_BLK_ERASE_COUNT,
+        .flags = SCF_CMD_AC | SCF_RSP_R1,
+        .arg = block_count & 0x7fffff,
+    };
+    return sdmmc_send_app_cmd(card, &cmd);
+}
+
+/* Allocate a temporary DMA-capable buffer for a transfer of block_count blocks
+ * from/to a buffer which can't be used by the DMA. The buffer holds up to
+ * SDMMC_BOUNCE_BUF_MAX_SECTORS blocks, or less if there isn't enough memory.
+ */
+static void* alloc_bounce_buffer(size_t block_size, size_t block_count, size_t* out_blocks)
+{
+    size_t blocks = MIN(block_count, SDMMC_BOUNCE_BUF_MAX_SECTORS);
+    while (true) {
+        // We don't want to force the allocation into SPIRAM, the allocator
+        // will decide based on the buffer size and memory availability.
+        void* buf = heap_caps_malloc(block_size * blocks, MALLOC_CAP_DMA);
+        if (buf || blocks == 1) {
+            *out_blocks = blocks;
+            return buf;
+        }
+        blocks /= 2;
+    }
+}
+
 esp_err_t sdmmc_write_sectors(sdmmc_card_t* card, const void* src,
         size_t start_block, size_t block_count)
 {
@@ -461,27 +490,25 @@ esp_err_t sdmmc_write_sectors(sdmmc_card_t* card, const void* src,
     ) {
         err = sdmmc_write_sectors_dma(card, src, start_block, block_count, block_size * block_count);
     } else {
-        // SDMMC peripheral needs DMA-capable buffers. Split the write into
-        // separate single block writes, if needed, and allocate a temporary
-        // DMA-capable buffer.
-        void *tmp_buf = NULL;
-        size_t actual_size = 0;
-        // We don't want to force the allocation into SPIRAM, the allocator
-        // will decide based on the buffer size and memory availability.
-        tmp_buf = heap_caps_malloc(block_size, MALLOC_CAP_DMA);
+        // SDMMC peripheral needs DMA-capable buffers. Copy the data into
+        // a temporary DMA-capable buffer, and split the write into chunks
+        // of the buffer size, if needed.
+        size_t tmp_blocks = 0;
+        void *tmp_buf = alloc_bounce_buffer(block_size, block_count, &tmp_blocks);
         if (!tmp_buf) {
             ESP_LOGE(TAG, "%s: not enough mem, err=0x%x", __func__, ESP_ERR_NO_MEM);
             return ESP_ERR_NO_MEM;
         }
-        actual_size = heap_caps_get_allocated_size(tmp_buf);
+        size_t actual_size = heap_caps_get_allocated_size(tmp_buf);
 
         const uint8_t* cur_src = (const uint8_t*) src;
-        for (size_t i = 0; i < block_count; ++i) {
-            memcpy(tmp_buf, cur_src, block_size);
-            cur_src += block_size;
-            err = sdmmc_write_sectors_dma(card, tmp_buf, start_block + i, 1, actual_size);
+        for (size_t i = 0; i < block_count; i += tmp_blocks) {
+            size_t count = MIN(block_count - i, tmp_blocks);
+            memcpy(tmp_buf, cur_src, block_size * count);
+            cur_src += block_size * count;
+            err = sdmmc_write_sectors_dma(card, tmp_buf, start_block + i, count, actual_size);
             if (err != ESP_OK) {
-                ESP_LOGD(TAG, "%s: error 0x%x writing block %d+%d",
+                ESP_LOGD(TAG, "%s: error 0x%x writing blocks %d+%d",
                         __func__, err, start_block, i);
                 break;
             }
@@ -510,6 +537,15 @@ esp_err_t sdmmc_write_sectors_dma(sdmmc_card_t* card, const void* src,
         cmd.opcode = MMC_WRITE_BLOCK_SINGLE;
     } else {
         cmd.opcode = MMC_WRITE_BLOCK_MULTIPLE;
+        /* Tell SD memory cards how many blocks are going to be written, so that
+         * they can pre-erase them. This is optional, and the write works without it.
+         */
+        if (!card->is_mmc) {
+            esp_err_t err_acmd23 = sdmmc_send_cmd_set_wr_blk_erase_count(card, block_count);
+            if (err_acmd23 != ESP_OK) {
+                ESP_LOGD(TAG, "%s: sdmmc_send_cmd_set_wr_blk_erase_count returned 0x%x", __func__, err_acmd23);
+            }
+        }
     }
     if (card->ocr & SD_OCR_SDHC_CAP) {
         cmd.arg = start_block;
@@ -599,28 +635,28 @@ esp_err_t sdmmc_read_sectors(sdmmc_card_t* card, void* dst,
     ) {
         err = sdmmc_read_sectors_dma(card, dst, start_block, block_count, block_size * block_count);
     } else {
-        // SDMMC peripheral needs DMA-capable buffers. Split the read into
-        // separate single block reads, if needed, and allocate a temporary
-        // DMA-capable buffer.
-        void *tmp_buf = NULL;
-        size_t actual_size = 0;
-        tmp_buf = heap_caps_malloc(block_size, MALLOC_CAP_DMA);
+        // SDMMC peripheral needs DMA-capable buffers. Read into a temporary
+        // DMA-capable buffer, and split the read into chunks of the buffer
+        // size, if needed.
+        size_t tmp_blocks = 0;
+        void *tmp_buf = alloc_bounce_buffer(block_size, block_count, &tmp_blocks);
         if (!tmp_buf) {
             ESP_LOGE(TAG, "%s: not enough mem, err=0x%x", __func__, ESP_ERR_NO_MEM);
             return ESP_ERR_NO_MEM;
         }
-        actual_size = heap_caps_get_allocated_size(tmp_buf);
+        size_t actual_size = heap_caps_get_allocated_size(tmp_buf);
 
         uint8_t* cur_dst = (uint8_t*) dst;
-        for (size_t i = 0; i < block_count; ++i) {
-            err = sdmmc_read_sectors_dma(card, tmp_buf, start_block + i, 1, actual_size);
+        for (size_t i = 0; i < block_count; i += tmp_blocks) {
+            size_t count = MIN(block_count - i, tmp_blocks);
+            err = sdmmc_read_sectors_dma(card, tmp_buf, start_block + i, count, actual_size);
             if (err != ESP_OK) {
-                ESP_LOGD(TAG, "%s: error 0x%x writing block %d+%d",
+                ESP_LOGD(TAG, "%s: error 0x%x reading blocks %d+%d",
                         __func__, err, start_block, i);
                 break;
             }
-            memcpy(cur_dst, tmp_buf, block_size);
-            cur_dst += block_size;
+            memcpy(cur_dst, tmp_buf, block_size * count);
+            cur_dst += block_size * count;
         }
         free(tmp_buf);
     }
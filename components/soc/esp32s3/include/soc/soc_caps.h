@@ -24,6 +24,7 @@
 /*-------------------------- COMMON CAPS ---------------------------------------*/
 #define SOC_ADC_SUPPORTED               1
 #define SOC_UART_SUPPORTED              1
+#define SOC_UHCI_SUPPORTED              1
 #define SOC_PCNT_SUPPORTED              1
 #define SOC_PHY_SUPPORTED               1
 #define SOC_WIFI_SUPPORTED              1
@@ -433,6 +434,9 @@
 
 #define SOC_UART_WAKEUP_SUPPORT_ACTIVE_THRESH_MODE (1)
 
+/*-------------------------- UHCI CAPS -------------------------------------*/
+#define SOC_UHCI_NUM                (1UL)
+
 /*-------------------------- USB CAPS ----------------------------------------*/
 #define SOC_USB_OTG_PERIPH_NUM          (1U)
 
@@ -12,6 +12,7 @@
 #include "esp_memory_utils.h"
 #include "spi_flash_chip_driver.h"
 #include "memspi_host_driver.h"
+#include "freertos/FreeRTOS.h"
 #include "esp_log.h"
 #include "sdkconfig.h"
 #include "esp_flash_internal.h"
@@ -24,6 +25,9 @@
 #include "esp_check.h"
 #include "hal/efuse_hal.h"
 #include "soc/chip_revision.h"
+#if CONFIG_ESP_METRICS_SYSTEM
+#include "esp_metrics.h"
+#endif
 
 #if CONFIG_IDF_TARGET_ESP32S2
 #include "esp_crypto_lock.h" // for locking flash encryption peripheral
@@ -72,6 +76,16 @@ DRAM_ATTR static const char TAG[] = "spi_flash";
         } \
     } while (0)
 
+#if CONFIG_ESP_METRICS_SYSTEM
+ESP_METRICS_COUNTER_DEFINE(s_read_bytes_metric, "esp_flash_read_bytes_total", "Bytes read from the SPI flash");
+ESP_METRICS_COUNTER_DEFINE(s_write_bytes_metric, "esp_flash_write_bytes_total", "Bytes written to the SPI flash");
+ESP_METRICS_COUNTER_DEFINE(s_erase_bytes_metric, "esp_flash_erase_bytes_total", "Bytes erased in the SPI flash");
+
+// The counters are in DRAM and updated inline, so this is safe while the cache is disabled
+#define METRICS_ADD_BYTES(counter, size) esp_metrics_counter_add(&s_##counter##_bytes_metric, size)
+#else
+#define METRICS_ADD_BYTES(counter, size)
+#endif
 
 #if CONFIG_SPI_FLASH_ENABLE_COUNTERS
 static esp_flash_counters_t esp_flash_stats;
@@ -86,6 +100,7 @@ static esp_flash_counters_t esp_flash_stats;
 #define COUNTER_ADD_BYTES(counter, size) \
     do { \
         esp_flash_stats.counter.bytes += size; \
+        METRICS_ADD_BYTES(counter, size); \
     } while (0)
 
 
@@ -128,7 +143,7 @@ void spi_flash_dump_counters(void)
 #else
 #define COUNTER_START()
 #define COUNTER_STOP(counter)
-#define COUNTER_ADD_BYTES(counter, size)
+#define COUNTER_ADD_BYTES(counter, size) METRICS_ADD_BYTES(counter, size)
 
 #endif //CONFIG_SPI_FLASH_ENABLE_COUNTERS
 
@@ -179,6 +194,186 @@ extern rom_spiflash_api_func_t *esp_flash_api_funcs;
 #define rom_spiflash_api_funcs esp_flash_api_funcs
 #endif // !CONFIG_SPI_FLASH_ROM_IMPL || ESP_ROM_HAS_ENCRYPTED_WRITES_USING_LEGACY_DRV
 
+#if CONFIG_SPI_FLASH_READ_CACHE
+/*
+ * RAM cache of the small reads of the main flash, e.g. the metadata rereads of the filesystems.
+ * The lines are filled by a single flash read, and the line after a line is prefetched in the same
+ * flash operation when the misses are sequential. The lines overlapping a region are invalidated
+ * when it is written or erased.
+ */
+#define READ_CACHE_LINE_SIZE    CONFIG_SPI_FLASH_READ_CACHE_LINE_SIZE
+#define READ_CACHE_LINE_NUM     CONFIG_SPI_FLASH_READ_CACHE_LINE_NUM
+#define READ_CACHE_INVALID      UINT32_MAX
+
+typedef struct {
+    uint32_t address;       // flash address of the line
+    uint32_t last_used;     // for the LRU replacement
+    bool valid;             // the line holds the data at `address`
+    bool filling;           // the line is being read from the flash, it can't be replaced
+    uint8_t data[READ_CACHE_LINE_SIZE] __attribute__((aligned(4)));
+} read_cache_line_t;
+
+static DRAM_ATTR read_cache_line_t s_read_cache[READ_CACHE_LINE_NUM];
+static DRAM_ATTR esp_flash_read_cache_stats_t s_read_cache_stats;
+static DRAM_ATTR uint32_t s_read_cache_tick;
+static DRAM_ATTR uint32_t s_read_cache_gen;     // incremented on each invalidation, discards the lines filled meanwhile
+static DRAM_ATTR uint32_t s_read_cache_last_fill = READ_CACHE_INVALID;  // last line read from the flash
+static DRAM_ATTR portMUX_TYPE s_read_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void esp_flash_read_cache_get_stats(esp_flash_read_cache_stats_t *out_stats)
+{
+    portENTER_CRITICAL_SAFE(&s_read_cache_lock);
+    *out_stats = s_read_cache_stats;
+    portEXIT_CRITICAL_SAFE(&s_read_cache_lock);
+}
+
+void esp_flash_read_cache_invalidate(void)
+{
+    portENTER_CRITICAL_SAFE(&s_read_cache_lock);
+    s_read_cache_gen++;
+    for (int i = 0; i < READ_CACHE_LINE_NUM; i++) {
+        s_read_cache[i].valid = false;
+    }
+    s_read_cache_last_fill = READ_CACHE_INVALID;
+    portEXIT_CRITICAL_SAFE(&s_read_cache_lock);
+}
+
+static void read_cache_invalidate_region(esp_flash_t *chip, uint32_t address, uint32_t length)
+{
+    if (chip != esp_flash_default_chip) {
+        return;
+    }
+    portENTER_CRITICAL_SAFE(&s_read_cache_lock);
+    s_read_cache_gen++;
+    for (int i = 0; i < READ_CACHE_LINE_NUM; i++) {
+        uint32_t line = s_read_cache[i].address;
+        if (s_read_cache[i].valid && line < address + length && address < line + READ_CACHE_LINE_SIZE) {
+            s_read_cache[i].valid = false;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&s_read_cache_lock);
+}
+
+// Copy from the line of `line_addr`, if it's cached
+static bool read_cache_lookup(uint32_t line_addr, void *buffer, uint32_t offset, uint32_t length)
+{
+    bool hit = false;
+    portENTER_CRITICAL_SAFE(&s_read_cache_lock);
+    for (int i = 0; i < READ_CACHE_LINE_NUM; i++) {
+        if (s_read_cache[i].valid && s_read_cache[i].address == line_addr) {
+            memcpy(buffer, s_read_cache[i].data + offset, length);
+            s_read_cache[i].last_used = ++s_read_cache_tick;
+            hit = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&s_read_cache_lock);
+    return hit;
+}
+
+// Least recently used line which is not being filled, call within the critical section
+static read_cache_line_t *read_cache_victim(void)
+{
+    read_cache_line_t *victim = NULL;
+    for (int i = 0; i < READ_CACHE_LINE_NUM; i++) {
+        read_cache_line_t *line = &s_read_cache[i];
+        if (!line->filling && (victim == NULL || (int32_t)(line->last_used - victim->last_used) < 0)) {
+            victim = line;
+        }
+    }
+    if (victim) {
+        victim->valid = false;
+        victim->filling = true;
+    }
+    return victim;
+}
+
+// Read the line of `line_addr` and, if the misses are sequential, the next line
+static esp_err_t read_cache_fill(esp_flash_t *chip, uint32_t line_addr)
+{
+    read_cache_line_t *lines[2] = { NULL, NULL };
+    uint32_t addrs[2] = { line_addr, line_addr + READ_CACHE_LINE_SIZE };
+
+    portENTER_CRITICAL_SAFE(&s_read_cache_lock);
+    bool prefetch = (s_read_cache_last_fill == line_addr - READ_CACHE_LINE_SIZE) && (addrs[1] < chip->size);
+    s_read_cache_stats.misses++;
+    uint32_t gen = s_read_cache_gen;
+    lines[0] = read_cache_victim();
+    if (lines[0] && prefetch) {
+        lines[1] = read_cache_victim();
+    }
+    s_read_cache_last_fill = lines[1] ? addrs[1] : line_addr;
+    portEXIT_CRITICAL_SAFE(&s_read_cache_lock);
+    if (lines[0] == NULL) {
+        // all the lines are being filled by other tasks
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    COUNTER_START();
+    esp_err_t err = rom_spiflash_api_funcs->start(chip);
+    if (err == ESP_OK) {
+        err = chip->chip_drv->read(chip, lines[0]->data, addrs[0], READ_CACHE_LINE_SIZE);
+        if (err == ESP_OK && lines[1]) {
+            // the prefetch is optional, keep the first line if it fails
+            if (chip->chip_drv->read(chip, lines[1]->data, addrs[1], READ_CACHE_LINE_SIZE) != ESP_OK) {
+                addrs[1] = READ_CACHE_INVALID;
+            }
+        }
+        err = rom_spiflash_api_funcs->end(chip, err);
+    }
+    COUNTER_ADD_BYTES(read, lines[1] ? 2 * READ_CACHE_LINE_SIZE : READ_CACHE_LINE_SIZE);
+    COUNTER_STOP(read);
+
+    portENTER_CRITICAL_SAFE(&s_read_cache_lock);
+    for (int i = 0; i < 2 && lines[i]; i++) {
+        // the lines are only valid if the flash was not written since the read started
+        if (err == ESP_OK && gen == s_read_cache_gen && addrs[i] != READ_CACHE_INVALID) {
+            lines[i]->valid = true;
+            lines[i]->address = addrs[i];
+            lines[i]->last_used = ++s_read_cache_tick;
+        }
+        lines[i]->filling = false;
+    }
+    if (lines[1] && addrs[1] != READ_CACHE_INVALID) {
+        s_read_cache_stats.prefetches++;
+    }
+    portEXIT_CRITICAL_SAFE(&s_read_cache_lock);
+    return err;
+}
+
+static esp_err_t flash_read_direct(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t length);
+
+static esp_err_t read_cache_read(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t length)
+{
+    esp_err_t err = ESP_OK;
+    while (err == ESP_OK && length > 0) {
+        uint32_t line_addr = address & ~(READ_CACHE_LINE_SIZE - 1);
+        uint32_t offset = address - line_addr;
+        uint32_t part_len = MIN(length, READ_CACHE_LINE_SIZE - offset);
+
+        if (read_cache_lookup(line_addr, buffer, offset, part_len)) {
+            portENTER_CRITICAL_SAFE(&s_read_cache_lock);
+            s_read_cache_stats.hits++;
+            portEXIT_CRITICAL_SAFE(&s_read_cache_lock);
+        } else {
+            err = read_cache_fill(chip, line_addr);
+            // the line may be invalidated again before it is read, read the flash then
+            if (err != ESP_OK || !read_cache_lookup(line_addr, buffer, offset, part_len)) {
+                err = flash_read_direct(chip, buffer, address, part_len);
+            }
+        }
+        address += part_len;
+        length -= part_len;
+        buffer = (void *)((intptr_t)buffer + part_len);
+    }
+    return err;
+}
+
+#define READ_CACHE_INVALIDATE(chip, address, length) read_cache_invalidate_region(chip, address, length)
+#else
+#define READ_CACHE_INVALIDATE(chip, address, length)
+#endif //CONFIG_SPI_FLASH_READ_CACHE
+
 /* Static function to notify OS of a new SPI flash operation.
 
    If returns an error result, caller must abort. If returns ESP_OK, caller must
@@ -227,6 +422,8 @@ static esp_err_t check_chip_pointer_default(esp_flash_t **inout_chip)
 
 static esp_err_t flash_end_flush_cache(esp_flash_t* chip, esp_err_t err, bool bus_acquired, uint32_t address, uint32_t length)
 {
+    // the region has been written or erased, whether the operation succeeded or not
+    READ_CACHE_INVALIDATE(chip, address, length);
     if (!bus_acquired) {
         // Try to acquire the bus again to flush the cache before exit.
         esp_err_t acquire_err = rom_spiflash_api_funcs->start(chip);
@@ -653,6 +850,7 @@ esp_err_t esp_flash_erase_region(esp_flash_t *chip, uint32_t start, uint32_t len
         if (chip->chip_drv->yield) {
             err = chip->chip_drv->yield(chip, 0);
             if (err != ESP_OK) {
+                READ_CACHE_INVALIDATE(chip, start, len);
                 return err;
             }
         }
@@ -860,6 +1058,17 @@ esp_err_t esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t address, uint
     if (length == 0) {
         return ESP_OK;
     }
+#if CONFIG_SPI_FLASH_READ_CACHE
+    if (chip == esp_flash_default_chip && length <= READ_CACHE_LINE_SIZE) {
+        return read_cache_read(chip, buffer, address, length);
+    }
+#endif
+    return flash_read_direct(chip, buffer, address, length);
+}
+
+static esp_err_t flash_read_direct(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t length)
+{
+    esp_err_t err;
 
     //when the cache is disabled, only the DRAM can be read, check whether we need to receive in another buffer in DRAM.
     bool direct_read = false;
@@ -1057,6 +1266,7 @@ esp_err_t esp_flash_write(esp_flash_t *chip, const void *buffer, uint32_t addres
         if (chip->chip_drv->yield) {
             err = chip->chip_drv->yield(chip, 0);
             if (err != ESP_OK) {
+                READ_CACHE_INVALIDATE(chip, address, length);
                 return err;
             }
         }
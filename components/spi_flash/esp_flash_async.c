@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_flash.h"
+#include "esp_flash_async.h"
+#include "spi_flash_mmap.h"
+
+static const char TAG[] = "flash_async";
+
+/* Number of jobs which can be combined into one flash operation */
+#define MAX_MERGED_JOBS     16
+
+typedef enum {
+    JOB_WRITE,
+    JOB_ERASE,
+    JOB_FLUSH,  // gives 'done' once the jobs queued before it have completed
+    JOB_STOP,   // like JOB_FLUSH, then the task deletes itself
+} job_type_t;
+
+typedef struct {
+    job_type_t type;
+    esp_flash_t *chip;
+    const void *buffer;
+    uint32_t address;
+    uint32_t length;
+    esp_flash_async_done_cb_t done_cb;
+    union {
+        void *arg;
+        SemaphoreHandle_t done;     // for JOB_FLUSH and JOB_STOP
+    };
+} job_t;
+
+typedef struct {
+    QueueHandle_t queue;
+    TaskHandle_t task;
+    uint8_t *merge_buffer;
+    size_t merge_buffer_size;
+} async_ctx_t;
+
+static async_ctx_t s_ctx;
+
+/* Whether the next job in the queue can be executed together with the current one */
+static bool can_merge(const job_t *cur, uint32_t cur_len, const job_t *next)
+{
+    if (next->type != cur->type || next->chip != cur->chip || next->address != cur->address + cur_len) {
+        return false;
+    }
+    if (cur->type == JOB_WRITE) {
+        return cur_len + next->length <= s_ctx.merge_buffer_size;
+    }
+    // don't make a valid erase fail together with a misaligned one
+    return cur->type == JOB_ERASE && (next->address % SPI_FLASH_SEC_SIZE) == 0 && (next->length % SPI_FLASH_SEC_SIZE) == 0;
+}
+
+static void flash_async_task(void *arg)
+{
+    job_t jobs[MAX_MERGED_JOBS];
+
+    while (true) {
+        xQueueReceive(s_ctx.queue, &jobs[0], portMAX_DELAY);
+        if (jobs[0].type == JOB_FLUSH || jobs[0].type == JOB_STOP) {
+            xSemaphoreGive(jobs[0].done);
+            if (jobs[0].type == JOB_STOP) {
+                vTaskDelete(NULL);
+            }
+            continue;
+        }
+
+        // Only this task receives from the queue, so a peeked job is the next one received
+        size_t count = 1;
+        uint32_t length = jobs[0].length;
+        while (count < MAX_MERGED_JOBS && xQueuePeek(s_ctx.queue, &jobs[count], 0) == pdTRUE &&
+                can_merge(&jobs[0], length, &jobs[count])) {
+            xQueueReceive(s_ctx.queue, &jobs[count], 0);
+            if (jobs[0].type == JOB_WRITE) {
+                if (count == 1) {
+                    memcpy(s_ctx.merge_buffer, jobs[0].buffer, jobs[0].length);
+                }
+                memcpy(s_ctx.merge_buffer + length, jobs[count].buffer, jobs[count].length);
+            }
+            length += jobs[count].length;
+            count++;
+        }
+
+        esp_err_t err;
+        if (jobs[0].type == JOB_WRITE) {
+            const void *buffer = (count > 1) ? s_ctx.merge_buffer : jobs[0].buffer;
+            err = esp_flash_write(jobs[0].chip, buffer, jobs[0].address, length);
+        } else {
+            err = esp_flash_erase_region(jobs[0].chip, jobs[0].address, length);
+        }
+        if (err != ESP_OK) {
+            ESP_LOGD(TAG, "%s of 0x%"PRIx32" bytes at 0x%"PRIx32" failed: %s", (jobs[0].type == JOB_WRITE) ? "write" : "erase",
+                     length, jobs[0].address, esp_err_to_name(err));
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            if (jobs[i].done_cb) {
+                jobs[i].done_cb(err, jobs[i].arg);
+            }
+        }
+    }
+}
+
+static esp_err_t queue_job(const job_t *job)
+{
+    ESP_RETURN_ON_FALSE(s_ctx.queue != NULL, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+
+    // Completion callbacks run in the job task, which can't wait for itself to make space in the queue
+    TickType_t ticks_to_wait = (xTaskGetCurrentTaskHandle() == s_ctx.task) ? 0 : portMAX_DELAY;
+    if (xQueueSend(s_ctx.queue, job, ticks_to_wait) != pdTRUE) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+/* Queue a JOB_FLUSH or JOB_STOP job and wait until the task has got to it */
+static esp_err_t queue_fence(job_type_t type)
+{
+    ESP_RETURN_ON_FALSE(s_ctx.queue != NULL, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    ESP_RETURN_ON_FALSE(xTaskGetCurrentTaskHandle() != s_ctx.task, ESP_ERR_INVALID_STATE, TAG,
+                        "can't wait for the jobs in a completion callback");
+
+    StaticSemaphore_t done_buf;
+    job_t job = {
+        .type = type,
+        .done = xSemaphoreCreateBinaryStatic(&done_buf),
+    };
+    xQueueSend(s_ctx.queue, &job, portMAX_DELAY);
+    xSemaphoreTake(job.done, portMAX_DELAY);
+    vSemaphoreDelete(job.done);
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_async_init(const esp_flash_async_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config != NULL && config->queue_size > 0, ESP_ERR_INVALID_ARG, TAG, "invalid config");
+    ESP_RETURN_ON_FALSE(s_ctx.queue == NULL, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+
+    esp_err_t ret = ESP_OK;
+    s_ctx.merge_buffer_size = config->merge_buffer_size;
+    if (s_ctx.merge_buffer_size > 0) {
+        s_ctx.merge_buffer = heap_caps_malloc(s_ctx.merge_buffer_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        ESP_GOTO_ON_FALSE(s_ctx.merge_buffer != NULL, ESP_ERR_NO_MEM, err, TAG, "no memory for merge buffer");
+    }
+    s_ctx.queue = xQueueCreate(config->queue_size, sizeof(job_t));
+    ESP_GOTO_ON_FALSE(s_ctx.queue != NULL, ESP_ERR_NO_MEM, err, TAG, "no memory for queue");
+    ESP_GOTO_ON_FALSE(xTaskCreatePinnedToCore(flash_async_task, "flash_async", config->task_stack_size, NULL,
+                                              config->task_priority, &s_ctx.task, config->task_core_id) == pdPASS,
+                      ESP_ERR_NO_MEM, err, TAG, "failed to create task");
+    return ESP_OK;
+
+err:
+    if (s_ctx.queue) {
+        vQueueDelete(s_ctx.queue);
+    }
+    free(s_ctx.merge_buffer);
+    s_ctx = (async_ctx_t) { 0 };
+    return ret;
+}
+
+esp_err_t esp_flash_async_deinit(void)
+{
+    ESP_RETURN_ON_ERROR(queue_fence(JOB_STOP), TAG, "failed to stop task");
+
+    vQueueDelete(s_ctx.queue);
+    free(s_ctx.merge_buffer);
+    s_ctx = (async_ctx_t) { 0 };
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_async_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t length,
+                                esp_flash_async_done_cb_t done_cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE(buffer != NULL, ESP_ERR_INVALID_ARG, TAG, "buffer is NULL");
+
+    job_t job = {
+        .type = JOB_WRITE,
+        .chip = (chip == NULL) ? esp_flash_default_chip : chip,
+        .buffer = buffer,
+        .address = address,
+        .length = length,
+        .done_cb = done_cb,
+        .arg = arg,
+    };
+    return queue_job(&job);
+}
+
+esp_err_t esp_flash_async_erase_region(esp_flash_t *chip, uint32_t start, uint32_t len,
+                                       esp_flash_async_done_cb_t done_cb, void *arg)
+{
+    job_t job = {
+        .type = JOB_ERASE,
+        .chip = (chip == NULL) ? esp_flash_default_chip : chip,
+        .address = start,
+        .length = len,
+        .done_cb = done_cb,
+        .arg = arg,
+    };
+    return queue_job(&job);
+}
+
+esp_err_t esp_flash_async_flush(void)
+{
+    return queue_fence(JOB_FLUSH);
+}
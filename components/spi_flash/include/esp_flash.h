@@ -10,6 +10,7 @@
 #include <stdbool.h>
 
 #include "hal/spi_flash_types.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -310,6 +311,35 @@ esp_err_t esp_flash_set_protected_region(esp_flash_t *chip, const esp_flash_regi
  */
 esp_err_t esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t length);
 
+#if CONFIG_SPI_FLASH_READ_CACHE || defined __DOXYGEN__
+/**
+ * @brief Statistics of the flash read cache (CONFIG_SPI_FLASH_READ_CACHE)
+ */
+typedef struct {
+    uint32_t hits;          /*!< Number of cache lines read from RAM */
+    uint32_t misses;        /*!< Number of cache lines read from the flash */
+    uint32_t prefetches;    /*!< Number of cache lines read from the flash ahead of the reads */
+} esp_flash_read_cache_stats_t;
+
+/**
+ * @brief Get the statistics of the flash read cache
+ *
+ * The small reads of the main flash with esp_flash_read() are served by the read cache. A read spread over two
+ * cache lines counts twice.
+ *
+ * @param[out] out_stats Statistics since the boot
+ */
+void esp_flash_read_cache_get_stats(esp_flash_read_cache_stats_t *out_stats);
+
+/**
+ * @brief Invalidate the whole flash read cache
+ *
+ * The cache is invalidated by the esp_flash write and erase functions. Call this function after the main flash
+ * has been written by other means, e.g. by the ROM functions.
+ */
+void esp_flash_read_cache_invalidate(void);
+#endif // CONFIG_SPI_FLASH_READ_CACHE || defined __DOXYGEN__
+
 /** @brief Write data to the SPI flash chip
  *
  * @param chip Pointer to identify flash chip. If NULL, esp_flash_default_chip is substituted. Must have been successfully initialised via esp_flash_init()
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_flash.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Callback invoked when a queued flash job has completed
+ *
+ * The callback runs in the context of the flash job task, it should return quickly. It may queue
+ * further jobs.
+ *
+ * @param result ESP_OK if the job succeeded, otherwise the error returned by esp_flash_write or
+ *               esp_flash_erase_region
+ * @param arg    Argument passed when the job was queued
+ */
+typedef void (*esp_flash_async_done_cb_t)(esp_err_t result, void *arg);
+
+/**
+ * @brief Configuration of the flash job queue
+ */
+typedef struct {
+    UBaseType_t task_priority;  ///< Priority of the task executing the jobs
+    uint32_t task_stack_size;   ///< Stack size of the task executing the jobs
+    BaseType_t task_core_id;    ///< Core the task is pinned to, or tskNO_AFFINITY
+    size_t queue_size;          ///< Number of jobs which can be queued, queuing blocks while the queue is full
+    size_t merge_buffer_size;   ///< Size of the buffer used to combine adjacent writes into one, 0 to never combine writes
+} esp_flash_async_config_t;
+
+/**
+ * @brief Default configuration of the flash job queue
+ *
+ * The task priority is low, so that jobs such as an OTA download being written only run while
+ * other tasks don't need the CPU.
+ */
+#define ESP_FLASH_ASYNC_DEFAULT_CONFIG() { \
+    .task_priority = 2, \
+    .task_stack_size = 3072, \
+    .task_core_id = tskNO_AFFINITY, \
+    .queue_size = 16, \
+    .merge_buffer_size = 4096, \
+}
+
+/**
+ * @brief Create the flash job queue and the task executing its jobs
+ *
+ * Jobs are executed in the order they are queued, so a write queued after an erase of the same
+ * region is executed after it. Consecutive writes to adjacent addresses are combined into
+ * one esp_flash_write call as long as they fit into the merge buffer, and consecutive erases of
+ * adjacent regions into one esp_flash_erase_region call, which can then use block erases.
+ *
+ * Between jobs, and during the jobs if SPI_FLASH_AUTO_SUSPEND is enabled, other tasks can run and
+ * read from flash.
+ *
+ * @param config Configuration, see ESP_FLASH_ASYNC_DEFAULT_CONFIG
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if config is NULL or queue_size is 0
+ *      - ESP_ERR_INVALID_STATE if the queue has already been created
+ *      - ESP_ERR_NO_MEM if the queue, the task or the merge buffer could not be allocated
+ */
+esp_err_t esp_flash_async_init(const esp_flash_async_config_t *config);
+
+/**
+ * @brief Wait for the queued jobs to complete, then delete the flash job queue and its task
+ *
+ * No jobs may be queued while this function runs.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the queue has not been created
+ */
+esp_err_t esp_flash_async_deinit(void);
+
+/**
+ * @brief Queue a write to flash
+ *
+ * The data is written with esp_flash_write, see its documentation for the restrictions on the
+ * arguments. The buffer is not copied, it must stay valid until done_cb is called.
+ *
+ * @param chip    Pointer to identify flash chip, NULL for the main flash chip
+ * @param buffer  Data to write
+ * @param address Address on flash to write to
+ * @param length  Length in bytes of the data to write
+ * @param done_cb Callback invoked when the write has completed, may be NULL
+ * @param arg     Argument for done_cb
+ * @return
+ *      - ESP_OK if the job was queued
+ *      - ESP_ERR_INVALID_ARG if buffer is NULL
+ *      - ESP_ERR_INVALID_STATE if the queue has not been created
+ *      - ESP_ERR_NO_MEM if the queue is full and the job is queued from a completion callback,
+ *        which can't wait for space in the queue
+ */
+esp_err_t esp_flash_async_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t length,
+                                esp_flash_async_done_cb_t done_cb, void *arg);
+
+/**
+ * @brief Queue an erase of a flash region
+ *
+ * The region is erased with esp_flash_erase_region, see its documentation for the restrictions on
+ * the arguments.
+ *
+ * @param chip    Pointer to identify flash chip, NULL for the main flash chip
+ * @param start   Address to start erasing flash, must be sector aligned
+ * @param len     Length of region to erase, must be sector aligned
+ * @param done_cb Callback invoked when the erase has completed, may be NULL
+ * @param arg     Argument for done_cb
+ * @return
+ *      - ESP_OK if the job was queued
+ *      - ESP_ERR_INVALID_STATE if the queue has not been created
+ *      - ESP_ERR_NO_MEM if the queue is full and the job is queued from a completion callback,
+ *        which can't wait for space in the queue
+ */
+esp_err_t esp_flash_async_erase_region(esp_flash_t *chip, uint32_t start, uint32_t len,
+                                       esp_flash_async_done_cb_t done_cb, void *arg);
+
+/**
+ * @brief Wait until all jobs queued before this call have completed
+ *
+ * Must not be called from a completion callback.
+ *
+ * @return
+ *      - ESP_OK when the jobs have completed
+ *      - ESP_ERR_INVALID_STATE if the queue has not been created, or if called from a completion callback
+ */
+esp_err_t esp_flash_async_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_flash.h"
+#include "esp_flash_async.h"
+#include "esp_partition.h"
+#include "spi_flash_mmap.h"
+#include "test_utils.h"
+
+extern const esp_partition_t *get_test_data_partition(void);
+
+#define WRITE_COUNT     40
+#define WRITE_SIZE      200
+
+typedef struct {
+    int done;
+    int failed;
+} job_stats_t;
+
+static void count_done(esp_err_t result, void *arg)
+{
+    job_stats_t *stats = (job_stats_t *)arg;
+    stats->done++;
+    if (result != ESP_OK) {
+        stats->failed++;
+    }
+}
+
+TEST_CASE("esp_flash_async executes queued erases and writes in order", "[esp_flash]")
+{
+    const esp_partition_t *part = get_test_data_partition();
+    const uint32_t base = part->address;
+    esp_flash_async_config_t config = ESP_FLASH_ASYNC_DEFAULT_CONFIG();
+    job_stats_t stats = { 0 };
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_flash_async_write(NULL, &stats, base, 4, NULL, NULL));
+    TEST_ESP_OK(esp_flash_async_init(&config));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_flash_async_init(&config));
+
+    uint8_t *data = malloc(WRITE_COUNT * WRITE_SIZE);
+    uint8_t *read_back = malloc(WRITE_COUNT * WRITE_SIZE);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(read_back);
+    for (int i = 0; i < WRITE_COUNT * WRITE_SIZE; i++) {
+        data[i] = i * 3 + (i >> 8);
+    }
+
+    // the writes follow the erases, and are combined into a few flash writes
+    const uint32_t erase_size = 2 * SPI_FLASH_SEC_SIZE;
+    TEST_ESP_OK(esp_flash_async_erase_region(NULL, base, SPI_FLASH_SEC_SIZE, count_done, &stats));
+    TEST_ESP_OK(esp_flash_async_erase_region(NULL, base + SPI_FLASH_SEC_SIZE, erase_size - SPI_FLASH_SEC_SIZE, count_done, &stats));
+    for (int i = 0; i < WRITE_COUNT; i++) {
+        TEST_ESP_OK(esp_flash_async_write(NULL, data + i * WRITE_SIZE, base + i * WRITE_SIZE, WRITE_SIZE, count_done, &stats));
+    }
+    TEST_ESP_OK(esp_flash_async_flush());
+    TEST_ASSERT_EQUAL(WRITE_COUNT + 2, stats.done);
+    TEST_ASSERT_EQUAL(0, stats.failed);
+
+    TEST_ESP_OK(esp_flash_read(NULL, read_back, base, WRITE_COUNT * WRITE_SIZE));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, read_back, WRITE_COUNT * WRITE_SIZE);
+
+    // an erase which fails doesn't affect the jobs around it
+    stats = (job_stats_t) { 0 };
+    TEST_ESP_OK(esp_flash_async_erase_region(NULL, base, SPI_FLASH_SEC_SIZE, count_done, &stats));
+    TEST_ESP_OK(esp_flash_async_erase_region(NULL, base + SPI_FLASH_SEC_SIZE, 1, count_done, &stats));
+    TEST_ESP_OK(esp_flash_async_write(NULL, data, base, WRITE_SIZE, count_done, &stats));
+    TEST_ESP_OK(esp_flash_async_flush());
+    TEST_ASSERT_EQUAL(3, stats.done);
+    TEST_ASSERT_EQUAL(1, stats.failed);
+    TEST_ESP_OK(esp_flash_read(NULL, read_back, base, SPI_FLASH_SEC_SIZE));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, read_back, WRITE_SIZE);
+    for (int i = WRITE_SIZE; i < SPI_FLASH_SEC_SIZE; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xff, read_back[i]);
+    }
+
+    TEST_ESP_OK(esp_flash_async_deinit());
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_flash_async_flush());
+    free(data);
+    free(read_back);
+}
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
 #include <stdio.h>
+#include <string.h>
 #include <sys/param.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -229,3 +230,52 @@ TEST_CASE("bootloader_flash_xmc_startup can be called when cache disabled", "[sp
 {
     test_xmc_startup();
 }
+
+#if CONFIG_SPI_FLASH_READ_CACHE
+TEST_CASE("flash read cache serves rereads and is invalidated by writes", "[spi_flash]")
+{
+    setup_tests();
+    const uint32_t addr = start;
+    uint8_t expected[CONFIG_SPI_FLASH_READ_CACHE_LINE_SIZE];
+    uint8_t buf[CONFIG_SPI_FLASH_READ_CACHE_LINE_SIZE];
+    esp_flash_read_cache_stats_t before, after;
+
+    for (int i = 0; i < sizeof(expected); i++) {
+        expected[i] = i;
+    }
+    TEST_ESP_OK(esp_flash_erase_region(NULL, addr, SPI_FLASH_SEC_SIZE));
+    TEST_ESP_OK(esp_flash_write(NULL, expected, addr, sizeof(expected)));
+
+    esp_flash_read_cache_get_stats(&before);
+    TEST_ESP_OK(esp_flash_read(NULL, buf, addr + 3, 10));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected + 3, buf, 10);
+    TEST_ESP_OK(esp_flash_read(NULL, buf, addr, sizeof(buf)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buf, sizeof(buf));
+    esp_flash_read_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL(before.hits + 1, after.hits);
+
+    // the line is invalidated by the write, the new data is read
+    for (int i = 0; i < sizeof(expected); i++) {
+        expected[i] &= 0x0F;
+    }
+    TEST_ESP_OK(esp_flash_write(NULL, expected, addr, sizeof(expected)));
+    TEST_ESP_OK(esp_flash_read(NULL, buf, addr, sizeof(buf)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buf, sizeof(buf));
+
+    // sequential misses prefetch the next line
+    esp_flash_read_cache_get_stats(&before);
+    for (uint32_t offset = 0; offset < 8 * sizeof(buf); offset += sizeof(buf)) {
+        TEST_ESP_OK(esp_flash_read(NULL, buf, addr + SPI_FLASH_SEC_SIZE / 2 + offset, sizeof(buf)));
+    }
+    esp_flash_read_cache_get_stats(&after);
+    TEST_ASSERT_GREATER_THAN(before.prefetches, after.prefetches);
+    TEST_ASSERT_LESS_THAN(before.misses + 8, after.misses);
+
+    // erasing invalidates the lines too
+    TEST_ESP_OK(esp_flash_erase_region(NULL, addr, SPI_FLASH_SEC_SIZE));
+    TEST_ESP_OK(esp_flash_read(NULL, buf, addr, sizeof(buf)));
+    memset(expected, 0xFF, sizeof(expected));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buf, sizeof(buf));
+}
+#endif // CONFIG_SPI_FLASH_READ_CACHE
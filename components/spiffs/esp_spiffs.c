@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -21,6 +21,7 @@
 #include "esp_vfs.h"
 #include "esp_err.h"
 #include "esp_rom_spiflash.h"
+#include "esp_timer.h"
 
 #include "spiffs_api.h"
 
@@ -83,6 +84,273 @@ static time_t vfs_spiffs_get_mtime(const spiffs_stat* s);
 
 static esp_spiffs_t * _efs[CONFIG_SPIFFS_MAX_PARTITIONS];
 
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+
+/* RAM index of the files of a partition. Each entry maps the hash of a file name
+ * to the last known page of the object index header of the file, which is passed
+ * to SPIFFS_open_by_page instead of searching the name in the whole partition.
+ * Headers move to other pages when they are rewritten or garbage collected, so
+ * an entry may be out of date. SPIFFS_open_by_page fails if the page isn't an
+ * object index header, and the name in the header is checked, then the lookup
+ * falls back to the usual search by name and the entry is updated.
+ */
+
+static uint32_t esp_spiffs_index_hash(const char *name)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < SPIFFS_OBJ_NAME_LEN && name[i] != '\0'; i++) {
+        hash = (hash ^ (uint8_t) name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/* Position of the first entry whose hash is not lower than the given one. Called with index_lock taken. */
+static size_t esp_spiffs_index_lower_bound(esp_spiffs_t *efs, uint32_t hash)
+{
+    size_t lo = 0;
+    size_t hi = efs->index_len;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (efs->index[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static bool esp_spiffs_index_get(esp_spiffs_t *efs, const char *name, spiffs_page_ix *out_pix)
+{
+    uint32_t hash = esp_spiffs_index_hash(name);
+    bool found = false;
+    _lock_acquire(&efs->index_lock);
+    size_t pos = esp_spiffs_index_lower_bound(efs, hash);
+    if (pos < efs->index_len && efs->index[pos].hash == hash) {
+        *out_pix = efs->index[pos].pix;
+        found = true;
+    }
+    _lock_release(&efs->index_lock);
+    return found;
+}
+
+static void esp_spiffs_index_set(esp_spiffs_t *efs, const char *name, spiffs_page_ix pix)
+{
+    uint32_t hash = esp_spiffs_index_hash(name);
+    _lock_acquire(&efs->index_lock);
+    size_t pos = esp_spiffs_index_lower_bound(efs, hash);
+    if (pos < efs->index_len && efs->index[pos].hash == hash) {
+        // names with the same hash share the entry, the other names are searched in the partition
+        efs->index[pos].pix = pix;
+        goto out;
+    }
+    if (efs->index_len == efs->index_cap) {
+        size_t cap = efs->index_cap ? efs->index_cap * 2 : 16;
+        esp_spiffs_index_entry_t *index = realloc(efs->index, cap * sizeof(esp_spiffs_index_entry_t));
+        if (index == NULL) {
+            // the file is searched in the partition then
+            goto out;
+        }
+        efs->index = index;
+        efs->index_cap = cap;
+    }
+    memmove(&efs->index[pos + 1], &efs->index[pos], (efs->index_len - pos) * sizeof(esp_spiffs_index_entry_t));
+    efs->index[pos].hash = hash;
+    efs->index[pos].pix = pix;
+    efs->index_len++;
+out:
+    _lock_release(&efs->index_lock);
+}
+
+#ifdef CONFIG_VFS_SUPPORT_DIR
+static void esp_spiffs_index_remove(esp_spiffs_t *efs, const char *name)
+{
+    uint32_t hash = esp_spiffs_index_hash(name);
+    _lock_acquire(&efs->index_lock);
+    size_t pos = esp_spiffs_index_lower_bound(efs, hash);
+    if (pos < efs->index_len && efs->index[pos].hash == hash) {
+        memmove(&efs->index[pos], &efs->index[pos + 1], (efs->index_len - pos - 1) * sizeof(esp_spiffs_index_entry_t));
+        efs->index_len--;
+    }
+    _lock_release(&efs->index_lock);
+}
+#endif // CONFIG_VFS_SUPPORT_DIR
+
+static void esp_spiffs_index_clear(esp_spiffs_t *efs)
+{
+    _lock_acquire(&efs->index_lock);
+    free(efs->index);
+    efs->index = NULL;
+    efs->index_len = 0;
+    efs->index_cap = 0;
+    _lock_release(&efs->index_lock);
+}
+
+static void esp_spiffs_index_build(esp_spiffs_t *efs)
+{
+    esp_spiffs_index_clear(efs);
+    spiffs_DIR d;
+    struct spiffs_dirent e;
+    if (!SPIFFS_opendir(efs->fs, "/", &d)) {
+        SPIFFS_clearerr(efs->fs);
+        return;
+    }
+    while (SPIFFS_readdir(&d, &e)) {
+        esp_spiffs_index_set(efs, (const char *) e.name, e.pix);
+    }
+    SPIFFS_closedir(&d);
+    SPIFFS_clearerr(efs->fs);
+}
+
+/* Record the current header page of an open file */
+static void esp_spiffs_index_update(esp_spiffs_t *efs, spiffs_file fd)
+{
+    spiffs_stat s;
+    if (SPIFFS_fflush(efs->fs, fd) < 0 || SPIFFS_fstat(efs->fs, fd, &s) < 0) {
+        SPIFFS_clearerr(efs->fs);
+        return;
+    }
+    esp_spiffs_index_set(efs, (const char *) s.name, s.pix);
+}
+
+/* Open an existing file through its index entry, and get its status.
+ * Returns -1 if the entry is missing or out of date.
+ */
+static spiffs_file esp_spiffs_index_open(esp_spiffs_t *efs, const char *path, spiffs_flags flags, spiffs_stat *s)
+{
+    spiffs_page_ix pix;
+    if (!esp_spiffs_index_get(efs, path, &pix)) {
+        return -1;
+    }
+    // don't truncate until the right file is opened
+    spiffs_file fd = SPIFFS_open_by_page(efs->fs, pix, flags & ~SPIFFS_O_TRUNC, 0);
+    if (fd < 0) {
+        SPIFFS_clearerr(efs->fs);
+        return -1;
+    }
+    if (SPIFFS_fstat(efs->fs, fd, s) < 0 || strncmp((const char *) s->name, path, SPIFFS_OBJ_NAME_LEN) != 0 ||
+            ((flags & SPIFFS_O_TRUNC) && SPIFFS_ftruncate(efs->fs, fd, 0) < 0)) {
+        SPIFFS_clearerr(efs->fs);
+        SPIFFS_close(efs->fs, fd);
+        return -1;
+    }
+    return fd;
+}
+
+#endif // CONFIG_SPIFFS_OPEN_INDEX
+
+#ifdef CONFIG_SPIFFS_BACKGROUND_GC
+
+/* Collect the garbage of one block. Returns false if there was nothing to collect. */
+static bool esp_spiffs_gc_step(esp_spiffs_t *efs)
+{
+    spiffs *fs = efs->fs;
+    u32_t deleted_pages = fs->stats_p_deleted;
+    if (deleted_pages == 0) {
+        return false;
+    }
+    int64_t start = esp_timer_get_time();
+    // erasing a block which holds only deleted pages doesn't move any page
+    s32_t res = SPIFFS_gc_quick(fs, 0);
+    if (res != SPIFFS_OK) {
+        SPIFFS_clearerr(fs);
+        // ask for one page more than is free, SPIFFS collects the block with the most deleted pages
+        u32_t total = 0;
+        u32_t used = 0;
+        SPIFFS_info(fs, &total, &used);
+        u32_t deleted = fs->stats_p_deleted * SPIFFS_DATA_PAGE_SIZE(fs);
+        if (used + deleted > total) {
+            return false;
+        }
+        res = SPIFFS_gc(fs, total - used - deleted + SPIFFS_DATA_PAGE_SIZE(fs));
+    }
+    SPIFFS_clearerr(fs);
+    efs->gc_time_us += esp_timer_get_time() - start;
+    if (res != SPIFFS_OK || fs->stats_p_deleted >= deleted_pages) {
+        return false;
+    }
+    efs->gc_runs++;
+    return true;
+}
+
+static void esp_spiffs_gc_task(void *arg)
+{
+    esp_spiffs_t *efs = (esp_spiffs_t *)arg;
+    while (!efs->gc_stop) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (!efs->gc_stop && efs->fs->free_blocks < CONFIG_SPIFFS_BACKGROUND_GC_FREE_BLOCKS) {
+            if (!esp_spiffs_gc_step(efs)) {
+                break;
+            }
+        }
+    }
+    xSemaphoreGive(efs->gc_done);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t esp_spiffs_gc_start(esp_spiffs_t *efs)
+{
+    efs->gc_done = xSemaphoreCreateBinary();
+    if (efs->gc_done == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(esp_spiffs_gc_task, "spiffs_gc", CONFIG_SPIFFS_BACKGROUND_GC_TASK_STACK_SIZE,
+                    efs, CONFIG_SPIFFS_BACKGROUND_GC_TASK_PRIORITY, &efs->gc_task) != pdPASS) {
+        vSemaphoreDelete(efs->gc_done);
+        efs->gc_done = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    // top up the free blocks of the partition as it is after mounting
+    xTaskNotifyGive(efs->gc_task);
+    return ESP_OK;
+}
+
+static void esp_spiffs_gc_stop(esp_spiffs_t *efs)
+{
+    if (efs->gc_task == NULL) {
+        return;
+    }
+    efs->gc_stop = true;
+    xTaskNotifyGive(efs->gc_task);
+    xSemaphoreTake(efs->gc_done, portMAX_DELAY);
+    vSemaphoreDelete(efs->gc_done);
+    efs->gc_task = NULL;
+    efs->gc_done = NULL;
+}
+
+/* Wake up the background GC task if the partition is running out of free blocks */
+static void esp_spiffs_gc_notify(esp_spiffs_t *efs)
+{
+    if (efs->gc_task && efs->fs->free_blocks < CONFIG_SPIFFS_BACKGROUND_GC_FREE_BLOCKS) {
+        xTaskNotifyGive(efs->gc_task);
+    }
+}
+
+#endif // CONFIG_SPIFFS_BACKGROUND_GC
+
+/* Open a file, using the index of the files if it is enabled */
+static spiffs_file esp_spiffs_open(esp_spiffs_t *efs, const char *path, spiffs_flags flags, spiffs_mode mode)
+{
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    // O_EXCL needs to know that the file doesn't exist, which the index can't tell
+    if (!(flags & SPIFFS_O_EXCL)) {
+        spiffs_stat s;
+        spiffs_file fd = esp_spiffs_index_open(efs, path, flags, &s);
+        if (fd >= 0) {
+            return fd;
+        }
+    }
+    spiffs_file fd = SPIFFS_open(efs->fs, path, flags, mode);
+    if (fd >= 0) {
+        esp_spiffs_index_update(efs, fd);
+    }
+    return fd;
+#else
+    return SPIFFS_open(efs->fs, path, flags, mode);
+#endif
+}
+
 static void esp_spiffs_free(esp_spiffs_t ** efs)
 {
     esp_spiffs_t * e = *efs;
@@ -96,6 +364,10 @@ static void esp_spiffs_free(esp_spiffs_t ** efs)
         free(e->fs);
     }
     vSemaphoreDelete(e->lock);
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    free(e->index);
+    _lock_close(&e->index_lock);
+#endif
     free(e->fds);
     free(e->cache);
     free(e->work);
@@ -208,6 +480,9 @@ static esp_err_t esp_spiffs_init(const esp_vfs_spiffs_conf_t* conf)
         ESP_LOGE(TAG, "esp_spiffs could not be malloced");
         return ESP_ERR_NO_MEM;
     }
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    _lock_init(&efs->index_lock);
+#endif
 
     efs->cfg.hal_erase_f       = spiffs_api_erase;
     efs->cfg.hal_read_f        = spiffs_api_read;
@@ -375,12 +650,31 @@ esp_err_t esp_spiffs_format(const char* partition_label)
             SPIFFS_clearerr(_efs[index]->fs);
             return ESP_FAIL;
         }
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+        esp_spiffs_index_clear(_efs[index]);
+#endif
     } else {
         esp_spiffs_free(&_efs[index]);
     }
     return ESP_OK;
 }
 
+esp_err_t esp_spiffs_gc_stats(const char* partition_label, esp_spiffs_gc_stats_t *stats)
+{
+    int index;
+    if (esp_spiffs_by_label(partition_label, &index) != ESP_OK) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_spiffs_t *efs = _efs[index];
+    memset(stats, 0, sizeof(*stats));
+    stats->free_blocks = efs->fs->free_blocks;
+#ifdef CONFIG_SPIFFS_BACKGROUND_GC
+    stats->background_gc_runs = efs->gc_runs;
+    stats->background_gc_time_us = efs->gc_time_us;
+#endif
+    return ESP_OK;
+}
+
 esp_err_t esp_spiffs_gc(const char* partition_label, size_t size_to_gc)
 {
     int index;
@@ -462,6 +756,20 @@ esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t * conf)
         return err;
     }
 
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    esp_spiffs_index_build(_efs[index]);
+#endif
+#ifdef CONFIG_SPIFFS_BACKGROUND_GC
+    if (!_efs[index]->partition->readonly) {
+        err = esp_spiffs_gc_start(_efs[index]);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "background GC task could not be created");
+            esp_vfs_unregister(_efs[index]->base_path);
+            esp_spiffs_free(&_efs[index]);
+            return err;
+        }
+    }
+#endif
     return ESP_OK;
 }
 
@@ -475,6 +783,9 @@ esp_err_t esp_vfs_spiffs_unregister(const char* partition_label)
     if (err != ESP_OK) {
         return err;
     }
+#ifdef CONFIG_SPIFFS_BACKGROUND_GC
+    esp_spiffs_gc_stop(_efs[index]);
+#endif
     esp_spiffs_free(&_efs[index]);
     return ESP_OK;
 }
@@ -543,7 +854,7 @@ static int vfs_spiffs_open(void* ctx, const char * path, int flags, int mode)
     assert(path);
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
     int spiffs_flags = spiffs_mode_conv(flags);
-    int fd = SPIFFS_open(efs->fs, path, spiffs_flags, mode);
+    int fd = esp_spiffs_open(efs, path, spiffs_flags, mode);
     if (fd < 0) {
         errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
         SPIFFS_clearerr(efs->fs);
@@ -564,6 +875,9 @@ static ssize_t vfs_spiffs_write(void* ctx, int fd, const void * data, size_t siz
         SPIFFS_clearerr(efs->fs);
         return -1;
     }
+#ifdef CONFIG_SPIFFS_BACKGROUND_GC
+    esp_spiffs_gc_notify(efs);
+#endif
     return res;
 }
 
@@ -582,6 +896,10 @@ static ssize_t vfs_spiffs_read(void* ctx, int fd, void * dst, size_t size)
 static int vfs_spiffs_close(void* ctx, int fd)
 {
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    // writing the file moves its object index header
+    esp_spiffs_index_update(efs, fd);
+#endif
     int res = SPIFFS_close(efs->fs, fd);
     if (res < 0) {
         errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
@@ -643,11 +961,23 @@ static int vfs_spiffs_stat(void* ctx, const char * path, struct stat * st)
     assert(st);
     spiffs_stat s;
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
-    off_t res = SPIFFS_stat(efs->fs, path, &s);
-    if (res < 0) {
-        errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
-        SPIFFS_clearerr(efs->fs);
-        return -1;
+    off_t res = SPIFFS_OK;
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    spiffs_file fd = esp_spiffs_index_open(efs, path, SPIFFS_O_RDONLY, &s);
+    if (fd >= 0) {
+        SPIFFS_close(efs->fs, fd);
+    } else
+#endif
+    {
+        res = SPIFFS_stat(efs->fs, path, &s);
+        if (res < 0) {
+            errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
+            SPIFFS_clearerr(efs->fs);
+            return -1;
+        }
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+        esp_spiffs_index_set(efs, path, s.pix);
+#endif
     }
     memset(st, 0, sizeof(*st));
     st->st_size = s.size;
@@ -670,6 +1000,10 @@ static int vfs_spiffs_rename(void* ctx, const char *src, const char *dst)
         SPIFFS_clearerr(efs->fs);
         return -1;
     }
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    esp_spiffs_index_remove(efs, src);
+    esp_spiffs_index_remove(efs, dst);
+#endif
     return res;
 }
 
@@ -683,6 +1017,12 @@ static int vfs_spiffs_unlink(void* ctx, const char *path)
         SPIFFS_clearerr(efs->fs);
         return -1;
     }
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    esp_spiffs_index_remove(efs, path);
+#endif
+#ifdef CONFIG_SPIFFS_BACKGROUND_GC
+    esp_spiffs_gc_notify(efs);
+#endif
     return res;
 }
 
@@ -826,7 +1166,7 @@ static int vfs_spiffs_truncate(void* ctx, const char *path, off_t length)
 {
     assert(path);
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
-    int fd = SPIFFS_open(efs->fs, path, SPIFFS_WRONLY, 0);
+    int fd = esp_spiffs_open(efs, path, SPIFFS_WRONLY, 0);
     if (fd < 0) {
         goto err;
     }
@@ -836,6 +1176,9 @@ static int vfs_spiffs_truncate(void* ctx, const char *path, off_t length)
         (void)SPIFFS_close(efs->fs, fd);
         goto err;
     }
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    esp_spiffs_index_update(efs, fd);
+#endif
 
     res = SPIFFS_close(efs->fs, fd);
     if (res < 0) {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,8 @@
 #define _ESP_SPIFFS_H_
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -124,6 +126,26 @@ esp_err_t esp_spiffs_check(const char* partition_label);
  */
 esp_err_t esp_spiffs_gc(const char* partition_label, size_t size_to_gc);
 
+/**
+ * @brief Garbage collection statistics of a SPIFFS partition
+ */
+typedef struct {
+    size_t free_blocks;             /*!< Number of erased blocks. Writes collect garbage when only a few blocks are left */
+    uint32_t background_gc_runs;    /*!< Number of times the background task has collected garbage (CONFIG_SPIFFS_BACKGROUND_GC) */
+    uint64_t background_gc_time_us; /*!< Time spent by the background task collecting garbage, in microseconds */
+} esp_spiffs_gc_stats_t;
+
+/**
+ * @brief Get garbage collection statistics of a SPIFFS partition
+ *
+ * @param partition_label  Same label as passed to esp_vfs_spiffs_register
+ * @param[out] stats       Statistics
+ * @return
+ *          - ESP_OK                  if success
+ *          - ESP_ERR_INVALID_STATE   if not mounted
+ */
+esp_err_t esp_spiffs_gc_stats(const char* partition_label, esp_spiffs_gc_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
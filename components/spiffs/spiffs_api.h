@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,8 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <sys/lock.h>
+#include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
@@ -20,6 +22,16 @@ extern "C" {
 
 #define ESP_SPIFFS_PATH_MAX 15
 
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+/**
+ * @brief Entry of the RAM index of the files, see CONFIG_SPIFFS_OPEN_INDEX
+ */
+typedef struct {
+    uint32_t hash;                          /*!< Hash of the file name */
+    spiffs_page_ix pix;                     /*!< Last known page of the object index header of the file */
+} esp_spiffs_index_entry_t;
+#endif
+
 /**
  * @brief SPIFFS definition structure
  */
@@ -35,6 +47,19 @@ typedef struct {
     uint32_t fds_sz;                        /*!< File Descriptor Buffer Length */
     uint8_t *cache;                         /*!< Cache Buffer */
     uint32_t cache_sz;                      /*!< Cache Buffer Length */
+#ifdef CONFIG_SPIFFS_BACKGROUND_GC
+    TaskHandle_t gc_task;                   /*!< Background GC task */
+    SemaphoreHandle_t gc_done;              /*!< Given by the background GC task when it exits */
+    volatile bool gc_stop;                  /*!< Tells the background GC task to exit */
+    uint32_t gc_runs;                       /*!< Number of blocks collected by the background GC task */
+    uint64_t gc_time_us;                    /*!< Time spent in the background GC task collecting garbage */
+#endif
+#ifdef CONFIG_SPIFFS_OPEN_INDEX
+    _lock_t index_lock;                     /*!< Lock of the index */
+    esp_spiffs_index_entry_t *index;        /*!< Index of the files, sorted by hash */
+    size_t index_len;                       /*!< Number of entries in the index */
+    size_t index_cap;                       /*!< Number of entries the index can hold */
+#endif
 } esp_spiffs_t;
 
 s32_t spiffs_api_read(spiffs *fs, uint32_t addr, uint32_t size, uint8_t *dst);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,6 +7,7 @@
 #include "sdkconfig.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <inttypes.h>
 #include <string.h>
 #include <time.h>
 #include <fcntl.h>
@@ -964,3 +965,94 @@ TEST_CASE("SPIFFS garbage-collect", "[spiffs][timeout=60]")
 
     test_teardown();
 }
+
+static void test_spiffs_check_text(const char* name, const char* text)
+{
+    char buf[32] = { 0 };
+    FILE* f = fopen(name, "r");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(strlen(text), fread(buf, 1, sizeof(buf) - 1, f));
+    TEST_ASSERT_EQUAL_STRING(text, buf);
+    TEST_ASSERT_EQUAL(0, fclose(f));
+
+    struct stat st;
+    TEST_ASSERT_EQUAL(0, stat(name, &st));
+    TEST_ASSERT_EQUAL(strlen(text), st.st_size);
+}
+
+TEST_CASE("files are found after they are rewritten, renamed and removed", "[spiffs]")
+{
+    const int files_count = 20;
+    char name[32];
+    char text[32];
+    test_setup();
+    for (int i = 0; i < files_count; ++i) {
+        snprintf(name, sizeof(name), "/spiffs/idx_%d.txt", i);
+        snprintf(text, sizeof(text), "file %d\n", i);
+        test_spiffs_create_file_with_text(name, text);
+    }
+    // mount again, to look up the files which were there when the partition was registered
+    test_teardown();
+    test_setup();
+    for (int i = 0; i < files_count; ++i) {
+        snprintf(name, sizeof(name), "/spiffs/idx_%d.txt", i);
+        snprintf(text, sizeof(text), "file %d\n", i);
+        test_spiffs_check_text(name, text);
+        if (i % 2) {
+            snprintf(text, sizeof(text), "rewritten %d\n", i);
+            test_spiffs_create_file_with_text(name, text);
+        }
+    }
+    // garbage collection moves the pages of the files
+    TEST_ESP_OK(esp_spiffs_gc(spiffs_test_partition_label, 4096));
+    TEST_ASSERT_EQUAL(0, rename("/spiffs/idx_0.txt", "/spiffs/idx_moved.txt"));
+    TEST_ASSERT_EQUAL(0, unlink("/spiffs/idx_1.txt"));
+
+    struct stat st;
+    TEST_ASSERT_EQUAL(-1, stat("/spiffs/idx_0.txt", &st));
+    TEST_ASSERT_NULL(fopen("/spiffs/idx_1.txt", "r"));
+    test_spiffs_check_text("/spiffs/idx_moved.txt", "file 0\n");
+    for (int i = 2; i < files_count; ++i) {
+        snprintf(name, sizeof(name), "/spiffs/idx_%d.txt", i);
+        snprintf(text, sizeof(text), (i % 2) ? "rewritten %d\n" : "file %d\n", i);
+        test_spiffs_check_text(name, text);
+        TEST_ASSERT_EQUAL(0, unlink(name));
+    }
+    TEST_ASSERT_EQUAL(0, unlink("/spiffs/idx_moved.txt"));
+    test_teardown();
+}
+
+#ifdef CONFIG_SPIFFS_BACKGROUND_GC
+TEST_CASE("background GC keeps free blocks", "[spiffs][timeout=60]")
+{
+    const esp_partition_t* part = get_partition();
+    TEST_ESP_OK(esp_partition_erase_range(part, 0, part->size));
+    test_setup();
+
+    const size_t buf_size = 4096;
+    uint8_t* buf = calloc(1, buf_size);
+    TEST_ASSERT_NOT_NULL(buf);
+    // rewrite a file which takes a third of the partition, leaving deleted pages behind
+    for (int i = 0; i < 4; ++i) {
+        FILE* f = fopen("/spiffs/gc.bin", "wb");
+        TEST_ASSERT_NOT_NULL(f);
+        for (size_t written = 0; written < part->size / 3; written += buf_size) {
+            TEST_ASSERT_EQUAL(buf_size, fwrite(buf, 1, buf_size, f));
+        }
+        TEST_ASSERT_EQUAL(0, fclose(f));
+    }
+    free(buf);
+    // let the background task run
+    vTaskDelay(pdMS_TO_TICKS(1000));
+
+    esp_spiffs_gc_stats_t stats;
+    TEST_ESP_OK(esp_spiffs_gc_stats(spiffs_test_partition_label, &stats));
+    printf("free blocks: %zu, background GC runs: %" PRIu32 ", time: %" PRIu64 " us\n",
+           stats.free_blocks, stats.background_gc_runs, stats.background_gc_time_us);
+    TEST_ASSERT_GREATER_THAN(0, stats.background_gc_runs);
+    TEST_ASSERT_GREATER_OR_EQUAL(CONFIG_SPIFFS_BACKGROUND_GC_FREE_BLOCKS, stats.free_blocks);
+
+    TEST_ASSERT_EQUAL(0, unlink("/spiffs/gc.bin"));
+    test_teardown();
+}
+#endif // CONFIG_SPIFFS_BACKGROUND_GC
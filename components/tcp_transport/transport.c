@@ -7,6 +7,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
 #include <esp_tls.h>
 
 #include "sys/queue.h"
@@ -150,6 +151,34 @@ int esp_transport_write(esp_transport_handle_t t, const char *buffer, int len, i
     return -1;
 }
 
+int esp_transport_writev(esp_transport_handle_t t, const struct iovec *iov, int iovcnt, int timeout_ms)
+{
+    if (t == NULL || iov == NULL || iovcnt <= 0) {
+        return -1;
+    }
+    if (t->_writev) {
+        return t->_writev(t, iov, iovcnt, timeout_ms);
+    }
+    if (t->_write == NULL) {
+        return -1;
+    }
+    int written = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len == 0) {
+            continue;
+        }
+        int ret = t->_write(t, iov[i].iov_base, iov[i].iov_len, timeout_ms);
+        if (ret < 0) {
+            return written > 0 ? written : ret;
+        }
+        written += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return written;
+}
+
 int esp_transport_poll_read(esp_transport_handle_t t, int timeout_ms)
 {
     if (t && t->_poll_read) {
@@ -210,6 +239,7 @@ esp_err_t esp_transport_set_func(esp_transport_handle_t t,
     t->_poll_read = _poll_read;
     t->_poll_write = _poll_write;
     t->_destroy = _destroy;
+    t->_writev = NULL;
     t->_connect_async = NULL;
     t->_parent_transfer = esp_transport_get_default_parent;
     return ESP_OK;
@@ -241,6 +271,15 @@ esp_err_t esp_transport_set_async_connect_func(esp_transport_handle_t t, connect
     return ESP_OK;
 }
 
+esp_err_t esp_transport_set_writev_func(esp_transport_handle_t t, io_writev_func _writev)
+{
+    if (t == NULL) {
+        return ESP_FAIL;
+    }
+    t->_writev = _writev;
+    return ESP_OK;
+}
+
 esp_err_t esp_transport_set_parent_transport_func(esp_transport_handle_t t, payload_transfer_func _parent_transport)
 {
     if (t == NULL) {
@@ -257,6 +257,47 @@ static int tcp_write(esp_transport_handle_t t, const char *buffer, int len, int
     return ret;
 }
 
+static int ssl_writev(esp_transport_handle_t t, const struct iovec *iov, int iovcnt, int timeout_ms)
+{
+    int poll;
+    transport_esp_tls_t *ssl = ssl_get_context_data(t);
+    ESP_STATIC_ANALYZER_CHECK(ssl == NULL, -1);
+
+    if ((poll = esp_transport_poll_write(t, timeout_ms)) <= 0) {
+        ESP_LOGW(TAG, "Poll timeout or error, errno=%s, fd=%d, timeout_ms=%d", strerror(errno), ssl->sockfd, timeout_ms);
+        return poll;
+    }
+    int ret = esp_tls_conn_writev(ssl->tls, iov, iovcnt);
+    if (ret < 0) {
+        ESP_LOGE(TAG, "esp_tls_conn_writev error, errno=%s", strerror(errno));
+        esp_tls_error_handle_t esp_tls_error_handle;
+        if (esp_tls_get_error_handle(ssl->tls, &esp_tls_error_handle) == ESP_OK) {
+            esp_transport_set_errors(t, esp_tls_error_handle);
+        } else {
+            ESP_LOGE(TAG, "Error in obtaining the error handle");
+        }
+    }
+    return ret;
+}
+
+static int tcp_writev(esp_transport_handle_t t, const struct iovec *iov, int iovcnt, int timeout_ms)
+{
+    int poll;
+    transport_esp_tls_t *ssl = ssl_get_context_data(t);
+    ESP_STATIC_ANALYZER_CHECK(ssl == NULL, -1);
+
+    if ((poll = esp_transport_poll_write(t, timeout_ms)) <= 0) {
+        ESP_LOGW(TAG, "Poll timeout or error, errno=%s, fd=%d, timeout_ms=%d", strerror(errno), ssl->sockfd, timeout_ms);
+        return poll;
+    }
+    int ret = writev(ssl->sockfd, iov, iovcnt);
+    if (ret < 0) {
+        ESP_LOGE(TAG, "tcp_writev error, errno=%s", strerror(errno));
+        esp_transport_capture_errno(t, errno);
+    }
+    return ret;
+}
+
 static int ssl_read(esp_transport_handle_t t, char *buffer, int len, int timeout_ms)
 {
     transport_esp_tls_t *ssl = ssl_get_context_data(t);
@@ -543,6 +584,7 @@ esp_transport_handle_t esp_transport_ssl_init(void)
     ((transport_esp_tls_t *)ssl_transport->data)->cfg.is_plain_tcp = false;
     esp_transport_set_func(ssl_transport, ssl_connect, ssl_read, ssl_write, base_close, base_poll_read, base_poll_write, base_destroy);
     esp_transport_set_async_connect_func(ssl_transport, ssl_connect_async);
+    esp_transport_set_writev_func(ssl_transport, ssl_writev);
     ssl_transport->_get_socket = base_get_socket;
     return ssl_transport;
 }
@@ -565,6 +607,7 @@ esp_transport_handle_t esp_transport_tcp_init(void)
     ((transport_esp_tls_t *)tcp_transport->data)->cfg.is_plain_tcp = true;
     esp_transport_set_func(tcp_transport, tcp_connect, tcp_read, tcp_write, base_close, base_poll_read, base_poll_write, base_destroy);
     esp_transport_set_async_connect_func(tcp_transport, tcp_connect_async);
+    esp_transport_set_writev_func(tcp_transport, tcp_writev);
     tcp_transport->_get_socket = base_get_socket;
     return tcp_transport;
 }
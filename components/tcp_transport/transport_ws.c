@@ -352,13 +352,40 @@ static int ws_connect(esp_transport_handle_t t, const char *host, int port, int
     return 0;
 }
 
+/* XOR the buffer with the mask key in place, a word at a time once the buffer is aligned */
+static void ws_mask_buffer(char *buffer, int len, const char *mask_key)
+{
+    int i = 0;
+    for (; i < len && ((uintptr_t)(buffer + i) & (sizeof(uint32_t) - 1)); ++i) {
+        buffer[i] ^= mask_key[i % 4];
+    }
+    if (len - i >= (int)sizeof(uint32_t)) {
+        /* Rotate the mask key so that it starts at the first aligned byte */
+        char rotated[4];
+        for (int j = 0; j < 4; ++j) {
+            rotated[j] = mask_key[(i + j) % 4];
+        }
+        uint32_t mask_word;
+        memcpy(&mask_word, rotated, sizeof(mask_word));
+        for (; len - i >= (int)sizeof(uint32_t); i += sizeof(uint32_t)) {
+            uint32_t word;
+            memcpy(&word, buffer + i, sizeof(word));
+            word ^= mask_word;
+            memcpy(buffer + i, &word, sizeof(word));
+        }
+    }
+    for (; i < len; ++i) {
+        buffer[i] ^= mask_key[i % 4];
+    }
+}
+
 static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const char *b, int len, int timeout_ms)
 {
     transport_ws_t *ws = esp_transport_get_context_data(t);
     char *buffer = (char *)b;
     char ws_header[MAX_WEBSOCKET_HEADER_SIZE];
     char *mask;
-    int header_len = 0, i;
+    int header_len = 0;
 
     int poll_write;
     if ((poll_write = esp_transport_poll_write(ws->parent, timeout_ms)) <= 0) {
@@ -395,29 +422,30 @@ static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const
         }
         header_len += 4;
 
-        for (i = 0; i < len; ++i) {
-            buffer[i] = (buffer[i] ^ mask[i % 4]);
+        if (len > 0) {
+            ws_mask_buffer(buffer, len, mask);
         }
     }
 
-    if (esp_transport_write(ws->parent, ws_header, header_len, timeout_ms) != header_len) {
+    // header and payload are handed over to the parent transport in a single write, without assembling a contiguous copy
+    struct iovec iov[2] = {
+        { .iov_base = ws_header, .iov_len = header_len },
+        { .iov_base = buffer, .iov_len = len },
+    };
+    int ret = esp_transport_writev(ws->parent, iov, len > 0 ? 2 : 1, timeout_ms);
+    // in case of masked transport we have to revert back to the original data, as ws layer
+    // does not create its own copy of data to be sent
+    if (mask_flag && len > 0) {
+        ws_mask_buffer(buffer, len, mask);
+    }
+    if (ret < header_len) {
         ESP_LOGE(TAG, "Error write header");
         return -1;
     }
     if (len == 0) {
         return 0;
     }
-
-    int ret = esp_transport_write(ws->parent, buffer, len, timeout_ms);
-    // in case of masked transport we have to revert back to the original data, as ws layer
-    // does not create its own copy of data to be sent
-    if (mask_flag) {
-        mask = &ws_header[header_len - 4];
-        for (i = 0; i < len; ++i) {
-            buffer[i] = (buffer[i] ^ mask[i % 4]);
-        }
-    }
-    return ret;
+    return ret - header_len;
 }
 
 int esp_transport_ws_send_raw(esp_transport_handle_t t, ws_transport_opcodes_t opcode, const char *b, int len, int timeout_ms)
@@ -466,9 +494,7 @@ static int ws_read_payload(esp_transport_handle_t t, char *buffer, int len, int
     }
     ws->frame_state.bytes_remaining -= rlen;
 
-    for (int i = 0; i < bytes_to_read; i++) {
-        buffer[i] = (buffer[i] ^ ws->frame_state.mask_key[i % 4]);
-    }
+    ws_mask_buffer(buffer, bytes_to_read, ws->frame_state.mask_key);
     return rlen;
 }
 
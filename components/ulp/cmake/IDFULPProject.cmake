@@ -118,6 +118,7 @@ function(ulp_apply_default_sources ulp_app_name)
         "${IDF_PATH}/components/ulp/lp_core/shared/ulp_lp_core_lp_timer_shared.c"
         "${IDF_PATH}/components/ulp/lp_core/lp_core/lp_core_startup.c"
         "${IDF_PATH}/components/ulp/lp_core/lp_core/lp_core_utils.c"
+        "${IDF_PATH}/components/ulp/lp_core/lp_core/lp_core_jobs.c"
 
         "${IDF_PATH}/components/hal/uart_hal_iram.c"
         "${IDF_PATH}/components/hal/uart_hal.c"
@@ -130,7 +131,8 @@ function(ulp_apply_default_sources ulp_app_name)
         "${IDF_PATH}/components/ulp/lp_core/lp_core/lp_core_ubsan.c"
         "${IDF_PATH}/components/ulp/lp_core/shared/ulp_lp_core_lp_adc_shared.c"
         "${IDF_PATH}/components/ulp/lp_core/shared/ulp_lp_core_lp_vad_shared.c"
-        "${IDF_PATH}/components/ulp/lp_core/shared/ulp_lp_core_critical_section_shared.c")
+        "${IDF_PATH}/components/ulp/lp_core/shared/ulp_lp_core_critical_section_shared.c"
+        "${IDF_PATH}/components/ulp/lp_core/shared/ulp_lp_core_ring_shared.c")
 
         if(CONFIG_SOC_TOUCH_SENSOR_SUPPORTED)
             list(APPEND ULP_S_SOURCES
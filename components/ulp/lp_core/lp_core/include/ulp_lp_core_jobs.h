@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Function of a periodic LP core job
+ *
+ * The function runs on the LP core and shares its results with the main CPU through global variables of the
+ * LP core program.
+ *
+ * @param arg Argument of the job
+ * @return true to wake up the main CPU, false otherwise
+ */
+typedef bool (*ulp_lp_core_job_fn_t)(void *arg);
+
+/**
+ * @brief Periodic LP core job, see ULP_LP_CORE_JOB()
+ */
+typedef struct {
+    ulp_lp_core_job_fn_t fn;    /*!< Job function */
+    void *arg;                  /*!< Argument passed to the job function */
+    uint32_t period_ms;         /*!< Period of the job in milliseconds */
+    uint32_t run_count;         /*!< Number of times the job has run */
+    uint64_t period_ticks;      /*!< Period of the job in LP timer ticks, computed at the first run */
+    uint64_t next_run;          /*!< LP timer count of the next run */
+} ulp_lp_core_job_t;
+
+/**
+ * @brief Initializer of a periodic LP core job
+ *
+ * @param job_fn Job function, see ulp_lp_core_job_fn_t
+ * @param job_arg Argument passed to the job function
+ * @param period Period of the job in milliseconds
+ */
+#define ULP_LP_CORE_JOB(job_fn, job_arg, period) { .fn = (job_fn), .arg = (job_arg), .period_ms = (period) }
+
+/**
+ * @brief Run the jobs which are due and schedule the next wakeup of the LP core
+ *
+ * Call this function from the main() of the LP core program. The jobs run for the first time at the first call.
+ * Afterwards, each job runs once per period; the runs missed while the LP core was busy are skipped.
+ *
+ * The LP timer is set to wake up the LP core when the next job is due. If the main CPU starts the LP core with
+ * ULP_LP_CORE_WAKEUP_SOURCE_LP_TIMER and a lp_timer_sleep_duration_us of 0, the LP core only wakes up when there
+ * is work to do. A non-zero sleep duration overrides this schedule after main() returns.
+ *
+ * If any job returns true, the main CPU is woken up with ulp_lp_core_wakeup_main_processor().
+ *
+ * @note Only available on targets with an LP timer.
+ *
+ * @param jobs Array of jobs, must stay valid between the wakeups, e.g. a global variable
+ * @param num_jobs Number of jobs in the array
+ * @return Bit mask of the jobs which requested to wake up the main CPU, bit N for jobs[N], up to 32 jobs
+ */
+uint32_t ulp_lp_core_jobs_run(ulp_lp_core_job_t *jobs, size_t num_jobs);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "soc/soc_caps.h"
+
+#if SOC_LP_TIMER_SUPPORTED
+#include "ulp_lp_core_jobs.h"
+#include "ulp_lp_core_utils.h"
+#include "ulp_lp_core_lp_timer_shared.h"
+
+uint32_t ulp_lp_core_jobs_run(ulp_lp_core_job_t *jobs, size_t num_jobs)
+{
+    uint32_t wake_mask = 0;
+    uint64_t next_wakeup = UINT64_MAX;
+    uint64_t now = ulp_lp_core_lp_timer_get_cycle_count();
+
+    for (size_t i = 0; i < num_jobs; i++) {
+        ulp_lp_core_job_t *job = &jobs[i];
+
+        if (job->period_ticks == 0) {
+            job->period_ticks = ulp_lp_core_lp_timer_calculate_sleep_ticks((uint64_t)job->period_ms * 1000);
+            if (job->period_ticks == 0) {
+                job->period_ticks = 1;
+            }
+            job->next_run = now;
+        }
+
+        if (now >= job->next_run) {
+            job->run_count++;
+            if (job->fn(job->arg) && i < 32) {
+                wake_mask |= 1U << i;
+            }
+            /* Keep the runs aligned on the period, skip the ones which were missed */
+            job->next_run += job->period_ticks;
+            if (job->next_run <= now) {
+                job->next_run += ((now - job->next_run) / job->period_ticks + 1) * job->period_ticks;
+            }
+        }
+
+        if (job->next_run < next_wakeup) {
+            next_wakeup = job->next_run;
+        }
+    }
+
+    if (num_jobs > 0) {
+        /* The jobs took some time, the next one may be due already */
+        now = ulp_lp_core_lp_timer_get_cycle_count();
+        ulp_lp_core_lp_timer_set_wakeup_ticks(next_wakeup > now ? next_wakeup - now : 1);
+    }
+
+    if (wake_mask) {
+        ulp_lp_core_wakeup_main_processor();
+    }
+    return wake_mask;
+}
+#endif //SOC_LP_TIMER_SUPPORTED
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Single producer, single consumer ring buffer shared between the main CPU and the LP core
+ *
+ * The ring lives in LP memory, defined in the LP core program with ULP_LP_CORE_RING_DEFINE(). It is accessed from
+ * the main CPU through the symbol exported for it, e.g. `ulp_<name>`. One side pushes items, the other one pops
+ * them, without any lock: each index is written by one side only.
+ *
+ * When the number of queued items reaches the wake threshold, the producer wakes up the consumer once:
+ * the LP core wakes up the main CPU with ulp_lp_core_wakeup_main_processor(), the main CPU triggers the LP core
+ * software interrupt. The next wakeup happens after the consumer has popped items again, so a batch of samples
+ * costs one wakeup of the consumer.
+ *
+ * @note The items are stored right after this header, see ULP_LP_CORE_RING_DEFINE().
+ */
+typedef struct {
+    volatile uint32_t head;             /*!< Number of items pushed, written by the producer only */
+    volatile uint32_t tail;             /*!< Number of items popped, written by the consumer only */
+    volatile uint32_t wake_pending;     /*!< Set by the producer when it wakes the consumer, cleared by the consumer */
+    volatile uint32_t dropped;          /*!< Number of items dropped because the ring was full */
+    uint32_t item_size;                 /*!< Size of an item in bytes, multiple of 4 */
+    uint32_t length;                    /*!< Number of items the ring holds, power of 2 */
+    uint32_t wake_threshold;            /*!< Number of queued items waking up the consumer, 0 to never wake it */
+    uint32_t reserved;
+} ulp_lp_core_ring_t;
+
+/**
+ * @brief Define a ring in the LP core program
+ *
+ * The ring is initialized statically, so it is ready as soon as the LP core binary is loaded by
+ * ulp_lp_core_load_binary(), before either side runs.
+ *
+ * @param name Name of the ring variable, the main CPU accesses it as `ulp_<name>`
+ * @param type Type of the items, its size must be a multiple of 4 bytes
+ * @param len Number of items the ring holds, power of 2
+ * @param threshold Number of queued items waking up the consumer, 0 to never wake it
+ */
+#define ULP_LP_CORE_RING_DEFINE(name, type, len, threshold)                                     \
+    _Static_assert((sizeof(type) % 4) == 0, "ring item size must be a multiple of 4");         \
+    _Static_assert((len) > 0 && ((len) & ((len) - 1)) == 0, "ring length must be a power of 2"); \
+    struct {                                                                                    \
+        ulp_lp_core_ring_t ring;                                                                \
+        type items[len];                                                                        \
+    } name = {                                                                                  \
+        .ring = {                                                                               \
+            .item_size = sizeof(type),                                                          \
+            .length = (len),                                                                    \
+            .wake_threshold = (threshold),                                                      \
+        },                                                                                      \
+    }
+
+/**
+ * @brief Get the ring of a variable defined with ULP_LP_CORE_RING_DEFINE()
+ *
+ * @param var Ring variable, e.g. `ulp_<name>` on the main CPU
+ */
+#define ULP_LP_CORE_RING(var) ((ulp_lp_core_ring_t *)&(var))
+
+/**
+ * @brief Push items into the ring, called by the producer
+ *
+ * The items which don't fit are dropped and counted in ulp_lp_core_ring_t::dropped.
+ * Wakes up the consumer if the wake threshold is reached.
+ *
+ * @param ring Ring
+ * @param items Items to push
+ * @param count Number of items
+ * @return Number of items pushed
+ */
+size_t ulp_lp_core_ring_push(ulp_lp_core_ring_t *ring, const void *items, size_t count);
+
+/**
+ * @brief Pop items from the ring, called by the consumer
+ *
+ * Popping re-arms the wakeup of the consumer.
+ *
+ * @param ring Ring
+ * @param[out] items Buffer receiving the items
+ * @param max_count Maximum number of items to pop
+ * @return Number of items popped
+ */
+size_t ulp_lp_core_ring_pop(ulp_lp_core_ring_t *ring, void *items, size_t max_count);
+
+/**
+ * @brief Get the number of items queued in the ring
+ *
+ * @param ring Ring
+ * @return Number of items which can be popped
+ */
+size_t ulp_lp_core_ring_count(const ulp_lp_core_ring_t *ring);
+
+/**
+ * @brief Drop all the items of the ring, called by the consumer
+ *
+ * @param ring Ring
+ */
+void ulp_lp_core_ring_flush(ulp_lp_core_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
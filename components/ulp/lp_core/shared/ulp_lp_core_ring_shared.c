@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ulp_lp_core_ring_shared.h"
+#if IS_ULP_COCPU
+#include "ulp_lp_core_utils.h"
+#else
+#include "ulp_lp_core.h"
+#endif
+
+/* The items are copied word by word, which works for every type of LP memory */
+static void ulp_lp_core_ring_copy(volatile uint32_t *dst, const volatile uint32_t *src, uint32_t words)
+{
+    for (uint32_t i = 0; i < words; i++) {
+        dst[i] = src[i];
+    }
+}
+
+static inline uint32_t *ulp_lp_core_ring_item(ulp_lp_core_ring_t *ring, uint32_t index)
+{
+    return (uint32_t *)((uint8_t *)(ring + 1) + (index & (ring->length - 1)) * ring->item_size);
+}
+
+static void ulp_lp_core_ring_wake_consumer(void)
+{
+#if IS_ULP_COCPU
+    ulp_lp_core_wakeup_main_processor();
+#else
+    ulp_lp_core_sw_intr_trigger();
+#endif
+}
+
+size_t ulp_lp_core_ring_push(ulp_lp_core_ring_t *ring, const void *items, size_t count)
+{
+    uint32_t head = ring->head;
+    uint32_t free_items = ring->length - (head - ring->tail);
+    size_t pushed = (count < free_items) ? count : free_items;
+    uint32_t words = ring->item_size / sizeof(uint32_t);
+
+    for (size_t i = 0; i < pushed; i++) {
+        ulp_lp_core_ring_copy(ulp_lp_core_ring_item(ring, head + i), (const uint32_t *)items + i * words, words);
+    }
+    if (pushed < count) {
+        ring->dropped += count - pushed;
+    }
+    if (pushed == 0) {
+        return 0;
+    }
+
+    /* The items must be visible to the other core before the new head */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    ring->head = head + pushed;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (ring->wake_threshold && !ring->wake_pending && (ring->head - ring->tail) >= ring->wake_threshold) {
+        ring->wake_pending = 1;
+        ulp_lp_core_ring_wake_consumer();
+    }
+    return pushed;
+}
+
+size_t ulp_lp_core_ring_pop(ulp_lp_core_ring_t *ring, void *items, size_t max_count)
+{
+    /* Re-arm the wakeup first, so that items pushed while popping wake the consumer again */
+    ring->wake_pending = 0;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    uint32_t tail = ring->tail;
+    uint32_t queued = ring->head - tail;
+    size_t popped = (max_count < queued) ? max_count : queued;
+    uint32_t words = ring->item_size / sizeof(uint32_t);
+
+    /* Read the items only after the head which announced them */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    for (size_t i = 0; i < popped; i++) {
+        ulp_lp_core_ring_copy((uint32_t *)items + i * words, ulp_lp_core_ring_item(ring, tail + i), words);
+    }
+
+    /* The items must be read before the producer can overwrite them */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    ring->tail = tail + popped;
+    return popped;
+}
+
+size_t ulp_lp_core_ring_count(const ulp_lp_core_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+void ulp_lp_core_ring_flush(ulp_lp_core_ring_t *ring)
+{
+    ring->wake_pending = 0;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    ring->tail = ring->head;
+}
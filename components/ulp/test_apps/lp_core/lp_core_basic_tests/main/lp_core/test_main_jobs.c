@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ulp_lp_core_jobs.h"
+
+volatile uint32_t count_job_runs;
+volatile uint32_t check_job_runs;
+volatile uint32_t wake_threshold;
+volatile uint32_t wake_mask;
+
+static bool count_job(void *arg)
+{
+    count_job_runs++;
+    return false;
+}
+
+static bool check_job(void *arg)
+{
+    check_job_runs++;
+    return wake_threshold && count_job_runs >= wake_threshold;
+}
+
+static ulp_lp_core_job_t s_jobs[] = {
+    ULP_LP_CORE_JOB(count_job, NULL, 20),
+    ULP_LP_CORE_JOB(check_job, NULL, 100),
+};
+
+int main(void)
+{
+    wake_mask |= ulp_lp_core_jobs_run(s_jobs, sizeof(s_jobs) / sizeof(s_jobs[0]));
+    return 0;
+}
@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include "test_shared.h"
+#include "ulp_lp_core_ring_shared.h"
+
+ULP_LP_CORE_RING_DEFINE(samples, test_ring_sample_t, 16, 8);
+
+volatile uint32_t sample_seq;
+
+int main(void)
+{
+    test_ring_sample_t sample = {
+        .seq = sample_seq,
+        .value = sample_seq ^ XOR_MASK,
+    };
+
+    if (ulp_lp_core_ring_push(&samples.ring, &sample, 1) == 1) {
+        sample_seq++;
+    }
+
+    return 0;
+}
@@ -1,10 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
 #pragma once
 
+#include <stdint.h>
+
 #define XOR_MASK 0xDEADBEEF
 
 /* I2C test params */
@@ -15,6 +17,12 @@
 /* LP UART test param */
 #define UART_BUF_SIZE  1024
 
+/* LP core ring test item */
+typedef struct {
+    uint32_t seq;
+    uint32_t value;
+} test_ring_sample_t;
+
 typedef enum {
     LP_CORE_READ_WRITE_TEST = 1,
     LP_CORE_DELAY_TEST,
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -12,14 +12,17 @@
 #include "lp_core_test_app.h"
 #include "lp_core_test_app_counter.h"
 #include "lp_core_test_app_isr.h"
+#include "lp_core_test_app_ring.h"
 
 #if SOC_LP_TIMER_SUPPORTED
 #include "lp_core_test_app_set_timer_wakeup.h"
+#include "lp_core_test_app_jobs.h"
 #endif
 
 #include "lp_core_test_app_gpio.h"
 #include "ulp_lp_core.h"
 #include "ulp_lp_core_lp_timer_shared.h"
+#include "ulp_lp_core_ring_shared.h"
 #include "test_shared.h"
 #include "unity.h"
 #include "esp_sleep.h"
@@ -40,12 +43,18 @@ extern const uint8_t lp_core_main_counter_bin_end[]   asm("_binary_lp_core_test_
 extern const uint8_t lp_core_main_set_timer_wakeup_bin_start[] asm("_binary_lp_core_test_app_set_timer_wakeup_bin_start");
 extern const uint8_t lp_core_main_set_timer_wakeup_bin_end[]   asm("_binary_lp_core_test_app_set_timer_wakeup_bin_end");
 
+extern const uint8_t lp_core_main_jobs_bin_start[] asm("_binary_lp_core_test_app_jobs_bin_start");
+extern const uint8_t lp_core_main_jobs_bin_end[]   asm("_binary_lp_core_test_app_jobs_bin_end");
+
 extern const uint8_t lp_core_main_gpio_bin_start[] asm("_binary_lp_core_test_app_gpio_bin_start");
 extern const uint8_t lp_core_main_gpio_bin_end[]   asm("_binary_lp_core_test_app_gpio_bin_end");
 
 extern const uint8_t lp_core_main_isr_bin_start[] asm("_binary_lp_core_test_app_isr_bin_start");
 extern const uint8_t lp_core_main_isr_bin_end[]   asm("_binary_lp_core_test_app_isr_bin_end");
 
+extern const uint8_t lp_core_main_ring_bin_start[] asm("_binary_lp_core_test_app_ring_bin_start");
+extern const uint8_t lp_core_main_ring_bin_end[]   asm("_binary_lp_core_test_app_ring_bin_end");
+
 static void load_and_start_lp_core_firmware(ulp_lp_core_cfg_t* cfg, const uint8_t* firmware_start, const uint8_t* firmware_end)
 {
     TEST_ASSERT(ulp_lp_core_load_binary(firmware_start,
@@ -257,6 +266,47 @@ TEST_CASE("LP Timer can wakeup lp core periodically", "[lp_core]")
     TEST_ASSERT_INT_WITHIN_MESSAGE(5, expected_run_count, ulp_counter, "LP Core did not wake up the expected number of times");
 }
 
+TEST_CASE("LP core ring passes samples to the main CPU in batches", "[lp_core]")
+{
+    ulp_lp_core_cfg_t cfg = {
+        .wakeup_source = ULP_LP_CORE_WAKEUP_SOURCE_LP_TIMER,
+        .lp_timer_sleep_duration_us = LP_TIMER_TEST_SLEEP_DURATION_US,
+    };
+
+    load_and_start_lp_core_firmware(&cfg, lp_core_main_ring_bin_start, lp_core_main_ring_bin_end);
+    ulp_lp_core_ring_t *ring = ULP_LP_CORE_RING(ulp_samples);
+    TEST_ASSERT_EQUAL(sizeof(test_ring_sample_t), ring->item_size);
+
+    test_ring_sample_t batch[16];
+    uint32_t expected_seq = 0;
+    int batches = 0;
+    int64_t start = esp_timer_get_time();
+    while (esp_timer_get_time() - start < 1000000) {
+        if (!ring->wake_pending) {
+            // the LP core has not reached the threshold of 8 samples yet
+            TEST_ASSERT_LESS_THAN(8, ulp_lp_core_ring_count(ring));
+            vTaskDelay(1);
+            continue;
+        }
+        size_t count = ulp_lp_core_ring_pop(ring, batch, 16);
+        TEST_ASSERT_GREATER_OR_EQUAL(8, count);
+        for (size_t i = 0; i < count; i++) {
+            TEST_ASSERT_EQUAL_HEX32(expected_seq, batch[i].seq);
+            TEST_ASSERT_EQUAL_HEX32(expected_seq ^ XOR_MASK, batch[i].value);
+            expected_seq++;
+        }
+        batches++;
+    }
+    ulp_lp_core_stop();
+
+    printf("Received %"PRIu32" samples in %d batches\n", expected_seq, batches);
+    TEST_ASSERT_GREATER_THAN(0, batches);
+    TEST_ASSERT_EQUAL(0, ring->dropped);
+
+    ulp_lp_core_ring_flush(ring);
+    TEST_ASSERT_EQUAL(0, ulp_lp_core_ring_count(ring));
+}
+
 static bool ulp_is_running(uint32_t *counter_variable)
 {
     uint32_t start_cnt = *counter_variable;
@@ -322,6 +372,38 @@ TEST_CASE("LP core can schedule next wake-up time by itself", "[ulp]")
     TEST_ASSERT_INT_WITHIN_MESSAGE(5, expected_run_count, ulp_set_timer_wakeup_counter, "LP Core did not wake up the expected number of times");
 }
 
+TEST_CASE("LP core runs periodic jobs and wakes up only when they are due", "[ulp]")
+{
+    /* The LP core schedules its own wake-ups from the periods of the jobs */
+    ulp_lp_core_cfg_t cfg = {
+        .wakeup_source = ULP_LP_CORE_WAKEUP_SOURCE_LP_TIMER,
+#if ESP_ROM_HAS_LP_ROM
+        .skip_lp_rom_boot = true,
+#endif
+    };
+
+    load_and_start_lp_core_firmware(&cfg, lp_core_main_jobs_bin_start, lp_core_main_jobs_bin_end);
+
+    int64_t start = esp_timer_get_time();
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    int64_t test_duration = esp_timer_get_time() - start;
+    uint32_t count_job_runs = ulp_count_job_runs;
+    uint32_t check_job_runs = ulp_check_job_runs;
+    printf("Jobs ran %"PRIu32" and %"PRIu32" times in %"PRIi64" ms\n", count_job_runs, check_job_runs, test_duration / 1000);
+
+    /* Periods of 20 ms and 100 ms */
+    TEST_ASSERT_INT_WITHIN(5, test_duration / 20000, count_job_runs);
+    TEST_ASSERT_INT_WITHIN(2, test_duration / 100000, check_job_runs);
+    TEST_ASSERT_EQUAL(0, ulp_wake_mask);
+
+    /* Only the check job requests to wake up the main CPU */
+    ulp_wake_threshold = ulp_count_job_runs + 10;
+    vTaskDelay(pdMS_TO_TICKS(500));
+    TEST_ASSERT_EQUAL_HEX32(BIT(1), ulp_wake_mask);
+
+    ulp_lp_core_stop();
+}
+
 #if SOC_RTCIO_PIN_COUNT > 0
 TEST_CASE("LP core gpio tests", "[ulp]")
 {
@@ -46,7 +46,8 @@
 // ----------------------- Configs -------------------------
 
 #define FRAME_LIST_LEN                          USB_HAL_FRAME_LIST_LEN_32
-#define NUM_BUFFERS                             2
+#define NUM_BUFFERS_ORDER                       CONFIG_USB_HOST_PIPE_BUFFERS_ORDER
+#define NUM_BUFFERS                             (1 << NUM_BUFFERS_ORDER)    // Must be a power of 2, for the buffer indexes to wrap
 
 #define XFER_LIST_LEN_CTRL                      3   // One descriptor for each stage
 #define XFER_LIST_LEN_BULK                      2   // One descriptor for transfer, one to support an extra zero length packet
@@ -173,18 +174,16 @@ struct pipe_obj {
     int num_urb_pending;
     int num_urb_done;
     // Multi-buffer control
-    dma_buffer_block_t *buffers[NUM_BUFFERS];  // Double buffering scheme
+    dma_buffer_block_t *buffers[NUM_BUFFERS];  // Multi-buffering scheme
     union {
         struct {
-            uint32_t buffer_num_to_fill: 2; // Number of buffers that can be filled
-            uint32_t buffer_num_to_exec: 2; // Number of buffers that are filled and need to be executed
-            uint32_t buffer_num_to_parse: 2;// Number of buffers completed execution and waiting to be parsed
-            uint32_t reserved2: 2;
-            uint32_t wr_idx: 1;             // Index of the next buffer to fill. Bit width must allow NUM_BUFFERS to wrap automatically
-            uint32_t rd_idx: 1;             // Index of the current buffer in-flight. Bit width must allow NUM_BUFFERS to wrap automatically
-            uint32_t fr_idx: 1;             // Index of the next buffer to parse. Bit width must allow NUM_BUFFERS to wrap automatically
-            uint32_t buffer_is_executing: 1;// One of the buffers is in flight
-            uint32_t reserved20: 20;
+            uint32_t buffer_num_to_fill: NUM_BUFFERS_ORDER + 1;     // Number of buffers that can be filled
+            uint32_t buffer_num_to_exec: NUM_BUFFERS_ORDER + 1;     // Number of buffers that are filled and need to be executed
+            uint32_t buffer_num_to_parse: NUM_BUFFERS_ORDER + 1;    // Number of buffers completed execution and waiting to be parsed
+            uint32_t wr_idx: NUM_BUFFERS_ORDER;     // Index of the next buffer to fill. Bit width must allow NUM_BUFFERS to wrap automatically
+            uint32_t rd_idx: NUM_BUFFERS_ORDER;     // Index of the current buffer in-flight. Bit width must allow NUM_BUFFERS to wrap automatically
+            uint32_t fr_idx: NUM_BUFFERS_ORDER;     // Index of the next buffer to parse. Bit width must allow NUM_BUFFERS to wrap automatically
+            uint32_t buffer_is_executing: 1;        // One of the buffers is in flight
         };
         uint32_t val;
     } multi_buffer_control;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -439,6 +439,76 @@ void esp_vfs_select_triggered(esp_vfs_select_sem_t sem);
  */
 void esp_vfs_select_triggered_isr(esp_vfs_select_sem_t sem, BaseType_t *woken);
 
+/**
+ * @brief Opaque handle of a persistent poll interest set
+ */
+typedef struct esp_vfs_poll_set_t *esp_vfs_poll_handle_t;
+
+/**
+ * @brief Create a persistent poll interest set
+ *
+ * Unlike poll() and select(), which take the list of descriptors on every
+ * call, the interest set is built once with esp_vfs_poll_ctl() and then
+ * waited on repeatedly with esp_vfs_poll_wait(). This avoids rebuilding the
+ * descriptor sets in the application for each wait when multiplexing many
+ * descriptors.
+ *
+ * @param[out] ret_handle  Handle of the new interest set
+ *
+ * @return
+ *      - ESP_OK if successful
+ *      - ESP_ERR_INVALID_ARG if ret_handle is NULL
+ *      - ESP_ERR_NO_MEM if out of memory
+ */
+esp_err_t esp_vfs_poll_create(esp_vfs_poll_handle_t *ret_handle);
+
+/**
+ * @brief Delete a poll interest set
+ *
+ * @note The set must not be waited on by any task when it is deleted.
+ *
+ * @param handle  Handle of the interest set
+ *
+ * @return
+ *      - ESP_OK if successful
+ *      - ESP_ERR_INVALID_ARG if handle is NULL
+ */
+esp_err_t esp_vfs_poll_delete(esp_vfs_poll_handle_t handle);
+
+/**
+ * @brief Add, modify or remove a descriptor in a poll interest set
+ *
+ * The events are interpreted in the same way as by poll(): POLLIN, POLLRDNORM,
+ * POLLRDBAND and POLLPRI request read readiness, POLLOUT, POLLWRNORM and
+ * POLLWRBAND request write readiness, and error conditions are always reported.
+ * Passing 0 as events removes the descriptor from the set.
+ *
+ * @note Changes made while another task waits on the set take effect at the
+ *       next call of esp_vfs_poll_wait().
+ *
+ * @param handle  Handle of the interest set
+ * @param fd      Descriptor to add, modify or remove
+ * @param events  Requested events, or 0 to remove the descriptor
+ *
+ * @return
+ *      - ESP_OK if successful
+ *      - ESP_ERR_INVALID_ARG if handle is NULL or fd is out of range
+ */
+esp_err_t esp_vfs_poll_ctl(esp_vfs_poll_handle_t handle, int fd, short events);
+
+/**
+ * @brief Wait for readiness of the descriptors in a poll interest set
+ *
+ * @param handle      Handle of the interest set
+ * @param fds         Array which receives the ready descriptors with revents set as by poll()
+ * @param max_fds     Size of the fds array
+ * @param timeout_ms  Timeout in milliseconds, negative value to wait forever
+ *
+ * @return  The number of entries written to fds, 0 on timeout, or -1 when an
+ *          error (specified by errno) has occurred.
+ */
+int esp_vfs_poll_wait(esp_vfs_poll_handle_t handle, struct pollfd *fds, int max_fds, int timeout_ms);
+
 /**
  *
  * @brief Implements the VFS layer of POSIX pread()
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -397,3 +397,40 @@ TEST_CASE("eventfd select block", "[vfs][eventfd]")
     TEST_ASSERT_EQUAL(0, close(fd_write));
     TEST_ESP_OK(esp_vfs_eventfd_unregister());
 }
+
+TEST_CASE("eventfd poll set", "[vfs][eventfd]")
+{
+    esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_vfs_eventfd_register(&config));
+
+    int fd1 = eventfd(0, 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd1);
+    int fd2 = eventfd(0, 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd2);
+
+    esp_vfs_poll_handle_t poll_set;
+    TEST_ESP_OK(esp_vfs_poll_create(&poll_set));
+    TEST_ESP_OK(esp_vfs_poll_ctl(poll_set, fd1, POLLIN));
+    TEST_ESP_OK(esp_vfs_poll_ctl(poll_set, fd2, POLLIN));
+
+    struct pollfd ready[2];
+    TEST_ASSERT_EQUAL(0, esp_vfs_poll_wait(poll_set, ready, 2, 100));
+
+    /* The interest set is kept across waits */
+    uint64_t val = 1;
+    TEST_ASSERT_EQUAL(sizeof(val), write(fd2, &val, sizeof(val)));
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(1, esp_vfs_poll_wait(poll_set, ready, 2, 100));
+        TEST_ASSERT_EQUAL(fd2, ready[0].fd);
+        TEST_ASSERT(ready[0].revents & POLLIN);
+    }
+
+    /* Removed descriptors are no longer reported */
+    TEST_ESP_OK(esp_vfs_poll_ctl(poll_set, fd2, 0));
+    TEST_ASSERT_EQUAL(0, esp_vfs_poll_wait(poll_set, ready, 2, 100));
+
+    TEST_ESP_OK(esp_vfs_poll_delete(poll_set));
+    TEST_ASSERT_EQUAL(0, close(fd1));
+    TEST_ASSERT_EQUAL(0, close(fd2));
+    TEST_ESP_OK(esp_vfs_eventfd_unregister());
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -294,6 +294,46 @@ TEST_CASE("esp_vfs_register_fd_range checks for overlap", "[vfs]")
     TEST_ESP_ERR(ESP_ERR_INVALID_ARG, err);
 }
 
+static int s_unregister_test_close_count;
+
+static int vfs_unregister_test_close(int fd)
+{
+    s_unregister_test_close_count++;
+    return 0;
+}
+
+TEST_CASE("esp_vfs_unregister releases all the FDs of the VFS", "[vfs]")
+{
+    esp_vfs_t vfs1 = {
+        .open = vfs_overlap_test_open,
+        .close = vfs_overlap_test_close
+    };
+    esp_vfs_t vfs2 = {
+        .open = vfs_overlap_test_open,
+        .close = vfs_unregister_test_close
+    };
+
+    TEST_ESP_OK(esp_vfs_register("/test", &vfs1, NULL));
+    // more FDs than the number of VFSs, so that some of them are beyond VFS_MAX_COUNT
+    const int fd_count = CONFIG_VFS_MAX_COUNT + 4;
+    int fds[fd_count];
+    for (int i = 0; i < fd_count; ++i) {
+        fds[i] = open("/test/1", 0, 0);
+        TEST_ASSERT_NOT_EQUAL(-1, fds[i]);
+    }
+    TEST_ESP_OK(esp_vfs_unregister("/test"));
+
+    // the new VFS may take the place of the old one, it must not receive the old FDs
+    s_unregister_test_close_count = 0;
+    TEST_ESP_OK(esp_vfs_register("/test", &vfs2, NULL));
+    for (int i = 0; i < fd_count; ++i) {
+        TEST_ASSERT_EQUAL(-1, close(fds[i]));
+        TEST_ASSERT_EQUAL(EBADF, errno);
+    }
+    TEST_ASSERT_EQUAL(0, s_unregister_test_close_count);
+    TEST_ESP_OK(esp_vfs_unregister("/test"));
+}
+
 static void socket_init(int *socket_fd)
 {
     const struct addrinfo hints = {
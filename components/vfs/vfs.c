@@ -61,7 +61,8 @@ typedef struct {
     uint8_t _reserved :5;
     vfs_index_t vfs_index;
     local_fd_t local_fd;
-} fd_table_t;
+} __attribute__((aligned(4))) fd_table_t;
+_Static_assert(sizeof(fd_table_t) == sizeof(uint32_t), "FD table entries must be read with a single access");
 
 typedef struct {
     bool isset; // none or at least one bit is set in the following 3 fd sets
@@ -76,6 +77,23 @@ static size_t s_vfs_count = 0;
 static fd_table_t s_fd_table[MAX_FDS] = { [0 ... MAX_FDS-1] = FD_TABLE_ENTRY_UNUSED };
 static _lock_t s_fd_table_lock;
 
+/* s_fd_table_lock serializes the changes of the FD table, but the entries are also
+ * read without the lock, on every read(), write(), etc. Each entry is therefore
+ * loaded and stored as a whole, with a single 32-bit access, so that such a reader
+ * sees the VFS index and the local FD of the same entry.
+ */
+static inline fd_table_t fd_table_load(int fd)
+{
+    fd_table_t entry;
+    __atomic_load(&s_fd_table[fd], &entry, __ATOMIC_ACQUIRE);
+    return entry;
+}
+
+static inline void fd_table_store(int fd, fd_table_t entry)
+{
+    __atomic_store(&s_fd_table[fd], &entry, __ATOMIC_RELEASE);
+}
+
 static ssize_t esp_get_free_index(void) {
     for (ssize_t i = 0; i < VFS_MAX_COUNT; i++) {
         if (s_vfs[i] == NULL) {
@@ -562,16 +580,14 @@ esp_err_t esp_vfs_register_fd_range(const esp_vfs_t *vfs, void *ctx, int min_fd,
                 s_vfs[index] = NULL;
                 for (int j = min_fd; j < i; ++j) {
                     if (s_fd_table[j].vfs_index == index) {
-                        s_fd_table[j] = FD_TABLE_ENTRY_UNUSED;
+                        fd_table_store(j, FD_TABLE_ENTRY_UNUSED);
                     }
                 }
                 _lock_release(&s_fd_table_lock);
                 ESP_LOGW(TAG, "esp_vfs_register_fd_range cannot set fd %d (used by other VFS)", i);
                 return ESP_ERR_INVALID_ARG;
             }
-            s_fd_table[i].permanent = true;
-            s_fd_table[i].vfs_index = index;
-            s_fd_table[i].local_fd = i;
+            fd_table_store(i, (fd_table_t) { .permanent = true, .vfs_index = index, .local_fd = i });
         }
         _lock_release(&s_fd_table_lock);
 
@@ -612,9 +628,9 @@ esp_err_t esp_vfs_unregister_with_id(esp_vfs_id_t vfs_id)
 
     _lock_acquire(&s_fd_table_lock);
     // Delete all references from the FD lookup-table
-    for (int j = 0; j < VFS_MAX_COUNT; ++j) {
+    for (int j = 0; j < MAX_FDS; ++j) {
         if (s_fd_table[j].vfs_index == vfs_id) {
-            s_fd_table[j] = FD_TABLE_ENTRY_UNUSED;
+            fd_table_store(j, FD_TABLE_ENTRY_UNUSED);
         }
     }
     _lock_release(&s_fd_table_lock);
@@ -660,13 +676,11 @@ esp_err_t esp_vfs_register_fd_with_local_fd(esp_vfs_id_t vfs_id, int local_fd, b
     _lock_acquire(&s_fd_table_lock);
     for (int i = 0; i < MAX_FDS; ++i) {
         if (s_fd_table[i].vfs_index == -1) {
-            s_fd_table[i].permanent = permanent;
-            s_fd_table[i].vfs_index = vfs_id;
-            if (local_fd >= 0) {
-                s_fd_table[i].local_fd = local_fd;
-            } else {
-                s_fd_table[i].local_fd = i;
-            }
+            fd_table_store(i, (fd_table_t) {
+                .permanent = permanent,
+                .vfs_index = vfs_id,
+                .local_fd = (local_fd >= 0) ? local_fd : i,
+            });
             *fd = i;
             ret = ESP_OK;
             break;
@@ -692,7 +706,7 @@ esp_err_t esp_vfs_unregister_fd(esp_vfs_id_t vfs_id, int fd)
     _lock_acquire(&s_fd_table_lock);
     fd_table_t *item = s_fd_table + fd;
     if (item->permanent == true && item->vfs_index == vfs_id && item->local_fd == fd) {
-        *item = FD_TABLE_ENTRY_UNUSED;
+        fd_table_store(fd, FD_TABLE_ENTRY_UNUSED);
         ret = ESP_OK;
     }
     _lock_release(&s_fd_table_lock);
@@ -775,27 +789,20 @@ static inline bool fd_valid(int fd)
     return (fd < MAX_FDS) && (fd >= 0);
 }
 
-static const vfs_entry_t *get_vfs_for_fd(int fd)
+static const vfs_entry_t *get_vfs_for_fd(int fd, int *local_fd)
 {
     const vfs_entry_t *vfs = NULL;
+    *local_fd = -1;
     if (fd_valid(fd)) {
-        const int index = s_fd_table[fd].vfs_index; // single read -> no locking is required
-        vfs = get_vfs_for_index(index);
+        const fd_table_t entry = fd_table_load(fd); // single read -> no locking is required
+        vfs = get_vfs_for_index(entry.vfs_index);
+        if (vfs) {
+            *local_fd = entry.local_fd;
+        }
     }
     return vfs;
 }
 
-static inline int get_local_fd(const vfs_entry_t *vfs, int fd)
-{
-    int local_fd = -1;
-
-    if (vfs && fd_valid(fd)) {
-        local_fd = s_fd_table[fd].local_fd; // single read -> no locking is required
-    }
-
-    return local_fd;
-}
-
 static const char* translate_path(const vfs_entry_t* vfs, const char* src_path)
 {
     assert(strncmp(src_path, vfs->path_prefix, vfs->path_prefix_len) == 0);
@@ -952,9 +959,7 @@ int esp_vfs_open(struct _reent *r, const char * path, int flags, int mode)
         _lock_acquire(&s_fd_table_lock);
         for (int i = 0; i < MAX_FDS; ++i) {
             if (s_fd_table[i].vfs_index == -1) {
-                s_fd_table[i].permanent = false;
-                s_fd_table[i].vfs_index = vfs->offset;
-                s_fd_table[i].local_fd = fd_within_vfs;
+                fd_table_store(i, (fd_table_t) { .permanent = false, .vfs_index = vfs->offset, .local_fd = fd_within_vfs });
                 _lock_release(&s_fd_table_lock);
                 return i;
             }
@@ -972,8 +977,8 @@ int esp_vfs_open(struct _reent *r, const char * path, int flags, int mode)
 
 ssize_t esp_vfs_write(struct _reent *r, int fd, const void * data, size_t size)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
         return -1;
@@ -985,8 +990,8 @@ ssize_t esp_vfs_write(struct _reent *r, int fd, const void * data, size_t size)
 
 off_t esp_vfs_lseek(struct _reent *r, int fd, off_t size, int mode)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
         return -1;
@@ -998,8 +1003,8 @@ off_t esp_vfs_lseek(struct _reent *r, int fd, off_t size, int mode)
 
 ssize_t esp_vfs_read(struct _reent *r, int fd, void * dst, size_t size)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
         return -1;
@@ -1012,8 +1017,8 @@ ssize_t esp_vfs_read(struct _reent *r, int fd, void * dst, size_t size)
 ssize_t esp_vfs_pread(int fd, void *dst, size_t size, off_t offset)
 {
     [[maybe_unused]] struct _reent *r = __getreent();
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
         return -1;
@@ -1026,8 +1031,8 @@ ssize_t esp_vfs_pread(int fd, void *dst, size_t size, off_t offset)
 ssize_t esp_vfs_pwrite(int fd, const void *src, size_t size, off_t offset)
 {
     [[maybe_unused]] struct _reent *r = __getreent();
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
         return -1;
@@ -1039,8 +1044,8 @@ ssize_t esp_vfs_pwrite(int fd, const void *src, size_t size, off_t offset)
 
 int esp_vfs_close(struct _reent *r, int fd)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
         return -1;
@@ -1049,11 +1054,13 @@ int esp_vfs_close(struct _reent *r, int fd)
     CHECK_AND_CALL(ret, r, vfs, close, local_fd);
 
     _lock_acquire(&s_fd_table_lock);
-    if (!s_fd_table[fd].permanent) {
-        if (s_fd_table[fd].has_pending_select) {
-            s_fd_table[fd].has_pending_close = true;
+    fd_table_t entry = s_fd_table[fd];
+    if (!entry.permanent) {
+        if (entry.has_pending_select) {
+            entry.has_pending_close = true;
+            fd_table_store(fd, entry);
         } else {
-            s_fd_table[fd] = FD_TABLE_ENTRY_UNUSED;
+            fd_table_store(fd, FD_TABLE_ENTRY_UNUSED);
         }
     }
     _lock_release(&s_fd_table_lock);
@@ -1062,8 +1069,8 @@ int esp_vfs_close(struct _reent *r, int fd)
 
 int esp_vfs_fstat(struct _reent *r, int fd, struct stat * st)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
         return -1;
@@ -1075,8 +1082,8 @@ int esp_vfs_fstat(struct _reent *r, int fd, struct stat * st)
 
 int esp_vfs_fcntl_r(struct _reent *r, int fd, int cmd, int arg)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
         return -1;
@@ -1088,8 +1095,8 @@ int esp_vfs_fcntl_r(struct _reent *r, int fd, int cmd, int arg)
 
 int esp_vfs_ioctl(int fd, int cmd, ...)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1117,8 +1124,8 @@ int esp_vfs_ioctl(int fd, int cmd, ...)
 
 int esp_vfs_fsync(int fd)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1373,8 +1380,8 @@ int esp_vfs_truncate(const char *path, off_t length)
 
 int esp_vfs_ftruncate(int fd, off_t length)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1415,33 +1422,36 @@ static inline bool esp_vfs_safe_fd_isset(int fd, const fd_set *fds)
     return fds && FD_ISSET(fd, fds);
 }
 
-static int set_global_fd_sets(const fds_triple_t *vfs_fds_triple, int size, fd_set *readfds, fd_set *writefds, fd_set *errorfds)
+static int set_global_fd_sets(const fds_triple_t *vfs_fds_triple, int size, int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds)
 {
     int ret = 0;
 
-    for (int i = 0; i < size; ++i) {
-        const fds_triple_t *item = &vfs_fds_triple[i];
-        if (item->isset) {
-            for (int fd = 0; fd < MAX_FDS; ++fd) {
-                if (s_fd_table[fd].vfs_index == i) {
-                    const int local_fd = s_fd_table[fd].local_fd; // single read -> no locking is required
-                    if (readfds && esp_vfs_safe_fd_isset(local_fd, &item->readfds)) {
-                        ESP_LOGD(TAG, "FD %d in readfds was set from VFS ID %d", fd, i);
-                        FD_SET(fd, readfds);
-                        ++ret;
-                    }
-                    if (writefds && esp_vfs_safe_fd_isset(local_fd, &item->writefds)) {
-                        ESP_LOGD(TAG, "FD %d in writefds was set from VFS ID %d", fd, i);
-                        FD_SET(fd, writefds);
-                        ++ret;
-                    }
-                    if (errorfds && esp_vfs_safe_fd_isset(local_fd, &item->errorfds)) {
-                        ESP_LOGD(TAG, "FD %d in errorfds was set from VFS ID %d", fd, i);
-                        FD_SET(fd, errorfds);
-                        ++ret;
-                    }
-                }
-            }
+    // Only FDs below nfds could have been passed to drivers, so a single pass over them
+    // is enough to translate the local FDs of all VFSs back to global FDs
+    for (int fd = 0; fd < nfds; ++fd) {
+        const fd_table_t entry = fd_table_load(fd); // single read -> no locking is required
+        if (entry.vfs_index < 0 || entry.vfs_index >= size) {
+            continue;
+        }
+        const fds_triple_t *item = &vfs_fds_triple[entry.vfs_index];
+        if (!item->isset) {
+            continue;
+        }
+        const int local_fd = entry.local_fd;
+        if (readfds && esp_vfs_safe_fd_isset(local_fd, &item->readfds)) {
+            ESP_LOGD(TAG, "FD %d in readfds was set from VFS ID %d", fd, entry.vfs_index);
+            FD_SET(fd, readfds);
+            ++ret;
+        }
+        if (writefds && esp_vfs_safe_fd_isset(local_fd, &item->writefds)) {
+            ESP_LOGD(TAG, "FD %d in writefds was set from VFS ID %d", fd, entry.vfs_index);
+            FD_SET(fd, writefds);
+            ++ret;
+        }
+        if (errorfds && esp_vfs_safe_fd_isset(local_fd, &item->errorfds)) {
+            ESP_LOGD(TAG, "FD %d in errorfds was set from VFS ID %d", fd, entry.vfs_index);
+            FD_SET(fd, errorfds);
+            ++ret;
         }
     }
 
@@ -1485,12 +1495,15 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
     // call. s_vfs_count cannot be protected with a mutex during a select() call (which can be one without a timeout)
     // because that could block the registration of new driver.
     const size_t vfs_count = s_vfs_count;
+    // FD sets and driver arguments of all VFSs are kept in a single allocation,
+    // driver arguments are placed after the FD sets
     fds_triple_t *vfs_fds_triple;
-    if ((vfs_fds_triple = heap_caps_calloc(vfs_count, sizeof(fds_triple_t), VFS_MALLOC_FLAGS)) == NULL) {
+    if ((vfs_fds_triple = heap_caps_calloc(1, vfs_count * (sizeof(fds_triple_t) + sizeof(void *)), VFS_MALLOC_FLAGS)) == NULL) {
         __errno_r(r) = ENOMEM;
         ESP_LOGD(TAG, "calloc is unsuccessful");
         return -1;
     }
+    void **driver_args = (void **) &vfs_fds_triple[vfs_count];
 
     esp_vfs_select_sem_t sel_sem = {
         .is_sem_local = false,
@@ -1498,29 +1511,30 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
     };
 
     int (*socket_select)(int, fd_set *, fd_set *, fd_set *, struct timeval *) = NULL;
+    int socket_vfs_index = -1;
+    // The FD table is locked once for the whole scan instead of once per FD
+    _lock_acquire(&s_fd_table_lock);
     for (int fd = 0; fd < nfds; ++fd) {
-        _lock_acquire(&s_fd_table_lock);
-        const bool is_socket_fd = s_fd_table[fd].permanent;
-        const int vfs_index = s_fd_table[fd].vfs_index;
-        const int local_fd = s_fd_table[fd].local_fd;
+        fd_table_t entry = s_fd_table[fd];
+        const bool is_socket_fd = entry.permanent;
+        const int vfs_index = entry.vfs_index;
+        const int local_fd = entry.local_fd;
         if (esp_vfs_safe_fd_isset(fd, errorfds)) {
-            s_fd_table[fd].has_pending_select = true;
+            entry.has_pending_select = true;
+            fd_table_store(fd, entry);
         }
-        _lock_release(&s_fd_table_lock);
 
         if (vfs_index < 0) {
             continue;
         }
 
         if (is_socket_fd) {
-            if (!socket_select) {
+            if (socket_vfs_index < 0) {
                 // no socket_select found yet so take a look
                 if (esp_vfs_safe_fd_isset(fd, readfds) ||
                         esp_vfs_safe_fd_isset(fd, writefds) ||
                         esp_vfs_safe_fd_isset(fd, errorfds)) {
-                    const vfs_entry_t *vfs = s_vfs[vfs_index];
-                    socket_select = vfs->vfs->select->socket_select;
-                    sel_sem.sem = vfs->vfs->select->get_socket_select_semaphore();
+                    socket_vfs_index = vfs_index;
                 }
             }
             continue;
@@ -1546,6 +1560,13 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
             ESP_LOGD(TAG, "removing %d from errorfds and adding as local FD %d to fd_set of VFS ID %d", fd, local_fd, vfs_index);
         }
     }
+    _lock_release(&s_fd_table_lock);
+
+    if (socket_vfs_index >= 0) {
+        const vfs_entry_t *vfs = s_vfs[socket_vfs_index];
+        socket_select = vfs->vfs->select->socket_select;
+        sel_sem.sem = vfs->vfs->select->get_socket_select_semaphore();
+    }
 
     // all non-socket VFSs have their FD sets in vfs_fds_triple
     // the global readfds, writefds and errorfds contain only socket FDs (if
@@ -1563,15 +1584,6 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
         }
     }
 
-    void **driver_args = heap_caps_calloc(vfs_count, sizeof(void *), VFS_MALLOC_FLAGS);
-
-    if (driver_args == NULL) {
-        free(vfs_fds_triple);
-        __errno_r(r) = ENOMEM;
-        ESP_LOGD(TAG, "calloc is unsuccessful for driver args");
-        return -1;
-    }
-
     for (size_t i = 0; i < vfs_count; ++i) {
         const vfs_entry_t *vfs = get_vfs_for_index(i);
         fds_triple_t *item = &vfs_fds_triple[i];
@@ -1598,13 +1610,12 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
             if (err != ESP_ERR_NOT_SUPPORTED) {
                 call_end_selects(i, vfs_fds_triple, driver_args);
             }
-            (void) set_global_fd_sets(vfs_fds_triple, vfs_count, readfds, writefds, errorfds);
+            (void) set_global_fd_sets(vfs_fds_triple, vfs_count, nfds, readfds, writefds, errorfds);
             if (sel_sem.is_sem_local && sel_sem.sem) {
                 vSemaphoreDelete(sel_sem.sem);
                 sel_sem.sem = NULL;
             }
             free(vfs_fds_triple);
-            free(driver_args);
             __errno_r(r) = EINTR;
             ESP_LOGD(TAG, "start_select failed: %s", esp_err_to_name(err));
             return -1;
@@ -1651,7 +1662,7 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
     call_end_selects(vfs_count, vfs_fds_triple, driver_args); // for VFSs for start_select was called before
 
     if (ret >= 0) {
-        ret += set_global_fd_sets(vfs_fds_triple, vfs_count, readfds, writefds, errorfds);
+        ret += set_global_fd_sets(vfs_fds_triple, vfs_count, nfds, readfds, writefds, errorfds);
     }
     if (sel_sem.sem) { // Cleanup the select semaphore
         if (sel_sem.is_sem_local) {
@@ -1668,12 +1679,11 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
     _lock_acquire(&s_fd_table_lock);
     for (int fd = 0; fd < nfds; ++fd) {
         if (s_fd_table[fd].has_pending_close) {
-            s_fd_table[fd] = FD_TABLE_ENTRY_UNUSED;
+            fd_table_store(fd, FD_TABLE_ENTRY_UNUSED);
         }
     }
     _lock_release(&s_fd_table_lock);
     free(vfs_fds_triple);
-    free(driver_args);
 
     ESP_LOGD(TAG, "esp_vfs_select returns %d", ret);
     esp_vfs_log_fd_set("readfds", readfds);
@@ -1729,14 +1739,125 @@ void esp_vfs_select_triggered_isr(esp_vfs_select_sem_t sem, BaseType_t *woken)
     }
 }
 
+struct esp_vfs_poll_set_t {
+    _lock_t lock;       // protects the members below
+    int nfds;           // highest descriptor in the set + 1
+    fd_set readfds;
+    fd_set writefds;
+    fd_set errorfds;
+};
+
+esp_err_t esp_vfs_poll_create(esp_vfs_poll_handle_t *ret_handle)
+{
+    if (ret_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_vfs_poll_handle_t set = heap_caps_calloc(1, sizeof(struct esp_vfs_poll_set_t), VFS_MALLOC_FLAGS);
+    if (set == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    _lock_init(&set->lock);
+    *ret_handle = set;
+    return ESP_OK;
+}
+
+esp_err_t esp_vfs_poll_delete(esp_vfs_poll_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    _lock_close(&handle->lock);
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t esp_vfs_poll_ctl(esp_vfs_poll_handle_t handle, int fd, short events)
+{
+    if (handle == NULL || fd < 0 || fd >= MAX_FDS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    _lock_acquire(&handle->lock);
+    FD_CLR(fd, &handle->readfds);
+    FD_CLR(fd, &handle->writefds);
+    FD_CLR(fd, &handle->errorfds);
+    // Mapping of events is the same as in poll()
+    if (events & (POLLIN | POLLRDNORM | POLLRDBAND | POLLPRI)) {
+        FD_SET(fd, &handle->readfds);
+        FD_SET(fd, &handle->errorfds);
+    }
+    if (events & (POLLOUT | POLLWRNORM | POLLWRBAND)) {
+        FD_SET(fd, &handle->writefds);
+        FD_SET(fd, &handle->errorfds);
+    }
+    if (FD_ISSET(fd, &handle->errorfds)) {
+        handle->nfds = MAX(handle->nfds, fd + 1);
+    } else if (fd + 1 == handle->nfds) {
+        // The highest descriptor was removed, find the new one
+        while (handle->nfds > 0 && !FD_ISSET(handle->nfds - 1, &handle->errorfds)) {
+            --handle->nfds;
+        }
+    }
+    _lock_release(&handle->lock);
+    return ESP_OK;
+}
+
+int esp_vfs_poll_wait(esp_vfs_poll_handle_t handle, struct pollfd *fds, int max_fds, int timeout_ms)
+{
+    if (handle == NULL || fds == NULL || max_fds <= 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    fd_set readfds;
+    fd_set writefds;
+    fd_set errorfds;
+    _lock_acquire(&handle->lock);
+    const int nfds = handle->nfds;
+    readfds = handle->readfds;
+    writefds = handle->writefds;
+    errorfds = handle->errorfds;
+    _lock_release(&handle->lock);
+
+    struct timeval tv = {
+        .tv_sec = timeout_ms / 1000,
+        .tv_usec = (timeout_ms % 1000) * 1000,
+    };
+    int ret = esp_vfs_select(nfds, &readfds, &writefds, &errorfds, timeout_ms < 0 ? NULL : &tv);
+    if (ret <= 0) {
+        return ret;
+    }
+
+    int count = 0;
+    for (int fd = 0; fd < nfds && count < max_fds; ++fd) {
+        short revents = 0;
+        if (FD_ISSET(fd, &readfds)) {
+            revents |= POLLIN;
+        }
+        if (FD_ISSET(fd, &writefds)) {
+            revents |= POLLOUT;
+        }
+        if (FD_ISSET(fd, &errorfds)) {
+            revents |= POLLERR;
+        }
+        if (revents) {
+            fds[count].fd = fd;
+            fds[count].events = 0;
+            fds[count].revents = revents;
+            ++count;
+        }
+    }
+    return count;
+}
+
 #endif // CONFIG_VFS_SUPPORT_SELECT
 
 #ifdef CONFIG_VFS_SUPPORT_TERMIOS
 
 int tcgetattr(int fd, struct termios *p)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1749,8 +1870,8 @@ int tcgetattr(int fd, struct termios *p)
 
 int tcsetattr(int fd, int optional_actions, const struct termios *p)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1763,8 +1884,8 @@ int tcsetattr(int fd, int optional_actions, const struct termios *p)
 
 int tcdrain(int fd)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1777,8 +1898,8 @@ int tcdrain(int fd)
 
 int tcflush(int fd, int select)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1791,8 +1912,8 @@ int tcflush(int fd, int select)
 
 int tcflow(int fd, int action)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1805,8 +1926,8 @@ int tcflow(int fd, int action)
 
 pid_t tcgetsid(int fd)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -1819,8 +1940,8 @@ pid_t tcgetsid(int fd)
 
 int tcsendbreak(int fd, int duration)
 {
-    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
-    const int local_fd = get_local_fd(vfs, fd);
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd, &local_fd);
     [[maybe_unused]] struct _reent* r = __getreent();
     if (vfs == NULL || local_fd < 0) {
         __errno_r(r) = EBADF;
@@ -0,0 +1,363 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "WL_Cache.h"
+
+static const char *TAG = "wl_cache";
+
+#define WL_CACHE_FREE_ADDR  SIZE_MAX
+
+#define WL_CACHE_RESULT_CHECK(result) \
+    if (result != ESP_OK) { \
+        ESP_LOGE(TAG,"%s(%d): result = 0x%08" PRIx32, __FUNCTION__, __LINE__, (uint32_t) result); \
+        return (result); \
+    }
+
+WL_Cache::WL_Cache(Flash_Access *flash, size_t block_size, size_t blocks_count, bool ordered)
+{
+    this->flash = flash;
+    this->block_size = block_size;
+    this->blocks_count = blocks_count;
+    this->ordered = ordered;
+    this->unit_size = flash->get_sector_size();
+    this->units_per_block = 0;
+}
+
+WL_Cache::~WL_Cache()
+{
+    free(this->blocks);
+    free(this->data);
+}
+
+esp_err_t WL_Cache::init()
+{
+    if (this->blocks_count == 0 || this->unit_size == 0 || this->block_size % this->unit_size != 0
+            || this->block_size / this->unit_size > 32) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (this->flash->get_flash_size() % this->block_size != 0) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    this->units_per_block = this->block_size / this->unit_size;
+
+    this->blocks = (Block *)calloc(this->blocks_count, sizeof(Block));
+    this->data = (uint8_t *)malloc(this->blocks_count * this->block_size);
+    if (this->blocks == NULL || this->data == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < this->blocks_count; i++) {
+        this->blocks[i].addr = WL_CACHE_FREE_ADDR;
+        this->blocks[i].data = this->data + i * this->block_size;
+    }
+    ESP_LOGD(TAG, "%s: %" PRIu32 " sectors of %" PRIu32 " bytes", __func__, (uint32_t) this->blocks_count, (uint32_t) this->block_size);
+    return ESP_OK;
+}
+
+size_t WL_Cache::get_flash_size()
+{
+    return this->flash->get_flash_size();
+}
+
+size_t WL_Cache::get_sector_size()
+{
+    return this->unit_size;
+}
+
+WL_Cache::Block *WL_Cache::find(size_t addr)
+{
+    for (size_t i = 0; i < this->blocks_count; i++) {
+        if (this->blocks[i].addr == addr) {
+            return &this->blocks[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t WL_Cache::get(size_t addr, bool load, Block **block)
+{
+    esp_err_t result = ESP_OK;
+    Block *entry = this->find(addr);
+    if (entry == NULL) {
+        // Take a free entry, or else the least recently used one
+        entry = &this->blocks[0];
+        for (size_t i = 0; i < this->blocks_count && entry->addr != WL_CACHE_FREE_ADDR; i++) {
+            Block *candidate = &this->blocks[i];
+            if (candidate->addr == WL_CACHE_FREE_ADDR || (int32_t)(candidate->last_use - entry->last_use) < 0) {
+                entry = candidate;
+            }
+        }
+        if (entry->addr != WL_CACHE_FREE_ADDR) {
+            result = this->evict(entry);
+            WL_CACHE_RESULT_CHECK(result);
+        }
+        if (load) {
+            result = this->flash->read(addr, entry->data, this->block_size);
+            WL_CACHE_RESULT_CHECK(result);
+        }
+        entry->addr = addr;
+        entry->dirty_units = 0;
+        entry->erased_units = 0;
+    }
+    entry->last_use = ++this->use_counter;
+    *block = entry;
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::evict(Block *block)
+{
+    esp_err_t result = ESP_OK;
+    if (this->ordered && block->dirty_units != 0) {
+        // The sectors modified before this one must reach the flash first
+        result = this->sync_before(block->dirty_seq);
+        WL_CACHE_RESULT_CHECK(result);
+    }
+    result = this->write_back(block);
+    WL_CACHE_RESULT_CHECK(result);
+    block->addr = WL_CACHE_FREE_ADDR;
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::sync_before(uint32_t dirty_seq)
+{
+    esp_err_t result = ESP_OK;
+    while (true) {
+        Block *oldest = NULL;
+        for (size_t i = 0; i < this->blocks_count; i++) {
+            Block *candidate = &this->blocks[i];
+            if (candidate->addr == WL_CACHE_FREE_ADDR || candidate->dirty_units == 0
+                    || (int32_t)(candidate->dirty_seq - dirty_seq) >= 0) {
+                continue;
+            }
+            if (oldest == NULL || (int32_t)(candidate->dirty_seq - oldest->dirty_seq) < 0) {
+                oldest = candidate;
+            }
+        }
+        if (oldest == NULL) {
+            return ESP_OK;
+        }
+        result = this->write_back(oldest);
+        WL_CACHE_RESULT_CHECK(result);
+    }
+}
+
+esp_err_t WL_Cache::write_back(Block *block)
+{
+    esp_err_t result = ESP_OK;
+    if (block->dirty_units == 0) {
+        return ESP_OK;
+    }
+    ESP_LOGV(TAG, "%s: addr = 0x%08" PRIx32 ", dirty = 0x%08" PRIx32 ", erased = 0x%08" PRIx32, __func__,
+             (uint32_t) block->addr, block->dirty_units, block->erased_units);
+
+    // Write back the runs of consecutive units which need the same operation,
+    // the erased units with erase_range() and write(), the others with write() only
+    size_t unit = 0;
+    while (unit < this->units_per_block) {
+        uint32_t mask = 1UL << unit;
+        if ((block->dirty_units & mask) == 0) {
+            unit++;
+            continue;
+        }
+        bool erase = (block->erased_units & mask) != 0;
+        size_t count = 1;
+        while (unit + count < this->units_per_block) {
+            uint32_t next = 1UL << (unit + count);
+            if ((block->dirty_units & next) == 0 || ((block->erased_units & next) != 0) != erase) {
+                break;
+            }
+            count++;
+        }
+        result = this->write_back_units(block, unit, count, erase);
+        WL_CACHE_RESULT_CHECK(result);
+        unit += count;
+    }
+    block->dirty_units = 0;
+    block->erased_units = 0;
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::write_back_units(Block *block, size_t first_unit, size_t count, bool erase)
+{
+    esp_err_t result = ESP_OK;
+    size_t addr = block->addr + first_unit * this->unit_size;
+    uint8_t *src = block->data + first_unit * this->unit_size;
+    size_t size = count * this->unit_size;
+
+    if (erase) {
+        result = this->flash->erase_range(addr, size);
+        WL_CACHE_RESULT_CHECK(result);
+        // Nothing to write over the erased state
+        bool blank = true;
+        for (size_t i = 0; i < size / sizeof(uint32_t); i++) {
+            if (((uint32_t *)src)[i] != UINT32_MAX) {
+                blank = false;
+                break;
+            }
+        }
+        if (!blank) {
+            result = this->flash->write(addr, src, size);
+            WL_CACHE_RESULT_CHECK(result);
+        }
+    } else {
+        result = this->flash->write(addr, src, size);
+        WL_CACHE_RESULT_CHECK(result);
+    }
+    // The units are clean now, so that a failure in a later run doesn't write them again
+    uint32_t mask = ((count < 32) ? (1UL << count) : 0UL) - 1;
+    block->dirty_units &= ~(mask << first_unit);
+    block->erased_units &= ~(mask << first_unit);
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::invalidate(size_t start_address, size_t size)
+{
+    esp_err_t result = ESP_OK;
+    for (size_t i = 0; i < this->blocks_count; i++) {
+        Block *block = &this->blocks[i];
+        if (block->addr == WL_CACHE_FREE_ADDR
+                || block->addr >= start_address + size || block->addr + this->block_size <= start_address) {
+            continue;
+        }
+        result = this->evict(block);
+        WL_CACHE_RESULT_CHECK(result);
+    }
+    return ESP_OK;
+}
+
+void WL_Cache::mark_dirty(Block *block, uint32_t units)
+{
+    if (block->dirty_units == 0) {
+        block->dirty_seq = ++this->dirty_counter;
+    }
+    block->dirty_units |= units;
+}
+
+esp_err_t WL_Cache::erase_sector(size_t sector)
+{
+    return this->erase_range(sector * this->unit_size, this->unit_size);
+}
+
+esp_err_t WL_Cache::erase_range(size_t start_address, size_t size)
+{
+    esp_err_t result = ESP_OK;
+    if (start_address > this->get_flash_size() || size > this->get_flash_size() - start_address) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (start_address % this->unit_size != 0 || size % this->unit_size != 0) {
+        // Not something the cache can keep track of, let the flash instance handle it
+        result = this->invalidate(start_address, size);
+        WL_CACHE_RESULT_CHECK(result);
+        return this->flash->erase_range(start_address, size);
+    }
+
+    while (size > 0) {
+        size_t block_addr = start_address - start_address % this->block_size;
+        size_t offset = start_address - block_addr;
+        size_t len = this->block_size - offset;
+        if (len > size) {
+            len = size;
+        }
+        Block *block = NULL;
+        // A sector which is erased completely doesn't need to be read from flash
+        result = this->get(block_addr, len != this->block_size, &block);
+        WL_CACHE_RESULT_CHECK(result);
+        memset(block->data + offset, 0xff, len);
+        uint32_t units = (((len / this->unit_size) < 32) ? (1UL << (len / this->unit_size)) : 0UL) - 1;
+        units <<= offset / this->unit_size;
+        this->mark_dirty(block, units);
+        block->erased_units |= units;
+
+        start_address += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::write(size_t dest_addr, const void *src, size_t size)
+{
+    esp_err_t result = ESP_OK;
+    const uint8_t *src_bytes = (const uint8_t *)src;
+    if (dest_addr > this->get_flash_size() || size > this->get_flash_size() - dest_addr) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    while (size > 0) {
+        size_t block_addr = dest_addr - dest_addr % this->block_size;
+        size_t offset = dest_addr - block_addr;
+        size_t len = this->block_size - offset;
+        if (len > size) {
+            len = size;
+        }
+        Block *block = NULL;
+        result = this->get(block_addr, true, &block);
+        WL_CACHE_RESULT_CHECK(result);
+        // Writing to flash can only clear bits, do the same in RAM
+        for (size_t i = 0; i < len; i++) {
+            block->data[offset + i] &= src_bytes[i];
+        }
+        size_t first_unit = offset / this->unit_size;
+        size_t last_unit = (offset + len - 1) / this->unit_size;
+        uint32_t units = ((last_unit - first_unit + 1 < 32) ? (1UL << (last_unit - first_unit + 1)) : 0UL) - 1;
+        this->mark_dirty(block, units << first_unit);
+
+        dest_addr += len;
+        src_bytes += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::read(size_t src_addr, void *dest, size_t size)
+{
+    esp_err_t result = ESP_OK;
+    uint8_t *dest_bytes = (uint8_t *)dest;
+    if (src_addr > this->get_flash_size() || size > this->get_flash_size() - src_addr) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    while (size > 0) {
+        size_t block_addr = src_addr - src_addr % this->block_size;
+        size_t offset = src_addr - block_addr;
+        size_t len = this->block_size - offset;
+        if (len > size) {
+            len = size;
+        }
+        // Reading doesn't allocate an entry, so that large reads don't evict the modified sectors
+        Block *block = this->find(block_addr);
+        if (block != NULL) {
+            block->last_use = ++this->use_counter;
+            memcpy(dest_bytes, block->data + offset, len);
+        } else {
+            result = this->flash->read(src_addr, dest_bytes, len);
+            WL_CACHE_RESULT_CHECK(result);
+        }
+
+        src_addr += len;
+        dest_bytes += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::sync()
+{
+    esp_err_t result = ESP_OK;
+    // Write the sectors back in the order they were modified, in case of a power loss
+    // this leaves the flash in a state which it has had without the cache
+    result = this->sync_before(this->dirty_counter + 1);
+    WL_CACHE_RESULT_CHECK(result);
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::flush()
+{
+    esp_err_t result = this->sync();
+    WL_CACHE_RESULT_CHECK(result);
+    return this->flash->flush();
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -13,8 +13,16 @@
 #include <string.h>
 #include <stddef.h>
 #include <inttypes.h>
+#include "sdkconfig.h"
 
 static const char *TAG = "wl_flash";
+
+#ifdef CONFIG_WL_DUMMY_SECTOR_MOVES
+#define WL_DUMMY_SEC_MOVES CONFIG_WL_DUMMY_SECTOR_MOVES
+#else
+#define WL_DUMMY_SEC_MOVES 1
+#endif // CONFIG_WL_DUMMY_SECTOR_MOVES
+
 #ifndef WL_CFG_CRC_CONST
 #define WL_CFG_CRC_CONST UINT32_MAX
 #endif // WL_CFG_CRC_CONST
@@ -37,6 +45,8 @@ WL_Flash::WL_Flash()
 WL_Flash::~WL_Flash()
 {
     free(this->temp_buff);
+    free(this->pos_buff);
+    free(this->erase_counts);
 }
 
 esp_err_t WL_Flash::config(wl_config_t *cfg, Partition *partition)
@@ -106,6 +116,11 @@ esp_err_t WL_Flash::config(wl_config_t *cfg, Partition *partition)
         result = ESP_ERR_NO_MEM;
     }
     WL_RESULT_CHECK(result);
+    this->pos_buff = (uint8_t *)malloc(WL_DUMMY_SEC_MOVES * this->cfg.wl_pos_update_record_size);
+    if (this->pos_buff == NULL) {
+        result = ESP_ERR_NO_MEM;
+    }
+    WL_RESULT_CHECK(result);
     this->configured = true;
     return ESP_OK;
 }
@@ -155,18 +170,8 @@ esp_err_t WL_Flash::init()
                 WL_RESULT_CHECK(result);
                 result = this->partition->write(this->addr_state2, &this->state, sizeof(wl_state_t));
                 WL_RESULT_CHECK(result);
-
-                for (size_t i = 0; i < ((this->cfg.wl_partition_size / this->cfg.flash_sector_size)); i++) {
-                    bool pos_bits;
-                    result = this->partition->read(this->addr_state1 + sizeof(wl_state_t) + i * this->cfg.wl_pos_update_record_size, this->temp_buff, this->cfg.wl_pos_update_record_size);
-                    WL_RESULT_CHECK(result);
-                    pos_bits = this->OkBuffSet(i);
-                    if (pos_bits == true) {
-                        //this->fillOkBuff(i);
-                        result = this->partition->write(this->addr_state2 + sizeof(wl_state_t) + i * this->cfg.wl_pos_update_record_size, this->temp_buff, this->cfg.wl_pos_update_record_size);
-                        WL_RESULT_CHECK(result);
-                    }
-                }
+                result = this->copyPosRecords(this->addr_state1, this->addr_state2);
+                WL_RESULT_CHECK(result);
             }
             ESP_LOGD(TAG, "%s: crc1=0x%08" PRIx32 ", crc2 = 0x%08" PRIx32 ", result= 0x%08" PRIx32 , __func__, crc1, crc2, (uint32_t)result);
             result = this->recoverPos();
@@ -190,17 +195,8 @@ esp_err_t WL_Flash::init()
             WL_RESULT_CHECK(result);
             result = this->partition->write(this->addr_state2, &this->state, sizeof(wl_state_t));
             WL_RESULT_CHECK(result);
-
-            for (size_t i = 0; i < ((this->cfg.wl_partition_size / this->cfg.flash_sector_size)); i++) {
-                bool pos_bits;
-                result = this->partition->read(this->addr_state1 + sizeof(wl_state_t) + i * this->cfg.wl_pos_update_record_size, this->temp_buff, this->cfg.wl_pos_update_record_size);
-                WL_RESULT_CHECK(result);
-                pos_bits = this->OkBuffSet(i);
-                if (pos_bits == true) {
-                    result = this->partition->write(this->addr_state2 + sizeof(wl_state_t) + i * this->cfg.wl_pos_update_record_size, this->temp_buff, this->cfg.wl_pos_update_record_size);
-                    WL_RESULT_CHECK(result);
-                }
-            }
+            result = this->copyPosRecords(this->addr_state1, this->addr_state2);
+            WL_RESULT_CHECK(result);
             result = this->partition->read(this->addr_state2, &this->state, sizeof(wl_state_t));
             WL_RESULT_CHECK(result);
         } else { // we have to recover state 1
@@ -236,27 +232,67 @@ esp_err_t WL_Flash::init()
         ESP_LOGE(TAG, "%s: returned 0x%08" PRIx32 , __func__, (uint32_t)result);
         return result;
     }
+    this->pos_pending = 0;
+    this->erase_count = 0;
+    this->dummy_move_count = 0;
+#if CONFIG_WL_SECTOR_ERASE_STATS
+    free(this->erase_counts);
+    this->erase_counts_size = this->state.wl_part_max_sec_pos * (this->cfg.wl_page_size / this->cfg.flash_sector_size);
+    this->erase_counts = (uint32_t *)calloc(this->erase_counts_size, sizeof(uint32_t));
+    if (this->erase_counts == NULL) {
+        ESP_LOGE(TAG, "%s: can't allocate erase counters", __func__);
+        return ESP_ERR_NO_MEM;
+    }
+#endif // CONFIG_WL_SECTOR_ERASE_STATS
     this->initialized = true;
     ESP_LOGD(TAG, "%s - wl_dummy_sec_move_count= 0x%08" PRIx32 , __func__, (uint32_t)this->state.wl_dummy_sec_move_count);
     return ESP_OK;
 }
 
+esp_err_t WL_Flash::findPos(size_t addr_state, size_t *pos)
+{
+    // The position records are written one after another, so the records before the current position are valid
+    // and the ones after it are erased: find the first invalid record by binary search
+    size_t first = 0;
+    size_t last = this->state.wl_part_max_sec_pos;
+    while (first < last) {
+        size_t i = first + (last - first) / 2;
+        esp_err_t result = this->partition->read(addr_state + sizeof(wl_state_t) + i * this->cfg.wl_pos_update_record_size, this->temp_buff, this->cfg.wl_pos_update_record_size);
+        WL_RESULT_CHECK(result);
+        bool pos_bits = this->OkBuffSet(i);
+        ESP_LOGV(TAG, "%s - check pos: position= %" PRIu32 ", pos_bits= 0x%08" PRIx32 , __func__, (uint32_t) i, (uint32_t) pos_bits);
+        if (pos_bits == true) {
+            first = i + 1;
+        } else {
+            last = i;
+        }
+    }
+    *pos = first;
+    return ESP_OK;
+}
+
+esp_err_t WL_Flash::copyPosRecords(size_t src_addr_state, size_t dest_addr_state)
+{
+    size_t count = 0;
+    esp_err_t result = this->findPos(src_addr_state, &count);
+    WL_RESULT_CHECK(result);
+    for (size_t i = 0; i < count; i++) {
+        size_t offset = sizeof(wl_state_t) + i * this->cfg.wl_pos_update_record_size;
+        result = this->partition->read(src_addr_state + offset, this->temp_buff, this->cfg.wl_pos_update_record_size);
+        WL_RESULT_CHECK(result);
+        result = this->partition->write(dest_addr_state + offset, this->temp_buff, this->cfg.wl_pos_update_record_size);
+        WL_RESULT_CHECK(result);
+    }
+    return result;
+}
+
 esp_err_t WL_Flash::recoverPos()
 {
     esp_err_t result = ESP_OK;
     size_t position = 0;
     ESP_LOGV(TAG, "%s start", __func__);
-    for (size_t i = 0; i < this->state.wl_part_max_sec_pos; i++) {
-        bool pos_bits;
-        position = i;
-        result = this->partition->read(this->addr_state1 + sizeof(wl_state_t) + i * this->cfg.wl_pos_update_record_size, this->temp_buff, this->cfg.wl_pos_update_record_size);
-        pos_bits = this->OkBuffSet(i);
-        WL_RESULT_CHECK(result);
-        ESP_LOGV(TAG, "%s - check pos: result=0x%08" PRIx32 ", position= %" PRIu32 ", pos_bits= 0x%08" PRIx32 , __func__, (uint32_t) result, (uint32_t) position, (uint32_t) pos_bits);
-        if (pos_bits == false) {
-            break; // we have found position
-        }
-    }
+    result = this->findPos(this->addr_state1, &position);
+    WL_RESULT_CHECK(result);
 
     this->state.wl_dummy_sec_pos = position;
     if (this->state.wl_dummy_sec_pos == this->state.wl_part_max_sec_pos && this->state.wl_dummy_sec_pos != 0) {
@@ -426,12 +462,79 @@ esp_err_t WL_Flash::updateWL()
 {
     esp_err_t result = ESP_OK;
     this->state.wl_sec_erase_cycle_count++;
-    if (this->state.wl_sec_erase_cycle_count < this->state.wl_max_sec_erase_cycle_count) {
+    if (this->state.wl_sec_erase_cycle_count < this->state.wl_max_sec_erase_cycle_count * WL_DUMMY_SEC_MOVES) {
         return result;
     }
-    // Here we have to move the block and increase the state
+    // Here we have to move the blocks and increase the state.
+    // WL_DUMMY_SEC_MOVES blocks are moved every WL_DUMMY_SEC_MOVES update periods, so the blocks are moved at the same rate.
     this->state.wl_sec_erase_cycle_count = 0;
-    ESP_LOGV(TAG, "%s - wl_sec_erase_cycle_count= 0x%08" PRIx32 ", pos= 0x%08" PRIx32 , __func__, this->state.wl_sec_erase_cycle_count, this->state.wl_dummy_sec_pos);
+    return this->moveDummySectors(WL_DUMMY_SEC_MOVES);
+}
+
+esp_err_t WL_Flash::moveDummySectors(size_t count)
+{
+    esp_err_t result = ESP_OK;
+    ESP_LOGV(TAG, "%s - count= %" PRIu32 ", pos= 0x%08" PRIx32 , __func__, (uint32_t) count, this->state.wl_dummy_sec_pos);
+    for (size_t i = 0; i < count; i++) {
+        if (this->state.wl_dummy_sec_pos >= this->state.wl_part_max_sec_pos || this->pos_pending >= WL_DUMMY_SEC_MOVES) {
+            break;
+        }
+        result = this->moveDummySector();
+        if (result != ESP_OK) {
+            break;
+        }
+    }
+    // The position records of the second state copy are only used to restore the first copy. They are written
+    // once for all the blocks moved here, and before the first copy is erased at the end of the loop.
+    if (this->pos_pending > 0) {
+        uint32_t first_pos = this->state.wl_dummy_sec_pos - this->pos_pending;
+        for (size_t i = 0; i < this->pos_pending; i++) {
+            this->fillOkBuff(first_pos + i);
+            memcpy(this->pos_buff + i * this->cfg.wl_pos_update_record_size, this->temp_buff, this->cfg.wl_pos_update_record_size);
+        }
+        esp_err_t pos_result = this->partition->write(this->addr_state2 + sizeof(wl_state_t) + first_pos * this->cfg.wl_pos_update_record_size, this->pos_buff, this->pos_pending * this->cfg.wl_pos_update_record_size);
+        if (pos_result == ESP_OK) {
+            this->pos_pending = 0;
+        } else {
+            ESP_LOGE(TAG, "%s - update position 2 result= 0x%08x" , __func__, pos_result);
+            result = pos_result;
+        }
+    }
+
+    if (this->state.wl_dummy_sec_pos >= this->state.wl_part_max_sec_pos) {
+        // The moved blocks can't be moved back, so complete the loop even if the position records were not written:
+        // the state rewritten below doesn't need them
+        this->pos_pending = 0;
+        this->state.wl_dummy_sec_pos = 0;
+        // one loop more
+        this->state.wl_dummy_sec_move_count++;
+        if (this->state.wl_dummy_sec_move_count >= (this->state.wl_part_max_sec_pos - 1)) {
+            this->state.wl_dummy_sec_move_count = 0;
+        }
+        // write main state
+        this->state.crc32 = crc32::crc32_le(WL_CFG_CRC_CONST, (uint8_t *)&this->state, WL_STATE_CRC_LEN_V2);
+
+        result = this->partition->erase_range(this->addr_state1, this->state_size);
+        WL_RESULT_CHECK(result);
+        result = this->partition->write(this->addr_state1, &this->state, sizeof(wl_state_t));
+        WL_RESULT_CHECK(result);
+        result = this->partition->erase_range(this->addr_state2, this->state_size);
+        WL_RESULT_CHECK(result);
+        result = this->partition->write(this->addr_state2, &this->state, sizeof(wl_state_t));
+        WL_RESULT_CHECK(result);
+        ESP_LOGD(TAG, "%s - wl_dummy_sec_move_count= 0x%08" PRIx32 ", wl_dummy_sec_pos= 0x%08" PRIx32 ", ", __func__, this->state.wl_dummy_sec_move_count, this->state.wl_dummy_sec_pos);
+    }
+    if (result != ESP_OK) {
+        this->state.wl_sec_erase_cycle_count = this->state.wl_max_sec_erase_cycle_count * WL_DUMMY_SEC_MOVES - 1; // we will update next time
+        return result;
+    }
+    ESP_LOGV(TAG, "%s - result= 0x%08x" , __func__, result);
+    return result;
+}
+
+esp_err_t WL_Flash::moveDummySector()
+{
+    esp_err_t result = ESP_OK;
     // copy data to dummy block
     size_t data_addr = this->state.wl_dummy_sec_pos + 1; // next block, [pos+1] copy to [pos]
     if (data_addr >= this->state.wl_part_max_sec_pos) {
@@ -442,22 +545,20 @@ esp_err_t WL_Flash::updateWL()
     result = this->partition->erase_range(this->dummy_addr, this->cfg.wl_page_size);
     if (result != ESP_OK) {
         ESP_LOGE(TAG, "%s - erase wl dummy sector result= 0x%08x" , __func__, result);
-        this->state.wl_sec_erase_cycle_count = this->state.wl_max_sec_erase_cycle_count - 1; // we will update next time
         return result;
     }
+    this->countErase(this->state.wl_dummy_sec_pos * this->cfg.wl_page_size, this->cfg.wl_page_size);
 
     size_t copy_count = this->cfg.wl_page_size / this->cfg.wl_temp_buff_size;
     for (size_t i = 0; i < copy_count; i++) {
         result = this->partition->read(data_addr + i * this->cfg.wl_temp_buff_size, this->temp_buff, this->cfg.wl_temp_buff_size);
         if (result != ESP_OK) {
             ESP_LOGE(TAG, "%s - not possible to read buffer, will try next time, result= 0x%08x" , __func__, result);
-            this->state.wl_sec_erase_cycle_count = this->state.wl_max_sec_erase_cycle_count - 1; // we will update next time
             return result;
         }
         result = this->partition->write(this->dummy_addr + i * this->cfg.wl_temp_buff_size, this->temp_buff, this->cfg.wl_temp_buff_size);
         if (result != ESP_OK) {
             ESP_LOGE(TAG, "%s - not possible to write buffer, will try next time, result= 0x%08x" , __func__, result);
-            this->state.wl_sec_erase_cycle_count = this->state.wl_max_sec_erase_cycle_count - 1; // we will update next time
             return result;
         }
     }
@@ -467,48 +568,27 @@ esp_err_t WL_Flash::updateWL()
     uint32_t byte_pos = this->state.wl_dummy_sec_pos * this->cfg.wl_pos_update_record_size;
     this->fillOkBuff(this->state.wl_dummy_sec_pos);
     // write state to mem. We updating only affected bits
-    result |= this->partition->write(this->addr_state1 + sizeof(wl_state_t) + byte_pos, this->temp_buff, this->cfg.wl_pos_update_record_size);
+    result = this->partition->write(this->addr_state1 + sizeof(wl_state_t) + byte_pos, this->temp_buff, this->cfg.wl_pos_update_record_size);
     if (result != ESP_OK) {
         ESP_LOGE(TAG, "%s - update position 1 result= 0x%08x" , __func__, result);
-        this->state.wl_sec_erase_cycle_count = this->state.wl_max_sec_erase_cycle_count - 1; // we will update next time
-        return result;
-    }
-    this->fillOkBuff(this->state.wl_dummy_sec_pos);
-    result |= this->partition->write(this->addr_state2 + sizeof(wl_state_t) + byte_pos, this->temp_buff, this->cfg.wl_pos_update_record_size);
-    if (result != ESP_OK) {
-        ESP_LOGE(TAG, "%s - update position 2 result= 0x%08x" , __func__, result);
-        this->state.wl_sec_erase_cycle_count = this->state.wl_max_sec_erase_cycle_count - 1; // we will update next time
         return result;
     }
-
     this->state.wl_dummy_sec_pos++;
-    if (this->state.wl_dummy_sec_pos >= this->state.wl_part_max_sec_pos) {
-        this->state.wl_dummy_sec_pos = 0;
-        // one loop more
-        this->state.wl_dummy_sec_move_count++;
-        if (this->state.wl_dummy_sec_move_count >= (this->state.wl_part_max_sec_pos - 1)) {
-            this->state.wl_dummy_sec_move_count = 0;
-        }
-        // write main state
-        this->state.crc32 = crc32::crc32_le(WL_CFG_CRC_CONST, (uint8_t *)&this->state, WL_STATE_CRC_LEN_V2);
+    this->pos_pending++;
+    this->dummy_move_count++;
+    return result;
+}
 
-        result = this->partition->erase_range(this->addr_state1, this->state_size);
-        WL_RESULT_CHECK(result);
-        result = this->partition->write(this->addr_state1, &this->state, sizeof(wl_state_t));
-        WL_RESULT_CHECK(result);
-        result = this->partition->erase_range(this->addr_state2, this->state_size);
-        WL_RESULT_CHECK(result);
-        result = this->partition->write(this->addr_state2, &this->state, sizeof(wl_state_t));
-        WL_RESULT_CHECK(result);
-        ESP_LOGD(TAG, "%s - wl_dummy_sec_move_count= 0x%08" PRIx32 ", wl_dummy_sec_pos= 0x%08" PRIx32 ", ", __func__, this->state.wl_dummy_sec_move_count, this->state.wl_dummy_sec_pos);
+void WL_Flash::countErase(size_t addr, size_t size)
+{
+    if (this->erase_counts == NULL) {
+        return;
     }
-    // Save structures to the flash... and check result
-    if (result == ESP_OK) {
-        ESP_LOGV(TAG, "%s - result= 0x%08x" , __func__, result);
-    } else {
-        ESP_LOGE(TAG, "%s - result= 0x%08x" , __func__, result);
+    size_t first = addr / this->cfg.flash_sector_size;
+    size_t last = (addr + size - 1) / this->cfg.flash_sector_size;
+    for (size_t i = first; i <= last && i < this->erase_counts_size; i++) {
+        this->erase_counts[i]++;
     }
-    return result;
 }
 
 size_t WL_Flash::calcAddr(size_t addr)
@@ -552,6 +632,8 @@ esp_err_t WL_Flash::erase_sector(size_t sector)
     size_t virt_addr = this->calcAddr(sector * this->cfg.flash_sector_size);
     result = this->partition->erase_sector((this->cfg.wl_partition_start_addr + virt_addr) / this->cfg.flash_sector_size);
     WL_RESULT_CHECK(result);
+    this->erase_count++;
+    this->countErase(virt_addr, this->cfg.flash_sector_size);
     return result;
 }
 
@@ -620,11 +702,40 @@ wl_config_t *WL_Flash::get_cfg()
     return &this->cfg;
 }
 
+esp_err_t WL_Flash::get_stats(wl_stats_t *stats)
+{
+    if (!this->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    size_t sectors_per_page = this->cfg.wl_page_size / this->cfg.flash_sector_size;
+    stats->sector_count = this->state.wl_part_max_sec_pos * sectors_per_page;
+    stats->dummy_sector = this->state.wl_dummy_sec_pos * sectors_per_page;
+    stats->erase_count = this->erase_count;
+    stats->dummy_sector_moves = this->dummy_move_count;
+    return ESP_OK;
+}
+
+esp_err_t WL_Flash::get_erase_counts(uint32_t *counts, size_t count)
+{
+    if (!this->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (this->erase_counts == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (count > this->erase_counts_size) {
+        count = this->erase_counts_size;
+    }
+    memcpy(counts, this->erase_counts, count * sizeof(uint32_t));
+    return ESP_OK;
+}
+
 esp_err_t WL_Flash::flush()
 {
     esp_err_t result = ESP_OK;
-    this->state.wl_sec_erase_cycle_count = this->state.wl_max_sec_erase_cycle_count - 1;
-    result = this->updateWL();
+    // move one block, and write the pending position records
+    this->state.wl_sec_erase_cycle_count = 0;
+    result = this->moveDummySectors(1);
     ESP_LOGD(TAG, "%s - result= 0x%08x, wl_dummy_sec_move_count= 0x%08" PRIx32, __func__, result, this->state.wl_dummy_sec_move_count);
     return result;
 }
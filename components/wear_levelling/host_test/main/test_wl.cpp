@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2016-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -12,6 +12,7 @@
 
 #include "wear_levelling.h"
 #include "WL_Flash.h"
+#include "WL_Cache.h"
 #include "crc32.h"
 
 
@@ -421,3 +422,163 @@ TEST_CASE("power down between WL status 1 and WL status 2 update", "[wear_levell
 
     free(tmp_state);
 }
+
+// Flash_Access implementation in RAM, which counts the erase and write operations
+class Test_Flash : public Flash_Access
+{
+public:
+    static const size_t sector_size = 4096;
+    static const size_t flash_size = 8 * sector_size;
+    uint8_t data[flash_size];
+    size_t erase_count = 0;
+    size_t write_count = 0;
+
+    Test_Flash()
+    {
+        memset(this->data, 0xff, sizeof(this->data));
+    }
+
+    size_t get_flash_size() override
+    {
+        return flash_size;
+    }
+
+    size_t get_sector_size() override
+    {
+        return sector_size;
+    }
+
+    esp_err_t erase_sector(size_t sector) override
+    {
+        return this->erase_range(sector * sector_size, sector_size);
+    }
+
+    esp_err_t erase_range(size_t start_address, size_t size) override
+    {
+        REQUIRE(start_address % sector_size == 0);
+        REQUIRE(size % sector_size == 0);
+        REQUIRE(start_address + size <= flash_size);
+        memset(this->data + start_address, 0xff, size);
+        this->erase_count += size / sector_size;
+        return ESP_OK;
+    }
+
+    esp_err_t write(size_t dest_addr, const void *src, size_t size) override
+    {
+        REQUIRE(dest_addr + size <= flash_size);
+        for (size_t i = 0; i < size; i++) {
+            this->data[dest_addr + i] &= ((const uint8_t *)src)[i];
+        }
+        this->write_count++;
+        return ESP_OK;
+    }
+
+    esp_err_t read(size_t src_addr, void *dest, size_t size) override
+    {
+        REQUIRE(src_addr + size <= flash_size);
+        memcpy(dest, this->data + src_addr, size);
+        return ESP_OK;
+    }
+};
+
+TEST_CASE("write-back cache erases a sector once per write back", "[wear_levelling]")
+{
+    Test_Flash *flash = new Test_Flash();
+    WL_Cache *cache = new WL_Cache(flash, Test_Flash::sector_size, 2, true);
+    REQUIRE(cache->init() == ESP_OK);
+
+    const size_t sector_size = Test_Flash::sector_size;
+    uint8_t *expected = (uint8_t *) malloc(Test_Flash::flash_size);
+    uint8_t *buf = (uint8_t *) malloc(sector_size);
+    memset(expected, 0xff, Test_Flash::flash_size);
+
+    // Rewrite the same sector many times, as FATFS does with the FAT sectors
+    for (int k = 0; k < TEST_COUNT_MAX; k++) {
+        memset(buf, k, sector_size);
+        REQUIRE(cache->erase_range(sector_size, sector_size) == ESP_OK);
+        REQUIRE(cache->write(sector_size, buf, sector_size) == ESP_OK);
+    }
+    memcpy(expected + sector_size, buf, sector_size);
+    REQUIRE(flash->erase_count == 0);
+    REQUIRE(cache->read(sector_size, buf, sector_size) == ESP_OK);
+    REQUIRE(memcmp(buf, expected + sector_size, sector_size) == 0);
+
+    REQUIRE(cache->sync() == ESP_OK);
+    REQUIRE(flash->erase_count == 1);
+    REQUIRE(memcmp(flash->data, expected, Test_Flash::flash_size) == 0);
+
+    // Modify three sectors, the least recently used one is written back
+    for (size_t s = 2; s < 5; s++) {
+        memset(buf, s, sector_size);
+        REQUIRE(cache->erase_range(s * sector_size, sector_size) == ESP_OK);
+        REQUIRE(cache->write(s * sector_size, buf, sector_size) == ESP_OK);
+        memcpy(expected + s * sector_size, buf, sector_size);
+    }
+    REQUIRE(flash->erase_count == 2);
+    REQUIRE(memcmp(flash->data + 2 * sector_size, expected + 2 * sector_size, sector_size) == 0);
+
+    // A partial write without erase is applied to the cached sector like to flash
+    memset(buf, 0x0f, 16);
+    REQUIRE(cache->write(4 * sector_size + 8, buf, 16) == ESP_OK);
+    for (size_t i = 0; i < 16; i++) {
+        expected[4 * sector_size + 8 + i] &= 0x0f;
+    }
+    REQUIRE(cache->read(4 * sector_size + 8, buf, 16) == ESP_OK);
+    REQUIRE(memcmp(buf, expected + 4 * sector_size + 8, 16) == 0);
+
+    REQUIRE(cache->flush() == ESP_OK);
+    REQUIRE(flash->erase_count == 4);
+    REQUIRE(memcmp(flash->data, expected, Test_Flash::flash_size) == 0);
+
+    free(buf);
+    free(expected);
+    delete cache;
+    delete flash;
+}
+
+TEST_CASE("erase statistics and dummy sector position after remount", "[wear_levelling]")
+{
+    wl_handle_t wl_handle;
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "storage");
+
+    REQUIRE(wl_mount(partition, &wl_handle) == ESP_OK);
+    size_t sector_size = wl_sector_size(wl_handle);
+    size_t sectors_count = wl_size(wl_handle) / sector_size;
+
+    wl_stats_t stats;
+    REQUIRE(wl_get_stats(wl_handle, &stats) == ESP_OK);
+    REQUIRE(stats.erase_count == 0);
+    REQUIRE(stats.dummy_sector_moves == 0);
+    REQUIRE(stats.dummy_sector < stats.sector_count);
+
+    // Erase the whole partition a few times, the dummy sector moves every 16 erases
+    const uint32_t passes = 4;
+    for (uint32_t k = 0; k < passes; k++) {
+        REQUIRE(wl_erase_range(wl_handle, 0, sectors_count * sector_size) == ESP_OK);
+    }
+    REQUIRE(wl_get_stats(wl_handle, &stats) == ESP_OK);
+    REQUIRE(stats.erase_count == passes * sectors_count);
+    REQUIRE(stats.dummy_sector_moves >= stats.erase_count / 16);
+    REQUIRE(stats.dummy_sector_moves <= (stats.erase_count + 15) / 16);
+
+    // Every erase is counted once, on the physical sector it was done on
+    uint32_t *counts = new uint32_t[stats.sector_count + 1];
+    counts[stats.sector_count] = UINT32_MAX;
+    REQUIRE(wl_get_sector_erase_counts(wl_handle, counts, stats.sector_count + 1) == ESP_OK);
+    REQUIRE(counts[stats.sector_count] == UINT32_MAX);
+    uint64_t total = 0;
+    for (size_t i = 0; i < stats.sector_count; i++) {
+        total += counts[i];
+    }
+    REQUIRE(total == stats.erase_count + stats.dummy_sector_moves);
+    delete[] counts;
+
+    // Unmounting moves the dummy sector once more, the new position is found on mount
+    REQUIRE(wl_unmount(wl_handle) == ESP_OK);
+    REQUIRE(wl_mount(partition, &wl_handle) == ESP_OK);
+    wl_stats_t new_stats;
+    REQUIRE(wl_get_stats(wl_handle, &new_stats) == ESP_OK);
+    REQUIRE(new_stats.sector_count == stats.sector_count);
+    REQUIRE(new_stats.dummy_sector == (stats.dummy_sector + 1) % stats.sector_count);
+    REQUIRE(wl_unmount(wl_handle) == ESP_OK);
+}
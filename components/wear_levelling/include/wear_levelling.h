@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -120,6 +120,65 @@ size_t wl_size(wl_handle_t handle);
 */
 size_t wl_sector_size(wl_handle_t handle);
 
+/**
+* @brief Write the data cached in RAM to the WL storage
+*
+* When CONFIG_WL_WRITE_BACK_CACHE is enabled, wl_erase_range and wl_write modify the sectors
+* cached in RAM, which are written to flash when they are evicted from the cache or on wl_unmount.
+* This function writes all the modified sectors to flash. It does nothing if the cache is disabled.
+*
+* @param handle WL module handle that was initialized before
+*
+* @return
+*       - ESP_OK, if the cached data was written successfully;
+*       - or one of error codes from lower-level flash driver.
+*/
+esp_err_t wl_sync(wl_handle_t handle);
+
+/**
+* @brief Wear levelling statistics of a WL instance
+*
+* The counters start from zero when the partition is mounted, they are not stored in flash.
+*/
+typedef struct {
+    size_t sector_count;            /*!< Number of physical flash sectors the data is spread over, including the dummy sector */
+    size_t dummy_sector;            /*!< Index of the physical sector currently used as the dummy sector */
+    uint32_t erase_count;           /*!< Number of sectors erased on behalf of wl_erase_range */
+    uint32_t dummy_sector_moves;    /*!< Number of dummy sector moves, each one erases and writes one more sector */
+} wl_stats_t;
+
+/**
+* @brief Get the wear levelling statistics
+*
+* @param handle WL module handle that was initialized before
+* @param[out] stats Wear levelling statistics
+*
+* @return
+*       - ESP_OK, if the statistics were read successfully;
+*       - ESP_ERR_INVALID_ARG, if stats is NULL;
+*       - ESP_ERR_NOT_FOUND, if handle is not a mounted WL instance.
+*/
+esp_err_t wl_get_stats(wl_handle_t handle, wl_stats_t *stats);
+
+/**
+* @brief Get the number of erase operations of each physical sector
+*
+* The sectors are indexed from the start of the partition, in the order they are on flash.
+* The counts include the erase operations done to move the dummy sector, and start from zero
+* when the partition is mounted. Requires CONFIG_WL_SECTOR_ERASE_STATS.
+*
+* @param handle WL module handle that was initialized before
+* @param[out] counts Array receiving the erase counts
+* @param count Number of elements of the counts array, the counts of up to wl_stats_t::sector_count sectors are read
+*
+* @return
+*       - ESP_OK, if the counts were read successfully;
+*       - ESP_ERR_INVALID_ARG, if counts is NULL;
+*       - ESP_ERR_NOT_FOUND, if handle is not a mounted WL instance;
+*       - ESP_ERR_NOT_SUPPORTED, if CONFIG_WL_SECTOR_ERASE_STATS is disabled.
+*/
+esp_err_t wl_get_sector_erase_counts(wl_handle_t handle, uint32_t *counts, size_t count);
+
 
 #ifdef __cplusplus
 } // extern "C"
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef _WL_Cache_H_
+#define _WL_Cache_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "Flash_Access.h"
+
+/**
+* @brief Write-back cache of flash sectors, placed on top of a WL instance
+*
+* Erase and write operations on a cached flash sector only modify its copy in RAM. The sector is
+* erased and written to flash once, when it is evicted from the cache or on sync()/flush(), so that
+* repeated read-modify-write cycles of the same sector (e.g. FAT updates) cost a single erase.
+*
+* The cache keeps track of which units (sectors of the underlying instance, e.g. FAT sectors) have been
+* erased or written, and writes back only these units, through the same erase_range() and write() calls
+* which the user would have made without the cache.
+*/
+class WL_Cache : public Flash_Access
+{
+public:
+    /**
+    * @param flash instance the cache is placed on
+    * @param block_size size of a cached sector, a multiple of the sector size of the flash instance
+    * @param blocks_count number of cached sectors
+    * @param ordered write the sectors back in the order in which they were modified
+    */
+    WL_Cache(Flash_Access *flash, size_t block_size, size_t blocks_count, bool ordered);
+    ~WL_Cache() override;
+
+    esp_err_t init();
+
+    size_t get_flash_size() override;
+    size_t get_sector_size() override;
+
+    esp_err_t erase_sector(size_t sector) override;
+    esp_err_t erase_range(size_t start_address, size_t size) override;
+
+    esp_err_t write(size_t dest_addr, const void *src, size_t size) override;
+    esp_err_t read(size_t src_addr, void *dest, size_t size) override;
+
+    /**
+    * @brief Write all the modified sectors back to flash
+    */
+    esp_err_t sync();
+
+    /**
+    * @brief Write all the modified sectors back to flash and flush the flash instance
+    */
+    esp_err_t flush() override;
+
+protected:
+    struct Block {
+        size_t addr;            /*!< Address of the cached sector, SIZE_MAX if the entry is free */
+        uint32_t last_use;      /*!< Value of use_counter at the last access, for LRU eviction */
+        uint32_t dirty_seq;     /*!< Value of dirty_counter when the sector was first modified */
+        uint32_t dirty_units;   /*!< Bit mask of the units which have been modified */
+        uint32_t erased_units;  /*!< Bit mask of the units which have been erased */
+        uint8_t *data;          /*!< Content of the sector */
+    };
+
+    Flash_Access *flash;
+    size_t block_size;
+    size_t unit_size;
+    size_t units_per_block;
+    size_t blocks_count;
+    bool ordered;
+    Block *blocks = NULL;
+    uint8_t *data = NULL;
+    uint32_t use_counter = 0;
+    uint32_t dirty_counter = 0;
+
+    Block *find(size_t addr);
+    esp_err_t get(size_t addr, bool load, Block **block);
+    esp_err_t evict(Block *block);
+    esp_err_t sync_before(uint32_t dirty_seq);
+    esp_err_t write_back(Block *block);
+    esp_err_t write_back_units(Block *block, size_t first_unit, size_t count, bool erase);
+    esp_err_t invalidate(size_t start_address, size_t size);
+    void mark_dirty(Block *block, uint32_t units);
+};
+
+#endif // _WL_Cache_H_
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,6 +11,7 @@
 #include "Partition.h"
 #include "WL_Config.h"
 #include "WL_State.h"
+#include "wear_levelling.h"
 
 /**
 * @brief This class is used to make wear levelling for flash devices. Class implements Flash_Access interface
@@ -36,6 +37,9 @@ public :
 
     esp_err_t flush() override;
 
+    esp_err_t get_stats(wl_stats_t *stats);
+    esp_err_t get_erase_counts(uint32_t *counts, size_t count);
+
     Partition *get_part();
     wl_config_t *get_cfg();
 
@@ -56,11 +60,23 @@ protected:
     uint32_t state_size;
     uint32_t cfg_size;
     uint8_t *temp_buff = NULL;
+    uint8_t *pos_buff = NULL;           // position records of the second state copy, written once per update
+    size_t pos_pending = 0;             // number of moved blocks whose position record is not written to the second state copy
     size_t dummy_addr;
     uint32_t pos_data[4];
 
+    uint32_t erase_count = 0;           // number of sectors erased since init
+    uint32_t dummy_move_count = 0;      // number of dummy block moves since init
+    uint32_t *erase_counts = NULL;      // number of erases of each physical sector since init, if enabled
+    size_t erase_counts_size = 0;
+
     esp_err_t initSections();
     esp_err_t updateWL();
+    esp_err_t moveDummySectors(size_t count);
+    esp_err_t moveDummySector();
+    void countErase(size_t addr, size_t size);
+    esp_err_t findPos(size_t addr_state, size_t *pos);
+    esp_err_t copyPosRecords(size_t src_addr_state, size_t dest_addr_state);
     esp_err_t recoverPos();
     size_t calcAddr(size_t addr);
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -13,6 +13,7 @@
 #include "WL_Flash.h"
 #include "WL_Ext_Perf.h"
 #include "WL_Ext_Safe.h"
+#include "WL_Cache.h"
 #include "SPI_Flash.h"
 #include "Partition.h"
 
@@ -36,12 +37,19 @@
 #define WL_DEFAULT_START_ADDR   0
 #endif //WL_DEFAULT_START_ADDR
 
+#if CONFIG_WL_WRITE_BACK_CACHE_POWER_FAIL_SAFE
+#define WL_CACHE_ORDERED    true
+#else
+#define WL_CACHE_ORDERED    false
+#endif // CONFIG_WL_WRITE_BACK_CACHE_POWER_FAIL_SAFE
+
 #ifndef WL_CURRENT_VERSION
 #define WL_CURRENT_VERSION  2
 #endif //WL_CURRENT_VERSION
 
 typedef struct {
     WL_Flash *instance;
+    Flash_Access *access;   // instance itself, or the write-back cache placed on top of it
     _lock_t lock;
 } wl_instance_t;
 
@@ -56,6 +64,11 @@ esp_err_t wl_mount(const esp_partition_t *partition, wl_handle_t *out_handle)
     // Initialize variables before the first jump to cleanup label
     void *wl_flash_ptr = NULL;
     WL_Flash *wl_flash = NULL;
+    Flash_Access *access = NULL;
+#if CONFIG_WL_WRITE_BACK_CACHE
+    void *wl_cache_ptr = NULL;
+    WL_Cache *wl_cache = NULL;
+#endif // CONFIG_WL_WRITE_BACK_CACHE
     void *part_ptr = NULL;
     Partition *part = NULL;
     esp_err_t result = ESP_OK;
@@ -147,7 +160,27 @@ esp_err_t wl_mount(const esp_partition_t *partition, wl_handle_t *out_handle)
         goto out;
     }
 
+    access = wl_flash;
+#if CONFIG_WL_WRITE_BACK_CACHE
+    // Same for WL_Cache, one cached sector is one flash sector
+    wl_cache_ptr = malloc(sizeof(WL_Cache));
+    if (wl_cache_ptr == NULL) {
+        result = ESP_ERR_NO_MEM;
+        ESP_LOGE(TAG, "%s: can't allocate WL_Cache", __func__);
+        goto out;
+    }
+    wl_cache = new (wl_cache_ptr) WL_Cache(wl_flash, cfg.flash_sector_size, CONFIG_WL_WRITE_BACK_CACHE_SECTORS,
+                                           WL_CACHE_ORDERED);
+    result = wl_cache->init();
+    if (ESP_OK != result) {
+        ESP_LOGE(TAG, "%s: cache init instance=0x%08" PRIx32 ", result=0x%x", __func__, *out_handle, result);
+        goto out;
+    }
+    access = wl_cache;
+#endif // CONFIG_WL_WRITE_BACK_CACHE
+
     s_instances[*out_handle].instance = wl_flash;
+    s_instances[*out_handle].access = access;
     // Initialise the lock for respective WL handle
     _lock_init(&s_instances[*out_handle].lock);
 
@@ -157,6 +190,12 @@ esp_err_t wl_mount(const esp_partition_t *partition, wl_handle_t *out_handle)
 out:
     _lock_release(&s_instances_lock);
     *out_handle = WL_INVALID_HANDLE;
+#if CONFIG_WL_WRITE_BACK_CACHE
+    if (wl_cache) {
+        wl_cache->~WL_Cache();
+        free(wl_cache);
+    }
+#endif // CONFIG_WL_WRITE_BACK_CACHE
     if (wl_flash) {
         wl_flash->~WL_Flash();
         free(wl_flash);
@@ -176,10 +215,15 @@ esp_err_t wl_unmount(wl_handle_t handle)
     if (result == ESP_OK) {
         // We use placement new in wl_mount, so call destructor directly
         Partition *part = s_instances[handle].instance->get_part();
-        // We have to flush state of the component
+        // We have to flush state of the component, and the cached sectors if any
         if (!part->is_readonly()) {
-            result = s_instances[handle].instance->flush();
+            result = s_instances[handle].access->flush();
         }
+        if (s_instances[handle].access != s_instances[handle].instance) {
+            s_instances[handle].access->~Flash_Access();
+            free(s_instances[handle].access);
+        }
+        s_instances[handle].access = NULL;
         part->~Partition();
         free(part);
         s_instances[handle].instance->~WL_Flash();
@@ -198,7 +242,7 @@ esp_err_t wl_erase_range(wl_handle_t handle, size_t start_addr, size_t size)
         return result;
     }
     _lock_acquire(&s_instances[handle].lock);
-    result = s_instances[handle].instance->erase_range(start_addr, size);
+    result = s_instances[handle].access->erase_range(start_addr, size);
     _lock_release(&s_instances[handle].lock);
     return result;
 }
@@ -210,7 +254,7 @@ esp_err_t wl_write(wl_handle_t handle, size_t dest_addr, const void *src, size_t
         return result;
     }
     _lock_acquire(&s_instances[handle].lock);
-    result = s_instances[handle].instance->write(dest_addr, src, size);
+    result = s_instances[handle].access->write(dest_addr, src, size);
     _lock_release(&s_instances[handle].lock);
     return result;
 }
@@ -222,7 +266,7 @@ esp_err_t wl_read(wl_handle_t handle, size_t src_addr, void *dest, size_t size)
         return result;
     }
     _lock_acquire(&s_instances[handle].lock);
-    result = s_instances[handle].instance->read(src_addr, dest, size);
+    result = s_instances[handle].access->read(src_addr, dest, size);
     _lock_release(&s_instances[handle].lock);
     return result;
 }
@@ -234,7 +278,7 @@ size_t wl_size(wl_handle_t handle)
         return 0;
     }
     _lock_acquire(&s_instances[handle].lock);
-    size_t result = s_instances[handle].instance->get_flash_size();
+    size_t result = s_instances[handle].access->get_flash_size();
     _lock_release(&s_instances[handle].lock);
     return result;
 }
@@ -246,7 +290,51 @@ size_t wl_sector_size(wl_handle_t handle)
         return 0;
     }
     _lock_acquire(&s_instances[handle].lock);
-    size_t result = s_instances[handle].instance->get_sector_size();
+    size_t result = s_instances[handle].access->get_sector_size();
+    _lock_release(&s_instances[handle].lock);
+    return result;
+}
+
+esp_err_t wl_sync(wl_handle_t handle)
+{
+    esp_err_t result = check_handle(handle, __func__);
+    if (result != ESP_OK) {
+        return result;
+    }
+    _lock_acquire(&s_instances[handle].lock);
+#if CONFIG_WL_WRITE_BACK_CACHE
+    result = ((WL_Cache *)s_instances[handle].access)->sync();
+#endif // CONFIG_WL_WRITE_BACK_CACHE
+    _lock_release(&s_instances[handle].lock);
+    return result;
+}
+
+esp_err_t wl_get_stats(wl_handle_t handle, wl_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t result = check_handle(handle, __func__);
+    if (result != ESP_OK) {
+        return result;
+    }
+    _lock_acquire(&s_instances[handle].lock);
+    result = s_instances[handle].instance->get_stats(stats);
+    _lock_release(&s_instances[handle].lock);
+    return result;
+}
+
+esp_err_t wl_get_sector_erase_counts(wl_handle_t handle, uint32_t *counts, size_t count)
+{
+    if (counts == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t result = check_handle(handle, __func__);
+    if (result != ESP_OK) {
+        return result;
+    }
+    _lock_acquire(&s_instances[handle].lock);
+    result = s_instances[handle].instance->get_erase_counts(counts, count);
     _lock_release(&s_instances[handle].lock);
     return result;
 }
@@ -144,6 +144,7 @@ struct wifi_prov_mgr_ctx {
     wifi_ap_record_t *ap_list[14];
     wifi_ap_record_t *ap_list_sorted[MAX_SCAN_RESULTS];
     wifi_scan_config_t scan_cfg;
+    int64_t scan_done_time;     // time at which the last complete scan finished, 0 if none
 
     /* Total number of attempts done for connecting to Wi-Fi */
     uint32_t connection_attempts_completed;
@@ -704,6 +705,7 @@ static bool wifi_prov_mgr_stop_service(bool blocking)
         prov_ctx->ap_list[channel] = NULL;
     }
     prov_ctx->scanning = false;
+    prov_ctx->scan_done_time = 0;
     for (uint8_t i = 0; i < MAX_SCAN_RESULTS; i++) {
         prov_ctx->ap_list_sorted[i] = NULL;
     }
@@ -906,6 +908,10 @@ static esp_err_t update_wifi_scan_results(void)
 
     final:
 
+    if (!prov_ctx->scanning) {
+        /* Remember when the results were complete, for serving them from the cache */
+        prov_ctx->scan_done_time = (ret == ESP_OK) ? esp_timer_get_time() : 0;
+    }
     return ret;
 }
 
@@ -1045,6 +1051,17 @@ esp_err_t wifi_prov_mgr_wifi_scan_start(bool blocking, bool passive,
         return ESP_OK;
     }
 
+#if CONFIG_WIFI_PROV_SCAN_CACHE_TIMEOUT > 0
+    /* Serve the results of a recent scan instead of scanning again */
+    if (prov_ctx->scan_done_time &&
+        esp_timer_get_time() - prov_ctx->scan_done_time < CONFIG_WIFI_PROV_SCAN_CACHE_TIMEOUT * 1000000LL) {
+        ESP_LOGD(TAG, "Using cached scan results");
+        RELEASE_LOCK(prov_ctx_lock);
+        return ESP_OK;
+    }
+#endif
+    prov_ctx->scan_done_time = 0;
+
     /* Clear sorted list for new entries */
     for (uint8_t i = 0; i < MAX_SCAN_RESULTS; i++) {
         prov_ctx->ap_list_sorted[i] = NULL;
@@ -1738,6 +1755,15 @@ exit:
         esp_wifi_set_storage(WIFI_STORAGE_FLASH);
     }
     RELEASE_LOCK(prov_ctx_lock);
+#if CONFIG_WIFI_PROV_SCAN_ON_START
+    if (ret == ESP_OK) {
+        /* Scan in the background while the client connects, so that the
+         * results are ready by the time the client asks for them */
+        if (wifi_prov_mgr_wifi_scan_start(false, false, 0, 0) != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to start scan on provisioning start");
+        }
+    }
+#endif
     return ret;
 }
 
@@ -8,6 +8,7 @@
 #include <string.h>
 #include <esp_err.h>
 #include <esp_log.h>
+#include <protocomm_pb_arena.h>
 
 #include "wifi_constants.pb-c.h"
 #include "wifi_config.pb-c.h"
@@ -313,9 +314,12 @@ esp_err_t wifi_prov_config_data_handler(uint32_t session_id, const uint8_t *inbu
     WiFiConfigPayload resp;
     esp_err_t ret;
 
-    req = wi_fi_config_payload__unpack(NULL, inlen, inbuf);
+    protocomm_pb_arena_t *arena = protocomm_pb_arena_create(inlen);
+    ProtobufCAllocator *allocator = protocomm_pb_arena_get_allocator(arena);
+    req = wi_fi_config_payload__unpack(allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack config data");
+        protocomm_pb_arena_delete(arena);
         return ESP_ERR_INVALID_ARG;
     }
 
@@ -323,11 +327,14 @@ esp_err_t wifi_prov_config_data_handler(uint32_t session_id, const uint8_t *inbu
     ret = wifi_prov_config_command_dispatcher(req, &resp, priv_data);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Proto command dispatcher error %d", ret);
+        wi_fi_config_payload__free_unpacked(req, allocator);
+        protocomm_pb_arena_delete(arena);
         return ESP_FAIL;
     }
 
     resp.msg = req->msg + 1; /* Response is request + 1 */
-    wi_fi_config_payload__free_unpacked(req, NULL);
+    wi_fi_config_payload__free_unpacked(req, allocator);
+    protocomm_pb_arena_delete(arena);
 
     *outlen = wi_fi_config_payload__get_packed_size(&resp);
     if (*outlen <= 0) {
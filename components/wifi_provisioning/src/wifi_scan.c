@@ -17,6 +17,7 @@
 #include <string.h>
 #include <esp_err.h>
 #include <esp_wifi.h>
+#include <protocomm_pb_arena.h>
 
 #include "wifi_scan.pb-c.h"
 
@@ -262,9 +263,12 @@ esp_err_t wifi_prov_scan_handler(uint32_t session_id, const uint8_t *inbuf, ssiz
     WiFiScanPayload resp;
     esp_err_t ret = ESP_OK;
 
-    req = wi_fi_scan_payload__unpack(NULL, inlen, inbuf);
+    protocomm_pb_arena_t *arena = protocomm_pb_arena_create(inlen);
+    ProtobufCAllocator *allocator = protocomm_pb_arena_get_allocator(arena);
+    req = wi_fi_scan_payload__unpack(allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack scan message");
+        protocomm_pb_arena_delete(arena);
         return ESP_ERR_INVALID_ARG;
     }
 
@@ -294,7 +298,8 @@ esp_err_t wifi_prov_scan_handler(uint32_t session_id, const uint8_t *inbuf, ssiz
     ESP_LOGD(TAG, "Response packet size : %d", *outlen);
     exit:
 
-    wi_fi_scan_payload__free_unpacked(req, NULL);
+    wi_fi_scan_payload__free_unpacked(req, allocator);
+    protocomm_pb_arena_delete(arena);
     wifi_prov_scan_cmd_cleanup(&resp, priv_data);
     return ret;
 }
@@ -159,8 +159,7 @@ RISCV_COPROC_DOCS = ['api-reference/system/ulp-risc-v.rst',]
 
 LP_CORE_DOCS = ['api-reference/system/ulp-lp-core.rst']
 
-XTENSA_DOCS = ['api-guides/hlinterrupts.rst',
-               'api-reference/system/perfmon.rst']
+XTENSA_DOCS = ['api-guides/hlinterrupts.rst']
 
 RISCV_DOCS = []  # type: list[str]
 
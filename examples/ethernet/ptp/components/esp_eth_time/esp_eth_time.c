@@ -1,10 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <errno.h>
+#include <stdlib.h>
 #include "esp_eth_time.h"
 
 static esp_eth_handle_t s_eth_hndl;
@@ -124,6 +125,34 @@ int esp_eth_clock_register_target_cb(clockid_t clock_id,
     return 0;
 }
 
+int esp_eth_clock_sync_system_time(clockid_t clock_id, int64_t step_threshold_us, int64_t *offset_us)
+{
+    struct timespec clock_time;
+    struct timeval sys_time;
+    if (esp_eth_clock_gettime(clock_id, &clock_time) == -1) {
+        return -1;
+    }
+    gettimeofday(&sys_time, NULL);
+
+    int64_t offset = ((int64_t)clock_time.tv_sec - sys_time.tv_sec) * 1000000LL +
+                     clock_time.tv_nsec / 1000 - sys_time.tv_usec;
+    if (offset_us) {
+        *offset_us = offset;
+    }
+    if (llabs(offset) >= step_threshold_us) {
+        struct timeval tv = {
+            .tv_sec = clock_time.tv_sec,
+            .tv_usec = clock_time.tv_nsec / 1000
+        };
+        return settimeofday(&tv, NULL);
+    }
+    struct timeval delta = {
+        .tv_sec = offset / 1000000LL,
+        .tv_usec = offset % 1000000LL
+    };
+    return adjtime(&delta, NULL);
+}
+
 esp_err_t esp_eth_clock_init(clockid_t clock_id, esp_eth_clock_cfg_t *cfg)
 {
     switch (clock_id) {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -114,6 +114,23 @@ int esp_eth_clock_set_target_time(clockid_t clock_id, struct timespec *tp);
 int esp_eth_clock_register_target_cb(clockid_t clock_id,
                                      ts_target_exceed_cb_from_isr_t ts_callback);
 
+/**
+ * @brief Synchronize the system time (`gettimeofday()`) to the clock
+ *
+ * When the offset between the clock and the system time is less than step_threshold_us, the system time is slewed
+ * by `adjtime()`, so that it does not jump. Otherwise, it is stepped by `settimeofday()`. Call this function
+ * periodically once the clock is synchronized, e.g. by PTP, to keep disciplining the system time.
+ *
+ * @param clock_id Identifier of the clock to synchronize the system time to
+ * @param step_threshold_us Offset from which the system time is stepped, in microseconds
+ * @param offset_us Optional pointer to store the offset of the clock from the system time, in microseconds
+ *
+ * @return
+ *     - 0: Success
+ *     - -1: Failure
+ */
+int esp_eth_clock_sync_system_time(clockid_t clock_id, int64_t step_threshold_us, int64_t *offset_us);
+
 /**
  * @brief Initialize the Ethernet clock subsystem
  *
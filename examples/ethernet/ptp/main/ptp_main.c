@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -145,6 +145,14 @@ void app_main(void)
             gpio_set_level(CONFIG_EXAMPLE_PTP_PULSE_GPIO, s_gpio_level);
             esp_eth_clock_set_target_time(CLOCK_PTP_SYSTEM, &s_next_time);
         }
+#if CONFIG_EXAMPLE_PTP_SYNC_SYSTEM_TIME
+        if (clock_source_valid) {
+            int64_t offset_us;
+            if (esp_eth_clock_sync_system_time(CLOCK_PTP_SYSTEM, CONFIG_EXAMPLE_PTP_SYNC_STEP_THRESHOLD_US, &offset_us) == 0) {
+                ESP_LOGD(TAG, "system time offset: %lld us", offset_us);
+            }
+        }
+#endif
         clock_source_valid_last = clock_source_valid;
     }
 }
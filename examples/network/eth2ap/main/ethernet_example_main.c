@@ -65,7 +65,7 @@ static esp_err_t pkt_eth2wifi(esp_eth_handle_t eth_handle, uint8_t *buffer, uint
     };
     if (xQueueSend(flow_control_queue, &msg, pdMS_TO_TICKS(FLOW_CONTROL_QUEUE_TIMEOUT_MS)) != pdTRUE) {
         ESP_LOGE(TAG, "send flow control message failed or timeout");
-        free(buffer);
+        esp_eth_free_rx_buffer(eth_handle, buffer);
         ret = ESP_FAIL;
     }
     return ret;
@@ -91,7 +91,7 @@ static void eth2wifi_flow_control_task(void *args)
                     ESP_LOGE(TAG, "WiFi send packet failed: %d", res);
                 }
             }
-            free(msg.packet);
+            esp_eth_free_rx_buffer(s_eth_handle, msg.packet);
         }
     }
     vTaskDelete(NULL);
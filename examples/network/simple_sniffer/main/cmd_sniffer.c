@@ -162,7 +162,7 @@ static esp_err_t eth_sniffer_cb(esp_eth_handle_t eth_handle, uint8_t *buffer, ui
 
     queue_packet(buffer, &packet_info);
 
-    free(buffer);
+    esp_eth_free_rx_buffer(eth_handle, buffer);
 
     return ESP_OK;
 }
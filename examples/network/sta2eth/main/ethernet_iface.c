@@ -263,7 +263,7 @@ void mac_spoof(mac_spoof_direction_t direction, uint8_t *buffer, uint16_t len, u
 static esp_err_t wired_recv(esp_eth_handle_t eth_handle, uint8_t *buffer, uint32_t len, void *priv)
 {
     esp_err_t ret = s_rx_cb(buffer, len, buffer);
-    free(buffer);
+    esp_eth_free_rx_buffer(eth_handle, buffer);
     return ret;
 }
 
@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: 2018-2023 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
 #
 
@@ -93,3 +93,30 @@ def set_prop_vals_response(security_ctx, response_data):
     resp = local_ctrl_pb2.LocalCtrlMessage()
     resp.ParseFromString(decrypt)
     return (resp.resp_set_prop_vals.status == 0)
+
+
+def get_changed_prop_vals_request(security_ctx, since):
+    req = local_ctrl_pb2.LocalCtrlMessage()
+    req.msg = local_ctrl_pb2.TypeCmdGetChangedPropertyValues
+    payload = local_ctrl_pb2.CmdGetChangedPropertyValues()
+    payload.since = since
+    req.cmd_get_changed_prop_vals.MergeFrom(payload)
+    enc_cmd = security_ctx.encrypt_data(req.SerializeToString())
+    return enc_cmd.decode('latin-1')
+
+
+def get_changed_prop_vals_response(security_ctx, response_data):
+    decrypt = security_ctx.decrypt_data(to_bytes(response_data))
+    resp = local_ctrl_pb2.LocalCtrlMessage()
+    resp.ParseFromString(decrypt)
+    results = []
+    if (resp.resp_get_changed_prop_vals.status == 0):
+        for index, prop in zip(resp.resp_get_changed_prop_vals.indices, resp.resp_get_changed_prop_vals.props):
+            results += [{
+                'index': index,
+                'name': prop.name,
+                'type': prop.type,
+                'flags': prop.flags,
+                'value': prop.value
+            }]
+    return resp.resp_get_changed_prop_vals.seq, results
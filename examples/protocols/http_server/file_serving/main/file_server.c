@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -229,7 +229,12 @@ static esp_err_t download_get_handler(httpd_req_t *req)
         return http_resp_dir_html(req, filepath);
     }
 
-    if (stat(filepath, &file_stat) == -1) {
+    /* Prefer the precompressed variant of the file, if present and the client accepts it */
+    char gz_filepath[FILE_PATH_MAX + sizeof(".gz")];
+    snprintf(gz_filepath, sizeof(gz_filepath), "%s.gz", filepath);
+    bool gzipped = httpd_req_accepts_encoding(req, "gzip") && stat(gz_filepath, &file_stat) == 0;
+
+    if (!gzipped && stat(filepath, &file_stat) == -1) {
         /* If file not present on SPIFFS check if URI
          * corresponds to one of the hardcoded paths */
         if (strcmp(filename, "/index.html") == 0) {
@@ -243,7 +248,7 @@ static esp_err_t download_get_handler(httpd_req_t *req)
         return ESP_FAIL;
     }
 
-    fd = fopen(filepath, "r");
+    fd = fopen(gzipped ? gz_filepath : filepath, "r");
     if (!fd) {
         ESP_LOGE(TAG, "Failed to read existing file : %s", filepath);
         /* Respond with 500 Internal Server Error */
@@ -251,8 +256,13 @@ static esp_err_t download_get_handler(httpd_req_t *req)
         return ESP_FAIL;
     }
 
-    ESP_LOGI(TAG, "Sending file : %s (%ld bytes)...", filename, file_stat.st_size);
+    ESP_LOGI(TAG, "Sending file : %s%s (%ld bytes)...", filename, gzipped ? ".gz" : "", file_stat.st_size);
     set_content_type_from_file(req, filename);
+    /* The response depends on the Accept-Encoding header, tell it to the caches */
+    httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+    if (gzipped) {
+        httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    }
 
     /* Retrieve the pointer to scratch buffer for temporary storage */
     char *chunk = ((struct file_server_data *)req->user_ctx)->scratch;
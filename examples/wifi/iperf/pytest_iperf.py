@@ -34,21 +34,7 @@ NO_BANDWIDTH_LIMIT = -1  # iperf send bandwidth is not limited
 BEST_PERFORMANCE_CONFIG = '99'
 
 
-@pytest.mark.temp_skip_ci(targets=['esp32s2', 'esp32c3', 'esp32s3'], reason='lack of runners (run only for ESP32)')
-@pytest.mark.timeout(1200)
-@pytest.mark.wifi_iperf
-@pytest.mark.parametrize('config', [BEST_PERFORMANCE_CONFIG], indirect=True)
-@idf_parametrize('target', ['esp32'], indirect=['target'])
-def test_wifi_throughput_basic(
-    dut: Dut,
-    log_performance: Callable[[str, str], None],
-    check_performance: Callable[[str, float, str], None],
-) -> None:
-    """
-    steps: |
-      1. test TCP tx rx and UDP tx rx throughput
-      2. compare with the pre-defined pass standard
-    """
+def run_throughput_test(dut: Dut, config: str, log_performance: Callable[[str, str], None], log_suffix: str) -> dict:
     # 1. wait for DUT
     dut.expect('iperf>')
 
@@ -63,29 +49,64 @@ def test_wifi_throughput_basic(
     }
 
     test_result = {
-        'tcp_tx': IperfUtility.TestResult('tcp', 'tx', BEST_PERFORMANCE_CONFIG),
-        'tcp_rx': IperfUtility.TestResult('tcp', 'rx', BEST_PERFORMANCE_CONFIG),
-        'udp_tx': IperfUtility.TestResult('udp', 'tx', BEST_PERFORMANCE_CONFIG),
-        'udp_rx': IperfUtility.TestResult('udp', 'rx', BEST_PERFORMANCE_CONFIG),
+        'tcp_tx': IperfUtility.TestResult('tcp', 'tx', config),
+        'tcp_rx': IperfUtility.TestResult('tcp', 'rx', config),
+        'udp_tx': IperfUtility.TestResult('udp', 'tx', config),
+        'udp_rx': IperfUtility.TestResult('udp', 'rx', config),
     }
 
     test_utility = IperfUtility.IperfTestUtility(
-        dut, BEST_PERFORMANCE_CONFIG, ap_info['ssid'], ap_info['password'], pc_nic_ip, pc_iperf_log_file, test_result
+        dut, config, ap_info['ssid'], ap_info['password'], pc_nic_ip, pc_iperf_log_file, test_result
     )
 
     # 3. run test for TCP Tx, Rx and UDP Tx, Rx
     for _ in range(RETRY_COUNT_FOR_BEST_PERFORMANCE):
         test_utility.run_all_cases(0, NO_BANDWIDTH_LIMIT)
 
-    # 4. log performance and compare with pass standard
+    # 4. log performance
     for throughput_type in test_result:
         log_performance(
-            '{}_throughput'.format(throughput_type),
+            '{}_throughput{}'.format(throughput_type, log_suffix),
             '{:.02f} Mbps'.format(test_result[throughput_type].get_best_throughput()),
         )
+    return test_result
+
+
+@pytest.mark.temp_skip_ci(targets=['esp32s2', 'esp32c3', 'esp32s3'], reason='lack of runners (run only for ESP32)')
+@pytest.mark.timeout(1200)
+@pytest.mark.wifi_iperf
+@pytest.mark.parametrize('config', [BEST_PERFORMANCE_CONFIG], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_wifi_throughput_basic(
+    dut: Dut,
+    log_performance: Callable[[str, str], None],
+    check_performance: Callable[[str, float, str], None],
+) -> None:
+    """
+    steps: |
+      1. test TCP tx rx and UDP tx rx throughput
+      2. compare with the pre-defined pass standard
+    """
+    test_result = run_throughput_test(dut, BEST_PERFORMANCE_CONFIG, log_performance, '')
 
     # do check after logging, otherwise test will exit immediately if check fail, some performance can't be logged.
     for throughput_type in test_result:
         check_performance(
             '{}_throughput'.format(throughput_type), test_result[throughput_type].get_best_throughput(), dut.target
         )
+
+
+@pytest.mark.timeout(1200)
+@pytest.mark.wifi_iperf
+@pytest.mark.parametrize('config', ['net_core'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_wifi_throughput_net_core(
+    dut: Dut,
+    log_performance: Callable[[str, str], None],
+) -> None:
+    """
+    steps: |
+      1. test TCP tx rx and UDP tx rx throughput with the network tasks pinned to CPU1
+      2. log the results next to the ones of test_wifi_throughput_basic for comparison
+    """
+    run_throughput_test(dut, 'net_core', log_performance, '_net_core')
@@ -0,0 +1,253 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+# This program decodes the BLE logs sent to the SPI bus with CONFIG_BT_BLE_LOG_SPI_OUT_ENABLED
+# (see components/bt/common/ble_log/ble_log_spi_out.c), as captured from the MOSI line, e.g. with a logic analyzer.
+#
+# Each log is a frame: length (16 bits, little endian), source, frame counter, payload, 0xAA. The frame counter
+# of each log buffer (upper layer, controller task, controller ISR) is also incremented for the frames which were
+# dropped because the buffer was full, so a gap in the counters shows the lost frames, whether the device reported
+# them with a loss frame or the capture missed them.
+#
+# Host logs sent in binary format (CONFIG_BT_BLE_LOG_SPI_OUT_BINARY) are formatted with the strings of the ELF file
+# of the application. HCI packets can be saved to a btsnoop file, which can be opened with Wireshark.
+import argparse
+import os
+import struct
+import sys
+from typing import BinaryIO
+from typing import Callable
+from typing import Dict
+from typing import List
+from typing import Optional
+from typing import TextIO
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+from log_binary_decode import ElfStrings  # noqa: E402
+from log_binary_decode import format_message  # noqa: E402
+from log_binary_decode import FrameError  # noqa: E402
+from log_binary_decode import Reader  # noqa: E402
+
+FRAME_HEAD_LEN = 4
+FRAME_TAIL = 0xAA
+FRAME_MAX_LEN = 10240  # SPI_OUT_MAX_TRANSFER_SIZE
+
+SOURCE_ESP = 0
+SOURCE_ESP_LEGACY = 1
+SOURCE_BLUEDROID = 2
+SOURCE_NIMBLE = 3
+SOURCE_HCI_UPSTREAM = 4
+SOURCE_HCI_DOWNSTREAM = 5
+SOURCE_ESP_ISR = 6
+SOURCE_ESP_LEGACY_ISR = 7
+SOURCE_USER = 0x10
+SOURCE_SYNC = 0xFE
+SOURCE_LOSS = 0xFF
+
+SOURCE_NAMES = {
+    SOURCE_ESP: 'LL_TASK',
+    SOURCE_ESP_LEGACY: 'LL_TASK_LEGACY',
+    SOURCE_BLUEDROID: 'BLUEDROID',
+    SOURCE_NIMBLE: 'NIMBLE',
+    SOURCE_HCI_UPSTREAM: 'HCI_UP',
+    SOURCE_HCI_DOWNSTREAM: 'HCI_DOWN',
+    SOURCE_ESP_ISR: 'LL_ISR',
+    SOURCE_ESP_LEGACY_ISR: 'LL_ISR_LEGACY',
+    SOURCE_USER: 'USER',
+    SOURCE_SYNC: 'SYNC',
+    SOURCE_LOSS: 'LOSS',
+}
+
+# log buffers of the device, each with its own frame counter, indexed by the flag of the loss frames
+CHANNEL_UL = 0
+CHANNEL_LL_TASK = 1
+CHANNEL_LL_ISR = 2
+CHANNEL_NAMES = ['UL', 'LL_TASK', 'LL_ISR']
+
+# first byte after the timestamp of the binary upper layer logs, and level of ble_log_spi_out_printf()
+BIN_MARKER = 0x02
+BIN_LEVEL_NONE = 0xFF
+
+# H4 packet types
+H4_CMD = 0x01
+H4_EVT = 0x04
+
+# microseconds from year 0 to 1970-01-01, as used by btsnoop
+BTSNOOP_EPOCH_DELTA = 0x00DCDDB30F2F8000
+
+
+def channel_of(source: int, payload: bytes) -> int:
+    if source in (SOURCE_ESP, SOURCE_ESP_LEGACY):
+        return CHANNEL_LL_TASK
+    if source in (SOURCE_ESP_ISR, SOURCE_ESP_LEGACY_ISR):
+        return CHANNEL_LL_ISR
+    if source == SOURCE_LOSS and payload and payload[0] < len(CHANNEL_NAMES):
+        return payload[0]
+    return CHANNEL_UL
+
+
+class Timestamp(object):
+    """ Extends the 32-bit microsecond timestamps of the device, which wrap around every 71 minutes """
+
+    def __init__(self) -> None:
+        self._last = None  # type: Optional[int]
+        self._high = 0
+
+    def __call__(self, ts: int) -> int:
+        if self._last is not None and ts < self._last and self._last - ts > 0x80000000:
+            self._high += 1 << 32
+        self._last = ts
+        return self._high + ts
+
+
+class BtSnoopWriter(object):
+    def __init__(self, f: BinaryIO) -> None:
+        self._f = f
+        self._f.write(b'btsnoop\x00' + struct.pack('>II', 1, 1002))  # version 1, H4 datalink
+
+    def write(self, packet: bytes, received: bool, ts_us: int) -> None:
+        if not packet:
+            return
+        flags = int(received) | (2 if packet[0] in (H4_CMD, H4_EVT) else 0)
+        self._f.write(struct.pack('>IIIIQ', len(packet), len(packet), flags, 0, ts_us + BTSNOOP_EPOCH_DELTA))
+        self._f.write(packet)
+
+
+class Decoder(object):
+    """ Splits the capture into frames and formats them """
+
+    def __init__(self, resolve_str: Optional[Callable[[int], str]] = None,
+                 btsnoop: Optional[BtSnoopWriter] = None) -> None:
+        self.resolve_str = resolve_str
+        self.btsnoop = btsnoop
+        self._buf = bytearray()
+        self._ts = Timestamp()
+        self._frame_cnt = [None, None, None]  # type: List[Optional[int]]
+        self.frames = {}  # type: Dict[int, int]
+        self.gaps = [0, 0, 0]
+        self.lost_bytes = [0, 0, 0]
+        self.lost_trans = [0, 0, 0]
+        self.skipped = 0
+
+    def feed(self, data: bytes, final: bool = False) -> str:
+        """ Returns the text of the frames received, final is set at the end of the capture """
+        self._buf += data
+        out = []  # type: List[str]
+        pos = 0
+        while len(self._buf) - pos >= FRAME_HEAD_LEN + 1:
+            length = self._buf[pos] | self._buf[pos + 1] << 8
+            end = pos + FRAME_HEAD_LEN + length
+            if end >= len(self._buf):
+                # wait for the rest of the frame, unless it can't be one (idle bus, corrupted length)
+                if length <= FRAME_MAX_LEN and not final:
+                    break
+            elif self._buf[end] == FRAME_TAIL:
+                out.append(self._frame(self._buf[pos + 2], self._buf[pos + 3],
+                                       bytes(self._buf[pos + FRAME_HEAD_LEN:end])))
+                pos = end + 1
+                continue
+            # not a frame here: resynchronize on the next byte
+            pos += 1
+            self.skipped += 1
+        del self._buf[:pos]
+        return ''.join(out)
+
+    def _count(self, channel: int, frame_cnt: int) -> None:
+        expected = self._frame_cnt[channel]
+        if expected is not None and frame_cnt != expected:
+            self.gaps[channel] += (frame_cnt - expected) & 0xFF
+        self._frame_cnt[channel] = (frame_cnt + 1) & 0xFF
+
+    def _frame(self, source: int, frame_cnt: int, payload: bytes) -> str:
+        self._count(channel_of(source, payload), frame_cnt)
+        self.frames[source] = self.frames.get(source, 0) + 1
+        name = SOURCE_NAMES.get(source, 'SOURCE_{:02X}'.format(source))
+        try:
+            ts, text = self._payload(source, payload)
+        except FrameError as e:
+            ts, text = None, '<invalid frame: {}> {}'.format(e, payload.hex(' '))
+        ts_text = '{:>14}'.format(ts) if ts is not None else ' ' * 14
+        return '{} {:<14} {:>3} {}\n'.format(ts_text, name, frame_cnt, text)
+
+    def _payload(self, source: int, payload: bytes) -> tuple:
+        reader = Reader(payload)
+        if source == SOURCE_LOSS:
+            flag = reader.u8()
+            lost_bytes = reader.u32()
+            lost_trans = reader.u8()
+            channel = flag if flag < len(CHANNEL_NAMES) else CHANNEL_UL
+            self.lost_bytes[channel] += lost_bytes
+            self.lost_trans[channel] += lost_trans
+            return None, '{} lost {} bytes, {} transactions'.format(CHANNEL_NAMES[channel], lost_bytes, lost_trans)
+        if source == SOURCE_SYNC:
+            io_level = reader.u8()
+            lc_ts = reader.u32()
+            esp_ts = self._ts(reader.u32())
+            return esp_ts, 'io {} lc_ts {}'.format(io_level, lc_ts)
+        if channel_of(source, payload) != CHANNEL_UL:
+            # controller logs are in the binary format of the controller library
+            return None, payload.hex(' ')
+
+        ts = self._ts(reader.u32())
+        data = payload[4:]
+        if source in (SOURCE_HCI_UPSTREAM, SOURCE_HCI_DOWNSTREAM):
+            if self.btsnoop:
+                self.btsnoop.write(data, source == SOURCE_HCI_UPSTREAM, ts)
+            return ts, data.hex(' ')
+        if data and data[0] == BIN_MARKER and self.resolve_str:
+            return ts, self._binary(reader)
+        return ts, data.decode('utf-8', 'replace').rstrip('\n')
+
+    def _binary(self, reader: Reader) -> str:
+        assert self.resolve_str is not None
+        reader.u8()
+        level = reader.u8()
+        fmt = self.resolve_str(reader.u32())
+        tag_addr = reader.u32()
+        message = format_message(fmt, reader, self.resolve_str)
+        if reader.pos != len(reader.data):
+            raise FrameError('unexpected data at the end of the frame')
+        if level == BIN_LEVEL_NONE:
+            return message.rstrip('\n')
+        tag = self.resolve_str(tag_addr) if tag_addr else 'NULL'
+        return '[{}][{}] {}'.format(level, tag, message.rstrip('\n'))
+
+    def summary(self) -> str:
+        lines = ['frames: ' + ', '.join('{} {}'.format(SOURCE_NAMES.get(s, s), n) for s, n in sorted(self.frames.items()))]
+        for channel, name in enumerate(CHANNEL_NAMES):
+            lines.append('{}: {} frames missing, {} bytes and {} transactions reported lost'.format(
+                name, self.gaps[channel], self.lost_bytes[channel], self.lost_trans[channel]))
+        if self.skipped:
+            lines.append('{} bytes outside of frames skipped'.format(self.skipped))
+        return '\n'.join(lines) + '\n'
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description='Decode the BLE logs captured from the SPI bus '
+                                                 '(CONFIG_BT_BLE_LOG_SPI_OUT_ENABLED)')
+    parser.add_argument('input', nargs='?', type=argparse.FileType('rb'), default=sys.stdin.buffer,
+                        help='Binary file with the bytes of the MOSI line, stdin by default')
+    parser.add_argument('--elf', '-e', help='ELF file of the application, to decode the binary host logs')
+    parser.add_argument('--btsnoop', '-s', type=argparse.FileType('wb'), help='Save the HCI packets to this btsnoop file')
+    parser.add_argument('--summary', action='store_true', help='Print the numbers of frames and lost frames at the end')
+    args = parser.parse_args()
+
+    decoder = Decoder(ElfStrings(args.elf) if args.elf else None, BtSnoopWriter(args.btsnoop) if args.btsnoop else None)
+    out = sys.stdout  # type: TextIO
+    try:
+        while True:
+            data = args.input.read1(4096)
+            out.write(decoder.feed(data, final=not data))
+            if not data:
+                break
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+    if args.summary:
+        out.write(decoder.summary())
+
+
+if __name__ == '__main__':
+    main()
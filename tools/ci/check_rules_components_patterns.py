@@ -48,6 +48,7 @@ def get_components_test_files() -> Set[str]:
         'components/*/host_test/**/*',
         # other test files
         'components/efuse/test_efuse_host/**/*',
+        'components/esp_assetfs/test_assetfsgen/**/*',
         'components/esp_coex/test_md5/**/*',
         'components/esp_gdbstub/test_gdbstub_host/**/*',
         'components/esp_system/test_eh_frame_parser/**/*',
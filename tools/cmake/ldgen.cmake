@@ -57,6 +57,14 @@ function(__ldgen_process_template template output)
         message(STATUS "Mapping check enabled in ldgen")
     endif()
 
+    if(CONFIG_COMPILER_HOT_FUNCTIONS_FILE)
+        idf_build_get_property(project_dir PROJECT_DIR)
+        get_filename_component(hot_functions_file "${CONFIG_COMPILER_HOT_FUNCTIONS_FILE}"
+            ABSOLUTE BASE_DIR "${project_dir}")
+        set(ldgen_hot_functions "--hot-functions" "${hot_functions_file}"
+            "--hot-functions-iram-size" "${CONFIG_COMPILER_HOT_FUNCTIONS_IRAM_SIZE}")
+    endif()
+
     add_custom_command(
         OUTPUT ${output}
         COMMAND ${python} "${idf_path}/tools/ldgen/ldgen.py"
@@ -69,7 +77,8 @@ function(__ldgen_process_template template output)
         --libraries-file "${build_dir}/ldgen_libraries"
         --objdump   "${CMAKE_OBJDUMP}"
         ${ldgen_check}
-        DEPENDS     ${template} ${ldgen_fragment_files} ${ldgen_depends} ${SDKCONFIG}
+        ${ldgen_hot_functions}
+        DEPENDS     ${template} ${ldgen_fragment_files} ${ldgen_depends} ${SDKCONFIG} ${hot_functions_file}
         VERBATIM
     )
 
@@ -0,0 +1,173 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+# Generates the hot function list for ldgen (CONFIG_COMPILER_HOT_FUNCTIONS_FILE) from a profile,
+# i.e. '<address> <count>' lines as printed by esp_apptrace_func_counters_dump(), or sampled
+# program counters in the same format, and the linker map file of the profiled build.
+#
+import argparse
+import bisect
+import collections
+import os
+import re
+import sys
+from typing import Dict
+from typing import Iterable
+from typing import List
+from typing import Optional
+from typing import TextIO
+from typing import Tuple
+
+# ' .text.name  0x42001234  0x56 esp-idf/comp/libcomp.a(file.c.obj)', the name may be on the line before
+INPUT_SECTION_RE = re.compile(r'^ (\.\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+SECTION_NAME_RE = re.compile(r'^ (\.\S+)$')
+SYMBOL_RE = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_][\w.$]*)$')
+OUTPUT_SECTION_RE = re.compile(r'^(\.\S+)')
+ARCHIVE_MEMBER_RE = re.compile(r'(?:^|[/\\])([^/\\()]+\.a)\(([^)]+)\)$')
+
+FLASH_TEXT = '.flash.text'
+IRAM_TEXT = '.iram0.text'
+
+InputSection = collections.namedtuple('InputSection', 'output name address size archive obj symbols')
+
+
+def parse_map(map_file: TextIO) -> List[InputSection]:
+    """Returns the input sections of the archive members placed in flash or IRAM text"""
+    sections: List[InputSection] = []
+    output_section = None
+    pending_name = None
+    started = False
+    for line in map_file:
+        line = line.rstrip('\n')
+        if not started:
+            started = line.startswith('Linker script and memory map')
+            continue
+        match = OUTPUT_SECTION_RE.match(line)
+        if match:
+            output_section = match.group(1)
+            continue
+        if output_section not in (FLASH_TEXT, IRAM_TEXT):
+            continue
+        match = SECTION_NAME_RE.match(line)
+        if match:
+            pending_name = match.group(1)
+            continue
+        match = INPUT_SECTION_RE.match(line)
+        if match:
+            name = match.group(1) or pending_name
+            pending_name = None
+            member = ARCHIVE_MEMBER_RE.search(match.group(4).strip())
+            if name and member:
+                sections.append(InputSection(output_section, name, int(match.group(2), 16), int(match.group(3), 16),
+                                             member.group(1), member.group(2).split('.')[0], []))
+            continue
+        match = SYMBOL_RE.match(line)
+        if match and sections:
+            sections[-1].symbols.append((int(match.group(1), 16), match.group(2)))
+    return sections
+
+
+def parse_profile(profile_files: Iterable[TextIO]) -> Dict[int, int]:
+    counts: Dict[int, int] = collections.Counter()
+    for profile in profile_files:
+        for line in profile:
+            fields = line.split('#', 1)[0].split()
+            if len(fields) != 2:
+                continue
+            try:
+                counts[int(fields[0], 16)] += int(fields[1])
+            except ValueError:
+                continue
+    return counts
+
+
+def find_section(sections: List[InputSection], starts: List[int], address: int) -> Optional[InputSection]:
+    i = bisect.bisect_right(starts, address) - 1
+    if i >= 0 and sections[i].address <= address < sections[i].address + max(sections[i].size, 1):
+        return sections[i]
+    return None
+
+
+def hot_functions(sections: List[InputSection], counts: Dict[int, int],
+                  min_calls: int) -> Tuple[List[Tuple[str, int, int]], List[Tuple[str, int]]]:
+    """
+    Returns the hot functions in flash as (entity, calls, size), hottest first, and the functions in IRAM
+    of the profiled objects which were not called, as (entity, size).
+    """
+    text_sections = sorted((s for s in sections if s.size > 0), key=lambda s: s.address)
+    starts = [s.address for s in text_sections]
+
+    # the literals of a function are placed together with its text
+    literal_sizes: Dict[Tuple[str, str, str], int] = collections.Counter()
+    for s in sections:
+        if s.output == FLASH_TEXT and s.name.startswith('.literal.'):
+            literal_sizes[(s.archive, s.obj, s.name[len('.literal.'):])] += s.size
+
+    calls: Dict[Tuple[str, str, str], int] = collections.Counter()
+    sizes: Dict[Tuple[str, str, str], int] = {}
+    called_iram = set()
+    profiled_objects = set()
+    for (address, count) in counts.items():
+        section = find_section(text_sections, starts, address)
+        if section is None or count <= 0:
+            continue
+        profiled_objects.add((section.archive, section.obj))
+        if section.output == FLASH_TEXT and section.name.startswith('.text.'):
+            key = (section.archive, section.obj, section.name[len('.text.'):])
+            calls[key] += count
+            sizes[key] = section.size + literal_sizes[key]
+        elif section.output == IRAM_TEXT:
+            # the address may also be a sampled program counter within the function
+            symbols = [sym for sym in section.symbols if sym[0] <= address]
+            if symbols:
+                called_iram.add(max(symbols)[0])
+
+    hot = [('%s:%s:%s' % key, n, sizes[key]) for (key, n) in calls.items() if n >= min_calls]
+    hot.sort(key=lambda h: (-h[1], h[2], h[0]))
+
+    cold_iram = []
+    for s in sections:
+        if s.output == IRAM_TEXT and (s.archive, s.obj) in profiled_objects:
+            symbols = sorted(s.symbols)
+            for (i, (address, name)) in enumerate(symbols):
+                if address not in called_iram:
+                    end = symbols[i + 1][0] if i + 1 < len(symbols) else s.address + s.size
+                    cold_iram.append(('%s:%s:%s' % (s.archive, s.obj, name), end - address))
+    return hot, cold_iram
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description='Generate the hot function list for ldgen from a profile')
+    parser.add_argument('map', type=argparse.FileType('r'), help='Linker map file of the profiled build')
+    parser.add_argument('profile', type=argparse.FileType('r'), nargs='+',
+                        help="Profiles with '<address> <count>' lines, e.g. from several devices")
+    parser.add_argument('--output', '-o', type=argparse.FileType('w'), default=sys.stdout,
+                        help='Hot function list, to be set in CONFIG_COMPILER_HOT_FUNCTIONS_FILE')
+    parser.add_argument('--min-calls', type=int, default=1,
+                        help='Leave out the functions with fewer calls or samples')
+    parser.add_argument('--cold-iram', action='store_true',
+                        help='Print the functions in IRAM of the profiled objects which were not called. They are '
+                             'not moved, as code may have to be in IRAM to run while the cache is disabled.')
+    args = parser.parse_args()
+
+    sections = parse_map(args.map)
+    if not sections:
+        sys.exit('No archive members found in %s or %s of %s' % (FLASH_TEXT, IRAM_TEXT, args.map.name))
+    hot, cold_iram = hot_functions(sections, parse_profile(args.profile), args.min_calls)
+
+    args.output.write('# Generated by %s from %s\n' % (os.path.basename(__file__),
+                                                       ' '.join(p.name for p in args.profile)))
+    args.output.write('# <archive>:<object>:<symbol> <calls> <size>\n')
+    for (entity, calls, size) in hot:
+        args.output.write('%s %d 0x%x\n' % (entity, calls, size))
+
+    if args.cold_iram:
+        print('Functions in IRAM which were not called:', file=sys.stderr)
+        for (entity, size) in cold_iram:
+            print('    %s (%d bytes)' % (entity, size), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -1,6 +1,6 @@
 #!/usr/bin/env python
 #
-# SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
 #
 import argparse
@@ -100,6 +100,16 @@ def main():
         '--objdump',
         help='Path to toolchain objdump')
 
+    argparser.add_argument(
+        '--hot-functions',
+        type=argparse.FileType('r'),
+        help='Hot function list, the functions are placed in IRAM or grouped at the start of flash text')
+
+    argparser.add_argument(
+        '--hot-functions-iram-size',
+        type=int, default=0,
+        help='Maximum size in bytes of the hot functions placed in IRAM')
+
     args = argparser.parse_args()
 
     input_file = args.input
@@ -133,6 +143,8 @@ def main():
                 sections_infos.add_sections_info(dump)
 
         generation_model = Generation(check_mapping, check_mapping_exceptions)
+        if args.hot_functions:
+            generation_model.add_hot_functions(args.hot_functions, args.hot_functions_iram_size)
 
         _update_environment(args)  # assign args.env and args.env_file to os.environ
 
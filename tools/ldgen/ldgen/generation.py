@@ -247,17 +247,17 @@ class EntityNode:
         self.placements[sections] = placement
         return placement
 
-    def child_placement(self, entity, sections, target, flags, sections_db):
+    def child_placement(self, entity, sections, target, flags, sections_db, force=False):
         child = self.add_child(entity)
-        child.insert(entity, sections, target, flags, sections_db)
+        child.insert(entity, sections, target, flags, sections_db, force)
 
-    def insert(self, entity, sections, target, flags, sections_db):
+    def insert(self, entity, sections, target, flags, sections_db, force=False):
         if self.entity.specificity == entity.specificity:
             # Since specificities match, create the placement in this node.
-            self.self_placement(sections, target, flags)
+            self.self_placement(sections, target, flags, force=force)
         else:
             # If not, create a child node and try to create the placement there.
-            self.child_placement(entity, sections, target, flags, sections_db)
+            self.child_placement(entity, sections, target, flags, sections_db, force)
 
     def get_output_sections(self):
         return sorted(self.placements.keys(), key=lambda x: sorted(x))  # pylint: disable=W0108
@@ -298,9 +298,9 @@ class ObjectNode(EntityNode):
         self.entity = Entity(self.parent.name, self.name)
         self.subplacements = list()
 
-    def child_placement(self, entity, sections, target, flags, sections_db):
+    def child_placement(self, entity, sections, target, flags, sections_db, force=False):
         child = self.add_child(entity)
-        sym_placement = Placement(child, sections, target, flags, True, dryrun=True)
+        sym_placement = Placement(child, sections, target, flags, True, force, dryrun=True)
 
         # The basis placement for sym_placement can either be
         # an existing placement on this node, or nonexistent.
@@ -385,11 +385,17 @@ class Generation:
     # Processed mapping, scheme and section entries
     EntityMapping = namedtuple('EntityMapping', 'entity sections_group target flags')
 
+    # Entry of a hot function list
+    HotFunction = namedtuple('HotFunction', 'entity calls size')
+
     def __init__(self, check_mappings=False, check_mapping_exceptions=None):
         self.schemes = {}
         self.placements = {}
         self.mappings = {}
 
+        self.hot_functions = []
+        self.hot_functions_iram_size = 0
+
         self.check_mappings = check_mappings
 
         if check_mapping_exceptions:
@@ -442,11 +448,14 @@ class Generation:
 
         return scheme_dictionary
 
+    @staticmethod
+    def _get_section_strs(section):
+        s_list = [Sections.get_section_data_from_entry(s) for s in section.entries]
+        return frozenset([item for sublist in s_list for item in sublist])
+
     def _prepare_entity_mappings(self, scheme_dictionary, entities):
         # Prepare entity mappings processed from mapping fragment entries.
-        def get_section_strs(section):
-            s_list = [Sections.get_section_data_from_entry(s) for s in section.entries]
-            return frozenset([item for sublist in s_list for item in sublist])
+        get_section_strs = Generation._get_section_strs
 
         entity_mappings = dict()
 
@@ -523,9 +532,79 @@ class Generation:
         res.sort(key=lambda m: m.entity)
         return res
 
+    def _prepare_hot_mappings(self, scheme_dictionary, entity_mappings, entities):
+        # Place the hot functions in IRAM, in the order of the list, as long as they fit into
+        # the IRAM size. The others stay in flash, with their own input section description,
+        # so that _order_hot_commands can move them together.
+        if not self.hot_functions:
+            return []
+
+        try:
+            text = scheme_dictionary['noflash_text']['iram0_text'][0]
+        except (KeyError, IndexError):
+            raise GenerationException("Hot function placement requires scheme 'noflash_text' with an "
+                                      'entry for iram0_text.')
+        sections_str = Generation._get_section_strs(text)
+
+        def covers(entity, hot):
+            return (entity.archive == hot.archive
+                    and entity.obj in (None, Entity.ALL, hot.obj)
+                    and entity.symbol in (None, Entity.ALL, hot.symbol))
+
+        # Mappings of the text sections from mapping fragments, the most specific ones first
+        explicit = [m for m in reversed(entity_mappings)
+                    if m.sections_group == sections_str and m.entity.specificity != Entity.Specificity.NONE]
+
+        hot_mappings = []
+        placed = set()
+        iram_left = self.hot_functions_iram_size
+        for hot in self.hot_functions:
+            entity = hot.entity
+            if entity in placed or '.text.%s' % entity.symbol not in entities.get_sections(entity.archive, entity.obj):
+                # the list may be out of date
+                continue
+            # mapping fragments take precedence, e.g. for functions which are in IRAM already
+            mapping = next((m for m in explicit if covers(m.entity, entity)), None)
+            if mapping and (mapping.target != 'flash_text' or mapping.flags
+                            or mapping.entity.specificity == Entity.Specificity.SYMBOL):
+                continue
+            if hot.size <= iram_left:
+                iram_left -= hot.size
+                target = 'iram0_text'
+            else:
+                target = 'flash_text'
+            placed.add(entity)
+            hot_mappings.append(Generation.EntityMapping(entity, sections_str, target, []))
+        return hot_mappings
+
+    def _order_hot_commands(self, commands, hot_mappings):
+        # Move the input section descriptions of the hot functions which stay in flash to the
+        # start of flash_text, in the order of the list, so that they share as few cache
+        # lines and MMU pages with cold code as possible.
+        hot_sections = []
+        for mapping in hot_mappings:
+            if mapping.target == 'flash_text':
+                sections = frozenset(s.replace('.*', '.%s' % mapping.entity.symbol) for s in mapping.sections_group
+                                     if '.*' in s)
+                hot_sections.append((Entity(mapping.entity.archive, mapping.entity.obj), sections))
+        if not hot_sections:
+            return
+
+        flash_text = commands['flash_text']
+        order = {key: i for (i, key) in enumerate(hot_sections)}
+
+        def hot_index(command):
+            if isinstance(command, InputSectionDesc) and not command.exclusions:
+                return order.get((command.entity, frozenset(command.sections)))
+            return None
+
+        hot_commands = sorted((c for c in flash_text if hot_index(c) is not None), key=hot_index)
+        commands['flash_text'] = hot_commands + [c for c in flash_text if hot_index(c) is None]
+
     def generate(self, entities, non_contiguous_sram):
         scheme_dictionary = self._prepare_scheme_dictionary()
         entity_mappings = self._prepare_entity_mappings(scheme_dictionary, entities)
+        hot_mappings = self._prepare_hot_mappings(scheme_dictionary, entity_mappings, entities)
         root_node = RootNode()
         for mapping in entity_mappings:
             (entity, sections, target, flags) = mapping
@@ -534,11 +613,42 @@ class Generation:
             except ValueError as e:
                 raise GenerationException(str(e))
 
+        # Placements of hot functions are emitted even if they keep the target of their
+        # basis, so that they can be ordered.
+        for (entity, sections, target, flags) in hot_mappings:
+            root_node.insert(entity, sections, target, flags, entities, force=True)
+
         # Traverse the tree, creating the placements
         commands = root_node.get_output_commands(non_contiguous_sram)
+        self._order_hot_commands(commands, hot_mappings)
 
         return commands
 
+    def add_hot_functions(self, hot_functions_file, iram_size):
+        """
+        Add a hot function list, e.g. generated by tools/ldgen/gen_hot_functions.py from
+        a profile. Each line is '<archive>:<object>:<symbol> [<calls> [<size>]]', hottest
+        first. '#' starts a comment.
+        """
+        for (line_number, line) in enumerate(hot_functions_file, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            names = fields[0].split(':')
+            try:
+                if len(names) != 3 or len(fields) > 3 or not all(names):
+                    raise ValueError
+                calls = int(fields[1]) if len(fields) > 1 else 0
+                size = int(fields[2], 0) if len(fields) > 2 else 0
+                entity = Entity(*names)
+            except ValueError:
+                raise GenerationException("Invalid hot function entry '%s' in %s:%d, expected "
+                                          "'<archive>:<object>:<symbol> [<calls> [<size>]]'."
+                                          % (line, getattr(hot_functions_file, 'name', ''), line_number))
+            self.hot_functions.append(Generation.HotFunction(entity, calls, size))
+        self.hot_functions_iram_size = iram_size
+
     def add_fragments_from_file(self, fragment_file):
         for fragment in fragment_file.fragments:
             if isinstance(fragment, Scheme):
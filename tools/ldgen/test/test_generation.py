@@ -1767,5 +1767,107 @@ entries:
             self.generation.generate(self.entities, False)
 
 
+class HotFunctionTest(GenerationTest):
+
+    def add_hot_functions(self, text, iram_size):
+        hot_functions = StringIO(text)
+        hot_functions.name = 'hot_functions.txt'
+        self.generation.add_hot_functions(hot_functions, iram_size)
+
+    def croutine_sections_except(self, symbols):
+        croutine_sections = self.entities.get_sections('libfreertos.a', 'croutine')
+        filtered_sections = fnmatch.filter(croutine_sections, '.literal.*')
+        filtered_sections.extend(fnmatch.filter(croutine_sections, '.text.*'))
+        filtered_sections = [s for s in filtered_sections if not any(s.endswith('.' + sym) for sym in symbols)]
+        filtered_sections.append('.text')
+        return set(filtered_sections)
+
+    def test_hot_function_iram(self):
+        # A hot function which fits into the IRAM size is placed like a symbol mapped with noflash_text
+        #
+        # flash_text
+        #   *((EXCLUDE_FILE(libfreertos.a:croutine)) .literal ...)                                  A
+        #   *libfreertos.a:croutine(.literal  .literal.prvCheckDelayedList ...)                     B
+        #
+        # iram0_text
+        #   *(.iram ...)
+        #   *libfreertos.a:croutine(.text.prvCheckPendingReadyList .literal.prvCheckPendingReadyList) C
+        self.add_hot_functions(u"""
+# hottest first
+libfreertos.a:croutine:prvCheckPendingReadyList 1000 0x6e
+""", 256)
+        actual = self.generation.generate(self.entities, False)
+        expected = self.generate_default_rules()
+
+        flash_text = expected['flash_text']
+        flash_text[0].exclusions.add(CROUTINE)                                              # A
+        flash_text.append(InputSectionDesc(CROUTINE, self.croutine_sections_except(['prvCheckPendingReadyList']), []))  # B
+        expected['iram0_text'].append(InputSectionDesc(CROUTINE, set(['.text.prvCheckPendingReadyList',
+                                                                      '.literal.prvCheckPendingReadyList']), []))  # C
+
+        self.compare_rules(expected, actual)
+
+    def test_hot_function_flash_order(self):
+        # Hot functions which do not fit into the IRAM size stay in flash, at the start of flash_text
+        # in the order of the list. The first one fits into the IRAM size.
+        #
+        # flash_text
+        #   *libfreertos.a:croutine(.text.xCoRoutineCreate .literal.xCoRoutineCreate)              A
+        #   *libfreertos.a:croutine(.text.prvCheckDelayedList .literal.prvCheckDelayedList)        B
+        #   *((EXCLUDE_FILE(libfreertos.a:croutine)) .literal ...)
+        #   *libfreertos.a:croutine(.literal  .literal.prvCheckPendingReadyList ...)
+        #
+        # iram0_text
+        #   *(.iram ...)
+        #   *libfreertos.a:croutine(.text.prvCheckPendingReadyList .literal.prvCheckPendingReadyList)
+        self.add_hot_functions(u"""
+libfreertos.a:croutine:prvCheckPendingReadyList 1000 0x6e
+libfreertos.a:croutine:xCoRoutineCreate 900 0x44
+libfreertos.a:croutine:prvCheckDelayedList 800 0xd8
+libfreertos.a:croutine:notInTheLibrary 700 0x10
+""", 0x80)
+        actual = self.generation.generate(self.entities, False)
+        expected = self.generate_default_rules()
+
+        flash_text = expected['flash_text']
+        flash_text[0].exclusions.add(CROUTINE)
+        flash_text.append(InputSectionDesc(CROUTINE, self.croutine_sections_except(['prvCheckPendingReadyList',
+                                                                                    'xCoRoutineCreate',
+                                                                                    'prvCheckDelayedList']), []))
+        flash_text.insert(0, InputSectionDesc(CROUTINE, set(['.text.prvCheckDelayedList',
+                                                             '.literal.prvCheckDelayedList']), []))  # B
+        flash_text.insert(0, InputSectionDesc(CROUTINE, set(['.text.xCoRoutineCreate',
+                                                             '.literal.xCoRoutineCreate']), []))  # A
+        expected['iram0_text'].append(InputSectionDesc(CROUTINE, set(['.text.prvCheckPendingReadyList',
+                                                                      '.literal.prvCheckPendingReadyList']), []))
+
+        self.compare_rules(expected, actual)
+
+    def test_hot_function_mapped(self):
+        # Mapping fragments take precedence over the hot function list, the function is
+        # in IRAM already
+        mapping = u"""
+[mapping:test]
+archive: libfreertos.a
+entries:
+    croutine (noflash)
+"""
+        self.add_fragments(mapping)
+        expected = self.generation.generate(self.entities, False)
+
+        self.add_hot_functions(u"""
+libfreertos.a:croutine:prvCheckPendingReadyList 1000 0x6e
+""", 256)
+        actual = self.generation.generate(self.entities, False)
+
+        self.compare_rules(expected, actual)
+
+    def test_hot_function_invalid(self):
+        with self.assertRaises(GenerationException):
+            self.add_hot_functions(u"""
+libfreertos.a:croutine 1000
+""", 256)
+
+
 if __name__ == '__main__':
     unittest.main()
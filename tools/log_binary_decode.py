@@ -0,0 +1,284 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+# This program decodes the output of an application built with CONFIG_LOG_BINARY.
+#
+# Each log message is a frame which holds the addresses of the format string and the tag, and the
+# arguments of the message (see components/log/src/os/log_binary.c). The strings are read from the
+# ELF file of the application and the messages are formatted as the device would. Everything outside
+# of the frames (e.g. output of printf or of the bootloader) is passed through unchanged.
+import argparse
+import re
+import struct
+import sys
+import time
+from typing import BinaryIO
+from typing import Callable
+from typing import Dict
+from typing import List
+from typing import Optional
+from typing import TextIO
+from typing import Tuple
+
+STX = 0x02
+DLE = 0x10
+DLE_XOR = 0x20
+
+LEVEL_NAMES = ['', 'E', 'W', 'I', 'D', 'V']
+LEVEL_COLORS = ['', '\033[0;31m', '\033[0;33m', '\033[0;32m', '', '']
+RESET_COLOR = '\033[0m'
+
+# conversion specifications: flags, width, precision, length, conversion
+CONV_RE = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t)?([diouxXeEfFgGaAcsp%])')
+
+# bits of the integer conversions, for the 32-bit targets
+LENGTH_BITS = {'hh': 8, 'h': 16, None: 32, 'l': 32, 'z': 32, 't': 32, 'll': 64, 'j': 64}
+
+
+class FrameError(Exception):
+    pass
+
+
+class ElfStrings(object):
+    """ Reads the strings located at an address of the ELF file """
+
+    def __init__(self, elf_path):  # type: (str) -> None
+        from elftools.elf.elffile import ELFFile
+        self._sections = []  # type: List[Tuple[int, bytes]]
+        self._cache = {}  # type: Dict[int, str]
+        with open(elf_path, 'rb') as f:
+            for section in ELFFile(f).iter_sections():
+                if section['sh_flags'] & 0x2 and section['sh_type'] == 'SHT_PROGBITS':  # SHF_ALLOC
+                    self._sections.append((section['sh_addr'], section.data()))
+
+    def __call__(self, addr):  # type: (int) -> str
+        if addr not in self._cache:
+            for start, data in self._sections:
+                if start <= addr < start + len(data):
+                    end = data.find(b'\0', addr - start)
+                    self._cache[addr] = data[addr - start:end if end >= 0 else len(data)].decode('utf-8', 'replace')
+                    break
+            else:
+                raise FrameError('no string at address 0x{:08x}'.format(addr))
+        return self._cache[addr]
+
+
+class Reader(object):
+    """ Reads the fields of an unescaped frame """
+
+    def __init__(self, data):  # type: (bytes) -> None
+        self.data = data
+        self.pos = 0
+
+    def bytes(self, n):  # type: (int) -> bytes
+        if self.pos + n > len(self.data):
+            raise FrameError('frame is truncated')
+        value = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return value
+
+    def u8(self):  # type: () -> int
+        return self.bytes(1)[0]
+
+    def u32(self):  # type: () -> int
+        return int(struct.unpack('<I', self.bytes(4))[0])
+
+    def varint(self):  # type: () -> int
+        value = 0
+        shift = 0
+        while True:
+            byte = self.u8()
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    def svarint(self):  # type: () -> int
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+
+def format_timestamp(timestamp_ms, timestamp_format):  # type: (int, str) -> str
+    if timestamp_format == 'ms':
+        return str(timestamp_ms)
+    t = time.gmtime(timestamp_ms // 1000)
+    ms = '.{:03d}'.format(timestamp_ms % 1000)
+    if timestamp_format == 'time':
+        return time.strftime('%H:%M:%S', t) + ms
+    return time.strftime('%y-%m-%d %H:%M:%S', t) + ms
+
+
+def format_message(fmt, reader, resolve_str):  # type: (str, Reader, Callable[[int], str]) -> str
+    """ Formats the message from the arguments in the frame, as printf would on the device """
+
+    def conversion(m):  # type: (re.Match) -> str
+        flags, width, precision, length, conv = m.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width = reader.svarint()
+            if width < 0:
+                flags += '-'
+                width = -width
+        if precision == '*':
+            precision = reader.svarint()
+            if precision < 0:
+                precision = None
+        elif precision == '':
+            precision = 0
+        spec = '%' + flags + (str(width) if width is not None else '')
+        spec += ('.' + str(precision)) if precision is not None else ''
+
+        if conv == 's':
+            size = reader.varint()
+            if size == 0:
+                value = resolve_str(reader.u32())
+                if precision is not None:
+                    value = value[:int(precision)]
+            else:
+                value = reader.bytes(size - 1).decode('utf-8', 'replace')
+            return (spec + 's') % value
+        if conv in 'eEfFgGaA':
+            value = struct.unpack('<d', reader.bytes(8))[0]
+            if conv in 'aA':
+                # float.hex() does not strip the trailing zeros of the fraction as printf does
+                text = re.sub(r'\.?0*p', 'p', value.hex())
+                return (spec + 's') % (text if conv == 'a' else text.upper())
+            return (spec + conv) % value
+        if conv == 'p':
+            value = reader.varint()
+            return (spec + 's') % '0x{:x}'.format(value)
+        if conv == 'c':
+            return (spec + 'c') % chr(reader.varint() & 0xff)
+        bits = LENGTH_BITS[length]
+        if conv in 'di':
+            value = reader.svarint() & ((1 << bits) - 1)
+            if value >> (bits - 1):
+                value -= 1 << bits
+            conv = 'd'
+        else:
+            value = reader.varint() & ((1 << bits) - 1)
+            if conv == 'u':
+                conv = 'd'
+            elif conv in 'xX' and value == 0:
+                spec = spec.replace('#', '')
+            elif conv == 'o' and '#' in flags:
+                # in C, "#" makes the first digit a 0 instead of adding a "0o" prefix
+                digits = len('{:o}'.format(value)) + (value != 0)
+                spec = spec.replace('#', '').split('.')[0] + '.' + str(max(digits, int(precision or 0)))
+        return (spec + conv) % value
+
+    return CONV_RE.sub(conversion, fmt)
+
+
+def decode_frame(data, resolve_str, timestamp_format='ms'):  # type: (bytes, Callable[[int], str], str) -> str
+    """ Returns the text of an unescaped frame, without STX and the final '\\n' """
+    reader = Reader(data)
+    flags = reader.u8()
+    level = flags & 0x7
+    if level >= len(LEVEL_NAMES):
+        raise FrameError('invalid log level {}'.format(level))
+    require_formatting = bool(flags & 0x8)
+    dis_color = bool(flags & 0x10) or LEVEL_COLORS[level] == ''
+    dis_timestamp = bool(flags & 0x20)
+    timestamp = reader.varint() if not dis_timestamp else 0
+    fmt = resolve_str(reader.u32())
+    tag_addr = reader.u32() if require_formatting else 0
+    message = format_message(fmt, reader, resolve_str)
+    if reader.pos != len(data):
+        raise FrameError('unexpected data at the end of the frame')
+    if not require_formatting:
+        return message
+
+    prefix = '' if dis_color else LEVEL_COLORS[level]
+    prefix += LEVEL_NAMES[level] + ' '
+    if not dis_timestamp:
+        prefix += '(' + format_timestamp(timestamp, timestamp_format) + ') '
+    if tag_addr != 0:
+        prefix += resolve_str(tag_addr) + ': '
+    return prefix + message + ('' if dis_color else RESET_COLOR) + '\n'
+
+
+class Decoder(object):
+    """ Splits the output of the device into text and frames """
+
+    def __init__(self, resolve_str, timestamp_format='ms'):  # type: (Callable[[int], str], str) -> None
+        self.resolve_str = resolve_str
+        self.timestamp_format = timestamp_format
+        self._frame = None  # type: Optional[bytearray]
+        self._escape = False
+
+    def feed(self, data):  # type: (bytes) -> str
+        out = []  # type: List[str]
+        text = bytearray()
+        for byte in bytearray(data):
+            if self._frame is None:
+                if byte == STX:
+                    out.append(text.decode('utf-8', 'replace'))
+                    text = bytearray()
+                    self._frame = bytearray()
+                    self._escape = False
+                else:
+                    text.append(byte)
+            elif byte == STX or byte == ord('\n'):
+                # a frame ends with '\n', STX means that the previous frame was cut (e.g. by a reset)
+                out.append(self._decode(bytes(self._frame), complete=(byte != STX)))
+                self._frame = bytearray() if byte == STX else None
+                self._escape = False
+            elif byte == ord('\r'):
+                pass  # added by a CRLF conversion of the console
+            elif self._escape:
+                self._frame.append(byte ^ DLE_XOR)
+                self._escape = False
+            elif byte == DLE:
+                self._escape = True
+            else:
+                self._frame.append(byte)
+        out.append(text.decode('utf-8', 'replace'))
+        return ''.join(out)
+
+    def _decode(self, frame, complete):  # type: (bytes, bool) -> str
+        try:
+            if not complete:
+                raise FrameError('frame is truncated')
+            return decode_frame(frame, self.resolve_str, self.timestamp_format)
+        except FrameError as e:
+            return '<invalid log frame: {}>\n'.format(e)
+
+
+def main():  # type: () -> None
+    parser = argparse.ArgumentParser(description='Decode the output of an application built with CONFIG_LOG_BINARY')
+    parser.add_argument('elf', help='ELF file of the application')
+    parser.add_argument('input', nargs='?', type=argparse.FileType('rb'), default=sys.stdin.buffer,
+                        help='File with the output of the device, stdin by default')
+    parser.add_argument('--port', '-p', help='Serial port to read the output of the device from instead')
+    parser.add_argument('--baud', '-b', type=int, default=115200, help='Baud rate of the serial port')
+    parser.add_argument('--timestamp', choices=['ms', 'time', 'datetime'], default='ms',
+                        help='Format of the timestamps, depending on CONFIG_LOG_TIMESTAMP_SOURCE: '
+                             'milliseconds, or the UTC time of day (System time) or date and time (System full)')
+    args = parser.parse_args()
+
+    decoder = Decoder(ElfStrings(args.elf), args.timestamp)
+    out = sys.stdout  # type: TextIO
+    if args.port:
+        import serial
+        stream = serial.Serial(args.port, args.baud, timeout=0.1)  # type: BinaryIO
+    else:
+        stream = args.input
+    try:
+        while True:
+            data = stream.read(256) if args.port else stream.read1(4096)  # type: ignore
+            if not data:
+                if args.port:
+                    continue
+                break
+            out.write(decoder.feed(data))
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
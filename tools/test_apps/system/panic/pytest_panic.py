@@ -44,7 +44,7 @@ CONFIGS = list(
             ],
             TARGETS_ALL,
         ),
-        itertools.product(['coredump_flash_custom_stack'], TARGETS_RISCV),
+        itertools.product(['coredump_flash_custom_stack', 'coredump_flash_fast_write'], TARGETS_RISCV),
     )
 )
 
@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+
+import os
+import struct
+import sys
+import unittest
+
+current_dir = os.path.dirname(os.path.realpath(__file__))
+sys.path.insert(0, os.path.join(current_dir, '..'))
+
+import log_binary_decode  # noqa: E402
+
+STRINGS = {
+    0x3c010000: 'wifi',
+    0x3c010010: 'connected to %s, channel %d, rssi %d',
+    0x3c010040: '%08x|%-5u|%hhd|%llu|%c|%p|%.2f|%*d|%.*s|%%|%s',
+    0x3c010080: 'ap_name',
+    0x3c010090: 'I (%lu) %s: raw %d\n',
+}
+
+
+def resolve(addr):
+    try:
+        return STRINGS[addr]
+    except KeyError:
+        raise log_binary_decode.FrameError('no string at address 0x{:08x}'.format(addr))
+
+
+def varint(value):
+    out = bytearray()
+    while value >= 0x80:
+        out.append((value & 0x7f) | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def svarint(value):
+    return varint(((value << 1) ^ (value >> 63)) & 0xffffffffffffffff)
+
+
+def frame(level, fmt, args, tag=None, timestamp=None, dis_color=False, require_formatting=True):
+    body = bytearray([level | (require_formatting << 3) | (dis_color << 4) | ((timestamp is None) << 5)])
+    if timestamp is not None:
+        body += varint(timestamp)
+    body += struct.pack('<I', fmt)
+    if require_formatting:
+        body += struct.pack('<I', tag or 0)
+    body += args
+    escaped = bytearray([0x02])
+    for byte in body:
+        if byte in (0x00, 0x02, 0x10, 0x0d, 0x0a):
+            escaped += bytes([0x10, byte ^ 0x20])
+        else:
+            escaped.append(byte)
+    return bytes(escaped) + b'\n'
+
+
+class TestLogBinaryDecode(unittest.TestCase):
+    def decode(self, data, chunk=None):
+        decoder = log_binary_decode.Decoder(resolve)
+        chunk = chunk or len(data)
+        return ''.join(decoder.feed(data[i:i + chunk]) for i in range(0, len(data), chunk))
+
+    def test_message(self):
+        args = b'\x00' + struct.pack('<I', 0x3c010080) + svarint(6) + svarint(-67)
+        data = frame(3, 0x3c010010, args, tag=0x3c010000, timestamp=1234)
+        self.assertEqual(self.decode(data), '\033[0;32mI (1234) wifi: connected to ap_name, channel 6, rssi -67\033[0m\n')
+
+    def test_no_color_no_timestamp_no_tag(self):
+        args = varint(len('ap') + 1) + b'ap' + svarint(11) + svarint(-1)
+        data = frame(2, 0x3c010010, args, dis_color=True)
+        self.assertEqual(self.decode(data), 'W connected to ap, channel 11, rssi -1\n')
+
+    def test_conversions(self):
+        args = (varint(0xbeef) + varint(42) + svarint(-56) + varint(2 ** 64 - 1) + varint(ord('\n')) +
+                varint(0x3fc80000) + struct.pack('<d', 3.14159) + svarint(-4) + svarint(7) +
+                svarint(3) + varint(len('abcdef') + 1) + b'abcdef' + varint(len('\r\n') + 1) + b'\r\n')
+        data = frame(4, 0x3c010040, args, tag=0x3c010000, timestamp=0)
+        self.assertEqual(self.decode(data, chunk=1),
+                         'D (0) wifi: 0000beef|42   |-56|18446744073709551615|\n|0x3fc80000|3.14|7   |abc|%|\r\n\n')
+
+    def test_preformatted_message(self):
+        args = varint(99) + b'\x00' + struct.pack('<I', 0x3c010000) + svarint(-5)
+        data = frame(3, 0x3c010090, args, require_formatting=False)
+        self.assertEqual(self.decode(data), 'I (99) wifi: raw -5\n')
+
+    def test_text_is_passed_through(self):
+        data = b'boot: text\r\n' + frame(1, 0x3c010010, b'\x00' + struct.pack('<I', 0x3c010080) + svarint(1) + svarint(2),
+                                         dis_color=True) + b'printf\n'
+        self.assertEqual(self.decode(data, chunk=3), 'boot: text\r\nE connected to ap_name, channel 1, rssi 2\nprintf\n')
+
+    def test_crlf_conversion(self):
+        data = frame(3, 0x3c010090, varint(0) + b'\x00' + struct.pack('<I', 0x3c010000) + svarint(0),
+                     require_formatting=False).replace(b'\n', b'\r\n')
+        self.assertEqual(self.decode(data), 'I (0) wifi: raw 0\n')
+
+    def test_invalid_frames(self):
+        good = frame(3, 0x3c010090, varint(0) + b'\x00' + struct.pack('<I', 0x3c010000) + svarint(0), require_formatting=False)
+        # cut by a reset: the next frame is still decoded
+        self.assertEqual(self.decode(good[:8] + good), '<invalid log frame: frame is truncated>\nI (0) wifi: raw 0\n')
+        self.assertIn('no string at address', self.decode(frame(3, 0x12345678, b'', dis_color=True)))
+        self.assertIn('unexpected data', self.decode(good[:-1] + b'\x01\n'))
+
+
+if __name__ == '__main__':
+    unittest.main()